@@ -0,0 +1,146 @@
+dnl Check for Hyperscan (or Vectorscan) Libraries
+dnl CHECK_HYPERSCAN(ACTION-IF-FOUND [, ACTION-IF-NOT-FOUND])
+
+
+AC_DEFUN([CHECK_HYPERSCAN],
+[dnl
+
+# Possible names for the hyperscan library/package (pkg-config). Vectorscan,
+# the portable fork, ships the very same library and package names.
+HYPERSCAN_POSSIBLE_LIB_NAMES="libhs hs"
+
+# Possible extensions for the library
+HYPERSCAN_POSSIBLE_EXTENSIONS="so so5 la sl dll dylib so.5"
+
+# Possible paths (if pkg-config was not found, proceed with the file lookup)
+HYPERSCAN_POSSIBLE_PATHS="/usr/lib /usr/local/lib /usr/local/hyperscan /usr/local/vectorscan /usr/local /opt/hyperscan /opt/vectorscan /opt /usr /usr/lib64 /opt/local"
+
+# Variables to be set by this very own script.
+HYPERSCAN_VERSION=""
+HYPERSCAN_CFLAGS=""
+HYPERSCAN_LDFLAGS=""
+HYPERSCAN_LDADD=""
+HYPERSCAN_DISPLAY=""
+
+AC_ARG_WITH(
+    hyperscan,
+    [AS_HELP_STRING([--with-hyperscan=PATH],[Path to hyperscan (or vectorscan) prefix. Used by @rx and @pm, disabled by default])]
+)
+
+
+if test "x${with_hyperscan}" == "x" || test "x${with_hyperscan}" == "xno"; then
+    AC_DEFINE(HAVE_HYPERSCAN, 0, [Support for Hyperscan is only enabled by the utilization of --with-hyperscan])
+    AC_MSG_NOTICE([Support for Hyperscan is disabled, use --with-hyperscan to enable it])
+    HYPERSCAN_DISABLED=yes
+else
+    HYPERSCAN_MANDATORY=yes
+    if test "x${with_hyperscan}" == "xyes"; then
+        # Nothing about the location was informed, use pkg-config.
+        if test -n "${PKG_CONFIG}"; then
+            HYPERSCAN_PKG_NAME=""
+            for x in ${HYPERSCAN_POSSIBLE_LIB_NAMES}; do
+                if ${PKG_CONFIG} --exists ${x}; then
+                    HYPERSCAN_PKG_NAME="$x"
+                    break
+                fi
+            done
+        fi
+        if test -n "${HYPERSCAN_PKG_NAME}"; then
+            HYPERSCAN_VERSION="`${PKG_CONFIG} ${HYPERSCAN_PKG_NAME} --modversion`"
+            HYPERSCAN_CFLAGS="`${PKG_CONFIG} ${HYPERSCAN_PKG_NAME} --cflags`"
+            HYPERSCAN_LDADD="`${PKG_CONFIG} ${HYPERSCAN_PKG_NAME} --libs-only-l`"
+            HYPERSCAN_LDFLAGS="`${PKG_CONFIG} ${HYPERSCAN_PKG_NAME} --libs-only-L --libs-only-other`"
+            HYPERSCAN_DISPLAY="${HYPERSCAN_LDADD}, ${HYPERSCAN_CFLAGS}"
+        else
+            for x in ${HYPERSCAN_POSSIBLE_PATHS}; do
+                CHECK_FOR_HYPERSCAN_AT(${x})
+                if test -n "${HYPERSCAN_LDADD}"; then
+                    break
+                fi
+            done
+        fi
+    else
+        CHECK_FOR_HYPERSCAN_AT(${with_hyperscan})
+    fi
+fi
+
+
+if test -z "${HYPERSCAN_LDADD}"; then
+    if test -z "${HYPERSCAN_MANDATORY}"; then
+        HYPERSCAN_FOUND=2
+    else
+        AC_MSG_ERROR([Hyperscan was explicitly referenced but it was not found])
+        HYPERSCAN_FOUND=-1
+    fi
+else
+    HYPERSCAN_FOUND=1
+    AC_MSG_NOTICE([using Hyperscan v${HYPERSCAN_VERSION}])
+    HYPERSCAN_CFLAGS="-DWITH_HYPERSCAN ${HYPERSCAN_CFLAGS}"
+    HYPERSCAN_DISPLAY="${HYPERSCAN_LDADD} ${HYPERSCAN_LDFLAGS}, ${HYPERSCAN_CFLAGS}"
+    AC_SUBST(HYPERSCAN_VERSION)
+    AC_SUBST(HYPERSCAN_LDFLAGS)
+    AC_SUBST(HYPERSCAN_LDADD)
+    AC_SUBST(HYPERSCAN_CFLAGS)
+    AC_SUBST(HYPERSCAN_DISPLAY)
+fi
+
+
+AC_SUBST(HYPERSCAN_FOUND)
+
+]) # AC_DEFUN [CHECK_HYPERSCAN]
+
+
+AC_DEFUN([CHECK_FOR_HYPERSCAN_AT], [
+    path=$1
+    echo "*** LOOKING AT PATH: " ${path}
+    for y in ${HYPERSCAN_POSSIBLE_EXTENSIONS}; do
+       if test -e "${path}/libhs.${y}"; then
+           hyperscan_lib_path="${path}/"
+           hyperscan_lib_file="${hyperscan_lib_path}/libhs.${y}"
+           break
+       fi
+       if test -e "${path}/lib/libhs.${y}"; then
+           hyperscan_lib_path="${path}/lib/"
+           hyperscan_lib_file="${hyperscan_lib_path}/libhs.${y}"
+           break
+       fi
+       if test -e "${path}/lib64/libhs.${y}"; then
+           hyperscan_lib_path="${path}/lib64/"
+           hyperscan_lib_file="${hyperscan_lib_path}/libhs.${y}"
+           break
+       fi
+       if test -e "${path}/lib/x86_64-linux-gnu/libhs.${y}"; then
+           hyperscan_lib_path="${path}/lib/x86_64-linux-gnu/"
+           hyperscan_lib_file="${hyperscan_lib_path}/libhs.${y}"
+           break
+       fi
+       if test -e "${path}/lib/aarch64-linux-gnu/libhs.${y}"; then
+           hyperscan_lib_path="${path}/lib/aarch64-linux-gnu/"
+           hyperscan_lib_file="${hyperscan_lib_path}/libhs.${y}"
+           break
+       fi
+    done
+    if test -e "${path}/include/hs/hs.h"; then
+        hyperscan_inc_path="${path}/include/hs"
+    elif test -e "${path}/include/hs.h"; then
+        hyperscan_inc_path="${path}/include"
+    elif test -e "${path}/hs.h"; then
+        hyperscan_inc_path="${path}"
+    fi
+
+    if test -n "${hyperscan_lib_path}"; then
+        AC_MSG_NOTICE([Hyperscan library found at: ${hyperscan_lib_file}])
+    fi
+
+    if test -n "${hyperscan_inc_path}"; then
+        AC_MSG_NOTICE([Hyperscan headers found at: ${hyperscan_inc_path}])
+    fi
+
+    if test -n "${hyperscan_lib_path}" -a -n "${hyperscan_inc_path}"; then
+        # TODO: Compile a piece of code to check the version.
+        HYPERSCAN_CFLAGS="-I${hyperscan_inc_path}"
+        HYPERSCAN_LDADD="-lhs"
+        HYPERSCAN_LDFLAGS="-L${hyperscan_lib_path}"
+        HYPERSCAN_DISPLAY="${hyperscan_lib_file}, ${hyperscan_inc_path}"
+    fi
+]) # AC_DEFUN [CHECK_FOR_HYPERSCAN_AT]
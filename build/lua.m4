@@ -6,7 +6,7 @@ AC_DEFUN([CHECK_LUA],
 [dnl
 
 # Possible names for the lua library/package (pkg-config)
-LUA_POSSIBLE_LIB_NAMES="lua54 lua5.4 lua-5.4 lua53 lua5.3 lua-5.3 lua52 lua5.2 lua-5.2 lua51 lua5.1 lua-5.1 lua"
+LUA_POSSIBLE_LIB_NAMES="lua54 lua5.4 lua-5.4 lua53 lua5.3 lua-5.3 lua52 lua5.2 lua-5.2 lua51 lua5.1 lua-5.1 lua luajit luajit-5.1"
 
 # Possible extensions for the library
 LUA_POSSIBLE_EXTENSIONS="so la sl dll dylib"
@@ -26,6 +26,13 @@ AC_ARG_WITH(
 )
 
 
+# A prefix given by --with-lua=PATH is the only one looked at; that is how
+# LuaJIT is picked when PUC Lua is installed as well.
+if test "x${with_lua}" != "xno" && test "x${with_lua}" != "xyes" && test -n "${with_lua}"; then
+    LUA_POSSIBLE_PATHS="${with_lua}"
+fi
+
+
 if test "x${with_lua}" == "xno"; then
     AC_DEFINE(HAVE_LUA, 0, [Support for LUA was disabled by the utilization of --without-lua or --with-lua=no])
     AC_MSG_NOTICE([Support for LUA was disabled by the utilization of --without-lua or --with-lua=no])
@@ -67,8 +74,8 @@ else
            (5.2*) LUA_CFLAGS="-DWITH_LUA_5_2 ${LUA_CFLAGS}" ; lua_5_2=1 ;;
            (5.3*) LUA_CFLAGS="-DWITH_LUA_5_3 ${LUA_CFLAGS}" ; lua_5_3=1 ;;
            (5.4*) LUA_CFLAGS="-DWITH_LUA_5_4 ${LUA_CFLAGS}" ; lua_5_4=1 ;;
-           (2.0*) LUA_CFLAGS="-DWITH_LUA_5_1 ${LUA_CFLAGS}" ; lua_5_1=1 ;;
-           (2.1*) LUA_CFLAGS="-DWITH_LUA_5_1 -DWITH_LUA_JIT_2_1 ${LUA_CFLAGS}" ; lua_5_1=1 ;;
+           (2.0*) LUA_CFLAGS="-DWITH_LUA_5_1 -DWITH_LUA_JIT ${LUA_CFLAGS}" ; lua_5_1=1 ;;
+           (2.1*) LUA_CFLAGS="-DWITH_LUA_5_1 -DWITH_LUA_JIT -DWITH_LUA_JIT_2_1 ${LUA_CFLAGS}" ; lua_5_1=1 ;;
         esac
            AC_MSG_NOTICE([LUA pkg-config version: ${LUA_PKG_VERSION}])
         fi
@@ -173,9 +180,14 @@ AC_DEFUN([CHECK_FOR_LUA_AT], [
     elif test -e "${path}/include/lua5.1/lua.h"; then
         lua_inc_path="${path}/include/lua5.1"
 	LUA_VERSION=501
+    elif test -e "${path}/include/luajit-2.1/lua.h"; then
+        lua_inc_path="${path}/include/luajit-2.1"
+	LUA_VERSION=501
+	LUA_JIT="-DWITH_LUA_JIT -DWITH_LUA_JIT_2_1"
     elif test -e "${path}/include/luajit-2.0/lua.h"; then
         lua_inc_path="${path}/include/luajit-2.0"
 	LUA_VERSION=501
+	LUA_JIT="-DWITH_LUA_JIT"
     fi
 
     if test -n "${lua_lib_path}"; then
@@ -235,7 +247,7 @@ AC_DEFUN([CHECK_FOR_LUA_AT], [
         fi
 
         case $LUA_VERSION in
-           (501) LUA_CFLAGS="-DWITH_LUA_5_1 ${LUA_CFLAGS}" ; lua_5_1=1 ;;
+           (501) LUA_CFLAGS="-DWITH_LUA_5_1 ${LUA_JIT} ${LUA_CFLAGS}" ; lua_5_1=1 ;;
            (502) LUA_CFLAGS="-DWITH_LUA_5_2 ${LUA_CFLAGS}" ; lua_5_2=1 ;;
            (503) LUA_CFLAGS="-DWITH_LUA_5_3 ${LUA_CFLAGS}" ; lua_5_3=1 ;;
            (504) LUA_CFLAGS="-DWITH_LUA_5_4 ${LUA_CFLAGS}" ; lua_5_4=1 ;;
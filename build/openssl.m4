@@ -0,0 +1,139 @@
+dnl Check for OpenSSL (libcrypto) Libraries
+dnl CHECK_OPENSSL(ACTION-IF-FOUND [, ACTION-IF-NOT-FOUND])
+
+
+AC_DEFUN([CHECK_OPENSSL],
+[dnl
+
+# Possible names for the OpenSSL crypto library/package (pkg-config)
+OPENSSL_POSSIBLE_LIB_NAMES="crypto"
+
+# Possible extensions for the library
+OPENSSL_POSSIBLE_EXTENSIONS="so so0 la sl dll dylib so.0.0.0"
+
+# Possible paths (if pkg-config was not found, proceed with the file lookup)
+OPENSSL_POSSIBLE_PATHS="/usr/lib /usr/local/lib /usr/local/ssl /usr/local /opt /usr /usr/lib64 /opt/local"
+
+# Variables to be set by this very own script.
+OPENSSL_CFLAGS=""
+OPENSSL_LDFLAGS=""
+OPENSSL_LDADD=""
+OPENSSL_DISPLAY=""
+
+AC_ARG_WITH(
+    openssl,
+    [AS_HELP_STRING([--with-openssl=PATH],[Path to OpenSSL prefix, used for t:md5 and t:sha1 instead of the bundled mbedtls])]
+)
+
+
+# Unlike the other libraries, OpenSSL is only used when asked for: the
+# bundled digests are already there and good enough on most systems.
+if test "x${with_openssl}" == "xno" || test "x${with_openssl}" == "x"; then
+    AC_MSG_NOTICE([OpenSSL support is disabled, use --with-openssl to enable it])
+    OPENSSL_DISABLED=yes
+else
+    OPENSSL_MANDATORY=yes
+    if test "x${with_openssl}" != "xyes"; then
+        OPENSSL_POSSIBLE_PATHS="${with_openssl}"
+    fi
+    for x in ${OPENSSL_POSSIBLE_PATHS}; do
+        CHECK_FOR_OPENSSL_AT(${x})
+        if test -n "${OPENSSL_CFLAGS}"; then
+            break
+        fi
+    done
+fi
+
+
+if test -z "${OPENSSL_CFLAGS}"; then
+    if test -z "${OPENSSL_MANDATORY}" || test "x${OPENSSL_MANDATORY}" == "xno"; then
+        if test -z "${OPENSSL_DISABLED}"; then
+            AC_MSG_NOTICE([OPENSSL library was not found])
+            OPENSSL_FOUND=0
+        else
+            OPENSSL_FOUND=2
+        fi
+    else
+        AC_MSG_ERROR([OPENSSL was explicitly referenced but it was not found])
+        OPENSSL_FOUND=-1
+    fi
+else
+    OPENSSL_FOUND=1
+    AC_MSG_NOTICE([using OpenSSL for the digests])
+    OPENSSL_CFLAGS="-DWITH_OPENSSL ${OPENSSL_CFLAGS}"
+    OPENSSL_DISPLAY="${OPENSSL_LDADD} ${OPENSSL_LDFLAGS}, ${OPENSSL_CFLAGS}"
+    AC_SUBST(OPENSSL_LDFLAGS)
+    AC_SUBST(OPENSSL_LDADD)
+    AC_SUBST(OPENSSL_CFLAGS)
+    AC_SUBST(OPENSSL_DISPLAY)
+fi
+
+
+AC_SUBST(OPENSSL_FOUND)
+
+]) # AC_DEFUN [CHECK_OPENSSL]
+
+
+AC_DEFUN([CHECK_FOR_OPENSSL_AT], [
+    path=$1
+    echo "*** LOOKING AT PATH: " ${path}
+    for y in ${OPENSSL_POSSIBLE_EXTENSIONS}; do
+        for z in ${OPENSSL_POSSIBLE_LIB_NAMES}; do
+           if test -e "${path}/${z}.${y}"; then
+               openssl_lib_path="${path}/"
+               openssl_lib_name="${z}"
+               openssl_lib_file="${openssl_lib_path}/${z}.${y}"
+               break
+           fi
+           if test -e "${path}/lib${z}.${y}"; then
+               openssl_lib_path="${path}/"
+               openssl_lib_name="${z}"
+               openssl_lib_file="${openssl_lib_path}/lib${z}.${y}"
+               break
+           fi
+           if test -e "${path}/lib/lib${z}.${y}"; then
+               openssl_lib_path="${path}/lib/"
+               openssl_lib_name="${z}"
+               openssl_lib_file="${openssl_lib_path}/lib${z}.${y}"
+               break
+           fi
+           if test -e "${path}/lib/x86_64-linux-gnu/lib${z}.${y}"; then
+               openssl_lib_path="${path}/lib/x86_64-linux-gnu/"
+               openssl_lib_name="${z}"
+               openssl_lib_file="${openssl_lib_path}/lib${z}.${y}"
+               break
+           fi
+           if test -e "${path}/lib/i386-linux-gnu/lib${z}.${y}"; then
+               openssl_lib_path="${path}/lib/i386-linux-gnu/"
+               openssl_lib_name="${z}"
+               openssl_lib_file="${openssl_lib_path}/lib${z}.${y}"
+               break
+           fi
+       done
+       if test -n "$openssl_lib_path"; then
+           break
+       fi
+    done
+    if test -e "${path}/include/openssl/evp.h"; then
+        openssl_inc_path="${path}/include"
+    fi
+
+    if test -n "${openssl_lib_path}"; then
+        AC_MSG_NOTICE([OPENSSL library found at: ${openssl_lib_file}])
+    fi
+
+    if test -n "${openssl_inc_path}"; then
+        AC_MSG_NOTICE([OPENSSL headers found at: ${openssl_inc_path}])
+    fi
+
+    if test -n "${openssl_lib_path}" -a -n "${openssl_inc_path}"; then
+        # TODO: Compile a piece of code to check the version.
+        OPENSSL_CFLAGS="-I${openssl_inc_path}"
+        OPENSSL_LDADD="-l${openssl_lib_name}"
+        OPENSSL_LDFLAGS="-L${openssl_lib_path}"
+        OPENSSL_DISPLAY="${openssl_lib_file}, ${openssl_inc_path}"
+    fi
+]) # AC_DEFUN [CHECK_FOR_OPENSSL_AT]
+
+
+
@@ -0,0 +1,143 @@
+dnl Check for RE2 Libraries
+dnl CHECK_RE2(ACTION-IF-FOUND [, ACTION-IF-NOT-FOUND])
+
+
+AC_DEFUN([CHECK_RE2],
+[dnl
+
+# Possible names for the re2 library/package (pkg-config)
+RE2_POSSIBLE_LIB_NAMES="re2"
+
+# Possible extensions for the library
+RE2_POSSIBLE_EXTENSIONS="so so11 so10 so9 la sl dll dylib"
+
+# Possible paths (if pkg-config was not found, proceed with the file lookup)
+RE2_POSSIBLE_PATHS="/usr/lib /usr/local/lib /usr/local/re2 /usr/local /opt/re2 /opt /usr /usr/lib64 /opt/local"
+
+# Variables to be set by this very own script.
+RE2_VERSION=""
+RE2_CFLAGS=""
+RE2_LDFLAGS=""
+RE2_LDADD=""
+RE2_DISPLAY=""
+
+AC_ARG_WITH(
+    re2,
+    [AS_HELP_STRING([--with-re2=PATH],[Path to re2 prefix. Used by @rx with SecRxRe2, disabled by default])]
+)
+
+
+if test "x${with_re2}" == "x" || test "x${with_re2}" == "xno"; then
+    AC_DEFINE(HAVE_RE2, 0, [Support for RE2 is only enabled by the utilization of --with-re2])
+    AC_MSG_NOTICE([Support for RE2 is disabled, use --with-re2 to enable it])
+    RE2_DISABLED=yes
+else
+    RE2_MANDATORY=yes
+    if test "x${with_re2}" == "xyes"; then
+        # Nothing about the location was informed, use pkg-config.
+        if test -n "${PKG_CONFIG}"; then
+            RE2_PKG_NAME=""
+            for x in ${RE2_POSSIBLE_LIB_NAMES}; do
+                if ${PKG_CONFIG} --exists ${x}; then
+                    RE2_PKG_NAME="$x"
+                    break
+                fi
+            done
+        fi
+        if test -n "${RE2_PKG_NAME}"; then
+            RE2_VERSION="`${PKG_CONFIG} ${RE2_PKG_NAME} --modversion`"
+            RE2_CFLAGS="`${PKG_CONFIG} ${RE2_PKG_NAME} --cflags`"
+            RE2_LDADD="`${PKG_CONFIG} ${RE2_PKG_NAME} --libs-only-l`"
+            RE2_LDFLAGS="`${PKG_CONFIG} ${RE2_PKG_NAME} --libs-only-L --libs-only-other`"
+            RE2_DISPLAY="${RE2_LDADD}, ${RE2_CFLAGS}"
+        else
+            for x in ${RE2_POSSIBLE_PATHS}; do
+                CHECK_FOR_RE2_AT(${x})
+                if test -n "${RE2_LDADD}"; then
+                    break
+                fi
+            done
+        fi
+    else
+        CHECK_FOR_RE2_AT(${with_re2})
+    fi
+fi
+
+
+if test -z "${RE2_LDADD}"; then
+    if test -z "${RE2_MANDATORY}"; then
+        RE2_FOUND=2
+    else
+        AC_MSG_ERROR([RE2 was explicitly referenced but it was not found])
+        RE2_FOUND=-1
+    fi
+else
+    RE2_FOUND=1
+    AC_MSG_NOTICE([using RE2 v${RE2_VERSION}])
+    RE2_CFLAGS="-DWITH_RE2 ${RE2_CFLAGS}"
+    RE2_DISPLAY="${RE2_LDADD} ${RE2_LDFLAGS}, ${RE2_CFLAGS}"
+    AC_SUBST(RE2_VERSION)
+    AC_SUBST(RE2_LDFLAGS)
+    AC_SUBST(RE2_LDADD)
+    AC_SUBST(RE2_CFLAGS)
+    AC_SUBST(RE2_DISPLAY)
+fi
+
+
+AC_SUBST(RE2_FOUND)
+
+]) # AC_DEFUN [CHECK_RE2]
+
+
+AC_DEFUN([CHECK_FOR_RE2_AT], [
+    path=$1
+    echo "*** LOOKING AT PATH: " ${path}
+    for y in ${RE2_POSSIBLE_EXTENSIONS}; do
+       if test -e "${path}/libre2.${y}"; then
+           re2_lib_path="${path}/"
+           re2_lib_file="${re2_lib_path}/libre2.${y}"
+           break
+       fi
+       if test -e "${path}/lib/libre2.${y}"; then
+           re2_lib_path="${path}/lib/"
+           re2_lib_file="${re2_lib_path}/libre2.${y}"
+           break
+       fi
+       if test -e "${path}/lib64/libre2.${y}"; then
+           re2_lib_path="${path}/lib64/"
+           re2_lib_file="${re2_lib_path}/libre2.${y}"
+           break
+       fi
+       if test -e "${path}/lib/x86_64-linux-gnu/libre2.${y}"; then
+           re2_lib_path="${path}/lib/x86_64-linux-gnu/"
+           re2_lib_file="${re2_lib_path}/libre2.${y}"
+           break
+       fi
+       if test -e "${path}/lib/aarch64-linux-gnu/libre2.${y}"; then
+           re2_lib_path="${path}/lib/aarch64-linux-gnu/"
+           re2_lib_file="${re2_lib_path}/libre2.${y}"
+           break
+       fi
+    done
+    if test -e "${path}/include/re2/re2.h"; then
+        re2_inc_path="${path}/include"
+    elif test -e "${path}/re2/re2.h"; then
+        re2_inc_path="${path}"
+    fi
+
+    if test -n "${re2_lib_path}"; then
+        AC_MSG_NOTICE([RE2 library found at: ${re2_lib_file}])
+    fi
+
+    if test -n "${re2_inc_path}"; then
+        AC_MSG_NOTICE([RE2 headers found at: ${re2_inc_path}])
+    fi
+
+    if test -n "${re2_lib_path}" -a -n "${re2_inc_path}"; then
+        # TODO: Compile a piece of code to check the version.
+        RE2_CFLAGS="-I${re2_inc_path}"
+        RE2_LDADD="-lre2"
+        RE2_LDFLAGS="-L${re2_lib_path}"
+        RE2_DISPLAY="${re2_lib_file}, ${re2_inc_path}"
+    fi
+]) # AC_DEFUN [CHECK_FOR_RE2_AT]
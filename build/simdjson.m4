@@ -0,0 +1,143 @@
+dnl Check for simdjson Libraries
+dnl CHECK_SIMDJSON(ACTION-IF-FOUND [, ACTION-IF-NOT-FOUND])
+
+
+AC_DEFUN([CHECK_SIMDJSON],
+[dnl
+
+# Possible names for the simdjson library/package (pkg-config)
+SIMDJSON_POSSIBLE_LIB_NAMES="simdjson libsimdjson"
+
+# Possible extensions for the library
+SIMDJSON_POSSIBLE_EXTENSIONS="so la sl dll dylib a"
+
+# Possible paths (if pkg-config was not found, proceed with the file lookup)
+SIMDJSON_POSSIBLE_PATHS="/usr/lib /usr/local/lib /usr/local/simdjson /usr/local /opt/simdjson /opt /usr /usr/lib64 /opt/local"
+
+# Variables to be set by this very own script.
+SIMDJSON_VERSION=""
+SIMDJSON_CFLAGS=""
+SIMDJSON_LDFLAGS=""
+SIMDJSON_LDADD=""
+SIMDJSON_DISPLAY=""
+
+AC_ARG_WITH(
+    simdjson,
+    [AS_HELP_STRING([--with-simdjson=PATH],[Path to simdjson prefix. Parses the JSON request bodies along with yajl, disabled by default])]
+)
+
+
+if test "x${with_simdjson}" == "x" || test "x${with_simdjson}" == "xno"; then
+    AC_DEFINE(HAVE_SIMDJSON, 0, [Support for simdjson is only enabled by the utilization of --with-simdjson])
+    AC_MSG_NOTICE([Support for simdjson is disabled, use --with-simdjson to enable it])
+    SIMDJSON_DISABLED=yes
+else
+    SIMDJSON_MANDATORY=yes
+    if test "x${with_simdjson}" == "xyes"; then
+        # Nothing about the location was informed, use pkg-config.
+        if test -n "${PKG_CONFIG}"; then
+            SIMDJSON_PKG_NAME=""
+            for x in ${SIMDJSON_POSSIBLE_LIB_NAMES}; do
+                if ${PKG_CONFIG} --exists ${x}; then
+                    SIMDJSON_PKG_NAME="$x"
+                    break
+                fi
+            done
+        fi
+        if test -n "${SIMDJSON_PKG_NAME}"; then
+            SIMDJSON_VERSION="`${PKG_CONFIG} ${SIMDJSON_PKG_NAME} --modversion`"
+            SIMDJSON_CFLAGS="`${PKG_CONFIG} ${SIMDJSON_PKG_NAME} --cflags`"
+            SIMDJSON_LDADD="`${PKG_CONFIG} ${SIMDJSON_PKG_NAME} --libs-only-l`"
+            SIMDJSON_LDFLAGS="`${PKG_CONFIG} ${SIMDJSON_PKG_NAME} --libs-only-L --libs-only-other`"
+            SIMDJSON_DISPLAY="${SIMDJSON_LDADD}, ${SIMDJSON_CFLAGS}"
+        else
+            for x in ${SIMDJSON_POSSIBLE_PATHS}; do
+                CHECK_FOR_SIMDJSON_AT(${x})
+                if test -n "${SIMDJSON_LDADD}"; then
+                    break
+                fi
+            done
+        fi
+    else
+        CHECK_FOR_SIMDJSON_AT(${with_simdjson})
+    fi
+fi
+
+
+if test -z "${SIMDJSON_LDADD}"; then
+    if test -z "${SIMDJSON_MANDATORY}"; then
+        SIMDJSON_FOUND=2
+    else
+        AC_MSG_ERROR([simdjson was explicitly referenced but it was not found])
+        SIMDJSON_FOUND=-1
+    fi
+else
+    SIMDJSON_FOUND=1
+    AC_MSG_NOTICE([using simdjson v${SIMDJSON_VERSION}])
+    SIMDJSON_CFLAGS="-DWITH_SIMDJSON ${SIMDJSON_CFLAGS}"
+    SIMDJSON_DISPLAY="${SIMDJSON_LDADD} ${SIMDJSON_LDFLAGS}, ${SIMDJSON_CFLAGS}"
+    AC_SUBST(SIMDJSON_VERSION)
+    AC_SUBST(SIMDJSON_LDFLAGS)
+    AC_SUBST(SIMDJSON_LDADD)
+    AC_SUBST(SIMDJSON_CFLAGS)
+    AC_SUBST(SIMDJSON_DISPLAY)
+fi
+
+
+AC_SUBST(SIMDJSON_FOUND)
+
+]) # AC_DEFUN [CHECK_SIMDJSON]
+
+
+AC_DEFUN([CHECK_FOR_SIMDJSON_AT], [
+    path=$1
+    echo "*** LOOKING AT PATH: " ${path}
+    for y in ${SIMDJSON_POSSIBLE_EXTENSIONS}; do
+       if test -e "${path}/libsimdjson.${y}"; then
+           simdjson_lib_path="${path}/"
+           simdjson_lib_file="${simdjson_lib_path}/libsimdjson.${y}"
+           break
+       fi
+       if test -e "${path}/lib/libsimdjson.${y}"; then
+           simdjson_lib_path="${path}/lib/"
+           simdjson_lib_file="${simdjson_lib_path}/libsimdjson.${y}"
+           break
+       fi
+       if test -e "${path}/lib64/libsimdjson.${y}"; then
+           simdjson_lib_path="${path}/lib64/"
+           simdjson_lib_file="${simdjson_lib_path}/libsimdjson.${y}"
+           break
+       fi
+       if test -e "${path}/lib/x86_64-linux-gnu/libsimdjson.${y}"; then
+           simdjson_lib_path="${path}/lib/x86_64-linux-gnu/"
+           simdjson_lib_file="${simdjson_lib_path}/libsimdjson.${y}"
+           break
+       fi
+       if test -e "${path}/lib/aarch64-linux-gnu/libsimdjson.${y}"; then
+           simdjson_lib_path="${path}/lib/aarch64-linux-gnu/"
+           simdjson_lib_file="${simdjson_lib_path}/libsimdjson.${y}"
+           break
+       fi
+    done
+    if test -e "${path}/include/simdjson.h"; then
+        simdjson_inc_path="${path}/include"
+    elif test -e "${path}/simdjson.h"; then
+        simdjson_inc_path="${path}"
+    fi
+
+    if test -n "${simdjson_lib_path}"; then
+        AC_MSG_NOTICE([simdjson library found at: ${simdjson_lib_file}])
+    fi
+
+    if test -n "${simdjson_inc_path}"; then
+        AC_MSG_NOTICE([simdjson headers found at: ${simdjson_inc_path}])
+    fi
+
+    if test -n "${simdjson_lib_path}" -a -n "${simdjson_inc_path}"; then
+        # TODO: Compile a piece of code to check the version.
+        SIMDJSON_CFLAGS="-I${simdjson_inc_path}"
+        SIMDJSON_LDADD="-lsimdjson"
+        SIMDJSON_LDFLAGS="-L${simdjson_lib_path}"
+        SIMDJSON_DISPLAY="${simdjson_lib_file}, ${simdjson_inc_path}"
+    fi
+]) # AC_DEFUN [CHECK_FOR_SIMDJSON_AT]
@@ -0,0 +1,150 @@
+dnl Check for ZLIB Libraries
+dnl CHECK_ZLIB(ACTION-IF-FOUND [, ACTION-IF-NOT-FOUND])
+
+
+AC_DEFUN([CHECK_ZLIB],
+[dnl
+
+# Possible names for the zlib library/package (pkg-config)
+ZLIB_POSSIBLE_LIB_NAMES="z"
+
+# Possible extensions for the library
+ZLIB_POSSIBLE_EXTENSIONS="so so0 la sl dll dylib so.0.0.0"
+
+# Possible paths (if pkg-config was not found, proceed with the file lookup)
+ZLIB_POSSIBLE_PATHS="/usr/lib /usr/local/lib /usr/local/zlib /usr/local /opt /usr /usr/lib64 /opt/local"
+
+# Variables to be set by this very own script.
+ZLIB_VERSION=""
+ZLIB_CFLAGS=""
+ZLIB_LDFLAGS=""
+ZLIB_LDADD=""
+ZLIB_DISPLAY=""
+
+AC_ARG_WITH(
+    zlib,
+    [AS_HELP_STRING([--with-zlib=PATH],[Path to zlib prefix])]
+)
+
+
+if test "x${with_zlib}" == "xno"; then
+    AC_DEFINE(HAVE_ZLIB, 0, [Support for ZLIB was disabled by the utilization of --without-zlib or --with-zlib=no])
+    AC_MSG_NOTICE([Support for ZLIB was disabled by the utilization of --without-zlib or --with-zlib=no])
+    ZLIB_DISABLED=yes
+else
+    if test "x${with_zlib}" == "xyes"; then
+        ZLIB_MANDATORY=yes
+        AC_MSG_NOTICE([ZLIB support was marked as mandatory by the utilization of --with-zlib=yes])
+    else
+        ZLIB_MANDATORY=no
+    fi
+    for x in ${ZLIB_POSSIBLE_PATHS}; do
+        CHECK_FOR_ZLIB_AT(${x})
+        if test -n "${ZLIB_CFLAGS}"; then
+            break
+        fi
+    done
+fi
+
+
+if test -z "${ZLIB_CFLAGS}"; then
+    if test -z "${ZLIB_MANDATORY}" || test "x${ZLIB_MANDATORY}" == "xno"; then
+        if test -z "${ZLIB_DISABLED}"; then
+            AC_MSG_NOTICE([ZLIB library was not found])
+            ZLIB_FOUND=0
+        else
+            ZLIB_FOUND=2
+        fi
+    else
+        AC_MSG_ERROR([ZLIB was explicitly referenced but it was not found])
+        ZLIB_FOUND=-1
+    fi
+else
+    ZLIB_FOUND=1
+    AC_MSG_NOTICE([using ZLIB v${ZLIB_VERSION}])
+    ZLIB_CFLAGS="-DWITH_ZLIB ${ZLIB_CFLAGS}"
+    ZLIB_DISPLAY="${ZLIB_LDADD} ${ZLIB_LDFLAGS}, ${ZLIB_CFLAGS}"
+    AC_SUBST(ZLIB_VERSION)
+    AC_SUBST(ZLIB_LDFLAGS)
+    AC_SUBST(ZLIB_LDADD)
+    AC_SUBST(ZLIB_CFLAGS)
+    AC_SUBST(ZLIB_DISPLAY)
+fi
+
+
+AC_SUBST(ZLIB_FOUND)
+
+]) # AC_DEFUN [CHECK_ZLIB]
+
+
+AC_DEFUN([CHECK_FOR_ZLIB_AT], [
+    path=$1
+    echo "*** LOOKING AT PATH: " ${path}
+    for y in ${ZLIB_POSSIBLE_EXTENSIONS}; do
+        for z in ${ZLIB_POSSIBLE_LIB_NAMES}; do
+           if test -e "${path}/${z}.${y}"; then
+               zlib_lib_path="${path}/"
+               zlib_lib_name="${z}"
+               zlib_lib_file="${zlib_lib_path}/${z}.${y}"
+               break
+           fi
+           if test -e "${path}/lib${z}.${y}"; then
+               zlib_lib_path="${path}/"
+               zlib_lib_name="${z}"
+               zlib_lib_file="${zlib_lib_path}/lib${z}.${y}"
+               break
+           fi
+           if test -e "${path}/lib/lib${z}.${y}"; then
+               zlib_lib_path="${path}/lib/"
+               zlib_lib_name="${z}"
+               zlib_lib_file="${zlib_lib_path}/lib${z}.${y}"
+               break
+           fi
+           if test -e "${path}/lib/x86_64-linux-gnu/lib${z}.${y}"; then
+               zlib_lib_path="${path}/lib/x86_64-linux-gnu/"
+               zlib_lib_name="${z}"
+               zlib_lib_file="${zlib_lib_path}/lib${z}.${y}"
+               break
+           fi
+           if test -e "${path}/lib/i386-linux-gnu/lib${z}.${y}"; then
+               zlib_lib_path="${path}/lib/i386-linux-gnu/"
+               zlib_lib_name="${z}"
+               zlib_lib_file="${zlib_lib_path}/lib${z}.${y}"
+               break
+           fi
+       done
+       if test -n "$zlib_lib_path"; then
+           break
+       fi
+    done
+    if test -e "${path}/include/zlib.h"; then
+        zlib_inc_path="${path}/include"
+        zlib_header="${path}/include/zlib.h"
+    elif test -e "${path}/zlib.h"; then
+        zlib_inc_path="${path}"
+        zlib_header="${path}/zlib.h"
+    elif test -e "${path}/include/zlib/zlib.h"; then
+        zlib_inc_path="${path}/include"
+        zlib_header="${path}/include/zlib/zlib.h"
+    fi
+
+    if test -n "${zlib_lib_path}"; then
+        AC_MSG_NOTICE([ZLIB library found at: ${zlib_lib_file}])
+    fi
+
+    if test -n "${zlib_inc_path}"; then
+        AC_MSG_NOTICE([ZLIB headers found at: ${zlib_inc_path}])
+    fi
+
+    if test -n "${zlib_lib_path}" -a -n "${zlib_inc_path}"; then
+        # zlib has no pkg-config file everywhere, its header tells the version
+        ZLIB_VERSION=`sed -n -e 's/^#define ZLIB_VERSION "\(.*\)"/\1/p' "${zlib_header}"`
+        ZLIB_CFLAGS="-I${zlib_inc_path}"
+        ZLIB_LDADD="-l${zlib_lib_name}"
+        ZLIB_LDFLAGS="-L${zlib_lib_path}"
+        ZLIB_DISPLAY="${zlib_lib_file}, ${zlib_inc_path}"
+    fi
+]) # AC_DEFUN [CHECK_FOR_ZLIB_AT]
+
+
+
@@ -14,6 +14,8 @@
  */
 
 #ifdef __cplusplus
+#include <stdint.h>
+
 #include <ctime>
 #include <fstream>
 #include <iomanip>
@@ -26,7 +28,9 @@
 #include <utility>
 #include <vector>
 #include <algorithm>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #endif
 
 #include "modsecurity/variable_value.h"
@@ -46,24 +50,41 @@ class KeyExclusions;
 }
 
 
+/*
+ * Keys (argument names, header names, collection keys) are compared
+ * ignoring the ASCII case, as tolower() does in the "C" locale, without
+ * going through the locale machinery for every byte.
+ */
+inline unsigned char foldCase(char c) {
+    unsigned char u = static_cast<unsigned char>(c);
+    return (u >= 'A' && u <= 'Z') ? static_cast<unsigned char>(u | 0x20) : u;
+}
+
+
 struct MyEqual {
     bool operator()(const std::string& Left, const std::string& Right) const {
         return Left.size() == Right.size()
              && std::equal(Left.begin(), Left.end(), Right.begin(),
             [](char a, char b) {
-            return tolower(a) == tolower(b);
+            return a == b || foldCase(a) == foldCase(b);
         });
     }
 };
 
+
+/*
+ * FNV-1a over the case folded key. The former sum of the characters put
+ * every anagram, and most of the similar names APIs like to post
+ * (item[0][id], item[1][id], ...), in the very same bucket.
+ */
 struct MyHash{
     size_t operator()(const std::string& Keyval) const {
-        // You might need a better hash function than this
-        size_t h = 0;
-        std::for_each(Keyval.begin(), Keyval.end(), [&](char c) {
-            h += tolower(c);
-        });
-        return h;
+        uint64_t h = 14695981039346656037ULL;
+        for (char c : Keyval) {
+            h ^= foldCase(c);
+            h *= 1099511628211ULL;
+        }
+        return static_cast<size_t>(h);
     }
 };
 
@@ -71,7 +92,23 @@ struct MyHash{
 class AnchoredSetVariable : public std::unordered_multimap<std::string,
 	VariableValue *, MyHash, MyEqual> {
  public:
-    AnchoredSetVariable(Transaction *t, const std::string &name);
+    /*
+     * What a set filled on first use, rather than as the request comes in,
+     * takes its elements from (see Utils::PairIndex). fill() adds the ones
+     * that are not in the set yet; find() hands out copies of those under
+     * key, in the order resolve(key) would, without filling the set.
+     */
+    class Source {
+     public:
+        virtual ~Source() { }
+        virtual void fill(AnchoredSetVariable *set) = 0;
+        virtual void find(const AnchoredSetVariable *set,
+            const std::string &key,
+            std::vector<const VariableValue *> *l) const = 0;
+    };
+
+    AnchoredSetVariable(Transaction *t, const std::string &name,
+        bool borrowable = true);
     ~AnchoredSetVariable();
 
     void unset();
@@ -84,6 +121,17 @@ class AnchoredSetVariable : public std::unordered_multimap<std::string,
 
     void setCopy(std::string key, std::string value, size_t offset);
 
+    /*
+     * The elements of source are due in the set: they are added the first
+     * time the whole set is looked at. A rule after a single key gets it
+     * from source instead, leaving the set alone. To be called again when
+     * source has more of them.
+     */
+    void setSource(Source *source) {
+        m_source = source;
+        m_pending.store(true, std::memory_order_release);
+    }
+
     void resolve(std::vector<const VariableValue *> *l);
     void resolve(std::vector<const VariableValue *> *l,
         variables::KeyExclusions &ke);
@@ -100,8 +148,52 @@ class AnchoredSetVariable : public std::unordered_multimap<std::string,
 
     std::unique_ptr<std::string> resolveFirst(const std::string &key);
 
+    /*
+     * Same as the resolve family, but the elements are the ones owned by
+     * the set: callers must not delete them and must be done with them
+     * before the set changes. Sets that change while the rules inspect
+     * them (MATCHED_VARS) are not borrowable; false is returned.
+     */
+    bool resolveBorrowed(std::vector<const VariableValue *> *l,
+        variables::KeyExclusions &ke);
+
+    bool resolveBorrowed(const std::string &key,
+        std::vector<const VariableValue *> *l);
+
+    bool resolveRegularExpressionBorrowed(Utils::Regex *r,
+        std::vector<const VariableValue *> *l,
+        variables::KeyExclusions &ke);
+
+    /*
+     * The elements in the order the resolve family hands them, kept in a
+     * flat list until the set changes, so that the rules that look at the
+     * whole set share one walk over the buckets instead of each doing
+     * its own. names() is the same for the NAME_NAMES form of them (see
+     * AnchoredSetVariableTranslationProxy), built with the given name.
+     *
+     * Rebuilt on first use after a change; the rules matched in parallel
+     * may get there together, hence the lock.
+     */
+    const std::vector<const VariableValue *> &snapshot();
+    const std::vector<const VariableValue *> &names(const std::string *name);
+
     Transaction *m_transaction;
     std::string m_name;
+    bool m_borrowable;
+
+ private:
+    void fill();
+
+    uint64_t m_generation;
+    std::atomic<uint64_t> m_snapshotGeneration;
+    std::atomic<uint64_t> m_namesGeneration;
+    std::vector<const VariableValue *> m_snapshot;
+    std::vector<const VariableValue *> m_names;
+    std::mutex m_snapshotLock;
+    /* set by setSource(), cleared once the set is filled */
+    Source *m_source;
+    std::atomic<bool> m_pending;
+    std::mutex m_fillLock;
 };
 
 }  // namespace modsecurity
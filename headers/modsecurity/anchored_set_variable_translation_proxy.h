@@ -47,11 +47,11 @@ class AnchoredSetVariableTranslationProxy {
                 VariableValue *newVariableValue = new VariableValue(name, &l->at(i)->getKey(), &l->at(i)->getKey());
                 const VariableValue *oldVariableValue = l->at(i);
                 l->at(i) = newVariableValue;
-                for (auto &oldOrigin : oldVariableValue->getOrigin()) {
-                    std::unique_ptr<VariableOrigin> newOrigin(new VariableOrigin);
-                    newOrigin->m_length = oldVariableValue->getKey().size();
-                    newOrigin->m_offset = oldOrigin->m_offset - oldVariableValue->getKey().size() - 1;
-                    newVariableValue->addOrigin(std::move(newOrigin));
+                for (const VariableOrigin &oldOrigin : oldVariableValue->getOrigin()) {
+                    VariableOrigin newOrigin;
+                    newOrigin.m_length = oldVariableValue->getKey().size();
+                    newOrigin.m_offset = oldOrigin.m_offset - oldVariableValue->getKey().size() - 1;
+                    newVariableValue->addOrigin(newOrigin);
                 }
                 delete oldVariableValue;
             }
@@ -91,6 +91,19 @@ class AnchoredSetVariableTranslationProxy {
         m_translate(&m_name, l);
     };
 
+    /* the translated values are kept by the fount, see names() there */
+    bool resolveBorrowed(std::vector<const VariableValue *> *l,
+        variables::KeyExclusions &ke);
+
+    bool resolveBorrowed(const std::string &key,
+        std::vector<const VariableValue *> *l) {
+        return false;
+    }
+
+    bool resolveRegularExpressionBorrowed(Utils::Regex *r,
+        std::vector<const VariableValue *> *l,
+        variables::KeyExclusions &ke);
+
     std::unique_ptr<std::string> resolveFirst(const std::string &key) {
         std::vector<const VariableValue *> l;
         resolve(&l);
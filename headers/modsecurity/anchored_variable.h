@@ -58,6 +58,7 @@ class AnchoredVariable {
     ~AnchoredVariable();
 
     void unset();
+    void reset();
     void set(const std::string &a, size_t offset);
     void set(const std::string &a, size_t offset, size_t offsetLen);
     void append(const std::string &a, size_t offset,
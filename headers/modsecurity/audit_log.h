@@ -31,6 +31,7 @@ namespace audit_log {
 namespace writer {
 class Writer;
 }
+class Sampler;
 
 /** @ingroup ModSecurity_CPP_API */
 class AuditLog {
@@ -44,7 +45,9 @@ class AuditLog {
      NotSetAuditLogType,
      SerialAuditLogType,
      ParallelAuditLogType,
-     HttpsAuditLogType
+     HttpsAuditLogType,
+     RingAuditLogType,
+     StreamAuditLogType
     };
 
     enum AuditLogStatus {
@@ -57,7 +60,11 @@ class AuditLog {
     enum AuditLogFormat {
      NotSetAuditLogFormat,
      JSONAuditLogFormat,
-     NativeAuditLogFormat
+     NativeAuditLogFormat,
+     /**
+      * Length prefixed MessagePack records, see Transaction::toMsgPack
+      */
+     MsgPackAuditLogFormat
     };
 
     enum AuditLogParts {
@@ -158,10 +165,16 @@ class AuditLog {
     bool setFilePath2(const std::basic_string<char>& path);
     bool setStorageDir(const std::basic_string<char>& path);
     bool setFormat(AuditLogFormat fmt);
+    bool setCompressionLevel(int level);
+    bool setRateLimit(int perMinute);
+    bool setTimings(bool timings);
 
     int getDirectoryPermission() const;
     int getFilePermission() const;
     int getParts() const;
+    int getCompressionLevel() const;
+    int getRateLimit() const;
+    bool getTimings() const;
 
     bool setParts(const std::basic_string<char>& new_parts);
     bool setType(AuditLogType audit_type);
@@ -199,6 +212,15 @@ class AuditLog {
     int m_directoryPermission;
     int m_defaultDirectoryPermission = 0750;
 
+    /* gzip level of the records, 0 (or not set) is no compression */
+    int m_compressionLevel;
+
+    /* full records a minute per rule id and client, 0 (or not set) is all */
+    int m_rateLimit;
+
+    /* time spent in each phase in the H part, off unless set to 1 */
+    int m_timings;
+
  private:
     AuditLogStatus m_status;
 
@@ -206,6 +228,7 @@ class AuditLog {
     std::string m_relevant;
 
     audit_log::writer::Writer *m_writer;
+    Sampler *m_sampler;
     bool m_ctlAuditEngineActive; // rules have at least one action On or RelevantOnly
 };
 
@@ -0,0 +1,89 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <stdint.h>
+
+#ifndef HEADERS_MODSECURITY_AUDIT_LOG_RING_H_
+#define HEADERS_MODSECURITY_AUDIT_LOG_RING_H_
+
+
+/*
+ * The layout of the file written by SecAuditLogType Ring, for the log
+ * shippers to map it and read the records in place. Everything is in the
+ * byte order of the host.
+ *
+ * The file starts with a MscAuditLogRingHeader, followed, at data_offset,
+ * by capacity bytes of records (capacity is a power of two). head and
+ * tail are positions that only grow; a position p is at byte
+ * (p & (capacity - 1)) of the data. The writers, any number of threads
+ * and processes, reserve a record by moving head with a compare and swap,
+ * as long as head - tail stays within capacity; otherwise the record is
+ * dropped and dropped is incremented. The one consumer owns tail.
+ *
+ * A record is a MscAuditLogRingRecord followed by length bytes, padded to
+ * MSC_AUDIT_LOG_RING_ALIGN. Its sequence is stored last, with release
+ * semantics, as its position plus one: the record at tail is complete
+ * once sequence, loaded with acquire semantics, is tail + 1; a stale or
+ * partly written one never matches. A record does not wrap around the
+ * end of the data; a padding record fills the space left at the end (it
+ * has kind MSC_AUDIT_LOG_RING_PADDING) and is to be skipped. Once done
+ * with a record, the consumer stores tail past it, with release
+ * semantics.
+ *
+ * The payload is a record as SecAuditLogFormat (and SecAuditLogCompress)
+ * would have it written to a file.
+ *
+ * A writer that dies between reserving a record and completing it stops
+ * the consumer at that record; the consumer may skip it after a while by
+ * moving tail past it, its length being already set.
+ */
+
+#define MSC_AUDIT_LOG_RING_MAGIC 0x4d735262
+#define MSC_AUDIT_LOG_RING_VERSION 1
+#define MSC_AUDIT_LOG_RING_ALIGN 16
+
+#define MSC_AUDIT_LOG_RING_RECORD 0
+#define MSC_AUDIT_LOG_RING_PADDING 1
+
+
+/* head, tail and the counters each on a cache line of their own */
+typedef struct MscAuditLogRingHeader_t {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t capacity;
+    uint64_t data_offset;
+    uint8_t reserved0[40];
+
+    uint64_t head;
+    uint8_t reserved1[56];
+
+    uint64_t tail;
+    uint8_t reserved2[56];
+
+    /* records written, and dropped because the ring was full */
+    uint64_t written;
+    uint64_t dropped;
+    uint8_t reserved3[48];
+} MscAuditLogRingHeader;
+
+
+typedef struct MscAuditLogRingRecord_t {
+    uint64_t sequence;
+    uint32_t length;
+    uint32_t kind;
+} MscAuditLogRingRecord;
+
+
+#endif  // HEADERS_MODSECURITY_AUDIT_LOG_RING_H_
@@ -0,0 +1,116 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#ifdef __cplusplus
+#include <cstddef>
+#include <string>
+#include <vector>
+#endif
+
+#ifndef HEADERS_MODSECURITY_BODY_BUFFER_H_
+#define HEADERS_MODSECURITY_BODY_BUFFER_H_
+
+#ifdef __cplusplus
+
+
+namespace modsecurity {
+
+
+/**
+ * Append only buffer for the request and response bodies.
+ *
+ * Data is kept in a chain of chunks that are never reallocated: appending
+ * fills the last chunk up to its capacity and then starts a new one, sized
+ * after what the buffer already holds (within kMinChunkSize and
+ * kMaxChunkSize). Consumers that can process the body piece by piece walk
+ * the chunks (see chunkCount/chunk); the others ask for str(), which
+ * merges the chain into a single chunk once and hands out a reference to
+ * it from there on. References are valid until the buffer is modified.
+ *
+ * With spoolAbove(), a buffer that grows past the limit moves what it
+ * holds to an unlinked file in the given directory and appends there from
+ * then on. A spooled buffer is a single chunk, a read only mapping of the
+ * file (see data()); str() copies it back into memory, so the consumers
+ * that care about the footprint use the chunks.
+ *
+ */
+class BodyBuffer {
+ public:
+    BodyBuffer() : m_size(0), m_reserve(0), m_spoolLimit(0), m_fd(-1),
+        m_map(nullptr), m_mapped(0) { }
+    ~BodyBuffer() { clear(); }
+
+    BodyBuffer(const BodyBuffer &b) = delete;
+    BodyBuffer &operator= (const BodyBuffer &b) = delete;
+
+    void append(const char *buf, size_t len);
+    /* Makes room for len more bytes, that then fit in one more chunk. */
+    void reserve(size_t len);
+    void clear();
+    /* Drops all but the last len bytes. */
+    void keepLast(size_t len);
+    /*
+     * Past limit bytes, the content goes to an unlinked file in dir. Set
+     * before the first append, clear() turns it off.
+     */
+    void spoolAbove(size_t limit, const std::string &dir);
+    /* Trades contents, the spooled file included, with other. */
+    void swap(BodyBuffer &other);
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    bool spooled() const { return m_fd >= 0; }
+
+    size_t chunkCount() const;
+    /* The i-th piece of the body, len bytes long. */
+    const char *chunk(size_t i, size_t *len) const;
+    /*
+     * The body in one piece: the mapping of the file when spooled (null if
+     * that fails), the merged chunks otherwise.
+     */
+    const char *data() const;
+
+    const std::string &str() const;
+
+    static const size_t kMinChunkSize = 4096;
+    static const size_t kMaxChunkSize = 1048576;
+
+ private:
+    /* str() merges the chunks, the content stays the same */
+    mutable std::vector<std::string> m_chunks;
+    size_t m_size;
+    /* the least capacity of the next chunk, from reserve() */
+    size_t m_reserve;
+
+    bool spool();
+    void unspool();
+
+    size_t m_spoolLimit;
+    std::string m_spoolDir;
+    int m_fd;
+    /* read only view of the first m_mapped bytes of the file */
+    mutable void *m_map;
+    mutable size_t m_mapped;
+    /* what str() hands out for a spooled buffer */
+    mutable std::string m_copy;
+};
+
+
+}  // namespace modsecurity
+
+#endif
+
+
+#endif  // HEADERS_MODSECURITY_BODY_BUFFER_H_
@@ -22,6 +22,7 @@
 #include <vector>
 #include <algorithm>
 #include <memory>
+#include <utility>
 #endif
 
 
@@ -68,17 +69,60 @@ class Collection {
         std::vector<const VariableValue *> *l,
         variables::KeyExclusions &ke) = 0;
 
+    /**
+     * Adds delta to the value of the first entry of key, taken as an
+     * integer (0 if it is missing or not a number), and stores the sum,
+     * which is also returned in result. Backends shared by several threads
+     * or processes override it so that the read and the write can not be
+     * interleaved with the ones of somebody else.
+     */
+    virtual bool atomicAdd(const std::string &key, int delta,
+        int *result) {
+        std::unique_ptr<std::string> current = resolveFirst(key);
+        int value = delta;
+
+        if (current != nullptr) {
+            value = toInt(*current) + delta;
+        }
+        if (result != nullptr) {
+            *result = value;
+        }
+
+        return storeOrUpdateFirst(key, std::to_string(value));
+    }
+
+    /**
+     * Fills entries with the keys (without the compartment::compartment2::
+     * they start with) and the values of a whole record, read at once.
+     * Backends that are expensive to reach per key override it, so the
+     * transaction takes a copy of the record (initcol) instead; false
+     * means there is none to take and keys are looked up one by one.
+     */
+    virtual bool resolveRecord(const std::string &compartment,
+        const std::string &compartment2,
+        std::vector<std::pair<std::string, std::string>> *entries) {
+        return false;
+    }
+
+    static int toInt(const std::string &value) {
+        try {
+            return std::stoi(value);
+        } catch (...) {
+            return 0;
+        }
+    }
+
 
     /* store */
-    virtual void store(std::string key, std::string compartment,
+    virtual void store(std::string key, const std::string &compartment,
         std::string value) {
         std::string nkey = compartment + "::" + key;
         store(nkey, value);
     }
 
 
-    virtual void store(std::string key, std::string compartment,
-        std::string compartment2, std::string value) {
+    virtual void store(std::string key, const std::string &compartment,
+        const std::string &compartment2, std::string value) {
         std::string nkey = compartment + "::" + compartment2 + "::" + key;
         store(nkey, value);
     }
@@ -86,14 +130,14 @@ class Collection {
 
     /* storeOrUpdateFirst */
     virtual bool storeOrUpdateFirst(const std::string &key,
-        std::string compartment, const std::string &value) {
+        const std::string &compartment, const std::string &value) {
         std::string nkey = compartment + "::" + key;
         return storeOrUpdateFirst(nkey, value);
     }
 
 
     virtual bool storeOrUpdateFirst(const std::string &key,
-        std::string compartment, std::string compartment2,
+        const std::string &compartment, const std::string &compartment2,
         const std::string &value) {
         std::string nkey = compartment + "::" + compartment2 + "::" + key;
         return storeOrUpdateFirst(nkey, value);
@@ -101,29 +145,46 @@ class Collection {
 
 
     /* updateFirst */
-    virtual bool updateFirst(const std::string &key, std::string compartment,
-        const std::string &value) {
+    virtual bool updateFirst(const std::string &key,
+        const std::string &compartment, const std::string &value) {
         std::string nkey = compartment + "::" + key;
         return updateFirst(nkey, value);
     }
 
 
-    virtual bool updateFirst(const std::string &key, std::string compartment,
-        std::string compartment2, const std::string &value) {
+    virtual bool updateFirst(const std::string &key,
+        const std::string &compartment, const std::string &compartment2,
+        const std::string &value) {
         std::string nkey = compartment + "::" + compartment2 + "::" + key;
         return updateFirst(nkey, value);
     }
 
 
+    /* atomicAdd */
+    virtual bool atomicAdd(const std::string &key,
+        const std::string &compartment, int delta, int *result) {
+        std::string nkey = compartment + "::" + key;
+        return atomicAdd(nkey, delta, result);
+    }
+
+
+    virtual bool atomicAdd(const std::string &key,
+        const std::string &compartment, const std::string &compartment2,
+        int delta, int *result) {
+        std::string nkey = compartment + "::" + compartment2 + "::" + key;
+        return atomicAdd(nkey, delta, result);
+    }
+
+
     /* del */
-    virtual void del(const std::string& key, std::string compartment) {
+    virtual void del(const std::string& key, const std::string &compartment) {
         std::string nkey = compartment + "::" + key;
         del(nkey);
     }
 
 
-    virtual void del(const std::string& key, std::string compartment,
-        std::string compartment2) {
+    virtual void del(const std::string& key, const std::string &compartment,
+        const std::string &compartment2) {
         std::string nkey = compartment + "::" + compartment2 + "::" + key;
         del(nkey);
     }
@@ -131,14 +192,14 @@ class Collection {
 
     /* resolveFirst */
     virtual std::unique_ptr<std::string> resolveFirst(const std::string& var,
-        std::string compartment) {
+        const std::string &compartment) {
         std::string nkey = compartment + "::" + var;
         return resolveFirst(nkey);
     }
 
 
     virtual std::unique_ptr<std::string> resolveFirst(const std::string& var,
-        std::string compartment, std::string compartment2) {
+        const std::string &compartment, const std::string &compartment2) {
         std::string nkey = compartment + "::" + compartment2 + "::" + var;
         return resolveFirst(nkey);
     }
@@ -146,14 +207,14 @@ class Collection {
 
     /* resolveSingleMatch */
     virtual void resolveSingleMatch(const std::string& var,
-        std::string compartment, std::vector<const VariableValue *> *l) {
+        const std::string &compartment, std::vector<const VariableValue *> *l) {
         std::string nkey = compartment + "::" + var;
         resolveSingleMatch(nkey, l);
     }
 
 
     virtual void resolveSingleMatch(const std::string& var,
-        std::string compartment, std::string compartment2,
+        const std::string &compartment, const std::string &compartment2,
         std::vector<const VariableValue *> *l) {
         std::string nkey = compartment + "::" + compartment2 + "::" + var;
         resolveSingleMatch(nkey, l);
@@ -162,7 +223,7 @@ class Collection {
 
     /* resolveMultiMatches */
     virtual void resolveMultiMatches(const std::string& var,
-        std::string compartment, std::vector<const VariableValue *> *l,
+        const std::string &compartment, std::vector<const VariableValue *> *l,
         variables::KeyExclusions &ke) {
         std::string nkey = compartment + "::" + var;
         resolveMultiMatches(nkey, l, ke);
@@ -170,7 +231,7 @@ class Collection {
 
 
     virtual void resolveMultiMatches(const std::string& var,
-        std::string compartment, std::string compartment2,
+        const std::string &compartment, const std::string &compartment2,
         std::vector<const VariableValue *> *l,
         variables::KeyExclusions &ke) {
         std::string nkey = compartment + "::" + compartment2 + "::" + var;
@@ -180,7 +241,7 @@ class Collection {
 
     /* resolveRegularExpression */
     virtual void resolveRegularExpression(const std::string& var,
-        std::string compartment, std::vector<const VariableValue *> *l,
+        const std::string &compartment, std::vector<const VariableValue *> *l,
         variables::KeyExclusions &ke) {
         std::string nkey = compartment + "::" + var;
         resolveRegularExpression(nkey, l, ke);
@@ -188,7 +249,7 @@ class Collection {
 
 
     virtual void resolveRegularExpression(const std::string& var,
-        std::string compartment, std::string compartment2,
+        const std::string &compartment, const std::string &compartment2,
         std::vector<const VariableValue *> *l, variables::KeyExclusions &ke) {
         std::string nkey = compartment + "::" + compartment2 + "::" + var;
         resolveRegularExpression(nkey, l, ke);
@@ -52,6 +52,20 @@ class Collections {
     Collections(const Collections &c) = delete;
     Collections& operator =(const Collections &c) = delete;
 
+    void reset();
+
+    /**
+     * Has the transaction use a copy of the record compartment (the
+     * initcol, setsid... key) of compartment2 (the SecWebAppId) in place
+     * of *collection, if its backend can hand it over at once. A copy of
+     * another record in there is flushed first.
+     */
+    void snapshot(Collection **collection, const std::string &compartment,
+        const std::string &compartment2);
+
+    /* Writes the copies back and puts the backends in their place again. */
+    void flush();
+
     std::string m_global_collection_key;
     std::string m_ip_collection_key;
     std::string m_session_collection_key;
@@ -64,6 +78,10 @@ class Collections {
     Collection *m_user_collection;
     Collection *m_resource_collection;
     Collection *m_tx_collection;
+
+ private:
+    /* The members above that have a copy in them. */
+    std::vector<Collection **> m_snapshots;
 };
 
 }  // namespace collection
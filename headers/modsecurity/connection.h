@@ -0,0 +1,113 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#ifdef __cplusplus
+#include <pthread.h>
+#include <stdint.h>
+
+#include <ctime>
+#include <map>
+#include <memory>
+#include <string>
+#endif
+
+
+#ifndef HEADERS_MODSECURITY_CONNECTION_H_
+#define HEADERS_MODSECURITY_CONNECTION_H_
+
+#ifndef __cplusplus
+typedef struct Connection_t Connection;
+#endif
+
+#include "modsecurity/transaction.h"
+
+#ifdef __cplusplus
+
+namespace modsecurity {
+namespace Utils {
+struct GeoRecord;
+}
+
+
+/**
+ * A client connection, shared by the transactions of its requests:
+ * the ones of keep-alive and the streams of HTTP/2.
+ *
+ * The addresses are kept once, the client one already parsed, and what
+ * the rules work out from the client address alone is remembered for
+ * the next requests: the @geoLookup record and the @rbl answers, the
+ * last for as long as their DNS TTL.
+ *
+ * The transactions attached to it (see Transaction::processConnection)
+ * may run on different threads, but it has to outlive them.
+ */
+/** @ingroup ModSecurity_CPP_API */
+class Connection {
+ public:
+    Connection(const char *client, int cPort, const char *server, int sPort);
+    ~Connection();
+
+    Connection(const Connection &) = delete;
+    Connection &operator=(const Connection &) = delete;
+
+    std::shared_ptr<const Utils::GeoRecord> geoRecord() const;
+    void setGeoRecord(std::shared_ptr<const Utils::GeoRecord> record);
+
+    /* result is an Utils::DnsResult, addr in network byte order */
+    bool rblAnswer(const std::string &host, int *result,
+        uint32_t *addr) const;
+    void setRblAnswer(const std::string &host, int result, uint32_t addr,
+        time_t expires);
+
+    const std::shared_ptr<std::string> m_clientIpAddress;
+    const std::shared_ptr<std::string> m_serverIpAddress;
+    const int m_clientPort;
+    const int m_serverPort;
+
+    /* as Transaction::m_clientIpFamily and m_clientIpBinary */
+    int m_clientIpFamily;
+    unsigned char m_clientIpBinary[16];
+
+ private:
+    struct RblAnswer {
+        int m_result;
+        uint32_t m_addr;
+        time_t m_expires;
+    };
+
+    mutable pthread_mutex_t m_lock;
+    std::shared_ptr<const Utils::GeoRecord> m_geoRecord;
+    std::map<std::string, RblAnswer> m_rblAnswers;
+};
+
+
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+Connection *msc_new_connection(const char *client, int cPort,
+    const char *server, int sPort);
+void msc_connection_cleanup(Connection *connection);
+int msc_process_connection_context(Transaction *transaction,
+    Connection *connection);
+
+#ifdef __cplusplus
+}
+}  // namespace modsecurity
+#endif
+
+#endif  // HEADERS_MODSECURITY_CONNECTION_H_
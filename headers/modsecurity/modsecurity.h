@@ -174,6 +174,7 @@ namespace modsecurity {
 #include "modsecurity/intervention.h"
 #include "modsecurity/transaction.h"
 #include "modsecurity/debug_log.h"
+#include "modsecurity/trace.h"
 
 /**
  * TAG_NUM:
@@ -221,6 +222,28 @@ namespace modsecurity {
 typedef void (*ModSecLogCb) (void *, const void *);
 
 
+/*
+ * @name    ModSecAllocator
+ * @brief   Allocator for what the library allocates on its own
+ *
+ *
+ * Handed to msc_set_allocator(). All three functions are to be set;
+ * realloc and free semantics are the ones of the C library, NULL
+ * included.
+ *
+ *
+ * data     Internal reference to be used by the API consumer, passed on
+ *          every call (e.g. the arena of the worker).
+ *
+ */
+typedef struct ModSecAllocator_t {
+    void *(*allocate)(void *data, size_t size);
+    void *(*reallocate)(void *data, void *ptr, size_t size);
+    void (*release)(void *data, void *ptr);
+    void *data;
+} ModSecAllocator;
+
+
 #ifdef __cplusplus
 namespace modsecurity {
 
@@ -229,7 +252,13 @@ namespace modsecurity {
 namespace actions {
 class Action;
 }
+namespace Utils {
+class AsyncRunner;
+class ServerLogQueue;
+}
 class RuleWithOperator;
+class RulesHandle;
+class RulesSetRouter;
 
 #ifdef __cplusplus
 extern "C" {
@@ -264,6 +293,16 @@ extern "C" {
      *
     */
      IncludeFullHighlightLogProperty = 4,
+    /**
+     * The callback is called from a thread of its own, after the fact,
+     * with the message formatted (TextLogProperty) on that thread too.
+     * The data given to the transaction has to stay valid until then,
+     * as do the RuleMessage and its rule for RuleMessageLogProperty:
+     * connectors call msc_drain_server_log() before freeing it.
+     * Messages are dropped, and counted, when too many are waiting.
+     *
+     */
+     AsyncLogProperty = 8,
     };
 
 
@@ -293,9 +332,76 @@ class ModSecurity {
     void setServerLogCb(ModSecLogCb cb, int properties);
 
     void serverLog(void *data, std::shared_ptr<RuleMessage> rm);
+    /**
+     * As above; with AsyncLogProperty, rules (the version of the rules of
+     * the transaction, if it has one) is kept alive until the message was
+     * delivered.
+     */
+    void serverLog(void *data, std::shared_ptr<RuleMessage> rm,
+        const std::shared_ptr<RulesSet> &rules);
+    void drainServerLog();
 
     const std::string& getConnectorInformation() const;
 
+    /**
+     * Engine counters of the whole process (transactions, interventions
+     * by rule id, PCRE limits hits, audit log failures, body processor
+     * errors, collection backend latencies, waits for the shared locks)
+     * in the Prometheus text format.
+     */
+    std::string metrics() const;
+
+    /**
+     * A handle to reload rules, taking the ownership of the initial set
+     * (see rules_handle.h). It lives as long as this instance does.
+     */
+    RulesHandle *createRulesHandle(RulesSet *rules);
+
+    /**
+     * A router picking the rules of a transaction by its Host header (see
+     * rules_set_router.h). It lives as long as this instance does.
+     */
+    RulesSetRouter *createRulesSetRouter();
+
+    /**
+     * Number of threads the non blocking transactions hand the phases
+     * that may block over to (see Transaction::setNonBlocking), 4 unless
+     * set. To be set before the first transaction of the instance.
+     */
+    void setAsyncThreads(size_t threads);
+    Utils::AsyncRunner *asyncRunner() const { return m_asyncRunner; }
+
+    /**
+     * Threads the transactions are run again on, against SecShadowRules,
+     * and how many may wait for one of them before the next ones are not
+     * shadowed; 2 and 256 unless set. To be set before the first
+     * transaction of the instance.
+     */
+    void setShadowThreads(size_t threads, size_t queueLimit);
+    Utils::AsyncRunner *shadowRunner() const { return m_shadowRunner; }
+
+    /**
+     * Threads the multipart parser hands the file parts it is done with
+     * over to, so that their temporary files are closed and read back
+     * while the parts after them are parsed, and how many may wait for
+     * one of them before the next ones are finished on the request
+     * thread. None unless set; 0 threads takes them away again. To be set
+     * before the first transaction of the instance.
+     */
+    void setUploadThreads(size_t threads, size_t queueLimit);
+    Utils::AsyncRunner *uploadRunner() const { return m_uploadRunner; }
+
+    /**
+     * Spans of the transactions given a parent (see trace.h and
+     * Transaction::setTraceParent): one per processing call, and one per
+     * operator or variable of a rule that took thresholdUs or longer. To
+     * be set before the first transaction; NULL turns tracing off.
+     */
+    void setTraceCb(ModSecTraceCb cb, uint64_t thresholdUs);
+    ModSecTraceCb traceCb() const { return m_traceCb; }
+    /* in nanoseconds */
+    uint64_t traceThreshold() const { return m_traceThreshold; }
+
     static int processContentOffset(const char *content, size_t len,
         const char *matchString, std::string *json, const char **err);
 
@@ -308,8 +414,18 @@ class ModSecurity {
  private:
     std::string m_connector;
     std::string m_whoami;
+    void deliverServerLog(void *data, const std::shared_ptr<RuleMessage> &rm);
+
     ModSecLogCb m_logCb;
     int m_logProperties;
+    Utils::ServerLogQueue *m_serverLogQueue;
+    Utils::AsyncRunner *m_asyncRunner;
+    Utils::AsyncRunner *m_shadowRunner;
+    Utils::AsyncRunner *m_uploadRunner;
+    std::vector<RulesHandle *> m_rulesHandles;
+    std::vector<RulesSetRouter *> m_rulesSetRouters;
+    ModSecTraceCb m_traceCb;
+    uint64_t m_traceThreshold;
 };
 
 
@@ -328,7 +444,24 @@ void msc_set_connector_info(ModSecurity *msc, const char *connector);
 /** @ingroup ModSecurity_C_API */
 void msc_set_log_cb(ModSecurity *msc, ModSecLogCb cb);
 /** @ingroup ModSecurity_C_API */
+void msc_drain_server_log(ModSecurity *msc);
+/** @ingroup ModSecurity_C_API */
 void msc_cleanup(ModSecurity *msc);
+/** @ingroup ModSecurity_C_API */
+char *msc_metrics_render(ModSecurity *msc);
+/** @ingroup ModSecurity_C_API */
+void msc_set_async_threads(ModSecurity *msc, size_t threads);
+/** @ingroup ModSecurity_C_API */
+void msc_set_shadow_threads(ModSecurity *msc, size_t threads,
+    size_t queue_limit);
+/** @ingroup ModSecurity_C_API */
+void msc_set_upload_threads(ModSecurity *msc, size_t threads,
+    size_t queue_limit);
+/** @ingroup ModSecurity_C_API */
+int msc_set_allocator(const ModSecAllocator *allocator);
+/** @ingroup ModSecurity_C_API */
+void msc_set_trace_cb(ModSecurity *msc, ModSecTraceCb cb,
+    uint64_t threshold_us);
 
 #ifdef __cplusplus
 }
@@ -93,7 +93,11 @@ class Rule {
     virtual bool evaluate(Transaction *transaction,
         std::shared_ptr<RuleMessage> rm) = 0;
 
-    std::shared_ptr<std::string> getFileName() const {
+    /*
+     * A reference, so that asking for it from a transaction does not touch
+     * the reference count unless the caller keeps a copy.
+     */
+    const std::shared_ptr<std::string> &getFileName() const {
         return m_fileName;
     }
 
@@ -52,6 +52,7 @@ class RuleMessage {
         m_accuracy(rule->m_accuracy),
         m_clientIpAddress(trans->m_clientIpAddress),
         m_data(""),
+        m_details(""),
         m_id(trans->m_id),
         m_isDisruptive(false),
         m_match(""),
@@ -77,6 +78,7 @@ class RuleMessage {
         m_accuracy(rule->m_accuracy),
         m_clientIpAddress(rule->m_clientIpAddress),
         m_data(rule->m_data),
+        m_details(rule->m_details),
         m_id(rule->m_id),
         m_isDisruptive(rule->m_isDisruptive),
         m_match(rule->m_match),
@@ -102,6 +104,7 @@ class RuleMessage {
         : m_accuracy(ruleMessage.m_accuracy),
         m_clientIpAddress(ruleMessage.m_clientIpAddress),
         m_data(ruleMessage.m_data),
+        m_details(ruleMessage.m_details),
         m_id(ruleMessage.m_id),
         m_isDisruptive(ruleMessage.m_isDisruptive),
         m_match(ruleMessage.m_match),
@@ -127,6 +130,7 @@ class RuleMessage {
         m_accuracy = ruleMessage.m_accuracy;
         m_clientIpAddress = ruleMessage.m_clientIpAddress;
         m_data = ruleMessage.m_data;
+        m_details = ruleMessage.m_details;
         m_id = ruleMessage.m_id;
         m_isDisruptive = ruleMessage.m_isDisruptive;
         m_match = ruleMessage.m_match;
@@ -149,6 +153,36 @@ class RuleMessage {
         return *this;
     }
 
+    /**
+     * Makes the message look like it was just constructed for rule and
+     * trans, reusing the storage the strings already have.
+     */
+    void reset(RuleWithActions *rule, Transaction *trans) {
+        m_accuracy = rule->m_accuracy;
+        m_clientIpAddress = trans->m_clientIpAddress;
+        m_data.clear();
+        m_details.clear();
+        m_id = trans->m_id;
+        m_isDisruptive = false;
+        m_match.clear();
+        m_maturity = rule->m_maturity;
+        m_message.clear();
+        m_noAuditLog = false;
+        m_phase = rule->getPhase() - 1;
+        m_reference.clear();
+        m_rev = rule->m_rev;
+        m_rule = rule;
+        m_ruleFile = rule->getFileName();
+        m_ruleId = rule->m_ruleId;
+        m_ruleLine = rule->getLineNumber();
+        m_saveMessage = true;
+        m_serverIpAddress = trans->m_serverIpAddress;
+        m_severity = 0;
+        m_uriNoQueryStringDecoded = trans->m_uri_no_query_string_decoded;
+        m_ver = rule->m_ver;
+        m_tags.clear();
+    }
+
     void clean() {
         m_data = "";
         m_match = "";
@@ -180,12 +214,23 @@ class RuleMessage {
         return log(rm, 0);
     }
 
+    /**
+     * Formats what log() takes from the rule, while the rule is known to
+     * be alive: a copy logged later on, on another thread, no longer
+     * reads it.
+     */
+    void formatDetails() {
+        m_details = _details(this);
+    }
+
     static std::string _details(const RuleMessage *rm);
     static std::string _errorLogTail(const RuleMessage *rm);
 
     int m_accuracy;
     std::shared_ptr<std::string> m_clientIpAddress;
     std::string m_data;
+    /* set by formatDetails(), what _details() gives from then on */
+    std::string m_details;
     std::shared_ptr<std::string> m_id;
     bool m_isDisruptive;
     std::string m_match;
@@ -62,10 +62,19 @@ class RuleWithActions : public Rule {
         m_actionsSetVar(r.m_actionsSetVar),
         m_actionsTag(r.m_actionsTag),
         m_transformations(r.m_transformations),
+        m_transformationsChain(r.m_transformationsChain),
+        m_fusedTransformations(r.m_fusedTransformations),
+        m_tagIds(r.m_tagIds),
+        m_msgId(r.m_msgId),
+        m_logDetails(r.m_logDetails),
         m_containsCaptureAction(r.m_containsCaptureAction),
+        m_containsCtlAction(r.m_containsCtlAction),
         m_containsMultiMatchAction(r.m_containsMultiMatchAction),
+        m_containsNoVerdictCacheAction(r.m_containsNoVerdictCacheAction),
         m_containsStaticBlockAction(r.m_containsStaticBlockAction),
-        m_isChained(r.m_isChained)
+        m_isChained(r.m_isChained),
+        m_tagsContainMacro(r.m_tagsContainMacro),
+        m_containsNoneTransformation(r.m_containsNoneTransformation)
     { }
 
     RuleWithActions &operator=(const RuleWithActions& r) {
@@ -87,11 +96,21 @@ class RuleWithActions : public Rule {
         m_actionsTag = r.m_actionsTag;
 
         m_transformations = r.m_transformations;
+        m_transformationsChain = r.m_transformationsChain;
+        m_fusedTransformations = r.m_fusedTransformations;
+
+        m_tagIds = r.m_tagIds;
+        m_msgId = r.m_msgId;
+        m_logDetails = r.m_logDetails;
 
         m_containsCaptureAction = r.m_containsCaptureAction;
+        m_containsCtlAction = r.m_containsCtlAction;
         m_containsMultiMatchAction = r.m_containsMultiMatchAction;
+        m_containsNoVerdictCacheAction = r.m_containsNoVerdictCacheAction;
         m_containsStaticBlockAction = r.m_containsStaticBlockAction;
         m_isChained = r.m_isChained;
+        m_tagsContainMacro = r.m_tagsContainMacro;
+        m_containsNoneTransformation = r.m_containsNoneTransformation;
 
         return *this;
     }
@@ -118,16 +137,34 @@ class RuleWithActions : public Rule {
         bool context);
 
 
+    /*
+     * cached is false off the transaction thread: the transformation cache
+     * of the transaction is not meant to be shared.
+     */
     void executeTransformations(
-        Transaction *trasn, const std::string &value, TransformationResults &ret);
-
+        Transaction *trasn, const std::string &value, TransformationResults &ret,
+        bool cached = true);
+    void compileTransformations();
+    void compileLogDetails();
+    void getTransformationsChain(const RulesSet *rules,
+        std::vector<actions::transformations::Transformation *> *chain)
+        const;
+    std::string getTransformationsKey(
+        const std::vector<actions::transformations::Transformation *> &chain)
+        const;
+
+    /*
+     * seen holds the hashes of the values already in ret, for multiMatch
+     * to test each distinct one once.
+     */
     inline void executeTransformation(
         actions::transformations::Transformation *a,
-        std::shared_ptr<std::string> *value,
+        std::string *value,
         Transaction *trans,
         TransformationResults *ret,
         std::string *path,
-        int *nth) const;
+        int *nth,
+        std::vector<size_t> *seen) const;
 
 
     void performLogging(Transaction *trans,
@@ -139,13 +176,39 @@ class RuleWithActions : public Rule {
         Transaction *t);
     bool containsTag(const std::string& name, Transaction *t);
     bool containsMsg(const std::string& name, Transaction *t);
+    bool containsTag(int id, const std::string& name, Transaction *t);
+    bool containsMsg(int id, const std::string& name, Transaction *t);
+    bool msgContainsMacro() const;
+    bool tagsContainMacro() const;
+    bool hasTransformations(const RulesSet *rules) const;
+    /**
+     * Whether the actions of this link of the chain leave nothing behind
+     * but TX, and noVerdictCache is not one of them (see
+     * Utils::VerdictCache::cacheable); *inputs gets what their macros read.
+     */
+    bool hasVerdictCacheableActions(unsigned int *inputs) const;
+    /* Whether initcol or a setvar of this link reaches IP, SESSION, ... */
+    bool hasPersistentCollectionActions() const;
+    /**
+     * Bytes held by this link of the chain, actions included, and by
+     * the ones chained after it (see RulesSet::memoryUsage).
+     */
+    virtual size_t memoryUsage() const;
+    /* As given to the rule, t:none included. */
+    const Transformations &getTransformations() const {
+        return m_transformations;
+    }
 
     inline bool isChained() const { return m_isChained == true; }
     inline bool hasCaptureAction() const { return m_containsCaptureAction == true; }
+    inline bool hasCtlAction() const { return m_containsCtlAction == true; }
     inline void setChained(bool b) { m_isChained = b; }
     inline bool hasDisruptiveAction() const { return m_disruptiveAction != NULL; }
     inline bool hasBlockAction() const { return m_containsStaticBlockAction == true; }
     inline bool hasMultimatch() const { return m_containsMultiMatchAction == true; }
+    inline bool hasNoVerdictCache() const {
+        return m_containsNoVerdictCacheAction == true;
+    }
 
     inline bool hasLogData() const { return m_logData != NULL; }
     std::string logData(Transaction *t);
@@ -154,6 +217,40 @@ class RuleWithActions : public Rule {
     inline bool hasSeverity() const { return m_severity != NULL; }
     int severity() const;
 
+    /*
+     * The rule metadata as RuleMessage::log writes it, escaped once when
+     * the rule is built. Along with each part go the values it was made
+     * of, so that a message that no longer agrees with them (it was
+     * reset for another rule, a tag had a macro) is written field by
+     * field instead.
+     */
+    struct LogDetails {
+        LogDetails()
+            : m_fileName(nullptr),
+            m_lineNumber(0),
+            m_ruleId(0),
+            m_accuracy(0),
+            m_maturity(0) { }
+
+        const std::string *m_fileName;
+        int m_lineNumber;
+        int64_t m_ruleId;
+        std::string m_rev;
+        /* [file][line][id][rev] */
+        std::string m_head;
+
+        std::string m_ver;
+        int m_accuracy;
+        int m_maturity;
+        /* [ver][maturity][accuracy] */
+        std::string m_middle;
+
+        std::vector<std::string> m_tagNames;
+        /* One [tag] per entry in m_tagNames. */
+        std::string m_tags;
+    };
+    const LogDetails &logDetails() const { return m_logDetails; }
+
     std::string m_rev;
     std::string m_ver;
     int m_accuracy;
@@ -177,11 +274,32 @@ class RuleWithActions : public Rule {
 
     /* actions > transformations */
     Transformations m_transformations;
+    /*
+     * What is actually executed out of m_transformations: what follows the
+     * last t:none, with the Fused runs in place (see Fused::optimize).
+     */
+    Transformations m_transformationsChain;
+    std::vector<std::shared_ptr<actions::transformations::Transformation>>
+        m_fusedTransformations;
+
+    /*
+     * Interned (see Utils::InternedStrings) tags and msg, only meaningful
+     * when they are free of macros. m_tagIds is indexed by the tag id,
+     * m_msgId is -1 if there is no static msg.
+     */
+    std::vector<bool> m_tagIds;
+    int m_msgId;
+
+    LogDetails m_logDetails;
 
     bool m_containsCaptureAction:1;
+    bool m_containsCtlAction:1;
     bool m_containsMultiMatchAction:1;
+    bool m_containsNoVerdictCacheAction:1;
     bool m_containsStaticBlockAction:1;
     bool m_isChained:1;
+    bool m_tagsContainMacro:1;
+    bool m_containsNoneTransformation:1;
 };
 
 }  // namespace modsecurity
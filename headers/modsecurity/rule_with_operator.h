@@ -34,6 +34,12 @@
 #ifdef __cplusplus
 
 namespace modsecurity {
+class RulePrefetch;
+class RulesExceptions;
+class RulesSet;
+namespace Utils {
+class Regex;
+}
 
 
 class RuleWithOperator : public RuleWithActions {
@@ -52,24 +58,106 @@ class RuleWithOperator : public RuleWithActions {
 
     void getVariablesExceptions(Transaction *t,
         variables::Variables *exclusion, variables::Variables *addition);
-    inline void getFinalVars(variables::Variables *vars,
-        variables::Variables *eclusion, Transaction *trans);
+    void getVariablesExceptions(RulesExceptions *exceptions, Transaction *t,
+        variables::Variables *exclusion, variables::Variables *addition);
+    void getTargetsRemovedAtRunTime(Transaction *trans,
+        std::vector<const std::string *> *targets);
+    void getFinalVars(RulesExceptions *exceptions,
+        variables::Variables *vars, variables::Variables *eclusion,
+        Transaction *trans);
+    bool hasStaticFinalVars(const RulesExceptions &exceptions) const;
+    std::string getEffectiveTargets(const RulesSet *rules);
 
     bool executeOperatorAt(Transaction *trasn, const std::string &key,
         const std::string &value, std::shared_ptr<RuleMessage> rm);
 
+    /**
+     * Whether matching this rule only reads the transaction, so that it
+     * can be done on another thread while the rules before it run their
+     * actions: the operator is safe for it, its parameter has no macros,
+     * there is no capture and the targets are all request or response
+     * data no action can change. Only meaningful once the targets of the
+     * set are compiled.
+     */
+    bool isParallelSafe(const RulesSet *rules) const;
+    /**
+     * Whether this link of the chain can be left out of the evaluation
+     * by SecVerdictCache (see Utils::VerdictCache): neither the operator
+     * (an external lookup), the targets, the macros nor the actions
+     * depend on anything but the request and TX. *inputs gets what of
+     * the client and server addresses it reads.
+     */
+    bool isVerdictCacheable(const RulesSet *rules,
+        unsigned int *inputs) const;
+    /**
+     * Whether matching this link of the chain may block on I/O: the
+     * operator is an external lookup or, with redis (the persistent
+     * collections are on Redis), a target or an action reaches one of
+     * them. See Transaction::setNonBlocking.
+     */
+    bool mayBlock(const RulesSet *rules, bool redis) const;
+
+    size_t memoryUsage() const override;
+    /**
+     * Whether the operator only reads the transaction, whatever the
+     * parameter and the targets are (see Operator::parallelSafe).
+     */
+    bool hasReadOnlyOperator() const;
+    /**
+     * Whether one of the variables of this link of the chain is name,
+     * in any case (e.g. "TX:MSC_TIME_BUDGET_EXCEEDED").
+     */
+    bool hasTarget(const std::string &name) const;
+    /**
+     * The regular expression of an @rx rule that looks at REQUEST_BODY
+     * alone, as is, so that it can be matched while the body is appended
+     * (see Utils::RegexStreams). nullptr for any other rule.
+     */
+    const Utils::Regex *requestBodyRegex(const RulesSet *rules) const;
+    void prefetch(Transaction *trans, RulePrefetch *out);
+    static void prefetchValueMajor(
+        const std::vector<RuleWithOperator *> &rules, Transaction *trans,
+        const std::vector<RulePrefetch *> &out);
+    bool hasSameTargets(const RuleWithOperator *other,
+        const RulesSet *rules) const;
+
     static void updateMatchedVars(Transaction *trasn, const std::string &key,
         const std::string &value);
     static void cleanMatchedVars(Transaction *trasn);
 
 
     std::string getOperatorName() const;
+    std::string getOperatorBackend() const;
+    operators::Operator *getOperator() const { return m_operator; }
+    /**
+     * What is known at load time to make the rule slower than it needs
+     * to be, one remark per entry (see rules-check -p).
+     */
+    std::vector<std::string> getPerformanceHints() const;
+    /**
+     * A rough idea of what the rule costs for each transaction: "low",
+     * "medium", "high" or "very high", out of the operator, the targets
+     * and the transformations.
+     */
+    std::string getCostClass(const RulesSet *rules) const;
 
     virtual std::string getReference() override {
         return std::to_string(m_ruleId);
     }
 
  private:
+    template <typename OnValue>
+    void matchValues(Transaction *trans, std::shared_ptr<RuleMessage> rm,
+        OnValue onValue, uint64_t *transformationNs, uint64_t *operatorNs,
+        size_t *values, bool cached);
+    template <typename OnValue>
+    void matchValue(Transaction *trans, std::shared_ptr<RuleMessage> rm,
+        const VariableValue *v, OnValue onValue, uint64_t *transformationNs,
+        uint64_t *operatorNs, size_t *values, bool cached);
+    void handleMatch(Transaction *trans, const std::string &key,
+        const std::string &value, const std::string &transformed,
+        bool *containsBlock, std::shared_ptr<RuleMessage> rm);
+
     modsecurity::variables::Variables *m_variables;
     operators::Operator *m_operator;
 };
@@ -44,6 +44,23 @@ class Variable;
 
 class RulesExceptions {
  public:
+    /**
+     * SecRuleUpdateTargetByTag / SecRuleUpdateTargetByMsg entry, with the
+     * tag (or msg) already interned. This is what the rules walk at run
+     * time; the multimaps are kept for whoever inspects the exceptions.
+     */
+    class UpdateTarget {
+     public:
+        UpdateTarget(int id, std::shared_ptr<std::string> name,
+            std::shared_ptr<variables::Variable> variable);
+
+        int m_id;
+        std::shared_ptr<std::string> m_name;
+        std::shared_ptr<variables::Variable> m_variable;
+        /* m_variable base when it is an exclusion (!VAR), nullptr otherwise */
+        variables::Variable *m_exclusion;
+    };
+
     RulesExceptions();
     ~RulesExceptions();
 
@@ -53,6 +70,11 @@ class RulesExceptions {
     bool contains(int a);
     bool merge(RulesExceptions *from);
 
+    /* Whether any SecRuleRemoveById/ByMsg/ByTag was loaded */
+    bool removesRules() const;
+    /* Whether any SecRuleUpdateTargetById/ByMsg/ByTag was loaded */
+    bool updatesTargets() const;
+
     bool loadRemoveRuleByMsg(const std::string &msg, std::string *error);
     bool loadRemoveRuleByTag(const std::string &msg, std::string *error);
 
@@ -84,6 +106,8 @@ class RulesExceptions {
         std::shared_ptr<actions::Action>> m_action_pos_update_target_by_id;
     std::list<std::string> m_remove_rule_by_msg;
     std::list<std::string> m_remove_rule_by_tag;
+    std::vector<UpdateTarget> m_update_target_by_tag;
+    std::vector<UpdateTarget> m_update_target_by_msg;
 
  private:
     std::list<std::pair<int, int> > m_ranges;
@@ -0,0 +1,141 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#ifdef __cplusplus
+#include <pthread.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#endif
+
+
+#ifndef HEADERS_MODSECURITY_RULES_HANDLE_H_
+#define HEADERS_MODSECURITY_RULES_HANDLE_H_
+
+#ifndef __cplusplus
+typedef struct RulesHandle_t RulesHandle;
+#endif
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/transaction.h"
+
+#ifdef __cplusplus
+
+namespace modsecurity {
+
+
+/**
+ * The rules a server is running with, replaced while transactions are
+ * being inspected.
+ *
+ * A new transaction takes the current version with an atomic load of a
+ * shared_ptr and keeps it until it is deleted, so the transactions in
+ * flight finish with the rules they started with. A replaced version is
+ * freed as soon as the last of them is gone, by whichever thread deletes
+ * it.
+ *
+ * reloadFromUris() builds the new version on a thread of its own; only
+ * one reload runs at a time, and a set that fails to load is not
+ * installed. The files that did not change since the current version
+ * was loaded are not parsed again (see RulesSet::loadFromUri). The
+ * handles are owned by the ModSecurity instance that created them (see
+ * ModSecurity::createRulesHandle).
+ *
+ * With AsyncLogProperty, the messages still waiting to be delivered keep
+ * the version of their transaction alive as well.
+ */
+/** @ingroup ModSecurity_CPP_API */
+class RulesHandle {
+ public:
+    /* takes ownership of rules */
+    explicit RulesHandle(RulesSet *rules);
+    ~RulesHandle();
+
+    RulesHandle(const RulesHandle &) = delete;
+    RulesHandle &operator=(const RulesHandle &) = delete;
+
+    std::shared_ptr<RulesSet> current() const {
+        return std::atomic_load(&m_current);
+    }
+
+    /* 1 for the set given to the constructor, bumped on every swap */
+    unsigned long version() const { return m_version.load(); }
+
+    /* installs rules, already loaded, as the new version; takes ownership */
+    void swap(RulesSet *rules);
+
+    /*
+     * Starts loading uris, in that order, into a new set, which replaces
+     * the current one when it loads fine. False if a reload is still
+     * running or the thread could not be started; one that is over does
+     * not need to be waited for first (its result is then lost).
+     */
+    bool reloadFromUris(const std::vector<std::string> &uris);
+    bool reloadFromUri(const std::string &uri) {
+        return reloadFromUris(std::vector<std::string>(1, uri));
+    }
+
+    /*
+     * Waits for the reload started last: 1 if it was installed, -1 if it
+     * failed (error tells why), 0 if there was none.
+     */
+    int wait(std::string *error);
+
+    Transaction *newTransaction(ModSecurity *ms, void *logCbData);
+    Transaction *newTransaction(ModSecurity *ms, char *id, void *logCbData);
+
+ private:
+    static void *run(void *data);
+
+    std::shared_ptr<RulesSet> m_current;
+    std::atomic<unsigned long> m_version;
+
+    /* the reload fields; the thread is joined by wait() */
+    pthread_mutex_t m_lock;
+    pthread_t m_thread;
+    bool m_reloading;
+    /* set by the thread as it returns, m_reloading until it is joined */
+    std::atomic<bool> m_finished;
+    std::vector<std::string> m_uris;
+    std::string m_error;
+    int m_result;
+};
+
+
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+RulesHandle *msc_create_rules_handle(ModSecurity *msc, RulesSet *rules);
+unsigned long msc_rules_handle_swap(RulesHandle *handle, RulesSet *rules);
+int msc_rules_handle_reload_file(RulesHandle *handle, const char *file);
+int msc_rules_handle_reload_files(RulesHandle *handle, const char **files,
+    size_t count);
+int msc_rules_handle_wait(RulesHandle *handle, const char **error);
+unsigned long msc_rules_handle_version(RulesHandle *handle);
+Transaction *msc_new_transaction_from_handle(ModSecurity *ms,
+    RulesHandle *handle, void *logCbData);
+
+#ifdef __cplusplus
+}
+}  // namespace modsecurity
+#endif
+
+#endif  // HEADERS_MODSECURITY_RULES_HANDLE_H_
@@ -22,6 +22,8 @@
 #include <string>
 #include <vector>
 #include <list>
+#include <memory>
+#include <unordered_map>
 #endif
 
 
@@ -37,33 +39,49 @@
 #ifdef __cplusplus
 
 namespace modsecurity {
+class HeaderRules;
+class NativeMatch;
+class NativeModule;
+class UriRules;
 class RuleWithOperator;
+namespace operators {
+class Operator;
+class PmGroup;
+class RxGroup;
+}
 namespace Parser {
 class Driver;
 }
+namespace Utils {
+class DebugLogBufferFlush;
+class DebugLogFilter;
+class OverloadGuard;
+class Regex;
+class RegexCache;
+class RuleProfiler;
+class ThreadPool;
+class VerdictCache;
+}
 
 
 
 /** @ingroup ModSecurity_CPP_API */
 class RulesSet : public RulesSetProperties {
  public:
-    RulesSet()
-        : RulesSetProperties(new DebugLog())
-#ifndef NO_LOGS
-        ,m_secmarker_skipped(0)
-#endif
-        { }
-
-    explicit RulesSet(DebugLog *customLog)
-        : RulesSetProperties(customLog)
-#ifndef NO_LOGS
-        ,m_secmarker_skipped(0)
-#endif
-        { }
-
-    ~RulesSet() { }
+    RulesSet();
+    explicit RulesSet(DebugLog *customLog);
+    ~RulesSet();
 
     int loadFromUri(const char *uri);
+    /**
+     * loadFromUri(), reusing what previous parsed for the same uri when
+     * none of the files read then (the file, its includes, the data files
+     * of the operators and the Lua scripts) changed size or modification
+     * time since. Each uri is parsed by a driver of its own, so merging
+     * that driver again gives the same set as parsing the files again.
+     * previous has to stay alive while this set loads.
+     */
+    int loadFromUri(const char *uri, const RulesSet *previous);
     int loadRemote(const char *key, const char *uri);
     int load(const char *rules);
     int load(const char *rules, const std::string &ref);
@@ -73,14 +91,421 @@ class RulesSet : public RulesSetProperties {
     int merge(Parser::Driver *driver);
     int merge(RulesSet *rules);
 
+    /**
+     * Makes this, still empty, set an overlay of base. The rules of base
+     * are shared by reference instead of being copied and its properties
+     * are inherited as merge() would do; whatever is loaded into this set
+     * afterwards (rules, exclusions, property overrides) applies on top of
+     * them. Unless the overlay adds SecRuleRemove* or SecRuleUpdateTarget*
+     * exceptions, the evaluation plan of base is reused too, so the cost
+     * of an overlay is proportional to what it adds.
+     *
+     * The overlay keeps a reference to base, which must not be changed
+     * once it has overlays; it can not be an overlay itself.
+     */
+    int setBase(std::shared_ptr<RulesSet> base);
+    const RulesSet *getBase() const { return m_base.get(); }
+
+    /**
+     * A reference to this set, for it to be the base of overlays made
+     * through the C API. From the first call on, release() (as
+     * msc_rules_cleanup does) only drops the reference of the caller and
+     * the set goes away with the last of its overlays.
+     */
+    std::shared_ptr<RulesSet> shared();
+    /* deletes rules, or drops the reference shared() keeps for the caller */
+    static void release(RulesSet *rules);
+
     int evaluate(int phase, Transaction *transaction);
+
+    /**
+     * Whether the response body has to be fed (and is buffered) at all:
+     * SecResponseBodyAccess is On and either a rule reads the body, the
+     * audit log may record it or the body limit is enforced by rejecting.
+     * When false the body is dropped and msc_get_response_body() is empty.
+     */
+    bool needsResponseBody() const;
+    /**
+     * SecCollectionTimeout in seconds, 0 when what the rules of this set
+     * write to the persistent collections does not expire.
+     */
+    unsigned int collectionTimeout() const;
     std::string getParserError();
 
+    /**
+     * The SecRuleProfiling figures gathered so far, most expensive rule
+     * first; empty if profiling is off.
+     */
+    std::string profileDump() const;
+    /**
+     * C++ for the transformations and operators of the rules of this set,
+     * to be built into a SecRuleNativeModule (see rules-check -n).
+     */
+    std::string nativeSource() const;
+    /*
+     * The function the SecRuleNativeModule of this set has for rule;
+     * nullptr if there is none or the rule does not fit it.
+     */
+    const NativeMatch *nativeMatch(const RuleWithOperator *rule) const {
+        if (m_nativeMatches.empty()) {
+            return nullptr;
+        }
+        auto it = m_nativeMatches.find(rule);
+        return it == m_nativeMatches.end() ? nullptr : it->second;
+    }
+
+    /**
+     * The distinct regular expressions of the phase 2 rules that can be
+     * matched while the request body is appended (see
+     * RuleWithOperator::requestBodyRegex).
+     */
+    const std::vector<const Utils::Regex *> &requestBodyRegexes() const {
+        return m_requestBodyRegexes;
+    }
+
+    /**
+     * The merged automaton a @pm (or @pmFromFile) operator of this set is
+     * matched with, along with its slot there; nullptr if it is matched on
+     * its own.
+     */
+    const operators::PmGroup *pmGroup(const operators::Operator *op,
+        size_t *slot) const;
+    /* The same, for the RE2 set of a @rx (or @rxGlobal), see SecRxRe2. */
+    const operators::RxGroup *rxGroup(const operators::Operator *op,
+        size_t *slot) const;
+
     void debug(int level, const std::string &id, const std::string &uri,
         const std::string &msg);
 
+    /**
+     * Targets of a rule once the SecRuleUpdateTargetById/ByTag/ByMsg
+     * exceptions of this set are applied. Computed on every merge, so at
+     * run time only the ctl:ruleRemoveTarget* adjustments are left.
+     *
+     * m_variables holds the rule variables without the excluded ones plus
+     * the added ones; m_exclusion the excluded targets, which still have
+     * to be checked against collection values (e.g. !ARGS:foo on ARGS).
+     *
+     */
+    class RuleTargets {
+     public:
+        RuleTargets();
+        ~RuleTargets();
+
+        RuleTargets(const RuleTargets &) = delete;
+        RuleTargets &operator=(const RuleTargets &) = delete;
+
+        variables::Variables *m_variables;
+        variables::Variables *m_exclusion;
+    };
+
+    /**
+     * Returns nullptr if the targets of rule can not be resolved ahead of
+     * time, that is, if the rule tags or msg an exception refers to
+     * contain macros.
+     */
+    const RuleTargets *getRuleTargets(const RuleWithOperator *rule) const {
+        auto it = m_ruleTargets.find(rule);
+        if (it == m_ruleTargets.end()) {
+            if (m_base != nullptr && m_updatesTargets == false) {
+                return m_base->getRuleTargets(rule);
+            }
+            return nullptr;
+        }
+        return it->second.get();
+    }
+
+    /**
+     * Whether some rule of phase may block on I/O, see
+     * RuleWithOperator::mayBlock; Lua scripts are always taken to.
+     */
+    bool mayBlock(int phase) const { return m_blockingPhases[phase]; }
+
+    /**
+     * Bytes held by the rules of this set, their compiled patterns and
+     * the patterns compiled once their macros were expanded. The rules of
+     * the base of an overlay are the base's (see setBase).
+     */
+    size_t memoryUsage() const;
+
+    /**
+     * Builds, for each NUMA node but the one the calling thread runs on,
+     * a replica of this set: what was loaded into it (files, plain rules,
+     * the downloaded SecRemoteRules) parsed again by a thread bound to the
+     * CPUs of the node, so that the compiled rules end up in the memory
+     * of that node. The transactions created from here on evaluate the
+     * replica of the node they are created on (see replica()).
+     *
+     * To be called once all the rules are loaded: the set must not be
+     * changed afterwards. An overlay can not be replicated. Returns the
+     * number of replicas, 0 on a single node host, -1 on error.
+     */
+    int replicatePerNumaNode();
+    /* The replica for the CPU the calling thread runs on, or this set. */
+    RulesSet *replica();
+
     RulesSetPhases m_rulesSetPhases;
+
+    /**
+     * Compiled forms of the macro expanded @rx/@rxGlobal patterns, shared
+     * by all the transactions of this set.
+     */
+    Utils::RegexCache *m_regexCache;
+
+    /**
+     * Per rule profile, only there when SecRuleProfiling is On. Rebuilt,
+     * and so emptied, on every merge.
+     */
+    std::shared_ptr<Utils::RuleProfiler> m_ruleProfiler;
+
+    /**
+     * Rolling p99 of the transactions and the shedding level it calls for,
+     * only there when SecOverloadTarget is set. Rebuilt on every merge.
+     */
+    Utils::OverloadGuard *m_overloadGuard;
+
+    /**
+     * Verdicts of the request phases for the requests seen so far, only
+     * there when SecVerdictCache is set and the rules of the request
+     * headers phase can be left out (see Utils::VerdictCache). Rebuilt,
+     * and so emptied, on every merge.
+     */
+    Utils::VerdictCache *m_verdictCache;
+
+    /**
+     * When the SecDebugLogBuffer of a transaction is written out, only
+     * there when SecDebugLogBuffer is set. Rebuilt on every merge.
+     */
+    Utils::DebugLogBufferFlush *m_debugBufferFlush;
+
+    /**
+     * What SecDebugLogLevel is scoped to by SecDebugLogFilter, only there
+     * when that is set. Rebuilt on every merge.
+     */
+    Utils::DebugLogFilter *m_debugFilter;
+
+    /**
+     * What the transactions are run again against, off their path, when
+     * SecShadowRules is set (see ShadowTransaction). The file is loaded
+     * again when it is another one from one merge to the next.
+     */
+    std::shared_ptr<RulesSet> m_shadow;
+
+    /**
+     * Bodies from which on the rules of the body phases are matched in
+     * parallel, when SecRuleEvaluationThreads is above 1. Below that the
+     * cost of handing them out is not worth it.
+     */
+    static const size_t kParallelMinBodySize = 64 * 1024;
  private:
+    /**
+     * Entry of the per phase evaluation plan. The plan is assembled every
+     * time rules are merged into this set; it holds the already resolved
+     * rule kind and the outcome of the static exclusions (SecRuleRemoveById,
+     * SecRuleRemoveByMsg and SecRuleRemoveByTag). Only msg or tags that
+     * contains macros are left to be checked at run time.
+     *
+     * An entry is the rule and a byte of flags, so that a phase is walked
+     * through a contiguous array, a few rules per cache line, and a rule
+     * that is skipped is never touched. The rule is only looked at through
+     * the kind that was resolved here (ruleWithActions(), prefetchable()).
+     *
+     * m_prefetchable is set when the rule can be matched ahead of time, in
+     * parallel with the rules around it (see
+     * RuleWithOperator::isParallelSafe); m_barrier marks the ones whose
+     * actions (ctl) may change how the following rules match, so no
+     * group of rules matched together goes past them.
+     *
+     * m_sameTargets tells that the rule is prefetchable and has the very
+     * targets of the entry before it, which is prefetchable as well, so
+     * the two can be matched value by value (SecRuleValueMajor).
+     *
+     * m_readsTimeBudget is set on the rules that look at
+     * MSC_TIME_BUDGET_EXCEEDED, the only ones left to run once the
+     * transaction went over SecTransactionTimeBudget.
+     *
+     * m_shed is the overload level from which on the rule is skipped
+     * (SecOverloadShedTag), 0 when it never is.
+     *
+     * m_headerRule is where the rule is in the header rules program of
+     * the plan (see HeaderRules), or kNoHeaderRule; m_uriRule the same
+     * for the index of the URI gated rules (see UriRules).
+     *
+     */
+    class CompiledRule {
+     public:
+        enum RemovedBy : unsigned char {
+            NotRemoved,
+            RemovedById,
+            RemovedByMsg,
+            RemovedByTag
+        };
+
+        explicit CompiledRule(Rule *rule)
+            : m_rule(rule),
+            m_removedBy(NotRemoved),
+            m_isMarker(false),
+            m_hasActions(false),
+            m_prefetchable(false),
+            m_barrier(false),
+            m_checkMsgAtRunTime(false),
+            m_checkTagAtRunTime(false),
+            m_sameTargets(false),
+            m_readsTimeBudget(false),
+            m_shed(0),
+            m_headerRule(kNoHeaderRule),
+            m_uriRule(kNoUriRule) { }
+
+        /* also the most rules either index takes in a plan */
+        static const uint16_t kNoHeaderRule = 0xffff;
+        static const uint16_t kNoUriRule = 0xffff;
+
+        inline RuleWithActions *ruleWithActions() const;
+        inline RuleWithOperator *prefetchable() const;
+
+        Rule *m_rule;
+        RemovedBy m_removedBy:2;
+        bool m_isMarker:1;
+        bool m_hasActions:1;
+        bool m_prefetchable:1;
+        bool m_barrier:1;
+        bool m_checkMsgAtRunTime:1;
+        bool m_checkTagAtRunTime:1;
+        bool m_sameTargets:1;
+        bool m_readsTimeBudget:1;
+        unsigned char m_shed;
+        uint16_t m_headerRule;
+        uint16_t m_uriRule;
+    };
+
+    /**
+     * Plan of a phase: its entries and, so that skipAfter and skip jump
+     * over the rules in between instead of walking them, where its
+     * markers are and how many rules, markers aside, come before each
+     * entry.
+     *
+     */
+    class CompiledPhase {
+     public:
+        void clear();
+        size_t size() const { return m_rules.size(); }
+
+        /* the first marker called name from `from' on, or size() */
+        size_t findMarker(const std::string &name, size_t from) const;
+        /*
+         * The entry past the *count rules from `from' on, or size() when
+         * there are not as many; *count is left with the ones to go.
+         */
+        size_t skipRules(size_t from, int *count) const;
+
+        std::vector<CompiledRule> m_rules;
+        std::unordered_map<std::string, std::vector<size_t>> m_markers;
+        std::vector<size_t> m_rulesBefore;
+        /* request headers phase only, when some of its rules fit */
+        std::shared_ptr<HeaderRules> m_headerRules;
+        std::shared_ptr<UriRules> m_uriRules;
+    };
+
+    void compile();
+    void compileRules(const Rules &rules, CompiledPhase *plan,
+        bool targets);
+    void compileTargets(RuleWithOperator *rule);
+    void compileHeaderRules(CompiledPhase *plan);
+    void compileUriRules(CompiledPhase *plan);
+    void compileOverloadGuard();
+    void compileProfiler();
+    void compileNative();
+    void compileRequestBodyRegexes();
+    void compilePmGroups();
+    void compileRxGroups();
+    void compileThreadPool();
+    void compileVerdictCache();
+    void compileDebugLogBuffer();
+    void compileDebugLogFilter();
+    bool verdictCacheable(int phase, unsigned int *inputs) const;
+    void compileBlockingPhases();
+    bool cachedVerdict(int phase, Transaction *transaction);
+    void cacheVerdict(int phase, Transaction *transaction, size_t messages);
+    void applyCollectionSyncMode();
+    void applyCollectionGroupCommit();
+    void applyCollectionTimeout();
+    bool applyCollectionRedisServer();
+    bool compileShadow();
+    bool evaluateRules(const CompiledPhase &plan, Transaction *transaction,
+        bool decisionAhead);
+    bool decidedEarly(Transaction *transaction) const;
+    unsigned char shedLevel(RuleWithActions *rule) const;
+    bool runsInParallel(int phase, Transaction *transaction) const;
+    bool runsValueMajor(int phase, Transaction *transaction) const;
+    void prefetch(const std::vector<CompiledRule> &rules, size_t first,
+        Transaction *transaction);
+    void prefetchValueMajor(const std::vector<CompiledRule> &rules,
+        size_t first, Transaction *transaction);
+
+    CompiledPhase m_compiledPhases[modsecurity::Phases::NUMBER_OF_PHASES];
+
+    /* the SecShadowRules file m_shadow was loaded from */
+    std::string m_shadowFile;
+
+    std::shared_ptr<const RulesSet> m_base;
+    /* the reference of the C API caller once shared() was called */
+    std::shared_ptr<RulesSet> m_self;
+    /*
+     * Plan for the rules of m_base, only built when the exceptions of this
+     * overlay change the outcome of them (m_removesRules or m_updatesTargets);
+     * otherwise the plan of m_base is used as is.
+     */
+    CompiledPhase m_basePhases[modsecurity::Phases::NUMBER_OF_PHASES];
+    bool m_removesRules;
+    bool m_updatesTargets;
+    Utils::ThreadPool *m_threadPool;
+    /*
+     * Phases where matching ahead of time, in parallel or value by value,
+     * is possible at all: neither the SecDefaultAction of the phase nor
+     * SecRuleUpdateActionById add ctl.
+     */
+    bool m_parallelPhases[modsecurity::Phases::NUMBER_OF_PHASES];
+    /*
+     * Whether m_verdictCache answers the request body phase as well, and
+     * the Utils::VerdictCache::Input the cached phases read.
+     */
+    bool m_verdictCacheBody;
+    unsigned int m_verdictCacheInputs;
+    bool m_blockingPhases[modsecurity::Phases::NUMBER_OF_PHASES];
+    std::unordered_map<const RuleWithOperator *,
+        std::unique_ptr<RuleTargets>> m_ruleTargets;
+    /* what loadFromUri() parsed, along with the driver it was parsed by */
+    class LoadedUri;
+    std::vector<std::shared_ptr<const LoadedUri>> m_loadedUris;
+    /* what load() and loadFromUri() were given, to build the replicas */
+    class Source {
+     public:
+        Source(bool uri, const std::string &rules, const std::string &ref)
+            : m_uri(uri),
+            m_rules(rules),
+            m_ref(ref) { }
+
+        bool m_uri;
+        std::string m_rules;
+        std::string m_ref;
+    };
+    std::vector<Source> m_sources;
+    std::vector<std::unique_ptr<RulesSet>> m_replicas;
+    /* by CPU, the replica of its node or this set */
+    std::vector<RulesSet *> m_replicaOfCpu;
+    std::vector<const Utils::Regex *> m_requestBodyRegexes;
+    std::vector<operators::PmGroup *> m_pmGroups;
+    std::unordered_map<const operators::Operator *,
+        std::pair<const operators::PmGroup *, size_t>> m_pmGroupOf;
+    std::vector<operators::RxGroup *> m_rxGroups;
+    std::unordered_map<const operators::Operator *,
+        std::pair<const operators::RxGroup *, size_t>> m_rxGroupOf;
+    std::unordered_map<const RuleWithOperator *, NativeMatch *>
+        m_nativeMatches;
+    /* what m_nativeMatches call into, loaded once by the parser */
+    std::shared_ptr<NativeModule> m_nativeModule;
+    /* the SecRuleEarlyDecision marker, shared with the transactions */
+    std::shared_ptr<std::string> m_earlyDecision;
 #ifndef NO_LOGS
     uint8_t m_secmarker_skipped;
 #endif
@@ -95,11 +520,16 @@ extern "C" {
 RulesSet *msc_create_rules_set(void);
 void msc_rules_dump(RulesSet *rules);
 int msc_rules_merge(RulesSet *rules_dst, RulesSet *rules_from, const char **error);
+int msc_rules_set_base(RulesSet *rules, RulesSet *base, const char **error);
 int msc_rules_add_remote(RulesSet *rules, const char *key, const char *uri,
     const char **error);
 int msc_rules_add_file(RulesSet *rules, const char *file, const char **error);
 int msc_rules_add(RulesSet *rules, const char *plain_rules, const char **error);
 int msc_rules_cleanup(RulesSet *rules);
+int msc_rules_needs_response_body(RulesSet *rules);
+char *msc_rules_profile_dump(RulesSet *rules);
+size_t msc_rules_memory_usage(RulesSet *rules);
+int msc_rules_replicate_per_numa_node(RulesSet *rules, const char **error);
 
 #ifdef __cplusplus
 }
@@ -45,11 +45,18 @@ class RulesSetPhases {
 
     bool insert(std::shared_ptr<Rule> rule);
 
-    int append(RulesSetPhases *from, std::ostringstream *err);
+    /**
+     * Appends the rules of from, refusing ids already present in this set
+     * or, when given, in base.
+     */
+    int append(RulesSetPhases *from, std::ostringstream *err,
+        const RulesSetPhases *base = nullptr);
     void dump() const;
 
     Rules *operator[](int index) { return &m_rulesAtPhase[index]; }
     Rules *at(int index) { return &m_rulesAtPhase[index]; }
+    const Rules *at(int index) const { return &m_rulesAtPhase[index]; }
+    bool empty() const;
 
  private:
     Rules m_rulesAtPhase[8];
@@ -21,6 +21,7 @@
 #include <vector>
 #include <list>
 #include <set>
+#include <cstdint>
 #include <cstring>
 #endif
 
@@ -124,19 +125,35 @@ class ConfigSet {
 };
 
 
+/**
+ * The byte every %uXXXX code point decodes to in the selected code page,
+ * and a bit per code point telling whether the code page maps it at all:
+ * 72 KiB, shared by all the rule sets that load the same unicode map file
+ * with the same code page.
+ */
 class UnicodeMapHolder {
  public:
     UnicodeMapHolder() {
-        memset(m_data, -1, (sizeof(int)*65536));
-    };
+        memset(m_data, 0, sizeof(m_data));
+        memset(m_mapped, 0, sizeof(m_mapped));
+    }
 
-    int& operator[](int index) { return m_data[index]; }
-    int operator[](int index) const { return m_data[index]; }
+    int operator[](int index) const { return at(index); }
 
-    int at(int index) const { return m_data[index]; }
-    void change(int i, int a) { m_data[i] = a; }
+    /* The byte index maps to, or -1 if it is not in the code page. */
+    int at(int index) const {
+        if ((m_mapped[index >> 6] >> (index & 63) & 1) == 0) {
+            return -1;
+        }
+        return m_data[index];
+    }
+    void change(int i, int a) {
+        m_data[i] = static_cast<unsigned char>(a);
+        m_mapped[i >> 6] |= UINT64_C(1) << (i & 63);
+    }
 
-    int m_data[65536];
+    unsigned char m_data[65536];
+    uint64_t m_mapped[65536 / 64];
 };
 
 
@@ -168,17 +185,103 @@ class ConfigUnicodeMap {
 };
 
 
+/**
+ * Settings of the per transaction transformation cache, filled by the
+ * directive: SecCacheTransformations On|Off [option:value,...]
+ *
+ * Supported options are: minlen and maxlen, the size limits of the values
+ * that should be cached, and maxsize, the amount of bytes that the cache
+ * may hold for a single transaction.
+ *
+ */
+class ConfigTransformationsCache {
+ public:
+    ConfigTransformationsCache() : m_set(false),
+        m_enabled(false),
+        m_minLength(0),
+        m_maxLength(1048576),
+        m_maxSize(1048576) { }
+
+    bool load(const std::string &directive, std::string *error);
+
+    void merge(ConfigTransformationsCache *from) {
+        if (m_set == true || from->m_set == false) {
+            return;
+        }
+
+        m_set = true;
+        m_enabled = from->m_enabled;
+        m_minLength = from->m_minLength;
+        m_maxLength = from->m_maxLength;
+        m_maxSize = from->m_maxSize;
+
+        return;
+    }
+
+    bool m_set;
+    bool m_enabled;
+    size_t m_minLength;
+    size_t m_maxLength;
+    size_t m_maxSize;
+};
+
+
+/**
+ * Variables that cost some work to fill and that a rule of the set refers
+ * to. Recorded by the parser as it builds the variables, be them rule
+ * targets, macros or exclusions; whatever reaches the variables by name at
+ * run time (the Lua scripts) marks all of them in use. The transaction
+ * does not fill the ones that are not.
+ *
+ */
+class ConfigVariablesInUse {
+ public:
+    enum Variable {
+        AuthType = 1 << 0,
+        RequestCookies = 1 << 1,
+        ArgsGet = 1 << 2,
+        ArgsPost = 1 << 3,
+        RequestHeadersNames = 1 << 4,
+        /* RESPONSE_BODY and what is computed from the buffered body */
+        ResponseBody = 1 << 5,
+        /* read back from the temporary files once they are complete */
+        FilesTmpContent = 1 << 6,
+    };
+
+    ConfigVariablesInUse() : m_mask(0) { }
+
+    void add(unsigned int mask) { m_mask |= mask; }
+    void addAll() { m_mask = ~0u; }
+    bool uses(unsigned int mask) const { return (m_mask & mask) != 0; }
+
+    void merge(ConfigVariablesInUse *from) {
+        m_mask |= from->m_mask;
+    }
+
+    unsigned int m_mask;
+};
+
+
 class RulesSetProperties {
  public:
     RulesSetProperties() :
         m_auditLog(new AuditLog()),
         m_requestBodyLimitAction(PropertyNotSetBodyLimitAction),
         m_responseBodyLimitAction(PropertyNotSetBodyLimitAction),
+        m_requestBodyDecompression(PropertyNotSetConfigBoolean),
+        m_responseBodyDecompression(PropertyNotSetConfigBoolean),
+        m_requestBodyJsonSimd(PropertyNotSetConfigBoolean),
         m_secRequestBodyAccess(PropertyNotSetConfigBoolean),
         m_secResponseBodyAccess(PropertyNotSetConfigBoolean),
+        m_secRuleProfiling(PropertyNotSetConfigBoolean),
+        m_secRuleValueMajor(PropertyNotSetConfigBoolean),
+        m_secRxPrefilter(PropertyNotSetConfigBoolean),
+        m_secRxRe2(PropertyNotSetConfigBoolean),
         m_secXMLExternalEntity(PropertyNotSetConfigBoolean),
         m_tmpSaveUploadedFiles(PropertyNotSetConfigBoolean),
+        m_uploadAnonymousFiles(PropertyNotSetConfigBoolean),
         m_uploadKeepFiles(PropertyNotSetConfigBoolean),
+        m_xmlDomRequired(PropertyNotSetConfigBoolean),
         m_debugLog(new DebugLog()),
         m_remoteRulesActionOnFailed(PropertyNotSetRemoteRulesAction),
         m_secRuleEngine(PropertyNotSetRuleEngine) { }
@@ -188,11 +291,20 @@ class RulesSetProperties {
         m_auditLog(new AuditLog()),
         m_requestBodyLimitAction(PropertyNotSetBodyLimitAction),
         m_responseBodyLimitAction(PropertyNotSetBodyLimitAction),
+        m_requestBodyDecompression(PropertyNotSetConfigBoolean),
+        m_responseBodyDecompression(PropertyNotSetConfigBoolean),
+        m_requestBodyJsonSimd(PropertyNotSetConfigBoolean),
         m_secRequestBodyAccess(PropertyNotSetConfigBoolean),
         m_secResponseBodyAccess(PropertyNotSetConfigBoolean),
+        m_secRuleProfiling(PropertyNotSetConfigBoolean),
+        m_secRuleValueMajor(PropertyNotSetConfigBoolean),
+        m_secRxPrefilter(PropertyNotSetConfigBoolean),
+        m_secRxRe2(PropertyNotSetConfigBoolean),
         m_secXMLExternalEntity(PropertyNotSetConfigBoolean),
         m_tmpSaveUploadedFiles(PropertyNotSetConfigBoolean),
+        m_uploadAnonymousFiles(PropertyNotSetConfigBoolean),
         m_uploadKeepFiles(PropertyNotSetConfigBoolean),
+        m_xmlDomRequired(PropertyNotSetConfigBoolean),
         m_debugLog(debugLog),
         m_remoteRulesActionOnFailed(PropertyNotSetRemoteRulesAction),
         m_secRuleEngine(PropertyNotSetRuleEngine) { }
@@ -311,6 +423,56 @@ class RulesSetProperties {
     };
 
 
+    /**
+     *
+     * Durability of the writes to the persistent collections, as set by
+     * SecCollectionSyncMode. Only meaningful for the LMDB backend.
+     *
+     */
+    enum CollectionSyncMode {
+     /**
+      *
+      * Flush data and meta data on every commit (default)
+      *
+      */
+     CollectionSyncFull,
+     /**
+      *
+      * Do not flush the meta page on commit
+      *
+      */
+     CollectionSyncNoMetaSync,
+     /**
+      *
+      * Leave the flushing to the operating system
+      *
+      */
+     CollectionSyncNoSync
+    };
+
+
+    /**
+     *
+     * How the transaction ids are made when the connector does not hand
+     * one, as set by SecTransactionIdFormat.
+     *
+     */
+    enum TransactionIdFormat {
+     /**
+      *
+      * Time stamp, process, thread and a per thread counter (default)
+      *
+      */
+     TransactionIdSequential,
+     /**
+      *
+      * Time stamp and a random number, as in the former versions
+      *
+      */
+     TransactionIdRandom
+    };
+
+
     static const char *ruleEngineStateString(RuleEngine i) {
         switch (i) {
         case DisabledRuleEngine:
@@ -353,6 +515,34 @@ class RulesSetProperties {
                             from->m_secResponseBodyAccess,
                             PropertyNotSetConfigBoolean);
 
+        merge_boolean_value(to->m_secRuleProfiling,
+                            from->m_secRuleProfiling,
+                            PropertyNotSetConfigBoolean);
+
+        merge_boolean_value(to->m_secRuleValueMajor,
+                            from->m_secRuleValueMajor,
+                            PropertyNotSetConfigBoolean);
+
+        merge_boolean_value(to->m_requestBodyDecompression,
+                            from->m_requestBodyDecompression,
+                            PropertyNotSetConfigBoolean);
+
+        merge_boolean_value(to->m_responseBodyDecompression,
+                            from->m_responseBodyDecompression,
+                            PropertyNotSetConfigBoolean);
+
+        merge_boolean_value(to->m_requestBodyJsonSimd,
+                            from->m_requestBodyJsonSimd,
+                            PropertyNotSetConfigBoolean);
+
+        merge_boolean_value(to->m_secRxPrefilter,
+                            from->m_secRxPrefilter,
+                            PropertyNotSetConfigBoolean);
+
+        merge_boolean_value(to->m_secRxRe2,
+                            from->m_secRxRe2,
+                            PropertyNotSetConfigBoolean);
+
         merge_boolean_value(to->m_secXMLExternalEntity,
                             from->m_secXMLExternalEntity,
                             PropertyNotSetConfigBoolean);
@@ -365,8 +555,18 @@ class RulesSetProperties {
                             from->m_tmpSaveUploadedFiles,
                             PropertyNotSetConfigBoolean);
 
+        merge_boolean_value(to->m_uploadAnonymousFiles,
+                            from->m_uploadAnonymousFiles,
+                            PropertyNotSetConfigBoolean);
+
+        merge_boolean_value(to->m_xmlDomRequired,
+                            from->m_xmlDomRequired,
+                            PropertyNotSetConfigBoolean);
+
         to->m_argumentsLimit.merge(&from->m_argumentsLimit);
         to->m_requestBodyJsonDepthLimit.merge(&from->m_requestBodyJsonDepthLimit);
+        to->m_requestBodyInMemoryLimit.merge(
+            &from->m_requestBodyInMemoryLimit);
         to->m_requestBodyLimit.merge(&from->m_requestBodyLimit);
         to->m_requestBodyNoFilesLimit.merge(&from->m_requestBodyNoFilesLimit);
         to->m_responseBodyLimit.merge(&from->m_responseBodyLimit);
@@ -379,11 +579,45 @@ class RulesSetProperties {
                                     from->m_responseBodyLimitAction,
                                     PropertyNotSetBodyLimitAction);
 
+        to->m_dataReloadInterval.merge(&from->m_dataReloadInterval);
+        to->m_debugLogBufferLevel.merge(&from->m_debugLogBufferLevel);
+        to->m_debugLogBufferSize.merge(&from->m_debugLogBufferSize);
+        to->m_debugLogBufferFlush.merge(&from->m_debugLogBufferFlush);
+        to->m_debugLogFilter.merge(&from->m_debugLogFilter);
+        to->m_luaStatePoolLimit.merge(&from->m_luaStatePoolLimit);
+        to->m_requestBodyDecompressionRatio.merge(
+            &from->m_requestBodyDecompressionRatio);
+        to->m_pcreJitStackSize.merge(&from->m_pcreJitStackSize);
         to->m_pcreMatchLimit.merge(&from->m_pcreMatchLimit);
+        to->m_collectionGroupCommit.merge(&from->m_collectionGroupCommit);
+        to->m_collectionSyncMode.merge(&from->m_collectionSyncMode);
+        to->m_collectionTimeout.merge(&from->m_collectionTimeout);
+        to->m_collectionRedisHost.merge(&from->m_collectionRedisHost);
+        to->m_collectionRedisPort.merge(&from->m_collectionRedisPort);
+        to->m_collectionRedisTimeout.merge(&from->m_collectionRedisTimeout);
+        to->m_rblTimeout.merge(&from->m_rblTimeout);
+        to->m_transactionIdFormat.merge(&from->m_transactionIdFormat);
+        to->m_transactionTimeBudget.merge(&from->m_transactionTimeBudget);
+        to->m_transactionMemoryLimit.merge(&from->m_transactionMemoryLimit);
+        to->m_verdictCacheEntries.merge(&from->m_verdictCacheEntries);
+        to->m_responseBodyStreamWindow.merge(
+            &from->m_responseBodyStreamWindow);
+        to->m_earlyDecisionVariable.merge(&from->m_earlyDecisionVariable);
+        to->m_earlyDecisionThreshold.merge(&from->m_earlyDecisionThreshold);
+        to->m_earlyDecisionMarker.merge(&from->m_earlyDecisionMarker);
+        to->m_ruleEvaluationThreads.merge(&from->m_ruleEvaluationThreads);
+        to->m_overloadTarget.merge(&from->m_overloadTarget);
+        to->m_overloadWindow.merge(&from->m_overloadWindow);
+        to->m_ruleEngineSampleRate.merge(&from->m_ruleEngineSampleRate);
+        to->m_ruleEngineSampleKey.merge(&from->m_ruleEngineSampleKey);
+        to->m_ruleProfilingSampleRate.merge(&from->m_ruleProfilingSampleRate);
+        to->m_rxGuardrail.merge(&from->m_rxGuardrail);
         to->m_uploadFileLimit.merge(&from->m_uploadFileLimit);
         to->m_uploadFileMode.merge(&from->m_uploadFileMode);
+        to->m_uploadInMemoryLimit.merge(&from->m_uploadInMemoryLimit);
         to->m_uploadDirectory.merge(&from->m_uploadDirectory);
         to->m_uploadTmpDirectory.merge(&from->m_uploadTmpDirectory);
+        to->m_tmpDirectory.merge(&from->m_tmpDirectory);
 
         to->m_secArgumentSeparator.merge(&from->m_secArgumentSeparator);
 
@@ -392,6 +626,11 @@ class RulesSetProperties {
         to->m_unicodeMapTable.merge(&from->m_unicodeMapTable);
 
         to->m_httpblKey.merge(&from->m_httpblKey);
+        to->m_ruleNativeModule.merge(&from->m_ruleNativeModule);
+        to->m_shadowRules.merge(&from->m_shadowRules);
+
+        to->m_transformationsCache.merge(&from->m_transformationsCache);
+        to->m_variablesInUse.merge(&from->m_variablesInUse);
 
         to->m_exceptions.merge(&from->m_exceptions);
 
@@ -413,6 +652,19 @@ class RulesSetProperties {
             to->m_responseBodyTypeToBeInspected.m_set = true;
         }
 
+        if (from->m_overloadShedTags.m_set == true) {
+            to->m_overloadShedTags.m_value.insert(
+                from->m_overloadShedTags.m_value.begin(),
+                from->m_overloadShedTags.m_value.end());
+            to->m_overloadShedTags.m_set = true;
+        }
+        if (from->m_overloadDetectionOnly.m_set == true) {
+            to->m_overloadDetectionOnly.m_value.insert(
+                from->m_overloadDetectionOnly.m_value.begin(),
+                from->m_overloadDetectionOnly.m_value.end());
+            to->m_overloadDetectionOnly.m_set = true;
+        }
+
         for (int i = 0; i < modsecurity::Phases::NUMBER_OF_PHASES; i++) {
             std::vector<std::shared_ptr<actions::Action> > *actions_from = \
                 &from->m_defaultActions[i];
@@ -461,34 +713,109 @@ class RulesSetProperties {
     audit_log::AuditLog *m_auditLog;
     BodyLimitAction m_requestBodyLimitAction;
     BodyLimitAction m_responseBodyLimitAction;
+    /* SecRequestBodyDecompression: inflate gzip and deflate bodies */
+    ConfigBoolean m_requestBodyDecompression;
+    /* SecResponseBodyDecompression: the same for the response bodies */
+    ConfigBoolean m_responseBodyDecompression;
+    /* SecRequestBodyJsonSimd, only Off counts: simdjson is used when
+     * built in, unless turned off. */
+    ConfigBoolean m_requestBodyJsonSimd;
     ConfigBoolean m_secRequestBodyAccess;
     ConfigBoolean m_secResponseBodyAccess;
+    ConfigBoolean m_secRuleProfiling;
+    ConfigBoolean m_secRuleValueMajor;
+    ConfigBoolean m_secRxPrefilter;
+    /* SecRxRe2: @rx and @rxGlobal with RE2, where it can. */
+    ConfigBoolean m_secRxRe2;
     ConfigBoolean m_secXMLExternalEntity;
     ConfigBoolean m_tmpSaveUploadedFiles;
+    ConfigBoolean m_uploadAnonymousFiles;
     ConfigBoolean m_uploadKeepFiles;
+    /* Set by the parser when a rule reads XML or validates it against a
+     * DTD/schema; without it the XML body is parsed without a tree. */
+    ConfigBoolean m_xmlDomRequired;
     ConfigDouble m_argumentsLimit;
     ConfigDouble m_requestBodyJsonDepthLimit;
+    /* SecRequestBodyInMemoryLimit, past it the body goes to SecTmpDir */
+    ConfigDouble m_requestBodyInMemoryLimit;
     ConfigDouble m_requestBodyLimit;
     ConfigDouble m_requestBodyNoFilesLimit;
     ConfigDouble m_responseBodyLimit;
+    /* SecCollectionGroupCommit, in milliseconds */
+    ConfigInt m_collectionGroupCommit;
+    ConfigInt m_collectionRedisPort;
+    ConfigInt m_collectionRedisTimeout;
+    ConfigInt m_collectionSyncMode;
+    ConfigInt m_collectionTimeout;
+    ConfigInt m_dataReloadInterval;
+    /* SecDebugLogBuffer: up to which level, and how many bytes */
+    ConfigInt m_debugLogBufferLevel;
+    ConfigInt m_debugLogBufferSize;
+    /* SecRuleEarlyDecision: TX variable, its threshold and the marker */
+    ConfigInt m_earlyDecisionThreshold;
+    ConfigInt m_luaStatePoolLimit;
+    /* SecOverloadTarget: the p99 to keep under, in microseconds, and how
+     * many transactions it is taken over */
+    ConfigInt m_overloadTarget;
+    ConfigInt m_overloadWindow;
+    ConfigInt m_pcreJitStackSize;
     ConfigInt m_pcreMatchLimit;
+    ConfigInt m_rblTimeout;
+    /* SecRequestBodyDecompressionRatio, inflated over compressed bytes */
+    ConfigInt m_requestBodyDecompressionRatio;
+    ConfigInt m_responseBodyStreamWindow;
+    /* SecRuleEngineSampleRate: the share of the transactions DetectionOnly
+     * evaluates, in hundredths of a percent, and what decides which ones:
+     * 0 their unique id, 1 the client address */
+    ConfigInt m_ruleEngineSampleRate;
+    ConfigInt m_ruleEngineSampleKey;
+    ConfigInt m_ruleEvaluationThreads;
+    ConfigInt m_ruleProfilingSampleRate;
+    /* SecRxGuardrail: how many times the median search of an @rx may
+     * an input cost before only a prefix of it is searched */
+    ConfigInt m_rxGuardrail;
+    ConfigInt m_transactionIdFormat;
+    /* SecTransactionMemoryLimit, in bytes of collected request data */
+    ConfigInt m_transactionMemoryLimit;
+    /* SecTransactionTimeBudget, in milliseconds of engine time */
+    ConfigInt m_transactionTimeBudget;
     ConfigInt m_uploadFileLimit;
     ConfigInt m_uploadFileMode;
+    ConfigInt m_uploadInMemoryLimit;
+    /* SecVerdictCache, 0 (the default) for no cache */
+    ConfigInt m_verdictCacheEntries;
     DebugLog *m_debugLog;
     OnFailedRemoteRulesAction m_remoteRulesActionOnFailed;
     RuleEngine m_secRuleEngine;
     RulesExceptions m_exceptions;
     std::list<std::string> m_components;
     std::ostringstream m_parserError;
+    /* SecOverloadShedTag and SecOverloadDetectionOnly */
+    ConfigSet m_overloadDetectionOnly;
+    ConfigSet m_overloadShedTags;
     ConfigSet m_responseBodyTypeToBeInspected;
+    ConfigString m_collectionRedisHost;
+    /* SecDebugLogBufferFlush, as given (see Utils::DebugLogBufferFlush) */
+    ConfigString m_debugLogBufferFlush;
+    /* SecDebugLogFilter, as given (see Utils::DebugLogFilter) */
+    ConfigString m_debugLogFilter;
+    ConfigString m_earlyDecisionMarker;
+    ConfigString m_earlyDecisionVariable;
     ConfigString m_httpblKey;
+    /* SecRuleNativeModule, the path of the module (see NativeRules) */
+    ConfigString m_ruleNativeModule;
+    /* SecShadowRules, the resolved path of the file */
+    ConfigString m_shadowRules;
     ConfigString m_uploadDirectory;
     ConfigString m_uploadTmpDirectory;
+    ConfigString m_tmpDirectory;
     ConfigString m_secArgumentSeparator;
     ConfigString m_secWebAppId;
     std::vector<std::shared_ptr<actions::Action> > \
         m_defaultActions[modsecurity::Phases::NUMBER_OF_PHASES];
     ConfigUnicodeMap m_unicodeMapTable;
+    ConfigTransformationsCache m_transformationsCache;
+    ConfigVariablesInUse m_variablesInUse;
 };
 
 
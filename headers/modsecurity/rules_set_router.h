@@ -0,0 +1,148 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#ifdef __cplusplus
+#include <memory>
+#include <string>
+#include <unordered_map>
+#endif
+
+
+#ifndef HEADERS_MODSECURITY_RULES_SET_ROUTER_H_
+#define HEADERS_MODSECURITY_RULES_SET_ROUTER_H_
+
+#ifndef __cplusplus
+typedef struct RulesSetRouter_t RulesSetRouter;
+#endif
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_handle.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/transaction.h"
+
+#ifdef __cplusplus
+
+namespace modsecurity {
+
+
+/**
+ * Picks the rules of a transaction by the Host header, for the servers
+ * inspecting the traffic of many tenants with one ModSecurity instance.
+ *
+ * A route maps a host name to a RulesHandle, so every tenant can be
+ * reloaded on its own. The names are either exact ("www.example.com"),
+ * found with a single hash lookup, or wildcards ("*.example.com", any
+ * name below example.com but not example.com itself), kept in a trie of
+ * the labels from the right, where the longest suffix wins. The lookup
+ * ignores the case, a port and a trailing dot; the hosts that match no
+ * route get the default one, when set.
+ *
+ * The tenants that only add to a common configuration are better loaded
+ * as overlays of it (see newOverlay), so that the rules of the base are
+ * compiled and kept once, whatever the number of tenants.
+ *
+ * The routes are to be set up before the first transaction: route() does
+ * not take any lock. The routers, as the handles they create, are owned
+ * by the ModSecurity instance (see ModSecurity::createRulesSetRouter).
+ */
+/** @ingroup ModSecurity_CPP_API */
+class RulesSetRouter {
+ public:
+    explicit RulesSetRouter(ModSecurity *ms);
+    ~RulesSetRouter();
+
+    RulesSetRouter(const RulesSetRouter &) = delete;
+    RulesSetRouter &operator=(const RulesSetRouter &) = delete;
+
+    /*
+     * The set the tenants are overlays of; takes ownership of it. Does
+     * not change the overlays already made of the previous base.
+     */
+    void setBase(RulesSet *base);
+    const RulesSet *getBase() const { return m_base.get(); }
+
+    /*
+     * A new, empty, set with the base of the router set up (see
+     * RulesSet::setBase), for the rules of a tenant to be loaded into.
+     * NULL, with error set, if there is no base.
+     */
+    RulesSet *newOverlay(std::string *error);
+
+    /*
+     * Routes host, "*.suffix" for a wildcard or "*" for the default
+     * route, to handle. False, with error set, if host is not a valid
+     * name or is already routed.
+     */
+    bool addRoute(const std::string &host, RulesHandle *handle,
+        std::string *error);
+    /* same, with a new handle taking ownership of rules */
+    bool addRoute(const std::string &host, RulesSet *rules,
+        std::string *error);
+
+    /* the handle for host, NULL when no route matches it */
+    RulesHandle *route(const char *host, size_t length) const;
+    RulesHandle *route(const std::string &host) const {
+        return route(host.c_str(), host.size());
+    }
+
+    /* NULL when no route matches host */
+    Transaction *newTransaction(const std::string &host, void *logCbData);
+
+    size_t size() const { return m_exact.size() + m_wildcards; }
+
+ private:
+    struct Node {
+        Node() : m_handle(nullptr) { }
+        std::unordered_map<std::string, std::unique_ptr<Node>> m_children;
+        /* the handle of "*." followed by the labels down to this node */
+        RulesHandle *m_handle;
+    };
+
+    static bool normalise(const char *host, size_t length,
+        std::string *name);
+
+    ModSecurity *m_ms;
+    /* the overlays made of it keep a reference of their own */
+    std::shared_ptr<RulesSet> m_base;
+    std::unordered_map<std::string, RulesHandle *> m_exact;
+    Node m_root;
+    size_t m_wildcards;
+    RulesHandle *m_default;
+};
+
+
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+RulesSetRouter *msc_create_rules_set_router(ModSecurity *msc);
+void msc_rules_set_router_set_base(RulesSetRouter *router, RulesSet *base);
+RulesSet *msc_rules_set_router_new_overlay(RulesSetRouter *router,
+    const char **error);
+int msc_rules_set_router_add(RulesSetRouter *router, const char *host,
+    RulesHandle *handle, const char **error);
+RulesHandle *msc_rules_set_router_route(RulesSetRouter *router,
+    const char *host);
+Transaction *msc_new_transaction_from_router(RulesSetRouter *router,
+    const char *host, void *logCbData);
+
+#ifdef __cplusplus
+}
+}  // namespace modsecurity
+#endif
+
+#endif  // HEADERS_MODSECURITY_RULES_SET_ROUTER_H_
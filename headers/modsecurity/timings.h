@@ -0,0 +1,43 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <stdint.h>
+
+#ifndef HEADERS_MODSECURITY_TIMINGS_H_
+#define HEADERS_MODSECURITY_TIMINGS_H_
+
+#ifdef __cplusplus
+namespace modsecurity {
+#endif
+
+/**
+ * Time spent, in nanoseconds of the monotonic clock, inside each of the
+ * processing calls of a transaction. A call made more than once adds up;
+ * one never made is 0. total is the sum of the others.
+ */
+typedef struct ModSecurityTimings_t {
+    uint64_t request_headers;
+    uint64_t request_body;
+    uint64_t response_headers;
+    uint64_t response_body;
+    uint64_t logging;
+    uint64_t total;
+} ModSecurityTimings;
+
+#ifdef __cplusplus
+}  // namespace modsecurity
+#endif
+
+#endif  // HEADERS_MODSECURITY_TIMINGS_H_
@@ -0,0 +1,75 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <stdint.h>
+
+#ifndef HEADERS_MODSECURITY_TRACE_H_
+#define HEADERS_MODSECURITY_TRACE_H_
+
+#ifdef __cplusplus
+namespace modsecurity {
+#endif
+
+/**
+ * A span of the work of a transaction, or an event (duration 0), for the
+ * connector to hand over to its tracer (e.g. as an OpenTelemetry span,
+ * child of the one of the request).
+ *
+ *  name       "request_headers", "request_body", "response_headers",
+ *             "response_body" or "logging" for a processing call;
+ *             "operator" or "variable" for an operator or a variable
+ *             (a collection read from its backend, mostly) of a rule
+ *             that took longer than the threshold; "match_limit" or
+ *             "rx_guardrail" for an event: a regular expression that hit
+ *             its match limit, or that only searched a prefix of its
+ *             input (SecRxGuardrail).
+ *  detail     the operator ("@rx"), the variable ("IP:counter") or the
+ *             pattern; NULL for a processing call.
+ *  rule_id    0 outside of a rule.
+ *  start      nanoseconds since the epoch (CLOCK_REALTIME).
+ *  duration   nanoseconds.
+ *
+ * Everything is only valid during the callback.
+ */
+typedef struct ModSecuritySpan_t {
+    const char *name;
+    const char *detail;
+    int64_t rule_id;
+    uint64_t start;
+    uint64_t duration;
+} ModSecuritySpan;
+
+
+/*
+ * @name    ModSecTraceCb
+ * @brief   Called once per span, as it ends
+ *
+ *
+ * void *   The parent the connector gave the transaction (see
+ *          Transaction::setTraceParent). Transactions without one are
+ *          not traced.
+ * const ModSecuritySpan *  The span.
+ *
+ * @note    Rules matched in parallel (SecRuleEvaluationThreads) report
+ *          their operators from the threads of the pool.
+ *
+ */
+typedef void (*ModSecTraceCb) (void *, const ModSecuritySpan *);
+
+#ifdef __cplusplus
+}  // namespace modsecurity
+#endif
+
+#endif  // HEADERS_MODSECURITY_TRACE_H_
@@ -18,11 +18,14 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <atomic>
+#include <functional>
 #include <list>
 #include <map>
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 #include <memory>
@@ -43,7 +46,9 @@ typedef struct Rules_t RulesSet;
 
 #include "modsecurity/anchored_set_variable.h"
 #include "modsecurity/anchored_variable.h"
+#include "modsecurity/body_buffer.h"
 #include "modsecurity/intervention.h"
+#include "modsecurity/timings.h"
 #include "modsecurity/collection/collections.h"
 #include "modsecurity/variable_value.h"
 #include "modsecurity/collection/collection.h"
@@ -55,8 +60,8 @@ typedef struct Rules_t RulesSet;
 #ifndef NO_LOGS
 #define ms_dbg(b, c) \
   do { \
-      if (m_rules && m_rules->m_debugLog && m_rules->m_debugLog->m_debugLevel >= b) { \
-          m_rules->debug(b, *m_id.get(), m_uri, c); \
+      if (m_debugLevel >= b) { \
+          debug(b, c); \
       } \
   } while (0);
 #else
@@ -64,10 +69,18 @@ typedef struct Rules_t RulesSet;
   do { } while (0);
 #endif
 
+#ifndef NO_LOGS
+#define ms_dbg_a_enabled(t, b) \
+  (t && t->m_debugLevel >= b)
+#else
+#define ms_dbg_a_enabled(t, b) \
+  (false)
+#endif
+
 #ifndef NO_LOGS
 #define ms_dbg_a(t, b, c) \
   do { \
-      if (t && t->m_rules && t->m_rules->m_debugLog && t->m_rules->m_debugLog->m_debugLevel >= b) { \
+      if (ms_dbg_a_enabled(t, b)) { \
           t->debug(b, c); \
       } \
   } while (0);
@@ -96,16 +109,31 @@ typedef struct Rules_t RulesSet;
     yajl_gen_string(g, reinterpret_cast<const unsigned char*>(a), strlen(a)); \
     yajl_gen_integer(g, b);
 
+/*
+ * What the process*() calls of a non blocking transaction return when
+ * the phase goes on on another thread (see msc_transaction_resume).
+ */
+#define MSC_AGAIN 2
+
 #ifdef __cplusplus
 
 namespace modsecurity {
 
+class Connection;
 class ModSecurity;
 class Transaction;
 class RulesSet;
+class Rule;
 class RuleMessage;
+class RulePrefetches;
+class RuleWithActions;
+class TimingScope;
+struct msc_iovec_t;
 namespace actions {
 class Action;
+namespace transformations {
+class TransformationCache;
+}
 namespace disruptive {
 enum AllowType : int;
 }
@@ -113,10 +141,22 @@ enum AllowType : int;
 namespace RequestBodyProcessor {
 class XML;
 class JSON;
+class GRPC;
 class MultipartPartTmpFile;
 }
 namespace operators {
 class Operator;
+class InjectionCache;
+class PmGroupCache;
+class RxGroupCache;
+}
+namespace Utils {
+class DebugLogBuffer;
+class Inflate;
+class PairIndex;
+class RegexStreams;
+class RuleProfiler;
+class RuleProfilerShard;
 }
 
 
@@ -136,6 +176,8 @@ class TransactionAnchoredVariables {
         m_variableMatchedVarName(t, "MATCHED_VAR_NAME"),
         m_variableMscPcreError(t, "MSC_PCRE_ERROR"),
         m_variableMscPcreLimitsExceeded(t, "MSC_PCRE_LIMITS_EXCEEDED"),
+        m_variableMscTimeBudgetExceeded(t, "MSC_TIME_BUDGET_EXCEEDED"),
+        m_variableMscMemoryLimitExceeded(t, "MSC_MEMORY_LIMIT_EXCEEDED"),
         m_variableMultipartBoundaryQuoted(t, "MULTIPART_BOUNDARY_QUOTED"),
         m_variableMultipartBoundaryWhiteSpace(t,
             "MULTIPART_BOUNDARY_WHITESPACE"),
@@ -194,8 +236,8 @@ class TransactionAnchoredVariables {
         m_variableFilesTmpContent(t, "FILES_TMP_CONTENT"),
         m_variableMultipartFileName(t, "MULTIPART_FILENAME"),
         m_variableMultipartName(t, "MULTIPART_NAME"),
-        m_variableMatchedVarsNames(t, "MATCHED_VARS_NAMES"),
-        m_variableMatchedVars(t, "MATCHED_VARS"),
+        m_variableMatchedVarsNames(t, "MATCHED_VARS_NAMES", false),
+        m_variableMatchedVars(t, "MATCHED_VARS", false),
         m_variableFiles(t, "FILES"),
         m_variableRequestCookies(t, "REQUEST_COOKIES"),
         m_variableRequestHeaders(t, "REQUEST_HEADERS"),
@@ -210,6 +252,8 @@ class TransactionAnchoredVariables {
         m_variableArgsPostNames("ARGS_POST_NAMES", &m_variableArgsPost)
         { }
 
+    void resetAnchoredVariables();
+
     AnchoredSetVariable m_variableRequestHeadersNames;
     AnchoredVariable m_variableResponseContentType;
     AnchoredSetVariable m_variableResponseHeadersNames;
@@ -223,6 +267,8 @@ class TransactionAnchoredVariables {
     AnchoredVariable m_variableMatchedVarName;
     AnchoredVariable m_variableMscPcreError;
     AnchoredVariable m_variableMscPcreLimitsExceeded;
+    AnchoredVariable m_variableMscTimeBudgetExceeded;
+    AnchoredVariable m_variableMscMemoryLimitExceeded;
     AnchoredVariable m_variableMultipartBoundaryQuoted;
     AnchoredVariable m_variableMultipartBoundaryWhiteSpace;
     AnchoredVariable m_variableMultipartCrlfLFLines;
@@ -306,7 +352,7 @@ class TransactionSecMarkerManagement {
         return false;
     }
 
-    std::shared_ptr<std::string> getCurrentMarker() const {
+    const std::string *getCurrentMarker() const {
         if (m_marker) {
             return m_marker;
         } else {
@@ -315,15 +361,20 @@ class TransactionSecMarkerManagement {
     }
 
     void removeMarker() {
-        m_marker.reset();
+        m_marker = nullptr;
     }
 
+    /*
+     * name belongs to the rules (skipAfter, SecRuleEarlyDecision), which
+     * outlive the transaction; only the pointer is kept, as a copy of the
+     * shared pointer would write to their memory.
+     */
     void addMarker(const std::shared_ptr<std::string> &name) {
-        m_marker = name;
+        m_marker = name.get();
     }
 
  private:
-    std::shared_ptr<std::string> m_marker;
+    const std::string *m_marker = nullptr;
 };
 
 /** @ingroup ModSecurity_CPP_API */
@@ -338,9 +389,13 @@ class Transaction : public TransactionAnchoredVariables, public TransactionSecMa
     bool operator ==(const Transaction &b) const { return false; };
     Transaction &operator =(const Transaction &b) const = delete;
 
+    void reset();
+    void reset(char *id);
+
     /** TODO: Should be an structure that fits an IP address */
     int processConnection(const char *client, int cPort,
         const char *server, int sPort);
+    int processConnection(Connection *connection);
     int processURI(const char *uri, const char *protocol,
         const char *http_version);
 
@@ -368,7 +423,11 @@ class Transaction : public TransactionAnchoredVariables, public TransactionSecMa
       /**
        *
        */
-      XMLRequestBody
+      XMLRequestBody,
+      /**
+       *
+       */
+      GRPCRequestBody
     };
 
     int processRequestHeaders();
@@ -379,6 +438,7 @@ class Transaction : public TransactionAnchoredVariables, public TransactionSecMa
 
     int processRequestBody();
     int appendRequestBody(const unsigned char *body, size_t size);
+    int appendRequestBody(const struct msc_iovec_t *iov, size_t n);
     int requestBodyFromFile(const char *path);
 
     int processResponseHeaders(int code, const std::string& proto);
@@ -389,11 +449,39 @@ class Transaction : public TransactionAnchoredVariables, public TransactionSecMa
 
     int processResponseBody();
     int appendResponseBody(const unsigned char *body, size_t size);
+    int appendResponseBody(const struct msc_iovec_t *iov, size_t n);
 
     int processLogging();
     int updateStatusCode(int status);
 
     bool intervention(ModSecurityIntervention *it);
+    void timings(ModSecurityTimings *timings) const;
+
+    /**
+     * Traces the transaction (see ModSecurity::setTraceCb): parent is
+     * given back with each span, for the connector to tell its request
+     * apart, e.g. the context of the span of the request. NULL, the
+     * default, is for no tracing. Reset along with the transaction.
+     */
+    void setTraceParent(void *parent) { m_traceParent = parent; }
+
+    /**
+     * Non blocking mode, for event driven connectors: a process*() call
+     * whose phase has rules that may block on I/O (see
+     * RulesSet::mayBlock) hands the phase over to the async threads of
+     * the ModSecurity instance and returns MSC_AGAIN at once. The phase
+     * is then suspended: asyncFd() turns readable once it is done and
+     * resume() gives what the call would have returned. Until then
+     * nothing else of the transaction may be called, and the transaction
+     * must not be deleted.
+     */
+    void setNonBlocking(bool nonBlocking) { m_nonBlocking = nonBlocking; }
+    /* -1 until a phase was suspended */
+    int asyncFd() const { return m_asyncFds[0]; }
+    /* MSC_AGAIN while the suspended phase still goes on. */
+    int resume();
+    /* Waits for the suspended phase, if any, and gives its result. */
+    int wait();
 
     bool addArgument(const std::string& orig, const std::string& key,
         const std::string& value, size_t offset);
@@ -404,35 +492,80 @@ class Transaction : public TransactionAnchoredVariables, public TransactionSecMa
     size_t getResponseBodyLength();
     size_t getRequestBodyLength();
 
+    /*
+     * Whether the rest of the transaction still looks at these, as of the
+     * phases run so far; the connector may pass them straight through
+     * otherwise (ctl:ruleEngine=Off, allow).
+     */
+    bool needsRequestBody() const;
+    bool needsResponseHeaders() const;
+    bool needsResponseBody() const;
+
 #ifndef NO_LOGS
     void debug(int, const std::string&) const;
 #endif
+    void setDebugScope(const RuleWithActions *rule);
     void serverLog(std::shared_ptr<RuleMessage> rm);
 
     int getRuleEngineState() const;
+    bool timeBudgetExceeded();
+    bool accountMemory(size_t bytes);
+    size_t memoryUsage() const;
 
     std::string toJSON(int parts);
+    void toJSON(int parts, std::string *out);
+    void toMsgPack(int parts, std::string *out);
     std::string toOldAuditLogFormat(int parts, const std::string &trailer);
+    void toOldAuditLogFormat(int parts, const std::string &trailer,
+        std::string *out);
     std::string toOldAuditLogFormatIndex(const std::string &filename,
         double size, const std::string &md5);
+    void toOldAuditLogFormatIndex(const std::string &filename,
+        double size, const std::string &md5, std::string *out);
+
+    size_t getTransformationCacheHits() const;
+    size_t getTransformationCacheMisses() const;
 
     /**
-     * Filled during the class instantiation, this variable can be later
-     * used to fill the SecRule variable `duration'. The variable `duration'
-     * is dynamic calculated, it is always relative to the value found in
-     * m_creationTimeStamp.
+     * The version of the rules the transaction was started with, when it
+     * came from a RulesHandle, kept alive until the transaction is gone.
      *
-     * @note There is space for performance improvement. This value don't
-	 *       need to be filled if there is no rule using the variable
-	 *       `duration'.
+     * @note It has to stay the first data member declared by Transaction
+     *       (the methods above aside): members are destroyed in the
+     *       reverse order, so it goes after all of the ones that may
+     *       still refer to the rules. The base classes, destroyed later,
+     *       do not.
      */
-    clock_t m_creationTimeStamp;
+    std::shared_ptr<RulesSet> m_rulesVersion;
+
+    /**
+     * utils::monotonic_ns() when the transaction was created (or reset),
+     * in nanoseconds. The variable `duration' is computed from it.
+     *
+     * @note It was a clock_t of process CPU seconds up to v3.0.10.
+     */
+    uint64_t m_creationTimeStamp;
 
     /**
      * Holds the client IP address.
      */
     std::shared_ptr<std::string> m_clientIpAddress;
 
+    /**
+     * Binary form of m_clientIpAddress (network byte order), filled the
+     * first time @ipMatch or @geoLookup looks at REMOTE_ADDR.
+     * m_clientIpFamily is 0 until then, AF_INET, AF_INET6 or -1 if it is
+     * not a valid address.
+     */
+    int m_clientIpFamily;
+    unsigned char m_clientIpBinary[16];
+
+    /**
+     * The connection the transaction was attached to by
+     * processConnection(Connection *), NULL otherwise.
+     */
+    Connection *m_connection;
+
     /**
      * Holds the HTTP version: 1.2, 2.0, 3.0 and so on....
      */
@@ -503,15 +636,17 @@ class Transaction : public TransactionAnchoredVariables, public TransactionSecMa
     RulesSet *m_rules;
 
     /**
+     * Rule ids removed by ctl:ruleRemoveById, ranges apart.
      *
+     * @note It was a std::list<int> up to v3.0.10.
      */
-    std::list<int > m_ruleRemoveById;
+    std::unordered_set<int> m_ruleRemoveById;
     std::list<std::pair<int, int> > m_ruleRemoveByIdRange;
 
     /**
      *
      */
-    std::list<std::string> m_ruleRemoveByTag;
+    std::list< std::pair<int, std::string> > m_ruleRemoveByTag;
 
     /**
      *
@@ -519,9 +654,11 @@ class Transaction : public TransactionAnchoredVariables, public TransactionSecMa
     std::list< std::pair<std::string, std::string> > m_ruleRemoveTargetByTag;
 
     /**
+     * Targets removed by ctl:ruleRemoveTargetById, by rule id.
      *
+     * @note It was a std::list of (id, target) pairs up to v3.0.10.
      */
-    std::list< std::pair<int, std::string> > m_ruleRemoveTargetById;
+    std::unordered_multimap<int, std::string> m_ruleRemoveTargetById;
 
     /**
      *
@@ -549,15 +686,33 @@ class Transaction : public TransactionAnchoredVariables, public TransactionSecMa
      */
     std::list<modsecurity::RuleMessage> m_rulesMessages;
 
+    /**
+     * The message the rules fill while they are evaluated. Most rules do
+     * not match, so instead of a new one per rule it is reset and handed
+     * to the next rule, unless somebody still holds a reference to it.
+     */
+    std::shared_ptr<modsecurity::RuleMessage> m_ruleMessage;
+
     /**
      * Holds the request body, in case of any.
      */
-    std::ostringstream m_requestBody;
+    BodyBuffer m_requestBody;
 
     /**
      * Holds the response body, in case of any.
      */
-    std::ostringstream m_responseBody;
+    BodyBuffer m_responseBody;
+
+    /**
+     * With SecResponseBodyStreamWindow the response body is inspected as
+     * it is appended and m_responseBody only keeps the window. These are
+     * the bytes appended so far, whether phase 4 is running over one of
+     * the chunks, and the rules that matched an earlier chunk, which are
+     * not run again: over the whole body they would only match once.
+     */
+    size_t m_responseBodyStreamed;
+    bool m_streamingResponseBody;
+    std::unordered_set<const Rule *> m_responseBodyMatches;
 
     /**
      * Contains the unique ID of the transaction. Use by the variable
@@ -590,10 +745,8 @@ class Transaction : public TransactionAnchoredVariables, public TransactionSecMa
     ModSecurityIntervention m_it;
 
     /**
-     * Holds the creation time stamp, using std::time.
-     *
-     * TODO: m_timeStamp and m_creationTimeStamp may be merged into a single
-     *       variable.
+     * Holds the creation time stamp, using std::time. It is wall clock
+     * time, for the logs; durations are measured from m_creationTimeStamp.
      */
     time_t m_timeStamp;
 
@@ -610,8 +763,146 @@ class Transaction : public TransactionAnchoredVariables, public TransactionSecMa
      */
     std::list<std::string> m_matched;
 
+    /**
+     * Body processors, created when the request body turns out to be of
+     * their kind. NULL otherwise.
+     */
     RequestBodyProcessor::XML *m_xml;
     RequestBodyProcessor::JSON *m_json;
+    RequestBodyProcessor::GRPC *m_grpc;
+
+    /**
+     * What REQUEST_COOKIES, REQUEST_COOKIES_NAMES and REQUEST_HEADERS_NAMES
+     * are filled from, the first time a rule looks at them. NULL until a
+     * header goes in one of them.
+     */
+    Utils::PairIndex *m_requestCookiesIndex;
+    Utils::PairIndex *m_requestHeadersNamesIndex;
+
+    /**
+     * Memoized transformation results, only allocated when the rule set
+     * has SecCacheTransformations enabled. NULL otherwise.
+     */
+    actions::transformations::TransformationCache *m_transformationCache;
+
+    /**
+     * Verdicts of @detectSQLi and @detectXSS on the values they already
+     * looked at.
+     */
+    operators::InjectionCache *m_injectionCache;
+
+    /**
+     * Outcome of the merged @pm automata of the rule set (see
+     * RulesSet::pmGroup) on the values they already looked at.
+     */
+    operators::PmGroupCache *m_pmGroupCache;
+
+    /**
+     * The same for the RE2 sets of @rx (see RulesSet::rxGroup).
+     */
+    operators::RxGroupCache *m_rxGroupCache;
+
+    /**
+     * The @rx rules over REQUEST_BODY matched while the body is appended,
+     * when the rule set has any. NULL otherwise.
+     */
+    Utils::RegexStreams *m_requestBodyStreams;
+
+    /**
+     * Inflates the request body as it is appended when it came with a
+     * Content-Encoding of gzip or deflate and SecRequestBodyDecompression
+     * is On. NULL otherwise.
+     */
+    Utils::Inflate *m_requestBodyInflate;
+
+    /**
+     * The same for the response body, with SecResponseBodyDecompression.
+     * Only what is inspected is inflated, the connector still sends the
+     * body on as it came.
+     */
+    Utils::Inflate *m_responseBodyInflate;
+
+    /**
+     * Where the rules record their profile when SecRuleProfiling is On and
+     * this transaction was sampled. NULL otherwise.
+     */
+    Utils::RuleProfilerShard *m_ruleProfile;
+    /**
+     * The profiler m_ruleProfile belongs to. A merge into the rule set
+     * replaces the profiler of the set; this one is kept until the
+     * transaction is done with it.
+     */
+    std::shared_ptr<Utils::RuleProfiler> m_ruleProfiler;
+
+    /**
+     * Rules of the phase being evaluated that were already matched in
+     * parallel (SecRuleEvaluationThreads). NULL otherwise.
+     */
+    RulePrefetches *m_rulePrefetches;
+
+    /**
+     * Overload protection level (SecOverloadTarget) taken when the
+     * request line came in; rules shed from it on are skipped.
+     */
+    int m_overloadLevel;
+
+    /**
+     * SecTransactionTimeBudget: when, in utils::monotonic_ns() time, the
+     * process*() call going on uses up what is left of the budget. 0
+     * outside of them, or without a budget.
+     */
+    uint64_t m_timeBudgetDeadline;
+    unsigned int m_timeBudgetChecks;
+    bool m_timeBudgetExceeded;
+
+    /**
+     * SecTransactionMemoryLimit: an estimate of the bytes taken by the
+     * arguments and headers collected so far (see accountMemory), the
+     * bodies aside, and whether the limit was gone over.
+     */
+    size_t m_memoryUsed;
+    bool m_memoryLimitExceeded;
+
+    /**
+     * SecDebugLogBuffer: the messages above SecDebugLogLevel, up to
+     * m_debugBufferLevel, are kept in m_debugBuffer until the end of the
+     * transaction; -1 and NULL without it. m_intervened tells that the
+     * connector was handed a disruptive intervention.
+     */
+    int m_debugBufferLevel;
+    Utils::DebugLogBuffer *m_debugBuffer;
+    bool m_intervened;
+
+    /* A replay of SecShadowRules: nothing of it goes to the server log. */
+    bool m_shadow;
+
+    /**
+     * The debug level the ms_dbg macros check: the higher of
+     * m_debugScopeLevel, what is written to the debug log, and
+     * m_debugBufferLevel. m_debugScopeLevel is SecDebugLogLevel unless
+     * SecDebugLogFilter leaves the rule running out (see setDebugScope),
+     * and m_debugAddressLevel is that unless it leaves the client out;
+     * -1 when they are left out.
+     */
+    int m_debugLevel;
+    int m_debugScopeLevel;
+    int m_debugAddressLevel;
+
+    /**
+     * SecVerdictCache: the key of the request, empty once it is known
+     * that its verdict is not to be stored, and whether the request
+     * headers phase was answered from the cache.
+     */
+    std::string m_verdictKey;
+    bool m_verdictHit;
+
+    /**
+     * Time spent in each of the process*() calls so far.
+     */
+    ModSecurityTimings m_timings;
+
+    /* What setTraceParent() was given. */
+    void *m_traceParent;
 
     int m_secRuleEngine;
 
@@ -631,6 +922,29 @@ class Transaction : public TransactionAnchoredVariables, public TransactionSecMa
     std::vector<std::shared_ptr<RequestBodyProcessor::MultipartPartTmpFile>> m_multipartPartTmpFiles;
 
  private:
+    int appendPlainRequestBody(const unsigned char *buf, size_t len);
+    int inflateRequestBody(const unsigned char *buf, size_t len);
+    int appendPlainResponseBody(const unsigned char *buf, size_t len);
+    int inflateResponseBody(const unsigned char *buf, size_t len);
+    void streamRequestBody(const unsigned char *buf, size_t len,
+        size_t offset);
+    void streamResponseBody(size_t len);
+    void evaluateResponseBody();
+    void resetTransaction();
+    bool suspend(int phase, TimingScope *scope, std::function<void()> step);
+    void evaluateLogging();
+    void flushCollections();
+    int evaluateConnection();
+    void flushDebugBuffer();
+    void setDebugAddress();
+    void shadow();
+
+    bool m_nonBlocking;
+    /* the pipe the async thread tells through that the phase is done */
+    int m_asyncFds[2];
+    /* a phase was handed over and its byte not read yet by resume() */
+    bool m_suspended;
+
     /**
      * Pointer to the callback function that will be called to fill
      * the web server (connector) log.
@@ -645,6 +959,57 @@ class Transaction : public TransactionAnchoredVariables, public TransactionSecMa
 extern "C" {
 #endif
 
+/**
+ * A header, as handed to msc_add_request_headers. Neither key nor value
+ * has to be NULL terminated.
+ */
+typedef struct msc_header_t {
+    const unsigned char *key;
+    size_t key_len;
+    const unsigned char *value;
+    size_t value_len;
+} msc_header;
+
+/**
+ * A piece of a body. The pieces of a body are taken in order, as if
+ * appended one after the other.
+ */
+typedef struct msc_iovec_t {
+    const unsigned char *base;
+    size_t len;
+} msc_iovec;
+
+/**
+ * Everything about a request that msc_process_request needs to run the
+ * phases 1 and 2 on it. body may be NULL when body_n is 0.
+ */
+typedef struct msc_request_t {
+    const char *client_ip;
+    int client_port;
+    const char *server_ip;
+    int server_port;
+    const char *uri;
+    const char *method;
+    const char *http_version;
+    const msc_header *headers;
+    size_t headers_n;
+    const msc_iovec *body;
+    size_t body_n;
+} msc_request;
+
+/**
+ * The response side of msc_request, for msc_process_response to run
+ * the phases 3 and 4.
+ */
+typedef struct msc_response_t {
+    int code;
+    const char *protocol;
+    const msc_header *headers;
+    size_t headers_n;
+    const msc_iovec *body;
+    size_t body_n;
+} msc_response;
+
 /** @ingroup ModSecurity_C_API */
 Transaction *msc_new_transaction(ModSecurity *ms,
     RulesSet *rules, void *logCbData);
@@ -669,6 +1034,17 @@ int msc_add_n_request_header(Transaction *transaction,
     const unsigned char *key, size_t len_key, const unsigned char *value,
     size_t len_value);
 
+/** @ingroup ModSecurity_C_API */
+int msc_add_request_headers(Transaction *transaction,
+    const msc_header *headers, size_t n);
+
+/** @ingroup ModSecurity_C_API */
+int msc_process_request(Transaction *transaction, const msc_request *req);
+
+/** @ingroup ModSecurity_C_API */
+int msc_process_response(Transaction *transaction,
+    const msc_response *res);
+
 /** @ingroup ModSecurity_C_API */
 int msc_process_request_body(Transaction *transaction);
 
@@ -676,6 +1052,10 @@ int msc_process_request_body(Transaction *transaction);
 int msc_append_request_body(Transaction *transaction,
     const unsigned char *body, size_t size);
 
+/** @ingroup ModSecurity_C_API */
+int msc_append_request_body_iov(Transaction *transaction,
+    const msc_iovec *iov, size_t n);
+
 /** @ingroup ModSecurity_C_API */
 int msc_request_body_from_file(Transaction *transaction, const char *path);
 
@@ -699,6 +1079,10 @@ int msc_process_response_body(Transaction *transaction);
 int msc_append_response_body(Transaction *transaction,
     const unsigned char *body, size_t size);
 
+/** @ingroup ModSecurity_C_API */
+int msc_append_response_body_iov(Transaction *transaction,
+    const msc_iovec *iov, size_t n);
+
 /** @ingroup ModSecurity_C_API */
 int msc_process_uri(Transaction *transaction, const char *uri,
     const char *protocol, const char *http_version);
@@ -712,18 +1096,52 @@ size_t msc_get_response_body_length(Transaction *transaction);
 /** @ingroup ModSecurity_C_API */
 size_t msc_get_request_body_length(Transaction *transaction);
 
+/** @ingroup ModSecurity_C_API */
+size_t msc_transaction_memory_usage(Transaction *transaction);
+
+/** @ingroup ModSecurity_C_API */
+int msc_needs_request_body(Transaction *transaction);
+
+/** @ingroup ModSecurity_C_API */
+int msc_needs_response_headers(Transaction *transaction);
+
+/** @ingroup ModSecurity_C_API */
+int msc_needs_response_body(Transaction *transaction);
+
 /** @ingroup ModSecurity_C_API */
 void msc_transaction_cleanup(Transaction *transaction);
 
+/** @ingroup ModSecurity_C_API */
+void msc_transaction_reset(Transaction *transaction);
+
+/** @ingroup ModSecurity_C_API */
+void msc_transaction_reset_with_id(Transaction *transaction, char *id);
+
 /** @ingroup ModSecurity_C_API */
 int msc_intervention(Transaction *transaction, ModSecurityIntervention *it);
 
 /** @ingroup ModSecurity_C_API */
 int msc_process_logging(Transaction *transaction);
 
+/** @ingroup ModSecurity_C_API */
+int msc_get_timings(Transaction *transaction, ModSecurityTimings *timings);
+
+/** @ingroup ModSecurity_C_API */
+void msc_set_trace_parent(Transaction *transaction, void *parent);
+
 /** @ingroup ModSecurity_C_API */
 int msc_update_status_code(Transaction *transaction, int status);
 
+/** @ingroup ModSecurity_C_API */
+void msc_transaction_set_non_blocking(Transaction *transaction,
+    int nonBlocking);
+
+/** @ingroup ModSecurity_C_API */
+int msc_transaction_fd(Transaction *transaction);
+
+/** @ingroup ModSecurity_C_API */
+int msc_transaction_resume(Transaction *transaction);
+
 #ifdef __cplusplus
 }
 }  // namespace modsecurity
@@ -15,11 +15,13 @@
 
 
 #ifdef __cplusplus
+#include <atomic>
 #include <string>
 #include <iostream>
 #include <memory>
 #include <list>
 #include <utility>
+#include <vector>
 #endif
 
 #include "modsecurity/variable_origin.h"
@@ -37,54 +39,117 @@ namespace modsecurity {
 class Collection;
 class VariableValue {
  public:
-    using Origins = std::list<std::unique_ptr<VariableOrigin>>;
+    /**
+     * Where the value came from, in order. Nearly every value has a single
+     * origin, which is kept inline; a second one moves them all to the
+     * heap.
+     */
+    class Origins {
+     public:
+        Origins() : m_count(0), m_more(nullptr) { }
+        ~Origins() { delete m_more; }
+
+        Origins(const Origins &o) = delete;
+        Origins &operator=(const Origins &o) = delete;
+
+        void push_back(const VariableOrigin &origin) {
+            if (m_more != nullptr) {
+                m_more->push_back(origin);
+            } else if (m_count == 0) {
+                m_first = origin;
+                m_count = 1;
+            } else {
+                m_more = new std::vector<VariableOrigin>();
+                m_more->reserve(2);
+                m_more->push_back(m_first);
+                m_more->push_back(origin);
+            }
+        }
+
+        void clear() {
+            delete m_more;
+            m_more = nullptr;
+            m_count = 0;
+        }
+
+        const VariableOrigin *begin() const {
+            return m_more != nullptr ? m_more->data() : &m_first;
+        }
+        const VariableOrigin *end() const {
+            return m_more != nullptr ? m_more->data() + m_more->size()
+                : &m_first + m_count;
+        }
+        size_t size() const {
+            return m_more != nullptr ? m_more->size() : m_count;
+        }
+        bool empty() const { return size() == 0; }
+
+     private:
+        VariableOrigin m_first;
+        size_t m_count;
+        std::vector<VariableOrigin> *m_more;
+    };
 
     explicit VariableValue(const std::string *key,
         const std::string *value = nullptr)
-        : m_collection(""),
+        : m_collection(internCollection(std::string())),
         m_key(*key),
-        m_keyWithCollection(*key),
+        m_keyWithCollection(nullptr),
         m_value(value != nullptr?*value:"")
     { }
 
     VariableValue(const std::string *collection,
         const std::string *key,
         const std::string *value)
-        : m_collection(*collection),
+        : m_collection(internCollection(*collection)),
         m_key(*key),
-        m_keyWithCollection(*collection + ":" + *key),
+        m_keyWithCollection(nullptr),
         m_value(*value)
     { }
 
     explicit VariableValue(const VariableValue *o) :
         m_collection(o->m_collection),
         m_key(o->m_key),
-        m_keyWithCollection(o->m_keyWithCollection),
+        m_keyWithCollection(nullptr),
         m_value(o->m_value)
     {
-        for (auto &i : o->m_orign) {
-            std::unique_ptr<VariableOrigin> origin(new VariableOrigin());
-            origin->m_offset = i->m_offset;
-            origin->m_length = i->m_length;
-            m_orign.push_back(std::move(origin));
+        for (const VariableOrigin &i : o->m_orign) {
+            m_orign.push_back(i);
         }
     }
 
     VariableValue(const VariableValue &v) = delete;
 
+    ~VariableValue() {
+        delete m_keyWithCollection.load(std::memory_order_relaxed);
+    }
+
 
     const std::string& getKey() const {
         return m_key;
     }
 
 
+    /**
+     * collection:key, or just the key when there is no collection. Built
+     * the first time it is asked for; values that are only stored (the
+     * arguments, the headers) never pay for it.
+     */
     const std::string& getKeyWithCollection() const {
-        return m_keyWithCollection;
+        if (m_collection->empty()) {
+            return m_key;
+        }
+        const std::string *k = m_keyWithCollection.load(
+            std::memory_order_acquire);
+        if (k == nullptr) {
+            k = buildKeyWithCollection();
+        }
+        return *k;
     }
 
 
     const std::string& getCollection() const {
-        return m_collection;
+        return *m_collection;
     }
 
 
@@ -98,8 +163,18 @@ class VariableValue {
     }
 
 
+    void setValue(std::string &&value) {
+        m_value = std::move(value);
+    }
+
+
+    void addOrigin(const VariableOrigin &origin) {
+        m_orign.push_back(origin);
+    }
+
+
     void addOrigin(std::unique_ptr<VariableOrigin> origin) {
-        m_orign.push_back(std::move(origin));
+        m_orign.push_back(*origin);
     }
 
 
@@ -107,11 +182,24 @@ class VariableValue {
         return m_orign;
     }
 
+
+    void clearOrigin() {
+        m_orign.clear();
+    }
+
  private:
+    /*
+     * The process wide copy of a collection name: the values of a
+     * collection all point to the same string.
+     */
+    static const std::string *internCollection(const std::string &name);
+    const std::string *buildKeyWithCollection() const;
+
     Origins m_orign;
-    std::string m_collection;
+    const std::string *m_collection;
     std::string m_key;
-    std::string m_keyWithCollection;
+    /* values may be evaluated, borrowed, by more than one thread */
+    mutable std::atomic<const std::string *> m_keyWithCollection;
     std::string m_value;
 };
 
@@ -19,6 +19,7 @@
 #include <string>
 
 #include "modsecurity/transaction.h"
+#include "src/utils/interned_strings.h"
 
 namespace modsecurity {
 namespace actions {
@@ -28,12 +29,13 @@ namespace ctl {
 bool RuleRemoveByTag::init(std::string *error) {
     std::string what(m_parser_payload, 16, m_parser_payload.size() - 16);
     m_tag = what;
+    m_tagId = Utils::InternedStrings::id(m_tag);
 
     return true;
 }
 
 bool RuleRemoveByTag::evaluate(RuleWithActions *rule, Transaction *transaction) {
-    transaction->m_ruleRemoveByTag.push_back(m_tag);
+    transaction->m_ruleRemoveByTag.emplace_back(m_tagId, m_tag);
     return true;
 }
 
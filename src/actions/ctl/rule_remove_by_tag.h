@@ -31,12 +31,14 @@ class RuleRemoveByTag : public Action {
  public:
     explicit RuleRemoveByTag(const std::string &action) 
         : Action(action, RunTimeOnlyIfMatchKind),
-        m_tag("") { }
+        m_tag(""),
+        m_tagId(-1) { }
 
     bool init(std::string *error) override;
     bool evaluate(RuleWithActions *rule, Transaction *transaction) override;
 
     std::string m_tag;
+    int m_tagId;
 };
 
 
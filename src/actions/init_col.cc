@@ -21,6 +21,7 @@
 #include "modsecurity/actions/action.h"
 #include "modsecurity/transaction.h"
 #include "modsecurity/rule.h"
+#include "modsecurity/rules_set.h"
 
 
 namespace modsecurity {
@@ -56,16 +57,22 @@ bool InitCol::init(std::string *error) {
 
 bool InitCol::evaluate(RuleWithActions *rule, Transaction *t) {
     std::string collectionName(m_string->evaluate(t));
+    collection::Collection **collection;
 
     if (m_collection_key == "ip") {
         t->m_collections.m_ip_collection_key = collectionName;
+        collection = &t->m_collections.m_ip_collection;
     } else if (m_collection_key == "global") {
         t->m_collections.m_global_collection_key = collectionName;
+        collection = &t->m_collections.m_global_collection;
     } else if (m_collection_key == "resource") {
         t->m_collections.m_resource_collection_key = collectionName;
+        collection = &t->m_collections.m_resource_collection;
     } else {
         return false;
     }
+    t->m_collections.snapshot(collection, collectionName,
+        t->m_rules->m_secWebAppId.m_value);
 
     ms_dbg_a(t, 5, "Collection `" + m_collection_key + "' initialized with " \
         "value: " + collectionName);
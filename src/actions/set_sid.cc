@@ -20,6 +20,7 @@
 
 #include "modsecurity/transaction.h"
 #include "modsecurity/rule.h"
+#include "modsecurity/rules_set.h"
 
 
 namespace modsecurity {
@@ -37,6 +38,8 @@ bool SetSID::evaluate(RuleWithActions *rule, Transaction *t) {
         + colNameExpanded + "\'.");
 
     t->m_collections.m_session_collection_key = colNameExpanded;
+    t->m_collections.snapshot(&t->m_collections.m_session_collection,
+        colNameExpanded, t->m_rules->m_secWebAppId.m_value);
     t->m_variableSessionID.set(colNameExpanded, t->m_variableOffset);
 
     return true;
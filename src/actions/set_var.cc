@@ -19,6 +19,7 @@
 #include <string>
 #include <memory>
 
+#include "modsecurity/collection/collection.h"
 #include "modsecurity/rules_set.h"
 #include "modsecurity/transaction.h"
 #include "modsecurity/rule.h"
@@ -36,6 +37,12 @@ namespace actions {
 
 
 bool SetVar::init(std::string *error) {
+    if ((m_operation == sumAndSetOperation
+        || m_operation == substractAndSetOperation)
+        && m_string && m_string->containsMacro() == false) {
+        m_delta = collection::Collection::toInt(m_string->evaluate());
+        m_constantDelta = true;
+    }
     return true;
 }
 
@@ -44,7 +51,7 @@ bool SetVar::evaluate(RuleWithActions *rule, Transaction *t) {
     std::string targetValue;
     std::string resolvedPre;
 
-    if (m_string) {
+    if (m_string && m_constantDelta == false) {
         resolvedPre = m_string->evaluate(t, rule);
     }
 
@@ -101,36 +108,35 @@ bool SetVar::evaluate(RuleWithActions *rule, Transaction *t) {
         }
         goto end;
     } else {
-        int pre = 0;
+        int pre = m_constantDelta ? m_delta
+            : collection::Collection::toInt(resolvedPre);
         int value = 0;
 
-        try {
-            pre = stoi(resolvedPre);
-        } catch (...) {
-            pre = 0;
+        if (m_operation == substractAndSetOperation) {
+            pre = -pre;
         }
 
-        try {
-            std::vector<const VariableValue *> l;
-            RuleWithOperator *rr = dynamic_cast<RuleWithOperator *>(rule);
-            m_variable->evaluate(t, rr, &l);
-            if (l.size() == 0) {
-                value = 0;
-            } else {
-                value = stoi(l[0]->getValue());
-                for (auto &i : l) {
-                    delete i;
-                }
-            }
-        } catch (...) {
-            value = 0;
+        /* read, sum and write in a single step of the backend */
+        if (tx) {
+            tx->atomicAdd(t, m_variableNameExpanded, pre, &value);
+        } else if (session) {
+            session->atomicAdd(t, m_variableNameExpanded, pre, &value);
+        } else if (ip) {
+            ip->atomicAdd(t, m_variableNameExpanded, pre, &value);
+        } else if (resource) {
+            resource->atomicAdd(t, m_variableNameExpanded, pre, &value);
+        } else if (global) {
+            global->atomicAdd(t, m_variableNameExpanded, pre, &value);
+        } else if (user) {
+            user->atomicAdd(t, m_variableNameExpanded, pre, &value);
+        } else {
+            // ?
         }
 
-        if (m_operation == sumAndSetOperation) {
-            targetValue = std::to_string(value + pre);
-        } else if (m_operation == substractAndSetOperation) {
-            targetValue = std::to_string(value - pre);
-        }
+        ms_dbg_a(t, 8, "Saving variable: " + m_variable->m_collectionName \
+            + ":" + m_variableNameExpanded + " with value: " \
+            + std::to_string(value));
+        goto end;
     }
 
     ms_dbg_a(t, 8, "Saving variable: " + m_variable->m_collectionName \
@@ -50,21 +50,33 @@ class SetVar : public Action {
         : Action("setvar"),
         m_operation(operation),
         m_variable(std::move(variable)),
-        m_string(std::move(predicate)) { }
+        m_string(std::move(predicate)),
+        m_constantDelta(false),
+        m_delta(0) { }
 
     SetVar(SetVarOperation operation,
         std::unique_ptr<modsecurity::variables::Variable> variable)
         : Action("setvar"),
         m_operation(operation),
-        m_variable(std::move(variable)) { }
+        m_variable(std::move(variable)),
+        m_constantDelta(false),
+        m_delta(0) { }
 
     bool evaluate(RuleWithActions *rule, Transaction *transaction) override;
     bool init(std::string *error) override;
 
+    const variables::Variable *getVariable() const {
+        return m_variable.get();
+    }
+    const RunTimeString *getValue() const { return m_string.get(); }
+
  private:
     SetVarOperation m_operation;
     std::unique_ptr<modsecurity::variables::Variable> m_variable;
     std::unique_ptr<RunTimeString> m_string;
+    /* =+ and =- of a number without macros, read once by init() */
+    bool m_constantDelta;
+    int m_delta;
 };
 
 }  // namespace actions
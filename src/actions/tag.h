@@ -37,6 +37,7 @@ class Tag : public Action {
         m_string(std::move(z)) { }
 
     std::string getName(Transaction *transaction);
+    inline bool containsMacro() const { return m_string->containsMacro(); }
 
     bool evaluate(RuleWithActions *rule, Transaction *transaction,
         std::shared_ptr<RuleMessage> rm) override;
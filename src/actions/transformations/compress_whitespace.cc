@@ -20,10 +20,12 @@
 #include <algorithm>
 #include <functional>
 #include <cctype>
+#include <cstring>
 #include <locale>
 
 #include "modsecurity/transaction.h"
 #include "src/actions/transformations/transformation.h"
+#include "src/utils/byte_scan.h"
 
 
 namespace modsecurity {
@@ -37,28 +39,46 @@ CompressWhitespace::CompressWhitespace(const std::string &action)
 
 std::string CompressWhitespace::evaluate(const std::string &value,
     Transaction *transaction) {
+    std::string a(value);
+    transform(a, transaction);
+    return a;
+}
 
-    std::string a;
-    int inWhiteSpace = 0;
-    int i = 0;
 
+bool CompressWhitespace::transform(std::string &value,
+    Transaction *transaction) {
+    bool inWhiteSpace = false;
+    bool changed = false;
+    size_t j = 0;
+
+    size_t i = 0;
     while (i < value.size()) {
-        if (isspace(value[i])) {
-            if (inWhiteSpace) {
-                i++;
-                continue;
-            } else {
-                inWhiteSpace = 1;
-                a.append(" ", 1);
+        size_t n = utils::scan::findSpace(value.data() + i, value.size() - i);
+        if (n > 0) {
+            /* no whitespace in there, copied (if needed at all) as a run */
+            if (j != i) {
+                memmove(&value[j], &value[i], n);
             }
+            i = i + n;
+            j = j + n;
+            inWhiteSpace = false;
+            continue;
+        }
+
+        if (inWhiteSpace) {
+            changed = true;
         } else {
-            inWhiteSpace = 0;
-            a.append(&value.at(i), 1);
+            inWhiteSpace = true;
+            if (value[i] != ' ') {
+                changed = true;
+            }
+            value[j++] = ' ';
         }
         i++;
     }
+    value.resize(j);
 
-    return a;
+    return changed;
 }
 
 }  // namespace transformations
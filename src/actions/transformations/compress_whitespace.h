@@ -35,6 +35,8 @@ class CompressWhitespace : public Transformation {
 
     std::string evaluate(const std::string &exp,
         Transaction *transaction) override;
+    bool transform(std::string &value,
+        Transaction *transaction) override;
 };
 
 }  // namespace transformations
@@ -26,6 +26,7 @@
 
 #include "modsecurity/transaction.h"
 #include "src/actions/transformations/transformation.h"
+#include "src/utils/allocator.h"
 #include "src/utils/string.h"
 
 
@@ -38,7 +39,7 @@ std::string CssDecode::evaluate(const std::string &value,
     Transaction *transaction) {
 
     char *tmp = reinterpret_cast<char *>(
-        malloc(sizeof(char) * value.size() + 1));
+        Utils::Allocator::malloc(sizeof(char) * value.size() + 1));
     memcpy(tmp, value.c_str(), value.size() + 1);
     tmp[value.size()] = '\0';
 
@@ -46,7 +47,7 @@ std::string CssDecode::evaluate(const std::string &value,
         value.size());
 
     std::string ret(tmp, 0, value.size());
-    free(tmp);
+    Utils::Allocator::free(tmp);
     return ret;
 }
 
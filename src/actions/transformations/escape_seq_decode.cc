@@ -25,6 +25,7 @@
 
 #include "modsecurity/transaction.h"
 #include "src/actions/transformations/transformation.h"
+#include "src/utils/allocator.h"
 #include "src/utils/string.h"
 
 namespace modsecurity {
@@ -143,8 +144,8 @@ int EscapeSeqDecode::ansi_c_sequences_decode_inplace(unsigned char *input,
 std::string EscapeSeqDecode::evaluate(const std::string &value,
     Transaction *transaction) {
 
-    unsigned char *tmp = (unsigned char *) malloc(sizeof(char)
-        * value.size() + 1);
+    unsigned char *tmp = (unsigned char *) Utils::Allocator::malloc(
+        sizeof(char) * value.size() + 1);
     memcpy(tmp, value.c_str(), value.size() + 1);
     tmp[value.size()] = '\0';
 
@@ -152,7 +153,7 @@ std::string EscapeSeqDecode::evaluate(const std::string &value,
 
     std::string ret("");
     ret.assign(reinterpret_cast<char *>(tmp), size);
-    free(tmp);
+    Utils::Allocator::free(tmp);
 
     return ret;
 }
@@ -0,0 +1,191 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/actions/transformations/fused.h"
+
+#include <locale>
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include "modsecurity/transaction.h"
+#include "src/actions/transformations/compress_whitespace.h"
+#include "src/actions/transformations/lower_case.h"
+#include "src/actions/transformations/parity_even_7bit.h"
+#include "src/actions/transformations/parity_odd_7bit.h"
+#include "src/actions/transformations/parity_zero_7bit.h"
+#include "src/actions/transformations/remove_nulls.h"
+#include "src/actions/transformations/remove_whitespace.h"
+#include "src/actions/transformations/replace_nulls.h"
+#include "src/actions/transformations/transformation.h"
+#include "src/actions/transformations/trim.h"
+#include "src/actions/transformations/trim_left.h"
+#include "src/actions/transformations/trim_right.h"
+#include "src/actions/transformations/upper_case.h"
+
+
+namespace modsecurity {
+namespace actions {
+namespace transformations {
+
+
+Fused::Fused(const std::vector<Transformation *> &steps)
+    : Transformation("t:fused"),
+    m_hasTable(false) {
+    std::string name;
+
+    for (Transformation *t : steps) {
+        if (name.empty() == false) {
+            name.push_back(',');
+        }
+        name.append(*t->m_name.get());
+
+        if (m_steps.empty() || isIdempotent(t) == false
+            || typeid(*m_steps.back()) != typeid(*t)) {
+            m_steps.push_back(t);
+        }
+    }
+    m_name = std::make_shared<std::string>(name);
+
+    /*
+     * The table is computed by the steps themselves. t:uppercase depends
+     * on the locale, the table is only valid (and used) for the classic
+     * one.
+     */
+    m_hasTable = m_steps.size() > 1 && std::locale() == std::locale::classic();
+    for (Transformation *t : m_steps) {
+        m_hasTable = m_hasTable && isByteMap(t);
+    }
+    for (int c = 0; m_hasTable && c < 256; c++) {
+        std::string b(1, static_cast<char>(c));
+        for (Transformation *t : m_steps) {
+            t->transform(b, nullptr);
+        }
+        if (b.size() != 1) {
+            m_hasTable = false;
+            break;
+        }
+        m_table[c] = static_cast<unsigned char>(b[0]);
+    }
+}
+
+
+std::string Fused::evaluate(const std::string &value,
+    Transaction *transaction) {
+    std::string ret(value);
+    transform(ret, transaction);
+    return ret;
+}
+
+
+bool Fused::transform(std::string &value, Transaction *transaction) {
+    if (m_hasTable == false || (std::locale() == std::locale::classic())
+        == false) {
+        return runSteps(value, transaction);
+    }
+
+    bool changed = false;
+    for (size_t i = 0; i < value.size(); i++) {
+        unsigned char c = static_cast<unsigned char>(value[i]);
+        if (m_table[c] != c) {
+            value[i] = static_cast<char>(m_table[c]);
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+
+bool Fused::runSteps(std::string &value, Transaction *transaction) {
+    bool changed = false;
+    for (Transformation *t : m_steps) {
+        if (t->transform(value, transaction)) {
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+
+/**
+ * Applying any of those twice gives the same as applying it once.
+ *
+ */
+bool Fused::isIdempotent(Transformation *t) {
+    return dynamic_cast<LowerCase *>(t) || dynamic_cast<UpperCase *>(t)
+        || dynamic_cast<RemoveNulls *>(t) || dynamic_cast<ReplaceNulls *>(t)
+        || dynamic_cast<CompressWhitespace *>(t)
+        || dynamic_cast<RemoveWhitespace *>(t)
+        || dynamic_cast<Trim *>(t) || dynamic_cast<TrimLeft *>(t)
+        || dynamic_cast<TrimRight *>(t)
+        || dynamic_cast<ParityEven7bit *>(t)
+        || dynamic_cast<ParityOdd7bit *>(t)
+        || dynamic_cast<ParityZero7bit *>(t);
+}
+
+
+/**
+ * Transformations that map every byte to exactly one byte, regardless of
+ * its neighbours. t:lowercase and t:removeNulls are not in here on purpose:
+ * their vectorized scans are faster than a table lookup per byte.
+ *
+ */
+bool Fused::isByteMap(Transformation *t) {
+    return dynamic_cast<UpperCase *>(t) || dynamic_cast<ReplaceNulls *>(t)
+        || dynamic_cast<ParityEven7bit *>(t)
+        || dynamic_cast<ParityOdd7bit *>(t)
+        || dynamic_cast<ParityZero7bit *>(t);
+}
+
+
+void Fused::optimize(const Transformations &transformations,
+    Transformations *chain,
+    std::vector<std::shared_ptr<Transformation>> *owned) {
+    size_t i = 0;
+
+    while (i < transformations.size()) {
+        Transformation *t = transformations[i];
+        size_t end = i + 1;
+
+        if (isByteMap(t)) {
+            while (end < transformations.size()
+                && isByteMap(transformations[end])) {
+                end++;
+            }
+        } else if (isIdempotent(t)) {
+            while (end < transformations.size()
+                && typeid(*transformations[end]) == typeid(*t)) {
+                end++;
+            }
+        }
+
+        if (end - i == 1) {
+            chain->push_back(t);
+        } else {
+            std::shared_ptr<Transformation> fused = std::make_shared<Fused>(
+                std::vector<Transformation *>(transformations.begin() + i,
+                    transformations.begin() + end));
+            owned->push_back(fused);
+            chain->push_back(fused.get());
+        }
+        i = end;
+    }
+}
+
+
+}  // namespace transformations
+}  // namespace actions
+}  // namespace modsecurity
@@ -0,0 +1,84 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "modsecurity/rule.h"
+#include "src/actions/transformations/transformation.h"
+
+#ifndef SRC_ACTIONS_TRANSFORMATIONS_FUSED_H_
+#define SRC_ACTIONS_TRANSFORMATIONS_FUSED_H_
+
+#ifdef __cplusplus
+
+namespace modsecurity {
+class Transaction;
+namespace actions {
+namespace transformations {
+
+
+/**
+ * A run of adjacent transformations of a rule executed as one.
+ *
+ * Built at rule load by optimize(): repeated idempotent transformations
+ * (t:lowercase,t:lowercase) are executed once and runs of byte to byte
+ * maps (t:uppercase, t:replaceNulls, t:parity*) are folded into a single
+ * lookup table, applied in one pass. The name is the one of the run, as
+ * it would appear in the transformation path, so the logs, the audit log
+ * and the transformation cache keys are unaffected.
+ *
+ * The intermediate values are not produced, which is why rules with
+ * multiMatch are left alone.
+ *
+ */
+class Fused : public Transformation {
+ public:
+    explicit Fused(const std::vector<Transformation *> &steps);
+
+    std::string evaluate(const std::string &exp,
+        Transaction *transaction) override;
+    bool transform(std::string &value,
+        Transaction *transaction) override;
+
+    /*
+     * Fills chain with what has to be executed for transformations; owned
+     * keeps the Fused instances that were created.
+     */
+    static void optimize(const Transformations &transformations,
+        Transformations *chain,
+        std::vector<std::shared_ptr<Transformation>> *owned);
+
+    static bool isIdempotent(Transformation *t);
+    static bool isByteMap(Transformation *t);
+
+ private:
+    bool runSteps(std::string &value, Transaction *transaction);
+
+    /* the steps, with the repetitions already removed */
+    std::vector<Transformation *> m_steps;
+    bool m_hasTable;
+    unsigned char m_table[256];
+};
+
+
+}  // namespace transformations
+}  // namespace actions
+}  // namespace modsecurity
+
+#endif
+
+#endif  // SRC_ACTIONS_TRANSFORMATIONS_FUSED_H_
@@ -34,25 +34,24 @@ namespace transformations {
 
 std::string HexDecode::evaluate(const std::string &value,
     Transaction *transaction) {
-    std::string ret;
-    unsigned char *input;
-    int size = 0;
+    std::string ret(value);
+    transform(ret, transaction);
+    return ret;
+}
 
-    input = reinterpret_cast<unsigned char *>
-        (malloc(sizeof(char) * value.length()+1));
 
-    if (input == NULL) {
-        return "";
+bool HexDecode::transform(std::string &value,
+    Transaction *transaction) {
+    if (value.empty()) {
+        return false;
     }
 
-    memcpy(input, value.c_str(), value.length()+1);
+    /* every pair of bytes becomes one, there is always a change */
+    int size = inplace(reinterpret_cast<unsigned char *>(&value[0]),
+        value.length());
+    value.resize(size);
 
-    size = inplace(input, value.length());
-
-    ret.assign(reinterpret_cast<char *>(input), size);
-    free(input);
-
-    return ret;
+    return true;
 }
 
 
@@ -34,6 +34,8 @@ class HexDecode : public Transformation {
 
     std::string evaluate(const std::string &exp,
         Transaction *transaction) override;
+    bool transform(std::string &value,
+        Transaction *transaction) override;
 
     static int inplace(unsigned char *data, int len);
 };
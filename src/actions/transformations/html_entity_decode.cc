@@ -16,7 +16,9 @@
 #include "src/actions/transformations/html_entity_decode.h"
 
 #include <string.h>
+#include <strings.h>
 
+#include <climits>
 #include <iostream>
 #include <string>
 #include <algorithm>
@@ -35,27 +37,91 @@ namespace transformations {
 
 std::string HtmlEntityDecode::evaluate(const std::string &value,
     Transaction *transaction) {
-    std::string ret;
-    unsigned char *input;
+    std::string ret(value);
+    transform(ret, transaction);
+    return ret;
+}
 
-    input = reinterpret_cast<unsigned char *>
-        (malloc(sizeof(char) * value.length()+1));
 
-    if (input == NULL) {
-        return "";
+bool HtmlEntityDecode::transform(std::string &value,
+    Transaction *transaction) {
+    if (value.find('&') == std::string::npos) {
+        return false;
     }
 
-    memcpy(input, value.c_str(), value.length()+1);
+    /*
+     * Every decoded entity takes at least two bytes and leaves one, so the
+     * value was changed if and only if it shrunk.
+     */
+    size_t size = value.length();
+    size_t i = inplace(reinterpret_cast<unsigned char *>(&value[0]),
+        value.length());
+    value.resize(i);
 
-    size_t i = inplace(input, value.length());
+    return i != size;
+}
 
-    ret.assign(reinterpret_cast<char *>(input), i);
-    free(input);
 
-    return ret;
+namespace {
+
+
+/*
+ * The value of the digits from k to j, as strtol() gives it: a number too
+ * large for a long saturates to LONG_MAX, whose low byte is 0xff.
+ */
+unsigned char numericEntity(const unsigned char *input, int k, int j,
+    int base) {
+    unsigned long value = 0;
+
+    for (; k < j; k++) {
+        unsigned char c = input[k];
+        unsigned long digit = isdigit(c) ? c - '0' : (c | 0x20) - 'a' + 10;
+        if (value > (LONG_MAX - digit) / base) {
+            return 0xff;
+        }
+        value = value * base + digit;
+    }
+    return static_cast<unsigned char>(value);
+}
+
+
+/*
+ * The character of the named entity from k to j, -1 if it is not one of
+ * those decoded. Picking on the length first leaves a single comparison.
+ */
+int namedEntity(const unsigned char *input, int k, int j) {
+    const char *name = reinterpret_cast<const char *>(&input[k]);
+
+    switch (j - k) {
+        case 2:
+            if (strncasecmp(name, "lt", 2) == 0) {
+                return '<';
+            }
+            if (strncasecmp(name, "gt", 2) == 0) {
+                return '>';
+            }
+            break;
+        case 3:
+            if (strncasecmp(name, "amp", 3) == 0) {
+                return '&';
+            }
+            break;
+        case 4:
+            if (strncasecmp(name, "quot", 4) == 0) {
+                return '"';
+            }
+            if (strncasecmp(name, "nbsp", 4) == 0) {
+                return NBSP;
+            }
+            break;
+    }
+    return -1;
 }
 
 
+}  // namespace
+
+
 int HtmlEntityDecode::inplace(unsigned char *input, uint64_t input_len) {
     unsigned char *d = input;
     int i, count;
@@ -65,13 +131,27 @@ int HtmlEntityDecode::inplace(unsigned char *input, uint64_t input_len) {
     }
 
     i = count = 0;
-    while ((i < input_len) && (count < input_len)) {
-        int z, copy = 1;
+    while (i < input_len) {
+        int copy = 1;
+
+        /* Everything up to the next ampersand is kept as it is. */
+        if (input[i] != '&') {
+            const unsigned char *amp = static_cast<const unsigned char *>(
+                memchr(input + i, '&', input_len - i));
+            int run = (amp == NULL ? input_len : amp - input) - i;
+            if (d != input + i) {
+                memmove(d, input + i, run);
+            }
+            d += run;
+            count += run;
+            i += run;
+            continue;
+        }
 
         /* Require an ampersand and at least one character to
          * start looking into the entity.
          */
-        if ((input[i] == '&') && (i + 1 < input_len)) {
+        if (i + 1 < input_len) {
             int k, j = i + 1;
 
             if (input[j] == '#') {
@@ -83,6 +163,7 @@ int HtmlEntityDecode::inplace(unsigned char *input, uint64_t input_len) {
                 }
                 j++;
 
+                int base = 10;
                 if ((input[j] == 'x') || (input[j] == 'X')) {
                     /* Hexadecimal entity. */
                     copy++;
@@ -91,111 +172,55 @@ int HtmlEntityDecode::inplace(unsigned char *input, uint64_t input_len) {
                         goto HTML_ENT_OUT; /* Not enough bytes. */
                     }
                     j++; /* j is the position of the first digit now. */
+                    base = 16;
+                }
 
-                    k = j;
-                    while ((j < input_len) && (isxdigit(input[j]))) {
-                        j++;
-                    }
-                    if (j > k) { /* Do we have at least one digit? */
-                        /* Decode the entity. */
-                        char *x;
-                        x = reinterpret_cast<char *>(calloc(sizeof(char),
-                            ((j - k) + 1)));
-                        memcpy(x, (const char *)&input[k], j - k);
-                        *d++ = (unsigned char)strtol(x, NULL, 16);
-                        free(x);
-                        count++;
-
-                        /* Skip over the semicolon if it's there. */
-                        if ((j < input_len) && (input[j] == ';')) {
-                            i = j + 1;
-                        } else {
-                            i = j;
-                        }
-                        continue;
-                    } else {
-                        goto HTML_ENT_OUT;
-                    }
-                } else {
-                    /* Decimal entity. */
-                    k = j;
-                    while ((j < input_len) && (isdigit(input[j]))) {
-                        j++;
-                    }
-                    if (j > k) { /* Do we have at least one digit? */
-                        /* Decode the entity. */
-                        char *x;
-                        x = reinterpret_cast<char *>(calloc(sizeof(char),
-                            ((j - k) + 1)));
-                        memcpy(x, (const char *)&input[k], j - k);
-                        *d++ = (unsigned char)strtol(x, NULL, 10);
-                        free(x);
-                        count++;
-
-                        /* Skip over the semicolon if it's there. */
-                        if ((j < input_len) && (input[j] == ';')) {
-                            i = j + 1;
-                        } else {
-                            i = j;
-                        }
-                        continue;
-                    } else {
-                        goto HTML_ENT_OUT;
-                    }
+                k = j;
+                while ((j < input_len) && (base == 16 ? isxdigit(input[j])
+                    : isdigit(input[j]))) {
+                    j++;
+                }
+                if (j == k) { /* Do we have at least one digit? */
+                    goto HTML_ENT_OUT;
                 }
+                *d++ = numericEntity(input, k, j, base);
             } else {
                 /* Text entity. */
                 k = j;
                 while ((j < input_len) && (isalnum(input[j]))) {
                     j++;
                 }
-                if (j > k) { /* Do we have at least one digit? */
-                    char *x;
-                    x = reinterpret_cast<char *>(calloc(sizeof(char),
-                        ((j - k) + 1)));
-                    memcpy(x, (const char *)&input[k], j - k);
-
-                    /* Decode the entity. */
-                    /* ENH What about others? */
-                    if (strcasecmp(x, "quot") == 0) {
-                        *d++ = '"';
-                    } else if (strcasecmp(x, "amp") == 0) {
-                        *d++ = '&';
-                    } else if (strcasecmp(x, "lt") == 0) {
-                        *d++ = '<';
-                    } else if (strcasecmp(x, "gt") == 0) {
-                        *d++ = '>';
-                    } else if (strcasecmp(x, "nbsp") == 0) {
-                        *d++ = NBSP;
-                    } else {
-                        /* We do no want to convert this entity,
-                         * copy the raw data over. */
-                        copy = j - k + 1;
-                        free(x);
-                        goto HTML_ENT_OUT;
-                    }
-                    free(x);
-
-                    count++;
-
-                    /* Skip over the semicolon if it's there. */
-                    if ((j < input_len) && (input[j] == ';')) {
-                        i = j + 1;
-                    } else {
-                        i = j;
-                    }
+                if (j == k) {
+                    goto HTML_ENT_OUT;
+                }
 
-                    continue;
+                /* ENH What about others? */
+                int c = namedEntity(input, k, j);
+                if (c == -1) {
+                    /* We do no want to convert this entity,
+                     * copy the raw data over. */
+                    copy = j - k + 1;
+                    goto HTML_ENT_OUT;
                 }
+                *d++ = c;
             }
+            count++;
+
+            /* Skip over the semicolon if it's there. */
+            if ((j < input_len) && (input[j] == ';')) {
+                i = j + 1;
+            } else {
+                i = j;
+            }
+            continue;
         }
 
 HTML_ENT_OUT:
 
-        for (z = 0; ((z < copy) && (count < input_len)); z++) {
-            *d++ = input[i++];
-            count++;
-        }
+        memmove(d, input + i, copy);
+        d += copy;
+        i += copy;
+        count += copy;
     }
 
     *d = '\0';
@@ -203,6 +228,7 @@ HTML_ENT_OUT:
     return count;
 }
 
+
 }  // namespace transformations
 }  // namespace actions
 }  // namespace modsecurity
@@ -38,6 +38,8 @@ class HtmlEntityDecode : public Transformation {
 
     std::string evaluate(const std::string &exp,
         Transaction *transaction) override;
+    bool transform(std::string &value,
+        Transaction *transaction) override;
 
     static int inplace(unsigned char *input, uint64_t input_len);
 };
@@ -36,24 +36,28 @@ namespace transformations {
 
 std::string JsDecode::evaluate(const std::string &value,
     Transaction *transaction) {
-    std::string ret;
-    unsigned char *input;
+    std::string ret(value);
+    transform(ret, transaction);
+    return ret;
+}
 
-    input = reinterpret_cast<unsigned char *>
-        (malloc(sizeof(char) * value.length()+1));
 
-    if (input == NULL) {
-        return "";
+bool JsDecode::transform(std::string &value,
+    Transaction *transaction) {
+    if (value.find('\\') == std::string::npos) {
+        return false;
     }
 
-    memcpy(input, value.c_str(), value.length()+1);
+    /*
+     * Every decoded escape takes at least two bytes and leaves one, so the
+     * value was changed if and only if it shrunk.
+     */
+    size_t size = value.length();
+    size_t i = inplace(reinterpret_cast<unsigned char *>(&value[0]),
+        value.length());
+    value.resize(i);
 
-    size_t i = inplace(input, value.length());
-
-    ret.assign(reinterpret_cast<char *>(input), i);
-    free(input);
-
-    return ret;
+    return i != size;
 }
 
 
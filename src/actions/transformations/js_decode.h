@@ -35,6 +35,8 @@ class JsDecode : public Transformation {
 
     std::string evaluate(const std::string &exp,
         Transaction *transaction) override;
+    bool transform(std::string &value,
+        Transaction *transaction) override;
     static int inplace(unsigned char *input, uint64_t input_len);
 };
 
@@ -21,6 +21,7 @@
 #include "modsecurity/transaction.h"
 #include "src/actions/transformations/transformation.h"
 #include "modsecurity/actions/action.h"
+#include "src/utils/byte_scan.h"
 
 namespace modsecurity {
 namespace actions {
@@ -33,14 +34,30 @@ LowerCase::LowerCase(const std::string &a)
 
 std::string LowerCase::evaluate(const std::string &val,
     Transaction *transaction) {
-    std::locale loc;
     std::string value(val);
+    transform(value, transaction);
+    return value;
+}
+
+
+bool LowerCase::transform(std::string &value,
+    Transaction *transaction) {
+    std::locale loc;
+    bool changed = false;
+
+    if (loc == std::locale::classic()) {
+        return utils::scan::asciiToLower(&value[0], value.length());
+    }
 
     for (std::string::size_type i=0; i < value.length(); ++i) {
-        value[i] = std::tolower(value[i], loc);
+        char c = std::tolower(value[i], loc);
+        if (c != value[i]) {
+            value[i] = c;
+            changed = true;
+        }
     }
 
-    return value;
+    return changed;
 }
 
 }  // namespace transformations
@@ -37,6 +37,12 @@ std::string None::evaluate(const std::string &value,
 }
 
 
+bool None::transform(std::string &value,
+    Transaction *transaction) {
+    return false;
+}
+
+
 }  // namespace transformations
 }  // namespace actions
 }  // namespace modsecurity
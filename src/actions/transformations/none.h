@@ -36,6 +36,8 @@ class None : public Transformation {
 
     std::string evaluate(const std::string &exp,
         Transaction *transaction) override;
+    bool transform(std::string &value,
+        Transaction *transaction) override;
 };
 
 }  // namespace transformations
@@ -26,6 +26,7 @@
 
 #include "modsecurity/transaction.h"
 #include "src/actions/transformations/transformation.h"
+#include "src/utils/byte_scan.h"
 
 
 namespace modsecurity {
@@ -39,28 +40,73 @@ NormalisePath::NormalisePath(const std::string &action)
 
 std::string NormalisePath::evaluate(const std::string &value,
     Transaction *transaction) {
-    int changed = 0;
+    std::string ret(value);
+    normalise(&ret, false);
+    return ret;
+}
 
-    char *tmp = reinterpret_cast<char *>(
-        malloc(sizeof(char) * value.size() + 1));
-    memcpy(tmp, value.c_str(), value.size() + 1);
-    tmp[value.size()] = '\0';
 
-    int i = normalize_path_inplace((unsigned char *)tmp,
-        value.size(), 0, &changed);
+bool NormalisePath::transform(std::string &value,
+    Transaction *transaction) {
+    return normalise(&value, false);
+}
 
-    std::string ret("");
-    ret.assign(tmp, i);
-    free(tmp);
 
-    return ret;
+/*
+ * A dot matters only when it ends a segment that is nothing but dots
+ * (normalize_path_inplace() takes "x/.../y" as a back-reference too);
+ * dots and slashes are rare enough in REQUEST_FILENAME for the scans,
+ * block by block, to go over most of it at once.
+ */
+bool NormalisePath::isNormalised(const std::string &value, bool win) {
+    const char *p = value.data();
+    size_t len = value.size();
+    size_t i = 0;
+
+    if (utils::scan::findString(p, len, "//", 2) != len) {
+        return false;
+    }
+
+    while ((i += utils::scan::findEither(p + i, len - i, '.',
+        win ? '\\' : '.')) < len) {
+        if (p[i] == '\\') {
+            return false;
+        }
+        if ((i + 1 == len || p[i + 1] == '/')
+            && (i == 0 || p[i - 1] == '/' || p[i - 1] == '.')) {
+            return false;
+        }
+        i++;
+    }
+
+    return true;
 }
 
 
-/**
- *
- * IMP1 Assumes NUL-terminated
+/*
+ * Straight over the buffer of value, a single pass, instead of over a
+ * copy of it; the NUL normalize_path_inplace() ends with goes at most
+ * where the one of value already is.
  */
+bool NormalisePath::normalise(std::string *value, bool win) {
+    int changed = 0;
+
+    if (isNormalised(*value, win)) {
+        return false;
+    }
+
+    int len = normalize_path_inplace(
+        reinterpret_cast<unsigned char *>(&(*value)[0]), value->size(),
+        win, &changed);
+    if (static_cast<size_t>(len) == value->size() && changed == 0) {
+        return false;
+    }
+    value->resize(len);
+
+    return true;
+}
+
+
 int NormalisePath::normalize_path_inplace(unsigned char *input, int input_len,
     int win, int *changed) {
     unsigned char *src;
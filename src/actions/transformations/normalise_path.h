@@ -35,6 +35,17 @@ class NormalisePath : public Transformation {
 
     std::string evaluate(const std::string &exp,
         Transaction *transaction) override;
+    bool transform(std::string &value,
+        Transaction *transaction) override;
+
+    /**
+     * Whether normalize_path_inplace() would leave value as it is, as it
+     * does for most file names: no empty segment, no "." or ".."
+     * segment and, with win, no backslash.
+     */
+    static bool isNormalised(const std::string &value, bool win);
+    /* The in place normalization of value, true if it changed. */
+    static bool normalise(std::string *value, bool win);
 
     static int normalize_path_inplace(unsigned char *input, int input_len,
         int win, int *changed);
@@ -36,22 +36,15 @@ namespace transformations {
 
 std::string NormalisePathWin::evaluate(const std::string &value,
     Transaction *transaction) {
-    int changed;
-
-    char *tmp = reinterpret_cast<char *>(
-        malloc(sizeof(char) * value.size() + 1));
-    memcpy(tmp, value.c_str(), value.size() + 1);
-    tmp[value.size()] = '\0';
-
-    int i = NormalisePath::normalize_path_inplace(
-        reinterpret_cast<unsigned char *>(tmp),
-        value.size(), 1, &changed);
+    std::string ret(value);
+    NormalisePath::normalise(&ret, true);
+    return ret;
+}
 
-    std::string ret("");
-    ret.assign(tmp, i);
-    free(tmp);
 
-    return ret;
+bool NormalisePathWin::transform(std::string &value,
+    Transaction *transaction) {
+    return NormalisePath::normalise(&value, true);
 }
 
 
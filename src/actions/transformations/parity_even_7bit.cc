@@ -25,6 +25,7 @@
 
 #include "modsecurity/transaction.h"
 #include "src/actions/transformations/transformation.h"
+#include "src/utils/allocator.h"
 
 
 namespace modsecurity {
@@ -38,7 +39,7 @@ std::string ParityEven7bit::evaluate(const std::string &value,
     unsigned char *input;
 
     input = reinterpret_cast<unsigned char *>
-        (malloc(sizeof(char) * value.length()+1));
+        (Utils::Allocator::malloc(sizeof(char) * value.length()+1));
 
     if (input == NULL) {
         return "";
@@ -49,13 +50,25 @@ std::string ParityEven7bit::evaluate(const std::string &value,
     inplace(input, value.length());
 
     ret.assign(reinterpret_cast<char *>(input), value.length());
-    free(input);
+    Utils::Allocator::free(input);
 
     return ret;
 }
 
+
+bool ParityEven7bit::transform(std::string &value,
+    Transaction *transaction) {
+    if (value.empty()) {
+        return false;
+    }
+    return inplace(reinterpret_cast<unsigned char *>(&value[0]),
+        value.length());
+}
+
+
 bool ParityEven7bit::inplace(unsigned char *input, uint64_t input_len) {
     uint64_t i;
+    bool changed = false;
 
     i = 0;
     while (i < input_len) {
@@ -69,10 +82,13 @@ bool ParityEven7bit::inplace(unsigned char *input, uint64_t input_len) {
         } else {
             input[i] = x & 0x7f;
         }
+        if (input[i] != x) {
+            changed = true;
+        }
         i++;
     }
 
-    return true;
+    return changed;
 }
 
 
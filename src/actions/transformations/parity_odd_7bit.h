@@ -33,6 +33,7 @@ class ParityOdd7bit : public Transformation {
     explicit ParityOdd7bit(const std::string &action)  : Transformation(action) { }
 
     std::string evaluate(const std::string &exp, Transaction *transaction) override;
+    bool transform(std::string &value, Transaction *transaction) override;
     static bool inplace(unsigned char *input, uint64_t input_len);
 };
 
@@ -25,6 +25,7 @@
 
 #include "modsecurity/transaction.h"
 #include "src/actions/transformations/transformation.h"
+#include "src/utils/allocator.h"
 
 
 namespace modsecurity {
@@ -38,7 +39,7 @@ std::string ParityZero7bit::evaluate(const std::string &value,
     unsigned char *input;
 
     input = reinterpret_cast<unsigned char *>
-        (malloc(sizeof(char) * value.length()+1));
+        (Utils::Allocator::malloc(sizeof(char) * value.length()+1));
 
     if (input == NULL) {
         return "";
@@ -49,22 +50,36 @@ std::string ParityZero7bit::evaluate(const std::string &value,
     inplace(input, value.length());
 
     ret.assign(reinterpret_cast<char *>(input), value.length());
-    free(input);
+    Utils::Allocator::free(input);
 
     return ret;
 }
 
 
+bool ParityZero7bit::transform(std::string &value,
+    Transaction *transaction) {
+    if (value.empty()) {
+        return false;
+    }
+    return inplace(reinterpret_cast<unsigned char *>(&value[0]),
+        value.length());
+}
+
+
 bool ParityZero7bit::inplace(unsigned char *input, uint64_t input_len) {
     uint64_t i;
+    bool changed = false;
 
     i = 0;
     while (i < input_len) {
-        input[i] &= 0x7f;
+        if (input[i] & 0x80) {
+            input[i] &= 0x7f;
+            changed = true;
+        }
         i++;
     }
 
-    return true;
+    return changed;
 }
 
 
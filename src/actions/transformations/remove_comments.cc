@@ -25,6 +25,7 @@
 
 #include "modsecurity/transaction.h"
 #include "src/actions/transformations/transformation.h"
+#include "src/utils/allocator.h"
 
 
 namespace modsecurity {
@@ -38,7 +39,7 @@ std::string RemoveComments::evaluate(const std::string &value,
     unsigned char *input;
 
     input = reinterpret_cast<unsigned char *>
-        (malloc(sizeof(char) * value.length()+1));
+        (Utils::Allocator::malloc(sizeof(char) * value.length()+1));
 
     if (input == NULL) {
         return "";
@@ -101,7 +102,7 @@ std::string RemoveComments::evaluate(const std::string &value,
     }
 
     ret.assign(reinterpret_cast<char *>(input), j);
-    free(input);
+    Utils::Allocator::free(input);
 
     return ret;
 }
@@ -30,20 +30,36 @@ namespace transformations {
 
 std::string RemoveNulls::evaluate(const std::string &val,
     Transaction *transaction) {
-    size_t i = 0;
-    std::string transformed_value;
-    transformed_value.reserve(val.size());
-
-    while (i < val.size()) {
-        if (val.at(i) == '\0') {
-            // do nothing; continue on to next char in original val
-        } else {
-            transformed_value += val.at(i);
+    std::string transformed_value(val);
+    transform(transformed_value, transaction);
+    return transformed_value;
+}
+
+
+bool RemoveNulls::transform(std::string &value,
+    Transaction *transaction) {
+    const char *nul = static_cast<const char *>(
+        memchr(value.data(), '\0', value.size()));
+    if (nul == NULL) {
+        return false;
+    }
+
+    /* memchr finds the NULs, the runs in between are moved as a whole */
+    size_t j = nul - value.data();
+    size_t i = j + 1;
+    while (i < value.size()) {
+        nul = static_cast<const char *>(
+            memchr(value.data() + i, '\0', value.size() - i));
+        size_t end = nul ? nul - value.data() : value.size();
+        if (end > i) {
+            memmove(&value[j], &value[i], end - i);
+            j = j + end - i;
         }
-        i++;
+        i = end + 1;
     }
+    value.resize(j);
 
-    return transformed_value;
+    return true;
 }
 
 
@@ -15,10 +15,12 @@
 
 #include "src/actions/transformations/remove_whitespace.h"
 
+#include <cstring>
 #include <string>
 
 #include "modsecurity/transaction.h"
 #include "src/actions/transformations/transformation.h"
+#include "src/utils/byte_scan.h"
 
 
 namespace modsecurity {
@@ -32,27 +34,35 @@ RemoveWhitespace::RemoveWhitespace(const std::string &action)
 
 std::string RemoveWhitespace::evaluate(const std::string &val,
     Transaction *transaction) {
-    std::string transformed_value;
-    transformed_value.reserve(val.size());
-
-    size_t i = 0;
-    const char nonBreakingSpaces = 0xa0;
-    const char nonBreakingSpaces2 = 0xc2;
-
-    // loop through all the chars
-    while (i < val.size()) {
-        // remove whitespaces and non breaking spaces (NBSP)
-        if (std::isspace(static_cast<unsigned char>(val[i]))
-            || (val[i] == nonBreakingSpaces)
-            || val[i] == nonBreakingSpaces2) {
-            // don't copy; continue on to next char in original val
-        } else {
-            transformed_value += val.at(i);
+    std::string transformed_value(val);
+    transform(transformed_value, transaction);
+    return transformed_value;
+}
+
+
+bool RemoveWhitespace::transform(std::string &value,
+    Transaction *transaction) {
+    size_t j = utils::scan::findSpaceOrNbsp(value.data(), value.size());
+
+    if (j == value.size()) {
+        return false;
+    }
+
+    // remove whitespaces and non breaking spaces (NBSP), moving the runs
+    // in between as a whole
+    size_t i = j + 1;
+    while (i < value.size()) {
+        size_t n = utils::scan::findSpaceOrNbsp(value.data() + i,
+            value.size() - i);
+        if (n > 0) {
+            memmove(&value[j], &value[i], n);
+            j = j + n;
         }
-        i++;
+        i = i + n + 1;
     }
+    value.resize(j);
 
-    return transformed_value;
+    return true;
 }
 
 }  // namespace transformations
@@ -25,6 +25,7 @@
 
 #include "modsecurity/transaction.h"
 #include "src/actions/transformations/transformation.h"
+#include "src/utils/allocator.h"
 
 
 namespace modsecurity {
@@ -41,7 +42,7 @@ std::string ReplaceComments::evaluate(const std::string &value,
     uint64_t i, j, incomment;
 
     char *input = reinterpret_cast<char *>(
-        malloc(sizeof(char) * value.size() + 1));
+        Utils::Allocator::malloc(sizeof(char) * value.size() + 1));
     memcpy(input, value.c_str(), value.size() + 1);
     input[value.size()] = '\0';
 
@@ -78,7 +79,7 @@ std::string ReplaceComments::evaluate(const std::string &value,
     std::string resp;
     resp.append(reinterpret_cast<char *>(input), j);
 
-    free(input);
+    Utils::Allocator::free(input);
 
     return resp;
 }
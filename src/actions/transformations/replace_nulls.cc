@@ -32,19 +32,24 @@ ReplaceNulls::ReplaceNulls(const std::string &action)
 
 std::string ReplaceNulls::evaluate(const std::string &val,
     Transaction *transaction) {
-    int64_t i;
     std::string value(val);
+    transform(value, transaction);
+    return value;
+}
+
 
-    i = 0;
-    while (i < value.size()) {
-        if (value.at(i) == '\0') {
+bool ReplaceNulls::transform(std::string &value,
+    Transaction *transaction) {
+    bool changed = false;
+
+    for (size_t i = 0; i < value.size(); i++) {
+        if (value[i] == '\0') {
             value[i] = ' ';
-        } else {
-            i++;
+            changed = true;
         }
     }
 
-    return value;
+    return changed;
 }
 
 }  // namespace transformations
@@ -25,6 +25,7 @@
 
 #include "modsecurity/transaction.h"
 #include "src/actions/transformations/transformation.h"
+#include "src/utils/allocator.h"
 #include "src/utils/string.h"
 
 
@@ -48,7 +49,7 @@ std::string SqlHexDecode::evaluate(const std::string &value,
     int size = 0;
 
     input = reinterpret_cast<unsigned char *>
-        (malloc(sizeof(char) * value.length()+1));
+        (Utils::Allocator::malloc(sizeof(char) * value.length()+1));
 
     if (input == NULL) {
         return "";
@@ -59,7 +60,7 @@ std::string SqlHexDecode::evaluate(const std::string &value,
     size = inplace(input, value.length());
 
     ret.assign(reinterpret_cast<char *>(input), size);
-    free(input);
+    Utils::Allocator::free(input);
 
     return ret;
 }
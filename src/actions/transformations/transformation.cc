@@ -74,6 +74,19 @@ std::string Transformation::evaluate(const std::string &value,
     return value;
 }
 
+bool Transformation::transform(std::string &value,
+    Transaction *transaction) {
+    std::string ret = evaluate(value, transaction);
+
+    if (ret == value) {
+        return false;
+    }
+
+    value.swap(ret);
+    return true;
+}
+
+
 Transformation* Transformation::instantiate(std::string a) {
     IF_MATCH(base64DecodeExt) { return new Base64DecodeExt(a); }
     IF_MATCH(base64Decode) { return new Base64Decode(a); }
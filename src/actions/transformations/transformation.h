@@ -38,6 +38,16 @@ class Transformation : public Action {
     std::string evaluate(const std::string &exp,
         Transaction *transaction) override;
 
+    /**
+     * Applies the transformation over value, in place, returning true if
+     * and only if the content was changed; multiMatch relies on it to
+     * collect the values. Transformations that are able to work on the
+     * caller buffer should override it and tell the change from what they
+     * did rather than by comparing with a copy of the input. The default
+     * implementation relies on evaluate() and a comparison.
+     */
+    virtual bool transform(std::string &value, Transaction *transaction);
+
     static Transformation* instantiate(std::string a);
 };
 
@@ -0,0 +1,99 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/actions/transformations/transformation_cache.h"
+
+#include <string>
+#include <unordered_map>
+
+#include "modsecurity/rules_set_properties.h"
+
+
+namespace modsecurity {
+namespace actions {
+namespace transformations {
+
+
+TransformationCache::TransformationCache(
+    const ConfigTransformationsCache &config)
+    : m_hits(0),
+    m_misses(0),
+    m_size(0),
+    m_minLength(config.m_minLength),
+    m_maxLength(config.m_maxLength),
+    m_maxSize(config.m_maxSize) { }
+
+
+bool TransformationCache::find(const std::string &chain,
+    const std::string &value, TransformationResults *ret) {
+    if (value.size() < m_minLength || value.size() > m_maxLength) {
+        return false;
+    }
+
+    auto c = m_entries.find(chain);
+    if (c != m_entries.end()) {
+        auto v = c->second.find(value);
+        if (v != c->second.end()) {
+            ret->insert(ret->end(), v->second.begin(), v->second.end());
+            m_hits++;
+            return true;
+        }
+    }
+
+    m_misses++;
+    return false;
+}
+
+
+void TransformationCache::insert(const std::string &chain,
+    const std::string &value, const TransformationResults &results) {
+    if (value.size() < m_minLength || value.size() > m_maxLength) {
+        return;
+    }
+
+    /*
+     * Rough accounting of what the entry holds; the fixed part stands for
+     * the map nodes and the string headers.
+     */
+    size_t size = value.size() + 64;
+    for (const auto &r : results) {
+        size = size + r.first->size() + 32;
+    }
+    if (m_entries.find(chain) == m_entries.end()) {
+        size = size + chain.size() + 64;
+    }
+
+    if (m_size + size > m_maxSize) {
+        return;
+    }
+
+    auto &entries = m_entries[chain];
+    if (entries.emplace(value, results).second) {
+        m_size = m_size + size;
+    }
+}
+
+
+void TransformationCache::clear() {
+    m_entries.clear();
+    m_hits = 0;
+    m_misses = 0;
+    m_size = 0;
+}
+
+
+}  // namespace transformations
+}  // namespace actions
+}  // namespace modsecurity
@@ -0,0 +1,74 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+#include "modsecurity/rule.h"
+
+#ifndef SRC_ACTIONS_TRANSFORMATIONS_TRANSFORMATION_CACHE_H_
+#define SRC_ACTIONS_TRANSFORMATIONS_TRANSFORMATION_CACHE_H_
+
+#ifdef __cplusplus
+namespace modsecurity {
+class ConfigTransformationsCache;
+
+namespace actions {
+namespace transformations {
+
+
+/**
+ * Transaction scoped memoization of transformation results.
+ *
+ * Entries are keyed by the canonical representation of a transformation
+ * chain (see RuleWithActions::executeTransformations) and by the value
+ * that was fed into it. Several rules applying the same chain to the same
+ * variable, as CRS does all over, only pay for the transformations once.
+ *
+ * The results are shared with the callers, which must not modify them.
+ *
+ */
+class TransformationCache {
+ public:
+    explicit TransformationCache(const ConfigTransformationsCache &config);
+
+    bool find(const std::string &chain, const std::string &value,
+        TransformationResults *ret);
+    void insert(const std::string &chain, const std::string &value,
+        const TransformationResults &results);
+    void clear();
+
+    size_t m_hits;
+    size_t m_misses;
+    size_t m_size;
+
+ private:
+    size_t m_minLength;
+    size_t m_maxLength;
+    size_t m_maxSize;
+
+    std::unordered_map<std::string,
+        std::unordered_map<std::string, TransformationResults>> m_entries;
+};
+
+
+}  // namespace transformations
+}  // namespace actions
+}  // namespace modsecurity
+
+#endif
+
+#endif  // SRC_ACTIONS_TRANSFORMATIONS_TRANSFORMATION_CACHE_H_
@@ -74,6 +74,14 @@ Trim::evaluate(const std::string &val,
 }
 
 
+bool Trim::transform(std::string &value,
+    Transaction *transaction) {
+    size_t size = value.size();
+    trim(&value);
+    return value.size() != size;
+}
+
+
 }  // namespace transformations
 }  // namespace actions
 }  // namespace modsecurity
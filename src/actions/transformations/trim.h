@@ -35,6 +35,8 @@ class Trim : public Transformation {
 
     std::string evaluate(const std::string &exp,
         Transaction *transaction) override;
+    bool transform(std::string &value,
+        Transaction *transaction) override;
 
     std::string *ltrim(std::string *s);
     std::string *rtrim(std::string *s);
@@ -44,6 +44,14 @@ std::string TrimLeft::evaluate(const std::string &val,
     return *ltrim(&value);
 }
 
+
+bool TrimLeft::transform(std::string &value,
+    Transaction *transaction) {
+    size_t size = value.size();
+    ltrim(&value);
+    return value.size() != size;
+}
+
 }  // namespace transformations
 }  // namespace actions
 }  // namespace modsecurity
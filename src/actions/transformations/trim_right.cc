@@ -42,6 +42,14 @@ std::string TrimRight::evaluate(const std::string &val,
     return *this->rtrim(&value);
 }
 
+
+bool TrimRight::transform(std::string &value,
+    Transaction *transaction) {
+    size_t size = value.size();
+    rtrim(&value);
+    return value.size() != size;
+}
+
 }  // namespace transformations
 }  // namespace actions
 }  // namespace modsecurity
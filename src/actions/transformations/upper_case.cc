@@ -34,13 +34,25 @@ UpperCase::UpperCase(const std::string &a)
 std::string UpperCase::evaluate(const std::string &val,
     Transaction *transaction) {
     std::string value(val);
+    transform(value, transaction);
+    return value;
+}
+
+
+bool UpperCase::transform(std::string &value,
+    Transaction *transaction) {
     std::locale loc;
+    bool changed = false;
 
     for (std::string::size_type i=0; i < value.length(); ++i) {
-        value[i] = std::toupper(value[i], loc);
+        char c = std::toupper(value[i], loc);
+        if (c != value[i]) {
+            value[i] = c;
+            changed = true;
+        }
     }
 
-    return value;
+    return changed;
 }
 
 }  // namespace transformations
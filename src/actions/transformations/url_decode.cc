@@ -39,23 +39,27 @@ UrlDecode::UrlDecode(const std::string &action)
 
 std::string UrlDecode::evaluate(const std::string &value,
     Transaction *transaction) {
-    unsigned char *val(NULL);
-    int invalid_count = 0;
-    int changed;
+    std::string ret(value);
+    transform(ret, transaction);
+    return ret;
+}
 
-    val = (unsigned char *) malloc(sizeof(char) * value.size() + 1);
-    memcpy(val, value.c_str(), value.size() + 1);
-    val[value.size()] = '\0';
 
-    int size = utils::urldecode_nonstrict_inplace(val, value.size(),
-        &invalid_count, &changed);
-    std::string out;
+bool UrlDecode::transform(std::string &value,
+    Transaction *transaction) {
+    int invalid_count = 0;
+    int changed = 0;
 
-    out.append((const char *)val, size);
+    if (value.empty()) {
+        return false;
+    }
 
-    free(val);
+    int size = utils::urldecode_nonstrict_inplace(
+        reinterpret_cast<unsigned char *>(&value[0]), value.size(),
+        &invalid_count, &changed);
+    value.resize(size);
 
-    return out;
+    return changed != 0;
 }
 
 
@@ -29,6 +29,7 @@
 #include "modsecurity/rules_set.h"
 #include "modsecurity/transaction.h"
 #include "src/actions/transformations/transformation.h"
+#include "src/utils/byte_scan.h"
 #include "src/utils/string.h"
 #include "src/utils/system.h"
 
@@ -40,38 +41,48 @@ namespace transformations {
 
 std::string UrlDecodeUni::evaluate(const std::string &value,
     Transaction *t) {
-    std::string ret;
-    unsigned char *input;
+    std::string ret(value);
+    transform(ret, t);
+    return ret;
+}
 
-    input = reinterpret_cast<unsigned char *>
-        (malloc(sizeof(char) * value.length()+1));
 
-    if (input == NULL) {
-        return "";
+bool UrlDecodeUni::transform(std::string &value,
+    Transaction *t) {
+    if (utils::scan::findEither(value.data(), value.size(), '%', '+')
+        == value.size()) {
+        return false;
     }
 
-    memcpy(input, value.c_str(), value.length()+1);
-
-    size_t i = inplace(input, value.length(), t);
+    /*
+     * A decoded sequence always shrinks the value; '+' is the only change
+     * that keeps the length.
+     */
+    size_t size = value.length();
+    bool plus = memchr(value.data(), '+', size) != NULL;
+    size_t i = inplace(reinterpret_cast<unsigned char *>(&value[0]),
+        value.length(), t);
+    value.resize(i);
+
+    return plus || i != size;
+}
 
-    ret.assign(reinterpret_cast<char *>(input), i);
-    free(input);
 
-    return ret;
-}
+namespace {
 
 
-/**
+/*
+ * Mapped is a template argument so that the loop of the rule sets without
+ * SecUnicodeMapFile, the usual case, does not test for the map at every
+ * %uXXXX.
  *
  * IMP1 Assumes NUL-terminated
  */
-int UrlDecodeUni::inplace(unsigned char *input, uint64_t input_len,
-    Transaction *t) {
+template <bool Mapped>
+int decode(unsigned char *input, uint64_t input_len,
+    const UnicodeMapHolder *map) {
     unsigned char *d = input;
-    int64_t i, count, fact, j, xv;
-    int Code, hmap = -1;
-
-    if (input == NULL) return -1;
+    int64_t i, count;
 
     i = count = 0;
     while (i < input_len) {
@@ -86,31 +97,12 @@ int UrlDecodeUni::inplace(unsigned char *input, uint64_t input_len,
                         (VALID_HEX(input[i + 3])) &&
                         (VALID_HEX(input[i + 4])) &&
                         (VALID_HEX(input[i + 5]))) {
-                        Code = 0;
-                        fact = 1;
-
-                        if (t
-                            && t->m_rules->m_unicodeMapTable.m_set == true
-                            && t->m_rules->m_unicodeMapTable.m_unicodeMapTable != NULL
-                            && t->m_rules->m_unicodeMapTable.m_unicodeCodePage > 0)  {
-                            for (j = 5; j >= 2; j--) {
-                                if (isxdigit((input[i+j]))) {
-                                    if (input[i+j] >= 97) {
-                                        xv = (input[i+j] - 97) + 10;
-                                    } else if (input[i+j] >= 65)  {
-                                        xv = (input[i+j] - 65) + 10;
-                                    } else {
-                                        xv = (input[i+j]) - 48;
-                                    }
-                                    Code += (xv * fact);
-                                    fact *= 16;
-                                }
-                            }
+                        int hmap = -1;
 
-                            if (Code >= 0 && Code <= 65535)  {
-                                RulesSet *r = t->m_rules;
-                                hmap = r->m_unicodeMapTable.m_unicodeMapTable->at(Code);
-                            }
+                        if (Mapped) {
+                            hmap = map->at(
+                                (utils::string::x2c(&input[i + 2]) << 8)
+                                | utils::string::x2c(&input[i + 4]));
                         }
 
                         if (hmap != -1)  {
@@ -190,6 +182,24 @@ int UrlDecodeUni::inplace(unsigned char *input, uint64_t input_len,
 }
 
 
+}  // namespace
+
+
+int UrlDecodeUni::inplace(unsigned char *input, uint64_t input_len,
+    Transaction *t) {
+    if (input == NULL) return -1;
+
+    if (t
+        && t->m_rules->m_unicodeMapTable.m_set == true
+        && t->m_rules->m_unicodeMapTable.m_unicodeMapTable != NULL
+        && t->m_rules->m_unicodeMapTable.m_unicodeCodePage > 0) {
+        return decode<true>(input, input_len,
+            t->m_rules->m_unicodeMapTable.m_unicodeMapTable.get());
+    }
+    return decode<false>(input, input_len, nullptr);
+}
+
+
 }  // namespace transformations
 }  // namespace actions
 }  // namespace modsecurity
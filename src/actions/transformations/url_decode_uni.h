@@ -34,6 +34,8 @@ class UrlDecodeUni : public Transformation {
     explicit UrlDecodeUni(const std::string &action)  : Transformation(action) { }
 
     std::string evaluate(const std::string &exp, Transaction *transaction) override;
+    bool transform(std::string &value,
+        Transaction *transaction) override;
     static int inplace(unsigned char *input, uint64_t input_len,
         Transaction *transaction);
 };
@@ -24,6 +24,7 @@
 
 #include "modsecurity/transaction.h"
 #include "src/actions/transformations/transformation.h"
+#include "src/utils/allocator.h"
 #include "src/utils/string.h"
 
 namespace modsecurity {
@@ -46,7 +47,7 @@ std::string UrlEncode::url_enc(const char *input,
     *changed = 0;
 
     len = input_len * 3 + 1;
-    d = rval = reinterpret_cast<char *>(malloc(len));
+    d = rval = reinterpret_cast<char *>(Utils::Allocator::malloc(len));
     if (rval == NULL) {
         return NULL;
     }
@@ -82,7 +83,7 @@ std::string UrlEncode::url_enc(const char *input,
 
     std::string ret("");
     ret.append(rval, count);
-    free(rval);
+    Utils::Allocator::free(rval);
     return ret;
 }
 
@@ -25,6 +25,8 @@
 
 #include "modsecurity/transaction.h"
 #include "src/actions/transformations/transformation.h"
+#include "src/utils/allocator.h"
+#include "src/utils/byte_scan.h"
 #include "src/utils/string.h"
 
 
@@ -41,7 +43,7 @@ std::string Utf8ToUnicode::evaluate(const std::string &value,
     char *out;
 
     input = reinterpret_cast<unsigned char *>
-        (malloc(sizeof(char) * value.length()+1));
+        (Utils::Allocator::malloc(sizeof(char) * value.length()+1));
 
     if (input == NULL) {
         return "";
@@ -50,11 +52,11 @@ std::string Utf8ToUnicode::evaluate(const std::string &value,
     memcpy(input, value.c_str(), value.length()+1);
 
     out = inplace(input, value.size() + 1, &changed);
-    free(input);
+    Utils::Allocator::free(input);
     if (out != NULL) {
         ret.assign(reinterpret_cast<char *>(out),
             strlen(reinterpret_cast<char *>(out)));
-        free(out);
+        Utils::Allocator::free(out);
     }
 
     return ret;
@@ -74,14 +76,15 @@ char *Utf8ToUnicode::inplace(unsigned char *input,
     /* RFC3629 states that UTF-8 are encoded using sequences of 1 to 4 octets. */
     /* Max size per character should fit in 4 bytes */
     len = input_len * 4 + 1;
-    data = reinterpret_cast<char *>(malloc(sizeof(char) * len));
+    data = reinterpret_cast<char *>(
+        Utils::Allocator::malloc(sizeof(char) * len));
     if (data == NULL) {
         return NULL;
     }
     data_orig = data;
 
     if (input == NULL) {
-        free(data);
+        Utils::Allocator::free(data);
         return NULL;
     }
 
@@ -93,6 +96,21 @@ char *Utf8ToUnicode::inplace(unsigned char *input,
 
         c = *utf;
 
+        /* Runs of ASCII other than NUL are copied as they are. */
+        if (c != 0 && (c & 0x80) == 0) {
+            size_t n = utils::scan::findNonAscii(
+                reinterpret_cast<const char *>(utf), bytes_left - i);
+            const void *nul = memchr(utf, 0, n);
+            if (nul != NULL) {
+                n = static_cast<const unsigned char *>(nul) - utf;
+            }
+            memcpy(data, utf, n);
+            data += n;
+            count += n;
+            i += n;
+            continue;
+        }
+
         /* If first byte begins with binary 0 it is single byte encoding */
         if ((c & 0x80) == 0) {
             /* single byte unicode (7 bit ASCII equivilent) has no validation */
@@ -13,13 +13,16 @@
  *
  */
 
+#include <algorithm>
 #include <ctime>
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "modsecurity/anchored_set_variable.h"
+#include "modsecurity/anchored_set_variable_translation_proxy.h"
 #include "modsecurity/modsecurity.h"
 #include "modsecurity/transaction.h"
 #include "src/utils/regex.h"
@@ -29,15 +32,24 @@ namespace modsecurity {
 
 
 AnchoredSetVariable::AnchoredSetVariable(Transaction *t,
-    const std::string &name)
+    const std::string &name, bool borrowable)
     : m_transaction(t),
-    m_name(name) {
+    m_name(name),
+    m_borrowable(borrowable),
+    m_generation(1),
+    m_snapshotGeneration(0),
+    m_namesGeneration(0),
+    m_source(nullptr),
+    m_pending(false) {
         reserve(10);
     }
 
 
 AnchoredSetVariable::~AnchoredSetVariable() {
     unset();
+    for (const VariableValue *v : m_names) {
+        delete v;
+    }
 }
 
 
@@ -47,63 +59,112 @@ void AnchoredSetVariable::unset() {
         delete var;
     }
     clear();
+    m_generation++;
+    m_pending.store(false, std::memory_order_relaxed);
+}
+
+
+/*
+ * Adds what the source has for the set. The rules matched in parallel may
+ * get there together; the one that comes second finds it done.
+ */
+void AnchoredSetVariable::fill() {
+    if (m_pending.load(std::memory_order_acquire) == false) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_fillLock);
+    if (m_pending.load(std::memory_order_relaxed)) {
+        m_source->fill(this);
+        m_pending.store(false, std::memory_order_release);
+    }
 }
 
 
 void AnchoredSetVariable::set(const std::string &key,
     const std::string &value, size_t offset, size_t len) {
-    std::unique_ptr<VariableOrigin> origin(new VariableOrigin());
+    VariableOrigin origin;
     std::string *v = new std::string(value);
     VariableValue *var = new VariableValue(&m_name, &key, v);
     delete v;
 
-    origin->m_offset = offset;
-    origin->m_length = len;
+    origin.m_offset = offset;
+    origin.m_length = len;
 
-    var->addOrigin(std::move(origin));
+    var->addOrigin(origin);
     emplace(key, var);
+    m_generation++;
 }
 
 
 void AnchoredSetVariable::set(const std::string &key,
     const std::string &value, size_t offset) {
-    std::unique_ptr<VariableOrigin> origin(new VariableOrigin());
+    VariableOrigin origin;
     std::string *v = new std::string(value);
     VariableValue *var = new VariableValue(&m_name, &key, v);
     delete v;
 
-    origin->m_offset = offset;
-    origin->m_length = value.size();
+    origin.m_offset = offset;
+    origin.m_length = value.size();
 
-    var->addOrigin(std::move(origin));
+    var->addOrigin(origin);
     emplace(key, var);
+    m_generation++;
+}
+
+
+/* set(), taking the value over rather than copying it. */
+void AnchoredSetVariable::setCopy(std::string key, std::string value,
+    size_t offset) {
+    VariableOrigin origin;
+    std::string empty;
+    VariableValue *var = new VariableValue(&m_name, &key, &empty);
+
+    origin.m_offset = offset;
+    origin.m_length = value.size();
+
+    var->setValue(std::move(value));
+    var->addOrigin(origin);
+    emplace(std::move(key), var);
+    m_generation++;
 }
 
 
 void AnchoredSetVariable::resolve(
     std::vector<const VariableValue *> *l) {
+    fill();
+    size_t first = l->size();
     for (const auto& x : *this) {
-        l->insert(l->begin(), new VariableValue(x.second));
+        l->push_back(new VariableValue(x.second));
     }
+    std::reverse(l->begin() + first, l->end());
 }
 
 
 void AnchoredSetVariable::resolve(
     std::vector<const VariableValue *> *l,
     variables::KeyExclusions &ke) {
+    fill();
+    size_t first = l->size();
     for (const auto& x : *this) {
         if (!ke.toOmit(x.first)) {
-            l->insert(l->begin(), new VariableValue(x.second));
+            l->push_back(new VariableValue(x.second));
         } else {
             ms_dbg_a(m_transaction, 7, "Excluding key: " + x.first
                 + " from target value.");
         }
     }
+    std::reverse(l->begin() + first, l->end());
 }
 
 
 void AnchoredSetVariable::resolve(const std::string &key,
     std::vector<const VariableValue *> *l) {
+    if (m_pending.load(std::memory_order_acquire)) {
+        m_source->find(this, key, l);
+        return;
+    }
+
     auto range = this->equal_range(key);
     for (auto it = range.first; it != range.second; ++it) {
         l->push_back(new VariableValue(it->second));
@@ -113,6 +174,19 @@ void AnchoredSetVariable::resolve(const std::string &key,
 
 std::unique_ptr<std::string> AnchoredSetVariable::resolveFirst(
     const std::string &key) {
+    if (m_pending.load(std::memory_order_acquire)) {
+        std::vector<const VariableValue *> l;
+        std::unique_ptr<std::string> b;
+        m_source->find(this, key, &l);
+        if (l.empty() == false) {
+            b.reset(new std::string(l.front()->getValue()));
+        }
+        for (const VariableValue *v : l) {
+            delete v;
+        }
+        return b;
+    }
+
     auto range = equal_range(key);
     for (auto it = range.first; it != range.second; ++it) {
         std::unique_ptr<std::string> b(new std::string());
@@ -125,31 +199,205 @@ std::unique_ptr<std::string> AnchoredSetVariable::resolveFirst(
 
 void AnchoredSetVariable::resolveRegularExpression(Utils::Regex *r,
     std::vector<const VariableValue *> *l) {
+    fill();
+    size_t first = l->size();
     for (const auto& x : *this) {
         int ret = Utils::regex_search(x.first, *r);
         if (ret <= 0) {
             continue;
         }
-        l->insert(l->begin(), new VariableValue(x.second));
+        l->push_back(new VariableValue(x.second));
     }
+    std::reverse(l->begin() + first, l->end());
 }
 
 
 void AnchoredSetVariable::resolveRegularExpression(Utils::Regex *r,
     std::vector<const VariableValue *> *l,
     variables::KeyExclusions &ke) {
+    fill();
+    size_t first = l->size();
     for (const auto& x : *this) {
         int ret = Utils::regex_search(x.first, *r);
         if (ret <= 0) {
             continue;
         }
         if (!ke.toOmit(x.first)) {
-            l->insert(l->begin(), new VariableValue(x.second));
+            l->push_back(new VariableValue(x.second));
         } else {
             ms_dbg_a(m_transaction, 7, "Excluding key: " + x.first
                 + " from target value.");
         }
     }
+    std::reverse(l->begin() + first, l->end());
+}
+
+
+/*
+ * The owning variants insert at the front of the list, the elements are
+ * appended and the new part reversed instead, giving the same order.
+ */
+bool AnchoredSetVariable::resolveBorrowed(
+    std::vector<const VariableValue *> *l,
+    variables::KeyExclusions &ke) {
+    if (m_borrowable == false) {
+        return false;
+    }
+
+    const std::vector<const VariableValue *> &all = snapshot();
+    if (ke.empty()) {
+        l->insert(l->end(), all.begin(), all.end());
+        return true;
+    }
+    l->reserve(l->size() + all.size());
+    for (const VariableValue *v : all) {
+        if (!ke.toOmit(v->getKey())) {
+            l->push_back(v);
+        } else {
+            ms_dbg_a(m_transaction, 7, "Excluding key: " + v->getKey()
+                + " from target value.");
+        }
+    }
+    return true;
+}
+
+
+bool AnchoredSetVariable::resolveBorrowed(const std::string &key,
+    std::vector<const VariableValue *> *l) {
+    /* not filled: resolve(key) makes copies out of the source */
+    if (m_borrowable == false
+        || m_pending.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    auto range = this->equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        l->push_back(it->second);
+    }
+    return true;
+}
+
+
+bool AnchoredSetVariable::resolveRegularExpressionBorrowed(Utils::Regex *r,
+    std::vector<const VariableValue *> *l,
+    variables::KeyExclusions &ke) {
+    if (m_borrowable == false) {
+        return false;
+    }
+
+    for (const VariableValue *v : snapshot()) {
+        int ret = Utils::regex_search(v->getKey(), *r);
+        if (ret <= 0) {
+            continue;
+        }
+        if (!ke.toOmit(v->getKey())) {
+            l->push_back(v);
+        } else {
+            ms_dbg_a(m_transaction, 7, "Excluding key: " + v->getKey()
+                + " from target value.");
+        }
+    }
+    return true;
+}
+
+
+const std::vector<const VariableValue *> &AnchoredSetVariable::snapshot() {
+    fill();
+    if (m_snapshotGeneration.load(std::memory_order_acquire)
+        == m_generation) {
+        return m_snapshot;
+    }
+
+    std::lock_guard<std::mutex> lock(m_snapshotLock);
+    if (m_snapshotGeneration.load(std::memory_order_relaxed)
+        != m_generation) {
+        m_snapshot.clear();
+        m_snapshot.reserve(size());
+        for (const auto& x : *this) {
+            m_snapshot.push_back(x.second);
+        }
+        std::reverse(m_snapshot.begin(), m_snapshot.end());
+        m_snapshotGeneration.store(m_generation, std::memory_order_release);
+    }
+    return m_snapshot;
+}
+
+
+/*
+ * As AnchoredSetVariableTranslationProxy translates them: the key is the
+ * value as well, and the origin is where the key starts, ahead of the
+ * value and its separator.
+ */
+const std::vector<const VariableValue *> &AnchoredSetVariable::names(
+    const std::string *name) {
+    fill();
+    if (m_namesGeneration.load(std::memory_order_acquire) == m_generation) {
+        return m_names;
+    }
+
+    const std::vector<const VariableValue *> &all = snapshot();
+    std::lock_guard<std::mutex> lock(m_snapshotLock);
+    if (m_namesGeneration.load(std::memory_order_relaxed) != m_generation) {
+        for (const VariableValue *v : m_names) {
+            delete v;
+        }
+        m_names.clear();
+        m_names.reserve(all.size());
+        for (const VariableValue *v : all) {
+            VariableValue *n = new VariableValue(name, &v->getKey(),
+                &v->getKey());
+            for (const VariableOrigin &o : v->getOrigin()) {
+                VariableOrigin origin;
+                origin.m_length = v->getKey().size();
+                origin.m_offset = o.m_offset - v->getKey().size() - 1;
+                n->addOrigin(origin);
+            }
+            m_names.push_back(n);
+        }
+        m_namesGeneration.store(m_generation, std::memory_order_release);
+    }
+    return m_names;
+}
+
+
+bool AnchoredSetVariableTranslationProxy::resolveBorrowed(
+    std::vector<const VariableValue *> *l,
+    variables::KeyExclusions &ke) {
+    if (m_fount->m_borrowable == false) {
+        return false;
+    }
+
+    for (const VariableValue *v : m_fount->names(&m_name)) {
+        if (!ke.toOmit(v->getKey())) {
+            l->push_back(v);
+        } else {
+            ms_dbg_a(m_fount->m_transaction, 7, "Excluding key: "
+                + v->getKey() + " from target value.");
+        }
+    }
+    return true;
+}
+
+
+bool AnchoredSetVariableTranslationProxy::resolveRegularExpressionBorrowed(
+    Utils::Regex *r, std::vector<const VariableValue *> *l,
+    variables::KeyExclusions &ke) {
+    if (m_fount->m_borrowable == false) {
+        return false;
+    }
+
+    for (const VariableValue *v : m_fount->names(&m_name)) {
+        if (Utils::regex_search(v->getKey(), *r) <= 0) {
+            continue;
+        }
+        if (!ke.toOmit(v->getKey())) {
+            l->push_back(v);
+        } else {
+            ms_dbg_a(m_fount->m_transaction, 7, "Excluding key: "
+                + v->getKey() + " from target value.");
+        }
+    }
+    return true;
 }
 
 
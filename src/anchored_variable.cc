@@ -52,33 +52,43 @@ void AnchoredVariable::unset() {
 }
 
 
+/*
+ * Brings the variable back to its just constructed state, origins
+ * included, keeping the storage around to be reused.
+ */
+void AnchoredVariable::reset() {
+    m_value.clear();
+    m_offset = 0;
+    m_var->clearOrigin();
+}
+
+
 void AnchoredVariable::set(const std::string &a, size_t offset,
     size_t offsetLen) {
-    std::unique_ptr<VariableOrigin> origin(new VariableOrigin());
+    VariableOrigin origin;
 
     m_offset = offset;
     m_value.assign(a.c_str(), a.size());
-    origin->m_offset = offset;
-    origin->m_length = offsetLen;
-    m_var->addOrigin(std::move(origin));
+    origin.m_offset = offset;
+    origin.m_length = offsetLen;
+    m_var->addOrigin(origin);
 }
 
 
 void AnchoredVariable::set(const std::string &a, size_t offset) {
-    std::unique_ptr<VariableOrigin> origin(new VariableOrigin());
+    VariableOrigin origin;
 
     m_offset = offset;
     m_value.assign(a.c_str(), a.size());
-    origin->m_offset = offset;
-    origin->m_length = m_value.size();
-    m_var->addOrigin(std::move(origin));
+    origin.m_offset = offset;
+    origin.m_length = m_value.size();
+    m_var->addOrigin(origin);
 }
 
 
 void AnchoredVariable::append(const std::string &a, size_t offset,
     bool spaceSeparator) {
-    std::unique_ptr<VariableOrigin> origin(
-        new VariableOrigin());
+    VariableOrigin origin;
 
     if (spaceSeparator && !m_value.empty()) {
         m_value.append(" " + a);
@@ -86,16 +96,15 @@ void AnchoredVariable::append(const std::string &a, size_t offset,
         m_value.append(a);
     }
     m_offset = offset;
-    origin->m_offset = offset;
-    origin->m_length = a.size();
-    m_var->addOrigin(std::move(origin));
+    origin.m_offset = offset;
+    origin.m_length = a.size();
+    m_var->addOrigin(origin);
 }
 
 
 void AnchoredVariable::append(const std::string &a, size_t offset,
     bool spaceSeparator, int size) {
-    std::unique_ptr<VariableOrigin> origin(
-        new VariableOrigin());
+    VariableOrigin origin;
 
     if (spaceSeparator && !m_value.empty()) {
         m_value.append(" " + a);
@@ -103,9 +112,9 @@ void AnchoredVariable::append(const std::string &a, size_t offset,
         m_value.append(a);
     }
     m_offset = offset;
-    origin->m_offset = offset;
-    origin->m_length = size;
-    m_var->addOrigin(std::move(origin));
+    origin.m_offset = offset;
+    origin.m_length = size;
+    m_var->addOrigin(origin);
 }
 
 
@@ -20,13 +20,18 @@
 #include <ctype.h>
 
 #include <fstream>
+#include <vector>
 
 #include "modsecurity/transaction.h"
 #include "modsecurity/rule_message.h"
+#include "src/audit_log/sampler.h"
 #include "src/audit_log/writer/https.h"
+#include "src/audit_log/writer/ring.h"
+#include "src/audit_log/writer/stream.h"
 #include "src/audit_log/writer/parallel.h"
 #include "src/audit_log/writer/serial.h"
 #include "src/audit_log/writer/writer.h"
+#include "src/utils/metrics.h"
 #include "src/utils/regex.h"
 
 #define PARTS_CONSTAINS(a, c) \
@@ -51,6 +56,24 @@ namespace modsecurity {
 namespace audit_log {
 
 
+namespace {
+
+void writeDigests(Transaction *transaction, writer::Writer *writer,
+    const std::vector<Sampler::Digest> &digests) {
+    for (const Sampler::Digest &d : digests) {
+        std::string error;
+        if (writer == NULL || writer->writeDigest(d, &error) == false) {
+            ms_dbg_a(transaction, 1, "Cannot save the audit log digest: "
+                + error);
+            Utils::Metrics::getInstance().increment(
+                Utils::Metrics::AuditLogFailuresCounter);
+        }
+    }
+}
+
+}  // namespace
+
+
 AuditLog::AuditLog()
     : m_path1(""),
     m_path2(""),
@@ -59,14 +82,25 @@ AuditLog::AuditLog()
     m_parts(-1),
     m_filePermission(-1),
     m_directoryPermission(-1),
+    m_compressionLevel(-1),
+    m_rateLimit(-1),
+    m_timings(-1),
     m_status(NotSetLogStatus),
     m_type(NotSetAuditLogType),
     m_relevant(""),
     m_writer(NULL),
+    m_sampler(NULL),
     m_ctlAuditEngineActive(false) { }
 
 
 AuditLog::~AuditLog() {
+    if (m_sampler) {
+        std::vector<Sampler::Digest> digests;
+        m_sampler->flush(&digests);
+        writeDigests(NULL, m_writer, digests);
+        delete m_sampler;
+        m_sampler = NULL;
+    }
     if (m_writer) {
         delete m_writer;
         m_writer = NULL;
@@ -136,6 +170,30 @@ bool AuditLog::setFormat(AuditLogFormat fmt) {
     return true;
 }
 
+
+bool AuditLog::setCompressionLevel(int level) {
+    if (level < 0 || level > 9) {
+        return false;
+    }
+    this->m_compressionLevel = level;
+    return true;
+}
+
+
+bool AuditLog::setRateLimit(int perMinute) {
+    if (perMinute < 0) {
+        return false;
+    }
+    this->m_rateLimit = perMinute;
+    return true;
+}
+
+
+bool AuditLog::setTimings(bool timings) {
+    this->m_timings = timings ? 1 : 0;
+    return true;
+}
+
 int AuditLog::addParts(int parts, const std::string& new_parts) {
     PARTS_CONSTAINS('A', AAuditLogPart)
     PARTS_CONSTAINS('B', BAuditLogPart)
@@ -202,6 +260,29 @@ int AuditLog::getParts() const {
 }
 
 
+int AuditLog::getCompressionLevel() const {
+    if (m_compressionLevel == -1) {
+        return 0;
+    }
+
+    return m_compressionLevel;
+}
+
+
+int AuditLog::getRateLimit() const {
+    if (m_rateLimit == -1) {
+        return 0;
+    }
+
+    return m_rateLimit;
+}
+
+
+bool AuditLog::getTimings() const {
+    return m_timings == 1;
+}
+
+
 bool AuditLog::setType(AuditLogType audit_type) {
     this->m_type = audit_type;
     return true;
@@ -225,6 +306,10 @@ bool AuditLog::init(std::string *error) {
         tmp_writer = new audit_log::writer::Parallel(this);
     } else if (m_type == HttpsAuditLogType) {
         tmp_writer = new audit_log::writer::Https(this);
+    } else if (m_type == RingAuditLogType) {
+        tmp_writer = new audit_log::writer::Ring(this);
+    } else if (m_type == StreamAuditLogType) {
+        tmp_writer = new audit_log::writer::Stream(this);
     } else {
         /*
          * if (m_type == SerialAuditLogType
@@ -250,6 +335,14 @@ bool AuditLog::init(std::string *error) {
 
     m_writer = tmp_writer;
 
+    if (m_sampler && m_sampler->perMinute() != getRateLimit()) {
+        delete m_sampler;
+        m_sampler = NULL;
+    }
+    if (m_sampler == NULL && getRateLimit() > 0) {
+        m_sampler = new Sampler(getRateLimit());
+    }
+
     return true;
 }
 
@@ -307,6 +400,30 @@ bool AuditLog::saveIfRelevant(Transaction *transaction, int parts) {
         return false;
     }
 
+    if (m_sampler) {
+        int64_t ruleId = 0;
+        std::vector<Sampler::Digest> digests;
+        for (RuleMessage &i : transaction->m_rulesMessages) {
+            if (i.m_noAuditLog == false) {
+                ruleId = i.m_ruleId;
+                break;
+            }
+        }
+        bool allowed = m_sampler->allow(ruleId,
+            transaction->m_clientIpAddress ?
+                *transaction->m_clientIpAddress : std::string(),
+            time(NULL), &digests);
+        writeDigests(transaction, m_writer, digests);
+        if (allowed == false) {
+            ms_dbg_a(transaction, 5, "Not saving this request in full, " \
+                "SecAuditLogRateLimit was reached for rule " +
+                std::to_string(ruleId) + ", it goes in a digest instead.");
+            Utils::Metrics::getInstance().increment(
+                Utils::Metrics::AuditLogSuppressedCounter);
+            return false;
+        }
+    }
+
     if (parts == -1) {
         parts = m_parts;
     }
@@ -319,6 +436,8 @@ bool AuditLog::saveIfRelevant(Transaction *transaction, int parts) {
         bool a = m_writer->write(transaction, parts, &error);
         if (a == false) {
             ms_dbg_a(transaction, 1, "Cannot save the audit log: " + error);
+            Utils::Metrics::getInstance().increment(
+                Utils::Metrics::AuditLogFailuresCounter);
             return false;
         }
     }
@@ -362,6 +481,18 @@ bool AuditLog::merge(AuditLog *from, std::string *error) {
         m_format = from->m_format;
     }
 
+    if (from->m_compressionLevel != -1) {
+        m_compressionLevel = from->m_compressionLevel;
+    }
+
+    if (from->m_rateLimit != -1) {
+        m_rateLimit = from->m_rateLimit;
+    }
+
+    if (from->m_timings != -1) {
+        m_timings = from->m_timings;
+    }
+
     if (from->m_ctlAuditEngineActive) {
         m_ctlAuditEngineActive = from->m_ctlAuditEngineActive;
     }
@@ -0,0 +1,137 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/audit_log/sampler.h"
+
+#include <pthread.h>
+#include <time.h>
+
+#include <string>
+#include <vector>
+
+namespace modsecurity {
+namespace audit_log {
+
+
+const size_t Sampler::kMaxKeys;
+const time_t Sampler::kWindow;
+
+
+Sampler::Sampler(int perMinute)
+    : m_perMinute(perMinute),
+    m_lastSweep(0) {
+    pthread_mutex_init(&m_lock, NULL);
+}
+
+
+Sampler::~Sampler() {
+    pthread_mutex_destroy(&m_lock);
+}
+
+
+bool Sampler::allow(int64_t ruleId, const std::string &clientIpAddress,
+    time_t now, std::vector<Digest> *digests) {
+    pthread_mutex_lock(&m_lock);
+    if (now != m_lastSweep) {
+        sweep(now, digests);
+    }
+
+    Key key(ruleId, clientIpAddress);
+    auto it = m_buckets.find(key);
+    if (it == m_buckets.end()) {
+        if (m_buckets.size() >= kMaxKeys) {
+            pthread_mutex_unlock(&m_lock);
+            return true;
+        }
+        Bucket fresh = { static_cast<double>(m_perMinute), now, 0, 0, 0 };
+        it = m_buckets.insert(std::make_pair(key, fresh)).first;
+    }
+
+    Bucket &b = it->second;
+    if (now > b.m_updated) {
+        b.m_tokens += static_cast<double>(now - b.m_updated)
+            * m_perMinute / kWindow;
+        if (b.m_tokens > m_perMinute) {
+            b.m_tokens = m_perMinute;
+        }
+        b.m_updated = now;
+    }
+
+    if (b.m_tokens >= 1) {
+        b.m_tokens -= 1;
+        pthread_mutex_unlock(&m_lock);
+        return true;
+    }
+
+    if (b.m_suppressed == 0) {
+        b.m_firstSeen = now;
+    }
+    b.m_suppressed++;
+    b.m_lastSeen = now;
+    pthread_mutex_unlock(&m_lock);
+
+    return false;
+}
+
+
+void Sampler::flush(std::vector<Digest> *digests) {
+    pthread_mutex_lock(&m_lock);
+    for (auto &i : m_buckets) {
+        if (i.second.m_suppressed > 0) {
+            digest(i.first, &i.second, digests);
+        }
+    }
+    pthread_mutex_unlock(&m_lock);
+}
+
+
+/*
+ * Has to be called with m_lock held. A bucket left alone for a whole
+ * window is full again, the same as a new one, so it is dropped.
+ */
+void Sampler::sweep(time_t now, std::vector<Digest> *digests) {
+    m_lastSweep = now;
+
+    for (auto it = m_buckets.begin(); it != m_buckets.end();) {
+        Bucket &b = it->second;
+        if (b.m_suppressed > 0 && now - b.m_firstSeen >= kWindow) {
+            digest(it->first, &b, digests);
+        }
+        if (b.m_suppressed == 0 && now - b.m_updated >= kWindow) {
+            it = m_buckets.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+
+void Sampler::digest(const Key &key, Bucket *bucket,
+    std::vector<Digest> *digests) {
+    Digest d;
+
+    d.m_ruleId = key.first;
+    d.m_clientIpAddress = key.second;
+    d.m_suppressed = bucket->m_suppressed;
+    d.m_firstSeen = bucket->m_firstSeen;
+    d.m_lastSeen = bucket->m_lastSeen;
+    digests->push_back(std::move(d));
+
+    bucket->m_suppressed = 0;
+}
+
+
+}  // namespace audit_log
+}  // namespace modsecurity
@@ -0,0 +1,107 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#ifdef __cplusplus
+#include <pthread.h>
+#include <stdint.h>
+#include <time.h>
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#endif
+
+#ifndef SRC_AUDIT_LOG_SAMPLER_H_
+#define SRC_AUDIT_LOG_SAMPLER_H_
+
+#ifdef __cplusplus
+
+namespace modsecurity {
+namespace audit_log {
+
+
+/**
+ * Decides which of the relevant transactions get a full audit log record
+ * (SecAuditLogRateLimit), so that a flood of the same attack does not
+ * turn into a flood of identical records.
+ *
+ * There is a token bucket per rule id and client address, holding up to
+ * the configured number of records and refilled at that many records a
+ * minute. What the bucket has no token for is only counted, then told in
+ * a digest once the minute started by the first of them is over: how
+ * many were left out, and when the first and the last of them were seen.
+ *
+ * Buckets are kept per process; the limit applies to each server worker
+ * on its own. Past kMaxKeys buckets, the transactions of new keys are
+ * logged in full rather than have them go unaccounted.
+ *
+ */
+class Sampler {
+ public:
+    static const size_t kMaxKeys = 65536;
+    static const time_t kWindow = 60;
+
+    struct Digest {
+        int64_t m_ruleId;
+        std::string m_clientIpAddress;
+        size_t m_suppressed;
+        time_t m_firstSeen;
+        time_t m_lastSeen;
+    };
+
+    explicit Sampler(int perMinute);
+    ~Sampler();
+
+    int perMinute() const { return m_perMinute; }
+
+    /**
+     * Takes a token from the bucket of ruleId and clientIpAddress; false
+     * when there was none and the record is only to be counted. The
+     * digests that are due by now are added to digests.
+     */
+    bool allow(int64_t ruleId, const std::string &clientIpAddress,
+        time_t now, std::vector<Digest> *digests);
+
+    /* the digests of everything left out so far, due or not */
+    void flush(std::vector<Digest> *digests);
+
+ private:
+    struct Bucket {
+        double m_tokens;
+        time_t m_updated;
+        size_t m_suppressed;
+        time_t m_firstSeen;
+        time_t m_lastSeen;
+    };
+    typedef std::pair<int64_t, std::string> Key;
+
+    void sweep(time_t now, std::vector<Digest> *digests);
+    static void digest(const Key &key, Bucket *bucket,
+        std::vector<Digest> *digests);
+
+    int m_perMinute;
+    time_t m_lastSweep;
+    std::map<Key, Bucket> m_buckets;
+    pthread_mutex_t m_lock;
+};
+
+
+}  // namespace audit_log
+}  // namespace modsecurity
+#endif
+
+#endif  // SRC_AUDIT_LOG_SAMPLER_H_
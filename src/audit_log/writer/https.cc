@@ -21,14 +21,20 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
 
+#include <deque>
 #include <fstream>
 #include <mutex>
+#include <string>
 
 #include "modsecurity/rules_set.h"
 #include "modsecurity/audit_log.h"
 #include "modsecurity/transaction.h"
 #include "src/utils/md5.h"
+#include "src/utils/metrics.h"
 #include "src/utils/https_client.h"
 
 
@@ -38,7 +44,28 @@ namespace audit_log {
 namespace writer {
 
 
+const size_t Https::kQueueLimit;
+const size_t Https::kBatchSize;
+const long Https::kBatchTimeout;
+
+
+Https::Https(audit_log::AuditLog *audit)
+    : audit_log::writer::Writer(audit),
+    m_pid(0),
+    m_running(false),
+    m_stopping(false),
+    m_sent(0),
+    m_dropped(0),
+    m_failed(0) {
+    pthread_mutex_init(&m_lock, NULL);
+    pthread_cond_init(&m_cond, NULL);
+}
+
+
 Https::~Https() {
+    stop();
+    pthread_cond_destroy(&m_cond);
+    pthread_mutex_destroy(&m_lock);
 }
 
 
@@ -48,16 +75,199 @@ bool Https::init(std::string *error) {
 
 
 bool Https::write(Transaction *transaction, int parts, std::string *error) {
-    Utils::HttpsClient m_http_client;
     ms_dbg_a(transaction, 7, "Sending logs to: " + m_audit->m_path1);
 
     std::string log = transaction->toJSON(parts);
-    m_http_client.setRequestType("application/json");
-    m_http_client.setRequestBody(log);
-    m_http_client.download(m_audit->m_path1);
+
+    return enqueue(&log, error);
+}
+
+
+bool Https::writeDigest(const Sampler::Digest &digest, std::string *error) {
+    std::string log;
+
+    formatDigest(digest, true, &log);
+    /* the sender adds the line breaks between the records of a batch */
+    log.pop_back();
+
+    return enqueue(&log, error);
+}
+
+
+bool Https::enqueue(std::string *log, std::string *error) {
+    pthread_mutex_lock(&m_lock);
+    if (m_running == false || m_pid != getpid()) {
+        if (start(error) == false) {
+            pthread_mutex_unlock(&m_lock);
+            return false;
+        }
+    }
+
+    if (m_queue.size() >= kQueueLimit) {
+        m_dropped++;
+        error->assign("HTTPS audit log queue is full, record dropped (" \
+            + std::to_string(m_dropped) + " so far)");
+        pthread_mutex_unlock(&m_lock);
+        return false;
+    }
+
+    m_queue.push_back(std::move(*log));
+    Utils::Metrics::getInstance().set(Utils::Metrics::AuditLogQueueGauge,
+        m_queue.size());
+    pthread_cond_signal(&m_cond);
+    pthread_mutex_unlock(&m_lock);
+
+    return true;
+}
+
+
+size_t Https::sent() {
+    pthread_mutex_lock(&m_lock);
+    size_t s = m_sent;
+    pthread_mutex_unlock(&m_lock);
+    return s;
+}
+
+
+size_t Https::dropped() {
+    pthread_mutex_lock(&m_lock);
+    size_t s = m_dropped;
+    pthread_mutex_unlock(&m_lock);
+    return s;
+}
+
+
+size_t Https::failed() {
+    pthread_mutex_lock(&m_lock);
+    size_t s = m_failed;
+    pthread_mutex_unlock(&m_lock);
+    return s;
+}
+
+
+/*
+ * Has to be called with m_lock held. A writer inherited through fork()
+ * has m_running set but no thread behind it; the records still queued
+ * belong to the parent, which is the one expected to send them.
+ */
+bool Https::start(std::string *error) {
+    if (m_running && m_pid != getpid()) {
+        m_queue.clear();
+        m_running = false;
+    }
+
+    m_stopping = false;
+    if (pthread_create(&m_thread, NULL, &Https::run, this) != 0) {
+        error->assign("Not able to start the HTTPS audit log sender");
+        return false;
+    }
+    m_pid = getpid();
+    m_running = true;
+
     return true;
 }
 
+
+/*
+ * Sends whatever is still queued and waits for the sender to finish.
+ */
+void Https::stop() {
+    pthread_mutex_lock(&m_lock);
+    if (m_running == false || m_pid != getpid()) {
+        pthread_mutex_unlock(&m_lock);
+        return;
+    }
+    m_stopping = true;
+    pthread_cond_signal(&m_cond);
+    pthread_mutex_unlock(&m_lock);
+
+    pthread_join(m_thread, NULL);
+
+    pthread_mutex_lock(&m_lock);
+    m_running = false;
+    pthread_mutex_unlock(&m_lock);
+}
+
+
+void *Https::run(void *data) {
+    Https *h = static_cast<Https *>(data);
+    Utils::HttpsClient client;
+
+    client.setKeepAlive(true);
+
+    pthread_mutex_lock(&h->m_lock);
+    while (true) {
+        while (h->m_queue.empty() && h->m_stopping == false) {
+            pthread_cond_wait(&h->m_cond, &h->m_lock);
+        }
+        if (h->m_queue.empty()) {
+            break;
+        }
+
+        if (h->m_queue.size() < kBatchSize && h->m_stopping == false) {
+            struct timespec deadline;
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_sec += kBatchTimeout / 1000;
+            deadline.tv_nsec += (kBatchTimeout % 1000) * 1000000;
+            if (deadline.tv_nsec >= 1000000000) {
+                deadline.tv_sec++;
+                deadline.tv_nsec -= 1000000000;
+            }
+            while (h->m_queue.size() < kBatchSize
+                && h->m_stopping == false) {
+                if (pthread_cond_timedwait(&h->m_cond, &h->m_lock,
+                    &deadline) == ETIMEDOUT) {
+                    break;
+                }
+            }
+        }
+
+        std::deque<std::string> batch;
+        while (h->m_queue.empty() == false && batch.size() < kBatchSize) {
+            batch.push_back(std::move(h->m_queue.front()));
+            h->m_queue.pop_front();
+        }
+        Utils::Metrics::getInstance().set(Utils::Metrics::AuditLogQueueGauge,
+            h->m_queue.size());
+        pthread_mutex_unlock(&h->m_lock);
+
+        bool ok = h->send(&client, batch);
+
+        pthread_mutex_lock(&h->m_lock);
+        if (ok) {
+            h->m_sent += batch.size();
+        } else {
+            h->m_failed += batch.size();
+            Utils::Metrics::getInstance().increment(
+                Utils::Metrics::AuditLogFailuresCounter, batch.size());
+        }
+    }
+    pthread_mutex_unlock(&h->m_lock);
+
+    return NULL;
+}
+
+
+bool Https::send(Utils::HttpsClient *client,
+    const std::deque<std::string> &batch) {
+    std::string body;
+
+    if (batch.size() == 1) {
+        client->setRequestType("application/json");
+        body = batch.front();
+    } else {
+        client->setRequestType("application/x-ndjson");
+        for (const std::string &record : batch) {
+            body.append(record);
+            body.append("\n");
+        }
+    }
+
+    client->content.clear();
+    client->setRequestBody(body);
+    return client->download(m_audit->m_path1);
+}
+
 }  // namespace writer
 }  // namespace audit_log
 }  // namespace modsecurity
@@ -14,6 +14,11 @@
  */
 
 #ifdef __cplusplus
+#include <pthread.h>
+#include <sys/types.h>
+
+#include <cstddef>
+#include <deque>
 #include <iostream>
 #include <fstream>
 #include <string>
@@ -28,20 +33,62 @@
 #ifdef __cplusplus
 
 namespace modsecurity {
+namespace Utils {
+class HttpsClient;
+}
 namespace audit_log {
 namespace writer {
 
+/**
+ * Sends the JSON audit logs to a collector, off the request thread.
+ *
+ * write() only serializes the transaction and queues the record; a sender
+ * thread, started on the first write of each process (so it is not lost
+ * when the server forks its workers), POSTs them keeping the connection
+ * alive. Records are batched up to kBatchSize or kBatchTimeout
+ * milliseconds, whatever comes first; a batch of more than one record is
+ * sent as NDJSON. When the collector can not keep up and the queue reaches
+ * kQueueLimit records, new records are dropped and counted.
+ *
+ */
 /** @ingroup ModSecurity_CPP_API */
 class Https : public Writer {
  public:
-    explicit Https(audit_log::AuditLog *audit)
-        : audit_log::writer::Writer(audit) { }
+    static const size_t kQueueLimit = 4096;
+    static const size_t kBatchSize = 32;
+    static const long kBatchTimeout = 100;
 
+    explicit Https(audit_log::AuditLog *audit);
     ~Https() override;
 
     bool init(std::string *error) override;
     bool write(Transaction *transaction, int parts,
         std::string *error) override;
+    bool writeDigest(const Sampler::Digest &digest,
+        std::string *error) override;
+
+    size_t sent();
+    size_t dropped();
+    size_t failed();
+
+ private:
+    static void *run(void *data);
+    bool send(Utils::HttpsClient *client,
+        const std::deque<std::string> &batch);
+    bool start(std::string *error);
+    bool enqueue(std::string *log, std::string *error);
+    void stop();
+
+    std::deque<std::string> m_queue;
+    pthread_mutex_t m_lock;
+    pthread_cond_t m_cond;
+    pthread_t m_thread;
+    pid_t m_pid;
+    bool m_running;
+    bool m_stopping;
+    size_t m_sent;
+    size_t m_dropped;
+    size_t m_failed;
 };
 
 }  // namespace writer
@@ -23,12 +23,14 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <stdlib.h>
+#include <errno.h>
 
 #include <fstream>
 #include <mutex>
 
 #include "modsecurity/audit_log.h"
 #include "modsecurity/transaction.h"
+#include "src/utils/log_strings.h"
 #include "src/utils/system.h"
 #include "src/utils/md5.h"
 
@@ -46,34 +48,51 @@ Parallel::~Parallel() {
 
 inline std::string Parallel::logFilePath(time_t *t,
     int part) {
-    struct tm timeinfo;
-    char tstr[300];
-    std::string name("");
-
-    localtime_r(t, &timeinfo);
+    std::string name;
 
     if (part & YearMonthDayDirectory) {
-        memset(tstr, '\0', 300);
-        strftime(tstr, 299, "/%Y%m%d", &timeinfo);
-        name = tstr;
+        name.append(Utils::LogStrings::day(*t));
     }
 
     if (part & YearMonthDayAndTimeDirectory) {
-        memset(tstr, '\0', 300);
-        strftime(tstr, 299, "/%Y%m%d-%H%M", &timeinfo);
-        name = name + tstr;
+        name.append(Utils::LogStrings::minute(*t));
     }
 
     if (part & YearMonthDayAndTimeFileName) {
-        memset(tstr, '\0', 300);
-        strftime(tstr, 299, "/%Y%m%d-%H%M%S", &timeinfo);
-        name = name + tstr;
+        name.append(Utils::LogStrings::second(*t));
     }
 
     return name;
 }
 
 
+/*
+ * Creates the day and minute directories the transaction goes to. The last
+ * minute directory created by the thread is remembered, so only the first
+ * record of each minute pays for the mkdir calls.
+ */
+bool Parallel::createLogDirectories(const std::string &dayDir,
+    const std::string &minuteDir, bool force, std::string *error) {
+    static thread_local std::string lastDirectory;
+
+    if (force == false && minuteDir == lastDirectory) {
+        return true;
+    }
+
+    if (utils::createDir(dayDir, m_audit->getDirectoryPermission(),
+        error) == false) {
+        return false;
+    }
+    if (utils::createDir(minuteDir, m_audit->getDirectoryPermission(),
+        error) == false) {
+        return false;
+    }
+
+    lastDirectory = minuteDir;
+    return true;
+}
+
+
 bool Parallel::init(std::string *error) {
     bool ret;
     if (!m_audit->m_path1.empty()) {
@@ -103,89 +122,116 @@ bool Parallel::init(std::string *error) {
 
 bool Parallel::write(Transaction *transaction, int parts, std::string *error) {
     int fd;
-    std::string log;
+    /* the record is gone to the file by the time write returns */
+    static thread_local std::string log;
     std::string fileName = logFilePath(&transaction->m_timeStamp,
         YearMonthDayDirectory | YearMonthDayAndTimeDirectory
         | YearMonthDayAndTimeFileName);
     bool ret;
 
+    log.clear();
     if (transaction->m_rules->m_auditLog->m_format ==
             audit_log::AuditLog::JSONAuditLogFormat) {
-        log = transaction->toJSON(parts);
+        transaction->toJSON(parts, &log);
+    } else if (transaction->m_rules->m_auditLog->m_format ==
+            audit_log::AuditLog::MsgPackAuditLogFormat) {
+        transaction->toMsgPack(parts, &log);
     } else {
         std::string boundary;
         generateBoundary(&boundary);
-        log = transaction->toOldAuditLogFormat(parts, "-" + boundary + "--");
+        transaction->toOldAuditLogFormat(parts, "-" + boundary + "--", &log);
+    }
+
+    if (compress(&log, error) == false) {
+        return false;
     }
 
     std::string logPath = m_audit->m_storage_dir;
     fileName = logPath + fileName + "-" + *transaction->m_id.get();
+    if (m_audit->getCompressionLevel() > 0) {
+        fileName.append(".gz");
+    }
 
     if (logPath.empty()) {
         error->assign("Log path is not valid.");
         return false;
     }
 
-    ret = utils::createDir((logPath +
-        logFilePath(&transaction->m_timeStamp, YearMonthDayDirectory)).c_str(),
-        m_audit->getDirectoryPermission(),
-        error);
-    if (ret == false) {
-        return false;
-    }
-    ret = utils::createDir((logPath +
-        logFilePath(&transaction->m_timeStamp, YearMonthDayDirectory
-            | YearMonthDayAndTimeDirectory)).c_str(),
-        m_audit->getDirectoryPermission(),
-        error);
-    if (ret == false) {
+    std::string dayDir = logPath + logFilePath(&transaction->m_timeStamp,
+        YearMonthDayDirectory);
+    std::string minuteDir = logPath + logFilePath(&transaction->m_timeStamp,
+        YearMonthDayDirectory | YearMonthDayAndTimeDirectory);
+
+    if (createLogDirectories(dayDir, minuteDir, false, error) == false) {
         return false;
     }
 
     fd = open(fileName.c_str(), O_CREAT | O_WRONLY | O_APPEND,
         m_audit->getFilePermission());
+    if (fd < 0 && errno == ENOENT) {
+        /* the directory went away since we last created it */
+        if (createLogDirectories(dayDir, minuteDir, true, error) == false) {
+            return false;
+        }
+        fd = open(fileName.c_str(), O_CREAT | O_WRONLY | O_APPEND,
+            m_audit->getFilePermission());
+    }
     if (fd < 0) {
         error->assign("Not able to open: " + fileName + ". " \
             + strerror(errno));
         return false;
     }
-    close(fd);
 
-    std::ofstream myfile;
-    std::string a(fileName.c_str());
-    myfile.open(a, std::ofstream::out | std::ofstream::app);
-    myfile << log;
-    myfile.close();
-
-    if (m_audit->m_path1.empty() == false
-        && m_audit->m_path2.empty() == false) {
-        std::string msg = transaction->toOldAuditLogFormatIndex(fileName,
-            log.length(), Utils::Md5::hexdigest(log));
-        ret = utils::SharedFiles::getInstance().write(m_audit->m_path2, msg,
-            error);
-        if (ret == false) {
+    const char *data = log.c_str();
+    size_t left = log.size();
+    while (left > 0) {
+        ssize_t wrote = ::write(fd, data, left);
+        if (wrote < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            error->assign("Not able to write: " + fileName + ". " \
+                + strerror(errno));
+            close(fd);
             return false;
         }
+        data = data + wrote;
+        left = left - wrote;
     }
-    if (m_audit->m_path1.empty() == false
-        && m_audit->m_path2.empty() == true) {
-        std::string msg = transaction->toOldAuditLogFormatIndex(fileName,
-            log.length(), Utils::Md5::hexdigest(log));
-        ret = utils::SharedFiles::getInstance().write(m_audit->m_path1, msg,
+    close(fd);
+
+    if (m_audit->m_path1.empty() && m_audit->m_path2.empty()) {
+        return true;
+    }
+
+    static thread_local std::string index;
+    index.clear();
+    transaction->toOldAuditLogFormatIndex(fileName, log.length(),
+        Utils::Md5::hexdigest(log), &index);
+    /* the index goes to the second path when there is one */
+    ret = utils::SharedFiles::getInstance().write(
+        m_audit->m_path2.empty() ? m_audit->m_path1 : m_audit->m_path2,
+        index, error);
+    if (ret == false) {
+        return false;
+    }
+
+    return true;
+}
+
+
+bool Parallel::writeDigest(const Sampler::Digest &digest,
+    std::string *error) {
+    std::string msg;
+
+    formatDigest(digest, true, &msg);
+    if (m_audit->m_path2.empty() == false) {
+        return utils::SharedFiles::getInstance().write(m_audit->m_path2, msg,
             error);
-        if (ret == false) {
-            return false;
-        }
     }
-    if (m_audit->m_path1.empty() == true
-        && m_audit->m_path2.empty() == false) {
-        std::string msg = transaction->toOldAuditLogFormatIndex(fileName,
-            log.length(), Utils::Md5::hexdigest(log));
-        ret = utils::SharedFiles::getInstance().write(m_audit->m_path2, msg,
+    if (m_audit->m_path1.empty() == false) {
+        return utils::SharedFiles::getInstance().write(m_audit->m_path1, msg,
             error);
-        if (ret == false) {
-            return false;
-        }
     }
 
     return true;
@@ -40,6 +40,9 @@ class Parallel : public Writer {
     bool init(std::string *error) override;
     bool write(Transaction *transaction, int parts,
         std::string *error) override;
+    /* digests go to the index, uncompressed like the rest of it */
+    bool writeDigest(const Sampler::Digest &digest,
+        std::string *error) override;
 
 
     /**
@@ -66,6 +69,10 @@ class Parallel : public Writer {
     };
 
     static inline std::string logFilePath(time_t *t, int part);
+
+ private:
+    bool createLogDirectories(const std::string &dayDir,
+        const std::string &minuteDir, bool force, std::string *error);
 };
 
 }  // namespace writer
@@ -0,0 +1,253 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/audit_log/writer/ring.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "modsecurity/audit_log.h"
+#include "modsecurity/audit_log_ring.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/transaction.h"
+
+
+namespace modsecurity {
+namespace audit_log {
+namespace writer {
+
+
+const uint64_t Ring::kCapacity;
+
+
+namespace {
+
+/* the data starts on a page of its own */
+const uint64_t kDataOffset = 4096;
+
+
+uint64_t aligned(uint64_t size) {
+    return (size + MSC_AUDIT_LOG_RING_ALIGN - 1)
+        & ~static_cast<uint64_t>(MSC_AUDIT_LOG_RING_ALIGN - 1);
+}
+
+
+/* a ring this version can write into, as far as the file size allows */
+bool usable(const MscAuditLogRingHeader &header, off_t size) {
+    return header.magic == MSC_AUDIT_LOG_RING_MAGIC
+        && header.version == MSC_AUDIT_LOG_RING_VERSION
+        && header.capacity >= 2 * MSC_AUDIT_LOG_RING_ALIGN
+        && (header.capacity & (header.capacity - 1)) == 0
+        && header.data_offset >= sizeof(MscAuditLogRingHeader)
+        && header.data_offset % MSC_AUDIT_LOG_RING_ALIGN == 0
+        && static_cast<uint64_t>(size) >= header.data_offset
+            + header.capacity;
+}
+
+}  // namespace
+
+
+Ring::Ring(audit_log::AuditLog *audit)
+    : audit_log::writer::Writer(audit),
+    m_header(nullptr),
+    m_data(nullptr),
+    m_size(0) { }
+
+
+Ring::~Ring() {
+    if (m_header != nullptr) {
+        munmap(m_header, m_size);
+    }
+}
+
+
+/*
+ * The lock on the file keeps two processes from setting up the same new
+ * ring at once; the magic is stored last, for a consumer mapping the file
+ * meanwhile to wait for it.
+ */
+bool Ring::init(std::string *error) {
+    const std::string &path = m_audit->m_path1;
+    if (path.empty()) {
+        error->assign("SecAuditLog has to be set to the file of the ring.");
+        return false;
+    }
+
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC,
+        m_audit->getFilePermission());
+    if (fd < 0) {
+        error->assign("Failed to open the audit log ring " + path + ": " \
+            + strerror(errno));
+        return false;
+    }
+    flock(fd, LOCK_EX);
+
+    /* anything else already there, an audit log file say, is kept */
+    MscAuditLogRingHeader existing;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        st.st_size = -1;
+    }
+    bool fresh = st.st_size == 0;
+    if (fresh == false && (st.st_size < 0
+        || pread(fd, &existing, sizeof(existing), 0) != sizeof(existing)
+        || usable(existing, st.st_size) == false)) {
+        error->assign("Not an audit log ring of this version: " + path);
+        flock(fd, LOCK_UN);
+        close(fd);
+        return false;
+    }
+
+    uint64_t offset = fresh ? kDataOffset : existing.data_offset;
+    uint64_t capacity = fresh ? kCapacity : existing.capacity;
+    if (fresh && ftruncate(fd, offset + capacity) != 0) {
+        error->assign("Failed to size the audit log ring " + path + ": " \
+            + strerror(errno));
+        flock(fd, LOCK_UN);
+        close(fd);
+        return false;
+    }
+
+    void *map = mmap(NULL, offset + capacity, PROT_READ | PROT_WRITE,
+        MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        error->assign("Failed to map the audit log ring " + path + ": " \
+            + strerror(errno));
+        flock(fd, LOCK_UN);
+        close(fd);
+        return false;
+    }
+
+    m_header = static_cast<MscAuditLogRingHeader *>(map);
+    m_data = static_cast<char *>(map) + offset;
+    m_size = offset + capacity;
+    if (fresh) {
+        memset(m_header, 0, sizeof(MscAuditLogRingHeader));
+        m_header->version = MSC_AUDIT_LOG_RING_VERSION;
+        m_header->capacity = capacity;
+        m_header->data_offset = offset;
+        __atomic_store_n(&m_header->magic, MSC_AUDIT_LOG_RING_MAGIC,
+            __ATOMIC_RELEASE);
+    }
+
+    flock(fd, LOCK_UN);
+    close(fd);
+    return true;
+}
+
+
+bool Ring::write(Transaction *transaction, int parts, std::string *error) {
+    static thread_local std::string log;
+
+    log.clear();
+    if (transaction->m_rules->m_auditLog->m_format ==
+            audit_log::AuditLog::JSONAuditLogFormat) {
+        transaction->toJSON(parts, &log);
+    } else if (transaction->m_rules->m_auditLog->m_format ==
+            audit_log::AuditLog::MsgPackAuditLogFormat) {
+        transaction->toMsgPack(parts, &log);
+    } else {
+        std::string boundary;
+        generateBoundary(&boundary);
+        transaction->toOldAuditLogFormat(parts, "-" + boundary + "--", &log);
+    }
+
+    if (compress(&log, error) == false) {
+        return false;
+    }
+
+    return publish(log, error);
+}
+
+
+bool Ring::writeDigest(const Sampler::Digest &digest, std::string *error) {
+    std::string log;
+
+    formatDigest(digest, false, &log);
+    if (compress(&log, error) == false) {
+        return false;
+    }
+
+    return publish(log, error);
+}
+
+
+/*
+ * Reserves the space of the record, and of the padding in front of it
+ * when it would cross the end of the data, with a single compare and
+ * swap on head; the sequences, stored last, tell the consumer that the
+ * record there is complete.
+ */
+bool Ring::publish(const std::string &log, std::string *error) {
+    MscAuditLogRingHeader *h = m_header;
+    uint64_t capacity = h->capacity;
+    uint64_t size = aligned(sizeof(MscAuditLogRingRecord) + log.size());
+
+    if (size > capacity / 2) {
+        __atomic_add_fetch(&h->dropped, 1, __ATOMIC_RELAXED);
+        error->assign("Audit log record too large for the ring (" \
+            + std::to_string(log.size()) + " bytes), dropped");
+        return false;
+    }
+
+    uint64_t head = __atomic_load_n(&h->head, __ATOMIC_ACQUIRE);
+    uint64_t pad;
+    do {
+        uint64_t offset = head & (capacity - 1);
+        pad = offset + size > capacity ? capacity - offset : 0;
+        uint64_t tail = __atomic_load_n(&h->tail, __ATOMIC_ACQUIRE);
+        if (head + pad + size - tail > capacity) {
+            uint64_t dropped = __atomic_add_fetch(&h->dropped, 1,
+                __ATOMIC_RELAXED);
+            error->assign("Audit log ring is full, record dropped (" \
+                + std::to_string(dropped) + " so far)");
+            return false;
+        }
+    } while (__atomic_compare_exchange_n(&h->head, &head, head + pad + size,
+        true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) == false);
+
+    MscAuditLogRingRecord *record;
+    if (pad > 0) {
+        record = reinterpret_cast<MscAuditLogRingRecord *>(
+            m_data + (head & (capacity - 1)));
+        record->length = pad - sizeof(MscAuditLogRingRecord);
+        record->kind = MSC_AUDIT_LOG_RING_PADDING;
+        __atomic_store_n(&record->sequence, head + 1, __ATOMIC_RELEASE);
+        head += pad;
+    }
+
+    record = reinterpret_cast<MscAuditLogRingRecord *>(
+        m_data + (head & (capacity - 1)));
+    record->length = log.size();
+    record->kind = MSC_AUDIT_LOG_RING_RECORD;
+    memcpy(record + 1, log.data(), log.size());
+    __atomic_store_n(&record->sequence, head + 1, __ATOMIC_RELEASE);
+    __atomic_add_fetch(&h->written, 1, __ATOMIC_RELAXED);
+
+    return true;
+}
+
+
+}  // namespace writer
+}  // namespace audit_log
+}  // namespace modsecurity
@@ -0,0 +1,74 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#ifdef __cplusplus
+#include <cstddef>
+#include <string>
+#endif
+
+#ifndef SRC_AUDIT_LOG_WRITER_RING_H_
+#define SRC_AUDIT_LOG_WRITER_RING_H_
+
+#include "src/audit_log/writer/writer.h"
+#include "modsecurity/audit_log_ring.h"
+#include "modsecurity/transaction.h"
+
+#ifdef __cplusplus
+
+namespace modsecurity {
+namespace audit_log {
+namespace writer {
+
+/**
+ * Publishes the records into a ring buffer in a memory mapped file (the
+ * SecAuditLog path, /dev/shm being the natural place for it), for a log
+ * shipper on the same host to read them in place; the layout is the one
+ * of modsecurity/audit_log_ring.h, and tools/audit-log-ring is a
+ * consumer to start from.
+ *
+ * A file already holding a ring is used as is, whoever created it, so
+ * every worker process (and every reload) writes to the same ring; an
+ * empty or missing one becomes a ring of kCapacity bytes, any other file
+ * is refused. When the consumer lags and a record does
+ * not fit, it is dropped and counted in the ring header.
+ */
+/** @ingroup ModSecurity_CPP_API */
+class Ring : public Writer {
+ public:
+    static const uint64_t kCapacity = 16 * 1024 * 1024;
+
+    explicit Ring(audit_log::AuditLog *audit);
+    ~Ring() override;
+
+    bool init(std::string *error) override;
+    bool write(Transaction *transaction, int parts,
+        std::string *error) override;
+    bool writeDigest(const Sampler::Digest &digest,
+        std::string *error) override;
+
+ private:
+    bool publish(const std::string &log, std::string *error);
+
+    MscAuditLogRingHeader *m_header;
+    char *m_data;
+    size_t m_size;
+};
+
+}  // namespace writer
+}  // namespace audit_log
+}  // namespace modsecurity
+#endif
+
+#endif  // SRC_AUDIT_LOG_WRITER_RING_H_
@@ -34,15 +34,24 @@ bool Serial::init(std::string *error) {
 
 
 bool Serial::write(Transaction *transaction, int parts, std::string *error) {
-    std::string msg;
+    /* the record is gone to the file by the time write returns */
+    static thread_local std::string msg;
 
+    msg.clear();
     if (transaction->m_rules->m_auditLog->m_format ==
             audit_log::AuditLog::JSONAuditLogFormat) {
-        msg = transaction->toJSON(parts);
+        transaction->toJSON(parts, &msg);
+    } else if (transaction->m_rules->m_auditLog->m_format ==
+            audit_log::AuditLog::MsgPackAuditLogFormat) {
+        transaction->toMsgPack(parts, &msg);
     } else {
         std::string boundary;
         generateBoundary(&boundary);
-        msg = transaction->toOldAuditLogFormat(parts, "-" + boundary + "--");
+        transaction->toOldAuditLogFormat(parts, "-" + boundary + "--", &msg);
+    }
+
+    if (compress(&msg, error) == false) {
+        return false;
     }
 
     return utils::SharedFiles::getInstance().write(m_audit->m_path1, msg,
@@ -0,0 +1,397 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/audit_log/writer/stream.h"
+
+#include <errno.h>
+#include <netdb.h>
+#include <pthread.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <deque>
+#include <string>
+
+#include "modsecurity/audit_log.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/transaction.h"
+#include "src/utils/metrics.h"
+
+
+namespace modsecurity {
+namespace audit_log {
+namespace writer {
+
+
+const size_t Stream::kQueueLimit;
+const size_t Stream::kBatchSize;
+const long Stream::kBatchTimeout;
+
+
+Stream::Stream(audit_log::AuditLog *audit)
+    : audit_log::writer::Writer(audit),
+    m_udp(false),
+    m_socket(-1),
+    m_pid(0),
+    m_running(false),
+    m_stopping(false),
+    m_sent(0),
+    m_dropped(0),
+    m_failed(0) {
+    pthread_mutex_init(&m_lock, NULL);
+    pthread_cond_init(&m_cond, NULL);
+}
+
+
+Stream::~Stream() {
+    stop();
+    if (m_socket >= 0) {
+        close(m_socket);
+    }
+    pthread_cond_destroy(&m_cond);
+    pthread_mutex_destroy(&m_lock);
+}
+
+
+bool Stream::parse(const std::string &url, bool *udp, std::string *host,
+    std::string *port) {
+    size_t start;
+    if (url.compare(0, 6, "tcp://") == 0) {
+        *udp = false;
+    } else if (url.compare(0, 6, "udp://") == 0) {
+        *udp = true;
+    } else {
+        return false;
+    }
+    start = 6;
+
+    /* an IPv6 address is in brackets, as in an URL */
+    size_t colon;
+    if (url.compare(start, 1, "[") == 0) {
+        size_t close = url.find(']', start);
+        if (close == std::string::npos || url.compare(close + 1, 1, ":")) {
+            return false;
+        }
+        host->assign(url, start + 1, close - start - 1);
+        colon = close + 1;
+    } else {
+        colon = url.rfind(':');
+        if (colon == std::string::npos || colon < start) {
+            return false;
+        }
+        host->assign(url, start, colon - start);
+    }
+    port->assign(url, colon + 1, std::string::npos);
+
+    return host->empty() == false && port->empty() == false
+        && port->find_first_not_of("0123456789") == std::string::npos;
+}
+
+
+bool Stream::init(std::string *error) {
+    if (parse(m_audit->m_path1, &m_udp, &m_host, &m_port) == false) {
+        error->assign("Not a tcp://host:port or udp://host:port audit " \
+            "log destination: " + m_audit->m_path1);
+        return false;
+    }
+    return true;
+}
+
+
+bool Stream::write(Transaction *transaction, int parts, std::string *error) {
+    std::string log;
+
+    ms_dbg_a(transaction, 7, "Streaming logs to: " + m_audit->m_path1);
+
+    if (transaction->m_rules->m_auditLog->m_format ==
+            audit_log::AuditLog::JSONAuditLogFormat) {
+        transaction->toJSON(parts, &log);
+    } else if (transaction->m_rules->m_auditLog->m_format ==
+            audit_log::AuditLog::MsgPackAuditLogFormat) {
+        transaction->toMsgPack(parts, &log);
+    } else {
+        std::string boundary;
+        generateBoundary(&boundary);
+        transaction->toOldAuditLogFormat(parts, "-" + boundary + "--", &log);
+    }
+
+    return enqueue(&log, error);
+}
+
+
+bool Stream::writeDigest(const Sampler::Digest &digest, std::string *error) {
+    std::string log;
+
+    formatDigest(digest, false, &log);
+
+    return enqueue(&log, error);
+}
+
+
+bool Stream::enqueue(std::string *log, std::string *error) {
+    pthread_mutex_lock(&m_lock);
+    if (m_running == false || m_pid != getpid()) {
+        if (start(error) == false) {
+            pthread_mutex_unlock(&m_lock);
+            return false;
+        }
+    }
+
+    if (m_queue.size() >= kQueueLimit) {
+        m_dropped++;
+        error->assign("Audit log stream queue is full, record dropped (" \
+            + std::to_string(m_dropped) + " so far)");
+        pthread_mutex_unlock(&m_lock);
+        return false;
+    }
+
+    m_queue.push_back(std::move(*log));
+    Utils::Metrics::getInstance().set(Utils::Metrics::AuditLogQueueGauge,
+        m_queue.size());
+    pthread_cond_signal(&m_cond);
+    pthread_mutex_unlock(&m_lock);
+
+    return true;
+}
+
+
+size_t Stream::sent() {
+    pthread_mutex_lock(&m_lock);
+    size_t s = m_sent;
+    pthread_mutex_unlock(&m_lock);
+    return s;
+}
+
+
+size_t Stream::dropped() {
+    pthread_mutex_lock(&m_lock);
+    size_t s = m_dropped;
+    pthread_mutex_unlock(&m_lock);
+    return s;
+}
+
+
+size_t Stream::failed() {
+    pthread_mutex_lock(&m_lock);
+    size_t s = m_failed;
+    pthread_mutex_unlock(&m_lock);
+    return s;
+}
+
+
+/*
+ * Has to be called with m_lock held. As for Https, a writer inherited
+ * through fork() leaves the queue to the parent; the child closes its
+ * copy of the socket and connects on its own.
+ */
+bool Stream::start(std::string *error) {
+    if (m_running && m_pid != getpid()) {
+        m_queue.clear();
+        m_running = false;
+        if (m_socket >= 0) {
+            close(m_socket);
+            m_socket = -1;
+        }
+    }
+
+    m_stopping = false;
+    if (pthread_create(&m_thread, NULL, &Stream::run, this) != 0) {
+        error->assign("Not able to start the audit log stream sender");
+        return false;
+    }
+    m_pid = getpid();
+    m_running = true;
+
+    return true;
+}
+
+
+/*
+ * Sends whatever is still queued and waits for the sender to finish.
+ */
+void Stream::stop() {
+    pthread_mutex_lock(&m_lock);
+    if (m_running == false || m_pid != getpid()) {
+        pthread_mutex_unlock(&m_lock);
+        return;
+    }
+    m_stopping = true;
+    pthread_cond_signal(&m_cond);
+    pthread_mutex_unlock(&m_lock);
+
+    pthread_join(m_thread, NULL);
+
+    pthread_mutex_lock(&m_lock);
+    m_running = false;
+    pthread_mutex_unlock(&m_lock);
+}
+
+
+void *Stream::run(void *data) {
+    Stream *s = static_cast<Stream *>(data);
+
+    pthread_mutex_lock(&s->m_lock);
+    while (true) {
+        while (s->m_queue.empty() && s->m_stopping == false) {
+            pthread_cond_wait(&s->m_cond, &s->m_lock);
+        }
+        if (s->m_queue.empty()) {
+            break;
+        }
+
+        if (s->m_queue.size() < kBatchSize && s->m_stopping == false) {
+            struct timespec deadline;
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_sec += kBatchTimeout / 1000;
+            deadline.tv_nsec += (kBatchTimeout % 1000) * 1000000;
+            if (deadline.tv_nsec >= 1000000000) {
+                deadline.tv_sec++;
+                deadline.tv_nsec -= 1000000000;
+            }
+            while (s->m_queue.size() < kBatchSize
+                && s->m_stopping == false) {
+                if (pthread_cond_timedwait(&s->m_cond, &s->m_lock,
+                    &deadline) == ETIMEDOUT) {
+                    break;
+                }
+            }
+        }
+
+        std::deque<std::string> batch;
+        while (s->m_queue.empty() == false && batch.size() < kBatchSize) {
+            batch.push_back(std::move(s->m_queue.front()));
+            s->m_queue.pop_front();
+        }
+        Utils::Metrics::getInstance().set(Utils::Metrics::AuditLogQueueGauge,
+            s->m_queue.size());
+        pthread_mutex_unlock(&s->m_lock);
+
+        size_t count = batch.size();
+        bool ok = s->send(&batch);
+
+        pthread_mutex_lock(&s->m_lock);
+        if (ok) {
+            s->m_sent += count;
+        } else {
+            s->m_failed += count;
+            Utils::Metrics::getInstance().increment(
+                Utils::Metrics::AuditLogFailuresCounter, count);
+        }
+    }
+    pthread_mutex_unlock(&s->m_lock);
+
+    return NULL;
+}
+
+
+bool Stream::connect() {
+    struct addrinfo hints;
+    struct addrinfo *addresses;
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = m_udp ? SOCK_DGRAM : SOCK_STREAM;
+    if (getaddrinfo(m_host.c_str(), m_port.c_str(), &hints,
+        &addresses) != 0) {
+        return false;
+    }
+
+    for (struct addrinfo *a = addresses; a != NULL; a = a->ai_next) {
+        int fd = socket(a->ai_family, a->ai_socktype | SOCK_CLOEXEC,
+            a->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+        if (::connect(fd, a->ai_addr, a->ai_addrlen) == 0) {
+            m_socket = fd;
+            break;
+        }
+        close(fd);
+    }
+    freeaddrinfo(addresses);
+
+    return m_socket >= 0;
+}
+
+
+/*
+ * Over TCP, a batch that fails is sent once more on a new connection: the
+ * collector may have closed the idle one. The frames are whole on every
+ * connection, none is left halfway, but the records that made it before
+ * the failure are received twice.
+ */
+bool Stream::send(std::deque<std::string> *batch) {
+    std::string error;
+    std::string out;
+
+    for (std::string &record : *batch) {
+        if (compress(&record, &error) == false) {
+            return false;
+        }
+        if (m_udp) {
+            continue;
+        }
+        uint32_t size = record.size();
+        for (int i = 3; i >= 0; i--) {
+            out.push_back(static_cast<char>((size >> (i * 8)) & 0xff));
+        }
+        out.append(record);
+    }
+
+    for (int attempt = 0; attempt < (m_udp ? 1 : 2); attempt++) {
+        if (m_socket < 0 && connect() == false) {
+            return false;
+        }
+
+        bool ok = true;
+        if (m_udp) {
+            for (const std::string &record : *batch) {
+                if (::send(m_socket, record.data(), record.size(),
+                    MSG_NOSIGNAL) < 0) {
+                    ok = false;
+                }
+            }
+            return ok;
+        }
+
+        size_t done = 0;
+        while (done < out.size()) {
+            ssize_t n = ::send(m_socket, out.data() + done,
+                out.size() - done, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                ok = false;
+                break;
+            }
+            done += n;
+        }
+        if (ok) {
+            return true;
+        }
+        close(m_socket);
+        m_socket = -1;
+    }
+
+    return false;
+}
+
+}  // namespace writer
+}  // namespace audit_log
+}  // namespace modsecurity
@@ -0,0 +1,105 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#ifdef __cplusplus
+#include <pthread.h>
+#include <sys/types.h>
+
+#include <cstddef>
+#include <deque>
+#include <string>
+#endif
+
+#ifndef SRC_AUDIT_LOG_WRITER_STREAM_H_
+#define SRC_AUDIT_LOG_WRITER_STREAM_H_
+
+#include "src/audit_log/writer/writer.h"
+#include "modsecurity/transaction.h"
+
+#ifdef __cplusplus
+
+namespace modsecurity {
+namespace audit_log {
+namespace writer {
+
+/**
+ * Streams the records to tcp://host:port or udp://host:port (the
+ * SecAuditLog value), for a collector in front of a message bus.
+ *
+ * As with Https, write() only serializes the transaction and queues the
+ * record; a sender thread of each process compresses them, when
+ * SecAuditLogCompress asks so, and sends them by batches of up to
+ * kBatchSize records or kBatchTimeout milliseconds. Over TCP a record is
+ * framed by its size, 4 bytes in network order, and a batch goes out in
+ * a single send(); the connection is opened again on failure. Over UDP a
+ * record is a datagram of its own. When the queue reaches kQueueLimit
+ * records, new records are dropped and counted.
+ */
+/** @ingroup ModSecurity_CPP_API */
+class Stream : public Writer {
+ public:
+    static const size_t kQueueLimit = 4096;
+    static const size_t kBatchSize = 64;
+    static const long kBatchTimeout = 100;
+
+    explicit Stream(audit_log::AuditLog *audit);
+    ~Stream() override;
+
+    bool init(std::string *error) override;
+    bool write(Transaction *transaction, int parts,
+        std::string *error) override;
+    bool writeDigest(const Sampler::Digest &digest,
+        std::string *error) override;
+
+    size_t sent();
+    size_t dropped();
+    size_t failed();
+
+    /* splits tcp://host:port or udp://host:port */
+    static bool parse(const std::string &url, bool *udp, std::string *host,
+        std::string *port);
+
+ private:
+    static void *run(void *data);
+    bool connect();
+    bool send(std::deque<std::string> *batch);
+    bool start(std::string *error);
+    bool enqueue(std::string *log, std::string *error);
+    void stop();
+
+    bool m_udp;
+    std::string m_host;
+    std::string m_port;
+    /* only used by the sender thread */
+    int m_socket;
+
+    std::deque<std::string> m_queue;
+    pthread_mutex_t m_lock;
+    pthread_cond_t m_cond;
+    pthread_t m_thread;
+    pid_t m_pid;
+    bool m_running;
+    bool m_stopping;
+    size_t m_sent;
+    size_t m_dropped;
+    size_t m_failed;
+};
+
+}  // namespace writer
+}  // namespace audit_log
+}  // namespace modsecurity
+#endif
+
+#endif  // SRC_AUDIT_LOG_WRITER_STREAM_H_
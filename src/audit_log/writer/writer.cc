@@ -15,14 +15,47 @@
 
 #include "src/audit_log/writer/writer.h"
 
+#ifdef WITH_ZLIB
+#include <zlib.h>
+#endif
+
+#include <stdio.h>
+
+#include <cstring>
 #include <string>
 
 #include "modsecurity/audit_log.h"
+#include "src/utils/msgpack.h"
+#include "src/utils/shared_files.h"
+#include "src/utils/string.h"
 
 namespace modsecurity {
 namespace audit_log {
 namespace writer {
 
+
+namespace {
+
+void appendJSONString(const std::string &s, std::string *out) {
+    out->push_back('"');
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            out->push_back('\\');
+            out->push_back(c);
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char u[7];
+            snprintf(u, sizeof(u), "\\u%04x", c);
+            out->append(u);
+        } else {
+            out->push_back(c);
+        }
+    }
+    out->push_back('"');
+}
+
+}  // namespace
+
+
 void Writer::generateBoundary(std::string *boundary) {
     static const char alphanum[] =
         "0123456789"
@@ -34,6 +67,108 @@ void Writer::generateBoundary(std::string *boundary) {
     }
 }
 
+
+bool Writer::compress(std::string *log, std::string *error) {
+    int level = m_audit->getCompressionLevel();
+    if (level == 0) {
+        return true;
+    }
+#ifdef WITH_ZLIB
+    static thread_local std::string out;
+    z_stream z;
+
+    memset(&z, 0, sizeof(z));
+    /* 16 on top of the window bits asks for the gzip wrapper */
+    if (deflateInit2(&z, level, Z_DEFLATED, 15 + 16, 8,
+        Z_DEFAULT_STRATEGY) != Z_OK) {
+        error->assign("Not able to start the audit log compression.");
+        return false;
+    }
+
+    out.resize(deflateBound(&z, log->size()));
+    z.next_in = reinterpret_cast<Bytef *>(&(*log)[0]);
+    z.avail_in = log->size();
+    z.next_out = reinterpret_cast<Bytef *>(&out[0]);
+    z.avail_out = out.size();
+
+    int ret = deflate(&z, Z_FINISH);
+    size_t size = z.total_out;
+    deflateEnd(&z);
+    if (ret != Z_STREAM_END) {
+        error->assign("Not able to compress the audit log record.");
+        return false;
+    }
+
+    out.resize(size);
+    log->swap(out);
+    return true;
+#else
+    error->assign("ModSecurity was not compiled with zlib support, " \
+        "audit log records can not be compressed.");
+    return false;
+#endif
+}
+
+
+void Writer::formatDigest(const Sampler::Digest &digest, bool json,
+    std::string *out) {
+    time_t first = digest.m_firstSeen;
+    time_t last = digest.m_lastSeen;
+    std::string firstSeen = utils::string::ascTime(&first);
+    std::string lastSeen = utils::string::ascTime(&last);
+
+    if (json == false && m_audit->m_format ==
+            audit_log::AuditLog::MsgPackAuditLogFormat) {
+        size_t start = out->size();
+        Utils::MsgPack m(out);
+
+        out->append(4, '\0');
+        m.mapOpen();
+        m.string("digest");
+        m.mapOpen();
+        m.add("rule_id", digest.m_ruleId);
+        m.add("client_ip", digest.m_clientIpAddress);
+        m.add("suppressed", static_cast<int64_t>(digest.m_suppressed));
+        m.add("first_seen", firstSeen);
+        m.add("last_seen", lastSeen);
+        m.mapClose();
+        m.mapClose();
+
+        uint32_t size = out->size() - start - 4;
+        for (int i = 0; i < 4; i++) {
+            (*out)[start + i] = static_cast<char>(
+                (size >> ((3 - i) * 8)) & 0xff);
+        }
+        return;
+    }
+
+    out->append("{\"digest\":{\"rule_id\":");
+    out->append(std::to_string(digest.m_ruleId));
+    out->append(",\"client_ip\":");
+    appendJSONString(digest.m_clientIpAddress, out);
+    out->append(",\"suppressed\":");
+    out->append(std::to_string(digest.m_suppressed));
+    out->append(",\"first_seen\":");
+    appendJSONString(firstSeen, out);
+    out->append(",\"last_seen\":");
+    appendJSONString(lastSeen, out);
+    out->append("}}\n");
+}
+
+
+bool Writer::writeDigest(const Sampler::Digest &digest, std::string *error) {
+    std::string log;
+
+    formatDigest(digest, false, &log);
+    if (compress(&log, error) == false) {
+        return false;
+    }
+
+    return utils::SharedFiles::getInstance().write(m_audit->m_path1, log,
+        error);
+}
+
+
 }  // namespace writer
 }  // namespace audit_log
 }  // namespace modsecurity
@@ -30,6 +30,7 @@
 
 #include "modsecurity/transaction.h"
 #include "modsecurity/audit_log.h"
+#include "src/audit_log/sampler.h"
 
 #define SERIAL_AUDIT_LOG_BOUNDARY_LENGTH 8
 
@@ -50,9 +51,30 @@ class Writer {
     virtual bool write(Transaction *transaction, int parts,
         std::string *error) = 0;
 
+    /**
+     * Writes down the digest of the records SecAuditLogRateLimit left
+     * out; by default next to the records, in the audit log file.
+     */
+    virtual bool writeDigest(const Sampler::Digest &digest,
+        std::string *error);
+
     static void generateBoundary(std::string *boundary);
 
  protected:
+    /**
+     * Turns the record in log into a gzip member of its own, when the
+     * audit log is to be compressed; members one after the other still
+     * make a valid gzip file, which zcat reads while it grows.
+     */
+    bool compress(std::string *log, std::string *error);
+
+    /**
+     * A digest as a JSON line, or as a MessagePack record when that is
+     * what the audit log is written in.
+     */
+    void formatDigest(const Sampler::Digest &digest, bool json,
+        std::string *out);
+
     AuditLog *m_audit;
 };
 
@@ -0,0 +1,316 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "modsecurity/body_buffer.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace modsecurity {
+
+
+namespace {
+
+
+bool writeAll(int fd, const char *buf, size_t len) {
+    while (len > 0) {
+        ssize_t n = write(fd, buf, len);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        buf = buf + n;
+        len = len - n;
+    }
+    return true;
+}
+
+
+/* Reads the first size bytes of the file, less if some can not be read. */
+void readAll(int fd, std::string *out, size_t size) {
+    size_t got = 0;
+    out->resize(size);
+    while (got < size) {
+        ssize_t n = pread(fd, &(*out)[got], size - got, got);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        got = got + n;
+    }
+    out->resize(got);
+}
+
+
+}  // namespace
+
+
+const size_t BodyBuffer::kMinChunkSize;
+const size_t BodyBuffer::kMaxChunkSize;
+
+
+void BodyBuffer::append(const char *buf, size_t len) {
+    if (len == 0) {
+        return;
+    }
+
+    if (m_fd < 0 && m_spoolLimit > 0 && m_size + len > m_spoolLimit) {
+        spool();
+    }
+    if (m_fd >= 0) {
+        if (writeAll(m_fd, buf, len)) {
+            m_size = m_size + len;
+            return;
+        }
+        /* out of disk: carry on in memory */
+        unspool();
+    }
+
+    m_size = m_size + len;
+
+    if (m_chunks.empty() == false) {
+        std::string &last = m_chunks.back();
+        size_t room = last.capacity() - last.size();
+        if (room >= len) {
+            last.append(buf, len);
+            return;
+        }
+        if (room > 0) {
+            last.append(buf, room);
+            buf = buf + room;
+            len = len - room;
+        }
+    }
+
+    size_t capacity = std::min(std::max(m_size, kMinChunkSize),
+        kMaxChunkSize);
+    m_chunks.emplace_back();
+    m_chunks.back().reserve(std::max(std::max(capacity, len), m_reserve));
+    m_chunks.back().append(buf, len);
+    m_reserve = 0;
+}
+
+
+void BodyBuffer::reserve(size_t len) {
+    if (m_fd >= 0 || (m_spoolLimit > 0 && m_size + len > m_spoolLimit)) {
+        m_reserve = 0;
+        return;
+    }
+
+    size_t room = 0;
+    if (m_chunks.empty() == false) {
+        room = m_chunks.back().capacity() - m_chunks.back().size();
+    }
+    m_reserve = len > room ? len - room : 0;
+}
+
+
+void BodyBuffer::clear() {
+    if (m_map != nullptr) {
+        munmap(m_map, m_mapped);
+        m_map = nullptr;
+        m_mapped = 0;
+    }
+    if (m_fd >= 0) {
+        close(m_fd);
+        m_fd = -1;
+    }
+    std::string().swap(m_copy);
+    m_chunks.clear();
+    m_size = 0;
+    m_reserve = 0;
+    m_spoolLimit = 0;
+    m_spoolDir.clear();
+}
+
+
+void BodyBuffer::keepLast(size_t len) {
+    if (len >= m_size) {
+        return;
+    }
+    if (m_fd >= 0) {
+        unspool();
+    }
+
+    std::string tail;
+    tail.reserve(std::max(len, kMinChunkSize));
+    tail.append(str(), m_size - len, len);
+    m_chunks.clear();
+    m_chunks.push_back(std::move(tail));
+    m_size = len;
+}
+
+
+void BodyBuffer::spoolAbove(size_t limit, const std::string &dir) {
+    m_spoolLimit = limit;
+    m_spoolDir = dir;
+}
+
+
+void BodyBuffer::swap(BodyBuffer &other) {
+    std::swap(m_chunks, other.m_chunks);
+    std::swap(m_size, other.m_size);
+    std::swap(m_reserve, other.m_reserve);
+    std::swap(m_spoolLimit, other.m_spoolLimit);
+    std::swap(m_spoolDir, other.m_spoolDir);
+    std::swap(m_fd, other.m_fd);
+    std::swap(m_map, other.m_map);
+    std::swap(m_mapped, other.m_mapped);
+    std::swap(m_copy, other.m_copy);
+}
+
+
+/*
+ * Moves the chunks to a new file, that is unlinked right away so that
+ * nothing is left behind however the process goes. If that does not work
+ * out the buffer stays in memory, and does not try again.
+ */
+bool BodyBuffer::spool() {
+    std::string path(m_spoolDir.empty() ? "/tmp" : m_spoolDir);
+    path.append("/modsec-body-XXXXXX");
+
+    m_spoolLimit = 0;
+    int fd = mkstemp(&path[0]);
+    if (fd < 0) {
+        return false;
+    }
+    unlink(path.c_str());
+
+    for (const std::string &c : m_chunks) {
+        if (writeAll(fd, c.data(), c.size()) == false) {
+            close(fd);
+            return false;
+        }
+    }
+
+    m_fd = fd;
+    m_chunks.clear();
+    m_reserve = 0;
+    return true;
+}
+
+
+/* Brings the content of the file back into memory, as a single chunk. */
+void BodyBuffer::unspool() {
+    std::string all;
+    if (m_copy.size() == m_size) {
+        all.swap(m_copy);
+    } else {
+        readAll(m_fd, &all, m_size);
+    }
+
+    if (m_map != nullptr) {
+        munmap(m_map, m_mapped);
+        m_map = nullptr;
+        m_mapped = 0;
+    }
+    close(m_fd);
+    m_fd = -1;
+    std::string().swap(m_copy);
+
+    m_size = all.size();
+    m_chunks.clear();
+    if (all.empty() == false) {
+        m_chunks.push_back(std::move(all));
+    }
+}
+
+
+size_t BodyBuffer::chunkCount() const {
+    if (m_fd >= 0) {
+        return m_size > 0 ? 1 : 0;
+    }
+    return m_chunks.size();
+}
+
+
+const char *BodyBuffer::chunk(size_t i, size_t *len) const {
+    if (m_fd >= 0) {
+        *len = m_size;
+        return data();
+    }
+    *len = m_chunks[i].size();
+    return m_chunks[i].data();
+}
+
+
+const char *BodyBuffer::data() const {
+    if (m_fd < 0 || m_size == 0) {
+        return str().data();
+    }
+
+    if (m_mapped != m_size) {
+        if (m_map != nullptr) {
+            munmap(m_map, m_mapped);
+        }
+        m_map = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, m_fd, 0);
+        if (m_map == MAP_FAILED) {
+            m_map = nullptr;
+            m_mapped = 0;
+            return str().data();
+        }
+        m_mapped = m_size;
+    }
+
+    return static_cast<const char *>(m_map);
+}
+
+
+const std::string &BodyBuffer::str() const {
+    static const std::string empty;
+
+    if (m_fd >= 0) {
+        /* the buffer only grows, the same size is the same content */
+        if (m_copy.size() != m_size) {
+            if (m_mapped == m_size && m_map != nullptr) {
+                m_copy.assign(static_cast<const char *>(m_map), m_size);
+            } else {
+                readAll(m_fd, &m_copy, m_size);
+            }
+        }
+        return m_copy;
+    }
+
+    if (m_chunks.empty()) {
+        return empty;
+    }
+
+    if (m_chunks.size() > 1) {
+        std::string all;
+        all.reserve(m_size);
+        for (const std::string &c : m_chunks) {
+            all.append(c);
+        }
+        m_chunks.clear();
+        m_chunks.push_back(std::move(all));
+    }
+
+    return m_chunks.front();
+}
+
+
+}  // namespace modsecurity
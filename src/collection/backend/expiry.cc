@@ -0,0 +1,194 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/collection/backend/expiry.h"
+
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <pthread.h>
+
+#include "src/utils/system.h"
+
+
+namespace modsecurity {
+namespace collection {
+namespace backend {
+
+
+namespace {
+
+/* Time a sweeper is given on every round. */
+const uint64_t kBudgetNs = 5 * 1000 * 1000;
+
+/* Pause before the next round while some sweeper has a backlog. */
+const useconds_t kBacklogPauseUs = 100 * 1000;
+
+/* see Expiry::Scope */
+thread_local unsigned int threadTimeout = 0;
+
+}  // namespace
+
+
+/*
+ * Never destroyed: the thread may still be sweeping while the process
+ * exits.
+ */
+Expiry& Expiry::getInstance() {
+    static Expiry *instance = new Expiry();
+    return *instance;
+}
+
+
+Expiry::Expiry() : m_shortest(0), m_running(false) {
+    pthread_mutex_init(&m_lock, NULL);
+    pthread_atfork(prepareFork, parentFork, childFork);
+}
+
+
+Expiry::Scope::Scope(unsigned int seconds) : m_previous(threadTimeout) {
+    threadTimeout = seconds;
+}
+
+
+Expiry::Scope::~Scope() {
+    threadTimeout = m_previous;
+}
+
+
+void Expiry::addTimeout(unsigned int seconds) {
+    unsigned int shortest = m_shortest.load(std::memory_order_relaxed);
+
+    while (seconds > 0 && (shortest == 0 || seconds < shortest)
+        && m_shortest.compare_exchange_weak(shortest, seconds,
+            std::memory_order_relaxed) == false) {
+    }
+}
+
+
+unsigned int Expiry::timeout() const {
+    return threadTimeout;
+}
+
+
+int64_t Expiry::expiresAt() {
+    unsigned int timeout = threadTimeout;
+
+    if (timeout == 0) {
+        return 0;
+    }
+    if (m_running.load(std::memory_order_acquire) == false) {
+        start();
+    }
+    return static_cast<int64_t>(time(NULL)) + timeout;
+}
+
+
+void Expiry::add(Sweeper *sweeper) {
+    pthread_mutex_lock(&m_lock);
+    m_sweepers.push_back(sweeper);
+    pthread_mutex_unlock(&m_lock);
+}
+
+
+/* Once it returns the sweeper is not in use, nor will it be. */
+void Expiry::remove(Sweeper *sweeper) {
+    pthread_mutex_lock(&m_lock);
+    m_sweepers.erase(std::remove(m_sweepers.begin(), m_sweepers.end(),
+        sweeper), m_sweepers.end());
+    pthread_mutex_unlock(&m_lock);
+}
+
+
+/*
+ * Started on demand, from the process that writes: the servers that fork
+ * their workers load the rules in the parent, which never does.
+ */
+void Expiry::start() {
+    pthread_t thread;
+    pthread_attr_t attr;
+
+    pthread_mutex_lock(&m_lock);
+    if (m_running.load(std::memory_order_relaxed) == false) {
+        pthread_attr_init(&attr);
+        pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+        /* Not retried if it fails, it would be on every write. */
+        pthread_create(&thread, &attr, run, this);
+        pthread_attr_destroy(&attr);
+        m_running.store(true, std::memory_order_release);
+    }
+    pthread_mutex_unlock(&m_lock);
+}
+
+
+void *Expiry::run(void *data) {
+    Expiry *expiry = reinterpret_cast<Expiry *>(data);
+    bool backlog = false;
+
+    while (true) {
+        if (backlog) {
+            usleep(kBacklogPauseUs);
+        } else {
+            unsigned int shortest = expiry->m_shortest.load(
+                std::memory_order_relaxed);
+            sleep(std::min(std::max(shortest / 10, 1u), 60u));
+        }
+
+        backlog = false;
+
+        int64_t now = static_cast<int64_t>(time(NULL));
+        pthread_mutex_lock(&expiry->m_lock);
+        for (Sweeper *sweeper : expiry->m_sweepers) {
+            if (sweeper->sweep(now, utils::monotonic_ns() + kBudgetNs)
+                == false) {
+                backlog = true;
+            }
+        }
+        pthread_mutex_unlock(&expiry->m_lock);
+    }
+
+    return NULL;
+}
+
+
+/*
+ * No sweep is half way through when the process forks, so the child does
+ * not inherit a backend lock nobody is going to release. The thread itself
+ * is not inherited; the child starts its own on its first write.
+ */
+void Expiry::prepareFork() {
+    pthread_mutex_lock(&getInstance().m_lock);
+}
+
+
+void Expiry::parentFork() {
+    pthread_mutex_unlock(&getInstance().m_lock);
+}
+
+
+void Expiry::childFork() {
+    getInstance().m_running.store(false, std::memory_order_relaxed);
+    pthread_mutex_unlock(&getInstance().m_lock);
+}
+
+
+}  // namespace backend
+}  // namespace collection
+}  // namespace modsecurity
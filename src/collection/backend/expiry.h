@@ -0,0 +1,120 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#ifdef __cplusplus
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#endif
+
+#include <pthread.h>
+
+#ifndef SRC_COLLECTION_BACKEND_EXPIRY_H_
+#define SRC_COLLECTION_BACKEND_EXPIRY_H_
+
+#ifdef __cplusplus
+namespace modsecurity {
+namespace collection {
+namespace backend {
+
+
+/**
+ * Expiry of the entries of the persistent collections, as set by
+ * SecCollectionTimeout (seconds, 0 -the default- keeps them forever).
+ *
+ * The timeout is the one of the rules set the writing thread runs (see
+ * Scope): the backends stamp every write with expiresAt() and register a
+ * Sweeper; a background thread of the process, started by the first
+ * stamped write, drops the expired entries every tenth of the shortest
+ * timeout (between one second and a minute). Each sweep runs for a few
+ * milliseconds at most and picks up where the previous one stopped, so
+ * lookups are not held up for long.
+ *
+ * Entries are never checked on access: they may outlive their deadline by
+ * the sweeping interval.
+ *
+ */
+class Expiry {
+ public:
+    class Sweeper {
+     public:
+        virtual ~Sweeper() { }
+
+        /**
+         * Drops the entries expired at now (seconds since the epoch), until
+         * the monotonic clock reaches until (utils::monotonic_ns). Returns
+         * false if there is still some to go through.
+         */
+        virtual bool sweep(int64_t now, uint64_t until) = 0;
+    };
+
+    /**
+     * The timeout of the writes the thread makes while it is alive: the
+     * transactions hold one with the SecCollectionTimeout of their rules
+     * set while those run, and while the records they copied are written
+     * back.
+     */
+    class Scope {
+     public:
+        explicit Scope(unsigned int seconds);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+     private:
+        unsigned int m_previous;
+    };
+
+    static Expiry& getInstance();
+
+    /* A rules set was loaded with this timeout, to pace the sweeps by. */
+    void addTimeout(unsigned int seconds);
+    /* The timeout of the writes of the thread, see Scope. */
+    unsigned int timeout() const;
+
+    /* Deadline of an entry written now, or 0 if it does not expire. */
+    int64_t expiresAt();
+
+    void add(Sweeper *sweeper);
+    void remove(Sweeper *sweeper);
+
+ private:
+    Expiry();
+    ~Expiry() = delete;
+    Expiry(const Expiry&) = delete;
+    Expiry& operator=(const Expiry&) = delete;
+
+    void start();
+    static void *run(void *data);
+    static void prepareFork();
+    static void parentFork();
+    static void childFork();
+
+    /* the shortest timeout of the rules sets loaded so far, 0 for none */
+    std::atomic<unsigned int> m_shortest;
+    std::atomic<bool> m_running;
+    std::vector<Sweeper *> m_sweepers;
+    pthread_mutex_t m_lock;
+};
+
+
+}  // namespace backend
+}  // namespace collection
+}  // namespace modsecurity
+#endif
+
+
+#endif  // SRC_COLLECTION_BACKEND_EXPIRY_H_
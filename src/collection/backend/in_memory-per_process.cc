@@ -17,6 +17,7 @@
 #include "src/collection/backend/in_memory-per_process.h"
 
 #ifdef __cplusplus
+#include <algorithm>
 #include <string>
 #include <iostream>
 #include <unordered_map>
@@ -27,6 +28,7 @@
 #include <pthread.h>
 
 #include "modsecurity/variable_value.h"
+#include "src/utils/metrics.h"
 #include "src/utils/regex.h"
 #include "src/utils/string.h"
 
@@ -48,7 +50,7 @@ InMemoryPerProcess::~InMemoryPerProcess() {
 }
 
 void InMemoryPerProcess::store(std::string key, std::string value) {
-    pthread_mutex_lock(&m_lock);
+    Utils::Metrics::lock(&m_lock, Utils::Metrics::CollectionPerProcessLock);
     this->emplace(key, value);
     pthread_mutex_unlock(&m_lock);
 }
@@ -65,7 +67,7 @@ bool InMemoryPerProcess::storeOrUpdateFirst(const std::string &key,
 
 bool InMemoryPerProcess::updateFirst(const std::string &key,
     const std::string &value) {
-    pthread_mutex_lock(&m_lock);
+    Utils::Metrics::lock(&m_lock, Utils::Metrics::CollectionPerProcessLock);
     auto range = this->equal_range(key);
 
     for (auto it = range.first; it != range.second; ++it) {
@@ -78,8 +80,29 @@ bool InMemoryPerProcess::updateFirst(const std::string &key,
 }
 
 
+bool InMemoryPerProcess::atomicAdd(const std::string &key, int delta,
+    int *result) {
+    int value = delta;
+
+    Utils::Metrics::lock(&m_lock, Utils::Metrics::CollectionPerProcessLock);
+    auto it = this->find(key);
+    if (it != this->end()) {
+        value = toInt(it->second) + delta;
+        it->second = std::to_string(value);
+    } else {
+        this->emplace(key, std::to_string(value));
+    }
+    pthread_mutex_unlock(&m_lock);
+
+    if (result != nullptr) {
+        *result = value;
+    }
+    return true;
+}
+
+
 void InMemoryPerProcess::del(const std::string& key) {
-    pthread_mutex_lock(&m_lock);
+    Utils::Metrics::lock(&m_lock, Utils::Metrics::CollectionPerProcessLock);
     this->erase(key);
     pthread_mutex_unlock(&m_lock);
 }
@@ -97,6 +120,7 @@ void InMemoryPerProcess::resolveSingleMatch(const std::string& var,
 
 void InMemoryPerProcess::resolveMultiMatches(const std::string& var,
     std::vector<const VariableValue *> *l, variables::KeyExclusions &ke) {
+    size_t first = l->size();
     size_t keySize = var.size();
     l->reserve(15);
 
@@ -105,7 +129,7 @@ void InMemoryPerProcess::resolveMultiMatches(const std::string& var,
             if (ke.toOmit(i.first)) {
                 continue;
             }
-            l->insert(l->begin(), new VariableValue(&m_name, &i.first,
+            l->push_back(new VariableValue(&m_name, &i.first,
                 &i.second));
         }
     } else {
@@ -114,15 +138,17 @@ void InMemoryPerProcess::resolveMultiMatches(const std::string& var,
             if (ke.toOmit(var)) {
                 continue;
             }
-            l->insert(l->begin(), new VariableValue(&m_name, &var,
+            l->push_back(new VariableValue(&m_name, &var,
                 &it->second));
         }
     }
+    std::reverse(l->begin() + first, l->end());
 }
 
 
 void InMemoryPerProcess::resolveRegularExpression(const std::string& var,
     std::vector<const VariableValue *> *l, variables::KeyExclusions &ke) {
+    size_t first = l->size();
 
     //if (var.find(":") == std::string::npos) {
     //    return;
@@ -155,8 +181,9 @@ void InMemoryPerProcess::resolveRegularExpression(const std::string& var,
         if (ke.toOmit(x.first)) {
             continue;
         }
-        l->insert(l->begin(), new VariableValue(&m_name, &x.first, &x.second));
+        l->push_back(new VariableValue(&m_name, &x.first, &x.second));
     }
+    std::reverse(l->begin() + first, l->end());
 }
 
 
@@ -25,6 +25,7 @@
 #endif
 
 
+#include "modsecurity/anchored_set_variable.h"
 #include "modsecurity/variable_value.h"
 #include "modsecurity/collection/collection.h"
 #include "src/variables/variable.h"
@@ -37,35 +38,9 @@ namespace modsecurity {
 namespace collection {
 namespace backend {
 
-/*
- * FIXME:
- *
- * This was an example grabbed from:
- * http://stackoverflow.com/questions/8627698/case-insensitive-stl-containers-e-g-stdunordered-set
- *
- * We have to have a better hash function, maybe based on the std::hash.
- *
- */
-struct MyEqual {
-    bool operator()(const std::string& Left, const std::string& Right) const {
-        return Left.size() == Right.size()
-             && std::equal(Left.begin(), Left.end(), Right.begin(),
-            [](char a, char b) {
-            return tolower(a) == tolower(b);
-        });
-    }
-};
-
-struct MyHash{
-    size_t operator()(const std::string& Keyval) const {
-        // You might need a better hash function than this
-        size_t h = 0;
-        std::for_each(Keyval.begin(), Keyval.end(), [&](char c) {
-            h += tolower(c);
-        });
-        return h;
-    }
-};
+/* Case insensitive, as the keys of the anchored collections. */
+typedef modsecurity::MyEqual MyEqual;
+typedef modsecurity::MyHash MyHash;
 
 class InMemoryPerProcess :
     public std::unordered_multimap<std::string, std::string,
@@ -84,6 +59,9 @@ class InMemoryPerProcess :
 
     void del(const std::string& key) override;
 
+    bool atomicAdd(const std::string &key, int delta,
+        int *result) override;
+
     std::unique_ptr<std::string> resolveFirst(const std::string& var) override;
 
     void resolveSingleMatch(const std::string& var,
@@ -0,0 +1,384 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/collection/backend/in_memory-per_transaction.h"
+
+#ifdef __cplusplus
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <memory>
+#endif
+
+#include "modsecurity/variable_value.h"
+#include "src/utils/regex.h"
+
+
+namespace modsecurity {
+namespace collection {
+namespace backend {
+
+
+const size_t InMemoryPerTransaction::kSlots;
+const size_t InMemoryPerTransaction::kInitialEntries;
+const uint32_t InMemoryPerTransaction::kEmpty;
+const uint32_t InMemoryPerTransaction::kDeleted;
+
+
+InMemoryPerTransaction::InMemoryPerTransaction(const std::string &name) :
+    Collection(name),
+    m_slotsUsed(0),
+    m_dead(0) {
+    m_entries.reserve(kInitialEntries);
+    m_index.assign(kInitialEntries * 2, kEmpty);
+}
+
+
+/* "0" to "99", as written by the operators; "01" or "007" are not. */
+size_t InMemoryPerTransaction::slotOf(const std::string &key) {
+    if (key.size() == 1 && key[0] >= '0' && key[0] <= '9') {
+        return key[0] - '0';
+    }
+    if (key.size() == 2 && key[0] >= '1' && key[0] <= '9'
+        && key[1] >= '0' && key[1] <= '9') {
+        return (key[0] - '0') * 10 + (key[1] - '0');
+    }
+    return kSlots;
+}
+
+
+const std::string &InMemoryPerTransaction::slotKey(size_t i) {
+    static const std::vector<std::string> keys = [] {
+        std::vector<std::string> k;
+        for (size_t j = 0; j < kSlots; j++) {
+            k.push_back(std::to_string(j));
+        }
+        return k;
+    }();
+    return keys[i];
+}
+
+
+uint32_t InMemoryPerTransaction::findFirst(const std::string &key,
+    size_t hash) const {
+    size_t mask = m_index.size() - 1;
+    MyEqual equal;
+
+    for (size_t i = hash & mask; m_index[i] != kEmpty; i = (i + 1) & mask) {
+        uint32_t e = m_index[i];
+        if (e != kDeleted && m_entries[e].m_hash == hash
+            && equal(m_entries[e].m_key, key)) {
+            return e;
+        }
+    }
+    return kEmpty;
+}
+
+
+void InMemoryPerTransaction::insert(std::string key, std::string value,
+    size_t hash) {
+    if ((m_entries.size() + 1) * 2 > m_index.size()) {
+        size_t buckets = m_index.size();
+        /* Only grow when dropping the deleted entries is not enough. */
+        while ((m_entries.size() - m_dead + 1) * 4 > buckets) {
+            buckets *= 2;
+        }
+        rebuild(buckets);
+    }
+
+    size_t mask = m_index.size() - 1;
+    size_t i = hash & mask;
+    while (m_index[i] != kEmpty) {
+        i = (i + 1) & mask;
+    }
+    m_index[i] = static_cast<uint32_t>(m_entries.size());
+    m_entries.push_back({std::move(key), Value(std::move(value)), hash,
+        true});
+}
+
+
+void InMemoryPerTransaction::rebuild(size_t buckets) {
+    std::vector<Entry> entries;
+    entries.reserve(std::max(m_entries.capacity(), buckets / 2));
+    for (auto &e : m_entries) {
+        if (e.m_live) {
+            entries.push_back(std::move(e));
+        }
+    }
+    m_entries.swap(entries);
+    m_dead = 0;
+
+    m_index.assign(buckets, kEmpty);
+    size_t mask = buckets - 1;
+    for (size_t e = 0; e < m_entries.size(); e++) {
+        size_t i = m_entries[e].m_hash & mask;
+        while (m_index[i] != kEmpty) {
+            i = (i + 1) & mask;
+        }
+        m_index[i] = static_cast<uint32_t>(e);
+    }
+}
+
+
+void InMemoryPerTransaction::clear() {
+    for (size_t i = 0; i < m_slotsUsed; i++) {
+        m_slots[i].m_set = false;
+        m_slots[i].m_value.clear();
+    }
+    m_slotsUsed = 0;
+    m_entries.clear();
+    std::fill(m_index.begin(), m_index.end(), kEmpty);
+    m_dead = 0;
+}
+
+
+void InMemoryPerTransaction::dump(
+    std::vector<std::pair<std::string, std::string>> *out) const {
+    for (size_t i = 0; i < m_slotsUsed; i++) {
+        if (m_slots[i].m_set) {
+            out->emplace_back(slotKey(i), m_slots[i].m_value.str());
+        }
+    }
+    for (const auto &e : m_entries) {
+        if (e.m_live) {
+            out->emplace_back(e.m_key, e.m_value.str());
+        }
+    }
+}
+
+
+void InMemoryPerTransaction::store(std::string key, std::string value) {
+    size_t i = slotOf(key);
+    if (i < kSlots && !m_slots[i].m_set) {
+        m_slots[i].m_value = std::move(value);
+        m_slots[i].m_set = true;
+        m_slotsUsed = std::max(m_slotsUsed, i + 1);
+        return;
+    }
+    size_t hash = MyHash()(key);
+    insert(std::move(key), std::move(value), hash);
+}
+
+
+bool InMemoryPerTransaction::storeOrUpdateFirst(const std::string &key,
+    const std::string &value) {
+    size_t i = slotOf(key);
+    if (i < kSlots) {
+        m_slots[i].m_value = value;
+        m_slots[i].m_set = true;
+        m_slotsUsed = std::max(m_slotsUsed, i + 1);
+        return true;
+    }
+
+    size_t hash = MyHash()(key);
+    uint32_t e = findFirst(key, hash);
+    if (e != kEmpty) {
+        m_entries[e].m_value = value;
+    } else {
+        insert(key, value, hash);
+    }
+    return true;
+}
+
+
+bool InMemoryPerTransaction::updateFirst(const std::string &key,
+    const std::string &value) {
+    size_t i = slotOf(key);
+    if (i < kSlots) {
+        if (!m_slots[i].m_set) {
+            return false;
+        }
+        m_slots[i].m_value = value;
+        return true;
+    }
+
+    uint32_t e = findFirst(key, MyHash()(key));
+    if (e == kEmpty) {
+        return false;
+    }
+    m_entries[e].m_value = value;
+    return true;
+}
+
+
+bool InMemoryPerTransaction::atomicAdd(const std::string &key, int delta,
+    int *result) {
+    size_t i = slotOf(key);
+    int value = delta;
+
+    if (i < kSlots) {
+        if (m_slots[i].m_set) {
+            value = m_slots[i].m_value.toInt() + delta;
+        }
+        m_slots[i].m_value.setInt(value);
+        m_slots[i].m_set = true;
+        m_slotsUsed = std::max(m_slotsUsed, i + 1);
+    } else {
+        size_t hash = MyHash()(key);
+        uint32_t e = findFirst(key, hash);
+        if (e == kEmpty) {
+            insert(key, std::string(), hash);
+            e = static_cast<uint32_t>(m_entries.size() - 1);
+        } else {
+            value = m_entries[e].m_value.toInt() + delta;
+        }
+        m_entries[e].m_value.setInt(value);
+    }
+
+    if (result != nullptr) {
+        *result = value;
+    }
+    return true;
+}
+
+
+void InMemoryPerTransaction::del(const std::string& key) {
+    size_t i = slotOf(key);
+    if (i < kSlots) {
+        m_slots[i].m_set = false;
+        m_slots[i].m_value.clear();
+    }
+
+    size_t hash = MyHash()(key);
+    size_t mask = m_index.size() - 1;
+    MyEqual equal;
+    for (size_t j = hash & mask; m_index[j] != kEmpty; j = (j + 1) & mask) {
+        uint32_t e = m_index[j];
+        if (e != kDeleted && m_entries[e].m_hash == hash
+            && equal(m_entries[e].m_key, key)) {
+            m_entries[e].m_live = false;
+            m_entries[e].m_key.clear();
+            m_entries[e].m_value.clear();
+            m_index[j] = kDeleted;
+            m_dead++;
+        }
+    }
+}
+
+
+std::unique_ptr<std::string> InMemoryPerTransaction::resolveFirst(
+    const std::string& var) {
+    size_t i = slotOf(var);
+    if (i < kSlots) {
+        if (!m_slots[i].m_set) {
+            return nullptr;
+        }
+        return std::unique_ptr<std::string>(
+            new std::string(m_slots[i].m_value.str()));
+    }
+
+    uint32_t e = findFirst(var, MyHash()(var));
+    if (e == kEmpty) {
+        return nullptr;
+    }
+    return std::unique_ptr<std::string>(
+        new std::string(m_entries[e].m_value.str()));
+}
+
+
+void InMemoryPerTransaction::resolveSingleMatch(const std::string& var,
+    std::vector<const VariableValue *> *l) {
+    size_t i = slotOf(var);
+    if (i < kSlots && m_slots[i].m_set) {
+        l->push_back(new VariableValue(&m_name, &slotKey(i),
+            &m_slots[i].m_value.str()));
+    }
+
+    size_t hash = MyHash()(var);
+    size_t mask = m_index.size() - 1;
+    MyEqual equal;
+    for (size_t j = hash & mask; m_index[j] != kEmpty; j = (j + 1) & mask) {
+        uint32_t e = m_index[j];
+        if (e != kDeleted && m_entries[e].m_hash == hash
+            && equal(m_entries[e].m_key, var)) {
+            l->push_back(new VariableValue(&m_name, &m_entries[e].m_key,
+                &m_entries[e].m_value.str()));
+        }
+    }
+}
+
+
+void InMemoryPerTransaction::resolveMultiMatches(const std::string& var,
+    std::vector<const VariableValue *> *l, variables::KeyExclusions &ke) {
+    size_t first = l->size();
+
+    if (var.empty()) {
+        for (size_t i = 0; i < m_slotsUsed; i++) {
+            if (!m_slots[i].m_set || ke.toOmit(slotKey(i))) {
+                continue;
+            }
+            l->push_back(new VariableValue(&m_name, &slotKey(i),
+                &m_slots[i].m_value.str()));
+        }
+        for (auto &e : m_entries) {
+            if (!e.m_live || ke.toOmit(e.m_key)) {
+                continue;
+            }
+            l->push_back(new VariableValue(&m_name, &e.m_key,
+                &e.m_value.str()));
+        }
+    } else {
+        if (ke.toOmit(var)) {
+            return;
+        }
+        size_t i = slotOf(var);
+        if (i < kSlots && m_slots[i].m_set) {
+            l->push_back(new VariableValue(&m_name, &var,
+                &m_slots[i].m_value.str()));
+        }
+        size_t hash = MyHash()(var);
+        size_t mask = m_index.size() - 1;
+        MyEqual equal;
+        for (size_t j = hash & mask; m_index[j] != kEmpty;
+            j = (j + 1) & mask) {
+            uint32_t e = m_index[j];
+            if (e != kDeleted && m_entries[e].m_hash == hash
+                && equal(m_entries[e].m_key, var)) {
+                l->push_back(new VariableValue(&m_name, &var,
+                    &m_entries[e].m_value.str()));
+            }
+        }
+    }
+    std::reverse(l->begin() + first, l->end());
+}
+
+
+void InMemoryPerTransaction::resolveRegularExpression(const std::string& var,
+    std::vector<const VariableValue *> *l, variables::KeyExclusions &ke) {
+    size_t first = l->size();
+    Utils::Regex r(var, true);
+
+    for (size_t i = 0; i < m_slotsUsed; i++) {
+        const std::string &key = slotKey(i);
+        if (!m_slots[i].m_set || r.search(key) <= 0 || ke.toOmit(key)) {
+            continue;
+        }
+        l->push_back(new VariableValue(&m_name, &key,
+            &m_slots[i].m_value.str()));
+    }
+    for (const auto &e : m_entries) {
+        if (!e.m_live || r.search(e.m_key) <= 0 || ke.toOmit(e.m_key)) {
+            continue;
+        }
+        l->push_back(new VariableValue(&m_name, &e.m_key,
+            &e.m_value.str()));
+    }
+    std::reverse(l->begin() + first, l->end());
+}
+
+
+}  // namespace backend
+}  // namespace collection
+}  // namespace modsecurity
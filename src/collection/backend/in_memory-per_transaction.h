@@ -0,0 +1,202 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#ifdef __cplusplus
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <utility>
+#endif
+
+
+#include "modsecurity/anchored_set_variable.h"
+#include "modsecurity/variable_value.h"
+#include "modsecurity/collection/collection.h"
+#include "src/variables/variable.h"
+
+#ifndef SRC_COLLECTION_BACKEND_IN_MEMORY_PER_TRANSACTION_H_
+#define SRC_COLLECTION_BACKEND_IN_MEMORY_PER_TRANSACTION_H_
+
+#ifdef __cplusplus
+namespace modsecurity {
+namespace collection {
+namespace backend {
+
+
+/**
+ * In memory collection owned by a single transaction (TX).
+ *
+ * Nobody else ever sees it, so there is no locking. The keys the operators
+ * keep writing their captures to, "0" to "99", live in a fixed array of
+ * slots instead of the map: setting TX:0 on every match is then a string
+ * assignment, with no hashing or allocation of a node.
+ *
+ */
+class InMemoryPerTransaction : public Collection {
+ public:
+    static const size_t kSlots = 100;
+
+    explicit InMemoryPerTransaction(const std::string &name);
+
+    InMemoryPerTransaction(const InMemoryPerTransaction&) = delete;
+    InMemoryPerTransaction& operator=(
+        const InMemoryPerTransaction&) = delete;
+
+    void store(std::string key, std::string value) override;
+
+    bool storeOrUpdateFirst(const std::string &key,
+        const std::string &value) override;
+
+    bool updateFirst(const std::string &key,
+        const std::string &value) override;
+
+    void del(const std::string& key) override;
+
+    bool atomicAdd(const std::string &key, int delta,
+        int *result) override;
+
+    std::unique_ptr<std::string> resolveFirst(const std::string& var) override;
+
+    void resolveSingleMatch(const std::string& var,
+        std::vector<const VariableValue *> *l) override;
+    void resolveMultiMatches(const std::string& var,
+        std::vector<const VariableValue *> *l,
+        variables::KeyExclusions &ke) override;
+    void resolveRegularExpression(const std::string& var,
+        std::vector<const VariableValue *> *l,
+        variables::KeyExclusions &ke) override;
+
+    void clear();
+    /*
+     * Every key and value, in an order that store()ing them again into
+     * an empty collection gives the same collection.
+     */
+    void dump(std::vector<std::pair<std::string, std::string>> *out) const;
+
+ private:
+    /*
+     * A value atomicAdd() keeps as a number: the string is only written
+     * out again once something reads it, and the anomaly scores CRS
+     * keeps adding to go from one sum to the next without it.
+     */
+    class Value {
+     public:
+        Value() : m_number(0), m_hasNumber(false), m_stale(false) { }
+        explicit Value(std::string value)
+            : m_string(std::move(value)),
+            m_number(0),
+            m_hasNumber(false),
+            m_stale(false) { }
+
+        Value &operator=(const std::string &value) {
+            m_string = value;
+            m_hasNumber = false;
+            m_stale = false;
+            return *this;
+        }
+
+        Value &operator=(std::string &&value) {
+            m_string = std::move(value);
+            m_hasNumber = false;
+            m_stale = false;
+            return *this;
+        }
+
+        const std::string &str() const {
+            if (m_stale) {
+                m_string = std::to_string(m_number);
+                m_stale = false;
+            }
+            return m_string;
+        }
+
+        int toInt() {
+            if (m_hasNumber == false) {
+                m_number = Collection::toInt(m_string);
+                m_hasNumber = true;
+            }
+            return m_number;
+        }
+
+        void setInt(int number) {
+            m_number = number;
+            m_hasNumber = true;
+            m_stale = true;
+        }
+
+        void clear() {
+            m_string.clear();
+            m_hasNumber = false;
+            m_stale = false;
+        }
+
+     private:
+        mutable std::string m_string;
+        int m_number;
+        bool m_hasNumber;
+        mutable bool m_stale;
+    };
+
+    struct Slot {
+        Slot() : m_set(false) { }
+        bool m_set;
+        Value m_value;
+    };
+
+    /* Index of the slot holding key, or kSlots if it has none. */
+    static size_t slotOf(const std::string &key);
+    static const std::string &slotKey(size_t i);
+
+    Slot m_slots[kSlots];
+    /* Highest slot ever set since the last clear(), plus one. */
+    size_t m_slotsUsed;
+    /*
+     * Everything else, plus the values stored on top of an already set
+     * slot, as TX allows for more than one value per key. It is a flat,
+     * open addressed table: the entries sit in a vector in the order they
+     * were stored and m_index, a power of two in size and at most half
+     * full, points into it. Deleted entries are only dropped when the
+     * table is rebuilt, so neither clear() nor del() give memory back.
+     */
+    struct Entry {
+        std::string m_key;
+        Value m_value;
+        size_t m_hash;
+        bool m_live;
+    };
+
+    static const size_t kInitialEntries = 64;
+    static const uint32_t kEmpty = UINT32_MAX;
+    static const uint32_t kDeleted = UINT32_MAX - 1;
+
+    /* Index in m_entries of the first live entry of key, or kEmpty. */
+    uint32_t findFirst(const std::string &key, size_t hash) const;
+    void insert(std::string key, std::string value, size_t hash);
+    void rebuild(size_t buckets);
+
+    std::vector<Entry> m_entries;
+    std::vector<uint32_t> m_index;
+    size_t m_dead;
+};
+
+
+}  // namespace backend
+}  // namespace collection
+}  // namespace modsecurity
+#endif
+
+
+#endif  // SRC_COLLECTION_BACKEND_IN_MEMORY_PER_TRANSACTION_H_
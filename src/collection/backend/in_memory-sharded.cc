@@ -0,0 +1,635 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/collection/backend/in_memory-sharded.h"
+
+#ifdef __cplusplus
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <memory>
+#include <vector>
+#endif
+
+#include <pthread.h>
+
+#include "modsecurity/variable_value.h"
+#include "src/collection/backend/expiry.h"
+#include "src/utils/metrics.h"
+#include "src/utils/regex.h"
+#include "src/utils/system.h"
+
+
+namespace modsecurity {
+namespace collection {
+namespace backend {
+
+
+/* the shard locks, accounting the time spent waiting for them */
+static void readLock(pthread_rwlock_t *lock) {
+    Utils::Metrics::readLock(lock, Utils::Metrics::CollectionShardLock);
+}
+
+
+static void writeLock(pthread_rwlock_t *lock) {
+    Utils::Metrics::writeLock(lock, Utils::Metrics::CollectionShardLock);
+}
+
+
+InMemorySharded::InMemorySharded(const std::string &name) :
+    Collection(name), m_sweepShard(0), m_sweepRecords(false),
+    m_sweepBucket(0) {
+    for (Shard &s : m_shards) {
+        s.m_records.reserve(64);
+        pthread_rwlock_init(&s.m_lock, NULL);
+    }
+    Expiry::getInstance().add(this);
+}
+
+
+InMemorySharded::~InMemorySharded() {
+    Expiry::getInstance().remove(this);
+    for (Shard &s : m_shards) {
+        s.m_records.clear();
+        pthread_rwlock_destroy(&s.m_lock);
+    }
+}
+
+
+/*
+ * The low bits of the hash pick the bucket inside of the shard map, the
+ * shard is taken from the upper ones so both stay evenly spread.
+ */
+InMemorySharded::Shard &InMemorySharded::shardOf(const std::string &key) {
+    size_t h = MyHash()(key);
+    return m_shards[(h >> 24) % kShards];
+}
+
+
+/* The name the keys of a record are given to the rules with. */
+static std::string keyOf(const std::string &compartment,
+    const std::string &compartment2, const std::string &key) {
+    std::string k;
+    k.reserve(compartment.size() + compartment2.size() + key.size() + 4);
+    k.append(compartment).append("::").append(compartment2).append("::");
+    k.append(key);
+    return k;
+}
+
+
+InMemorySharded::Record *InMemorySharded::findRecord(Shard *s,
+    const std::string &compartment, const std::string &compartment2) {
+    auto records = s->m_records.find(compartment);
+    if (records == s->m_records.end()) {
+        return nullptr;
+    }
+    auto record = records->second.find(compartment2);
+    if (record == records->second.end()) {
+        return nullptr;
+    }
+    return &record->second;
+}
+
+
+/* So the records of the clients that went away do not pile up. */
+void InMemorySharded::dropIfEmpty(Shard *s, const std::string &compartment,
+    const std::string &compartment2) {
+    auto records = s->m_records.find(compartment);
+    if (records == s->m_records.end()) {
+        return;
+    }
+    auto record = records->second.find(compartment2);
+    if (record == records->second.end()
+        || record->second.m_fields.empty() == false) {
+        return;
+    }
+    records->second.erase(record);
+    if (records->second.empty()) {
+        s->m_records.erase(records);
+    }
+}
+
+
+void InMemorySharded::storeField(Record *r, const std::string &key,
+    const std::string &value, int64_t expires) {
+    auto it = r->m_fields.find(key);
+    if (it != r->m_fields.end()) {
+        it->second = value;
+    } else {
+        r->m_fields.emplace(key, value);
+    }
+    if (expires != 0) {
+        r->m_expires[key] = expires;
+    }
+}
+
+
+bool InMemorySharded::updateField(Record *r, const std::string &key,
+    const std::string &value, int64_t expires) {
+    auto it = r->m_fields.find(key);
+    if (it == r->m_fields.end()) {
+        return false;
+    }
+    it->second = value;
+    if (expires != 0) {
+        r->m_expires[key] = expires;
+    }
+    return true;
+}
+
+
+int InMemorySharded::addToField(Record *r, const std::string &key,
+    int delta, int64_t expires) {
+    int value = delta;
+
+    auto it = r->m_fields.find(key);
+    if (it != r->m_fields.end()) {
+        value = toInt(it->second) + delta;
+        it->second = std::to_string(value);
+    } else {
+        r->m_fields.emplace(key, std::to_string(value));
+    }
+    if (expires != 0) {
+        r->m_expires[key] = expires;
+    }
+    return value;
+}
+
+
+uint64_t InMemorySharded::expireFields(Record *r, int64_t now) {
+    uint64_t expired = 0;
+
+    for (auto it = r->m_expires.begin(); it != r->m_expires.end();) {
+        if (it->second > now) {
+            ++it;
+            continue;
+        }
+        expired += r->m_fields.erase(it->first);
+        it = r->m_expires.erase(it);
+    }
+    return expired;
+}
+
+
+void InMemorySharded::store(std::string key, std::string value) {
+    Shard &s = shardOf(key);
+    int64_t expires = Expiry::getInstance().expiresAt();
+
+    writeLock(&s.m_lock);
+    if (expires != 0) {
+        s.m_flat.m_expires[key] = expires;
+    }
+    s.m_flat.m_fields.emplace(std::move(key), std::move(value));
+    pthread_rwlock_unlock(&s.m_lock);
+}
+
+
+bool InMemorySharded::storeOrUpdateFirst(const std::string &key,
+    const std::string &value) {
+    Shard &s = shardOf(key);
+    int64_t expires = Expiry::getInstance().expiresAt();
+
+    writeLock(&s.m_lock);
+    storeField(&s.m_flat, key, value, expires);
+    pthread_rwlock_unlock(&s.m_lock);
+
+    return true;
+}
+
+
+bool InMemorySharded::updateFirst(const std::string &key,
+    const std::string &value) {
+    Shard &s = shardOf(key);
+    int64_t expires = Expiry::getInstance().expiresAt();
+
+    writeLock(&s.m_lock);
+    bool updated = updateField(&s.m_flat, key, value, expires);
+    pthread_rwlock_unlock(&s.m_lock);
+
+    return updated;
+}
+
+
+bool InMemorySharded::atomicAdd(const std::string &key, int delta,
+    int *result) {
+    Shard &s = shardOf(key);
+    int64_t expires = Expiry::getInstance().expiresAt();
+
+    writeLock(&s.m_lock);
+    int value = addToField(&s.m_flat, key, delta, expires);
+    pthread_rwlock_unlock(&s.m_lock);
+
+    if (result != nullptr) {
+        *result = value;
+    }
+    return true;
+}
+
+
+void InMemorySharded::del(const std::string& key) {
+    Shard &s = shardOf(key);
+
+    writeLock(&s.m_lock);
+    s.m_flat.m_fields.erase(key);
+    s.m_flat.m_expires.erase(key);
+    pthread_rwlock_unlock(&s.m_lock);
+}
+
+
+std::unique_ptr<std::string> InMemorySharded::resolveFirst(
+    const std::string& var) {
+    Shard &s = shardOf(var);
+    std::unique_ptr<std::string> ret;
+
+    readLock(&s.m_lock);
+    auto it = s.m_flat.m_fields.find(var);
+    if (it != s.m_flat.m_fields.end()) {
+        ret.reset(new std::string(it->second));
+    }
+    pthread_rwlock_unlock(&s.m_lock);
+
+    return ret;
+}
+
+
+void InMemorySharded::resolveSingleMatch(const std::string& var,
+    std::vector<const VariableValue *> *l) {
+    Shard &s = shardOf(var);
+
+    readLock(&s.m_lock);
+    auto range = s.m_flat.m_fields.equal_range(var);
+    for (auto it = range.first; it != range.second; ++it) {
+        l->push_back(new VariableValue(&m_name, &it->first, &it->second));
+    }
+    pthread_rwlock_unlock(&s.m_lock);
+}
+
+
+void InMemorySharded::resolveMultiMatches(const std::string& var,
+    std::vector<const VariableValue *> *l, variables::KeyExclusions &ke) {
+    size_t first = l->size();
+    l->reserve(15);
+
+    if (var.empty() == false) {
+        if (ke.toOmit(var)) {
+            return;
+        }
+        Shard &s = shardOf(var);
+        readLock(&s.m_lock);
+        auto range = s.m_flat.m_fields.equal_range(var);
+        for (auto it = range.first; it != range.second; ++it) {
+            l->push_back(new VariableValue(&m_name, &var,
+                &it->second));
+        }
+        pthread_rwlock_unlock(&s.m_lock);
+        std::reverse(l->begin() + first, l->end());
+        return;
+    }
+
+    for (Shard &s : m_shards) {
+        readLock(&s.m_lock);
+        for (const auto &i : s.m_flat.m_fields) {
+            if (ke.toOmit(i.first)) {
+                continue;
+            }
+            l->push_back(new VariableValue(&m_name, &i.first,
+                &i.second));
+        }
+        pthread_rwlock_unlock(&s.m_lock);
+    }
+    std::reverse(l->begin() + first, l->end());
+}
+
+
+void InMemorySharded::resolveRegularExpression(const std::string& var,
+    std::vector<const VariableValue *> *l, variables::KeyExclusions &ke) {
+    size_t first = l->size();
+    Utils::Regex r(var, true);
+
+    for (Shard &s : m_shards) {
+        readLock(&s.m_lock);
+        for (const auto &x : s.m_flat.m_fields) {
+            if (Utils::regex_search(x.first, r) <= 0) {
+                continue;
+            }
+            if (ke.toOmit(x.first)) {
+                continue;
+            }
+            l->push_back(new VariableValue(&m_name, &x.first,
+                &x.second));
+        }
+        pthread_rwlock_unlock(&s.m_lock);
+    }
+    std::reverse(l->begin() + first, l->end());
+}
+
+
+void InMemorySharded::store(std::string key, const std::string &compartment,
+    const std::string &compartment2, std::string value) {
+    Shard &s = shardOf(compartment);
+    int64_t expires = Expiry::getInstance().expiresAt();
+
+    writeLock(&s.m_lock);
+    Record &r = s.m_records[compartment][compartment2];
+    if (expires != 0) {
+        r.m_expires[key] = expires;
+    }
+    r.m_fields.emplace(std::move(key), std::move(value));
+    pthread_rwlock_unlock(&s.m_lock);
+}
+
+
+bool InMemorySharded::storeOrUpdateFirst(const std::string &key,
+    const std::string &compartment, const std::string &compartment2,
+    const std::string &value) {
+    Shard &s = shardOf(compartment);
+    int64_t expires = Expiry::getInstance().expiresAt();
+
+    writeLock(&s.m_lock);
+    storeField(&s.m_records[compartment][compartment2], key, value,
+        expires);
+    pthread_rwlock_unlock(&s.m_lock);
+
+    return true;
+}
+
+
+bool InMemorySharded::updateFirst(const std::string &key,
+    const std::string &compartment, const std::string &compartment2,
+    const std::string &value) {
+    Shard &s = shardOf(compartment);
+    int64_t expires = Expiry::getInstance().expiresAt();
+    bool updated = false;
+
+    writeLock(&s.m_lock);
+    Record *r = findRecord(&s, compartment, compartment2);
+    if (r != nullptr) {
+        updated = updateField(r, key, value, expires);
+    }
+    pthread_rwlock_unlock(&s.m_lock);
+
+    return updated;
+}
+
+
+bool InMemorySharded::atomicAdd(const std::string &key,
+    const std::string &compartment, const std::string &compartment2,
+    int delta, int *result) {
+    Shard &s = shardOf(compartment);
+    int64_t expires = Expiry::getInstance().expiresAt();
+
+    writeLock(&s.m_lock);
+    int value = addToField(&s.m_records[compartment][compartment2], key,
+        delta, expires);
+    pthread_rwlock_unlock(&s.m_lock);
+
+    if (result != nullptr) {
+        *result = value;
+    }
+    return true;
+}
+
+
+void InMemorySharded::del(const std::string& key,
+    const std::string &compartment, const std::string &compartment2) {
+    Shard &s = shardOf(compartment);
+
+    writeLock(&s.m_lock);
+    Record *r = findRecord(&s, compartment, compartment2);
+    if (r != nullptr) {
+        r->m_fields.erase(key);
+        r->m_expires.erase(key);
+        dropIfEmpty(&s, compartment, compartment2);
+    }
+    pthread_rwlock_unlock(&s.m_lock);
+}
+
+
+std::unique_ptr<std::string> InMemorySharded::resolveFirst(
+    const std::string& var, const std::string &compartment,
+    const std::string &compartment2) {
+    Shard &s = shardOf(compartment);
+    std::unique_ptr<std::string> ret;
+
+    readLock(&s.m_lock);
+    Record *r = findRecord(&s, compartment, compartment2);
+    if (r != nullptr) {
+        auto it = r->m_fields.find(var);
+        if (it != r->m_fields.end()) {
+            ret.reset(new std::string(it->second));
+        }
+    }
+    pthread_rwlock_unlock(&s.m_lock);
+
+    return ret;
+}
+
+
+void InMemorySharded::resolveSingleMatch(const std::string& var,
+    const std::string &compartment, const std::string &compartment2,
+    std::vector<const VariableValue *> *l) {
+    Shard &s = shardOf(compartment);
+
+    readLock(&s.m_lock);
+    Record *r = findRecord(&s, compartment, compartment2);
+    if (r != nullptr) {
+        auto range = r->m_fields.equal_range(var);
+        for (auto it = range.first; it != range.second; ++it) {
+            std::string key(keyOf(compartment, compartment2, it->first));
+            l->push_back(new VariableValue(&m_name, &key, &it->second));
+        }
+    }
+    pthread_rwlock_unlock(&s.m_lock);
+}
+
+
+/*
+ * A bare collection target (var empty) goes through the one record; the
+ * values are given with the whole name of their key, as the backends that
+ * have the keys flat do.
+ */
+void InMemorySharded::resolveMultiMatches(const std::string& var,
+    const std::string &compartment, const std::string &compartment2,
+    std::vector<const VariableValue *> *l, variables::KeyExclusions &ke) {
+    Shard &s = shardOf(compartment);
+    size_t first = l->size();
+
+    readLock(&s.m_lock);
+    Record *r = findRecord(&s, compartment, compartment2);
+    if (r == nullptr) {
+        pthread_rwlock_unlock(&s.m_lock);
+        return;
+    }
+
+    if (var.empty() == false) {
+        auto range = r->m_fields.equal_range(var);
+        if (range.first != range.second) {
+            std::string key(keyOf(compartment, compartment2, var));
+            if (ke.toOmit(key) == false) {
+                for (auto it = range.first; it != range.second; ++it) {
+                    l->push_back(new VariableValue(&m_name, &key,
+                        &it->second));
+                }
+            }
+        }
+    } else {
+        l->reserve(first + r->m_fields.size());
+        for (const auto &i : r->m_fields) {
+            std::string key(keyOf(compartment, compartment2, i.first));
+            if (ke.toOmit(key)) {
+                continue;
+            }
+            l->push_back(new VariableValue(&m_name, &key, &i.second));
+        }
+    }
+    pthread_rwlock_unlock(&s.m_lock);
+    std::reverse(l->begin() + first, l->end());
+}
+
+
+/* The expression is matched against the keys of the record only. */
+void InMemorySharded::resolveRegularExpression(const std::string& var,
+    const std::string &compartment, const std::string &compartment2,
+    std::vector<const VariableValue *> *l, variables::KeyExclusions &ke) {
+    Shard &s = shardOf(compartment);
+    size_t first = l->size();
+    Utils::Regex r(var, true);
+
+    readLock(&s.m_lock);
+    Record *record = findRecord(&s, compartment, compartment2);
+    if (record != nullptr) {
+        for (const auto &x : record->m_fields) {
+            if (Utils::regex_search(x.first, r) <= 0) {
+                continue;
+            }
+            std::string key(keyOf(compartment, compartment2, x.first));
+            if (ke.toOmit(key)) {
+                continue;
+            }
+            l->push_back(new VariableValue(&m_name, &key, &x.second));
+        }
+    }
+    pthread_rwlock_unlock(&s.m_lock);
+    std::reverse(l->begin() + first, l->end());
+}
+
+
+/*
+ * Up to kSweepBuckets buckets of the shard, from where the sweeper left
+ * it: the keys without a record first, then the records. Returns true,
+ * with the cursor back at the start, once the whole shard is done. The
+ * maps growing in between may move a few keys behind the cursor, those
+ * are left for the next pass.
+ */
+bool InMemorySharded::sweepBuckets(Shard *s, int64_t now,
+    uint64_t *expired) {
+    size_t budget = kSweepBuckets;
+
+    if (m_sweepRecords == false) {
+        Record &flat = s->m_flat;
+        std::vector<std::string> keys;
+        for (; budget > 0 && m_sweepBucket < flat.m_expires.bucket_count();
+            budget--, m_sweepBucket++) {
+            for (auto it = flat.m_expires.begin(m_sweepBucket);
+                it != flat.m_expires.end(m_sweepBucket); ++it) {
+                if (it->second <= now) {
+                    keys.push_back(it->first);
+                }
+            }
+        }
+        for (const std::string &key : keys) {
+            *expired += flat.m_fields.erase(key);
+            flat.m_expires.erase(key);
+        }
+        if (m_sweepBucket < flat.m_expires.bucket_count()) {
+            return false;
+        }
+        m_sweepRecords = true;
+        m_sweepBucket = 0;
+    }
+
+    std::vector<std::string> compartments;
+    for (; budget > 0 && m_sweepBucket < s->m_records.bucket_count();
+        budget--, m_sweepBucket++) {
+        for (auto it = s->m_records.begin(m_sweepBucket);
+            it != s->m_records.end(m_sweepBucket); ++it) {
+            compartments.push_back(it->first);
+        }
+    }
+    for (const std::string &compartment : compartments) {
+        auto records = s->m_records.find(compartment);
+        for (auto r = records->second.begin();
+            r != records->second.end();) {
+            if (r->second.m_expires.empty()) {
+                ++r;
+                continue;
+            }
+            *expired += expireFields(&r->second, now);
+            if (r->second.m_fields.empty()) {
+                r = records->second.erase(r);
+            } else {
+                ++r;
+            }
+        }
+        if (records->second.empty()) {
+            s->m_records.erase(records);
+        }
+    }
+    if (m_sweepBucket < s->m_records.bucket_count()) {
+        return false;
+    }
+    m_sweepRecords = false;
+    m_sweepBucket = 0;
+    return true;
+}
+
+
+/*
+ * A few buckets of a shard per hold of its lock, so neither the writers
+ * to the shard nor the ones to the others are held up for long; the keys
+ * written before SecCollectionTimeout was set have no deadline and stay.
+ * The records left with no keys go away.
+ */
+bool InMemorySharded::sweep(int64_t now, uint64_t until) {
+    uint64_t expired = 0;
+    bool finished = false;
+
+    while (finished == false) {
+        Shard &s = m_shards[m_sweepShard];
+
+        writeLock(&s.m_lock);
+        bool shard = sweepBuckets(&s, now, &expired);
+        pthread_rwlock_unlock(&s.m_lock);
+
+        if (shard) {
+            m_sweepShard = (m_sweepShard + 1) % kShards;
+            finished = m_sweepShard == 0;
+        }
+        if (utils::monotonic_ns() >= until) {
+            break;
+        }
+    }
+
+    if (expired != 0) {
+        Utils::Metrics::getInstance().increment(
+            Utils::Metrics::InMemoryEntriesExpiredCounter, expired);
+    }
+    return finished;
+}
+
+
+}  // namespace backend
+}  // namespace collection
+}  // namespace modsecurity
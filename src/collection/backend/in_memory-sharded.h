@@ -0,0 +1,182 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#ifdef __cplusplus
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <memory>
+#endif
+
+#include <pthread.h>
+
+#include "modsecurity/anchored_set_variable.h"
+#include "modsecurity/variable_value.h"
+#include "modsecurity/collection/collection.h"
+#include "src/collection/backend/expiry.h"
+#include "src/variables/variable.h"
+
+#ifndef SRC_COLLECTION_BACKEND_IN_MEMORY_SHARDED_H_
+#define SRC_COLLECTION_BACKEND_IN_MEMORY_SHARDED_H_
+
+#ifdef __cplusplus
+namespace modsecurity {
+namespace collection {
+namespace backend {
+
+
+/**
+ * In memory collection shared by all the threads of the process.
+ *
+ * The keys the rules use belong to a record, the one picked by initcol
+ * (compartment) for the web application (compartment2): each record is a
+ * small map of its own, found by the two names, so a key is reached with
+ * no compartment::compartment2::key string being built and a bare
+ * collection target (IP) only goes through the keys of its record. Keys
+ * given without a record are kept apart, as they are.
+ *
+ * Records (and keys without one) are spread over a fixed number of shards
+ * by the (case folded) hash of their compartment; each shard has its own
+ * read/write lock. Lookups in different shards do not contend at all and
+ * the ones in the same shard only wait for writers.
+ *
+ * With SecCollectionTimeout set, every record also keeps the deadline of
+ * its keys, for the expiry sweeper to go through.
+ *
+ */
+class InMemorySharded : public Collection, public Expiry::Sweeper {
+ public:
+    static const size_t kShards = 16;
+    /* buckets the sweeper goes through per hold of a shard lock */
+    static const size_t kSweepBuckets = 64;
+
+    explicit InMemorySharded(const std::string &name);
+    ~InMemorySharded();
+
+    InMemorySharded(const InMemorySharded&) = delete;
+    InMemorySharded& operator=(const InMemorySharded&) = delete;
+
+    void store(std::string key, std::string value) override;
+
+    bool storeOrUpdateFirst(const std::string &key,
+        const std::string &value) override;
+
+    bool updateFirst(const std::string &key,
+        const std::string &value) override;
+
+    void del(const std::string& key) override;
+
+    bool atomicAdd(const std::string &key, int delta,
+        int *result) override;
+
+    std::unique_ptr<std::string> resolveFirst(const std::string& var) override;
+
+    void resolveSingleMatch(const std::string& var,
+        std::vector<const VariableValue *> *l) override;
+    void resolveMultiMatches(const std::string& var,
+        std::vector<const VariableValue *> *l,
+        variables::KeyExclusions &ke) override;
+    void resolveRegularExpression(const std::string& var,
+        std::vector<const VariableValue *> *l,
+        variables::KeyExclusions &ke) override;
+
+    void store(std::string key, const std::string &compartment,
+        const std::string &compartment2, std::string value) override;
+
+    bool storeOrUpdateFirst(const std::string &key,
+        const std::string &compartment, const std::string &compartment2,
+        const std::string &value) override;
+
+    bool updateFirst(const std::string &key, const std::string &compartment,
+        const std::string &compartment2, const std::string &value) override;
+
+    bool atomicAdd(const std::string &key, const std::string &compartment,
+        const std::string &compartment2, int delta, int *result) override;
+
+    void del(const std::string& key, const std::string &compartment,
+        const std::string &compartment2) override;
+
+    std::unique_ptr<std::string> resolveFirst(const std::string& var,
+        const std::string &compartment,
+        const std::string &compartment2) override;
+
+    void resolveSingleMatch(const std::string& var,
+        const std::string &compartment, const std::string &compartment2,
+        std::vector<const VariableValue *> *l) override;
+    void resolveMultiMatches(const std::string& var,
+        const std::string &compartment, const std::string &compartment2,
+        std::vector<const VariableValue *> *l,
+        variables::KeyExclusions &ke) override;
+    void resolveRegularExpression(const std::string& var,
+        const std::string &compartment, const std::string &compartment2,
+        std::vector<const VariableValue *> *l,
+        variables::KeyExclusions &ke) override;
+
+    bool sweep(int64_t now, uint64_t until) override;
+
+ private:
+    /*
+     * A key may have more than a value (store() adds one); m_expires has
+     * the deadlines of the keys written with SecCollectionTimeout set.
+     */
+    struct Record {
+        std::unordered_multimap<std::string, std::string,
+            MyHash, MyEqual> m_fields;
+        std::unordered_map<std::string, int64_t, MyHash, MyEqual> m_expires;
+    };
+
+    /* The records of a compartment, by their compartment2. */
+    typedef std::unordered_map<std::string, Record, MyHash, MyEqual> Records;
+
+    struct Shard {
+        Record m_flat;
+        std::unordered_map<std::string, Records, MyHash, MyEqual> m_records;
+        pthread_rwlock_t m_lock;
+    };
+
+    Shard &shardOf(const std::string &key);
+
+    static Record *findRecord(Shard *s, const std::string &compartment,
+        const std::string &compartment2);
+    static void dropIfEmpty(Shard *s, const std::string &compartment,
+        const std::string &compartment2);
+
+    static void storeField(Record *r, const std::string &key,
+        const std::string &value, int64_t expires);
+    static bool updateField(Record *r, const std::string &key,
+        const std::string &value, int64_t expires);
+    static int addToField(Record *r, const std::string &key, int delta,
+        int64_t expires);
+    static uint64_t expireFields(Record *r, int64_t now);
+    bool sweepBuckets(Shard *s, int64_t now, uint64_t *expired);
+
+    Shard m_shards[kShards];
+    /*
+     * where the sweeper goes on from, only used by its thread: the shard,
+     * whether its flat keys are done and the bucket of the map it is at
+     */
+    size_t m_sweepShard;
+    bool m_sweepRecords;
+    size_t m_sweepBucket;
+};
+
+
+}  // namespace backend
+}  // namespace collection
+}  // namespace modsecurity
+#endif
+
+
+#endif  // SRC_COLLECTION_BACKEND_IN_MEMORY_SHARDED_H_
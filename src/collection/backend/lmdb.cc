@@ -19,13 +19,22 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <string.h>
+
+#include <time.h>
+
+#include <algorithm>
 #include <string>
 #include <memory>
+#include <unordered_map>
 
 #include <pthread.h>
 
 #include "modsecurity/variable_value.h"
+#include "src/collection/backend/expiry.h"
 #include "src/utils/regex.h"
+#include "src/utils/metrics.h"
+#include "src/utils/system.h"
 #include "src/variables/variable.h"
 
 #undef LMDB_STDOUT_COUT
@@ -37,6 +46,526 @@ namespace backend {
 
 #ifdef WITH_LMDB
 
+/*
+ * Begins a write transaction. The writer lock can not be tried, so all the
+ * time it takes is accounted as the wait for that lock.
+ */
+static int writeTxnBegin(MDB_env *env, unsigned int flags, MDB_txn **txn) {
+    uint64_t start = utils::monotonic_ns();
+    int rc = mdb_txn_begin(env, NULL, flags, txn);
+    Utils::Metrics::getInstance().waited(Utils::Metrics::LmdbWriterLock,
+        utils::monotonic_ns() - start);
+    return rc;
+}
+
+namespace {
+
+/*
+ * Read only transaction of the calling thread. Between lookups it is only
+ * reset, so the next one is a cheap mdb_txn_renew instead of a new begin
+ * (and a new reader slot).
+ */
+struct ThreadReadTxn {
+    ThreadReadTxn() : m_txn(NULL) { }
+    ~ThreadReadTxn() {
+        if (m_txn != NULL) {
+            mdb_txn_abort(m_txn);
+        }
+    }
+    MDB_txn *m_txn;
+};
+
+thread_local ThreadReadTxn threadReadTxn;
+
+
+/*
+ * The IP:/regex/ like targets come with the same few patterns over and
+ * over, so each thread compiles them once. Emptied when it grows past
+ * kMaxRegexes, in case reloads keep bringing new ones.
+ */
+const size_t kMaxRegexes = 1024;
+
+const Utils::Regex &cachedRegex(const std::string &pattern) {
+    static thread_local std::unordered_map<std::string,
+        std::unique_ptr<Utils::Regex>> regexes;
+
+    auto it = regexes.find(pattern);
+    if (it == regexes.end()) {
+        if (regexes.size() >= kMaxRegexes) {
+            regexes.clear();
+        }
+        it = regexes.emplace(pattern, std::unique_ptr<Utils::Regex>(
+            new Utils::Regex(pattern, true))).first;
+    }
+    return *it->second;
+}
+
+
+/* Positions the cursor on the first key starting with prefix. */
+int seekPrefix(MDB_cursor *cursor, const std::string &prefix, MDB_val *key,
+    MDB_val *data) {
+    if (prefix.empty()) {
+        return mdb_cursor_get(cursor, key, data, MDB_FIRST);
+    }
+    key->mv_size = prefix.size();
+    key->mv_data = const_cast<char *>(prefix.data());
+    return mdb_cursor_get(cursor, key, data, MDB_SET_RANGE);
+}
+
+
+bool hasPrefix(const MDB_val &key, const std::string &prefix) {
+    return key.mv_size >= prefix.size()
+        && memcmp(key.mv_data, prefix.data(), prefix.size()) == 0;
+}
+
+
+/*
+ * The deadline of a key is stored under this prefix and the key, as
+ * seconds since the epoch. The collection keys always start with their
+ * record, so they do not mix.
+ */
+const std::string kExpirePrefix("__expire_");
+
+/* Deadlines looked at in every write transaction of a sweep. */
+const size_t kSweepBatch = 256;
+
+
+/*
+ * Replaces the deadline of key, kept next to the deadlines of all of the
+ * other keys for the sweeper to walk through them.
+ */
+int stampExpiry(MDB_txn *txn, MDB_dbi dbi, const std::string &key,
+    int64_t expires) {
+    std::string k(kExpirePrefix + key);
+    std::string v(std::to_string(expires));
+    MDB_val mdb_key;
+    MDB_val mdb_value;
+    int rc;
+
+    mdb_key.mv_size = k.size();
+    mdb_key.mv_data = const_cast<char *>(k.data());
+    mdb_value.mv_size = v.size();
+    mdb_value.mv_data = const_cast<char *>(v.data());
+
+    rc = mdb_del(txn, dbi, &mdb_key, NULL);
+    if (rc != 0 && rc != MDB_NOTFOUND) {
+        return rc;
+    }
+    return mdb_put(txn, dbi, &mdb_key, &mdb_value, 0);
+}
+
+
+const size_t kCommitShards = 16;
+
+/* Writes queued past which the committer does not wait for the interval. */
+const size_t kCommitQueued = 65536;
+
+
+/*
+ * SecCollectionGroupCommit: the writes of every thread of the process are
+ * queued, and a committer thread applies whatever piled up in a single
+ * write transaction every few milliseconds, instead of each write taking
+ * the writer lock of the environment, which is one for all of the
+ * processes, on its own.
+ *
+ * Until its commit a write is pending: the value it leaves, as far as
+ * this process can tell, is kept for resolveFirst() and atomicAdd() to
+ * see it (the reads of a record taken by initcol are served by the copy
+ * of the transaction anyway). The other lookups, and the other
+ * processes, see the write once committed. An increment is applied as
+ * such when committed, so the ones of the other processes still add up.
+ */
+class Committer {
+ public:
+    static Committer& getInstance() {
+        static Committer *instance = new Committer();
+        return *instance;
+    }
+
+    /* what key was left with by the pending writes, if any */
+    enum State { NoWrite, Deleted, Stored, Added };
+    State pending(const std::string &key, std::string *value, int *delta);
+
+    void store(const std::string &key, const std::string &value,
+        int64_t expires);
+    void storeOrUpdateFirst(const std::string &key, const std::string &value,
+        int64_t expires);
+    bool updateFirst(LMDB *lmdb, const std::string &key,
+        const std::string &value, int64_t expires);
+    void add(LMDB *lmdb, const std::string &key, int delta, int *result,
+        int64_t expires);
+    void del(const std::string &key);
+
+ private:
+    struct Pending {
+        Pending() : m_state(NoWrite), m_delta(0), m_writes(0) { }
+        State m_state;
+        std::string m_value;
+        /* on top of the stored value, when m_state is Added */
+        int m_delta;
+        /* queued writes of the key not committed yet */
+        unsigned int m_writes;
+    };
+
+    struct Shard {
+        std::unordered_map<std::string, Pending> m_keys;
+        pthread_mutex_t m_lock;
+    };
+
+    struct Write {
+        /* 's'tore, 'f'irst (storeOrUpdateFirst), 'u'pdate, 'i'ncrement
+         * by m_delta or 'd'elete */
+        char m_op;
+        std::string m_key;
+        std::string m_value;
+        int m_delta;
+        int64_t m_expires;
+    };
+
+    Committer();
+
+    Shard &shardOf(const std::string &key) {
+        return m_shards[std::hash<std::string>()(key) % kCommitShards];
+    }
+
+    void queue(Write w);
+    void done(const Write &w);
+    int apply(MDB_txn *txn, MDB_dbi dbi, const Write &w);
+    static void *run(void *data);
+
+    static void prepareFork();
+    static void parentFork();
+    static void childFork();
+
+    Shard m_shards[kCommitShards];
+    std::vector<Write> m_queue;
+    bool m_running;
+    pthread_mutex_t m_queueLock;
+    pthread_cond_t m_queueCond;
+};
+
+
+Committer::Committer() : m_running(false) {
+    for (Shard &s : m_shards) {
+        pthread_mutex_init(&s.m_lock, NULL);
+    }
+    pthread_mutex_init(&m_queueLock, NULL);
+    pthread_cond_init(&m_queueCond, NULL);
+    pthread_atfork(prepareFork, parentFork, childFork);
+}
+
+
+Committer::State Committer::pending(const std::string &key,
+    std::string *value, int *delta) {
+    Shard &s = shardOf(key);
+    State state = NoWrite;
+
+    pthread_mutex_lock(&s.m_lock);
+    auto it = s.m_keys.find(key);
+    if (it != s.m_keys.end()) {
+        state = it->second.m_state;
+        value->assign(it->second.m_value);
+        *delta = it->second.m_delta;
+    }
+    pthread_mutex_unlock(&s.m_lock);
+
+    return state;
+}
+
+
+/*
+ * Adds a value next to the ones key has: the first of them, the one the
+ * lookups return, is only known once committed.
+ */
+void Committer::store(const std::string &key, const std::string &value,
+    int64_t expires) {
+    Shard &s = shardOf(key);
+
+    pthread_mutex_lock(&s.m_lock);
+    Pending &p = s.m_keys[key];
+    if (p.m_state == Deleted) {
+        p.m_state = Stored;
+        p.m_value = value;
+    }
+    p.m_writes++;
+    pthread_mutex_unlock(&s.m_lock);
+
+    queue(Write{'s', key, value, 0, expires});
+}
+
+
+void Committer::storeOrUpdateFirst(const std::string &key,
+    const std::string &value, int64_t expires) {
+    Shard &s = shardOf(key);
+
+    pthread_mutex_lock(&s.m_lock);
+    Pending &p = s.m_keys[key];
+    p.m_state = Stored;
+    p.m_value = value;
+    p.m_delta = 0;
+    p.m_writes++;
+    pthread_mutex_unlock(&s.m_lock);
+
+    queue(Write{'f', key, value, 0, expires});
+}
+
+
+/* Whether key is there is told by the pending writes, or the database. */
+bool Committer::updateFirst(LMDB *lmdb, const std::string &key,
+    const std::string &value, int64_t expires) {
+    Shard &s = shardOf(key);
+
+    pthread_mutex_lock(&s.m_lock);
+    auto it = s.m_keys.find(key);
+    bool exists = it != s.m_keys.end() && it->second.m_state != NoWrite
+        ? it->second.m_state != Deleted
+        : lmdb->resolveStored(key) != nullptr;
+    if (exists) {
+        Pending &p = s.m_keys[key];
+        p.m_state = Stored;
+        p.m_value = value;
+        p.m_delta = 0;
+        p.m_writes++;
+    }
+    pthread_mutex_unlock(&s.m_lock);
+
+    if (exists) {
+        queue(Write{'u', key, value, 0, expires});
+    }
+    return exists;
+}
+
+
+/*
+ * The stored value is only read when the caller wants the sum; otherwise
+ * the increments pile up as a delta over it.
+ */
+void Committer::add(LMDB *lmdb, const std::string &key, int delta,
+    int *result, int64_t expires) {
+    Shard &s = shardOf(key);
+
+    pthread_mutex_lock(&s.m_lock);
+    Pending &p = s.m_keys[key];
+    if (p.m_state == Deleted) {
+        p.m_state = Stored;
+        p.m_value.clear();
+    } else if ((p.m_state == NoWrite || p.m_state == Added)
+        && result != nullptr) {
+        std::unique_ptr<std::string> stored(lmdb->resolveStored(key));
+        p.m_value = std::to_string((stored ? Collection::toInt(*stored) : 0)
+            + p.m_delta);
+        p.m_state = Stored;
+    }
+    if (p.m_state == Stored) {
+        p.m_value = std::to_string(Collection::toInt(p.m_value) + delta);
+        p.m_delta = 0;
+        if (result != nullptr) {
+            *result = Collection::toInt(p.m_value);
+        }
+    } else {
+        p.m_state = Added;
+        p.m_delta += delta;
+    }
+    p.m_writes++;
+    pthread_mutex_unlock(&s.m_lock);
+
+    queue(Write{'i', key, "", delta, expires});
+}
+
+
+void Committer::del(const std::string &key) {
+    Shard &s = shardOf(key);
+
+    pthread_mutex_lock(&s.m_lock);
+    Pending &p = s.m_keys[key];
+    p.m_state = Deleted;
+    p.m_value.clear();
+    p.m_delta = 0;
+    p.m_writes++;
+    pthread_mutex_unlock(&s.m_lock);
+
+    queue(Write{'d', key, "", 0, 0});
+}
+
+
+void Committer::queue(Write w) {
+    pthread_mutex_lock(&m_queueLock);
+    if (m_running == false) {
+        pthread_t thread;
+        pthread_attr_t attr;
+
+        pthread_attr_init(&attr);
+        pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+        m_running = pthread_create(&thread, &attr, run, this) == 0;
+        pthread_attr_destroy(&attr);
+    }
+    m_queue.push_back(std::move(w));
+    if (m_queue.size() == 1 || m_queue.size() >= kCommitQueued) {
+        pthread_cond_signal(&m_queueCond);
+    }
+    pthread_mutex_unlock(&m_queueLock);
+}
+
+
+/* Committed, or lost with its transaction: the database has the say. */
+void Committer::done(const Write &w) {
+    Shard &s = shardOf(w.m_key);
+
+    pthread_mutex_lock(&s.m_lock);
+    auto it = s.m_keys.find(w.m_key);
+    if (it != s.m_keys.end() && --it->second.m_writes == 0) {
+        s.m_keys.erase(it);
+    }
+    pthread_mutex_unlock(&s.m_lock);
+}
+
+
+/* What the write would have done in a transaction of its own. */
+int Committer::apply(MDB_txn *txn, MDB_dbi dbi, const Write &w) {
+    MDB_val key;
+    MDB_val value;
+    MDB_val current;
+    std::string data;
+    int rc;
+
+    key.mv_size = w.m_key.size();
+    key.mv_data = const_cast<char *>(w.m_key.data());
+
+    rc = mdb_get(txn, dbi, &key, &current);
+    if (rc != 0 && rc != MDB_NOTFOUND) {
+        return rc;
+    }
+    if (w.m_op == 'd') {
+        if (rc == MDB_NOTFOUND) {
+            return 0;
+        }
+        rc = mdb_del(txn, dbi, &key, &current);
+        if (rc != 0) {
+            return rc;
+        }
+        data = kExpirePrefix + w.m_key;
+        key.mv_size = data.size();
+        key.mv_data = const_cast<char *>(data.data());
+        rc = mdb_del(txn, dbi, &key, NULL);
+        return rc == MDB_NOTFOUND ? 0 : rc;
+    }
+    if (w.m_op == 'u' && rc == MDB_NOTFOUND) {
+        return 0;
+    }
+
+    data = w.m_value;
+    if (w.m_op == 'i') {
+        data = std::to_string((rc == 0 ? Collection::toInt(std::string(
+            reinterpret_cast<char *>(current.mv_data), current.mv_size))
+            : 0) + w.m_delta);
+    }
+    if (rc == 0 && w.m_op != 's') {
+        rc = mdb_del(txn, dbi, &key, &current);
+        if (rc != 0) {
+            return rc;
+        }
+    }
+
+    value.mv_size = data.size();
+    value.mv_data = const_cast<char *>(data.data());
+    rc = mdb_put(txn, dbi, &key, &value, 0);
+    if (rc == 0 && w.m_expires != 0) {
+        rc = stampExpiry(txn, dbi, w.m_key, w.m_expires);
+    }
+    return rc;
+}
+
+
+/*
+ * A write that fails is left out, as it would have failed on its own;
+ * one failing commit loses the whole batch.
+ */
+void *Committer::run(void *data) {
+    Committer *c = reinterpret_cast<Committer *>(data);
+    MDBEnvProvider &provider = MDBEnvProvider::GetInstance();
+    std::vector<Write> writes;
+
+    while (true) {
+        pthread_mutex_lock(&c->m_queueLock);
+        while (c->m_queue.empty()) {
+            pthread_cond_wait(&c->m_queueCond, &c->m_queueLock);
+        }
+
+        uint64_t interval = MDBEnvProvider::groupCommit();
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += interval / 1000;
+        deadline.tv_nsec += (interval % 1000) * 1000000;
+        if (deadline.tv_nsec >= 1000000000) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000;
+        }
+        while (c->m_queue.size() < kCommitQueued
+            && pthread_cond_timedwait(&c->m_queueCond, &c->m_queueLock,
+            &deadline) != ETIMEDOUT) {
+        }
+
+        writes.clear();
+        writes.swap(c->m_queue);
+        pthread_mutex_unlock(&c->m_queueLock);
+
+        Utils::Metrics::Timer timer(Utils::Metrics::LmdbOperationsHistogram);
+        MDB_txn *txn;
+        if (provider.isValid()) {
+            provider.applySyncMode();
+            if (writeTxnBegin(provider.GetEnv(), 0, &txn) == 0) {
+                MDB_dbi dbi = *provider.GetDBI();
+                for (const Write &w : writes) {
+                    c->apply(txn, dbi, w);
+                }
+                mdb_txn_commit(txn);
+            }
+        }
+        for (const Write &w : writes) {
+            c->done(w);
+        }
+    }
+
+    return NULL;
+}
+
+
+void Committer::prepareFork() {
+    Committer &c = getInstance();
+
+    pthread_mutex_lock(&c.m_queueLock);
+    for (Shard &s : c.m_shards) {
+        pthread_mutex_lock(&s.m_lock);
+    }
+}
+
+
+void Committer::parentFork() {
+    Committer &c = getInstance();
+
+    for (Shard &s : c.m_shards) {
+        pthread_mutex_unlock(&s.m_lock);
+    }
+    pthread_mutex_unlock(&c.m_queueLock);
+}
+
+
+/* The queued writes are the parent's to commit. */
+void Committer::childFork() {
+    Committer &c = getInstance();
+
+    for (Shard &s : c.m_shards) {
+        s.m_keys.clear();
+        pthread_mutex_unlock(&s.m_lock);
+    }
+    c.m_queue.clear();
+    c.m_running = false;
+    pthread_mutex_unlock(&c.m_queueLock);
+}
+
+}  // namespace
+
+
 LMDB::LMDB(const std::string &name) :
     Collection(name), m_env(NULL), isOpen(false) {}
 
@@ -48,18 +577,55 @@ int LMDB::txn_begin(unsigned int flags, MDB_txn **ret) {
     }
 
     if (MDBEnvProvider::GetInstance().isValid()) {
+        if ((flags & MDB_RDONLY) == 0) {
+            MDBEnvProvider::GetInstance().applySyncMode();
+            return writeTxnBegin(m_env, flags, ret);
+        }
         return mdb_txn_begin(m_env, NULL, flags, ret);
     } else {
         return -1;
     }
 }
 
+
+int LMDB::read_txn_begin(MDB_txn **ret) {
+    int rc;
+
+    if (threadReadTxn.m_txn != NULL) {
+        rc = mdb_txn_renew(threadReadTxn.m_txn);
+        if (rc == 0) {
+            *ret = threadReadTxn.m_txn;
+            return 0;
+        }
+        mdb_txn_abort(threadReadTxn.m_txn);
+        threadReadTxn.m_txn = NULL;
+    }
+
+    rc = txn_begin(MDB_RDONLY, ret);
+    if (rc == 0) {
+        threadReadTxn.m_txn = *ret;
+    }
+
+    return rc;
+}
+
+
+void LMDB::read_txn_end(MDB_txn *txn) {
+    mdb_txn_reset(txn);
+}
+
 void LMDB::string2val(const std::string& str, MDB_val *val) {
     val->mv_size = sizeof(char)*(str.size());
     val->mv_data = const_cast<char *>(str.c_str());
 }
 
 
+int LMDB::stampExpiry(MDB_txn *txn, const std::string &key,
+    int64_t expires) {
+    return backend::stampExpiry(txn, m_dbi, key, expires);
+}
+
+
 void LMDB::lmdb_debug(int rc, const std::string &op, const std::string &scope) {
 #ifndef LMDB_STDOUT_COUT
     return;
@@ -152,6 +718,30 @@ void LMDB::lmdb_debug(int rc, const std::string &op, const std::string &scope) {
 
 
 std::unique_ptr<std::string> LMDB::resolveFirst(const std::string& var) {
+    if (MDBEnvProvider::groupCommit() != 0) {
+        std::string value;
+        int delta = 0;
+        switch (Committer::getInstance().pending(var, &value, &delta)) {
+            case Committer::Deleted:
+                return nullptr;
+            case Committer::Stored:
+                return std::unique_ptr<std::string>(new std::string(value));
+            case Committer::Added: {
+                std::unique_ptr<std::string> stored(resolveStored(var));
+                return std::unique_ptr<std::string>(new std::string(
+                    std::to_string((stored ? toInt(*stored) : 0) + delta)));
+            }
+            case Committer::NoWrite:
+                break;
+        }
+    }
+
+    return resolveStored(var);
+}
+
+
+std::unique_ptr<std::string> LMDB::resolveStored(const std::string& var) {
+    Utils::Metrics::Timer timer(Utils::Metrics::LmdbOperationsHistogram);
     int rc;
     MDB_val mdb_key;
     MDB_val mdb_value;
@@ -161,13 +751,13 @@ std::unique_ptr<std::string> LMDB::resolveFirst(const std::string& var) {
 
     string2val(var, &mdb_key);
 
-    rc = txn_begin(MDB_RDONLY, &txn);
-    lmdb_debug(rc, "txn", "resolveFirst");
+    rc = read_txn_begin(&txn);
+    lmdb_debug(rc, "txn", "resolveStored");
     if (rc != 0) {
         goto end_txn;
     }
     rc = mdb_get(txn, m_dbi, &mdb_key, &mdb_value_ret);
-    lmdb_debug(rc, "get", "resolveFirst");
+    lmdb_debug(rc, "get", "resolveStored");
     if (rc != 0) {
         goto end_get;
     }
@@ -177,7 +767,7 @@ std::unique_ptr<std::string> LMDB::resolveFirst(const std::string& var) {
         mdb_value_ret.mv_size));
 
 end_get:
-    mdb_txn_abort(txn);
+    read_txn_end(txn);
 end_txn:
     return ret;
 }
@@ -185,11 +775,18 @@ end_txn:
 
 bool LMDB::storeOrUpdateFirst(const std::string &key,
     const std::string &value) {
+    Utils::Metrics::Timer timer(Utils::Metrics::LmdbOperationsHistogram);
     int rc;
     MDB_txn *txn;
     MDB_val mdb_key;
     MDB_val mdb_value;
     MDB_val mdb_value_ret;
+    int64_t expires = Expiry::getInstance().expiresAt();
+
+    if (MDBEnvProvider::groupCommit() != 0) {
+        Committer::getInstance().storeOrUpdateFirst(key, value, expires);
+        return true;
+    }
 
     string2val(key, &mdb_key);
     string2val(value, &mdb_value);
@@ -216,6 +813,14 @@ bool LMDB::storeOrUpdateFirst(const std::string &key,
         goto end_put;
     }
 
+    if (expires != 0) {
+        rc = stampExpiry(txn, key, expires);
+        lmdb_debug(rc, "put", "storeOrUpdateFirst");
+        if (rc != 0) {
+            goto end_put;
+        }
+    }
+
     rc = mdb_txn_commit(txn);
     lmdb_debug(rc, "commit", "storeOrUpdateFirst");
     if (rc != 0) {
@@ -235,6 +840,7 @@ end_txn:
 
 void LMDB::resolveSingleMatch(const std::string& var,
     std::vector<const VariableValue *> *l) {
+    Utils::Metrics::Timer timer(Utils::Metrics::LmdbOperationsHistogram);
     int rc;
     MDB_txn *txn;
     MDB_val mdb_key;
@@ -242,7 +848,7 @@ void LMDB::resolveSingleMatch(const std::string& var,
     MDB_val mdb_value_ret;
     MDB_cursor *cursor;
 
-    rc = txn_begin(MDB_RDONLY, &txn);
+    rc = read_txn_begin(&txn);
     lmdb_debug(rc, "txn", "resolveSingleMatch");
     if (rc != 0) {
         goto end_txn;
@@ -261,17 +867,24 @@ void LMDB::resolveSingleMatch(const std::string& var,
     }
 
     mdb_cursor_close(cursor);
-    mdb_txn_abort(txn);
+    read_txn_end(txn);
 end_txn:
     return;
 }
 
 
 void LMDB::store(std::string key, std::string value) {
+    Utils::Metrics::Timer timer(Utils::Metrics::LmdbOperationsHistogram);
     MDB_val mdb_key, mdb_data;
     MDB_txn *txn = NULL;
     int rc;
     MDB_stat mst;
+    int64_t expires = Expiry::getInstance().expiresAt();
+
+    if (MDBEnvProvider::groupCommit() != 0) {
+        Committer::getInstance().store(key, value, expires);
+        return;
+    }
 
     rc = txn_begin(0, &txn);
     lmdb_debug(rc, "txn", "store");
@@ -287,6 +900,14 @@ void LMDB::store(std::string key, std::string value) {
         goto end_put;
     }
 
+    if (expires != 0) {
+        rc = stampExpiry(txn, key, expires);
+        lmdb_debug(rc, "put", "store");
+        if (rc != 0) {
+            goto end_put;
+        }
+    }
+
     rc = mdb_txn_commit(txn);
     lmdb_debug(rc, "commit", "store");
     if (rc != 0) {
@@ -306,11 +927,18 @@ end_txn:
 
 bool LMDB::updateFirst(const std::string &key,
     const std::string &value) {
+    Utils::Metrics::Timer timer(Utils::Metrics::LmdbOperationsHistogram);
     int rc;
     MDB_txn *txn;
     MDB_val mdb_key;
     MDB_val mdb_value;
     MDB_val mdb_value_ret;
+    int64_t expires = Expiry::getInstance().expiresAt();
+
+    if (MDBEnvProvider::groupCommit() != 0) {
+        return Committer::getInstance().updateFirst(this, key, value,
+            expires);
+    }
 
     rc = txn_begin(0, &txn);
     lmdb_debug(rc, "txn", "updateFirst");
@@ -339,6 +967,14 @@ bool LMDB::updateFirst(const std::string &key,
         goto end_put;
     }
 
+    if (expires != 0) {
+        rc = stampExpiry(txn, key, expires);
+        lmdb_debug(rc, "put", "updateFirst");
+        if (rc != 0) {
+            goto end_put;
+        }
+    }
+
     rc = mdb_txn_commit(txn);
     lmdb_debug(rc, "commit", "updateFirst");
     if (rc != 0) {
@@ -358,13 +994,94 @@ end_txn:
 }
 
 
+bool LMDB::atomicAdd(const std::string &key, int delta, int *result) {
+    Utils::Metrics::Timer timer(Utils::Metrics::LmdbOperationsHistogram);
+    int rc;
+    int value = delta;
+    std::string data;
+    MDB_txn *txn;
+    MDB_val mdb_key;
+    MDB_val mdb_value;
+    MDB_val mdb_value_ret;
+    int64_t expires = Expiry::getInstance().expiresAt();
+
+    if (MDBEnvProvider::groupCommit() != 0) {
+        Committer::getInstance().add(this, key, delta, result, expires);
+        return true;
+    }
+
+    string2val(key, &mdb_key);
+
+    rc = txn_begin(0, &txn);
+    lmdb_debug(rc, "txn", "atomicAdd");
+    if (rc != 0) {
+        goto end_txn;
+    }
+
+    rc = mdb_get(txn, m_dbi, &mdb_key, &mdb_value_ret);
+    lmdb_debug(rc, "get", "atomicAdd");
+    if (rc == 0) {
+        value = toInt(std::string(
+            reinterpret_cast<char *>(mdb_value_ret.mv_data),
+            mdb_value_ret.mv_size)) + delta;
+        rc = mdb_del(txn, m_dbi, &mdb_key, &mdb_value_ret);
+        lmdb_debug(rc, "del", "atomicAdd");
+        if (rc != 0) {
+            goto end_del;
+        }
+    }
+
+    data = std::to_string(value);
+    string2val(data, &mdb_value);
+    rc = mdb_put(txn, m_dbi, &mdb_key, &mdb_value, 0);
+    lmdb_debug(rc, "put", "atomicAdd");
+    if (rc != 0) {
+        goto end_put;
+    }
+
+    if (expires != 0) {
+        rc = stampExpiry(txn, key, expires);
+        lmdb_debug(rc, "put", "atomicAdd");
+        if (rc != 0) {
+            goto end_put;
+        }
+    }
+
+    rc = mdb_txn_commit(txn);
+    lmdb_debug(rc, "commit", "atomicAdd");
+    if (rc != 0) {
+        goto end_commit;
+    }
+
+    if (result != nullptr) {
+        *result = value;
+    }
+
+end_put:
+end_del:
+    if (rc != 0) {
+        mdb_txn_abort(txn);
+    }
+end_commit:
+end_txn:
+    return rc == 0;
+}
+
+
 void LMDB::del(const std::string& key) {
+    Utils::Metrics::Timer timer(Utils::Metrics::LmdbOperationsHistogram);
     int rc;
     MDB_txn *txn;
     MDB_val mdb_key;
     MDB_val mdb_value;
     MDB_val mdb_value_ret;
     MDB_stat mst;
+    std::string expire;
+
+    if (MDBEnvProvider::groupCommit() != 0) {
+        Committer::getInstance().del(key);
+        return;
+    }
 
     rc = txn_begin(0, &txn);
     lmdb_debug(rc, "txn", "del");
@@ -386,6 +1103,14 @@ void LMDB::del(const std::string& key) {
         goto end_del;
     }
 
+    expire = kExpirePrefix + key;
+    string2val(expire, &mdb_key);
+    rc = mdb_del(txn, m_dbi, &mdb_key, NULL);
+    lmdb_debug(rc, "del", "del");
+    if (rc != 0 && rc != MDB_NOTFOUND) {
+        goto end_del;
+    }
+
     rc = mdb_txn_commit(txn);
     lmdb_debug(rc, "commit", "del");
     if (rc != 0) {
@@ -403,17 +1128,21 @@ end_txn:
 }
 
 
+/*
+ * The keys are kept sorted, so the ones starting with var are next to
+ * each other from where MDB_SET_RANGE puts the cursor.
+ */
 void LMDB::resolveMultiMatches(const std::string& var,
     std::vector<const VariableValue *> *l,
     variables::KeyExclusions &ke) {
+    Utils::Metrics::Timer timer(Utils::Metrics::LmdbOperationsHistogram);
+    size_t first = l->size();
     MDB_val key, data;
     MDB_txn *txn = NULL;
     int rc;
-    MDB_stat mst;
-    size_t keySize = var.size();
     MDB_cursor *cursor;
 
-    rc = txn_begin(MDB_RDONLY, &txn);
+    rc = read_txn_begin(&txn);
     lmdb_debug(rc, "txn", "resolveMultiMatches");
     if (rc != 0) {
         goto end_txn;
@@ -425,33 +1154,22 @@ void LMDB::resolveMultiMatches(const std::string& var,
         goto end_cursor_open;
     }
 
-    if (keySize == 0) {
-        while ((rc = mdb_cursor_get(cursor, &key, &data, MDB_NEXT)) == 0) {
-            l->insert(l->begin(), new VariableValue(
-                &m_name,
-                new std::string(reinterpret_cast<char *>(key.mv_data),
-                key.mv_size),
-                new std::string(reinterpret_cast<char *>(data.mv_data),
-                data.mv_size)));
-        }
-    } else {
-        while ((rc = mdb_cursor_get(cursor, &key, &data, MDB_NEXT)) == 0) {
-            char *a = reinterpret_cast<char *>(key.mv_data);
-            if (strncmp(var.c_str(), a, keySize) == 0) {
-                l->insert(l->begin(), new VariableValue(
-                    &m_name,
-                    new std::string(reinterpret_cast<char *>(key.mv_data),
-                    key.mv_size),
-                    new std::string(reinterpret_cast<char *>(data.mv_data),
-                    data.mv_size)));
-            }
-        }
+    for (rc = seekPrefix(cursor, var, &key, &data); rc == 0
+        && hasPrefix(key, var);
+        rc = mdb_cursor_get(cursor, &key, &data, MDB_NEXT)) {
+        l->push_back(new VariableValue(
+            &m_name,
+            new std::string(reinterpret_cast<char *>(key.mv_data),
+            key.mv_size),
+            new std::string(reinterpret_cast<char *>(data.mv_data),
+            data.mv_size)));
     }
 
     mdb_cursor_close(cursor);
 end_cursor_open:
-    mdb_txn_abort(txn);
+    read_txn_end(txn);
 end_txn:
+    std::reverse(l->begin() + first, l->end());
     return;
 }
 
@@ -459,15 +1177,86 @@ end_txn:
 void LMDB::resolveRegularExpression(const std::string& var,
     std::vector<const VariableValue *> *l,
     variables::KeyExclusions &ke) {
+    Utils::Regex r(var, true);
+
+    resolvePrefixedRegularExpression("", r, l, ke);
+}
+
+
+/*
+ * With the record at hand only its keys are walked, and the regular
+ * expression is matched against the part of the key after the record
+ * prefix, the name the rules gave the variable.
+ */
+void LMDB::resolveRegularExpression(const std::string& var,
+    const std::string &compartment, std::vector<const VariableValue *> *l,
+    variables::KeyExclusions &ke) {
+    resolvePrefixedRegularExpression(compartment + "::", cachedRegex(var),
+        l, ke);
+}
+
+
+void LMDB::resolveRegularExpression(const std::string& var,
+    const std::string &compartment, const std::string &compartment2,
+    std::vector<const VariableValue *> *l, variables::KeyExclusions &ke) {
+    resolvePrefixedRegularExpression(compartment + "::" + compartment2
+        + "::", cachedRegex(var), l, ke);
+}
+
+
+/* The whole record in a single read txn and walk of the cursor. */
+bool LMDB::resolveRecord(const std::string &compartment,
+    const std::string &compartment2,
+    std::vector<std::pair<std::string, std::string>> *entries) {
+    Utils::Metrics::Timer timer(Utils::Metrics::LmdbOperationsHistogram);
+    std::string prefix(compartment + "::" + compartment2 + "::");
     MDB_val key, data;
     MDB_txn *txn = NULL;
     int rc;
-    MDB_stat mst;
     MDB_cursor *cursor;
 
-    Utils::Regex r(var, true);
+    rc = read_txn_begin(&txn);
+    lmdb_debug(rc, "txn", "resolveRecord");
+    if (rc != 0) {
+        return false;
+    }
+
+    rc = mdb_cursor_open(txn, m_dbi, &cursor);
+    lmdb_debug(rc, "cursor_open", "resolveRecord");
+    if (rc != 0) {
+        read_txn_end(txn);
+        return false;
+    }
+
+    /* MDB_NEXT_NODUP: the first value of a key is the one resolveFirst has */
+    for (rc = seekPrefix(cursor, prefix, &key, &data); rc == 0
+        && hasPrefix(key, prefix);
+        rc = mdb_cursor_get(cursor, &key, &data, MDB_NEXT_NODUP)) {
+        const char *a = reinterpret_cast<char *>(key.mv_data);
+        entries->emplace_back(
+            std::string(a + prefix.size(), key.mv_size - prefix.size()),
+            std::string(reinterpret_cast<char *>(data.mv_data),
+                data.mv_size));
+    }
+
+    mdb_cursor_close(cursor);
+    read_txn_end(txn);
+    return true;
+}
+
 
-    rc = txn_begin(MDB_RDONLY, &txn);
+void LMDB::resolvePrefixedRegularExpression(const std::string &prefix,
+    const Utils::Regex &r, std::vector<const VariableValue *> *l,
+    variables::KeyExclusions &ke) {
+    Utils::Metrics::Timer timer(Utils::Metrics::LmdbOperationsHistogram);
+    size_t first = l->size();
+    MDB_val key, data;
+    MDB_txn *txn = NULL;
+    int rc;
+    MDB_cursor *cursor;
+    std::string name;
+
+    rc = read_txn_begin(&txn);
     lmdb_debug(rc, "txn", "resolveRegularExpression");
     if (rc != 0) {
         goto end_txn;
@@ -479,45 +1268,57 @@ void LMDB::resolveRegularExpression(const std::string& var,
         goto end_cursor_open;
     }
 
-    while ((rc = mdb_cursor_get(cursor, &key, &data, MDB_NEXT)) == 0) {
-        char *a = reinterpret_cast<char *>(key.mv_data);
-        int ret = Utils::regex_search(a, r);
-        if (ret <= 0) {
+    for (rc = seekPrefix(cursor, prefix, &key, &data); rc == 0
+        && hasPrefix(key, prefix);
+        rc = mdb_cursor_get(cursor, &key, &data, MDB_NEXT)) {
+        if (prefix.empty() && hasPrefix(key, kExpirePrefix)) {
             continue;
         }
-        if (ke.toOmit(std::string(reinterpret_cast<char *>(key.mv_data),
-                key.mv_size))) {
+        const char *a = reinterpret_cast<char *>(key.mv_data);
+        name.assign(a + prefix.size(), key.mv_size - prefix.size());
+        if (Utils::regex_search(name, r) <= 0) {
+            continue;
+        }
+        std::string *k = new std::string(a, key.mv_size);
+        if (ke.toOmit(*k)) {
+            delete k;
             continue;
         }
 
-        VariableValue *v = new VariableValue(
-            new std::string(reinterpret_cast<char *>(key.mv_data),
-                key.mv_size),
+        VariableValue *v = new VariableValue(k,
             new std::string(reinterpret_cast<char *>(data.mv_data),
                 data.mv_size));
-        l->insert(l->begin(), v);
+        l->push_back(v);
     }
 
     mdb_cursor_close(cursor);
 end_cursor_open:
-    mdb_txn_abort(txn);
+    read_txn_end(txn);
 end_txn:
+    std::reverse(l->begin() + first, l->end());
     return;
 }
 
 
-MDBEnvProvider::MDBEnvProvider() : m_env(NULL), valid(false) {
+unsigned int MDBEnvProvider::m_requestedSyncMode = 0;
+std::atomic<unsigned int> MDBEnvProvider::m_groupCommit(0);
+
+
+MDBEnvProvider::MDBEnvProvider() : m_env(NULL), valid(false),
+    m_syncMode(m_requestedSyncMode) {
     int rc;
     MDB_txn *txn;
     mdb_env_create(&m_env);
     rc = mdb_env_open(m_env, "./modsec-shared-collections",
-        MDB_WRITEMAP | MDB_NOSUBDIR, 0664);
+        MDB_WRITEMAP | MDB_NOSUBDIR | m_syncMode, 0664);
+    pthread_mutex_init(&m_lock, NULL);
 
     if (rc == 0) {
         valid = true;
         mdb_txn_begin(m_env, NULL, 0, &txn);
         mdb_dbi_open(txn, NULL, MDB_CREATE | MDB_DUPSORT, &m_dbi);
         mdb_txn_commit(txn);
+        Expiry::getInstance().add(this);
     }
 }
 
@@ -533,9 +1334,132 @@ bool MDBEnvProvider::isValid() {
     return valid;
 }
 
+
+/*
+ * Only records the flags; the environment is opened lazily, in the process
+ * that uses it, and picks them up on the next write transaction.
+ */
+void MDBEnvProvider::setSyncMode(unsigned int flags) {
+    m_requestedSyncMode = flags & (MDB_NOSYNC | MDB_NOMETASYNC);
+}
+
+
+void MDBEnvProvider::setGroupCommit(unsigned int ms) {
+    m_groupCommit = ms;
+}
+
+
+void MDBEnvProvider::applySyncMode() {
+    unsigned int requested = m_requestedSyncMode;
+
+    if (requested == m_syncMode) {
+        return;
+    }
+
+    pthread_mutex_lock(&m_lock);
+    if (requested != m_syncMode) {
+        mdb_env_set_flags(m_env, MDB_NOSYNC | MDB_NOMETASYNC, 0);
+        if (requested != 0) {
+            mdb_env_set_flags(m_env, requested, 1);
+        }
+        m_syncMode = requested;
+    }
+    pthread_mutex_unlock(&m_lock);
+}
+
+/*
+ * Walks the deadlines from where the last sweep stopped, kSweepBatch of
+ * them per write transaction so the other writers get their turn, and
+ * drops the expired keys along with their deadline.
+ */
+bool MDBEnvProvider::sweep(int64_t now, uint64_t until) {
+    std::vector<std::string> expired;
+    bool done = false;
+    MDB_envinfo info;
+    MDB_stat mst;
+
+    while (done == false && utils::monotonic_ns() < until) {
+        MDB_txn *txn;
+        MDB_cursor *cursor;
+        MDB_val key, data;
+        uint64_t count = 0;
+        size_t n = 0;
+        int rc;
+
+        applySyncMode();
+        rc = writeTxnBegin(m_env, 0, &txn);
+        if (rc != 0) {
+            break;
+        }
+        rc = mdb_cursor_open(txn, m_dbi, &cursor);
+        if (rc != 0) {
+            mdb_txn_abort(txn);
+            break;
+        }
+
+        if (m_sweepFrom.empty()) {
+            m_sweepFrom = kExpirePrefix;
+        }
+        expired.clear();
+        for (rc = seekPrefix(cursor, m_sweepFrom, &key, &data);
+            rc == 0 && hasPrefix(key, kExpirePrefix) && n < kSweepBatch;
+            rc = mdb_cursor_get(cursor, &key, &data, MDB_NEXT), n++) {
+            std::string deadline(reinterpret_cast<char *>(data.mv_data),
+                data.mv_size);
+            if (strtoll(deadline.c_str(), NULL, 10) <= now) {
+                expired.emplace_back(reinterpret_cast<char *>(key.mv_data),
+                    key.mv_size);
+            }
+        }
+        done = rc != 0 || hasPrefix(key, kExpirePrefix) == false;
+        if (done == false) {
+            m_sweepFrom.assign(reinterpret_cast<char *>(key.mv_data),
+                key.mv_size);
+        }
+        mdb_cursor_close(cursor);
+
+        for (const std::string &e : expired) {
+            key.mv_size = e.size();
+            key.mv_data = const_cast<char *>(e.data());
+            mdb_del(txn, m_dbi, &key, NULL);
+            key.mv_size = e.size() - kExpirePrefix.size();
+            key.mv_data = const_cast<char *>(e.data())
+                + kExpirePrefix.size();
+            if (mdb_del(txn, m_dbi, &key, NULL) == 0) {
+                count++;
+            }
+        }
+
+        rc = mdb_txn_commit(txn);
+        if (rc != 0) {
+            break;
+        }
+        if (count != 0) {
+            Utils::Metrics::getInstance().increment(
+                Utils::Metrics::LmdbEntriesExpiredCounter, count);
+        }
+    }
+
+    if (done) {
+        m_sweepFrom.clear();
+    }
+
+    if (mdb_env_info(m_env, &info) == 0 && mdb_env_stat(m_env, &mst) == 0) {
+        Utils::Metrics::getInstance().set(Utils::Metrics::LmdbSizeGauge,
+            static_cast<int64_t>((info.me_last_pgno + 1) * mst.ms_psize));
+    }
+
+    return done;
+}
+
+
 MDBEnvProvider::~MDBEnvProvider() {
+    if (valid) {
+        Expiry::getInstance().remove(this);
+    }
     mdb_dbi_close(m_env, m_dbi);
     mdb_env_close(m_env);
+    pthread_mutex_destroy(&m_lock);
 }
 
 #endif
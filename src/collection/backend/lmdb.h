@@ -22,6 +22,7 @@
 #include <list>
 #include <vector>
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #endif
 
@@ -36,6 +37,7 @@
 
 #include "modsecurity/variable_value.h"
 #include "modsecurity/collection/collection.h"
+#include "src/collection/backend/expiry.h"
 #include "src/variables/variable.h"
 
 #ifndef SRC_COLLECTION_BACKEND_LMDB_H_
@@ -64,8 +66,11 @@ namespace backend {
  * In that way next lmdb requirement be satisfied:
  *
  *   "Use an MDB_env* in the process which opened it, without fork()ing."
+ *
+ * All of the collections live in the one environment, so it is the
+ * provider that sweeps their expired entries.
  */
-class MDBEnvProvider {
+class MDBEnvProvider : public Expiry::Sweeper {
 
  public:
     MDBEnvProvider(MDBEnvProvider &other) = delete;
@@ -85,11 +90,36 @@ class MDBEnvProvider {
     MDB_dbi* GetDBI();
     bool isValid();
 
+    /**
+     * Durability of the write transactions, as set by SecCollectionSyncMode:
+     * 0, MDB_NOMETASYNC or MDB_NOSYNC. There is a single environment per
+     * process, so is the setting.
+     */
+    static void setSyncMode(unsigned int flags);
+    void applySyncMode();
+
+    /**
+     * Milliseconds the writes are gathered for before a committer thread
+     * applies them in a single write transaction, as set by
+     * SecCollectionGroupCommit; 0, the default, writes them right away.
+     */
+    static void setGroupCommit(unsigned int ms);
+    static unsigned int groupCommit() { return m_groupCommit; }
+
+    bool sweep(int64_t now, uint64_t until) override;
+
     ~MDBEnvProvider();
  private:
     MDB_env *m_env;
     MDB_dbi m_dbi;
     bool valid;
+    unsigned int m_syncMode;
+    pthread_mutex_t m_lock;
+    /* deadline key the next sweep starts from, only used by the sweeper */
+    std::string m_sweepFrom;
+
+    static unsigned int m_requestedSyncMode;
+    static std::atomic<unsigned int> m_groupCommit;
 
     MDBEnvProvider();
 };
@@ -108,6 +138,9 @@ class LMDB :
 
     void del(const std::string& key) override;
 
+    bool atomicAdd(const std::string &key, int delta,
+        int *result) override;
+
     std::unique_ptr<std::string> resolveFirst(const std::string& var) override;
 
     void resolveSingleMatch(const std::string& var,
@@ -118,9 +151,31 @@ class LMDB :
     void resolveRegularExpression(const std::string& var,
         std::vector<const VariableValue *> *l,
         variables::KeyExclusions &ke) override;
+    void resolveRegularExpression(const std::string& var,
+        const std::string &compartment, std::vector<const VariableValue *> *l,
+        variables::KeyExclusions &ke) override;
+    void resolveRegularExpression(const std::string& var,
+        const std::string &compartment, const std::string &compartment2,
+        std::vector<const VariableValue *> *l,
+        variables::KeyExclusions &ke) override;
+
+    bool resolveRecord(const std::string &compartment,
+        const std::string &compartment2,
+        std::vector<std::pair<std::string, std::string>> *entries) override;
+
+    /* resolveFirst() leaving aside the writes not committed yet */
+    std::unique_ptr<std::string> resolveStored(const std::string& var);
 
  private:
+    /* The keys starting with prefix whose remainder r matches. */
+    void resolvePrefixedRegularExpression(const std::string &prefix,
+        const Utils::Regex &r, std::vector<const VariableValue *> *l,
+        variables::KeyExclusions &ke);
+
+    int stampExpiry(MDB_txn *txn, const std::string &key, int64_t expires);
     int txn_begin(unsigned int flags, MDB_txn **ret);
+    int read_txn_begin(MDB_txn **ret);
+    void read_txn_end(MDB_txn *txn);
     void string2val(const std::string& str, MDB_val *val);
     void inline lmdb_debug(int rc, const std::string &op, const std::string &scope);
 
@@ -0,0 +1,263 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/collection/backend/record_snapshot.h"
+
+#ifdef __cplusplus
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include <memory>
+#endif
+
+#include "modsecurity/variable_value.h"
+#include "src/utils/regex.h"
+
+
+namespace modsecurity {
+namespace collection {
+namespace backend {
+
+
+RecordSnapshot::RecordSnapshot(Collection *backend,
+    const std::string &compartment, const std::string &compartment2,
+    std::vector<std::pair<std::string, std::string>> *entries) :
+    Collection(backend->m_name),
+    m_backend(backend),
+    m_compartment(compartment),
+    m_compartment2(compartment2),
+    m_prefix(compartment + "::" + compartment2 + "::") {
+    /* the first of the values of a key, as resolveFirst() has it */
+    for (auto &e : *entries) {
+        m_fields.emplace(std::move(e.first), std::move(e.second));
+    }
+}
+
+
+bool RecordSnapshot::isOf(const std::string &compartment,
+    const std::string &compartment2) const {
+    return m_compartment == compartment && m_compartment2 == compartment2;
+}
+
+
+bool RecordSnapshot::fieldOf(const std::string &key,
+    std::string *field) const {
+    if (key.compare(0, m_prefix.size(), m_prefix) != 0) {
+        return false;
+    }
+    field->assign(key, m_prefix.size(), std::string::npos);
+    return true;
+}
+
+
+void RecordSnapshot::set(const std::string &field,
+    const std::string &value) {
+    m_fields[field] = value;
+    m_changes[field].m_operation = Change::SetOperation;
+}
+
+
+void RecordSnapshot::store(std::string key, std::string value) {
+    std::string field;
+
+    if (fieldOf(key, &field) == false) {
+        m_backend->store(std::move(key), std::move(value));
+        return;
+    }
+    set(field, value);
+}
+
+
+bool RecordSnapshot::storeOrUpdateFirst(const std::string &key,
+    const std::string &value) {
+    std::string field;
+
+    if (fieldOf(key, &field) == false) {
+        return m_backend->storeOrUpdateFirst(key, value);
+    }
+    set(field, value);
+    return true;
+}
+
+
+bool RecordSnapshot::updateFirst(const std::string &key,
+    const std::string &value) {
+    std::string field;
+
+    if (fieldOf(key, &field) == false) {
+        return m_backend->updateFirst(key, value);
+    }
+    if (m_fields.count(field) == 0) {
+        return false;
+    }
+    set(field, value);
+    return true;
+}
+
+
+void RecordSnapshot::del(const std::string& key) {
+    std::string field;
+
+    if (fieldOf(key, &field) == false) {
+        m_backend->del(key);
+        return;
+    }
+    m_fields.erase(field);
+    m_changes[field].m_operation = Change::DeleteOperation;
+}
+
+
+/*
+ * Increments in a row stay one: flush() adds them up in the backend. Once
+ * the key was set or deleted its value is known, and is what gets stored.
+ */
+bool RecordSnapshot::atomicAdd(const std::string &key, int delta,
+    int *result) {
+    std::string field;
+    int value = delta;
+
+    if (fieldOf(key, &field) == false) {
+        return m_backend->atomicAdd(key, delta, result);
+    }
+
+    auto it = m_fields.find(field);
+    if (it != m_fields.end()) {
+        value = toInt(it->second) + delta;
+    }
+    m_fields[field] = std::to_string(value);
+
+    auto c = m_changes.find(field);
+    if (c == m_changes.end()) {
+        Change &change = m_changes[field];
+        change.m_operation = Change::AddOperation;
+        change.m_delta = delta;
+    } else if (c->second.m_operation == Change::AddOperation) {
+        c->second.m_delta += delta;
+    } else {
+        c->second.m_operation = Change::SetOperation;
+    }
+
+    if (result != nullptr) {
+        *result = value;
+    }
+    return true;
+}
+
+
+std::unique_ptr<std::string> RecordSnapshot::resolveFirst(
+    const std::string& var) {
+    std::string field;
+
+    if (fieldOf(var, &field) == false) {
+        return m_backend->resolveFirst(var);
+    }
+    auto it = m_fields.find(field);
+    if (it == m_fields.end()) {
+        return nullptr;
+    }
+    return std::unique_ptr<std::string>(new std::string(it->second));
+}
+
+
+void RecordSnapshot::resolveSingleMatch(const std::string& var,
+    std::vector<const VariableValue *> *l) {
+    std::string field;
+
+    if (fieldOf(var, &field) == false) {
+        m_backend->resolveSingleMatch(var, l);
+        return;
+    }
+    auto it = m_fields.find(field);
+    if (it != m_fields.end()) {
+        l->push_back(new VariableValue(&var, &it->second));
+    }
+}
+
+
+/* In the order LMDB has them, backwards. */
+void RecordSnapshot::resolveMultiMatches(const std::string& var,
+    std::vector<const VariableValue *> *l, variables::KeyExclusions &ke) {
+    std::string field;
+
+    if (fieldOf(var, &field) == false) {
+        m_backend->resolveMultiMatches(var, l, ke);
+        return;
+    }
+
+    if (field.empty() == false) {
+        auto it = m_fields.find(field);
+        if (it != m_fields.end() && ke.toOmit(var) == false) {
+            l->push_back(new VariableValue(&m_name, &var, &it->second));
+        }
+        return;
+    }
+
+    for (auto it = m_fields.rbegin(); it != m_fields.rend(); ++it) {
+        std::string key(m_prefix + it->first);
+        if (ke.toOmit(key)) {
+            continue;
+        }
+        l->push_back(new VariableValue(&m_name, &key, &it->second));
+    }
+}
+
+
+void RecordSnapshot::resolveRegularExpression(const std::string& var,
+    std::vector<const VariableValue *> *l, variables::KeyExclusions &ke) {
+    std::string field;
+
+    if (fieldOf(var, &field) == false) {
+        m_backend->resolveRegularExpression(var, l, ke);
+        return;
+    }
+
+    Utils::Regex r(field, true);
+    for (auto it = m_fields.rbegin(); it != m_fields.rend(); ++it) {
+        if (Utils::regex_search(it->first, r) <= 0) {
+            continue;
+        }
+        std::string key(m_prefix + it->first);
+        if (ke.toOmit(key)) {
+            continue;
+        }
+        l->push_back(new VariableValue(&key, &it->second));
+    }
+}
+
+
+void RecordSnapshot::flush() {
+    for (const auto &c : m_changes) {
+        switch (c.second.m_operation) {
+            case Change::SetOperation:
+                m_backend->storeOrUpdateFirst(c.first, m_compartment,
+                    m_compartment2, m_fields[c.first]);
+                break;
+            case Change::DeleteOperation:
+                m_backend->del(c.first, m_compartment, m_compartment2);
+                break;
+            case Change::AddOperation:
+                m_backend->atomicAdd(c.first, m_compartment, m_compartment2,
+                    c.second.m_delta, nullptr);
+                break;
+        }
+    }
+    m_changes.clear();
+}
+
+
+}  // namespace backend
+}  // namespace collection
+}  // namespace modsecurity
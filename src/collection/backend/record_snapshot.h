@@ -0,0 +1,126 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#ifdef __cplusplus
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include <memory>
+#endif
+
+
+#include "modsecurity/variable_value.h"
+#include "modsecurity/collection/collection.h"
+#include "src/variables/variable.h"
+
+#ifndef SRC_COLLECTION_BACKEND_RECORD_SNAPSHOT_H_
+#define SRC_COLLECTION_BACKEND_RECORD_SNAPSHOT_H_
+
+#ifdef __cplusplus
+namespace modsecurity {
+namespace collection {
+namespace backend {
+
+
+/**
+ * Copy of a record of a persistent collection, owned by a transaction.
+ *
+ * Taken when initcol (setsid, setuid, setrsc) picks the record, in one go
+ * from the backend (Collection::resolveRecord), so the lookups that follow
+ * do not go to the backend each. The keys of the record are served from
+ * the copy and the changes to them are kept; flush() writes them back, at
+ * the end of the transaction. Increments are written as such (atomicAdd),
+ * so the ones of concurrent transactions add up; anything else is plainly
+ * stored, the last transaction wins.
+ *
+ * Keys of other records go straight to the backend. As the copy of TX,
+ * nobody else ever sees it: there is no locking.
+ *
+ */
+class RecordSnapshot : public Collection {
+ public:
+    RecordSnapshot(Collection *backend, const std::string &compartment,
+        const std::string &compartment2,
+        std::vector<std::pair<std::string, std::string>> *entries);
+
+    RecordSnapshot(const RecordSnapshot&) = delete;
+    RecordSnapshot& operator=(const RecordSnapshot&) = delete;
+
+    /* A record has a single value per key: store() replaces it. */
+    void store(std::string key, std::string value) override;
+
+    bool storeOrUpdateFirst(const std::string &key,
+        const std::string &value) override;
+
+    bool updateFirst(const std::string &key,
+        const std::string &value) override;
+
+    void del(const std::string& key) override;
+
+    bool atomicAdd(const std::string &key, int delta,
+        int *result) override;
+
+    std::unique_ptr<std::string> resolveFirst(const std::string& var) override;
+
+    void resolveSingleMatch(const std::string& var,
+        std::vector<const VariableValue *> *l) override;
+    void resolveMultiMatches(const std::string& var,
+        std::vector<const VariableValue *> *l,
+        variables::KeyExclusions &ke) override;
+    void resolveRegularExpression(const std::string& var,
+        std::vector<const VariableValue *> *l,
+        variables::KeyExclusions &ke) override;
+
+    bool isOf(const std::string &compartment,
+        const std::string &compartment2) const;
+
+    /* Writes the changes back to the backend. */
+    void flush();
+
+    Collection *backend() const { return m_backend; }
+
+ private:
+    struct Change {
+        enum Operation {
+            SetOperation,
+            DeleteOperation,
+            AddOperation
+        };
+        Operation m_operation;
+        int m_delta;
+    };
+
+    /* The key within the record, if key is one of the record. */
+    bool fieldOf(const std::string &key, std::string *field) const;
+    void set(const std::string &field, const std::string &value);
+
+    Collection *m_backend;
+    std::string m_compartment;
+    std::string m_compartment2;
+    /* compartment::compartment2::, what the keys of the record start with */
+    std::string m_prefix;
+    std::map<std::string, std::string> m_fields;
+    std::map<std::string, Change> m_changes;
+};
+
+
+}  // namespace backend
+}  // namespace collection
+}  // namespace modsecurity
+#endif
+
+
+#endif  // SRC_COLLECTION_BACKEND_RECORD_SNAPSHOT_H_
@@ -0,0 +1,1035 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/collection/backend/redis.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <pthread.h>
+
+#include "modsecurity/variable_value.h"
+#include "src/collection/backend/expiry.h"
+#include "src/collection/backend/redis_protocol.h"
+#include "src/utils/metrics.h"
+#include "src/utils/regex.h"
+#include "src/utils/system.h"
+#include "src/variables/variable.h"
+
+
+namespace modsecurity {
+namespace collection {
+namespace backend {
+
+
+namespace {
+
+/* A server that failed to answer is not asked again before this. */
+const uint64_t kRetryNs = 1000ULL * 1000 * 1000;
+
+/* For how long a fetched record is used before it is fetched again. */
+const uint64_t kFreshNs = 500ULL * 1000 * 1000;
+
+/* Records kept per shard of the cache, and its number of shards. */
+const size_t kMaxRecords = 4096;
+const size_t kShards = 16;
+
+/* Connections kept open between round trips. */
+const size_t kMaxIdle = 8;
+
+/* Writes waiting to be sent, past which they are dropped. */
+const size_t kMaxQueued = 65536;
+
+/* Writes (or fetches) sent in a single round trip. */
+const size_t kBatch = 512;
+
+
+using redis::Command;
+using redis::Fields;
+using redis::Reply;
+
+
+/*
+ * A connection to the server, talking RESP, non blocking: nothing it does
+ * goes on past the deadline (utils::monotonic_ns) it is given.
+ */
+class Connection : public redis::ReplyParser {
+ public:
+    Connection() : m_fd(-1), m_deadline(0) { }
+    ~Connection() {
+        if (m_fd >= 0) {
+            close(m_fd);
+        }
+    }
+
+    Connection(const Connection&) = delete;
+    Connection& operator=(const Connection&) = delete;
+
+    bool open(const sockaddr_storage &addr, socklen_t len,
+        uint64_t deadline);
+    bool execute(const std::vector<Command> &commands,
+        std::vector<Reply> *replies, uint64_t deadline);
+
+ protected:
+    bool fill(std::string *in) override;
+
+ private:
+    bool wait(short events, uint64_t deadline);
+
+    int m_fd;
+    /* of the execute() under way */
+    uint64_t m_deadline;
+};
+
+
+bool Connection::wait(short events, uint64_t deadline) {
+    struct pollfd p;
+    uint64_t now;
+    int rc;
+
+    p.fd = m_fd;
+    p.events = events;
+    do {
+        now = utils::monotonic_ns();
+        if (now >= deadline) {
+            return false;
+        }
+        p.revents = 0;
+        rc = poll(&p, 1, (deadline - now + 999999) / 1000000);
+    } while (rc < 0 && errno == EINTR);
+
+    return rc > 0;
+}
+
+
+bool Connection::open(const sockaddr_storage &addr, socklen_t len,
+    uint64_t deadline) {
+    int one = 1;
+    int err = 0;
+    socklen_t errLen = sizeof(err);
+
+    m_fd = socket(addr.ss_family, SOCK_STREAM, 0);
+    if (m_fd < 0) {
+        return false;
+    }
+    /* not SOCK_NONBLOCK | SOCK_CLOEXEC, which only some systems have */
+    if (fcntl(m_fd, F_SETFD, FD_CLOEXEC) < 0
+        || fcntl(m_fd, F_SETFL, fcntl(m_fd, F_GETFL) | O_NONBLOCK) < 0) {
+        return false;
+    }
+    setsockopt(m_fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    if (connect(m_fd, reinterpret_cast<const sockaddr *>(&addr), len) == 0) {
+        return true;
+    }
+    if (errno != EINPROGRESS || wait(POLLOUT, deadline) == false) {
+        return false;
+    }
+    return getsockopt(m_fd, SOL_SOCKET, SO_ERROR, &err, &errLen) == 0
+        && err == 0;
+}
+
+
+/*
+ * All of the commands go in one write, then all of the replies are read:
+ * a single round trip however many there are.
+ */
+bool Connection::execute(const std::vector<Command> &commands,
+    std::vector<Reply> *replies, uint64_t deadline) {
+    std::string out;
+    size_t sent = 0;
+
+    redis::encode(commands, &out);
+
+    while (sent < out.size()) {
+        ssize_t n = send(m_fd, out.data() + sent, out.size() - sent,
+            MSG_NOSIGNAL);
+        if (n > 0) {
+            sent += n;
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)
+            && wait(POLLOUT, deadline)) {
+            continue;
+        } else {
+            return false;
+        }
+    }
+
+    m_deadline = deadline;
+    replies->clear();
+    replies->resize(commands.size());
+    for (Reply &r : *replies) {
+        if (reply(&r) == false) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+bool Connection::fill(std::string *in) {
+    char buffer[16384];
+
+    while (true) {
+        ssize_t n = recv(m_fd, buffer, sizeof(buffer), 0);
+        if (n > 0) {
+            in->append(buffer, n);
+            return true;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)
+            && wait(POLLIN, m_deadline)) {
+            continue;
+        }
+        return false;
+    }
+}
+
+
+/*
+ * The server of the process, and the connections to it. Never destroyed,
+ * as the writer thread may be using it while the process exits.
+ */
+class Server {
+ public:
+    static Server& getInstance() {
+        static Server *instance = new Server();
+        return *instance;
+    }
+
+    bool configure(const std::string &host, int port,
+        unsigned int timeoutMs, std::string *error);
+
+    /*
+     * False if the server is not set, did not answer in time, or failed
+     * to not long ago.
+     */
+    bool execute(const std::vector<Command> &commands,
+        std::vector<Reply> *replies);
+
+ private:
+    Server();
+
+    static void prepareFork();
+    static void parentFork();
+    static void childFork();
+
+    pthread_mutex_t m_lock;
+    sockaddr_storage m_addr;
+    socklen_t m_addrLen;
+    uint64_t m_timeoutNs;
+    /* bumped by configure(), so the connections to the old one go */
+    uint64_t m_generation;
+    std::vector<std::unique_ptr<Connection>> m_idle;
+    std::atomic<uint64_t> m_retryAt;
+};
+
+
+Server::Server() : m_addrLen(0), m_timeoutNs(0), m_generation(0),
+    m_retryAt(0) {
+    memset(&m_addr, 0, sizeof(m_addr));
+    pthread_mutex_init(&m_lock, NULL);
+    pthread_atfork(prepareFork, parentFork, childFork);
+}
+
+
+bool Server::configure(const std::string &host, int port,
+    unsigned int timeoutMs, std::string *error) {
+    struct addrinfo hints;
+    struct addrinfo *res = NULL;
+    std::string service(std::to_string(port));
+    int rc;
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    rc = getaddrinfo(host.c_str(), service.c_str(), &hints, &res);
+    if (rc != 0 || res == NULL) {
+        error->assign("Failed to resolve the Redis server " + host + ": "
+            + gai_strerror(rc));
+        return false;
+    }
+
+    pthread_mutex_lock(&m_lock);
+    memcpy(&m_addr, res->ai_addr, res->ai_addrlen);
+    m_addrLen = res->ai_addrlen;
+    m_timeoutNs = static_cast<uint64_t>(timeoutMs) * 1000 * 1000;
+    m_generation++;
+    m_idle.clear();
+    m_retryAt.store(0, std::memory_order_relaxed);
+    pthread_mutex_unlock(&m_lock);
+
+    freeaddrinfo(res);
+    return true;
+}
+
+
+bool Server::execute(const std::vector<Command> &commands,
+    std::vector<Reply> *replies) {
+    uint64_t now = utils::monotonic_ns();
+    std::unique_ptr<Connection> c;
+    sockaddr_storage addr;
+    socklen_t len;
+    uint64_t deadline;
+    uint64_t generation;
+    bool ok;
+
+    if (now < m_retryAt.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    pthread_mutex_lock(&m_lock);
+    addr = m_addr;
+    len = m_addrLen;
+    deadline = now + m_timeoutNs;
+    generation = m_generation;
+    if (m_idle.empty() == false) {
+        c = std::move(m_idle.back());
+        m_idle.pop_back();
+    }
+    pthread_mutex_unlock(&m_lock);
+
+    if (len == 0) {
+        return false;
+    }
+
+    Utils::Metrics::Timer timer(Utils::Metrics::RedisOperationsHistogram);
+    if (c == nullptr) {
+        c.reset(new Connection());
+        ok = c->open(addr, len, deadline)
+            && c->execute(commands, replies, deadline);
+    } else {
+        ok = c->execute(commands, replies, deadline);
+    }
+
+    if (ok == false) {
+        m_retryAt.store(utils::monotonic_ns() + kRetryNs,
+            std::memory_order_relaxed);
+        Utils::Metrics::getInstance().increment(
+            Utils::Metrics::RedisErrorsCounter);
+        return false;
+    }
+
+    pthread_mutex_lock(&m_lock);
+    if (generation == m_generation && m_idle.size() < kMaxIdle) {
+        m_idle.push_back(std::move(c));
+    }
+    pthread_mutex_unlock(&m_lock);
+
+    return true;
+}
+
+
+void Server::prepareFork() {
+    pthread_mutex_lock(&getInstance().m_lock);
+}
+
+
+void Server::parentFork() {
+    pthread_mutex_unlock(&getInstance().m_lock);
+}
+
+
+/* The connections stay with the parent; closing them here does not. */
+void Server::childFork() {
+    getInstance().m_idle.clear();
+    pthread_mutex_unlock(&getInstance().m_lock);
+}
+
+
+/*
+ * The copies of the records the process uses, and the writes and fetches
+ * on their way to the server: the request threads never wait for it, the
+ * writer thread does. A field written locally is pending until the server
+ * has it: fetching the record again does not overwrite it in between.
+ */
+class Records {
+ public:
+    static Records& getInstance() {
+        static Records *instance = new Records();
+        return *instance;
+    }
+
+    bool get(const std::string &hash, const std::string &field,
+        std::string *value);
+    void fields(const std::string &hash, Fields *out);
+
+    void set(const std::string &hash, const std::string &field,
+        const std::string &value);
+    bool update(const std::string &hash, const std::string &field,
+        const std::string &value);
+    void del(const std::string &hash, const std::string &field);
+    int add(const std::string &hash, const std::string &field, int delta);
+
+ private:
+    struct Record {
+        Record() : m_fetched(0), m_fetching(false) { }
+        Fields m_fields;
+        std::unordered_map<std::string, unsigned int> m_pending;
+        uint64_t m_fetched;
+        /* a fetch of it is queued, or out */
+        bool m_fetching;
+    };
+
+    struct Shard {
+        std::unordered_map<std::string, Record> m_records;
+        pthread_mutex_t m_lock;
+    };
+
+    struct Write {
+        /* 's'et, 'd'elete or 'i'ncrement, by m_value */
+        char m_op;
+        std::string m_hash;
+        std::string m_field;
+        std::string m_value;
+        /* the SecCollectionTimeout of the rules that wrote it */
+        unsigned int m_timeout;
+    };
+
+    Records();
+
+    Shard &shardOf(const std::string &hash);
+    Record &record(Shard &s, const std::string &hash);
+    Record &load(Shard &s, const std::string &hash, bool *fetch);
+    void evict(Shard &s);
+
+    void queue(Write w);
+    void done(const Write &w, const Reply *reply);
+    void fetch(const std::string &hash);
+    void fetched(const std::string &hash, const Reply *reply);
+    void start();
+    static void *run(void *data);
+
+    static void prepareFork();
+    static void parentFork();
+    static void childFork();
+
+    Shard m_shards[kShards];
+    std::vector<Write> m_queue;
+    std::vector<std::string> m_fetches;
+    bool m_running;
+    pthread_mutex_t m_queueLock;
+    pthread_cond_t m_queueCond;
+};
+
+
+Records::Records() : m_running(false) {
+    for (Shard &s : m_shards) {
+        pthread_mutex_init(&s.m_lock, NULL);
+    }
+    pthread_mutex_init(&m_queueLock, NULL);
+    pthread_cond_init(&m_queueCond, NULL);
+    pthread_atfork(prepareFork, parentFork, childFork);
+}
+
+
+Records::Shard &Records::shardOf(const std::string &hash) {
+    return m_shards[std::hash<std::string>()(hash) % kShards];
+}
+
+
+/* With the lock of s held. */
+Records::Record &Records::record(Shard &s, const std::string &hash) {
+    if (s.m_records.size() >= kMaxRecords && s.m_records.count(hash) == 0) {
+        evict(s);
+    }
+    return s.m_records[hash];
+}
+
+
+/*
+ * With the lock of s held: the copy as it is, with fetch set if the
+ * record is due to be fetched again, for the caller to queue it once the
+ * lock is let go. A record not seen before looks empty until it is back,
+ * as all of them do while the server is down.
+ */
+Records::Record &Records::load(Shard &s, const std::string &hash,
+    bool *fetch) {
+    uint64_t now = utils::monotonic_ns();
+    Record &r = record(s, hash);
+
+    *fetch = r.m_fetching == false && now - r.m_fetched >= kFreshNs;
+    if (*fetch) {
+        r.m_fetching = true;
+    }
+    return r;
+}
+
+
+/* The records not written to, the old ones first. */
+void Records::evict(Shard &s) {
+    uint64_t now = utils::monotonic_ns();
+
+    for (auto it = s.m_records.begin(); it != s.m_records.end();) {
+        if (it->second.m_pending.empty()
+            && now - it->second.m_fetched >= kFreshNs) {
+            it = s.m_records.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto it = s.m_records.begin(); it != s.m_records.end()
+        && s.m_records.size() >= kMaxRecords;) {
+        if (it->second.m_pending.empty()) {
+            it = s.m_records.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+
+bool Records::get(const std::string &hash, const std::string &field,
+    std::string *value) {
+    Shard &s = shardOf(hash);
+    bool found = false;
+    bool due;
+
+    pthread_mutex_lock(&s.m_lock);
+    Record &r = load(s, hash, &due);
+    auto it = r.m_fields.find(field);
+    if (it != r.m_fields.end()) {
+        value->assign(it->second);
+        found = true;
+    }
+    pthread_mutex_unlock(&s.m_lock);
+
+    if (due) {
+        fetch(hash);
+    }
+    return found;
+}
+
+
+void Records::fields(const std::string &hash, Fields *out) {
+    Shard &s = shardOf(hash);
+    bool due;
+
+    pthread_mutex_lock(&s.m_lock);
+    *out = load(s, hash, &due).m_fields;
+    pthread_mutex_unlock(&s.m_lock);
+
+    if (due) {
+        fetch(hash);
+    }
+}
+
+
+void Records::set(const std::string &hash, const std::string &field,
+    const std::string &value) {
+    Shard &s = shardOf(hash);
+
+    pthread_mutex_lock(&s.m_lock);
+    Record &r = record(s, hash);
+    r.m_fields[field] = value;
+    r.m_pending[field]++;
+    pthread_mutex_unlock(&s.m_lock);
+
+    queue(Write{'s', hash, field, value});
+}
+
+
+bool Records::update(const std::string &hash, const std::string &field,
+    const std::string &value) {
+    Shard &s = shardOf(hash);
+    bool due;
+
+    pthread_mutex_lock(&s.m_lock);
+    Record &r = load(s, hash, &due);
+    auto it = r.m_fields.find(field);
+    if (it == r.m_fields.end()) {
+        pthread_mutex_unlock(&s.m_lock);
+        if (due) {
+            fetch(hash);
+        }
+        return false;
+    }
+    it->second = value;
+    r.m_pending[field]++;
+    pthread_mutex_unlock(&s.m_lock);
+
+    if (due) {
+        fetch(hash);
+    }
+    queue(Write{'s', hash, field, value});
+    return true;
+}
+
+
+void Records::del(const std::string &hash, const std::string &field) {
+    Shard &s = shardOf(hash);
+
+    pthread_mutex_lock(&s.m_lock);
+    Record &r = record(s, hash);
+    r.m_fields.erase(field);
+    r.m_pending[field]++;
+    pthread_mutex_unlock(&s.m_lock);
+
+    queue(Write{'d', hash, field, ""});
+}
+
+
+/*
+ * The sum is worked out from the copy, so it is right for this process;
+ * the server gets the delta, and the total of all of the hosts comes back
+ * from it.
+ */
+int Records::add(const std::string &hash, const std::string &field,
+    int delta) {
+    Shard &s = shardOf(hash);
+    int value;
+    bool due;
+
+    pthread_mutex_lock(&s.m_lock);
+    Record &r = load(s, hash, &due);
+    std::string &current = r.m_fields[field];
+    value = Collection::toInt(current) + delta;
+    current = std::to_string(value);
+    r.m_pending[field]++;
+    pthread_mutex_unlock(&s.m_lock);
+
+    if (due) {
+        fetch(hash);
+    }
+    queue(Write{'i', hash, field, std::to_string(delta)});
+    return value;
+}
+
+
+void Records::queue(Write w) {
+    w.m_timeout = Expiry::getInstance().timeout();
+    pthread_mutex_lock(&m_queueLock);
+    if (m_running == false) {
+        start();
+    }
+    if (m_queue.size() >= kMaxQueued) {
+        pthread_mutex_unlock(&m_queueLock);
+        done(w, nullptr);
+        return;
+    }
+    m_queue.push_back(std::move(w));
+    pthread_cond_signal(&m_queueCond);
+    pthread_mutex_unlock(&m_queueLock);
+}
+
+
+/* The server has the write, or never will if reply is null. */
+void Records::done(const Write &w, const Reply *reply) {
+    Shard &s = shardOf(w.m_hash);
+
+    if (reply == nullptr) {
+        Utils::Metrics::getInstance().increment(
+            Utils::Metrics::RedisDroppedWritesCounter);
+    }
+
+    pthread_mutex_lock(&s.m_lock);
+    auto it = s.m_records.find(w.m_hash);
+    if (it != s.m_records.end()) {
+        Record &r = it->second;
+        auto p = r.m_pending.find(w.m_field);
+        if (p != r.m_pending.end() && --p->second == 0) {
+            r.m_pending.erase(p);
+            if (reply != nullptr && w.m_op == 'i' && reply->m_type == ':') {
+                r.m_fields[w.m_field] = std::to_string(reply->m_integer);
+            }
+        }
+        if (reply == nullptr) {
+            r.m_fetched = 0;
+        }
+    }
+    pthread_mutex_unlock(&s.m_lock);
+}
+
+
+/* Sent by the writer thread, after the writes queued before it. */
+void Records::fetch(const std::string &hash) {
+    pthread_mutex_lock(&m_queueLock);
+    if (m_running == false) {
+        start();
+    }
+    if (m_fetches.size() >= kMaxQueued) {
+        pthread_mutex_unlock(&m_queueLock);
+        fetched(hash, nullptr);
+        return;
+    }
+    m_fetches.push_back(hash);
+    pthread_cond_signal(&m_queueCond);
+    pthread_mutex_unlock(&m_queueLock);
+}
+
+
+/* The record is back from the server, or is not coming if reply is null. */
+void Records::fetched(const std::string &hash, const Reply *reply) {
+    Shard &s = shardOf(hash);
+
+    pthread_mutex_lock(&s.m_lock);
+    Record &r = record(s, hash);
+    if (reply != nullptr && reply->m_type == '*') {
+        const std::vector<Reply> &e = reply->m_elements;
+        Fields fields;
+        for (size_t i = 0; i + 1 < e.size(); i += 2) {
+            fields[e[i].m_string] = e[i + 1].m_string;
+        }
+        redis::merge(&fields, r.m_fields, r.m_pending);
+        r.m_fields.swap(fields);
+    }
+    /* as fetched even if it failed, the next try is on the next round */
+    r.m_fetched = utils::monotonic_ns();
+    r.m_fetching = false;
+    pthread_mutex_unlock(&s.m_lock);
+}
+
+
+/* With m_queueLock held. Not retried if it fails, writes then pile up. */
+void Records::start() {
+    pthread_t thread;
+    pthread_attr_t attr;
+
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    pthread_create(&thread, &attr, run, this);
+    pthread_attr_destroy(&attr);
+    m_running = true;
+}
+
+
+/*
+ * Whatever was queued while the last batch was out goes in the next one,
+ * in order, with an EXPIRE of every record written to; then the records
+ * to fetch, so they come back with those writes.
+ */
+void *Records::run(void *data) {
+    Records *records = reinterpret_cast<Records *>(data);
+    std::vector<Write> writes;
+    std::vector<std::string> fetches;
+    std::vector<Command> commands;
+    std::vector<std::pair<std::string, unsigned int>> hashes;
+    std::vector<Reply> replies;
+
+    while (true) {
+        pthread_mutex_lock(&records->m_queueLock);
+        while (records->m_queue.empty() && records->m_fetches.empty()) {
+            pthread_cond_wait(&records->m_queueCond, &records->m_queueLock);
+        }
+        writes.clear();
+        writes.swap(records->m_queue);
+        fetches.clear();
+        fetches.swap(records->m_fetches);
+        pthread_mutex_unlock(&records->m_queueLock);
+
+        for (size_t first = 0; first < writes.size(); first += kBatch) {
+            size_t last = std::min(first + kBatch, writes.size());
+
+            commands.clear();
+            hashes.clear();
+            for (size_t i = first; i < last; i++) {
+                const Write &w = writes[i];
+                if (w.m_op == 'i') {
+                    commands.push_back({"HINCRBY", w.m_hash, w.m_field,
+                        w.m_value});
+                } else if (w.m_op == 's') {
+                    commands.push_back({"HSET", w.m_hash, w.m_field,
+                        w.m_value});
+                } else {
+                    commands.push_back({"HDEL", w.m_hash, w.m_field});
+                }
+                if (w.m_timeout != 0) {
+                    hashes.push_back(std::make_pair(w.m_hash, w.m_timeout));
+                }
+            }
+            /* The last write to a record in the batch sets its expiry. */
+            std::stable_sort(hashes.begin(), hashes.end(),
+                [](const std::pair<std::string, unsigned int> &a,
+                    const std::pair<std::string, unsigned int> &b) {
+                    return a.first < b.first;
+                });
+            for (size_t i = 0; i < hashes.size(); i++) {
+                if (i + 1 < hashes.size()
+                    && hashes[i + 1].first == hashes[i].first) {
+                    continue;
+                }
+                commands.push_back({"EXPIRE", hashes[i].first,
+                    std::to_string(hashes[i].second)});
+            }
+
+            bool ok = Server::getInstance().execute(commands, &replies);
+            for (size_t i = first; i < last; i++) {
+                records->done(writes[i], ok ? &replies[i - first] : nullptr);
+            }
+        }
+
+        for (size_t first = 0; first < fetches.size(); first += kBatch) {
+            size_t last = std::min(first + kBatch, fetches.size());
+
+            commands.clear();
+            for (size_t i = first; i < last; i++) {
+                commands.push_back({"HGETALL", fetches[i]});
+            }
+
+            bool ok = Server::getInstance().execute(commands, &replies);
+            for (size_t i = first; i < last; i++) {
+                records->fetched(fetches[i],
+                    ok ? &replies[i - first] : nullptr);
+            }
+        }
+    }
+
+    return NULL;
+}
+
+
+void Records::prepareFork() {
+    Records &r = getInstance();
+
+    pthread_mutex_lock(&r.m_queueLock);
+    for (Shard &s : r.m_shards) {
+        pthread_mutex_lock(&s.m_lock);
+    }
+}
+
+
+void Records::parentFork() {
+    Records &r = getInstance();
+
+    for (Shard &s : r.m_shards) {
+        pthread_mutex_unlock(&s.m_lock);
+    }
+    pthread_mutex_unlock(&r.m_queueLock);
+}
+
+
+/*
+ * The queued writes are the parent's to send, and the copies have them
+ * pending: the child starts afresh, with a writer of its own.
+ */
+void Records::childFork() {
+    Records &r = getInstance();
+
+    for (Shard &s : r.m_shards) {
+        s.m_records.clear();
+        pthread_mutex_unlock(&s.m_lock);
+    }
+    r.m_queue.clear();
+    r.m_fetches.clear();
+    r.m_running = false;
+    pthread_mutex_unlock(&r.m_queueLock);
+}
+
+}  // namespace
+
+
+Redis::Redis(const std::string &name) :
+    Collection(name), m_prefix("modsec:" + name + ":") { }
+
+
+bool Redis::setServer(const std::string &host, int port,
+    unsigned int timeoutMs, std::string *error) {
+    return Server::getInstance().configure(host, port, timeoutMs, error);
+}
+
+
+/*
+ * The record is what comes before the last "::", the compartments the
+ * key was made of (an IPv6 address has some of its own).
+ */
+std::string Redis::hashOf(const std::string &key, std::string *field) const {
+    size_t pos = key.rfind("::");
+
+    if (pos == std::string::npos) {
+        field->assign(key);
+        return m_prefix;
+    }
+    field->assign(key, pos + 2, std::string::npos);
+    return m_prefix + key.substr(0, pos);
+}
+
+
+void Redis::store(std::string key, std::string value) {
+    std::string field;
+    std::string hash = hashOf(key, &field);
+
+    Records::getInstance().set(hash, field, value);
+}
+
+
+bool Redis::storeOrUpdateFirst(const std::string &key,
+    const std::string &value) {
+    std::string field;
+    std::string hash = hashOf(key, &field);
+
+    Records::getInstance().set(hash, field, value);
+    return true;
+}
+
+
+bool Redis::updateFirst(const std::string &key,
+    const std::string &value) {
+    std::string field;
+    std::string hash = hashOf(key, &field);
+
+    return Records::getInstance().update(hash, field, value);
+}
+
+
+void Redis::del(const std::string& key) {
+    std::string field;
+    std::string hash = hashOf(key, &field);
+
+    Records::getInstance().del(hash, field);
+}
+
+
+bool Redis::atomicAdd(const std::string &key, int delta, int *result) {
+    std::string field;
+    std::string hash = hashOf(key, &field);
+    int value = Records::getInstance().add(hash, field, delta);
+
+    if (result != nullptr) {
+        *result = value;
+    }
+    return true;
+}
+
+
+std::unique_ptr<std::string> Redis::resolveFirst(const std::string& var) {
+    std::string field;
+    std::string hash = hashOf(var, &field);
+    std::unique_ptr<std::string> value(new std::string());
+
+    if (Records::getInstance().get(hash, field, value.get()) == false) {
+        return nullptr;
+    }
+    return value;
+}
+
+
+void Redis::resolveSingleMatch(const std::string& var,
+    std::vector<const VariableValue *> *l) {
+    std::string field;
+    std::string hash = hashOf(var, &field);
+    std::string value;
+
+    if (Records::getInstance().get(hash, field, &value)) {
+        l->push_back(new VariableValue(&var, &value));
+    }
+}
+
+
+/* var ends with "::" for the whole record. */
+void Redis::resolveMultiMatches(const std::string& var,
+    std::vector<const VariableValue *> *l, variables::KeyExclusions &ke) {
+    std::string field;
+    std::string hash = hashOf(var, &field);
+
+    if (field.empty() == false) {
+        std::string value;
+        if (ke.toOmit(var) == false
+            && Records::getInstance().get(hash, field, &value)) {
+            l->push_back(new VariableValue(&m_name, &var, &value));
+        }
+        return;
+    }
+
+    Fields fields;
+    Records::getInstance().fields(hash, &fields);
+    for (const auto &f : fields) {
+        std::string key(var + f.first);
+        if (ke.toOmit(key)) {
+            continue;
+        }
+        l->push_back(new VariableValue(&m_name, &key, &f.second));
+    }
+}
+
+
+void Redis::resolveRegularExpression(const std::string& var,
+    std::vector<const VariableValue *> *l, variables::KeyExclusions &ke) {
+    resolveFields("", var, l, ke);
+}
+
+
+void Redis::resolveRegularExpression(const std::string& var,
+    const std::string &compartment, std::vector<const VariableValue *> *l,
+    variables::KeyExclusions &ke) {
+    resolveFields(compartment, var, l, ke);
+}
+
+
+void Redis::resolveRegularExpression(const std::string& var,
+    const std::string &compartment, const std::string &compartment2,
+    std::vector<const VariableValue *> *l, variables::KeyExclusions &ke) {
+    resolveFields(compartment + "::" + compartment2, var, l, ke);
+}
+
+
+/* The copy there is, see Records::load(). */
+bool Redis::resolveRecord(const std::string &compartment,
+    const std::string &compartment2,
+    std::vector<std::pair<std::string, std::string>> *entries) {
+    Fields fields;
+
+    Records::getInstance().fields(m_prefix + compartment + "::"
+        + compartment2, &fields);
+    for (auto &f : fields) {
+        entries->emplace_back(f.first, std::move(f.second));
+    }
+    return true;
+}
+
+
+/* The fields of record whose name matches the regular expression var. */
+void Redis::resolveFields(const std::string &record, const std::string &var,
+    std::vector<const VariableValue *> *l, variables::KeyExclusions &ke) {
+    Utils::Regex r(var, true);
+    Fields fields;
+
+    Records::getInstance().fields(m_prefix + record, &fields);
+    for (const auto &f : fields) {
+        if (Utils::regex_search(f.first, r) <= 0) {
+            continue;
+        }
+        std::string key(record.empty() ? f.first : record + "::" + f.first);
+        if (ke.toOmit(key)) {
+            continue;
+        }
+        l->push_back(new VariableValue(&key, &f.second));
+    }
+}
+
+
+}  // namespace backend
+}  // namespace collection
+}  // namespace modsecurity
@@ -0,0 +1,123 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#ifdef __cplusplus
+#include <string>
+#include <utility>
+#include <vector>
+#include <memory>
+#endif
+
+#include "modsecurity/variable_value.h"
+#include "modsecurity/collection/collection.h"
+#include "src/variables/variable.h"
+
+#ifndef SRC_COLLECTION_BACKEND_REDIS_H_
+#define SRC_COLLECTION_BACKEND_REDIS_H_
+
+#ifdef __cplusplus
+namespace modsecurity {
+namespace collection {
+namespace backend {
+
+
+/**
+ * Persistent collection kept in a Redis server, as set by
+ * SecCollectionRedisServer, so several hosts can share it.
+ *
+ * A record (the compartments of the key: IP address, web application id)
+ * is a Redis hash, "modsec:<collection>:<record>", its variables are the
+ * fields. The process keeps a copy of the records it uses, fetched whole
+ * (HGETALL) in the background and fetched again every half a second or
+ * so while it is in use. Lookups only read that copy and never wait for
+ * the server: a record not seen before looks empty until its first fetch
+ * is back, a round trip later.
+ *
+ * Writes are applied to that copy right away and sent in the background:
+ * HSET, HDEL and the counters as HINCRBY, pipelined with the writes of the
+ * other transactions, and an EXPIRE of the record when
+ * SecCollectionTimeout is set.
+ *
+ * Every round trip is bounded by the timeout of the directive; a server
+ * that fails to answer in time is left alone for a second, during which
+ * the records look empty (or as they were last seen) and the writes are
+ * dropped. Keys only have one value: store() replaces it.
+ *
+ */
+class Redis : public Collection {
+ public:
+    explicit Redis(const std::string &name);
+
+    void store(std::string key, std::string value) override;
+
+    bool storeOrUpdateFirst(const std::string &key,
+        const std::string &value) override;
+
+    bool updateFirst(const std::string &key,
+        const std::string &value) override;
+
+    void del(const std::string& key) override;
+
+    bool atomicAdd(const std::string &key, int delta,
+        int *result) override;
+
+    std::unique_ptr<std::string> resolveFirst(const std::string& var) override;
+
+    void resolveSingleMatch(const std::string& var,
+        std::vector<const VariableValue *> *l) override;
+    void resolveMultiMatches(const std::string& var,
+        std::vector<const VariableValue *> *l,
+        variables::KeyExclusions &ke) override;
+    void resolveRegularExpression(const std::string& var,
+        std::vector<const VariableValue *> *l,
+        variables::KeyExclusions &ke) override;
+    void resolveRegularExpression(const std::string& var,
+        const std::string &compartment, std::vector<const VariableValue *> *l,
+        variables::KeyExclusions &ke) override;
+    void resolveRegularExpression(const std::string& var,
+        const std::string &compartment, const std::string &compartment2,
+        std::vector<const VariableValue *> *l,
+        variables::KeyExclusions &ke) override;
+
+    bool resolveRecord(const std::string &compartment,
+        const std::string &compartment2,
+        std::vector<std::pair<std::string, std::string>> *entries) override;
+
+    /**
+     * Server of all of the Redis collections of the process. host is
+     * resolved here, not on the request path. Returns false, with error
+     * set, if it can not be.
+     */
+    static bool setServer(const std::string &host, int port,
+        unsigned int timeoutMs, std::string *error);
+
+ private:
+    /* Splits key into the Redis hash of its record and the field. */
+    std::string hashOf(const std::string &key, std::string *field) const;
+
+    void resolveFields(const std::string &record, const std::string &var,
+        std::vector<const VariableValue *> *l, variables::KeyExclusions &ke);
+
+    std::string m_prefix;
+};
+
+
+}  // namespace backend
+}  // namespace collection
+}  // namespace modsecurity
+#endif
+
+
+#endif  // SRC_COLLECTION_BACKEND_REDIS_H_
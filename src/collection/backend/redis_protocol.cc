@@ -0,0 +1,150 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/collection/backend/redis_protocol.h"
+
+#include <stdlib.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+namespace modsecurity {
+namespace collection {
+namespace backend {
+namespace redis {
+
+
+void encode(const std::vector<Command> &commands, std::string *out) {
+    for (const Command &c : commands) {
+        out->append("*" + std::to_string(c.size()) + "\r\n");
+        for (const std::string &arg : c) {
+            out->append("$" + std::to_string(arg.size()) + "\r\n");
+            out->append(arg);
+            out->append("\r\n");
+        }
+    }
+}
+
+
+bool ReplyParser::reply(Reply *out) {
+    return reply(out, 0);
+}
+
+
+/* What was parsed already goes, before more is read. */
+bool ReplyParser::more() {
+    m_in.erase(0, m_pos);
+    m_pos = 0;
+    return fill(&m_in);
+}
+
+
+bool ReplyParser::line(std::string *out) {
+    /* what follows m_pos with no end of line in it */
+    size_t scanned = 0;
+    size_t end;
+
+    while ((end = m_in.find("\r\n", m_pos + scanned)) == std::string::npos) {
+        /* but for the last byte, it may be the \r */
+        scanned = m_in.size() - m_pos > 0 ? m_in.size() - m_pos - 1 : 0;
+        if (more() == false) {
+            return false;
+        }
+    }
+    out->assign(m_in, m_pos, end - m_pos);
+    m_pos = end + 2;
+    return true;
+}
+
+
+bool ReplyParser::reply(Reply *out, int depth) {
+    std::string l;
+    char *end;
+    long long n;
+
+    if (depth > kMaxDepth || line(&l) == false || l.empty()) {
+        return false;
+    }
+
+    out->m_type = l[0];
+    switch (l[0]) {
+        case '+':
+        case '-':
+            out->m_string = l.substr(1);
+            return true;
+        case ':':
+            out->m_integer = strtoll(l.c_str() + 1, &end, 10);
+            return end != l.c_str() + 1 && *end == '\0';
+        case '$':
+            n = strtoll(l.c_str() + 1, &end, 10);
+            if (end == l.c_str() + 1 || *end != '\0' || n > kMaxBulk) {
+                return false;
+            }
+            if (n < 0) {
+                out->m_type = 0;
+                return true;
+            }
+            while (m_in.size() - m_pos < static_cast<size_t>(n) + 2) {
+                if (more() == false) {
+                    return false;
+                }
+            }
+            if (m_in.compare(m_pos + n, 2, "\r\n") != 0) {
+                return false;
+            }
+            out->m_string.assign(m_in, m_pos, n);
+            m_pos += n + 2;
+            return true;
+        case '*':
+            n = strtoll(l.c_str() + 1, &end, 10);
+            if (end == l.c_str() + 1 || *end != '\0' || n > kMaxElements) {
+                return false;
+            }
+            if (n < 0) {
+                out->m_type = 0;
+                return true;
+            }
+            out->m_elements.resize(n);
+            for (Reply &e : out->m_elements) {
+                if (reply(&e, depth + 1) == false) {
+                    return false;
+                }
+            }
+            return true;
+        default:
+            return false;
+    }
+}
+
+
+void merge(Fields *fetched, const Fields &local,
+    const std::unordered_map<std::string, unsigned int> &pending) {
+    for (const auto &p : pending) {
+        auto l = local.find(p.first);
+        if (l == local.end()) {
+            fetched->erase(p.first);
+        } else {
+            (*fetched)[p.first] = l->second;
+        }
+    }
+}
+
+
+}  // namespace redis
+}  // namespace backend
+}  // namespace collection
+}  // namespace modsecurity
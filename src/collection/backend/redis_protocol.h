@@ -0,0 +1,102 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#ifdef __cplusplus
+#include <string>
+#include <unordered_map>
+#include <vector>
+#endif
+
+#ifndef SRC_COLLECTION_BACKEND_REDIS_PROTOCOL_H_
+#define SRC_COLLECTION_BACKEND_REDIS_PROTOCOL_H_
+
+#ifdef __cplusplus
+namespace modsecurity {
+namespace collection {
+namespace backend {
+namespace redis {
+
+
+typedef std::vector<std::string> Command;
+typedef std::unordered_map<std::string, std::string> Fields;
+
+
+/* Bounds of what is taken from the server in a reply. */
+const long long kMaxBulk = 16 * 1024 * 1024;
+const long long kMaxElements = 1024 * 1024;
+const int kMaxDepth = 2;
+
+
+struct Reply {
+    Reply() : m_type(0), m_integer(0) { }
+
+    /* '+', '-', ':', '$' or '*' as in the protocol, 0 for nil */
+    char m_type;
+    long long m_integer;
+    std::string m_string;
+    std::vector<Reply> m_elements;
+};
+
+
+/* Appends the commands to out, each an array of bulk strings (RESP). */
+void encode(const std::vector<Command> &commands, std::string *out);
+
+
+/**
+ * Reads the replies of the server (RESP) off what fill() gives it, as it
+ * comes: nothing is parsed twice however small the pieces are.
+ */
+class ReplyParser {
+ public:
+    ReplyParser() : m_pos(0) { }
+    virtual ~ReplyParser() { }
+
+    /**
+     * The next reply; false if the input ends before it does, or is not
+     * RESP, or goes past the bounds above.
+     */
+    bool reply(Reply *out);
+
+ protected:
+    /* Appends more of the input to in; false if there is none. */
+    virtual bool fill(std::string *in) = 0;
+
+ private:
+    bool more();
+    bool line(std::string *out);
+    bool reply(Reply *out, int depth);
+
+    std::string m_in;
+    size_t m_pos;
+};
+
+
+/**
+ * The fields of a record as fetched (HGETALL), the ones written locally
+ * and not yet acknowledged by the server (pending) taken from the local
+ * copy instead: a fetch that went out before a write does not undo it.
+ */
+void merge(Fields *fetched, const Fields &local,
+    const std::unordered_map<std::string, unsigned int> &pending);
+
+
+}  // namespace redis
+}  // namespace backend
+}  // namespace collection
+}  // namespace modsecurity
+#endif
+
+
+#endif  // SRC_COLLECTION_BACKEND_REDIS_PROTOCOL_H_
@@ -0,0 +1,556 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/collection/backend/shared_memory.h"
+
+#ifdef __cplusplus
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <memory>
+#include <vector>
+#endif
+
+#include <errno.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "modsecurity/anchored_set_variable.h"
+#include "modsecurity/variable_value.h"
+#include "src/utils/regex.h"
+#include "src/utils/metrics.h"
+
+
+namespace modsecurity {
+namespace collection {
+namespace backend {
+
+
+const size_t SharedMemory::kSlots;
+const size_t SharedMemory::kProbes;
+const size_t SharedMemory::kKeySize;
+const size_t SharedMemory::kValueSize;
+const int64_t SharedMemory::kTimeout;
+const size_t SharedMemory::kStripes;
+const size_t SharedMemory::kStripeChecks;
+
+
+namespace {
+
+const uint8_t kSlotEmpty = 0;
+const uint8_t kSlotUsed = 1;
+const uint8_t kSlotDeleted = 2;
+
+
+uint32_t hashOf(const std::string &key) {
+    uint64_t h = MyHash()(key);
+    return static_cast<uint32_t>(h ^ (h >> 32));
+}
+
+}  // namespace
+
+
+/*
+ * The anonymous mapping comes zero filled, which is a valid empty slot
+ * (sequence 0, kSlotEmpty) and an unlocked stripe; pages are only backed
+ * once touched. The stripes follow the slots.
+ */
+SharedMemory::SharedMemory(const std::string &name) :
+    Collection(name),
+    m_size(sizeof(Slot) * kSlots + sizeof(std::atomic<uint32_t>) * kStripes),
+    m_slots(NULL),
+    m_stripes(NULL) {
+    void *m = mmap(NULL, m_size, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (m != MAP_FAILED) {
+        m_slots = static_cast<Slot *>(m);
+        m_stripes = reinterpret_cast<std::atomic<uint32_t> *>(
+            m_slots + kSlots);
+    }
+}
+
+
+SharedMemory::~SharedMemory() {
+    if (m_slots != NULL) {
+        munmap(m_slots, m_size);
+        m_slots = NULL;
+        m_stripes = NULL;
+    }
+}
+
+
+/*
+ * A stripe holds the pid of the process that has it, 0 when it is free.
+ * A worker may die while holding one (it is only held for an insertion,
+ * but a worker can be killed anywhere): every kStripeChecks turns the
+ * waiters look whether the holder is still there, and the first one to
+ * find it gone takes the stripe over. A dead holder whose pid was already
+ * given to another process is not noticed until that one exits.
+ */
+void SharedMemory::lockStripe(uint32_t hash) {
+    std::atomic<uint32_t> *stripe = &m_stripes[hash % kStripes];
+    uint32_t self = static_cast<uint32_t>(getpid());
+
+    for (size_t turn = 1;; turn++) {
+        uint32_t owner = stripe->load(std::memory_order_relaxed);
+        if (owner == 0 && stripe->compare_exchange_weak(owner, self,
+            std::memory_order_acquire)) {
+            return;
+        }
+        if (owner != 0 && turn % kStripeChecks == 0
+            && kill(static_cast<pid_t>(owner), 0) != 0 && errno == ESRCH
+            && stripe->compare_exchange_strong(owner, self,
+            std::memory_order_acquire)) {
+            return;
+        }
+        sched_yield();
+    }
+}
+
+
+void SharedMemory::unlockStripe(uint32_t hash) {
+    m_stripes[hash % kStripes].store(0, std::memory_order_release);
+}
+
+
+void SharedMemory::read(const Slot *slot, Entry *e) {
+    for (;;) {
+        uint32_t seq = slot->m_sequence.load(std::memory_order_acquire);
+        if (seq & 1) {
+            sched_yield();
+            continue;
+        }
+
+        e->m_state = slot->m_state;
+        e->m_hash = slot->m_hash;
+        e->m_expires = slot->m_expires;
+        if (e->m_state == kSlotUsed) {
+            e->m_key.assign(slot->m_key,
+                std::min<size_t>(slot->m_keyLength, kKeySize));
+            e->m_value.assign(slot->m_value,
+                std::min<size_t>(slot->m_valueLength, kValueSize));
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->m_sequence.load(std::memory_order_relaxed) == seq) {
+            return;
+        }
+    }
+}
+
+
+void SharedMemory::lock(Slot *slot) {
+    for (;;) {
+        uint32_t seq = slot->m_sequence.load(std::memory_order_relaxed);
+        if ((seq & 1) == 0 && slot->m_sequence.compare_exchange_weak(seq,
+            seq + 1, std::memory_order_acquire)) {
+            return;
+        }
+        sched_yield();
+    }
+}
+
+
+void SharedMemory::unlock(Slot *slot) {
+    slot->m_sequence.fetch_add(1, std::memory_order_release);
+}
+
+
+bool SharedMemory::isLive(const Entry &e, int64_t now) {
+    return e.m_state == kSlotUsed && e.m_expires > now;
+}
+
+
+bool SharedMemory::matches(const Entry &e, uint32_t hash,
+    const std::string &key, int64_t now) {
+    return isLive(e, now) && e.m_hash == hash && MyEqual()(e.m_key, key);
+}
+
+
+/* Same as matches(), for a slot locked by the caller. */
+bool SharedMemory::holds(const Slot *slot, uint32_t hash,
+    const std::string &key, int64_t now) {
+    if (slot->m_state != kSlotUsed || slot->m_expires <= now
+        || slot->m_hash != hash || slot->m_keyLength != key.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < key.size(); i++) {
+        if (foldCase(slot->m_key[i]) != foldCase(key[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+void SharedMemory::write(Slot *slot, uint32_t hash, const std::string &key,
+    const std::string &value, int64_t now) {
+    slot->m_state = kSlotUsed;
+    slot->m_hash = hash;
+    slot->m_expires = now + kTimeout;
+    slot->m_keyLength = static_cast<uint8_t>(key.size());
+    slot->m_valueLength = static_cast<uint16_t>(value.size());
+    memcpy(slot->m_key, key.c_str(), key.size());
+    memcpy(slot->m_value, value.c_str(), value.size());
+}
+
+
+bool SharedMemory::fits(const std::string &key, const std::string &value) {
+    if (m_slots == NULL) {
+        return false;
+    }
+    if (key.size() > kKeySize || value.size() > kValueSize) {
+        /* no transaction to log it for here, only counted */
+        Utils::Metrics::getInstance().increment(
+            Utils::Metrics::SharedMemoryDroppedWritesCounter);
+        return false;
+    }
+    return true;
+}
+
+
+/*
+ * Entries are always inserted before the first never used slot of their
+ * probe window, so the lookups can stop there.
+ */
+bool SharedMemory::update(const std::string &key, const std::string &value) {
+    uint32_t hash = hashOf(key);
+    int64_t now = time(NULL);
+    Entry e;
+
+    for (size_t i = 0; i < kProbes; i++) {
+        Slot *slot = &m_slots[(hash + i) % kSlots];
+        read(slot, &e);
+        if (e.m_state == kSlotEmpty) {
+            break;
+        }
+        if (matches(e, hash, key, now) == false) {
+            continue;
+        }
+        lock(slot);
+        if (holds(slot, hash, key, now)) {
+            write(slot, hash, key, value, now);
+            unlock(slot);
+            return true;
+        }
+        unlock(slot);
+    }
+
+    return false;
+}
+
+
+void SharedMemory::insert(const std::string &key, const std::string &value) {
+    uint32_t hash = hashOf(key);
+    int64_t now = time(NULL);
+    Slot *oldest = NULL;
+    int64_t oldestExpires = 0;
+    Entry e;
+
+    for (size_t i = 0; i < kProbes; i++) {
+        Slot *slot = &m_slots[(hash + i) % kSlots];
+        read(slot, &e);
+        if (isLive(e, now) == false) {
+            lock(slot);
+            if (slot->m_state != kSlotUsed || slot->m_expires <= now) {
+                write(slot, hash, key, value, now);
+                unlock(slot);
+                return;
+            }
+            unlock(slot);
+            continue;
+        }
+        if (oldest == NULL || e.m_expires < oldestExpires) {
+            oldest = slot;
+            oldestExpires = e.m_expires;
+        }
+    }
+
+    /* the whole window is in use: evict the least recently written */
+    if (oldest != NULL) {
+        lock(oldest);
+        write(oldest, hash, key, value, now);
+        unlock(oldest);
+    }
+}
+
+
+void SharedMemory::store(std::string key, std::string value) {
+    Utils::Metrics::Timer timer(
+        Utils::Metrics::SharedMemoryOperationsHistogram);
+    if (fits(key, value)) {
+        insert(key, value);
+    }
+}
+
+
+bool SharedMemory::storeOrUpdateFirst(const std::string &key,
+    const std::string &value) {
+    Utils::Metrics::Timer timer(
+        Utils::Metrics::SharedMemoryOperationsHistogram);
+    if (fits(key, value) == false) {
+        return false;
+    }
+    if (update(key, value)) {
+        return true;
+    }
+
+    uint32_t hash = hashOf(key);
+    lockStripe(hash);
+    if (update(key, value) == false) {
+        insert(key, value);
+    }
+    unlockStripe(hash);
+    return true;
+}
+
+
+bool SharedMemory::updateFirst(const std::string &key,
+    const std::string &value) {
+    Utils::Metrics::Timer timer(
+        Utils::Metrics::SharedMemoryOperationsHistogram);
+    if (fits(key, value) == false) {
+        return false;
+    }
+    return update(key, value);
+}
+
+
+/* Adds delta to the entry held by a slot locked by the caller. */
+int SharedMemory::add(Slot *slot, uint32_t hash, const std::string &key,
+    int delta, int64_t now) {
+    int value = toInt(std::string(slot->m_value,
+        std::min<size_t>(slot->m_valueLength, kValueSize))) + delta;
+    write(slot, hash, key, std::to_string(value), now);
+    return value;
+}
+
+
+/* Adds delta to the live entry of key, if there is one. */
+bool SharedMemory::addExisting(const std::string &key, int delta,
+    int *value) {
+    uint32_t hash = hashOf(key);
+    int64_t now = time(NULL);
+    Entry e;
+
+    for (size_t i = 0; i < kProbes; i++) {
+        Slot *slot = &m_slots[(hash + i) % kSlots];
+        read(slot, &e);
+        if (e.m_state == kSlotEmpty) {
+            break;
+        }
+        if (matches(e, hash, key, now) == false) {
+            continue;
+        }
+        lock(slot);
+        if (holds(slot, hash, key, now)) {
+            *value = add(slot, hash, key, delta, now);
+            unlock(slot);
+            return true;
+        }
+        unlock(slot);
+    }
+
+    return false;
+}
+
+
+/*
+ * Concurrent first additions to a missing key wait for each other on the
+ * stripe of the key; the one that comes second finds the entry then.
+ */
+bool SharedMemory::atomicAdd(const std::string &key, int delta,
+    int *result) {
+    Utils::Metrics::Timer timer(
+        Utils::Metrics::SharedMemoryOperationsHistogram);
+    int value = delta;
+
+    if (fits(key, "") == false) {
+        return false;
+    }
+
+    if (addExisting(key, delta, &value) == false) {
+        uint32_t hash = hashOf(key);
+        lockStripe(hash);
+        if (addExisting(key, delta, &value) == false) {
+            insert(key, std::to_string(value));
+        }
+        unlockStripe(hash);
+    }
+
+    if (result != nullptr) {
+        *result = value;
+    }
+    return true;
+}
+
+
+void SharedMemory::del(const std::string& key) {
+    Utils::Metrics::Timer timer(
+        Utils::Metrics::SharedMemoryOperationsHistogram);
+    uint32_t hash = hashOf(key);
+    int64_t now = time(NULL);
+    Entry e;
+
+    if (m_slots == NULL) {
+        return;
+    }
+
+    for (size_t i = 0; i < kProbes; i++) {
+        Slot *slot = &m_slots[(hash + i) % kSlots];
+        read(slot, &e);
+        if (e.m_state == kSlotEmpty) {
+            break;
+        }
+        if (matches(e, hash, key, now) == false) {
+            continue;
+        }
+        lock(slot);
+        if (holds(slot, hash, key, now)) {
+            slot->m_state = kSlotDeleted;
+        }
+        unlock(slot);
+    }
+}
+
+
+std::unique_ptr<std::string> SharedMemory::resolveFirst(
+    const std::string& var) {
+    Utils::Metrics::Timer timer(
+        Utils::Metrics::SharedMemoryOperationsHistogram);
+    uint32_t hash = hashOf(var);
+    int64_t now = time(NULL);
+    Entry e;
+
+    if (m_slots == NULL) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < kProbes; i++) {
+        read(&m_slots[(hash + i) % kSlots], &e);
+        if (e.m_state == kSlotEmpty) {
+            break;
+        }
+        if (matches(e, hash, var, now)) {
+            return std::unique_ptr<std::string>(new std::string(e.m_value));
+        }
+    }
+
+    return NULL;
+}
+
+
+void SharedMemory::resolveSingleMatch(const std::string& var,
+    std::vector<const VariableValue *> *l) {
+    Utils::Metrics::Timer timer(
+        Utils::Metrics::SharedMemoryOperationsHistogram);
+    uint32_t hash = hashOf(var);
+    int64_t now = time(NULL);
+    Entry e;
+
+    if (m_slots == NULL) {
+        return;
+    }
+
+    for (size_t i = 0; i < kProbes; i++) {
+        read(&m_slots[(hash + i) % kSlots], &e);
+        if (e.m_state == kSlotEmpty) {
+            break;
+        }
+        if (matches(e, hash, var, now)) {
+            l->push_back(new VariableValue(&m_name, &e.m_key, &e.m_value));
+        }
+    }
+}
+
+
+void SharedMemory::resolveMultiMatches(const std::string& var,
+    std::vector<const VariableValue *> *l, variables::KeyExclusions &ke) {
+    Utils::Metrics::Timer timer(
+        Utils::Metrics::SharedMemoryOperationsHistogram);
+    size_t first = l->size();
+    int64_t now = time(NULL);
+    Entry e;
+
+    if (m_slots == NULL) {
+        return;
+    }
+
+    if (var.empty() == false) {
+        uint32_t hash = hashOf(var);
+        if (ke.toOmit(var)) {
+            return;
+        }
+        for (size_t i = 0; i < kProbes; i++) {
+            read(&m_slots[(hash + i) % kSlots], &e);
+            if (e.m_state == kSlotEmpty) {
+                break;
+            }
+            if (matches(e, hash, var, now)) {
+                l->push_back(new VariableValue(&m_name, &var,
+                    &e.m_value));
+            }
+        }
+        std::reverse(l->begin() + first, l->end());
+        return;
+    }
+
+    for (size_t i = 0; i < kSlots; i++) {
+        read(&m_slots[i], &e);
+        if (isLive(e, now) == false || ke.toOmit(e.m_key)) {
+            continue;
+        }
+        l->push_back(new VariableValue(&m_name, &e.m_key,
+            &e.m_value));
+    }
+    std::reverse(l->begin() + first, l->end());
+}
+
+
+void SharedMemory::resolveRegularExpression(const std::string& var,
+    std::vector<const VariableValue *> *l, variables::KeyExclusions &ke) {
+    Utils::Metrics::Timer timer(
+        Utils::Metrics::SharedMemoryOperationsHistogram);
+    size_t first = l->size();
+    int64_t now = time(NULL);
+    Utils::Regex r(var, true);
+    Entry e;
+
+    if (m_slots == NULL) {
+        return;
+    }
+
+    for (size_t i = 0; i < kSlots; i++) {
+        read(&m_slots[i], &e);
+        if (isLive(e, now) == false) {
+            continue;
+        }
+        if (Utils::regex_search(e.m_key, r) <= 0 || ke.toOmit(e.m_key)) {
+            continue;
+        }
+        l->push_back(new VariableValue(&m_name, &e.m_key,
+            &e.m_value));
+    }
+    std::reverse(l->begin() + first, l->end());
+}
+
+
+}  // namespace backend
+}  // namespace collection
+}  // namespace modsecurity
@@ -0,0 +1,158 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#ifdef __cplusplus
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#endif
+
+#include "modsecurity/variable_value.h"
+#include "modsecurity/collection/collection.h"
+#include "src/variables/variable.h"
+
+#ifndef SRC_COLLECTION_BACKEND_SHARED_MEMORY_H_
+#define SRC_COLLECTION_BACKEND_SHARED_MEMORY_H_
+
+#ifdef __cplusplus
+namespace modsecurity {
+namespace collection {
+namespace backend {
+
+
+/**
+ * Collection living in an anonymous shared mapping.
+ *
+ * The mapping is created along with the ModSecurity instance and inherited
+ * by every process forked after that, so all the workers of a multi
+ * process server see the very same IP, SESSION, etc counters.
+ *
+ * It is a fixed size open addressing table (linear probing, bounded). Each
+ * slot is guarded by a sequence counter: writers make it odd while they
+ * copy the entry in, readers never block, they just retry when the
+ * sequence was odd or changed under them. Entries expire kTimeout seconds
+ * after their last write; expired slots, or the least recently written
+ * one of a full probe window, are reused by the next insertion.
+ *
+ * Keys and values longer than kKeySize / kValueSize are not stored; they
+ * are counted as dropped writes in the metrics.
+ *
+ * Creating an entry takes one of kStripes spin locks, picked by the hash
+ * of the key and kept in the same mapping, so that two writers missing
+ * the same key do not both insert it. A stripe left locked by a worker
+ * that died is taken over (see lockStripe()). The sequence of a slot is
+ * not: it is only odd across the copy of an entry, and a worker killed
+ * right then leaves that slot spinning for good.
+ *
+ */
+class SharedMemory : public Collection {
+ public:
+    static const size_t kSlots = 16384;
+    static const size_t kProbes = 32;
+    static const size_t kKeySize = 128;
+    static const size_t kValueSize = 112;
+    static const int64_t kTimeout = 3600;
+    static const size_t kStripes = 1024;
+    /* turns of a waiter between two looks at the holder of its stripe */
+    static const size_t kStripeChecks = 1024;
+
+    explicit SharedMemory(const std::string &name);
+    ~SharedMemory();
+
+    SharedMemory(const SharedMemory&) = delete;
+    SharedMemory& operator=(const SharedMemory&) = delete;
+
+    void store(std::string key, std::string value) override;
+
+    bool storeOrUpdateFirst(const std::string &key,
+        const std::string &value) override;
+
+    bool updateFirst(const std::string &key,
+        const std::string &value) override;
+
+    void del(const std::string& key) override;
+
+    bool atomicAdd(const std::string &key, int delta,
+        int *result) override;
+
+    std::unique_ptr<std::string> resolveFirst(const std::string& var) override;
+
+    void resolveSingleMatch(const std::string& var,
+        std::vector<const VariableValue *> *l) override;
+    void resolveMultiMatches(const std::string& var,
+        std::vector<const VariableValue *> *l,
+        variables::KeyExclusions &ke) override;
+    void resolveRegularExpression(const std::string& var,
+        std::vector<const VariableValue *> *l,
+        variables::KeyExclusions &ke) override;
+
+ private:
+    struct Slot {
+        std::atomic<uint32_t> m_sequence;
+        uint8_t m_state;
+        uint8_t m_keyLength;
+        uint16_t m_valueLength;
+        uint32_t m_hash;
+        int64_t m_expires;
+        char m_key[kKeySize];
+        char m_value[kValueSize];
+    };
+
+    struct Entry {
+        uint8_t m_state;
+        uint32_t m_hash;
+        int64_t m_expires;
+        std::string m_key;
+        std::string m_value;
+    };
+
+    static void read(const Slot *slot, Entry *e);
+    static void lock(Slot *slot);
+    static void unlock(Slot *slot);
+    static bool isLive(const Entry &e, int64_t now);
+    static bool matches(const Entry &e, uint32_t hash,
+        const std::string &key, int64_t now);
+    static bool holds(const Slot *slot, uint32_t hash,
+        const std::string &key, int64_t now);
+    static void write(Slot *slot, uint32_t hash, const std::string &key,
+        const std::string &value, int64_t now);
+
+    static int add(Slot *slot, uint32_t hash, const std::string &key,
+        int delta, int64_t now);
+
+    void lockStripe(uint32_t hash);
+    void unlockStripe(uint32_t hash);
+    bool addExisting(const std::string &key, int delta, int *value);
+
+    bool fits(const std::string &key, const std::string &value);
+    bool update(const std::string &key, const std::string &value);
+    void insert(const std::string &key, const std::string &value);
+
+    size_t m_size;
+    Slot *m_slots;
+    std::atomic<uint32_t> *m_stripes;
+};
+
+
+}  // namespace backend
+}  // namespace collection
+}  // namespace modsecurity
+#endif
+
+
+#endif  // SRC_COLLECTION_BACKEND_SHARED_MEMORY_H_
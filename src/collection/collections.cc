@@ -22,11 +22,13 @@
 #include <unordered_map>
 #include <list>
 #include <vector>
+#include <utility>
 #endif
 
 #include "modsecurity/variable_value.h"
 #include "modsecurity/collection/collection.h"
-#include "src/collection/backend/in_memory-per_process.h"
+#include "src/collection/backend/in_memory-per_transaction.h"
+#include "src/collection/backend/record_snapshot.h"
 #include "src/utils/string.h"
 
 
@@ -47,14 +49,74 @@ Collections::Collections(Collection *global,
     m_session_collection(session),
     m_user_collection(user),
     m_resource_collection(resource),
-    m_tx_collection(new backend::InMemoryPerProcess("TX")) {
+    m_tx_collection(new backend::InMemoryPerTransaction("TX")) {
     }
 
 
 Collections::~Collections() {
+    flush();
     delete m_tx_collection;
 }
 
 
+/*
+ * Forgets everything that is transaction scoped: the TX collection and the
+ * keys set by initcol/setsid/setuid. The persistent collections are owned
+ * by ModSecurity and stay untouched.
+ */
+void Collections::reset() {
+    m_global_collection_key.clear();
+    m_ip_collection_key.clear();
+    m_session_collection_key.clear();
+    m_user_collection_key.clear();
+    m_resource_collection_key.clear();
+
+    flush();
+    static_cast<backend::InMemoryPerTransaction *>(m_tx_collection)->clear();
+}
+
+
+void Collections::snapshot(Collection **collection,
+    const std::string &compartment, const std::string &compartment2) {
+    std::vector<std::pair<std::string, std::string>> entries;
+
+    for (auto it = m_snapshots.begin(); it != m_snapshots.end(); ++it) {
+        if (*it != collection) {
+            continue;
+        }
+        backend::RecordSnapshot *s =
+            static_cast<backend::RecordSnapshot *>(*collection);
+        if (s->isOf(compartment, compartment2)) {
+            return;
+        }
+        s->flush();
+        *collection = s->backend();
+        delete s;
+        m_snapshots.erase(it);
+        break;
+    }
+
+    if ((*collection)->resolveRecord(compartment, compartment2,
+        &entries) == false) {
+        return;
+    }
+    *collection = new backend::RecordSnapshot(*collection, compartment,
+        compartment2, &entries);
+    m_snapshots.push_back(collection);
+}
+
+
+void Collections::flush() {
+    for (Collection **collection : m_snapshots) {
+        backend::RecordSnapshot *s =
+            static_cast<backend::RecordSnapshot *>(*collection);
+        s->flush();
+        *collection = s->backend();
+        delete s;
+    }
+    m_snapshots.clear();
+}
+
+
 }  // namespace collection
 }  // namespace modsecurity
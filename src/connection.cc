@@ -0,0 +1,124 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "modsecurity/connection.h"
+
+#include <pthread.h>
+
+#include <ctime>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "modsecurity/transaction.h"
+#include "src/utils/geo_cache.h"
+#include "src/utils/ip_tree.h"
+
+
+namespace modsecurity {
+
+
+Connection::Connection(const char *client, int cPort, const char *server,
+    int sPort)
+    : m_clientIpAddress(std::make_shared<std::string>(client)),
+    m_serverIpAddress(std::make_shared<std::string>(server)),
+    m_clientPort(cPort),
+    m_serverPort(sPort),
+    m_clientIpFamily(Utils::IpTree::parse(client, m_clientIpBinary)) {
+    pthread_mutex_init(&m_lock, NULL);
+}
+
+
+Connection::~Connection() {
+    pthread_mutex_destroy(&m_lock);
+}
+
+
+std::shared_ptr<const Utils::GeoRecord> Connection::geoRecord() const {
+    pthread_mutex_lock(&m_lock);
+    std::shared_ptr<const Utils::GeoRecord> record(m_geoRecord);
+    pthread_mutex_unlock(&m_lock);
+
+    return record;
+}
+
+
+void Connection::setGeoRecord(
+    std::shared_ptr<const Utils::GeoRecord> record) {
+    pthread_mutex_lock(&m_lock);
+    m_geoRecord = std::move(record);
+    pthread_mutex_unlock(&m_lock);
+}
+
+
+bool Connection::rblAnswer(const std::string &host, int *result,
+    uint32_t *addr) const {
+    bool found = false;
+
+    pthread_mutex_lock(&m_lock);
+    auto it = m_rblAnswers.find(host);
+    if (it != m_rblAnswers.end() && it->second.m_expires > time(NULL)) {
+        *result = it->second.m_result;
+        *addr = it->second.m_addr;
+        found = true;
+    }
+    pthread_mutex_unlock(&m_lock);
+
+    return found;
+}
+
+
+void Connection::setRblAnswer(const std::string &host, int result,
+    uint32_t addr, time_t expires) {
+    pthread_mutex_lock(&m_lock);
+    RblAnswer &answer = m_rblAnswers[host];
+    answer.m_result = result;
+    answer.m_addr = addr;
+    answer.m_expires = expires;
+    pthread_mutex_unlock(&m_lock);
+}
+
+
+/**
+ * @name    msc_new_connection
+ * @brief   Creates the context shared by the transactions of a connection.
+ *
+ * To be freed with msc_connection_cleanup() once the last of them is.
+ *
+ */
+extern "C" Connection *msc_new_connection(const char *client, int cPort,
+    const char *server, int sPort) {
+    return new Connection(client, cPort, server, sPort);
+}
+
+
+extern "C" void msc_connection_cleanup(Connection *connection) {
+    delete connection;
+}
+
+
+/**
+ * @name    msc_process_connection_context
+ * @brief   msc_process_connection() with the addresses of connection,
+ *          which the transaction is attached to.
+ *
+ */
+extern "C" int msc_process_connection_context(Transaction *transaction,
+    Connection *connection) {
+    return transaction->processConnection(connection);
+}
+
+
+}  // namespace modsecurity
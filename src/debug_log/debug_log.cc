@@ -75,8 +75,11 @@ int DebugLog::getDebugLogLevel() {
 void DebugLog::write(int level, const std::string &id,
     const std::string &uri, const std::string &msg) {
     if (level <= m_debugLevel) {
-        std::string msgf = "[" + std::to_string(level) + "] " + msg;
-        msgf = "[" + id + "] [" + uri + "] " + msgf;
+        std::string msgf;
+        msgf.reserve(id.size() + uri.size() + msg.size() + 12);
+        msgf.append("[").append(id).append("] [").append(uri);
+        msgf.append("] [").append(std::to_string(level)).append("] ");
+        msgf.append(msg);
 
         DebugLogWriter &d = DebugLogWriter::getInstance();
         d.write_log(m_fileName, msgf);
@@ -22,6 +22,7 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <list>
 #include <sstream>
 #include <iterator>
 #include <iostream>
@@ -30,9 +31,57 @@
 #include "modsecurity/modsecurity.h"
 #include "src/utils/string.h"
 #include "modsecurity/transaction.h"
+#include "modsecurity/rules_set.h"
 #include "src/variables/variable.h"
 #include "src/variables/highest_severity.h"
+#include "src/actions/transformations/fused.h"
 #include "src/actions/transformations/transformation.h"
+#include "src/utils/geo_lookup.h"
+
+
+#ifdef WITH_LUA
+/*
+ * One run of main, what __msc points to: the values handed to the script
+ * through the FFI are kept here until it returns.
+ */
+struct msc_lua_run {
+    modsecurity::Transaction *m_transaction;
+    modsecurity::engine::Lua *m_lua;
+    std::vector<const modsecurity::VariableValue *> m_variables;
+    std::list<std::string> m_values;
+    std::list<std::vector<msc_lua_value>> m_lists;
+};
+
+
+/* The transformations of msc_lua_compile_transformations, fused. */
+struct msc_lua_transformations {
+    std::vector<std::unique_ptr<
+        modsecurity::actions::transformations::Transformation>> m_steps;
+    modsecurity::Transformations m_chain;
+    std::vector<std::shared_ptr<
+        modsecurity::actions::transformations::Transformation>> m_fused;
+};
+
+
+/* m.ffi */
+static const char *mscLuaFfi =
+    "typedef struct msc_lua_value {\n"
+    "    const char *name;\n"
+    "    size_t name_len;\n"
+    "    const char *value;\n"
+    "    size_t value_len;\n"
+    "} msc_lua_value;\n"
+    "typedef struct msc_lua_run msc_lua_run;\n"
+    "typedef struct msc_lua_transformations msc_lua_transformations;\n"
+    "const msc_lua_transformations *msc_lua_compile_transformations(\n"
+    "    msc_lua_run *run, const char *names);\n"
+    "int msc_lua_getvar(msc_lua_run *run, const char *name,\n"
+    "    const msc_lua_transformations *transformations,\n"
+    "    const char **value, size_t *len);\n"
+    "int msc_lua_getvars(msc_lua_run *run, const char *name,\n"
+    "    const msc_lua_transformations *transformations,\n"
+    "    const msc_lua_value **values);\n";
+#endif
 
 
 namespace modsecurity {
@@ -98,6 +147,10 @@ bool Lua::load(const std::string &script, std::string *err) {
     }
 
     lua_close(L);
+
+    /* m.getvar() may ask for any of the GEO fields */
+    Utils::GeoLookup::getInstance().wantAll();
+
     return true;
 #else
     err->assign("Lua support was not enabled.");
@@ -121,11 +174,15 @@ const char *Lua::blob_reader(lua_State *L, void *ud, size_t *size) {
 #endif
 
 
-int Lua::run(Transaction *t, const std::string &str) {
 #ifdef WITH_LUA
-    std::string luaRet;
-    const char *a = NULL;
-    int ret = true;
+/**
+ * Returns a state ready to have its main function called: the m library
+ * registered, the script chunk executed and main kept in the registry.
+ *
+ * Returns NULL (the problem is logged) if the script could not be loaded.
+ *
+ */
+lua_State *Lua::newState(Transaction *t) {
     lua_State *L = luaL_newstate();
     luaL_openlibs(L);
 
@@ -136,6 +193,8 @@ int Lua::run(Transaction *t, const std::string &str) {
     lua_setglobal(L, "__transaction");
 
     luaL_setfuncs(L, mscLuaLib, 0);
+    lua_pushstring(L, mscLuaFfi);
+    lua_setfield(L, -2, "ffi");
     lua_setglobal(L, "m");
 
 #ifdef WITH_LUA_5_1
@@ -162,10 +221,52 @@ int Lua::run(Transaction *t, const std::string &str) {
         }
         e.append(lua_tostring(L, -1));
         ms_dbg_a(t, 2, e);
-        ret = false;
-        goto err;
+        lua_close(L);
+        return NULL;
     }
 
+    /*
+     * The script sees its globals through an empty proxy table. Reads and
+     * writes go to whatever the proxy's metatable points at: the chunk
+     * defines main and its helpers in the base table, and every run gets
+     * a fresh table on top of it (see run()). What a run assigns to a
+     * global is dropped with that table, so nothing is left behind for
+     * the next transaction to borrow this state.
+     */
+    lua_newtable(L);
+    lua_newtable(L);
+#if LUA_VERSION_NUM < 502
+    lua_pushvalue(L, LUA_GLOBALSINDEX);
+#else
+    lua_pushglobaltable(L);
+#endif
+    lua_setfield(L, -2, "__index");
+    lua_setmetatable(L, -2);
+    lua_pushvalue(L, -1);
+    lua_setfield(L, LUA_REGISTRYINDEX, "msc_env_base");
+    lua_newtable(L);
+    lua_pushvalue(L, -2);
+    lua_setfield(L, -2, "__index");
+    lua_setfield(L, LUA_REGISTRYINDEX, "msc_env_run");
+    lua_newtable(L);
+    lua_newtable(L);
+    lua_pushvalue(L, -3);
+    lua_setfield(L, -2, "__index");
+    lua_pushvalue(L, -3);
+    lua_setfield(L, -2, "__newindex");
+    lua_pushvalue(L, -1);
+    lua_setfield(L, LUA_REGISTRYINDEX, "msc_env");
+    lua_setmetatable(L, -2);
+    lua_remove(L, -2);
+#if LUA_VERSION_NUM < 502
+    lua_setfenv(L, -2);
+#else
+    if (lua_setupvalue(L, -2, 1) == NULL) {
+        /* the chunk does not touch any global */
+        lua_pop(L, 1);
+    }
+#endif
+
     if (lua_pcall(L, 0, 0, 0)) {
         std::string e;
         const char *luaerr = lua_tostring(L, -1);
@@ -176,14 +277,136 @@ int Lua::run(Transaction *t, const std::string &str) {
             e.append(luaerr);
         }
         ms_dbg_a(t, 2, e);
-
-        ret = false;
-        goto err;
+        lua_close(L);
+        return NULL;
     }
 
     lua_setglobal(L, "modsec");
 
-    lua_getglobal(L, "main");
+    lua_getfield(L, LUA_REGISTRYINDEX, "msc_env_base");
+    lua_getfield(L, -1, "main");
+    lua_setfield(L, LUA_REGISTRYINDEX, "msc_main");
+    lua_settop(L, 0);
+
+    return L;
+}
+
+
+/**
+ * Points the script globals at a fresh table for a run (over the ones the
+ * chunk defined) or, with fresh false, back at the chunk ones, letting
+ * the table of the last run go.
+ *
+ */
+void Lua::setEnvironment(lua_State *L, bool fresh) {
+    lua_getfield(L, LUA_REGISTRYINDEX, "msc_env");
+    if (fresh) {
+        lua_newtable(L);
+        lua_getfield(L, LUA_REGISTRYINDEX, "msc_env_run");
+        lua_setmetatable(L, -2);
+    } else {
+        lua_getfield(L, LUA_REGISTRYINDEX, "msc_env_base");
+    }
+    lua_pushvalue(L, -1);
+    lua_setfield(L, -3, "__index");
+    lua_setfield(L, -2, "__newindex");
+    lua_pop(L, 1);
+}
+
+
+lua_State *Lua::acquireState(Transaction *t) {
+    lua_State *L = NULL;
+
+    pthread_mutex_lock(&m_poolLock);
+    if (m_pool.empty() == false) {
+        L = m_pool.back();
+        m_pool.pop_back();
+    }
+    pthread_mutex_unlock(&m_poolLock);
+
+    if (L == NULL) {
+        L = newState(t);
+    }
+
+    return L;
+}
+
+
+/**
+ * Gives the state back to the pool, or closes it if the pool is full.
+ * Nothing of the transaction is left behind: the stack is emptied,
+ * __transaction no longer points to it and the globals the run set are
+ * dropped along with its environment table.
+ *
+ */
+void Lua::releaseState(Transaction *t, lua_State *L) {
+    size_t limit = MSC_LUA_STATE_POOL_LIMIT;
+
+    if (t && t->m_rules && t->m_rules->m_luaStatePoolLimit.m_set) {
+        limit = t->m_rules->m_luaStatePoolLimit.m_value;
+    }
+
+    lua_settop(L, 0);
+    lua_pushlightuserdata(L, NULL);
+    lua_setglobal(L, "__transaction");
+    lua_pushlightuserdata(L, NULL);
+    lua_setglobal(L, "__msc");
+    setEnvironment(L, false);
+
+    pthread_mutex_lock(&m_poolLock);
+    if (m_pool.size() < limit) {
+        m_pool.push_back(L);
+        L = NULL;
+    }
+    pthread_mutex_unlock(&m_poolLock);
+
+    if (L != NULL) {
+        lua_close(L);
+    }
+}
+#endif
+
+
+Lua::Lua() {
+#ifdef WITH_LUA
+    pthread_mutex_init(&m_poolLock, NULL);
+#endif
+}
+
+
+Lua::~Lua() {
+#ifdef WITH_LUA
+    for (lua_State *L : m_pool) {
+        lua_close(L);
+    }
+    m_pool.clear();
+    pthread_mutex_destroy(&m_poolLock);
+#endif
+}
+
+
+int Lua::run(Transaction *t, const std::string &str) {
+#ifdef WITH_LUA
+    std::string luaRet;
+    const char *a = NULL;
+    int ret = true;
+    lua_State *L = acquireState(t);
+
+    if (L == NULL) {
+        return false;
+    }
+
+    msc_lua_run run;
+    run.m_transaction = t;
+    run.m_lua = this;
+
+    lua_pushlightuserdata(L, reinterpret_cast<void *>(t));
+    lua_setglobal(L, "__transaction");
+    lua_pushlightuserdata(L, reinterpret_cast<void *>(&run));
+    lua_setglobal(L, "__msc");
+    setEnvironment(L, true);
+
+    lua_getfield(L, LUA_REGISTRYINDEX, "msc_main");
 
     ms_dbg_a(t, 1, str);
 
@@ -202,8 +425,12 @@ int Lua::run(Transaction *t, const std::string &str) {
         }
         ms_dbg_a(t, 2, e);
 
-        ret = false;
-        goto err;
+        /* do not reuse a state left behind by a failure */
+        lua_close(L);
+        for (const VariableValue *v : run.m_variables) {
+            delete v;
+        }
+        return false;
     }
 
     a = reinterpret_cast<const char *>(lua_tostring(L, -1));
@@ -217,10 +444,10 @@ int Lua::run(Transaction *t, const std::string &str) {
         ret = false;
     }
 
-
-err:
-    lua_pop(L, 1);
-    lua_close(L);
+    releaseState(t, L);
+    for (const VariableValue *v : run.m_variables) {
+        delete v;
+    }
 
     return ret;
 #else
@@ -479,3 +706,101 @@ std::string Lua::applyTransformations(lua_State *L, Transaction *t,
 }  //  namespace engine
 }  //  namespace modsecurity
 
+
+#ifdef WITH_LUA
+using modsecurity::actions::transformations::Fused;
+using modsecurity::actions::transformations::Transformation;
+
+
+static const std::string &transformed(msc_lua_run *run,
+    const msc_lua_transformations *transformations,
+    const std::string &value) {
+    if (transformations == NULL || transformations->m_chain.empty()) {
+        return value;
+    }
+    run->m_values.push_back(value);
+    for (Transformation *t : transformations->m_chain) {
+        t->transform(run->m_values.back(), run->m_transaction);
+    }
+    return run->m_values.back();
+}
+
+
+extern "C" const msc_lua_transformations *msc_lua_compile_transformations(
+    msc_lua_run *run, const char *names) {
+    modsecurity::engine::Lua *lua = run->m_lua;
+    const msc_lua_transformations *ret = NULL;
+
+    pthread_mutex_lock(&lua->m_poolLock);
+    auto it = lua->m_transformations.find(names);
+    if (it != lua->m_transformations.end()) {
+        ret = it->second.get();
+    } else {
+        std::unique_ptr<msc_lua_transformations> compiled(
+            new msc_lua_transformations());
+        modsecurity::Transformations steps;
+        for (const std::string &name : modsecurity::utils::string::ssplit(
+            names, ',')) {
+            if (name.empty()) {
+                continue;
+            }
+            if (name == "none") {
+                steps.clear();
+                continue;
+            }
+            compiled->m_steps.emplace_back(Transformation::instantiate(
+                "t:" + name));
+            steps.push_back(compiled->m_steps.back().get());
+        }
+        Fused::optimize(steps, &compiled->m_chain, &compiled->m_fused);
+        ret = compiled.get();
+        lua->m_transformations[names] = std::move(compiled);
+    }
+    pthread_mutex_unlock(&lua->m_poolLock);
+
+    return ret;
+}
+
+
+extern "C" int msc_lua_getvar(msc_lua_run *run, const char *name,
+    const msc_lua_transformations *transformations,
+    const char **value, size_t *len) {
+    run->m_values.push_back(modsecurity::variables::Variable::
+        stringMatchResolve(run->m_transaction, name));
+    const std::string &var = transformed(run, transformations,
+        run->m_values.back());
+
+    if (var.empty()) {
+        return 0;
+    }
+    *value = var.c_str();
+    *len = var.size();
+    return 1;
+}
+
+
+extern "C" int msc_lua_getvars(msc_lua_run *run, const char *name,
+    const msc_lua_transformations *transformations,
+    const msc_lua_value **values) {
+    std::vector<const modsecurity::VariableValue *> l;
+
+    modsecurity::variables::Variable::stringMatchResolveMulti(
+        run->m_transaction, name, &l);
+
+    run->m_lists.emplace_back();
+    std::vector<msc_lua_value> &list = run->m_lists.back();
+    for (const modsecurity::VariableValue *v : l) {
+        run->m_variables.push_back(v);
+        const std::string &key = v->getKeyWithCollection();
+        const std::string &value = transformed(run, transformations,
+            v->getValue());
+        list.push_back({key.c_str(), key.size(), value.c_str(),
+            value.size()});
+    }
+
+    *values = list.data();
+    return static_cast<int>(list.size());
+}
+#endif
+
+
@@ -15,16 +15,51 @@
 
 #ifdef WITH_LUA
 #include <lua.hpp>
+#include <pthread.h>
 #endif
 
 #include <iostream>
 #include <cstdint>
 #include <cstring>
+#include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 #ifndef SRC_ENGINE_LUA_H_
 #define SRC_ENGINE_LUA_H_
 
+#ifdef WITH_LUA
+/*
+ * What the scripts can call through the LuaJIT FFI, without a Lua string
+ * or table created per value: m.ffi has these declarations, for
+ * ffi.cdef, and __msc is the run to hand them. The pointers they return
+ * are valid until main returns; the ones of
+ * msc_lua_compile_transformations for as long as the script is loaded.
+ */
+extern "C" {
+typedef struct msc_lua_value {
+    const char *name;
+    size_t name_len;
+    const char *value;
+    size_t value_len;
+} msc_lua_value;
+
+typedef struct msc_lua_run msc_lua_run;
+typedef struct msc_lua_transformations msc_lua_transformations;
+
+/* names as in m.getvar, comma separated; "none" starts over */
+const msc_lua_transformations *msc_lua_compile_transformations(
+    msc_lua_run *run, const char *names);
+int msc_lua_getvar(msc_lua_run *run, const char *name,
+    const msc_lua_transformations *transformations,
+    const char **value, size_t *len);
+int msc_lua_getvars(msc_lua_run *run, const char *name,
+    const msc_lua_transformations *transformations,
+    const msc_lua_value **values);
+}
+#endif
+
 namespace modsecurity {
 class Transaction;
 namespace engine {
@@ -63,15 +98,30 @@ class LuaScriptBlob {
 };
 #endif
 
+/*
+ * Number of ready to use states kept per script when SecLuaStatePoolLimit
+ * is not set.
+ */
+#define MSC_LUA_STATE_POOL_LIMIT 16
+
 class Lua {
  public:
-    Lua() { }
+    Lua();
+    ~Lua();
+
+    Lua(const Lua&) = delete;
+    Lua& operator=(const Lua&) = delete;
 
     bool load(const std::string &script, std::string *err);
     int run(Transaction *t, const std::string &str="");
     static bool isCompatible(const std::string &script, Lua *l, std::string *error);
 
 #ifdef WITH_LUA
+    lua_State *acquireState(Transaction *t);
+    void releaseState(Transaction *t, lua_State *L);
+    lua_State *newState(Transaction *t);
+    static void setEnvironment(lua_State *L, bool fresh);
+
     static int blob_keeper(lua_State *L, const void *p, size_t sz, void *ud);
     static const char *blob_reader(lua_State *L, void *us, size_t *size);
 
@@ -83,6 +133,23 @@ class Lua {
         int idx, std::string var);
 
     LuaScriptBlob m_blob;
+
+ private:
+    /*
+     * States with the script chunk already executed and its main function
+     * kept in the registry. Borrowed for the duration of run().
+     */
+    std::vector<lua_State *> m_pool;
+    pthread_mutex_t m_poolLock;
+
+    /* msc_lua_compile_transformations, by names; under m_poolLock too */
+    std::map<std::string, std::unique_ptr<msc_lua_transformations>>
+        m_transformations;
+
+    friend const msc_lua_transformations *::msc_lua_compile_transformations(
+        msc_lua_run *run, const char *names);
+
+ public:
 #endif
     std::string m_scriptName;
 };
@@ -0,0 +1,170 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/header_rules.h"
+
+#include <string>
+#include <vector>
+
+#include "modsecurity/rule_with_operator.h"
+#include "modsecurity/transaction.h"
+#include "modsecurity/variable_value.h"
+#include "src/utils/string.h"
+#include "src/variables/remote_addr.h"
+#include "src/variables/request_headers.h"
+#include "src/variables/request_method.h"
+#include "src/variables/request_uri.h"
+#include "src/variables/variable.h"
+
+
+namespace modsecurity {
+
+namespace {
+
+/*
+ * The targets the program takes, each kind of them keyed apart; none for
+ * any other, &REQUEST_HEADERS included. Header names are looked up
+ * regardless of case, so are the slots of single headers.
+ */
+std::string slotKey(const variables::Variable *var) {
+    if (dynamic_cast<const variables::RequestHeaders_DictElement *>(var)) {
+        return "H" + utils::string::tolower(*var->m_fullName);
+    }
+    if (dynamic_cast<const variables::RequestHeaders_DictElementRegexp *>(
+        var)) {
+        return "R" + *var->m_fullName;
+    }
+    if (dynamic_cast<const variables::RequestHeaders_NoDictElement *>(var)) {
+        return "A" + *var->m_fullName;
+    }
+    if (dynamic_cast<const variables::RequestURI *>(var)
+        || dynamic_cast<const variables::RequestMethod *>(var)
+        || dynamic_cast<const variables::RemoteAddr *>(var)) {
+        return "V" + *var->m_fullName;
+    }
+    return "";
+}
+
+}  // namespace
+
+
+HeaderRules::Values::Values(const HeaderRules *program)
+    : m_program(program),
+    m_slots(program ? program->m_slots.size() : 0) { }
+
+
+HeaderRules::Values::~Values() {
+    for (Slot &s : m_slots) {
+        if (s.m_borrowed) {
+            continue;
+        }
+        for (const VariableValue *v : s.m_values) {
+            delete v;
+        }
+    }
+}
+
+
+const std::vector<const VariableValue *> &HeaderRules::Values::resolve(
+    Transaction *t, size_t slot, RuleWithOperator *rule) {
+    Slot &s = m_slots[slot];
+    if (s.m_resolved == false) {
+        variables::Variable *var = m_program->m_slots[slot];
+        s.m_borrowed = var->evaluateBorrowed(t, rule, &s.m_values);
+        if (s.m_borrowed == false) {
+            var->evaluate(t, rule, &s.m_values);
+        }
+        s.m_resolved = true;
+    }
+    return s.m_values;
+}
+
+
+bool HeaderRules::add(RuleWithOperator *rule,
+    const RulesSet::RuleTargets *targets) {
+    if (targets == nullptr || rule->hasReadOnlyOperator() == false) {
+        return false;
+    }
+
+    Rule r;
+    r.m_rule = rule;
+    r.m_exclusion = targets->m_exclusion;
+    for (variables::Variable *var : *targets->m_variables) {
+        if (var == nullptr) {
+            continue;
+        }
+        std::string key = slotKey(var);
+        if (key.empty()) {
+            return false;
+        }
+        /* key exclusions belong to the variable, so does its slot */
+        auto it = var->m_keyExclusion.empty() ? m_slotsByTarget.find(key)
+            : m_slotsByTarget.end();
+        if (it != m_slotsByTarget.end()) {
+            r.m_slots.push_back(it->second);
+            continue;
+        }
+        r.m_slots.push_back(m_slots.size());
+        if (var->m_keyExclusion.empty()) {
+            m_slotsByTarget[key] = m_slots.size();
+        }
+        m_slots.push_back(var);
+    }
+
+    m_rules.push_back(r);
+    return true;
+}
+
+
+bool HeaderRules::usable(const Transaction *t) {
+    return ms_dbg_a_enabled(t, 4) == false
+        && t->m_ruleProfile == nullptr
+        && t->m_rulePrefetches == nullptr
+        && t->m_ruleRemoveById.empty()
+        && t->m_ruleRemoveByIdRange.empty()
+        && t->m_ruleRemoveTargetById.empty()
+        && t->m_ruleRemoveTargetByTag.empty();
+}
+
+
+bool HeaderRules::matches(size_t index, Transaction *t,
+    Values *values) const {
+    const Rule &r = m_rules[index];
+
+    for (size_t slot : r.m_slots) {
+        for (const VariableValue *v : values->resolve(t, slot, r.m_rule)) {
+            if (r.m_exclusion->contains(v)) {
+                continue;
+            }
+            TransformationResults results;
+            r.m_rule->executeTransformations(t, v->getValue(), results);
+            for (const auto &value : results) {
+                /* no message: offsets are only kept for a match */
+                if (r.m_rule->executeOperatorAt(t, v->getKeyWithCollection(),
+                    *value.first, nullptr)) {
+                    return true;
+                }
+            }
+        }
+    }
+
+    /* what RuleWithOperator::evaluate() does for a rule that returns 0 */
+    t->m_matched.clear();
+    RuleWithOperator::cleanMatchedVars(t);
+    return false;
+}
+
+
+}  // namespace modsecurity
@@ -0,0 +1,125 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "modsecurity/rules_set.h"
+
+#ifndef SRC_HEADER_RULES_H_
+#define SRC_HEADER_RULES_H_
+
+
+namespace modsecurity {
+class RuleWithOperator;
+class Transaction;
+class VariableValue;
+namespace variables {
+class Variable;
+}
+
+
+/**
+ * Flat program for the rules of the request headers phase (phase:1) that
+ * only look at REQUEST_HEADERS, REQUEST_URI, REQUEST_METHOD and
+ * REMOTE_ADDR. Many requests are decided there, and as no action changes
+ * those targets, each distinct one is resolved once per transaction, into
+ * a slot, for all the rules that name it.
+ *
+ * Rules are only matched here. The ones that do not match, most of them,
+ * are done with at the cost of their transformations and operator calls,
+ * without a rule message, a target lookup or the debug log checks. When a
+ * value matches the rule is evaluated as usual, from scratch, so that its
+ * actions, the chain and the logging go the general way; the operators
+ * taken are the ones that only read the transaction, so matching twice
+ * makes no difference. So does a transaction with anything out of the
+ * ordinary (see usable()).
+ *
+ */
+class HeaderRules {
+ public:
+    /**
+     * The slots of a transaction, resolved as the rules ask for them and
+     * released along with it when the plan is done.
+     */
+    class Values {
+     public:
+        explicit Values(const HeaderRules *program);
+        ~Values();
+
+        Values(const Values &) = delete;
+        Values &operator=(const Values &) = delete;
+
+     private:
+        friend class HeaderRules;
+
+        class Slot {
+         public:
+            Slot() : m_resolved(false), m_borrowed(false) { }
+            bool m_resolved;
+            bool m_borrowed;
+            std::vector<const VariableValue *> m_values;
+        };
+
+        const std::vector<const VariableValue *> &resolve(Transaction *t,
+            size_t slot, RuleWithOperator *rule);
+
+        const HeaderRules *m_program;
+        std::vector<Slot> m_slots;
+    };
+
+    /**
+     * Adds rule, with its targets as resolved by the set, if it fits the
+     * program; its index is then size() - 1.
+     */
+    bool add(RuleWithOperator *rule, const RulesSet::RuleTargets *targets);
+
+    /**
+     * Whether t may go through the program at all: no debug log to write
+     * rule by rule, no profiling and no rule or target removed by ctl.
+     * Checked for every rule, ctl may come from the rules before.
+     */
+    static bool usable(const Transaction *t);
+
+    /**
+     * Whether any value of the rule at index matches. If none does, the
+     * transaction is left as evaluating the rule would have left it.
+     */
+    bool matches(size_t index, Transaction *t, Values *values) const;
+
+    size_t size() const { return m_rules.size(); }
+
+ private:
+    class Rule {
+     public:
+        RuleWithOperator *m_rule;
+        variables::Variables *m_exclusion;
+        std::vector<size_t> m_slots;
+    };
+
+    std::vector<Rule> m_rules;
+    std::vector<variables::Variable *> m_slots;
+    std::unordered_map<std::string, size_t> m_slotsByTarget;
+};
+
+
+}  // namespace modsecurity
+
+#endif  // SRC_HEADER_RULES_H_
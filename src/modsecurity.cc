@@ -35,11 +35,22 @@
 
 #include "modsecurity/rule.h"
 #include "modsecurity/rule_message.h"
+#include "modsecurity/rules_handle.h"
+#include "modsecurity/rules_set_router.h"
 #include "src/collection/backend/in_memory-per_process.h"
+#include "src/collection/backend/in_memory-sharded.h"
 #include "src/collection/backend/lmdb.h"
+#include "src/collection/backend/redis.h"
+#include "src/collection/backend/shared_memory.h"
+#include "src/request_body_processor/xml.h"
+#include "src/shadow_transaction.h"
 #include "src/unique_id.h"
+#include "src/utils/allocator.h"
+#include "src/utils/async_runner.h"
 #include "src/utils/regex.h"
 #include "src/utils/geo_lookup.h"
+#include "src/utils/metrics.h"
+#include "src/utils/server_log_queue.h"
 #include "src/actions/transformations/transformation.h"
 
 namespace modsecurity {
@@ -61,25 +72,48 @@ namespace modsecurity {
  */
 ModSecurity::ModSecurity()
     :
-#ifdef WITH_LMDB
+#if defined(WITH_SHARED_COLLECTIONS)
+    m_global_collection(new collection::backend::SharedMemory("GLOBAL")),
+    m_resource_collection(new collection::backend::SharedMemory("RESOURCE")),
+    m_ip_collection(new collection::backend::SharedMemory("IP")),
+    m_session_collection(new collection::backend::SharedMemory("SESSION")),
+    m_user_collection(new collection::backend::SharedMemory("USER")),
+#elif defined(WITH_REDIS_COLLECTIONS)
+    m_global_collection(new collection::backend::Redis("GLOBAL")),
+    m_resource_collection(new collection::backend::Redis("RESOURCE")),
+    m_ip_collection(new collection::backend::Redis("IP")),
+    m_session_collection(new collection::backend::Redis("SESSION")),
+    m_user_collection(new collection::backend::Redis("USER")),
+#elif defined(WITH_LMDB)
     m_global_collection(new collection::backend::LMDB("GLOBAL")),
     m_resource_collection(new collection::backend::LMDB("RESOURCE")),
     m_ip_collection(new collection::backend::LMDB("IP")),
     m_session_collection(new collection::backend::LMDB("SESSION")),
     m_user_collection(new collection::backend::LMDB("USER")),
 #else
-    m_global_collection(new collection::backend::InMemoryPerProcess("GLOBAL")),
+    m_global_collection(new collection::backend::InMemorySharded("GLOBAL")),
     m_resource_collection(
-        new collection::backend::InMemoryPerProcess("RESOURCE")),
-    m_ip_collection(new collection::backend::InMemoryPerProcess("IP")),
+        new collection::backend::InMemorySharded("RESOURCE")),
+    m_ip_collection(new collection::backend::InMemorySharded("IP")),
     m_session_collection(
-        new collection::backend::InMemoryPerProcess("SESSION")),
-    m_user_collection(new collection::backend::InMemoryPerProcess("USER")),
+        new collection::backend::InMemorySharded("SESSION")),
+    m_user_collection(new collection::backend::InMemorySharded("USER")),
 #endif
     m_connector(""),
     m_whoami(""),
     m_logCb(NULL),
-    m_logProperties(0) {
+    m_logProperties(0),
+    m_serverLogQueue(NULL),
+    m_asyncRunner(new Utils::AsyncRunner(
+        Utils::AsyncRunner::kDefaultThreads)),
+    m_shadowRunner(new Utils::AsyncRunner(
+        ShadowTransaction::kDefaultThreads,
+        ShadowTransaction::kDefaultQueueLimit)),
+    m_uploadRunner(NULL),
+    m_traceCb(NULL),
+    m_traceThreshold(0) {
+    /* what is allocated from here on may be freed by anyone */
+    Utils::Allocator::seal();
     UniqueId::uniqueId();
     srand(time(NULL));
 #ifdef MSC_WITH_CURL
@@ -92,6 +126,18 @@ ModSecurity::ModSecurity()
 
 
 ModSecurity::~ModSecurity() {
+    /* first: what is still queued runs transactions of this instance */
+    delete m_shadowRunner;
+    for (RulesHandle *handle : m_rulesHandles) {
+        delete handle;
+    }
+    /* after the handles: the overlays they hold use the router bases */
+    for (RulesSetRouter *router : m_rulesSetRouters) {
+        delete router;
+    }
+    delete m_serverLogQueue;
+    delete m_asyncRunner;
+    delete m_uploadRunner;
 #ifdef MSC_WITH_CURL
     curl_global_cleanup();
 #endif
@@ -99,6 +145,7 @@ ModSecurity::~ModSecurity() {
     Utils::GeoLookup::getInstance().cleanUp();
 #endif
 #ifdef WITH_LIBXML2
+    RequestBodyProcessor::XML::releaseParser();
     xmlCleanupParser();
 #endif
     delete m_global_collection;
@@ -191,6 +238,12 @@ const std::string& ModSecurity::getConnectorInformation() const {
 }
 
 void ModSecurity::serverLog(void *data, std::shared_ptr<RuleMessage> rm) {
+    serverLog(data, std::move(rm), nullptr);
+}
+
+
+void ModSecurity::serverLog(void *data, std::shared_ptr<RuleMessage> rm,
+    const std::shared_ptr<RulesSet> &rules) {
     if (m_logCb == NULL) {
         std::cerr << "Server log callback is not set -- " << rm->errorLog();
         std::cerr << std::endl;
@@ -201,6 +254,32 @@ void ModSecurity::serverLog(void *data, std::shared_ptr<RuleMessage> rm) {
         return;
     }
 
+    if (m_serverLogQueue) {
+        /*
+         * A copy, the rule keeps filling its message in (multimatch, the
+         * rest of a chain) after logging it; its details are formatted
+         * here, the rule may be gone by the time it is delivered.
+         */
+        std::shared_ptr<RuleMessage> copy = std::make_shared<RuleMessage>(
+            *rm);
+        copy->formatDetails();
+        m_serverLogQueue->push(data, std::move(copy), rules);
+        return;
+    }
+
+    deliverServerLog(data, rm);
+}
+
+
+void ModSecurity::drainServerLog() {
+    if (m_serverLogQueue) {
+        m_serverLogQueue->drain();
+    }
+}
+
+
+void ModSecurity::deliverServerLog(void *data,
+    const std::shared_ptr<RuleMessage> &rm) {
     if (m_logProperties & TextLogProperty) {
         std::string &&d = rm->log();
         const void *a = static_cast<const void *>(d.c_str());
@@ -235,7 +314,7 @@ int ModSecurity::processContentOffset(const char *content, size_t len,
     std::list<Utils::SMatch> ops = operators.searchAll(matchString);
     std::list<Utils::SMatch> trans = transformations.searchAll(matchString);
 
-    g = yajl_gen_alloc(NULL);
+    g = yajl_gen_alloc(Utils::Allocator::yajl());
     if (g == NULL) {
         *err = "Failed to allocate memory for the JSON creation.";
         return -1;
@@ -408,8 +487,19 @@ void ModSecurity::setServerLogCb(ModSecLogCb cb) {
 
 
 void ModSecurity::setServerLogCb(ModSecLogCb cb, int properties) {
+    /* whatever is still queued goes with the old callback */
+    delete m_serverLogQueue;
+    m_serverLogQueue = NULL;
+
     m_logCb = (ModSecLogCb) cb;
     m_logProperties = properties;
+
+    if (properties & AsyncLogProperty) {
+        m_serverLogQueue = new Utils::ServerLogQueue(
+            [this](void *data, const std::shared_ptr<RuleMessage> &rm) {
+                deliverServerLog(data, rm);
+            });
+    }
 }
 
 /**
@@ -468,6 +558,176 @@ extern "C" const char *msc_who_am_i(ModSecurity *msc) {
 }
 
 
+std::string ModSecurity::metrics() const {
+    return Utils::Metrics::getInstance().render();
+}
+
+
+RulesHandle *ModSecurity::createRulesHandle(RulesSet *rules) {
+    RulesHandle *handle = new RulesHandle(rules);
+    m_rulesHandles.push_back(handle);
+    return handle;
+}
+
+
+RulesSetRouter *ModSecurity::createRulesSetRouter() {
+    RulesSetRouter *router = new RulesSetRouter(this);
+    m_rulesSetRouters.push_back(router);
+    return router;
+}
+
+
+void ModSecurity::setAsyncThreads(size_t threads) {
+    delete m_asyncRunner;
+    m_asyncRunner = new Utils::AsyncRunner(threads);
+}
+
+
+void ModSecurity::setShadowThreads(size_t threads, size_t queueLimit) {
+    delete m_shadowRunner;
+    m_shadowRunner = new Utils::AsyncRunner(threads, queueLimit);
+}
+
+
+void ModSecurity::setUploadThreads(size_t threads, size_t queueLimit) {
+    delete m_uploadRunner;
+    m_uploadRunner = NULL;
+    if (threads > 0) {
+        m_uploadRunner = new Utils::AsyncRunner(threads, queueLimit);
+    }
+}
+
+
+void ModSecurity::setTraceCb(ModSecTraceCb cb, uint64_t thresholdUs) {
+    m_traceCb = cb;
+    m_traceThreshold = thresholdUs * 1000;
+}
+
+
+/**
+ * @name    msc_set_async_threads
+ * @brief   Number of threads for the non blocking transactions.
+ *
+ * See msc_transaction_set_non_blocking. To be called before the first
+ * transaction is created.
+ *
+ */
+extern "C" void msc_set_async_threads(ModSecurity *msc, size_t threads) {
+    msc->setAsyncThreads(threads);
+}
+
+
+/**
+ * @name    msc_set_shadow_threads
+ * @brief   Threads and queue for the transactions run against
+ *          SecShadowRules.
+ *
+ * Past queue_limit waiting transactions, the next ones are not shadowed.
+ * To be called before the first transaction is created.
+ *
+ */
+extern "C" void msc_set_shadow_threads(ModSecurity *msc, size_t threads,
+    size_t queue_limit) {
+    msc->setShadowThreads(threads, queue_limit);
+}
+
+
+/**
+ * @name    msc_set_upload_threads
+ * @brief   Threads finishing the file parts of the multipart bodies.
+ *
+ * Once the data of a file part is all in, the closing of its temporary
+ * file and, for FILES_TMP_CONTENT, reading it back are left to these
+ * while the parser goes on with the next parts; the request body phase
+ * waits for them. Past queue_limit waiting parts, the next ones are
+ * finished on the request thread. No threads, the default, finishes them
+ * all there. To be called before the first transaction is created.
+ *
+ */
+extern "C" void msc_set_upload_threads(ModSecurity *msc, size_t threads,
+    size_t queue_limit) {
+    msc->setUploadThreads(threads, queue_limit);
+}
+
+
+/**
+ * @name    msc_set_allocator
+ * @brief   Routes what the library allocates on its own to allocator.
+ *
+ * That is the buffers of the transformations, the JSON parser and
+ * generator (yajl), libxml2 and the PCRE2 code, match data and JIT
+ * stacks. libxml2 is set up process wide, through xmlMemSetup(). The C++
+ * objects are still allocated with the global operator new.
+ *
+ * @note To be called before msc_init(), and before anything else of the
+ *       process uses libxml2. NULL goes back to the C library allocator.
+ *       Once the library allocated anything, with either, the allocator
+ *       stays as it is.
+ *
+ * @param allocator The allocator; its functions are copied.
+ *
+ * @retval 0 The allocator is in place.
+ * @retval -1 A ModSecurity instance was already created, something was
+ *            allocated already, a function of allocator is missing, or
+ *            libxml2 was set up with another allocator.
+ *
+ */
+extern "C" int msc_set_allocator(const ModSecAllocator *allocator) {
+    return Utils::Allocator::set(allocator) ? 0 : -1;
+}
+
+
+/**
+ * @name    msc_set_trace_cb
+ * @brief   Spans of the traced transactions, for the tracer of the connector.
+ *
+ * See trace.h. Only the transactions given a parent with
+ * msc_set_trace_parent are traced; the others cost a pointer check.
+ *
+ * @param msc The current ModSecurity instance.
+ * @param cb The callback, NULL to stop tracing.
+ * @param threshold_us Operators and variables of the rules that take
+ *                     less than that get no span.
+ *
+ */
+extern "C" void msc_set_trace_cb(ModSecurity *msc, ModSecTraceCb cb,
+    uint64_t threshold_us) {
+    msc->setTraceCb(cb, threshold_us);
+}
+
+
+/**
+ * @name    msc_metrics_render
+ * @brief   Engine counters in the Prometheus text exposition format.
+ *
+ * Meant to be served as is by the connector, e.g. on a /metrics location.
+ * The counters are process wide, not per ModSecurity instance.
+ *
+ * @note The returned string has to be freed by the caller.
+ *
+ */
+extern "C" char *msc_metrics_render(ModSecurity *msc) {
+    return strdup(msc->metrics().c_str());
+}
+
+
+/**
+ * @name    msc_drain_server_log
+ * @brief   Waits for the queued server log messages to be delivered.
+ *
+ * With AsyncLogProperty the log callback runs after the fact, with the
+ * data given to the transaction. Connectors call this before freeing
+ * that data; it returns once every message queued so far, by any
+ * thread, was handed to the callback. Nothing to wait for otherwise.
+ *
+ * @note Not to be called from the log callback itself.
+ *
+ */
+extern "C" void msc_drain_server_log(ModSecurity *msc) {
+    msc->drainServerLog();
+}
+
+
 /**
  * @name    msc_cleanup
  * @brief   Cleanup ModSecurity C API
@@ -0,0 +1,505 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/native_rules.h"
+
+#include <dlfcn.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rule_message.h"
+#include "modsecurity/rule_with_operator.h"
+#include "modsecurity/rules_set.h"
+#include "src/actions/transformations/base64_decode.h"
+#include "src/actions/transformations/base64_decode_ext.h"
+#include "src/actions/transformations/base64_encode.h"
+#include "src/actions/transformations/cmd_line.h"
+#include "src/actions/transformations/compress_whitespace.h"
+#include "src/actions/transformations/css_decode.h"
+#include "src/actions/transformations/escape_seq_decode.h"
+#include "src/actions/transformations/fused.h"
+#include "src/actions/transformations/hex_decode.h"
+#include "src/actions/transformations/hex_encode.h"
+#include "src/actions/transformations/html_entity_decode.h"
+#include "src/actions/transformations/js_decode.h"
+#include "src/actions/transformations/length.h"
+#include "src/actions/transformations/lower_case.h"
+#include "src/actions/transformations/md5.h"
+#include "src/actions/transformations/none.h"
+#include "src/actions/transformations/normalise_path.h"
+#include "src/actions/transformations/normalise_path_win.h"
+#include "src/actions/transformations/parity_even_7bit.h"
+#include "src/actions/transformations/parity_odd_7bit.h"
+#include "src/actions/transformations/parity_zero_7bit.h"
+#include "src/actions/transformations/remove_comments.h"
+#include "src/actions/transformations/remove_comments_char.h"
+#include "src/actions/transformations/remove_nulls.h"
+#include "src/actions/transformations/remove_whitespace.h"
+#include "src/actions/transformations/replace_comments.h"
+#include "src/actions/transformations/replace_nulls.h"
+#include "src/actions/transformations/sha1.h"
+#include "src/actions/transformations/sql_hex_decode.h"
+#include "src/actions/transformations/transformation.h"
+#include "src/actions/transformations/trim.h"
+#include "src/actions/transformations/trim_left.h"
+#include "src/actions/transformations/trim_right.h"
+#include "src/actions/transformations/upper_case.h"
+#include "src/actions/transformations/url_decode.h"
+#include "src/actions/transformations/url_decode_uni.h"
+#include "src/actions/transformations/url_encode.h"
+#include "src/actions/transformations/utf8_to_unicode.h"
+#include "src/operators/begins_with.h"
+#include "src/operators/contains.h"
+#include "src/operators/contains_word.h"
+#include "src/operators/detect_sqli.h"
+#include "src/operators/detect_xss.h"
+#include "src/operators/ends_with.h"
+#include "src/operators/eq.h"
+#include "src/operators/ge.h"
+#include "src/operators/gt.h"
+#include "src/operators/ip_match.h"
+#include "src/operators/ip_match_f.h"
+#include "src/operators/ip_match_from_file.h"
+#include "src/operators/le.h"
+#include "src/operators/lt.h"
+#include "src/operators/no_match.h"
+#include "src/operators/operator.h"
+#include "src/operators/pm.h"
+#include "src/operators/pm_f.h"
+#include "src/operators/pm_from_file.h"
+#include "src/operators/rx.h"
+#include "src/operators/rx_global.h"
+#include "src/operators/str_eq.h"
+#include "src/operators/str_match.h"
+#include "src/operators/unconditional_match.h"
+#include "src/operators/validate_byte_range.h"
+#include "src/operators/validate_url_encoding.h"
+#include "src/operators/validate_utf8_encoding.h"
+#include "src/operators/within.h"
+
+namespace modsecurity {
+
+using actions::transformations::Transformation;
+
+namespace {
+
+/*
+ * The classes the generated code may name. m_impl is the class whose
+ * evaluate() the operator gets (e.g. @pmf is a PmFromFile); m_rule is
+ * for the evaluate() that takes the rule and the rule message, the one
+ * the operators with captures or a match message override.
+ */
+class OperatorClass {
+ public:
+    const std::type_info *m_type;
+    const char *m_name;
+    const char *m_impl;
+    const char *m_header;
+    bool m_rule;
+};
+
+#define NATIVE_OPERATOR(c, impl, h, rule) \
+    { &typeid(operators::c), #c, #impl, "src/operators/" h, rule }
+
+const OperatorClass operatorClasses[] = {
+    NATIVE_OPERATOR(BeginsWith, BeginsWith, "begins_with.h", true),
+    NATIVE_OPERATOR(Contains, Contains, "contains.h", true),
+    NATIVE_OPERATOR(ContainsWord, ContainsWord, "contains_word.h", true),
+    NATIVE_OPERATOR(DetectSQLi, DetectSQLi, "detect_sqli.h", true),
+    NATIVE_OPERATOR(DetectXSS, DetectXSS, "detect_xss.h", true),
+    NATIVE_OPERATOR(EndsWith, EndsWith, "ends_with.h", true),
+    NATIVE_OPERATOR(Eq, Eq, "eq.h", false),
+    NATIVE_OPERATOR(Ge, Ge, "ge.h", false),
+    NATIVE_OPERATOR(Gt, Gt, "gt.h", false),
+    NATIVE_OPERATOR(IpMatch, IpMatch, "ip_match.h", false),
+    NATIVE_OPERATOR(IpMatchF, IpMatchFromFile, "ip_match_f.h", false),
+    NATIVE_OPERATOR(IpMatchFromFile, IpMatchFromFile,
+        "ip_match_from_file.h", false),
+    NATIVE_OPERATOR(Le, Le, "le.h", false),
+    NATIVE_OPERATOR(Lt, Lt, "lt.h", false),
+    NATIVE_OPERATOR(NoMatch, NoMatch, "no_match.h", false),
+    NATIVE_OPERATOR(Pm, Pm, "pm.h", true),
+    NATIVE_OPERATOR(PmF, PmFromFile, "pm_f.h", true),
+    NATIVE_OPERATOR(PmFromFile, PmFromFile, "pm_from_file.h", true),
+    NATIVE_OPERATOR(Rx, Rx, "rx.h", true),
+    NATIVE_OPERATOR(RxGlobal, RxGlobal, "rx_global.h", true),
+    NATIVE_OPERATOR(StrEq, StrEq, "str_eq.h", false),
+    NATIVE_OPERATOR(StrMatch, StrMatch, "str_match.h", false),
+    NATIVE_OPERATOR(UnconditionalMatch, UnconditionalMatch,
+        "unconditional_match.h", false),
+    NATIVE_OPERATOR(ValidateByteRange, ValidateByteRange,
+        "validate_byte_range.h", true),
+    NATIVE_OPERATOR(ValidateUrlEncoding, ValidateUrlEncoding,
+        "validate_url_encoding.h", true),
+    NATIVE_OPERATOR(ValidateUtf8Encoding, ValidateUtf8Encoding,
+        "validate_utf8_encoding.h", true),
+    NATIVE_OPERATOR(Within, Within, "within.h", true),
+};
+
+#undef NATIVE_OPERATOR
+
+
+/*
+ * m_inPlace for the ones with a transform() of their own; the others
+ * only have evaluate(), which Transformation::transform() swaps in.
+ */
+class TransformationClass {
+ public:
+    const std::type_info *m_type;
+    const char *m_name;
+    const char *m_header;
+    bool m_inPlace;
+};
+
+#define NATIVE_TRANSFORMATION(c, h, inPlace) \
+    { &typeid(actions::transformations::c), #c, \
+        "src/actions/transformations/" h, inPlace }
+
+const TransformationClass transformationClasses[] = {
+    NATIVE_TRANSFORMATION(Base64Decode, "base64_decode.h", false),
+    NATIVE_TRANSFORMATION(Base64DecodeExt, "base64_decode_ext.h", false),
+    NATIVE_TRANSFORMATION(Base64Encode, "base64_encode.h", false),
+    NATIVE_TRANSFORMATION(CmdLine, "cmd_line.h", false),
+    NATIVE_TRANSFORMATION(CompressWhitespace, "compress_whitespace.h", true),
+    NATIVE_TRANSFORMATION(CssDecode, "css_decode.h", false),
+    NATIVE_TRANSFORMATION(EscapeSeqDecode, "escape_seq_decode.h", false),
+    NATIVE_TRANSFORMATION(Fused, "fused.h", true),
+    NATIVE_TRANSFORMATION(HexDecode, "hex_decode.h", true),
+    NATIVE_TRANSFORMATION(HexEncode, "hex_encode.h", false),
+    NATIVE_TRANSFORMATION(HtmlEntityDecode, "html_entity_decode.h", true),
+    NATIVE_TRANSFORMATION(JsDecode, "js_decode.h", true),
+    NATIVE_TRANSFORMATION(Length, "length.h", false),
+    NATIVE_TRANSFORMATION(LowerCase, "lower_case.h", true),
+    NATIVE_TRANSFORMATION(Md5, "md5.h", false),
+    NATIVE_TRANSFORMATION(None, "none.h", true),
+    NATIVE_TRANSFORMATION(NormalisePath, "normalise_path.h", false),
+    NATIVE_TRANSFORMATION(NormalisePathWin, "normalise_path_win.h", false),
+    NATIVE_TRANSFORMATION(ParityEven7bit, "parity_even_7bit.h", true),
+    NATIVE_TRANSFORMATION(ParityOdd7bit, "parity_odd_7bit.h", true),
+    NATIVE_TRANSFORMATION(ParityZero7bit, "parity_zero_7bit.h", true),
+    NATIVE_TRANSFORMATION(RemoveComments, "remove_comments.h", false),
+    NATIVE_TRANSFORMATION(RemoveCommentsChar, "remove_comments_char.h",
+        false),
+    NATIVE_TRANSFORMATION(RemoveNulls, "remove_nulls.h", true),
+    NATIVE_TRANSFORMATION(RemoveWhitespace, "remove_whitespace.h", true),
+    NATIVE_TRANSFORMATION(ReplaceComments, "replace_comments.h", false),
+    NATIVE_TRANSFORMATION(ReplaceNulls, "replace_nulls.h", true),
+    NATIVE_TRANSFORMATION(Sha1, "sha1.h", false),
+    NATIVE_TRANSFORMATION(SqlHexDecode, "sql_hex_decode.h", false),
+    NATIVE_TRANSFORMATION(Trim, "trim.h", true),
+    NATIVE_TRANSFORMATION(TrimLeft, "trim_left.h", true),
+    NATIVE_TRANSFORMATION(TrimRight, "trim_right.h", true),
+    NATIVE_TRANSFORMATION(UpperCase, "upper_case.h", true),
+    NATIVE_TRANSFORMATION(UrlDecode, "url_decode.h", true),
+    NATIVE_TRANSFORMATION(UrlDecodeUni, "url_decode_uni.h", true),
+    NATIVE_TRANSFORMATION(UrlEncode, "url_encode.h", false),
+    NATIVE_TRANSFORMATION(Utf8ToUnicode, "utf8_to_unicode.h", false),
+};
+
+#undef NATIVE_TRANSFORMATION
+
+
+const OperatorClass *operatorClass(const operators::Operator *op) {
+    for (const OperatorClass &c : operatorClasses) {
+        if (*c.m_type == typeid(*op)) {
+            return &c;
+        }
+    }
+    return nullptr;
+}
+
+
+const TransformationClass *transformationClass(const Transformation *t) {
+    for (const TransformationClass &c : transformationClasses) {
+        if (*c.m_type == typeid(*t)) {
+            return &c;
+        }
+    }
+    return nullptr;
+}
+
+
+/* The function for the operator of c over the transformations of chain. */
+void writeMatch(std::ostream &out, size_t n, const OperatorClass *c,
+    const std::vector<const TransformationClass *> &chain) {
+    const char *input = chain.empty() ? "in" : "*value";
+
+    out << "/* " << c->m_name;
+    for (size_t i = 0; i < chain.size(); i++) {
+        out << (i ? ", " : " after ") << chain[i]->m_name;
+    }
+    out << " */" << std::endl;
+    out << "bool match" << n << "(Transaction *t, RuleWithActions *rule, "
+        << "op::Operator *o," << std::endl
+        << "    tr::Transformation *const *chain, const std::string &in,"
+        << std::endl
+        << "    std::string *value, std::shared_ptr<RuleMessage> rm) {"
+        << std::endl;
+    if (chain.empty() == false) {
+        out << "    value->assign(in);" << std::endl;
+    }
+    for (size_t i = 0; i < chain.size(); i++) {
+        const char *name = chain[i]->m_name;
+        if (chain[i]->m_inPlace) {
+            out << "    static_cast<tr::" << name << " *>(chain[" << i
+                << "])->tr::" << name << "::transform(*value, t);"
+                << std::endl;
+        } else {
+            out << "    {" << std::endl
+                << "        std::string r(static_cast<tr::" << name
+                << " *>(chain[" << i << "])->tr::" << name
+                << "::evaluate(*value, t));" << std::endl
+                << "        value->swap(r);" << std::endl
+                << "    }" << std::endl;
+        }
+    }
+    out << "    return static_cast<op::" << c->m_name << " *>(o)->op::"
+        << c->m_impl << "::evaluate(t, ";
+    if (c->m_rule) {
+        out << "rule, " << input << ", rm)";
+    } else {
+        out << input << ")";
+    }
+    out << std::endl << "        != o->m_negation;" << std::endl
+        << "}" << std::endl << std::endl;
+
+    out << "bool bind" << n << "(const op::Operator *o," << std::endl
+        << "    const std::vector<tr::Transformation *> &chain) {"
+        << std::endl
+        << "    return typeid(*o) == typeid(op::" << c->m_name << ")"
+        << std::endl
+        << "        && chain.size() == " << chain.size();
+    for (size_t i = 0; i < chain.size(); i++) {
+        out << std::endl << "        && typeid(*chain[" << i
+            << "]) == typeid(tr::" << chain[i]->m_name << ")";
+    }
+    out << ";" << std::endl << "}" << std::endl << std::endl << std::endl;
+}
+
+}  // namespace
+
+
+void NativeRules::forEachLink(const RulesSet *set,
+    const std::function<void(RuleWithOperator *, int64_t, int)> &f) {
+    for (const RulesSetPhases *phases : {set->getBase() ?
+        &set->getBase()->m_rulesSetPhases : nullptr,
+        &set->m_rulesSetPhases}) {
+        if (phases == nullptr) {
+            continue;
+        }
+        for (int phase = 0; phase < modsecurity::Phases::NUMBER_OF_PHASES;
+            phase++) {
+            for (auto &r : phases->at(phase)->m_rules) {
+                if (r->isMarker()) {
+                    continue;
+                }
+                RuleWithActions *chain = dynamic_cast<RuleWithActions *>(
+                    r.get());
+                int link = 0;
+                for (RuleWithActions *l = chain; l != nullptr;
+                    l = l->m_chainedRuleChild.get(), link++) {
+                    RuleWithOperator *op = dynamic_cast<RuleWithOperator *>(
+                        l);
+                    if (op) {
+                        f(op, chain->m_ruleId, link);
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+bool NativeRules::compilable(const RulesSet *set,
+    const RuleWithOperator *rule) {
+    std::vector<Transformation *> chain;
+
+    if (rule->hasMultimatch() || rule->getOperator() == nullptr
+        || operatorClass(rule->getOperator()) == nullptr) {
+        return false;
+    }
+    rule->getTransformationsChain(set, &chain);
+    for (const Transformation *t : chain) {
+        if (transformationClass(t) == nullptr) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/*
+ * The links with the same operator and transformation classes share a
+ * function; what tells them apart, the parameters, is in the objects the
+ * function gets at run time.
+ */
+std::string NativeRules::source(const RulesSet *rules) {
+    std::map<std::string, size_t> functions;
+    std::map<std::string, bool> headers;
+    std::stringstream body;
+    std::stringstream table;
+    std::stringstream out;
+    size_t links = 0;
+
+    forEachLink(rules, [&](RuleWithOperator *rule, int64_t id,
+        int link) {
+        std::vector<Transformation *> chain;
+        std::vector<const TransformationClass *> classes;
+
+        if (compilable(rules, rule) == false) {
+            return;
+        }
+        const OperatorClass *c = operatorClass(rule->getOperator());
+        std::string signature(c->m_name);
+        headers[c->m_header] = true;
+        rule->getTransformationsChain(rules, &chain);
+        for (const Transformation *t : chain) {
+            classes.push_back(transformationClass(t));
+            signature.append(",").append(classes.back()->m_name);
+            headers[classes.back()->m_header] = true;
+        }
+
+        auto f = functions.find(signature);
+        if (f == functions.end()) {
+            f = functions.insert(std::make_pair(signature,
+                functions.size())).first;
+            writeMatch(body, f->second, c, classes);
+        }
+        table << "    { " << id << ", " << link << ", bind" << f->second
+            << ", match" << f->second << " }," << std::endl;
+        links++;
+    });
+
+    out << "/*" << std::endl
+        << " * Written by rules-check -n for ModSecurity "
+        << MODSECURITY_VERSION << ": " << links << " rules, "
+        << functions.size() << " functions." << std::endl
+        << " * See src/native_rules.h for how to build it." << std::endl
+        << " */" << std::endl << std::endl
+        << "#include <memory>" << std::endl
+        << "#include <string>" << std::endl
+        << "#include <typeinfo>" << std::endl
+        << "#include <vector>" << std::endl << std::endl
+        << "#include \"modsecurity/modsecurity.h\"" << std::endl
+        << "#include \"modsecurity/rule_message.h\"" << std::endl
+        << "#include \"modsecurity/rule_with_actions.h\"" << std::endl
+        << "#include \"modsecurity/rule_with_operator.h\"" << std::endl
+        << "#include \"modsecurity/rules_set.h\"" << std::endl
+        << "#include \"modsecurity/transaction.h\"" << std::endl
+        << "#include \"src/native_rules.h\"" << std::endl;
+    for (auto &h : headers) {
+        out << "#include \"" << h.first << "\"" << std::endl;
+    }
+    out << std::endl
+        << "namespace {" << std::endl << std::endl
+        << "using modsecurity::RuleMessage;" << std::endl
+        << "using modsecurity::RuleWithActions;" << std::endl
+        << "using modsecurity::Transaction;" << std::endl
+        << "namespace op = modsecurity::operators;" << std::endl
+        << "namespace tr = modsecurity::actions::transformations;"
+        << std::endl << std::endl << std::endl
+        << body.str()
+        << "const modsecurity::NativeRule rules[] = {" << std::endl
+        << table.str()
+        << "    { 0, 0, nullptr, nullptr }" << std::endl
+        << "};" << std::endl << std::endl
+        << "}  // namespace" << std::endl << std::endl << std::endl
+        << "extern \"C\" const modsecurity::NativeRule *"
+        << MSC_NATIVE_RULES_SYMBOL << "(long abi," << std::endl
+        << "    long version, uint64_t build, size_t *count) {"
+        << std::endl
+        << "    if (abi != MSC_NATIVE_RULES_ABI"
+        << " || version != MODSECURITY_VERSION_NUM" << std::endl
+        << "        || build != MSC_NATIVE_RULES_BUILD) {" << std::endl
+        << "        return nullptr;" << std::endl
+        << "    }" << std::endl
+        << "    *count = sizeof(rules) / sizeof(rules[0]) - 1;" << std::endl
+        << "    return rules;" << std::endl
+        << "}" << std::endl;
+
+    return out.str();
+}
+
+
+NativeModule::~NativeModule() {
+    dlclose(m_handle);
+}
+
+
+std::shared_ptr<NativeModule> NativeRules::load(const std::string &path,
+    std::string *error) {
+    void *module = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (module == nullptr) {
+        const char *e = dlerror();
+        error->assign(e ? e : "failed to load " + path);
+        return nullptr;
+    }
+
+    NativeRulesFn rules = reinterpret_cast<NativeRulesFn>(dlsym(module,
+        MSC_NATIVE_RULES_SYMBOL));
+    if (rules == nullptr) {
+        error->assign(path + " has no " MSC_NATIVE_RULES_SYMBOL
+            "(), it is not a rules module");
+        dlclose(module);
+        return nullptr;
+    }
+
+    size_t count = 0;
+    const NativeRule *ret = rules(MSC_NATIVE_RULES_ABI,
+        MODSECURITY_VERSION_NUM, MSC_NATIVE_RULES_BUILD, &count);
+    if (ret == nullptr) {
+        error->assign(path + " was built for another version of " \
+            "ModSecurity, or with other options; it has to be written " \
+            "and built again (rules-check -n)");
+        dlclose(module);
+        return nullptr;
+    }
+    return std::make_shared<NativeModule>(module, path, ret, count);
+}
+
+
+NativeMatch *NativeRules::bind(const NativeRule &entry, const RulesSet *set,
+    const RuleWithOperator *rule) {
+    if (rule->hasMultimatch()) {
+        return nullptr;
+    }
+
+    NativeMatch *native = new NativeMatch();
+    rule->getTransformationsChain(set, &native->m_chain);
+    if (entry.m_bind(rule->getOperator(), native->m_chain) == false) {
+        delete native;
+        return nullptr;
+    }
+
+    native->m_match = entry.m_match;
+    for (const Transformation *t : native->m_chain) {
+        if (!native->m_path.empty()) {
+            native->m_path.push_back(',');
+        }
+        native->m_path.append(*t->m_name);
+    }
+    return native;
+}
+
+
+}  // namespace modsecurity
@@ -0,0 +1,237 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifndef SRC_NATIVE_RULES_H_
+#define SRC_NATIVE_RULES_H_
+
+
+namespace modsecurity {
+class RuleMessage;
+class RulesSet;
+class RuleWithActions;
+class RuleWithOperator;
+class Transaction;
+namespace operators {
+class Operator;
+}
+namespace actions {
+namespace transformations {
+class Transformation;
+}
+}
+
+
+/*
+ * Changed along with NativeRule and the functions below; a module built
+ * for another value, or another MODSECURITY_VERSION_NUM, is refused.
+ */
+#define MSC_NATIVE_RULES_ABI 2
+
+
+/*
+ * What the classes a module calls into look like in the translation unit
+ * it is computed in: the compiler, the options that change their layout
+ * and the sizes given. A module built with other options than the
+ * library, or by another compiler, is refused though it was written for
+ * the same version. See MSC_NATIVE_RULES_BUILD.
+ */
+inline uint64_t nativeRulesBuild(std::initializer_list<size_t> sizes) {
+    const char *options = ""
+#ifdef __VERSION__
+        __VERSION__
+#endif
+#ifdef _GLIBCXX_USE_CXX11_ABI
+        " cxx11abi"
+#endif
+#ifdef NO_LOGS
+        " no_logs"
+#endif
+#if WITH_PCRE2
+        " pcre2"
+#endif
+#ifdef WITH_RE2
+        " re2"
+#endif
+#ifdef WITH_HYPERSCAN
+        " hyperscan"
+#endif
+#ifdef WITH_LUA
+        " lua"
+#endif
+#ifdef WITH_LIBXML2
+        " libxml2"
+#endif
+#ifdef MODSEC_MUTEX_ON_PM
+        " mutex_on_pm"
+#endif
+        "";
+    /* FNV-1a */
+    uint64_t h = 14695981039346656037ULL;
+    for (const char *c = options; *c != '\0'; c++) {
+        h = (h ^ static_cast<unsigned char>(*c)) * 1099511628211ULL;
+    }
+    for (size_t size : sizes) {
+        h = (h ^ size) * 1099511628211ULL;
+    }
+    return h;
+}
+
+/* Where Transaction, the rule and rule set classes are complete. */
+#define MSC_NATIVE_RULES_BUILD modsecurity::nativeRulesBuild({ \
+    sizeof(modsecurity::Transaction), \
+    sizeof(modsecurity::RuleMessage), \
+    sizeof(modsecurity::RuleWithActions), \
+    sizeof(modsecurity::RuleWithOperator), \
+    sizeof(modsecurity::RulesSet), \
+    sizeof(std::string)})
+
+
+/*
+ * Transformations of chain over in, into *value, and the operator over
+ * the result, negation included: what executeTransformations() and
+ * executeOperatorAt() do for a rule without multiMatch.
+ */
+typedef bool (*NativeMatchFn)(Transaction *t, RuleWithActions *rule,
+    operators::Operator *op,
+    actions::transformations::Transformation *const *chain,
+    const std::string &in, std::string *value,
+    std::shared_ptr<RuleMessage> ruleMessage);
+
+/* Whether op and chain are the very classes the match was written for. */
+typedef bool (*NativeBindFn)(const operators::Operator *op,
+    const std::vector<actions::transformations::Transformation *> &chain);
+
+
+/*
+ * A link of a chain in a module written by NativeRules::source(): the id
+ * of the rule that starts the chain and how far down it the link is.
+ */
+struct NativeRule {
+    int64_t m_ruleId;
+    int m_link;
+    NativeBindFn m_bind;
+    NativeMatchFn m_match;
+};
+
+
+/* What a module exports, under this name. */
+#define MSC_NATIVE_RULES_SYMBOL "msc_native_rules"
+typedef const NativeRule *(*NativeRulesFn)(long abi, long version,
+    uint64_t build, size_t *count);
+
+
+/**
+ * A module loaded by NativeRules::load(), unloaded when the last rule set
+ * bound to it is gone (see RulesSet::m_nativeModule).
+ */
+class NativeModule {
+ public:
+    NativeModule(void *handle, const std::string &path,
+        const NativeRule *rules, size_t count)
+        : m_path(path),
+        m_rules(rules),
+        m_count(count),
+        m_handle(handle) { }
+    ~NativeModule();
+
+    NativeModule(const NativeModule &) = delete;
+    NativeModule &operator=(const NativeModule &) = delete;
+
+    const std::string m_path;
+    const NativeRule *const m_rules;
+    const size_t m_count;
+
+ private:
+    void *m_handle;
+};
+
+
+/**
+ * A rule of a set bound to the function a module has for it, see
+ * RulesSet::nativeMatch.
+ */
+class NativeMatch {
+ public:
+    NativeMatchFn m_match;
+    std::vector<actions::transformations::Transformation *> m_chain;
+    /* the transformation path the interpreted chain would report */
+    std::string m_path;
+};
+
+
+/**
+ * Ahead of time compilation of a rule set (SecRuleNativeModule).
+ *
+ * source() writes C++ for the transformations and the operator of every
+ * rule it knows the classes of: one function per distinct operator and
+ * transformation chain, where each step is a direct, non virtual call to
+ * the class the rule has, so the compiler can inline them into one
+ * another. Built as a shared object against the sources of this very
+ * version, e.g.
+ *
+ *   rules-check -n rules.cc rules.conf
+ *   c++ -O2 -shared -fPIC -I<src> -I<src>/headers <options> rules.cc \
+ *       -o rules.so
+ *
+ * where options are the ones (-DWITH_PCRE2...) the library was built
+ * with, and loaded on the next start. The targets and the actions are not
+ * compiled; nor is a rule the module does not fit, because it changed
+ * since, or because its operator or a transformation has no entry in
+ * the tables of native_rules.cc: it is interpreted as usual.
+ *
+ */
+class NativeRules {
+ public:
+    static std::string source(const RulesSet *rules);
+
+    /**
+     * The module at path, nullptr with *error set if it can not be
+     * loaded or was built for something else.
+     */
+    static std::shared_ptr<NativeModule> load(const std::string &path,
+        std::string *error);
+
+    /**
+     * rule, of set, bound to the function of entry; nullptr if that was
+     * written for other classes.
+     */
+    static NativeMatch *bind(const NativeRule &entry, const RulesSet *set,
+        const RuleWithOperator *rule);
+
+    /**
+     * Calls f for every link of every chain of set, the base of an
+     * overlay first, with the id of the chain and the place of the link
+     * in it: what NativeRule tells the rules apart with.
+     */
+    static void forEachLink(const RulesSet *set,
+        const std::function<void(RuleWithOperator *, int64_t, int)> &f);
+
+    /* Whether the rule is one source() writes a function for. */
+    static bool compilable(const RulesSet *set, const RuleWithOperator *rule);
+};
+
+
+}  // namespace modsecurity
+
+#endif  // SRC_NATIVE_RULES_H_
@@ -34,6 +34,7 @@ class BeginsWith : public Operator {
 
     bool evaluate(Transaction *transaction, RuleWithActions *rule, const std::string &str,
         std::shared_ptr<RuleMessage> ruleMessage) override;
+    bool parallelSafe() const override { return true; }
 };
 
 }  // namespace operators
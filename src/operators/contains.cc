@@ -17,16 +17,23 @@
 
 #include <string>
 
+#include "src/utils/byte_scan.h"
+
 
 namespace modsecurity {
 namespace operators {
 
 bool Contains::evaluate(Transaction *transaction, RuleWithActions *rule,
         const std::string &input, std::shared_ptr<RuleMessage> ruleMessage) {
-    std::string p(m_string->evaluate(transaction));
-    size_t offset = input.find(p);
+    std::string expanded;
+    if (m_string->m_containsMacro) {
+        expanded = m_string->evaluate(transaction);
+    }
+    const std::string &p = m_string->m_containsMacro ? expanded : m_param;
+    size_t offset = utils::scan::findString(input.data(), input.size(),
+        p.data(), p.size());
 
-    bool contains = offset != std::string::npos;
+    bool contains = offset != input.size() || p.empty();
 
     if (contains && transaction) {
         logOffset(ruleMessage, offset, p.size());
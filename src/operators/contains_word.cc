@@ -19,6 +19,7 @@
 
 #include "src/operators/operator.h"
 #include "modsecurity/rule_message.h"
+#include "src/utils/byte_scan.h"
 
 namespace modsecurity {
 namespace operators {
@@ -38,7 +39,12 @@ bool ContainsWord::acceptableChar(const std::string& a, size_t pos) {
 
 bool ContainsWord::evaluate(Transaction *transaction, RuleWithActions *rule,
     const std::string &str, std::shared_ptr<RuleMessage> ruleMessage) {
-    std::string paramTarget(m_string->evaluate(transaction));
+    std::string expanded;
+    if (m_string->m_containsMacro) {
+        expanded = m_string->evaluate(transaction);
+    }
+    const std::string &paramTarget = m_string->m_containsMacro ? expanded
+        : m_param;
 
     if (paramTarget.empty()) {
         return true;
@@ -50,8 +56,9 @@ bool ContainsWord::evaluate(Transaction *transaction, RuleWithActions *rule,
         return true;
     }
 
-    size_t pos = str.find(paramTarget);
-    while (pos != std::string::npos) {
+    size_t pos = utils::scan::findString(str.data(), str.size(),
+        paramTarget.data(), paramTarget.size());
+    while (pos != str.size()) {
         if (pos == 0 && acceptableChar(str, paramTarget.size())) {
             logOffset(ruleMessage, 0, paramTarget.size());
             return true;
@@ -66,7 +73,8 @@ bool ContainsWord::evaluate(Transaction *transaction, RuleWithActions *rule,
             logOffset(ruleMessage, pos, paramTarget.size());
             return true;
         }
-        pos = str.find(paramTarget, pos + 1);
+        pos = pos + 1 + utils::scan::findString(str.data() + pos + 1,
+            str.size() - pos - 1, paramTarget.data(), paramTarget.size());
     }
 
     return false;
@@ -35,6 +35,7 @@ class ContainsWord : public Operator {
     bool evaluate(Transaction *transaction, RuleWithActions *rule,
         const std::string &str,
         std::shared_ptr<RuleMessage> ruleMessage) override;
+    bool parallelSafe() const override { return true; }
 
  private:
     static bool acceptableChar(const std::string& a, size_t pos);
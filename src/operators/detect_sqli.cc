@@ -19,18 +19,50 @@
 #include <list>
 
 #include "src/operators/operator.h"
+#include "src/operators/injection_cache.h"
+#include "src/utils/byte_scan.h"
 #include "others/libinjection/src/libinjection.h"
 
 namespace modsecurity {
 namespace operators {
 
+namespace {
+
+/*
+ * Without quotes libinjection only tokenizes the input as it is, and a
+ * lone word or number is a single token, which is not what any of its
+ * fingerprints is made of. Most parameter values are like that.
+ */
+bool cannotBeSQLi(const std::string &input) {
+    const char *p = input.c_str();
+    size_t len = input.size();
+
+    return len == 0
+        || utils::scan::findNotLetter(p, len) == len
+        || utils::scan::findNotDigit(p, len) == len;
+}
+
+}  // namespace
+
 
 bool DetectSQLi::evaluate(Transaction *t, RuleWithActions *rule,
     const std::string& input, std::shared_ptr<RuleMessage> ruleMessage) {
-    char fingerprint[8];
+    InjectionCache::Result result;
+    const char *fingerprint = result.m_fingerprint;
     int issqli;
 
-    issqli = libinjection_sqli(input.c_str(), input.length(), fingerprint);
+    result.m_found = false;
+    result.m_fingerprint[0] = '\0';
+    if (!cannotBeSQLi(input) && (t == NULL || !t->m_injectionCache->find(
+        InjectionCache::SQLiKind, input, &result))) {
+        result.m_found = libinjection_sqli(input.c_str(), input.length(),
+            result.m_fingerprint) != 0;
+        if (t) {
+            t->m_injectionCache->insert(InjectionCache::SQLiKind, input,
+                result);
+        }
+    }
+    issqli = result.m_found;
 
     if (!t) {
         goto tisempty;
@@ -18,18 +18,44 @@
 #include <string>
 
 #include "src/operators/operator.h"
+#include "src/operators/injection_cache.h"
+#include "src/utils/byte_scan.h"
 #include "others/libinjection/src/libinjection.h"
 
 
 namespace modsecurity {
 namespace operators {
 
+namespace {
+
+/*
+ * libinjection looks for tags, attributes and attribute values; with no
+ * byte that opens or ends one of those the whole input is a single run
+ * of text or of unquoted value, in every context it is parsed in.
+ */
+bool cannotBeXSS(const std::string &input) {
+    return utils::scan::findMarkup(input.c_str(), input.size())
+        == input.size();
+}
+
+}  // namespace
+
 
 bool DetectXSS::evaluate(Transaction *t, RuleWithActions *rule,
     const std::string& input, std::shared_ptr<RuleMessage> ruleMessage) {
+    InjectionCache::Result result;
     int is_xss;
 
-    is_xss = libinjection_xss(input.c_str(), input.length());
+    result.m_found = false;
+    if (!cannotBeXSS(input) && (t == NULL || !t->m_injectionCache->find(
+        InjectionCache::XSSKind, input, &result))) {
+        result.m_found = libinjection_xss(input.c_str(), input.length()) != 0;
+        if (t) {
+            t->m_injectionCache->insert(InjectionCache::XSSKind, input,
+                result);
+        }
+    }
+    is_xss = result.m_found;
 
     if (t) {
         if (is_xss) {
@@ -34,6 +34,7 @@ class DetectXSS : public Operator {
     bool evaluate(Transaction *t, RuleWithActions *rule,
         const std::string& input,
         std::shared_ptr<RuleMessage> ruleMessage) override;
+    bool parallelSafe() const override { return true; }
 };
 
 }  // namespace operators
@@ -26,7 +26,11 @@ namespace operators {
 bool EndsWith::evaluate(Transaction *transaction, RuleWithActions *rule,
     const std::string &str, std::shared_ptr<RuleMessage> ruleMessage) {
     bool ret = false;
-    std::string p(m_string->evaluate(transaction));
+    std::string expanded;
+    if (m_string->m_containsMacro) {
+        expanded = m_string->evaluate(transaction);
+    }
+    const std::string &p = m_string->m_containsMacro ? expanded : m_param;
 
     if (str.length() >= p.length()) {
         ret = (0 == str.compare(str.length() - p.length(),
@@ -15,6 +15,10 @@
 
 #include "src/operators/eq.h"
 
+#include <errno.h>
+#include <limits.h>
+#include <stdlib.h>
+
 #include <string>
 
 #include "src/operators/operator.h"
@@ -25,22 +29,20 @@ namespace operators {
 
 
 bool Eq::evaluate(Transaction *transaction, const std::string &input) {
-    int p = 0;
-    int i = 0;
-    std::string pt(m_string->evaluate(transaction));
-
-    try {
-        p = std::stoi(pt);
-    } catch (...) {
-        p = 0;
-    }
-    try {
-        i = std::stoi(input);
-    } catch (...) {
-        i = 0;
-    }
+    return toNumber(input) == operand(transaction);
+}
 
-    return p == i;
+
+long long Eq::toNumber(const std::string &value) const {
+    const char *begin = value.c_str();
+    char *end = nullptr;
+
+    errno = 0;
+    long n = strtol(begin, &end, 10);
+    if (end == begin || errno == ERANGE || n < INT_MIN || n > INT_MAX) {
+        return 0;
+    }
+    return n;
 }
 
 
@@ -20,18 +20,22 @@
 #include <memory>
 #include <utility>
 
-#include "src/operators/operator.h"
+#include "src/operators/numeric_operator.h"
 
 
 namespace modsecurity {
 namespace operators {
 
-class Eq : public Operator {
+class Eq : public NumericOperator {
  public:
     /** @ingroup ModSecurity_Operator */
     explicit Eq(std::unique_ptr<RunTimeString> param)
-        : Operator("Eq", std::move(param)) { }
+        : NumericOperator("Eq", std::move(param)) { }
     bool evaluate(Transaction *transaction, const std::string &input) override;
+
+ protected:
+    /* std::stoi(), 0 where it would throw */
+    long long toNumber(const std::string &value) const override;
 };
 
 }  // namespace operators
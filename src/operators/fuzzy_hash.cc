@@ -15,7 +15,11 @@
 
 #include "src/operators/fuzzy_hash.h"
 
+#include <stdlib.h>
+
+#include <algorithm>
 #include <string>
+#include <vector>
 
 #include "src/operators/operator.h"
 #include "src/utils/system.h"
@@ -23,13 +27,99 @@
 namespace modsecurity {
 namespace operators {
 
+
+#ifdef WITH_SSDEEP
+namespace {
+
+
+/* ssdeep gives 0 to the signatures without a common substring this long. */
+const size_t kGram = 7;
+
+
+/*
+ * blocksize:first:second, as fuzzy_hash_buf() writes it, maybe followed
+ * by ,"filename" as in the files that ssdeep writes.
+ */
+bool parseHash(const std::string &hash, uint64_t *blockSize,
+    std::string *first, std::string *second) {
+    const char *p = hash.c_str();
+    char *end = NULL;
+
+    *blockSize = strtoul(p, &end, 10);
+    if (end == p || *end != ':') {
+        return false;
+    }
+    size_t a = end - p + 1;
+    size_t b = hash.find(':', a);
+    if (b == std::string::npos) {
+        return false;
+    }
+    size_t c = hash.find(',', b + 1);
+    first->assign(hash, a, b - a);
+    second->assign(hash, b + 1,
+        c == std::string::npos ? std::string::npos : c - b - 1);
+    return true;
+}
+
+
+void addGrams(const std::string &s, uint64_t blockSize,
+    std::vector<uint32_t> *keys) {
+    for (size_t i = 0; i + kGram <= s.size(); i++) {
+        uint64_t g = 0;
+        for (size_t j = 0; j < kGram; j++) {
+            g = g << 8 | static_cast<unsigned char>(s[i + j]);
+        }
+        g = (g ^ blockSize * 0x9e3779b97f4a7c15ULL) * 0xff51afd7ed558ccdULL;
+        keys->push_back(static_cast<uint32_t>(g >> 32));
+    }
+}
+
+
+/*
+ * Signatures are only compared at the same block size, the first one of
+ * a hash being for its block size and the second one for twice that.
+ * Recent versions of ssdeep collapse the runs of more than three equal
+ * characters before comparing and older ones do not, so the grams of
+ * both forms are taken.
+ */
+void hashKeys(uint64_t blockSize, const std::string &first,
+    const std::string &second, std::vector<uint32_t> *keys) {
+    const std::string *s[] = { &first, &second };
+
+    keys->clear();
+    for (int k = 0; k < 2; k++) {
+        std::string collapsed;
+        for (size_t i = 0; i < s[k]->size(); i++) {
+            if (i < 3 || (*s[k])[i] != (*s[k])[i - 1]
+                || (*s[k])[i] != (*s[k])[i - 2]
+                || (*s[k])[i] != (*s[k])[i - 3]) {
+                collapsed.push_back((*s[k])[i]);
+            }
+        }
+        addGrams(*s[k], blockSize << k, keys);
+        if (collapsed.size() != s[k]->size()) {
+            addGrams(collapsed, blockSize << k, keys);
+        }
+    }
+    std::sort(keys->begin(), keys->end());
+    keys->erase(std::unique(keys->begin(), keys->end()), keys->end());
+}
+
+
+}  // namespace
+#endif
+
+
 bool FuzzyHash::init(const std::string &param2, std::string *error) {
 #ifdef WITH_SSDEEP
     std::string digit;
     std::string file;
     std::istream *iss;
-    struct fuzzy_hash_chunk *chunk, *t;
     std::string err;
+    uint64_t blockSize;
+    std::string first;
+    std::string second;
+    std::vector<uint32_t> keys;
 
     auto pos = m_param.find_last_of(' ');
     if (pos == std::string::npos) {
@@ -55,24 +145,21 @@ bool FuzzyHash::init(const std::string &param2, std::string *error) {
     }
 
     for (std::string line; std::getline(*iss, line); ) {
-       chunk = (struct fuzzy_hash_chunk *)calloc(1,
-            sizeof(struct fuzzy_hash_chunk));
+        uint32_t i = m_hashes.size();
 
-        chunk->data = strdup(line.c_str());
-        chunk->next = NULL;
-
-        if (m_head == NULL) {
-            m_head = chunk;
-        } else {
-            t = m_head;
-
-            while (t->next) {
-                t = t->next;
-            }
-
-            t->next = chunk;
+        keys.clear();
+        if (parseHash(line, &blockSize, &first, &second)) {
+            hashKeys(blockSize, first, second, &keys);
+        }
+        if (keys.empty()) {
+            m_unindexed.push_back(i);
+        }
+        for (uint32_t key : keys) {
+            m_index.push_back(static_cast<uint64_t>(key) << 32 | i);
         }
+        m_hashes.push_back(line);
     }
+    std::sort(m_index.begin(), m_index.end());
 
     delete iss;
     return true;
@@ -83,23 +170,14 @@ bool FuzzyHash::init(const std::string &param2, std::string *error) {
 #endif
 }
 
-FuzzyHash::~FuzzyHash() {
-    struct fuzzy_hash_chunk *c = m_head;
-    while (c) {
-        struct fuzzy_hash_chunk *t = c;
-        free(c->data);
-        c->data = NULL;
-        c = c->next;
-        free(t);
-    }
-    m_head = NULL;
-}
-
-
 bool FuzzyHash::evaluate(Transaction *t, const std::string &str) {
 #ifdef WITH_SSDEEP
     char result[FUZZY_MAX_RESULT];
-    struct fuzzy_hash_chunk *chunk = m_head;
+    uint64_t blockSize;
+    std::string first;
+    std::string second;
+    std::vector<uint32_t> keys;
+    std::vector<uint32_t> candidates;
 
     if (fuzzy_hash_buf((const unsigned char*)str.c_str(),
         str.size(), result)) {
@@ -107,14 +185,37 @@ bool FuzzyHash::evaluate(Transaction *t, const std::string &str) {
         return false;
     }
 
-    while (chunk != NULL) {
-        int i = fuzzy_compare(chunk->data, result);
+    /*
+     * Anything scores 0 or more, so a threshold that low needs all of
+     * them. The candidates are compared in the order of the file, for
+     * the first match to be the same one as without the index.
+     */
+    if (m_threshold > 0 && parseHash(result, &blockSize, &first, &second)) {
+        hashKeys(blockSize, first, second, &keys);
+        candidates = m_unindexed;
+        for (uint32_t key : keys) {
+            auto it = std::lower_bound(m_index.begin(), m_index.end(),
+                static_cast<uint64_t>(key) << 32);
+            for (; it != m_index.end() && (*it >> 32) == key; ++it) {
+                candidates.push_back(static_cast<uint32_t>(*it));
+            }
+        }
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()),
+            candidates.end());
+    } else {
+        for (uint32_t i = 0; i < m_hashes.size(); i++) {
+            candidates.push_back(i);
+        }
+    }
+
+    for (uint32_t c : candidates) {
+        int i = fuzzy_compare(m_hashes[c].c_str(), result);
         if (i >= m_threshold) {
             ms_dbg_a(t, 4, "Fuzzy hash: matched " \
                 "with score: " + std::to_string(i) + ".");
             return true;
         }
-        chunk = chunk->next;
     }
 #endif
     /* No match. */
@@ -16,9 +16,12 @@
 #ifndef SRC_OPERATORS_FUZZY_HASH_H_
 #define SRC_OPERATORS_FUZZY_HASH_H_
 
+#include <stdint.h>
+
 #include <string>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #ifdef WITH_SSDEEP
 #include <fuzzy.h>
@@ -30,26 +33,28 @@ namespace modsecurity {
 namespace operators {
 
 
-struct fuzzy_hash_chunk {
-    char *data;
-    struct fuzzy_hash_chunk *next;
-};
-
 class FuzzyHash : public Operator {
  public:
     /** @ingroup ModSecurity_Operator */
     explicit FuzzyHash(std::unique_ptr<RunTimeString> param)
         : Operator("FuzzyHash", std::move(param)),
-        m_threshold(0),
-        m_head(NULL) { }
-    ~FuzzyHash();
+        m_threshold(0) { }
 
     bool evaluate(Transaction *transaction, const std::string &std) override;
 
     bool init(const std::string &param, std::string *error) override;
  private:
     int m_threshold;
-    struct fuzzy_hash_chunk *m_head;
+    /* The lines of the file, in its order. */
+    std::vector<std::string> m_hashes;
+    /*
+     * Sorted n-gram key << 32 | index in m_hashes: every hash is listed
+     * under the keys of the 7-grams of its signatures, so that evaluate()
+     * only compares the ones that share one with the input.
+     */
+    std::vector<uint64_t> m_index;
+    /* The lines there is no n-gram of, compared every time. */
+    std::vector<uint32_t> m_unindexed;
 };
 
 }  // namespace operators
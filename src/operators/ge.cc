@@ -24,12 +24,7 @@ namespace modsecurity {
 namespace operators {
 
 bool Ge::evaluate(Transaction *transaction, const std::string &input) {
-    std::string p(m_string->evaluate(transaction));
-    std::string i = input;
-
-    bool ge = atoll(i.c_str()) >= atoll(p.c_str());
-
-    return ge;
+    return toNumber(input) >= operand(transaction);
 }
 
 
@@ -20,16 +20,16 @@
 #include <memory>
 #include <utility>
 
-#include "src/operators/operator.h"
+#include "src/operators/numeric_operator.h"
 
 namespace modsecurity {
 namespace operators {
 
-class Ge : public Operator {
+class Ge : public NumericOperator {
  public:
     /** @ingroup ModSecurity_Operator */
     explicit Ge(std::unique_ptr<RunTimeString> param)
-        : Operator("Ge", std::move(param)) {
+        : NumericOperator("Ge", std::move(param)) {
             m_couldContainsMacro = true;
         }
     bool evaluate(Transaction *transaction, const std::string &input) override;
@@ -16,21 +16,114 @@
 #include "src/operators/gsblookup.h"
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "src/operators/operator.h"
+#include "src/utils/gsb.h"
 
 namespace modsecurity {
 namespace operators {
 
 
-bool GsbLookup::evaluate(Transaction *transaction, const std::string &str) {
-    /**
-     * @todo Implement the operator GeoLookup.
-     *       Reference: https://github.com/SpiderLabs/ModSecurity/wiki/Reference-Manual#gsblookup
-     */
+namespace {
+
+/* URLs looked up per input, at most */
+const size_t kMaxUrls = 32;
+
+const char kSeparators[] = " \t\r\n\"'<>()[]{},;|";
+
+}  // namespace
+
+
+bool GsbLookup::init(const std::string &file, std::string *error) {
+    if (m_param.empty()) {
+        return true;
+    }
+
+    m_re.reset(new Utils::Regex(m_param));
+    if (m_re->hasError()) {
+        error->assign("Failed to compile the @gsbLookup expression: "
+            + m_param);
+        return false;
+    }
+
     return true;
 }
 
 
+/*
+ * Without the expression, a word is taken when what would be its host,
+ * up to the first slash, has a dot in it: www.example.com/a, but not 1/2.
+ */
+void GsbLookup::urlsOf(const std::string &input,
+    std::vector<std::pair<size_t, size_t>> *urls) const {
+    if (m_re) {
+        std::vector<Utils::SMatchCapture> captures;
+        m_re->searchAll(input.c_str(), input.size(), &captures);
+        for (const Utils::SMatchCapture &c : captures) {
+            if (c.m_group == 0) {
+                urls->emplace_back(c.m_offset, c.m_length);
+            } else if (c.m_group == 1 && urls->empty() == false) {
+                urls->back() = std::make_pair(c.m_offset, c.m_length);
+            }
+            if (urls->size() > kMaxUrls) {
+                urls->pop_back();
+                return;
+            }
+        }
+        return;
+    }
+
+    size_t i = input.find_first_not_of(kSeparators);
+    while (i != std::string::npos && urls->size() < kMaxUrls) {
+        size_t end = input.find_first_of(kSeparators, i);
+        size_t size = (end == std::string::npos ? input.size() : end) - i;
+        size_t scheme = input.compare(i, 7, "http://") == 0 ? 7
+            : input.compare(i, 8, "https://") == 0 ? 8 : 0;
+        size_t host = input.find_first_of("/?#", i + scheme);
+        size_t dot = input.find('.', i + scheme);
+        if (dot != std::string::npos && dot < i + size
+            && (host == std::string::npos || dot < host)) {
+            urls->emplace_back(i, size);
+        }
+        i = end == std::string::npos ? end
+            : input.find_first_not_of(kSeparators, end);
+    }
+}
+
+
+bool GsbLookup::evaluate(Transaction *t, RuleWithActions *rule,
+    const std::string &input, std::shared_ptr<RuleMessage> ruleMessage) {
+    Utils::Gsb &gsb = Utils::Gsb::getInstance();
+    std::vector<std::pair<size_t, size_t>> urls;
+
+    if (gsb.configured() == false) {
+        ms_dbg_a(t, 4, "GSB: no SecGsbLookupDb, nothing to look up in.");
+        return false;
+    }
+
+    urlsOf(input, &urls);
+    for (const auto &u : urls) {
+        std::string url(input, u.first, u.second);
+        std::string threat;
+        if (gsb.lookup(url, &threat) == false) {
+            continue;
+        }
+
+        ms_dbg_a(t, 4, "GSB: " + url + " is in the lists" \
+            + (threat.empty() ? "" : " (" + threat + ")") + ".");
+        if (rule && t && rule->hasCaptureAction()) {
+            t->m_collections.m_tx_collection->storeOrUpdateFirst("0", url);
+            ms_dbg_a(t, 7, "Added GSB match TX.0: " + url);
+        }
+        logOffset(ruleMessage, u.first, u.second);
+        return true;
+    }
+
+    return false;
+}
+
+
 }  // namespace operators
 }  // namespace modsecurity
@@ -19,19 +19,39 @@
 #include <string>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "src/operators/operator.h"
+#include "src/utils/regex.h"
 
 namespace modsecurity {
 namespace operators {
 
+/**
+ * Looks the URLs of the input up in the Safe Browsing lists (see
+ * Utils::Gsb). The parameter, if any, is a regular expression that finds
+ * them: its first capture group, or the whole match, is the URL. Without
+ * one, the words of the input that look like an URL are taken.
+ */
 class GsbLookup : public Operator {
  public:
     /** @ingroup ModSecurity_Operator */
     explicit GsbLookup(std::unique_ptr<RunTimeString> param)
         : Operator("GsbLookup", std::move(param)) { }
 
-    bool evaluate(Transaction *transaction, const std::string &str) override;
+    bool init(const std::string &file, std::string *error) override;
+    bool evaluate(Transaction *transaction, RuleWithActions *rule,
+        const std::string &input,
+        std::shared_ptr<RuleMessage> ruleMessage) override;
+    bool threadSafeInit() const override { return true; }
+    bool parallelSafe() const override { return true; }
+
+ private:
+    /* offset and size within input of each URL to look up */
+    void urlsOf(const std::string &input,
+        std::vector<std::pair<size_t, size_t>> *urls) const;
+
+    std::unique_ptr<Utils::Regex> m_re;
 };
 
 }  // namespace operators
@@ -24,11 +24,7 @@ namespace modsecurity {
 namespace operators {
 
 bool Gt::evaluate(Transaction *transaction, const std::string &input) {
-    std::string p(m_string->evaluate(transaction));
-
-    bool gt = atoll(input.c_str()) > atoll(p.c_str());
-
-    return gt;
+    return toNumber(input) > operand(transaction);
 }
 
 
@@ -20,17 +20,17 @@
 #include <memory>
 #include <utility>
 
-#include "src/operators/operator.h"
+#include "src/operators/numeric_operator.h"
 
 
 namespace modsecurity {
 namespace operators {
 
-class Gt : public Operator {
+class Gt : public NumericOperator {
  public:
     /** @ingroup ModSecurity_Operator */
     explicit Gt(std::unique_ptr<RunTimeString> param)
-        : Operator("Gt", std::move(param)) {
+        : NumericOperator("Gt", std::move(param)) {
             m_couldContainsMacro = true;
         }
     bool evaluate(Transaction *transaction, const std::string &input) override;
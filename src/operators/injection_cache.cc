@@ -0,0 +1,88 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/operators/injection_cache.h"
+
+#include <pthread.h>
+
+#include <string>
+#include <unordered_map>
+
+
+namespace modsecurity {
+namespace operators {
+
+
+InjectionCache::InjectionCache()
+    : m_size(0) {
+    pthread_mutex_init(&m_lock, NULL);
+}
+
+
+InjectionCache::~InjectionCache() {
+    pthread_mutex_destroy(&m_lock);
+}
+
+
+bool InjectionCache::find(Kind kind, const std::string &value,
+    Result *result) {
+    bool found = false;
+
+    if (value.size() > MSC_INJECTION_CACHE_MAX_LENGTH) {
+        return false;
+    }
+
+    pthread_mutex_lock(&m_lock);
+    auto it = m_entries[kind].find(value);
+    if (it != m_entries[kind].end()) {
+        *result = it->second;
+        found = true;
+    }
+    pthread_mutex_unlock(&m_lock);
+
+    return found;
+}
+
+
+void InjectionCache::insert(Kind kind, const std::string &value,
+    const Result &result) {
+    if (value.size() > MSC_INJECTION_CACHE_MAX_LENGTH) {
+        return;
+    }
+
+    /* The fixed part stands for the map node and the string header. */
+    size_t size = value.size() + sizeof(Result) + 64;
+
+    pthread_mutex_lock(&m_lock);
+    if (m_size + size <= MSC_INJECTION_CACHE_MAX_SIZE
+        && m_entries[kind].emplace(value, result).second) {
+        m_size = m_size + size;
+    }
+    pthread_mutex_unlock(&m_lock);
+}
+
+
+void InjectionCache::clear() {
+    pthread_mutex_lock(&m_lock);
+    for (int i = 0; i < NumberOfKinds; i++) {
+        m_entries[i].clear();
+    }
+    m_size = 0;
+    pthread_mutex_unlock(&m_lock);
+}
+
+
+}  // namespace operators
+}  // namespace modsecurity
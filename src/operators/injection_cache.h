@@ -0,0 +1,76 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <pthread.h>
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+#ifndef SRC_OPERATORS_INJECTION_CACHE_H_
+#define SRC_OPERATORS_INJECTION_CACHE_H_
+
+/* Longest value, and bytes in all, that a transaction keeps. */
+#define MSC_INJECTION_CACHE_MAX_LENGTH 16384
+#define MSC_INJECTION_CACHE_MAX_SIZE (1024 * 1024)
+
+
+namespace modsecurity {
+namespace operators {
+
+
+/**
+ * Transaction scoped memoization of the libinjection verdicts.
+ *
+ * CRS runs @detectSQLi and @detectXSS from several rules over the same
+ * ARGS and COOKIES, with transformation chains that often leave the value
+ * as it was. The verdict only depends on the value, so it is looked up
+ * here before the value is tokenized again.
+ *
+ * @detectXSS may be matched from several threads at once (see
+ * SecRuleEvaluationThreads), hence the lock.
+ *
+ */
+class InjectionCache {
+ public:
+    enum Kind {
+        SQLiKind,
+        XSSKind,
+        NumberOfKinds
+    };
+
+    struct Result {
+        bool m_found;
+        char m_fingerprint[8];
+    };
+
+    InjectionCache();
+    ~InjectionCache();
+
+    bool find(Kind kind, const std::string &value, Result *result);
+    void insert(Kind kind, const std::string &value, const Result &result);
+    void clear();
+
+ private:
+    std::unordered_map<std::string, Result> m_entries[NumberOfKinds];
+    size_t m_size;
+    pthread_mutex_t m_lock;
+};
+
+
+}  // namespace operators
+}  // namespace modsecurity
+
+#endif  // SRC_OPERATORS_INJECTION_CACHE_H_
@@ -31,6 +31,15 @@ bool InspectFile::init(const std::string &param2, std::string *error) {
     std::string err;
     std::string err_lua;
 
+    m_scanner.reset(Utils::FileScanner::fromParameter(m_param, &err));
+    if (m_scanner) {
+        return true;
+    }
+    if (err.empty() == false) {
+        error->assign(err);
+        return false;
+    }
+
     m_file = utils::find_resource(m_param, param2, &err);
     iss = new std::ifstream(m_file, std::ios::in);
 
@@ -52,6 +61,18 @@ bool InspectFile::init(const std::string &param2, std::string *error) {
 bool InspectFile::evaluate(Transaction *transaction, const std::string &str) {
     if (m_isScript) {
         return m_lua.run(transaction, str);
+    } else if (m_scanner) {
+        bool found = false;
+        std::string reply;
+        std::string error;
+
+        if (m_scanner->scan(str, &found, &reply, &error) == false) {
+            ms_dbg_a(transaction, 4, "@inspectFile: " + error);
+            return false;
+        }
+        ms_dbg_a(transaction, 5, "@inspectFile: " + str + ": " + reply);
+
+        return found;
     } else {
         FILE *in;
         char buff[512];
@@ -22,6 +22,7 @@
 
 #include "src/operators/operator.h"
 #include "src/engine/lua.h"
+#include "src/utils/file_scanner.h"
 
 
 namespace modsecurity {
@@ -41,6 +42,8 @@ class InspectFile : public Operator {
     std::string m_file;
     bool m_isScript;
     engine::Lua m_lua;
+    /* set for the unix: and clamd: targets, see Utils::FileScanner */
+    std::unique_ptr<Utils::FileScanner> m_scanner;
 };
 
 }  // namespace operators
@@ -18,7 +18,6 @@
 #include <string.h>
 #include <string>
 
-#include "src/utils/msc_tree.h"
 #include "src/operators/operator.h"
 
 namespace modsecurity {
@@ -38,7 +37,24 @@ bool IpMatch::init(const std::string &file, std::string *error) {
 
 
 bool IpMatch::evaluate(Transaction *transaction, const std::string &input) {
-    return m_tree.contains(input);
+    return contains(transaction, m_tree, input);
+}
+
+
+bool IpMatch::contains(Transaction *transaction, const Utils::IpTree &tree,
+    const std::string &input) {
+    if (transaction == NULL || input != *transaction->m_clientIpAddress) {
+        return tree.contains(input);
+    }
+
+    /* REMOTE_ADDR, parsed once for all the rules of the transaction */
+    if (transaction->m_clientIpFamily == 0) {
+        transaction->m_clientIpFamily = Utils::IpTree::parse(input,
+            transaction->m_clientIpBinary);
+    }
+
+    return tree.contains(transaction->m_clientIpFamily,
+        transaction->m_clientIpBinary);
 }
 
 
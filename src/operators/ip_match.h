@@ -39,6 +39,9 @@ class IpMatch : public Operator {
     bool init(const std::string &file, std::string *error) override;
 
  protected:
+    bool contains(Transaction *transaction, const Utils::IpTree &tree,
+        const std::string &input);
+
     Utils::IpTree m_tree;
 };
 
@@ -21,6 +21,7 @@
 #include <string.h>
 
 #include "src/operators/operator.h"
+#include "src/utils/reloader.h"
 
 namespace modsecurity {
 namespace operators {
@@ -31,21 +32,46 @@ bool IpMatchFromFile::init(const std::string &file,
     std::string e("");
     bool res = false;
 
+    std::string location(m_param);
+
     if (m_param.compare(0, 8, "https://") == 0) {
         res = m_tree.addFromUrl(m_param, &e);
     } else {
-        std::string resf = utils::find_resource(m_param, file, error);
-        if (resf == "") {
+        location = utils::find_resource(m_param, file, error);
+        if (location == "") {
             return false;
         }
-        res = m_tree.addFromFile(resf, &e);
+        res = m_tree.addFromFile(location, &e);
     }
 
     if (res == false) {
         error->assign(e);
+        return false;
+    }
+
+    m_reloader.reset(new Utils::Reloader(location,
+        [this](std::istream *ss, std::string *err) {
+            std::unique_ptr<Utils::IpTree> tree(new Utils::IpTree());
+            if (tree->addFromBuffer(ss, err) == false) {
+                return false;
+            }
+            m_reloaded.publish(tree.release());
+            return true;
+        }));
+
+    return true;
+}
+
+
+bool IpMatchFromFile::evaluate(Transaction *transaction,
+    const std::string &input) {
+    if (transaction && m_reloader
+        && transaction->m_rules->m_dataReloadInterval.m_set) {
+        m_reloader->watch(transaction->m_rules->m_dataReloadInterval.m_value);
     }
 
-    return res;
+    std::shared_ptr<const Utils::IpTree> tree = m_reloaded.get();
+    return contains(transaction, tree ? *tree : m_tree, input);
 }
 
 
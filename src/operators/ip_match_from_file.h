@@ -20,6 +20,7 @@
 #include <utility>
 
 #include "src/operators/ip_match.h"
+#include "src/utils/reloader.h"
 
 namespace modsecurity {
 namespace operators {
@@ -32,6 +33,13 @@ class IpMatchFromFile : public IpMatch {
     IpMatchFromFile(const std::string &n, std::unique_ptr<RunTimeString> param)
         : IpMatch(n, std::move(param)) { }
     bool init(const std::string& file, std::string *error) override;
+
+    bool evaluate(Transaction *transaction, const std::string &input) override;
+
+ private:
+    /* the list as last reloaded; m_tree until then */
+    Utils::Versioned<Utils::IpTree> m_reloaded;
+    std::unique_ptr<Utils::Reloader> m_reloader;
 };
 
 }  // namespace operators
@@ -24,11 +24,7 @@ namespace modsecurity {
 namespace operators {
 
 bool Le::evaluate(Transaction *transaction, const std::string &input) {
-    std::string p(m_string->evaluate(transaction));
-
-    bool le = atoll(input.c_str()) <= atoll(p.c_str());
-
-    return le;
+    return toNumber(input) <= operand(transaction);
 }
 
 
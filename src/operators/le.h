@@ -20,17 +20,17 @@
 #include <memory>
 #include <utility>
 
-#include "src/operators/operator.h"
+#include "src/operators/numeric_operator.h"
 
 
 namespace modsecurity {
 namespace operators {
 
-class Le : public Operator {
+class Le : public NumericOperator {
  public:
     /** @ingroup ModSecurity_Operator */
     explicit Le(std::unique_ptr<RunTimeString> param)
-        : Operator("Le", std::move(param)) {
+        : NumericOperator("Le", std::move(param)) {
             m_couldContainsMacro = true;
         }
 
@@ -23,11 +23,7 @@ namespace modsecurity {
 namespace operators {
 
 bool Lt::evaluate(Transaction *transaction, const std::string &input) {
-    std::string p(m_string->evaluate(transaction));
-
-    bool lt = atoll(input.c_str()) < atoll(p.c_str());
-
-    return lt;
+    return toNumber(input) < operand(transaction);
 }
 
 
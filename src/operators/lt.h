@@ -20,17 +20,17 @@
 #include <memory>
 #include <utility>
 
-#include "src/operators/operator.h"
+#include "src/operators/numeric_operator.h"
 
 
 namespace modsecurity {
 namespace operators {
 
-class Lt : public Operator {
+class Lt : public NumericOperator {
  public:
     /** @ingroup ModSecurity_Operator */
     explicit Lt(std::unique_ptr<RunTimeString> param)
-        : Operator("Lt", std::move(param)) {
+        : NumericOperator("Lt", std::move(param)) {
              m_couldContainsMacro = true;
         }
 
@@ -0,0 +1,79 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#ifndef SRC_OPERATORS_NUMERIC_OPERATOR_H_
+#define SRC_OPERATORS_NUMERIC_OPERATOR_H_
+
+#include <stdlib.h>
+
+#include <string>
+#include <memory>
+#include <utility>
+
+#include "src/operators/operator.h"
+#include "src/run_time_string.h"
+
+
+namespace modsecurity {
+namespace operators {
+
+/**
+ * The operators comparing the input, as a number, against theirs: @eq,
+ * @ge, @gt, @le and @lt. An operand without macros is only read once, by
+ * init(), instead of on every evaluation.
+ *
+ */
+class NumericOperator : public Operator {
+ public:
+    NumericOperator(const std::string &name,
+        std::unique_ptr<RunTimeString> param)
+        : Operator(name, std::move(param)),
+        m_constant(false),
+        m_operand(0) { }
+
+    bool init(const std::string &arg, std::string *error) override {
+        if (m_string && m_string->containsMacro() == false) {
+            m_operand = toNumber(m_string->evaluate());
+            m_constant = true;
+        }
+        return true;
+    }
+
+    bool threadSafeInit() const override { return true; }
+    bool parallelSafe() const override { return true; }
+
+ protected:
+    /* What the input, or the operand, is worth: atoll() by default. */
+    virtual long long toNumber(const std::string &value) const {
+        return atoll(value.c_str());
+    }
+
+    long long operand(Transaction *transaction) const {
+        if (m_constant) {
+            return m_operand;
+        }
+        return toNumber(m_string->evaluate(transaction));
+    }
+
+ private:
+    bool m_constant;
+    long long m_operand;
+};
+
+}  // namespace operators
+}  // namespace modsecurity
+
+
+#endif  // SRC_OPERATORS_NUMERIC_OPERATOR_H_
@@ -15,12 +15,19 @@
 
 #include "src/operators/operator.h"
 
+#include <pthread.h>
+
+#include <algorithm>
 #include <cstring>
 #include <memory>
 #include <string>
 
 #include "modsecurity/transaction.h"
 #include "src/run_time_string.h"
+#include "src/utils/metrics.h"
+#include "src/utils/trace.h"
+#include "src/utils/regex.h"
+#include "src/utils/rx_guardrail.h"
 #include "src/utils/string.h"
 #include "src/operators/begins_with.h"
 #include "src/operators/contains.h"
@@ -48,6 +55,7 @@
 #include "src/operators/rsub.h"
 #include "src/operators/rx.h"
 #include "src/operators/rx_global.h"
+#include "src/operators/rx_group.h"
 #include "src/operators/str_eq.h"
 #include "src/operators/str_match.h"
 #include "src/operators/validate_byte_range.h"
@@ -138,6 +146,127 @@ bool Operator::evaluate(Transaction *transaction, const std::string& a) {
     return true;
 }
 
+size_t Operator::memoryUsage() const {
+    size_t bytes = sizeof(*this) + m_op.size() + m_param.size();
+    if (regex() != nullptr) {
+        bytes += regex()->memoryUsage();
+    }
+    return bytes;
+}
+
+
+void Operator::countSkipped(Transaction *transaction) {
+    if (transaction != nullptr && transaction->m_ruleProfile != nullptr) {
+        m_skipped++;
+    }
+}
+
+
+bool Operator::linear(Transaction *transaction, RuleWithActions *rule,
+    const Utils::Regex *re, const std::string &input, bool *miss) {
+    size_t slot;
+
+    *miss = false;
+    if (transaction == nullptr || transaction->m_rules->m_secRxRe2
+        != RulesSetProperties::TrueConfigBoolean) {
+        return false;
+    }
+
+    if (re->linear() == false) {
+        ms_dbg_a(transaction, 9, "Rule " \
+            + std::to_string(rule ? rule->m_ruleId : 0) \
+            + ": matching the regular expression with PCRE, " \
+            + (re->linearError().empty()
+                ? std::string("the expanded ones are not compiled for RE2.")
+                : "RE2 can not run it: " + re->linearError()));
+        return false;
+    }
+
+    const RxGroup *group = transaction->m_rules->rxGroup(this, &slot);
+    if (group != nullptr
+        && transaction->m_rxGroupCache->match(group, slot, input) == 0) {
+        countSkipped(transaction);
+        ms_dbg_a(transaction, 9, "Rule " \
+            + std::to_string(rule ? rule->m_ruleId : 0) \
+            + ": the RE2 set of its group did not match.");
+        *miss = true;
+    }
+
+    return true;
+}
+
+
+static pthread_mutex_t regexErrorLock = PTHREAD_MUTEX_INITIALIZER;
+
+
+void Operator::regexError(Transaction *transaction, bool matchLimit,
+    const RuleWithActions *rule, const std::string *pattern) {
+    pthread_mutex_lock(&regexErrorLock);
+    transaction->m_variableMscPcreError.set("1",
+        transaction->m_variableOffset);
+    if (matchLimit) {
+        transaction->m_variableMscPcreLimitsExceeded.set("1",
+            transaction->m_variableOffset);
+        transaction->m_collections.m_tx_collection->storeOrUpdateFirst(
+            "MSC_PCRE_LIMITS_EXCEEDED", "1");
+    }
+    pthread_mutex_unlock(&regexErrorLock);
+
+    if (matchLimit) {
+        ms_dbg_a(transaction, 7, "Set TX.MSC_PCRE_LIMITS_EXCEEDED to 1");
+        Utils::Metrics::getInstance().increment(
+            Utils::Metrics::PcreLimitsExceededCounter);
+        if (Utils::Trace::enabled(transaction)) {
+            Utils::Trace::event(transaction, "match_limit",
+                rule ? rule->m_ruleId : 0, pattern);
+        }
+    }
+}
+
+
+bool Operator::guardrail(Transaction *transaction,
+    const RuleWithActions *rule, const Utils::RxGuardrail &guardrail,
+    const std::string &input, std::string *prefix,
+    unsigned long *matchLimit, const std::string *pattern) {
+    if (transaction == nullptr
+        || transaction->m_rules->m_rxGuardrail.m_set == false) {
+        return false;
+    }
+
+    int factor = transaction->m_rules->m_rxGuardrail.m_value;
+    size_t budget = guardrail.budget(input.size(), factor);
+    if (budget >= input.size()) {
+        return false;
+    }
+
+    prefix->assign(input, 0, budget);
+    unsigned long limit = *matchLimit != 0 ? *matchLimit
+        : Utils::RxGuardrail::kDefaultMatchLimit;
+    *matchLimit = std::max(limit / factor, 1UL);
+
+    pthread_mutex_lock(&regexErrorLock);
+    transaction->m_collections.m_tx_collection->storeOrUpdateFirst(
+        "MSC_RX_GUARDRAIL", "1");
+    pthread_mutex_unlock(&regexErrorLock);
+
+    ms_dbg_a(transaction, 4, "Rule " \
+        + std::to_string(rule ? rule->m_ruleId : 0) \
+        + ": searching the first " + std::to_string(budget) + " of " \
+        + std::to_string(input.size()) + " bytes, with a match limit of " \
+        + std::to_string(*matchLimit) + ", as the whole input would " \
+        "cost over " + std::to_string(factor) + " times the median " \
+        "search. Set TX.MSC_RX_GUARDRAIL to 1");
+    Utils::Metrics::getInstance().increment(
+        Utils::Metrics::RxGuardrailCounter);
+    if (Utils::Trace::enabled(transaction)) {
+        Utils::Trace::event(transaction, "rx_guardrail",
+            rule ? rule->m_ruleId : 0, pattern);
+    }
+
+    return true;
+}
+
+
 Operator *Operator::instantiate(const std::string& op, const std::string& param_str) {
     std::string op_ = utils::string::tolower(op);
     std::unique_ptr<RunTimeString> param(new RunTimeString());
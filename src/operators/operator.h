@@ -13,6 +13,7 @@
  *
  */
 
+#include <atomic>
 #include <string>
 #include <memory>
 #include <utility>
@@ -26,6 +27,10 @@
 #include "src/run_time_string.h"
 
 namespace modsecurity {
+namespace Utils {
+class Regex;
+class RxGuardrail;
+}
 namespace operators {
 
 class Operator {
@@ -108,6 +113,47 @@ class Operator {
         return true;
     }
 
+    /**
+     * Whether init() only touches the operator itself, so that the
+     * parser may run it on a worker thread after the whole rule set was
+     * read (see Parser::Driver::deferInit).
+     */
+    virtual bool threadSafeInit() const {
+        return false;
+    }
+
+    /**
+     * Name of the matching engine in use, when the operator has more
+     * than one to pick from (see rules-check -b). Empty otherwise.
+     */
+    virtual std::string backend() const {
+        return "";
+    }
+
+    /**
+     * The regular expression the operator matches with, when it has one
+     * compiled at load time. nullptr otherwise.
+     */
+    virtual const Utils::Regex *regex() const {
+        return nullptr;
+    }
+
+    /**
+     * Bytes held by the operator, along with what it compiled at load
+     * time. What is shared among rules (see InternedPatterns) is counted
+     * by each of them.
+     */
+    virtual size_t memoryUsage() const;
+
+    /**
+     * Whether evaluate() only reads the transaction, captures aside, so
+     * that several rules can be matched at once on the same transaction
+     * (see SecRuleEvaluationThreads).
+     */
+    virtual bool parallelSafe() const {
+        return false;
+    }
+
     virtual std::string resolveMatchMessage(Transaction *t,
         std::string key, std::string value);
 
@@ -128,6 +174,40 @@ class Operator {
         return evaluate(transaction, str);
     }
 
+    /**
+     * Flags a failed regular expression match on the transaction: sets
+     * MSC_PCRE_ERROR and, when the match limit was hit,
+     * MSC_PCRE_LIMITS_EXCEEDED, which is a "match_limit" event for the
+     * tracer too. Serialized, as the rules may be matched in parallel.
+     */
+    static void regexError(Transaction *transaction, bool matchLimit,
+        const RuleWithActions *rule = nullptr,
+        const std::string *pattern = nullptr);
+
+    /* Counts, in m_skipped, an evaluation the matcher was spared. */
+    void countSkipped(Transaction *transaction);
+
+    /**
+     * For @rx and @rxGlobal, with SecRxRe2 On: whether re is to be run
+     * with RE2 (the debug log tells when it is left to PCRE instead) and,
+     * through miss, whether the RE2 set of the group of the operator
+     * (see RulesSet::rxGroup) already found that input does not match.
+     */
+    bool linear(Transaction *transaction, RuleWithActions *rule,
+        const Utils::Regex *re, const std::string &input, bool *miss);
+
+    /**
+     * For @rx and @rxGlobal, with SecRxGuardrail: when searching input is
+     * predicted to cost more than the configured multiple of the median
+     * search of the operator (see Utils::RxGuardrail), copies into prefix
+     * the part of input that may be searched, divides matchLimit by that
+     * multiple and sets TX.MSC_RX_GUARDRAIL. Returns whether it did.
+     */
+    static bool guardrail(Transaction *transaction,
+        const RuleWithActions *rule, const Utils::RxGuardrail &guardrail,
+        const std::string &input, std::string *prefix,
+        unsigned long *matchLimit, const std::string *pattern = nullptr);
+
     static void logOffset(std::shared_ptr<RuleMessage> ruleMessage, int offset, int len) {
         if (ruleMessage) {
             ruleMessage->m_reference.append("o"
@@ -142,6 +222,15 @@ class Operator {
     std::string m_param;
     std::unique_ptr<RunTimeString> m_string;
     bool m_couldContainsMacro;
+
+    /**
+     * Evaluations answered without running the matcher, because the input
+     * could not possibly match (see Pm and Rx). Operators are not shared
+     * among rules, so this is a per rule figure meant for profiling; it is
+     * only counted on the transactions SecRuleProfiling samples, the
+     * others leave the operator memory alone.
+     */
+    std::atomic<size_t> m_skipped{0};
 };
 
 }  // namespace operators
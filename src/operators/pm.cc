@@ -19,82 +19,245 @@
 
 #include <string>
 #include <algorithm>
+#include <functional>
 #include <iterator>
 #include <sstream>
 #include <vector>
 #include <list>
 #include <memory>
 
+#include "modsecurity/rules_set.h"
+#include "modsecurity/transaction.h"
 #include "src/operators/operator.h"
+#include "src/operators/pm_group.h"
 #include "src/utils/acmp.h"
+#include "src/utils/interned_patterns.h"
 #include "src/utils/string.h"
 
 namespace modsecurity {
 namespace operators {
 
-Pm::~Pm() {
-    acmp_node_t *root = m_p->root_node;
+PmPhrases::PmPhrases(const std::vector<std::string> &patterns)
+    : m_p(acmp_create(0)),
+    m_minLength(0),
+    m_patterns(patterns)
+#ifdef WITH_HYPERSCAN
+    , m_hs(NULL)
+#endif
+    {
+    for (const std::string &pattern : m_patterns) {
+        if (m_p->dict_count == 0 || pattern.length() < m_minLength) {
+            m_minLength = pattern.length();
+        }
+        acmp_add_pattern(m_p, pattern.c_str(), NULL, NULL,
+            pattern.length());
+    }
+
+    while (m_p->is_failtree_done == 0) {
+        acmp_prepare(m_p);
+    }
+
+#ifdef WITH_HYPERSCAN
+    std::vector<const char *> expressions;
+    std::vector<unsigned int> flags;
+    std::vector<unsigned int> ids;
+    std::vector<size_t> lengths;
+    hs_compile_error_t *hs_error = NULL;
+
+    if (m_patterns.empty()) {
+        return;
+    }
+
+    for (size_t i = 0; i < m_patterns.size(); i++) {
+        expressions.push_back(m_patterns[i].c_str());
+        lengths.push_back(m_patterns[i].length());
+        flags.push_back(HS_FLAG_CASELESS | HS_FLAG_SINGLEMATCH);
+        ids.push_back(i);
+    }
+
+    /* on failure the acmp tree, which is ready anyway, is used */
+    if (hs_compile_lit_multi(expressions.data(), flags.data(), ids.data(),
+        lengths.data(), expressions.size(), HS_MODE_BLOCK, NULL, &m_hs,
+        &hs_error) != HS_SUCCESS) {
+        hs_free_compile_error(hs_error);
+        m_hs = NULL;
+    }
+#endif
+}
 
-    cleanup(root);
 
-    free(m_p);
+PmPhrases::~PmPhrases() {
+#ifdef WITH_HYPERSCAN
+    if (m_hs != NULL) {
+        hs_free_database(m_hs);
+        m_hs = NULL;
+    }
+#endif
+
+    acmp_destroy(m_p);
     m_p = NULL;
+}
+
+
+/*
+ * Keyed by a digest of the phrases, which may be a whole data file; the
+ * phrases themselves tell the entries with the same digest apart.
+ */
+std::shared_ptr<const PmPhrases> PmPhrases::intern(
+    const std::vector<std::string> &patterns) {
+    std::string content;
+
+    for (const std::string &pattern : patterns) {
+        content.append(pattern);
+        content.push_back('\n');
+    }
+
+    return Utils::InternedPatterns<const PmPhrases>::get(
+        std::to_string(content.size()) + "/"
+            + std::to_string(std::hash<std::string>()(content)),
+        [&patterns](const PmPhrases &p) { return p.m_patterns == patterns; },
+        [&patterns]() { return new PmPhrases(patterns); });
+}
+
+
+Pm::~Pm() {
 #ifdef MODSEC_MUTEX_ON_PM
     pthread_mutex_destroy(&m_lock);
 #endif
 }
 
 
-void Pm::cleanup(acmp_node_t *n) {
-    if (n == NULL) {
-        return;
-    }
+void Pm::addPattern(const std::string &pattern) {
+    m_pending.push_back(pattern);
+}
+
 
-    cleanup(n->sibling);
-    cleanup(n->child);
+void Pm::prepare() {
+    m_phrases = PmPhrases::intern(m_pending);
+    m_pending.clear();
+    m_pending.shrink_to_fit();
+}
 
-    postOrderTraversal(n->btree);
 
-    if (n->text && strlen(n->text) > 0) {
-        free(n->text);
-        n->text = NULL;
+std::string Pm::backend() const {
+#ifdef WITH_HYPERSCAN
+    if (m_phrases && m_phrases->m_hs != NULL) {
+        return "hyperscan";
     }
+#endif
+    return "acmp";
+}
 
-    if (n->pattern && strlen(n->pattern) > 0) {
-        free(n->pattern);
-        n->pattern = NULL;
+
+size_t Pm::memoryUsage() const {
+    size_t bytes = Operator::memoryUsage();
+
+    if (m_phrases == nullptr) {
+        return bytes;
+    }
+    bytes += sizeof(PmPhrases) + acmp_memory_usage(m_phrases->m_p);
+    for (const std::string &pattern : m_phrases->m_patterns) {
+        bytes += sizeof(std::string) + pattern.size();
+    }
+#ifdef WITH_HYPERSCAN
+    size_t size = 0;
+    if (m_phrases->m_hs != NULL
+        && hs_database_size(m_phrases->m_hs, &size) == HS_SUCCESS) {
+        bytes += size;
     }
+#endif
+    return bytes;
+}
+
+
+#ifdef WITH_HYPERSCAN
+struct PmHyperscanMatch {
+    unsigned int m_id;
+    unsigned long long m_to;
+};
 
-    free(n);
+
+static int pmOnMatch(unsigned int id, unsigned long long from,
+    unsigned long long to, unsigned int flags, void *ctx) {
+    PmHyperscanMatch *m = reinterpret_cast<PmHyperscanMatch *>(ctx);
+    m->m_id = id;
+    m->m_to = to;
+    /* same as acmp_process_quick: stop at the first match */
+    return 1;
 }
 
 
-void Pm::postOrderTraversal(acmp_btree_node_t *node) {
-    if (node == NULL) {
-        return;
+/*
+ * Same contract as acmp_process_quick: the offset of the last byte of the
+ * first match, or -1. Returns -2 if hyperscan could not scan the input.
+ *
+ */
+int Pm::hyperscanSearch(const std::string &input, const char **match) {
+    hs_database_t *db = m_phrases->m_hs;
+    hs_scratch_t *scratch = Utils::hyperscanScratch(db);
+    PmHyperscanMatch m;
+
+    if (scratch == NULL) {
+        return -2;
     }
 
-    postOrderTraversal(node->right);
-    postOrderTraversal(node->left);
+    m.m_id = 0;
+    m.m_to = 0;
+    hs_error_t rc = hs_scan(db, input.c_str(), input.length(), 0, scratch,
+        pmOnMatch, &m);
+    if (rc == HS_SUCCESS) {
+        return -1;
+    }
+    if (rc != HS_SCAN_TERMINATED) {
+        return -2;
+    }
 
-    free(node);
+    *match = m_phrases->m_patterns[m.m_id].c_str();
+    return static_cast<int>(m.m_to) - 1;
 }
+#endif
 
 
 bool Pm::evaluate(Transaction *transaction, RuleWithActions *rule,
     const std::string &input, std::shared_ptr<RuleMessage> ruleMessage) {
-    int rc;
+    int rc = -2;
     ACMPT pt;
-    pt.parser = m_p;
+    pt.parser = m_phrases->m_p;
     pt.ptr = NULL;
     const char *match = NULL;
+
+    if (input.length() < m_phrases->m_minLength) {
+        countSkipped(transaction);
+        ms_dbg_a(transaction, 9, "Rule " \
+            + std::to_string(rule ? rule->m_ruleId : 0) \
+            + ": skipping the phrase match, the input is shorter than " \
+            "any of the phrases.");
+        return false;
+    }
+
+    if (transaction && transaction->m_rules) {
+        size_t slot;
+        const PmGroup *group = transaction->m_rules->pmGroup(this, &slot);
+        if (group != nullptr) {
+            rc = transaction->m_pmGroupCache->match(group, slot, input,
+                &match);
+        }
+    }
+
+#ifdef WITH_HYPERSCAN
+    if (rc == -2 && m_phrases->m_hs != NULL) {
+        rc = hyperscanSearch(input, &match);
+    }
+#endif
+    if (rc == -2) {
 #ifdef MODSEC_MUTEX_ON_PM
-    pthread_mutex_lock(&m_lock);
+        pthread_mutex_lock(&m_lock);
 #endif
-    rc = acmp_process_quick(&pt, &match, input.c_str(), input.length());
+        rc = acmp_process_quick(&pt, &match, input.c_str(), input.length());
 #ifdef MODSEC_MUTEX_ON_PM
-    pthread_mutex_unlock(&m_lock);
+        pthread_mutex_unlock(&m_lock);
 #endif
+    }
 
     if (rc >= 0 && transaction) {
         std::string match_(match?match:"");
@@ -133,12 +296,10 @@ bool Pm::init(const std::string &file, std::string *error) {
         back_inserter(vec));
 
     for (auto &a : vec) {
-        acmp_add_pattern(m_p, a.c_str(), NULL, NULL, a.length());
+        addPattern(a);
     }
 
-    while (m_p->is_failtree_done == 0) {
-        acmp_prepare(m_p);
-    }
+    prepare();
 
     if (content) {
         free(content);
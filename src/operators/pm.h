@@ -20,26 +20,54 @@
 #include <list>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "src/operators/operator.h"
 #include "src/utils/acmp.h"
+#include "src/utils/hyperscan.h"
 
 
 namespace modsecurity {
 namespace operators {
 
 
+/**
+ * What the phrases of a @pm compile to. Read only once built, so that
+ * the operators with the same phrases, @pmFromFile over the same data
+ * file in many rules or rule sets, share one (see intern).
+ */
+class PmPhrases {
+ public:
+    explicit PmPhrases(const std::vector<std::string> &patterns);
+    ~PmPhrases();
+
+    PmPhrases(const PmPhrases &) = delete;
+    PmPhrases &operator=(const PmPhrases &) = delete;
+
+    static std::shared_ptr<const PmPhrases> intern(
+        const std::vector<std::string> &patterns);
+
+    ACMP *m_p;
+
+    /* length of the shortest phrase, shorter inputs can not match */
+    size_t m_minLength;
+
+    std::vector<std::string> m_patterns;
+
+#ifdef WITH_HYPERSCAN
+    /* literal database, used instead of m_p when it compiles */
+    hs_database_t *m_hs;
+#endif
+};
+
+
 class Pm : public Operator {
  public:
     /** @ingroup ModSecurity_Operator */
     explicit Pm(std::unique_ptr<RunTimeString> param)
-        : Operator("Pm", std::move(param)) {
-        m_p = acmp_create(0);
-    }
+        : Operator("Pm", std::move(param)) { }
     explicit Pm(const std::string &n, std::unique_ptr<RunTimeString> param)
-        : Operator(n, std::move(param)) {
-        m_p = acmp_create(0);
-    }
+        : Operator(n, std::move(param)) { }
     ~Pm();
     bool evaluate(Transaction *transaction, RuleWithActions *rule,
         const std::string &str,
@@ -47,15 +75,30 @@ class Pm : public Operator {
 
 
     bool init(const std::string &file, std::string *error) override;
-    void postOrderTraversal(acmp_btree_node_t *node);
-    void cleanup(acmp_node_t *n);
+    bool threadSafeInit() const override { return true; }
 
- protected:
-    ACMP *m_p;
+    std::string backend() const override;
+    size_t memoryUsage() const override;
 
-#ifdef MODSEC_MUTEX_ON_PM
+    /* the phrases, as given */
+    const std::vector<std::string> &patterns() const {
+        return m_phrases ? m_phrases->m_patterns : m_pending;
+    }
+
+ protected:
+    void addPattern(const std::string &pattern);
+    void prepare();
 
  private:
+#ifdef WITH_HYPERSCAN
+    int hyperscanSearch(const std::string &input, const char **match);
+#endif
+
+    /* added since the last prepare() */
+    std::vector<std::string> m_pending;
+    std::shared_ptr<const PmPhrases> m_phrases;
+
+#ifdef MODSEC_MUTEX_ON_PM
     pthread_mutex_t m_lock;
 #endif
 };
@@ -20,6 +20,7 @@
 #include "src/operators/operator.h"
 #include "src/utils/https_client.h"
 #include "src/utils/system.h"
+#include "src/utils/reloader.h"
 
 
 namespace modsecurity {
@@ -45,6 +46,7 @@ bool PmFromFile::isComment(const std::string &s) {
 
 bool PmFromFile::init(const std::string &config, std::string *error) {
     std::istream *iss;
+    std::string location(m_param);
 
     if (m_param.compare(0, 8, "https://") == 0) {
         Utils::HttpsClient client;
@@ -56,8 +58,8 @@ bool PmFromFile::init(const std::string &config, std::string *error) {
         iss = new std::stringstream(client.content);
     } else {
         std::string err;
-        std::string resource = utils::find_resource(m_param, config, &err);
-        iss = new std::ifstream(resource, std::ios::in);
+        location = utils::find_resource(m_param, config, &err);
+        iss = new std::ifstream(location, std::ios::in);
 
         if (((std::ifstream *)iss)->is_open() == false) {
             error->assign("Failed to open file: " + m_param + ". " + err);
@@ -66,18 +68,46 @@ bool PmFromFile::init(const std::string &config, std::string *error) {
         }
     }
 
+    load(iss);
+
+    delete iss;
+
+    m_reloader.reset(new Utils::Reloader(location,
+        [this](std::istream *ss, std::string *err) {
+            std::unique_ptr<PmFromFile> pm(new PmFromFile(m_op,
+                std::unique_ptr<RunTimeString>(new RunTimeString())));
+            pm->load(ss);
+            m_reloaded.publish(pm.release());
+            return true;
+        }));
+
+    return true;
+}
+
+
+void PmFromFile::load(std::istream *iss) {
     for (std::string line; std::getline(*iss, line); ) {
         if (isComment(line) == false) {
-            acmp_add_pattern(m_p, line.c_str(), NULL, NULL, line.length());
+            addPattern(line);
 	}
     }
 
-    while (m_p->is_failtree_done == 0) {
-        acmp_prepare(m_p);
+    prepare();
+}
+
+
+bool PmFromFile::evaluate(Transaction *transaction, RuleWithActions *rule,
+    const std::string &str, std::shared_ptr<RuleMessage> ruleMessage) {
+    if (transaction && m_reloader
+        && transaction->m_rules->m_dataReloadInterval.m_set) {
+        m_reloader->watch(transaction->m_rules->m_dataReloadInterval.m_value);
     }
 
-    delete iss;
-    return true;
+    std::shared_ptr<PmFromFile> pm = m_reloaded.get();
+    if (pm != NULL) {
+        return pm->Pm::evaluate(transaction, rule, str, ruleMessage);
+    }
+    return Pm::evaluate(transaction, rule, str, ruleMessage);
 }
 
 
@@ -21,6 +21,7 @@
 #include <utility>
 
 #include "src/operators/pm.h"
+#include "src/utils/reloader.h"
 
 
 namespace modsecurity {
@@ -36,9 +37,21 @@ class PmFromFile : public Pm {
         : Pm(n, std::move(param)) { }
 
     bool init(const std::string &file, std::string *error) override;
+    /* The file lookup goes through wordexp()/glob() and a download
+     * through curl, none of which we want to run concurrently. */
+    bool threadSafeInit() const override { return false; }
+
+    bool evaluate(Transaction *transaction, RuleWithActions *rule,
+        const std::string &str,
+        std::shared_ptr<RuleMessage> ruleMessage) override;
 
 private:
     static bool isComment(const std::string &s);
+    void load(std::istream *iss);
+
+    /* the phrases as last reloaded; this very matcher until then */
+    Utils::Versioned<PmFromFile> m_reloaded;
+    std::unique_ptr<Utils::Reloader> m_reloader;
 };
 
 
@@ -0,0 +1,188 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/operators/pm_group.h"
+
+#include <pthread.h>
+#include <stdint.h>
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "src/utils/acmp.h"
+#include "src/utils/string.h"
+
+
+namespace modsecurity {
+namespace operators {
+
+
+namespace {
+
+struct MatchContext {
+    const std::vector<std::vector<std::pair<size_t, std::string>>> *m_owners;
+    std::vector<PmGroup::Match> *m_matches;
+    size_t m_left;
+};
+
+}  // namespace
+
+
+PmGroup::PmGroup()
+    : m_p(acmp_create(0)),
+    m_slots(0) { }
+
+
+PmGroup::~PmGroup() {
+    acmp_destroy(m_p);
+    m_p = NULL;
+}
+
+
+/*
+ * The phrases of one more operator. Returns its slot.
+ */
+size_t PmGroup::add(const std::vector<std::string> &phrases) {
+    size_t slot = m_slots++;
+
+    for (const std::string &phrase : phrases) {
+        std::string folded(utils::string::tolower(phrase));
+        auto it = m_index.find(folded);
+        if (it == m_index.end()) {
+            it = m_index.emplace(folded, m_owners.size()).first;
+            m_owners.emplace_back();
+            /* the data is the index of the phrase, plus one, never NULL */
+            acmp_add_pattern(m_p, phrase.c_str(), NULL,
+                reinterpret_cast<void *>(static_cast<uintptr_t>(
+                    m_owners.size())), phrase.length());
+        }
+        std::vector<std::pair<size_t, std::string>> &owners =
+            m_owners[it->second];
+        if (owners.empty() || owners.back().first != slot) {
+            owners.push_back(std::make_pair(slot, phrase));
+        }
+    }
+
+    return slot;
+}
+
+
+void PmGroup::prepare() {
+    while (m_p->is_failtree_done == 0) {
+        acmp_prepare(m_p);
+    }
+}
+
+
+int PmGroup::onMatch(void *ctx, void *data, int offset) {
+    MatchContext *c = reinterpret_cast<MatchContext *>(ctx);
+    size_t phrase = reinterpret_cast<uintptr_t>(data) - 1;
+
+    for (const auto &owner : (*c->m_owners)[phrase]) {
+        Match &m = (*c->m_matches)[owner.first];
+        if (m.m_offset < 0) {
+            m.m_offset = offset;
+            m.m_phrase = owner.second.c_str();
+            c->m_left--;
+        }
+    }
+
+    return c->m_left == 0;
+}
+
+
+/*
+ * Fills matches with the first match of every slot, that is, the match
+ * that ends first and, out of the ones ending there, the longest.
+ */
+void PmGroup::match(const std::string &value,
+    std::vector<Match> *matches) const {
+    MatchContext c;
+    Match none;
+
+    none.m_offset = -1;
+    none.m_phrase = NULL;
+    matches->assign(m_slots, none);
+
+    c.m_owners = &m_owners;
+    c.m_matches = matches;
+    c.m_left = m_slots;
+    acmp_process_all(m_p, value.c_str(), value.length(), onMatch, &c);
+}
+
+
+PmGroupCache::PmGroupCache()
+    : m_size(0) {
+    pthread_mutex_init(&m_lock, NULL);
+}
+
+
+PmGroupCache::~PmGroupCache() {
+    pthread_mutex_destroy(&m_lock);
+}
+
+
+int PmGroupCache::match(const PmGroup *group, size_t slot,
+    const std::string &value, const char **phrase) {
+    std::vector<PmGroup::Match> matches;
+    bool found = false;
+
+    if (value.size() > MSC_PM_GROUP_CACHE_MAX_LENGTH) {
+        return -2;
+    }
+
+    pthread_mutex_lock(&m_lock);
+    auto g = m_entries.find(group);
+    if (g != m_entries.end()) {
+        auto it = g->second.find(value);
+        if (it != g->second.end()) {
+            matches = it->second;
+            found = true;
+        }
+    }
+    pthread_mutex_unlock(&m_lock);
+
+    if (found == false) {
+        group->match(value, &matches);
+
+        /* The fixed part stands for the map nodes and the string header. */
+        size_t size = value.size() + matches.size() * sizeof(PmGroup::Match)
+            + 64;
+
+        pthread_mutex_lock(&m_lock);
+        if (m_size + size <= MSC_PM_GROUP_CACHE_MAX_SIZE
+            && m_entries[group].emplace(value, matches).second) {
+            m_size = m_size + size;
+        }
+        pthread_mutex_unlock(&m_lock);
+    }
+
+    *phrase = matches[slot].m_phrase;
+    return matches[slot].m_offset;
+}
+
+
+void PmGroupCache::clear() {
+    pthread_mutex_lock(&m_lock);
+    m_entries.clear();
+    m_size = 0;
+    pthread_mutex_unlock(&m_lock);
+}
+
+
+}  // namespace operators
+}  // namespace modsecurity
@@ -0,0 +1,114 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <pthread.h>
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "src/utils/acmp.h"
+
+#ifndef SRC_OPERATORS_PM_GROUP_H_
+#define SRC_OPERATORS_PM_GROUP_H_
+
+/* Longest value, and bytes in all, that a transaction keeps. */
+#define MSC_PM_GROUP_CACHE_MAX_LENGTH 16384
+#define MSC_PM_GROUP_CACHE_MAX_SIZE (1024 * 1024)
+
+
+namespace modsecurity {
+namespace operators {
+
+
+/**
+ * The phrases of several @pm (or @pmFromFile) operators in a single
+ * automaton. Each operator gets a slot; the states where a phrase ends
+ * know the slots the phrase belongs to, so that a value goes through the
+ * automaton once and comes out with the first match of every slot, the
+ * same one the operator would have found on its own.
+ *
+ */
+class PmGroup {
+ public:
+    /* m_offset is the one of the last byte of the match, -1 if none */
+    struct Match {
+        int m_offset;
+        const char *m_phrase;
+    };
+
+    PmGroup();
+    ~PmGroup();
+
+    PmGroup(const PmGroup &) = delete;
+    PmGroup &operator=(const PmGroup &) = delete;
+
+    size_t add(const std::vector<std::string> &phrases);
+    void prepare();
+
+    void match(const std::string &value, std::vector<Match> *matches) const;
+
+ private:
+    static int onMatch(void *ctx, void *data, int offset);
+
+    ACMP *m_p;
+    size_t m_slots;
+    /*
+     * Per distinct phrase, case folded, the slots it belongs to along with
+     * the phrase as that slot has it.
+     */
+    std::vector<std::vector<std::pair<size_t, std::string>>> m_owners;
+    std::unordered_map<std::string, size_t> m_index;
+};
+
+
+/**
+ * Transaction scoped outcome of the PmGroup of the rule set, per value.
+ *
+ * The first operator of a group to look at a value runs the automaton for
+ * all of them; the others, which see the very same values, find their
+ * match here.
+ *
+ * May be used from several threads at once (see SecRuleEvaluationThreads),
+ * hence the lock.
+ *
+ */
+class PmGroupCache {
+ public:
+    PmGroupCache();
+    ~PmGroupCache();
+
+    /*
+     * As acmp_process_quick, for the slot of group, or -2 if value is too
+     * long to be kept here.
+     */
+    int match(const PmGroup *group, size_t slot, const std::string &value,
+        const char **phrase);
+    void clear();
+
+ private:
+    std::unordered_map<const PmGroup *, std::unordered_map<std::string,
+        std::vector<PmGroup::Match>>> m_entries;
+    size_t m_size;
+    pthread_mutex_t m_lock;
+};
+
+
+}  // namespace operators
+}  // namespace modsecurity
+
+#endif  // SRC_OPERATORS_PM_GROUP_H_
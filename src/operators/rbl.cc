@@ -20,11 +20,15 @@
 #include <netdb.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
+#include <string.h>
+#include <time.h>
 
 #include <string>
 
+#include "modsecurity/connection.h"
 #include "modsecurity/rules_set.h"
 #include "src/operators/operator.h"
+#include "src/utils/dns.h"
 
 namespace modsecurity {
 namespace operators {
@@ -200,32 +204,118 @@ void Rbl::furtherInfo(struct sockaddr_in *sin, const std::string &ipStr,
 }
 
 
+bool Rbl::findInCache(const std::string &host, Utils::DnsResult *result,
+    struct in_addr *addr, time_t *expires) {
+    bool found = false;
+
+    pthread_mutex_lock(&m_cacheLock);
+    auto it = m_cache.find(host);
+    if (it != m_cache.end()) {
+        if (it->second.m_expires > time(NULL)) {
+            *result = it->second.m_result;
+            *addr = it->second.m_addr;
+            *expires = it->second.m_expires;
+            found = true;
+        } else {
+            m_cache.erase(it);
+        }
+    }
+    pthread_mutex_unlock(&m_cacheLock);
+
+    return found;
+}
+
+
+void Rbl::addToCache(const std::string &host, Utils::DnsResult result,
+    const struct in_addr &addr, unsigned int ttl) {
+    time_t now = time(NULL);
+
+    if (ttl == 0) {
+        return;
+    }
+
+    pthread_mutex_lock(&m_cacheLock);
+    if (m_cache.size() >= MSC_RBL_CACHE_LIMIT) {
+        for (auto it = m_cache.begin(); it != m_cache.end();) {
+            if (it->second.m_expires <= now) {
+                it = m_cache.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        if (m_cache.size() >= MSC_RBL_CACHE_LIMIT) {
+            m_cache.clear();
+        }
+    }
+
+    CachedLookup &entry = m_cache[host];
+    entry.m_result = result;
+    entry.m_addr = addr;
+    entry.m_expires = now + ttl;
+    pthread_mutex_unlock(&m_cacheLock);
+}
+
+
 bool Rbl::evaluate(Transaction *t, RuleWithActions *rule,
         const std::string& ipStr,
         std::shared_ptr<RuleMessage> ruleMessage) {
-    struct addrinfo *info = NULL;
     std::string host = Rbl::mapIpToAddress(ipStr, t);
-    int rc = 0;
+    struct sockaddr_in sin;
+    Utils::DnsResult result;
 
     if (host.empty()) {
         return false;
     }
 
-    rc = getaddrinfo(host.c_str(), NULL, NULL, &info);
-
-    if (rc != 0) {
-        if (info != NULL) {
-            freeaddrinfo(info);
+    memset(&sin, 0, sizeof(sin));
+    sin.sin_family = AF_INET;
+
+    Connection *connection = t ? t->m_connection : NULL;
+    int answer = 0;
+    time_t expires = 0;
+    if (connection != NULL
+        && connection->rblAnswer(host, &answer, &sin.sin_addr.s_addr)) {
+        result = static_cast<Utils::DnsResult>(answer);
+        ms_dbg_a(t, 9, "RBL lookup of " + ipStr + " answered earlier on " \
+            "this connection.");
+    } else {
+        if (findInCache(host, &result, &sin.sin_addr, &expires)) {
+            ms_dbg_a(t, 9, "RBL lookup of " + ipStr \
+                + " found in the cache.");
+        } else {
+            long timeout = MSC_RBL_TIMEOUT;
+            unsigned int ttl = 0;
+
+            if (t && t->m_rules->m_rblTimeout.m_set) {
+                timeout = t->m_rules->m_rblTimeout.m_value;
+            }
+
+            result = Utils::dnsResolveA(host, timeout, &sin.sin_addr, &ttl);
+            if (result == Utils::DnsResult::Failed) {
+                ttl = MSC_RBL_FAILURE_TTL;
+            }
+            addToCache(host, result, sin.sin_addr, ttl);
+            expires = time(NULL) + ttl;
         }
+        if (connection != NULL) {
+            connection->setRblAnswer(host, static_cast<int>(result),
+                sin.sin_addr.s_addr, expires);
+        }
+    }
+
+    if (result == Utils::DnsResult::Failed) {
+        ms_dbg_a(t, 5, "RBL lookup of " + ipStr + " failed (no answer " \
+            "in time or resolver failure).");
+        return false;
+    }
+
+    if (result == Utils::DnsResult::NotFound) {
         ms_dbg_a(t, 5, "RBL lookup of " + ipStr + " failed.");
         return false;
     }
 
-    struct sockaddr *addr = info->ai_addr;
-    struct sockaddr_in *sin = (struct sockaddr_in *) addr;
-    furtherInfo(sin, ipStr, t, m_provider);
+    furtherInfo(&sin, ipStr, t, m_provider);
 
-    freeaddrinfo(info);
     if (rule && t && rule->hasCaptureAction()) {
         t->m_collections.m_tx_collection->storeOrUpdateFirst(
         "0", std::string(ipStr));
@@ -21,12 +21,23 @@
 #include <netdb.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
+#include <pthread.h>
+#include <time.h>
 
 #include <string>
 #include <memory>
+#include <unordered_map>
 #include <utility>
 
 #include "src/operators/operator.h"
+#include "src/utils/dns.h"
+
+/* default for SecRblTimeout, in milliseconds */
+#define MSC_RBL_TIMEOUT 1000
+/* seconds a failed lookup (timeout, server failure) is remembered */
+#define MSC_RBL_FAILURE_TTL 30
+/* entries of the lookup cache, per operator */
+#define MSC_RBL_CACHE_LIMIT 16384
 
 
 namespace modsecurity {
@@ -66,6 +77,7 @@ class Rbl : public Operator {
         m_demandsPassword(false),
         m_provider(RblProvider::UnknownProvider),
         Operator("Rbl", std::move(param)) {
+            pthread_mutex_init(&m_cacheLock, NULL);
             m_service = m_string->evaluate();
             if (m_service.find("httpbl.org") != std::string::npos) {
                 m_demandsPassword = true;
@@ -76,6 +88,11 @@ class Rbl : public Operator {
                 m_provider = RblProvider::httpbl;
             }
         }
+
+    ~Rbl() {
+        pthread_mutex_destroy(&m_cacheLock);
+    }
+
     bool evaluate(Transaction *transaction, RuleWithActions *rule,
         const std::string& input,
         std::shared_ptr<RuleMessage> ruleMessage) override;
@@ -92,9 +109,27 @@ class Rbl : public Operator {
         Transaction *trans, RblProvider provider);
 
  private:
+    /**
+     * Outcome of a lookup, kept until the TTL of the answer (or
+     * MSC_RBL_FAILURE_TTL for failures) expires. The cache belongs to the
+     * operator, so it is shared by every transaction of the rules set.
+     */
+    struct CachedLookup {
+        Utils::DnsResult m_result;
+        struct in_addr m_addr;
+        time_t m_expires;
+    };
+
+    bool findInCache(const std::string &host, Utils::DnsResult *result,
+        struct in_addr *addr, time_t *expires);
+    void addToCache(const std::string &host, Utils::DnsResult result,
+        const struct in_addr &addr, unsigned int ttl);
+
     std::string m_service;
     bool m_demandsPassword;
     RblProvider m_provider;
+    std::unordered_map<std::string, CachedLookup> m_cache;
+    pthread_mutex_t m_cacheLock;
 };
 
 }  // namespace operators
@@ -22,6 +22,11 @@
 #include "src/operators/operator.h"
 #include "modsecurity/rule.h"
 #include "modsecurity/rule_message.h"
+#include "modsecurity/rules_set.h"
+#include "src/utils/regex_cache.h"
+#include "src/utils/regex_store.h"
+#include "src/utils/regex_stream.h"
+#include "src/utils/rule_profiler.h"
 
 namespace modsecurity {
 namespace operators {
@@ -29,16 +34,57 @@ namespace operators {
 
 bool Rx::init(const std::string &arg, std::string *error) {
     if (m_string->m_containsMacro == false) {
-        m_re = new Regex(m_param);
+        m_re = Regex::interned(m_param, false, m_regexStore);
+        m_prefilter = Utils::RxPrefilter::interned(m_param);
     }
 
     return true;
 }
 
 
+Utils::RegexResult Rx::search(Transaction *transaction,
+    RuleWithActions *rule, Regex *re, const std::string &input,
+    std::vector<Utils::SMatchCapture> *captures, bool linear) {
+    unsigned long match_limit = 0;
+    const std::string *subject = &input;
+    std::string prefix;
+    bool observe = false;
+    uint64_t start = 0;
+
+    if (transaction && transaction->m_rules->m_pcreMatchLimit.m_set) {
+        match_limit = transaction->m_rules->m_pcreMatchLimit.m_value;
+    }
+
+    /* the expanded expressions are not the one m_guardrail knows of */
+    if (re == m_re.get()) {
+        if (guardrail(transaction, rule, m_guardrail, input, &prefix,
+            &match_limit, &re->pattern)) {
+            subject = &prefix;
+        } else if (transaction && transaction->m_ruleProfile != nullptr
+            && transaction->m_rules->m_rxGuardrail.m_set) {
+            observe = true;
+            start = Utils::RuleProfiler::now();
+        }
+    }
+
+    /* the groups are only of use to the capture action */
+    bool groups = rule == nullptr || rule->hasCaptureAction();
+    Utils::RegexResult result = re->searchOneMatch(*subject, *captures,
+        match_limit, linear, groups);
+
+    if (observe) {
+        m_guardrail.observe(input.size(),
+            Utils::RuleProfiler::now() - start);
+    }
+
+    return result;
+}
+
+
 bool Rx::evaluate(Transaction *transaction, RuleWithActions *rule,
     const std::string& input, std::shared_ptr<RuleMessage> ruleMessage) {
     Regex *re;
+    std::shared_ptr<Regex> expanded;
 
     if (m_param.empty() && !m_string->m_containsMacro) {
         return true;
@@ -46,9 +92,35 @@ bool Rx::evaluate(Transaction *transaction, RuleWithActions *rule,
 
     if (m_string->m_containsMacro) {
         std::string eparam(m_string->evaluate(transaction));
-        re = new Regex(eparam);
+        if (transaction) {
+            expanded = transaction->m_rules->m_regexCache->get(eparam);
+        } else {
+            expanded = std::make_shared<Regex>(eparam);
+        }
+        re = expanded.get();
     } else {
-        re = m_re;
+        re = m_re.get();
+    }
+
+    if (re->mayStartMatch(input) == false) {
+        countSkipped(transaction);
+        ms_dbg_a(transaction, 9, "Rule " \
+            + std::to_string(rule ? rule->m_ruleId : 0) \
+            + ": skipping the regular expression, the input is too short " \
+            "or has no byte where a match could start.");
+        return false;
+    }
+
+    if (m_prefilter && m_prefilter->isUsable() && transaction
+        && transaction->m_rules->m_secRxPrefilter
+            == RulesSetProperties::TrueConfigBoolean
+        && m_prefilter->mayMatch(input) == false) {
+        countSkipped(transaction);
+        ms_dbg_a(transaction, 9, "Rule " \
+            + std::to_string(rule ? rule->m_ruleId : 0) \
+            + ": skipping the regular expression, none of its literals " \
+            "is present.");
+        return false;
     }
 
     if (re->hasError()) {
@@ -56,27 +128,44 @@ bool Rx::evaluate(Transaction *transaction, RuleWithActions *rule,
         return false;
     }
 
+    bool miss;
+    bool linear = Operator::linear(transaction, rule, re, input, &miss);
+    if (miss) {
+        return false;
+    }
+
     Utils::RegexResult regex_result;
     std::vector<Utils::SMatchCapture> captures;
+    const Utils::RegexStream *stream = nullptr;
 
-    if (transaction && transaction->m_rules->m_pcreMatchLimit.m_set) {
-        unsigned long match_limit = transaction->m_rules->m_pcreMatchLimit.m_value;
-        regex_result = re->searchOneMatch(input, captures, match_limit);
+    if (transaction && transaction->m_requestBodyStreams && re == m_re.get()) {
+        stream = transaction->m_requestBodyStreams->find(re, input);
+    }
+
+    if (stream && stream->state() == Utils::RegexStream::NotMatched) {
+        ms_dbg_a(transaction, 9, "Rule " \
+            + std::to_string(rule ? rule->m_ruleId : 0) \
+            + ": the request body did not match as it was appended.");
+        return false;
+    } else if (stream) {
+        ms_dbg_a(transaction, 9, "Rule " \
+            + std::to_string(rule ? rule->m_ruleId : 0) \
+            + ": the request body matched as it was appended.");
+        captures = stream->captures();
+        regex_result = Utils::RegexResult::Ok;
     } else {
-        regex_result = re->searchOneMatch(input, captures);
+        regex_result = search(transaction, rule, re, input, &captures,
+            linear);
     }
 
-    // FIXME: DRY regex error reporting. This logic is currently duplicated in other operators.
     if (regex_result != Utils::RegexResult::Ok) {
-        transaction->m_variableMscPcreError.set("1", transaction->m_variableOffset);
-
         std::string regex_error_str = "OTHER";
         if (regex_result == Utils::RegexResult::ErrorMatchLimit) {
             regex_error_str = "MATCH_LIMIT";
-            transaction->m_variableMscPcreLimitsExceeded.set("1", transaction->m_variableOffset);
-            transaction->m_collections.m_tx_collection->storeOrUpdateFirst("MSC_PCRE_LIMITS_EXCEEDED", "1");
-            ms_dbg_a(transaction, 7, "Set TX.MSC_PCRE_LIMITS_EXCEEDED to 1");
         }
+        regexError(transaction,
+            regex_result == Utils::RegexResult::ErrorMatchLimit, rule,
+            &re->pattern);
 
         ms_dbg_a(transaction, 1, "rx: regex error '" + regex_error_str + "' for pattern '" + re->pattern + "'");
 
@@ -86,12 +175,13 @@ bool Rx::evaluate(Transaction *transaction, RuleWithActions *rule,
 
     if (rule && rule->hasCaptureAction() && transaction) {
         for (const Utils::SMatchCapture& capture : captures) {
-            const std::string capture_substring(input.substr(capture.m_offset,capture.m_length));
+            std::string capture_substring(input, capture.m_offset,
+                capture.m_length);
             transaction->m_collections.m_tx_collection->storeOrUpdateFirst(
                 std::to_string(capture.m_group), capture_substring);
             ms_dbg_a(transaction, 7, "Added regex subexpression TX." +
                 std::to_string(capture.m_group) + ": " + capture_substring);
-            transaction->m_matched.push_back(capture_substring);
+            transaction->m_matched.push_back(std::move(capture_substring));
         }
     }
 
@@ -99,10 +189,6 @@ bool Rx::evaluate(Transaction *transaction, RuleWithActions *rule,
         logOffset(ruleMessage, capture.m_offset, capture.m_length);
     }
 
-    if (m_string->m_containsMacro) {
-        delete re;
-    }
-
     if (!captures.empty()) {
         return true;
     }
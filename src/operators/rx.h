@@ -20,9 +20,12 @@
 #include <list>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "src/operators/operator.h"
 #include "src/utils/regex.h"
+#include "src/utils/rx_guardrail.h"
+#include "src/utils/rx_prefilter.h"
 
 
 namespace modsecurity {
@@ -35,28 +38,49 @@ namespace operators {
 
 class Rx : public Operator {
  public:
-    /** @ingroup ModSecurity_Operator */
-    explicit Rx(std::unique_ptr<RunTimeString> param)
+    /**
+     * @ingroup ModSecurity_Operator
+     * store is the one of SecRegexCacheFile, if any, see
+     * Utils::RegexStore. It is only used by init().
+     */
+    explicit Rx(std::unique_ptr<RunTimeString> param,
+        Utils::RegexStore *store = NULL)
         : m_re(nullptr),
+        m_prefilter(nullptr),
+        m_regexStore(store),
         Operator("Rx", std::move(param)) {
             m_couldContainsMacro = true;
         }
 
-    ~Rx() {
-        if (m_string->m_containsMacro == false && m_re != NULL) {
-            delete m_re;
-            m_re = NULL;
-        }
-    }
-
     bool evaluate(Transaction *transaction, RuleWithActions *rule,
         const std::string& input,
         std::shared_ptr<RuleMessage> ruleMessage) override;
 
     bool init(const std::string &arg, std::string *error) override;
+    bool threadSafeInit() const override { return true; }
+
+    std::string backend() const override {
+        return m_re != NULL ? m_re->backend() : "";
+    }
+    bool parallelSafe() const override { return true; }
+
+    /* The expression the operator stands for, unless it has macros. */
+    const Regex *regex() const override {
+        return m_string->m_containsMacro ? nullptr : m_re.get();
+    }
 
  private:
-    Regex *m_re;
+    /* re on input, as cut short by SecRxGuardrail */
+    Utils::RegexResult search(Transaction *transaction,
+        RuleWithActions *rule, Regex *re, const std::string &input,
+        std::vector<Utils::SMatchCapture> *captures, bool linear);
+
+    /* both interned, see Regex::interned */
+    std::shared_ptr<Regex> m_re;
+    std::shared_ptr<Utils::RxPrefilter> m_prefilter;
+    Utils::RegexStore *m_regexStore;
+    /* the cost of m_re, see SecRxGuardrail */
+    Utils::RxGuardrail m_guardrail;
 };
 
 
@@ -0,0 +1,175 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/operators/rx_group.h"
+
+#include <pthread.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifdef WITH_RE2
+#include <re2/re2.h>
+#include <re2/set.h>
+#endif
+
+#include "src/utils/regex.h"
+
+
+namespace modsecurity {
+namespace operators {
+
+
+class RxGroup::Set {
+ public:
+#ifdef WITH_RE2
+    static re2::RE2::Options options() {
+        re2::RE2::Options o;
+        /* as Regex::compileLinear, for @rx, which is case sensitive */
+        o.set_encoding(re2::RE2::Options::EncodingLatin1);
+        o.set_dot_nl(true);
+        o.set_log_errors(false);
+        return o;
+    }
+
+    Set() : m_set(options(), re2::RE2::UNANCHORED) { }
+
+    re2::RE2::Set m_set;
+#endif
+};
+
+
+RxGroup::RxGroup()
+    : m_slots(0),
+    m_set(new Set()) { }
+
+
+RxGroup::~RxGroup() {
+    delete m_set;
+    m_set = nullptr;
+}
+
+
+/*
+ * Gives re the next slot, unless RE2 refuses it.
+ */
+bool RxGroup::add(const Utils::Regex *re, size_t *slot) {
+#ifdef WITH_RE2
+    std::string error;
+
+    if (re->linear() == false
+        || m_set->m_set.Add(re->linearPattern(), &error) < 0) {
+        return false;
+    }
+    *slot = m_slots++;
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+bool RxGroup::prepare() {
+#ifdef WITH_RE2
+    return m_slots > 0 && m_set->m_set.Compile();
+#else
+    return false;
+#endif
+}
+
+
+bool RxGroup::match(const std::string &value,
+    std::vector<bool> *matched) const {
+#ifdef WITH_RE2
+    std::vector<int> found;
+    re2::RE2::Set::ErrorInfo info;
+
+    if (m_set->m_set.Match(value, &found, &info) == false
+        && info.kind != re2::RE2::Set::kNoError) {
+        return false;
+    }
+    matched->assign(m_slots, false);
+    for (int i : found) {
+        (*matched)[i] = true;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+RxGroupCache::RxGroupCache()
+    : m_size(0) {
+    pthread_mutex_init(&m_lock, NULL);
+}
+
+
+RxGroupCache::~RxGroupCache() {
+    pthread_mutex_destroy(&m_lock);
+}
+
+
+int RxGroupCache::match(const RxGroup *group, size_t slot,
+    const std::string &value) {
+    std::vector<bool> matched;
+    bool found = false;
+
+    if (value.size() > MSC_RX_GROUP_CACHE_MAX_LENGTH) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&m_lock);
+    auto g = m_entries.find(group);
+    if (g != m_entries.end()) {
+        auto it = g->second.find(value);
+        if (it != g->second.end()) {
+            matched = it->second;
+            found = true;
+        }
+    }
+    pthread_mutex_unlock(&m_lock);
+
+    if (found == false) {
+        if (group->match(value, &matched) == false) {
+            return -1;
+        }
+
+        /* The fixed part stands for the map nodes and the string header. */
+        size_t size = value.size() + matched.size() / 8 + 64;
+
+        pthread_mutex_lock(&m_lock);
+        if (m_size + size <= MSC_RX_GROUP_CACHE_MAX_SIZE
+            && m_entries[group].emplace(value, matched).second) {
+            m_size = m_size + size;
+        }
+        pthread_mutex_unlock(&m_lock);
+    }
+
+    return matched[slot] ? 1 : 0;
+}
+
+
+void RxGroupCache::clear() {
+    pthread_mutex_lock(&m_lock);
+    m_entries.clear();
+    m_size = 0;
+    pthread_mutex_unlock(&m_lock);
+}
+
+
+}  // namespace operators
+}  // namespace modsecurity
@@ -0,0 +1,101 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <pthread.h>
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifndef SRC_OPERATORS_RX_GROUP_H_
+#define SRC_OPERATORS_RX_GROUP_H_
+
+/* Longest value, and bytes in all, that a transaction keeps. */
+#define MSC_RX_GROUP_CACHE_MAX_LENGTH 16384
+#define MSC_RX_GROUP_CACHE_MAX_SIZE (1024 * 1024)
+
+
+namespace modsecurity {
+namespace Utils {
+class Regex;
+}
+namespace operators {
+
+
+/**
+ * The expressions of several @rx (or @rxGlobal) operators in a single RE2
+ * set (see SecRxRe2). Each operator gets a slot; a value goes through the
+ * set once and comes out with the slots whose expression matches it, in
+ * time linear in its length. Who matched still runs its own expression,
+ * for the captures; who did not is done.
+ *
+ */
+class RxGroup {
+ public:
+    RxGroup();
+    ~RxGroup();
+
+    RxGroup(const RxGroup &) = delete;
+    RxGroup &operator=(const RxGroup &) = delete;
+
+    /* The expression of one more operator, see Regex::linear(). */
+    bool add(const Utils::Regex *re, size_t *slot);
+    bool prepare();
+
+    /*
+     * Fills matched, by slot. False when RE2 could not tell (it ran out
+     * of memory): every operator is then on its own.
+     */
+    bool match(const std::string &value, std::vector<bool> *matched) const;
+
+ private:
+    size_t m_slots;
+    /* the RE2::Set, which can not be declared here */
+    class Set;
+    Set *m_set;
+};
+
+
+/**
+ * Transaction scoped outcome of the RxGroup of the rule set, per value,
+ * as PmGroupCache is for the PmGroup.
+ *
+ */
+class RxGroupCache {
+ public:
+    RxGroupCache();
+    ~RxGroupCache();
+
+    /*
+     * 1 if the expression of the slot of group matches value, 0 if it
+     * does not, -1 if that is unknown (value too long to be kept here,
+     * RE2 out of memory).
+     */
+    int match(const RxGroup *group, size_t slot, const std::string &value);
+    void clear();
+
+ private:
+    std::unordered_map<const RxGroup *, std::unordered_map<std::string,
+        std::vector<bool>>> m_entries;
+    size_t m_size;
+    pthread_mutex_t m_lock;
+};
+
+
+}  // namespace operators
+}  // namespace modsecurity
+
+#endif  // SRC_OPERATORS_RX_GROUP_H_
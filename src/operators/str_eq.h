@@ -35,6 +35,7 @@ class StrEq : public Operator {
         : Operator("StrEq", std::move(param)) { }
 
     bool evaluate(Transaction *transaction, const std::string &str) override;
+    bool parallelSafe() const override { return true; }
 };
 
 }  // namespace operators
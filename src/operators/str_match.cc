@@ -18,17 +18,26 @@
 #include <string>
 
 #include "src/operators/operator.h"
+#include "src/utils/byte_scan.h"
 
 
 namespace modsecurity {
 namespace operators {
 
 
+/*
+ * m_param already has the parameter when it has no macros in it, only a
+ * parameter with macros is expanded on each evaluation.
+ */
 bool StrMatch::evaluate(Transaction *transaction, const std::string &input) {
-    std::string p(m_string->evaluate(transaction));
-    bool ret = input.find(p) != std::string::npos;
-
-    return ret;
+    std::string expanded;
+    if (m_string->m_containsMacro) {
+        expanded = m_string->evaluate(transaction);
+    }
+    const std::string &p = m_string->m_containsMacro ? expanded : m_param;
+
+    return utils::scan::findString(input.data(), input.size(),
+        p.data(), p.size()) != input.size() || p.empty();
 }
 
 
@@ -35,6 +35,7 @@ class StrMatch : public Operator {
         }
 
     bool evaluate(Transaction *transaction, const std::string &input) override;
+    bool parallelSafe() const override { return true; }
 };
 
 }  // namespace operators
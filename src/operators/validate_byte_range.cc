@@ -106,6 +106,21 @@ bool ValidateByteRange::init(const std::string &file,
         pos = next_pos;
     }
 
+    m_scanRanges = true;
+    for (int c = 0; c < 256; c++) {
+        if (!(table[c >> 3] & (1 << (c & 0x7)))) {
+            continue;
+        }
+        int lo = c;
+        while (c < 255 && (table[(c + 1) >> 3] & (1 << ((c + 1) & 0x7)))) {
+            c++;
+        }
+        if (!m_ranges.add(lo, c)) {
+            m_scanRanges = false;
+            break;
+        }
+    }
+
     return true;
 }
 
@@ -115,13 +130,25 @@ bool ValidateByteRange::evaluate(Transaction *transaction, RuleWithActions *rule
     bool ret = true;
 
     size_t count = 0;
-    for (int i = 0; i < input.length(); i++) {
-        int x = (unsigned char) input.at(i);
-        if (!(table[x >> 3] & (1 << (x & 0x7)))) {
-            // debug(9, "Value " + std::to_string(x) + " in " +
-            //     input + " ouside range: " + param);
+    if (m_scanRanges) {
+        const char *p = input.data();
+        size_t len = input.size();
+        size_t i = utils::scan::findOutside(p, len, m_ranges);
+        while (i < len) {
             logOffset(ruleMessage, i, 1);
             count++;
+            i++;
+            i += utils::scan::findOutside(p + i, len - i, m_ranges);
+        }
+    } else {
+        for (int i = 0; i < input.length(); i++) {
+            int x = (unsigned char) input.at(i);
+            if (!(table[x >> 3] & (1 << (x & 0x7)))) {
+                // debug(9, "Value " + std::to_string(x) + " in " +
+                //     input + " ouside range: " + param);
+                logOffset(ruleMessage, i, 1);
+                count++;
+            }
         }
     }
 
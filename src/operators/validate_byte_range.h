@@ -23,6 +23,7 @@
 #include <utility>
 
 #include "src/operators/operator.h"
+#include "src/utils/byte_scan.h"
 
 
 namespace modsecurity {
@@ -32,7 +33,8 @@ class ValidateByteRange : public Operator {
  public:
     /** @ingroup ModSecurity_Operator */
     explicit ValidateByteRange(std::unique_ptr<RunTimeString> param)
-        : Operator("ValidateByteRange", std::move(param)) {
+        : Operator("ValidateByteRange", std::move(param)),
+        m_scanRanges(false) {
             std::memset(table, '\0', sizeof(char) * 32);
         }
     ~ValidateByteRange() override { }
@@ -42,9 +44,16 @@ class ValidateByteRange : public Operator {
         std::shared_ptr<RuleMessage> ruleMessage) override;
     bool getRange(const std::string &rangeRepresentation, std::string *error);
     bool init(const std::string& file, std::string *error) override;
+    bool parallelSafe() const override { return true; }
  private:
     std::vector<std::string> ranges;
     char table[32];
+    /*
+     * The accepted bytes as intervals, when there are few enough of them
+     * for utils::scan::findOutside(); table is used otherwise.
+     */
+    utils::scan::ByteRanges m_ranges;
+    bool m_scanRanges;
 };
 
 }  // namespace operators
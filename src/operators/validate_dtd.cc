@@ -18,6 +18,7 @@
 #include <string>
 
 #include "src/request_body_processor/xml.h"
+#include "src/utils/reloader.h"
 #include "src/utils/system.h"
 #include "src/operators/operator.h"
 
@@ -25,6 +26,38 @@ namespace modsecurity {
 namespace operators {
 
 #ifdef WITH_LIBXML2
+ValidateDTD::Dtd *ValidateDTD::load(const std::string &resource,
+    std::string *error) {
+    /* not the loader of the XML processor, see ValidateSchema::load */
+    xmlParserInputBufferCreateFilenameFunc loader =
+        xmlParserInputBufferCreateFilenameDefault(NULL);
+    xmlDtdPtr dtd = xmlParseDTD(NULL, (const xmlChar *)resource.c_str());
+    xmlParserInputBufferCreateFilenameDefault(loader);
+
+    if (dtd == NULL) {
+        error->assign("XML: Failed to load DTD: " + resource);
+        return NULL;
+    }
+
+#ifdef LIBXML_REGEXP_ENABLED
+    xmlValidCtxtPtr cvp = xmlNewValidCtxt();
+    if (cvp != NULL) {
+        cvp->error = (xmlValidityErrorFunc)null_error;
+        cvp->warning = (xmlValidityWarningFunc)null_error;
+        for (xmlNodePtr n = dtd->children; n != NULL; n = n->next) {
+            if (n->type == XML_ELEMENT_DECL) {
+                xmlValidBuildContentModel(cvp,
+                    reinterpret_cast<xmlElementPtr>(n));
+            }
+        }
+        xmlFreeValidCtxt(cvp);
+    }
+#endif
+
+    return new Dtd(dtd);
+}
+
+
 bool ValidateDTD::init(const std::string &file, std::string *error) {
     std::string err;
     m_resource = utils::find_resource(m_param, file, &err);
@@ -39,6 +72,22 @@ bool ValidateDTD::init(const std::string &file, std::string *error) {
     xmlSetGenericErrorFunc(NULL,
         null_error);
 
+    /* as for a schema, a DTD that does not parse makes the rule match */
+    Dtd *dtd = load(m_resource, &err);
+    if (dtd != NULL) {
+        m_dtd.publish(dtd);
+    }
+
+    m_reloader.reset(new Utils::Reloader(m_resource,
+        [this](std::istream *ss, std::string *err) {
+            Dtd *fresh = load(m_resource, err);
+            if (fresh == NULL) {
+                return false;
+            }
+            m_dtd.publish(fresh);
+            return true;
+        }));
+
     return true;
 }
 
@@ -46,15 +95,27 @@ bool ValidateDTD::init(const std::string &file, std::string *error) {
 bool ValidateDTD::evaluate(Transaction *t, const std::string &str) {
     xmlValidCtxtPtr cvp;
 
-    m_dtd = xmlParseDTD(NULL, (const xmlChar *)m_resource.c_str());
-    if (m_dtd == NULL) {
+    if (m_reloader && t->m_rules->m_dataReloadInterval.m_set) {
+        m_reloader->watch(t->m_rules->m_dataReloadInterval.m_value);
+    }
+
+    std::shared_ptr<const Dtd> dtd = m_dtd.get();
+    if (dtd == NULL) {
         std::string err = std::string("XML: Failed to load DTD: ") \
             + m_resource;
         ms_dbg_a(t, 4, err);
         return true;
     }
 
-    if (t->m_xml->m_data.doc == NULL) {
+    /* see ValidateSchema::evaluate */
+    if (t->m_xml != NULL && t->m_rules->m_secXMLExternalEntity
+        != RulesSetProperties::TrueConfigBoolean) {
+        ms_dbg_a(t, 4, "XML: Failed to load DTD: " + m_resource \
+            + ". SecXMLExternalEntity is not On.");
+        return true;
+    }
+
+    if (t->m_xml == NULL || t->m_xml->m_data.doc == NULL) {
         ms_dbg_a(t, 4, "XML document tree could not "\
             "be found for DTD validation.");
         return true;
@@ -87,7 +148,7 @@ bool ValidateDTD::evaluate(Transaction *t, const std::string &str) {
     cvp->warning = (xmlSchemaValidityErrorFunc)warn_runtime;
     cvp->userData = t;
 
-    if (!xmlValidateDtd(cvp, t->m_xml->m_data.doc, m_dtd)) {
+    if (!xmlValidateDtd(cvp, t->m_xml->m_data.doc, dtd->m_dtd)) {
         ms_dbg_a(t, 4, "XML: DTD validation failed.");
         xmlFreeValidCtxt(cvp);
         return true;
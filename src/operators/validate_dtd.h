@@ -28,6 +28,7 @@
 #include <utility>
 
 #include "src/operators/operator.h"
+#include "src/utils/reloader.h"
 
 
 namespace modsecurity {
@@ -39,13 +40,6 @@ class ValidateDTD : public Operator {
     explicit ValidateDTD(std::unique_ptr<RunTimeString> param)
         : Operator("ValidateDTD", std::move(param)) { }
 #ifdef WITH_LIBXML2
-    ~ValidateDTD() {
-        if (m_dtd != NULL) {
-            xmlFreeDtd(m_dtd);
-            m_dtd = NULL;
-        }
-    }
-
     bool evaluate(Transaction *transaction, const std::string  &str) override;
     bool init(const std::string &file, std::string *error) override;
 
@@ -88,8 +82,27 @@ class ValidateDTD : public Operator {
     }
 
  private:
+    /*
+     * A parsed DTD, with the content models of its elements built
+     * up front: libxml2 builds them on the first validation otherwise,
+     * which would be a write to what the threads share.
+     */
+    class Dtd {
+     public:
+        explicit Dtd(xmlDtdPtr dtd) : m_dtd(dtd) { }
+        ~Dtd() { xmlFreeDtd(m_dtd); }
+
+        Dtd(const Dtd &) = delete;
+        Dtd &operator=(const Dtd &) = delete;
+
+        xmlDtdPtr m_dtd;
+    };
+
+    static Dtd *load(const std::string &resource, std::string *error);
+
     std::string m_resource;
-    xmlDtdPtr m_dtd = NULL;
+    Utils::Versioned<Dtd> m_dtd;
+    std::unique_ptr<Utils::Reloader> m_reloader;
 #endif
 };
 
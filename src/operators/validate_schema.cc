@@ -19,6 +19,7 @@
 
 #include "src/operators/operator.h"
 #include "src/request_body_processor/xml.h"
+#include "src/utils/reloader.h"
 #include "src/utils/system.h"
 
 
@@ -27,6 +28,53 @@ namespace operators {
 
 #ifdef WITH_LIBXML2
 
+ValidateSchema::Schema *ValidateSchema::load(const std::string &resource,
+    std::string *error) {
+    std::string err;
+
+    /*
+     * SecXMLExternalEntity is about the request bodies; the file named by
+     * the rules is read with the default loader, whatever the XML
+     * processor left in place.
+     */
+    xmlParserInputBufferCreateFilenameFunc loader =
+        xmlParserInputBufferCreateFilenameDefault(NULL);
+
+    xmlSchemaParserCtxtPtr parserCtx = xmlSchemaNewParserCtxt(
+        resource.c_str());
+    if (parserCtx == NULL) {
+        xmlParserInputBufferCreateFilenameDefault(loader);
+        error->assign("XML: Failed to load Schema from file: " + resource
+            + ".");
+        return NULL;
+    }
+
+    xmlSchemaSetParserErrors(parserCtx,
+        (xmlSchemaValidityErrorFunc)error_load,
+        (xmlSchemaValidityWarningFunc)warn_load, &err);
+
+    xmlThrDefSetGenericErrorFunc(parserCtx,
+        null_error);
+
+    xmlSetGenericErrorFunc(parserCtx,
+        null_error);
+
+    xmlSchemaPtr schema = xmlSchemaParse(parserCtx);
+    xmlSchemaFreeParserCtxt(parserCtx);
+    xmlParserInputBufferCreateFilenameDefault(loader);
+
+    if (schema == NULL) {
+        error->assign("XML: Failed to load Schema: " + resource + ".");
+        if (err.empty() == false) {
+            error->append(" " + err);
+        }
+        return NULL;
+    }
+
+    return new Schema(schema);
+}
+
+
 bool ValidateSchema::init(const std::string &file, std::string *error) {
     std::string err;
     m_resource = utils::find_resource(m_param, file, &err);
@@ -35,6 +83,26 @@ bool ValidateSchema::init(const std::string &file, std::string *error) {
         return false;
     }
 
+    /*
+     * A schema that does not compile is not a configuration error: as
+     * when it was compiled per request, the rule matches and says why.
+     */
+    Schema *schema = load(m_resource, &m_loadError);
+    if (schema != NULL) {
+        m_schema.publish(schema);
+    }
+
+    m_reloader.reset(new Utils::Reloader(m_resource,
+        [this](std::istream *ss, std::string *err) {
+            /* from the file, for its includes to be found */
+            Schema *fresh = load(m_resource, err);
+            if (fresh == NULL) {
+                return false;
+            }
+            m_schema.publish(fresh);
+            return true;
+        }));
+
     return true;
 }
 
@@ -43,59 +111,28 @@ bool ValidateSchema::evaluate(Transaction *t,
     const std::string &str) {
     int rc;
 
-    m_parserCtx = xmlSchemaNewParserCtxt(m_resource.c_str());
-    if (m_parserCtx == NULL) {
-        std::stringstream err;
-        err << "XML: Failed to load Schema from file: ";
-        err << m_resource;
-        err << ". ";
-        if (m_err.empty() == false) {
-            err << m_err;
-        }
-        ms_dbg_a(t, 4, err.str());
-        return true;
+    if (m_reloader && t->m_rules->m_dataReloadInterval.m_set) {
+        m_reloader->watch(t->m_rules->m_dataReloadInterval.m_value);
     }
 
-    xmlSchemaSetParserErrors(m_parserCtx,
-        (xmlSchemaValidityErrorFunc)error_load,
-        (xmlSchemaValidityWarningFunc)warn_load, &m_err);
-
-    xmlThrDefSetGenericErrorFunc(m_parserCtx,
-        null_error);
-
-    xmlSetGenericErrorFunc(m_parserCtx,
-        null_error);
-
-    m_schema = xmlSchemaParse(m_parserCtx);
-    if (m_schema == NULL) {
-        std::stringstream err;
-        err << "XML: Failed to load Schema: ";
-        err << m_resource;
-        err << ".";
-        if (m_err.empty() == false) {
-            err << " " << m_err;
-        }
-        ms_dbg_a(t, 4, err.str());
-        xmlSchemaFreeParserCtxt(m_parserCtx);
+    std::shared_ptr<const Schema> schema = m_schema.get();
+    if (schema == NULL) {
+        ms_dbg_a(t, 4, m_loadError);
         return true;
     }
 
-    m_validCtx = xmlSchemaNewValidCtxt(m_schema);
-    if (m_validCtx == NULL) {
-        std::stringstream err("XML: Failed to create validation context.");
-        if (m_err.empty() == false) {
-            err << " " << m_err;
-        }
-        ms_dbg_a(t, 4, err.str());
+    /*
+     * Reading the schema used to go through the loader of the XML
+     * processor, which refuses any file unless SecXMLExternalEntity is On.
+     */
+    if (t->m_xml != NULL && t->m_rules->m_secXMLExternalEntity
+        != RulesSetProperties::TrueConfigBoolean) {
+        ms_dbg_a(t, 4, "XML: Failed to load Schema: " + m_resource \
+            + ". SecXMLExternalEntity is not On.");
         return true;
     }
 
-    /* Send validator errors/warnings to msr_log */
-    xmlSchemaSetValidErrors(m_validCtx,
-        (xmlSchemaValidityErrorFunc)error_runtime,
-        (xmlSchemaValidityWarningFunc)warn_runtime, t);
-
-    if (t->m_xml->m_data.doc == NULL) {
+    if (t->m_xml == NULL || t->m_xml->m_data.doc == NULL) {
         ms_dbg_a(t, 4, "XML document tree could not be found for " \
             "schema validation.");
         return true;
@@ -116,18 +153,26 @@ bool ValidateSchema::evaluate(Transaction *t,
     }
     */
 
-    rc = xmlSchemaValidateDoc(m_validCtx, t->m_xml->m_data.doc);
+    xmlSchemaValidCtxtPtr validCtx = xmlSchemaNewValidCtxt(schema->m_schema);
+    if (validCtx == NULL) {
+        ms_dbg_a(t, 4, "XML: Failed to create validation context.");
+        return true;
+    }
+
+    /* Send validator errors/warnings to msr_log */
+    xmlSchemaSetValidErrors(validCtx,
+        (xmlSchemaValidityErrorFunc)error_runtime,
+        (xmlSchemaValidityWarningFunc)warn_runtime, t);
+
+    rc = xmlSchemaValidateDoc(validCtx, t->m_xml->m_data.doc);
+    xmlSchemaFreeValidCtxt(validCtx);
     if (rc != 0) {
         ms_dbg_a(t, 4, "XML: Schema validation failed.");
-        xmlSchemaFree(m_schema);
-        xmlSchemaFreeParserCtxt(m_parserCtx);
         return true; /* No match. */
     }
 
     ms_dbg_a(t, 4, "XML: Successfully validated payload against " \
         "Schema: " + m_resource);
-    xmlSchemaFree(m_schema);
-    xmlSchemaFreeParserCtxt(m_parserCtx);
 
     return false;
 }
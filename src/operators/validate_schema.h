@@ -28,6 +28,7 @@
 #include <utility>
 
 #include "src/operators/operator.h"
+#include "src/utils/reloader.h"
 
 
 namespace modsecurity {
@@ -36,28 +37,9 @@ namespace operators {
 class ValidateSchema : public Operator {
  public:
     /** @ingroup ModSecurity_Operator */
-#ifndef WITH_LIBXML2
     explicit ValidateSchema(std::unique_ptr<RunTimeString> param)
         : Operator("ValidateSchema", std::move(param)) { }
-#else
-    explicit ValidateSchema(std::unique_ptr<RunTimeString> param)
-        : Operator("ValidateSchema", std::move(param)),
-        m_parserCtx(NULL),
-        m_validCtx(NULL),
-        m_schema(NULL) { }
-    ~ValidateSchema() {
-        /*
-        if (m_schema != NULL) {
-            xmlSchemaFree(m_schema);
-            m_schema = NULL;
-        }
-        */
-        if (m_validCtx != NULL) {
-            xmlSchemaFreeValidCtxt(m_validCtx);
-            m_validCtx = NULL;
-        }
-    }
-
+#ifdef WITH_LIBXML2
     bool evaluate(Transaction *transaction, const std::string  &str) override;
     bool init(const std::string &file, std::string *error) override;
 
@@ -129,11 +111,28 @@ class ValidateSchema : public Operator {
     }
 
  private:
-    xmlSchemaParserCtxtPtr m_parserCtx;
-    xmlSchemaValidCtxtPtr m_validCtx;
-    xmlSchemaPtr m_schema;
+    /*
+     * A compiled schema. It is only read by the validations, each with
+     * a context of its own, so the threads can share it.
+     */
+    class Schema {
+     public:
+        explicit Schema(xmlSchemaPtr schema) : m_schema(schema) { }
+        ~Schema() { xmlSchemaFree(m_schema); }
+
+        Schema(const Schema &) = delete;
+        Schema &operator=(const Schema &) = delete;
+
+        xmlSchemaPtr m_schema;
+    };
+
+    static Schema *load(const std::string &resource, std::string *error);
+
     std::string m_resource;
-    std::string m_err;
+    /* why the schema did not load along with the rules, if it did not */
+    std::string m_loadError;
+    Utils::Versioned<Schema> m_schema;
+    std::unique_ptr<Utils::Reloader> m_reloader;
 #endif
 };
 
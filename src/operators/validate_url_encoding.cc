@@ -15,6 +15,8 @@
 
 #include "src/operators/validate_url_encoding.h"
 
+#include <string.h>
+
 #include <string>
 
 #include "src/operators/operator.h"
@@ -34,33 +36,37 @@ int ValidateUrlEncoding::validate_url_encoding(const char *input,
 
     i = 0;
     while (i < input_length) {
-        if (input[i] == '%') {
-            if (i + 2 >= input_length) {
-                *offset = i;
-                /* Not enough bytes. */
-                return -3;
-            } else {
-                /* Here we only decode a %xx combination if it is valid,
-                 * leaving it as is otherwise.
-                 */
-                char c1 = input[i + 1];
-                char c2 = input[i + 2];
-
-                if ( (((c1 >= '0') && (c1 <= '9'))
-                    || ((c1 >= 'a') && (c1 <= 'f'))
-                    || ((c1 >= 'A') && (c1 <= 'F')))
-                    && (((c2 >= '0') && (c2 <= '9'))
-                    || ((c2 >= 'a') && (c2 <= 'f'))
-                    || ((c2 >= 'A') && (c2 <= 'F'))) ) {
-                    i += 3;
-                } else {
-                    /* Non-hexadecimal characters used in encoding. */
-                    *offset = i;
-                    return -2;
-                }
-            }
+        /* Only the escapes need a look, memchr() jumps to the next one. */
+        const char *escape = static_cast<const char *>(
+            memchr(input + i, '%', input_length - i));
+        if (escape == NULL) {
+            break;
+        }
+        i = escape - input;
+
+        if (i + 2 >= input_length) {
+            *offset = i;
+            /* Not enough bytes. */
+            return -3;
+        }
+
+        /* Here we only decode a %xx combination if it is valid,
+         * leaving it as is otherwise.
+         */
+        char c1 = input[i + 1];
+        char c2 = input[i + 2];
+
+        if ( (((c1 >= '0') && (c1 <= '9'))
+            || ((c1 >= 'a') && (c1 <= 'f'))
+            || ((c1 >= 'A') && (c1 <= 'F')))
+            && (((c2 >= '0') && (c2 <= '9'))
+            || ((c2 >= 'a') && (c2 <= 'f'))
+            || ((c2 >= 'A') && (c2 <= 'F'))) ) {
+            i += 3;
         } else {
-            i++;
+            /* Non-hexadecimal characters used in encoding. */
+            *offset = i;
+            return -2;
         }
     }
 
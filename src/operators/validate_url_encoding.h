@@ -37,6 +37,7 @@ class ValidateUrlEncoding : public Operator {
 
     static int validate_url_encoding(const char *input, uint64_t input_length,
         size_t *offset);
+    bool parallelSafe() const override { return true; }
 };
 
 }  // namespace operators
@@ -18,6 +18,7 @@
 #include <string>
 
 #include "src/operators/operator.h"
+#include "src/utils/byte_scan.h"
 
 namespace modsecurity {
 namespace operators {
@@ -121,6 +122,17 @@ bool ValidateUtf8Encoding::evaluate(Transaction *transaction, RuleWithActions *r
     bytes_left = str.size();
 
     for (i = 0; i < str.size();) {
+        /*
+         * ASCII is always valid, it is skipped a block at a time and only
+         * the multi byte sequences go through detect_utf8_character().
+         */
+        size_t ascii = utils::scan::findNonAscii(str_c + i, bytes_left);
+        if (ascii == bytes_left) {
+            break;
+        }
+        i += ascii;
+        bytes_left -= ascii;
+
         int rc = detect_utf8_character((unsigned char *)&str_c[i], bytes_left);
 
         switch (rc) {
@@ -44,6 +44,7 @@ class ValidateUtf8Encoding : public Operator {
 
     static int detect_utf8_character(const unsigned char *p_read,
         unsigned int length);
+    bool parallelSafe() const override { return true; }
 };
 
 }  // namespace operators
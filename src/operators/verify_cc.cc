@@ -20,6 +20,8 @@
 #include <vector>
 
 #include "src/operators/operator.h"
+#include "src/utils/allocator.h"
+#include "src/utils/byte_scan.h"
 
 #ifndef WITH_PCRE2
 #if PCRE_HAVE_JIT
@@ -101,7 +103,8 @@ bool VerifyCC::init(const std::string &param2, std::string *error) {
     int errornumber = 0;
     PCRE2_SIZE erroroffset = 0;
     m_pc = pcre2_compile(pcre2_pattern, PCRE2_ZERO_TERMINATED,
-        pcre2_options, &errornumber, &erroroffset, NULL);
+        pcre2_options, &errornumber, &erroroffset,
+        Utils::Allocator::pcre2Compile());
     if (m_pc == NULL) {
         return false;
     }
@@ -137,11 +140,22 @@ bool VerifyCC::init(const std::string &param2, std::string *error) {
 
 bool VerifyCC::evaluate(Transaction *t, RuleWithActions *rule,
     const std::string& i, std::shared_ptr<RuleMessage> ruleMessage) {
+    /*
+     * luhnVerify() turns down whatever has no digits, so neither can any
+     * match of an input without them. Most response bodies have no card
+     * numbers, but this spares the regex only when there are no digits
+     * at all.
+     */
+    if (utils::scan::findDigit(i.c_str(), i.size()) == i.size()) {
+        return false;
+    }
+
 #ifdef WITH_PCRE2
     PCRE2_SIZE offset = 0;
     size_t target_length = i.length();
     PCRE2_SPTR pcre2_i = reinterpret_cast<PCRE2_SPTR>(i.c_str());
-    pcre2_match_data *match_data = pcre2_match_data_create_from_pattern(m_pc, NULL);
+    pcre2_match_data *match_data = pcre2_match_data_create_from_pattern(m_pc,
+        Utils::Allocator::pcre2());
 
     int ret;
     for (offset = 0; offset < target_length; offset++) {
@@ -168,7 +182,7 @@ bool VerifyCC::evaluate(Transaction *t, RuleWithActions *rule,
         int ovector[33];
         memset(ovector, 0, sizeof(ovector));
         int ret = pcre_exec(m_pc, m_pce, i.c_str(), i.size(), offset,
-            0, ovector, 33) > 0;
+            0, ovector, 33);
 
         /* If there was no match, then we are done. */
         if (ret == PCRE_ERROR_NOMATCH) {
@@ -198,6 +212,11 @@ bool VerifyCC::evaluate(Transaction *t, RuleWithActions *rule,
 #endif
                 return true;
             }
+            /*
+             * Searching again from any offset up to the start of this
+             * match would only find it again.
+             */
+            offset = ovector[0];
         }
     }
 
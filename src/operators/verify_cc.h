@@ -51,6 +51,8 @@ class VerifyCC : public Operator {
         const std::string& input,
         std::shared_ptr<RuleMessage> ruleMessage)  override;
     bool init(const std::string &param, std::string *error) override;
+    bool threadSafeInit() const override { return true; }
+    bool parallelSafe() const override { return true; }
  private:
 #if WITH_PCRE2
     pcre2_code *m_pc;
@@ -16,7 +16,7 @@
 #include "src/operators/verify_cpf.h"
 
 #include <string>
-#include <list>
+#include <vector>
 
 #include "src/operators/operator.h"
 
@@ -110,25 +110,27 @@ bool VerifyCPF::verify(const char *cpfnumber, int len) {
 
 bool VerifyCPF::evaluate(Transaction *t, RuleWithActions *rule,
     const std::string& input, std::shared_ptr<RuleMessage> ruleMessage) {
-    std::list<SMatch> matches;
+    std::vector<Utils::SMatchCapture> matches;
     bool is_cpf = false;
-    int i;
 
     if (m_param.empty()) {
         return false;
     }
 
-    for (i = 0; i < input.size() - 1 && is_cpf == false; i++) {
-        matches = m_re->searchAll(input.substr(i, input.size()));
-        for (const auto & m : matches) {
-            is_cpf = verify(m.str().c_str(), m.str().size());
+    for (size_t i = 0; i + 1 < input.size() && is_cpf == false; i++) {
+        matches.clear();
+        m_re->searchAll(input.c_str() + i, input.size() - i, &matches);
+        for (auto j = matches.rbegin(); j != matches.rend(); ++j) {
+            const char *match = input.c_str() + i + j->m_offset;
+            is_cpf = verify(match, j->m_length);
             if (is_cpf) {
-                logOffset(ruleMessage, m.offset(), m.str().size());
+                logOffset(ruleMessage, j->m_offset, j->m_length);
                 if (rule && t && rule->hasCaptureAction()) {
+                    std::string value(match, j->m_length);
                     t->m_collections.m_tx_collection->storeOrUpdateFirst(
-                        "0", m.str());
+                        "0", value);
                     ms_dbg_a(t, 7, "Added VerifyCPF match TX.0: " + \
-                        m.str());
+                        value);
                 }
 
                 goto out;
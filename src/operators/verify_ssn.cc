@@ -17,7 +17,7 @@
 
 #include <string>
 #include <memory>
-#include <list>
+#include <vector>
 
 #include "src/operators/operator.h"
 
@@ -112,25 +112,27 @@ invalid:
 
 bool VerifySSN::evaluate(Transaction *t, RuleWithActions *rule,
     const std::string& input, std::shared_ptr<RuleMessage> ruleMessage) {
-    std::list<SMatch> matches;
+    std::vector<Utils::SMatchCapture> matches;
     bool is_ssn = false;
-    int i;
 
     if (m_param.empty()) {
         return false;
     }
 
-    for (i = 0; i < input.size() - 1 && is_ssn == false; i++) {
-        matches = m_re->searchAll(input.substr(i, input.size()));
-        for (const auto & j : matches) {
-            is_ssn = verify(j.str().c_str(), j.str().size());
+    for (size_t i = 0; i + 1 < input.size() && is_ssn == false; i++) {
+        matches.clear();
+        m_re->searchAll(input.c_str() + i, input.size() - i, &matches);
+        for (auto j = matches.rbegin(); j != matches.rend(); ++j) {
+            const char *match = input.c_str() + i + j->m_offset;
+            is_ssn = verify(match, j->m_length);
             if (is_ssn) {
-                logOffset(ruleMessage, j.offset(), j.str().size());
+                logOffset(ruleMessage, j->m_offset, j->m_length);
                 if (rule && t && rule->hasCaptureAction()) {
+                    std::string value(match, j->m_length);
                     t->m_collections.m_tx_collection->storeOrUpdateFirst(
-                        "0", j.str());
+                        "0", value);
                     ms_dbg_a(t, 7, "Added VerifySSN match TX.0: " + \
-                        j.str());
+                        value);
                 }
 
                 goto out;
@@ -2,6 +2,7 @@
 #include "src/operators/verify_svnr.h"
 
 #include <string>
+#include <vector>
 
 #include "src/operators/operator.h"
 
@@ -79,26 +80,27 @@ bool VerifySVNR::verify(const char *svnrnumber, int len) {
 
 bool VerifySVNR::evaluate(Transaction *t, RuleWithActions *rule,
     const std::string& input, std::shared_ptr<RuleMessage> ruleMessage) {
-    std::list<SMatch> matches;
+    std::vector<Utils::SMatchCapture> matches;
     bool is_svnr = false;
-    int i;
 
     if (m_param.empty()) {
         return is_svnr;
     }
 
-    for (i = 0; i < input.size() - 1 && is_svnr == false; i++) {
-        matches = m_re->searchAll(input.substr(i, input.size()));
-
-        for (const auto & j : matches) {
-            is_svnr = verify(j.str().c_str(), j.str().size());
+    for (size_t i = 0; i + 1 < input.size() && is_svnr == false; i++) {
+        matches.clear();
+        m_re->searchAll(input.c_str() + i, input.size() - i, &matches);
+        for (auto j = matches.rbegin(); j != matches.rend(); ++j) {
+            const char *match = input.c_str() + i + j->m_offset;
+            is_svnr = verify(match, j->m_length);
             if (is_svnr) {
-                logOffset(ruleMessage, j.offset(), j.str().size());
+                logOffset(ruleMessage, j->m_offset, j->m_length);
                 if (rule && t && rule->hasCaptureAction()) {
+                    std::string value(match, j->m_length);
                     t->m_collections.m_tx_collection->storeOrUpdateFirst(
-                        "0", j.str());
+                        "0", value);
                     ms_dbg_a(t, 7, "Added VerifySVNR match TX.0: " + \
-                        j.str());
+                        value);
                 }
 
                 goto out;
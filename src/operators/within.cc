@@ -16,6 +16,10 @@
 #include "src/operators/within.h"
 
 #include <string>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "src/operators/operator.h"
 
@@ -24,17 +28,84 @@ namespace modsecurity {
 namespace operators {
 
 
+Within::List::List(const std::string &value)
+    : m_value(value) {
+    size_t start = 0;
+    while (start < m_value.size()) {
+        size_t end = m_value.find_first_of(" ,\t", start);
+        if (end == std::string::npos) {
+            end = m_value.size();
+        }
+        if (end > start) {
+            std::string token(m_value, start, end - start);
+            if (m_tokens.find(token) == m_tokens.end()) {
+                size_t offset = m_value.find(token);
+                m_tokens.emplace(std::move(token), offset);
+            }
+        }
+        start = end + 1;
+    }
+}
+
+
+/*
+ * Lists with macros come from variables set by the setup rules, so they
+ * are the same on every transaction. Each thread keeps the last ones of
+ * each operator, found by comparing the expanded parameter: an operator
+ * freed with its rules set and another one at the same address can only
+ * be handed a list made of the same value. Nothing is locked.
+ */
+std::shared_ptr<const Within::List> Within::findList(
+    const std::string &value) const {
+    typedef std::vector<std::shared_ptr<const List>> Lists;
+    static thread_local std::unordered_map<const Within *, Lists> cache;
+
+    if (cache.size() >= MSC_WITHIN_CACHE_LIMIT
+        && cache.find(this) == cache.end()) {
+        cache.clear();
+    }
+    Lists &lists = cache[this];
+
+    for (size_t i = 0; i < lists.size(); i++) {
+        if (lists[i]->m_value == value) {
+            if (i > 0) {
+                std::swap(lists[i], lists[0]);
+            }
+            return lists[0];
+        }
+    }
+
+    if (lists.size() >= MSC_WITHIN_CACHE_LISTS) {
+        lists.pop_back();
+    }
+    lists.insert(lists.begin(), std::make_shared<const List>(value));
+
+    return lists[0];
+}
+
+
 bool Within::evaluate(Transaction *transaction, RuleWithActions *rule,
     const std::string &str, std::shared_ptr<RuleMessage> ruleMessage) {
     bool res = false;
     size_t pos = 0;
-    std::string paramTarget(m_string->evaluate(transaction));
 
     if (str.empty()) {
         return true;
     }
 
-    pos = paramTarget.find(str);
+    const List *list = m_static.get();
+    std::shared_ptr<const List> expanded;
+    if (list == nullptr) {
+        expanded = findList(m_string->evaluate(transaction));
+        list = expanded.get();
+    }
+
+    auto it = list->m_tokens.find(str);
+    if (it != list->m_tokens.end()) {
+        pos = it->second;
+    } else {
+        pos = list->m_value.find(str);
+    }
     res = pos != std::string::npos;
     if (res) {
         logOffset(ruleMessage, pos, str.size());
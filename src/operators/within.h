@@ -18,10 +18,16 @@
 
 #include <string>
 #include <memory>
+#include <unordered_map>
 #include <utility>
 
 #include "src/operators/operator.h"
 
+/* @within operators with macros each thread keeps expanded lists for. */
+#define MSC_WITHIN_CACHE_LIMIT 256
+/* Distinct expanded lists a thread keeps for each of them. */
+#define MSC_WITHIN_CACHE_LISTS 4
+
 
 namespace modsecurity {
 namespace operators {
@@ -32,9 +38,33 @@ class Within : public Operator {
     explicit Within(std::unique_ptr<RunTimeString> param)
         : Operator("Within", std::move(param)) {
             m_couldContainsMacro = true;
+            if (!m_string->m_containsMacro) {
+                m_static = std::make_shared<const List>(m_param);
+            }
         }
+
     bool evaluate(Transaction *transaction, RuleWithActions *rule,
         const std::string &str, std::shared_ptr<RuleMessage> ruleMessage) override;
+    bool parallelSafe() const override { return true; }
+
+ private:
+    /**
+     * An expanded parameter split on spaces, commas and tabs. Each token
+     * maps to the offset where the parameter first contains it, which is
+     * what a substring search would find, so that inputs matching a whole
+     * token are answered without searching. Anything else still goes
+     * through a search of m_value.
+     */
+    struct List {
+        explicit List(const std::string &value);
+        std::string m_value;
+        std::unordered_map<std::string, size_t> m_tokens;
+    };
+
+    std::shared_ptr<const List> findList(const std::string &value) const;
+
+    /* Built once when the parameter has no macros. */
+    std::shared_ptr<const List> m_static;
 };
 
 }  // namespace operators
@@ -15,10 +15,18 @@
 
 #include "src/parser/driver.h"
 
+#include <pthread.h>
+#include <unistd.h>
+
+#include <atomic>
+
 #include "modsecurity/rules_set_properties.h"
 #include "src/parser/seclang-parser.hh"
 #include "modsecurity/audit_log.h"
 #include "modsecurity/rule_marker.h"
+#include "src/operators/operator.h"
+#include "src/utils/download_cache.h"
+#include "src/utils/regex_store.h"
 
 using modsecurity::audit_log::AuditLog;
 using modsecurity::RuleWithOperator;
@@ -26,6 +34,33 @@ using modsecurity::RuleWithOperator;
 namespace modsecurity {
 namespace Parser {
 
+namespace {
+
+/* Below that many operators the threads cost more than they save. */
+const size_t kDeferredInitMinPerThread = 16;
+const long kDeferredInitMaxThreads = 16;
+
+struct DeferredInitQueue {
+    std::vector<Driver::DeferredInit> *items;
+    std::atomic<size_t> next;
+};
+
+
+void *runDeferredInit(void *data) {
+    DeferredInitQueue *queue = reinterpret_cast<DeferredInitQueue *>(data);
+    size_t i;
+
+    while ((i = queue->next++) < queue->items->size()) {
+        Driver::DeferredInit &d = queue->items->at(i);
+        d.ok = d.op->init(d.file, &d.error);
+    }
+
+    return NULL;
+}
+
+}  // namespace
+
+
 Driver::Driver()
   : RulesSetProperties(),
   trace_scanning(false),
@@ -127,6 +162,12 @@ int Driver::addSecRule(std::unique_ptr<RuleWithActions> r) {
 
 
 int Driver::parse(const std::string &f, const std::string &ref) {
+    buffer = f;
+    return parseBuffer(ref);
+}
+
+
+int Driver::parseBuffer(const std::string &ref) {
     m_lastRule = nullptr;
     loc.push_back(new yy::location());
     if (ref.empty()) {
@@ -137,16 +178,35 @@ int Driver::parse(const std::string &f, const std::string &ref) {
         loc.back()->begin.filename = loc.back()->end.filename = &(m_filenames.back());
     }
 
-    if (f.empty()) {
+    if (buffer.empty()) {
         return 1;
     }
 
-    buffer = f;
+    Utils::DownloadCache::getInstance().prefetch(buffer);
     scan_begin();
     yy::seclang_parser parser(*this);
     parser.set_debug_level(trace_parsing);
     int res = parser.parse();
     scan_end();
+    Utils::DownloadCache::getInstance().clearPrefetched();
+
+    /*
+     * On a parser error the rules owning the queued operators may be
+     * gone already, nothing is going to use them anyway.
+     */
+    if (res != 0) {
+        m_deferredInit.clear();
+    } else if (initDeferred() == false) {
+        return false;
+    }
+
+    if (res == 0) {
+        std::string error;
+        if (m_regexStore && m_regexStore->save(&error) == false) {
+            m_parserError << error << std::endl;
+            return false;
+        }
+    }
 
     /*
      * need to check for rules marked as chained but without
@@ -175,21 +235,74 @@ int Driver::parse(const std::string &f, const std::string &ref) {
 
 int Driver::parseFile(const std::string &f) {
     std::ifstream t(f);
-    std::string str;
 
     if (utils::isFile(f) == false) {
         m_parserError << "Failed to open the file: " << f << std::endl;
         return false;
     }
 
+    /* Read at once into the buffer that the scanner works on. */
     t.seekg(0, std::ios::end);
-    str.reserve(t.tellg());
+    std::streamoff size = t.tellg();
     t.seekg(0, std::ios::beg);
+    if (size < 0) {
+        m_parserError << "Failed to read the file: " << f << std::endl;
+        return false;
+    }
+    buffer.resize(size);
+    t.read(&buffer[0], size);
+    buffer.resize(t.gcount());
+
+    return parseBuffer(f);
+}
+
+
+void Driver::deferInit(operators::Operator *op, const std::string &file,
+    const yy::location &l) {
+    m_deferredInit.push_back({op, file, l, "", false});
+}
+
 
-    str.assign((std::istreambuf_iterator<char>(t)),
-        std::istreambuf_iterator<char>());
+bool Driver::initDeferred() {
+    DeferredInitQueue queue;
+    std::vector<pthread_t> threads;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    long wanted = m_deferredInit.size() / kDeferredInitMinPerThread;
+
+    if (wanted > cpus) {
+        wanted = cpus;
+    }
+    if (wanted > kDeferredInitMaxThreads) {
+        wanted = kDeferredInitMaxThreads;
+    }
+
+    queue.items = &m_deferredInit;
+    queue.next = 0;
+
+    /* The calling thread takes its share, it is one of the workers. */
+    for (long i = 1; i < wanted; i++) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, runDeferredInit, &queue) != 0) {
+            break;
+        }
+        threads.push_back(thread);
+    }
+    runDeferredInit(&queue);
+    for (pthread_t &thread : threads) {
+        pthread_join(thread, NULL);
+    }
+
+    bool ok = true;
+    for (DeferredInit &d : m_deferredInit) {
+        if (d.ok == false) {
+            error(d.location, d.error);
+            ok = false;
+            break;
+        }
+    }
+    m_deferredInit.clear();
 
-    return parse(str, f);
+    return ok;
 }
 
 
@@ -16,6 +16,7 @@
 #ifdef __cplusplus
 #include <string>
 #include <map>
+#include <memory>
 #include <stack>
 #include <vector>
 #include <list>
@@ -30,6 +31,7 @@
 #include "modsecurity/rules_set_properties.h"
 #include "modsecurity/audit_log.h"
 #include "src/rule_script.h"
+#include "src/utils/regex_store.h"
 #ifndef MS_CPPCHECK_DISABLED_FOR_PARSER
 #include "src/parser/seclang-parser.hh"
 #endif
@@ -69,6 +71,8 @@ class Driver : public RulesSetProperties {
 
     int parseFile(const std::string& f);
     int parse(const std::string& f, const std::string &ref);
+    /* parse() for what is in buffer already, which the scanner changes. */
+    int parseBuffer(const std::string &ref);
 
     std::string file;
 
@@ -78,6 +82,32 @@ class Driver : public RulesSetProperties {
     void error(const yy::location& l, const std::string& m,
         const std::string& c);
 
+    /**
+     * Queues an operator whose init() is thread safe. The queued
+     * operators are compiled together on a few threads when parse()
+     * is done with the rules, instead of one by one from the parser
+     * actions. Errors are reported against the rule location, in the
+     * order the rules were read.
+     */
+    void deferInit(operators::Operator *op, const std::string &file,
+        const yy::location &l);
+    bool initDeferred();
+
+    struct DeferredInit {
+        operators::Operator *op;
+        std::string file;
+        yy::location location;
+        std::string error;
+        bool ok;
+    };
+    std::vector<DeferredInit> m_deferredInit;
+
+    /* SecRegexCacheFile, saved once the rules were loaded */
+    std::unique_ptr<Utils::RegexStore> m_regexStore;
+
+    /* SecRuleNativeModule, as the parser loaded it */
+    std::shared_ptr<NativeModule> m_nativeModule;
+
     std::list<yy::location *> loc;
 
     std::string buffer;
@@ -42,7 +42,7 @@
 
 
 // Unqualified %code blocks.
-#line 330 "seclang-parser.yy"
+#line 353 "seclang-parser.yy"
 
 #include "src/parser/driver.h"
 
@@ -215,6 +215,7 @@ namespace yy {
       case symbol_kind::S_ACTION_CHAIN: // "Chain"
       case symbol_kind::S_ACTION_CTL_AUDIT_ENGINE: // "ACTION_CTL_AUDIT_ENGINE"
       case symbol_kind::S_ACTION_CTL_AUDIT_LOG_PARTS: // "ACTION_CTL_AUDIT_LOG_PARTS"
+      case symbol_kind::S_ACTION_CTL_BDY_GRPC: // "ACTION_CTL_BDY_GRPC"
       case symbol_kind::S_ACTION_CTL_BDY_JSON: // "ACTION_CTL_BDY_JSON"
       case symbol_kind::S_ACTION_CTL_BDY_XML: // "ACTION_CTL_BDY_XML"
       case symbol_kind::S_ACTION_CTL_BDY_URLENCODED: // "ACTION_CTL_BDY_URLENCODED"
@@ -238,6 +239,7 @@ namespace yy {
       case symbol_kind::S_ACTION_MULTI_MATCH: // "MultiMatch"
       case symbol_kind::S_ACTION_NO_AUDIT_LOG: // "NoAuditLog"
       case symbol_kind::S_ACTION_NO_LOG: // "NoLog"
+      case symbol_kind::S_ACTION_NO_VERDICT_CACHE: // "NoVerdictCache"
       case symbol_kind::S_ACTION_PASS: // "Pass"
       case symbol_kind::S_ACTION_PAUSE: // "Pause"
       case symbol_kind::S_ACTION_PHASE: // "Phase"
@@ -302,6 +304,7 @@ namespace yy {
       case symbol_kind::S_CONFIG_SEC_ARGUMENT_SEPARATOR: // "CONFIG_SEC_ARGUMENT_SEPARATOR"
       case symbol_kind::S_CONFIG_SEC_WEB_APP_ID: // "CONFIG_SEC_WEB_APP_ID"
       case symbol_kind::S_CONFIG_SEC_SERVER_SIG: // "CONFIG_SEC_SERVER_SIG"
+      case symbol_kind::S_CONFIG_DIR_AUDIT_COMPRESSION_LEVEL: // "CONFIG_DIR_AUDIT_COMPRESSION_LEVEL"
       case symbol_kind::S_CONFIG_DIR_AUDIT_DIR: // "CONFIG_DIR_AUDIT_DIR"
       case symbol_kind::S_CONFIG_DIR_AUDIT_DIR_MOD: // "CONFIG_DIR_AUDIT_DIR_MOD"
       case symbol_kind::S_CONFIG_DIR_AUDIT_ENG: // "CONFIG_DIR_AUDIT_ENG"
@@ -309,7 +312,9 @@ namespace yy {
       case symbol_kind::S_CONFIG_DIR_AUDIT_LOG: // "CONFIG_DIR_AUDIT_LOG"
       case symbol_kind::S_CONFIG_DIR_AUDIT_LOG2: // "CONFIG_DIR_AUDIT_LOG2"
       case symbol_kind::S_CONFIG_DIR_AUDIT_LOG_P: // "CONFIG_DIR_AUDIT_LOG_P"
+      case symbol_kind::S_CONFIG_DIR_AUDIT_RATE_LIMIT: // "CONFIG_DIR_AUDIT_RATE_LIMIT"
       case symbol_kind::S_CONFIG_DIR_AUDIT_STS: // "CONFIG_DIR_AUDIT_STS"
+      case symbol_kind::S_CONFIG_DIR_AUDIT_TIMINGS: // "CONFIG_DIR_AUDIT_TIMINGS"
       case symbol_kind::S_CONFIG_DIR_AUDIT_TPE: // "CONFIG_DIR_AUDIT_TPE"
       case symbol_kind::S_CONFIG_DIR_DEBUG_LOG: // "CONFIG_DIR_DEBUG_LOG"
       case symbol_kind::S_CONFIG_DIR_DEBUG_LVL: // "CONFIG_DIR_DEBUG_LVL"
@@ -324,13 +329,32 @@ namespace yy {
       case symbol_kind::S_CONFIG_DIR_GEO_DB: // "CONFIG_DIR_GEO_DB"
       case symbol_kind::S_CONFIG_DIR_GSB_DB: // "CONFIG_DIR_GSB_DB"
       case symbol_kind::S_CONFIG_SEC_GUARDIAN_LOG: // "CONFIG_SEC_GUARDIAN_LOG"
+      case symbol_kind::S_CONFIG_DIR_DATA_RELOAD_INTERVAL: // "CONFIG_DIR_DATA_RELOAD_INTERVAL"
+      case symbol_kind::S_CONFIG_DIR_LUA_STATE_POOL_LIMIT: // "CONFIG_DIR_LUA_STATE_POOL_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_OVERLOAD_DETECTION_ONLY: // "CONFIG_DIR_OVERLOAD_DETECTION_ONLY"
+      case symbol_kind::S_CONFIG_DIR_OVERLOAD_SHED_TAG: // "CONFIG_DIR_OVERLOAD_SHED_TAG"
+      case symbol_kind::S_CONFIG_DIR_OVERLOAD_TARGET: // "CONFIG_DIR_OVERLOAD_TARGET"
+      case symbol_kind::S_CONFIG_DIR_PCRE_JIT_STACK_SIZE: // "CONFIG_DIR_PCRE_JIT_STACK_SIZE"
       case symbol_kind::S_CONFIG_DIR_PCRE_MATCH_LIMIT: // "CONFIG_DIR_PCRE_MATCH_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_RBL_TIMEOUT: // "CONFIG_DIR_RBL_TIMEOUT"
+      case symbol_kind::S_CONFIG_DIR_RULE_EARLY_DECISION: // "CONFIG_DIR_RULE_EARLY_DECISION"
+      case symbol_kind::S_CONFIG_DIR_RULE_EVALUATION_THREADS: // "CONFIG_DIR_RULE_EVALUATION_THREADS"
+      case symbol_kind::S_CONFIG_DIR_RULE_ENG_SAMPLE_RATE: // "CONFIG_DIR_RULE_ENG_SAMPLE_RATE"
+      case symbol_kind::S_CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE: // "CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE"
+      case symbol_kind::S_CONFIG_DIR_RX_GUARDRAIL: // "CONFIG_DIR_RX_GUARDRAIL"
+      case symbol_kind::S_CONFIG_DIR_REGEX_CACHE_FILE: // "CONFIG_DIR_REGEX_CACHE_FILE"
+      case symbol_kind::S_CONFIG_DIR_RULE_NATIVE_MODULE: // "CONFIG_DIR_RULE_NATIVE_MODULE"
+      case symbol_kind::S_CONFIG_DIR_SHADOW_RULES: // "CONFIG_DIR_SHADOW_RULES"
       case symbol_kind::S_CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION: // "CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION"
       case symbol_kind::S_CONFIG_SEC_CONN_R_STATE_LIMIT: // "CONFIG_SEC_CONN_R_STATE_LIMIT"
       case symbol_kind::S_CONFIG_SEC_CONN_W_STATE_LIMIT: // "CONFIG_SEC_CONN_W_STATE_LIMIT"
       case symbol_kind::S_CONFIG_SEC_SENSOR_ID: // "CONFIG_SEC_SENSOR_ID"
       case symbol_kind::S_CONFIG_DIR_ARGS_LIMIT: // "CONFIG_DIR_ARGS_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_REQ_BODY_DECOMPRESSION: // "CONFIG_DIR_REQ_BODY_DECOMPRESSION"
+      case symbol_kind::S_CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO: // "CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO"
+      case symbol_kind::S_CONFIG_DIR_RES_BODY_DECOMPRESSION: // "CONFIG_DIR_RES_BODY_DECOMPRESSION"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT: // "CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_REQ_BODY_JSON_SIMD: // "CONFIG_DIR_REQ_BODY_JSON_SIMD"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY: // "CONFIG_DIR_REQ_BODY"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT: // "CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY_LIMIT: // "CONFIG_DIR_REQ_BODY_LIMIT"
@@ -339,17 +363,34 @@ namespace yy {
       case symbol_kind::S_CONFIG_DIR_RES_BODY: // "CONFIG_DIR_RES_BODY"
       case symbol_kind::S_CONFIG_DIR_RES_BODY_LIMIT: // "CONFIG_DIR_RES_BODY_LIMIT"
       case symbol_kind::S_CONFIG_DIR_RES_BODY_LIMIT_ACTION: // "CONFIG_DIR_RES_BODY_LIMIT_ACTION"
+      case symbol_kind::S_CONFIG_DIR_RES_BODY_STREAM_WINDOW: // "CONFIG_DIR_RES_BODY_STREAM_WINDOW"
       case symbol_kind::S_CONFIG_SEC_RULE_INHERITANCE: // "CONFIG_SEC_RULE_INHERITANCE"
       case symbol_kind::S_CONFIG_SEC_RULE_PERF_TIME: // "CONFIG_SEC_RULE_PERF_TIME"
+      case symbol_kind::S_CONFIG_SEC_RULE_PROFILING: // "CONFIG_SEC_RULE_PROFILING"
+      case symbol_kind::S_CONFIG_SEC_RULE_VALUE_MAJOR: // "CONFIG_SEC_RULE_VALUE_MAJOR"
+      case symbol_kind::S_CONFIG_SEC_RX_PREFILTER: // "CONFIG_SEC_RX_PREFILTER"
+      case symbol_kind::S_CONFIG_SEC_RX_RE2: // "CONFIG_SEC_RX_RE2"
       case symbol_kind::S_CONFIG_DIR_RULE_ENG: // "CONFIG_DIR_RULE_ENG"
       case symbol_kind::S_CONFIG_DIR_SEC_ACTION: // "CONFIG_DIR_SEC_ACTION"
       case symbol_kind::S_CONFIG_DIR_SEC_DEFAULT_ACTION: // "CONFIG_DIR_SEC_DEFAULT_ACTION"
       case symbol_kind::S_CONFIG_DIR_SEC_MARKER: // "CONFIG_DIR_SEC_MARKER"
       case symbol_kind::S_CONFIG_DIR_UNICODE_MAP_FILE: // "CONFIG_DIR_UNICODE_MAP_FILE"
       case symbol_kind::S_CONFIG_DIR_UNICODE_CODE_PAGE: // "CONFIG_DIR_UNICODE_CODE_PAGE"
+      case symbol_kind::S_CONFIG_SEC_COLLECTION_GROUP_COMMIT: // "CONFIG_SEC_COLLECTION_GROUP_COMMIT"
+      case symbol_kind::S_CONFIG_SEC_COLLECTION_REDIS_SERVER: // "CONFIG_SEC_COLLECTION_REDIS_SERVER"
+      case symbol_kind::S_CONFIG_SEC_COLLECTION_SYNC_MODE: // "CONFIG_SEC_COLLECTION_SYNC_MODE"
       case symbol_kind::S_CONFIG_SEC_COLLECTION_TIMEOUT: // "CONFIG_SEC_COLLECTION_TIMEOUT"
+      case symbol_kind::S_CONFIG_SEC_TRANSACTION_ID_FORMAT: // "CONFIG_SEC_TRANSACTION_ID_FORMAT"
+      case symbol_kind::S_CONFIG_SEC_TRANSACTION_MEMORY_LIMIT: // "CONFIG_SEC_TRANSACTION_MEMORY_LIMIT"
+      case symbol_kind::S_CONFIG_SEC_TRANSACTION_TIME_BUDGET: // "CONFIG_SEC_TRANSACTION_TIME_BUDGET"
+      case symbol_kind::S_CONFIG_SEC_VERDICT_CACHE: // "CONFIG_SEC_VERDICT_CACHE"
+      case symbol_kind::S_CONFIG_SEC_DEBUG_LOG_BUFFER: // "CONFIG_SEC_DEBUG_LOG_BUFFER"
+      case symbol_kind::S_CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH: // "CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH"
+      case symbol_kind::S_CONFIG_SEC_DEBUG_LOG_FILTER: // "CONFIG_SEC_DEBUG_LOG_FILTER"
       case symbol_kind::S_CONFIG_SEC_HTTP_BLKEY: // "CONFIG_SEC_HTTP_BLKEY"
+      case symbol_kind::S_CONFIG_SEC_HUGE_PAGES: // "CONFIG_SEC_HUGE_PAGES"
       case symbol_kind::S_CONFIG_SEC_INTERCEPT_ON_ERROR: // "CONFIG_SEC_INTERCEPT_ON_ERROR"
+      case symbol_kind::S_CONFIG_SEC_REMOTE_RULES_CACHE_DIR: // "CONFIG_SEC_REMOTE_RULES_CACHE_DIR"
       case symbol_kind::S_CONFIG_SEC_REMOTE_RULES_FAIL_ACTION: // "CONFIG_SEC_REMOTE_RULES_FAIL_ACTION"
       case symbol_kind::S_CONFIG_SEC_RULE_REMOVE_BY_ID: // "CONFIG_SEC_RULE_REMOVE_BY_ID"
       case symbol_kind::S_CONFIG_SEC_RULE_REMOVE_BY_MSG: // "CONFIG_SEC_RULE_REMOVE_BY_MSG"
@@ -360,9 +401,11 @@ namespace yy {
       case symbol_kind::S_CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID: // "CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID"
       case symbol_kind::S_CONFIG_UPDLOAD_KEEP_FILES: // "CONFIG_UPDLOAD_KEEP_FILES"
       case symbol_kind::S_CONFIG_UPDLOAD_SAVE_TMP_FILES: // "CONFIG_UPDLOAD_SAVE_TMP_FILES"
+      case symbol_kind::S_CONFIG_UPLOAD_ANONYMOUS_FILES: // "CONFIG_UPLOAD_ANONYMOUS_FILES"
       case symbol_kind::S_CONFIG_UPLOAD_DIR: // "CONFIG_UPLOAD_DIR"
       case symbol_kind::S_CONFIG_UPLOAD_FILE_LIMIT: // "CONFIG_UPLOAD_FILE_LIMIT"
       case symbol_kind::S_CONFIG_UPLOAD_FILE_MODE: // "CONFIG_UPLOAD_FILE_MODE"
+      case symbol_kind::S_CONFIG_UPLOAD_IN_MEMORY_LIMIT: // "CONFIG_UPLOAD_IN_MEMORY_LIMIT"
       case symbol_kind::S_CONFIG_VALUE_ABORT: // "CONFIG_VALUE_ABORT"
       case symbol_kind::S_CONFIG_VALUE_DETC: // "CONFIG_VALUE_DETC"
       case symbol_kind::S_CONFIG_VALUE_HTTPS: // "CONFIG_VALUE_HTTPS"
@@ -372,7 +415,9 @@ namespace yy {
       case symbol_kind::S_CONFIG_VALUE_PROCESS_PARTIAL: // "CONFIG_VALUE_PROCESS_PARTIAL"
       case symbol_kind::S_CONFIG_VALUE_REJECT: // "CONFIG_VALUE_REJECT"
       case symbol_kind::S_CONFIG_VALUE_RELEVANT_ONLY: // "CONFIG_VALUE_RELEVANT_ONLY"
+      case symbol_kind::S_CONFIG_VALUE_RING: // "CONFIG_VALUE_RING"
       case symbol_kind::S_CONFIG_VALUE_SERIAL: // "CONFIG_VALUE_SERIAL"
+      case symbol_kind::S_CONFIG_VALUE_STREAM: // "CONFIG_VALUE_STREAM"
       case symbol_kind::S_CONFIG_VALUE_WARN: // "CONFIG_VALUE_WARN"
       case symbol_kind::S_CONFIG_XML_EXTERNAL_ENTITY: // "CONFIG_XML_EXTERNAL_ENTITY"
       case symbol_kind::S_CONGIG_DIR_RESPONSE_BODY_MP: // "CONGIG_DIR_RESPONSE_BODY_MP"
@@ -461,6 +506,7 @@ namespace yy {
       case symbol_kind::S_ACTION_CHAIN: // "Chain"
       case symbol_kind::S_ACTION_CTL_AUDIT_ENGINE: // "ACTION_CTL_AUDIT_ENGINE"
       case symbol_kind::S_ACTION_CTL_AUDIT_LOG_PARTS: // "ACTION_CTL_AUDIT_LOG_PARTS"
+      case symbol_kind::S_ACTION_CTL_BDY_GRPC: // "ACTION_CTL_BDY_GRPC"
       case symbol_kind::S_ACTION_CTL_BDY_JSON: // "ACTION_CTL_BDY_JSON"
       case symbol_kind::S_ACTION_CTL_BDY_XML: // "ACTION_CTL_BDY_XML"
       case symbol_kind::S_ACTION_CTL_BDY_URLENCODED: // "ACTION_CTL_BDY_URLENCODED"
@@ -484,6 +530,7 @@ namespace yy {
       case symbol_kind::S_ACTION_MULTI_MATCH: // "MultiMatch"
       case symbol_kind::S_ACTION_NO_AUDIT_LOG: // "NoAuditLog"
       case symbol_kind::S_ACTION_NO_LOG: // "NoLog"
+      case symbol_kind::S_ACTION_NO_VERDICT_CACHE: // "NoVerdictCache"
       case symbol_kind::S_ACTION_PASS: // "Pass"
       case symbol_kind::S_ACTION_PAUSE: // "Pause"
       case symbol_kind::S_ACTION_PHASE: // "Phase"
@@ -548,6 +595,7 @@ namespace yy {
       case symbol_kind::S_CONFIG_SEC_ARGUMENT_SEPARATOR: // "CONFIG_SEC_ARGUMENT_SEPARATOR"
       case symbol_kind::S_CONFIG_SEC_WEB_APP_ID: // "CONFIG_SEC_WEB_APP_ID"
       case symbol_kind::S_CONFIG_SEC_SERVER_SIG: // "CONFIG_SEC_SERVER_SIG"
+      case symbol_kind::S_CONFIG_DIR_AUDIT_COMPRESSION_LEVEL: // "CONFIG_DIR_AUDIT_COMPRESSION_LEVEL"
       case symbol_kind::S_CONFIG_DIR_AUDIT_DIR: // "CONFIG_DIR_AUDIT_DIR"
       case symbol_kind::S_CONFIG_DIR_AUDIT_DIR_MOD: // "CONFIG_DIR_AUDIT_DIR_MOD"
       case symbol_kind::S_CONFIG_DIR_AUDIT_ENG: // "CONFIG_DIR_AUDIT_ENG"
@@ -555,7 +603,9 @@ namespace yy {
       case symbol_kind::S_CONFIG_DIR_AUDIT_LOG: // "CONFIG_DIR_AUDIT_LOG"
       case symbol_kind::S_CONFIG_DIR_AUDIT_LOG2: // "CONFIG_DIR_AUDIT_LOG2"
       case symbol_kind::S_CONFIG_DIR_AUDIT_LOG_P: // "CONFIG_DIR_AUDIT_LOG_P"
+      case symbol_kind::S_CONFIG_DIR_AUDIT_RATE_LIMIT: // "CONFIG_DIR_AUDIT_RATE_LIMIT"
       case symbol_kind::S_CONFIG_DIR_AUDIT_STS: // "CONFIG_DIR_AUDIT_STS"
+      case symbol_kind::S_CONFIG_DIR_AUDIT_TIMINGS: // "CONFIG_DIR_AUDIT_TIMINGS"
       case symbol_kind::S_CONFIG_DIR_AUDIT_TPE: // "CONFIG_DIR_AUDIT_TPE"
       case symbol_kind::S_CONFIG_DIR_DEBUG_LOG: // "CONFIG_DIR_DEBUG_LOG"
       case symbol_kind::S_CONFIG_DIR_DEBUG_LVL: // "CONFIG_DIR_DEBUG_LVL"
@@ -570,13 +620,32 @@ namespace yy {
       case symbol_kind::S_CONFIG_DIR_GEO_DB: // "CONFIG_DIR_GEO_DB"
       case symbol_kind::S_CONFIG_DIR_GSB_DB: // "CONFIG_DIR_GSB_DB"
       case symbol_kind::S_CONFIG_SEC_GUARDIAN_LOG: // "CONFIG_SEC_GUARDIAN_LOG"
+      case symbol_kind::S_CONFIG_DIR_DATA_RELOAD_INTERVAL: // "CONFIG_DIR_DATA_RELOAD_INTERVAL"
+      case symbol_kind::S_CONFIG_DIR_LUA_STATE_POOL_LIMIT: // "CONFIG_DIR_LUA_STATE_POOL_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_OVERLOAD_DETECTION_ONLY: // "CONFIG_DIR_OVERLOAD_DETECTION_ONLY"
+      case symbol_kind::S_CONFIG_DIR_OVERLOAD_SHED_TAG: // "CONFIG_DIR_OVERLOAD_SHED_TAG"
+      case symbol_kind::S_CONFIG_DIR_OVERLOAD_TARGET: // "CONFIG_DIR_OVERLOAD_TARGET"
+      case symbol_kind::S_CONFIG_DIR_PCRE_JIT_STACK_SIZE: // "CONFIG_DIR_PCRE_JIT_STACK_SIZE"
       case symbol_kind::S_CONFIG_DIR_PCRE_MATCH_LIMIT: // "CONFIG_DIR_PCRE_MATCH_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_RBL_TIMEOUT: // "CONFIG_DIR_RBL_TIMEOUT"
+      case symbol_kind::S_CONFIG_DIR_RULE_EARLY_DECISION: // "CONFIG_DIR_RULE_EARLY_DECISION"
+      case symbol_kind::S_CONFIG_DIR_RULE_EVALUATION_THREADS: // "CONFIG_DIR_RULE_EVALUATION_THREADS"
+      case symbol_kind::S_CONFIG_DIR_RULE_ENG_SAMPLE_RATE: // "CONFIG_DIR_RULE_ENG_SAMPLE_RATE"
+      case symbol_kind::S_CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE: // "CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE"
+      case symbol_kind::S_CONFIG_DIR_RX_GUARDRAIL: // "CONFIG_DIR_RX_GUARDRAIL"
+      case symbol_kind::S_CONFIG_DIR_REGEX_CACHE_FILE: // "CONFIG_DIR_REGEX_CACHE_FILE"
+      case symbol_kind::S_CONFIG_DIR_RULE_NATIVE_MODULE: // "CONFIG_DIR_RULE_NATIVE_MODULE"
+      case symbol_kind::S_CONFIG_DIR_SHADOW_RULES: // "CONFIG_DIR_SHADOW_RULES"
       case symbol_kind::S_CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION: // "CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION"
       case symbol_kind::S_CONFIG_SEC_CONN_R_STATE_LIMIT: // "CONFIG_SEC_CONN_R_STATE_LIMIT"
       case symbol_kind::S_CONFIG_SEC_CONN_W_STATE_LIMIT: // "CONFIG_SEC_CONN_W_STATE_LIMIT"
       case symbol_kind::S_CONFIG_SEC_SENSOR_ID: // "CONFIG_SEC_SENSOR_ID"
       case symbol_kind::S_CONFIG_DIR_ARGS_LIMIT: // "CONFIG_DIR_ARGS_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_REQ_BODY_DECOMPRESSION: // "CONFIG_DIR_REQ_BODY_DECOMPRESSION"
+      case symbol_kind::S_CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO: // "CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO"
+      case symbol_kind::S_CONFIG_DIR_RES_BODY_DECOMPRESSION: // "CONFIG_DIR_RES_BODY_DECOMPRESSION"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT: // "CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_REQ_BODY_JSON_SIMD: // "CONFIG_DIR_REQ_BODY_JSON_SIMD"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY: // "CONFIG_DIR_REQ_BODY"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT: // "CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY_LIMIT: // "CONFIG_DIR_REQ_BODY_LIMIT"
@@ -585,17 +654,34 @@ namespace yy {
       case symbol_kind::S_CONFIG_DIR_RES_BODY: // "CONFIG_DIR_RES_BODY"
       case symbol_kind::S_CONFIG_DIR_RES_BODY_LIMIT: // "CONFIG_DIR_RES_BODY_LIMIT"
       case symbol_kind::S_CONFIG_DIR_RES_BODY_LIMIT_ACTION: // "CONFIG_DIR_RES_BODY_LIMIT_ACTION"
+      case symbol_kind::S_CONFIG_DIR_RES_BODY_STREAM_WINDOW: // "CONFIG_DIR_RES_BODY_STREAM_WINDOW"
       case symbol_kind::S_CONFIG_SEC_RULE_INHERITANCE: // "CONFIG_SEC_RULE_INHERITANCE"
       case symbol_kind::S_CONFIG_SEC_RULE_PERF_TIME: // "CONFIG_SEC_RULE_PERF_TIME"
+      case symbol_kind::S_CONFIG_SEC_RULE_PROFILING: // "CONFIG_SEC_RULE_PROFILING"
+      case symbol_kind::S_CONFIG_SEC_RULE_VALUE_MAJOR: // "CONFIG_SEC_RULE_VALUE_MAJOR"
+      case symbol_kind::S_CONFIG_SEC_RX_PREFILTER: // "CONFIG_SEC_RX_PREFILTER"
+      case symbol_kind::S_CONFIG_SEC_RX_RE2: // "CONFIG_SEC_RX_RE2"
       case symbol_kind::S_CONFIG_DIR_RULE_ENG: // "CONFIG_DIR_RULE_ENG"
       case symbol_kind::S_CONFIG_DIR_SEC_ACTION: // "CONFIG_DIR_SEC_ACTION"
       case symbol_kind::S_CONFIG_DIR_SEC_DEFAULT_ACTION: // "CONFIG_DIR_SEC_DEFAULT_ACTION"
       case symbol_kind::S_CONFIG_DIR_SEC_MARKER: // "CONFIG_DIR_SEC_MARKER"
       case symbol_kind::S_CONFIG_DIR_UNICODE_MAP_FILE: // "CONFIG_DIR_UNICODE_MAP_FILE"
       case symbol_kind::S_CONFIG_DIR_UNICODE_CODE_PAGE: // "CONFIG_DIR_UNICODE_CODE_PAGE"
+      case symbol_kind::S_CONFIG_SEC_COLLECTION_GROUP_COMMIT: // "CONFIG_SEC_COLLECTION_GROUP_COMMIT"
+      case symbol_kind::S_CONFIG_SEC_COLLECTION_REDIS_SERVER: // "CONFIG_SEC_COLLECTION_REDIS_SERVER"
+      case symbol_kind::S_CONFIG_SEC_COLLECTION_SYNC_MODE: // "CONFIG_SEC_COLLECTION_SYNC_MODE"
       case symbol_kind::S_CONFIG_SEC_COLLECTION_TIMEOUT: // "CONFIG_SEC_COLLECTION_TIMEOUT"
+      case symbol_kind::S_CONFIG_SEC_TRANSACTION_ID_FORMAT: // "CONFIG_SEC_TRANSACTION_ID_FORMAT"
+      case symbol_kind::S_CONFIG_SEC_TRANSACTION_MEMORY_LIMIT: // "CONFIG_SEC_TRANSACTION_MEMORY_LIMIT"
+      case symbol_kind::S_CONFIG_SEC_TRANSACTION_TIME_BUDGET: // "CONFIG_SEC_TRANSACTION_TIME_BUDGET"
+      case symbol_kind::S_CONFIG_SEC_VERDICT_CACHE: // "CONFIG_SEC_VERDICT_CACHE"
+      case symbol_kind::S_CONFIG_SEC_DEBUG_LOG_BUFFER: // "CONFIG_SEC_DEBUG_LOG_BUFFER"
+      case symbol_kind::S_CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH: // "CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH"
+      case symbol_kind::S_CONFIG_SEC_DEBUG_LOG_FILTER: // "CONFIG_SEC_DEBUG_LOG_FILTER"
       case symbol_kind::S_CONFIG_SEC_HTTP_BLKEY: // "CONFIG_SEC_HTTP_BLKEY"
+      case symbol_kind::S_CONFIG_SEC_HUGE_PAGES: // "CONFIG_SEC_HUGE_PAGES"
       case symbol_kind::S_CONFIG_SEC_INTERCEPT_ON_ERROR: // "CONFIG_SEC_INTERCEPT_ON_ERROR"
+      case symbol_kind::S_CONFIG_SEC_REMOTE_RULES_CACHE_DIR: // "CONFIG_SEC_REMOTE_RULES_CACHE_DIR"
       case symbol_kind::S_CONFIG_SEC_REMOTE_RULES_FAIL_ACTION: // "CONFIG_SEC_REMOTE_RULES_FAIL_ACTION"
       case symbol_kind::S_CONFIG_SEC_RULE_REMOVE_BY_ID: // "CONFIG_SEC_RULE_REMOVE_BY_ID"
       case symbol_kind::S_CONFIG_SEC_RULE_REMOVE_BY_MSG: // "CONFIG_SEC_RULE_REMOVE_BY_MSG"
@@ -606,9 +692,11 @@ namespace yy {
       case symbol_kind::S_CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID: // "CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID"
       case symbol_kind::S_CONFIG_UPDLOAD_KEEP_FILES: // "CONFIG_UPDLOAD_KEEP_FILES"
       case symbol_kind::S_CONFIG_UPDLOAD_SAVE_TMP_FILES: // "CONFIG_UPDLOAD_SAVE_TMP_FILES"
+      case symbol_kind::S_CONFIG_UPLOAD_ANONYMOUS_FILES: // "CONFIG_UPLOAD_ANONYMOUS_FILES"
       case symbol_kind::S_CONFIG_UPLOAD_DIR: // "CONFIG_UPLOAD_DIR"
       case symbol_kind::S_CONFIG_UPLOAD_FILE_LIMIT: // "CONFIG_UPLOAD_FILE_LIMIT"
       case symbol_kind::S_CONFIG_UPLOAD_FILE_MODE: // "CONFIG_UPLOAD_FILE_MODE"
+      case symbol_kind::S_CONFIG_UPLOAD_IN_MEMORY_LIMIT: // "CONFIG_UPLOAD_IN_MEMORY_LIMIT"
       case symbol_kind::S_CONFIG_VALUE_ABORT: // "CONFIG_VALUE_ABORT"
       case symbol_kind::S_CONFIG_VALUE_DETC: // "CONFIG_VALUE_DETC"
       case symbol_kind::S_CONFIG_VALUE_HTTPS: // "CONFIG_VALUE_HTTPS"
@@ -618,7 +706,9 @@ namespace yy {
       case symbol_kind::S_CONFIG_VALUE_PROCESS_PARTIAL: // "CONFIG_VALUE_PROCESS_PARTIAL"
       case symbol_kind::S_CONFIG_VALUE_REJECT: // "CONFIG_VALUE_REJECT"
       case symbol_kind::S_CONFIG_VALUE_RELEVANT_ONLY: // "CONFIG_VALUE_RELEVANT_ONLY"
+      case symbol_kind::S_CONFIG_VALUE_RING: // "CONFIG_VALUE_RING"
       case symbol_kind::S_CONFIG_VALUE_SERIAL: // "CONFIG_VALUE_SERIAL"
+      case symbol_kind::S_CONFIG_VALUE_STREAM: // "CONFIG_VALUE_STREAM"
       case symbol_kind::S_CONFIG_VALUE_WARN: // "CONFIG_VALUE_WARN"
       case symbol_kind::S_CONFIG_XML_EXTERNAL_ENTITY: // "CONFIG_XML_EXTERNAL_ENTITY"
       case symbol_kind::S_CONGIG_DIR_RESPONSE_BODY_MP: // "CONGIG_DIR_RESPONSE_BODY_MP"
@@ -707,6 +797,7 @@ namespace yy {
       case symbol_kind::S_ACTION_CHAIN: // "Chain"
       case symbol_kind::S_ACTION_CTL_AUDIT_ENGINE: // "ACTION_CTL_AUDIT_ENGINE"
       case symbol_kind::S_ACTION_CTL_AUDIT_LOG_PARTS: // "ACTION_CTL_AUDIT_LOG_PARTS"
+      case symbol_kind::S_ACTION_CTL_BDY_GRPC: // "ACTION_CTL_BDY_GRPC"
       case symbol_kind::S_ACTION_CTL_BDY_JSON: // "ACTION_CTL_BDY_JSON"
       case symbol_kind::S_ACTION_CTL_BDY_XML: // "ACTION_CTL_BDY_XML"
       case symbol_kind::S_ACTION_CTL_BDY_URLENCODED: // "ACTION_CTL_BDY_URLENCODED"
@@ -730,6 +821,7 @@ namespace yy {
       case symbol_kind::S_ACTION_MULTI_MATCH: // "MultiMatch"
       case symbol_kind::S_ACTION_NO_AUDIT_LOG: // "NoAuditLog"
       case symbol_kind::S_ACTION_NO_LOG: // "NoLog"
+      case symbol_kind::S_ACTION_NO_VERDICT_CACHE: // "NoVerdictCache"
       case symbol_kind::S_ACTION_PASS: // "Pass"
       case symbol_kind::S_ACTION_PAUSE: // "Pause"
       case symbol_kind::S_ACTION_PHASE: // "Phase"
@@ -794,6 +886,7 @@ namespace yy {
       case symbol_kind::S_CONFIG_SEC_ARGUMENT_SEPARATOR: // "CONFIG_SEC_ARGUMENT_SEPARATOR"
       case symbol_kind::S_CONFIG_SEC_WEB_APP_ID: // "CONFIG_SEC_WEB_APP_ID"
       case symbol_kind::S_CONFIG_SEC_SERVER_SIG: // "CONFIG_SEC_SERVER_SIG"
+      case symbol_kind::S_CONFIG_DIR_AUDIT_COMPRESSION_LEVEL: // "CONFIG_DIR_AUDIT_COMPRESSION_LEVEL"
       case symbol_kind::S_CONFIG_DIR_AUDIT_DIR: // "CONFIG_DIR_AUDIT_DIR"
       case symbol_kind::S_CONFIG_DIR_AUDIT_DIR_MOD: // "CONFIG_DIR_AUDIT_DIR_MOD"
       case symbol_kind::S_CONFIG_DIR_AUDIT_ENG: // "CONFIG_DIR_AUDIT_ENG"
@@ -801,7 +894,9 @@ namespace yy {
       case symbol_kind::S_CONFIG_DIR_AUDIT_LOG: // "CONFIG_DIR_AUDIT_LOG"
       case symbol_kind::S_CONFIG_DIR_AUDIT_LOG2: // "CONFIG_DIR_AUDIT_LOG2"
       case symbol_kind::S_CONFIG_DIR_AUDIT_LOG_P: // "CONFIG_DIR_AUDIT_LOG_P"
+      case symbol_kind::S_CONFIG_DIR_AUDIT_RATE_LIMIT: // "CONFIG_DIR_AUDIT_RATE_LIMIT"
       case symbol_kind::S_CONFIG_DIR_AUDIT_STS: // "CONFIG_DIR_AUDIT_STS"
+      case symbol_kind::S_CONFIG_DIR_AUDIT_TIMINGS: // "CONFIG_DIR_AUDIT_TIMINGS"
       case symbol_kind::S_CONFIG_DIR_AUDIT_TPE: // "CONFIG_DIR_AUDIT_TPE"
       case symbol_kind::S_CONFIG_DIR_DEBUG_LOG: // "CONFIG_DIR_DEBUG_LOG"
       case symbol_kind::S_CONFIG_DIR_DEBUG_LVL: // "CONFIG_DIR_DEBUG_LVL"
@@ -816,13 +911,32 @@ namespace yy {
       case symbol_kind::S_CONFIG_DIR_GEO_DB: // "CONFIG_DIR_GEO_DB"
       case symbol_kind::S_CONFIG_DIR_GSB_DB: // "CONFIG_DIR_GSB_DB"
       case symbol_kind::S_CONFIG_SEC_GUARDIAN_LOG: // "CONFIG_SEC_GUARDIAN_LOG"
+      case symbol_kind::S_CONFIG_DIR_DATA_RELOAD_INTERVAL: // "CONFIG_DIR_DATA_RELOAD_INTERVAL"
+      case symbol_kind::S_CONFIG_DIR_LUA_STATE_POOL_LIMIT: // "CONFIG_DIR_LUA_STATE_POOL_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_OVERLOAD_DETECTION_ONLY: // "CONFIG_DIR_OVERLOAD_DETECTION_ONLY"
+      case symbol_kind::S_CONFIG_DIR_OVERLOAD_SHED_TAG: // "CONFIG_DIR_OVERLOAD_SHED_TAG"
+      case symbol_kind::S_CONFIG_DIR_OVERLOAD_TARGET: // "CONFIG_DIR_OVERLOAD_TARGET"
+      case symbol_kind::S_CONFIG_DIR_PCRE_JIT_STACK_SIZE: // "CONFIG_DIR_PCRE_JIT_STACK_SIZE"
       case symbol_kind::S_CONFIG_DIR_PCRE_MATCH_LIMIT: // "CONFIG_DIR_PCRE_MATCH_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_RBL_TIMEOUT: // "CONFIG_DIR_RBL_TIMEOUT"
+      case symbol_kind::S_CONFIG_DIR_RULE_EARLY_DECISION: // "CONFIG_DIR_RULE_EARLY_DECISION"
+      case symbol_kind::S_CONFIG_DIR_RULE_EVALUATION_THREADS: // "CONFIG_DIR_RULE_EVALUATION_THREADS"
+      case symbol_kind::S_CONFIG_DIR_RULE_ENG_SAMPLE_RATE: // "CONFIG_DIR_RULE_ENG_SAMPLE_RATE"
+      case symbol_kind::S_CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE: // "CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE"
+      case symbol_kind::S_CONFIG_DIR_RX_GUARDRAIL: // "CONFIG_DIR_RX_GUARDRAIL"
+      case symbol_kind::S_CONFIG_DIR_REGEX_CACHE_FILE: // "CONFIG_DIR_REGEX_CACHE_FILE"
+      case symbol_kind::S_CONFIG_DIR_RULE_NATIVE_MODULE: // "CONFIG_DIR_RULE_NATIVE_MODULE"
+      case symbol_kind::S_CONFIG_DIR_SHADOW_RULES: // "CONFIG_DIR_SHADOW_RULES"
       case symbol_kind::S_CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION: // "CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION"
       case symbol_kind::S_CONFIG_SEC_CONN_R_STATE_LIMIT: // "CONFIG_SEC_CONN_R_STATE_LIMIT"
       case symbol_kind::S_CONFIG_SEC_CONN_W_STATE_LIMIT: // "CONFIG_SEC_CONN_W_STATE_LIMIT"
       case symbol_kind::S_CONFIG_SEC_SENSOR_ID: // "CONFIG_SEC_SENSOR_ID"
       case symbol_kind::S_CONFIG_DIR_ARGS_LIMIT: // "CONFIG_DIR_ARGS_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_REQ_BODY_DECOMPRESSION: // "CONFIG_DIR_REQ_BODY_DECOMPRESSION"
+      case symbol_kind::S_CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO: // "CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO"
+      case symbol_kind::S_CONFIG_DIR_RES_BODY_DECOMPRESSION: // "CONFIG_DIR_RES_BODY_DECOMPRESSION"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT: // "CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_REQ_BODY_JSON_SIMD: // "CONFIG_DIR_REQ_BODY_JSON_SIMD"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY: // "CONFIG_DIR_REQ_BODY"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT: // "CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY_LIMIT: // "CONFIG_DIR_REQ_BODY_LIMIT"
@@ -831,17 +945,34 @@ namespace yy {
       case symbol_kind::S_CONFIG_DIR_RES_BODY: // "CONFIG_DIR_RES_BODY"
       case symbol_kind::S_CONFIG_DIR_RES_BODY_LIMIT: // "CONFIG_DIR_RES_BODY_LIMIT"
       case symbol_kind::S_CONFIG_DIR_RES_BODY_LIMIT_ACTION: // "CONFIG_DIR_RES_BODY_LIMIT_ACTION"
+      case symbol_kind::S_CONFIG_DIR_RES_BODY_STREAM_WINDOW: // "CONFIG_DIR_RES_BODY_STREAM_WINDOW"
       case symbol_kind::S_CONFIG_SEC_RULE_INHERITANCE: // "CONFIG_SEC_RULE_INHERITANCE"
       case symbol_kind::S_CONFIG_SEC_RULE_PERF_TIME: // "CONFIG_SEC_RULE_PERF_TIME"
+      case symbol_kind::S_CONFIG_SEC_RULE_PROFILING: // "CONFIG_SEC_RULE_PROFILING"
+      case symbol_kind::S_CONFIG_SEC_RULE_VALUE_MAJOR: // "CONFIG_SEC_RULE_VALUE_MAJOR"
+      case symbol_kind::S_CONFIG_SEC_RX_PREFILTER: // "CONFIG_SEC_RX_PREFILTER"
+      case symbol_kind::S_CONFIG_SEC_RX_RE2: // "CONFIG_SEC_RX_RE2"
       case symbol_kind::S_CONFIG_DIR_RULE_ENG: // "CONFIG_DIR_RULE_ENG"
       case symbol_kind::S_CONFIG_DIR_SEC_ACTION: // "CONFIG_DIR_SEC_ACTION"
       case symbol_kind::S_CONFIG_DIR_SEC_DEFAULT_ACTION: // "CONFIG_DIR_SEC_DEFAULT_ACTION"
       case symbol_kind::S_CONFIG_DIR_SEC_MARKER: // "CONFIG_DIR_SEC_MARKER"
       case symbol_kind::S_CONFIG_DIR_UNICODE_MAP_FILE: // "CONFIG_DIR_UNICODE_MAP_FILE"
       case symbol_kind::S_CONFIG_DIR_UNICODE_CODE_PAGE: // "CONFIG_DIR_UNICODE_CODE_PAGE"
+      case symbol_kind::S_CONFIG_SEC_COLLECTION_GROUP_COMMIT: // "CONFIG_SEC_COLLECTION_GROUP_COMMIT"
+      case symbol_kind::S_CONFIG_SEC_COLLECTION_REDIS_SERVER: // "CONFIG_SEC_COLLECTION_REDIS_SERVER"
+      case symbol_kind::S_CONFIG_SEC_COLLECTION_SYNC_MODE: // "CONFIG_SEC_COLLECTION_SYNC_MODE"
       case symbol_kind::S_CONFIG_SEC_COLLECTION_TIMEOUT: // "CONFIG_SEC_COLLECTION_TIMEOUT"
+      case symbol_kind::S_CONFIG_SEC_TRANSACTION_ID_FORMAT: // "CONFIG_SEC_TRANSACTION_ID_FORMAT"
+      case symbol_kind::S_CONFIG_SEC_TRANSACTION_MEMORY_LIMIT: // "CONFIG_SEC_TRANSACTION_MEMORY_LIMIT"
+      case symbol_kind::S_CONFIG_SEC_TRANSACTION_TIME_BUDGET: // "CONFIG_SEC_TRANSACTION_TIME_BUDGET"
+      case symbol_kind::S_CONFIG_SEC_VERDICT_CACHE: // "CONFIG_SEC_VERDICT_CACHE"
+      case symbol_kind::S_CONFIG_SEC_DEBUG_LOG_BUFFER: // "CONFIG_SEC_DEBUG_LOG_BUFFER"
+      case symbol_kind::S_CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH: // "CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH"
+      case symbol_kind::S_CONFIG_SEC_DEBUG_LOG_FILTER: // "CONFIG_SEC_DEBUG_LOG_FILTER"
       case symbol_kind::S_CONFIG_SEC_HTTP_BLKEY: // "CONFIG_SEC_HTTP_BLKEY"
+      case symbol_kind::S_CONFIG_SEC_HUGE_PAGES: // "CONFIG_SEC_HUGE_PAGES"
       case symbol_kind::S_CONFIG_SEC_INTERCEPT_ON_ERROR: // "CONFIG_SEC_INTERCEPT_ON_ERROR"
+      case symbol_kind::S_CONFIG_SEC_REMOTE_RULES_CACHE_DIR: // "CONFIG_SEC_REMOTE_RULES_CACHE_DIR"
       case symbol_kind::S_CONFIG_SEC_REMOTE_RULES_FAIL_ACTION: // "CONFIG_SEC_REMOTE_RULES_FAIL_ACTION"
       case symbol_kind::S_CONFIG_SEC_RULE_REMOVE_BY_ID: // "CONFIG_SEC_RULE_REMOVE_BY_ID"
       case symbol_kind::S_CONFIG_SEC_RULE_REMOVE_BY_MSG: // "CONFIG_SEC_RULE_REMOVE_BY_MSG"
@@ -852,9 +983,11 @@ namespace yy {
       case symbol_kind::S_CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID: // "CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID"
       case symbol_kind::S_CONFIG_UPDLOAD_KEEP_FILES: // "CONFIG_UPDLOAD_KEEP_FILES"
       case symbol_kind::S_CONFIG_UPDLOAD_SAVE_TMP_FILES: // "CONFIG_UPDLOAD_SAVE_TMP_FILES"
+      case symbol_kind::S_CONFIG_UPLOAD_ANONYMOUS_FILES: // "CONFIG_UPLOAD_ANONYMOUS_FILES"
       case symbol_kind::S_CONFIG_UPLOAD_DIR: // "CONFIG_UPLOAD_DIR"
       case symbol_kind::S_CONFIG_UPLOAD_FILE_LIMIT: // "CONFIG_UPLOAD_FILE_LIMIT"
       case symbol_kind::S_CONFIG_UPLOAD_FILE_MODE: // "CONFIG_UPLOAD_FILE_MODE"
+      case symbol_kind::S_CONFIG_UPLOAD_IN_MEMORY_LIMIT: // "CONFIG_UPLOAD_IN_MEMORY_LIMIT"
       case symbol_kind::S_CONFIG_VALUE_ABORT: // "CONFIG_VALUE_ABORT"
       case symbol_kind::S_CONFIG_VALUE_DETC: // "CONFIG_VALUE_DETC"
       case symbol_kind::S_CONFIG_VALUE_HTTPS: // "CONFIG_VALUE_HTTPS"
@@ -864,7 +997,9 @@ namespace yy {
       case symbol_kind::S_CONFIG_VALUE_PROCESS_PARTIAL: // "CONFIG_VALUE_PROCESS_PARTIAL"
       case symbol_kind::S_CONFIG_VALUE_REJECT: // "CONFIG_VALUE_REJECT"
       case symbol_kind::S_CONFIG_VALUE_RELEVANT_ONLY: // "CONFIG_VALUE_RELEVANT_ONLY"
+      case symbol_kind::S_CONFIG_VALUE_RING: // "CONFIG_VALUE_RING"
       case symbol_kind::S_CONFIG_VALUE_SERIAL: // "CONFIG_VALUE_SERIAL"
+      case symbol_kind::S_CONFIG_VALUE_STREAM: // "CONFIG_VALUE_STREAM"
       case symbol_kind::S_CONFIG_VALUE_WARN: // "CONFIG_VALUE_WARN"
       case symbol_kind::S_CONFIG_XML_EXTERNAL_ENTITY: // "CONFIG_XML_EXTERNAL_ENTITY"
       case symbol_kind::S_CONGIG_DIR_RESPONSE_BODY_MP: // "CONGIG_DIR_RESPONSE_BODY_MP"
@@ -952,6 +1087,7 @@ namespace yy {
       case symbol_kind::S_ACTION_CHAIN: // "Chain"
       case symbol_kind::S_ACTION_CTL_AUDIT_ENGINE: // "ACTION_CTL_AUDIT_ENGINE"
       case symbol_kind::S_ACTION_CTL_AUDIT_LOG_PARTS: // "ACTION_CTL_AUDIT_LOG_PARTS"
+      case symbol_kind::S_ACTION_CTL_BDY_GRPC: // "ACTION_CTL_BDY_GRPC"
       case symbol_kind::S_ACTION_CTL_BDY_JSON: // "ACTION_CTL_BDY_JSON"
       case symbol_kind::S_ACTION_CTL_BDY_XML: // "ACTION_CTL_BDY_XML"
       case symbol_kind::S_ACTION_CTL_BDY_URLENCODED: // "ACTION_CTL_BDY_URLENCODED"
@@ -975,6 +1111,7 @@ namespace yy {
       case symbol_kind::S_ACTION_MULTI_MATCH: // "MultiMatch"
       case symbol_kind::S_ACTION_NO_AUDIT_LOG: // "NoAuditLog"
       case symbol_kind::S_ACTION_NO_LOG: // "NoLog"
+      case symbol_kind::S_ACTION_NO_VERDICT_CACHE: // "NoVerdictCache"
       case symbol_kind::S_ACTION_PASS: // "Pass"
       case symbol_kind::S_ACTION_PAUSE: // "Pause"
       case symbol_kind::S_ACTION_PHASE: // "Phase"
@@ -1039,6 +1176,7 @@ namespace yy {
       case symbol_kind::S_CONFIG_SEC_ARGUMENT_SEPARATOR: // "CONFIG_SEC_ARGUMENT_SEPARATOR"
       case symbol_kind::S_CONFIG_SEC_WEB_APP_ID: // "CONFIG_SEC_WEB_APP_ID"
       case symbol_kind::S_CONFIG_SEC_SERVER_SIG: // "CONFIG_SEC_SERVER_SIG"
+      case symbol_kind::S_CONFIG_DIR_AUDIT_COMPRESSION_LEVEL: // "CONFIG_DIR_AUDIT_COMPRESSION_LEVEL"
       case symbol_kind::S_CONFIG_DIR_AUDIT_DIR: // "CONFIG_DIR_AUDIT_DIR"
       case symbol_kind::S_CONFIG_DIR_AUDIT_DIR_MOD: // "CONFIG_DIR_AUDIT_DIR_MOD"
       case symbol_kind::S_CONFIG_DIR_AUDIT_ENG: // "CONFIG_DIR_AUDIT_ENG"
@@ -1046,7 +1184,9 @@ namespace yy {
       case symbol_kind::S_CONFIG_DIR_AUDIT_LOG: // "CONFIG_DIR_AUDIT_LOG"
       case symbol_kind::S_CONFIG_DIR_AUDIT_LOG2: // "CONFIG_DIR_AUDIT_LOG2"
       case symbol_kind::S_CONFIG_DIR_AUDIT_LOG_P: // "CONFIG_DIR_AUDIT_LOG_P"
+      case symbol_kind::S_CONFIG_DIR_AUDIT_RATE_LIMIT: // "CONFIG_DIR_AUDIT_RATE_LIMIT"
       case symbol_kind::S_CONFIG_DIR_AUDIT_STS: // "CONFIG_DIR_AUDIT_STS"
+      case symbol_kind::S_CONFIG_DIR_AUDIT_TIMINGS: // "CONFIG_DIR_AUDIT_TIMINGS"
       case symbol_kind::S_CONFIG_DIR_AUDIT_TPE: // "CONFIG_DIR_AUDIT_TPE"
       case symbol_kind::S_CONFIG_DIR_DEBUG_LOG: // "CONFIG_DIR_DEBUG_LOG"
       case symbol_kind::S_CONFIG_DIR_DEBUG_LVL: // "CONFIG_DIR_DEBUG_LVL"
@@ -1061,13 +1201,32 @@ namespace yy {
       case symbol_kind::S_CONFIG_DIR_GEO_DB: // "CONFIG_DIR_GEO_DB"
       case symbol_kind::S_CONFIG_DIR_GSB_DB: // "CONFIG_DIR_GSB_DB"
       case symbol_kind::S_CONFIG_SEC_GUARDIAN_LOG: // "CONFIG_SEC_GUARDIAN_LOG"
+      case symbol_kind::S_CONFIG_DIR_DATA_RELOAD_INTERVAL: // "CONFIG_DIR_DATA_RELOAD_INTERVAL"
+      case symbol_kind::S_CONFIG_DIR_LUA_STATE_POOL_LIMIT: // "CONFIG_DIR_LUA_STATE_POOL_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_OVERLOAD_DETECTION_ONLY: // "CONFIG_DIR_OVERLOAD_DETECTION_ONLY"
+      case symbol_kind::S_CONFIG_DIR_OVERLOAD_SHED_TAG: // "CONFIG_DIR_OVERLOAD_SHED_TAG"
+      case symbol_kind::S_CONFIG_DIR_OVERLOAD_TARGET: // "CONFIG_DIR_OVERLOAD_TARGET"
+      case symbol_kind::S_CONFIG_DIR_PCRE_JIT_STACK_SIZE: // "CONFIG_DIR_PCRE_JIT_STACK_SIZE"
       case symbol_kind::S_CONFIG_DIR_PCRE_MATCH_LIMIT: // "CONFIG_DIR_PCRE_MATCH_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_RBL_TIMEOUT: // "CONFIG_DIR_RBL_TIMEOUT"
+      case symbol_kind::S_CONFIG_DIR_RULE_EARLY_DECISION: // "CONFIG_DIR_RULE_EARLY_DECISION"
+      case symbol_kind::S_CONFIG_DIR_RULE_EVALUATION_THREADS: // "CONFIG_DIR_RULE_EVALUATION_THREADS"
+      case symbol_kind::S_CONFIG_DIR_RULE_ENG_SAMPLE_RATE: // "CONFIG_DIR_RULE_ENG_SAMPLE_RATE"
+      case symbol_kind::S_CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE: // "CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE"
+      case symbol_kind::S_CONFIG_DIR_RX_GUARDRAIL: // "CONFIG_DIR_RX_GUARDRAIL"
+      case symbol_kind::S_CONFIG_DIR_REGEX_CACHE_FILE: // "CONFIG_DIR_REGEX_CACHE_FILE"
+      case symbol_kind::S_CONFIG_DIR_RULE_NATIVE_MODULE: // "CONFIG_DIR_RULE_NATIVE_MODULE"
+      case symbol_kind::S_CONFIG_DIR_SHADOW_RULES: // "CONFIG_DIR_SHADOW_RULES"
       case symbol_kind::S_CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION: // "CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION"
       case symbol_kind::S_CONFIG_SEC_CONN_R_STATE_LIMIT: // "CONFIG_SEC_CONN_R_STATE_LIMIT"
       case symbol_kind::S_CONFIG_SEC_CONN_W_STATE_LIMIT: // "CONFIG_SEC_CONN_W_STATE_LIMIT"
       case symbol_kind::S_CONFIG_SEC_SENSOR_ID: // "CONFIG_SEC_SENSOR_ID"
       case symbol_kind::S_CONFIG_DIR_ARGS_LIMIT: // "CONFIG_DIR_ARGS_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_REQ_BODY_DECOMPRESSION: // "CONFIG_DIR_REQ_BODY_DECOMPRESSION"
+      case symbol_kind::S_CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO: // "CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO"
+      case symbol_kind::S_CONFIG_DIR_RES_BODY_DECOMPRESSION: // "CONFIG_DIR_RES_BODY_DECOMPRESSION"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT: // "CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_REQ_BODY_JSON_SIMD: // "CONFIG_DIR_REQ_BODY_JSON_SIMD"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY: // "CONFIG_DIR_REQ_BODY"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT: // "CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY_LIMIT: // "CONFIG_DIR_REQ_BODY_LIMIT"
@@ -1076,17 +1235,34 @@ namespace yy {
       case symbol_kind::S_CONFIG_DIR_RES_BODY: // "CONFIG_DIR_RES_BODY"
       case symbol_kind::S_CONFIG_DIR_RES_BODY_LIMIT: // "CONFIG_DIR_RES_BODY_LIMIT"
       case symbol_kind::S_CONFIG_DIR_RES_BODY_LIMIT_ACTION: // "CONFIG_DIR_RES_BODY_LIMIT_ACTION"
+      case symbol_kind::S_CONFIG_DIR_RES_BODY_STREAM_WINDOW: // "CONFIG_DIR_RES_BODY_STREAM_WINDOW"
       case symbol_kind::S_CONFIG_SEC_RULE_INHERITANCE: // "CONFIG_SEC_RULE_INHERITANCE"
       case symbol_kind::S_CONFIG_SEC_RULE_PERF_TIME: // "CONFIG_SEC_RULE_PERF_TIME"
+      case symbol_kind::S_CONFIG_SEC_RULE_PROFILING: // "CONFIG_SEC_RULE_PROFILING"
+      case symbol_kind::S_CONFIG_SEC_RULE_VALUE_MAJOR: // "CONFIG_SEC_RULE_VALUE_MAJOR"
+      case symbol_kind::S_CONFIG_SEC_RX_PREFILTER: // "CONFIG_SEC_RX_PREFILTER"
+      case symbol_kind::S_CONFIG_SEC_RX_RE2: // "CONFIG_SEC_RX_RE2"
       case symbol_kind::S_CONFIG_DIR_RULE_ENG: // "CONFIG_DIR_RULE_ENG"
       case symbol_kind::S_CONFIG_DIR_SEC_ACTION: // "CONFIG_DIR_SEC_ACTION"
       case symbol_kind::S_CONFIG_DIR_SEC_DEFAULT_ACTION: // "CONFIG_DIR_SEC_DEFAULT_ACTION"
       case symbol_kind::S_CONFIG_DIR_SEC_MARKER: // "CONFIG_DIR_SEC_MARKER"
       case symbol_kind::S_CONFIG_DIR_UNICODE_MAP_FILE: // "CONFIG_DIR_UNICODE_MAP_FILE"
       case symbol_kind::S_CONFIG_DIR_UNICODE_CODE_PAGE: // "CONFIG_DIR_UNICODE_CODE_PAGE"
+      case symbol_kind::S_CONFIG_SEC_COLLECTION_GROUP_COMMIT: // "CONFIG_SEC_COLLECTION_GROUP_COMMIT"
+      case symbol_kind::S_CONFIG_SEC_COLLECTION_REDIS_SERVER: // "CONFIG_SEC_COLLECTION_REDIS_SERVER"
+      case symbol_kind::S_CONFIG_SEC_COLLECTION_SYNC_MODE: // "CONFIG_SEC_COLLECTION_SYNC_MODE"
       case symbol_kind::S_CONFIG_SEC_COLLECTION_TIMEOUT: // "CONFIG_SEC_COLLECTION_TIMEOUT"
+      case symbol_kind::S_CONFIG_SEC_TRANSACTION_ID_FORMAT: // "CONFIG_SEC_TRANSACTION_ID_FORMAT"
+      case symbol_kind::S_CONFIG_SEC_TRANSACTION_MEMORY_LIMIT: // "CONFIG_SEC_TRANSACTION_MEMORY_LIMIT"
+      case symbol_kind::S_CONFIG_SEC_TRANSACTION_TIME_BUDGET: // "CONFIG_SEC_TRANSACTION_TIME_BUDGET"
+      case symbol_kind::S_CONFIG_SEC_VERDICT_CACHE: // "CONFIG_SEC_VERDICT_CACHE"
+      case symbol_kind::S_CONFIG_SEC_DEBUG_LOG_BUFFER: // "CONFIG_SEC_DEBUG_LOG_BUFFER"
+      case symbol_kind::S_CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH: // "CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH"
+      case symbol_kind::S_CONFIG_SEC_DEBUG_LOG_FILTER: // "CONFIG_SEC_DEBUG_LOG_FILTER"
       case symbol_kind::S_CONFIG_SEC_HTTP_BLKEY: // "CONFIG_SEC_HTTP_BLKEY"
+      case symbol_kind::S_CONFIG_SEC_HUGE_PAGES: // "CONFIG_SEC_HUGE_PAGES"
       case symbol_kind::S_CONFIG_SEC_INTERCEPT_ON_ERROR: // "CONFIG_SEC_INTERCEPT_ON_ERROR"
+      case symbol_kind::S_CONFIG_SEC_REMOTE_RULES_CACHE_DIR: // "CONFIG_SEC_REMOTE_RULES_CACHE_DIR"
       case symbol_kind::S_CONFIG_SEC_REMOTE_RULES_FAIL_ACTION: // "CONFIG_SEC_REMOTE_RULES_FAIL_ACTION"
       case symbol_kind::S_CONFIG_SEC_RULE_REMOVE_BY_ID: // "CONFIG_SEC_RULE_REMOVE_BY_ID"
       case symbol_kind::S_CONFIG_SEC_RULE_REMOVE_BY_MSG: // "CONFIG_SEC_RULE_REMOVE_BY_MSG"
@@ -1097,9 +1273,11 @@ namespace yy {
       case symbol_kind::S_CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID: // "CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID"
       case symbol_kind::S_CONFIG_UPDLOAD_KEEP_FILES: // "CONFIG_UPDLOAD_KEEP_FILES"
       case symbol_kind::S_CONFIG_UPDLOAD_SAVE_TMP_FILES: // "CONFIG_UPDLOAD_SAVE_TMP_FILES"
+      case symbol_kind::S_CONFIG_UPLOAD_ANONYMOUS_FILES: // "CONFIG_UPLOAD_ANONYMOUS_FILES"
       case symbol_kind::S_CONFIG_UPLOAD_DIR: // "CONFIG_UPLOAD_DIR"
       case symbol_kind::S_CONFIG_UPLOAD_FILE_LIMIT: // "CONFIG_UPLOAD_FILE_LIMIT"
       case symbol_kind::S_CONFIG_UPLOAD_FILE_MODE: // "CONFIG_UPLOAD_FILE_MODE"
+      case symbol_kind::S_CONFIG_UPLOAD_IN_MEMORY_LIMIT: // "CONFIG_UPLOAD_IN_MEMORY_LIMIT"
       case symbol_kind::S_CONFIG_VALUE_ABORT: // "CONFIG_VALUE_ABORT"
       case symbol_kind::S_CONFIG_VALUE_DETC: // "CONFIG_VALUE_DETC"
       case symbol_kind::S_CONFIG_VALUE_HTTPS: // "CONFIG_VALUE_HTTPS"
@@ -1109,7 +1287,9 @@ namespace yy {
       case symbol_kind::S_CONFIG_VALUE_PROCESS_PARTIAL: // "CONFIG_VALUE_PROCESS_PARTIAL"
       case symbol_kind::S_CONFIG_VALUE_REJECT: // "CONFIG_VALUE_REJECT"
       case symbol_kind::S_CONFIG_VALUE_RELEVANT_ONLY: // "CONFIG_VALUE_RELEVANT_ONLY"
+      case symbol_kind::S_CONFIG_VALUE_RING: // "CONFIG_VALUE_RING"
       case symbol_kind::S_CONFIG_VALUE_SERIAL: // "CONFIG_VALUE_SERIAL"
+      case symbol_kind::S_CONFIG_VALUE_STREAM: // "CONFIG_VALUE_STREAM"
       case symbol_kind::S_CONFIG_VALUE_WARN: // "CONFIG_VALUE_WARN"
       case symbol_kind::S_CONFIG_XML_EXTERNAL_ENTITY: // "CONFIG_XML_EXTERNAL_ENTITY"
       case symbol_kind::S_CONGIG_DIR_RESPONSE_BODY_MP: // "CONGIG_DIR_RESPONSE_BODY_MP"
@@ -1322,14 +1502,14 @@ namespace yy {
 
 
     // User initialization code.
-#line 322 "seclang-parser.yy"
+#line 345 "seclang-parser.yy"
 {
   // Initialize the initial location.
   driver.m_filenames.push_back(driver.file);
   yyla.location.begin.filename = yyla.location.end.filename = &(driver.m_filenames.back());
 }
 
-#line 1333 "seclang-parser.cc"
+#line 1513 "seclang-parser.cc"
 
 
     /* Initialize the stack.  The initial state will be set in
@@ -1453,6 +1633,7 @@ namespace yy {
       case symbol_kind::S_ACTION_CHAIN: // "Chain"
       case symbol_kind::S_ACTION_CTL_AUDIT_ENGINE: // "ACTION_CTL_AUDIT_ENGINE"
       case symbol_kind::S_ACTION_CTL_AUDIT_LOG_PARTS: // "ACTION_CTL_AUDIT_LOG_PARTS"
+      case symbol_kind::S_ACTION_CTL_BDY_GRPC: // "ACTION_CTL_BDY_GRPC"
       case symbol_kind::S_ACTION_CTL_BDY_JSON: // "ACTION_CTL_BDY_JSON"
       case symbol_kind::S_ACTION_CTL_BDY_XML: // "ACTION_CTL_BDY_XML"
       case symbol_kind::S_ACTION_CTL_BDY_URLENCODED: // "ACTION_CTL_BDY_URLENCODED"
@@ -1476,6 +1657,7 @@ namespace yy {
       case symbol_kind::S_ACTION_MULTI_MATCH: // "MultiMatch"
       case symbol_kind::S_ACTION_NO_AUDIT_LOG: // "NoAuditLog"
       case symbol_kind::S_ACTION_NO_LOG: // "NoLog"
+      case symbol_kind::S_ACTION_NO_VERDICT_CACHE: // "NoVerdictCache"
       case symbol_kind::S_ACTION_PASS: // "Pass"
       case symbol_kind::S_ACTION_PAUSE: // "Pause"
       case symbol_kind::S_ACTION_PHASE: // "Phase"
@@ -1540,6 +1722,7 @@ namespace yy {
       case symbol_kind::S_CONFIG_SEC_ARGUMENT_SEPARATOR: // "CONFIG_SEC_ARGUMENT_SEPARATOR"
       case symbol_kind::S_CONFIG_SEC_WEB_APP_ID: // "CONFIG_SEC_WEB_APP_ID"
       case symbol_kind::S_CONFIG_SEC_SERVER_SIG: // "CONFIG_SEC_SERVER_SIG"
+      case symbol_kind::S_CONFIG_DIR_AUDIT_COMPRESSION_LEVEL: // "CONFIG_DIR_AUDIT_COMPRESSION_LEVEL"
       case symbol_kind::S_CONFIG_DIR_AUDIT_DIR: // "CONFIG_DIR_AUDIT_DIR"
       case symbol_kind::S_CONFIG_DIR_AUDIT_DIR_MOD: // "CONFIG_DIR_AUDIT_DIR_MOD"
       case symbol_kind::S_CONFIG_DIR_AUDIT_ENG: // "CONFIG_DIR_AUDIT_ENG"
@@ -1547,7 +1730,9 @@ namespace yy {
       case symbol_kind::S_CONFIG_DIR_AUDIT_LOG: // "CONFIG_DIR_AUDIT_LOG"
       case symbol_kind::S_CONFIG_DIR_AUDIT_LOG2: // "CONFIG_DIR_AUDIT_LOG2"
       case symbol_kind::S_CONFIG_DIR_AUDIT_LOG_P: // "CONFIG_DIR_AUDIT_LOG_P"
+      case symbol_kind::S_CONFIG_DIR_AUDIT_RATE_LIMIT: // "CONFIG_DIR_AUDIT_RATE_LIMIT"
       case symbol_kind::S_CONFIG_DIR_AUDIT_STS: // "CONFIG_DIR_AUDIT_STS"
+      case symbol_kind::S_CONFIG_DIR_AUDIT_TIMINGS: // "CONFIG_DIR_AUDIT_TIMINGS"
       case symbol_kind::S_CONFIG_DIR_AUDIT_TPE: // "CONFIG_DIR_AUDIT_TPE"
       case symbol_kind::S_CONFIG_DIR_DEBUG_LOG: // "CONFIG_DIR_DEBUG_LOG"
       case symbol_kind::S_CONFIG_DIR_DEBUG_LVL: // "CONFIG_DIR_DEBUG_LVL"
@@ -1562,13 +1747,32 @@ namespace yy {
       case symbol_kind::S_CONFIG_DIR_GEO_DB: // "CONFIG_DIR_GEO_DB"
       case symbol_kind::S_CONFIG_DIR_GSB_DB: // "CONFIG_DIR_GSB_DB"
       case symbol_kind::S_CONFIG_SEC_GUARDIAN_LOG: // "CONFIG_SEC_GUARDIAN_LOG"
+      case symbol_kind::S_CONFIG_DIR_DATA_RELOAD_INTERVAL: // "CONFIG_DIR_DATA_RELOAD_INTERVAL"
+      case symbol_kind::S_CONFIG_DIR_LUA_STATE_POOL_LIMIT: // "CONFIG_DIR_LUA_STATE_POOL_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_OVERLOAD_DETECTION_ONLY: // "CONFIG_DIR_OVERLOAD_DETECTION_ONLY"
+      case symbol_kind::S_CONFIG_DIR_OVERLOAD_SHED_TAG: // "CONFIG_DIR_OVERLOAD_SHED_TAG"
+      case symbol_kind::S_CONFIG_DIR_OVERLOAD_TARGET: // "CONFIG_DIR_OVERLOAD_TARGET"
+      case symbol_kind::S_CONFIG_DIR_PCRE_JIT_STACK_SIZE: // "CONFIG_DIR_PCRE_JIT_STACK_SIZE"
       case symbol_kind::S_CONFIG_DIR_PCRE_MATCH_LIMIT: // "CONFIG_DIR_PCRE_MATCH_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_RBL_TIMEOUT: // "CONFIG_DIR_RBL_TIMEOUT"
+      case symbol_kind::S_CONFIG_DIR_RULE_EARLY_DECISION: // "CONFIG_DIR_RULE_EARLY_DECISION"
+      case symbol_kind::S_CONFIG_DIR_RULE_EVALUATION_THREADS: // "CONFIG_DIR_RULE_EVALUATION_THREADS"
+      case symbol_kind::S_CONFIG_DIR_RULE_ENG_SAMPLE_RATE: // "CONFIG_DIR_RULE_ENG_SAMPLE_RATE"
+      case symbol_kind::S_CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE: // "CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE"
+      case symbol_kind::S_CONFIG_DIR_RX_GUARDRAIL: // "CONFIG_DIR_RX_GUARDRAIL"
+      case symbol_kind::S_CONFIG_DIR_REGEX_CACHE_FILE: // "CONFIG_DIR_REGEX_CACHE_FILE"
+      case symbol_kind::S_CONFIG_DIR_RULE_NATIVE_MODULE: // "CONFIG_DIR_RULE_NATIVE_MODULE"
+      case symbol_kind::S_CONFIG_DIR_SHADOW_RULES: // "CONFIG_DIR_SHADOW_RULES"
       case symbol_kind::S_CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION: // "CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION"
       case symbol_kind::S_CONFIG_SEC_CONN_R_STATE_LIMIT: // "CONFIG_SEC_CONN_R_STATE_LIMIT"
       case symbol_kind::S_CONFIG_SEC_CONN_W_STATE_LIMIT: // "CONFIG_SEC_CONN_W_STATE_LIMIT"
       case symbol_kind::S_CONFIG_SEC_SENSOR_ID: // "CONFIG_SEC_SENSOR_ID"
       case symbol_kind::S_CONFIG_DIR_ARGS_LIMIT: // "CONFIG_DIR_ARGS_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_REQ_BODY_DECOMPRESSION: // "CONFIG_DIR_REQ_BODY_DECOMPRESSION"
+      case symbol_kind::S_CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO: // "CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO"
+      case symbol_kind::S_CONFIG_DIR_RES_BODY_DECOMPRESSION: // "CONFIG_DIR_RES_BODY_DECOMPRESSION"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT: // "CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_REQ_BODY_JSON_SIMD: // "CONFIG_DIR_REQ_BODY_JSON_SIMD"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY: // "CONFIG_DIR_REQ_BODY"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT: // "CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY_LIMIT: // "CONFIG_DIR_REQ_BODY_LIMIT"
@@ -1577,17 +1781,34 @@ namespace yy {
       case symbol_kind::S_CONFIG_DIR_RES_BODY: // "CONFIG_DIR_RES_BODY"
       case symbol_kind::S_CONFIG_DIR_RES_BODY_LIMIT: // "CONFIG_DIR_RES_BODY_LIMIT"
       case symbol_kind::S_CONFIG_DIR_RES_BODY_LIMIT_ACTION: // "CONFIG_DIR_RES_BODY_LIMIT_ACTION"
+      case symbol_kind::S_CONFIG_DIR_RES_BODY_STREAM_WINDOW: // "CONFIG_DIR_RES_BODY_STREAM_WINDOW"
       case symbol_kind::S_CONFIG_SEC_RULE_INHERITANCE: // "CONFIG_SEC_RULE_INHERITANCE"
       case symbol_kind::S_CONFIG_SEC_RULE_PERF_TIME: // "CONFIG_SEC_RULE_PERF_TIME"
+      case symbol_kind::S_CONFIG_SEC_RULE_PROFILING: // "CONFIG_SEC_RULE_PROFILING"
+      case symbol_kind::S_CONFIG_SEC_RULE_VALUE_MAJOR: // "CONFIG_SEC_RULE_VALUE_MAJOR"
+      case symbol_kind::S_CONFIG_SEC_RX_PREFILTER: // "CONFIG_SEC_RX_PREFILTER"
+      case symbol_kind::S_CONFIG_SEC_RX_RE2: // "CONFIG_SEC_RX_RE2"
       case symbol_kind::S_CONFIG_DIR_RULE_ENG: // "CONFIG_DIR_RULE_ENG"
       case symbol_kind::S_CONFIG_DIR_SEC_ACTION: // "CONFIG_DIR_SEC_ACTION"
       case symbol_kind::S_CONFIG_DIR_SEC_DEFAULT_ACTION: // "CONFIG_DIR_SEC_DEFAULT_ACTION"
       case symbol_kind::S_CONFIG_DIR_SEC_MARKER: // "CONFIG_DIR_SEC_MARKER"
       case symbol_kind::S_CONFIG_DIR_UNICODE_MAP_FILE: // "CONFIG_DIR_UNICODE_MAP_FILE"
       case symbol_kind::S_CONFIG_DIR_UNICODE_CODE_PAGE: // "CONFIG_DIR_UNICODE_CODE_PAGE"
+      case symbol_kind::S_CONFIG_SEC_COLLECTION_GROUP_COMMIT: // "CONFIG_SEC_COLLECTION_GROUP_COMMIT"
+      case symbol_kind::S_CONFIG_SEC_COLLECTION_REDIS_SERVER: // "CONFIG_SEC_COLLECTION_REDIS_SERVER"
+      case symbol_kind::S_CONFIG_SEC_COLLECTION_SYNC_MODE: // "CONFIG_SEC_COLLECTION_SYNC_MODE"
       case symbol_kind::S_CONFIG_SEC_COLLECTION_TIMEOUT: // "CONFIG_SEC_COLLECTION_TIMEOUT"
+      case symbol_kind::S_CONFIG_SEC_TRANSACTION_ID_FORMAT: // "CONFIG_SEC_TRANSACTION_ID_FORMAT"
+      case symbol_kind::S_CONFIG_SEC_TRANSACTION_MEMORY_LIMIT: // "CONFIG_SEC_TRANSACTION_MEMORY_LIMIT"
+      case symbol_kind::S_CONFIG_SEC_TRANSACTION_TIME_BUDGET: // "CONFIG_SEC_TRANSACTION_TIME_BUDGET"
+      case symbol_kind::S_CONFIG_SEC_VERDICT_CACHE: // "CONFIG_SEC_VERDICT_CACHE"
+      case symbol_kind::S_CONFIG_SEC_DEBUG_LOG_BUFFER: // "CONFIG_SEC_DEBUG_LOG_BUFFER"
+      case symbol_kind::S_CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH: // "CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH"
+      case symbol_kind::S_CONFIG_SEC_DEBUG_LOG_FILTER: // "CONFIG_SEC_DEBUG_LOG_FILTER"
       case symbol_kind::S_CONFIG_SEC_HTTP_BLKEY: // "CONFIG_SEC_HTTP_BLKEY"
+      case symbol_kind::S_CONFIG_SEC_HUGE_PAGES: // "CONFIG_SEC_HUGE_PAGES"
       case symbol_kind::S_CONFIG_SEC_INTERCEPT_ON_ERROR: // "CONFIG_SEC_INTERCEPT_ON_ERROR"
+      case symbol_kind::S_CONFIG_SEC_REMOTE_RULES_CACHE_DIR: // "CONFIG_SEC_REMOTE_RULES_CACHE_DIR"
       case symbol_kind::S_CONFIG_SEC_REMOTE_RULES_FAIL_ACTION: // "CONFIG_SEC_REMOTE_RULES_FAIL_ACTION"
       case symbol_kind::S_CONFIG_SEC_RULE_REMOVE_BY_ID: // "CONFIG_SEC_RULE_REMOVE_BY_ID"
       case symbol_kind::S_CONFIG_SEC_RULE_REMOVE_BY_MSG: // "CONFIG_SEC_RULE_REMOVE_BY_MSG"
@@ -1598,9 +1819,11 @@ namespace yy {
       case symbol_kind::S_CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID: // "CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID"
       case symbol_kind::S_CONFIG_UPDLOAD_KEEP_FILES: // "CONFIG_UPDLOAD_KEEP_FILES"
       case symbol_kind::S_CONFIG_UPDLOAD_SAVE_TMP_FILES: // "CONFIG_UPDLOAD_SAVE_TMP_FILES"
+      case symbol_kind::S_CONFIG_UPLOAD_ANONYMOUS_FILES: // "CONFIG_UPLOAD_ANONYMOUS_FILES"
       case symbol_kind::S_CONFIG_UPLOAD_DIR: // "CONFIG_UPLOAD_DIR"
       case symbol_kind::S_CONFIG_UPLOAD_FILE_LIMIT: // "CONFIG_UPLOAD_FILE_LIMIT"
       case symbol_kind::S_CONFIG_UPLOAD_FILE_MODE: // "CONFIG_UPLOAD_FILE_MODE"
+      case symbol_kind::S_CONFIG_UPLOAD_IN_MEMORY_LIMIT: // "CONFIG_UPLOAD_IN_MEMORY_LIMIT"
       case symbol_kind::S_CONFIG_VALUE_ABORT: // "CONFIG_VALUE_ABORT"
       case symbol_kind::S_CONFIG_VALUE_DETC: // "CONFIG_VALUE_DETC"
       case symbol_kind::S_CONFIG_VALUE_HTTPS: // "CONFIG_VALUE_HTTPS"
@@ -1610,7 +1833,9 @@ namespace yy {
       case symbol_kind::S_CONFIG_VALUE_PROCESS_PARTIAL: // "CONFIG_VALUE_PROCESS_PARTIAL"
       case symbol_kind::S_CONFIG_VALUE_REJECT: // "CONFIG_VALUE_REJECT"
       case symbol_kind::S_CONFIG_VALUE_RELEVANT_ONLY: // "CONFIG_VALUE_RELEVANT_ONLY"
+      case symbol_kind::S_CONFIG_VALUE_RING: // "CONFIG_VALUE_RING"
       case symbol_kind::S_CONFIG_VALUE_SERIAL: // "CONFIG_VALUE_SERIAL"
+      case symbol_kind::S_CONFIG_VALUE_STREAM: // "CONFIG_VALUE_STREAM"
       case symbol_kind::S_CONFIG_VALUE_WARN: // "CONFIG_VALUE_WARN"
       case symbol_kind::S_CONFIG_XML_EXTERNAL_ENTITY: // "CONFIG_XML_EXTERNAL_ENTITY"
       case symbol_kind::S_CONGIG_DIR_RESPONSE_BODY_MP: // "CONGIG_DIR_RESPONSE_BODY_MP"
@@ -1696,586 +1921,668 @@ namespace yy {
           switch (yyn)
             {
   case 2: // input: "end of file"
-#line 721 "seclang-parser.yy"
+#line 792 "seclang-parser.yy"
       {
         return 0;
       }
-#line 1704 "seclang-parser.cc"
+#line 1929 "seclang-parser.cc"
     break;
 
   case 6: // audit_log: "CONFIG_DIR_AUDIT_DIR_MOD"
-#line 734 "seclang-parser.yy"
+#line 805 "seclang-parser.yy"
       {
         driver.m_auditLog->setStorageDirMode(strtol(yystack_[0].value.as < std::string > ().c_str(), NULL, 8));
       }
-#line 1712 "seclang-parser.cc"
+#line 1937 "seclang-parser.cc"
     break;
 
   case 7: // audit_log: "CONFIG_DIR_AUDIT_DIR"
-#line 740 "seclang-parser.yy"
+#line 811 "seclang-parser.yy"
       {
         driver.m_auditLog->setStorageDir(yystack_[0].value.as < std::string > ());
       }
-#line 1720 "seclang-parser.cc"
+#line 1945 "seclang-parser.cc"
     break;
 
   case 8: // audit_log: "CONFIG_DIR_AUDIT_ENG" "CONFIG_VALUE_RELEVANT_ONLY"
-#line 746 "seclang-parser.yy"
+#line 817 "seclang-parser.yy"
       {
         driver.m_auditLog->setStatus(modsecurity::audit_log::AuditLog::RelevantOnlyAuditLogStatus);
       }
-#line 1728 "seclang-parser.cc"
+#line 1953 "seclang-parser.cc"
     break;
 
   case 9: // audit_log: "CONFIG_DIR_AUDIT_ENG" "CONFIG_VALUE_OFF"
-#line 750 "seclang-parser.yy"
+#line 821 "seclang-parser.yy"
       {
         driver.m_auditLog->setStatus(modsecurity::audit_log::AuditLog::OffAuditLogStatus);
       }
-#line 1736 "seclang-parser.cc"
+#line 1961 "seclang-parser.cc"
     break;
 
   case 10: // audit_log: "CONFIG_DIR_AUDIT_ENG" "CONFIG_VALUE_ON"
-#line 754 "seclang-parser.yy"
+#line 825 "seclang-parser.yy"
       {
         driver.m_auditLog->setStatus(modsecurity::audit_log::AuditLog::OnAuditLogStatus);
       }
-#line 1744 "seclang-parser.cc"
+#line 1969 "seclang-parser.cc"
+    break;
+
+  case 11: // audit_log: "CONFIG_DIR_AUDIT_COMPRESSION_LEVEL"
+#line 831 "seclang-parser.yy"
+      {
+        int level = atoi(yystack_[0].value.as < std::string > ().c_str());
+        if (driver.m_auditLog->setCompressionLevel(level) == false) {
+            driver.error(yystack_[1].location, "SecAuditLogCompressionLevel expects a level from 0 (no compression) to 9.");
+            YYERROR;
+        }
+#ifndef WITH_ZLIB
+        if (level > 0) {
+            driver.error(yystack_[1].location, "This version of ModSecurity was not compiled with zlib support.");
+            YYERROR;
+        }
+#endif
+      }
+#line 1987 "seclang-parser.cc"
+    break;
+
+  case 12: // audit_log: "CONFIG_DIR_AUDIT_RATE_LIMIT"
+#line 847 "seclang-parser.yy"
+      {
+        driver.m_auditLog->setRateLimit(atoi(yystack_[0].value.as < std::string > ().c_str()));
+      }
+#line 1995 "seclang-parser.cc"
     break;
 
-  case 11: // audit_log: "CONFIG_DIR_AUDIT_FLE_MOD"
-#line 760 "seclang-parser.yy"
+  case 13: // audit_log: "CONFIG_DIR_AUDIT_FLE_MOD"
+#line 853 "seclang-parser.yy"
       {
         driver.m_auditLog->setFileMode(strtol(yystack_[0].value.as < std::string > ().c_str(), NULL, 8));
       }
-#line 1752 "seclang-parser.cc"
+#line 2003 "seclang-parser.cc"
     break;
 
-  case 12: // audit_log: "CONFIG_DIR_AUDIT_LOG2"
-#line 766 "seclang-parser.yy"
+  case 14: // audit_log: "CONFIG_DIR_AUDIT_LOG2"
+#line 859 "seclang-parser.yy"
       {
         driver.m_auditLog->setFilePath2(yystack_[0].value.as < std::string > ());
       }
-#line 1760 "seclang-parser.cc"
+#line 2011 "seclang-parser.cc"
     break;
 
-  case 13: // audit_log: "CONFIG_DIR_AUDIT_LOG_P"
-#line 772 "seclang-parser.yy"
+  case 15: // audit_log: "CONFIG_DIR_AUDIT_LOG_P"
+#line 865 "seclang-parser.yy"
       {
         driver.m_auditLog->setParts(yystack_[0].value.as < std::string > ());
       }
-#line 1768 "seclang-parser.cc"
+#line 2019 "seclang-parser.cc"
     break;
 
-  case 14: // audit_log: "CONFIG_DIR_AUDIT_LOG"
-#line 778 "seclang-parser.yy"
+  case 16: // audit_log: "CONFIG_DIR_AUDIT_LOG"
+#line 871 "seclang-parser.yy"
       {
         driver.m_auditLog->setFilePath1(yystack_[0].value.as < std::string > ());
       }
-#line 1776 "seclang-parser.cc"
+#line 2027 "seclang-parser.cc"
     break;
 
-  case 15: // audit_log: CONFIG_DIR_AUDIT_LOG_FMT JSON
-#line 783 "seclang-parser.yy"
+  case 17: // audit_log: CONFIG_DIR_AUDIT_LOG_FMT JSON
+#line 876 "seclang-parser.yy"
       {
         driver.m_auditLog->setFormat(modsecurity::audit_log::AuditLog::JSONAuditLogFormat);
       }
-#line 1784 "seclang-parser.cc"
+#line 2035 "seclang-parser.cc"
+    break;
+
+  case 18: // audit_log: CONFIG_DIR_AUDIT_LOG_FMT MSGPACK
+#line 881 "seclang-parser.yy"
+      {
+        driver.m_auditLog->setFormat(modsecurity::audit_log::AuditLog::MsgPackAuditLogFormat);
+      }
+#line 2043 "seclang-parser.cc"
     break;
 
-  case 16: // audit_log: CONFIG_DIR_AUDIT_LOG_FMT NATIVE
-#line 788 "seclang-parser.yy"
+  case 19: // audit_log: CONFIG_DIR_AUDIT_LOG_FMT NATIVE
+#line 886 "seclang-parser.yy"
       {
         driver.m_auditLog->setFormat(modsecurity::audit_log::AuditLog::NativeAuditLogFormat);
       }
-#line 1792 "seclang-parser.cc"
+#line 2051 "seclang-parser.cc"
+    break;
+
+  case 20: // audit_log: "CONFIG_DIR_AUDIT_TIMINGS" "CONFIG_VALUE_OFF"
+#line 892 "seclang-parser.yy"
+      {
+        driver.m_auditLog->setTimings(false);
+      }
+#line 2059 "seclang-parser.cc"
+    break;
+
+  case 21: // audit_log: "CONFIG_DIR_AUDIT_TIMINGS" "CONFIG_VALUE_ON"
+#line 896 "seclang-parser.yy"
+      {
+        driver.m_auditLog->setTimings(true);
+      }
+#line 2067 "seclang-parser.cc"
     break;
 
-  case 17: // audit_log: "CONFIG_DIR_AUDIT_STS"
-#line 794 "seclang-parser.yy"
+  case 22: // audit_log: "CONFIG_DIR_AUDIT_STS"
+#line 902 "seclang-parser.yy"
       {
         std::string relevant_status(yystack_[0].value.as < std::string > ());
         driver.m_auditLog->setRelevantStatus(relevant_status);
       }
-#line 1801 "seclang-parser.cc"
+#line 2076 "seclang-parser.cc"
     break;
 
-  case 18: // audit_log: "CONFIG_DIR_AUDIT_TPE" "CONFIG_VALUE_SERIAL"
-#line 801 "seclang-parser.yy"
+  case 23: // audit_log: "CONFIG_DIR_AUDIT_TPE" "CONFIG_VALUE_SERIAL"
+#line 909 "seclang-parser.yy"
       {
         driver.m_auditLog->setType(modsecurity::audit_log::AuditLog::SerialAuditLogType);
       }
-#line 1809 "seclang-parser.cc"
+#line 2084 "seclang-parser.cc"
     break;
 
-  case 19: // audit_log: "CONFIG_DIR_AUDIT_TPE" "CONFIG_VALUE_PARALLEL"
-#line 805 "seclang-parser.yy"
+  case 24: // audit_log: "CONFIG_DIR_AUDIT_TPE" "CONFIG_VALUE_PARALLEL"
+#line 913 "seclang-parser.yy"
       {
         driver.m_auditLog->setType(modsecurity::audit_log::AuditLog::ParallelAuditLogType);
       }
-#line 1817 "seclang-parser.cc"
+#line 2092 "seclang-parser.cc"
     break;
 
-  case 20: // audit_log: "CONFIG_DIR_AUDIT_TPE" "CONFIG_VALUE_HTTPS"
-#line 809 "seclang-parser.yy"
+  case 25: // audit_log: "CONFIG_DIR_AUDIT_TPE" "CONFIG_VALUE_HTTPS"
+#line 917 "seclang-parser.yy"
       {
         driver.m_auditLog->setType(modsecurity::audit_log::AuditLog::HttpsAuditLogType);
       }
-#line 1825 "seclang-parser.cc"
+#line 2100 "seclang-parser.cc"
     break;
 
-  case 21: // audit_log: "CONFIG_UPDLOAD_KEEP_FILES" "CONFIG_VALUE_ON"
-#line 815 "seclang-parser.yy"
+  case 26: // audit_log: "CONFIG_DIR_AUDIT_TPE" "CONFIG_VALUE_RING"
+#line 921 "seclang-parser.yy"
+      {
+        driver.m_auditLog->setType(modsecurity::audit_log::AuditLog::RingAuditLogType);
+      }
+#line 2108 "seclang-parser.cc"
+    break;
+
+  case 27: // audit_log: "CONFIG_DIR_AUDIT_TPE" "CONFIG_VALUE_STREAM"
+#line 925 "seclang-parser.yy"
+      {
+        driver.m_auditLog->setType(modsecurity::audit_log::AuditLog::StreamAuditLogType);
+      }
+#line 2116 "seclang-parser.cc"
+    break;
+
+  case 28: // audit_log: "CONFIG_UPDLOAD_KEEP_FILES" "CONFIG_VALUE_ON"
+#line 931 "seclang-parser.yy"
       {
         driver.m_uploadKeepFiles = modsecurity::RulesSetProperties::TrueConfigBoolean;
       }
-#line 1833 "seclang-parser.cc"
+#line 2124 "seclang-parser.cc"
     break;
 
-  case 22: // audit_log: "CONFIG_UPDLOAD_KEEP_FILES" "CONFIG_VALUE_OFF"
-#line 819 "seclang-parser.yy"
+  case 29: // audit_log: "CONFIG_UPDLOAD_KEEP_FILES" "CONFIG_VALUE_OFF"
+#line 935 "seclang-parser.yy"
       {
         driver.m_uploadKeepFiles = modsecurity::RulesSetProperties::FalseConfigBoolean;
       }
-#line 1841 "seclang-parser.cc"
+#line 2132 "seclang-parser.cc"
     break;
 
-  case 23: // audit_log: "CONFIG_UPDLOAD_KEEP_FILES" "CONFIG_VALUE_RELEVANT_ONLY"
-#line 823 "seclang-parser.yy"
+  case 30: // audit_log: "CONFIG_UPDLOAD_KEEP_FILES" "CONFIG_VALUE_RELEVANT_ONLY"
+#line 939 "seclang-parser.yy"
       {
         driver.error(yystack_[2].location, "SecUploadKeepFiles RelevantOnly is not currently supported. Accepted values are On or Off");
         YYERROR;
       }
-#line 1850 "seclang-parser.cc"
+#line 2141 "seclang-parser.cc"
     break;
 
-  case 24: // audit_log: "CONFIG_UPLOAD_FILE_LIMIT"
-#line 828 "seclang-parser.yy"
+  case 31: // audit_log: "CONFIG_UPLOAD_FILE_LIMIT"
+#line 944 "seclang-parser.yy"
       {
         driver.m_uploadFileLimit.m_set = true;
         driver.m_uploadFileLimit.m_value = strtol(yystack_[0].value.as < std::string > ().c_str(), NULL, 10);
       }
-#line 1859 "seclang-parser.cc"
+#line 2150 "seclang-parser.cc"
     break;
 
-  case 25: // audit_log: "CONFIG_UPLOAD_FILE_MODE"
-#line 833 "seclang-parser.yy"
+  case 32: // audit_log: "CONFIG_UPLOAD_FILE_MODE"
+#line 949 "seclang-parser.yy"
       {
         driver.m_uploadFileMode.m_set = true;
         driver.m_uploadFileMode.m_value = strtol(yystack_[0].value.as < std::string > ().c_str(), NULL, 8);
       }
-#line 1868 "seclang-parser.cc"
+#line 2159 "seclang-parser.cc"
     break;
 
-  case 26: // audit_log: "CONFIG_UPLOAD_DIR"
-#line 838 "seclang-parser.yy"
+  case 33: // audit_log: "CONFIG_UPLOAD_IN_MEMORY_LIMIT"
+#line 954 "seclang-parser.yy"
+      {
+        driver.m_uploadInMemoryLimit.m_set = true;
+        driver.m_uploadInMemoryLimit.m_value = strtol(yystack_[0].value.as < std::string > ().c_str(), NULL, 10);
+      }
+#line 2168 "seclang-parser.cc"
+    break;
+
+  case 34: // audit_log: "CONFIG_UPLOAD_DIR"
+#line 959 "seclang-parser.yy"
       {
         driver.m_uploadDirectory.m_set = true;
         driver.m_uploadDirectory.m_value = yystack_[0].value.as < std::string > ();
       }
-#line 1877 "seclang-parser.cc"
+#line 2177 "seclang-parser.cc"
     break;
 
-  case 27: // audit_log: "CONFIG_UPDLOAD_SAVE_TMP_FILES" "CONFIG_VALUE_ON"
-#line 843 "seclang-parser.yy"
+  case 35: // audit_log: "CONFIG_UPDLOAD_SAVE_TMP_FILES" "CONFIG_VALUE_ON"
+#line 964 "seclang-parser.yy"
       {
         driver.m_tmpSaveUploadedFiles = modsecurity::RulesSetProperties::TrueConfigBoolean;
       }
-#line 1885 "seclang-parser.cc"
+#line 2185 "seclang-parser.cc"
     break;
 
-  case 28: // audit_log: "CONFIG_UPDLOAD_SAVE_TMP_FILES" "CONFIG_VALUE_OFF"
-#line 847 "seclang-parser.yy"
+  case 36: // audit_log: "CONFIG_UPDLOAD_SAVE_TMP_FILES" "CONFIG_VALUE_OFF"
+#line 968 "seclang-parser.yy"
       {
         driver.m_tmpSaveUploadedFiles = modsecurity::RulesSetProperties::FalseConfigBoolean;
       }
-#line 1893 "seclang-parser.cc"
+#line 2193 "seclang-parser.cc"
+    break;
+
+  case 37: // audit_log: "CONFIG_UPLOAD_ANONYMOUS_FILES" "CONFIG_VALUE_ON"
+#line 972 "seclang-parser.yy"
+      {
+        driver.m_uploadAnonymousFiles = modsecurity::RulesSetProperties::TrueConfigBoolean;
+      }
+#line 2201 "seclang-parser.cc"
+    break;
+
+  case 38: // audit_log: "CONFIG_UPLOAD_ANONYMOUS_FILES" "CONFIG_VALUE_OFF"
+#line 976 "seclang-parser.yy"
+      {
+        driver.m_uploadAnonymousFiles = modsecurity::RulesSetProperties::FalseConfigBoolean;
+      }
+#line 2209 "seclang-parser.cc"
     break;
 
-  case 29: // actions: "QUOTATION_MARK" actions_may_quoted "QUOTATION_MARK"
-#line 854 "seclang-parser.yy"
+  case 39: // actions: "QUOTATION_MARK" actions_may_quoted "QUOTATION_MARK"
+#line 983 "seclang-parser.yy"
       {
         yylhs.value.as < std::unique_ptr<std::vector<std::unique_ptr<actions::Action> > >  > () = std::move(yystack_[1].value.as < std::unique_ptr<std::vector<std::unique_ptr<actions::Action> > >  > ());
       }
-#line 1901 "seclang-parser.cc"
+#line 2217 "seclang-parser.cc"
     break;
 
-  case 30: // actions: actions_may_quoted
-#line 858 "seclang-parser.yy"
+  case 40: // actions: actions_may_quoted
+#line 987 "seclang-parser.yy"
       {
         yylhs.value.as < std::unique_ptr<std::vector<std::unique_ptr<actions::Action> > >  > () = std::move(yystack_[0].value.as < std::unique_ptr<std::vector<std::unique_ptr<actions::Action> > >  > ());
       }
-#line 1909 "seclang-parser.cc"
+#line 2225 "seclang-parser.cc"
     break;
 
-  case 31: // actions_may_quoted: actions_may_quoted "," act
-#line 865 "seclang-parser.yy"
+  case 41: // actions_may_quoted: actions_may_quoted "," act
+#line 994 "seclang-parser.yy"
       {
         ACTION_INIT(yystack_[0].value.as < std::unique_ptr<actions::Action> > (), yystack_[3].location)
         yystack_[2].value.as < std::unique_ptr<std::vector<std::unique_ptr<actions::Action> > >  > ()->push_back(std::move(yystack_[0].value.as < std::unique_ptr<actions::Action> > ()));
         yylhs.value.as < std::unique_ptr<std::vector<std::unique_ptr<actions::Action> > >  > () = std::move(yystack_[2].value.as < std::unique_ptr<std::vector<std::unique_ptr<actions::Action> > >  > ());
       }
-#line 1919 "seclang-parser.cc"
+#line 2235 "seclang-parser.cc"
     break;
 
-  case 32: // actions_may_quoted: act
-#line 871 "seclang-parser.yy"
+  case 42: // actions_may_quoted: act
+#line 1000 "seclang-parser.yy"
       {
         std::unique_ptr<std::vector<std::unique_ptr<actions::Action>>> b(new std::vector<std::unique_ptr<actions::Action>>());
         ACTION_INIT(yystack_[0].value.as < std::unique_ptr<actions::Action> > (), yystack_[1].location)
         b->push_back(std::move(yystack_[0].value.as < std::unique_ptr<actions::Action> > ()));
         yylhs.value.as < std::unique_ptr<std::vector<std::unique_ptr<actions::Action> > >  > () = std::move(b);
       }
-#line 1930 "seclang-parser.cc"
+#line 2246 "seclang-parser.cc"
     break;
 
-  case 33: // op: op_before_init
-#line 881 "seclang-parser.yy"
+  case 43: // op: op_before_init
+#line 1010 "seclang-parser.yy"
       {
         yylhs.value.as < std::unique_ptr<Operator> > () = std::move(yystack_[0].value.as < std::unique_ptr<Operator> > ());
-        std::string error;
-        if (yylhs.value.as < std::unique_ptr<Operator> > ()->init(*yystack_[0].location.end.filename, &error) == false) {
-            driver.error(yystack_[1].location, error);
-            YYERROR;
-        }
+        OPERATOR_INIT(yylhs.value.as < std::unique_ptr<Operator> > (), *yystack_[0].location.end.filename, yystack_[1].location)
       }
-#line 1943 "seclang-parser.cc"
+#line 2255 "seclang-parser.cc"
     break;
 
-  case 34: // op: "NOT" op_before_init
-#line 890 "seclang-parser.yy"
+  case 44: // op: "NOT" op_before_init
+#line 1015 "seclang-parser.yy"
       {
         yylhs.value.as < std::unique_ptr<Operator> > () = std::move(yystack_[0].value.as < std::unique_ptr<Operator> > ());
         yylhs.value.as < std::unique_ptr<Operator> > ()->m_negation = true;
-        std::string error;
-        if (yylhs.value.as < std::unique_ptr<Operator> > ()->init(*yystack_[1].location.end.filename, &error) == false) {
-            driver.error(yystack_[2].location, error);
-            YYERROR;
-        }
+        OPERATOR_INIT(yylhs.value.as < std::unique_ptr<Operator> > (), *yystack_[1].location.end.filename, yystack_[2].location)
       }
-#line 1957 "seclang-parser.cc"
+#line 2265 "seclang-parser.cc"
     break;
 
-  case 35: // op: run_time_string
-#line 900 "seclang-parser.yy"
+  case 45: // op: run_time_string
+#line 1021 "seclang-parser.yy"
       {
-        OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::Rx(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
-        std::string error;
-        if (yylhs.value.as < std::unique_ptr<Operator> > ()->init(*yystack_[0].location.end.filename, &error) == false) {
-            driver.error(yystack_[1].location, error);
-            YYERROR;
-        }
+        OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::Rx(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ()),
+            driver.m_regexStore.get()));
+        OPERATOR_INIT(yylhs.value.as < std::unique_ptr<Operator> > (), *yystack_[0].location.end.filename, yystack_[1].location)
       }
-#line 1970 "seclang-parser.cc"
+#line 2275 "seclang-parser.cc"
     break;
 
-  case 36: // op: "NOT" run_time_string
-#line 909 "seclang-parser.yy"
+  case 46: // op: "NOT" run_time_string
+#line 1027 "seclang-parser.yy"
       {
-        OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::Rx(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
+        OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::Rx(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ()),
+            driver.m_regexStore.get()));
         yylhs.value.as < std::unique_ptr<Operator> > ()->m_negation = true;
-        std::string error;
-        if (yylhs.value.as < std::unique_ptr<Operator> > ()->init(*yystack_[1].location.end.filename, &error) == false) {
-            driver.error(yystack_[2].location, error);
-            YYERROR;
-        }
+        OPERATOR_INIT(yylhs.value.as < std::unique_ptr<Operator> > (), *yystack_[1].location.end.filename, yystack_[2].location)
       }
-#line 1984 "seclang-parser.cc"
+#line 2286 "seclang-parser.cc"
     break;
 
-  case 37: // op_before_init: "OPERATOR_UNCONDITIONAL_MATCH"
-#line 922 "seclang-parser.yy"
+  case 47: // op_before_init: "OPERATOR_UNCONDITIONAL_MATCH"
+#line 1037 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::UnconditionalMatch());
       }
-#line 1992 "seclang-parser.cc"
+#line 2294 "seclang-parser.cc"
     break;
 
-  case 38: // op_before_init: "OPERATOR_DETECT_SQLI"
-#line 926 "seclang-parser.yy"
+  case 48: // op_before_init: "OPERATOR_DETECT_SQLI"
+#line 1041 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::DetectSQLi());
       }
-#line 2000 "seclang-parser.cc"
+#line 2302 "seclang-parser.cc"
     break;
 
-  case 39: // op_before_init: "OPERATOR_DETECT_XSS"
-#line 930 "seclang-parser.yy"
+  case 49: // op_before_init: "OPERATOR_DETECT_XSS"
+#line 1045 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::DetectXSS());
       }
-#line 2008 "seclang-parser.cc"
+#line 2310 "seclang-parser.cc"
     break;
 
-  case 40: // op_before_init: "OPERATOR_VALIDATE_URL_ENCODING"
-#line 934 "seclang-parser.yy"
+  case 50: // op_before_init: "OPERATOR_VALIDATE_URL_ENCODING"
+#line 1049 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::ValidateUrlEncoding());
       }
-#line 2016 "seclang-parser.cc"
+#line 2318 "seclang-parser.cc"
     break;
 
-  case 41: // op_before_init: "OPERATOR_VALIDATE_UTF8_ENCODING"
-#line 938 "seclang-parser.yy"
+  case 51: // op_before_init: "OPERATOR_VALIDATE_UTF8_ENCODING"
+#line 1053 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::ValidateUtf8Encoding());
       }
-#line 2024 "seclang-parser.cc"
+#line 2326 "seclang-parser.cc"
     break;
 
-  case 42: // op_before_init: "OPERATOR_INSPECT_FILE" run_time_string
-#line 942 "seclang-parser.yy"
+  case 52: // op_before_init: "OPERATOR_INSPECT_FILE" run_time_string
+#line 1057 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::InspectFile(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
+        driver.m_variablesInUse.addAll();
+        driver.m_xmlDomRequired = modsecurity::RulesSetProperties::TrueConfigBoolean;
       }
-#line 2032 "seclang-parser.cc"
+#line 2336 "seclang-parser.cc"
     break;
 
-  case 43: // op_before_init: "OPERATOR_FUZZY_HASH" run_time_string
-#line 946 "seclang-parser.yy"
+  case 53: // op_before_init: "OPERATOR_FUZZY_HASH" run_time_string
+#line 1063 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::FuzzyHash(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 2040 "seclang-parser.cc"
+#line 2344 "seclang-parser.cc"
     break;
 
-  case 44: // op_before_init: "OPERATOR_VALIDATE_BYTE_RANGE" run_time_string
-#line 950 "seclang-parser.yy"
+  case 54: // op_before_init: "OPERATOR_VALIDATE_BYTE_RANGE" run_time_string
+#line 1067 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::ValidateByteRange(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 2048 "seclang-parser.cc"
+#line 2352 "seclang-parser.cc"
     break;
 
-  case 45: // op_before_init: "OPERATOR_VALIDATE_DTD" run_time_string
-#line 954 "seclang-parser.yy"
+  case 55: // op_before_init: "OPERATOR_VALIDATE_DTD" run_time_string
+#line 1071 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::ValidateDTD(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
+        driver.m_xmlDomRequired = modsecurity::RulesSetProperties::TrueConfigBoolean;
       }
-#line 2056 "seclang-parser.cc"
+#line 2361 "seclang-parser.cc"
     break;
 
-  case 46: // op_before_init: "OPERATOR_VALIDATE_HASH" run_time_string
-#line 958 "seclang-parser.yy"
+  case 56: // op_before_init: "OPERATOR_VALIDATE_HASH" run_time_string
+#line 1076 "seclang-parser.yy"
       {
         /* $$ = new operators::ValidateHash($1); */
         OPERATOR_NOT_SUPPORTED("ValidateHash", yystack_[2].location);
       }
-#line 2065 "seclang-parser.cc"
+#line 2370 "seclang-parser.cc"
     break;
 
-  case 47: // op_before_init: "OPERATOR_VALIDATE_SCHEMA" run_time_string
-#line 963 "seclang-parser.yy"
+  case 57: // op_before_init: "OPERATOR_VALIDATE_SCHEMA" run_time_string
+#line 1081 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::ValidateSchema(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
+        driver.m_xmlDomRequired = modsecurity::RulesSetProperties::TrueConfigBoolean;
       }
-#line 2073 "seclang-parser.cc"
+#line 2379 "seclang-parser.cc"
     break;
 
-  case 48: // op_before_init: "OPERATOR_VERIFY_CC" run_time_string
-#line 967 "seclang-parser.yy"
+  case 58: // op_before_init: "OPERATOR_VERIFY_CC" run_time_string
+#line 1086 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::VerifyCC(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 2081 "seclang-parser.cc"
+#line 2387 "seclang-parser.cc"
     break;
 
-  case 49: // op_before_init: "OPERATOR_VERIFY_CPF" run_time_string
-#line 971 "seclang-parser.yy"
+  case 59: // op_before_init: "OPERATOR_VERIFY_CPF" run_time_string
+#line 1090 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::VerifyCPF(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 2089 "seclang-parser.cc"
+#line 2395 "seclang-parser.cc"
     break;
 
-  case 50: // op_before_init: "OPERATOR_VERIFY_SSN" run_time_string
-#line 975 "seclang-parser.yy"
+  case 60: // op_before_init: "OPERATOR_VERIFY_SSN" run_time_string
+#line 1094 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::VerifySSN(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 2097 "seclang-parser.cc"
+#line 2403 "seclang-parser.cc"
     break;
 
-  case 51: // op_before_init: "OPERATOR_VERIFY_SVNR" run_time_string
-#line 979 "seclang-parser.yy"
+  case 61: // op_before_init: "OPERATOR_VERIFY_SVNR" run_time_string
+#line 1098 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::VerifySVNR(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 2105 "seclang-parser.cc"
+#line 2411 "seclang-parser.cc"
     break;
 
-  case 52: // op_before_init: "OPERATOR_GSB_LOOKUP" run_time_string
-#line 983 "seclang-parser.yy"
+  case 62: // op_before_init: "OPERATOR_GSB_LOOKUP" run_time_string
+#line 1102 "seclang-parser.yy"
       {
-        /* $$ = new operators::GsbLookup($1); */
-        OPERATOR_NOT_SUPPORTED("GsbLookup", yystack_[2].location);
+        OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::GsbLookup(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 2114 "seclang-parser.cc"
+#line 2419 "seclang-parser.cc"
     break;
 
-  case 53: // op_before_init: "OPERATOR_RSUB" run_time_string
-#line 988 "seclang-parser.yy"
+  case 63: // op_before_init: "OPERATOR_RSUB" run_time_string
+#line 1106 "seclang-parser.yy"
       {
         /* $$ = new operators::Rsub($1); */
         OPERATOR_NOT_SUPPORTED("Rsub", yystack_[2].location);
       }
-#line 2123 "seclang-parser.cc"
+#line 2428 "seclang-parser.cc"
     break;
 
-  case 54: // op_before_init: "OPERATOR_WITHIN" run_time_string
-#line 993 "seclang-parser.yy"
+  case 64: // op_before_init: "OPERATOR_WITHIN" run_time_string
+#line 1111 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::Within(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 2131 "seclang-parser.cc"
+#line 2436 "seclang-parser.cc"
     break;
 
-  case 55: // op_before_init: "OPERATOR_CONTAINS_WORD" run_time_string
-#line 997 "seclang-parser.yy"
+  case 65: // op_before_init: "OPERATOR_CONTAINS_WORD" run_time_string
+#line 1115 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::ContainsWord(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 2139 "seclang-parser.cc"
+#line 2444 "seclang-parser.cc"
     break;
 
-  case 56: // op_before_init: "OPERATOR_CONTAINS" run_time_string
-#line 1001 "seclang-parser.yy"
+  case 66: // op_before_init: "OPERATOR_CONTAINS" run_time_string
+#line 1119 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::Contains(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 2147 "seclang-parser.cc"
+#line 2452 "seclang-parser.cc"
     break;
 
-  case 57: // op_before_init: "OPERATOR_ENDS_WITH" run_time_string
-#line 1005 "seclang-parser.yy"
+  case 67: // op_before_init: "OPERATOR_ENDS_WITH" run_time_string
+#line 1123 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::EndsWith(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 2155 "seclang-parser.cc"
+#line 2460 "seclang-parser.cc"
     break;
 
-  case 58: // op_before_init: "OPERATOR_EQ" run_time_string
-#line 1009 "seclang-parser.yy"
+  case 68: // op_before_init: "OPERATOR_EQ" run_time_string
+#line 1127 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::Eq(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 2163 "seclang-parser.cc"
+#line 2468 "seclang-parser.cc"
     break;
 
-  case 59: // op_before_init: "OPERATOR_GE" run_time_string
-#line 1013 "seclang-parser.yy"
+  case 69: // op_before_init: "OPERATOR_GE" run_time_string
+#line 1131 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::Ge(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 2171 "seclang-parser.cc"
+#line 2476 "seclang-parser.cc"
     break;
 
-  case 60: // op_before_init: "OPERATOR_GT" run_time_string
-#line 1017 "seclang-parser.yy"
+  case 70: // op_before_init: "OPERATOR_GT" run_time_string
+#line 1135 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::Gt(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 2179 "seclang-parser.cc"
+#line 2484 "seclang-parser.cc"
     break;
 
-  case 61: // op_before_init: "OPERATOR_IP_MATCH_FROM_FILE" run_time_string
-#line 1021 "seclang-parser.yy"
+  case 71: // op_before_init: "OPERATOR_IP_MATCH_FROM_FILE" run_time_string
+#line 1139 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::IpMatchF(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 2187 "seclang-parser.cc"
+#line 2492 "seclang-parser.cc"
     break;
 
-  case 62: // op_before_init: "OPERATOR_IP_MATCH" run_time_string
-#line 1025 "seclang-parser.yy"
+  case 72: // op_before_init: "OPERATOR_IP_MATCH" run_time_string
+#line 1143 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::IpMatch(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 2195 "seclang-parser.cc"
+#line 2500 "seclang-parser.cc"
     break;
 
-  case 63: // op_before_init: "OPERATOR_LE" run_time_string
-#line 1029 "seclang-parser.yy"
+  case 73: // op_before_init: "OPERATOR_LE" run_time_string
+#line 1147 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::Le(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 2203 "seclang-parser.cc"
+#line 2508 "seclang-parser.cc"
     break;
 
-  case 64: // op_before_init: "OPERATOR_LT" run_time_string
-#line 1033 "seclang-parser.yy"
+  case 74: // op_before_init: "OPERATOR_LT" run_time_string
+#line 1151 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::Lt(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 2211 "seclang-parser.cc"
+#line 2516 "seclang-parser.cc"
     break;
 
-  case 65: // op_before_init: "OPERATOR_PM_FROM_FILE" run_time_string
-#line 1037 "seclang-parser.yy"
+  case 75: // op_before_init: "OPERATOR_PM_FROM_FILE" run_time_string
+#line 1155 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::PmFromFile(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 2219 "seclang-parser.cc"
+#line 2524 "seclang-parser.cc"
     break;
 
-  case 66: // op_before_init: "OPERATOR_PM" run_time_string
-#line 1041 "seclang-parser.yy"
+  case 76: // op_before_init: "OPERATOR_PM" run_time_string
+#line 1159 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::Pm(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 2227 "seclang-parser.cc"
+#line 2532 "seclang-parser.cc"
     break;
 
-  case 67: // op_before_init: "OPERATOR_RBL" run_time_string
-#line 1045 "seclang-parser.yy"
+  case 77: // op_before_init: "OPERATOR_RBL" run_time_string
+#line 1163 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::Rbl(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 2235 "seclang-parser.cc"
+#line 2540 "seclang-parser.cc"
     break;
 
-  case 68: // op_before_init: "OPERATOR_RX" run_time_string
-#line 1049 "seclang-parser.yy"
+  case 78: // op_before_init: "OPERATOR_RX" run_time_string
+#line 1167 "seclang-parser.yy"
       {
-        OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::Rx(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
+        OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::Rx(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ()),
+            driver.m_regexStore.get()));
       }
-#line 2243 "seclang-parser.cc"
+#line 2549 "seclang-parser.cc"
     break;
 
-  case 69: // op_before_init: "OPERATOR_RX_GLOBAL" run_time_string
-#line 1053 "seclang-parser.yy"
+  case 79: // op_before_init: "OPERATOR_RX_GLOBAL" run_time_string
+#line 1172 "seclang-parser.yy"
       {
-        OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::RxGlobal(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
+        OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::RxGlobal(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ()),
+            driver.m_regexStore.get()));
       }
-#line 2251 "seclang-parser.cc"
+#line 2558 "seclang-parser.cc"
     break;
 
-  case 70: // op_before_init: "OPERATOR_STR_EQ" run_time_string
-#line 1057 "seclang-parser.yy"
+  case 80: // op_before_init: "OPERATOR_STR_EQ" run_time_string
+#line 1177 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::StrEq(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 2259 "seclang-parser.cc"
+#line 2566 "seclang-parser.cc"
     break;
 
-  case 71: // op_before_init: "OPERATOR_STR_MATCH" run_time_string
-#line 1061 "seclang-parser.yy"
+  case 81: // op_before_init: "OPERATOR_STR_MATCH" run_time_string
+#line 1181 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::StrMatch(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 2267 "seclang-parser.cc"
+#line 2574 "seclang-parser.cc"
     break;
 
-  case 72: // op_before_init: "OPERATOR_BEGINS_WITH" run_time_string
-#line 1065 "seclang-parser.yy"
+  case 82: // op_before_init: "OPERATOR_BEGINS_WITH" run_time_string
+#line 1185 "seclang-parser.yy"
       {
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::BeginsWith(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 2275 "seclang-parser.cc"
+#line 2582 "seclang-parser.cc"
     break;
 
-  case 73: // op_before_init: "OPERATOR_GEOLOOKUP"
-#line 1069 "seclang-parser.yy"
+  case 83: // op_before_init: "OPERATOR_GEOLOOKUP"
+#line 1189 "seclang-parser.yy"
       {
 #if defined(WITH_GEOIP) or defined(WITH_MAXMIND)
         OPERATOR_CONTAINER(yylhs.value.as < std::unique_ptr<Operator> > (), new operators::GeoLookup());
@@ -2286,11 +2593,11 @@ namespace yy {
             YYERROR;
 #endif  // WITH_GEOIP
       }
-#line 2290 "seclang-parser.cc"
+#line 2597 "seclang-parser.cc"
     break;
 
-  case 75: // expression: "DIRECTIVE" variables op actions
-#line 1084 "seclang-parser.yy"
+  case 85: // expression: "DIRECTIVE" variables op actions
+#line 1204 "seclang-parser.yy"
       {
         std::vector<actions::Action *> *a = new std::vector<actions::Action *>();
         std::vector<actions::transformations::Transformation *> *t = new std::vector<actions::transformations::Transformation *>();
@@ -2320,11 +2627,11 @@ namespace yy {
             YYERROR;
         }
       }
-#line 2324 "seclang-parser.cc"
+#line 2631 "seclang-parser.cc"
     break;
 
-  case 76: // expression: "DIRECTIVE" variables op
-#line 1114 "seclang-parser.yy"
+  case 86: // expression: "DIRECTIVE" variables op
+#line 1234 "seclang-parser.yy"
       {
         variables::Variables *v = new variables::Variables();
         for (auto &i : *yystack_[1].value.as < std::unique_ptr<std::vector<std::unique_ptr<Variable> > >  > ().get()) {
@@ -2343,11 +2650,11 @@ namespace yy {
             YYERROR;
         }
       }
-#line 2347 "seclang-parser.cc"
+#line 2654 "seclang-parser.cc"
     break;
 
-  case 77: // expression: "CONFIG_DIR_SEC_ACTION" actions
-#line 1133 "seclang-parser.yy"
+  case 87: // expression: "CONFIG_DIR_SEC_ACTION" actions
+#line 1253 "seclang-parser.yy"
       {
         std::vector<actions::Action *> *a = new std::vector<actions::Action *>();
         std::vector<actions::transformations::Transformation *> *t = new std::vector<actions::transformations::Transformation *>();
@@ -2366,11 +2673,11 @@ namespace yy {
             ));
         driver.addSecAction(std::move(rule));
       }
-#line 2370 "seclang-parser.cc"
+#line 2677 "seclang-parser.cc"
     break;
 
-  case 78: // expression: "DIRECTIVE_SECRULESCRIPT" actions
-#line 1152 "seclang-parser.yy"
+  case 88: // expression: "DIRECTIVE_SECRULESCRIPT" actions
+#line 1272 "seclang-parser.yy"
       {
         std::string err;
         std::vector<actions::Action *> *a = new std::vector<actions::Action *>();
@@ -2397,12 +2704,15 @@ namespace yy {
         if (driver.addSecRuleScript(std::move(r)) == false) {
             YYERROR;
         }
+        /* scripts reach the variables, XML included, by name */
+        driver.m_variablesInUse.addAll();
+        driver.m_xmlDomRequired = modsecurity::RulesSetProperties::TrueConfigBoolean;
       }
-#line 2402 "seclang-parser.cc"
+#line 2712 "seclang-parser.cc"
     break;
 
-  case 79: // expression: "CONFIG_DIR_SEC_DEFAULT_ACTION" actions
-#line 1180 "seclang-parser.yy"
+  case 89: // expression: "CONFIG_DIR_SEC_DEFAULT_ACTION" actions
+#line 1303 "seclang-parser.yy"
       {
         bool hasDisruptive = false;
         std::vector<actions::Action *> *actions = new std::vector<actions::Action *>();
@@ -2459,78 +2769,78 @@ namespace yy {
 
         delete actions;
       }
-#line 2463 "seclang-parser.cc"
+#line 2773 "seclang-parser.cc"
     break;
 
-  case 80: // expression: "CONFIG_DIR_SEC_MARKER"
-#line 1237 "seclang-parser.yy"
+  case 90: // expression: "CONFIG_DIR_SEC_MARKER"
+#line 1360 "seclang-parser.yy"
       {
         driver.addSecMarker(modsecurity::utils::string::removeBracketsIfNeeded(yystack_[0].value.as < std::string > ()),
             /* file name */ std::unique_ptr<std::string>(new std::string(*yystack_[0].location.end.filename)),
             /* line number */ yystack_[0].location.end.line
         );
       }
-#line 2474 "seclang-parser.cc"
+#line 2784 "seclang-parser.cc"
     break;
 
-  case 81: // expression: "CONFIG_DIR_RULE_ENG" "CONFIG_VALUE_OFF"
-#line 1244 "seclang-parser.yy"
+  case 91: // expression: "CONFIG_DIR_RULE_ENG" "CONFIG_VALUE_OFF"
+#line 1367 "seclang-parser.yy"
       {
         driver.m_secRuleEngine = modsecurity::RulesSet::DisabledRuleEngine;
       }
-#line 2482 "seclang-parser.cc"
+#line 2792 "seclang-parser.cc"
     break;
 
-  case 82: // expression: "CONFIG_DIR_RULE_ENG" "CONFIG_VALUE_ON"
-#line 1248 "seclang-parser.yy"
+  case 92: // expression: "CONFIG_DIR_RULE_ENG" "CONFIG_VALUE_ON"
+#line 1371 "seclang-parser.yy"
       {
         driver.m_secRuleEngine = modsecurity::RulesSet::EnabledRuleEngine;
       }
-#line 2490 "seclang-parser.cc"
+#line 2800 "seclang-parser.cc"
     break;
 
-  case 83: // expression: "CONFIG_DIR_RULE_ENG" "CONFIG_VALUE_DETC"
-#line 1252 "seclang-parser.yy"
+  case 93: // expression: "CONFIG_DIR_RULE_ENG" "CONFIG_VALUE_DETC"
+#line 1375 "seclang-parser.yy"
       {
         driver.m_secRuleEngine = modsecurity::RulesSet::DetectionOnlyRuleEngine;
       }
-#line 2498 "seclang-parser.cc"
+#line 2808 "seclang-parser.cc"
     break;
 
-  case 84: // expression: "CONFIG_DIR_REQ_BODY" "CONFIG_VALUE_ON"
-#line 1256 "seclang-parser.yy"
+  case 94: // expression: "CONFIG_DIR_REQ_BODY" "CONFIG_VALUE_ON"
+#line 1379 "seclang-parser.yy"
       {
         driver.m_secRequestBodyAccess = modsecurity::RulesSetProperties::TrueConfigBoolean;
       }
-#line 2506 "seclang-parser.cc"
+#line 2816 "seclang-parser.cc"
     break;
 
-  case 85: // expression: "CONFIG_DIR_REQ_BODY" "CONFIG_VALUE_OFF"
-#line 1260 "seclang-parser.yy"
+  case 95: // expression: "CONFIG_DIR_REQ_BODY" "CONFIG_VALUE_OFF"
+#line 1383 "seclang-parser.yy"
       {
         driver.m_secRequestBodyAccess = modsecurity::RulesSetProperties::FalseConfigBoolean;
       }
-#line 2514 "seclang-parser.cc"
+#line 2824 "seclang-parser.cc"
     break;
 
-  case 86: // expression: "CONFIG_DIR_RES_BODY" "CONFIG_VALUE_ON"
-#line 1264 "seclang-parser.yy"
+  case 96: // expression: "CONFIG_DIR_RES_BODY" "CONFIG_VALUE_ON"
+#line 1387 "seclang-parser.yy"
       {
         driver.m_secResponseBodyAccess = modsecurity::RulesSetProperties::TrueConfigBoolean;
       }
-#line 2522 "seclang-parser.cc"
+#line 2832 "seclang-parser.cc"
     break;
 
-  case 87: // expression: "CONFIG_DIR_RES_BODY" "CONFIG_VALUE_OFF"
-#line 1268 "seclang-parser.yy"
+  case 97: // expression: "CONFIG_DIR_RES_BODY" "CONFIG_VALUE_OFF"
+#line 1391 "seclang-parser.yy"
       {
         driver.m_secResponseBodyAccess = modsecurity::RulesSetProperties::FalseConfigBoolean;
       }
-#line 2530 "seclang-parser.cc"
+#line 2840 "seclang-parser.cc"
     break;
 
-  case 88: // expression: "CONFIG_SEC_ARGUMENT_SEPARATOR"
-#line 1272 "seclang-parser.yy"
+  case 98: // expression: "CONFIG_SEC_ARGUMENT_SEPARATOR"
+#line 1395 "seclang-parser.yy"
       {
         if (yystack_[0].value.as < std::string > ().length() != 1) {
           driver.error(yystack_[1].location, "Argument separator should be set to a single character.");
@@ -2539,259 +2849,283 @@ namespace yy {
         driver.m_secArgumentSeparator.m_value = yystack_[0].value.as < std::string > ();
         driver.m_secArgumentSeparator.m_set = true;
       }
-#line 2543 "seclang-parser.cc"
+#line 2853 "seclang-parser.cc"
     break;
 
-  case 89: // expression: "CONFIG_COMPONENT_SIG"
-#line 1281 "seclang-parser.yy"
+  case 99: // expression: "CONFIG_COMPONENT_SIG"
+#line 1404 "seclang-parser.yy"
       {
         driver.m_components.push_back(yystack_[0].value.as < std::string > ());
       }
-#line 2551 "seclang-parser.cc"
+#line 2861 "seclang-parser.cc"
     break;
 
-  case 90: // expression: "CONFIG_CONN_ENGINE" "CONFIG_VALUE_ON"
-#line 1285 "seclang-parser.yy"
+  case 100: // expression: "CONFIG_CONN_ENGINE" "CONFIG_VALUE_ON"
+#line 1408 "seclang-parser.yy"
       {
         driver.error(yystack_[2].location, "SecConnEngine is not yet supported.");
         YYERROR;
       }
-#line 2560 "seclang-parser.cc"
+#line 2870 "seclang-parser.cc"
     break;
 
-  case 91: // expression: "CONFIG_CONN_ENGINE" "CONFIG_VALUE_OFF"
-#line 1290 "seclang-parser.yy"
+  case 101: // expression: "CONFIG_CONN_ENGINE" "CONFIG_VALUE_OFF"
+#line 1413 "seclang-parser.yy"
       {
       }
-#line 2567 "seclang-parser.cc"
+#line 2877 "seclang-parser.cc"
     break;
 
-  case 92: // expression: "CONFIG_SEC_WEB_APP_ID"
-#line 1293 "seclang-parser.yy"
+  case 102: // expression: "CONFIG_SEC_WEB_APP_ID"
+#line 1416 "seclang-parser.yy"
       {
         driver.m_secWebAppId.m_value = yystack_[0].value.as < std::string > ();
         driver.m_secWebAppId.m_set = true;
       }
-#line 2576 "seclang-parser.cc"
+#line 2886 "seclang-parser.cc"
     break;
 
-  case 93: // expression: "CONFIG_SEC_SERVER_SIG"
-#line 1298 "seclang-parser.yy"
+  case 103: // expression: "CONFIG_SEC_SERVER_SIG"
+#line 1421 "seclang-parser.yy"
       {
         driver.error(yystack_[1].location, "SecServerSignature is not supported.");
         YYERROR;
       }
-#line 2585 "seclang-parser.cc"
+#line 2895 "seclang-parser.cc"
     break;
 
-  case 94: // expression: "CONFIG_SEC_CACHE_TRANSFORMATIONS"
-#line 1303 "seclang-parser.yy"
+  case 104: // expression: "CONFIG_SEC_CACHE_TRANSFORMATIONS"
+#line 1426 "seclang-parser.yy"
       {
-        driver.error(yystack_[1].location, "SecCacheTransformations is not supported.");
-        YYERROR;
+        std::string error;
+        if (driver.m_transformationsCache.load(yystack_[0].value.as < std::string > (), &error) == false) {
+            driver.error(yystack_[1].location, error);
+            YYERROR;
+        }
       }
-#line 2594 "seclang-parser.cc"
+#line 2907 "seclang-parser.cc"
     break;
 
-  case 95: // expression: "CONFIG_SEC_DISABLE_BACKEND_COMPRESS" "CONFIG_VALUE_ON"
-#line 1308 "seclang-parser.yy"
+  case 105: // expression: "CONFIG_SEC_DISABLE_BACKEND_COMPRESS" "CONFIG_VALUE_ON"
+#line 1434 "seclang-parser.yy"
       {
         driver.error(yystack_[2].location, "SecDisableBackendCompression is not supported.");
         YYERROR;
       }
-#line 2603 "seclang-parser.cc"
+#line 2916 "seclang-parser.cc"
     break;
 
-  case 96: // expression: "CONFIG_SEC_DISABLE_BACKEND_COMPRESS" "CONFIG_VALUE_OFF"
-#line 1313 "seclang-parser.yy"
+  case 106: // expression: "CONFIG_SEC_DISABLE_BACKEND_COMPRESS" "CONFIG_VALUE_OFF"
+#line 1439 "seclang-parser.yy"
       {
       }
-#line 2610 "seclang-parser.cc"
+#line 2923 "seclang-parser.cc"
     break;
 
-  case 97: // expression: "CONFIG_CONTENT_INJECTION" "CONFIG_VALUE_ON"
-#line 1316 "seclang-parser.yy"
+  case 107: // expression: "CONFIG_CONTENT_INJECTION" "CONFIG_VALUE_ON"
+#line 1442 "seclang-parser.yy"
       {
         driver.error(yystack_[2].location, "SecContentInjection is not yet supported.");
         YYERROR;
       }
-#line 2619 "seclang-parser.cc"
+#line 2932 "seclang-parser.cc"
     break;
 
-  case 98: // expression: "CONFIG_CONTENT_INJECTION" "CONFIG_VALUE_OFF"
-#line 1321 "seclang-parser.yy"
+  case 108: // expression: "CONFIG_CONTENT_INJECTION" "CONFIG_VALUE_OFF"
+#line 1447 "seclang-parser.yy"
       {
       }
-#line 2626 "seclang-parser.cc"
+#line 2939 "seclang-parser.cc"
     break;
 
-  case 99: // expression: "CONFIG_SEC_CHROOT_DIR"
-#line 1324 "seclang-parser.yy"
+  case 109: // expression: "CONFIG_SEC_CHROOT_DIR"
+#line 1450 "seclang-parser.yy"
       {
         driver.error(yystack_[1].location, "SecChrootDir is not supported.");
         YYERROR;
       }
-#line 2635 "seclang-parser.cc"
+#line 2948 "seclang-parser.cc"
     break;
 
-  case 100: // expression: "CONFIG_SEC_HASH_ENGINE" "CONFIG_VALUE_ON"
-#line 1329 "seclang-parser.yy"
+  case 110: // expression: "CONFIG_SEC_HASH_ENGINE" "CONFIG_VALUE_ON"
+#line 1455 "seclang-parser.yy"
       {
         driver.error(yystack_[2].location, "SecHashEngine is not yet supported.");
         YYERROR;
       }
-#line 2644 "seclang-parser.cc"
+#line 2957 "seclang-parser.cc"
     break;
 
-  case 101: // expression: "CONFIG_SEC_HASH_ENGINE" "CONFIG_VALUE_OFF"
-#line 1334 "seclang-parser.yy"
+  case 111: // expression: "CONFIG_SEC_HASH_ENGINE" "CONFIG_VALUE_OFF"
+#line 1460 "seclang-parser.yy"
       {
       }
-#line 2651 "seclang-parser.cc"
+#line 2964 "seclang-parser.cc"
     break;
 
-  case 102: // expression: "CONFIG_SEC_HASH_KEY"
-#line 1337 "seclang-parser.yy"
+  case 112: // expression: "CONFIG_SEC_HASH_KEY"
+#line 1463 "seclang-parser.yy"
       {
         driver.error(yystack_[1].location, "SecHashKey is not yet supported.");
         YYERROR;
       }
-#line 2660 "seclang-parser.cc"
+#line 2973 "seclang-parser.cc"
     break;
 
-  case 103: // expression: "CONFIG_SEC_HASH_PARAM"
-#line 1342 "seclang-parser.yy"
+  case 113: // expression: "CONFIG_SEC_HASH_PARAM"
+#line 1468 "seclang-parser.yy"
       {
         driver.error(yystack_[1].location, "SecHashParam is not yet supported.");
         YYERROR;
       }
-#line 2669 "seclang-parser.cc"
+#line 2982 "seclang-parser.cc"
     break;
 
-  case 104: // expression: "CONFIG_SEC_HASH_METHOD_RX"
-#line 1347 "seclang-parser.yy"
+  case 114: // expression: "CONFIG_SEC_HASH_METHOD_RX"
+#line 1473 "seclang-parser.yy"
       {
         driver.error(yystack_[1].location, "SecHashMethodRx is not yet supported.");
         YYERROR;
       }
-#line 2678 "seclang-parser.cc"
+#line 2991 "seclang-parser.cc"
     break;
 
-  case 105: // expression: "CONFIG_SEC_HASH_METHOD_PM"
-#line 1352 "seclang-parser.yy"
+  case 115: // expression: "CONFIG_SEC_HASH_METHOD_PM"
+#line 1478 "seclang-parser.yy"
       {
         driver.error(yystack_[1].location, "SecHashMethodPm is not yet supported.");
         YYERROR;
       }
-#line 2687 "seclang-parser.cc"
+#line 3000 "seclang-parser.cc"
     break;
 
-  case 106: // expression: "CONFIG_DIR_GSB_DB"
-#line 1357 "seclang-parser.yy"
+  case 116: // expression: "CONFIG_DIR_GSB_DB"
+#line 1483 "seclang-parser.yy"
       {
-        driver.error(yystack_[1].location, "SecGsbLookupDb is not supported.");
-        YYERROR;
+        std::vector<std::string> param;
+        for (const std::string &a : utils::string::ssplit(yystack_[0].value.as < std::string > (), ' ')) {
+            if (a.empty() == false) {
+                param.push_back(a);
+            }
+        }
+        std::string file(param.empty() ? "" : param[0]);
+        std::string error;
+        if (file.size() > 1 && file.front() == '"' && file.back() == '"') {
+            file = file.substr(1, file.size() - 2);
+        }
+        if (file.empty() == false && file[0] != '/') {
+            std::string err;
+            std::string resolved = modsecurity::utils::find_resource(file, *yystack_[1].location.end.filename, &err);
+            if (resolved.empty() == false) {
+                file = resolved;
+            }
+        }
+        if (param.size() > 2 || file.empty()
+            || Utils::Gsb::getInstance().configure(file, param.size() > 1 ? param[1] : "", &error) == false) {
+            driver.error(yystack_[1].location, "SecGsbLookupDb: " + (error.empty() ? "expects a file and optionally an API key" : error));
+            YYERROR;
+        }
       }
-#line 2696 "seclang-parser.cc"
+#line 3030 "seclang-parser.cc"
     break;
 
-  case 107: // expression: "CONFIG_SEC_GUARDIAN_LOG"
-#line 1362 "seclang-parser.yy"
+  case 117: // expression: "CONFIG_SEC_GUARDIAN_LOG"
+#line 1509 "seclang-parser.yy"
       {
         driver.error(yystack_[1].location, "SecGuardianLog is not supported.");
         YYERROR;
       }
-#line 2705 "seclang-parser.cc"
+#line 3039 "seclang-parser.cc"
     break;
 
-  case 108: // expression: "CONFIG_SEC_INTERCEPT_ON_ERROR" "CONFIG_VALUE_ON"
-#line 1367 "seclang-parser.yy"
+  case 118: // expression: "CONFIG_SEC_INTERCEPT_ON_ERROR" "CONFIG_VALUE_ON"
+#line 1514 "seclang-parser.yy"
       {
         driver.error(yystack_[2].location, "SecInterceptOnError is not yet supported.");
         YYERROR;
       }
-#line 2714 "seclang-parser.cc"
+#line 3048 "seclang-parser.cc"
     break;
 
-  case 109: // expression: "CONFIG_SEC_INTERCEPT_ON_ERROR" "CONFIG_VALUE_OFF"
-#line 1372 "seclang-parser.yy"
+  case 119: // expression: "CONFIG_SEC_INTERCEPT_ON_ERROR" "CONFIG_VALUE_OFF"
+#line 1519 "seclang-parser.yy"
       {
       }
-#line 2721 "seclang-parser.cc"
+#line 3055 "seclang-parser.cc"
     break;
 
-  case 110: // expression: "CONFIG_SEC_CONN_R_STATE_LIMIT"
-#line 1375 "seclang-parser.yy"
+  case 120: // expression: "CONFIG_SEC_CONN_R_STATE_LIMIT"
+#line 1522 "seclang-parser.yy"
       {
         driver.error(yystack_[1].location, "SecConnReadStateLimit is not yet supported.");
         YYERROR;
       }
-#line 2730 "seclang-parser.cc"
+#line 3064 "seclang-parser.cc"
     break;
 
-  case 111: // expression: "CONFIG_SEC_CONN_W_STATE_LIMIT"
-#line 1380 "seclang-parser.yy"
+  case 121: // expression: "CONFIG_SEC_CONN_W_STATE_LIMIT"
+#line 1527 "seclang-parser.yy"
       {
         driver.error(yystack_[1].location, "SecConnWriteStateLimit is not yet supported.");
         YYERROR;
       }
-#line 2739 "seclang-parser.cc"
+#line 3073 "seclang-parser.cc"
     break;
 
-  case 112: // expression: "CONFIG_SEC_SENSOR_ID"
-#line 1385 "seclang-parser.yy"
+  case 122: // expression: "CONFIG_SEC_SENSOR_ID"
+#line 1532 "seclang-parser.yy"
       {
         driver.error(yystack_[1].location, "SecSensorId is not yet supported.");
         YYERROR;
       }
-#line 2748 "seclang-parser.cc"
+#line 3082 "seclang-parser.cc"
     break;
 
-  case 113: // expression: "CONFIG_SEC_RULE_INHERITANCE" "CONFIG_VALUE_ON"
-#line 1390 "seclang-parser.yy"
+  case 123: // expression: "CONFIG_SEC_RULE_INHERITANCE" "CONFIG_VALUE_ON"
+#line 1537 "seclang-parser.yy"
       {
         driver.error(yystack_[2].location, "SecRuleInheritance is not yet supported.");
         YYERROR;
       }
-#line 2757 "seclang-parser.cc"
+#line 3091 "seclang-parser.cc"
     break;
 
-  case 114: // expression: "CONFIG_SEC_RULE_INHERITANCE" "CONFIG_VALUE_OFF"
-#line 1395 "seclang-parser.yy"
+  case 124: // expression: "CONFIG_SEC_RULE_INHERITANCE" "CONFIG_VALUE_OFF"
+#line 1542 "seclang-parser.yy"
       {
       }
-#line 2764 "seclang-parser.cc"
+#line 3098 "seclang-parser.cc"
     break;
 
-  case 115: // expression: "CONFIG_SEC_RULE_PERF_TIME"
-#line 1398 "seclang-parser.yy"
+  case 125: // expression: "CONFIG_SEC_RULE_PERF_TIME"
+#line 1545 "seclang-parser.yy"
       {
         driver.error(yystack_[1].location, "SecRulePerfTime is not yet supported.");
         YYERROR;
       }
-#line 2773 "seclang-parser.cc"
+#line 3107 "seclang-parser.cc"
     break;
 
-  case 116: // expression: "CONFIG_SEC_STREAM_IN_BODY_INSPECTION"
-#line 1403 "seclang-parser.yy"
+  case 126: // expression: "CONFIG_SEC_STREAM_IN_BODY_INSPECTION"
+#line 1550 "seclang-parser.yy"
       {
         driver.error(yystack_[1].location, "SecStreamInBodyInspection is not supported.");
         YYERROR;
       }
-#line 2782 "seclang-parser.cc"
+#line 3116 "seclang-parser.cc"
     break;
 
-  case 117: // expression: "CONFIG_SEC_STREAM_OUT_BODY_INSPECTION"
-#line 1408 "seclang-parser.yy"
+  case 127: // expression: "CONFIG_SEC_STREAM_OUT_BODY_INSPECTION"
+#line 1555 "seclang-parser.yy"
       {
         driver.error(yystack_[1].location, "SecStreamOutBodyInspection is not supported.");
         YYERROR;
       }
-#line 2791 "seclang-parser.cc"
+#line 3125 "seclang-parser.cc"
     break;
 
-  case 118: // expression: "CONFIG_SEC_RULE_REMOVE_BY_ID"
-#line 1413 "seclang-parser.yy"
+  case 128: // expression: "CONFIG_SEC_RULE_REMOVE_BY_ID"
+#line 1560 "seclang-parser.yy"
       {
         std::string error;
         if (driver.m_exceptions.load(yystack_[0].value.as < std::string > (), &error) == false) {
@@ -2804,11 +3138,11 @@ namespace yy {
             YYERROR;
         }
       }
-#line 2808 "seclang-parser.cc"
+#line 3142 "seclang-parser.cc"
     break;
 
-  case 119: // expression: "CONFIG_SEC_RULE_REMOVE_BY_TAG"
-#line 1426 "seclang-parser.yy"
+  case 129: // expression: "CONFIG_SEC_RULE_REMOVE_BY_TAG"
+#line 1573 "seclang-parser.yy"
       {
         std::string error;
         if (driver.m_exceptions.loadRemoveRuleByTag(yystack_[0].value.as < std::string > (), &error) == false) {
@@ -2821,11 +3155,11 @@ namespace yy {
             YYERROR;
         }
       }
-#line 2825 "seclang-parser.cc"
+#line 3159 "seclang-parser.cc"
     break;
 
-  case 120: // expression: "CONFIG_SEC_RULE_REMOVE_BY_MSG"
-#line 1439 "seclang-parser.yy"
+  case 130: // expression: "CONFIG_SEC_RULE_REMOVE_BY_MSG"
+#line 1586 "seclang-parser.yy"
       {
         std::string error;
         if (driver.m_exceptions.loadRemoveRuleByMsg(yystack_[0].value.as < std::string > (), &error) == false) {
@@ -2838,11 +3172,11 @@ namespace yy {
             YYERROR;
         }
       }
-#line 2842 "seclang-parser.cc"
+#line 3176 "seclang-parser.cc"
     break;
 
-  case 121: // expression: "CONFIG_SEC_RULE_UPDATE_TARGET_BY_TAG" variables_pre_process
-#line 1452 "seclang-parser.yy"
+  case 131: // expression: "CONFIG_SEC_RULE_UPDATE_TARGET_BY_TAG" variables_pre_process
+#line 1599 "seclang-parser.yy"
       {
         std::string error;
         if (driver.m_exceptions.loadUpdateTargetByTag(yystack_[1].value.as < std::string > (), std::move(yystack_[0].value.as < std::unique_ptr<std::vector<std::unique_ptr<Variable> > >  > ()), &error) == false) {
@@ -2855,11 +3189,11 @@ namespace yy {
             YYERROR;
         }
       }
-#line 2859 "seclang-parser.cc"
+#line 3193 "seclang-parser.cc"
     break;
 
-  case 122: // expression: "CONFIG_SEC_RULE_UPDATE_TARGET_BY_MSG" variables_pre_process
-#line 1465 "seclang-parser.yy"
+  case 132: // expression: "CONFIG_SEC_RULE_UPDATE_TARGET_BY_MSG" variables_pre_process
+#line 1612 "seclang-parser.yy"
       {
         std::string error;
         if (driver.m_exceptions.loadUpdateTargetByMsg(yystack_[1].value.as < std::string > (), std::move(yystack_[0].value.as < std::unique_ptr<std::vector<std::unique_ptr<Variable> > >  > ()), &error) == false) {
@@ -2872,11 +3206,11 @@ namespace yy {
             YYERROR;
         }
       }
-#line 2876 "seclang-parser.cc"
+#line 3210 "seclang-parser.cc"
     break;
 
-  case 123: // expression: "CONFIG_SEC_RULE_UPDATE_TARGET_BY_ID" variables_pre_process
-#line 1478 "seclang-parser.yy"
+  case 133: // expression: "CONFIG_SEC_RULE_UPDATE_TARGET_BY_ID" variables_pre_process
+#line 1625 "seclang-parser.yy"
       {
         std::string error;
         double ruleId;
@@ -2902,11 +3236,11 @@ namespace yy {
             YYERROR;
         }
       }
-#line 2906 "seclang-parser.cc"
+#line 3240 "seclang-parser.cc"
     break;
 
-  case 124: // expression: "CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID" actions
-#line 1504 "seclang-parser.yy"
+  case 134: // expression: "CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID" actions
+#line 1651 "seclang-parser.yy"
       {
         std::string error;
         double ruleId;
@@ -2933,11 +3267,11 @@ namespace yy {
             YYERROR;
         }
       }
-#line 2937 "seclang-parser.cc"
+#line 3271 "seclang-parser.cc"
     break;
 
-  case 125: // expression: "CONFIG_DIR_DEBUG_LVL"
-#line 1532 "seclang-parser.yy"
+  case 135: // expression: "CONFIG_DIR_DEBUG_LVL"
+#line 1679 "seclang-parser.yy"
       {
         if (driver.m_debugLog != NULL) {
           driver.m_debugLog->setDebugLogLevel(atoi(yystack_[0].value.as < std::string > ().c_str()));
@@ -2949,11 +3283,11 @@ namespace yy {
             YYERROR;
         }
       }
-#line 2953 "seclang-parser.cc"
+#line 3287 "seclang-parser.cc"
     break;
 
-  case 126: // expression: "CONFIG_DIR_DEBUG_LOG"
-#line 1544 "seclang-parser.yy"
+  case 136: // expression: "CONFIG_DIR_DEBUG_LOG"
+#line 1691 "seclang-parser.yy"
       {
         if (driver.m_debugLog != NULL) {
             std::string error;
@@ -2972,11 +3306,11 @@ namespace yy {
             YYERROR;
         }
       }
-#line 2976 "seclang-parser.cc"
+#line 3310 "seclang-parser.cc"
     break;
 
-  case 127: // expression: "CONFIG_DIR_GEO_DB"
-#line 1564 "seclang-parser.yy"
+  case 137: // expression: "CONFIG_DIR_GEO_DB"
+#line 1711 "seclang-parser.yy"
       {
 #if defined(WITH_GEOIP) or defined(WITH_MAXMIND)
         std::string err;
@@ -3003,217 +3337,621 @@ namespace yy {
         YYERROR;
 #endif  // WITH_GEOIP
       }
-#line 3007 "seclang-parser.cc"
+#line 3341 "seclang-parser.cc"
     break;
 
-  case 128: // expression: "CONFIG_DIR_ARGS_LIMIT"
-#line 1591 "seclang-parser.yy"
+  case 138: // expression: "CONFIG_DIR_ARGS_LIMIT"
+#line 1738 "seclang-parser.yy"
       {
         driver.m_argumentsLimit.m_set = true;
         driver.m_argumentsLimit.m_value = atoi(yystack_[0].value.as < std::string > ().c_str());
       }
-#line 3016 "seclang-parser.cc"
+#line 3350 "seclang-parser.cc"
+    break;
+
+  case 139: // expression: "CONFIG_DIR_REQ_BODY_DECOMPRESSION" "CONFIG_VALUE_OFF"
+#line 1743 "seclang-parser.yy"
+      {
+        driver.m_requestBodyDecompression = modsecurity::RulesSetProperties::FalseConfigBoolean;
+      }
+#line 3358 "seclang-parser.cc"
+    break;
+
+  case 140: // expression: "CONFIG_DIR_REQ_BODY_DECOMPRESSION" "CONFIG_VALUE_ON"
+#line 1747 "seclang-parser.yy"
+      {
+#ifdef WITH_ZLIB
+        driver.m_requestBodyDecompression = modsecurity::RulesSetProperties::TrueConfigBoolean;
+#else
+        driver.error(yystack_[2].location, "SecRequestBodyDecompression: ModSecurity was not compiled with zlib support.");
+        YYERROR;
+#endif
+      }
+#line 3371 "seclang-parser.cc"
+    break;
+
+  case 141: // expression: "CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO"
+#line 1756 "seclang-parser.yy"
+      {
+        int ratio = atoi(yystack_[0].value.as < std::string > ().c_str());
+        if (ratio < 1) {
+            driver.error(yystack_[1].location, "SecRequestBodyDecompressionRatio expects a ratio of at least 1.");
+            YYERROR;
+        }
+        driver.m_requestBodyDecompressionRatio.m_set = true;
+        driver.m_requestBodyDecompressionRatio.m_value = ratio;
+      }
+#line 3385 "seclang-parser.cc"
+    break;
+
+  case 142: // expression: "CONFIG_DIR_RES_BODY_DECOMPRESSION" "CONFIG_VALUE_OFF"
+#line 1766 "seclang-parser.yy"
+      {
+        driver.m_responseBodyDecompression = modsecurity::RulesSetProperties::FalseConfigBoolean;
+      }
+#line 3393 "seclang-parser.cc"
     break;
 
-  case 129: // expression: "CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT"
-#line 1596 "seclang-parser.yy"
+  case 143: // expression: "CONFIG_DIR_RES_BODY_DECOMPRESSION" "CONFIG_VALUE_ON"
+#line 1770 "seclang-parser.yy"
+      {
+#ifdef WITH_ZLIB
+        driver.m_responseBodyDecompression = modsecurity::RulesSetProperties::TrueConfigBoolean;
+#else
+        driver.error(yystack_[2].location, "SecResponseBodyDecompression: ModSecurity was not compiled with zlib support.");
+        YYERROR;
+#endif
+      }
+#line 3406 "seclang-parser.cc"
+    break;
+
+  case 144: // expression: "CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT"
+#line 1779 "seclang-parser.yy"
       {
         driver.m_requestBodyJsonDepthLimit.m_set = true;
         driver.m_requestBodyJsonDepthLimit.m_value = atoi(yystack_[0].value.as < std::string > ().c_str());
       }
-#line 3025 "seclang-parser.cc"
+#line 3415 "seclang-parser.cc"
+    break;
+
+  case 145: // expression: "CONFIG_DIR_REQ_BODY_JSON_SIMD" "CONFIG_VALUE_OFF"
+#line 1784 "seclang-parser.yy"
+      {
+        driver.m_requestBodyJsonSimd = modsecurity::RulesSetProperties::FalseConfigBoolean;
+      }
+#line 3423 "seclang-parser.cc"
+    break;
+
+  case 146: // expression: "CONFIG_DIR_REQ_BODY_JSON_SIMD" "CONFIG_VALUE_ON"
+#line 1788 "seclang-parser.yy"
+      {
+#ifdef WITH_SIMDJSON
+        driver.m_requestBodyJsonSimd = modsecurity::RulesSetProperties::TrueConfigBoolean;
+#else
+        driver.error(yystack_[2].location, "SecRequestBodyJsonSimd: ModSecurity was not built with simdjson.");
+        YYERROR;
+#endif
+      }
+#line 3436 "seclang-parser.cc"
     break;
 
-  case 130: // expression: "CONFIG_DIR_REQ_BODY_LIMIT"
-#line 1602 "seclang-parser.yy"
+  case 147: // expression: "CONFIG_DIR_REQ_BODY_LIMIT"
+#line 1798 "seclang-parser.yy"
       {
         driver.m_requestBodyLimit.m_set = true;
         driver.m_requestBodyLimit.m_value = atoi(yystack_[0].value.as < std::string > ().c_str());
       }
-#line 3034 "seclang-parser.cc"
+#line 3445 "seclang-parser.cc"
     break;
 
-  case 131: // expression: "CONFIG_DIR_REQ_BODY_NO_FILES_LIMIT"
-#line 1607 "seclang-parser.yy"
+  case 148: // expression: "CONFIG_DIR_REQ_BODY_NO_FILES_LIMIT"
+#line 1803 "seclang-parser.yy"
       {
         driver.m_requestBodyNoFilesLimit.m_set = true;
         driver.m_requestBodyNoFilesLimit.m_value = atoi(yystack_[0].value.as < std::string > ().c_str());
       }
-#line 3043 "seclang-parser.cc"
+#line 3454 "seclang-parser.cc"
     break;
 
-  case 132: // expression: "CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT"
-#line 1612 "seclang-parser.yy"
+  case 149: // expression: "CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT"
+#line 1808 "seclang-parser.yy"
       {
-        std::stringstream ss;
-        ss << "As of ModSecurity version 3.0, SecRequestBodyInMemoryLimit is no longer ";
-        ss << "supported. Instead, you can use your web server configurations to control ";
-        ss << "those values. ModSecurity will follow the web server decision.";
-        driver.error(yystack_[1].location, ss.str());
-        YYERROR;
+        driver.m_requestBodyInMemoryLimit.m_set = true;
+        driver.m_requestBodyInMemoryLimit.m_value = atoi(yystack_[0].value.as < std::string > ().c_str());
       }
-#line 3056 "seclang-parser.cc"
+#line 3463 "seclang-parser.cc"
     break;
 
-  case 133: // expression: "CONFIG_DIR_RES_BODY_LIMIT"
-#line 1621 "seclang-parser.yy"
+  case 150: // expression: "CONFIG_DIR_RES_BODY_LIMIT"
+#line 1813 "seclang-parser.yy"
       {
         driver.m_responseBodyLimit.m_set = true;
         driver.m_responseBodyLimit.m_value = atoi(yystack_[0].value.as < std::string > ().c_str());
       }
-#line 3065 "seclang-parser.cc"
+#line 3472 "seclang-parser.cc"
     break;
 
-  case 134: // expression: "CONFIG_DIR_REQ_BODY_LIMIT_ACTION" "CONFIG_VALUE_PROCESS_PARTIAL"
-#line 1626 "seclang-parser.yy"
+  case 151: // expression: "CONFIG_DIR_REQ_BODY_LIMIT_ACTION" "CONFIG_VALUE_PROCESS_PARTIAL"
+#line 1818 "seclang-parser.yy"
       {
         driver.m_requestBodyLimitAction = modsecurity::RulesSet::BodyLimitAction::ProcessPartialBodyLimitAction;
       }
-#line 3073 "seclang-parser.cc"
+#line 3480 "seclang-parser.cc"
     break;
 
-  case 135: // expression: "CONFIG_DIR_REQ_BODY_LIMIT_ACTION" "CONFIG_VALUE_REJECT"
-#line 1630 "seclang-parser.yy"
+  case 152: // expression: "CONFIG_DIR_REQ_BODY_LIMIT_ACTION" "CONFIG_VALUE_REJECT"
+#line 1822 "seclang-parser.yy"
       {
         driver.m_requestBodyLimitAction = modsecurity::RulesSet::BodyLimitAction::RejectBodyLimitAction;
       }
-#line 3081 "seclang-parser.cc"
+#line 3488 "seclang-parser.cc"
     break;
 
-  case 136: // expression: "CONFIG_DIR_RES_BODY_LIMIT_ACTION" "CONFIG_VALUE_PROCESS_PARTIAL"
-#line 1634 "seclang-parser.yy"
+  case 153: // expression: "CONFIG_DIR_RES_BODY_LIMIT_ACTION" "CONFIG_VALUE_PROCESS_PARTIAL"
+#line 1826 "seclang-parser.yy"
       {
         driver.m_responseBodyLimitAction = modsecurity::RulesSet::BodyLimitAction::ProcessPartialBodyLimitAction;
       }
-#line 3089 "seclang-parser.cc"
+#line 3496 "seclang-parser.cc"
     break;
 
-  case 137: // expression: "CONFIG_DIR_RES_BODY_LIMIT_ACTION" "CONFIG_VALUE_REJECT"
-#line 1638 "seclang-parser.yy"
+  case 154: // expression: "CONFIG_DIR_RES_BODY_LIMIT_ACTION" "CONFIG_VALUE_REJECT"
+#line 1830 "seclang-parser.yy"
       {
         driver.m_responseBodyLimitAction = modsecurity::RulesSet::BodyLimitAction::RejectBodyLimitAction;
       }
-#line 3097 "seclang-parser.cc"
+#line 3504 "seclang-parser.cc"
+    break;
+
+  case 155: // expression: "CONFIG_DIR_RES_BODY_STREAM_WINDOW"
+#line 1834 "seclang-parser.yy"
+      {
+        driver.m_responseBodyStreamWindow.m_set = true;
+        driver.m_responseBodyStreamWindow.m_value = atoi(yystack_[0].value.as < std::string > ().c_str());
+      }
+#line 3513 "seclang-parser.cc"
+    break;
+
+  case 156: // expression: "CONFIG_SEC_REMOTE_RULES_CACHE_DIR"
+#line 1839 "seclang-parser.yy"
+      {
+        /* process wide, and set right away: the downloads are done while scanning */
+        std::string error;
+        if (Utils::DownloadCache::getInstance().setDirectory(yystack_[0].value.as < std::string > (), &error) == false) {
+            driver.error(yystack_[1].location, "SecRemoteRulesCacheDir: " + error);
+            YYERROR;
+        }
+      }
+#line 3526 "seclang-parser.cc"
     break;
 
-  case 138: // expression: "CONFIG_SEC_REMOTE_RULES_FAIL_ACTION" "CONFIG_VALUE_ABORT"
-#line 1642 "seclang-parser.yy"
+  case 157: // expression: "CONFIG_SEC_REMOTE_RULES_FAIL_ACTION" "CONFIG_VALUE_ABORT"
+#line 1848 "seclang-parser.yy"
       {
         driver.m_remoteRulesActionOnFailed = RulesSet::OnFailedRemoteRulesAction::AbortOnFailedRemoteRulesAction;
       }
-#line 3105 "seclang-parser.cc"
+#line 3534 "seclang-parser.cc"
     break;
 
-  case 139: // expression: "CONFIG_SEC_REMOTE_RULES_FAIL_ACTION" "CONFIG_VALUE_WARN"
-#line 1646 "seclang-parser.yy"
+  case 158: // expression: "CONFIG_SEC_REMOTE_RULES_FAIL_ACTION" "CONFIG_VALUE_WARN"
+#line 1852 "seclang-parser.yy"
       {
         driver.m_remoteRulesActionOnFailed = RulesSet::OnFailedRemoteRulesAction::WarnOnFailedRemoteRulesAction;
       }
-#line 3113 "seclang-parser.cc"
+#line 3542 "seclang-parser.cc"
     break;
 
-  case 141: // expression: "CONFIG_DIR_PCRE_MATCH_LIMIT"
-#line 1655 "seclang-parser.yy"
+  case 160: // expression: "CONFIG_DIR_DATA_RELOAD_INTERVAL"
+#line 1861 "seclang-parser.yy"
       {
-        driver.m_pcreMatchLimit.m_set = true;
-        driver.m_pcreMatchLimit.m_value = atoi(yystack_[0].value.as < std::string > ().c_str());
+        driver.m_dataReloadInterval.m_set = true;
+        driver.m_dataReloadInterval.m_value = atoi(yystack_[0].value.as < std::string > ().c_str());
       }
-#line 3122 "seclang-parser.cc"
+#line 3551 "seclang-parser.cc"
     break;
 
-  case 142: // expression: "CONGIG_DIR_RESPONSE_BODY_MP"
-#line 1660 "seclang-parser.yy"
+  case 161: // expression: "CONFIG_DIR_LUA_STATE_POOL_LIMIT"
+#line 1866 "seclang-parser.yy"
       {
-        std::istringstream buf(yystack_[0].value.as < std::string > ());
-        std::istream_iterator<std::string> beg(buf), end;
-        std::set<std::string> tokens(beg, end);
-        driver.m_responseBodyTypeToBeInspected.m_set = true;
-        for (std::set<std::string>::iterator it=tokens.begin();
-            it!=tokens.end(); ++it)
-        {
-            driver.m_responseBodyTypeToBeInspected.m_value.insert(*it);
-        }
+        driver.m_luaStatePoolLimit.m_set = true;
+        driver.m_luaStatePoolLimit.m_value = atoi(yystack_[0].value.as < std::string > ().c_str());
       }
-#line 3138 "seclang-parser.cc"
+#line 3560 "seclang-parser.cc"
     break;
 
-  case 143: // expression: "CONGIG_DIR_RESPONSE_BODY_MP_CLEAR"
-#line 1672 "seclang-parser.yy"
+  case 162: // expression: "CONFIG_DIR_PCRE_JIT_STACK_SIZE"
+#line 1871 "seclang-parser.yy"
       {
-        driver.m_responseBodyTypeToBeInspected.m_set = true;
-        driver.m_responseBodyTypeToBeInspected.m_clear = true;
-        driver.m_responseBodyTypeToBeInspected.m_value.clear();
+        driver.m_pcreJitStackSize.m_set = true;
+        driver.m_pcreJitStackSize.m_value = atoi(yystack_[0].value.as < std::string > ().c_str());
       }
-#line 3148 "seclang-parser.cc"
+#line 3569 "seclang-parser.cc"
     break;
 
-  case 144: // expression: "CONFIG_XML_EXTERNAL_ENTITY" "CONFIG_VALUE_OFF"
-#line 1678 "seclang-parser.yy"
+  case 163: // expression: "CONFIG_DIR_PCRE_MATCH_LIMIT"
+#line 1876 "seclang-parser.yy"
       {
-        driver.m_secXMLExternalEntity = modsecurity::RulesSetProperties::FalseConfigBoolean;
+        driver.m_pcreMatchLimit.m_set = true;
+        driver.m_pcreMatchLimit.m_value = atoi(yystack_[0].value.as < std::string > ().c_str());
       }
-#line 3156 "seclang-parser.cc"
+#line 3578 "seclang-parser.cc"
     break;
 
-  case 145: // expression: "CONFIG_XML_EXTERNAL_ENTITY" "CONFIG_VALUE_ON"
-#line 1682 "seclang-parser.yy"
+  case 164: // expression: "CONFIG_DIR_RBL_TIMEOUT"
+#line 1881 "seclang-parser.yy"
       {
-        driver.m_secXMLExternalEntity = modsecurity::RulesSetProperties::TrueConfigBoolean;
+        driver.m_rblTimeout.m_set = true;
+        driver.m_rblTimeout.m_value = atoi(yystack_[0].value.as < std::string > ().c_str());
       }
-#line 3164 "seclang-parser.cc"
+#line 3587 "seclang-parser.cc"
     break;
 
-  case 146: // expression: "CONGIG_DIR_SEC_TMP_DIR"
-#line 1686 "seclang-parser.yy"
+  case 165: // expression: "CONFIG_DIR_RULE_EARLY_DECISION"
+#line 1886 "seclang-parser.yy"
       {
-/* Parser error disabled to avoid breaking default installations with modsecurity.conf-recommended
-        std::stringstream ss;
-        ss << "As of ModSecurity version 3.0, SecTmpDir is no longer supported.";
-        ss << " Instead, you can use your web server configurations to control when";
-        ss << "and where to swap. ModSecurity will follow the web server decision.";
-        driver.error(@0, ss.str());
-        YYERROR;
-*/
+        std::vector<std::string> args;
+        for (const std::string &a : utils::string::ssplit(yystack_[0].value.as < std::string > (), ' ')) {
+            if (a.empty() == false) {
+                args.push_back(a);
+            }
+        }
+        std::string variable = args.empty() ? ""
+            : utils::string::tolower(args[0]);
+        if (variable.compare(0, 3, "tx:") == 0
+            || variable.compare(0, 3, "tx.") == 0) {
+            variable = variable.substr(3);
+        } else {
+            variable.clear();
+        }
+        char *end = nullptr;
+        long threshold = args.size() > 1
+            ? strtol(args[1].c_str(), &end, 10) : 0;
+        if (args.size() != 3 || variable.empty() || end == args[1].c_str()
+            || *end != '\0') {
+            driver.error(yystack_[1].location, "SecRuleEarlyDecision expects a TX variable, a threshold and a marker, got: " + yystack_[0].value.as < std::string > ());
+            YYERROR;
+        }
+        driver.m_earlyDecisionVariable.m_set = true;
+        driver.m_earlyDecisionVariable.m_value = variable;
+        driver.m_earlyDecisionThreshold.m_set = true;
+        driver.m_earlyDecisionThreshold.m_value = threshold;
+        std::string marker = args[2];
+        if (marker.size() > 2 && marker.front() == '"'
+            && marker.back() == '"') {
+            marker = marker.substr(1, marker.size() - 2);
+        }
+        driver.m_earlyDecisionMarker.m_set = true;
+        driver.m_earlyDecisionMarker.m_value = marker;
       }
-#line 3179 "seclang-parser.cc"
+#line 3627 "seclang-parser.cc"
     break;
 
-  case 149: // expression: "CONGIG_DIR_SEC_COOKIE_FORMAT"
-#line 1707 "seclang-parser.yy"
+  case 166: // expression: "CONFIG_DIR_OVERLOAD_TARGET"
+#line 1922 "seclang-parser.yy"
       {
-        if (atoi(yystack_[0].value.as < std::string > ().c_str()) == 1) {
-          driver.error(yystack_[1].location, "SecCookieFormat 1 is not yet supported.");
-          YYERROR;
+        std::vector<std::string> args;
+        for (const std::string &a : utils::string::ssplit(yystack_[0].value.as < std::string > (), ' ')) {
+            if (a.empty() == false) {
+                args.push_back(a);
+            }
         }
+        long values[2] = { 0, 1000 };
+        bool valid = args.size() == 1 || args.size() == 2;
+        for (size_t i = 0; valid && i < args.size(); i++) {
+            char *end = nullptr;
+            values[i] = strtol(args[i].c_str(), &end, 10);
+            valid = end != args[i].c_str() && *end == '\0' && values[i] > 0;
+        }
+        if (valid == false) {
+            driver.error(yystack_[1].location, "SecOverloadTarget expects a p99 in microseconds and optionally a number of transactions, got: " + yystack_[0].value.as < std::string > ());
+            YYERROR;
+        }
+        driver.m_overloadTarget.m_set = true;
+        driver.m_overloadTarget.m_value = values[0];
+        driver.m_overloadWindow.m_set = true;
+        driver.m_overloadWindow.m_value = values[1];
       }
-#line 3190 "seclang-parser.cc"
+#line 3655 "seclang-parser.cc"
     break;
 
-  case 150: // expression: "CONFIG_SEC_COOKIEV0_SEPARATOR"
-#line 1714 "seclang-parser.yy"
+  case 167: // expression: "CONFIG_DIR_OVERLOAD_SHED_TAG"
+#line 1946 "seclang-parser.yy"
       {
-        driver.error(yystack_[1].location, "SecCookieV0Separator is not yet supported.");
-        YYERROR;
+        std::string tag = yystack_[0].value.as < std::string > ();
+        if (tag.size() > 2 && tag.front() == '"' && tag.back() == '"') {
+            tag = tag.substr(1, tag.size() - 2);
+        }
+        driver.m_overloadShedTags.m_set = true;
+        driver.m_overloadShedTags.m_value.insert(tag);
       }
-#line 3199 "seclang-parser.cc"
+#line 3668 "seclang-parser.cc"
     break;
 
-  case 152: // expression: "CONFIG_DIR_UNICODE_MAP_FILE"
-#line 1724 "seclang-parser.yy"
+  case 168: // expression: "CONFIG_DIR_OVERLOAD_DETECTION_ONLY"
+#line 1955 "seclang-parser.yy"
       {
-        std::string error;
-        std::vector<std::string> param;
-        double num = 0;
-        std::string f;
-        std::string file;
-        std::string err;
-        param = utils::string::ssplit(yystack_[0].value.as < std::string > (), ' ');
-        if (param.size() <= 1) {
-            std::stringstream ss;
-            ss << "Failed to process unicode map, missing ";
-            ss << "parameter: " << yystack_[0].value.as < std::string > () << " ";
-            driver.error(yystack_[1].location, ss.str());
-            YYERROR;
+        driver.m_overloadDetectionOnly.m_set = true;
+        for (const std::string &a : utils::string::ssplit(yystack_[0].value.as < std::string > (), ' ')) {
+            if (a.empty() == false) {
+                driver.m_overloadDetectionOnly.m_value.insert(
+                    utils::string::toupper(a));
+            }
+        }
+      }
+#line 3682 "seclang-parser.cc"
+    break;
+
+  case 169: // expression: "CONFIG_DIR_RULE_EVALUATION_THREADS"
+#line 1965 "seclang-parser.yy"
+      {
+        driver.m_ruleEvaluationThreads.m_set = true;
+        driver.m_ruleEvaluationThreads.m_value = atoi(yystack_[0].value.as < std::string > ().c_str());
+      }
+#line 3691 "seclang-parser.cc"
+    break;
+
+  case 170: // expression: "CONFIG_DIR_RULE_ENG_SAMPLE_RATE"
+#line 1970 "seclang-parser.yy"
+      {
+        /* <percent>[%] [transaction|client], kept in hundredths of a percent */
+        std::stringstream ss(yystack_[0].value.as < std::string > ());
+        std::string rate;
+        std::string key;
+        ss >> rate >> key;
+        if (rate.empty() == false && rate.back() == '%') {
+            rate.pop_back();
+        }
+        double percent = atof(rate.c_str());
+        if (percent < 0 || percent > 100) {
+            driver.error(yystack_[1].location, "SecRuleEngineSampleRate expects a percentage from 0 to 100.");
+            YYERROR;
+        }
+        key = utils::string::tolower(key);
+        if (key.empty() == false && key != "transaction" && key != "client") {
+            driver.error(yystack_[1].location, "SecRuleEngineSampleRate samples by transaction or by client, not by " + key + ".");
+            YYERROR;
+        }
+        driver.m_ruleEngineSampleRate.m_set = true;
+        driver.m_ruleEngineSampleRate.m_value =
+            static_cast<int>(percent * 100 + 0.5);
+        driver.m_ruleEngineSampleKey.m_set = true;
+        driver.m_ruleEngineSampleKey.m_value = key == "client" ? 1 : 0;
+      }
+#line 3721 "seclang-parser.cc"
+    break;
+
+  case 171: // expression: "CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE"
+#line 1996 "seclang-parser.yy"
+      {
+        driver.m_ruleProfilingSampleRate.m_set = true;
+        driver.m_ruleProfilingSampleRate.m_value = atoi(yystack_[0].value.as < std::string > ().c_str());
+      }
+#line 3730 "seclang-parser.cc"
+    break;
+
+  case 172: // expression: "CONFIG_DIR_RX_GUARDRAIL"
+#line 2001 "seclang-parser.yy"
+      {
+        int factor = atoi(yystack_[0].value.as < std::string > ().c_str());
+        if (factor < 2) {
+            driver.error(yystack_[1].location, "SecRxGuardrail expects a factor of at " \
+                "least 2, not: " + yystack_[0].value.as < std::string > ());
+            YYERROR;
+        }
+        driver.m_rxGuardrail.m_set = true;
+        driver.m_rxGuardrail.m_value = factor;
+      }
+#line 3745 "seclang-parser.cc"
+    break;
+
+  case 173: // expression: "CONFIG_DIR_REGEX_CACHE_FILE"
+#line 2012 "seclang-parser.yy"
+      {
+        std::string err;
+        driver.m_regexStore.reset(new Utils::RegexStore());
+        if (driver.m_regexStore->open(yystack_[0].value.as < std::string > (), &err) == false) {
+            driver.error(yystack_[1].location, err);
+            YYERROR;
+        }
+      }
+#line 3758 "seclang-parser.cc"
+    break;
+
+  case 174: // expression: "CONFIG_DIR_RULE_NATIVE_MODULE"
+#line 2021 "seclang-parser.yy"
+      {
+        std::string err;
+        std::string file = modsecurity::utils::find_resource(yystack_[0].value.as < std::string > (),
+            *yystack_[0].location.end.filename, &err);
+        if (file.empty()) {
+            driver.error(yystack_[1].location, "Failed to locate the native module " + yystack_[0].value.as < std::string > ()
+                + ". " + err);
+            YYERROR;
+        }
+        driver.m_nativeModule = NativeRules::load(file, &err);
+        if (driver.m_nativeModule == nullptr) {
+            driver.error(yystack_[1].location, err);
+            YYERROR;
+        }
+        driver.m_ruleNativeModule.m_set = true;
+        driver.m_ruleNativeModule.m_value = file;
+      }
+#line 3780 "seclang-parser.cc"
+    break;
+
+  case 175: // expression: "CONFIG_DIR_SHADOW_RULES"
+#line 2039 "seclang-parser.yy"
+      {
+        std::string err;
+        std::string file = modsecurity::utils::find_resource(yystack_[0].value.as < std::string > (),
+            *yystack_[0].location.end.filename, &err);
+        if (file.empty()) {
+            driver.error(yystack_[1].location, "Failed to locate the shadow rules " + yystack_[0].value.as < std::string > ()
+                + ". " + err);
+            YYERROR;
+        }
+        driver.m_shadowRules.m_set = true;
+        driver.m_shadowRules.m_value = file;
+      }
+#line 3797 "seclang-parser.cc"
+    break;
+
+  case 176: // expression: "CONGIG_DIR_RESPONSE_BODY_MP"
+#line 2052 "seclang-parser.yy"
+      {
+        std::istringstream buf(yystack_[0].value.as < std::string > ());
+        std::istream_iterator<std::string> beg(buf), end;
+        std::set<std::string> tokens(beg, end);
+        driver.m_responseBodyTypeToBeInspected.m_set = true;
+        for (std::set<std::string>::iterator it=tokens.begin();
+            it!=tokens.end(); ++it)
+        {
+            driver.m_responseBodyTypeToBeInspected.m_value.insert(*it);
+        }
+      }
+#line 3813 "seclang-parser.cc"
+    break;
+
+  case 177: // expression: "CONGIG_DIR_RESPONSE_BODY_MP_CLEAR"
+#line 2064 "seclang-parser.yy"
+      {
+        driver.m_responseBodyTypeToBeInspected.m_set = true;
+        driver.m_responseBodyTypeToBeInspected.m_clear = true;
+        driver.m_responseBodyTypeToBeInspected.m_value.clear();
+      }
+#line 3823 "seclang-parser.cc"
+    break;
+
+  case 178: // expression: "CONFIG_SEC_RULE_PROFILING" "CONFIG_VALUE_OFF"
+#line 2070 "seclang-parser.yy"
+      {
+        driver.m_secRuleProfiling = modsecurity::RulesSetProperties::FalseConfigBoolean;
+      }
+#line 3831 "seclang-parser.cc"
+    break;
+
+  case 179: // expression: "CONFIG_SEC_RULE_PROFILING" "CONFIG_VALUE_ON"
+#line 2074 "seclang-parser.yy"
+      {
+        driver.m_secRuleProfiling = modsecurity::RulesSetProperties::TrueConfigBoolean;
+      }
+#line 3839 "seclang-parser.cc"
+    break;
+
+  case 180: // expression: "CONFIG_SEC_RULE_VALUE_MAJOR" "CONFIG_VALUE_OFF"
+#line 2078 "seclang-parser.yy"
+      {
+        driver.m_secRuleValueMajor = modsecurity::RulesSetProperties::FalseConfigBoolean;
+      }
+#line 3847 "seclang-parser.cc"
+    break;
+
+  case 181: // expression: "CONFIG_SEC_RULE_VALUE_MAJOR" "CONFIG_VALUE_ON"
+#line 2082 "seclang-parser.yy"
+      {
+        driver.m_secRuleValueMajor = modsecurity::RulesSetProperties::TrueConfigBoolean;
+      }
+#line 3855 "seclang-parser.cc"
+    break;
+
+  case 182: // expression: "CONFIG_SEC_RX_PREFILTER" "CONFIG_VALUE_OFF"
+#line 2086 "seclang-parser.yy"
+      {
+        driver.m_secRxPrefilter = modsecurity::RulesSetProperties::FalseConfigBoolean;
+      }
+#line 3863 "seclang-parser.cc"
+    break;
+
+  case 183: // expression: "CONFIG_SEC_RX_PREFILTER" "CONFIG_VALUE_ON"
+#line 2090 "seclang-parser.yy"
+      {
+        driver.m_secRxPrefilter = modsecurity::RulesSetProperties::TrueConfigBoolean;
+      }
+#line 3871 "seclang-parser.cc"
+    break;
+
+  case 184: // expression: "CONFIG_SEC_RX_RE2" "CONFIG_VALUE_OFF"
+#line 2094 "seclang-parser.yy"
+      {
+        driver.m_secRxRe2 = modsecurity::RulesSetProperties::FalseConfigBoolean;
+      }
+#line 3879 "seclang-parser.cc"
+    break;
+
+  case 185: // expression: "CONFIG_SEC_RX_RE2" "CONFIG_VALUE_ON"
+#line 2098 "seclang-parser.yy"
+      {
+#ifdef WITH_RE2
+        driver.m_secRxRe2 = modsecurity::RulesSetProperties::TrueConfigBoolean;
+#else
+        driver.error(yystack_[2].location, "SecRxRe2: ModSecurity was not compiled with RE2 support.");
+        YYERROR;
+#endif
+      }
+#line 3892 "seclang-parser.cc"
+    break;
+
+  case 186: // expression: "CONFIG_XML_EXTERNAL_ENTITY" "CONFIG_VALUE_OFF"
+#line 2107 "seclang-parser.yy"
+      {
+        driver.m_secXMLExternalEntity = modsecurity::RulesSetProperties::FalseConfigBoolean;
+      }
+#line 3900 "seclang-parser.cc"
+    break;
+
+  case 187: // expression: "CONFIG_XML_EXTERNAL_ENTITY" "CONFIG_VALUE_ON"
+#line 2111 "seclang-parser.yy"
+      {
+        driver.m_secXMLExternalEntity = modsecurity::RulesSetProperties::TrueConfigBoolean;
+      }
+#line 3908 "seclang-parser.cc"
+    break;
+
+  case 188: // expression: "CONGIG_DIR_SEC_TMP_DIR"
+#line 2115 "seclang-parser.yy"
+      {
+        driver.m_tmpDirectory.m_set = true;
+        driver.m_tmpDirectory.m_value = yystack_[0].value.as < std::string > ();
+      }
+#line 3917 "seclang-parser.cc"
+    break;
+
+  case 191: // expression: "CONGIG_DIR_SEC_COOKIE_FORMAT"
+#line 2130 "seclang-parser.yy"
+      {
+        if (atoi(yystack_[0].value.as < std::string > ().c_str()) == 1) {
+          driver.error(yystack_[1].location, "SecCookieFormat 1 is not yet supported.");
+          YYERROR;
+        }
+      }
+#line 3928 "seclang-parser.cc"
+    break;
+
+  case 192: // expression: "CONFIG_SEC_COOKIEV0_SEPARATOR"
+#line 2137 "seclang-parser.yy"
+      {
+        driver.error(yystack_[1].location, "SecCookieV0Separator is not yet supported.");
+        YYERROR;
+      }
+#line 3937 "seclang-parser.cc"
+    break;
+
+  case 194: // expression: "CONFIG_DIR_UNICODE_MAP_FILE"
+#line 2147 "seclang-parser.yy"
+      {
+        std::string error;
+        std::vector<std::string> param;
+        double num = 0;
+        std::string f;
+        std::string file;
+        std::string err;
+        param = utils::string::ssplit(yystack_[0].value.as < std::string > (), ' ');
+        if (param.size() <= 1) {
+            std::stringstream ss;
+            ss << "Failed to process unicode map, missing ";
+            ss << "parameter: " << yystack_[0].value.as < std::string > () << " ";
+            driver.error(yystack_[1].location, ss.str());
+            YYERROR;
         }
 
         try {
@@ -3253,31 +3991,208 @@ namespace yy {
         }
 
       }
-#line 3257 "seclang-parser.cc"
+#line 3995 "seclang-parser.cc"
     break;
 
-  case 153: // expression: "CONFIG_SEC_COLLECTION_TIMEOUT"
-#line 1778 "seclang-parser.yy"
+  case 195: // expression: "CONFIG_SEC_COLLECTION_REDIS_SERVER"
+#line 2201 "seclang-parser.yy"
       {
-/* Parser error disabled to avoid breaking default CRS installations with crs-setup.conf-recommended
-        driver.error(@0, "SecCollectionTimeout is not yet supported.");
-        YYERROR;
-*/
+        std::vector<std::string> args;
+        for (const std::string &a : utils::string::ssplit(yystack_[0].value.as < std::string > (), ' ')) {
+            if (a.empty() == false) {
+                args.push_back(a);
+            }
+        }
+        size_t colon = args.empty() ? std::string::npos : args[0].rfind(':');
+        std::string host;
+        int port = 0;
+        int timeout = args.size() > 1 ? atoi(args[1].c_str()) : 50;
+        if (colon != std::string::npos) {
+            host = args[0].substr(0, colon);
+            port = atoi(args[0].c_str() + colon + 1);
+        }
+        if (host.size() > 2 && host.front() == '[' && host.back() == ']') {
+            host = host.substr(1, host.size() - 2);
+        }
+        if (args.size() > 2 || host.empty() || port <= 0 || port > 65535
+            || timeout <= 0) {
+            driver.error(yystack_[1].location, "SecCollectionRedisServer expects host:port and optionally a timeout in milliseconds, got: " + yystack_[0].value.as < std::string > ());
+            YYERROR;
+        }
+        driver.m_collectionRedisHost.m_set = true;
+        driver.m_collectionRedisHost.m_value = host;
+        driver.m_collectionRedisPort.m_set = true;
+        driver.m_collectionRedisPort.m_value = port;
+        driver.m_collectionRedisTimeout.m_set = true;
+        driver.m_collectionRedisTimeout.m_value = timeout;
+      }
+#line 4030 "seclang-parser.cc"
+    break;
+
+  case 196: // expression: "CONFIG_SEC_COLLECTION_SYNC_MODE"
+#line 2232 "seclang-parser.yy"
+      {
+        std::string mode = utils::string::tolower(yystack_[0].value.as < std::string > ());
+        if (mode == "full") {
+            driver.m_collectionSyncMode.m_value = RulesSetProperties::CollectionSyncFull;
+        } else if (mode == "nometasync") {
+            driver.m_collectionSyncMode.m_value = RulesSetProperties::CollectionSyncNoMetaSync;
+        } else if (mode == "nosync") {
+            driver.m_collectionSyncMode.m_value = RulesSetProperties::CollectionSyncNoSync;
+        } else {
+            driver.error(yystack_[1].location, "SecCollectionSyncMode expects Full, NoMetaSync or NoSync, got: " + yystack_[0].value.as < std::string > ());
+            YYERROR;
+        }
+        driver.m_collectionSyncMode.m_set = true;
+      }
+#line 4049 "seclang-parser.cc"
+    break;
+
+  case 197: // expression: "CONFIG_SEC_TRANSACTION_ID_FORMAT"
+#line 2247 "seclang-parser.yy"
+      {
+        std::string format = utils::string::tolower(yystack_[0].value.as < std::string > ());
+        if (format == "sequential") {
+            driver.m_transactionIdFormat.m_value = RulesSetProperties::TransactionIdSequential;
+        } else if (format == "random") {
+            driver.m_transactionIdFormat.m_value = RulesSetProperties::TransactionIdRandom;
+        } else {
+            driver.error(yystack_[1].location, "SecTransactionIdFormat expects Sequential or Random, got: " + yystack_[0].value.as < std::string > ());
+            YYERROR;
+        }
+        driver.m_transactionIdFormat.m_set = true;
+      }
+#line 4066 "seclang-parser.cc"
+    break;
+
+  case 198: // expression: "CONFIG_SEC_TRANSACTION_MEMORY_LIMIT"
+#line 2260 "seclang-parser.yy"
+      {
+        driver.m_transactionMemoryLimit.m_set = true;
+        driver.m_transactionMemoryLimit.m_value = atoi(yystack_[0].value.as < std::string > ().c_str());
+      }
+#line 4075 "seclang-parser.cc"
+    break;
+
+  case 199: // expression: "CONFIG_SEC_TRANSACTION_TIME_BUDGET"
+#line 2265 "seclang-parser.yy"
+      {
+        driver.m_transactionTimeBudget.m_set = true;
+        driver.m_transactionTimeBudget.m_value = atoi(yystack_[0].value.as < std::string > ().c_str());
+      }
+#line 4084 "seclang-parser.cc"
+    break;
+
+  case 200: // expression: "CONFIG_SEC_VERDICT_CACHE"
+#line 2270 "seclang-parser.yy"
+      {
+        driver.m_verdictCacheEntries.m_set = true;
+        driver.m_verdictCacheEntries.m_value = atoi(yystack_[0].value.as < std::string > ().c_str());
+      }
+#line 4093 "seclang-parser.cc"
+    break;
+
+  case 201: // expression: "CONFIG_SEC_COLLECTION_GROUP_COMMIT"
+#line 2275 "seclang-parser.yy"
+      {
+        driver.m_collectionGroupCommit.m_set = true;
+        driver.m_collectionGroupCommit.m_value = atoi(yystack_[0].value.as < std::string > ().c_str());
+      }
+#line 4102 "seclang-parser.cc"
+    break;
+
+  case 202: // expression: "CONFIG_SEC_COLLECTION_TIMEOUT"
+#line 2280 "seclang-parser.yy"
+      {
+        driver.m_collectionTimeout.m_set = true;
+        driver.m_collectionTimeout.m_value = atoi(yystack_[0].value.as < std::string > ().c_str());
       }
-#line 3268 "seclang-parser.cc"
+#line 4111 "seclang-parser.cc"
     break;
 
-  case 154: // expression: "CONFIG_SEC_HTTP_BLKEY"
-#line 1785 "seclang-parser.yy"
+  case 203: // expression: "CONFIG_SEC_HTTP_BLKEY"
+#line 2285 "seclang-parser.yy"
       {
         driver.m_httpblKey.m_set = true;
         driver.m_httpblKey.m_value = yystack_[0].value.as < std::string > ();
       }
-#line 3277 "seclang-parser.cc"
+#line 4120 "seclang-parser.cc"
+    break;
+
+  case 204: // expression: "CONFIG_SEC_DEBUG_LOG_BUFFER"
+#line 2290 "seclang-parser.yy"
+      {
+        std::vector<std::string> args;
+        for (const std::string &a : utils::string::ssplit(yystack_[0].value.as < std::string > (), ' ')) {
+            if (a.empty() == false) {
+                args.push_back(a);
+            }
+        }
+        int level = args.empty() ? -1 : atoi(args[0].c_str());
+        int size = args.size() > 1 ? atoi(args[1].c_str()) : 65536;
+        if (args.size() > 2 || level < 1 || level > 9 || size <= 0) {
+            driver.error(yystack_[1].location, "SecDebugLogBuffer expects a debug level and optionally a size in bytes, got: " + yystack_[0].value.as < std::string > ());
+            YYERROR;
+        }
+        driver.m_debugLogBufferLevel.m_set = true;
+        driver.m_debugLogBufferLevel.m_value = level;
+        driver.m_debugLogBufferSize.m_set = true;
+        driver.m_debugLogBufferSize.m_value = size;
+      }
+#line 4143 "seclang-parser.cc"
+    break;
+
+  case 205: // expression: "CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH"
+#line 2309 "seclang-parser.yy"
+      {
+        std::string error;
+        Utils::DebugLogBufferFlush flush;
+        if (flush.parse(yystack_[0].value.as < std::string > (), &error) == false) {
+            driver.error(yystack_[1].location, "SecDebugLogBufferFlush: " + error);
+            YYERROR;
+        }
+        driver.m_debugLogBufferFlush.m_set = true;
+        driver.m_debugLogBufferFlush.m_value = yystack_[0].value.as < std::string > ();
+      }
+#line 4158 "seclang-parser.cc"
+    break;
+
+  case 206: // expression: "CONFIG_SEC_DEBUG_LOG_FILTER"
+#line 2320 "seclang-parser.yy"
+      {
+        std::string error;
+        Utils::DebugLogFilter filter;
+        if (filter.parse(yystack_[0].value.as < std::string > (), &error) == false) {
+            driver.error(yystack_[1].location, "SecDebugLogFilter: " + error);
+            YYERROR;
+        }
+        driver.m_debugLogFilter.m_set = true;
+        driver.m_debugLogFilter.m_value = yystack_[0].value.as < std::string > ();
+      }
+#line 4173 "seclang-parser.cc"
+    break;
+
+  case 207: // expression: "CONFIG_SEC_HUGE_PAGES"
+#line 2331 "seclang-parser.yy"
+      {
+        /* process wide, and for what the lines that follow compile */
+        std::string mode = utils::string::tolower(yystack_[0].value.as < std::string > ());
+        if (mode == "off") {
+            Utils::HugePages::setMode(Utils::HugePages::Off);
+        } else if (mode == "on") {
+            Utils::HugePages::setMode(Utils::HugePages::Transparent);
+        } else if (mode == "explicit") {
+            Utils::HugePages::setMode(Utils::HugePages::Explicit);
+        } else {
+            driver.error(yystack_[1].location, "SecHugePages expects On, Off or Explicit, got: " + yystack_[0].value.as < std::string > ());
+            YYERROR;
+        }
+      }
+#line 4192 "seclang-parser.cc"
     break;
 
-  case 155: // variables: variables_pre_process
-#line 1793 "seclang-parser.yy"
+  case 208: // variables: variables_pre_process
+#line 2349 "seclang-parser.yy"
       {
         std::unique_ptr<std::vector<std::unique_ptr<Variable> > > originalList = std::move(yystack_[0].value.as < std::unique_ptr<std::vector<std::unique_ptr<Variable> > >  > ());
         std::unique_ptr<std::vector<std::unique_ptr<Variable>>> newList(new std::vector<std::unique_ptr<Variable>>());
@@ -3311,2402 +4226,2469 @@ namespace yy {
         }
         yylhs.value.as < std::unique_ptr<std::vector<std::unique_ptr<Variable> > >  > () = std::move(newNewList);
       }
-#line 3315 "seclang-parser.cc"
+#line 4230 "seclang-parser.cc"
     break;
 
-  case 156: // variables_pre_process: variables_may_be_quoted
-#line 1830 "seclang-parser.yy"
+  case 209: // variables_pre_process: variables_may_be_quoted
+#line 2386 "seclang-parser.yy"
       {
         yylhs.value.as < std::unique_ptr<std::vector<std::unique_ptr<Variable> > >  > () = std::move(yystack_[0].value.as < std::unique_ptr<std::vector<std::unique_ptr<Variable> > >  > ());
       }
-#line 3323 "seclang-parser.cc"
+#line 4238 "seclang-parser.cc"
     break;
 
-  case 157: // variables_pre_process: "QUOTATION_MARK" variables_may_be_quoted "QUOTATION_MARK"
-#line 1834 "seclang-parser.yy"
+  case 210: // variables_pre_process: "QUOTATION_MARK" variables_may_be_quoted "QUOTATION_MARK"
+#line 2390 "seclang-parser.yy"
       {
         yylhs.value.as < std::unique_ptr<std::vector<std::unique_ptr<Variable> > >  > () = std::move(yystack_[1].value.as < std::unique_ptr<std::vector<std::unique_ptr<Variable> > >  > ());
       }
-#line 3331 "seclang-parser.cc"
+#line 4246 "seclang-parser.cc"
     break;
 
-  case 158: // variables_may_be_quoted: variables_may_be_quoted PIPE var
-#line 1841 "seclang-parser.yy"
+  case 211: // variables_may_be_quoted: variables_may_be_quoted PIPE var
+#line 2397 "seclang-parser.yy"
       {
         yystack_[2].value.as < std::unique_ptr<std::vector<std::unique_ptr<Variable> > >  > ()->push_back(std::move(yystack_[0].value.as < std::unique_ptr<Variable> > ()));
         yylhs.value.as < std::unique_ptr<std::vector<std::unique_ptr<Variable> > >  > () = std::move(yystack_[2].value.as < std::unique_ptr<std::vector<std::unique_ptr<Variable> > >  > ());
       }
-#line 3340 "seclang-parser.cc"
+#line 4255 "seclang-parser.cc"
     break;
 
-  case 159: // variables_may_be_quoted: variables_may_be_quoted PIPE VAR_EXCLUSION var
-#line 1846 "seclang-parser.yy"
+  case 212: // variables_may_be_quoted: variables_may_be_quoted PIPE VAR_EXCLUSION var
+#line 2402 "seclang-parser.yy"
       {
         std::unique_ptr<Variable> c(new VariableModificatorExclusion(std::move(yystack_[0].value.as < std::unique_ptr<Variable> > ())));
         yystack_[3].value.as < std::unique_ptr<std::vector<std::unique_ptr<Variable> > >  > ()->push_back(std::move(c));
         yylhs.value.as < std::unique_ptr<std::vector<std::unique_ptr<Variable> > >  > () = std::move(yystack_[3].value.as < std::unique_ptr<std::vector<std::unique_ptr<Variable> > >  > ());
       }
-#line 3350 "seclang-parser.cc"
+#line 4265 "seclang-parser.cc"
     break;
 
-  case 160: // variables_may_be_quoted: variables_may_be_quoted PIPE VAR_COUNT var
-#line 1852 "seclang-parser.yy"
+  case 213: // variables_may_be_quoted: variables_may_be_quoted PIPE VAR_COUNT var
+#line 2408 "seclang-parser.yy"
       {
         std::unique_ptr<Variable> c(new VariableModificatorCount(std::move(yystack_[0].value.as < std::unique_ptr<Variable> > ())));
         yystack_[3].value.as < std::unique_ptr<std::vector<std::unique_ptr<Variable> > >  > ()->push_back(std::move(c));
         yylhs.value.as < std::unique_ptr<std::vector<std::unique_ptr<Variable> > >  > () = std::move(yystack_[3].value.as < std::unique_ptr<std::vector<std::unique_ptr<Variable> > >  > ());
       }
-#line 3360 "seclang-parser.cc"
+#line 4275 "seclang-parser.cc"
     break;
 
-  case 161: // variables_may_be_quoted: var
-#line 1858 "seclang-parser.yy"
+  case 214: // variables_may_be_quoted: var
+#line 2414 "seclang-parser.yy"
       {
         std::unique_ptr<std::vector<std::unique_ptr<Variable>>> b(new std::vector<std::unique_ptr<Variable>>());
         b->push_back(std::move(yystack_[0].value.as < std::unique_ptr<Variable> > ()));
         yylhs.value.as < std::unique_ptr<std::vector<std::unique_ptr<Variable> > >  > () = std::move(b);
       }
-#line 3370 "seclang-parser.cc"
+#line 4285 "seclang-parser.cc"
     break;
 
-  case 162: // variables_may_be_quoted: VAR_EXCLUSION var
-#line 1864 "seclang-parser.yy"
+  case 215: // variables_may_be_quoted: VAR_EXCLUSION var
+#line 2420 "seclang-parser.yy"
       {
         std::unique_ptr<std::vector<std::unique_ptr<Variable>>> b(new std::vector<std::unique_ptr<Variable>>());
         std::unique_ptr<Variable> c(new VariableModificatorExclusion(std::move(yystack_[0].value.as < std::unique_ptr<Variable> > ())));
         b->push_back(std::move(c));
         yylhs.value.as < std::unique_ptr<std::vector<std::unique_ptr<Variable> > >  > () = std::move(b);
       }
-#line 3381 "seclang-parser.cc"
+#line 4296 "seclang-parser.cc"
     break;
 
-  case 163: // variables_may_be_quoted: VAR_COUNT var
-#line 1871 "seclang-parser.yy"
+  case 216: // variables_may_be_quoted: VAR_COUNT var
+#line 2427 "seclang-parser.yy"
       {
         std::unique_ptr<std::vector<std::unique_ptr<Variable>>> b(new std::vector<std::unique_ptr<Variable>>());
         std::unique_ptr<Variable> c(new VariableModificatorCount(std::move(yystack_[0].value.as < std::unique_ptr<Variable> > ())));
         b->push_back(std::move(c));
         yylhs.value.as < std::unique_ptr<std::vector<std::unique_ptr<Variable> > >  > () = std::move(b);
       }
-#line 3392 "seclang-parser.cc"
+#line 4307 "seclang-parser.cc"
     break;
 
-  case 164: // var: VARIABLE_ARGS "Dictionary element"
-#line 1881 "seclang-parser.yy"
+  case 217: // var: VARIABLE_ARGS "Dictionary element"
+#line 2437 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Args_DictElement(yystack_[0].value.as < std::string > ()));
       }
-#line 3400 "seclang-parser.cc"
+#line 4315 "seclang-parser.cc"
     break;
 
-  case 165: // var: VARIABLE_ARGS "Dictionary element, selected by regexp"
-#line 1885 "seclang-parser.yy"
+  case 218: // var: VARIABLE_ARGS "Dictionary element, selected by regexp"
+#line 2441 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Args_DictElementRegexp(yystack_[0].value.as < std::string > ()));
       }
-#line 3408 "seclang-parser.cc"
+#line 4323 "seclang-parser.cc"
     break;
 
-  case 166: // var: VARIABLE_ARGS
-#line 1889 "seclang-parser.yy"
+  case 219: // var: VARIABLE_ARGS
+#line 2445 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Args_NoDictElement());
       }
-#line 3416 "seclang-parser.cc"
+#line 4331 "seclang-parser.cc"
     break;
 
-  case 167: // var: VARIABLE_ARGS_POST "Dictionary element"
-#line 1893 "seclang-parser.yy"
+  case 220: // var: VARIABLE_ARGS_POST "Dictionary element"
+#line 2449 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ArgsPost_DictElement(yystack_[0].value.as < std::string > ()));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ArgsPost);
       }
-#line 3424 "seclang-parser.cc"
+#line 4340 "seclang-parser.cc"
     break;
 
-  case 168: // var: VARIABLE_ARGS_POST "Dictionary element, selected by regexp"
-#line 1897 "seclang-parser.yy"
+  case 221: // var: VARIABLE_ARGS_POST "Dictionary element, selected by regexp"
+#line 2454 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ArgsPost_DictElementRegexp(yystack_[0].value.as < std::string > ()));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ArgsPost);
       }
-#line 3432 "seclang-parser.cc"
+#line 4349 "seclang-parser.cc"
     break;
 
-  case 169: // var: VARIABLE_ARGS_POST
-#line 1901 "seclang-parser.yy"
+  case 222: // var: VARIABLE_ARGS_POST
+#line 2459 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ArgsPost_NoDictElement());
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ArgsPost);
       }
-#line 3440 "seclang-parser.cc"
+#line 4358 "seclang-parser.cc"
     break;
 
-  case 170: // var: VARIABLE_ARGS_GET "Dictionary element"
-#line 1905 "seclang-parser.yy"
+  case 223: // var: VARIABLE_ARGS_GET "Dictionary element"
+#line 2464 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ArgsGet_DictElement(yystack_[0].value.as < std::string > ()));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ArgsGet);
       }
-#line 3448 "seclang-parser.cc"
+#line 4367 "seclang-parser.cc"
     break;
 
-  case 171: // var: VARIABLE_ARGS_GET "Dictionary element, selected by regexp"
-#line 1909 "seclang-parser.yy"
+  case 224: // var: VARIABLE_ARGS_GET "Dictionary element, selected by regexp"
+#line 2469 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ArgsGet_DictElementRegexp(yystack_[0].value.as < std::string > ()));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ArgsGet);
       }
-#line 3456 "seclang-parser.cc"
+#line 4376 "seclang-parser.cc"
     break;
 
-  case 172: // var: VARIABLE_ARGS_GET
-#line 1913 "seclang-parser.yy"
+  case 225: // var: VARIABLE_ARGS_GET
+#line 2474 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ArgsGet_NoDictElement());
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ArgsGet);
       }
-#line 3464 "seclang-parser.cc"
+#line 4385 "seclang-parser.cc"
     break;
 
-  case 173: // var: VARIABLE_FILES_SIZES "Dictionary element"
-#line 1917 "seclang-parser.yy"
+  case 226: // var: VARIABLE_FILES_SIZES "Dictionary element"
+#line 2479 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::FilesSizes_DictElement(yystack_[0].value.as < std::string > ()));
       }
-#line 3472 "seclang-parser.cc"
+#line 4393 "seclang-parser.cc"
     break;
 
-  case 174: // var: VARIABLE_FILES_SIZES "Dictionary element, selected by regexp"
-#line 1921 "seclang-parser.yy"
+  case 227: // var: VARIABLE_FILES_SIZES "Dictionary element, selected by regexp"
+#line 2483 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::FilesSizes_DictElementRegexp(yystack_[0].value.as < std::string > ()));
       }
-#line 3480 "seclang-parser.cc"
+#line 4401 "seclang-parser.cc"
     break;
 
-  case 175: // var: VARIABLE_FILES_SIZES
-#line 1925 "seclang-parser.yy"
+  case 228: // var: VARIABLE_FILES_SIZES
+#line 2487 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::FilesSizes_NoDictElement());
       }
-#line 3488 "seclang-parser.cc"
+#line 4409 "seclang-parser.cc"
     break;
 
-  case 176: // var: VARIABLE_FILES_NAMES "Dictionary element"
-#line 1929 "seclang-parser.yy"
+  case 229: // var: VARIABLE_FILES_NAMES "Dictionary element"
+#line 2491 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::FilesNames_DictElement(yystack_[0].value.as < std::string > ()));
       }
-#line 3496 "seclang-parser.cc"
+#line 4417 "seclang-parser.cc"
     break;
 
-  case 177: // var: VARIABLE_FILES_NAMES "Dictionary element, selected by regexp"
-#line 1933 "seclang-parser.yy"
+  case 230: // var: VARIABLE_FILES_NAMES "Dictionary element, selected by regexp"
+#line 2495 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::FilesNames_DictElementRegexp(yystack_[0].value.as < std::string > ()));
       }
-#line 3504 "seclang-parser.cc"
+#line 4425 "seclang-parser.cc"
     break;
 
-  case 178: // var: VARIABLE_FILES_NAMES
-#line 1937 "seclang-parser.yy"
+  case 231: // var: VARIABLE_FILES_NAMES
+#line 2499 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::FilesNames_NoDictElement());
       }
-#line 3512 "seclang-parser.cc"
+#line 4433 "seclang-parser.cc"
     break;
 
-  case 179: // var: VARIABLE_FILES_TMP_CONTENT "Dictionary element"
-#line 1941 "seclang-parser.yy"
+  case 232: // var: VARIABLE_FILES_TMP_CONTENT "Dictionary element"
+#line 2503 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::FilesTmpContent_DictElement(yystack_[0].value.as < std::string > ()));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::FilesTmpContent);
       }
-#line 3520 "seclang-parser.cc"
+#line 4442 "seclang-parser.cc"
     break;
 
-  case 180: // var: VARIABLE_FILES_TMP_CONTENT "Dictionary element, selected by regexp"
-#line 1945 "seclang-parser.yy"
+  case 233: // var: VARIABLE_FILES_TMP_CONTENT "Dictionary element, selected by regexp"
+#line 2508 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::FilesTmpContent_DictElementRegexp(yystack_[0].value.as < std::string > ()));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::FilesTmpContent);
       }
-#line 3528 "seclang-parser.cc"
+#line 4451 "seclang-parser.cc"
     break;
 
-  case 181: // var: VARIABLE_FILES_TMP_CONTENT
-#line 1949 "seclang-parser.yy"
+  case 234: // var: VARIABLE_FILES_TMP_CONTENT
+#line 2513 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::FilesTmpContent_NoDictElement());
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::FilesTmpContent);
       }
-#line 3536 "seclang-parser.cc"
+#line 4460 "seclang-parser.cc"
     break;
 
-  case 182: // var: VARIABLE_MULTIPART_FILENAME "Dictionary element"
-#line 1953 "seclang-parser.yy"
+  case 235: // var: VARIABLE_MULTIPART_FILENAME "Dictionary element"
+#line 2518 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MultiPartFileName_DictElement(yystack_[0].value.as < std::string > ()));
       }
-#line 3544 "seclang-parser.cc"
+#line 4468 "seclang-parser.cc"
     break;
 
-  case 183: // var: VARIABLE_MULTIPART_FILENAME "Dictionary element, selected by regexp"
-#line 1957 "seclang-parser.yy"
+  case 236: // var: VARIABLE_MULTIPART_FILENAME "Dictionary element, selected by regexp"
+#line 2522 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MultiPartFileName_DictElementRegexp(yystack_[0].value.as < std::string > ()));
       }
-#line 3552 "seclang-parser.cc"
+#line 4476 "seclang-parser.cc"
     break;
 
-  case 184: // var: VARIABLE_MULTIPART_FILENAME
-#line 1961 "seclang-parser.yy"
+  case 237: // var: VARIABLE_MULTIPART_FILENAME
+#line 2526 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MultiPartFileName_NoDictElement());
       }
-#line 3560 "seclang-parser.cc"
+#line 4484 "seclang-parser.cc"
     break;
 
-  case 185: // var: VARIABLE_MULTIPART_NAME "Dictionary element"
-#line 1965 "seclang-parser.yy"
+  case 238: // var: VARIABLE_MULTIPART_NAME "Dictionary element"
+#line 2530 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MultiPartName_DictElement(yystack_[0].value.as < std::string > ()));
       }
-#line 3568 "seclang-parser.cc"
+#line 4492 "seclang-parser.cc"
     break;
 
-  case 186: // var: VARIABLE_MULTIPART_NAME "Dictionary element, selected by regexp"
-#line 1969 "seclang-parser.yy"
+  case 239: // var: VARIABLE_MULTIPART_NAME "Dictionary element, selected by regexp"
+#line 2534 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MultiPartName_DictElementRegexp(yystack_[0].value.as < std::string > ()));
       }
-#line 3576 "seclang-parser.cc"
+#line 4500 "seclang-parser.cc"
     break;
 
-  case 187: // var: VARIABLE_MULTIPART_NAME
-#line 1973 "seclang-parser.yy"
+  case 240: // var: VARIABLE_MULTIPART_NAME
+#line 2538 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MultiPartName_NoDictElement());
       }
-#line 3584 "seclang-parser.cc"
+#line 4508 "seclang-parser.cc"
     break;
 
-  case 188: // var: VARIABLE_MATCHED_VARS_NAMES "Dictionary element"
-#line 1977 "seclang-parser.yy"
+  case 241: // var: VARIABLE_MATCHED_VARS_NAMES "Dictionary element"
+#line 2542 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MatchedVarsNames_DictElement(yystack_[0].value.as < std::string > ()));
       }
-#line 3592 "seclang-parser.cc"
+#line 4516 "seclang-parser.cc"
     break;
 
-  case 189: // var: VARIABLE_MATCHED_VARS_NAMES "Dictionary element, selected by regexp"
-#line 1981 "seclang-parser.yy"
+  case 242: // var: VARIABLE_MATCHED_VARS_NAMES "Dictionary element, selected by regexp"
+#line 2546 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MatchedVarsNames_DictElementRegexp(yystack_[0].value.as < std::string > ()));
       }
-#line 3600 "seclang-parser.cc"
+#line 4524 "seclang-parser.cc"
     break;
 
-  case 190: // var: VARIABLE_MATCHED_VARS_NAMES
-#line 1985 "seclang-parser.yy"
+  case 243: // var: VARIABLE_MATCHED_VARS_NAMES
+#line 2550 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MatchedVarsNames_NoDictElement());
       }
-#line 3608 "seclang-parser.cc"
+#line 4532 "seclang-parser.cc"
     break;
 
-  case 191: // var: VARIABLE_MATCHED_VARS "Dictionary element"
-#line 1989 "seclang-parser.yy"
+  case 244: // var: VARIABLE_MATCHED_VARS "Dictionary element"
+#line 2554 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MatchedVars_DictElement(yystack_[0].value.as < std::string > ()));
       }
-#line 3616 "seclang-parser.cc"
+#line 4540 "seclang-parser.cc"
     break;
 
-  case 192: // var: VARIABLE_MATCHED_VARS "Dictionary element, selected by regexp"
-#line 1993 "seclang-parser.yy"
+  case 245: // var: VARIABLE_MATCHED_VARS "Dictionary element, selected by regexp"
+#line 2558 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MatchedVars_DictElementRegexp(yystack_[0].value.as < std::string > ()));
       }
-#line 3624 "seclang-parser.cc"
+#line 4548 "seclang-parser.cc"
     break;
 
-  case 193: // var: VARIABLE_MATCHED_VARS
-#line 1997 "seclang-parser.yy"
+  case 246: // var: VARIABLE_MATCHED_VARS
+#line 2562 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MatchedVars_NoDictElement());
       }
-#line 3632 "seclang-parser.cc"
+#line 4556 "seclang-parser.cc"
     break;
 
-  case 194: // var: VARIABLE_FILES "Dictionary element"
-#line 2001 "seclang-parser.yy"
+  case 247: // var: VARIABLE_FILES "Dictionary element"
+#line 2566 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Files_DictElement(yystack_[0].value.as < std::string > ()));
       }
-#line 3640 "seclang-parser.cc"
+#line 4564 "seclang-parser.cc"
     break;
 
-  case 195: // var: VARIABLE_FILES "Dictionary element, selected by regexp"
-#line 2005 "seclang-parser.yy"
+  case 248: // var: VARIABLE_FILES "Dictionary element, selected by regexp"
+#line 2570 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Files_DictElementRegexp(yystack_[0].value.as < std::string > ()));
       }
-#line 3648 "seclang-parser.cc"
+#line 4572 "seclang-parser.cc"
     break;
 
-  case 196: // var: VARIABLE_FILES
-#line 2009 "seclang-parser.yy"
+  case 249: // var: VARIABLE_FILES
+#line 2574 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Files_NoDictElement());
       }
-#line 3656 "seclang-parser.cc"
+#line 4580 "seclang-parser.cc"
     break;
 
-  case 197: // var: VARIABLE_REQUEST_COOKIES "Dictionary element"
-#line 2013 "seclang-parser.yy"
+  case 250: // var: VARIABLE_REQUEST_COOKIES "Dictionary element"
+#line 2578 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::RequestCookies_DictElement(yystack_[0].value.as < std::string > ()));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::RequestCookies);
       }
-#line 3664 "seclang-parser.cc"
+#line 4589 "seclang-parser.cc"
     break;
 
-  case 198: // var: VARIABLE_REQUEST_COOKIES "Dictionary element, selected by regexp"
-#line 2017 "seclang-parser.yy"
+  case 251: // var: VARIABLE_REQUEST_COOKIES "Dictionary element, selected by regexp"
+#line 2583 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::RequestCookies_DictElementRegexp(yystack_[0].value.as < std::string > ()));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::RequestCookies);
       }
-#line 3672 "seclang-parser.cc"
+#line 4598 "seclang-parser.cc"
     break;
 
-  case 199: // var: VARIABLE_REQUEST_COOKIES
-#line 2021 "seclang-parser.yy"
+  case 252: // var: VARIABLE_REQUEST_COOKIES
+#line 2588 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::RequestCookies_NoDictElement());
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::RequestCookies);
       }
-#line 3680 "seclang-parser.cc"
+#line 4607 "seclang-parser.cc"
     break;
 
-  case 200: // var: VARIABLE_REQUEST_HEADERS "Dictionary element"
-#line 2025 "seclang-parser.yy"
+  case 253: // var: VARIABLE_REQUEST_HEADERS "Dictionary element"
+#line 2593 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::RequestHeaders_DictElement(yystack_[0].value.as < std::string > ()));
       }
-#line 3688 "seclang-parser.cc"
+#line 4615 "seclang-parser.cc"
     break;
 
-  case 201: // var: VARIABLE_REQUEST_HEADERS "Dictionary element, selected by regexp"
-#line 2029 "seclang-parser.yy"
+  case 254: // var: VARIABLE_REQUEST_HEADERS "Dictionary element, selected by regexp"
+#line 2597 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::RequestHeaders_DictElementRegexp(yystack_[0].value.as < std::string > ()));
       }
-#line 3696 "seclang-parser.cc"
+#line 4623 "seclang-parser.cc"
     break;
 
-  case 202: // var: VARIABLE_REQUEST_HEADERS
-#line 2033 "seclang-parser.yy"
+  case 255: // var: VARIABLE_REQUEST_HEADERS
+#line 2601 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::RequestHeaders_NoDictElement());
       }
-#line 3704 "seclang-parser.cc"
+#line 4631 "seclang-parser.cc"
     break;
 
-  case 203: // var: VARIABLE_RESPONSE_HEADERS "Dictionary element"
-#line 2037 "seclang-parser.yy"
+  case 256: // var: VARIABLE_RESPONSE_HEADERS "Dictionary element"
+#line 2605 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ResponseHeaders_DictElement(yystack_[0].value.as < std::string > ()));
       }
-#line 3712 "seclang-parser.cc"
+#line 4639 "seclang-parser.cc"
     break;
 
-  case 204: // var: VARIABLE_RESPONSE_HEADERS "Dictionary element, selected by regexp"
-#line 2041 "seclang-parser.yy"
+  case 257: // var: VARIABLE_RESPONSE_HEADERS "Dictionary element, selected by regexp"
+#line 2609 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ResponseHeaders_DictElementRegexp(yystack_[0].value.as < std::string > ()));
       }
-#line 3720 "seclang-parser.cc"
+#line 4647 "seclang-parser.cc"
     break;
 
-  case 205: // var: VARIABLE_RESPONSE_HEADERS
-#line 2045 "seclang-parser.yy"
+  case 258: // var: VARIABLE_RESPONSE_HEADERS
+#line 2613 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ResponseHeaders_NoDictElement());
       }
-#line 3728 "seclang-parser.cc"
+#line 4655 "seclang-parser.cc"
     break;
 
-  case 206: // var: VARIABLE_GEO "Dictionary element"
-#line 2049 "seclang-parser.yy"
+  case 259: // var: VARIABLE_GEO "Dictionary element"
+#line 2617 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Geo_DictElement(yystack_[0].value.as < std::string > ()));
       }
-#line 3736 "seclang-parser.cc"
+#line 4663 "seclang-parser.cc"
     break;
 
-  case 207: // var: VARIABLE_GEO "Dictionary element, selected by regexp"
-#line 2053 "seclang-parser.yy"
+  case 260: // var: VARIABLE_GEO "Dictionary element, selected by regexp"
+#line 2621 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Geo_DictElementRegexp(yystack_[0].value.as < std::string > ()));
       }
-#line 3744 "seclang-parser.cc"
+#line 4671 "seclang-parser.cc"
     break;
 
-  case 208: // var: VARIABLE_GEO
-#line 2057 "seclang-parser.yy"
+  case 261: // var: VARIABLE_GEO
+#line 2625 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Geo_NoDictElement());
       }
-#line 3752 "seclang-parser.cc"
+#line 4679 "seclang-parser.cc"
     break;
 
-  case 209: // var: VARIABLE_REQUEST_COOKIES_NAMES "Dictionary element"
-#line 2061 "seclang-parser.yy"
+  case 262: // var: VARIABLE_REQUEST_COOKIES_NAMES "Dictionary element"
+#line 2629 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::RequestCookiesNames_DictElement(yystack_[0].value.as < std::string > ()));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::RequestCookies);
       }
-#line 3760 "seclang-parser.cc"
+#line 4688 "seclang-parser.cc"
     break;
 
-  case 210: // var: VARIABLE_REQUEST_COOKIES_NAMES "Dictionary element, selected by regexp"
-#line 2065 "seclang-parser.yy"
+  case 263: // var: VARIABLE_REQUEST_COOKIES_NAMES "Dictionary element, selected by regexp"
+#line 2634 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::RequestCookiesNames_DictElementRegexp(yystack_[0].value.as < std::string > ()));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::RequestCookies);
       }
-#line 3768 "seclang-parser.cc"
+#line 4697 "seclang-parser.cc"
     break;
 
-  case 211: // var: VARIABLE_REQUEST_COOKIES_NAMES
-#line 2069 "seclang-parser.yy"
+  case 264: // var: VARIABLE_REQUEST_COOKIES_NAMES
+#line 2639 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::RequestCookiesNames_NoDictElement());
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::RequestCookies);
       }
-#line 3776 "seclang-parser.cc"
+#line 4706 "seclang-parser.cc"
     break;
 
-  case 212: // var: VARIABLE_MULTIPART_PART_HEADERS "Dictionary element"
-#line 2073 "seclang-parser.yy"
+  case 265: // var: VARIABLE_MULTIPART_PART_HEADERS "Dictionary element"
+#line 2644 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MultipartPartHeaders_DictElement(yystack_[0].value.as < std::string > ()));
       }
-#line 3784 "seclang-parser.cc"
+#line 4714 "seclang-parser.cc"
     break;
 
-  case 213: // var: VARIABLE_MULTIPART_PART_HEADERS "Dictionary element, selected by regexp"
-#line 2077 "seclang-parser.yy"
+  case 266: // var: VARIABLE_MULTIPART_PART_HEADERS "Dictionary element, selected by regexp"
+#line 2648 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MultipartPartHeaders_DictElementRegexp(yystack_[0].value.as < std::string > ()));
       }
-#line 3792 "seclang-parser.cc"
+#line 4722 "seclang-parser.cc"
     break;
 
-  case 214: // var: VARIABLE_MULTIPART_PART_HEADERS
-#line 2081 "seclang-parser.yy"
+  case 267: // var: VARIABLE_MULTIPART_PART_HEADERS
+#line 2652 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MultipartPartHeaders_NoDictElement());
       }
-#line 3800 "seclang-parser.cc"
+#line 4730 "seclang-parser.cc"
     break;
 
-  case 215: // var: VARIABLE_RULE "Dictionary element"
-#line 2085 "seclang-parser.yy"
+  case 268: // var: VARIABLE_RULE "Dictionary element"
+#line 2656 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Rule_DictElement(yystack_[0].value.as < std::string > ()));
       }
-#line 3808 "seclang-parser.cc"
+#line 4738 "seclang-parser.cc"
     break;
 
-  case 216: // var: VARIABLE_RULE "Dictionary element, selected by regexp"
-#line 2089 "seclang-parser.yy"
+  case 269: // var: VARIABLE_RULE "Dictionary element, selected by regexp"
+#line 2660 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Rule_DictElementRegexp(yystack_[0].value.as < std::string > ()));
       }
-#line 3816 "seclang-parser.cc"
+#line 4746 "seclang-parser.cc"
     break;
 
-  case 217: // var: VARIABLE_RULE
-#line 2093 "seclang-parser.yy"
+  case 270: // var: VARIABLE_RULE
+#line 2664 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Rule_NoDictElement());
       }
-#line 3824 "seclang-parser.cc"
+#line 4754 "seclang-parser.cc"
     break;
 
-  case 218: // var: "RUN_TIME_VAR_ENV" "Dictionary element"
-#line 2097 "seclang-parser.yy"
+  case 271: // var: "RUN_TIME_VAR_ENV" "Dictionary element"
+#line 2668 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Env("ENV:" + yystack_[0].value.as < std::string > ()));
       }
-#line 3832 "seclang-parser.cc"
+#line 4762 "seclang-parser.cc"
     break;
 
-  case 219: // var: "RUN_TIME_VAR_ENV" "Dictionary element, selected by regexp"
-#line 2101 "seclang-parser.yy"
+  case 272: // var: "RUN_TIME_VAR_ENV" "Dictionary element, selected by regexp"
+#line 2672 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Env("ENV:" + yystack_[0].value.as < std::string > ()));
       }
-#line 3840 "seclang-parser.cc"
+#line 4770 "seclang-parser.cc"
     break;
 
-  case 220: // var: "RUN_TIME_VAR_ENV"
-#line 2105 "seclang-parser.yy"
+  case 273: // var: "RUN_TIME_VAR_ENV"
+#line 2676 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Env("ENV"));
       }
-#line 3848 "seclang-parser.cc"
+#line 4778 "seclang-parser.cc"
     break;
 
-  case 221: // var: "RUN_TIME_VAR_XML" "Dictionary element"
-#line 2109 "seclang-parser.yy"
+  case 274: // var: "RUN_TIME_VAR_XML" "Dictionary element"
+#line 2680 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::XML("XML:" + yystack_[0].value.as < std::string > ()));
+        driver.m_xmlDomRequired = modsecurity::RulesSetProperties::TrueConfigBoolean;
       }
-#line 3856 "seclang-parser.cc"
+#line 4787 "seclang-parser.cc"
     break;
 
-  case 222: // var: "RUN_TIME_VAR_XML" "Dictionary element, selected by regexp"
-#line 2113 "seclang-parser.yy"
+  case 275: // var: "RUN_TIME_VAR_XML" "Dictionary element, selected by regexp"
+#line 2685 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::XML("XML:" + yystack_[0].value.as < std::string > ()));
+        driver.m_xmlDomRequired = modsecurity::RulesSetProperties::TrueConfigBoolean;
       }
-#line 3864 "seclang-parser.cc"
+#line 4796 "seclang-parser.cc"
     break;
 
-  case 223: // var: "RUN_TIME_VAR_XML"
-#line 2117 "seclang-parser.yy"
+  case 276: // var: "RUN_TIME_VAR_XML"
+#line 2690 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::XML_NoDictElement());
+        driver.m_xmlDomRequired = modsecurity::RulesSetProperties::TrueConfigBoolean;
       }
-#line 3872 "seclang-parser.cc"
+#line 4805 "seclang-parser.cc"
     break;
 
-  case 224: // var: "FILES_TMPNAMES" "Dictionary element"
-#line 2121 "seclang-parser.yy"
+  case 277: // var: "FILES_TMPNAMES" "Dictionary element"
+#line 2695 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::FilesTmpNames_DictElement(yystack_[0].value.as < std::string > ()));
       }
-#line 3880 "seclang-parser.cc"
+#line 4813 "seclang-parser.cc"
     break;
 
-  case 225: // var: "FILES_TMPNAMES" "Dictionary element, selected by regexp"
-#line 2125 "seclang-parser.yy"
+  case 278: // var: "FILES_TMPNAMES" "Dictionary element, selected by regexp"
+#line 2699 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::FilesTmpNames_DictElementRegexp(yystack_[0].value.as < std::string > ()));
       }
-#line 3888 "seclang-parser.cc"
+#line 4821 "seclang-parser.cc"
     break;
 
-  case 226: // var: "FILES_TMPNAMES"
-#line 2129 "seclang-parser.yy"
+  case 279: // var: "FILES_TMPNAMES"
+#line 2703 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::FilesTmpNames_NoDictElement());
       }
-#line 3896 "seclang-parser.cc"
+#line 4829 "seclang-parser.cc"
     break;
 
-  case 227: // var: "RESOURCE" run_time_string
-#line 2133 "seclang-parser.yy"
+  case 280: // var: "RESOURCE" run_time_string
+#line 2707 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Resource_DynamicElement(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 3904 "seclang-parser.cc"
+#line 4837 "seclang-parser.cc"
     break;
 
-  case 228: // var: "RESOURCE" "Dictionary element"
-#line 2137 "seclang-parser.yy"
+  case 281: // var: "RESOURCE" "Dictionary element"
+#line 2711 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Resource_DictElement(yystack_[0].value.as < std::string > ()));
       }
-#line 3912 "seclang-parser.cc"
+#line 4845 "seclang-parser.cc"
     break;
 
-  case 229: // var: "RESOURCE" "Dictionary element, selected by regexp"
-#line 2141 "seclang-parser.yy"
+  case 282: // var: "RESOURCE" "Dictionary element, selected by regexp"
+#line 2715 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Resource_DictElementRegexp(yystack_[0].value.as < std::string > ()));
       }
-#line 3920 "seclang-parser.cc"
+#line 4853 "seclang-parser.cc"
     break;
 
-  case 230: // var: "RESOURCE"
-#line 2145 "seclang-parser.yy"
+  case 283: // var: "RESOURCE"
+#line 2719 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Resource_NoDictElement());
       }
-#line 3928 "seclang-parser.cc"
+#line 4861 "seclang-parser.cc"
     break;
 
-  case 231: // var: "VARIABLE_IP" run_time_string
-#line 2149 "seclang-parser.yy"
+  case 284: // var: "VARIABLE_IP" run_time_string
+#line 2723 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Ip_DynamicElement(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 3936 "seclang-parser.cc"
+#line 4869 "seclang-parser.cc"
     break;
 
-  case 232: // var: "VARIABLE_IP" "Dictionary element"
-#line 2153 "seclang-parser.yy"
+  case 285: // var: "VARIABLE_IP" "Dictionary element"
+#line 2727 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Ip_DictElement(yystack_[0].value.as < std::string > ()));
       }
-#line 3944 "seclang-parser.cc"
+#line 4877 "seclang-parser.cc"
     break;
 
-  case 233: // var: "VARIABLE_IP" "Dictionary element, selected by regexp"
-#line 2157 "seclang-parser.yy"
+  case 286: // var: "VARIABLE_IP" "Dictionary element, selected by regexp"
+#line 2731 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Ip_DictElementRegexp(yystack_[0].value.as < std::string > ()));
       }
-#line 3952 "seclang-parser.cc"
+#line 4885 "seclang-parser.cc"
     break;
 
-  case 234: // var: "VARIABLE_IP"
-#line 2161 "seclang-parser.yy"
+  case 287: // var: "VARIABLE_IP"
+#line 2735 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Ip_NoDictElement());
       }
-#line 3960 "seclang-parser.cc"
+#line 4893 "seclang-parser.cc"
     break;
 
-  case 235: // var: "VARIABLE_GLOBAL" run_time_string
-#line 2165 "seclang-parser.yy"
+  case 288: // var: "VARIABLE_GLOBAL" run_time_string
+#line 2739 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Global_DynamicElement(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 3968 "seclang-parser.cc"
+#line 4901 "seclang-parser.cc"
     break;
 
-  case 236: // var: "VARIABLE_GLOBAL" "Dictionary element"
-#line 2169 "seclang-parser.yy"
+  case 289: // var: "VARIABLE_GLOBAL" "Dictionary element"
+#line 2743 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Global_DictElement(yystack_[0].value.as < std::string > ()));
       }
-#line 3976 "seclang-parser.cc"
+#line 4909 "seclang-parser.cc"
     break;
 
-  case 237: // var: "VARIABLE_GLOBAL" "Dictionary element, selected by regexp"
-#line 2173 "seclang-parser.yy"
+  case 290: // var: "VARIABLE_GLOBAL" "Dictionary element, selected by regexp"
+#line 2747 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Global_DictElementRegexp(yystack_[0].value.as < std::string > ()));
       }
-#line 3984 "seclang-parser.cc"
+#line 4917 "seclang-parser.cc"
     break;
 
-  case 238: // var: "VARIABLE_GLOBAL"
-#line 2177 "seclang-parser.yy"
+  case 291: // var: "VARIABLE_GLOBAL"
+#line 2751 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Global_NoDictElement());
       }
-#line 3992 "seclang-parser.cc"
+#line 4925 "seclang-parser.cc"
     break;
 
-  case 239: // var: "VARIABLE_USER" run_time_string
-#line 2181 "seclang-parser.yy"
+  case 292: // var: "VARIABLE_USER" run_time_string
+#line 2755 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::User_DynamicElement(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 4000 "seclang-parser.cc"
+#line 4933 "seclang-parser.cc"
     break;
 
-  case 240: // var: "VARIABLE_USER" "Dictionary element"
-#line 2185 "seclang-parser.yy"
+  case 293: // var: "VARIABLE_USER" "Dictionary element"
+#line 2759 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::User_DictElement(yystack_[0].value.as < std::string > ()));
       }
-#line 4008 "seclang-parser.cc"
+#line 4941 "seclang-parser.cc"
     break;
 
-  case 241: // var: "VARIABLE_USER" "Dictionary element, selected by regexp"
-#line 2189 "seclang-parser.yy"
+  case 294: // var: "VARIABLE_USER" "Dictionary element, selected by regexp"
+#line 2763 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::User_DictElementRegexp(yystack_[0].value.as < std::string > ()));
       }
-#line 4016 "seclang-parser.cc"
+#line 4949 "seclang-parser.cc"
     break;
 
-  case 242: // var: "VARIABLE_USER"
-#line 2193 "seclang-parser.yy"
+  case 295: // var: "VARIABLE_USER"
+#line 2767 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::User_NoDictElement());
       }
-#line 4024 "seclang-parser.cc"
+#line 4957 "seclang-parser.cc"
     break;
 
-  case 243: // var: "VARIABLE_TX" run_time_string
-#line 2197 "seclang-parser.yy"
+  case 296: // var: "VARIABLE_TX" run_time_string
+#line 2771 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Tx_DynamicElement(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 4032 "seclang-parser.cc"
+#line 4965 "seclang-parser.cc"
     break;
 
-  case 244: // var: "VARIABLE_TX" "Dictionary element"
-#line 2201 "seclang-parser.yy"
+  case 297: // var: "VARIABLE_TX" "Dictionary element"
+#line 2775 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Tx_DictElement(yystack_[0].value.as < std::string > ()));
       }
-#line 4040 "seclang-parser.cc"
+#line 4973 "seclang-parser.cc"
     break;
 
-  case 245: // var: "VARIABLE_TX" "Dictionary element, selected by regexp"
-#line 2205 "seclang-parser.yy"
+  case 298: // var: "VARIABLE_TX" "Dictionary element, selected by regexp"
+#line 2779 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Tx_DictElementRegexp(yystack_[0].value.as < std::string > ()));
       }
-#line 4048 "seclang-parser.cc"
+#line 4981 "seclang-parser.cc"
     break;
 
-  case 246: // var: "VARIABLE_TX"
-#line 2209 "seclang-parser.yy"
+  case 299: // var: "VARIABLE_TX"
+#line 2783 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Tx_NoDictElement());
       }
-#line 4056 "seclang-parser.cc"
+#line 4989 "seclang-parser.cc"
     break;
 
-  case 247: // var: "VARIABLE_SESSION" run_time_string
-#line 2213 "seclang-parser.yy"
+  case 300: // var: "VARIABLE_SESSION" run_time_string
+#line 2787 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Session_DynamicElement(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 4064 "seclang-parser.cc"
+#line 4997 "seclang-parser.cc"
     break;
 
-  case 248: // var: "VARIABLE_SESSION" "Dictionary element"
-#line 2217 "seclang-parser.yy"
+  case 301: // var: "VARIABLE_SESSION" "Dictionary element"
+#line 2791 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Session_DictElement(yystack_[0].value.as < std::string > ()));
       }
-#line 4072 "seclang-parser.cc"
+#line 5005 "seclang-parser.cc"
     break;
 
-  case 249: // var: "VARIABLE_SESSION" "Dictionary element, selected by regexp"
-#line 2221 "seclang-parser.yy"
+  case 302: // var: "VARIABLE_SESSION" "Dictionary element, selected by regexp"
+#line 2795 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Session_DictElementRegexp(yystack_[0].value.as < std::string > ()));
       }
-#line 4080 "seclang-parser.cc"
+#line 5013 "seclang-parser.cc"
     break;
 
-  case 250: // var: "VARIABLE_SESSION"
-#line 2225 "seclang-parser.yy"
+  case 303: // var: "VARIABLE_SESSION"
+#line 2799 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Session_NoDictElement());
       }
-#line 4088 "seclang-parser.cc"
+#line 5021 "seclang-parser.cc"
     break;
 
-  case 251: // var: "Variable ARGS_NAMES" "Dictionary element"
-#line 2229 "seclang-parser.yy"
+  case 304: // var: "Variable ARGS_NAMES" "Dictionary element"
+#line 2803 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ArgsNames_DictElement(yystack_[0].value.as < std::string > ()));
       }
-#line 4096 "seclang-parser.cc"
+#line 5029 "seclang-parser.cc"
     break;
 
-  case 252: // var: "Variable ARGS_NAMES" "Dictionary element, selected by regexp"
-#line 2233 "seclang-parser.yy"
+  case 305: // var: "Variable ARGS_NAMES" "Dictionary element, selected by regexp"
+#line 2807 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ArgsNames_DictElementRegexp(yystack_[0].value.as < std::string > ()));
       }
-#line 4104 "seclang-parser.cc"
+#line 5037 "seclang-parser.cc"
     break;
 
-  case 253: // var: "Variable ARGS_NAMES"
-#line 2237 "seclang-parser.yy"
+  case 306: // var: "Variable ARGS_NAMES"
+#line 2811 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ArgsNames_NoDictElement());
       }
-#line 4112 "seclang-parser.cc"
+#line 5045 "seclang-parser.cc"
     break;
 
-  case 254: // var: VARIABLE_ARGS_GET_NAMES "Dictionary element"
-#line 2241 "seclang-parser.yy"
+  case 307: // var: VARIABLE_ARGS_GET_NAMES "Dictionary element"
+#line 2815 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ArgsGetNames_DictElement(yystack_[0].value.as < std::string > ()));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ArgsGet);
       }
-#line 4120 "seclang-parser.cc"
+#line 5054 "seclang-parser.cc"
     break;
 
-  case 255: // var: VARIABLE_ARGS_GET_NAMES "Dictionary element, selected by regexp"
-#line 2245 "seclang-parser.yy"
+  case 308: // var: VARIABLE_ARGS_GET_NAMES "Dictionary element, selected by regexp"
+#line 2820 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ArgsGetNames_DictElementRegexp(yystack_[0].value.as < std::string > ()));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ArgsGet);
       }
-#line 4128 "seclang-parser.cc"
+#line 5063 "seclang-parser.cc"
     break;
 
-  case 256: // var: VARIABLE_ARGS_GET_NAMES
-#line 2249 "seclang-parser.yy"
+  case 309: // var: VARIABLE_ARGS_GET_NAMES
+#line 2825 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ArgsGetNames_NoDictElement());
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ArgsGet);
       }
-#line 4136 "seclang-parser.cc"
+#line 5072 "seclang-parser.cc"
     break;
 
-  case 257: // var: VARIABLE_ARGS_POST_NAMES "Dictionary element"
-#line 2254 "seclang-parser.yy"
+  case 310: // var: VARIABLE_ARGS_POST_NAMES "Dictionary element"
+#line 2831 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ArgsPostNames_DictElement(yystack_[0].value.as < std::string > ()));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ArgsPost);
       }
-#line 4144 "seclang-parser.cc"
+#line 5081 "seclang-parser.cc"
     break;
 
-  case 258: // var: VARIABLE_ARGS_POST_NAMES "Dictionary element, selected by regexp"
-#line 2258 "seclang-parser.yy"
+  case 311: // var: VARIABLE_ARGS_POST_NAMES "Dictionary element, selected by regexp"
+#line 2836 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ArgsPostNames_DictElementRegexp(yystack_[0].value.as < std::string > ()));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ArgsPost);
       }
-#line 4152 "seclang-parser.cc"
+#line 5090 "seclang-parser.cc"
     break;
 
-  case 259: // var: VARIABLE_ARGS_POST_NAMES
-#line 2262 "seclang-parser.yy"
+  case 312: // var: VARIABLE_ARGS_POST_NAMES
+#line 2841 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ArgsPostNames_NoDictElement());
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ArgsPost);
       }
-#line 4160 "seclang-parser.cc"
+#line 5099 "seclang-parser.cc"
     break;
 
-  case 260: // var: VARIABLE_REQUEST_HEADERS_NAMES "Dictionary element"
-#line 2267 "seclang-parser.yy"
+  case 313: // var: VARIABLE_REQUEST_HEADERS_NAMES "Dictionary element"
+#line 2847 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::RequestHeadersNames_DictElement(yystack_[0].value.as < std::string > ()));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::RequestHeadersNames);
       }
-#line 4168 "seclang-parser.cc"
+#line 5108 "seclang-parser.cc"
     break;
 
-  case 261: // var: VARIABLE_REQUEST_HEADERS_NAMES "Dictionary element, selected by regexp"
-#line 2271 "seclang-parser.yy"
+  case 314: // var: VARIABLE_REQUEST_HEADERS_NAMES "Dictionary element, selected by regexp"
+#line 2852 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::RequestHeadersNames_DictElementRegexp(yystack_[0].value.as < std::string > ()));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::RequestHeadersNames);
       }
-#line 4176 "seclang-parser.cc"
+#line 5117 "seclang-parser.cc"
     break;
 
-  case 262: // var: VARIABLE_REQUEST_HEADERS_NAMES
-#line 2275 "seclang-parser.yy"
+  case 315: // var: VARIABLE_REQUEST_HEADERS_NAMES
+#line 2857 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::RequestHeadersNames_NoDictElement());
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::RequestHeadersNames);
       }
-#line 4184 "seclang-parser.cc"
+#line 5126 "seclang-parser.cc"
     break;
 
-  case 263: // var: VARIABLE_RESPONSE_CONTENT_TYPE
-#line 2280 "seclang-parser.yy"
+  case 316: // var: VARIABLE_RESPONSE_CONTENT_TYPE
+#line 2863 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ResponseContentType());
       }
-#line 4192 "seclang-parser.cc"
+#line 5134 "seclang-parser.cc"
     break;
 
-  case 264: // var: VARIABLE_RESPONSE_HEADERS_NAMES "Dictionary element"
-#line 2285 "seclang-parser.yy"
+  case 317: // var: VARIABLE_RESPONSE_HEADERS_NAMES "Dictionary element"
+#line 2868 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ResponseHeadersNames_DictElement(yystack_[0].value.as < std::string > ()));
       }
-#line 4200 "seclang-parser.cc"
+#line 5142 "seclang-parser.cc"
     break;
 
-  case 265: // var: VARIABLE_RESPONSE_HEADERS_NAMES "Dictionary element, selected by regexp"
-#line 2289 "seclang-parser.yy"
+  case 318: // var: VARIABLE_RESPONSE_HEADERS_NAMES "Dictionary element, selected by regexp"
+#line 2872 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ResponseHeadersNames_DictElementRegexp(yystack_[0].value.as < std::string > ()));
       }
-#line 4208 "seclang-parser.cc"
+#line 5150 "seclang-parser.cc"
     break;
 
-  case 266: // var: VARIABLE_RESPONSE_HEADERS_NAMES
-#line 2293 "seclang-parser.yy"
+  case 319: // var: VARIABLE_RESPONSE_HEADERS_NAMES
+#line 2876 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ResponseHeadersNames_NoDictElement());
       }
-#line 4216 "seclang-parser.cc"
+#line 5158 "seclang-parser.cc"
     break;
 
-  case 267: // var: VARIABLE_ARGS_COMBINED_SIZE
-#line 2297 "seclang-parser.yy"
+  case 320: // var: VARIABLE_ARGS_COMBINED_SIZE
+#line 2880 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ArgsCombinedSize());
       }
-#line 4224 "seclang-parser.cc"
+#line 5166 "seclang-parser.cc"
     break;
 
-  case 268: // var: "AUTH_TYPE"
-#line 2301 "seclang-parser.yy"
+  case 321: // var: "AUTH_TYPE"
+#line 2884 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::AuthType());
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::AuthType);
       }
-#line 4232 "seclang-parser.cc"
+#line 5175 "seclang-parser.cc"
     break;
 
-  case 269: // var: "FILES_COMBINED_SIZE"
-#line 2305 "seclang-parser.yy"
+  case 322: // var: "FILES_COMBINED_SIZE"
+#line 2889 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::FilesCombinedSize());
       }
-#line 4240 "seclang-parser.cc"
+#line 5183 "seclang-parser.cc"
     break;
 
-  case 270: // var: "FULL_REQUEST"
-#line 2309 "seclang-parser.yy"
+  case 323: // var: "FULL_REQUEST"
+#line 2893 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::FullRequest());
       }
-#line 4248 "seclang-parser.cc"
+#line 5191 "seclang-parser.cc"
     break;
 
-  case 271: // var: "FULL_REQUEST_LENGTH"
-#line 2313 "seclang-parser.yy"
+  case 324: // var: "FULL_REQUEST_LENGTH"
+#line 2897 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::FullRequestLength());
       }
-#line 4256 "seclang-parser.cc"
+#line 5199 "seclang-parser.cc"
     break;
 
-  case 272: // var: "INBOUND_DATA_ERROR"
-#line 2317 "seclang-parser.yy"
+  case 325: // var: "INBOUND_DATA_ERROR"
+#line 2901 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::InboundDataError());
       }
-#line 4264 "seclang-parser.cc"
+#line 5207 "seclang-parser.cc"
     break;
 
-  case 273: // var: "MATCHED_VAR"
-#line 2321 "seclang-parser.yy"
+  case 326: // var: "MATCHED_VAR"
+#line 2905 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MatchedVar());
       }
-#line 4272 "seclang-parser.cc"
+#line 5215 "seclang-parser.cc"
     break;
 
-  case 274: // var: "MATCHED_VAR_NAME"
-#line 2325 "seclang-parser.yy"
+  case 327: // var: "MATCHED_VAR_NAME"
+#line 2909 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MatchedVarName());
       }
-#line 4280 "seclang-parser.cc"
+#line 5223 "seclang-parser.cc"
     break;
 
-  case 275: // var: "MSC_PCRE_ERROR"
-#line 2329 "seclang-parser.yy"
+  case 328: // var: "MSC_PCRE_ERROR"
+#line 2913 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MscPcreError());
       }
-#line 4288 "seclang-parser.cc"
+#line 5231 "seclang-parser.cc"
     break;
 
-  case 276: // var: "MSC_PCRE_LIMITS_EXCEEDED"
-#line 2333 "seclang-parser.yy"
+  case 329: // var: "MSC_PCRE_LIMITS_EXCEEDED"
+#line 2917 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MscPcreLimitsExceeded());
       }
-#line 4296 "seclang-parser.cc"
+#line 5239 "seclang-parser.cc"
+    break;
+
+  case 330: // var: "MSC_MEMORY_LIMIT_EXCEEDED"
+#line 2921 "seclang-parser.yy"
+      {
+        VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MscMemoryLimitExceeded());
+      }
+#line 5247 "seclang-parser.cc"
     break;
 
-  case 277: // var: VARIABLE_MULTIPART_BOUNDARY_QUOTED
-#line 2337 "seclang-parser.yy"
+  case 331: // var: "MSC_TIME_BUDGET_EXCEEDED"
+#line 2925 "seclang-parser.yy"
+      {
+        VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MscTimeBudgetExceeded());
+      }
+#line 5255 "seclang-parser.cc"
+    break;
+
+  case 332: // var: VARIABLE_MULTIPART_BOUNDARY_QUOTED
+#line 2929 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MultipartBoundaryQuoted());
       }
-#line 4304 "seclang-parser.cc"
+#line 5263 "seclang-parser.cc"
     break;
 
-  case 278: // var: VARIABLE_MULTIPART_BOUNDARY_WHITESPACE
-#line 2341 "seclang-parser.yy"
+  case 333: // var: VARIABLE_MULTIPART_BOUNDARY_WHITESPACE
+#line 2933 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MultipartBoundaryWhiteSpace());
       }
-#line 4312 "seclang-parser.cc"
+#line 5271 "seclang-parser.cc"
     break;
 
-  case 279: // var: "MULTIPART_CRLF_LF_LINES"
-#line 2345 "seclang-parser.yy"
+  case 334: // var: "MULTIPART_CRLF_LF_LINES"
+#line 2937 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MultipartCrlfLFLines());
       }
-#line 4320 "seclang-parser.cc"
+#line 5279 "seclang-parser.cc"
     break;
 
-  case 280: // var: "MULTIPART_DATA_AFTER"
-#line 2349 "seclang-parser.yy"
+  case 335: // var: "MULTIPART_DATA_AFTER"
+#line 2941 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MultipartDateAfter());
       }
-#line 4328 "seclang-parser.cc"
+#line 5287 "seclang-parser.cc"
     break;
 
-  case 281: // var: VARIABLE_MULTIPART_DATA_BEFORE
-#line 2353 "seclang-parser.yy"
+  case 336: // var: VARIABLE_MULTIPART_DATA_BEFORE
+#line 2945 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MultipartDateBefore());
       }
-#line 4336 "seclang-parser.cc"
+#line 5295 "seclang-parser.cc"
     break;
 
-  case 282: // var: "MULTIPART_FILE_LIMIT_EXCEEDED"
-#line 2357 "seclang-parser.yy"
+  case 337: // var: "MULTIPART_FILE_LIMIT_EXCEEDED"
+#line 2949 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MultipartFileLimitExceeded());
       }
-#line 4344 "seclang-parser.cc"
+#line 5303 "seclang-parser.cc"
     break;
 
-  case 283: // var: "MULTIPART_HEADER_FOLDING"
-#line 2361 "seclang-parser.yy"
+  case 338: // var: "MULTIPART_HEADER_FOLDING"
+#line 2953 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MultipartHeaderFolding());
       }
-#line 4352 "seclang-parser.cc"
+#line 5311 "seclang-parser.cc"
     break;
 
-  case 284: // var: "MULTIPART_INVALID_HEADER_FOLDING"
-#line 2365 "seclang-parser.yy"
+  case 339: // var: "MULTIPART_INVALID_HEADER_FOLDING"
+#line 2957 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MultipartInvalidHeaderFolding());
       }
-#line 4360 "seclang-parser.cc"
+#line 5319 "seclang-parser.cc"
     break;
 
-  case 285: // var: VARIABLE_MULTIPART_INVALID_PART
-#line 2369 "seclang-parser.yy"
+  case 340: // var: VARIABLE_MULTIPART_INVALID_PART
+#line 2961 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MultipartInvalidPart());
       }
-#line 4368 "seclang-parser.cc"
+#line 5327 "seclang-parser.cc"
     break;
 
-  case 286: // var: "MULTIPART_INVALID_QUOTING"
-#line 2373 "seclang-parser.yy"
+  case 341: // var: "MULTIPART_INVALID_QUOTING"
+#line 2965 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MultipartInvalidQuoting());
       }
-#line 4376 "seclang-parser.cc"
+#line 5335 "seclang-parser.cc"
     break;
 
-  case 287: // var: VARIABLE_MULTIPART_LF_LINE
-#line 2377 "seclang-parser.yy"
+  case 342: // var: VARIABLE_MULTIPART_LF_LINE
+#line 2969 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MultipartLFLine());
       }
-#line 4384 "seclang-parser.cc"
+#line 5343 "seclang-parser.cc"
     break;
 
-  case 288: // var: VARIABLE_MULTIPART_MISSING_SEMICOLON
-#line 2381 "seclang-parser.yy"
+  case 343: // var: VARIABLE_MULTIPART_MISSING_SEMICOLON
+#line 2973 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MultipartMissingSemicolon());
       }
-#line 4392 "seclang-parser.cc"
+#line 5351 "seclang-parser.cc"
     break;
 
-  case 289: // var: VARIABLE_MULTIPART_SEMICOLON_MISSING
-#line 2385 "seclang-parser.yy"
+  case 344: // var: VARIABLE_MULTIPART_SEMICOLON_MISSING
+#line 2977 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MultipartMissingSemicolon());
       }
-#line 4400 "seclang-parser.cc"
+#line 5359 "seclang-parser.cc"
     break;
 
-  case 290: // var: "MULTIPART_STRICT_ERROR"
-#line 2389 "seclang-parser.yy"
+  case 345: // var: "MULTIPART_STRICT_ERROR"
+#line 2981 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MultipartStrictError());
       }
-#line 4408 "seclang-parser.cc"
+#line 5367 "seclang-parser.cc"
     break;
 
-  case 291: // var: "MULTIPART_UNMATCHED_BOUNDARY"
-#line 2393 "seclang-parser.yy"
+  case 346: // var: "MULTIPART_UNMATCHED_BOUNDARY"
+#line 2985 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::MultipartUnmatchedBoundary());
       }
-#line 4416 "seclang-parser.cc"
+#line 5375 "seclang-parser.cc"
     break;
 
-  case 292: // var: "OUTBOUND_DATA_ERROR"
-#line 2397 "seclang-parser.yy"
+  case 347: // var: "OUTBOUND_DATA_ERROR"
+#line 2989 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::OutboundDataError());
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ResponseBody);
       }
-#line 4424 "seclang-parser.cc"
+#line 5384 "seclang-parser.cc"
     break;
 
-  case 293: // var: "PATH_INFO"
-#line 2401 "seclang-parser.yy"
+  case 348: // var: "PATH_INFO"
+#line 2994 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::PathInfo());
       }
-#line 4432 "seclang-parser.cc"
+#line 5392 "seclang-parser.cc"
     break;
 
-  case 294: // var: "QUERY_STRING"
-#line 2405 "seclang-parser.yy"
+  case 349: // var: "QUERY_STRING"
+#line 2998 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::QueryString());
       }
-#line 4440 "seclang-parser.cc"
+#line 5400 "seclang-parser.cc"
     break;
 
-  case 295: // var: "REMOTE_ADDR"
-#line 2409 "seclang-parser.yy"
+  case 350: // var: "REMOTE_ADDR"
+#line 3002 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::RemoteAddr());
       }
-#line 4448 "seclang-parser.cc"
+#line 5408 "seclang-parser.cc"
     break;
 
-  case 296: // var: "REMOTE_HOST"
-#line 2413 "seclang-parser.yy"
+  case 351: // var: "REMOTE_HOST"
+#line 3006 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::RemoteHost());
       }
-#line 4456 "seclang-parser.cc"
+#line 5416 "seclang-parser.cc"
     break;
 
-  case 297: // var: "REMOTE_PORT"
-#line 2417 "seclang-parser.yy"
+  case 352: // var: "REMOTE_PORT"
+#line 3010 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::RemotePort());
       }
-#line 4464 "seclang-parser.cc"
+#line 5424 "seclang-parser.cc"
     break;
 
-  case 298: // var: "REQBODY_ERROR"
-#line 2421 "seclang-parser.yy"
+  case 353: // var: "REQBODY_ERROR"
+#line 3014 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ReqbodyError());
       }
-#line 4472 "seclang-parser.cc"
+#line 5432 "seclang-parser.cc"
     break;
 
-  case 299: // var: "REQBODY_ERROR_MSG"
-#line 2425 "seclang-parser.yy"
+  case 354: // var: "REQBODY_ERROR_MSG"
+#line 3018 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ReqbodyErrorMsg());
       }
-#line 4480 "seclang-parser.cc"
+#line 5440 "seclang-parser.cc"
     break;
 
-  case 300: // var: "REQBODY_PROCESSOR"
-#line 2429 "seclang-parser.yy"
+  case 355: // var: "REQBODY_PROCESSOR"
+#line 3022 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ReqbodyProcessor());
       }
-#line 4488 "seclang-parser.cc"
+#line 5448 "seclang-parser.cc"
     break;
 
-  case 301: // var: "REQBODY_PROCESSOR_ERROR"
-#line 2433 "seclang-parser.yy"
+  case 356: // var: "REQBODY_PROCESSOR_ERROR"
+#line 3026 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ReqbodyProcessorError());
       }
-#line 4496 "seclang-parser.cc"
+#line 5456 "seclang-parser.cc"
     break;
 
-  case 302: // var: "REQBODY_PROCESSOR_ERROR_MSG"
-#line 2437 "seclang-parser.yy"
+  case 357: // var: "REQBODY_PROCESSOR_ERROR_MSG"
+#line 3030 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ReqbodyProcessorErrorMsg());
       }
-#line 4504 "seclang-parser.cc"
+#line 5464 "seclang-parser.cc"
     break;
 
-  case 303: // var: "REQUEST_BASENAME"
-#line 2441 "seclang-parser.yy"
+  case 358: // var: "REQUEST_BASENAME"
+#line 3034 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::RequestBasename());
       }
-#line 4512 "seclang-parser.cc"
+#line 5472 "seclang-parser.cc"
     break;
 
-  case 304: // var: "REQUEST_BODY"
-#line 2445 "seclang-parser.yy"
+  case 359: // var: "REQUEST_BODY"
+#line 3038 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::RequestBody());
       }
-#line 4520 "seclang-parser.cc"
+#line 5480 "seclang-parser.cc"
     break;
 
-  case 305: // var: "REQUEST_BODY_LENGTH"
-#line 2449 "seclang-parser.yy"
+  case 360: // var: "REQUEST_BODY_LENGTH"
+#line 3042 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::RequestBodyLength());
       }
-#line 4528 "seclang-parser.cc"
+#line 5488 "seclang-parser.cc"
     break;
 
-  case 306: // var: "REQUEST_FILENAME"
-#line 2453 "seclang-parser.yy"
+  case 361: // var: "REQUEST_FILENAME"
+#line 3046 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::RequestFilename());
       }
-#line 4536 "seclang-parser.cc"
+#line 5496 "seclang-parser.cc"
     break;
 
-  case 307: // var: "REQUEST_LINE"
-#line 2457 "seclang-parser.yy"
+  case 362: // var: "REQUEST_LINE"
+#line 3050 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::RequestLine());
       }
-#line 4544 "seclang-parser.cc"
+#line 5504 "seclang-parser.cc"
     break;
 
-  case 308: // var: "REQUEST_METHOD"
-#line 2461 "seclang-parser.yy"
+  case 363: // var: "REQUEST_METHOD"
+#line 3054 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::RequestMethod());
       }
-#line 4552 "seclang-parser.cc"
+#line 5512 "seclang-parser.cc"
     break;
 
-  case 309: // var: "REQUEST_PROTOCOL"
-#line 2465 "seclang-parser.yy"
+  case 364: // var: "REQUEST_PROTOCOL"
+#line 3058 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::RequestProtocol());
       }
-#line 4560 "seclang-parser.cc"
+#line 5520 "seclang-parser.cc"
     break;
 
-  case 310: // var: "REQUEST_URI"
-#line 2469 "seclang-parser.yy"
+  case 365: // var: "REQUEST_URI"
+#line 3062 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::RequestURI());
       }
-#line 4568 "seclang-parser.cc"
+#line 5528 "seclang-parser.cc"
     break;
 
-  case 311: // var: "REQUEST_URI_RAW"
-#line 2473 "seclang-parser.yy"
+  case 366: // var: "REQUEST_URI_RAW"
+#line 3066 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::RequestURIRaw());
       }
-#line 4576 "seclang-parser.cc"
+#line 5536 "seclang-parser.cc"
     break;
 
-  case 312: // var: "RESPONSE_BODY"
-#line 2477 "seclang-parser.yy"
+  case 367: // var: "RESPONSE_BODY"
+#line 3070 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ResponseBody());
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ResponseBody);
       }
-#line 4584 "seclang-parser.cc"
+#line 5545 "seclang-parser.cc"
     break;
 
-  case 313: // var: "RESPONSE_CONTENT_LENGTH"
-#line 2481 "seclang-parser.yy"
+  case 368: // var: "RESPONSE_CONTENT_LENGTH"
+#line 3075 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ResponseContentLength());
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ResponseBody);
       }
-#line 4592 "seclang-parser.cc"
+#line 5554 "seclang-parser.cc"
     break;
 
-  case 314: // var: "RESPONSE_PROTOCOL"
-#line 2485 "seclang-parser.yy"
+  case 369: // var: "RESPONSE_PROTOCOL"
+#line 3080 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ResponseProtocol());
       }
-#line 4600 "seclang-parser.cc"
+#line 5562 "seclang-parser.cc"
     break;
 
-  case 315: // var: "RESPONSE_STATUS"
-#line 2489 "seclang-parser.yy"
+  case 370: // var: "RESPONSE_STATUS"
+#line 3084 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ResponseStatus());
       }
-#line 4608 "seclang-parser.cc"
+#line 5570 "seclang-parser.cc"
     break;
 
-  case 316: // var: "SERVER_ADDR"
-#line 2493 "seclang-parser.yy"
+  case 371: // var: "SERVER_ADDR"
+#line 3088 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ServerAddr());
       }
-#line 4616 "seclang-parser.cc"
+#line 5578 "seclang-parser.cc"
     break;
 
-  case 317: // var: "SERVER_NAME"
-#line 2497 "seclang-parser.yy"
+  case 372: // var: "SERVER_NAME"
+#line 3092 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ServerName());
       }
-#line 4624 "seclang-parser.cc"
+#line 5586 "seclang-parser.cc"
     break;
 
-  case 318: // var: "SERVER_PORT"
-#line 2501 "seclang-parser.yy"
+  case 373: // var: "SERVER_PORT"
+#line 3096 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::ServerPort());
       }
-#line 4632 "seclang-parser.cc"
+#line 5594 "seclang-parser.cc"
     break;
 
-  case 319: // var: "SESSIONID"
-#line 2505 "seclang-parser.yy"
+  case 374: // var: "SESSIONID"
+#line 3100 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::SessionID());
       }
-#line 4640 "seclang-parser.cc"
+#line 5602 "seclang-parser.cc"
     break;
 
-  case 320: // var: "UNIQUE_ID"
-#line 2509 "seclang-parser.yy"
+  case 375: // var: "UNIQUE_ID"
+#line 3104 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::UniqueID());
       }
-#line 4648 "seclang-parser.cc"
+#line 5610 "seclang-parser.cc"
     break;
 
-  case 321: // var: "URLENCODED_ERROR"
-#line 2513 "seclang-parser.yy"
+  case 376: // var: "URLENCODED_ERROR"
+#line 3108 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::UrlEncodedError());
       }
-#line 4656 "seclang-parser.cc"
+#line 5618 "seclang-parser.cc"
     break;
 
-  case 322: // var: "USERID"
-#line 2517 "seclang-parser.yy"
+  case 377: // var: "USERID"
+#line 3112 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::UserID());
       }
-#line 4664 "seclang-parser.cc"
+#line 5626 "seclang-parser.cc"
     break;
 
-  case 323: // var: "VARIABLE_STATUS"
-#line 2521 "seclang-parser.yy"
+  case 378: // var: "VARIABLE_STATUS"
+#line 3116 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Status());
       }
-#line 4672 "seclang-parser.cc"
+#line 5634 "seclang-parser.cc"
     break;
 
-  case 324: // var: "VARIABLE_STATUS_LINE"
-#line 2525 "seclang-parser.yy"
+  case 379: // var: "VARIABLE_STATUS_LINE"
+#line 3120 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::Status());
       }
-#line 4680 "seclang-parser.cc"
+#line 5642 "seclang-parser.cc"
     break;
 
-  case 325: // var: "WEBAPPID"
-#line 2529 "seclang-parser.yy"
+  case 380: // var: "WEBAPPID"
+#line 3124 "seclang-parser.yy"
       {
         VARIABLE_CONTAINER(yylhs.value.as < std::unique_ptr<Variable> > (), new variables::WebAppId());
       }
-#line 4688 "seclang-parser.cc"
+#line 5650 "seclang-parser.cc"
     break;
 
-  case 326: // var: "RUN_TIME_VAR_DUR"
-#line 2533 "seclang-parser.yy"
+  case 381: // var: "RUN_TIME_VAR_DUR"
+#line 3128 "seclang-parser.yy"
       {
         std::string name(yystack_[0].value.as < std::string > ());
         char z = name.at(0);
         std::unique_ptr<Variable> c(new Duration(name));
         yylhs.value.as < std::unique_ptr<Variable> > () = std::move(c);
       }
-#line 4699 "seclang-parser.cc"
+#line 5661 "seclang-parser.cc"
     break;
 
-  case 327: // var: "RUN_TIME_VAR_BLD"
-#line 2541 "seclang-parser.yy"
+  case 382: // var: "RUN_TIME_VAR_BLD"
+#line 3136 "seclang-parser.yy"
       {
         std::string name(yystack_[0].value.as < std::string > ());
         char z = name.at(0);
         std::unique_ptr<Variable> c(new ModsecBuild(name));
         yylhs.value.as < std::unique_ptr<Variable> > () = std::move(c);
       }
-#line 4710 "seclang-parser.cc"
+#line 5672 "seclang-parser.cc"
     break;
 
-  case 328: // var: "RUN_TIME_VAR_HSV"
-#line 2548 "seclang-parser.yy"
+  case 383: // var: "RUN_TIME_VAR_HSV"
+#line 3143 "seclang-parser.yy"
       {
         std::string name(yystack_[0].value.as < std::string > ());
         char z = name.at(0);
         std::unique_ptr<Variable> c(new HighestSeverity(name));
         yylhs.value.as < std::unique_ptr<Variable> > () = std::move(c);
       }
-#line 4721 "seclang-parser.cc"
+#line 5683 "seclang-parser.cc"
     break;
 
-  case 329: // var: "RUN_TIME_VAR_REMOTE_USER"
-#line 2555 "seclang-parser.yy"
+  case 384: // var: "RUN_TIME_VAR_REMOTE_USER"
+#line 3150 "seclang-parser.yy"
       {
         std::string name(yystack_[0].value.as < std::string > ());
         char z = name.at(0);
         std::unique_ptr<Variable> c(new RemoteUser(name));
         yylhs.value.as < std::unique_ptr<Variable> > () = std::move(c);
       }
-#line 4732 "seclang-parser.cc"
+#line 5694 "seclang-parser.cc"
     break;
 
-  case 330: // var: "RUN_TIME_VAR_TIME"
-#line 2562 "seclang-parser.yy"
+  case 385: // var: "RUN_TIME_VAR_TIME"
+#line 3157 "seclang-parser.yy"
       {
         std::string name(yystack_[0].value.as < std::string > ());
         char z = name.at(0);
         std::unique_ptr<Variable> c(new Time(name));
         yylhs.value.as < std::unique_ptr<Variable> > () = std::move(c);
       }
-#line 4743 "seclang-parser.cc"
+#line 5705 "seclang-parser.cc"
     break;
 
-  case 331: // var: "RUN_TIME_VAR_TIME_DAY"
-#line 2569 "seclang-parser.yy"
+  case 386: // var: "RUN_TIME_VAR_TIME_DAY"
+#line 3164 "seclang-parser.yy"
       {
         std::string name(yystack_[0].value.as < std::string > ());
         char z = name.at(0);
         std::unique_ptr<Variable> c(new TimeDay(name));
         yylhs.value.as < std::unique_ptr<Variable> > () = std::move(c);
       }
-#line 4754 "seclang-parser.cc"
+#line 5716 "seclang-parser.cc"
     break;
 
-  case 332: // var: "RUN_TIME_VAR_TIME_EPOCH"
-#line 2576 "seclang-parser.yy"
+  case 387: // var: "RUN_TIME_VAR_TIME_EPOCH"
+#line 3171 "seclang-parser.yy"
       {
         std::string name(yystack_[0].value.as < std::string > ());
         char z = name.at(0);
         std::unique_ptr<Variable> c(new TimeEpoch(name));
         yylhs.value.as < std::unique_ptr<Variable> > () = std::move(c);
       }
-#line 4765 "seclang-parser.cc"
+#line 5727 "seclang-parser.cc"
     break;
 
-  case 333: // var: "RUN_TIME_VAR_TIME_HOUR"
-#line 2583 "seclang-parser.yy"
+  case 388: // var: "RUN_TIME_VAR_TIME_HOUR"
+#line 3178 "seclang-parser.yy"
       {
         std::string name(yystack_[0].value.as < std::string > ());
         char z = name.at(0);
         std::unique_ptr<Variable> c(new TimeHour(name));
         yylhs.value.as < std::unique_ptr<Variable> > () = std::move(c);
       }
-#line 4776 "seclang-parser.cc"
+#line 5738 "seclang-parser.cc"
     break;
 
-  case 334: // var: "RUN_TIME_VAR_TIME_MIN"
-#line 2590 "seclang-parser.yy"
+  case 389: // var: "RUN_TIME_VAR_TIME_MIN"
+#line 3185 "seclang-parser.yy"
       {
         std::string name(yystack_[0].value.as < std::string > ());
         char z = name.at(0);
         std::unique_ptr<Variable> c(new TimeMin(name));
         yylhs.value.as < std::unique_ptr<Variable> > () = std::move(c);
       }
-#line 4787 "seclang-parser.cc"
+#line 5749 "seclang-parser.cc"
     break;
 
-  case 335: // var: "RUN_TIME_VAR_TIME_MON"
-#line 2597 "seclang-parser.yy"
+  case 390: // var: "RUN_TIME_VAR_TIME_MON"
+#line 3192 "seclang-parser.yy"
       {
         std::string name(yystack_[0].value.as < std::string > ());
         char z = name.at(0);
         std::unique_ptr<Variable> c(new TimeMon(name));
         yylhs.value.as < std::unique_ptr<Variable> > () = std::move(c);
       }
-#line 4798 "seclang-parser.cc"
+#line 5760 "seclang-parser.cc"
     break;
 
-  case 336: // var: "RUN_TIME_VAR_TIME_SEC"
-#line 2604 "seclang-parser.yy"
+  case 391: // var: "RUN_TIME_VAR_TIME_SEC"
+#line 3199 "seclang-parser.yy"
       {
         std::string name(yystack_[0].value.as < std::string > ());
         char z = name.at(0);
             std::unique_ptr<Variable> c(new TimeSec(name));
             yylhs.value.as < std::unique_ptr<Variable> > () = std::move(c);
       }
-#line 4809 "seclang-parser.cc"
+#line 5771 "seclang-parser.cc"
     break;
 
-  case 337: // var: "RUN_TIME_VAR_TIME_WDAY"
-#line 2611 "seclang-parser.yy"
+  case 392: // var: "RUN_TIME_VAR_TIME_WDAY"
+#line 3206 "seclang-parser.yy"
       {
         std::string name(yystack_[0].value.as < std::string > ());
         char z = name.at(0);
         std::unique_ptr<Variable> c(new TimeWDay(name));
         yylhs.value.as < std::unique_ptr<Variable> > () = std::move(c);
       }
-#line 4820 "seclang-parser.cc"
+#line 5782 "seclang-parser.cc"
     break;
 
-  case 338: // var: "RUN_TIME_VAR_TIME_YEAR"
-#line 2618 "seclang-parser.yy"
+  case 393: // var: "RUN_TIME_VAR_TIME_YEAR"
+#line 3213 "seclang-parser.yy"
       {
         std::string name(yystack_[0].value.as < std::string > ());
         char z = name.at(0);
         std::unique_ptr<Variable> c(new TimeYear(name));
         yylhs.value.as < std::unique_ptr<Variable> > () = std::move(c);
       }
-#line 4831 "seclang-parser.cc"
+#line 5793 "seclang-parser.cc"
     break;
 
-  case 339: // act: "Accuracy"
-#line 2628 "seclang-parser.yy"
+  case 394: // act: "Accuracy"
+#line 3223 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::Accuracy(yystack_[0].value.as < std::string > ()));
       }
-#line 4839 "seclang-parser.cc"
+#line 5801 "seclang-parser.cc"
     break;
 
-  case 340: // act: "Allow"
-#line 2632 "seclang-parser.yy"
+  case 395: // act: "Allow"
+#line 3227 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::disruptive::Allow(yystack_[0].value.as < std::string > ()));
       }
-#line 4847 "seclang-parser.cc"
+#line 5809 "seclang-parser.cc"
     break;
 
-  case 341: // act: "Append"
-#line 2636 "seclang-parser.yy"
+  case 396: // act: "Append"
+#line 3231 "seclang-parser.yy"
       {
         ACTION_NOT_SUPPORTED("Append", yystack_[1].location);
       }
-#line 4855 "seclang-parser.cc"
+#line 5817 "seclang-parser.cc"
     break;
 
-  case 342: // act: "AuditLog"
-#line 2640 "seclang-parser.yy"
+  case 397: // act: "AuditLog"
+#line 3235 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::AuditLog(yystack_[0].value.as < std::string > ()));
       }
-#line 4863 "seclang-parser.cc"
+#line 5825 "seclang-parser.cc"
     break;
 
-  case 343: // act: "Block"
-#line 2644 "seclang-parser.yy"
+  case 398: // act: "Block"
+#line 3239 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::Block(yystack_[0].value.as < std::string > ()));
       }
-#line 4871 "seclang-parser.cc"
+#line 5833 "seclang-parser.cc"
     break;
 
-  case 344: // act: "Capture"
-#line 2648 "seclang-parser.yy"
+  case 399: // act: "Capture"
+#line 3243 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::Capture(yystack_[0].value.as < std::string > ()));
       }
-#line 4879 "seclang-parser.cc"
+#line 5841 "seclang-parser.cc"
     break;
 
-  case 345: // act: "Chain"
-#line 2652 "seclang-parser.yy"
+  case 400: // act: "Chain"
+#line 3247 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::Chain(yystack_[0].value.as < std::string > ()));
       }
-#line 4887 "seclang-parser.cc"
+#line 5849 "seclang-parser.cc"
     break;
 
-  case 346: // act: "ACTION_CTL_AUDIT_ENGINE" "CONFIG_VALUE_ON"
-#line 2656 "seclang-parser.yy"
+  case 401: // act: "ACTION_CTL_AUDIT_ENGINE" "CONFIG_VALUE_ON"
+#line 3251 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::ctl::AuditEngine("ctl:auditengine=on"));
         driver.m_auditLog->setCtlAuditEngineActive();
       }
-#line 4896 "seclang-parser.cc"
+#line 5858 "seclang-parser.cc"
     break;
 
-  case 347: // act: "ACTION_CTL_AUDIT_ENGINE" "CONFIG_VALUE_OFF"
-#line 2661 "seclang-parser.yy"
+  case 402: // act: "ACTION_CTL_AUDIT_ENGINE" "CONFIG_VALUE_OFF"
+#line 3256 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::ctl::AuditEngine("ctl:auditengine=off"));
       }
-#line 4904 "seclang-parser.cc"
+#line 5866 "seclang-parser.cc"
     break;
 
-  case 348: // act: "ACTION_CTL_AUDIT_ENGINE" "CONFIG_VALUE_RELEVANT_ONLY"
-#line 2665 "seclang-parser.yy"
+  case 403: // act: "ACTION_CTL_AUDIT_ENGINE" "CONFIG_VALUE_RELEVANT_ONLY"
+#line 3260 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::ctl::AuditEngine("ctl:auditengine=relevantonly"));
         driver.m_auditLog->setCtlAuditEngineActive();
       }
-#line 4913 "seclang-parser.cc"
+#line 5875 "seclang-parser.cc"
     break;
 
-  case 349: // act: "ACTION_CTL_AUDIT_LOG_PARTS"
-#line 2670 "seclang-parser.yy"
+  case 404: // act: "ACTION_CTL_AUDIT_LOG_PARTS"
+#line 3265 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::ctl::AuditLogParts(yystack_[0].value.as < std::string > ()));
+        /* may ask for the part E */
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ResponseBody);
+      }
+#line 5885 "seclang-parser.cc"
+    break;
+
+  case 405: // act: "ACTION_CTL_BDY_GRPC"
+#line 3271 "seclang-parser.yy"
+      {
+        ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::ctl::RequestBodyProcessorGRPC(yystack_[0].value.as < std::string > ()));
       }
-#line 4921 "seclang-parser.cc"
+#line 5893 "seclang-parser.cc"
     break;
 
-  case 350: // act: "ACTION_CTL_BDY_JSON"
-#line 2674 "seclang-parser.yy"
+  case 406: // act: "ACTION_CTL_BDY_JSON"
+#line 3275 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::ctl::RequestBodyProcessorJSON(yystack_[0].value.as < std::string > ()));
       }
-#line 4929 "seclang-parser.cc"
+#line 5901 "seclang-parser.cc"
     break;
 
-  case 351: // act: "ACTION_CTL_BDY_XML"
-#line 2678 "seclang-parser.yy"
+  case 407: // act: "ACTION_CTL_BDY_XML"
+#line 3279 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::ctl::RequestBodyProcessorXML(yystack_[0].value.as < std::string > ()));
       }
-#line 4937 "seclang-parser.cc"
+#line 5909 "seclang-parser.cc"
     break;
 
-  case 352: // act: "ACTION_CTL_BDY_URLENCODED"
-#line 2682 "seclang-parser.yy"
+  case 408: // act: "ACTION_CTL_BDY_URLENCODED"
+#line 3283 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::ctl::RequestBodyProcessorURLENCODED(yystack_[0].value.as < std::string > ()));
       }
-#line 4945 "seclang-parser.cc"
+#line 5917 "seclang-parser.cc"
     break;
 
-  case 353: // act: "ACTION_CTL_FORCE_REQ_BODY_VAR" "CONFIG_VALUE_ON"
-#line 2686 "seclang-parser.yy"
+  case 409: // act: "ACTION_CTL_FORCE_REQ_BODY_VAR" "CONFIG_VALUE_ON"
+#line 3287 "seclang-parser.yy"
       {
         //ACTION_NOT_SUPPORTED("CtlForceReequestBody", @0);
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::Action(yystack_[1].value.as < std::string > ()));
       }
-#line 4954 "seclang-parser.cc"
+#line 5926 "seclang-parser.cc"
     break;
 
-  case 354: // act: "ACTION_CTL_FORCE_REQ_BODY_VAR" "CONFIG_VALUE_OFF"
-#line 2691 "seclang-parser.yy"
+  case 410: // act: "ACTION_CTL_FORCE_REQ_BODY_VAR" "CONFIG_VALUE_OFF"
+#line 3292 "seclang-parser.yy"
       {
         //ACTION_NOT_SUPPORTED("CtlForceReequestBody", @0);
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::Action(yystack_[1].value.as < std::string > ()));
       }
-#line 4963 "seclang-parser.cc"
+#line 5935 "seclang-parser.cc"
     break;
 
-  case 355: // act: "ACTION_CTL_REQUEST_BODY_ACCESS" "CONFIG_VALUE_ON"
-#line 2696 "seclang-parser.yy"
+  case 411: // act: "ACTION_CTL_REQUEST_BODY_ACCESS" "CONFIG_VALUE_ON"
+#line 3297 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::ctl::RequestBodyAccess(yystack_[1].value.as < std::string > () + "true"));
       }
-#line 4971 "seclang-parser.cc"
+#line 5943 "seclang-parser.cc"
     break;
 
-  case 356: // act: "ACTION_CTL_REQUEST_BODY_ACCESS" "CONFIG_VALUE_OFF"
-#line 2700 "seclang-parser.yy"
+  case 412: // act: "ACTION_CTL_REQUEST_BODY_ACCESS" "CONFIG_VALUE_OFF"
+#line 3301 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::ctl::RequestBodyAccess(yystack_[1].value.as < std::string > () + "false"));
       }
-#line 4979 "seclang-parser.cc"
+#line 5951 "seclang-parser.cc"
     break;
 
-  case 357: // act: "ACTION_CTL_RULE_ENGINE" "CONFIG_VALUE_ON"
-#line 2704 "seclang-parser.yy"
+  case 413: // act: "ACTION_CTL_RULE_ENGINE" "CONFIG_VALUE_ON"
+#line 3305 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::ctl::RuleEngine("ctl:RuleEngine=on"));
       }
-#line 4987 "seclang-parser.cc"
+#line 5959 "seclang-parser.cc"
     break;
 
-  case 358: // act: "ACTION_CTL_RULE_ENGINE" "CONFIG_VALUE_OFF"
-#line 2708 "seclang-parser.yy"
+  case 414: // act: "ACTION_CTL_RULE_ENGINE" "CONFIG_VALUE_OFF"
+#line 3309 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::ctl::RuleEngine("ctl:RuleEngine=off"));
       }
-#line 4995 "seclang-parser.cc"
+#line 5967 "seclang-parser.cc"
     break;
 
-  case 359: // act: "ACTION_CTL_RULE_ENGINE" "CONFIG_VALUE_DETC"
-#line 2712 "seclang-parser.yy"
+  case 415: // act: "ACTION_CTL_RULE_ENGINE" "CONFIG_VALUE_DETC"
+#line 3313 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::ctl::RuleEngine("ctl:RuleEngine=detectiononly"));
       }
-#line 5003 "seclang-parser.cc"
+#line 5975 "seclang-parser.cc"
     break;
 
-  case 360: // act: "ACTION_CTL_RULE_REMOVE_BY_ID"
-#line 2716 "seclang-parser.yy"
+  case 416: // act: "ACTION_CTL_RULE_REMOVE_BY_ID"
+#line 3317 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::ctl::RuleRemoveById(yystack_[0].value.as < std::string > ()));
       }
-#line 5011 "seclang-parser.cc"
+#line 5983 "seclang-parser.cc"
     break;
 
-  case 361: // act: "ACTION_CTL_RULE_REMOVE_BY_TAG"
-#line 2720 "seclang-parser.yy"
+  case 417: // act: "ACTION_CTL_RULE_REMOVE_BY_TAG"
+#line 3321 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::ctl::RuleRemoveByTag(yystack_[0].value.as < std::string > ()));
       }
-#line 5019 "seclang-parser.cc"
+#line 5991 "seclang-parser.cc"
     break;
 
-  case 362: // act: "ACTION_CTL_RULE_REMOVE_TARGET_BY_ID"
-#line 2724 "seclang-parser.yy"
+  case 418: // act: "ACTION_CTL_RULE_REMOVE_TARGET_BY_ID"
+#line 3325 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::ctl::RuleRemoveTargetById(yystack_[0].value.as < std::string > ()));
       }
-#line 5027 "seclang-parser.cc"
+#line 5999 "seclang-parser.cc"
     break;
 
-  case 363: // act: "ACTION_CTL_RULE_REMOVE_TARGET_BY_TAG"
-#line 2728 "seclang-parser.yy"
+  case 419: // act: "ACTION_CTL_RULE_REMOVE_TARGET_BY_TAG"
+#line 3329 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::ctl::RuleRemoveTargetByTag(yystack_[0].value.as < std::string > ()));
       }
-#line 5035 "seclang-parser.cc"
+#line 6007 "seclang-parser.cc"
     break;
 
-  case 364: // act: "Deny"
-#line 2732 "seclang-parser.yy"
+  case 420: // act: "Deny"
+#line 3333 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::disruptive::Deny(yystack_[0].value.as < std::string > ()));
       }
-#line 5043 "seclang-parser.cc"
+#line 6015 "seclang-parser.cc"
     break;
 
-  case 365: // act: "DeprecateVar"
-#line 2736 "seclang-parser.yy"
+  case 421: // act: "DeprecateVar"
+#line 3337 "seclang-parser.yy"
       {
         ACTION_NOT_SUPPORTED("DeprecateVar", yystack_[1].location);
       }
-#line 5051 "seclang-parser.cc"
+#line 6023 "seclang-parser.cc"
     break;
 
-  case 366: // act: "Drop"
-#line 2740 "seclang-parser.yy"
+  case 422: // act: "Drop"
+#line 3341 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::disruptive::Drop(yystack_[0].value.as < std::string > ()));
       }
-#line 5059 "seclang-parser.cc"
+#line 6031 "seclang-parser.cc"
     break;
 
-  case 367: // act: "Exec"
-#line 2744 "seclang-parser.yy"
+  case 423: // act: "Exec"
+#line 3345 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::Exec(yystack_[0].value.as < std::string > ()));
+        driver.m_variablesInUse.addAll();
+        driver.m_xmlDomRequired = modsecurity::RulesSetProperties::TrueConfigBoolean;
       }
-#line 5067 "seclang-parser.cc"
+#line 6041 "seclang-parser.cc"
     break;
 
-  case 368: // act: "ExpireVar"
-#line 2748 "seclang-parser.yy"
+  case 424: // act: "ExpireVar"
+#line 3351 "seclang-parser.yy"
       {
         //ACTION_NOT_SUPPORTED("ExpireVar", @0);
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::Action(yystack_[0].value.as < std::string > ()));
       }
-#line 5076 "seclang-parser.cc"
+#line 6050 "seclang-parser.cc"
     break;
 
-  case 369: // act: "Id"
-#line 2753 "seclang-parser.yy"
+  case 425: // act: "Id"
+#line 3356 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::RuleId(yystack_[0].value.as < std::string > ()));
       }
-#line 5084 "seclang-parser.cc"
+#line 6058 "seclang-parser.cc"
     break;
 
-  case 370: // act: "InitCol" run_time_string
-#line 2757 "seclang-parser.yy"
+  case 426: // act: "InitCol" run_time_string
+#line 3360 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::InitCol(yystack_[1].value.as < std::string > (), std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 5092 "seclang-parser.cc"
+#line 6066 "seclang-parser.cc"
     break;
 
-  case 371: // act: "LogData" run_time_string
-#line 2761 "seclang-parser.yy"
+  case 427: // act: "LogData" run_time_string
+#line 3364 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::LogData(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 5100 "seclang-parser.cc"
+#line 6074 "seclang-parser.cc"
     break;
 
-  case 372: // act: "Log"
-#line 2765 "seclang-parser.yy"
+  case 428: // act: "Log"
+#line 3368 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::Log(yystack_[0].value.as < std::string > ()));
       }
-#line 5108 "seclang-parser.cc"
+#line 6082 "seclang-parser.cc"
     break;
 
-  case 373: // act: "Maturity"
-#line 2769 "seclang-parser.yy"
+  case 429: // act: "Maturity"
+#line 3372 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::Maturity(yystack_[0].value.as < std::string > ()));
       }
-#line 5116 "seclang-parser.cc"
+#line 6090 "seclang-parser.cc"
     break;
 
-  case 374: // act: "Msg" run_time_string
-#line 2773 "seclang-parser.yy"
+  case 430: // act: "Msg" run_time_string
+#line 3376 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::Msg(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 5124 "seclang-parser.cc"
+#line 6098 "seclang-parser.cc"
     break;
 
-  case 375: // act: "MultiMatch"
-#line 2777 "seclang-parser.yy"
+  case 431: // act: "MultiMatch"
+#line 3380 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::MultiMatch(yystack_[0].value.as < std::string > ()));
       }
-#line 5132 "seclang-parser.cc"
+#line 6106 "seclang-parser.cc"
     break;
 
-  case 376: // act: "NoAuditLog"
-#line 2781 "seclang-parser.yy"
+  case 432: // act: "NoAuditLog"
+#line 3384 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::NoAuditLog(yystack_[0].value.as < std::string > ()));
       }
-#line 5140 "seclang-parser.cc"
+#line 6114 "seclang-parser.cc"
     break;
 
-  case 377: // act: "NoLog"
-#line 2785 "seclang-parser.yy"
+  case 433: // act: "NoLog"
+#line 3388 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::NoLog(yystack_[0].value.as < std::string > ()));
       }
-#line 5148 "seclang-parser.cc"
+#line 6122 "seclang-parser.cc"
     break;
 
-  case 378: // act: "Pass"
-#line 2789 "seclang-parser.yy"
+  case 434: // act: "NoVerdictCache"
+#line 3392 "seclang-parser.yy"
+      {
+        ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::NoVerdictCache(yystack_[0].value.as < std::string > ()));
+      }
+#line 6130 "seclang-parser.cc"
+    break;
+
+  case 435: // act: "Pass"
+#line 3396 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::disruptive::Pass(yystack_[0].value.as < std::string > ()));
       }
-#line 5156 "seclang-parser.cc"
+#line 6138 "seclang-parser.cc"
     break;
 
-  case 379: // act: "Pause"
-#line 2793 "seclang-parser.yy"
+  case 436: // act: "Pause"
+#line 3400 "seclang-parser.yy"
       {
         ACTION_NOT_SUPPORTED("Pause", yystack_[1].location);
       }
-#line 5164 "seclang-parser.cc"
+#line 6146 "seclang-parser.cc"
     break;
 
-  case 380: // act: "Phase"
-#line 2797 "seclang-parser.yy"
+  case 437: // act: "Phase"
+#line 3404 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::Phase(yystack_[0].value.as < std::string > ()));
       }
-#line 5172 "seclang-parser.cc"
+#line 6154 "seclang-parser.cc"
     break;
 
-  case 381: // act: "Prepend"
-#line 2801 "seclang-parser.yy"
+  case 438: // act: "Prepend"
+#line 3408 "seclang-parser.yy"
       {
         ACTION_NOT_SUPPORTED("Prepend", yystack_[1].location);
       }
-#line 5180 "seclang-parser.cc"
+#line 6162 "seclang-parser.cc"
     break;
 
-  case 382: // act: "Proxy"
-#line 2805 "seclang-parser.yy"
+  case 439: // act: "Proxy"
+#line 3412 "seclang-parser.yy"
       {
         ACTION_NOT_SUPPORTED("Proxy", yystack_[1].location);
       }
-#line 5188 "seclang-parser.cc"
+#line 6170 "seclang-parser.cc"
     break;
 
-  case 383: // act: "Redirect" run_time_string
-#line 2809 "seclang-parser.yy"
+  case 440: // act: "Redirect" run_time_string
+#line 3416 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::disruptive::Redirect(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 5196 "seclang-parser.cc"
+#line 6178 "seclang-parser.cc"
     break;
 
-  case 384: // act: "Rev"
-#line 2813 "seclang-parser.yy"
+  case 441: // act: "Rev"
+#line 3420 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::Rev(yystack_[0].value.as < std::string > ()));
       }
-#line 5204 "seclang-parser.cc"
+#line 6186 "seclang-parser.cc"
     break;
 
-  case 385: // act: "SanitiseArg"
-#line 2817 "seclang-parser.yy"
+  case 442: // act: "SanitiseArg"
+#line 3424 "seclang-parser.yy"
       {
         ACTION_NOT_SUPPORTED("SanitiseArg", yystack_[1].location);
       }
-#line 5212 "seclang-parser.cc"
+#line 6194 "seclang-parser.cc"
     break;
 
-  case 386: // act: "SanitiseMatched"
-#line 2821 "seclang-parser.yy"
+  case 443: // act: "SanitiseMatched"
+#line 3428 "seclang-parser.yy"
       {
         ACTION_NOT_SUPPORTED("SanitiseMatched", yystack_[1].location);
       }
-#line 5220 "seclang-parser.cc"
+#line 6202 "seclang-parser.cc"
     break;
 
-  case 387: // act: "SanitiseMatchedBytes"
-#line 2825 "seclang-parser.yy"
+  case 444: // act: "SanitiseMatchedBytes"
+#line 3432 "seclang-parser.yy"
       {
         ACTION_NOT_SUPPORTED("SanitiseMatchedBytes", yystack_[1].location);
       }
-#line 5228 "seclang-parser.cc"
+#line 6210 "seclang-parser.cc"
     break;
 
-  case 388: // act: "SanitiseRequestHeader"
-#line 2829 "seclang-parser.yy"
+  case 445: // act: "SanitiseRequestHeader"
+#line 3436 "seclang-parser.yy"
       {
         ACTION_NOT_SUPPORTED("SanitiseRequestHeader", yystack_[1].location);
       }
-#line 5236 "seclang-parser.cc"
+#line 6218 "seclang-parser.cc"
     break;
 
-  case 389: // act: "SanitiseResponseHeader"
-#line 2833 "seclang-parser.yy"
+  case 446: // act: "SanitiseResponseHeader"
+#line 3440 "seclang-parser.yy"
       {
         ACTION_NOT_SUPPORTED("SanitiseResponseHeader", yystack_[1].location);
       }
-#line 5244 "seclang-parser.cc"
+#line 6226 "seclang-parser.cc"
     break;
 
-  case 390: // act: "SetEnv" run_time_string
-#line 2837 "seclang-parser.yy"
+  case 447: // act: "SetEnv" run_time_string
+#line 3444 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::SetENV(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 5252 "seclang-parser.cc"
+#line 6234 "seclang-parser.cc"
     break;
 
-  case 391: // act: "SetRsc" run_time_string
-#line 2841 "seclang-parser.yy"
+  case 448: // act: "SetRsc" run_time_string
+#line 3448 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::SetRSC(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 5260 "seclang-parser.cc"
+#line 6242 "seclang-parser.cc"
     break;
 
-  case 392: // act: "SetSid" run_time_string
-#line 2845 "seclang-parser.yy"
+  case 449: // act: "SetSid" run_time_string
+#line 3452 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::SetSID(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 5268 "seclang-parser.cc"
+#line 6250 "seclang-parser.cc"
     break;
 
-  case 393: // act: "SetUID" run_time_string
-#line 2849 "seclang-parser.yy"
+  case 450: // act: "SetUID" run_time_string
+#line 3456 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::SetUID(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 5276 "seclang-parser.cc"
+#line 6258 "seclang-parser.cc"
     break;
 
-  case 394: // act: "SetVar" setvar_action
-#line 2853 "seclang-parser.yy"
+  case 451: // act: "SetVar" setvar_action
+#line 3460 "seclang-parser.yy"
       {
         yylhs.value.as < std::unique_ptr<actions::Action> > () = std::move(yystack_[0].value.as < std::unique_ptr<actions::Action> > ());
       }
-#line 5284 "seclang-parser.cc"
+#line 6266 "seclang-parser.cc"
     break;
 
-  case 395: // act: "Severity"
-#line 2857 "seclang-parser.yy"
+  case 452: // act: "Severity"
+#line 3464 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::Severity(yystack_[0].value.as < std::string > ()));
       }
-#line 5292 "seclang-parser.cc"
+#line 6274 "seclang-parser.cc"
     break;
 
-  case 396: // act: "Skip"
-#line 2861 "seclang-parser.yy"
+  case 453: // act: "Skip"
+#line 3468 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::Skip(yystack_[0].value.as < std::string > ()));
       }
-#line 5300 "seclang-parser.cc"
+#line 6282 "seclang-parser.cc"
     break;
 
-  case 397: // act: "SkipAfter"
-#line 2865 "seclang-parser.yy"
+  case 454: // act: "SkipAfter"
+#line 3472 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::SkipAfter(yystack_[0].value.as < std::string > ()));
       }
-#line 5308 "seclang-parser.cc"
+#line 6290 "seclang-parser.cc"
     break;
 
-  case 398: // act: "Status"
-#line 2869 "seclang-parser.yy"
+  case 455: // act: "Status"
+#line 3476 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::data::Status(yystack_[0].value.as < std::string > ()));
       }
-#line 5316 "seclang-parser.cc"
+#line 6298 "seclang-parser.cc"
     break;
 
-  case 399: // act: "Tag" run_time_string
-#line 2873 "seclang-parser.yy"
+  case 456: // act: "Tag" run_time_string
+#line 3480 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::Tag(std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 5324 "seclang-parser.cc"
+#line 6306 "seclang-parser.cc"
     break;
 
-  case 400: // act: "Ver"
-#line 2877 "seclang-parser.yy"
+  case 457: // act: "Ver"
+#line 3484 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::Ver(yystack_[0].value.as < std::string > ()));
       }
-#line 5332 "seclang-parser.cc"
+#line 6314 "seclang-parser.cc"
     break;
 
-  case 401: // act: "xmlns"
-#line 2881 "seclang-parser.yy"
+  case 458: // act: "xmlns"
+#line 3488 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::XmlNS(yystack_[0].value.as < std::string > ()));
       }
-#line 5340 "seclang-parser.cc"
+#line 6322 "seclang-parser.cc"
     break;
 
-  case 402: // act: "ACTION_TRANSFORMATION_PARITY_ZERO_7_BIT"
-#line 2885 "seclang-parser.yy"
+  case 459: // act: "ACTION_TRANSFORMATION_PARITY_ZERO_7_BIT"
+#line 3492 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::ParityZero7bit(yystack_[0].value.as < std::string > ()));
       }
-#line 5348 "seclang-parser.cc"
+#line 6330 "seclang-parser.cc"
     break;
 
-  case 403: // act: "ACTION_TRANSFORMATION_PARITY_ODD_7_BIT"
-#line 2889 "seclang-parser.yy"
+  case 460: // act: "ACTION_TRANSFORMATION_PARITY_ODD_7_BIT"
+#line 3496 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::ParityOdd7bit(yystack_[0].value.as < std::string > ()));
       }
-#line 5356 "seclang-parser.cc"
+#line 6338 "seclang-parser.cc"
     break;
 
-  case 404: // act: "ACTION_TRANSFORMATION_PARITY_EVEN_7_BIT"
-#line 2893 "seclang-parser.yy"
+  case 461: // act: "ACTION_TRANSFORMATION_PARITY_EVEN_7_BIT"
+#line 3500 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::ParityEven7bit(yystack_[0].value.as < std::string > ()));
       }
-#line 5364 "seclang-parser.cc"
+#line 6346 "seclang-parser.cc"
     break;
 
-  case 405: // act: "ACTION_TRANSFORMATION_SQL_HEX_DECODE"
-#line 2897 "seclang-parser.yy"
+  case 462: // act: "ACTION_TRANSFORMATION_SQL_HEX_DECODE"
+#line 3504 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::SqlHexDecode(yystack_[0].value.as < std::string > ()));
       }
-#line 5372 "seclang-parser.cc"
+#line 6354 "seclang-parser.cc"
     break;
 
-  case 406: // act: "ACTION_TRANSFORMATION_BASE_64_ENCODE"
-#line 2901 "seclang-parser.yy"
+  case 463: // act: "ACTION_TRANSFORMATION_BASE_64_ENCODE"
+#line 3508 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::Base64Encode(yystack_[0].value.as < std::string > ()));
       }
-#line 5380 "seclang-parser.cc"
+#line 6362 "seclang-parser.cc"
     break;
 
-  case 407: // act: "ACTION_TRANSFORMATION_BASE_64_DECODE"
-#line 2905 "seclang-parser.yy"
+  case 464: // act: "ACTION_TRANSFORMATION_BASE_64_DECODE"
+#line 3512 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::Base64Decode(yystack_[0].value.as < std::string > ()));
       }
-#line 5388 "seclang-parser.cc"
+#line 6370 "seclang-parser.cc"
     break;
 
-  case 408: // act: "ACTION_TRANSFORMATION_BASE_64_DECODE_EXT"
-#line 2909 "seclang-parser.yy"
+  case 465: // act: "ACTION_TRANSFORMATION_BASE_64_DECODE_EXT"
+#line 3516 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::Base64DecodeExt(yystack_[0].value.as < std::string > ()));
       }
-#line 5396 "seclang-parser.cc"
+#line 6378 "seclang-parser.cc"
     break;
 
-  case 409: // act: "ACTION_TRANSFORMATION_CMD_LINE"
-#line 2913 "seclang-parser.yy"
+  case 466: // act: "ACTION_TRANSFORMATION_CMD_LINE"
+#line 3520 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::CmdLine(yystack_[0].value.as < std::string > ()));
       }
-#line 5404 "seclang-parser.cc"
+#line 6386 "seclang-parser.cc"
     break;
 
-  case 410: // act: "ACTION_TRANSFORMATION_SHA1"
-#line 2917 "seclang-parser.yy"
+  case 467: // act: "ACTION_TRANSFORMATION_SHA1"
+#line 3524 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::Sha1(yystack_[0].value.as < std::string > ()));
       }
-#line 5412 "seclang-parser.cc"
+#line 6394 "seclang-parser.cc"
     break;
 
-  case 411: // act: "ACTION_TRANSFORMATION_MD5"
-#line 2921 "seclang-parser.yy"
+  case 468: // act: "ACTION_TRANSFORMATION_MD5"
+#line 3528 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::Md5(yystack_[0].value.as < std::string > ()));
       }
-#line 5420 "seclang-parser.cc"
+#line 6402 "seclang-parser.cc"
     break;
 
-  case 412: // act: "ACTION_TRANSFORMATION_ESCAPE_SEQ_DECODE"
-#line 2925 "seclang-parser.yy"
+  case 469: // act: "ACTION_TRANSFORMATION_ESCAPE_SEQ_DECODE"
+#line 3532 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::EscapeSeqDecode(yystack_[0].value.as < std::string > ()));
       }
-#line 5428 "seclang-parser.cc"
+#line 6410 "seclang-parser.cc"
     break;
 
-  case 413: // act: "ACTION_TRANSFORMATION_HEX_ENCODE"
-#line 2929 "seclang-parser.yy"
+  case 470: // act: "ACTION_TRANSFORMATION_HEX_ENCODE"
+#line 3536 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::HexEncode(yystack_[0].value.as < std::string > ()));
       }
-#line 5436 "seclang-parser.cc"
+#line 6418 "seclang-parser.cc"
     break;
 
-  case 414: // act: "ACTION_TRANSFORMATION_HEX_DECODE"
-#line 2933 "seclang-parser.yy"
+  case 471: // act: "ACTION_TRANSFORMATION_HEX_DECODE"
+#line 3540 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::HexDecode(yystack_[0].value.as < std::string > ()));
       }
-#line 5444 "seclang-parser.cc"
+#line 6426 "seclang-parser.cc"
     break;
 
-  case 415: // act: "ACTION_TRANSFORMATION_LOWERCASE"
-#line 2937 "seclang-parser.yy"
+  case 472: // act: "ACTION_TRANSFORMATION_LOWERCASE"
+#line 3544 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::LowerCase(yystack_[0].value.as < std::string > ()));
       }
-#line 5452 "seclang-parser.cc"
+#line 6434 "seclang-parser.cc"
     break;
 
-  case 416: // act: "ACTION_TRANSFORMATION_UPPERCASE"
-#line 2941 "seclang-parser.yy"
+  case 473: // act: "ACTION_TRANSFORMATION_UPPERCASE"
+#line 3548 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::UpperCase(yystack_[0].value.as < std::string > ()));
       }
-#line 5460 "seclang-parser.cc"
+#line 6442 "seclang-parser.cc"
     break;
 
-  case 417: // act: "ACTION_TRANSFORMATION_URL_DECODE_UNI"
-#line 2945 "seclang-parser.yy"
+  case 474: // act: "ACTION_TRANSFORMATION_URL_DECODE_UNI"
+#line 3552 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::UrlDecodeUni(yystack_[0].value.as < std::string > ()));
       }
-#line 5468 "seclang-parser.cc"
+#line 6450 "seclang-parser.cc"
     break;
 
-  case 418: // act: "ACTION_TRANSFORMATION_URL_DECODE"
-#line 2949 "seclang-parser.yy"
+  case 475: // act: "ACTION_TRANSFORMATION_URL_DECODE"
+#line 3556 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::UrlDecode(yystack_[0].value.as < std::string > ()));
       }
-#line 5476 "seclang-parser.cc"
+#line 6458 "seclang-parser.cc"
     break;
 
-  case 419: // act: "ACTION_TRANSFORMATION_URL_ENCODE"
-#line 2953 "seclang-parser.yy"
+  case 476: // act: "ACTION_TRANSFORMATION_URL_ENCODE"
+#line 3560 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::UrlEncode(yystack_[0].value.as < std::string > ()));
       }
-#line 5484 "seclang-parser.cc"
+#line 6466 "seclang-parser.cc"
     break;
 
-  case 420: // act: "ACTION_TRANSFORMATION_NONE"
-#line 2957 "seclang-parser.yy"
+  case 477: // act: "ACTION_TRANSFORMATION_NONE"
+#line 3564 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::None(yystack_[0].value.as < std::string > ()));
       }
-#line 5492 "seclang-parser.cc"
+#line 6474 "seclang-parser.cc"
     break;
 
-  case 421: // act: "ACTION_TRANSFORMATION_COMPRESS_WHITESPACE"
-#line 2961 "seclang-parser.yy"
+  case 478: // act: "ACTION_TRANSFORMATION_COMPRESS_WHITESPACE"
+#line 3568 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::CompressWhitespace(yystack_[0].value.as < std::string > ()));
       }
-#line 5500 "seclang-parser.cc"
+#line 6482 "seclang-parser.cc"
     break;
 
-  case 422: // act: "ACTION_TRANSFORMATION_REMOVE_WHITESPACE"
-#line 2965 "seclang-parser.yy"
+  case 479: // act: "ACTION_TRANSFORMATION_REMOVE_WHITESPACE"
+#line 3572 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::RemoveWhitespace(yystack_[0].value.as < std::string > ()));
       }
-#line 5508 "seclang-parser.cc"
+#line 6490 "seclang-parser.cc"
     break;
 
-  case 423: // act: "ACTION_TRANSFORMATION_REPLACE_NULLS"
-#line 2969 "seclang-parser.yy"
+  case 480: // act: "ACTION_TRANSFORMATION_REPLACE_NULLS"
+#line 3576 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::ReplaceNulls(yystack_[0].value.as < std::string > ()));
       }
-#line 5516 "seclang-parser.cc"
+#line 6498 "seclang-parser.cc"
     break;
 
-  case 424: // act: "ACTION_TRANSFORMATION_REMOVE_NULLS"
-#line 2973 "seclang-parser.yy"
+  case 481: // act: "ACTION_TRANSFORMATION_REMOVE_NULLS"
+#line 3580 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::RemoveNulls(yystack_[0].value.as < std::string > ()));
       }
-#line 5524 "seclang-parser.cc"
+#line 6506 "seclang-parser.cc"
     break;
 
-  case 425: // act: "ACTION_TRANSFORMATION_HTML_ENTITY_DECODE"
-#line 2977 "seclang-parser.yy"
+  case 482: // act: "ACTION_TRANSFORMATION_HTML_ENTITY_DECODE"
+#line 3584 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::HtmlEntityDecode(yystack_[0].value.as < std::string > ()));
       }
-#line 5532 "seclang-parser.cc"
+#line 6514 "seclang-parser.cc"
     break;
 
-  case 426: // act: "ACTION_TRANSFORMATION_JS_DECODE"
-#line 2981 "seclang-parser.yy"
+  case 483: // act: "ACTION_TRANSFORMATION_JS_DECODE"
+#line 3588 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::JsDecode(yystack_[0].value.as < std::string > ()));
       }
-#line 5540 "seclang-parser.cc"
+#line 6522 "seclang-parser.cc"
     break;
 
-  case 427: // act: "ACTION_TRANSFORMATION_CSS_DECODE"
-#line 2985 "seclang-parser.yy"
+  case 484: // act: "ACTION_TRANSFORMATION_CSS_DECODE"
+#line 3592 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::CssDecode(yystack_[0].value.as < std::string > ()));
       }
-#line 5548 "seclang-parser.cc"
+#line 6530 "seclang-parser.cc"
     break;
 
-  case 428: // act: "ACTION_TRANSFORMATION_TRIM"
-#line 2989 "seclang-parser.yy"
+  case 485: // act: "ACTION_TRANSFORMATION_TRIM"
+#line 3596 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::Trim(yystack_[0].value.as < std::string > ()));
       }
-#line 5556 "seclang-parser.cc"
+#line 6538 "seclang-parser.cc"
     break;
 
-  case 429: // act: "ACTION_TRANSFORMATION_TRIM_LEFT"
-#line 2993 "seclang-parser.yy"
+  case 486: // act: "ACTION_TRANSFORMATION_TRIM_LEFT"
+#line 3600 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::TrimLeft(yystack_[0].value.as < std::string > ()));
       }
-#line 5564 "seclang-parser.cc"
+#line 6546 "seclang-parser.cc"
     break;
 
-  case 430: // act: "ACTION_TRANSFORMATION_TRIM_RIGHT"
-#line 2997 "seclang-parser.yy"
+  case 487: // act: "ACTION_TRANSFORMATION_TRIM_RIGHT"
+#line 3604 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::TrimRight(yystack_[0].value.as < std::string > ()));
       }
-#line 5572 "seclang-parser.cc"
+#line 6554 "seclang-parser.cc"
     break;
 
-  case 431: // act: "ACTION_TRANSFORMATION_NORMALISE_PATH_WIN"
-#line 3001 "seclang-parser.yy"
+  case 488: // act: "ACTION_TRANSFORMATION_NORMALISE_PATH_WIN"
+#line 3608 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::NormalisePathWin(yystack_[0].value.as < std::string > ()));
       }
-#line 5580 "seclang-parser.cc"
+#line 6562 "seclang-parser.cc"
     break;
 
-  case 432: // act: "ACTION_TRANSFORMATION_NORMALISE_PATH"
-#line 3005 "seclang-parser.yy"
+  case 489: // act: "ACTION_TRANSFORMATION_NORMALISE_PATH"
+#line 3612 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::NormalisePath(yystack_[0].value.as < std::string > ()));
       }
-#line 5588 "seclang-parser.cc"
+#line 6570 "seclang-parser.cc"
     break;
 
-  case 433: // act: "ACTION_TRANSFORMATION_LENGTH"
-#line 3009 "seclang-parser.yy"
+  case 490: // act: "ACTION_TRANSFORMATION_LENGTH"
+#line 3616 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::Length(yystack_[0].value.as < std::string > ()));
       }
-#line 5596 "seclang-parser.cc"
+#line 6578 "seclang-parser.cc"
     break;
 
-  case 434: // act: "ACTION_TRANSFORMATION_UTF8_TO_UNICODE"
-#line 3013 "seclang-parser.yy"
+  case 491: // act: "ACTION_TRANSFORMATION_UTF8_TO_UNICODE"
+#line 3620 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::Utf8ToUnicode(yystack_[0].value.as < std::string > ()));
       }
-#line 5604 "seclang-parser.cc"
+#line 6586 "seclang-parser.cc"
     break;
 
-  case 435: // act: "ACTION_TRANSFORMATION_REMOVE_COMMENTS_CHAR"
-#line 3017 "seclang-parser.yy"
+  case 492: // act: "ACTION_TRANSFORMATION_REMOVE_COMMENTS_CHAR"
+#line 3624 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::RemoveCommentsChar(yystack_[0].value.as < std::string > ()));
       }
-#line 5612 "seclang-parser.cc"
+#line 6594 "seclang-parser.cc"
     break;
 
-  case 436: // act: "ACTION_TRANSFORMATION_REMOVE_COMMENTS"
-#line 3021 "seclang-parser.yy"
+  case 493: // act: "ACTION_TRANSFORMATION_REMOVE_COMMENTS"
+#line 3628 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::RemoveComments(yystack_[0].value.as < std::string > ()));
       }
-#line 5620 "seclang-parser.cc"
+#line 6602 "seclang-parser.cc"
     break;
 
-  case 437: // act: "ACTION_TRANSFORMATION_REPLACE_COMMENTS"
-#line 3025 "seclang-parser.yy"
+  case 494: // act: "ACTION_TRANSFORMATION_REPLACE_COMMENTS"
+#line 3632 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::transformations::ReplaceComments(yystack_[0].value.as < std::string > ()));
       }
-#line 5628 "seclang-parser.cc"
+#line 6610 "seclang-parser.cc"
     break;
 
-  case 438: // setvar_action: "NOT" var
-#line 3032 "seclang-parser.yy"
+  case 495: // setvar_action: "NOT" var
+#line 3639 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::SetVar(actions::SetVarOperation::unsetOperation, std::move(yystack_[0].value.as < std::unique_ptr<Variable> > ())));
       }
-#line 5636 "seclang-parser.cc"
+#line 6618 "seclang-parser.cc"
     break;
 
-  case 439: // setvar_action: var
-#line 3036 "seclang-parser.yy"
+  case 496: // setvar_action: var
+#line 3643 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::SetVar(actions::SetVarOperation::setToOneOperation, std::move(yystack_[0].value.as < std::unique_ptr<Variable> > ())));
       }
-#line 5644 "seclang-parser.cc"
+#line 6626 "seclang-parser.cc"
     break;
 
-  case 440: // setvar_action: var SETVAR_OPERATION_EQUALS run_time_string
-#line 3040 "seclang-parser.yy"
+  case 497: // setvar_action: var SETVAR_OPERATION_EQUALS run_time_string
+#line 3647 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::SetVar(actions::SetVarOperation::setOperation, std::move(yystack_[2].value.as < std::unique_ptr<Variable> > ()), std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 5652 "seclang-parser.cc"
+#line 6634 "seclang-parser.cc"
     break;
 
-  case 441: // setvar_action: var SETVAR_OPERATION_EQUALS_PLUS run_time_string
-#line 3044 "seclang-parser.yy"
+  case 498: // setvar_action: var SETVAR_OPERATION_EQUALS_PLUS run_time_string
+#line 3651 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::SetVar(actions::SetVarOperation::sumAndSetOperation, std::move(yystack_[2].value.as < std::unique_ptr<Variable> > ()), std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 5660 "seclang-parser.cc"
+#line 6642 "seclang-parser.cc"
     break;
 
-  case 442: // setvar_action: var SETVAR_OPERATION_EQUALS_MINUS run_time_string
-#line 3048 "seclang-parser.yy"
+  case 499: // setvar_action: var SETVAR_OPERATION_EQUALS_MINUS run_time_string
+#line 3655 "seclang-parser.yy"
       {
         ACTION_CONTAINER(yylhs.value.as < std::unique_ptr<actions::Action> > (), new actions::SetVar(actions::SetVarOperation::substractAndSetOperation, std::move(yystack_[2].value.as < std::unique_ptr<Variable> > ()), std::move(yystack_[0].value.as < std::unique_ptr<RunTimeString> > ())));
       }
-#line 5668 "seclang-parser.cc"
+#line 6650 "seclang-parser.cc"
     break;
 
-  case 443: // run_time_string: run_time_string "FREE_TEXT_QUOTE_MACRO_EXPANSION"
-#line 3055 "seclang-parser.yy"
+  case 500: // run_time_string: run_time_string "FREE_TEXT_QUOTE_MACRO_EXPANSION"
+#line 3662 "seclang-parser.yy"
       {
         yystack_[1].value.as < std::unique_ptr<RunTimeString> > ()->appendText(yystack_[0].value.as < std::string > ());
         yylhs.value.as < std::unique_ptr<RunTimeString> > () = std::move(yystack_[1].value.as < std::unique_ptr<RunTimeString> > ());
       }
-#line 5677 "seclang-parser.cc"
+#line 6659 "seclang-parser.cc"
     break;
 
-  case 444: // run_time_string: run_time_string var
-#line 3060 "seclang-parser.yy"
+  case 501: // run_time_string: run_time_string var
+#line 3667 "seclang-parser.yy"
       {
         yystack_[1].value.as < std::unique_ptr<RunTimeString> > ()->appendVar(std::move(yystack_[0].value.as < std::unique_ptr<Variable> > ()));
         yylhs.value.as < std::unique_ptr<RunTimeString> > () = std::move(yystack_[1].value.as < std::unique_ptr<RunTimeString> > ());
       }
-#line 5686 "seclang-parser.cc"
+#line 6668 "seclang-parser.cc"
     break;
 
-  case 445: // run_time_string: "FREE_TEXT_QUOTE_MACRO_EXPANSION"
-#line 3065 "seclang-parser.yy"
+  case 502: // run_time_string: "FREE_TEXT_QUOTE_MACRO_EXPANSION"
+#line 3672 "seclang-parser.yy"
       {
         std::unique_ptr<RunTimeString> r(new RunTimeString());
         r->appendText(yystack_[0].value.as < std::string > ());
         yylhs.value.as < std::unique_ptr<RunTimeString> > () = std::move(r);
       }
-#line 5696 "seclang-parser.cc"
+#line 6678 "seclang-parser.cc"
     break;
 
-  case 446: // run_time_string: var
-#line 3071 "seclang-parser.yy"
+  case 503: // run_time_string: var
+#line 3678 "seclang-parser.yy"
       {
         std::unique_ptr<RunTimeString> r(new RunTimeString());
         r->appendVar(std::move(yystack_[0].value.as < std::unique_ptr<Variable> > ()));
         yylhs.value.as < std::unique_ptr<RunTimeString> > () = std::move(r);
       }
-#line 5706 "seclang-parser.cc"
+#line 6688 "seclang-parser.cc"
     break;
 
 
-#line 5710 "seclang-parser.cc"
+#line 6692 "seclang-parser.cc"
 
             default:
               break;
@@ -6058,706 +7040,715 @@ namespace yy {
   }
 
 
-  const short seclang_parser::yypact_ninf_ = -308;
+  const short seclang_parser::yypact_ninf_ = -471;
 
   const signed char seclang_parser::yytable_ninf_ = -1;
 
   const short
   seclang_parser::yypact_[] =
   {
-    2802,  -308,  -279,  -308,  -102,  -308,  -143,  -308,  -308,  -308,
-    -308,  -308,  -294,  -308,  -308,  -308,  -308,  -308,  -276,  -308,
-    -308,  -308,  -101,   -99,  -308,  -308,  -308,  -308,  -308,  -308,
-    -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,   -97,
-    -308,  -308,   -98,  -308,   -93,  -308,   -94,   -89,  -308,  -286,
-     -92,   -92,  -308,  -308,  -308,  -308,   -87,  -303,  -308,  -308,
-    -308,  1508,  1508,  1508,   -92,  -273,   -85,  -308,  -308,  -308,
-     -83,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,
-    1508,   -92,  2946,  -308,  -308,  -308,  -308,  -308,  -308,  -308,
-    -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,
-    -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,
-    -308,  -308,  -308,  -308,  -308,  2364,  -261,  -308,  -308,  -308,
-    -308,  -308,  -308,  -308,  -267,  -308,  -308,  -308,  -308,   -81,
-     -79,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,
-    -308,  2499,  -308,  2499,  -308,  2499,  -308,  -308,  -308,  -308,
-    -308,  -308,  -308,  -308,  2499,  -308,  -308,  -308,  -308,  -308,
-    -308,  2499,  2499,  2499,  2499,  -308,  -308,  -308,  -308,  2499,
-    -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,
-    -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,
-    -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,
-    -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  3133,  -308,
-       2,  -308,  -308,  -308,  -308,  -308,  -308,  2698,  2698,  -307,
-    -292,  -197,  -193,  -192,  -187,  -186,  -183,  -182,  -172,  -171,
-    -168,  -167,  -164,  -163,  -160,  -159,  -308,  -156,  -155,  -152,
-    -151,  -308,  -308,  -148,  -308,  -308,  -308,  -308,  -308,  -308,
-    -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,
-    -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,
-    -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,
-    -308,  -147,  -308,  -308,  -308,  -308,  -308,   462,  -308,  -308,
-    -308,  -144,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,
-    -308,  -308,  -308,  -308,   554,   646,   984,  1076,  1168,  -141,
-    -140,  1602,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,
-    -308,  -308,  -308,  -308,  -308,  -308,    16,  -308,  -308,  -308,
-    -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  2030,  -308,
-    -308,  -308,  -308,  2698,   -53,  -308,  -308,  -308,  -308,  -308,
-    -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  2591,  2591,
-    2591,  2591,  2591,  2591,  2591,  2591,  2591,     3,  3133,  -308,
-    -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,
-    -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,
-    -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,
-    -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,
-    -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  -308,  2591,
-    -308,  -308,  -308,  -308,  2591,  -308,  -308,  2591,  -308,  -308,
-    2591,  -308,  -308,  2591,  -308,  -308,  2591,  -308,  -308,  -308,
-    -308,     8,  1696,  2165,  2499,  2499,  2499,  -308,  -308,  2499,
-    2499,  2499,  -308,  2499,  2499,  2499,  2499,  2499,  2499,  2499,
-    2499,  2499,  2499,  2499,  2499,  2499,  2499,  2499,  2499,  -308,
-    2499,  2499,  2499,  2499,  -308,  -308,  2499,  2499,  2499,  2499,
-    2499,   -92,  -308,  2591,  -308,  2499,  2499,  2499,  -308,  -308,
-    -308,  -308,  -308,  2698,  2698,  -308,  -308,  2591,  2591,  2591,
-    2591,  2591,  2591,  2591,  2591,  2591,  2591,  2591,  2591,  2591,
-    2591,  2591,  2591,  2591,  2591,  2591,  2591,  2591,  2591,  2591,
-    2591,  2591,  2591,  2591,  2591,  2591,  2591,  2591,  2591,  -308,
-    2591,  2591,  2591,  -308,  -308
+    2852,  -471,  -323,  -471,  -106,  -471,  -307,  -471,  -471,  -471,
+    -471,  -471,  -471,  -342,  -471,  -471,  -471,  -471,  -471,  -471,
+     -57,  -346,  -471,  -471,  -471,   -55,   -51,  -471,  -471,  -471,
+    -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,
+    -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,
+    -471,  -471,  -471,  -471,  -471,  -471,   -49,  -471,   -45,  -471,
+     -43,   -41,  -471,  -471,   -42,  -471,   -37,  -471,   -38,  -471,
+     -33,  -471,   -22,   -20,   -18,   -16,  -319,   -75,   -75,  -471,
+    -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,
+    -471,  -471,  -471,  -471,   -14,  -471,  -345,  -471,  -471,  -471,
+    1321,  1321,  1321,   -75,  -333,   -12,   -10,  -471,  -471,  -471,
+    -471,    -8,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,
+    -471,  1321,   -75,  3057,  -471,  -471,  -471,  -471,  -471,  -471,
+    -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,
+    -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,
+    -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,
+    -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,
+    -471,  -471,  -471,  -471,  -471,  2414,  -315,  -471,  -471,  -471,
+    -471,  -471,  -471,  -471,  -325,  -471,  -471,  -471,  -471,  -471,
+      -6,    -4,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,
+    -471,  -471,  2513,  -471,  2513,  -471,  2513,  -471,  -471,  -471,
+    -471,  -471,  -471,  -471,  -471,  -471,  2513,  -471,  -471,  -471,
+    -471,  -471,  -471,  2513,  2513,  2513,  2513,  -471,  -471,  -471,
+    -471,  2513,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,
+    -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,
+    -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,
+    -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,
+    3311,  -471,     6,  -471,  -471,  -471,  -471,  -471,  -471,  2895,
+    2895,  -383,  -343,  -340,  -339,  -336,  -335,  -332,  -331,  -328,
+    -327,  -324,  -321,  -223,  -222,  -219,  -218,  -117,  -471,  -116,
+    -113,  -112,  -109,  -471,  -471,  -108,  -471,  -471,  -471,  -471,
+    -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,
+    -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,
+    -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,
+    -471,  -471,  -471,  -471,  -471,  -105,  -471,  -471,  -471,  -471,
+    -471,   171,  -471,  -471,  -471,  -104,  -471,  -471,  -471,  -471,
+    -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,   557,   651,
+     745,  1131,  1225,  -101,   -98,  1705,  -471,  -471,  -471,  -471,
+    -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,
+      14,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,
+    -471,  -471,  -471,  -471,  1895,  -471,  -471,  -471,  -471,  2895,
+     -60,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,
+    -471,  -471,  -471,  -471,  2659,  2659,  2659,  2659,  2659,  2659,
+    2659,  2659,  2659,     0,  3311,  -471,  -471,  -471,  -471,  -471,
+    -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,
+    -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,
+    -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,
+    -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,  -471,
+    -471,  -471,  -471,  -471,  -471,  2659,  -471,  -471,  -471,  -471,
+    2659,  -471,  -471,  2659,  -471,  -471,  2659,  -471,  -471,  2659,
+    -471,  -471,  2659,  -471,  -471,  -471,  -471,    -2,  1801,  2277,
+    2513,  2513,  2513,  -471,  -471,  2513,  2513,  2513,  -471,  2513,
+    2513,  2513,  2513,  2513,  2513,  2513,  2513,  2513,  2513,  2513,
+    2513,  2513,  2513,  2513,  2513,  -471,  2513,  2513,  2513,  2513,
+    -471,  -471,  2513,  2513,  2513,  2513,  2513,   -75,  -471,  2659,
+    -471,  2513,  2513,  2513,  -471,  -471,  -471,  -471,  -471,  2895,
+    2895,  -471,  -471,  2659,  2659,  2659,  2659,  2659,  2659,  2659,
+    2659,  2659,  2659,  2659,  2659,  2659,  2659,  2659,  2659,  2659,
+    2659,  2659,  2659,  2659,  2659,  2659,  2659,  2659,  2659,  2659,
+    2659,  2659,  2659,  2659,  2659,  -471,  2659,  2659,  2659,  -471,
+    -471
   };
 
   const short
   seclang_parser::yydefact_[] =
   {
-       0,     2,     0,   143,     0,    89,     0,    88,    92,    93,
-       7,     6,     0,    11,    14,    12,    13,    17,     0,   126,
-     125,    94,     0,     0,   102,   103,   104,   105,    99,   127,
-     106,   107,   141,   140,   110,   111,   112,   128,   129,     0,
-     132,   130,     0,   131,     0,   133,     0,     0,   115,     0,
-       0,     0,    80,   152,   153,   154,     0,     0,   118,   120,
-     119,     0,     0,     0,     0,     0,     0,    26,    24,    25,
-       0,   142,   148,   149,   150,   147,   151,   116,   117,   146,
-       0,     0,     0,     4,    74,     5,    98,    97,    15,    16,
-      91,    90,     9,    10,     8,    20,    19,    18,    96,    95,
-     101,   100,    85,    84,   134,   135,    87,    86,   136,   137,
-     114,   113,    83,    81,    82,     0,     0,   339,   340,   341,
-     342,   343,   344,   345,     0,   349,   350,   351,   352,     0,
-       0,   360,   361,   362,   363,   364,   365,   366,   367,   368,
-     369,     0,   372,     0,   373,     0,   375,   376,   377,   378,
-     379,   380,   381,   382,     0,   384,   385,   386,   387,   388,
-     389,     0,     0,     0,     0,   395,   396,   397,   398,     0,
-     406,   407,   408,   409,   421,   427,   412,   413,   414,   425,
-     426,   433,   415,   411,   420,   432,   431,   404,   403,   402,
-     436,   435,   424,   422,   437,   423,   410,   405,   428,   429,
-     430,   416,   419,   418,   417,   434,   400,   401,     0,    77,
-      30,    32,    79,   109,   108,   138,   139,     0,     0,   166,
-     169,   172,   175,   178,   181,   184,   187,   190,   193,   196,
-     199,   202,   205,   208,   211,   214,   267,   256,   217,   253,
-     259,   268,   269,   226,   270,   271,   272,   273,   274,   275,
-     276,   277,   278,   279,   280,   281,   282,   283,   284,   285,
-     286,   287,   288,   289,   290,   291,   292,   293,   294,   295,
-     296,   297,   299,   298,   302,   301,   300,   303,   305,   304,
-     306,   262,   307,   308,   309,   311,   310,   230,   312,   313,
-     263,   266,   314,   315,   316,   317,   318,   319,   320,   321,
-     322,   325,   323,   324,   234,   238,   246,   250,   242,   220,
-     223,     0,   327,   326,   328,   329,   330,   331,   332,   333,
-     334,   335,   336,   337,   338,   121,   156,   161,   122,   123,
-     124,    22,    21,    23,    28,    27,   144,   145,     0,   155,
-      78,     1,     3,     0,   439,   394,   359,   358,   357,   347,
-     346,   348,   354,   353,   356,   355,   445,   446,   370,   371,
-     374,   383,   390,   391,   392,   393,   399,     0,     0,   163,
-     162,   164,   165,   167,   168,   170,   171,   173,   174,   176,
-     177,   179,   180,   182,   183,   185,   186,   188,   189,   191,
-     192,   194,   195,   197,   198,   200,   201,   203,   204,   206,
-     207,   209,   210,   212,   213,   254,   255,   215,   216,   251,
-     252,   257,   258,   224,   225,   260,   261,   228,   229,   227,
-     264,   265,   232,   233,   231,   236,   237,   235,   244,   245,
-     243,   248,   249,   247,   240,   241,   239,   218,   219,   221,
-     222,     0,     0,     0,     0,     0,     0,    38,    39,     0,
-       0,     0,    73,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,    37,
-       0,     0,     0,     0,    40,    41,     0,     0,     0,     0,
-       0,    76,    33,    35,   438,     0,     0,     0,   443,   444,
-      29,    31,   157,     0,     0,   158,    34,    36,    72,    56,
-      55,    57,    58,    43,    59,    52,    60,    42,    61,    62,
-      63,    64,    65,    66,    67,    53,    68,    69,    70,    71,
-      44,    45,    46,    47,    48,    49,    50,    51,    54,    75,
-     440,   441,   442,   160,   159
+       0,     2,     0,   177,     0,    99,     0,    98,   102,   103,
+      11,     7,     6,     0,    13,    16,    14,    15,    12,    22,
+       0,     0,   136,   135,   104,     0,     0,   112,   113,   114,
+     115,   109,   137,   116,   117,   160,   161,   168,   167,   166,
+     162,   163,   164,   165,   169,   170,   171,   172,   173,   174,
+     175,   159,   120,   121,   122,   138,     0,   141,     0,   144,
+       0,     0,   149,   147,     0,   148,     0,   150,     0,   155,
+       0,   125,     0,     0,     0,     0,     0,     0,     0,    90,
+     194,   201,   195,   196,   202,   197,   198,   199,   200,   204,
+     205,   206,   203,   207,     0,   156,     0,   128,   130,   129,
+       0,     0,     0,     0,     0,     0,     0,    34,    31,    32,
+      33,     0,   176,   190,   191,   192,   189,   193,   126,   127,
+     188,     0,     0,     0,     4,    84,     5,   108,   107,    17,
+      18,    19,   101,   100,     9,    10,     8,    20,    21,    25,
+      24,    26,    23,    27,   106,   105,   111,   110,   139,   140,
+     142,   143,   145,   146,    95,    94,   151,   152,    97,    96,
+     153,   154,   124,   123,   178,   179,   180,   181,   182,   183,
+     184,   185,    93,    91,    92,     0,     0,   394,   395,   396,
+     397,   398,   399,   400,     0,   404,   405,   406,   407,   408,
+       0,     0,   416,   417,   418,   419,   420,   421,   422,   423,
+     424,   425,     0,   428,     0,   429,     0,   431,   432,   433,
+     434,   435,   436,   437,   438,   439,     0,   441,   442,   443,
+     444,   445,   446,     0,     0,     0,     0,   452,   453,   454,
+     455,     0,   463,   464,   465,   466,   478,   484,   469,   470,
+     471,   482,   483,   490,   472,   468,   477,   489,   488,   461,
+     460,   459,   493,   492,   481,   479,   494,   480,   467,   462,
+     485,   486,   487,   473,   476,   475,   474,   491,   457,   458,
+       0,    87,    40,    42,    89,   119,   118,   157,   158,     0,
+       0,   219,   222,   225,   228,   231,   234,   237,   240,   243,
+     246,   249,   252,   255,   258,   261,   264,   267,   320,   309,
+     270,   306,   312,   321,   322,   279,   323,   324,   325,   326,
+     327,   328,   329,   330,   331,   332,   333,   334,   335,   336,
+     337,   338,   339,   340,   341,   342,   343,   344,   345,   346,
+     347,   348,   349,   350,   351,   352,   354,   353,   357,   356,
+     355,   358,   360,   359,   361,   315,   362,   363,   364,   366,
+     365,   283,   367,   368,   316,   319,   369,   370,   371,   372,
+     373,   374,   375,   376,   377,   380,   378,   379,   287,   291,
+     299,   303,   295,   273,   276,     0,   382,   381,   383,   384,
+     385,   386,   387,   388,   389,   390,   391,   392,   393,   131,
+     209,   214,   132,   133,   134,    29,    28,    30,    36,    35,
+      38,    37,   186,   187,     0,   208,    88,     1,     3,     0,
+     496,   451,   415,   414,   413,   402,   401,   403,   410,   409,
+     412,   411,   502,   503,   426,   427,   430,   440,   447,   448,
+     449,   450,   456,     0,     0,   216,   215,   217,   218,   220,
+     221,   223,   224,   226,   227,   229,   230,   232,   233,   235,
+     236,   238,   239,   241,   242,   244,   245,   247,   248,   250,
+     251,   253,   254,   256,   257,   259,   260,   262,   263,   265,
+     266,   307,   308,   268,   269,   304,   305,   310,   311,   277,
+     278,   313,   314,   281,   282,   280,   317,   318,   285,   286,
+     284,   289,   290,   288,   297,   298,   296,   301,   302,   300,
+     293,   294,   292,   271,   272,   274,   275,     0,     0,     0,
+       0,     0,     0,    48,    49,     0,     0,     0,    83,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,    47,     0,     0,     0,     0,
+      50,    51,     0,     0,     0,     0,     0,    86,    43,    45,
+     495,     0,     0,     0,   500,   501,    39,    41,   210,     0,
+       0,   211,    44,    46,    82,    66,    65,    67,    68,    53,
+      69,    62,    70,    52,    71,    72,    73,    74,    75,    76,
+      77,    63,    78,    79,    80,    81,    54,    55,    56,    57,
+      58,    59,    60,    61,    64,    85,   497,   498,   499,   213,
+     212
   };
 
   const short
   seclang_parser::yypgoto_[] =
   {
-    -308,  -308,   -74,  -308,   -47,   -59,  -308,  -211,  -308,  -308,
-     -51,   -78,   -61,  -134,  -308,  -136
+    -471,  -471,   -99,  -471,   -52,  -242,  -471,  -470,  -471,  -471,
+     -96,  -302,  -100,  -256,  -471,  3230
   };
 
   const short
   seclang_parser::yydefgoto_[] =
   {
-       0,    82,    83,    84,   209,   210,   481,   482,    85,   338,
-     325,   326,   357,   211,   345,   358
+       0,   123,   124,   125,   271,   272,   547,   548,   126,   404,
+     389,   390,   423,   273,   411,   424
   };
 
   const short
   seclang_parser::yytable_[] =
   {
-     327,   327,   327,   215,   212,   368,   368,   359,   342,   360,
-     115,   328,   329,   216,   442,    92,    93,   330,   361,   327,
-      94,   112,   442,   113,   114,   362,   363,   364,   365,   339,
-      86,    87,    95,   366,   340,    96,   331,   332,   371,    97,
-     372,   333,   349,   350,    88,    89,   346,   351,   347,   348,
-     485,   486,   487,   373,   344,   374,   116,   117,   118,   119,
-     120,   121,   122,   123,   124,   125,   126,   127,   128,   129,
-     130,   131,   132,   133,   134,   135,   136,   137,   138,   139,
-     140,   141,   142,   143,   144,   145,   146,   147,   148,   149,
-     150,   151,   152,   153,   154,   155,   156,   157,   158,   159,
-     160,   161,   162,   163,   164,   165,   166,   167,   168,   169,
-     170,   171,   172,   173,   174,   175,   176,   177,   178,   179,
+     391,   391,   391,   434,   508,   392,   393,   277,   139,   434,
+     437,   140,   438,   134,   135,   141,   142,   143,   136,   278,
+     508,   391,   395,   396,   408,   405,   274,   397,   433,   175,
+     415,   416,   127,   128,   172,   417,   173,   174,   412,   562,
+     413,   414,   129,   130,   131,   551,   552,   553,   132,   133,
+     439,   394,   440,   441,   443,   442,   444,   445,   447,   446,
+     448,   449,   451,   450,   452,   453,   455,   454,   456,   457,
+     406,   458,   459,   507,   460,   410,   176,   177,   178,   179,
      180,   181,   182,   183,   184,   185,   186,   187,   188,   189,
      190,   191,   192,   193,   194,   195,   196,   197,   198,   199,
-     200,   201,   202,   203,   204,   205,   206,   207,   375,   367,
-     376,   419,   377,   379,   378,   380,   369,   370,   381,   383,
-     382,   384,   385,   387,   386,   388,    90,    91,   424,   427,
-     430,   433,   436,   389,   391,   390,   392,   393,   395,   394,
-     396,   397,   399,   398,   400,   401,   403,   402,   404,   405,
-     407,   406,   408,   409,   411,   410,   412,   413,   415,   414,
-     416,   420,   483,   421,   437,   439,   438,   440,    98,    99,
-     100,   101,   102,   103,   104,   105,   106,   107,   108,   109,
-     110,   111,   213,   214,   334,   335,   336,   337,   352,   353,
-     354,   355,   496,   441,   491,     0,     0,     0,   208,     0,
+     200,   201,   202,   203,   204,   205,   206,   207,   208,   209,
+     210,   211,   212,   213,   214,   215,   216,   217,   218,   219,
+     220,   221,   222,   223,   224,   225,   226,   227,   228,   229,
+     230,   231,   232,   233,   234,   235,   236,   237,   238,   239,
+     240,   241,   242,   243,   244,   245,   246,   247,   248,   249,
+     250,   251,   252,   253,   254,   255,   256,   257,   258,   259,
+     260,   261,   262,   263,   264,   265,   266,   267,   268,   269,
+     461,   463,   462,   464,   465,   467,   466,   468,   557,   435,
+     436,   281,   282,   283,   284,   285,   286,   287,   288,   289,
+     290,   291,   292,   293,   294,   295,   296,   297,   298,   299,
+     300,   301,   302,   303,   304,   305,   306,   307,   308,   309,
+     310,   311,   312,   313,   314,   315,   316,   317,   318,   319,
+     320,   321,   322,   323,   324,   325,   326,   327,   328,   329,
+     330,   331,   332,   333,   334,   335,   336,   337,   338,   339,
+     340,   341,   342,   343,   344,   345,   346,   347,   348,   349,
+     350,   351,   352,   353,   354,   355,   356,   357,   358,   359,
+     360,   361,   362,   363,   364,   365,   366,   367,   368,   369,
+     370,   371,   372,   373,   374,   391,   469,   471,   470,   472,
+     473,   475,   474,   476,   477,   479,   478,   480,   481,   486,
+     482,   487,   503,     0,   504,   505,     0,   506,   137,   138,
+     144,   145,     0,   270,   146,   147,   148,   149,     0,   550,
+     150,   151,   152,   153,   154,   155,   156,   157,   158,   159,
+     160,   161,   162,   163,   555,   555,   555,   555,   555,   555,
+     555,   555,   555,   164,   165,   166,   167,   168,   169,   170,
+     171,   275,   276,   398,   399,   400,   401,   402,   403,   418,
+     419,   420,   421,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-     327,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,   558,     0,   556,     0,
+       0,     0,     0,     0,     0,   555,     0,     0,     0,     0,
+     555,     0,     0,   555,     0,     0,   555,     0,     0,   555,
+       0,     0,   555,     0,     0,     0,     0,     0,   561,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,   484,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,   489,   489,   489,
-     489,   489,   489,   489,   489,   489,     0,   497,   498,   499,
-     500,     0,     0,   501,   502,   503,     0,   504,   505,   506,
-     507,   508,   509,   510,   511,   512,   513,   514,   515,   516,
-     517,   518,   519,   490,   520,   521,   522,   523,   492,     0,
-     524,   525,   526,   527,   528,     0,     0,     0,     0,   530,
-     531,   532,     0,     0,     0,     0,     0,     0,   489,     0,
-       0,     0,     0,   489,     0,     0,   489,     0,     0,   489,
-       0,     0,   489,     0,     0,   489,     0,     0,     0,     0,
-       0,   495,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,   555,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,   599,
+     600,     0,     0,   555,   555,   555,   555,   555,   555,   555,
+     555,   555,   555,   555,   555,   555,   555,   555,   555,   555,
+     555,   555,   555,   555,   555,   555,   555,   555,   555,   555,
+     555,   555,   555,   555,   555,   595,   555,   555,   555,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,   489,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,   533,   534,   529,     0,   489,   489,   489,   489,
-     489,   489,   489,   489,   489,   489,   489,   489,   489,   489,
-     489,   489,   489,   489,   489,   489,   489,   489,   489,   489,
-     489,   489,   489,   489,   489,   489,   489,   489,     0,   489,
-     489,   489,   219,   220,   221,   222,   223,   224,   225,   226,
-     227,   228,   229,   230,   231,   232,   233,   234,   235,   236,
-     237,   238,   239,   240,   241,   242,   243,   244,   245,   246,
-     247,   248,   249,   250,   251,   252,   253,   254,   255,   256,
-     257,   258,   259,   260,   261,   262,   263,   264,   265,   266,
-     267,   268,   269,   270,   271,   272,   273,   274,   275,   276,
-     277,   278,   279,   280,   281,   282,   283,   284,   285,   286,
-     287,   288,   289,   290,   291,   292,   293,   294,   295,   296,
-     297,   298,   299,   300,   301,   302,   303,   304,   305,   306,
-     307,   308,   309,   310,   219,   220,   221,   222,   223,   224,
-     225,   226,   227,   228,   229,   230,   231,   232,   233,   234,
-     235,   236,   237,   238,   239,   240,   241,   242,   243,   244,
-     245,   246,   247,   248,   249,   250,   251,   252,   253,   254,
-     255,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,   296,   297,   298,   299,   300,   301,   302,   303,   304,
-     305,   306,   307,   308,   309,   310,   219,   220,   221,   222,
-     223,   224,   225,   226,   227,   228,   229,   230,   231,   232,
-     233,   234,   235,   236,   237,   238,   239,   240,   241,   242,
-     243,   244,   245,   246,   247,   248,   249,   250,   251,   252,
-     253,   254,   255,   256,   257,   258,   259,   260,   261,   262,
-     263,   264,   265,   266,   267,   268,   269,   270,   271,   272,
-     273,   274,   275,   276,   277,   278,   279,   280,   281,   282,
-     283,   284,   285,   286,   287,   288,   289,   290,   291,   292,
-     293,   294,   295,   296,   297,   298,   299,   300,   301,   302,
-     303,   304,   305,   306,   307,   308,   309,   310,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,   422,     0,
+     376,   377,   378,   379,   380,   381,   382,   383,   384,   385,
+     386,   387,   388,     0,   483,     0,   484,   281,   282,   283,
+     284,   285,   286,   287,   288,   289,   290,   291,   292,   293,
+     294,   295,   296,   297,   298,   299,   300,   301,   302,   303,
+     304,   305,   306,   307,   308,   309,   310,   311,   312,   313,
+     314,   315,   316,   317,   318,   319,   320,   321,   322,   323,
+     324,   325,   326,   327,   328,   329,   330,   331,   332,   333,
+     334,   335,   336,   337,   338,   339,   340,   341,   342,   343,
+     344,   345,   346,   347,   348,   349,   350,   351,   352,   353,
+     354,   355,   356,   357,   358,   359,   360,   361,   362,   363,
+     364,   365,   366,   367,   368,   369,   370,   371,   372,   373,
+     374,   281,   282,   283,   284,   285,   286,   287,   288,   289,
+     290,   291,   292,   293,   294,   295,   296,   297,   298,   299,
+     300,   301,   302,   303,   304,   305,   306,   307,   308,   309,
+     310,   311,   312,   313,   314,   315,   316,   317,   318,   319,
+     320,   321,   322,   323,   324,   325,   326,   327,   328,   329,
+     330,   331,   332,   333,   334,   335,   336,   337,   338,   339,
+     340,   341,   342,   343,   344,   345,   346,   347,   348,   349,
+     350,   351,   352,   353,   354,   355,   356,   357,   358,   359,
+     360,   361,   362,   363,   364,   365,   366,   367,   368,   369,
+     370,   371,   372,   373,   374,   281,   282,   283,   284,   285,
+     286,   287,   288,   289,   290,   291,   292,   293,   294,   295,
+     296,   297,   298,   299,   300,   301,   302,   303,   304,   305,
+     306,   307,   308,   309,   310,   311,   312,   313,   314,   315,
+     316,   317,   318,   319,   320,   321,   322,   323,   324,   325,
+     326,   327,   328,   329,   330,   331,   332,   333,   334,   335,
+     336,   337,   338,   339,   340,   341,   342,   343,   344,   345,
+     346,   347,   348,   349,   350,   351,   352,   353,   354,   355,
+     356,   357,   358,   359,   360,   361,   362,   363,   364,   365,
+     366,   367,   368,   369,   370,   371,   372,   373,   374,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,   356,     0,   312,   313,   314,   315,   316,   317,   318,
-     319,   320,   321,   322,   323,   324,     0,   417,     0,   418,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,   422,     0,   376,   377,   378,   379,
+     380,   381,   382,   383,   384,   385,   386,   387,   388,     0,
+     488,     0,   489,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,   356,     0,   312,   313,   314,   315,   316,
-     317,   318,   319,   320,   321,   322,   323,   324,     0,   422,
-       0,   423,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,   422,     0,
+     376,   377,   378,   379,   380,   381,   382,   383,   384,   385,
+     386,   387,   388,     0,   491,     0,   492,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,   356,     0,   312,   313,   314,
-     315,   316,   317,   318,   319,   320,   321,   322,   323,   324,
-       0,   425,     0,   426,   219,   220,   221,   222,   223,   224,
-     225,   226,   227,   228,   229,   230,   231,   232,   233,   234,
-     235,   236,   237,   238,   239,   240,   241,   242,   243,   244,
-     245,   246,   247,   248,   249,   250,   251,   252,   253,   254,
-     255,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,   296,   297,   298,   299,   300,   301,   302,   303,   304,
-     305,   306,   307,   308,   309,   310,   219,   220,   221,   222,
-     223,   224,   225,   226,   227,   228,   229,   230,   231,   232,
-     233,   234,   235,   236,   237,   238,   239,   240,   241,   242,
-     243,   244,   245,   246,   247,   248,   249,   250,   251,   252,
-     253,   254,   255,   256,   257,   258,   259,   260,   261,   262,
-     263,   264,   265,   266,   267,   268,   269,   270,   271,   272,
-     273,   274,   275,   276,   277,   278,   279,   280,   281,   282,
-     283,   284,   285,   286,   287,   288,   289,   290,   291,   292,
-     293,   294,   295,   296,   297,   298,   299,   300,   301,   302,
-     303,   304,   305,   306,   307,   308,   309,   310,   219,   220,
-     221,   222,   223,   224,   225,   226,   227,   228,   229,   230,
-     231,   232,   233,   234,   235,   236,   237,   238,   239,   240,
-     241,   242,   243,   244,   245,   246,   247,   248,   249,   250,
-     251,   252,   253,   254,   255,   256,   257,   258,   259,   260,
-     261,   262,   263,   264,   265,   266,   267,   268,   269,   270,
-     271,   272,   273,   274,   275,   276,   277,   278,   279,   280,
-     281,   282,   283,   284,   285,   286,   287,   288,   289,   290,
-     291,   292,   293,   294,   295,   296,   297,   298,   299,   300,
-     301,   302,   303,   304,   305,   306,   307,   308,   309,   310,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,   356,     0,   312,   313,   314,   315,   316,
-     317,   318,   319,   320,   321,   322,   323,   324,     0,   428,
-       0,   429,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,   422,     0,   376,   377,   378,   379,   380,   381,
+     382,   383,   384,   385,   386,   387,   388,     0,   494,     0,
+     495,   281,   282,   283,   284,   285,   286,   287,   288,   289,
+     290,   291,   292,   293,   294,   295,   296,   297,   298,   299,
+     300,   301,   302,   303,   304,   305,   306,   307,   308,   309,
+     310,   311,   312,   313,   314,   315,   316,   317,   318,   319,
+     320,   321,   322,   323,   324,   325,   326,   327,   328,   329,
+     330,   331,   332,   333,   334,   335,   336,   337,   338,   339,
+     340,   341,   342,   343,   344,   345,   346,   347,   348,   349,
+     350,   351,   352,   353,   354,   355,   356,   357,   358,   359,
+     360,   361,   362,   363,   364,   365,   366,   367,   368,   369,
+     370,   371,   372,   373,   374,   281,   282,   283,   284,   285,
+     286,   287,   288,   289,   290,   291,   292,   293,   294,   295,
+     296,   297,   298,   299,   300,   301,   302,   303,   304,   305,
+     306,   307,   308,   309,   310,   311,   312,   313,   314,   315,
+     316,   317,   318,   319,   320,   321,   322,   323,   324,   325,
+     326,   327,   328,   329,   330,   331,   332,   333,   334,   335,
+     336,   337,   338,   339,   340,   341,   342,   343,   344,   345,
+     346,   347,   348,   349,   350,   351,   352,   353,   354,   355,
+     356,   357,   358,   359,   360,   361,   362,   363,   364,   365,
+     366,   367,   368,   369,   370,   371,   372,   373,   374,   279,
+     280,   281,   282,   283,   284,   285,   286,   287,   288,   289,
+     290,   291,   292,   293,   294,   295,   296,   297,   298,   299,
+     300,   301,   302,   303,   304,   305,   306,   307,   308,   309,
+     310,   311,   312,   313,   314,   315,   316,   317,   318,   319,
+     320,   321,   322,   323,   324,   325,   326,   327,   328,   329,
+     330,   331,   332,   333,   334,   335,   336,   337,   338,   339,
+     340,   341,   342,   343,   344,   345,   346,   347,   348,   349,
+     350,   351,   352,   353,   354,   355,   356,   357,   358,   359,
+     360,   361,   362,   363,   364,   365,   366,   367,   368,   369,
+     370,   371,   372,   373,   374,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,   356,     0,   312,   313,   314,
-     315,   316,   317,   318,   319,   320,   321,   322,   323,   324,
-       0,   431,     0,   432,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,   422,     0,
+     376,   377,   378,   379,   380,   381,   382,   383,   384,   385,
+     386,   387,   388,     0,   497,     0,   498,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,   356,     0,   312,
-     313,   314,   315,   316,   317,   318,   319,   320,   321,   322,
-     323,   324,     0,   434,     0,   435,   217,   218,   219,   220,
-     221,   222,   223,   224,   225,   226,   227,   228,   229,   230,
-     231,   232,   233,   234,   235,   236,   237,   238,   239,   240,
-     241,   242,   243,   244,   245,   246,   247,   248,   249,   250,
-     251,   252,   253,   254,   255,   256,   257,   258,   259,   260,
-     261,   262,   263,   264,   265,   266,   267,   268,   269,   270,
-     271,   272,   273,   274,   275,   276,   277,   278,   279,   280,
-     281,   282,   283,   284,   285,   286,   287,   288,   289,   290,
-     291,   292,   293,   294,   295,   296,   297,   298,   299,   300,
-     301,   302,   303,   304,   305,   306,   307,   308,   309,   310,
-     217,   218,   219,   220,   221,   222,   223,   224,   225,   226,
-     227,   228,   229,   230,   231,   232,   233,   234,   235,   236,
-     237,   238,   239,   240,   241,   242,   243,   244,   245,   246,
-     247,   248,   249,   250,   251,   252,   253,   254,   255,   256,
-     257,   258,   259,   260,   261,   262,   263,   264,   265,   266,
-     267,   268,   269,   270,   271,   272,   273,   274,   275,   276,
-     277,   278,   279,   280,   281,   282,   283,   284,   285,   286,
-     287,   288,   289,   290,   291,   292,   293,   294,   295,   296,
-     297,   298,   299,   300,   301,   302,   303,   304,   305,   306,
-     307,   308,   309,   310,   493,   494,   219,   220,   221,   222,
-     223,   224,   225,   226,   227,   228,   229,   230,   231,   232,
-     233,   234,   235,   236,   237,   238,   239,   240,   241,   242,
-     243,   244,   245,   246,   247,   248,   249,   250,   251,   252,
-     253,   254,   255,   256,   257,   258,   259,   260,   261,   262,
-     263,   264,   265,   266,   267,   268,   269,   270,   271,   272,
-     273,   274,   275,   276,   277,   278,   279,   280,   281,   282,
-     283,   284,   285,   286,   287,   288,   289,   290,   291,   292,
-     293,   294,   295,   296,   297,   298,   299,   300,   301,   302,
-     303,   304,   305,   306,   307,   308,   309,   310,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,   311,   312,
-     313,   314,   315,   316,   317,   318,   319,   320,   321,   322,
-     323,   324,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,   422,     0,   376,   377,   378,   379,   380,   381,
+     382,   383,   384,   385,   386,   387,   388,     0,   500,     0,
+     501,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,   312,   313,   314,   315,   316,   317,   318,
-     319,   320,   321,   322,   323,   324,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,   375,
+     376,   377,   378,   379,   380,   381,   382,   383,   384,   385,
+     386,   387,   388,   279,   280,   281,   282,   283,   284,   285,
+     286,   287,   288,   289,   290,   291,   292,   293,   294,   295,
+     296,   297,   298,   299,   300,   301,   302,   303,   304,   305,
+     306,   307,   308,   309,   310,   311,   312,   313,   314,   315,
+     316,   317,   318,   319,   320,   321,   322,   323,   324,   325,
+     326,   327,   328,   329,   330,   331,   332,   333,   334,   335,
+     336,   337,   338,   339,   340,   341,   342,   343,   344,   345,
+     346,   347,   348,   349,   350,   351,   352,   353,   354,   355,
+     356,   357,   358,   359,   360,   361,   362,   363,   364,   365,
+     366,   367,   368,   369,   370,   371,   372,   373,   374,   559,
+     560,   281,   282,   283,   284,   285,   286,   287,   288,   289,
+     290,   291,   292,   293,   294,   295,   296,   297,   298,   299,
+     300,   301,   302,   303,   304,   305,   306,   307,   308,   309,
+     310,   311,   312,   313,   314,   315,   316,   317,   318,   319,
+     320,   321,   322,   323,   324,   325,   326,   327,   328,   329,
+     330,   331,   332,   333,   334,   335,   336,   337,   338,   339,
+     340,   341,   342,   343,   344,   345,   346,   347,   348,   349,
+     350,   351,   352,   353,   354,   355,   356,   357,   358,   359,
+     360,   361,   362,   363,   364,   365,   366,   367,   368,   369,
+     370,   371,   372,   373,   374,   281,   282,   283,   284,   285,
+     286,   287,   288,   289,   290,   291,   292,   293,   294,   295,
+     296,   297,   298,   299,   300,   301,   302,   303,   304,   305,
+     306,   307,   308,   309,   310,   311,   312,   313,   314,   315,
+     316,   317,   318,   319,   320,   321,   322,   323,   324,   325,
+     326,   327,   328,   329,   330,   331,   332,   333,   334,   335,
+     336,   337,   338,   339,   340,   341,   342,   343,   344,   345,
+     346,   347,   348,   349,   350,   351,   352,   353,   354,   355,
+     356,   357,   358,   359,   360,   361,   362,   363,   364,   365,
+     366,   367,   368,   369,   370,   371,   372,   373,   374,     0,
+       0,     0,     0,   509,   510,   511,   512,   513,   514,   515,
+     516,   517,   518,   519,   520,   521,   522,   523,   524,   525,
+     526,   527,   528,   529,   530,     0,   531,   532,   533,   534,
+     535,   536,   537,   538,   539,   540,   541,   542,   543,   544,
+     545,   546,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,   376,   377,   378,   379,   380,   381,
+     382,   383,   384,   385,   386,   387,   388,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,   312,   313,   314,
-     315,   316,   317,   318,   319,   320,   321,   322,   323,   324,
-     219,   220,   221,   222,   223,   224,   225,   226,   227,   228,
-     229,   230,   231,   232,   233,   234,   235,   236,   237,   238,
-     239,   240,   241,   242,   243,   244,   245,   246,   247,   248,
-     249,   250,   251,   252,   253,   254,   255,   256,   257,   258,
-     259,   260,   261,   262,   263,   264,   265,   266,   267,   268,
-     269,   270,   271,   272,   273,   274,   275,   276,   277,   278,
-     279,   280,   281,   282,   283,   284,   285,   286,   287,   288,
-     289,   290,   291,   292,   293,   294,   295,   296,   297,   298,
-     299,   300,   301,   302,   303,   304,   305,   306,   307,   308,
-     309,   310,     0,     0,     0,     0,   443,   444,   445,   446,
-     447,   448,   449,   450,   451,   452,   453,   454,   455,   456,
-     457,   458,   459,   460,   461,   462,   463,   464,     0,   465,
-     466,   467,   468,   469,   470,   471,   472,   473,   474,   475,
-     476,   477,   478,   479,   480,   219,   220,   221,   222,   223,
-     224,   225,   226,   227,   228,   229,   230,   231,   232,   233,
-     234,   235,   236,   237,   238,   239,   240,   241,   242,   243,
-     244,   245,   246,   247,   248,   249,   250,   251,   252,   253,
-     254,   255,   256,   257,   258,   259,   260,   261,   262,   263,
-     264,   265,   266,   267,   268,   269,   270,   271,   272,   273,
-     274,   275,   276,   277,   278,   279,   280,   281,   282,   283,
-     284,   285,   286,   287,   288,   289,   290,   291,   292,   293,
-     294,   295,   296,   297,   298,   299,   300,   301,   302,   303,
-     304,   305,   306,   307,   308,   309,   310,     0,     0,     0,
-       0,     0,   444,   445,   446,   447,   448,   449,   450,   451,
-     452,   453,   454,   455,   456,   457,   458,   459,   460,   461,
-     462,   463,   464,     0,   465,   466,   467,   468,   469,   470,
-     471,   472,   473,   474,   475,   476,   477,   478,   479,   480,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,   356,
-       0,   312,   313,   314,   315,   316,   317,   318,   319,   320,
-     321,   322,   323,   324,   219,   220,   221,   222,   223,   224,
-     225,   226,   227,   228,   229,   230,   231,   232,   233,   234,
-     235,   236,   237,   238,   239,   240,   241,   242,   243,   244,
-     245,   246,   247,   248,   249,   250,   251,   252,   253,   254,
-     255,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,   296,   297,   298,   299,   300,   301,   302,   303,   304,
-     305,   306,   307,   308,   309,   310,     0,     0,     0,     0,
-     343,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+     376,   377,   378,   379,   380,   381,   382,   383,   384,   385,
+     386,   387,   388,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,   356,     0,   312,   313,   314,   315,
-     316,   317,   318,   319,   320,   321,   322,   323,   324,   219,
-     220,   221,   222,   223,   224,   225,   226,   227,   228,   229,
-     230,   231,   232,   233,   234,   235,   236,   237,   238,   239,
-     240,   241,   242,   243,   244,   245,   246,   247,   248,   249,
-     250,   251,   252,   253,   254,   255,   256,   257,   258,   259,
-     260,   261,   262,   263,   264,   265,   266,   267,   268,   269,
-     270,   271,   272,   273,   274,   275,   276,   277,   278,   279,
-     280,   281,   282,   283,   284,   285,   286,   287,   288,   289,
-     290,   291,   292,   293,   294,   295,   296,   297,   298,   299,
-     300,   301,   302,   303,   304,   305,   306,   307,   308,   309,
-     310,   219,   220,   221,   222,   223,   224,   225,   226,   227,
-     228,   229,   230,   231,   232,   233,   234,   235,   236,   237,
-     238,   239,   240,   241,   242,   243,   244,   245,   246,   247,
-     248,   249,   250,   251,   252,   253,   254,   255,   256,   257,
-     258,   259,   260,   261,   262,   263,   264,   265,   266,   267,
-     268,   269,   270,   271,   272,   273,   274,   275,   276,   277,
-     278,   279,   280,   281,   282,   283,   284,   285,   286,   287,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,   422,     0,   376,   377,   378,   379,   380,   381,
+     382,   383,   384,   385,   386,   387,   388,   281,   282,   283,
+     284,   285,   286,   287,   288,   289,   290,   291,   292,   293,
+     294,   295,   296,   297,   298,   299,   300,   301,   302,   303,
+     304,   305,   306,   307,   308,   309,   310,   311,   312,   313,
+     314,   315,   316,   317,   318,   319,   320,   321,   322,   323,
+     324,   325,   326,   327,   328,   329,   330,   331,   332,   333,
+     334,   335,   336,   337,   338,   339,   340,   341,   342,   343,
+     344,   345,   346,   347,   348,   349,   350,   351,   352,   353,
+     354,   355,   356,   357,   358,   359,   360,   361,   362,   363,
+     364,   365,   366,   367,   368,   369,   370,   371,   372,   373,
+     374,     0,     0,     0,     0,     0,   510,   511,   512,   513,
+     514,   515,   516,   517,   518,   519,   520,   521,   522,   523,
+     524,   525,   526,   527,   528,   529,   530,     0,   531,   532,
+     533,   534,   535,   536,   537,   538,   539,   540,   541,   542,
+     543,   544,   545,   546,   281,   282,   283,   284,   285,   286,
+     287,   288,   289,   290,   291,   292,   293,   294,   295,   296,
+     297,   298,   299,   300,   301,   302,   303,   304,   305,   306,
+     307,   308,   309,   310,   311,   312,   313,   314,   315,   316,
+     317,   318,   319,   320,   321,   322,   323,   324,   325,   326,
+     327,   328,   329,   330,   331,   332,   333,   334,   335,   336,
+     337,   338,   339,   340,   341,   342,   343,   344,   345,   346,
+     347,   348,   349,   350,   351,   352,   353,   354,   355,   356,
+     357,   358,   359,   360,   361,   362,   363,   364,   365,   366,
+     367,   368,   369,   370,   371,   372,   373,   374,     0,     0,
+       0,     0,   409,   281,   282,   283,   284,   285,   286,   287,
      288,   289,   290,   291,   292,   293,   294,   295,   296,   297,
      298,   299,   300,   301,   302,   303,   304,   305,   306,   307,
-     308,   309,   310,     0,     0,   312,   313,   314,   315,   316,
-     317,   318,   319,   320,   321,   322,   323,   324,   219,   220,
-     221,   222,   223,   224,   225,   226,   227,   228,   229,   230,
-     231,   232,   233,   234,   235,   236,   237,   238,   239,   240,
-     241,   242,   243,   244,   245,   246,   247,   248,   249,   250,
-     251,   252,   253,   254,   255,   256,   257,   258,   259,   260,
-     261,   262,   263,   264,   265,   266,   267,   268,   269,   270,
-     271,   272,   273,   274,   275,   276,   277,   278,   279,   280,
-     281,   282,   283,   284,   285,   286,   287,   288,   289,   290,
-     291,   292,   293,   294,   295,   296,   297,   298,   299,   300,
-     301,   302,   303,   304,   305,   306,   307,   308,   309,   310,
-       0,     0,     1,     0,     0,     0,     2,     3,     0,     0,
+     308,   309,   310,   311,   312,   313,   314,   315,   316,   317,
+     318,   319,   320,   321,   322,   323,   324,   325,   326,   327,
+     328,   329,   330,   331,   332,   333,   334,   335,   336,   337,
+     338,   339,   340,   341,   342,   343,   344,   345,   346,   347,
+     348,   349,   350,   351,   352,   353,   354,   355,   356,   357,
+     358,   359,   360,   361,   362,   363,   364,   365,   366,   367,
+     368,   369,   370,   371,   372,   373,   374,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,   356,     0,
+       0,     0,     0,     0,   422,     0,   376,   377,   378,   379,
+     380,   381,   382,   383,   384,   385,   386,   387,   388,   281,
+     282,   283,   284,   285,   286,   287,   288,   289,   290,   291,
+     292,   293,   294,   295,   296,   297,   298,   299,   300,   301,
+     302,   303,   304,   305,   306,   307,   308,   309,   310,   311,
      312,   313,   314,   315,   316,   317,   318,   319,   320,   321,
-     322,   323,   324,     0,     0,     0,     0,     0,     0,     0,
+     322,   323,   324,   325,   326,   327,   328,   329,   330,   331,
+     332,   333,   334,   335,   336,   337,   338,   339,   340,   341,
+     342,   343,   344,   345,   346,   347,   348,   349,   350,   351,
+     352,   353,   354,   355,   356,   357,   358,   359,   360,   361,
+     362,   363,   364,   365,   366,   367,   368,   369,   370,   371,
+     372,   373,   374,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,   376,   377,   378,   379,   380,   381,   382,
+     383,   384,   385,   386,   387,   388,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     1,     0,     0,     0,     2,     3,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-     488,     0,   312,   313,   314,   315,   316,   317,   318,   319,
-     320,   321,   322,   323,   324,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,   341,     4,     0,     0,
-       2,     3,     0,     0,     0,     0,     0,     0,     0,     0,
+     422,     0,   376,   377,   378,   379,   380,   381,   382,   383,
+     384,   385,   386,   387,   388,   281,   282,   283,   284,   285,
+     286,   287,   288,   289,   290,   291,   292,   293,   294,   295,
+     296,   297,   298,   299,   300,   301,   302,   303,   304,   305,
+     306,   307,   308,   309,   310,   311,   312,   313,   314,   315,
+     316,   317,   318,   319,   320,   321,   322,   323,   324,   325,
+     326,   327,   328,   329,   330,   331,   332,   333,   334,   335,
+     336,   337,   338,   339,   340,   341,   342,   343,   344,   345,
+     346,   347,   348,   349,   350,   351,   352,   353,   354,   355,
+     356,   357,   358,   359,   360,   361,   362,   363,   364,   365,
+     366,   367,   368,   369,   370,   371,   372,   373,   374,     4,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,   554,     0,   376,   377,
+     378,   379,   380,   381,   382,   383,   384,   385,   386,   387,
+     388,     0,     0,     0,     0,     0,     0,   407,     0,     0,
+       0,     2,     3,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     5,     6,     7,
+       8,     9,    10,    11,    12,    13,    14,    15,    16,    17,
+      18,    19,    20,    21,    22,    23,    24,    25,    26,    27,
+      28,    29,    30,    31,    32,    33,    34,    35,    36,    37,
+      38,    39,    40,    41,    42,    43,    44,    45,    46,    47,
+      48,    49,    50,    51,    52,    53,    54,    55,    56,    57,
+      58,    59,    60,    61,    62,    63,    64,    65,    66,    67,
+      68,    69,    70,    71,    72,    73,    74,    75,    76,    77,
+      78,    79,    80,     0,    81,    82,    83,    84,    85,    86,
+      87,    88,    89,    90,    91,    92,    93,    94,    95,    96,
+      97,    98,    99,   100,   101,   102,   103,   104,   105,   106,
+     107,   108,   109,   110,     4,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,   111,   112,   113,
+     114,   115,   116,   117,   118,   119,   120,   121,   122,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,   312,
-     313,   314,   315,   316,   317,   318,   319,   320,   321,   322,
-     323,   324,     5,     6,     7,     8,     9,    10,    11,    12,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,   376,   377,   378,   379,   380,   381,
+     382,   383,   384,   385,   386,   387,   388,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     5,     6,     7,     8,     9,    10,    11,    12,
       13,    14,    15,    16,    17,    18,    19,    20,    21,    22,
       23,    24,    25,    26,    27,    28,    29,    30,    31,    32,
       33,    34,    35,    36,    37,    38,    39,    40,    41,    42,
       43,    44,    45,    46,    47,    48,    49,    50,    51,    52,
-      53,     4,    54,    55,    56,    57,    58,    59,    60,    61,
-      62,    63,    64,    65,    66,    67,    68,    69,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,    70,
-      71,    72,    73,    74,    75,    76,    77,    78,    79,    80,
-      81,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+      53,    54,    55,    56,    57,    58,    59,    60,    61,    62,
+      63,    64,    65,    66,    67,    68,    69,    70,    71,    72,
+      73,    74,    75,    76,    77,    78,    79,    80,     0,    81,
+      82,    83,    84,    85,    86,    87,    88,    89,    90,    91,
+      92,    93,    94,    95,    96,    97,    98,    99,   100,   101,
+     102,   103,   104,   105,   106,   107,   108,   109,   110,     0,
+       0,     0,     0,     0,     0,   175,     0,     0,     0,     0,
+       0,     0,   111,   112,   113,   114,   115,   116,   117,   118,
+     119,   120,   121,   122,   425,     0,   426,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,   427,     0,     0,     0,
+       0,     0,     0,   428,   429,   430,   431,     0,     0,     0,
+       0,   432,   176,   177,   178,   179,   180,   181,   182,   183,
+     184,   185,   186,   187,   188,   189,   190,   191,   192,   193,
+     194,   195,   196,   197,   198,   199,   200,   201,   202,   203,
+     204,   205,   206,   207,   208,   209,   210,   211,   212,   213,
+     214,   215,   216,   217,   218,   219,   220,   221,   222,   223,
+     224,   225,   226,   227,   228,   229,   230,   231,   232,   233,
+     234,   235,   236,   237,   238,   239,   240,   241,   242,   243,
+     244,   245,   246,   247,   248,   249,   250,   251,   252,   253,
+     254,   255,   256,   257,   258,   259,   260,   261,   262,   263,
+     264,   265,   266,   267,   268,   269,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,   485,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,   490,   493,
+     496,   499,   502,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     5,     6,     7,     8,
-       9,    10,    11,    12,    13,    14,    15,    16,    17,    18,
-      19,    20,    21,    22,    23,    24,    25,    26,    27,    28,
-      29,    30,    31,    32,    33,    34,    35,    36,    37,    38,
-      39,    40,    41,    42,    43,    44,    45,    46,    47,    48,
-      49,    50,    51,    52,    53,   115,    54,    55,    56,    57,
-      58,    59,    60,    61,    62,    63,    64,    65,    66,    67,
-      68,    69,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,    70,    71,    72,    73,    74,    75,    76,
-      77,    78,    79,    80,    81,     0,     0,     0,     0,     0,
-       0,   116,   117,   118,   119,   120,   121,   122,   123,   124,
-     125,   126,   127,   128,   129,   130,   131,   132,   133,   134,
-     135,   136,   137,   138,   139,   140,   141,   142,   143,   144,
-     145,   146,   147,   148,   149,   150,   151,   152,   153,   154,
-     155,   156,   157,   158,   159,   160,   161,   162,   163,   164,
-     165,   166,   167,   168,   169,   170,   171,   172,   173,   174,
-     175,   176,   177,   178,   179,   180,   181,   182,   183,   184,
-     185,   186,   187,   188,   189,   190,   191,   192,   193,   194,
-     195,   196,   197,   198,   199,   200,   201,   202,   203,   204,
-     205,   206,   207
+       0,     0,     0,     0,   549,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,   563,
+     564,   565,   566,     0,     0,   567,   568,   569,     0,   570,
+     571,   572,   573,   574,   575,   576,   577,   578,   579,   580,
+     581,   582,   583,   584,   585,     0,   586,   587,   588,   589,
+       0,     0,   590,   591,   592,   593,   594,     0,     0,     0,
+       0,   596,   597,   598
   };
 
   const short
   seclang_parser::yycheck_[] =
   {
-      61,    62,    63,   306,    51,     3,     3,   143,    82,   145,
-     102,    62,    63,   316,     6,   309,   310,    64,   154,    80,
-     314,   307,     6,   309,   310,   161,   162,   163,   164,    80,
-     309,   310,   308,   169,    81,   311,   309,   310,   345,   315,
-     347,   314,   309,   310,   146,   147,   307,   314,   309,   310,
-     103,   104,   105,   345,   115,   347,   148,   149,   150,   151,
-     152,   153,   154,   155,   156,   157,   158,   159,   160,   161,
-     162,   163,   164,   165,   166,   167,   168,   169,   170,   171,
-     172,   173,   174,   175,   176,   177,   178,   179,   180,   181,
-     182,   183,   184,   185,   186,   187,   188,   189,   190,   191,
-     192,   193,   194,   195,   196,   197,   198,   199,   200,   201,
-     202,   203,   204,   205,   206,   207,   208,   209,   210,   211,
-     212,   213,   214,   215,   216,   217,   218,   219,   220,   221,
-     222,   223,   224,   225,   226,   227,   228,   229,   230,   231,
-     232,   233,   234,   235,   236,   237,   238,   239,   345,   208,
-     347,   287,   345,   345,   347,   347,   217,   218,   345,   345,
-     347,   347,   345,   345,   347,   347,   309,   310,   304,   305,
-     306,   307,   308,   345,   345,   347,   347,   345,   345,   347,
-     347,   345,   345,   347,   347,   345,   345,   347,   347,   345,
-     345,   347,   347,   345,   345,   347,   347,   345,   345,   347,
-     347,   345,   338,   347,   345,   345,   347,   347,   309,   310,
-     309,   310,   309,   310,   312,   313,   309,   310,   312,   313,
-     309,   310,   309,   310,   309,   310,   309,   310,   309,   310,
-     309,   310,   443,   311,   368,    -1,    -1,    -1,   330,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-     311,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,   343,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,   358,   359,   360,
-     361,   362,   363,   364,   365,   366,    -1,   443,   444,   445,
-     446,    -1,    -1,   449,   450,   451,    -1,   453,   454,   455,
-     456,   457,   458,   459,   460,   461,   462,   463,   464,   465,
-     466,   467,   468,   330,   470,   471,   472,   473,   330,    -1,
-     476,   477,   478,   479,   480,    -1,    -1,    -1,    -1,   485,
-     486,   487,    -1,    -1,    -1,    -1,    -1,    -1,   419,    -1,
-      -1,    -1,    -1,   424,    -1,    -1,   427,    -1,    -1,   430,
-      -1,    -1,   433,    -1,    -1,   436,    -1,    -1,    -1,    -1,
-      -1,   442,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,   483,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,   493,   494,   481,    -1,   497,   498,   499,   500,
-     501,   502,   503,   504,   505,   506,   507,   508,   509,   510,
-     511,   512,   513,   514,   515,   516,   517,   518,   519,   520,
-     521,   522,   523,   524,   525,   526,   527,   528,    -1,   530,
-     531,   532,    10,    11,    12,    13,    14,    15,    16,    17,
-      18,    19,    20,    21,    22,    23,    24,    25,    26,    27,
-      28,    29,    30,    31,    32,    33,    34,    35,    36,    37,
-      38,    39,    40,    41,    42,    43,    44,    45,    46,    47,
-      48,    49,    50,    51,    52,    53,    54,    55,    56,    57,
-      58,    59,    60,    61,    62,    63,    64,    65,    66,    67,
-      68,    69,    70,    71,    72,    73,    74,    75,    76,    77,
-      78,    79,    80,    81,    82,    83,    84,    85,    86,    87,
-      88,    89,    90,    91,    92,    93,    94,    95,    96,    97,
-      98,    99,   100,   101,    10,    11,    12,    13,    14,    15,
-      16,    17,    18,    19,    20,    21,    22,    23,    24,    25,
-      26,    27,    28,    29,    30,    31,    32,    33,    34,    35,
-      36,    37,    38,    39,    40,    41,    42,    43,    44,    45,
-      46,    47,    48,    49,    50,    51,    52,    53,    54,    55,
-      56,    57,    58,    59,    60,    61,    62,    63,    64,    65,
-      66,    67,    68,    69,    70,    71,    72,    73,    74,    75,
-      76,    77,    78,    79,    80,    81,    82,    83,    84,    85,
-      86,    87,    88,    89,    90,    91,    92,    93,    94,    95,
-      96,    97,    98,    99,   100,   101,    10,    11,    12,    13,
-      14,    15,    16,    17,    18,    19,    20,    21,    22,    23,
-      24,    25,    26,    27,    28,    29,    30,    31,    32,    33,
-      34,    35,    36,    37,    38,    39,    40,    41,    42,    43,
-      44,    45,    46,    47,    48,    49,    50,    51,    52,    53,
-      54,    55,    56,    57,    58,    59,    60,    61,    62,    63,
-      64,    65,    66,    67,    68,    69,    70,    71,    72,    73,
-      74,    75,    76,    77,    78,    79,    80,    81,    82,    83,
-      84,    85,    86,    87,    88,    89,    90,    91,    92,    93,
-      94,    95,    96,    97,    98,    99,   100,   101,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+     100,   101,   102,     3,     6,   101,   102,   352,   354,     3,
+     393,   357,   395,   355,   356,   361,   362,   363,   360,   364,
+       6,   121,   355,   356,   123,   121,    78,   360,   270,   104,
+     355,   356,   355,   356,   353,   360,   355,   356,   353,   509,
+     355,   356,   148,   149,   150,   105,   106,   107,   355,   356,
+     393,   103,   395,   393,   393,   395,   395,   393,   393,   395,
+     395,   393,   393,   395,   395,   393,   393,   395,   395,   393,
+     122,   395,   393,   375,   395,   175,   151,   152,   153,   154,
+     155,   156,   157,   158,   159,   160,   161,   162,   163,   164,
+     165,   166,   167,   168,   169,   170,   171,   172,   173,   174,
+     175,   176,   177,   178,   179,   180,   181,   182,   183,   184,
+     185,   186,   187,   188,   189,   190,   191,   192,   193,   194,
+     195,   196,   197,   198,   199,   200,   201,   202,   203,   204,
+     205,   206,   207,   208,   209,   210,   211,   212,   213,   214,
+     215,   216,   217,   218,   219,   220,   221,   222,   223,   224,
+     225,   226,   227,   228,   229,   230,   231,   232,   233,   234,
+     235,   236,   237,   238,   239,   240,   241,   242,   243,   244,
+     393,   393,   395,   395,   393,   393,   395,   395,   434,   279,
+     280,    10,    11,    12,    13,    14,    15,    16,    17,    18,
+      19,    20,    21,    22,    23,    24,    25,    26,    27,    28,
+      29,    30,    31,    32,    33,    34,    35,    36,    37,    38,
+      39,    40,    41,    42,    43,    44,    45,    46,    47,    48,
+      49,    50,    51,    52,    53,    54,    55,    56,    57,    58,
+      59,    60,    61,    62,    63,    64,    65,    66,    67,    68,
+      69,    70,    71,    72,    73,    74,    75,    76,    77,    78,
+      79,    80,    81,    82,    83,    84,    85,    86,    87,    88,
+      89,    90,    91,    92,    93,    94,    95,    96,    97,    98,
+      99,   100,   101,   102,   103,   375,   393,   393,   395,   395,
+     393,   393,   395,   395,   393,   393,   395,   395,   393,   393,
+     395,   395,   393,    -1,   395,   393,    -1,   395,   355,   356,
+     355,   356,    -1,   378,   355,   356,   355,   356,    -1,   409,
+     355,   356,   355,   356,   355,   356,   358,   359,   355,   356,
+     358,   359,   355,   356,   424,   425,   426,   427,   428,   429,
+     430,   431,   432,   355,   356,   355,   356,   355,   356,   355,
+     356,   355,   356,   355,   356,   355,   356,   355,   356,   355,
+     356,   355,   356,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,   378,    -1,   378,    -1,
+      -1,    -1,    -1,    -1,    -1,   485,    -1,    -1,    -1,    -1,
+     490,    -1,    -1,   493,    -1,    -1,   496,    -1,    -1,   499,
+      -1,    -1,   502,    -1,    -1,    -1,    -1,    -1,   508,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,   329,    -1,   331,   332,   333,   334,   335,   336,   337,
-     338,   339,   340,   341,   342,   343,    -1,   345,    -1,   347,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,   549,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,   559,
+     560,    -1,    -1,   563,   564,   565,   566,   567,   568,   569,
+     570,   571,   572,   573,   574,   575,   576,   577,   578,   579,
+     580,   581,   582,   583,   584,   585,   586,   587,   588,   589,
+     590,   591,   592,   593,   594,   547,   596,   597,   598,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,   377,    -1,
+     379,   380,   381,   382,   383,   384,   385,   386,   387,   388,
+     389,   390,   391,    -1,   393,    -1,   395,    10,    11,    12,
+      13,    14,    15,    16,    17,    18,    19,    20,    21,    22,
+      23,    24,    25,    26,    27,    28,    29,    30,    31,    32,
+      33,    34,    35,    36,    37,    38,    39,    40,    41,    42,
+      43,    44,    45,    46,    47,    48,    49,    50,    51,    52,
+      53,    54,    55,    56,    57,    58,    59,    60,    61,    62,
+      63,    64,    65,    66,    67,    68,    69,    70,    71,    72,
+      73,    74,    75,    76,    77,    78,    79,    80,    81,    82,
+      83,    84,    85,    86,    87,    88,    89,    90,    91,    92,
+      93,    94,    95,    96,    97,    98,    99,   100,   101,   102,
+     103,    10,    11,    12,    13,    14,    15,    16,    17,    18,
+      19,    20,    21,    22,    23,    24,    25,    26,    27,    28,
+      29,    30,    31,    32,    33,    34,    35,    36,    37,    38,
+      39,    40,    41,    42,    43,    44,    45,    46,    47,    48,
+      49,    50,    51,    52,    53,    54,    55,    56,    57,    58,
+      59,    60,    61,    62,    63,    64,    65,    66,    67,    68,
+      69,    70,    71,    72,    73,    74,    75,    76,    77,    78,
+      79,    80,    81,    82,    83,    84,    85,    86,    87,    88,
+      89,    90,    91,    92,    93,    94,    95,    96,    97,    98,
+      99,   100,   101,   102,   103,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
+      45,    46,    47,    48,    49,    50,    51,    52,    53,    54,
+      55,    56,    57,    58,    59,    60,    61,    62,    63,    64,
+      65,    66,    67,    68,    69,    70,    71,    72,    73,    74,
+      75,    76,    77,    78,    79,    80,    81,    82,    83,    84,
+      85,    86,    87,    88,    89,    90,    91,    92,    93,    94,
+      95,    96,    97,    98,    99,   100,   101,   102,   103,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,   329,    -1,   331,   332,   333,   334,   335,
-     336,   337,   338,   339,   340,   341,   342,   343,    -1,   345,
-      -1,   347,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,   329,    -1,   331,   332,   333,
-     334,   335,   336,   337,   338,   339,   340,   341,   342,   343,
-      -1,   345,    -1,   347,    10,    11,    12,    13,    14,    15,
-      16,    17,    18,    19,    20,    21,    22,    23,    24,    25,
-      26,    27,    28,    29,    30,    31,    32,    33,    34,    35,
-      36,    37,    38,    39,    40,    41,    42,    43,    44,    45,
-      46,    47,    48,    49,    50,    51,    52,    53,    54,    55,
-      56,    57,    58,    59,    60,    61,    62,    63,    64,    65,
-      66,    67,    68,    69,    70,    71,    72,    73,    74,    75,
-      76,    77,    78,    79,    80,    81,    82,    83,    84,    85,
-      86,    87,    88,    89,    90,    91,    92,    93,    94,    95,
-      96,    97,    98,    99,   100,   101,    10,    11,    12,    13,
-      14,    15,    16,    17,    18,    19,    20,    21,    22,    23,
-      24,    25,    26,    27,    28,    29,    30,    31,    32,    33,
-      34,    35,    36,    37,    38,    39,    40,    41,    42,    43,
-      44,    45,    46,    47,    48,    49,    50,    51,    52,    53,
-      54,    55,    56,    57,    58,    59,    60,    61,    62,    63,
-      64,    65,    66,    67,    68,    69,    70,    71,    72,    73,
-      74,    75,    76,    77,    78,    79,    80,    81,    82,    83,
-      84,    85,    86,    87,    88,    89,    90,    91,    92,    93,
-      94,    95,    96,    97,    98,    99,   100,   101,    10,    11,
-      12,    13,    14,    15,    16,    17,    18,    19,    20,    21,
-      22,    23,    24,    25,    26,    27,    28,    29,    30,    31,
-      32,    33,    34,    35,    36,    37,    38,    39,    40,    41,
-      42,    43,    44,    45,    46,    47,    48,    49,    50,    51,
-      52,    53,    54,    55,    56,    57,    58,    59,    60,    61,
-      62,    63,    64,    65,    66,    67,    68,    69,    70,    71,
-      72,    73,    74,    75,    76,    77,    78,    79,    80,    81,
-      82,    83,    84,    85,    86,    87,    88,    89,    90,    91,
-      92,    93,    94,    95,    96,    97,    98,    99,   100,   101,
+      -1,    -1,    -1,    -1,   377,    -1,   379,   380,   381,   382,
+     383,   384,   385,   386,   387,   388,   389,   390,   391,    -1,
+     393,    -1,   395,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,   329,    -1,   331,   332,   333,   334,   335,
-     336,   337,   338,   339,   340,   341,   342,   343,    -1,   345,
-      -1,   347,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,   377,    -1,
+     379,   380,   381,   382,   383,   384,   385,   386,   387,   388,
+     389,   390,   391,    -1,   393,    -1,   395,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,   329,    -1,   331,   332,   333,
-     334,   335,   336,   337,   338,   339,   340,   341,   342,   343,
-      -1,   345,    -1,   347,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,   377,    -1,   379,   380,   381,   382,   383,   384,
+     385,   386,   387,   388,   389,   390,   391,    -1,   393,    -1,
+     395,    10,    11,    12,    13,    14,    15,    16,    17,    18,
+      19,    20,    21,    22,    23,    24,    25,    26,    27,    28,
+      29,    30,    31,    32,    33,    34,    35,    36,    37,    38,
+      39,    40,    41,    42,    43,    44,    45,    46,    47,    48,
+      49,    50,    51,    52,    53,    54,    55,    56,    57,    58,
+      59,    60,    61,    62,    63,    64,    65,    66,    67,    68,
+      69,    70,    71,    72,    73,    74,    75,    76,    77,    78,
+      79,    80,    81,    82,    83,    84,    85,    86,    87,    88,
+      89,    90,    91,    92,    93,    94,    95,    96,    97,    98,
+      99,   100,   101,   102,   103,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
+      45,    46,    47,    48,    49,    50,    51,    52,    53,    54,
+      55,    56,    57,    58,    59,    60,    61,    62,    63,    64,
+      65,    66,    67,    68,    69,    70,    71,    72,    73,    74,
+      75,    76,    77,    78,    79,    80,    81,    82,    83,    84,
+      85,    86,    87,    88,    89,    90,    91,    92,    93,    94,
+      95,    96,    97,    98,    99,   100,   101,   102,   103,     8,
+       9,    10,    11,    12,    13,    14,    15,    16,    17,    18,
+      19,    20,    21,    22,    23,    24,    25,    26,    27,    28,
+      29,    30,    31,    32,    33,    34,    35,    36,    37,    38,
+      39,    40,    41,    42,    43,    44,    45,    46,    47,    48,
+      49,    50,    51,    52,    53,    54,    55,    56,    57,    58,
+      59,    60,    61,    62,    63,    64,    65,    66,    67,    68,
+      69,    70,    71,    72,    73,    74,    75,    76,    77,    78,
+      79,    80,    81,    82,    83,    84,    85,    86,    87,    88,
+      89,    90,    91,    92,    93,    94,    95,    96,    97,    98,
+      99,   100,   101,   102,   103,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,   329,    -1,   331,
-     332,   333,   334,   335,   336,   337,   338,   339,   340,   341,
-     342,   343,    -1,   345,    -1,   347,     8,     9,    10,    11,
-      12,    13,    14,    15,    16,    17,    18,    19,    20,    21,
-      22,    23,    24,    25,    26,    27,    28,    29,    30,    31,
-      32,    33,    34,    35,    36,    37,    38,    39,    40,    41,
-      42,    43,    44,    45,    46,    47,    48,    49,    50,    51,
-      52,    53,    54,    55,    56,    57,    58,    59,    60,    61,
-      62,    63,    64,    65,    66,    67,    68,    69,    70,    71,
-      72,    73,    74,    75,    76,    77,    78,    79,    80,    81,
-      82,    83,    84,    85,    86,    87,    88,    89,    90,    91,
-      92,    93,    94,    95,    96,    97,    98,    99,   100,   101,
-       8,     9,    10,    11,    12,    13,    14,    15,    16,    17,
-      18,    19,    20,    21,    22,    23,    24,    25,    26,    27,
-      28,    29,    30,    31,    32,    33,    34,    35,    36,    37,
-      38,    39,    40,    41,    42,    43,    44,    45,    46,    47,
-      48,    49,    50,    51,    52,    53,    54,    55,    56,    57,
-      58,    59,    60,    61,    62,    63,    64,    65,    66,    67,
-      68,    69,    70,    71,    72,    73,    74,    75,    76,    77,
-      78,    79,    80,    81,    82,    83,    84,    85,    86,    87,
-      88,    89,    90,    91,    92,    93,    94,    95,    96,    97,
-      98,    99,   100,   101,     8,     9,    10,    11,    12,    13,
-      14,    15,    16,    17,    18,    19,    20,    21,    22,    23,
-      24,    25,    26,    27,    28,    29,    30,    31,    32,    33,
-      34,    35,    36,    37,    38,    39,    40,    41,    42,    43,
-      44,    45,    46,    47,    48,    49,    50,    51,    52,    53,
-      54,    55,    56,    57,    58,    59,    60,    61,    62,    63,
-      64,    65,    66,    67,    68,    69,    70,    71,    72,    73,
-      74,    75,    76,    77,    78,    79,    80,    81,    82,    83,
-      84,    85,    86,    87,    88,    89,    90,    91,    92,    93,
-      94,    95,    96,    97,    98,    99,   100,   101,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,   330,   331,
-     332,   333,   334,   335,   336,   337,   338,   339,   340,   341,
-     342,   343,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,   377,    -1,
+     379,   380,   381,   382,   383,   384,   385,   386,   387,   388,
+     389,   390,   391,    -1,   393,    -1,   395,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,   331,   332,   333,   334,   335,   336,   337,
-     338,   339,   340,   341,   342,   343,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,   377,    -1,   379,   380,   381,   382,   383,   384,
+     385,   386,   387,   388,   389,   390,   391,    -1,   393,    -1,
+     395,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,   331,   332,   333,
-     334,   335,   336,   337,   338,   339,   340,   341,   342,   343,
-      10,    11,    12,    13,    14,    15,    16,    17,    18,    19,
-      20,    21,    22,    23,    24,    25,    26,    27,    28,    29,
-      30,    31,    32,    33,    34,    35,    36,    37,    38,    39,
-      40,    41,    42,    43,    44,    45,    46,    47,    48,    49,
-      50,    51,    52,    53,    54,    55,    56,    57,    58,    59,
-      60,    61,    62,    63,    64,    65,    66,    67,    68,    69,
-      70,    71,    72,    73,    74,    75,    76,    77,    78,    79,
-      80,    81,    82,    83,    84,    85,    86,    87,    88,    89,
-      90,    91,    92,    93,    94,    95,    96,    97,    98,    99,
-     100,   101,    -1,    -1,    -1,    -1,   106,   107,   108,   109,
-     110,   111,   112,   113,   114,   115,   116,   117,   118,   119,
-     120,   121,   122,   123,   124,   125,   126,   127,    -1,   129,
-     130,   131,   132,   133,   134,   135,   136,   137,   138,   139,
-     140,   141,   142,   143,   144,    10,    11,    12,    13,    14,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,   378,
+     379,   380,   381,   382,   383,   384,   385,   386,   387,   388,
+     389,   390,   391,     8,     9,    10,    11,    12,    13,    14,
       15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
       25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
       35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
@@ -6766,18 +7757,69 @@ namespace yy {
       65,    66,    67,    68,    69,    70,    71,    72,    73,    74,
       75,    76,    77,    78,    79,    80,    81,    82,    83,    84,
       85,    86,    87,    88,    89,    90,    91,    92,    93,    94,
-      95,    96,    97,    98,    99,   100,   101,    -1,    -1,    -1,
-      -1,    -1,   107,   108,   109,   110,   111,   112,   113,   114,
+      95,    96,    97,    98,    99,   100,   101,   102,   103,     8,
+       9,    10,    11,    12,    13,    14,    15,    16,    17,    18,
+      19,    20,    21,    22,    23,    24,    25,    26,    27,    28,
+      29,    30,    31,    32,    33,    34,    35,    36,    37,    38,
+      39,    40,    41,    42,    43,    44,    45,    46,    47,    48,
+      49,    50,    51,    52,    53,    54,    55,    56,    57,    58,
+      59,    60,    61,    62,    63,    64,    65,    66,    67,    68,
+      69,    70,    71,    72,    73,    74,    75,    76,    77,    78,
+      79,    80,    81,    82,    83,    84,    85,    86,    87,    88,
+      89,    90,    91,    92,    93,    94,    95,    96,    97,    98,
+      99,   100,   101,   102,   103,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
+      45,    46,    47,    48,    49,    50,    51,    52,    53,    54,
+      55,    56,    57,    58,    59,    60,    61,    62,    63,    64,
+      65,    66,    67,    68,    69,    70,    71,    72,    73,    74,
+      75,    76,    77,    78,    79,    80,    81,    82,    83,    84,
+      85,    86,    87,    88,    89,    90,    91,    92,    93,    94,
+      95,    96,    97,    98,    99,   100,   101,   102,   103,    -1,
+      -1,    -1,    -1,   108,   109,   110,   111,   112,   113,   114,
      115,   116,   117,   118,   119,   120,   121,   122,   123,   124,
-     125,   126,   127,    -1,   129,   130,   131,   132,   133,   134,
+     125,   126,   127,   128,   129,    -1,   131,   132,   133,   134,
      135,   136,   137,   138,   139,   140,   141,   142,   143,   144,
+     145,   146,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,   379,   380,   381,   382,   383,   384,
+     385,   386,   387,   388,   389,   390,   391,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,   329,
-      -1,   331,   332,   333,   334,   335,   336,   337,   338,   339,
-     340,   341,   342,   343,    10,    11,    12,    13,    14,    15,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+     379,   380,   381,   382,   383,   384,   385,   386,   387,   388,
+     389,   390,   391,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,   377,    -1,   379,   380,   381,   382,   383,   384,
+     385,   386,   387,   388,   389,   390,   391,    10,    11,    12,
+      13,    14,    15,    16,    17,    18,    19,    20,    21,    22,
+      23,    24,    25,    26,    27,    28,    29,    30,    31,    32,
+      33,    34,    35,    36,    37,    38,    39,    40,    41,    42,
+      43,    44,    45,    46,    47,    48,    49,    50,    51,    52,
+      53,    54,    55,    56,    57,    58,    59,    60,    61,    62,
+      63,    64,    65,    66,    67,    68,    69,    70,    71,    72,
+      73,    74,    75,    76,    77,    78,    79,    80,    81,    82,
+      83,    84,    85,    86,    87,    88,    89,    90,    91,    92,
+      93,    94,    95,    96,    97,    98,    99,   100,   101,   102,
+     103,    -1,    -1,    -1,    -1,    -1,   109,   110,   111,   112,
+     113,   114,   115,   116,   117,   118,   119,   120,   121,   122,
+     123,   124,   125,   126,   127,   128,   129,    -1,   131,   132,
+     133,   134,   135,   136,   137,   138,   139,   140,   141,   142,
+     143,   144,   145,   146,    10,    11,    12,    13,    14,    15,
       16,    17,    18,    19,    20,    21,    22,    23,    24,    25,
       26,    27,    28,    29,    30,    31,    32,    33,    34,    35,
       36,    37,    38,    39,    40,    41,    42,    43,    44,    45,
@@ -6786,11 +7828,22 @@ namespace yy {
       66,    67,    68,    69,    70,    71,    72,    73,    74,    75,
       76,    77,    78,    79,    80,    81,    82,    83,    84,    85,
       86,    87,    88,    89,    90,    91,    92,    93,    94,    95,
-      96,    97,    98,    99,   100,   101,    -1,    -1,    -1,    -1,
-     106,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      96,    97,    98,    99,   100,   101,   102,   103,    -1,    -1,
+      -1,    -1,   108,    10,    11,    12,    13,    14,    15,    16,
+      17,    18,    19,    20,    21,    22,    23,    24,    25,    26,
+      27,    28,    29,    30,    31,    32,    33,    34,    35,    36,
+      37,    38,    39,    40,    41,    42,    43,    44,    45,    46,
+      47,    48,    49,    50,    51,    52,    53,    54,    55,    56,
+      57,    58,    59,    60,    61,    62,    63,    64,    65,    66,
+      67,    68,    69,    70,    71,    72,    73,    74,    75,    76,
+      77,    78,    79,    80,    81,    82,    83,    84,    85,    86,
+      87,    88,    89,    90,    91,    92,    93,    94,    95,    96,
+      97,    98,    99,   100,   101,   102,   103,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,   329,    -1,   331,   332,   333,   334,
-     335,   336,   337,   338,   339,   340,   341,   342,   343,    10,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,   377,    -1,   379,   380,   381,   382,
+     383,   384,   385,   386,   387,   388,   389,   390,   391,    10,
       11,    12,    13,    14,    15,    16,    17,    18,    19,    20,
       21,    22,    23,    24,    25,    26,    27,    28,    29,    30,
       31,    32,    33,    34,    35,    36,    37,    38,    39,    40,
@@ -6800,201 +7853,240 @@ namespace yy {
       71,    72,    73,    74,    75,    76,    77,    78,    79,    80,
       81,    82,    83,    84,    85,    86,    87,    88,    89,    90,
       91,    92,    93,    94,    95,    96,    97,    98,    99,   100,
-     101,    10,    11,    12,    13,    14,    15,    16,    17,    18,
-      19,    20,    21,    22,    23,    24,    25,    26,    27,    28,
-      29,    30,    31,    32,    33,    34,    35,    36,    37,    38,
-      39,    40,    41,    42,    43,    44,    45,    46,    47,    48,
-      49,    50,    51,    52,    53,    54,    55,    56,    57,    58,
-      59,    60,    61,    62,    63,    64,    65,    66,    67,    68,
-      69,    70,    71,    72,    73,    74,    75,    76,    77,    78,
-      79,    80,    81,    82,    83,    84,    85,    86,    87,    88,
-      89,    90,    91,    92,    93,    94,    95,    96,    97,    98,
-      99,   100,   101,    -1,    -1,   331,   332,   333,   334,   335,
-     336,   337,   338,   339,   340,   341,   342,   343,    10,    11,
-      12,    13,    14,    15,    16,    17,    18,    19,    20,    21,
-      22,    23,    24,    25,    26,    27,    28,    29,    30,    31,
-      32,    33,    34,    35,    36,    37,    38,    39,    40,    41,
-      42,    43,    44,    45,    46,    47,    48,    49,    50,    51,
-      52,    53,    54,    55,    56,    57,    58,    59,    60,    61,
-      62,    63,    64,    65,    66,    67,    68,    69,    70,    71,
-      72,    73,    74,    75,    76,    77,    78,    79,    80,    81,
-      82,    83,    84,    85,    86,    87,    88,    89,    90,    91,
-      92,    93,    94,    95,    96,    97,    98,    99,   100,   101,
-      -1,    -1,     0,    -1,    -1,    -1,     4,     5,    -1,    -1,
+     101,   102,   103,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,   329,    -1,
-     331,   332,   333,   334,   335,   336,   337,   338,   339,   340,
-     341,   342,   343,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,   379,   380,   381,   382,   383,   384,   385,
+     386,   387,   388,   389,   390,   391,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,     0,    -1,    -1,    -1,     4,     5,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-     329,    -1,   331,   332,   333,   334,   335,   336,   337,   338,
-     339,   340,   341,   342,   343,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,     0,   145,    -1,    -1,
-       4,     5,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+     377,    -1,   379,   380,   381,   382,   383,   384,   385,   386,
+     387,   388,   389,   390,   391,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
+      45,    46,    47,    48,    49,    50,    51,    52,    53,    54,
+      55,    56,    57,    58,    59,    60,    61,    62,    63,    64,
+      65,    66,    67,    68,    69,    70,    71,    72,    73,    74,
+      75,    76,    77,    78,    79,    80,    81,    82,    83,    84,
+      85,    86,    87,    88,    89,    90,    91,    92,    93,    94,
+      95,    96,    97,    98,    99,   100,   101,   102,   103,   147,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,   377,    -1,   379,   380,
+     381,   382,   383,   384,   385,   386,   387,   388,   389,   390,
+     391,    -1,    -1,    -1,    -1,    -1,    -1,     0,    -1,    -1,
+      -1,     4,     5,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,   331,
-     332,   333,   334,   335,   336,   337,   338,   339,   340,   341,
-     342,   343,   240,   241,   242,   243,   244,   245,   246,   247,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,   245,   246,   247,
      248,   249,   250,   251,   252,   253,   254,   255,   256,   257,
      258,   259,   260,   261,   262,   263,   264,   265,   266,   267,
      268,   269,   270,   271,   272,   273,   274,   275,   276,   277,
      278,   279,   280,   281,   282,   283,   284,   285,   286,   287,
-     288,   145,   290,   291,   292,   293,   294,   295,   296,   297,
-     298,   299,   300,   301,   302,   303,   304,   305,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,   317,
-     318,   319,   320,   321,   322,   323,   324,   325,   326,   327,
-     328,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+     288,   289,   290,   291,   292,   293,   294,   295,   296,   297,
+     298,   299,   300,   301,   302,   303,   304,   305,   306,   307,
+     308,   309,   310,   311,   312,   313,   314,   315,   316,   317,
+     318,   319,   320,    -1,   322,   323,   324,   325,   326,   327,
+     328,   329,   330,   331,   332,   333,   334,   335,   336,   337,
+     338,   339,   340,   341,   342,   343,   344,   345,   346,   347,
+     348,   349,   350,   351,   147,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,   365,   366,   367,
+     368,   369,   370,   371,   372,   373,   374,   375,   376,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,   240,   241,   242,   243,
-     244,   245,   246,   247,   248,   249,   250,   251,   252,   253,
-     254,   255,   256,   257,   258,   259,   260,   261,   262,   263,
-     264,   265,   266,   267,   268,   269,   270,   271,   272,   273,
-     274,   275,   276,   277,   278,   279,   280,   281,   282,   283,
-     284,   285,   286,   287,   288,   102,   290,   291,   292,   293,
-     294,   295,   296,   297,   298,   299,   300,   301,   302,   303,
-     304,   305,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,   317,   318,   319,   320,   321,   322,   323,
-     324,   325,   326,   327,   328,    -1,    -1,    -1,    -1,    -1,
-      -1,   148,   149,   150,   151,   152,   153,   154,   155,   156,
-     157,   158,   159,   160,   161,   162,   163,   164,   165,   166,
-     167,   168,   169,   170,   171,   172,   173,   174,   175,   176,
-     177,   178,   179,   180,   181,   182,   183,   184,   185,   186,
-     187,   188,   189,   190,   191,   192,   193,   194,   195,   196,
-     197,   198,   199,   200,   201,   202,   203,   204,   205,   206,
-     207,   208,   209,   210,   211,   212,   213,   214,   215,   216,
-     217,   218,   219,   220,   221,   222,   223,   224,   225,   226,
-     227,   228,   229,   230,   231,   232,   233,   234,   235,   236,
-     237,   238,   239
+      -1,    -1,    -1,    -1,   379,   380,   381,   382,   383,   384,
+     385,   386,   387,   388,   389,   390,   391,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,   245,   246,   247,   248,   249,   250,   251,   252,
+     253,   254,   255,   256,   257,   258,   259,   260,   261,   262,
+     263,   264,   265,   266,   267,   268,   269,   270,   271,   272,
+     273,   274,   275,   276,   277,   278,   279,   280,   281,   282,
+     283,   284,   285,   286,   287,   288,   289,   290,   291,   292,
+     293,   294,   295,   296,   297,   298,   299,   300,   301,   302,
+     303,   304,   305,   306,   307,   308,   309,   310,   311,   312,
+     313,   314,   315,   316,   317,   318,   319,   320,    -1,   322,
+     323,   324,   325,   326,   327,   328,   329,   330,   331,   332,
+     333,   334,   335,   336,   337,   338,   339,   340,   341,   342,
+     343,   344,   345,   346,   347,   348,   349,   350,   351,    -1,
+      -1,    -1,    -1,    -1,    -1,   104,    -1,    -1,    -1,    -1,
+      -1,    -1,   365,   366,   367,   368,   369,   370,   371,   372,
+     373,   374,   375,   376,   204,    -1,   206,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,   216,    -1,    -1,    -1,
+      -1,    -1,    -1,   223,   224,   225,   226,    -1,    -1,    -1,
+      -1,   231,   151,   152,   153,   154,   155,   156,   157,   158,
+     159,   160,   161,   162,   163,   164,   165,   166,   167,   168,
+     169,   170,   171,   172,   173,   174,   175,   176,   177,   178,
+     179,   180,   181,   182,   183,   184,   185,   186,   187,   188,
+     189,   190,   191,   192,   193,   194,   195,   196,   197,   198,
+     199,   200,   201,   202,   203,   204,   205,   206,   207,   208,
+     209,   210,   211,   212,   213,   214,   215,   216,   217,   218,
+     219,   220,   221,   222,   223,   224,   225,   226,   227,   228,
+     229,   230,   231,   232,   233,   234,   235,   236,   237,   238,
+     239,   240,   241,   242,   243,   244,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,   351,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,   368,   369,
+     370,   371,   372,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,   404,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,   509,
+     510,   511,   512,    -1,    -1,   515,   516,   517,    -1,   519,
+     520,   521,   522,   523,   524,   525,   526,   527,   528,   529,
+     530,   531,   532,   533,   534,    -1,   536,   537,   538,   539,
+      -1,    -1,   542,   543,   544,   545,   546,    -1,    -1,    -1,
+      -1,   551,   552,   553
   };
 
   const short
   seclang_parser::yystos_[] =
   {
-       0,     0,     4,     5,   145,   240,   241,   242,   243,   244,
-     245,   246,   247,   248,   249,   250,   251,   252,   253,   254,
-     255,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   290,   291,   292,   293,   294,   295,
-     296,   297,   298,   299,   300,   301,   302,   303,   304,   305,
-     317,   318,   319,   320,   321,   322,   323,   324,   325,   326,
-     327,   328,   349,   350,   351,   356,   309,   310,   146,   147,
-     309,   310,   309,   310,   314,   308,   311,   315,   309,   310,
-     309,   310,   309,   310,   312,   313,   309,   310,   312,   313,
-     309,   310,   307,   309,   310,   102,   148,   149,   150,   151,
-     152,   153,   154,   155,   156,   157,   158,   159,   160,   161,
-     162,   163,   164,   165,   166,   167,   168,   169,   170,   171,
-     172,   173,   174,   175,   176,   177,   178,   179,   180,   181,
-     182,   183,   184,   185,   186,   187,   188,   189,   190,   191,
-     192,   193,   194,   195,   196,   197,   198,   199,   200,   201,
-     202,   203,   204,   205,   206,   207,   208,   209,   210,   211,
-     212,   213,   214,   215,   216,   217,   218,   219,   220,   221,
-     222,   223,   224,   225,   226,   227,   228,   229,   230,   231,
-     232,   233,   234,   235,   236,   237,   238,   239,   330,   352,
-     353,   361,   352,   309,   310,   306,   316,     8,     9,    10,
-      11,    12,    13,    14,    15,    16,    17,    18,    19,    20,
-      21,    22,    23,    24,    25,    26,    27,    28,    29,    30,
-      31,    32,    33,    34,    35,    36,    37,    38,    39,    40,
-      41,    42,    43,    44,    45,    46,    47,    48,    49,    50,
-      51,    52,    53,    54,    55,    56,    57,    58,    59,    60,
-      61,    62,    63,    64,    65,    66,    67,    68,    69,    70,
-      71,    72,    73,    74,    75,    76,    77,    78,    79,    80,
-      81,    82,    83,    84,    85,    86,    87,    88,    89,    90,
-      91,    92,    93,    94,    95,    96,    97,    98,    99,   100,
-     101,   330,   331,   332,   333,   334,   335,   336,   337,   338,
-     339,   340,   341,   342,   343,   358,   359,   360,   358,   358,
-     352,   309,   310,   314,   309,   310,   309,   310,   357,   358,
-     352,     0,   350,   106,   360,   362,   307,   309,   310,   309,
-     310,   314,   309,   310,   309,   310,   329,   360,   363,   363,
-     363,   363,   363,   363,   363,   363,   363,   353,     3,   360,
-     360,   345,   347,   345,   347,   345,   347,   345,   347,   345,
-     347,   345,   347,   345,   347,   345,   347,   345,   347,   345,
-     347,   345,   347,   345,   347,   345,   347,   345,   347,   345,
-     347,   345,   347,   345,   347,   345,   347,   345,   347,   345,
-     347,   345,   347,   345,   347,   345,   347,   345,   347,   363,
-     345,   347,   345,   347,   363,   345,   347,   363,   345,   347,
-     363,   345,   347,   363,   345,   347,   363,   345,   347,   345,
-     347,   359,     6,   106,   107,   108,   109,   110,   111,   112,
-     113,   114,   115,   116,   117,   118,   119,   120,   121,   122,
-     123,   124,   125,   126,   127,   129,   130,   131,   132,   133,
-     134,   135,   136,   137,   138,   139,   140,   141,   142,   143,
-     144,   354,   355,   363,   360,   103,   104,   105,   329,   360,
-     330,   361,   330,     8,     9,   360,   355,   363,   363,   363,
-     363,   363,   363,   363,   363,   363,   363,   363,   363,   363,
-     363,   363,   363,   363,   363,   363,   363,   363,   363,   363,
-     363,   363,   363,   363,   363,   363,   363,   363,   363,   352,
-     363,   363,   363,   360,   360
+       0,     0,     4,     5,   147,   245,   246,   247,   248,   249,
+     250,   251,   252,   253,   254,   255,   256,   257,   258,   259,
+     260,   261,   262,   263,   264,   265,   266,   267,   268,   269,
+     270,   271,   272,   273,   274,   275,   276,   277,   278,   279,
+     280,   281,   282,   283,   284,   285,   286,   287,   288,   289,
+     290,   291,   292,   293,   294,   295,   296,   297,   298,   299,
+     300,   301,   302,   303,   304,   305,   306,   307,   308,   309,
+     310,   311,   312,   313,   314,   315,   316,   317,   318,   319,
+     320,   322,   323,   324,   325,   326,   327,   328,   329,   330,
+     331,   332,   333,   334,   335,   336,   337,   338,   339,   340,
+     341,   342,   343,   344,   345,   346,   347,   348,   349,   350,
+     351,   365,   366,   367,   368,   369,   370,   371,   372,   373,
+     374,   375,   376,   397,   398,   399,   404,   355,   356,   148,
+     149,   150,   355,   356,   355,   356,   360,   355,   356,   354,
+     357,   361,   362,   363,   355,   356,   355,   356,   355,   356,
+     355,   356,   355,   356,   355,   356,   358,   359,   355,   356,
+     358,   359,   355,   356,   355,   356,   355,   356,   355,   356,
+     355,   356,   353,   355,   356,   104,   151,   152,   153,   154,
+     155,   156,   157,   158,   159,   160,   161,   162,   163,   164,
+     165,   166,   167,   168,   169,   170,   171,   172,   173,   174,
+     175,   176,   177,   178,   179,   180,   181,   182,   183,   184,
+     185,   186,   187,   188,   189,   190,   191,   192,   193,   194,
+     195,   196,   197,   198,   199,   200,   201,   202,   203,   204,
+     205,   206,   207,   208,   209,   210,   211,   212,   213,   214,
+     215,   216,   217,   218,   219,   220,   221,   222,   223,   224,
+     225,   226,   227,   228,   229,   230,   231,   232,   233,   234,
+     235,   236,   237,   238,   239,   240,   241,   242,   243,   244,
+     378,   400,   401,   409,   400,   355,   356,   352,   364,     8,
+       9,    10,    11,    12,    13,    14,    15,    16,    17,    18,
+      19,    20,    21,    22,    23,    24,    25,    26,    27,    28,
+      29,    30,    31,    32,    33,    34,    35,    36,    37,    38,
+      39,    40,    41,    42,    43,    44,    45,    46,    47,    48,
+      49,    50,    51,    52,    53,    54,    55,    56,    57,    58,
+      59,    60,    61,    62,    63,    64,    65,    66,    67,    68,
+      69,    70,    71,    72,    73,    74,    75,    76,    77,    78,
+      79,    80,    81,    82,    83,    84,    85,    86,    87,    88,
+      89,    90,    91,    92,    93,    94,    95,    96,    97,    98,
+      99,   100,   101,   102,   103,   378,   379,   380,   381,   382,
+     383,   384,   385,   386,   387,   388,   389,   390,   391,   406,
+     407,   408,   406,   406,   400,   355,   356,   360,   355,   356,
+     355,   356,   355,   356,   405,   406,   400,     0,   398,   108,
+     408,   410,   353,   355,   356,   355,   356,   360,   355,   356,
+     355,   356,   377,   408,   411,   411,   411,   411,   411,   411,
+     411,   411,   411,   401,     3,   408,   408,   393,   395,   393,
+     395,   393,   395,   393,   395,   393,   395,   393,   395,   393,
+     395,   393,   395,   393,   395,   393,   395,   393,   395,   393,
+     395,   393,   395,   393,   395,   393,   395,   393,   395,   393,
+     395,   393,   395,   393,   395,   393,   395,   393,   395,   393,
+     395,   393,   395,   393,   395,   411,   393,   395,   393,   395,
+     411,   393,   395,   411,   393,   395,   411,   393,   395,   411,
+     393,   395,   411,   393,   395,   393,   395,   407,     6,   108,
+     109,   110,   111,   112,   113,   114,   115,   116,   117,   118,
+     119,   120,   121,   122,   123,   124,   125,   126,   127,   128,
+     129,   131,   132,   133,   134,   135,   136,   137,   138,   139,
+     140,   141,   142,   143,   144,   145,   146,   402,   403,   411,
+     408,   105,   106,   107,   377,   408,   378,   409,   378,     8,
+       9,   408,   403,   411,   411,   411,   411,   411,   411,   411,
+     411,   411,   411,   411,   411,   411,   411,   411,   411,   411,
+     411,   411,   411,   411,   411,   411,   411,   411,   411,   411,
+     411,   411,   411,   411,   411,   400,   411,   411,   411,   408,
+     408
   };
 
   const short
   seclang_parser::yyr1_[] =
   {
-       0,   348,   349,   349,   349,   350,   351,   351,   351,   351,
-     351,   351,   351,   351,   351,   351,   351,   351,   351,   351,
-     351,   351,   351,   351,   351,   351,   351,   351,   351,   352,
-     352,   353,   353,   354,   354,   354,   354,   355,   355,   355,
-     355,   355,   355,   355,   355,   355,   355,   355,   355,   355,
-     355,   355,   355,   355,   355,   355,   355,   355,   355,   355,
-     355,   355,   355,   355,   355,   355,   355,   355,   355,   355,
-     355,   355,   355,   355,   356,   356,   356,   356,   356,   356,
-     356,   356,   356,   356,   356,   356,   356,   356,   356,   356,
-     356,   356,   356,   356,   356,   356,   356,   356,   356,   356,
-     356,   356,   356,   356,   356,   356,   356,   356,   356,   356,
-     356,   356,   356,   356,   356,   356,   356,   356,   356,   356,
-     356,   356,   356,   356,   356,   356,   356,   356,   356,   356,
-     356,   356,   356,   356,   356,   356,   356,   356,   356,   356,
-     356,   356,   356,   356,   356,   356,   356,   356,   356,   356,
-     356,   356,   356,   356,   356,   357,   358,   358,   359,   359,
-     359,   359,   359,   359,   360,   360,   360,   360,   360,   360,
-     360,   360,   360,   360,   360,   360,   360,   360,   360,   360,
-     360,   360,   360,   360,   360,   360,   360,   360,   360,   360,
-     360,   360,   360,   360,   360,   360,   360,   360,   360,   360,
-     360,   360,   360,   360,   360,   360,   360,   360,   360,   360,
-     360,   360,   360,   360,   360,   360,   360,   360,   360,   360,
-     360,   360,   360,   360,   360,   360,   360,   360,   360,   360,
-     360,   360,   360,   360,   360,   360,   360,   360,   360,   360,
-     360,   360,   360,   360,   360,   360,   360,   360,   360,   360,
-     360,   360,   360,   360,   360,   360,   360,   360,   360,   360,
-     360,   360,   360,   360,   360,   360,   360,   360,   360,   360,
-     360,   360,   360,   360,   360,   360,   360,   360,   360,   360,
-     360,   360,   360,   360,   360,   360,   360,   360,   360,   360,
-     360,   360,   360,   360,   360,   360,   360,   360,   360,   360,
-     360,   360,   360,   360,   360,   360,   360,   360,   360,   360,
-     360,   360,   360,   360,   360,   360,   360,   360,   360,   360,
-     360,   360,   360,   360,   360,   360,   360,   360,   360,   360,
-     360,   360,   360,   360,   360,   360,   360,   360,   360,   361,
-     361,   361,   361,   361,   361,   361,   361,   361,   361,   361,
-     361,   361,   361,   361,   361,   361,   361,   361,   361,   361,
-     361,   361,   361,   361,   361,   361,   361,   361,   361,   361,
-     361,   361,   361,   361,   361,   361,   361,   361,   361,   361,
-     361,   361,   361,   361,   361,   361,   361,   361,   361,   361,
-     361,   361,   361,   361,   361,   361,   361,   361,   361,   361,
-     361,   361,   361,   361,   361,   361,   361,   361,   361,   361,
-     361,   361,   361,   361,   361,   361,   361,   361,   361,   361,
-     361,   361,   361,   361,   361,   361,   361,   361,   361,   361,
-     361,   361,   361,   361,   361,   361,   361,   361,   362,   362,
-     362,   362,   362,   363,   363,   363,   363
+       0,   396,   397,   397,   397,   398,   399,   399,   399,   399,
+     399,   399,   399,   399,   399,   399,   399,   399,   399,   399,
+     399,   399,   399,   399,   399,   399,   399,   399,   399,   399,
+     399,   399,   399,   399,   399,   399,   399,   399,   399,   400,
+     400,   401,   401,   402,   402,   402,   402,   403,   403,   403,
+     403,   403,   403,   403,   403,   403,   403,   403,   403,   403,
+     403,   403,   403,   403,   403,   403,   403,   403,   403,   403,
+     403,   403,   403,   403,   403,   403,   403,   403,   403,   403,
+     403,   403,   403,   403,   404,   404,   404,   404,   404,   404,
+     404,   404,   404,   404,   404,   404,   404,   404,   404,   404,
+     404,   404,   404,   404,   404,   404,   404,   404,   404,   404,
+     404,   404,   404,   404,   404,   404,   404,   404,   404,   404,
+     404,   404,   404,   404,   404,   404,   404,   404,   404,   404,
+     404,   404,   404,   404,   404,   404,   404,   404,   404,   404,
+     404,   404,   404,   404,   404,   404,   404,   404,   404,   404,
+     404,   404,   404,   404,   404,   404,   404,   404,   404,   404,
+     404,   404,   404,   404,   404,   404,   404,   404,   404,   404,
+     404,   404,   404,   404,   404,   404,   404,   404,   404,   404,
+     404,   404,   404,   404,   404,   404,   404,   404,   404,   404,
+     404,   404,   404,   404,   404,   404,   404,   404,   404,   404,
+     404,   404,   404,   404,   404,   404,   404,   404,   405,   406,
+     406,   407,   407,   407,   407,   407,   407,   408,   408,   408,
+     408,   408,   408,   408,   408,   408,   408,   408,   408,   408,
+     408,   408,   408,   408,   408,   408,   408,   408,   408,   408,
+     408,   408,   408,   408,   408,   408,   408,   408,   408,   408,
+     408,   408,   408,   408,   408,   408,   408,   408,   408,   408,
+     408,   408,   408,   408,   408,   408,   408,   408,   408,   408,
+     408,   408,   408,   408,   408,   408,   408,   408,   408,   408,
+     408,   408,   408,   408,   408,   408,   408,   408,   408,   408,
+     408,   408,   408,   408,   408,   408,   408,   408,   408,   408,
+     408,   408,   408,   408,   408,   408,   408,   408,   408,   408,
+     408,   408,   408,   408,   408,   408,   408,   408,   408,   408,
+     408,   408,   408,   408,   408,   408,   408,   408,   408,   408,
+     408,   408,   408,   408,   408,   408,   408,   408,   408,   408,
+     408,   408,   408,   408,   408,   408,   408,   408,   408,   408,
+     408,   408,   408,   408,   408,   408,   408,   408,   408,   408,
+     408,   408,   408,   408,   408,   408,   408,   408,   408,   408,
+     408,   408,   408,   408,   408,   408,   408,   408,   408,   408,
+     408,   408,   408,   408,   408,   408,   408,   408,   408,   408,
+     408,   408,   408,   408,   409,   409,   409,   409,   409,   409,
+     409,   409,   409,   409,   409,   409,   409,   409,   409,   409,
+     409,   409,   409,   409,   409,   409,   409,   409,   409,   409,
+     409,   409,   409,   409,   409,   409,   409,   409,   409,   409,
+     409,   409,   409,   409,   409,   409,   409,   409,   409,   409,
+     409,   409,   409,   409,   409,   409,   409,   409,   409,   409,
+     409,   409,   409,   409,   409,   409,   409,   409,   409,   409,
+     409,   409,   409,   409,   409,   409,   409,   409,   409,   409,
+     409,   409,   409,   409,   409,   409,   409,   409,   409,   409,
+     409,   409,   409,   409,   409,   409,   409,   409,   409,   409,
+     409,   409,   409,   409,   409,   410,   410,   410,   410,   410,
+     411,   411,   411,   411
   };
 
   const signed char
   seclang_parser::yyr2_[] =
   {
        0,     2,     1,     2,     1,     1,     1,     1,     2,     2,
-       2,     1,     1,     1,     1,     2,     2,     1,     2,     2,
-       2,     2,     2,     2,     1,     1,     1,     2,     2,     3,
+       2,     1,     1,     1,     1,     1,     1,     2,     2,     2,
+       2,     2,     1,     2,     2,     2,     2,     2,     2,     2,
+       2,     1,     1,     1,     1,     2,     2,     2,     2,     3,
        1,     3,     1,     1,     2,     1,     2,     1,     1,     1,
        1,     1,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -7004,21 +8096,25 @@ namespace yy {
        2,     2,     1,     1,     1,     2,     2,     2,     2,     1,
        2,     2,     1,     1,     1,     1,     1,     1,     2,     2,
        1,     1,     1,     2,     2,     1,     1,     1,     1,     1,
-       1,     2,     2,     2,     2,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     2,     2,     2,     2,     2,     2,
-       1,     1,     1,     1,     2,     2,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     1,     3,     3,     4,
-       4,     1,     2,     2,     2,     2,     1,     2,     2,     1,
+       1,     2,     2,     2,     2,     1,     1,     1,     1,     2,
+       2,     1,     2,     2,     1,     2,     2,     1,     1,     1,
+       1,     2,     2,     2,     2,     1,     1,     2,     2,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       3,     3,     4,     4,     1,     2,     2,     2,     2,     1,
        2,     2,     1,     2,     2,     1,     2,     2,     1,     2,
        2,     1,     2,     2,     1,     2,     2,     1,     2,     2,
        1,     2,     2,     1,     2,     2,     1,     2,     2,     1,
        2,     2,     1,     2,     2,     1,     2,     2,     1,     2,
        2,     1,     2,     2,     1,     2,     2,     1,     2,     2,
-       1,     2,     2,     1,     2,     2,     1,     2,     2,     2,
-       1,     2,     2,     2,     1,     2,     2,     2,     1,     2,
-       2,     2,     1,     2,     2,     2,     1,     2,     2,     2,
        1,     2,     2,     1,     2,     2,     1,     2,     2,     1,
-       2,     2,     1,     1,     2,     2,     1,     1,     1,     1,
+       2,     2,     2,     1,     2,     2,     2,     1,     2,     2,
+       2,     1,     2,     2,     2,     1,     2,     2,     2,     1,
+       2,     2,     2,     1,     2,     2,     1,     2,     2,     1,
+       2,     2,     1,     2,     2,     1,     1,     2,     2,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
@@ -7026,17 +8122,18 @@ namespace yy {
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     2,     2,     2,     1,
-       1,     1,     1,     2,     2,     2,     2,     2,     2,     2,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       2,     2,     1,     1,     2,     1,     1,     1,     1,     1,
-       1,     1,     1,     2,     1,     1,     1,     1,     1,     1,
-       2,     2,     2,     2,     2,     1,     1,     1,     1,     2,
+       1,     2,     2,     2,     1,     1,     1,     1,     1,     2,
+       2,     2,     2,     2,     2,     2,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     2,     2,     1,     1,
+       2,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       2,     1,     1,     1,     1,     1,     1,     2,     2,     2,
+       2,     2,     1,     1,     1,     1,     2,     1,     1,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     1,     1,     2,     1,
-       3,     3,     3,     2,     2,     1,     1
+       1,     1,     1,     1,     1,     2,     1,     3,     3,     3,
+       2,     2,     1,     1
   };
 
 
@@ -7061,7 +8158,8 @@ namespace yy {
   "\"AUTH_TYPE\"", "\"FILES_COMBINED_SIZE\"", "\"FILES_TMPNAMES\"",
   "\"FULL_REQUEST\"", "\"FULL_REQUEST_LENGTH\"", "\"INBOUND_DATA_ERROR\"",
   "\"MATCHED_VAR\"", "\"MATCHED_VAR_NAME\"", "\"MSC_PCRE_ERROR\"",
-  "\"MSC_PCRE_LIMITS_EXCEEDED\"", "VARIABLE_MULTIPART_BOUNDARY_QUOTED",
+  "\"MSC_PCRE_LIMITS_EXCEEDED\"", "\"MSC_MEMORY_LIMIT_EXCEEDED\"",
+  "\"MSC_TIME_BUDGET_EXCEEDED\"", "VARIABLE_MULTIPART_BOUNDARY_QUOTED",
   "VARIABLE_MULTIPART_BOUNDARY_WHITESPACE", "\"MULTIPART_CRLF_LF_LINES\"",
   "\"MULTIPART_DATA_AFTER\"", "VARIABLE_MULTIPART_DATA_BEFORE",
   "\"MULTIPART_FILE_LIMIT_EXCEEDED\"", "\"MULTIPART_HEADER_FOLDING\"",
@@ -7105,25 +8203,26 @@ namespace yy {
   "\"OPERATOR_VALIDATE_UTF8_ENCODING\"", "\"OPERATOR_VERIFY_CC\"",
   "\"OPERATOR_VERIFY_CPF\"", "\"OPERATOR_VERIFY_SSN\"",
   "\"OPERATOR_VERIFY_SVNR\"", "\"OPERATOR_WITHIN\"",
-  "CONFIG_DIR_AUDIT_LOG_FMT", "JSON", "NATIVE",
+  "CONFIG_DIR_AUDIT_LOG_FMT", "JSON", "MSGPACK", "NATIVE",
   "\"ACTION_CTL_RULE_ENGINE\"", "\"Accuracy\"", "\"Allow\"", "\"Append\"",
   "\"AuditLog\"", "\"Block\"", "\"Capture\"", "\"Chain\"",
   "\"ACTION_CTL_AUDIT_ENGINE\"", "\"ACTION_CTL_AUDIT_LOG_PARTS\"",
-  "\"ACTION_CTL_BDY_JSON\"", "\"ACTION_CTL_BDY_XML\"",
-  "\"ACTION_CTL_BDY_URLENCODED\"", "\"ACTION_CTL_FORCE_REQ_BODY_VAR\"",
+  "\"ACTION_CTL_BDY_GRPC\"", "\"ACTION_CTL_BDY_JSON\"",
+  "\"ACTION_CTL_BDY_XML\"", "\"ACTION_CTL_BDY_URLENCODED\"",
+  "\"ACTION_CTL_FORCE_REQ_BODY_VAR\"",
   "\"ACTION_CTL_REQUEST_BODY_ACCESS\"", "\"ACTION_CTL_RULE_REMOVE_BY_ID\"",
   "\"ACTION_CTL_RULE_REMOVE_BY_TAG\"",
   "\"ACTION_CTL_RULE_REMOVE_TARGET_BY_ID\"",
   "\"ACTION_CTL_RULE_REMOVE_TARGET_BY_TAG\"", "\"Deny\"",
   "\"DeprecateVar\"", "\"Drop\"", "\"Exec\"", "\"ExpireVar\"", "\"Id\"",
   "\"InitCol\"", "\"Log\"", "\"LogData\"", "\"Maturity\"", "\"Msg\"",
-  "\"MultiMatch\"", "\"NoAuditLog\"", "\"NoLog\"", "\"Pass\"", "\"Pause\"",
-  "\"Phase\"", "\"Prepend\"", "\"Proxy\"", "\"Redirect\"", "\"Rev\"",
-  "\"SanitiseArg\"", "\"SanitiseMatched\"", "\"SanitiseMatchedBytes\"",
-  "\"SanitiseRequestHeader\"", "\"SanitiseResponseHeader\"", "\"SetEnv\"",
-  "\"SetRsc\"", "\"SetSid\"", "\"SetUID\"", "\"Severity\"", "\"Skip\"",
-  "\"SkipAfter\"", "\"Status\"", "\"Tag\"",
-  "\"ACTION_TRANSFORMATION_BASE_64_ENCODE\"",
+  "\"MultiMatch\"", "\"NoAuditLog\"", "\"NoLog\"", "\"NoVerdictCache\"",
+  "\"Pass\"", "\"Pause\"", "\"Phase\"", "\"Prepend\"", "\"Proxy\"",
+  "\"Redirect\"", "\"Rev\"", "\"SanitiseArg\"", "\"SanitiseMatched\"",
+  "\"SanitiseMatchedBytes\"", "\"SanitiseRequestHeader\"",
+  "\"SanitiseResponseHeader\"", "\"SetEnv\"", "\"SetRsc\"", "\"SetSid\"",
+  "\"SetUID\"", "\"Severity\"", "\"Skip\"", "\"SkipAfter\"", "\"Status\"",
+  "\"Tag\"", "\"ACTION_TRANSFORMATION_BASE_64_ENCODE\"",
   "\"ACTION_TRANSFORMATION_BASE_64_DECODE\"",
   "\"ACTION_TRANSFORMATION_BASE_64_DECODE_EXT\"",
   "\"ACTION_TRANSFORMATION_CMD_LINE\"",
@@ -7159,33 +8258,61 @@ namespace yy {
   "\"ACTION_TRANSFORMATION_UTF8_TO_UNICODE\"", "\"Ver\"", "\"xmlns\"",
   "\"CONFIG_COMPONENT_SIG\"", "\"CONFIG_CONN_ENGINE\"",
   "\"CONFIG_SEC_ARGUMENT_SEPARATOR\"", "\"CONFIG_SEC_WEB_APP_ID\"",
-  "\"CONFIG_SEC_SERVER_SIG\"", "\"CONFIG_DIR_AUDIT_DIR\"",
-  "\"CONFIG_DIR_AUDIT_DIR_MOD\"", "\"CONFIG_DIR_AUDIT_ENG\"",
-  "\"CONFIG_DIR_AUDIT_FLE_MOD\"", "\"CONFIG_DIR_AUDIT_LOG\"",
-  "\"CONFIG_DIR_AUDIT_LOG2\"", "\"CONFIG_DIR_AUDIT_LOG_P\"",
-  "\"CONFIG_DIR_AUDIT_STS\"", "\"CONFIG_DIR_AUDIT_TPE\"",
-  "\"CONFIG_DIR_DEBUG_LOG\"", "\"CONFIG_DIR_DEBUG_LVL\"",
-  "\"CONFIG_SEC_CACHE_TRANSFORMATIONS\"",
+  "\"CONFIG_SEC_SERVER_SIG\"", "\"CONFIG_DIR_AUDIT_COMPRESSION_LEVEL\"",
+  "\"CONFIG_DIR_AUDIT_DIR\"", "\"CONFIG_DIR_AUDIT_DIR_MOD\"",
+  "\"CONFIG_DIR_AUDIT_ENG\"", "\"CONFIG_DIR_AUDIT_FLE_MOD\"",
+  "\"CONFIG_DIR_AUDIT_LOG\"", "\"CONFIG_DIR_AUDIT_LOG2\"",
+  "\"CONFIG_DIR_AUDIT_LOG_P\"", "\"CONFIG_DIR_AUDIT_RATE_LIMIT\"",
+  "\"CONFIG_DIR_AUDIT_STS\"", "\"CONFIG_DIR_AUDIT_TIMINGS\"",
+  "\"CONFIG_DIR_AUDIT_TPE\"", "\"CONFIG_DIR_DEBUG_LOG\"",
+  "\"CONFIG_DIR_DEBUG_LVL\"", "\"CONFIG_SEC_CACHE_TRANSFORMATIONS\"",
   "\"CONFIG_SEC_DISABLE_BACKEND_COMPRESS\"", "\"CONFIG_SEC_HASH_ENGINE\"",
   "\"CONFIG_SEC_HASH_KEY\"", "\"CONFIG_SEC_HASH_PARAM\"",
   "\"CONFIG_SEC_HASH_METHOD_RX\"", "\"CONFIG_SEC_HASH_METHOD_PM\"",
   "\"CONFIG_SEC_CHROOT_DIR\"", "\"CONFIG_DIR_GEO_DB\"",
   "\"CONFIG_DIR_GSB_DB\"", "\"CONFIG_SEC_GUARDIAN_LOG\"",
-  "\"CONFIG_DIR_PCRE_MATCH_LIMIT\"",
+  "\"CONFIG_DIR_DATA_RELOAD_INTERVAL\"",
+  "\"CONFIG_DIR_LUA_STATE_POOL_LIMIT\"",
+  "\"CONFIG_DIR_OVERLOAD_DETECTION_ONLY\"",
+  "\"CONFIG_DIR_OVERLOAD_SHED_TAG\"", "\"CONFIG_DIR_OVERLOAD_TARGET\"",
+  "\"CONFIG_DIR_PCRE_JIT_STACK_SIZE\"", "\"CONFIG_DIR_PCRE_MATCH_LIMIT\"",
+  "\"CONFIG_DIR_RBL_TIMEOUT\"", "\"CONFIG_DIR_RULE_EARLY_DECISION\"",
+  "\"CONFIG_DIR_RULE_EVALUATION_THREADS\"",
+  "\"CONFIG_DIR_RULE_ENG_SAMPLE_RATE\"",
+  "\"CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE\"",
+  "\"CONFIG_DIR_RX_GUARDRAIL\"", "\"CONFIG_DIR_REGEX_CACHE_FILE\"",
+  "\"CONFIG_DIR_RULE_NATIVE_MODULE\"", "\"CONFIG_DIR_SHADOW_RULES\"",
   "\"CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION\"",
   "\"CONFIG_SEC_CONN_R_STATE_LIMIT\"", "\"CONFIG_SEC_CONN_W_STATE_LIMIT\"",
   "\"CONFIG_SEC_SENSOR_ID\"", "\"CONFIG_DIR_ARGS_LIMIT\"",
-  "\"CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT\"", "\"CONFIG_DIR_REQ_BODY\"",
+  "\"CONFIG_DIR_REQ_BODY_DECOMPRESSION\"",
+  "\"CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO\"",
+  "\"CONFIG_DIR_RES_BODY_DECOMPRESSION\"",
+  "\"CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT\"",
+  "\"CONFIG_DIR_REQ_BODY_JSON_SIMD\"", "\"CONFIG_DIR_REQ_BODY\"",
   "\"CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT\"",
   "\"CONFIG_DIR_REQ_BODY_LIMIT\"", "\"CONFIG_DIR_REQ_BODY_LIMIT_ACTION\"",
   "\"CONFIG_DIR_REQ_BODY_NO_FILES_LIMIT\"", "\"CONFIG_DIR_RES_BODY\"",
   "\"CONFIG_DIR_RES_BODY_LIMIT\"", "\"CONFIG_DIR_RES_BODY_LIMIT_ACTION\"",
+  "\"CONFIG_DIR_RES_BODY_STREAM_WINDOW\"",
   "\"CONFIG_SEC_RULE_INHERITANCE\"", "\"CONFIG_SEC_RULE_PERF_TIME\"",
+  "\"CONFIG_SEC_RULE_PROFILING\"", "\"CONFIG_SEC_RULE_VALUE_MAJOR\"",
+  "\"CONFIG_SEC_RX_PREFILTER\"", "\"CONFIG_SEC_RX_RE2\"",
   "\"CONFIG_DIR_RULE_ENG\"", "\"CONFIG_DIR_SEC_ACTION\"",
   "\"CONFIG_DIR_SEC_DEFAULT_ACTION\"", "\"CONFIG_DIR_SEC_MARKER\"",
   "\"CONFIG_DIR_UNICODE_MAP_FILE\"", "\"CONFIG_DIR_UNICODE_CODE_PAGE\"",
-  "\"CONFIG_SEC_COLLECTION_TIMEOUT\"", "\"CONFIG_SEC_HTTP_BLKEY\"",
-  "\"CONFIG_SEC_INTERCEPT_ON_ERROR\"",
+  "\"CONFIG_SEC_COLLECTION_GROUP_COMMIT\"",
+  "\"CONFIG_SEC_COLLECTION_REDIS_SERVER\"",
+  "\"CONFIG_SEC_COLLECTION_SYNC_MODE\"",
+  "\"CONFIG_SEC_COLLECTION_TIMEOUT\"",
+  "\"CONFIG_SEC_TRANSACTION_ID_FORMAT\"",
+  "\"CONFIG_SEC_TRANSACTION_MEMORY_LIMIT\"",
+  "\"CONFIG_SEC_TRANSACTION_TIME_BUDGET\"", "\"CONFIG_SEC_VERDICT_CACHE\"",
+  "\"CONFIG_SEC_DEBUG_LOG_BUFFER\"",
+  "\"CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH\"",
+  "\"CONFIG_SEC_DEBUG_LOG_FILTER\"", "\"CONFIG_SEC_HTTP_BLKEY\"",
+  "\"CONFIG_SEC_HUGE_PAGES\"", "\"CONFIG_SEC_INTERCEPT_ON_ERROR\"",
+  "\"CONFIG_SEC_REMOTE_RULES_CACHE_DIR\"",
   "\"CONFIG_SEC_REMOTE_RULES_FAIL_ACTION\"",
   "\"CONFIG_SEC_RULE_REMOVE_BY_ID\"", "\"CONFIG_SEC_RULE_REMOVE_BY_MSG\"",
   "\"CONFIG_SEC_RULE_REMOVE_BY_TAG\"",
@@ -7194,13 +8321,15 @@ namespace yy {
   "\"CONFIG_SEC_RULE_UPDATE_TARGET_BY_ID\"",
   "\"CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID\"",
   "\"CONFIG_UPDLOAD_KEEP_FILES\"", "\"CONFIG_UPDLOAD_SAVE_TMP_FILES\"",
-  "\"CONFIG_UPLOAD_DIR\"", "\"CONFIG_UPLOAD_FILE_LIMIT\"",
-  "\"CONFIG_UPLOAD_FILE_MODE\"", "\"CONFIG_VALUE_ABORT\"",
+  "\"CONFIG_UPLOAD_ANONYMOUS_FILES\"", "\"CONFIG_UPLOAD_DIR\"",
+  "\"CONFIG_UPLOAD_FILE_LIMIT\"", "\"CONFIG_UPLOAD_FILE_MODE\"",
+  "\"CONFIG_UPLOAD_IN_MEMORY_LIMIT\"", "\"CONFIG_VALUE_ABORT\"",
   "\"CONFIG_VALUE_DETC\"", "\"CONFIG_VALUE_HTTPS\"",
   "\"CONFIG_VALUE_OFF\"", "\"CONFIG_VALUE_ON\"",
   "\"CONFIG_VALUE_PARALLEL\"", "\"CONFIG_VALUE_PROCESS_PARTIAL\"",
   "\"CONFIG_VALUE_REJECT\"", "\"CONFIG_VALUE_RELEVANT_ONLY\"",
-  "\"CONFIG_VALUE_SERIAL\"", "\"CONFIG_VALUE_WARN\"",
+  "\"CONFIG_VALUE_RING\"", "\"CONFIG_VALUE_SERIAL\"",
+  "\"CONFIG_VALUE_STREAM\"", "\"CONFIG_VALUE_WARN\"",
   "\"CONFIG_XML_EXTERNAL_ENTITY\"", "\"CONGIG_DIR_RESPONSE_BODY_MP\"",
   "\"CONGIG_DIR_SEC_ARG_SEP\"", "\"CONGIG_DIR_SEC_COOKIE_FORMAT\"",
   "\"CONFIG_SEC_COOKIEV0_SEPARATOR\"", "\"CONGIG_DIR_SEC_DATA_DIR\"",
@@ -7230,51 +8359,57 @@ namespace yy {
   const short
   seclang_parser::yyrline_[] =
   {
-       0,   720,   720,   724,   725,   728,   733,   739,   745,   749,
-     753,   759,   765,   771,   777,   782,   787,   793,   800,   804,
-     808,   814,   818,   822,   827,   832,   837,   842,   846,   853,
-     857,   864,   870,   880,   889,   899,   908,   921,   925,   929,
-     933,   937,   941,   945,   949,   953,   957,   962,   966,   970,
-     974,   978,   982,   987,   992,   996,  1000,  1004,  1008,  1012,
-    1016,  1020,  1024,  1028,  1032,  1036,  1040,  1044,  1048,  1052,
-    1056,  1060,  1064,  1068,  1082,  1083,  1113,  1132,  1151,  1179,
-    1236,  1243,  1247,  1251,  1255,  1259,  1263,  1267,  1271,  1280,
-    1284,  1289,  1292,  1297,  1302,  1307,  1312,  1315,  1320,  1323,
-    1328,  1333,  1336,  1341,  1346,  1351,  1356,  1361,  1366,  1371,
-    1374,  1379,  1384,  1389,  1394,  1397,  1402,  1407,  1412,  1425,
-    1438,  1451,  1464,  1477,  1503,  1531,  1543,  1563,  1590,  1595,
-    1601,  1606,  1611,  1620,  1625,  1629,  1633,  1637,  1641,  1645,
-    1649,  1654,  1659,  1671,  1677,  1681,  1685,  1696,  1705,  1706,
-    1713,  1718,  1723,  1777,  1784,  1792,  1829,  1833,  1840,  1845,
-    1851,  1857,  1863,  1870,  1880,  1884,  1888,  1892,  1896,  1900,
-    1904,  1908,  1912,  1916,  1920,  1924,  1928,  1932,  1936,  1940,
-    1944,  1948,  1952,  1956,  1960,  1964,  1968,  1972,  1976,  1980,
-    1984,  1988,  1992,  1996,  2000,  2004,  2008,  2012,  2016,  2020,
-    2024,  2028,  2032,  2036,  2040,  2044,  2048,  2052,  2056,  2060,
-    2064,  2068,  2072,  2076,  2080,  2084,  2088,  2092,  2096,  2100,
-    2104,  2108,  2112,  2116,  2120,  2124,  2128,  2132,  2136,  2140,
-    2144,  2148,  2152,  2156,  2160,  2164,  2168,  2172,  2176,  2180,
-    2184,  2188,  2192,  2196,  2200,  2204,  2208,  2212,  2216,  2220,
-    2224,  2228,  2232,  2236,  2240,  2244,  2248,  2253,  2257,  2261,
-    2266,  2270,  2274,  2279,  2284,  2288,  2292,  2296,  2300,  2304,
-    2308,  2312,  2316,  2320,  2324,  2328,  2332,  2336,  2340,  2344,
-    2348,  2352,  2356,  2360,  2364,  2368,  2372,  2376,  2380,  2384,
-    2388,  2392,  2396,  2400,  2404,  2408,  2412,  2416,  2420,  2424,
-    2428,  2432,  2436,  2440,  2444,  2448,  2452,  2456,  2460,  2464,
-    2468,  2472,  2476,  2480,  2484,  2488,  2492,  2496,  2500,  2504,
-    2508,  2512,  2516,  2520,  2524,  2528,  2532,  2540,  2547,  2554,
-    2561,  2568,  2575,  2582,  2589,  2596,  2603,  2610,  2617,  2627,
-    2631,  2635,  2639,  2643,  2647,  2651,  2655,  2660,  2664,  2669,
-    2673,  2677,  2681,  2685,  2690,  2695,  2699,  2703,  2707,  2711,
-    2715,  2719,  2723,  2727,  2731,  2735,  2739,  2743,  2747,  2752,
-    2756,  2760,  2764,  2768,  2772,  2776,  2780,  2784,  2788,  2792,
-    2796,  2800,  2804,  2808,  2812,  2816,  2820,  2824,  2828,  2832,
-    2836,  2840,  2844,  2848,  2852,  2856,  2860,  2864,  2868,  2872,
-    2876,  2880,  2884,  2888,  2892,  2896,  2900,  2904,  2908,  2912,
-    2916,  2920,  2924,  2928,  2932,  2936,  2940,  2944,  2948,  2952,
-    2956,  2960,  2964,  2968,  2972,  2976,  2980,  2984,  2988,  2992,
-    2996,  3000,  3004,  3008,  3012,  3016,  3020,  3024,  3031,  3035,
-    3039,  3043,  3047,  3054,  3059,  3064,  3070
+       0,   791,   791,   795,   796,   799,   804,   810,   816,   820,
+     824,   830,   846,   852,   858,   864,   870,   875,   880,   885,
+     891,   895,   901,   908,   912,   916,   920,   924,   930,   934,
+     938,   943,   948,   953,   958,   963,   967,   971,   975,   982,
+     986,   993,   999,  1009,  1014,  1020,  1026,  1036,  1040,  1044,
+    1048,  1052,  1056,  1062,  1066,  1070,  1075,  1080,  1085,  1089,
+    1093,  1097,  1101,  1105,  1110,  1114,  1118,  1122,  1126,  1130,
+    1134,  1138,  1142,  1146,  1150,  1154,  1158,  1162,  1166,  1171,
+    1176,  1180,  1184,  1188,  1202,  1203,  1233,  1252,  1271,  1302,
+    1359,  1366,  1370,  1374,  1378,  1382,  1386,  1390,  1394,  1403,
+    1407,  1412,  1415,  1420,  1425,  1433,  1438,  1441,  1446,  1449,
+    1454,  1459,  1462,  1467,  1472,  1477,  1482,  1508,  1513,  1518,
+    1521,  1526,  1531,  1536,  1541,  1544,  1549,  1554,  1559,  1572,
+    1585,  1598,  1611,  1624,  1650,  1678,  1690,  1710,  1737,  1742,
+    1746,  1755,  1765,  1769,  1778,  1783,  1787,  1797,  1802,  1807,
+    1812,  1817,  1821,  1825,  1829,  1833,  1838,  1847,  1851,  1855,
+    1860,  1865,  1870,  1875,  1880,  1885,  1921,  1945,  1954,  1964,
+    1969,  1995,  2000,  2011,  2020,  2038,  2051,  2063,  2069,  2073,
+    2077,  2081,  2085,  2089,  2093,  2097,  2106,  2110,  2114,  2119,
+    2128,  2129,  2136,  2141,  2146,  2200,  2231,  2246,  2259,  2264,
+    2269,  2274,  2279,  2284,  2289,  2308,  2319,  2330,  2348,  2385,
+    2389,  2396,  2401,  2407,  2413,  2419,  2426,  2436,  2440,  2444,
+    2448,  2453,  2458,  2463,  2468,  2473,  2478,  2482,  2486,  2490,
+    2494,  2498,  2502,  2507,  2512,  2517,  2521,  2525,  2529,  2533,
+    2537,  2541,  2545,  2549,  2553,  2557,  2561,  2565,  2569,  2573,
+    2577,  2582,  2587,  2592,  2596,  2600,  2604,  2608,  2612,  2616,
+    2620,  2624,  2628,  2633,  2638,  2643,  2647,  2651,  2655,  2659,
+    2663,  2667,  2671,  2675,  2679,  2684,  2689,  2694,  2698,  2702,
+    2706,  2710,  2714,  2718,  2722,  2726,  2730,  2734,  2738,  2742,
+    2746,  2750,  2754,  2758,  2762,  2766,  2770,  2774,  2778,  2782,
+    2786,  2790,  2794,  2798,  2802,  2806,  2810,  2814,  2819,  2824,
+    2830,  2835,  2840,  2846,  2851,  2856,  2862,  2867,  2871,  2875,
+    2879,  2883,  2888,  2892,  2896,  2900,  2904,  2908,  2912,  2916,
+    2920,  2924,  2928,  2932,  2936,  2940,  2944,  2948,  2952,  2956,
+    2960,  2964,  2968,  2972,  2976,  2980,  2984,  2988,  2993,  2997,
+    3001,  3005,  3009,  3013,  3017,  3021,  3025,  3029,  3033,  3037,
+    3041,  3045,  3049,  3053,  3057,  3061,  3065,  3069,  3074,  3079,
+    3083,  3087,  3091,  3095,  3099,  3103,  3107,  3111,  3115,  3119,
+    3123,  3127,  3135,  3142,  3149,  3156,  3163,  3170,  3177,  3184,
+    3191,  3198,  3205,  3212,  3222,  3226,  3230,  3234,  3238,  3242,
+    3246,  3250,  3255,  3259,  3264,  3270,  3274,  3278,  3282,  3286,
+    3291,  3296,  3300,  3304,  3308,  3312,  3316,  3320,  3324,  3328,
+    3332,  3336,  3340,  3344,  3350,  3355,  3359,  3363,  3367,  3371,
+    3375,  3379,  3383,  3387,  3391,  3395,  3399,  3403,  3407,  3411,
+    3415,  3419,  3423,  3427,  3431,  3435,  3439,  3443,  3447,  3451,
+    3455,  3459,  3463,  3467,  3471,  3475,  3479,  3483,  3487,  3491,
+    3495,  3499,  3503,  3507,  3511,  3515,  3519,  3523,  3527,  3531,
+    3535,  3539,  3543,  3547,  3551,  3555,  3559,  3563,  3567,  3571,
+    3575,  3579,  3583,  3587,  3591,  3595,  3599,  3603,  3607,  3611,
+    3615,  3619,  3623,  3627,  3631,  3638,  3642,  3646,  3650,  3654,
+    3661,  3666,  3671,  3677
   };
 
   void
@@ -7306,9 +8441,9 @@ namespace yy {
 
 
 } // yy
-#line 7310 "seclang-parser.cc"
+#line 8445 "seclang-parser.cc"
 
-#line 3077 "seclang-parser.yy"
+#line 3684 "seclang-parser.yy"
 
 
 void yy::seclang_parser::error (const location_type& l, const std::string& m) {
@@ -32,7 +32,7 @@
 
 
 /**
- ** \file y.tab.h
+ ** \file seclang-parser.hh
  ** Define the yy::parser class.
  */
 
@@ -45,7 +45,7 @@
 #ifndef YY_YY_SECLANG_PARSER_HH_INCLUDED
 # define YY_YY_SECLANG_PARSER_HH_INCLUDED
 // "%code requires" blocks.
-#line 10 "seclang-parser.yy"
+#line 9 "seclang-parser.yy"
 
 #include <string>
 #include <iterator>
@@ -68,6 +68,7 @@ class Driver;
 #include "src/actions/ctl/audit_log_parts.h"
 #include "src/actions/ctl/request_body_access.h"
 #include "src/actions/ctl/rule_engine.h"
+#include "src/actions/ctl/request_body_processor_grpc.h"
 #include "src/actions/ctl/request_body_processor_json.h"
 #include "src/actions/ctl/request_body_processor_xml.h"
 #include "src/actions/ctl/request_body_processor_urlencoded.h"
@@ -88,6 +89,7 @@ class Driver;
 #include "src/actions/maturity.h"
 #include "src/actions/msg.h"
 #include "src/actions/multi_match.h"
+#include "src/actions/no_verdict_cache.h"
 #include "src/actions/no_audit_log.h"
 #include "src/actions/no_log.h"
 #include "src/actions/phase.h"
@@ -193,8 +195,15 @@ class Driver;
 #include "modsecurity/modsecurity.h"
 #include "modsecurity/rules_set_properties.h"
 #include "modsecurity/rule.h"
+#include "src/native_rules.h"
 #include "src/operators/operator.h"
+#include "src/utils/debug_log_buffer.h"
+#include "src/utils/debug_log_filter.h"
+#include "src/utils/download_cache.h"
 #include "src/utils/geo_lookup.h"
+#include "src/utils/gsb.h"
+#include "src/utils/huge_pages.h"
+#include "src/utils/regex_store.h"
 #include "src/utils/string.h"
 #include "src/utils/system.h"
 #include "src/variables/args_combined_size.h"
@@ -225,6 +234,8 @@ class Driver;
 #include "src/variables/modsec_build.h"
 #include "src/variables/msc_pcre_error.h"
 #include "src/variables/msc_pcre_limits_exceeded.h"
+#include "src/variables/msc_memory_limit_exceeded.h"
+#include "src/variables/msc_time_budget_exceeded.h"
 #include "src/variables/multipart_boundary_quoted.h"
 #include "src/variables/multipart_boundary_whitespace.h"
 #include "src/variables/multipart_crlf_lf_lines.h"
@@ -341,6 +352,19 @@ using namespace modsecurity::operators;
         YYERROR; \
     }
 
+/* Operators that can compile off the parser thread are queued on the
+ * driver and initialized together once the parsing is over. */
+#define OPERATOR_INIT(a, b, c) \
+    if (a->threadSafeInit()) { \
+        driver.deferInit(a.get(), b, c); \
+    } else { \
+        std::string error; \
+        if (a->init(b, &error) == false) { \
+            driver.error(c, error); \
+            YYERROR; \
+        } \
+    }
+
 #define OPERATOR_CONTAINER(a, b) \
     std::unique_ptr<Operator> c(b); \
     a = std::move(c);
@@ -354,9 +378,9 @@ using namespace modsecurity::operators;
     a = std::move(c);
 
 
-#line 358 "seclang-parser.hh"
+#line 382 "seclang-parser.hh"
+
 
-# include <cassert>
 # include <cstdlib> // std::abort
 # include <iostream>
 # include <stdexcept>
@@ -400,11 +424,6 @@ using namespace modsecurity::operators;
 # define YY_CONSTEXPR
 #endif
 # include "location.hh"
-#include <typeinfo>
-#ifndef YY_ASSERT
-# include <cassert>
-# define YY_ASSERT assert
-#endif
 
 
 #ifndef YY_ATTRIBUTE_PURE
@@ -494,7 +513,7 @@ using namespace modsecurity::operators;
 #endif
 
 namespace yy {
-#line 498 "seclang-parser.hh"
+#line 517 "seclang-parser.hh"
 
 
 
@@ -523,15 +542,12 @@ namespace yy {
     /// Empty construction.
     value_type () YY_NOEXCEPT
       : yyraw_ ()
-      , yytypeid_ (YY_NULLPTR)
     {}
 
     /// Construct and fill.
     template <typename T>
     value_type (YY_RVREF (T) t)
-      : yytypeid_ (&typeid (T))
     {
-      YY_ASSERT (sizeof (T) <= size);
       new (yyas_<T> ()) T (YY_MOVE (t));
     }
 
@@ -544,9 +560,7 @@ namespace yy {
 
     /// Destruction, allowed only if empty.
     ~value_type () YY_NOEXCEPT
-    {
-      YY_ASSERT (!yytypeid_);
-    }
+    {}
 
 # if 201103L <= YY_CPLUSPLUS
     /// Instantiate a \a T in here from \a t.
@@ -554,9 +568,6 @@ namespace yy {
     T&
     emplace (U&&... u)
     {
-      YY_ASSERT (!yytypeid_);
-      YY_ASSERT (sizeof (T) <= size);
-      yytypeid_ = & typeid (T);
       return *new (yyas_<T> ()) T (std::forward <U>(u)...);
     }
 # else
@@ -565,9 +576,6 @@ namespace yy {
     T&
     emplace ()
     {
-      YY_ASSERT (!yytypeid_);
-      YY_ASSERT (sizeof (T) <= size);
-      yytypeid_ = & typeid (T);
       return *new (yyas_<T> ()) T ();
     }
 
@@ -576,9 +584,6 @@ namespace yy {
     T&
     emplace (const T& t)
     {
-      YY_ASSERT (!yytypeid_);
-      YY_ASSERT (sizeof (T) <= size);
-      yytypeid_ = & typeid (T);
       return *new (yyas_<T> ()) T (std::move((T&)t));
     }
 # endif
@@ -606,9 +611,6 @@ namespace yy {
     T&
     as () YY_NOEXCEPT
     {
-      YY_ASSERT (yytypeid_);
-      YY_ASSERT (*yytypeid_ == typeid (T));
-      YY_ASSERT (sizeof (T) <= size);
       return *yyas_<T> ();
     }
 
@@ -617,9 +619,6 @@ namespace yy {
     const T&
     as () const YY_NOEXCEPT
     {
-      YY_ASSERT (yytypeid_);
-      YY_ASSERT (*yytypeid_ == typeid (T));
-      YY_ASSERT (sizeof (T) <= size);
       return *yyas_<T> ();
     }
 
@@ -635,8 +634,6 @@ namespace yy {
     void
     swap (self_type& that) YY_NOEXCEPT
     {
-      YY_ASSERT (yytypeid_);
-      YY_ASSERT (*yytypeid_ == *that.yytypeid_);
       std::swap (as<T> (), that.as<T> ());
     }
 
@@ -681,7 +678,6 @@ namespace yy {
     destroy ()
     {
       as<T> ().~T ();
-      yytypeid_ = YY_NULLPTR;
     }
 
   private:
@@ -722,6 +718,7 @@ namespace yy {
       // "Chain"
       // "ACTION_CTL_AUDIT_ENGINE"
       // "ACTION_CTL_AUDIT_LOG_PARTS"
+      // "ACTION_CTL_BDY_GRPC"
       // "ACTION_CTL_BDY_JSON"
       // "ACTION_CTL_BDY_XML"
       // "ACTION_CTL_BDY_URLENCODED"
@@ -745,6 +742,7 @@ namespace yy {
       // "MultiMatch"
       // "NoAuditLog"
       // "NoLog"
+      // "NoVerdictCache"
       // "Pass"
       // "Pause"
       // "Phase"
@@ -809,6 +807,7 @@ namespace yy {
       // "CONFIG_SEC_ARGUMENT_SEPARATOR"
       // "CONFIG_SEC_WEB_APP_ID"
       // "CONFIG_SEC_SERVER_SIG"
+      // "CONFIG_DIR_AUDIT_COMPRESSION_LEVEL"
       // "CONFIG_DIR_AUDIT_DIR"
       // "CONFIG_DIR_AUDIT_DIR_MOD"
       // "CONFIG_DIR_AUDIT_ENG"
@@ -816,7 +815,9 @@ namespace yy {
       // "CONFIG_DIR_AUDIT_LOG"
       // "CONFIG_DIR_AUDIT_LOG2"
       // "CONFIG_DIR_AUDIT_LOG_P"
+      // "CONFIG_DIR_AUDIT_RATE_LIMIT"
       // "CONFIG_DIR_AUDIT_STS"
+      // "CONFIG_DIR_AUDIT_TIMINGS"
       // "CONFIG_DIR_AUDIT_TPE"
       // "CONFIG_DIR_DEBUG_LOG"
       // "CONFIG_DIR_DEBUG_LVL"
@@ -831,13 +832,32 @@ namespace yy {
       // "CONFIG_DIR_GEO_DB"
       // "CONFIG_DIR_GSB_DB"
       // "CONFIG_SEC_GUARDIAN_LOG"
+      // "CONFIG_DIR_DATA_RELOAD_INTERVAL"
+      // "CONFIG_DIR_LUA_STATE_POOL_LIMIT"
+      // "CONFIG_DIR_OVERLOAD_DETECTION_ONLY"
+      // "CONFIG_DIR_OVERLOAD_SHED_TAG"
+      // "CONFIG_DIR_OVERLOAD_TARGET"
+      // "CONFIG_DIR_PCRE_JIT_STACK_SIZE"
       // "CONFIG_DIR_PCRE_MATCH_LIMIT"
+      // "CONFIG_DIR_RBL_TIMEOUT"
+      // "CONFIG_DIR_RULE_EARLY_DECISION"
+      // "CONFIG_DIR_RULE_EVALUATION_THREADS"
+      // "CONFIG_DIR_RULE_ENG_SAMPLE_RATE"
+      // "CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE"
+      // "CONFIG_DIR_RX_GUARDRAIL"
+      // "CONFIG_DIR_REGEX_CACHE_FILE"
+      // "CONFIG_DIR_RULE_NATIVE_MODULE"
+      // "CONFIG_DIR_SHADOW_RULES"
       // "CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION"
       // "CONFIG_SEC_CONN_R_STATE_LIMIT"
       // "CONFIG_SEC_CONN_W_STATE_LIMIT"
       // "CONFIG_SEC_SENSOR_ID"
       // "CONFIG_DIR_ARGS_LIMIT"
+      // "CONFIG_DIR_REQ_BODY_DECOMPRESSION"
+      // "CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO"
+      // "CONFIG_DIR_RES_BODY_DECOMPRESSION"
       // "CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT"
+      // "CONFIG_DIR_REQ_BODY_JSON_SIMD"
       // "CONFIG_DIR_REQ_BODY"
       // "CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT"
       // "CONFIG_DIR_REQ_BODY_LIMIT"
@@ -846,17 +866,34 @@ namespace yy {
       // "CONFIG_DIR_RES_BODY"
       // "CONFIG_DIR_RES_BODY_LIMIT"
       // "CONFIG_DIR_RES_BODY_LIMIT_ACTION"
+      // "CONFIG_DIR_RES_BODY_STREAM_WINDOW"
       // "CONFIG_SEC_RULE_INHERITANCE"
       // "CONFIG_SEC_RULE_PERF_TIME"
+      // "CONFIG_SEC_RULE_PROFILING"
+      // "CONFIG_SEC_RULE_VALUE_MAJOR"
+      // "CONFIG_SEC_RX_PREFILTER"
+      // "CONFIG_SEC_RX_RE2"
       // "CONFIG_DIR_RULE_ENG"
       // "CONFIG_DIR_SEC_ACTION"
       // "CONFIG_DIR_SEC_DEFAULT_ACTION"
       // "CONFIG_DIR_SEC_MARKER"
       // "CONFIG_DIR_UNICODE_MAP_FILE"
       // "CONFIG_DIR_UNICODE_CODE_PAGE"
+      // "CONFIG_SEC_COLLECTION_GROUP_COMMIT"
+      // "CONFIG_SEC_COLLECTION_REDIS_SERVER"
+      // "CONFIG_SEC_COLLECTION_SYNC_MODE"
       // "CONFIG_SEC_COLLECTION_TIMEOUT"
+      // "CONFIG_SEC_TRANSACTION_ID_FORMAT"
+      // "CONFIG_SEC_TRANSACTION_MEMORY_LIMIT"
+      // "CONFIG_SEC_TRANSACTION_TIME_BUDGET"
+      // "CONFIG_SEC_VERDICT_CACHE"
+      // "CONFIG_SEC_DEBUG_LOG_BUFFER"
+      // "CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH"
+      // "CONFIG_SEC_DEBUG_LOG_FILTER"
       // "CONFIG_SEC_HTTP_BLKEY"
+      // "CONFIG_SEC_HUGE_PAGES"
       // "CONFIG_SEC_INTERCEPT_ON_ERROR"
+      // "CONFIG_SEC_REMOTE_RULES_CACHE_DIR"
       // "CONFIG_SEC_REMOTE_RULES_FAIL_ACTION"
       // "CONFIG_SEC_RULE_REMOVE_BY_ID"
       // "CONFIG_SEC_RULE_REMOVE_BY_MSG"
@@ -867,9 +904,11 @@ namespace yy {
       // "CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID"
       // "CONFIG_UPDLOAD_KEEP_FILES"
       // "CONFIG_UPDLOAD_SAVE_TMP_FILES"
+      // "CONFIG_UPLOAD_ANONYMOUS_FILES"
       // "CONFIG_UPLOAD_DIR"
       // "CONFIG_UPLOAD_FILE_LIMIT"
       // "CONFIG_UPLOAD_FILE_MODE"
+      // "CONFIG_UPLOAD_IN_MEMORY_LIMIT"
       // "CONFIG_VALUE_ABORT"
       // "CONFIG_VALUE_DETC"
       // "CONFIG_VALUE_HTTPS"
@@ -879,7 +918,9 @@ namespace yy {
       // "CONFIG_VALUE_PROCESS_PARTIAL"
       // "CONFIG_VALUE_REJECT"
       // "CONFIG_VALUE_RELEVANT_ONLY"
+      // "CONFIG_VALUE_RING"
       // "CONFIG_VALUE_SERIAL"
+      // "CONFIG_VALUE_STREAM"
       // "CONFIG_VALUE_WARN"
       // "CONFIG_XML_EXTERNAL_ENTITY"
       // "CONGIG_DIR_RESPONSE_BODY_MP"
@@ -949,9 +990,6 @@ namespace yy {
       /// A buffer large enough to store any of the semantic values.
       char yyraw_[size];
     };
-
-    /// Whether the content is built: if defined, the name of the stored type.
-    const std::type_info *yytypeid_;
   };
 
 #endif
@@ -1027,312 +1065,360 @@ namespace yy {
     TOK_VARIABLE_MATCHED_VAR_NAME = 294, // "MATCHED_VAR_NAME"
     TOK_VARIABLE_MSC_PCRE_ERROR = 295, // "MSC_PCRE_ERROR"
     TOK_VARIABLE_MSC_PCRE_LIMITS_EXCEEDED = 296, // "MSC_PCRE_LIMITS_EXCEEDED"
-    TOK_VARIABLE_MULTIPART_BOUNDARY_QUOTED = 297, // VARIABLE_MULTIPART_BOUNDARY_QUOTED
-    TOK_VARIABLE_MULTIPART_BOUNDARY_WHITESPACE = 298, // VARIABLE_MULTIPART_BOUNDARY_WHITESPACE
-    TOK_VARIABLE_MULTIPART_CRLF_LF_LINES = 299, // "MULTIPART_CRLF_LF_LINES"
-    TOK_VARIABLE_MULTIPART_DATA_AFTER = 300, // "MULTIPART_DATA_AFTER"
-    TOK_VARIABLE_MULTIPART_DATA_BEFORE = 301, // VARIABLE_MULTIPART_DATA_BEFORE
-    TOK_VARIABLE_MULTIPART_FILE_LIMIT_EXCEEDED = 302, // "MULTIPART_FILE_LIMIT_EXCEEDED"
-    TOK_VARIABLE_MULTIPART_HEADER_FOLDING = 303, // "MULTIPART_HEADER_FOLDING"
-    TOK_VARIABLE_MULTIPART_INVALID_HEADER_FOLDING = 304, // "MULTIPART_INVALID_HEADER_FOLDING"
-    TOK_VARIABLE_MULTIPART_INVALID_PART = 305, // VARIABLE_MULTIPART_INVALID_PART
-    TOK_VARIABLE_MULTIPART_INVALID_QUOTING = 306, // "MULTIPART_INVALID_QUOTING"
-    TOK_VARIABLE_MULTIPART_LF_LINE = 307, // VARIABLE_MULTIPART_LF_LINE
-    TOK_VARIABLE_MULTIPART_MISSING_SEMICOLON = 308, // VARIABLE_MULTIPART_MISSING_SEMICOLON
-    TOK_VARIABLE_MULTIPART_SEMICOLON_MISSING = 309, // VARIABLE_MULTIPART_SEMICOLON_MISSING
-    TOK_VARIABLE_MULTIPART_STRICT_ERROR = 310, // "MULTIPART_STRICT_ERROR"
-    TOK_VARIABLE_MULTIPART_UNMATCHED_BOUNDARY = 311, // "MULTIPART_UNMATCHED_BOUNDARY"
-    TOK_VARIABLE_OUTBOUND_DATA_ERROR = 312, // "OUTBOUND_DATA_ERROR"
-    TOK_VARIABLE_PATH_INFO = 313,  // "PATH_INFO"
-    TOK_VARIABLE_QUERY_STRING = 314, // "QUERY_STRING"
-    TOK_VARIABLE_REMOTE_ADDR = 315, // "REMOTE_ADDR"
-    TOK_VARIABLE_REMOTE_HOST = 316, // "REMOTE_HOST"
-    TOK_VARIABLE_REMOTE_PORT = 317, // "REMOTE_PORT"
-    TOK_VARIABLE_REQBODY_ERROR_MSG = 318, // "REQBODY_ERROR_MSG"
-    TOK_VARIABLE_REQBODY_ERROR = 319, // "REQBODY_ERROR"
-    TOK_VARIABLE_REQBODY_PROCESSOR_ERROR_MSG = 320, // "REQBODY_PROCESSOR_ERROR_MSG"
-    TOK_VARIABLE_REQBODY_PROCESSOR_ERROR = 321, // "REQBODY_PROCESSOR_ERROR"
-    TOK_VARIABLE_REQBODY_PROCESSOR = 322, // "REQBODY_PROCESSOR"
-    TOK_VARIABLE_REQUEST_BASENAME = 323, // "REQUEST_BASENAME"
-    TOK_VARIABLE_REQUEST_BODY_LENGTH = 324, // "REQUEST_BODY_LENGTH"
-    TOK_VARIABLE_REQUEST_BODY = 325, // "REQUEST_BODY"
-    TOK_VARIABLE_REQUEST_FILE_NAME = 326, // "REQUEST_FILENAME"
-    TOK_VARIABLE_REQUEST_HEADERS_NAMES = 327, // VARIABLE_REQUEST_HEADERS_NAMES
-    TOK_VARIABLE_REQUEST_LINE = 328, // "REQUEST_LINE"
-    TOK_VARIABLE_REQUEST_METHOD = 329, // "REQUEST_METHOD"
-    TOK_VARIABLE_REQUEST_PROTOCOL = 330, // "REQUEST_PROTOCOL"
-    TOK_VARIABLE_REQUEST_URI_RAW = 331, // "REQUEST_URI_RAW"
-    TOK_VARIABLE_REQUEST_URI = 332, // "REQUEST_URI"
-    TOK_VARIABLE_RESOURCE = 333,   // "RESOURCE"
-    TOK_VARIABLE_RESPONSE_BODY = 334, // "RESPONSE_BODY"
-    TOK_VARIABLE_RESPONSE_CONTENT_LENGTH = 335, // "RESPONSE_CONTENT_LENGTH"
-    TOK_VARIABLE_RESPONSE_CONTENT_TYPE = 336, // VARIABLE_RESPONSE_CONTENT_TYPE
-    TOK_VARIABLE_RESPONSE_HEADERS_NAMES = 337, // VARIABLE_RESPONSE_HEADERS_NAMES
-    TOK_VARIABLE_RESPONSE_PROTOCOL = 338, // "RESPONSE_PROTOCOL"
-    TOK_VARIABLE_RESPONSE_STATUS = 339, // "RESPONSE_STATUS"
-    TOK_VARIABLE_SERVER_ADDR = 340, // "SERVER_ADDR"
-    TOK_VARIABLE_SERVER_NAME = 341, // "SERVER_NAME"
-    TOK_VARIABLE_SERVER_PORT = 342, // "SERVER_PORT"
-    TOK_VARIABLE_SESSION_ID = 343, // "SESSIONID"
-    TOK_VARIABLE_UNIQUE_ID = 344,  // "UNIQUE_ID"
-    TOK_VARIABLE_URL_ENCODED_ERROR = 345, // "URLENCODED_ERROR"
-    TOK_VARIABLE_USER_ID = 346,    // "USERID"
-    TOK_VARIABLE_WEB_APP_ID = 347, // "WEBAPPID"
-    TOK_VARIABLE_STATUS = 348,     // "VARIABLE_STATUS"
-    TOK_VARIABLE_STATUS_LINE = 349, // "VARIABLE_STATUS_LINE"
-    TOK_VARIABLE_IP = 350,         // "VARIABLE_IP"
-    TOK_VARIABLE_GLOBAL = 351,     // "VARIABLE_GLOBAL"
-    TOK_VARIABLE_TX = 352,         // "VARIABLE_TX"
-    TOK_VARIABLE_SESSION = 353,    // "VARIABLE_SESSION"
-    TOK_VARIABLE_USER = 354,       // "VARIABLE_USER"
-    TOK_RUN_TIME_VAR_ENV = 355,    // "RUN_TIME_VAR_ENV"
-    TOK_RUN_TIME_VAR_XML = 356,    // "RUN_TIME_VAR_XML"
-    TOK_ACTION_SETVAR = 357,       // "SetVar"
-    TOK_SETVAR_OPERATION_EQUALS = 358, // SETVAR_OPERATION_EQUALS
-    TOK_SETVAR_OPERATION_EQUALS_PLUS = 359, // SETVAR_OPERATION_EQUALS_PLUS
-    TOK_SETVAR_OPERATION_EQUALS_MINUS = 360, // SETVAR_OPERATION_EQUALS_MINUS
-    TOK_NOT = 361,                 // "NOT"
-    TOK_OPERATOR_BEGINS_WITH = 362, // "OPERATOR_BEGINS_WITH"
-    TOK_OPERATOR_CONTAINS = 363,   // "OPERATOR_CONTAINS"
-    TOK_OPERATOR_CONTAINS_WORD = 364, // "OPERATOR_CONTAINS_WORD"
-    TOK_OPERATOR_DETECT_SQLI = 365, // "OPERATOR_DETECT_SQLI"
-    TOK_OPERATOR_DETECT_XSS = 366, // "OPERATOR_DETECT_XSS"
-    TOK_OPERATOR_ENDS_WITH = 367,  // "OPERATOR_ENDS_WITH"
-    TOK_OPERATOR_EQ = 368,         // "OPERATOR_EQ"
-    TOK_OPERATOR_FUZZY_HASH = 369, // "OPERATOR_FUZZY_HASH"
-    TOK_OPERATOR_GEOLOOKUP = 370,  // "OPERATOR_GEOLOOKUP"
-    TOK_OPERATOR_GE = 371,         // "OPERATOR_GE"
-    TOK_OPERATOR_GSB_LOOKUP = 372, // "OPERATOR_GSB_LOOKUP"
-    TOK_OPERATOR_GT = 373,         // "OPERATOR_GT"
-    TOK_OPERATOR_INSPECT_FILE = 374, // "OPERATOR_INSPECT_FILE"
-    TOK_OPERATOR_IP_MATCH_FROM_FILE = 375, // "OPERATOR_IP_MATCH_FROM_FILE"
-    TOK_OPERATOR_IP_MATCH = 376,   // "OPERATOR_IP_MATCH"
-    TOK_OPERATOR_LE = 377,         // "OPERATOR_LE"
-    TOK_OPERATOR_LT = 378,         // "OPERATOR_LT"
-    TOK_OPERATOR_PM_FROM_FILE = 379, // "OPERATOR_PM_FROM_FILE"
-    TOK_OPERATOR_PM = 380,         // "OPERATOR_PM"
-    TOK_OPERATOR_RBL = 381,        // "OPERATOR_RBL"
-    TOK_OPERATOR_RSUB = 382,       // "OPERATOR_RSUB"
-    TOK_OPERATOR_RX_CONTENT_ONLY = 383, // "Operator RX (content only)"
-    TOK_OPERATOR_RX = 384,         // "OPERATOR_RX"
-    TOK_OPERATOR_RX_GLOBAL = 385,  // "OPERATOR_RX_GLOBAL"
-    TOK_OPERATOR_STR_EQ = 386,     // "OPERATOR_STR_EQ"
-    TOK_OPERATOR_STR_MATCH = 387,  // "OPERATOR_STR_MATCH"
-    TOK_OPERATOR_UNCONDITIONAL_MATCH = 388, // "OPERATOR_UNCONDITIONAL_MATCH"
-    TOK_OPERATOR_VALIDATE_BYTE_RANGE = 389, // "OPERATOR_VALIDATE_BYTE_RANGE"
-    TOK_OPERATOR_VALIDATE_DTD = 390, // "OPERATOR_VALIDATE_DTD"
-    TOK_OPERATOR_VALIDATE_HASH = 391, // "OPERATOR_VALIDATE_HASH"
-    TOK_OPERATOR_VALIDATE_SCHEMA = 392, // "OPERATOR_VALIDATE_SCHEMA"
-    TOK_OPERATOR_VALIDATE_URL_ENCODING = 393, // "OPERATOR_VALIDATE_URL_ENCODING"
-    TOK_OPERATOR_VALIDATE_UTF8_ENCODING = 394, // "OPERATOR_VALIDATE_UTF8_ENCODING"
-    TOK_OPERATOR_VERIFY_CC = 395,  // "OPERATOR_VERIFY_CC"
-    TOK_OPERATOR_VERIFY_CPF = 396, // "OPERATOR_VERIFY_CPF"
-    TOK_OPERATOR_VERIFY_SSN = 397, // "OPERATOR_VERIFY_SSN"
-    TOK_OPERATOR_VERIFY_SVNR = 398, // "OPERATOR_VERIFY_SVNR"
-    TOK_OPERATOR_WITHIN = 399,     // "OPERATOR_WITHIN"
-    TOK_CONFIG_DIR_AUDIT_LOG_FMT = 400, // CONFIG_DIR_AUDIT_LOG_FMT
-    TOK_JSON = 401,                // JSON
-    TOK_NATIVE = 402,              // NATIVE
-    TOK_ACTION_CTL_RULE_ENGINE = 403, // "ACTION_CTL_RULE_ENGINE"
-    TOK_ACTION_ACCURACY = 404,     // "Accuracy"
-    TOK_ACTION_ALLOW = 405,        // "Allow"
-    TOK_ACTION_APPEND = 406,       // "Append"
-    TOK_ACTION_AUDIT_LOG = 407,    // "AuditLog"
-    TOK_ACTION_BLOCK = 408,        // "Block"
-    TOK_ACTION_CAPTURE = 409,      // "Capture"
-    TOK_ACTION_CHAIN = 410,        // "Chain"
-    TOK_ACTION_CTL_AUDIT_ENGINE = 411, // "ACTION_CTL_AUDIT_ENGINE"
-    TOK_ACTION_CTL_AUDIT_LOG_PARTS = 412, // "ACTION_CTL_AUDIT_LOG_PARTS"
-    TOK_ACTION_CTL_BDY_JSON = 413, // "ACTION_CTL_BDY_JSON"
-    TOK_ACTION_CTL_BDY_XML = 414,  // "ACTION_CTL_BDY_XML"
-    TOK_ACTION_CTL_BDY_URLENCODED = 415, // "ACTION_CTL_BDY_URLENCODED"
-    TOK_ACTION_CTL_FORCE_REQ_BODY_VAR = 416, // "ACTION_CTL_FORCE_REQ_BODY_VAR"
-    TOK_ACTION_CTL_REQUEST_BODY_ACCESS = 417, // "ACTION_CTL_REQUEST_BODY_ACCESS"
-    TOK_ACTION_CTL_RULE_REMOVE_BY_ID = 418, // "ACTION_CTL_RULE_REMOVE_BY_ID"
-    TOK_ACTION_CTL_RULE_REMOVE_BY_TAG = 419, // "ACTION_CTL_RULE_REMOVE_BY_TAG"
-    TOK_ACTION_CTL_RULE_REMOVE_TARGET_BY_ID = 420, // "ACTION_CTL_RULE_REMOVE_TARGET_BY_ID"
-    TOK_ACTION_CTL_RULE_REMOVE_TARGET_BY_TAG = 421, // "ACTION_CTL_RULE_REMOVE_TARGET_BY_TAG"
-    TOK_ACTION_DENY = 422,         // "Deny"
-    TOK_ACTION_DEPRECATE_VAR = 423, // "DeprecateVar"
-    TOK_ACTION_DROP = 424,         // "Drop"
-    TOK_ACTION_EXEC = 425,         // "Exec"
-    TOK_ACTION_EXPIRE_VAR = 426,   // "ExpireVar"
-    TOK_ACTION_ID = 427,           // "Id"
-    TOK_ACTION_INITCOL = 428,      // "InitCol"
-    TOK_ACTION_LOG = 429,          // "Log"
-    TOK_ACTION_LOG_DATA = 430,     // "LogData"
-    TOK_ACTION_MATURITY = 431,     // "Maturity"
-    TOK_ACTION_MSG = 432,          // "Msg"
-    TOK_ACTION_MULTI_MATCH = 433,  // "MultiMatch"
-    TOK_ACTION_NO_AUDIT_LOG = 434, // "NoAuditLog"
-    TOK_ACTION_NO_LOG = 435,       // "NoLog"
-    TOK_ACTION_PASS = 436,         // "Pass"
-    TOK_ACTION_PAUSE = 437,        // "Pause"
-    TOK_ACTION_PHASE = 438,        // "Phase"
-    TOK_ACTION_PREPEND = 439,      // "Prepend"
-    TOK_ACTION_PROXY = 440,        // "Proxy"
-    TOK_ACTION_REDIRECT = 441,     // "Redirect"
-    TOK_ACTION_REV = 442,          // "Rev"
-    TOK_ACTION_SANITISE_ARG = 443, // "SanitiseArg"
-    TOK_ACTION_SANITISE_MATCHED = 444, // "SanitiseMatched"
-    TOK_ACTION_SANITISE_MATCHED_BYTES = 445, // "SanitiseMatchedBytes"
-    TOK_ACTION_SANITISE_REQUEST_HEADER = 446, // "SanitiseRequestHeader"
-    TOK_ACTION_SANITISE_RESPONSE_HEADER = 447, // "SanitiseResponseHeader"
-    TOK_ACTION_SETENV = 448,       // "SetEnv"
-    TOK_ACTION_SETRSC = 449,       // "SetRsc"
-    TOK_ACTION_SETSID = 450,       // "SetSid"
-    TOK_ACTION_SETUID = 451,       // "SetUID"
-    TOK_ACTION_SEVERITY = 452,     // "Severity"
-    TOK_ACTION_SKIP = 453,         // "Skip"
-    TOK_ACTION_SKIP_AFTER = 454,   // "SkipAfter"
-    TOK_ACTION_STATUS = 455,       // "Status"
-    TOK_ACTION_TAG = 456,          // "Tag"
-    TOK_ACTION_TRANSFORMATION_BASE_64_ENCODE = 457, // "ACTION_TRANSFORMATION_BASE_64_ENCODE"
-    TOK_ACTION_TRANSFORMATION_BASE_64_DECODE = 458, // "ACTION_TRANSFORMATION_BASE_64_DECODE"
-    TOK_ACTION_TRANSFORMATION_BASE_64_DECODE_EXT = 459, // "ACTION_TRANSFORMATION_BASE_64_DECODE_EXT"
-    TOK_ACTION_TRANSFORMATION_CMD_LINE = 460, // "ACTION_TRANSFORMATION_CMD_LINE"
-    TOK_ACTION_TRANSFORMATION_COMPRESS_WHITESPACE = 461, // "ACTION_TRANSFORMATION_COMPRESS_WHITESPACE"
-    TOK_ACTION_TRANSFORMATION_CSS_DECODE = 462, // "ACTION_TRANSFORMATION_CSS_DECODE"
-    TOK_ACTION_TRANSFORMATION_ESCAPE_SEQ_DECODE = 463, // "ACTION_TRANSFORMATION_ESCAPE_SEQ_DECODE"
-    TOK_ACTION_TRANSFORMATION_HEX_ENCODE = 464, // "ACTION_TRANSFORMATION_HEX_ENCODE"
-    TOK_ACTION_TRANSFORMATION_HEX_DECODE = 465, // "ACTION_TRANSFORMATION_HEX_DECODE"
-    TOK_ACTION_TRANSFORMATION_HTML_ENTITY_DECODE = 466, // "ACTION_TRANSFORMATION_HTML_ENTITY_DECODE"
-    TOK_ACTION_TRANSFORMATION_JS_DECODE = 467, // "ACTION_TRANSFORMATION_JS_DECODE"
-    TOK_ACTION_TRANSFORMATION_LENGTH = 468, // "ACTION_TRANSFORMATION_LENGTH"
-    TOK_ACTION_TRANSFORMATION_LOWERCASE = 469, // "ACTION_TRANSFORMATION_LOWERCASE"
-    TOK_ACTION_TRANSFORMATION_MD5 = 470, // "ACTION_TRANSFORMATION_MD5"
-    TOK_ACTION_TRANSFORMATION_NONE = 471, // "ACTION_TRANSFORMATION_NONE"
-    TOK_ACTION_TRANSFORMATION_NORMALISE_PATH = 472, // "ACTION_TRANSFORMATION_NORMALISE_PATH"
-    TOK_ACTION_TRANSFORMATION_NORMALISE_PATH_WIN = 473, // "ACTION_TRANSFORMATION_NORMALISE_PATH_WIN"
-    TOK_ACTION_TRANSFORMATION_PARITY_EVEN_7_BIT = 474, // "ACTION_TRANSFORMATION_PARITY_EVEN_7_BIT"
-    TOK_ACTION_TRANSFORMATION_PARITY_ODD_7_BIT = 475, // "ACTION_TRANSFORMATION_PARITY_ODD_7_BIT"
-    TOK_ACTION_TRANSFORMATION_PARITY_ZERO_7_BIT = 476, // "ACTION_TRANSFORMATION_PARITY_ZERO_7_BIT"
-    TOK_ACTION_TRANSFORMATION_REMOVE_COMMENTS = 477, // "ACTION_TRANSFORMATION_REMOVE_COMMENTS"
-    TOK_ACTION_TRANSFORMATION_REMOVE_COMMENTS_CHAR = 478, // "ACTION_TRANSFORMATION_REMOVE_COMMENTS_CHAR"
-    TOK_ACTION_TRANSFORMATION_REMOVE_NULLS = 479, // "ACTION_TRANSFORMATION_REMOVE_NULLS"
-    TOK_ACTION_TRANSFORMATION_REMOVE_WHITESPACE = 480, // "ACTION_TRANSFORMATION_REMOVE_WHITESPACE"
-    TOK_ACTION_TRANSFORMATION_REPLACE_COMMENTS = 481, // "ACTION_TRANSFORMATION_REPLACE_COMMENTS"
-    TOK_ACTION_TRANSFORMATION_REPLACE_NULLS = 482, // "ACTION_TRANSFORMATION_REPLACE_NULLS"
-    TOK_ACTION_TRANSFORMATION_SHA1 = 483, // "ACTION_TRANSFORMATION_SHA1"
-    TOK_ACTION_TRANSFORMATION_SQL_HEX_DECODE = 484, // "ACTION_TRANSFORMATION_SQL_HEX_DECODE"
-    TOK_ACTION_TRANSFORMATION_TRIM = 485, // "ACTION_TRANSFORMATION_TRIM"
-    TOK_ACTION_TRANSFORMATION_TRIM_LEFT = 486, // "ACTION_TRANSFORMATION_TRIM_LEFT"
-    TOK_ACTION_TRANSFORMATION_TRIM_RIGHT = 487, // "ACTION_TRANSFORMATION_TRIM_RIGHT"
-    TOK_ACTION_TRANSFORMATION_UPPERCASE = 488, // "ACTION_TRANSFORMATION_UPPERCASE"
-    TOK_ACTION_TRANSFORMATION_URL_ENCODE = 489, // "ACTION_TRANSFORMATION_URL_ENCODE"
-    TOK_ACTION_TRANSFORMATION_URL_DECODE = 490, // "ACTION_TRANSFORMATION_URL_DECODE"
-    TOK_ACTION_TRANSFORMATION_URL_DECODE_UNI = 491, // "ACTION_TRANSFORMATION_URL_DECODE_UNI"
-    TOK_ACTION_TRANSFORMATION_UTF8_TO_UNICODE = 492, // "ACTION_TRANSFORMATION_UTF8_TO_UNICODE"
-    TOK_ACTION_VER = 493,          // "Ver"
-    TOK_ACTION_XMLNS = 494,        // "xmlns"
-    TOK_CONFIG_COMPONENT_SIG = 495, // "CONFIG_COMPONENT_SIG"
-    TOK_CONFIG_CONN_ENGINE = 496,  // "CONFIG_CONN_ENGINE"
-    TOK_CONFIG_SEC_ARGUMENT_SEPARATOR = 497, // "CONFIG_SEC_ARGUMENT_SEPARATOR"
-    TOK_CONFIG_SEC_WEB_APP_ID = 498, // "CONFIG_SEC_WEB_APP_ID"
-    TOK_CONFIG_SEC_SERVER_SIG = 499, // "CONFIG_SEC_SERVER_SIG"
-    TOK_CONFIG_DIR_AUDIT_DIR = 500, // "CONFIG_DIR_AUDIT_DIR"
-    TOK_CONFIG_DIR_AUDIT_DIR_MOD = 501, // "CONFIG_DIR_AUDIT_DIR_MOD"
-    TOK_CONFIG_DIR_AUDIT_ENG = 502, // "CONFIG_DIR_AUDIT_ENG"
-    TOK_CONFIG_DIR_AUDIT_FLE_MOD = 503, // "CONFIG_DIR_AUDIT_FLE_MOD"
-    TOK_CONFIG_DIR_AUDIT_LOG = 504, // "CONFIG_DIR_AUDIT_LOG"
-    TOK_CONFIG_DIR_AUDIT_LOG2 = 505, // "CONFIG_DIR_AUDIT_LOG2"
-    TOK_CONFIG_DIR_AUDIT_LOG_P = 506, // "CONFIG_DIR_AUDIT_LOG_P"
-    TOK_CONFIG_DIR_AUDIT_STS = 507, // "CONFIG_DIR_AUDIT_STS"
-    TOK_CONFIG_DIR_AUDIT_TPE = 508, // "CONFIG_DIR_AUDIT_TPE"
-    TOK_CONFIG_DIR_DEBUG_LOG = 509, // "CONFIG_DIR_DEBUG_LOG"
-    TOK_CONFIG_DIR_DEBUG_LVL = 510, // "CONFIG_DIR_DEBUG_LVL"
-    TOK_CONFIG_SEC_CACHE_TRANSFORMATIONS = 511, // "CONFIG_SEC_CACHE_TRANSFORMATIONS"
-    TOK_CONFIG_SEC_DISABLE_BACKEND_COMPRESS = 512, // "CONFIG_SEC_DISABLE_BACKEND_COMPRESS"
-    TOK_CONFIG_SEC_HASH_ENGINE = 513, // "CONFIG_SEC_HASH_ENGINE"
-    TOK_CONFIG_SEC_HASH_KEY = 514, // "CONFIG_SEC_HASH_KEY"
-    TOK_CONFIG_SEC_HASH_PARAM = 515, // "CONFIG_SEC_HASH_PARAM"
-    TOK_CONFIG_SEC_HASH_METHOD_RX = 516, // "CONFIG_SEC_HASH_METHOD_RX"
-    TOK_CONFIG_SEC_HASH_METHOD_PM = 517, // "CONFIG_SEC_HASH_METHOD_PM"
-    TOK_CONFIG_SEC_CHROOT_DIR = 518, // "CONFIG_SEC_CHROOT_DIR"
-    TOK_CONFIG_DIR_GEO_DB = 519,   // "CONFIG_DIR_GEO_DB"
-    TOK_CONFIG_DIR_GSB_DB = 520,   // "CONFIG_DIR_GSB_DB"
-    TOK_CONFIG_SEC_GUARDIAN_LOG = 521, // "CONFIG_SEC_GUARDIAN_LOG"
-    TOK_CONFIG_DIR_PCRE_MATCH_LIMIT = 522, // "CONFIG_DIR_PCRE_MATCH_LIMIT"
-    TOK_CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION = 523, // "CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION"
-    TOK_CONFIG_SEC_CONN_R_STATE_LIMIT = 524, // "CONFIG_SEC_CONN_R_STATE_LIMIT"
-    TOK_CONFIG_SEC_CONN_W_STATE_LIMIT = 525, // "CONFIG_SEC_CONN_W_STATE_LIMIT"
-    TOK_CONFIG_SEC_SENSOR_ID = 526, // "CONFIG_SEC_SENSOR_ID"
-    TOK_CONFIG_DIR_ARGS_LIMIT = 527, // "CONFIG_DIR_ARGS_LIMIT"
-    TOK_CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT = 528, // "CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT"
-    TOK_CONFIG_DIR_REQ_BODY = 529, // "CONFIG_DIR_REQ_BODY"
-    TOK_CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT = 530, // "CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT"
-    TOK_CONFIG_DIR_REQ_BODY_LIMIT = 531, // "CONFIG_DIR_REQ_BODY_LIMIT"
-    TOK_CONFIG_DIR_REQ_BODY_LIMIT_ACTION = 532, // "CONFIG_DIR_REQ_BODY_LIMIT_ACTION"
-    TOK_CONFIG_DIR_REQ_BODY_NO_FILES_LIMIT = 533, // "CONFIG_DIR_REQ_BODY_NO_FILES_LIMIT"
-    TOK_CONFIG_DIR_RES_BODY = 534, // "CONFIG_DIR_RES_BODY"
-    TOK_CONFIG_DIR_RES_BODY_LIMIT = 535, // "CONFIG_DIR_RES_BODY_LIMIT"
-    TOK_CONFIG_DIR_RES_BODY_LIMIT_ACTION = 536, // "CONFIG_DIR_RES_BODY_LIMIT_ACTION"
-    TOK_CONFIG_SEC_RULE_INHERITANCE = 537, // "CONFIG_SEC_RULE_INHERITANCE"
-    TOK_CONFIG_SEC_RULE_PERF_TIME = 538, // "CONFIG_SEC_RULE_PERF_TIME"
-    TOK_CONFIG_DIR_RULE_ENG = 539, // "CONFIG_DIR_RULE_ENG"
-    TOK_CONFIG_DIR_SEC_ACTION = 540, // "CONFIG_DIR_SEC_ACTION"
-    TOK_CONFIG_DIR_SEC_DEFAULT_ACTION = 541, // "CONFIG_DIR_SEC_DEFAULT_ACTION"
-    TOK_CONFIG_DIR_SEC_MARKER = 542, // "CONFIG_DIR_SEC_MARKER"
-    TOK_CONFIG_DIR_UNICODE_MAP_FILE = 543, // "CONFIG_DIR_UNICODE_MAP_FILE"
-    TOK_CONFIG_DIR_UNICODE_CODE_PAGE = 544, // "CONFIG_DIR_UNICODE_CODE_PAGE"
-    TOK_CONFIG_SEC_COLLECTION_TIMEOUT = 545, // "CONFIG_SEC_COLLECTION_TIMEOUT"
-    TOK_CONFIG_SEC_HTTP_BLKEY = 546, // "CONFIG_SEC_HTTP_BLKEY"
-    TOK_CONFIG_SEC_INTERCEPT_ON_ERROR = 547, // "CONFIG_SEC_INTERCEPT_ON_ERROR"
-    TOK_CONFIG_SEC_REMOTE_RULES_FAIL_ACTION = 548, // "CONFIG_SEC_REMOTE_RULES_FAIL_ACTION"
-    TOK_CONFIG_SEC_RULE_REMOVE_BY_ID = 549, // "CONFIG_SEC_RULE_REMOVE_BY_ID"
-    TOK_CONFIG_SEC_RULE_REMOVE_BY_MSG = 550, // "CONFIG_SEC_RULE_REMOVE_BY_MSG"
-    TOK_CONFIG_SEC_RULE_REMOVE_BY_TAG = 551, // "CONFIG_SEC_RULE_REMOVE_BY_TAG"
-    TOK_CONFIG_SEC_RULE_UPDATE_TARGET_BY_TAG = 552, // "CONFIG_SEC_RULE_UPDATE_TARGET_BY_TAG"
-    TOK_CONFIG_SEC_RULE_UPDATE_TARGET_BY_MSG = 553, // "CONFIG_SEC_RULE_UPDATE_TARGET_BY_MSG"
-    TOK_CONFIG_SEC_RULE_UPDATE_TARGET_BY_ID = 554, // "CONFIG_SEC_RULE_UPDATE_TARGET_BY_ID"
-    TOK_CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID = 555, // "CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID"
-    TOK_CONFIG_UPDLOAD_KEEP_FILES = 556, // "CONFIG_UPDLOAD_KEEP_FILES"
-    TOK_CONFIG_UPDLOAD_SAVE_TMP_FILES = 557, // "CONFIG_UPDLOAD_SAVE_TMP_FILES"
-    TOK_CONFIG_UPLOAD_DIR = 558,   // "CONFIG_UPLOAD_DIR"
-    TOK_CONFIG_UPLOAD_FILE_LIMIT = 559, // "CONFIG_UPLOAD_FILE_LIMIT"
-    TOK_CONFIG_UPLOAD_FILE_MODE = 560, // "CONFIG_UPLOAD_FILE_MODE"
-    TOK_CONFIG_VALUE_ABORT = 561,  // "CONFIG_VALUE_ABORT"
-    TOK_CONFIG_VALUE_DETC = 562,   // "CONFIG_VALUE_DETC"
-    TOK_CONFIG_VALUE_HTTPS = 563,  // "CONFIG_VALUE_HTTPS"
-    TOK_CONFIG_VALUE_OFF = 564,    // "CONFIG_VALUE_OFF"
-    TOK_CONFIG_VALUE_ON = 565,     // "CONFIG_VALUE_ON"
-    TOK_CONFIG_VALUE_PARALLEL = 566, // "CONFIG_VALUE_PARALLEL"
-    TOK_CONFIG_VALUE_PROCESS_PARTIAL = 567, // "CONFIG_VALUE_PROCESS_PARTIAL"
-    TOK_CONFIG_VALUE_REJECT = 568, // "CONFIG_VALUE_REJECT"
-    TOK_CONFIG_VALUE_RELEVANT_ONLY = 569, // "CONFIG_VALUE_RELEVANT_ONLY"
-    TOK_CONFIG_VALUE_SERIAL = 570, // "CONFIG_VALUE_SERIAL"
-    TOK_CONFIG_VALUE_WARN = 571,   // "CONFIG_VALUE_WARN"
-    TOK_CONFIG_XML_EXTERNAL_ENTITY = 572, // "CONFIG_XML_EXTERNAL_ENTITY"
-    TOK_CONGIG_DIR_RESPONSE_BODY_MP = 573, // "CONGIG_DIR_RESPONSE_BODY_MP"
-    TOK_CONGIG_DIR_SEC_ARG_SEP = 574, // "CONGIG_DIR_SEC_ARG_SEP"
-    TOK_CONGIG_DIR_SEC_COOKIE_FORMAT = 575, // "CONGIG_DIR_SEC_COOKIE_FORMAT"
-    TOK_CONFIG_SEC_COOKIEV0_SEPARATOR = 576, // "CONFIG_SEC_COOKIEV0_SEPARATOR"
-    TOK_CONGIG_DIR_SEC_DATA_DIR = 577, // "CONGIG_DIR_SEC_DATA_DIR"
-    TOK_CONGIG_DIR_SEC_STATUS_ENGINE = 578, // "CONGIG_DIR_SEC_STATUS_ENGINE"
-    TOK_CONFIG_SEC_STREAM_IN_BODY_INSPECTION = 579, // "CONFIG_SEC_STREAM_IN_BODY_INSPECTION"
-    TOK_CONFIG_SEC_STREAM_OUT_BODY_INSPECTION = 580, // "CONFIG_SEC_STREAM_OUT_BODY_INSPECTION"
-    TOK_CONGIG_DIR_SEC_TMP_DIR = 581, // "CONGIG_DIR_SEC_TMP_DIR"
-    TOK_DIRECTIVE = 582,           // "DIRECTIVE"
-    TOK_DIRECTIVE_SECRULESCRIPT = 583, // "DIRECTIVE_SECRULESCRIPT"
-    TOK_FREE_TEXT_QUOTE_MACRO_EXPANSION = 584, // "FREE_TEXT_QUOTE_MACRO_EXPANSION"
-    TOK_QUOTATION_MARK = 585,      // "QUOTATION_MARK"
-    TOK_RUN_TIME_VAR_BLD = 586,    // "RUN_TIME_VAR_BLD"
-    TOK_RUN_TIME_VAR_DUR = 587,    // "RUN_TIME_VAR_DUR"
-    TOK_RUN_TIME_VAR_HSV = 588,    // "RUN_TIME_VAR_HSV"
-    TOK_RUN_TIME_VAR_REMOTE_USER = 589, // "RUN_TIME_VAR_REMOTE_USER"
-    TOK_RUN_TIME_VAR_TIME = 590,   // "RUN_TIME_VAR_TIME"
-    TOK_RUN_TIME_VAR_TIME_DAY = 591, // "RUN_TIME_VAR_TIME_DAY"
-    TOK_RUN_TIME_VAR_TIME_EPOCH = 592, // "RUN_TIME_VAR_TIME_EPOCH"
-    TOK_RUN_TIME_VAR_TIME_HOUR = 593, // "RUN_TIME_VAR_TIME_HOUR"
-    TOK_RUN_TIME_VAR_TIME_MIN = 594, // "RUN_TIME_VAR_TIME_MIN"
-    TOK_RUN_TIME_VAR_TIME_MON = 595, // "RUN_TIME_VAR_TIME_MON"
-    TOK_RUN_TIME_VAR_TIME_SEC = 596, // "RUN_TIME_VAR_TIME_SEC"
-    TOK_RUN_TIME_VAR_TIME_WDAY = 597, // "RUN_TIME_VAR_TIME_WDAY"
-    TOK_RUN_TIME_VAR_TIME_YEAR = 598, // "RUN_TIME_VAR_TIME_YEAR"
-    TOK_VARIABLE = 599,            // "VARIABLE"
-    TOK_DICT_ELEMENT = 600,        // "Dictionary element"
-    TOK_DICT_ELEMENT_WITH_EQUALS = 601, // "Dictionary element, with equals"
-    TOK_DICT_ELEMENT_REGEXP = 602  // "Dictionary element, selected by regexp"
+    TOK_VARIABLE_MSC_MEMORY_LIMIT_EXCEEDED = 297, // "MSC_MEMORY_LIMIT_EXCEEDED"
+    TOK_VARIABLE_MSC_TIME_BUDGET_EXCEEDED = 298, // "MSC_TIME_BUDGET_EXCEEDED"
+    TOK_VARIABLE_MULTIPART_BOUNDARY_QUOTED = 299, // VARIABLE_MULTIPART_BOUNDARY_QUOTED
+    TOK_VARIABLE_MULTIPART_BOUNDARY_WHITESPACE = 300, // VARIABLE_MULTIPART_BOUNDARY_WHITESPACE
+    TOK_VARIABLE_MULTIPART_CRLF_LF_LINES = 301, // "MULTIPART_CRLF_LF_LINES"
+    TOK_VARIABLE_MULTIPART_DATA_AFTER = 302, // "MULTIPART_DATA_AFTER"
+    TOK_VARIABLE_MULTIPART_DATA_BEFORE = 303, // VARIABLE_MULTIPART_DATA_BEFORE
+    TOK_VARIABLE_MULTIPART_FILE_LIMIT_EXCEEDED = 304, // "MULTIPART_FILE_LIMIT_EXCEEDED"
+    TOK_VARIABLE_MULTIPART_HEADER_FOLDING = 305, // "MULTIPART_HEADER_FOLDING"
+    TOK_VARIABLE_MULTIPART_INVALID_HEADER_FOLDING = 306, // "MULTIPART_INVALID_HEADER_FOLDING"
+    TOK_VARIABLE_MULTIPART_INVALID_PART = 307, // VARIABLE_MULTIPART_INVALID_PART
+    TOK_VARIABLE_MULTIPART_INVALID_QUOTING = 308, // "MULTIPART_INVALID_QUOTING"
+    TOK_VARIABLE_MULTIPART_LF_LINE = 309, // VARIABLE_MULTIPART_LF_LINE
+    TOK_VARIABLE_MULTIPART_MISSING_SEMICOLON = 310, // VARIABLE_MULTIPART_MISSING_SEMICOLON
+    TOK_VARIABLE_MULTIPART_SEMICOLON_MISSING = 311, // VARIABLE_MULTIPART_SEMICOLON_MISSING
+    TOK_VARIABLE_MULTIPART_STRICT_ERROR = 312, // "MULTIPART_STRICT_ERROR"
+    TOK_VARIABLE_MULTIPART_UNMATCHED_BOUNDARY = 313, // "MULTIPART_UNMATCHED_BOUNDARY"
+    TOK_VARIABLE_OUTBOUND_DATA_ERROR = 314, // "OUTBOUND_DATA_ERROR"
+    TOK_VARIABLE_PATH_INFO = 315,  // "PATH_INFO"
+    TOK_VARIABLE_QUERY_STRING = 316, // "QUERY_STRING"
+    TOK_VARIABLE_REMOTE_ADDR = 317, // "REMOTE_ADDR"
+    TOK_VARIABLE_REMOTE_HOST = 318, // "REMOTE_HOST"
+    TOK_VARIABLE_REMOTE_PORT = 319, // "REMOTE_PORT"
+    TOK_VARIABLE_REQBODY_ERROR_MSG = 320, // "REQBODY_ERROR_MSG"
+    TOK_VARIABLE_REQBODY_ERROR = 321, // "REQBODY_ERROR"
+    TOK_VARIABLE_REQBODY_PROCESSOR_ERROR_MSG = 322, // "REQBODY_PROCESSOR_ERROR_MSG"
+    TOK_VARIABLE_REQBODY_PROCESSOR_ERROR = 323, // "REQBODY_PROCESSOR_ERROR"
+    TOK_VARIABLE_REQBODY_PROCESSOR = 324, // "REQBODY_PROCESSOR"
+    TOK_VARIABLE_REQUEST_BASENAME = 325, // "REQUEST_BASENAME"
+    TOK_VARIABLE_REQUEST_BODY_LENGTH = 326, // "REQUEST_BODY_LENGTH"
+    TOK_VARIABLE_REQUEST_BODY = 327, // "REQUEST_BODY"
+    TOK_VARIABLE_REQUEST_FILE_NAME = 328, // "REQUEST_FILENAME"
+    TOK_VARIABLE_REQUEST_HEADERS_NAMES = 329, // VARIABLE_REQUEST_HEADERS_NAMES
+    TOK_VARIABLE_REQUEST_LINE = 330, // "REQUEST_LINE"
+    TOK_VARIABLE_REQUEST_METHOD = 331, // "REQUEST_METHOD"
+    TOK_VARIABLE_REQUEST_PROTOCOL = 332, // "REQUEST_PROTOCOL"
+    TOK_VARIABLE_REQUEST_URI_RAW = 333, // "REQUEST_URI_RAW"
+    TOK_VARIABLE_REQUEST_URI = 334, // "REQUEST_URI"
+    TOK_VARIABLE_RESOURCE = 335,   // "RESOURCE"
+    TOK_VARIABLE_RESPONSE_BODY = 336, // "RESPONSE_BODY"
+    TOK_VARIABLE_RESPONSE_CONTENT_LENGTH = 337, // "RESPONSE_CONTENT_LENGTH"
+    TOK_VARIABLE_RESPONSE_CONTENT_TYPE = 338, // VARIABLE_RESPONSE_CONTENT_TYPE
+    TOK_VARIABLE_RESPONSE_HEADERS_NAMES = 339, // VARIABLE_RESPONSE_HEADERS_NAMES
+    TOK_VARIABLE_RESPONSE_PROTOCOL = 340, // "RESPONSE_PROTOCOL"
+    TOK_VARIABLE_RESPONSE_STATUS = 341, // "RESPONSE_STATUS"
+    TOK_VARIABLE_SERVER_ADDR = 342, // "SERVER_ADDR"
+    TOK_VARIABLE_SERVER_NAME = 343, // "SERVER_NAME"
+    TOK_VARIABLE_SERVER_PORT = 344, // "SERVER_PORT"
+    TOK_VARIABLE_SESSION_ID = 345, // "SESSIONID"
+    TOK_VARIABLE_UNIQUE_ID = 346,  // "UNIQUE_ID"
+    TOK_VARIABLE_URL_ENCODED_ERROR = 347, // "URLENCODED_ERROR"
+    TOK_VARIABLE_USER_ID = 348,    // "USERID"
+    TOK_VARIABLE_WEB_APP_ID = 349, // "WEBAPPID"
+    TOK_VARIABLE_STATUS = 350,     // "VARIABLE_STATUS"
+    TOK_VARIABLE_STATUS_LINE = 351, // "VARIABLE_STATUS_LINE"
+    TOK_VARIABLE_IP = 352,         // "VARIABLE_IP"
+    TOK_VARIABLE_GLOBAL = 353,     // "VARIABLE_GLOBAL"
+    TOK_VARIABLE_TX = 354,         // "VARIABLE_TX"
+    TOK_VARIABLE_SESSION = 355,    // "VARIABLE_SESSION"
+    TOK_VARIABLE_USER = 356,       // "VARIABLE_USER"
+    TOK_RUN_TIME_VAR_ENV = 357,    // "RUN_TIME_VAR_ENV"
+    TOK_RUN_TIME_VAR_XML = 358,    // "RUN_TIME_VAR_XML"
+    TOK_ACTION_SETVAR = 359,       // "SetVar"
+    TOK_SETVAR_OPERATION_EQUALS = 360, // SETVAR_OPERATION_EQUALS
+    TOK_SETVAR_OPERATION_EQUALS_PLUS = 361, // SETVAR_OPERATION_EQUALS_PLUS
+    TOK_SETVAR_OPERATION_EQUALS_MINUS = 362, // SETVAR_OPERATION_EQUALS_MINUS
+    TOK_NOT = 363,                 // "NOT"
+    TOK_OPERATOR_BEGINS_WITH = 364, // "OPERATOR_BEGINS_WITH"
+    TOK_OPERATOR_CONTAINS = 365,   // "OPERATOR_CONTAINS"
+    TOK_OPERATOR_CONTAINS_WORD = 366, // "OPERATOR_CONTAINS_WORD"
+    TOK_OPERATOR_DETECT_SQLI = 367, // "OPERATOR_DETECT_SQLI"
+    TOK_OPERATOR_DETECT_XSS = 368, // "OPERATOR_DETECT_XSS"
+    TOK_OPERATOR_ENDS_WITH = 369,  // "OPERATOR_ENDS_WITH"
+    TOK_OPERATOR_EQ = 370,         // "OPERATOR_EQ"
+    TOK_OPERATOR_FUZZY_HASH = 371, // "OPERATOR_FUZZY_HASH"
+    TOK_OPERATOR_GEOLOOKUP = 372,  // "OPERATOR_GEOLOOKUP"
+    TOK_OPERATOR_GE = 373,         // "OPERATOR_GE"
+    TOK_OPERATOR_GSB_LOOKUP = 374, // "OPERATOR_GSB_LOOKUP"
+    TOK_OPERATOR_GT = 375,         // "OPERATOR_GT"
+    TOK_OPERATOR_INSPECT_FILE = 376, // "OPERATOR_INSPECT_FILE"
+    TOK_OPERATOR_IP_MATCH_FROM_FILE = 377, // "OPERATOR_IP_MATCH_FROM_FILE"
+    TOK_OPERATOR_IP_MATCH = 378,   // "OPERATOR_IP_MATCH"
+    TOK_OPERATOR_LE = 379,         // "OPERATOR_LE"
+    TOK_OPERATOR_LT = 380,         // "OPERATOR_LT"
+    TOK_OPERATOR_PM_FROM_FILE = 381, // "OPERATOR_PM_FROM_FILE"
+    TOK_OPERATOR_PM = 382,         // "OPERATOR_PM"
+    TOK_OPERATOR_RBL = 383,        // "OPERATOR_RBL"
+    TOK_OPERATOR_RSUB = 384,       // "OPERATOR_RSUB"
+    TOK_OPERATOR_RX_CONTENT_ONLY = 385, // "Operator RX (content only)"
+    TOK_OPERATOR_RX = 386,         // "OPERATOR_RX"
+    TOK_OPERATOR_RX_GLOBAL = 387,  // "OPERATOR_RX_GLOBAL"
+    TOK_OPERATOR_STR_EQ = 388,     // "OPERATOR_STR_EQ"
+    TOK_OPERATOR_STR_MATCH = 389,  // "OPERATOR_STR_MATCH"
+    TOK_OPERATOR_UNCONDITIONAL_MATCH = 390, // "OPERATOR_UNCONDITIONAL_MATCH"
+    TOK_OPERATOR_VALIDATE_BYTE_RANGE = 391, // "OPERATOR_VALIDATE_BYTE_RANGE"
+    TOK_OPERATOR_VALIDATE_DTD = 392, // "OPERATOR_VALIDATE_DTD"
+    TOK_OPERATOR_VALIDATE_HASH = 393, // "OPERATOR_VALIDATE_HASH"
+    TOK_OPERATOR_VALIDATE_SCHEMA = 394, // "OPERATOR_VALIDATE_SCHEMA"
+    TOK_OPERATOR_VALIDATE_URL_ENCODING = 395, // "OPERATOR_VALIDATE_URL_ENCODING"
+    TOK_OPERATOR_VALIDATE_UTF8_ENCODING = 396, // "OPERATOR_VALIDATE_UTF8_ENCODING"
+    TOK_OPERATOR_VERIFY_CC = 397,  // "OPERATOR_VERIFY_CC"
+    TOK_OPERATOR_VERIFY_CPF = 398, // "OPERATOR_VERIFY_CPF"
+    TOK_OPERATOR_VERIFY_SSN = 399, // "OPERATOR_VERIFY_SSN"
+    TOK_OPERATOR_VERIFY_SVNR = 400, // "OPERATOR_VERIFY_SVNR"
+    TOK_OPERATOR_WITHIN = 401,     // "OPERATOR_WITHIN"
+    TOK_CONFIG_DIR_AUDIT_LOG_FMT = 402, // CONFIG_DIR_AUDIT_LOG_FMT
+    TOK_JSON = 403,                // JSON
+    TOK_MSGPACK = 404,             // MSGPACK
+    TOK_NATIVE = 405,              // NATIVE
+    TOK_ACTION_CTL_RULE_ENGINE = 406, // "ACTION_CTL_RULE_ENGINE"
+    TOK_ACTION_ACCURACY = 407,     // "Accuracy"
+    TOK_ACTION_ALLOW = 408,        // "Allow"
+    TOK_ACTION_APPEND = 409,       // "Append"
+    TOK_ACTION_AUDIT_LOG = 410,    // "AuditLog"
+    TOK_ACTION_BLOCK = 411,        // "Block"
+    TOK_ACTION_CAPTURE = 412,      // "Capture"
+    TOK_ACTION_CHAIN = 413,        // "Chain"
+    TOK_ACTION_CTL_AUDIT_ENGINE = 414, // "ACTION_CTL_AUDIT_ENGINE"
+    TOK_ACTION_CTL_AUDIT_LOG_PARTS = 415, // "ACTION_CTL_AUDIT_LOG_PARTS"
+    TOK_ACTION_CTL_BDY_GRPC = 416, // "ACTION_CTL_BDY_GRPC"
+    TOK_ACTION_CTL_BDY_JSON = 417, // "ACTION_CTL_BDY_JSON"
+    TOK_ACTION_CTL_BDY_XML = 418,  // "ACTION_CTL_BDY_XML"
+    TOK_ACTION_CTL_BDY_URLENCODED = 419, // "ACTION_CTL_BDY_URLENCODED"
+    TOK_ACTION_CTL_FORCE_REQ_BODY_VAR = 420, // "ACTION_CTL_FORCE_REQ_BODY_VAR"
+    TOK_ACTION_CTL_REQUEST_BODY_ACCESS = 421, // "ACTION_CTL_REQUEST_BODY_ACCESS"
+    TOK_ACTION_CTL_RULE_REMOVE_BY_ID = 422, // "ACTION_CTL_RULE_REMOVE_BY_ID"
+    TOK_ACTION_CTL_RULE_REMOVE_BY_TAG = 423, // "ACTION_CTL_RULE_REMOVE_BY_TAG"
+    TOK_ACTION_CTL_RULE_REMOVE_TARGET_BY_ID = 424, // "ACTION_CTL_RULE_REMOVE_TARGET_BY_ID"
+    TOK_ACTION_CTL_RULE_REMOVE_TARGET_BY_TAG = 425, // "ACTION_CTL_RULE_REMOVE_TARGET_BY_TAG"
+    TOK_ACTION_DENY = 426,         // "Deny"
+    TOK_ACTION_DEPRECATE_VAR = 427, // "DeprecateVar"
+    TOK_ACTION_DROP = 428,         // "Drop"
+    TOK_ACTION_EXEC = 429,         // "Exec"
+    TOK_ACTION_EXPIRE_VAR = 430,   // "ExpireVar"
+    TOK_ACTION_ID = 431,           // "Id"
+    TOK_ACTION_INITCOL = 432,      // "InitCol"
+    TOK_ACTION_LOG = 433,          // "Log"
+    TOK_ACTION_LOG_DATA = 434,     // "LogData"
+    TOK_ACTION_MATURITY = 435,     // "Maturity"
+    TOK_ACTION_MSG = 436,          // "Msg"
+    TOK_ACTION_MULTI_MATCH = 437,  // "MultiMatch"
+    TOK_ACTION_NO_AUDIT_LOG = 438, // "NoAuditLog"
+    TOK_ACTION_NO_LOG = 439,       // "NoLog"
+    TOK_ACTION_NO_VERDICT_CACHE = 440, // "NoVerdictCache"
+    TOK_ACTION_PASS = 441,         // "Pass"
+    TOK_ACTION_PAUSE = 442,        // "Pause"
+    TOK_ACTION_PHASE = 443,        // "Phase"
+    TOK_ACTION_PREPEND = 444,      // "Prepend"
+    TOK_ACTION_PROXY = 445,        // "Proxy"
+    TOK_ACTION_REDIRECT = 446,     // "Redirect"
+    TOK_ACTION_REV = 447,          // "Rev"
+    TOK_ACTION_SANITISE_ARG = 448, // "SanitiseArg"
+    TOK_ACTION_SANITISE_MATCHED = 449, // "SanitiseMatched"
+    TOK_ACTION_SANITISE_MATCHED_BYTES = 450, // "SanitiseMatchedBytes"
+    TOK_ACTION_SANITISE_REQUEST_HEADER = 451, // "SanitiseRequestHeader"
+    TOK_ACTION_SANITISE_RESPONSE_HEADER = 452, // "SanitiseResponseHeader"
+    TOK_ACTION_SETENV = 453,       // "SetEnv"
+    TOK_ACTION_SETRSC = 454,       // "SetRsc"
+    TOK_ACTION_SETSID = 455,       // "SetSid"
+    TOK_ACTION_SETUID = 456,       // "SetUID"
+    TOK_ACTION_SEVERITY = 457,     // "Severity"
+    TOK_ACTION_SKIP = 458,         // "Skip"
+    TOK_ACTION_SKIP_AFTER = 459,   // "SkipAfter"
+    TOK_ACTION_STATUS = 460,       // "Status"
+    TOK_ACTION_TAG = 461,          // "Tag"
+    TOK_ACTION_TRANSFORMATION_BASE_64_ENCODE = 462, // "ACTION_TRANSFORMATION_BASE_64_ENCODE"
+    TOK_ACTION_TRANSFORMATION_BASE_64_DECODE = 463, // "ACTION_TRANSFORMATION_BASE_64_DECODE"
+    TOK_ACTION_TRANSFORMATION_BASE_64_DECODE_EXT = 464, // "ACTION_TRANSFORMATION_BASE_64_DECODE_EXT"
+    TOK_ACTION_TRANSFORMATION_CMD_LINE = 465, // "ACTION_TRANSFORMATION_CMD_LINE"
+    TOK_ACTION_TRANSFORMATION_COMPRESS_WHITESPACE = 466, // "ACTION_TRANSFORMATION_COMPRESS_WHITESPACE"
+    TOK_ACTION_TRANSFORMATION_CSS_DECODE = 467, // "ACTION_TRANSFORMATION_CSS_DECODE"
+    TOK_ACTION_TRANSFORMATION_ESCAPE_SEQ_DECODE = 468, // "ACTION_TRANSFORMATION_ESCAPE_SEQ_DECODE"
+    TOK_ACTION_TRANSFORMATION_HEX_ENCODE = 469, // "ACTION_TRANSFORMATION_HEX_ENCODE"
+    TOK_ACTION_TRANSFORMATION_HEX_DECODE = 470, // "ACTION_TRANSFORMATION_HEX_DECODE"
+    TOK_ACTION_TRANSFORMATION_HTML_ENTITY_DECODE = 471, // "ACTION_TRANSFORMATION_HTML_ENTITY_DECODE"
+    TOK_ACTION_TRANSFORMATION_JS_DECODE = 472, // "ACTION_TRANSFORMATION_JS_DECODE"
+    TOK_ACTION_TRANSFORMATION_LENGTH = 473, // "ACTION_TRANSFORMATION_LENGTH"
+    TOK_ACTION_TRANSFORMATION_LOWERCASE = 474, // "ACTION_TRANSFORMATION_LOWERCASE"
+    TOK_ACTION_TRANSFORMATION_MD5 = 475, // "ACTION_TRANSFORMATION_MD5"
+    TOK_ACTION_TRANSFORMATION_NONE = 476, // "ACTION_TRANSFORMATION_NONE"
+    TOK_ACTION_TRANSFORMATION_NORMALISE_PATH = 477, // "ACTION_TRANSFORMATION_NORMALISE_PATH"
+    TOK_ACTION_TRANSFORMATION_NORMALISE_PATH_WIN = 478, // "ACTION_TRANSFORMATION_NORMALISE_PATH_WIN"
+    TOK_ACTION_TRANSFORMATION_PARITY_EVEN_7_BIT = 479, // "ACTION_TRANSFORMATION_PARITY_EVEN_7_BIT"
+    TOK_ACTION_TRANSFORMATION_PARITY_ODD_7_BIT = 480, // "ACTION_TRANSFORMATION_PARITY_ODD_7_BIT"
+    TOK_ACTION_TRANSFORMATION_PARITY_ZERO_7_BIT = 481, // "ACTION_TRANSFORMATION_PARITY_ZERO_7_BIT"
+    TOK_ACTION_TRANSFORMATION_REMOVE_COMMENTS = 482, // "ACTION_TRANSFORMATION_REMOVE_COMMENTS"
+    TOK_ACTION_TRANSFORMATION_REMOVE_COMMENTS_CHAR = 483, // "ACTION_TRANSFORMATION_REMOVE_COMMENTS_CHAR"
+    TOK_ACTION_TRANSFORMATION_REMOVE_NULLS = 484, // "ACTION_TRANSFORMATION_REMOVE_NULLS"
+    TOK_ACTION_TRANSFORMATION_REMOVE_WHITESPACE = 485, // "ACTION_TRANSFORMATION_REMOVE_WHITESPACE"
+    TOK_ACTION_TRANSFORMATION_REPLACE_COMMENTS = 486, // "ACTION_TRANSFORMATION_REPLACE_COMMENTS"
+    TOK_ACTION_TRANSFORMATION_REPLACE_NULLS = 487, // "ACTION_TRANSFORMATION_REPLACE_NULLS"
+    TOK_ACTION_TRANSFORMATION_SHA1 = 488, // "ACTION_TRANSFORMATION_SHA1"
+    TOK_ACTION_TRANSFORMATION_SQL_HEX_DECODE = 489, // "ACTION_TRANSFORMATION_SQL_HEX_DECODE"
+    TOK_ACTION_TRANSFORMATION_TRIM = 490, // "ACTION_TRANSFORMATION_TRIM"
+    TOK_ACTION_TRANSFORMATION_TRIM_LEFT = 491, // "ACTION_TRANSFORMATION_TRIM_LEFT"
+    TOK_ACTION_TRANSFORMATION_TRIM_RIGHT = 492, // "ACTION_TRANSFORMATION_TRIM_RIGHT"
+    TOK_ACTION_TRANSFORMATION_UPPERCASE = 493, // "ACTION_TRANSFORMATION_UPPERCASE"
+    TOK_ACTION_TRANSFORMATION_URL_ENCODE = 494, // "ACTION_TRANSFORMATION_URL_ENCODE"
+    TOK_ACTION_TRANSFORMATION_URL_DECODE = 495, // "ACTION_TRANSFORMATION_URL_DECODE"
+    TOK_ACTION_TRANSFORMATION_URL_DECODE_UNI = 496, // "ACTION_TRANSFORMATION_URL_DECODE_UNI"
+    TOK_ACTION_TRANSFORMATION_UTF8_TO_UNICODE = 497, // "ACTION_TRANSFORMATION_UTF8_TO_UNICODE"
+    TOK_ACTION_VER = 498,          // "Ver"
+    TOK_ACTION_XMLNS = 499,        // "xmlns"
+    TOK_CONFIG_COMPONENT_SIG = 500, // "CONFIG_COMPONENT_SIG"
+    TOK_CONFIG_CONN_ENGINE = 501,  // "CONFIG_CONN_ENGINE"
+    TOK_CONFIG_SEC_ARGUMENT_SEPARATOR = 502, // "CONFIG_SEC_ARGUMENT_SEPARATOR"
+    TOK_CONFIG_SEC_WEB_APP_ID = 503, // "CONFIG_SEC_WEB_APP_ID"
+    TOK_CONFIG_SEC_SERVER_SIG = 504, // "CONFIG_SEC_SERVER_SIG"
+    TOK_CONFIG_DIR_AUDIT_COMPRESSION_LEVEL = 505, // "CONFIG_DIR_AUDIT_COMPRESSION_LEVEL"
+    TOK_CONFIG_DIR_AUDIT_DIR = 506, // "CONFIG_DIR_AUDIT_DIR"
+    TOK_CONFIG_DIR_AUDIT_DIR_MOD = 507, // "CONFIG_DIR_AUDIT_DIR_MOD"
+    TOK_CONFIG_DIR_AUDIT_ENG = 508, // "CONFIG_DIR_AUDIT_ENG"
+    TOK_CONFIG_DIR_AUDIT_FLE_MOD = 509, // "CONFIG_DIR_AUDIT_FLE_MOD"
+    TOK_CONFIG_DIR_AUDIT_LOG = 510, // "CONFIG_DIR_AUDIT_LOG"
+    TOK_CONFIG_DIR_AUDIT_LOG2 = 511, // "CONFIG_DIR_AUDIT_LOG2"
+    TOK_CONFIG_DIR_AUDIT_LOG_P = 512, // "CONFIG_DIR_AUDIT_LOG_P"
+    TOK_CONFIG_DIR_AUDIT_RATE_LIMIT = 513, // "CONFIG_DIR_AUDIT_RATE_LIMIT"
+    TOK_CONFIG_DIR_AUDIT_STS = 514, // "CONFIG_DIR_AUDIT_STS"
+    TOK_CONFIG_DIR_AUDIT_TIMINGS = 515, // "CONFIG_DIR_AUDIT_TIMINGS"
+    TOK_CONFIG_DIR_AUDIT_TPE = 516, // "CONFIG_DIR_AUDIT_TPE"
+    TOK_CONFIG_DIR_DEBUG_LOG = 517, // "CONFIG_DIR_DEBUG_LOG"
+    TOK_CONFIG_DIR_DEBUG_LVL = 518, // "CONFIG_DIR_DEBUG_LVL"
+    TOK_CONFIG_SEC_CACHE_TRANSFORMATIONS = 519, // "CONFIG_SEC_CACHE_TRANSFORMATIONS"
+    TOK_CONFIG_SEC_DISABLE_BACKEND_COMPRESS = 520, // "CONFIG_SEC_DISABLE_BACKEND_COMPRESS"
+    TOK_CONFIG_SEC_HASH_ENGINE = 521, // "CONFIG_SEC_HASH_ENGINE"
+    TOK_CONFIG_SEC_HASH_KEY = 522, // "CONFIG_SEC_HASH_KEY"
+    TOK_CONFIG_SEC_HASH_PARAM = 523, // "CONFIG_SEC_HASH_PARAM"
+    TOK_CONFIG_SEC_HASH_METHOD_RX = 524, // "CONFIG_SEC_HASH_METHOD_RX"
+    TOK_CONFIG_SEC_HASH_METHOD_PM = 525, // "CONFIG_SEC_HASH_METHOD_PM"
+    TOK_CONFIG_SEC_CHROOT_DIR = 526, // "CONFIG_SEC_CHROOT_DIR"
+    TOK_CONFIG_DIR_GEO_DB = 527,   // "CONFIG_DIR_GEO_DB"
+    TOK_CONFIG_DIR_GSB_DB = 528,   // "CONFIG_DIR_GSB_DB"
+    TOK_CONFIG_SEC_GUARDIAN_LOG = 529, // "CONFIG_SEC_GUARDIAN_LOG"
+    TOK_CONFIG_DIR_DATA_RELOAD_INTERVAL = 530, // "CONFIG_DIR_DATA_RELOAD_INTERVAL"
+    TOK_CONFIG_DIR_LUA_STATE_POOL_LIMIT = 531, // "CONFIG_DIR_LUA_STATE_POOL_LIMIT"
+    TOK_CONFIG_DIR_OVERLOAD_DETECTION_ONLY = 532, // "CONFIG_DIR_OVERLOAD_DETECTION_ONLY"
+    TOK_CONFIG_DIR_OVERLOAD_SHED_TAG = 533, // "CONFIG_DIR_OVERLOAD_SHED_TAG"
+    TOK_CONFIG_DIR_OVERLOAD_TARGET = 534, // "CONFIG_DIR_OVERLOAD_TARGET"
+    TOK_CONFIG_DIR_PCRE_JIT_STACK_SIZE = 535, // "CONFIG_DIR_PCRE_JIT_STACK_SIZE"
+    TOK_CONFIG_DIR_PCRE_MATCH_LIMIT = 536, // "CONFIG_DIR_PCRE_MATCH_LIMIT"
+    TOK_CONFIG_DIR_RBL_TIMEOUT = 537, // "CONFIG_DIR_RBL_TIMEOUT"
+    TOK_CONFIG_DIR_RULE_EARLY_DECISION = 538, // "CONFIG_DIR_RULE_EARLY_DECISION"
+    TOK_CONFIG_DIR_RULE_EVALUATION_THREADS = 539, // "CONFIG_DIR_RULE_EVALUATION_THREADS"
+    TOK_CONFIG_DIR_RULE_ENG_SAMPLE_RATE = 540, // "CONFIG_DIR_RULE_ENG_SAMPLE_RATE"
+    TOK_CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE = 541, // "CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE"
+    TOK_CONFIG_DIR_RX_GUARDRAIL = 542, // "CONFIG_DIR_RX_GUARDRAIL"
+    TOK_CONFIG_DIR_REGEX_CACHE_FILE = 543, // "CONFIG_DIR_REGEX_CACHE_FILE"
+    TOK_CONFIG_DIR_RULE_NATIVE_MODULE = 544, // "CONFIG_DIR_RULE_NATIVE_MODULE"
+    TOK_CONFIG_DIR_SHADOW_RULES = 545, // "CONFIG_DIR_SHADOW_RULES"
+    TOK_CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION = 546, // "CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION"
+    TOK_CONFIG_SEC_CONN_R_STATE_LIMIT = 547, // "CONFIG_SEC_CONN_R_STATE_LIMIT"
+    TOK_CONFIG_SEC_CONN_W_STATE_LIMIT = 548, // "CONFIG_SEC_CONN_W_STATE_LIMIT"
+    TOK_CONFIG_SEC_SENSOR_ID = 549, // "CONFIG_SEC_SENSOR_ID"
+    TOK_CONFIG_DIR_ARGS_LIMIT = 550, // "CONFIG_DIR_ARGS_LIMIT"
+    TOK_CONFIG_DIR_REQ_BODY_DECOMPRESSION = 551, // "CONFIG_DIR_REQ_BODY_DECOMPRESSION"
+    TOK_CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO = 552, // "CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO"
+    TOK_CONFIG_DIR_RES_BODY_DECOMPRESSION = 553, // "CONFIG_DIR_RES_BODY_DECOMPRESSION"
+    TOK_CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT = 554, // "CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT"
+    TOK_CONFIG_DIR_REQ_BODY_JSON_SIMD = 555, // "CONFIG_DIR_REQ_BODY_JSON_SIMD"
+    TOK_CONFIG_DIR_REQ_BODY = 556, // "CONFIG_DIR_REQ_BODY"
+    TOK_CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT = 557, // "CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT"
+    TOK_CONFIG_DIR_REQ_BODY_LIMIT = 558, // "CONFIG_DIR_REQ_BODY_LIMIT"
+    TOK_CONFIG_DIR_REQ_BODY_LIMIT_ACTION = 559, // "CONFIG_DIR_REQ_BODY_LIMIT_ACTION"
+    TOK_CONFIG_DIR_REQ_BODY_NO_FILES_LIMIT = 560, // "CONFIG_DIR_REQ_BODY_NO_FILES_LIMIT"
+    TOK_CONFIG_DIR_RES_BODY = 561, // "CONFIG_DIR_RES_BODY"
+    TOK_CONFIG_DIR_RES_BODY_LIMIT = 562, // "CONFIG_DIR_RES_BODY_LIMIT"
+    TOK_CONFIG_DIR_RES_BODY_LIMIT_ACTION = 563, // "CONFIG_DIR_RES_BODY_LIMIT_ACTION"
+    TOK_CONFIG_DIR_RES_BODY_STREAM_WINDOW = 564, // "CONFIG_DIR_RES_BODY_STREAM_WINDOW"
+    TOK_CONFIG_SEC_RULE_INHERITANCE = 565, // "CONFIG_SEC_RULE_INHERITANCE"
+    TOK_CONFIG_SEC_RULE_PERF_TIME = 566, // "CONFIG_SEC_RULE_PERF_TIME"
+    TOK_CONFIG_SEC_RULE_PROFILING = 567, // "CONFIG_SEC_RULE_PROFILING"
+    TOK_CONFIG_SEC_RULE_VALUE_MAJOR = 568, // "CONFIG_SEC_RULE_VALUE_MAJOR"
+    TOK_CONFIG_SEC_RX_PREFILTER = 569, // "CONFIG_SEC_RX_PREFILTER"
+    TOK_CONFIG_SEC_RX_RE2 = 570,   // "CONFIG_SEC_RX_RE2"
+    TOK_CONFIG_DIR_RULE_ENG = 571, // "CONFIG_DIR_RULE_ENG"
+    TOK_CONFIG_DIR_SEC_ACTION = 572, // "CONFIG_DIR_SEC_ACTION"
+    TOK_CONFIG_DIR_SEC_DEFAULT_ACTION = 573, // "CONFIG_DIR_SEC_DEFAULT_ACTION"
+    TOK_CONFIG_DIR_SEC_MARKER = 574, // "CONFIG_DIR_SEC_MARKER"
+    TOK_CONFIG_DIR_UNICODE_MAP_FILE = 575, // "CONFIG_DIR_UNICODE_MAP_FILE"
+    TOK_CONFIG_DIR_UNICODE_CODE_PAGE = 576, // "CONFIG_DIR_UNICODE_CODE_PAGE"
+    TOK_CONFIG_SEC_COLLECTION_GROUP_COMMIT = 577, // "CONFIG_SEC_COLLECTION_GROUP_COMMIT"
+    TOK_CONFIG_SEC_COLLECTION_REDIS_SERVER = 578, // "CONFIG_SEC_COLLECTION_REDIS_SERVER"
+    TOK_CONFIG_SEC_COLLECTION_SYNC_MODE = 579, // "CONFIG_SEC_COLLECTION_SYNC_MODE"
+    TOK_CONFIG_SEC_COLLECTION_TIMEOUT = 580, // "CONFIG_SEC_COLLECTION_TIMEOUT"
+    TOK_CONFIG_SEC_TRANSACTION_ID_FORMAT = 581, // "CONFIG_SEC_TRANSACTION_ID_FORMAT"
+    TOK_CONFIG_SEC_TRANSACTION_MEMORY_LIMIT = 582, // "CONFIG_SEC_TRANSACTION_MEMORY_LIMIT"
+    TOK_CONFIG_SEC_TRANSACTION_TIME_BUDGET = 583, // "CONFIG_SEC_TRANSACTION_TIME_BUDGET"
+    TOK_CONFIG_SEC_VERDICT_CACHE = 584, // "CONFIG_SEC_VERDICT_CACHE"
+    TOK_CONFIG_SEC_DEBUG_LOG_BUFFER = 585, // "CONFIG_SEC_DEBUG_LOG_BUFFER"
+    TOK_CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH = 586, // "CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH"
+    TOK_CONFIG_SEC_DEBUG_LOG_FILTER = 587, // "CONFIG_SEC_DEBUG_LOG_FILTER"
+    TOK_CONFIG_SEC_HTTP_BLKEY = 588, // "CONFIG_SEC_HTTP_BLKEY"
+    TOK_CONFIG_SEC_HUGE_PAGES = 589, // "CONFIG_SEC_HUGE_PAGES"
+    TOK_CONFIG_SEC_INTERCEPT_ON_ERROR = 590, // "CONFIG_SEC_INTERCEPT_ON_ERROR"
+    TOK_CONFIG_SEC_REMOTE_RULES_CACHE_DIR = 591, // "CONFIG_SEC_REMOTE_RULES_CACHE_DIR"
+    TOK_CONFIG_SEC_REMOTE_RULES_FAIL_ACTION = 592, // "CONFIG_SEC_REMOTE_RULES_FAIL_ACTION"
+    TOK_CONFIG_SEC_RULE_REMOVE_BY_ID = 593, // "CONFIG_SEC_RULE_REMOVE_BY_ID"
+    TOK_CONFIG_SEC_RULE_REMOVE_BY_MSG = 594, // "CONFIG_SEC_RULE_REMOVE_BY_MSG"
+    TOK_CONFIG_SEC_RULE_REMOVE_BY_TAG = 595, // "CONFIG_SEC_RULE_REMOVE_BY_TAG"
+    TOK_CONFIG_SEC_RULE_UPDATE_TARGET_BY_TAG = 596, // "CONFIG_SEC_RULE_UPDATE_TARGET_BY_TAG"
+    TOK_CONFIG_SEC_RULE_UPDATE_TARGET_BY_MSG = 597, // "CONFIG_SEC_RULE_UPDATE_TARGET_BY_MSG"
+    TOK_CONFIG_SEC_RULE_UPDATE_TARGET_BY_ID = 598, // "CONFIG_SEC_RULE_UPDATE_TARGET_BY_ID"
+    TOK_CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID = 599, // "CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID"
+    TOK_CONFIG_UPDLOAD_KEEP_FILES = 600, // "CONFIG_UPDLOAD_KEEP_FILES"
+    TOK_CONFIG_UPDLOAD_SAVE_TMP_FILES = 601, // "CONFIG_UPDLOAD_SAVE_TMP_FILES"
+    TOK_CONFIG_UPLOAD_ANONYMOUS_FILES = 602, // "CONFIG_UPLOAD_ANONYMOUS_FILES"
+    TOK_CONFIG_UPLOAD_DIR = 603,   // "CONFIG_UPLOAD_DIR"
+    TOK_CONFIG_UPLOAD_FILE_LIMIT = 604, // "CONFIG_UPLOAD_FILE_LIMIT"
+    TOK_CONFIG_UPLOAD_FILE_MODE = 605, // "CONFIG_UPLOAD_FILE_MODE"
+    TOK_CONFIG_UPLOAD_IN_MEMORY_LIMIT = 606, // "CONFIG_UPLOAD_IN_MEMORY_LIMIT"
+    TOK_CONFIG_VALUE_ABORT = 607,  // "CONFIG_VALUE_ABORT"
+    TOK_CONFIG_VALUE_DETC = 608,   // "CONFIG_VALUE_DETC"
+    TOK_CONFIG_VALUE_HTTPS = 609,  // "CONFIG_VALUE_HTTPS"
+    TOK_CONFIG_VALUE_OFF = 610,    // "CONFIG_VALUE_OFF"
+    TOK_CONFIG_VALUE_ON = 611,     // "CONFIG_VALUE_ON"
+    TOK_CONFIG_VALUE_PARALLEL = 612, // "CONFIG_VALUE_PARALLEL"
+    TOK_CONFIG_VALUE_PROCESS_PARTIAL = 613, // "CONFIG_VALUE_PROCESS_PARTIAL"
+    TOK_CONFIG_VALUE_REJECT = 614, // "CONFIG_VALUE_REJECT"
+    TOK_CONFIG_VALUE_RELEVANT_ONLY = 615, // "CONFIG_VALUE_RELEVANT_ONLY"
+    TOK_CONFIG_VALUE_RING = 616,   // "CONFIG_VALUE_RING"
+    TOK_CONFIG_VALUE_SERIAL = 617, // "CONFIG_VALUE_SERIAL"
+    TOK_CONFIG_VALUE_STREAM = 618, // "CONFIG_VALUE_STREAM"
+    TOK_CONFIG_VALUE_WARN = 619,   // "CONFIG_VALUE_WARN"
+    TOK_CONFIG_XML_EXTERNAL_ENTITY = 620, // "CONFIG_XML_EXTERNAL_ENTITY"
+    TOK_CONGIG_DIR_RESPONSE_BODY_MP = 621, // "CONGIG_DIR_RESPONSE_BODY_MP"
+    TOK_CONGIG_DIR_SEC_ARG_SEP = 622, // "CONGIG_DIR_SEC_ARG_SEP"
+    TOK_CONGIG_DIR_SEC_COOKIE_FORMAT = 623, // "CONGIG_DIR_SEC_COOKIE_FORMAT"
+    TOK_CONFIG_SEC_COOKIEV0_SEPARATOR = 624, // "CONFIG_SEC_COOKIEV0_SEPARATOR"
+    TOK_CONGIG_DIR_SEC_DATA_DIR = 625, // "CONGIG_DIR_SEC_DATA_DIR"
+    TOK_CONGIG_DIR_SEC_STATUS_ENGINE = 626, // "CONGIG_DIR_SEC_STATUS_ENGINE"
+    TOK_CONFIG_SEC_STREAM_IN_BODY_INSPECTION = 627, // "CONFIG_SEC_STREAM_IN_BODY_INSPECTION"
+    TOK_CONFIG_SEC_STREAM_OUT_BODY_INSPECTION = 628, // "CONFIG_SEC_STREAM_OUT_BODY_INSPECTION"
+    TOK_CONGIG_DIR_SEC_TMP_DIR = 629, // "CONGIG_DIR_SEC_TMP_DIR"
+    TOK_DIRECTIVE = 630,           // "DIRECTIVE"
+    TOK_DIRECTIVE_SECRULESCRIPT = 631, // "DIRECTIVE_SECRULESCRIPT"
+    TOK_FREE_TEXT_QUOTE_MACRO_EXPANSION = 632, // "FREE_TEXT_QUOTE_MACRO_EXPANSION"
+    TOK_QUOTATION_MARK = 633,      // "QUOTATION_MARK"
+    TOK_RUN_TIME_VAR_BLD = 634,    // "RUN_TIME_VAR_BLD"
+    TOK_RUN_TIME_VAR_DUR = 635,    // "RUN_TIME_VAR_DUR"
+    TOK_RUN_TIME_VAR_HSV = 636,    // "RUN_TIME_VAR_HSV"
+    TOK_RUN_TIME_VAR_REMOTE_USER = 637, // "RUN_TIME_VAR_REMOTE_USER"
+    TOK_RUN_TIME_VAR_TIME = 638,   // "RUN_TIME_VAR_TIME"
+    TOK_RUN_TIME_VAR_TIME_DAY = 639, // "RUN_TIME_VAR_TIME_DAY"
+    TOK_RUN_TIME_VAR_TIME_EPOCH = 640, // "RUN_TIME_VAR_TIME_EPOCH"
+    TOK_RUN_TIME_VAR_TIME_HOUR = 641, // "RUN_TIME_VAR_TIME_HOUR"
+    TOK_RUN_TIME_VAR_TIME_MIN = 642, // "RUN_TIME_VAR_TIME_MIN"
+    TOK_RUN_TIME_VAR_TIME_MON = 643, // "RUN_TIME_VAR_TIME_MON"
+    TOK_RUN_TIME_VAR_TIME_SEC = 644, // "RUN_TIME_VAR_TIME_SEC"
+    TOK_RUN_TIME_VAR_TIME_WDAY = 645, // "RUN_TIME_VAR_TIME_WDAY"
+    TOK_RUN_TIME_VAR_TIME_YEAR = 646, // "RUN_TIME_VAR_TIME_YEAR"
+    TOK_VARIABLE = 647,            // "VARIABLE"
+    TOK_DICT_ELEMENT = 648,        // "Dictionary element"
+    TOK_DICT_ELEMENT_WITH_EQUALS = 649, // "Dictionary element, with equals"
+    TOK_DICT_ELEMENT_REGEXP = 650  // "Dictionary element, selected by regexp"
       };
       /// Backward compatibility alias (Bison 3.6).
       typedef token_kind_type yytokentype;
@@ -1349,7 +1435,7 @@ namespace yy {
     {
       enum symbol_kind_type
       {
-        YYNTOKENS = 348, ///< Number of tokens.
+        YYNTOKENS = 396, ///< Number of tokens.
         S_YYEMPTY = -2,
         S_YYEOF = 0,                             // "end of file"
         S_YYerror = 1,                           // error
@@ -1393,328 +1479,376 @@ namespace yy {
         S_VARIABLE_MATCHED_VAR_NAME = 39,        // "MATCHED_VAR_NAME"
         S_VARIABLE_MSC_PCRE_ERROR = 40,          // "MSC_PCRE_ERROR"
         S_VARIABLE_MSC_PCRE_LIMITS_EXCEEDED = 41, // "MSC_PCRE_LIMITS_EXCEEDED"
-        S_VARIABLE_MULTIPART_BOUNDARY_QUOTED = 42, // VARIABLE_MULTIPART_BOUNDARY_QUOTED
-        S_VARIABLE_MULTIPART_BOUNDARY_WHITESPACE = 43, // VARIABLE_MULTIPART_BOUNDARY_WHITESPACE
-        S_VARIABLE_MULTIPART_CRLF_LF_LINES = 44, // "MULTIPART_CRLF_LF_LINES"
-        S_VARIABLE_MULTIPART_DATA_AFTER = 45,    // "MULTIPART_DATA_AFTER"
-        S_VARIABLE_MULTIPART_DATA_BEFORE = 46,   // VARIABLE_MULTIPART_DATA_BEFORE
-        S_VARIABLE_MULTIPART_FILE_LIMIT_EXCEEDED = 47, // "MULTIPART_FILE_LIMIT_EXCEEDED"
-        S_VARIABLE_MULTIPART_HEADER_FOLDING = 48, // "MULTIPART_HEADER_FOLDING"
-        S_VARIABLE_MULTIPART_INVALID_HEADER_FOLDING = 49, // "MULTIPART_INVALID_HEADER_FOLDING"
-        S_VARIABLE_MULTIPART_INVALID_PART = 50,  // VARIABLE_MULTIPART_INVALID_PART
-        S_VARIABLE_MULTIPART_INVALID_QUOTING = 51, // "MULTIPART_INVALID_QUOTING"
-        S_VARIABLE_MULTIPART_LF_LINE = 52,       // VARIABLE_MULTIPART_LF_LINE
-        S_VARIABLE_MULTIPART_MISSING_SEMICOLON = 53, // VARIABLE_MULTIPART_MISSING_SEMICOLON
-        S_VARIABLE_MULTIPART_SEMICOLON_MISSING = 54, // VARIABLE_MULTIPART_SEMICOLON_MISSING
-        S_VARIABLE_MULTIPART_STRICT_ERROR = 55,  // "MULTIPART_STRICT_ERROR"
-        S_VARIABLE_MULTIPART_UNMATCHED_BOUNDARY = 56, // "MULTIPART_UNMATCHED_BOUNDARY"
-        S_VARIABLE_OUTBOUND_DATA_ERROR = 57,     // "OUTBOUND_DATA_ERROR"
-        S_VARIABLE_PATH_INFO = 58,               // "PATH_INFO"
-        S_VARIABLE_QUERY_STRING = 59,            // "QUERY_STRING"
-        S_VARIABLE_REMOTE_ADDR = 60,             // "REMOTE_ADDR"
-        S_VARIABLE_REMOTE_HOST = 61,             // "REMOTE_HOST"
-        S_VARIABLE_REMOTE_PORT = 62,             // "REMOTE_PORT"
-        S_VARIABLE_REQBODY_ERROR_MSG = 63,       // "REQBODY_ERROR_MSG"
-        S_VARIABLE_REQBODY_ERROR = 64,           // "REQBODY_ERROR"
-        S_VARIABLE_REQBODY_PROCESSOR_ERROR_MSG = 65, // "REQBODY_PROCESSOR_ERROR_MSG"
-        S_VARIABLE_REQBODY_PROCESSOR_ERROR = 66, // "REQBODY_PROCESSOR_ERROR"
-        S_VARIABLE_REQBODY_PROCESSOR = 67,       // "REQBODY_PROCESSOR"
-        S_VARIABLE_REQUEST_BASENAME = 68,        // "REQUEST_BASENAME"
-        S_VARIABLE_REQUEST_BODY_LENGTH = 69,     // "REQUEST_BODY_LENGTH"
-        S_VARIABLE_REQUEST_BODY = 70,            // "REQUEST_BODY"
-        S_VARIABLE_REQUEST_FILE_NAME = 71,       // "REQUEST_FILENAME"
-        S_VARIABLE_REQUEST_HEADERS_NAMES = 72,   // VARIABLE_REQUEST_HEADERS_NAMES
-        S_VARIABLE_REQUEST_LINE = 73,            // "REQUEST_LINE"
-        S_VARIABLE_REQUEST_METHOD = 74,          // "REQUEST_METHOD"
-        S_VARIABLE_REQUEST_PROTOCOL = 75,        // "REQUEST_PROTOCOL"
-        S_VARIABLE_REQUEST_URI_RAW = 76,         // "REQUEST_URI_RAW"
-        S_VARIABLE_REQUEST_URI = 77,             // "REQUEST_URI"
-        S_VARIABLE_RESOURCE = 78,                // "RESOURCE"
-        S_VARIABLE_RESPONSE_BODY = 79,           // "RESPONSE_BODY"
-        S_VARIABLE_RESPONSE_CONTENT_LENGTH = 80, // "RESPONSE_CONTENT_LENGTH"
-        S_VARIABLE_RESPONSE_CONTENT_TYPE = 81,   // VARIABLE_RESPONSE_CONTENT_TYPE
-        S_VARIABLE_RESPONSE_HEADERS_NAMES = 82,  // VARIABLE_RESPONSE_HEADERS_NAMES
-        S_VARIABLE_RESPONSE_PROTOCOL = 83,       // "RESPONSE_PROTOCOL"
-        S_VARIABLE_RESPONSE_STATUS = 84,         // "RESPONSE_STATUS"
-        S_VARIABLE_SERVER_ADDR = 85,             // "SERVER_ADDR"
-        S_VARIABLE_SERVER_NAME = 86,             // "SERVER_NAME"
-        S_VARIABLE_SERVER_PORT = 87,             // "SERVER_PORT"
-        S_VARIABLE_SESSION_ID = 88,              // "SESSIONID"
-        S_VARIABLE_UNIQUE_ID = 89,               // "UNIQUE_ID"
-        S_VARIABLE_URL_ENCODED_ERROR = 90,       // "URLENCODED_ERROR"
-        S_VARIABLE_USER_ID = 91,                 // "USERID"
-        S_VARIABLE_WEB_APP_ID = 92,              // "WEBAPPID"
-        S_VARIABLE_STATUS = 93,                  // "VARIABLE_STATUS"
-        S_VARIABLE_STATUS_LINE = 94,             // "VARIABLE_STATUS_LINE"
-        S_VARIABLE_IP = 95,                      // "VARIABLE_IP"
-        S_VARIABLE_GLOBAL = 96,                  // "VARIABLE_GLOBAL"
-        S_VARIABLE_TX = 97,                      // "VARIABLE_TX"
-        S_VARIABLE_SESSION = 98,                 // "VARIABLE_SESSION"
-        S_VARIABLE_USER = 99,                    // "VARIABLE_USER"
-        S_RUN_TIME_VAR_ENV = 100,                // "RUN_TIME_VAR_ENV"
-        S_RUN_TIME_VAR_XML = 101,                // "RUN_TIME_VAR_XML"
-        S_ACTION_SETVAR = 102,                   // "SetVar"
-        S_SETVAR_OPERATION_EQUALS = 103,         // SETVAR_OPERATION_EQUALS
-        S_SETVAR_OPERATION_EQUALS_PLUS = 104,    // SETVAR_OPERATION_EQUALS_PLUS
-        S_SETVAR_OPERATION_EQUALS_MINUS = 105,   // SETVAR_OPERATION_EQUALS_MINUS
-        S_NOT = 106,                             // "NOT"
-        S_OPERATOR_BEGINS_WITH = 107,            // "OPERATOR_BEGINS_WITH"
-        S_OPERATOR_CONTAINS = 108,               // "OPERATOR_CONTAINS"
-        S_OPERATOR_CONTAINS_WORD = 109,          // "OPERATOR_CONTAINS_WORD"
-        S_OPERATOR_DETECT_SQLI = 110,            // "OPERATOR_DETECT_SQLI"
-        S_OPERATOR_DETECT_XSS = 111,             // "OPERATOR_DETECT_XSS"
-        S_OPERATOR_ENDS_WITH = 112,              // "OPERATOR_ENDS_WITH"
-        S_OPERATOR_EQ = 113,                     // "OPERATOR_EQ"
-        S_OPERATOR_FUZZY_HASH = 114,             // "OPERATOR_FUZZY_HASH"
-        S_OPERATOR_GEOLOOKUP = 115,              // "OPERATOR_GEOLOOKUP"
-        S_OPERATOR_GE = 116,                     // "OPERATOR_GE"
-        S_OPERATOR_GSB_LOOKUP = 117,             // "OPERATOR_GSB_LOOKUP"
-        S_OPERATOR_GT = 118,                     // "OPERATOR_GT"
-        S_OPERATOR_INSPECT_FILE = 119,           // "OPERATOR_INSPECT_FILE"
-        S_OPERATOR_IP_MATCH_FROM_FILE = 120,     // "OPERATOR_IP_MATCH_FROM_FILE"
-        S_OPERATOR_IP_MATCH = 121,               // "OPERATOR_IP_MATCH"
-        S_OPERATOR_LE = 122,                     // "OPERATOR_LE"
-        S_OPERATOR_LT = 123,                     // "OPERATOR_LT"
-        S_OPERATOR_PM_FROM_FILE = 124,           // "OPERATOR_PM_FROM_FILE"
-        S_OPERATOR_PM = 125,                     // "OPERATOR_PM"
-        S_OPERATOR_RBL = 126,                    // "OPERATOR_RBL"
-        S_OPERATOR_RSUB = 127,                   // "OPERATOR_RSUB"
-        S_OPERATOR_RX_CONTENT_ONLY = 128,        // "Operator RX (content only)"
-        S_OPERATOR_RX = 129,                     // "OPERATOR_RX"
-        S_OPERATOR_RX_GLOBAL = 130,              // "OPERATOR_RX_GLOBAL"
-        S_OPERATOR_STR_EQ = 131,                 // "OPERATOR_STR_EQ"
-        S_OPERATOR_STR_MATCH = 132,              // "OPERATOR_STR_MATCH"
-        S_OPERATOR_UNCONDITIONAL_MATCH = 133,    // "OPERATOR_UNCONDITIONAL_MATCH"
-        S_OPERATOR_VALIDATE_BYTE_RANGE = 134,    // "OPERATOR_VALIDATE_BYTE_RANGE"
-        S_OPERATOR_VALIDATE_DTD = 135,           // "OPERATOR_VALIDATE_DTD"
-        S_OPERATOR_VALIDATE_HASH = 136,          // "OPERATOR_VALIDATE_HASH"
-        S_OPERATOR_VALIDATE_SCHEMA = 137,        // "OPERATOR_VALIDATE_SCHEMA"
-        S_OPERATOR_VALIDATE_URL_ENCODING = 138,  // "OPERATOR_VALIDATE_URL_ENCODING"
-        S_OPERATOR_VALIDATE_UTF8_ENCODING = 139, // "OPERATOR_VALIDATE_UTF8_ENCODING"
-        S_OPERATOR_VERIFY_CC = 140,              // "OPERATOR_VERIFY_CC"
-        S_OPERATOR_VERIFY_CPF = 141,             // "OPERATOR_VERIFY_CPF"
-        S_OPERATOR_VERIFY_SSN = 142,             // "OPERATOR_VERIFY_SSN"
-        S_OPERATOR_VERIFY_SVNR = 143,            // "OPERATOR_VERIFY_SVNR"
-        S_OPERATOR_WITHIN = 144,                 // "OPERATOR_WITHIN"
-        S_CONFIG_DIR_AUDIT_LOG_FMT = 145,        // CONFIG_DIR_AUDIT_LOG_FMT
-        S_JSON = 146,                            // JSON
-        S_NATIVE = 147,                          // NATIVE
-        S_ACTION_CTL_RULE_ENGINE = 148,          // "ACTION_CTL_RULE_ENGINE"
-        S_ACTION_ACCURACY = 149,                 // "Accuracy"
-        S_ACTION_ALLOW = 150,                    // "Allow"
-        S_ACTION_APPEND = 151,                   // "Append"
-        S_ACTION_AUDIT_LOG = 152,                // "AuditLog"
-        S_ACTION_BLOCK = 153,                    // "Block"
-        S_ACTION_CAPTURE = 154,                  // "Capture"
-        S_ACTION_CHAIN = 155,                    // "Chain"
-        S_ACTION_CTL_AUDIT_ENGINE = 156,         // "ACTION_CTL_AUDIT_ENGINE"
-        S_ACTION_CTL_AUDIT_LOG_PARTS = 157,      // "ACTION_CTL_AUDIT_LOG_PARTS"
-        S_ACTION_CTL_BDY_JSON = 158,             // "ACTION_CTL_BDY_JSON"
-        S_ACTION_CTL_BDY_XML = 159,              // "ACTION_CTL_BDY_XML"
-        S_ACTION_CTL_BDY_URLENCODED = 160,       // "ACTION_CTL_BDY_URLENCODED"
-        S_ACTION_CTL_FORCE_REQ_BODY_VAR = 161,   // "ACTION_CTL_FORCE_REQ_BODY_VAR"
-        S_ACTION_CTL_REQUEST_BODY_ACCESS = 162,  // "ACTION_CTL_REQUEST_BODY_ACCESS"
-        S_ACTION_CTL_RULE_REMOVE_BY_ID = 163,    // "ACTION_CTL_RULE_REMOVE_BY_ID"
-        S_ACTION_CTL_RULE_REMOVE_BY_TAG = 164,   // "ACTION_CTL_RULE_REMOVE_BY_TAG"
-        S_ACTION_CTL_RULE_REMOVE_TARGET_BY_ID = 165, // "ACTION_CTL_RULE_REMOVE_TARGET_BY_ID"
-        S_ACTION_CTL_RULE_REMOVE_TARGET_BY_TAG = 166, // "ACTION_CTL_RULE_REMOVE_TARGET_BY_TAG"
-        S_ACTION_DENY = 167,                     // "Deny"
-        S_ACTION_DEPRECATE_VAR = 168,            // "DeprecateVar"
-        S_ACTION_DROP = 169,                     // "Drop"
-        S_ACTION_EXEC = 170,                     // "Exec"
-        S_ACTION_EXPIRE_VAR = 171,               // "ExpireVar"
-        S_ACTION_ID = 172,                       // "Id"
-        S_ACTION_INITCOL = 173,                  // "InitCol"
-        S_ACTION_LOG = 174,                      // "Log"
-        S_ACTION_LOG_DATA = 175,                 // "LogData"
-        S_ACTION_MATURITY = 176,                 // "Maturity"
-        S_ACTION_MSG = 177,                      // "Msg"
-        S_ACTION_MULTI_MATCH = 178,              // "MultiMatch"
-        S_ACTION_NO_AUDIT_LOG = 179,             // "NoAuditLog"
-        S_ACTION_NO_LOG = 180,                   // "NoLog"
-        S_ACTION_PASS = 181,                     // "Pass"
-        S_ACTION_PAUSE = 182,                    // "Pause"
-        S_ACTION_PHASE = 183,                    // "Phase"
-        S_ACTION_PREPEND = 184,                  // "Prepend"
-        S_ACTION_PROXY = 185,                    // "Proxy"
-        S_ACTION_REDIRECT = 186,                 // "Redirect"
-        S_ACTION_REV = 187,                      // "Rev"
-        S_ACTION_SANITISE_ARG = 188,             // "SanitiseArg"
-        S_ACTION_SANITISE_MATCHED = 189,         // "SanitiseMatched"
-        S_ACTION_SANITISE_MATCHED_BYTES = 190,   // "SanitiseMatchedBytes"
-        S_ACTION_SANITISE_REQUEST_HEADER = 191,  // "SanitiseRequestHeader"
-        S_ACTION_SANITISE_RESPONSE_HEADER = 192, // "SanitiseResponseHeader"
-        S_ACTION_SETENV = 193,                   // "SetEnv"
-        S_ACTION_SETRSC = 194,                   // "SetRsc"
-        S_ACTION_SETSID = 195,                   // "SetSid"
-        S_ACTION_SETUID = 196,                   // "SetUID"
-        S_ACTION_SEVERITY = 197,                 // "Severity"
-        S_ACTION_SKIP = 198,                     // "Skip"
-        S_ACTION_SKIP_AFTER = 199,               // "SkipAfter"
-        S_ACTION_STATUS = 200,                   // "Status"
-        S_ACTION_TAG = 201,                      // "Tag"
-        S_ACTION_TRANSFORMATION_BASE_64_ENCODE = 202, // "ACTION_TRANSFORMATION_BASE_64_ENCODE"
-        S_ACTION_TRANSFORMATION_BASE_64_DECODE = 203, // "ACTION_TRANSFORMATION_BASE_64_DECODE"
-        S_ACTION_TRANSFORMATION_BASE_64_DECODE_EXT = 204, // "ACTION_TRANSFORMATION_BASE_64_DECODE_EXT"
-        S_ACTION_TRANSFORMATION_CMD_LINE = 205,  // "ACTION_TRANSFORMATION_CMD_LINE"
-        S_ACTION_TRANSFORMATION_COMPRESS_WHITESPACE = 206, // "ACTION_TRANSFORMATION_COMPRESS_WHITESPACE"
-        S_ACTION_TRANSFORMATION_CSS_DECODE = 207, // "ACTION_TRANSFORMATION_CSS_DECODE"
-        S_ACTION_TRANSFORMATION_ESCAPE_SEQ_DECODE = 208, // "ACTION_TRANSFORMATION_ESCAPE_SEQ_DECODE"
-        S_ACTION_TRANSFORMATION_HEX_ENCODE = 209, // "ACTION_TRANSFORMATION_HEX_ENCODE"
-        S_ACTION_TRANSFORMATION_HEX_DECODE = 210, // "ACTION_TRANSFORMATION_HEX_DECODE"
-        S_ACTION_TRANSFORMATION_HTML_ENTITY_DECODE = 211, // "ACTION_TRANSFORMATION_HTML_ENTITY_DECODE"
-        S_ACTION_TRANSFORMATION_JS_DECODE = 212, // "ACTION_TRANSFORMATION_JS_DECODE"
-        S_ACTION_TRANSFORMATION_LENGTH = 213,    // "ACTION_TRANSFORMATION_LENGTH"
-        S_ACTION_TRANSFORMATION_LOWERCASE = 214, // "ACTION_TRANSFORMATION_LOWERCASE"
-        S_ACTION_TRANSFORMATION_MD5 = 215,       // "ACTION_TRANSFORMATION_MD5"
-        S_ACTION_TRANSFORMATION_NONE = 216,      // "ACTION_TRANSFORMATION_NONE"
-        S_ACTION_TRANSFORMATION_NORMALISE_PATH = 217, // "ACTION_TRANSFORMATION_NORMALISE_PATH"
-        S_ACTION_TRANSFORMATION_NORMALISE_PATH_WIN = 218, // "ACTION_TRANSFORMATION_NORMALISE_PATH_WIN"
-        S_ACTION_TRANSFORMATION_PARITY_EVEN_7_BIT = 219, // "ACTION_TRANSFORMATION_PARITY_EVEN_7_BIT"
-        S_ACTION_TRANSFORMATION_PARITY_ODD_7_BIT = 220, // "ACTION_TRANSFORMATION_PARITY_ODD_7_BIT"
-        S_ACTION_TRANSFORMATION_PARITY_ZERO_7_BIT = 221, // "ACTION_TRANSFORMATION_PARITY_ZERO_7_BIT"
-        S_ACTION_TRANSFORMATION_REMOVE_COMMENTS = 222, // "ACTION_TRANSFORMATION_REMOVE_COMMENTS"
-        S_ACTION_TRANSFORMATION_REMOVE_COMMENTS_CHAR = 223, // "ACTION_TRANSFORMATION_REMOVE_COMMENTS_CHAR"
-        S_ACTION_TRANSFORMATION_REMOVE_NULLS = 224, // "ACTION_TRANSFORMATION_REMOVE_NULLS"
-        S_ACTION_TRANSFORMATION_REMOVE_WHITESPACE = 225, // "ACTION_TRANSFORMATION_REMOVE_WHITESPACE"
-        S_ACTION_TRANSFORMATION_REPLACE_COMMENTS = 226, // "ACTION_TRANSFORMATION_REPLACE_COMMENTS"
-        S_ACTION_TRANSFORMATION_REPLACE_NULLS = 227, // "ACTION_TRANSFORMATION_REPLACE_NULLS"
-        S_ACTION_TRANSFORMATION_SHA1 = 228,      // "ACTION_TRANSFORMATION_SHA1"
-        S_ACTION_TRANSFORMATION_SQL_HEX_DECODE = 229, // "ACTION_TRANSFORMATION_SQL_HEX_DECODE"
-        S_ACTION_TRANSFORMATION_TRIM = 230,      // "ACTION_TRANSFORMATION_TRIM"
-        S_ACTION_TRANSFORMATION_TRIM_LEFT = 231, // "ACTION_TRANSFORMATION_TRIM_LEFT"
-        S_ACTION_TRANSFORMATION_TRIM_RIGHT = 232, // "ACTION_TRANSFORMATION_TRIM_RIGHT"
-        S_ACTION_TRANSFORMATION_UPPERCASE = 233, // "ACTION_TRANSFORMATION_UPPERCASE"
-        S_ACTION_TRANSFORMATION_URL_ENCODE = 234, // "ACTION_TRANSFORMATION_URL_ENCODE"
-        S_ACTION_TRANSFORMATION_URL_DECODE = 235, // "ACTION_TRANSFORMATION_URL_DECODE"
-        S_ACTION_TRANSFORMATION_URL_DECODE_UNI = 236, // "ACTION_TRANSFORMATION_URL_DECODE_UNI"
-        S_ACTION_TRANSFORMATION_UTF8_TO_UNICODE = 237, // "ACTION_TRANSFORMATION_UTF8_TO_UNICODE"
-        S_ACTION_VER = 238,                      // "Ver"
-        S_ACTION_XMLNS = 239,                    // "xmlns"
-        S_CONFIG_COMPONENT_SIG = 240,            // "CONFIG_COMPONENT_SIG"
-        S_CONFIG_CONN_ENGINE = 241,              // "CONFIG_CONN_ENGINE"
-        S_CONFIG_SEC_ARGUMENT_SEPARATOR = 242,   // "CONFIG_SEC_ARGUMENT_SEPARATOR"
-        S_CONFIG_SEC_WEB_APP_ID = 243,           // "CONFIG_SEC_WEB_APP_ID"
-        S_CONFIG_SEC_SERVER_SIG = 244,           // "CONFIG_SEC_SERVER_SIG"
-        S_CONFIG_DIR_AUDIT_DIR = 245,            // "CONFIG_DIR_AUDIT_DIR"
-        S_CONFIG_DIR_AUDIT_DIR_MOD = 246,        // "CONFIG_DIR_AUDIT_DIR_MOD"
-        S_CONFIG_DIR_AUDIT_ENG = 247,            // "CONFIG_DIR_AUDIT_ENG"
-        S_CONFIG_DIR_AUDIT_FLE_MOD = 248,        // "CONFIG_DIR_AUDIT_FLE_MOD"
-        S_CONFIG_DIR_AUDIT_LOG = 249,            // "CONFIG_DIR_AUDIT_LOG"
-        S_CONFIG_DIR_AUDIT_LOG2 = 250,           // "CONFIG_DIR_AUDIT_LOG2"
-        S_CONFIG_DIR_AUDIT_LOG_P = 251,          // "CONFIG_DIR_AUDIT_LOG_P"
-        S_CONFIG_DIR_AUDIT_STS = 252,            // "CONFIG_DIR_AUDIT_STS"
-        S_CONFIG_DIR_AUDIT_TPE = 253,            // "CONFIG_DIR_AUDIT_TPE"
-        S_CONFIG_DIR_DEBUG_LOG = 254,            // "CONFIG_DIR_DEBUG_LOG"
-        S_CONFIG_DIR_DEBUG_LVL = 255,            // "CONFIG_DIR_DEBUG_LVL"
-        S_CONFIG_SEC_CACHE_TRANSFORMATIONS = 256, // "CONFIG_SEC_CACHE_TRANSFORMATIONS"
-        S_CONFIG_SEC_DISABLE_BACKEND_COMPRESS = 257, // "CONFIG_SEC_DISABLE_BACKEND_COMPRESS"
-        S_CONFIG_SEC_HASH_ENGINE = 258,          // "CONFIG_SEC_HASH_ENGINE"
-        S_CONFIG_SEC_HASH_KEY = 259,             // "CONFIG_SEC_HASH_KEY"
-        S_CONFIG_SEC_HASH_PARAM = 260,           // "CONFIG_SEC_HASH_PARAM"
-        S_CONFIG_SEC_HASH_METHOD_RX = 261,       // "CONFIG_SEC_HASH_METHOD_RX"
-        S_CONFIG_SEC_HASH_METHOD_PM = 262,       // "CONFIG_SEC_HASH_METHOD_PM"
-        S_CONFIG_SEC_CHROOT_DIR = 263,           // "CONFIG_SEC_CHROOT_DIR"
-        S_CONFIG_DIR_GEO_DB = 264,               // "CONFIG_DIR_GEO_DB"
-        S_CONFIG_DIR_GSB_DB = 265,               // "CONFIG_DIR_GSB_DB"
-        S_CONFIG_SEC_GUARDIAN_LOG = 266,         // "CONFIG_SEC_GUARDIAN_LOG"
-        S_CONFIG_DIR_PCRE_MATCH_LIMIT = 267,     // "CONFIG_DIR_PCRE_MATCH_LIMIT"
-        S_CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION = 268, // "CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION"
-        S_CONFIG_SEC_CONN_R_STATE_LIMIT = 269,   // "CONFIG_SEC_CONN_R_STATE_LIMIT"
-        S_CONFIG_SEC_CONN_W_STATE_LIMIT = 270,   // "CONFIG_SEC_CONN_W_STATE_LIMIT"
-        S_CONFIG_SEC_SENSOR_ID = 271,            // "CONFIG_SEC_SENSOR_ID"
-        S_CONFIG_DIR_ARGS_LIMIT = 272,           // "CONFIG_DIR_ARGS_LIMIT"
-        S_CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT = 273, // "CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT"
-        S_CONFIG_DIR_REQ_BODY = 274,             // "CONFIG_DIR_REQ_BODY"
-        S_CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT = 275, // "CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT"
-        S_CONFIG_DIR_REQ_BODY_LIMIT = 276,       // "CONFIG_DIR_REQ_BODY_LIMIT"
-        S_CONFIG_DIR_REQ_BODY_LIMIT_ACTION = 277, // "CONFIG_DIR_REQ_BODY_LIMIT_ACTION"
-        S_CONFIG_DIR_REQ_BODY_NO_FILES_LIMIT = 278, // "CONFIG_DIR_REQ_BODY_NO_FILES_LIMIT"
-        S_CONFIG_DIR_RES_BODY = 279,             // "CONFIG_DIR_RES_BODY"
-        S_CONFIG_DIR_RES_BODY_LIMIT = 280,       // "CONFIG_DIR_RES_BODY_LIMIT"
-        S_CONFIG_DIR_RES_BODY_LIMIT_ACTION = 281, // "CONFIG_DIR_RES_BODY_LIMIT_ACTION"
-        S_CONFIG_SEC_RULE_INHERITANCE = 282,     // "CONFIG_SEC_RULE_INHERITANCE"
-        S_CONFIG_SEC_RULE_PERF_TIME = 283,       // "CONFIG_SEC_RULE_PERF_TIME"
-        S_CONFIG_DIR_RULE_ENG = 284,             // "CONFIG_DIR_RULE_ENG"
-        S_CONFIG_DIR_SEC_ACTION = 285,           // "CONFIG_DIR_SEC_ACTION"
-        S_CONFIG_DIR_SEC_DEFAULT_ACTION = 286,   // "CONFIG_DIR_SEC_DEFAULT_ACTION"
-        S_CONFIG_DIR_SEC_MARKER = 287,           // "CONFIG_DIR_SEC_MARKER"
-        S_CONFIG_DIR_UNICODE_MAP_FILE = 288,     // "CONFIG_DIR_UNICODE_MAP_FILE"
-        S_CONFIG_DIR_UNICODE_CODE_PAGE = 289,    // "CONFIG_DIR_UNICODE_CODE_PAGE"
-        S_CONFIG_SEC_COLLECTION_TIMEOUT = 290,   // "CONFIG_SEC_COLLECTION_TIMEOUT"
-        S_CONFIG_SEC_HTTP_BLKEY = 291,           // "CONFIG_SEC_HTTP_BLKEY"
-        S_CONFIG_SEC_INTERCEPT_ON_ERROR = 292,   // "CONFIG_SEC_INTERCEPT_ON_ERROR"
-        S_CONFIG_SEC_REMOTE_RULES_FAIL_ACTION = 293, // "CONFIG_SEC_REMOTE_RULES_FAIL_ACTION"
-        S_CONFIG_SEC_RULE_REMOVE_BY_ID = 294,    // "CONFIG_SEC_RULE_REMOVE_BY_ID"
-        S_CONFIG_SEC_RULE_REMOVE_BY_MSG = 295,   // "CONFIG_SEC_RULE_REMOVE_BY_MSG"
-        S_CONFIG_SEC_RULE_REMOVE_BY_TAG = 296,   // "CONFIG_SEC_RULE_REMOVE_BY_TAG"
-        S_CONFIG_SEC_RULE_UPDATE_TARGET_BY_TAG = 297, // "CONFIG_SEC_RULE_UPDATE_TARGET_BY_TAG"
-        S_CONFIG_SEC_RULE_UPDATE_TARGET_BY_MSG = 298, // "CONFIG_SEC_RULE_UPDATE_TARGET_BY_MSG"
-        S_CONFIG_SEC_RULE_UPDATE_TARGET_BY_ID = 299, // "CONFIG_SEC_RULE_UPDATE_TARGET_BY_ID"
-        S_CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID = 300, // "CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID"
-        S_CONFIG_UPDLOAD_KEEP_FILES = 301,       // "CONFIG_UPDLOAD_KEEP_FILES"
-        S_CONFIG_UPDLOAD_SAVE_TMP_FILES = 302,   // "CONFIG_UPDLOAD_SAVE_TMP_FILES"
-        S_CONFIG_UPLOAD_DIR = 303,               // "CONFIG_UPLOAD_DIR"
-        S_CONFIG_UPLOAD_FILE_LIMIT = 304,        // "CONFIG_UPLOAD_FILE_LIMIT"
-        S_CONFIG_UPLOAD_FILE_MODE = 305,         // "CONFIG_UPLOAD_FILE_MODE"
-        S_CONFIG_VALUE_ABORT = 306,              // "CONFIG_VALUE_ABORT"
-        S_CONFIG_VALUE_DETC = 307,               // "CONFIG_VALUE_DETC"
-        S_CONFIG_VALUE_HTTPS = 308,              // "CONFIG_VALUE_HTTPS"
-        S_CONFIG_VALUE_OFF = 309,                // "CONFIG_VALUE_OFF"
-        S_CONFIG_VALUE_ON = 310,                 // "CONFIG_VALUE_ON"
-        S_CONFIG_VALUE_PARALLEL = 311,           // "CONFIG_VALUE_PARALLEL"
-        S_CONFIG_VALUE_PROCESS_PARTIAL = 312,    // "CONFIG_VALUE_PROCESS_PARTIAL"
-        S_CONFIG_VALUE_REJECT = 313,             // "CONFIG_VALUE_REJECT"
-        S_CONFIG_VALUE_RELEVANT_ONLY = 314,      // "CONFIG_VALUE_RELEVANT_ONLY"
-        S_CONFIG_VALUE_SERIAL = 315,             // "CONFIG_VALUE_SERIAL"
-        S_CONFIG_VALUE_WARN = 316,               // "CONFIG_VALUE_WARN"
-        S_CONFIG_XML_EXTERNAL_ENTITY = 317,      // "CONFIG_XML_EXTERNAL_ENTITY"
-        S_CONGIG_DIR_RESPONSE_BODY_MP = 318,     // "CONGIG_DIR_RESPONSE_BODY_MP"
-        S_CONGIG_DIR_SEC_ARG_SEP = 319,          // "CONGIG_DIR_SEC_ARG_SEP"
-        S_CONGIG_DIR_SEC_COOKIE_FORMAT = 320,    // "CONGIG_DIR_SEC_COOKIE_FORMAT"
-        S_CONFIG_SEC_COOKIEV0_SEPARATOR = 321,   // "CONFIG_SEC_COOKIEV0_SEPARATOR"
-        S_CONGIG_DIR_SEC_DATA_DIR = 322,         // "CONGIG_DIR_SEC_DATA_DIR"
-        S_CONGIG_DIR_SEC_STATUS_ENGINE = 323,    // "CONGIG_DIR_SEC_STATUS_ENGINE"
-        S_CONFIG_SEC_STREAM_IN_BODY_INSPECTION = 324, // "CONFIG_SEC_STREAM_IN_BODY_INSPECTION"
-        S_CONFIG_SEC_STREAM_OUT_BODY_INSPECTION = 325, // "CONFIG_SEC_STREAM_OUT_BODY_INSPECTION"
-        S_CONGIG_DIR_SEC_TMP_DIR = 326,          // "CONGIG_DIR_SEC_TMP_DIR"
-        S_DIRECTIVE = 327,                       // "DIRECTIVE"
-        S_DIRECTIVE_SECRULESCRIPT = 328,         // "DIRECTIVE_SECRULESCRIPT"
-        S_FREE_TEXT_QUOTE_MACRO_EXPANSION = 329, // "FREE_TEXT_QUOTE_MACRO_EXPANSION"
-        S_QUOTATION_MARK = 330,                  // "QUOTATION_MARK"
-        S_RUN_TIME_VAR_BLD = 331,                // "RUN_TIME_VAR_BLD"
-        S_RUN_TIME_VAR_DUR = 332,                // "RUN_TIME_VAR_DUR"
-        S_RUN_TIME_VAR_HSV = 333,                // "RUN_TIME_VAR_HSV"
-        S_RUN_TIME_VAR_REMOTE_USER = 334,        // "RUN_TIME_VAR_REMOTE_USER"
-        S_RUN_TIME_VAR_TIME = 335,               // "RUN_TIME_VAR_TIME"
-        S_RUN_TIME_VAR_TIME_DAY = 336,           // "RUN_TIME_VAR_TIME_DAY"
-        S_RUN_TIME_VAR_TIME_EPOCH = 337,         // "RUN_TIME_VAR_TIME_EPOCH"
-        S_RUN_TIME_VAR_TIME_HOUR = 338,          // "RUN_TIME_VAR_TIME_HOUR"
-        S_RUN_TIME_VAR_TIME_MIN = 339,           // "RUN_TIME_VAR_TIME_MIN"
-        S_RUN_TIME_VAR_TIME_MON = 340,           // "RUN_TIME_VAR_TIME_MON"
-        S_RUN_TIME_VAR_TIME_SEC = 341,           // "RUN_TIME_VAR_TIME_SEC"
-        S_RUN_TIME_VAR_TIME_WDAY = 342,          // "RUN_TIME_VAR_TIME_WDAY"
-        S_RUN_TIME_VAR_TIME_YEAR = 343,          // "RUN_TIME_VAR_TIME_YEAR"
-        S_VARIABLE = 344,                        // "VARIABLE"
-        S_DICT_ELEMENT = 345,                    // "Dictionary element"
-        S_DICT_ELEMENT_WITH_EQUALS = 346,        // "Dictionary element, with equals"
-        S_DICT_ELEMENT_REGEXP = 347,             // "Dictionary element, selected by regexp"
-        S_YYACCEPT = 348,                        // $accept
-        S_input = 349,                           // input
-        S_line = 350,                            // line
-        S_audit_log = 351,                       // audit_log
-        S_actions = 352,                         // actions
-        S_actions_may_quoted = 353,              // actions_may_quoted
-        S_op = 354,                              // op
-        S_op_before_init = 355,                  // op_before_init
-        S_expression = 356,                      // expression
-        S_variables = 357,                       // variables
-        S_variables_pre_process = 358,           // variables_pre_process
-        S_variables_may_be_quoted = 359,         // variables_may_be_quoted
-        S_var = 360,                             // var
-        S_act = 361,                             // act
-        S_setvar_action = 362,                   // setvar_action
-        S_run_time_string = 363                  // run_time_string
+        S_VARIABLE_MSC_MEMORY_LIMIT_EXCEEDED = 42, // "MSC_MEMORY_LIMIT_EXCEEDED"
+        S_VARIABLE_MSC_TIME_BUDGET_EXCEEDED = 43, // "MSC_TIME_BUDGET_EXCEEDED"
+        S_VARIABLE_MULTIPART_BOUNDARY_QUOTED = 44, // VARIABLE_MULTIPART_BOUNDARY_QUOTED
+        S_VARIABLE_MULTIPART_BOUNDARY_WHITESPACE = 45, // VARIABLE_MULTIPART_BOUNDARY_WHITESPACE
+        S_VARIABLE_MULTIPART_CRLF_LF_LINES = 46, // "MULTIPART_CRLF_LF_LINES"
+        S_VARIABLE_MULTIPART_DATA_AFTER = 47,    // "MULTIPART_DATA_AFTER"
+        S_VARIABLE_MULTIPART_DATA_BEFORE = 48,   // VARIABLE_MULTIPART_DATA_BEFORE
+        S_VARIABLE_MULTIPART_FILE_LIMIT_EXCEEDED = 49, // "MULTIPART_FILE_LIMIT_EXCEEDED"
+        S_VARIABLE_MULTIPART_HEADER_FOLDING = 50, // "MULTIPART_HEADER_FOLDING"
+        S_VARIABLE_MULTIPART_INVALID_HEADER_FOLDING = 51, // "MULTIPART_INVALID_HEADER_FOLDING"
+        S_VARIABLE_MULTIPART_INVALID_PART = 52,  // VARIABLE_MULTIPART_INVALID_PART
+        S_VARIABLE_MULTIPART_INVALID_QUOTING = 53, // "MULTIPART_INVALID_QUOTING"
+        S_VARIABLE_MULTIPART_LF_LINE = 54,       // VARIABLE_MULTIPART_LF_LINE
+        S_VARIABLE_MULTIPART_MISSING_SEMICOLON = 55, // VARIABLE_MULTIPART_MISSING_SEMICOLON
+        S_VARIABLE_MULTIPART_SEMICOLON_MISSING = 56, // VARIABLE_MULTIPART_SEMICOLON_MISSING
+        S_VARIABLE_MULTIPART_STRICT_ERROR = 57,  // "MULTIPART_STRICT_ERROR"
+        S_VARIABLE_MULTIPART_UNMATCHED_BOUNDARY = 58, // "MULTIPART_UNMATCHED_BOUNDARY"
+        S_VARIABLE_OUTBOUND_DATA_ERROR = 59,     // "OUTBOUND_DATA_ERROR"
+        S_VARIABLE_PATH_INFO = 60,               // "PATH_INFO"
+        S_VARIABLE_QUERY_STRING = 61,            // "QUERY_STRING"
+        S_VARIABLE_REMOTE_ADDR = 62,             // "REMOTE_ADDR"
+        S_VARIABLE_REMOTE_HOST = 63,             // "REMOTE_HOST"
+        S_VARIABLE_REMOTE_PORT = 64,             // "REMOTE_PORT"
+        S_VARIABLE_REQBODY_ERROR_MSG = 65,       // "REQBODY_ERROR_MSG"
+        S_VARIABLE_REQBODY_ERROR = 66,           // "REQBODY_ERROR"
+        S_VARIABLE_REQBODY_PROCESSOR_ERROR_MSG = 67, // "REQBODY_PROCESSOR_ERROR_MSG"
+        S_VARIABLE_REQBODY_PROCESSOR_ERROR = 68, // "REQBODY_PROCESSOR_ERROR"
+        S_VARIABLE_REQBODY_PROCESSOR = 69,       // "REQBODY_PROCESSOR"
+        S_VARIABLE_REQUEST_BASENAME = 70,        // "REQUEST_BASENAME"
+        S_VARIABLE_REQUEST_BODY_LENGTH = 71,     // "REQUEST_BODY_LENGTH"
+        S_VARIABLE_REQUEST_BODY = 72,            // "REQUEST_BODY"
+        S_VARIABLE_REQUEST_FILE_NAME = 73,       // "REQUEST_FILENAME"
+        S_VARIABLE_REQUEST_HEADERS_NAMES = 74,   // VARIABLE_REQUEST_HEADERS_NAMES
+        S_VARIABLE_REQUEST_LINE = 75,            // "REQUEST_LINE"
+        S_VARIABLE_REQUEST_METHOD = 76,          // "REQUEST_METHOD"
+        S_VARIABLE_REQUEST_PROTOCOL = 77,        // "REQUEST_PROTOCOL"
+        S_VARIABLE_REQUEST_URI_RAW = 78,         // "REQUEST_URI_RAW"
+        S_VARIABLE_REQUEST_URI = 79,             // "REQUEST_URI"
+        S_VARIABLE_RESOURCE = 80,                // "RESOURCE"
+        S_VARIABLE_RESPONSE_BODY = 81,           // "RESPONSE_BODY"
+        S_VARIABLE_RESPONSE_CONTENT_LENGTH = 82, // "RESPONSE_CONTENT_LENGTH"
+        S_VARIABLE_RESPONSE_CONTENT_TYPE = 83,   // VARIABLE_RESPONSE_CONTENT_TYPE
+        S_VARIABLE_RESPONSE_HEADERS_NAMES = 84,  // VARIABLE_RESPONSE_HEADERS_NAMES
+        S_VARIABLE_RESPONSE_PROTOCOL = 85,       // "RESPONSE_PROTOCOL"
+        S_VARIABLE_RESPONSE_STATUS = 86,         // "RESPONSE_STATUS"
+        S_VARIABLE_SERVER_ADDR = 87,             // "SERVER_ADDR"
+        S_VARIABLE_SERVER_NAME = 88,             // "SERVER_NAME"
+        S_VARIABLE_SERVER_PORT = 89,             // "SERVER_PORT"
+        S_VARIABLE_SESSION_ID = 90,              // "SESSIONID"
+        S_VARIABLE_UNIQUE_ID = 91,               // "UNIQUE_ID"
+        S_VARIABLE_URL_ENCODED_ERROR = 92,       // "URLENCODED_ERROR"
+        S_VARIABLE_USER_ID = 93,                 // "USERID"
+        S_VARIABLE_WEB_APP_ID = 94,              // "WEBAPPID"
+        S_VARIABLE_STATUS = 95,                  // "VARIABLE_STATUS"
+        S_VARIABLE_STATUS_LINE = 96,             // "VARIABLE_STATUS_LINE"
+        S_VARIABLE_IP = 97,                      // "VARIABLE_IP"
+        S_VARIABLE_GLOBAL = 98,                  // "VARIABLE_GLOBAL"
+        S_VARIABLE_TX = 99,                      // "VARIABLE_TX"
+        S_VARIABLE_SESSION = 100,                // "VARIABLE_SESSION"
+        S_VARIABLE_USER = 101,                   // "VARIABLE_USER"
+        S_RUN_TIME_VAR_ENV = 102,                // "RUN_TIME_VAR_ENV"
+        S_RUN_TIME_VAR_XML = 103,                // "RUN_TIME_VAR_XML"
+        S_ACTION_SETVAR = 104,                   // "SetVar"
+        S_SETVAR_OPERATION_EQUALS = 105,         // SETVAR_OPERATION_EQUALS
+        S_SETVAR_OPERATION_EQUALS_PLUS = 106,    // SETVAR_OPERATION_EQUALS_PLUS
+        S_SETVAR_OPERATION_EQUALS_MINUS = 107,   // SETVAR_OPERATION_EQUALS_MINUS
+        S_NOT = 108,                             // "NOT"
+        S_OPERATOR_BEGINS_WITH = 109,            // "OPERATOR_BEGINS_WITH"
+        S_OPERATOR_CONTAINS = 110,               // "OPERATOR_CONTAINS"
+        S_OPERATOR_CONTAINS_WORD = 111,          // "OPERATOR_CONTAINS_WORD"
+        S_OPERATOR_DETECT_SQLI = 112,            // "OPERATOR_DETECT_SQLI"
+        S_OPERATOR_DETECT_XSS = 113,             // "OPERATOR_DETECT_XSS"
+        S_OPERATOR_ENDS_WITH = 114,              // "OPERATOR_ENDS_WITH"
+        S_OPERATOR_EQ = 115,                     // "OPERATOR_EQ"
+        S_OPERATOR_FUZZY_HASH = 116,             // "OPERATOR_FUZZY_HASH"
+        S_OPERATOR_GEOLOOKUP = 117,              // "OPERATOR_GEOLOOKUP"
+        S_OPERATOR_GE = 118,                     // "OPERATOR_GE"
+        S_OPERATOR_GSB_LOOKUP = 119,             // "OPERATOR_GSB_LOOKUP"
+        S_OPERATOR_GT = 120,                     // "OPERATOR_GT"
+        S_OPERATOR_INSPECT_FILE = 121,           // "OPERATOR_INSPECT_FILE"
+        S_OPERATOR_IP_MATCH_FROM_FILE = 122,     // "OPERATOR_IP_MATCH_FROM_FILE"
+        S_OPERATOR_IP_MATCH = 123,               // "OPERATOR_IP_MATCH"
+        S_OPERATOR_LE = 124,                     // "OPERATOR_LE"
+        S_OPERATOR_LT = 125,                     // "OPERATOR_LT"
+        S_OPERATOR_PM_FROM_FILE = 126,           // "OPERATOR_PM_FROM_FILE"
+        S_OPERATOR_PM = 127,                     // "OPERATOR_PM"
+        S_OPERATOR_RBL = 128,                    // "OPERATOR_RBL"
+        S_OPERATOR_RSUB = 129,                   // "OPERATOR_RSUB"
+        S_OPERATOR_RX_CONTENT_ONLY = 130,        // "Operator RX (content only)"
+        S_OPERATOR_RX = 131,                     // "OPERATOR_RX"
+        S_OPERATOR_RX_GLOBAL = 132,              // "OPERATOR_RX_GLOBAL"
+        S_OPERATOR_STR_EQ = 133,                 // "OPERATOR_STR_EQ"
+        S_OPERATOR_STR_MATCH = 134,              // "OPERATOR_STR_MATCH"
+        S_OPERATOR_UNCONDITIONAL_MATCH = 135,    // "OPERATOR_UNCONDITIONAL_MATCH"
+        S_OPERATOR_VALIDATE_BYTE_RANGE = 136,    // "OPERATOR_VALIDATE_BYTE_RANGE"
+        S_OPERATOR_VALIDATE_DTD = 137,           // "OPERATOR_VALIDATE_DTD"
+        S_OPERATOR_VALIDATE_HASH = 138,          // "OPERATOR_VALIDATE_HASH"
+        S_OPERATOR_VALIDATE_SCHEMA = 139,        // "OPERATOR_VALIDATE_SCHEMA"
+        S_OPERATOR_VALIDATE_URL_ENCODING = 140,  // "OPERATOR_VALIDATE_URL_ENCODING"
+        S_OPERATOR_VALIDATE_UTF8_ENCODING = 141, // "OPERATOR_VALIDATE_UTF8_ENCODING"
+        S_OPERATOR_VERIFY_CC = 142,              // "OPERATOR_VERIFY_CC"
+        S_OPERATOR_VERIFY_CPF = 143,             // "OPERATOR_VERIFY_CPF"
+        S_OPERATOR_VERIFY_SSN = 144,             // "OPERATOR_VERIFY_SSN"
+        S_OPERATOR_VERIFY_SVNR = 145,            // "OPERATOR_VERIFY_SVNR"
+        S_OPERATOR_WITHIN = 146,                 // "OPERATOR_WITHIN"
+        S_CONFIG_DIR_AUDIT_LOG_FMT = 147,        // CONFIG_DIR_AUDIT_LOG_FMT
+        S_JSON = 148,                            // JSON
+        S_MSGPACK = 149,                         // MSGPACK
+        S_NATIVE = 150,                          // NATIVE
+        S_ACTION_CTL_RULE_ENGINE = 151,          // "ACTION_CTL_RULE_ENGINE"
+        S_ACTION_ACCURACY = 152,                 // "Accuracy"
+        S_ACTION_ALLOW = 153,                    // "Allow"
+        S_ACTION_APPEND = 154,                   // "Append"
+        S_ACTION_AUDIT_LOG = 155,                // "AuditLog"
+        S_ACTION_BLOCK = 156,                    // "Block"
+        S_ACTION_CAPTURE = 157,                  // "Capture"
+        S_ACTION_CHAIN = 158,                    // "Chain"
+        S_ACTION_CTL_AUDIT_ENGINE = 159,         // "ACTION_CTL_AUDIT_ENGINE"
+        S_ACTION_CTL_AUDIT_LOG_PARTS = 160,      // "ACTION_CTL_AUDIT_LOG_PARTS"
+        S_ACTION_CTL_BDY_GRPC = 161,             // "ACTION_CTL_BDY_GRPC"
+        S_ACTION_CTL_BDY_JSON = 162,             // "ACTION_CTL_BDY_JSON"
+        S_ACTION_CTL_BDY_XML = 163,              // "ACTION_CTL_BDY_XML"
+        S_ACTION_CTL_BDY_URLENCODED = 164,       // "ACTION_CTL_BDY_URLENCODED"
+        S_ACTION_CTL_FORCE_REQ_BODY_VAR = 165,   // "ACTION_CTL_FORCE_REQ_BODY_VAR"
+        S_ACTION_CTL_REQUEST_BODY_ACCESS = 166,  // "ACTION_CTL_REQUEST_BODY_ACCESS"
+        S_ACTION_CTL_RULE_REMOVE_BY_ID = 167,    // "ACTION_CTL_RULE_REMOVE_BY_ID"
+        S_ACTION_CTL_RULE_REMOVE_BY_TAG = 168,   // "ACTION_CTL_RULE_REMOVE_BY_TAG"
+        S_ACTION_CTL_RULE_REMOVE_TARGET_BY_ID = 169, // "ACTION_CTL_RULE_REMOVE_TARGET_BY_ID"
+        S_ACTION_CTL_RULE_REMOVE_TARGET_BY_TAG = 170, // "ACTION_CTL_RULE_REMOVE_TARGET_BY_TAG"
+        S_ACTION_DENY = 171,                     // "Deny"
+        S_ACTION_DEPRECATE_VAR = 172,            // "DeprecateVar"
+        S_ACTION_DROP = 173,                     // "Drop"
+        S_ACTION_EXEC = 174,                     // "Exec"
+        S_ACTION_EXPIRE_VAR = 175,               // "ExpireVar"
+        S_ACTION_ID = 176,                       // "Id"
+        S_ACTION_INITCOL = 177,                  // "InitCol"
+        S_ACTION_LOG = 178,                      // "Log"
+        S_ACTION_LOG_DATA = 179,                 // "LogData"
+        S_ACTION_MATURITY = 180,                 // "Maturity"
+        S_ACTION_MSG = 181,                      // "Msg"
+        S_ACTION_MULTI_MATCH = 182,              // "MultiMatch"
+        S_ACTION_NO_AUDIT_LOG = 183,             // "NoAuditLog"
+        S_ACTION_NO_LOG = 184,                   // "NoLog"
+        S_ACTION_NO_VERDICT_CACHE = 185,         // "NoVerdictCache"
+        S_ACTION_PASS = 186,                     // "Pass"
+        S_ACTION_PAUSE = 187,                    // "Pause"
+        S_ACTION_PHASE = 188,                    // "Phase"
+        S_ACTION_PREPEND = 189,                  // "Prepend"
+        S_ACTION_PROXY = 190,                    // "Proxy"
+        S_ACTION_REDIRECT = 191,                 // "Redirect"
+        S_ACTION_REV = 192,                      // "Rev"
+        S_ACTION_SANITISE_ARG = 193,             // "SanitiseArg"
+        S_ACTION_SANITISE_MATCHED = 194,         // "SanitiseMatched"
+        S_ACTION_SANITISE_MATCHED_BYTES = 195,   // "SanitiseMatchedBytes"
+        S_ACTION_SANITISE_REQUEST_HEADER = 196,  // "SanitiseRequestHeader"
+        S_ACTION_SANITISE_RESPONSE_HEADER = 197, // "SanitiseResponseHeader"
+        S_ACTION_SETENV = 198,                   // "SetEnv"
+        S_ACTION_SETRSC = 199,                   // "SetRsc"
+        S_ACTION_SETSID = 200,                   // "SetSid"
+        S_ACTION_SETUID = 201,                   // "SetUID"
+        S_ACTION_SEVERITY = 202,                 // "Severity"
+        S_ACTION_SKIP = 203,                     // "Skip"
+        S_ACTION_SKIP_AFTER = 204,               // "SkipAfter"
+        S_ACTION_STATUS = 205,                   // "Status"
+        S_ACTION_TAG = 206,                      // "Tag"
+        S_ACTION_TRANSFORMATION_BASE_64_ENCODE = 207, // "ACTION_TRANSFORMATION_BASE_64_ENCODE"
+        S_ACTION_TRANSFORMATION_BASE_64_DECODE = 208, // "ACTION_TRANSFORMATION_BASE_64_DECODE"
+        S_ACTION_TRANSFORMATION_BASE_64_DECODE_EXT = 209, // "ACTION_TRANSFORMATION_BASE_64_DECODE_EXT"
+        S_ACTION_TRANSFORMATION_CMD_LINE = 210,  // "ACTION_TRANSFORMATION_CMD_LINE"
+        S_ACTION_TRANSFORMATION_COMPRESS_WHITESPACE = 211, // "ACTION_TRANSFORMATION_COMPRESS_WHITESPACE"
+        S_ACTION_TRANSFORMATION_CSS_DECODE = 212, // "ACTION_TRANSFORMATION_CSS_DECODE"
+        S_ACTION_TRANSFORMATION_ESCAPE_SEQ_DECODE = 213, // "ACTION_TRANSFORMATION_ESCAPE_SEQ_DECODE"
+        S_ACTION_TRANSFORMATION_HEX_ENCODE = 214, // "ACTION_TRANSFORMATION_HEX_ENCODE"
+        S_ACTION_TRANSFORMATION_HEX_DECODE = 215, // "ACTION_TRANSFORMATION_HEX_DECODE"
+        S_ACTION_TRANSFORMATION_HTML_ENTITY_DECODE = 216, // "ACTION_TRANSFORMATION_HTML_ENTITY_DECODE"
+        S_ACTION_TRANSFORMATION_JS_DECODE = 217, // "ACTION_TRANSFORMATION_JS_DECODE"
+        S_ACTION_TRANSFORMATION_LENGTH = 218,    // "ACTION_TRANSFORMATION_LENGTH"
+        S_ACTION_TRANSFORMATION_LOWERCASE = 219, // "ACTION_TRANSFORMATION_LOWERCASE"
+        S_ACTION_TRANSFORMATION_MD5 = 220,       // "ACTION_TRANSFORMATION_MD5"
+        S_ACTION_TRANSFORMATION_NONE = 221,      // "ACTION_TRANSFORMATION_NONE"
+        S_ACTION_TRANSFORMATION_NORMALISE_PATH = 222, // "ACTION_TRANSFORMATION_NORMALISE_PATH"
+        S_ACTION_TRANSFORMATION_NORMALISE_PATH_WIN = 223, // "ACTION_TRANSFORMATION_NORMALISE_PATH_WIN"
+        S_ACTION_TRANSFORMATION_PARITY_EVEN_7_BIT = 224, // "ACTION_TRANSFORMATION_PARITY_EVEN_7_BIT"
+        S_ACTION_TRANSFORMATION_PARITY_ODD_7_BIT = 225, // "ACTION_TRANSFORMATION_PARITY_ODD_7_BIT"
+        S_ACTION_TRANSFORMATION_PARITY_ZERO_7_BIT = 226, // "ACTION_TRANSFORMATION_PARITY_ZERO_7_BIT"
+        S_ACTION_TRANSFORMATION_REMOVE_COMMENTS = 227, // "ACTION_TRANSFORMATION_REMOVE_COMMENTS"
+        S_ACTION_TRANSFORMATION_REMOVE_COMMENTS_CHAR = 228, // "ACTION_TRANSFORMATION_REMOVE_COMMENTS_CHAR"
+        S_ACTION_TRANSFORMATION_REMOVE_NULLS = 229, // "ACTION_TRANSFORMATION_REMOVE_NULLS"
+        S_ACTION_TRANSFORMATION_REMOVE_WHITESPACE = 230, // "ACTION_TRANSFORMATION_REMOVE_WHITESPACE"
+        S_ACTION_TRANSFORMATION_REPLACE_COMMENTS = 231, // "ACTION_TRANSFORMATION_REPLACE_COMMENTS"
+        S_ACTION_TRANSFORMATION_REPLACE_NULLS = 232, // "ACTION_TRANSFORMATION_REPLACE_NULLS"
+        S_ACTION_TRANSFORMATION_SHA1 = 233,      // "ACTION_TRANSFORMATION_SHA1"
+        S_ACTION_TRANSFORMATION_SQL_HEX_DECODE = 234, // "ACTION_TRANSFORMATION_SQL_HEX_DECODE"
+        S_ACTION_TRANSFORMATION_TRIM = 235,      // "ACTION_TRANSFORMATION_TRIM"
+        S_ACTION_TRANSFORMATION_TRIM_LEFT = 236, // "ACTION_TRANSFORMATION_TRIM_LEFT"
+        S_ACTION_TRANSFORMATION_TRIM_RIGHT = 237, // "ACTION_TRANSFORMATION_TRIM_RIGHT"
+        S_ACTION_TRANSFORMATION_UPPERCASE = 238, // "ACTION_TRANSFORMATION_UPPERCASE"
+        S_ACTION_TRANSFORMATION_URL_ENCODE = 239, // "ACTION_TRANSFORMATION_URL_ENCODE"
+        S_ACTION_TRANSFORMATION_URL_DECODE = 240, // "ACTION_TRANSFORMATION_URL_DECODE"
+        S_ACTION_TRANSFORMATION_URL_DECODE_UNI = 241, // "ACTION_TRANSFORMATION_URL_DECODE_UNI"
+        S_ACTION_TRANSFORMATION_UTF8_TO_UNICODE = 242, // "ACTION_TRANSFORMATION_UTF8_TO_UNICODE"
+        S_ACTION_VER = 243,                      // "Ver"
+        S_ACTION_XMLNS = 244,                    // "xmlns"
+        S_CONFIG_COMPONENT_SIG = 245,            // "CONFIG_COMPONENT_SIG"
+        S_CONFIG_CONN_ENGINE = 246,              // "CONFIG_CONN_ENGINE"
+        S_CONFIG_SEC_ARGUMENT_SEPARATOR = 247,   // "CONFIG_SEC_ARGUMENT_SEPARATOR"
+        S_CONFIG_SEC_WEB_APP_ID = 248,           // "CONFIG_SEC_WEB_APP_ID"
+        S_CONFIG_SEC_SERVER_SIG = 249,           // "CONFIG_SEC_SERVER_SIG"
+        S_CONFIG_DIR_AUDIT_COMPRESSION_LEVEL = 250, // "CONFIG_DIR_AUDIT_COMPRESSION_LEVEL"
+        S_CONFIG_DIR_AUDIT_DIR = 251,            // "CONFIG_DIR_AUDIT_DIR"
+        S_CONFIG_DIR_AUDIT_DIR_MOD = 252,        // "CONFIG_DIR_AUDIT_DIR_MOD"
+        S_CONFIG_DIR_AUDIT_ENG = 253,            // "CONFIG_DIR_AUDIT_ENG"
+        S_CONFIG_DIR_AUDIT_FLE_MOD = 254,        // "CONFIG_DIR_AUDIT_FLE_MOD"
+        S_CONFIG_DIR_AUDIT_LOG = 255,            // "CONFIG_DIR_AUDIT_LOG"
+        S_CONFIG_DIR_AUDIT_LOG2 = 256,           // "CONFIG_DIR_AUDIT_LOG2"
+        S_CONFIG_DIR_AUDIT_LOG_P = 257,          // "CONFIG_DIR_AUDIT_LOG_P"
+        S_CONFIG_DIR_AUDIT_RATE_LIMIT = 258,     // "CONFIG_DIR_AUDIT_RATE_LIMIT"
+        S_CONFIG_DIR_AUDIT_STS = 259,            // "CONFIG_DIR_AUDIT_STS"
+        S_CONFIG_DIR_AUDIT_TIMINGS = 260,        // "CONFIG_DIR_AUDIT_TIMINGS"
+        S_CONFIG_DIR_AUDIT_TPE = 261,            // "CONFIG_DIR_AUDIT_TPE"
+        S_CONFIG_DIR_DEBUG_LOG = 262,            // "CONFIG_DIR_DEBUG_LOG"
+        S_CONFIG_DIR_DEBUG_LVL = 263,            // "CONFIG_DIR_DEBUG_LVL"
+        S_CONFIG_SEC_CACHE_TRANSFORMATIONS = 264, // "CONFIG_SEC_CACHE_TRANSFORMATIONS"
+        S_CONFIG_SEC_DISABLE_BACKEND_COMPRESS = 265, // "CONFIG_SEC_DISABLE_BACKEND_COMPRESS"
+        S_CONFIG_SEC_HASH_ENGINE = 266,          // "CONFIG_SEC_HASH_ENGINE"
+        S_CONFIG_SEC_HASH_KEY = 267,             // "CONFIG_SEC_HASH_KEY"
+        S_CONFIG_SEC_HASH_PARAM = 268,           // "CONFIG_SEC_HASH_PARAM"
+        S_CONFIG_SEC_HASH_METHOD_RX = 269,       // "CONFIG_SEC_HASH_METHOD_RX"
+        S_CONFIG_SEC_HASH_METHOD_PM = 270,       // "CONFIG_SEC_HASH_METHOD_PM"
+        S_CONFIG_SEC_CHROOT_DIR = 271,           // "CONFIG_SEC_CHROOT_DIR"
+        S_CONFIG_DIR_GEO_DB = 272,               // "CONFIG_DIR_GEO_DB"
+        S_CONFIG_DIR_GSB_DB = 273,               // "CONFIG_DIR_GSB_DB"
+        S_CONFIG_SEC_GUARDIAN_LOG = 274,         // "CONFIG_SEC_GUARDIAN_LOG"
+        S_CONFIG_DIR_DATA_RELOAD_INTERVAL = 275, // "CONFIG_DIR_DATA_RELOAD_INTERVAL"
+        S_CONFIG_DIR_LUA_STATE_POOL_LIMIT = 276, // "CONFIG_DIR_LUA_STATE_POOL_LIMIT"
+        S_CONFIG_DIR_OVERLOAD_DETECTION_ONLY = 277, // "CONFIG_DIR_OVERLOAD_DETECTION_ONLY"
+        S_CONFIG_DIR_OVERLOAD_SHED_TAG = 278,    // "CONFIG_DIR_OVERLOAD_SHED_TAG"
+        S_CONFIG_DIR_OVERLOAD_TARGET = 279,      // "CONFIG_DIR_OVERLOAD_TARGET"
+        S_CONFIG_DIR_PCRE_JIT_STACK_SIZE = 280,  // "CONFIG_DIR_PCRE_JIT_STACK_SIZE"
+        S_CONFIG_DIR_PCRE_MATCH_LIMIT = 281,     // "CONFIG_DIR_PCRE_MATCH_LIMIT"
+        S_CONFIG_DIR_RBL_TIMEOUT = 282,          // "CONFIG_DIR_RBL_TIMEOUT"
+        S_CONFIG_DIR_RULE_EARLY_DECISION = 283,  // "CONFIG_DIR_RULE_EARLY_DECISION"
+        S_CONFIG_DIR_RULE_EVALUATION_THREADS = 284, // "CONFIG_DIR_RULE_EVALUATION_THREADS"
+        S_CONFIG_DIR_RULE_ENG_SAMPLE_RATE = 285, // "CONFIG_DIR_RULE_ENG_SAMPLE_RATE"
+        S_CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE = 286, // "CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE"
+        S_CONFIG_DIR_RX_GUARDRAIL = 287,         // "CONFIG_DIR_RX_GUARDRAIL"
+        S_CONFIG_DIR_REGEX_CACHE_FILE = 288,     // "CONFIG_DIR_REGEX_CACHE_FILE"
+        S_CONFIG_DIR_RULE_NATIVE_MODULE = 289,   // "CONFIG_DIR_RULE_NATIVE_MODULE"
+        S_CONFIG_DIR_SHADOW_RULES = 290,         // "CONFIG_DIR_SHADOW_RULES"
+        S_CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION = 291, // "CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION"
+        S_CONFIG_SEC_CONN_R_STATE_LIMIT = 292,   // "CONFIG_SEC_CONN_R_STATE_LIMIT"
+        S_CONFIG_SEC_CONN_W_STATE_LIMIT = 293,   // "CONFIG_SEC_CONN_W_STATE_LIMIT"
+        S_CONFIG_SEC_SENSOR_ID = 294,            // "CONFIG_SEC_SENSOR_ID"
+        S_CONFIG_DIR_ARGS_LIMIT = 295,           // "CONFIG_DIR_ARGS_LIMIT"
+        S_CONFIG_DIR_REQ_BODY_DECOMPRESSION = 296, // "CONFIG_DIR_REQ_BODY_DECOMPRESSION"
+        S_CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO = 297, // "CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO"
+        S_CONFIG_DIR_RES_BODY_DECOMPRESSION = 298, // "CONFIG_DIR_RES_BODY_DECOMPRESSION"
+        S_CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT = 299, // "CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT"
+        S_CONFIG_DIR_REQ_BODY_JSON_SIMD = 300,   // "CONFIG_DIR_REQ_BODY_JSON_SIMD"
+        S_CONFIG_DIR_REQ_BODY = 301,             // "CONFIG_DIR_REQ_BODY"
+        S_CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT = 302, // "CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT"
+        S_CONFIG_DIR_REQ_BODY_LIMIT = 303,       // "CONFIG_DIR_REQ_BODY_LIMIT"
+        S_CONFIG_DIR_REQ_BODY_LIMIT_ACTION = 304, // "CONFIG_DIR_REQ_BODY_LIMIT_ACTION"
+        S_CONFIG_DIR_REQ_BODY_NO_FILES_LIMIT = 305, // "CONFIG_DIR_REQ_BODY_NO_FILES_LIMIT"
+        S_CONFIG_DIR_RES_BODY = 306,             // "CONFIG_DIR_RES_BODY"
+        S_CONFIG_DIR_RES_BODY_LIMIT = 307,       // "CONFIG_DIR_RES_BODY_LIMIT"
+        S_CONFIG_DIR_RES_BODY_LIMIT_ACTION = 308, // "CONFIG_DIR_RES_BODY_LIMIT_ACTION"
+        S_CONFIG_DIR_RES_BODY_STREAM_WINDOW = 309, // "CONFIG_DIR_RES_BODY_STREAM_WINDOW"
+        S_CONFIG_SEC_RULE_INHERITANCE = 310,     // "CONFIG_SEC_RULE_INHERITANCE"
+        S_CONFIG_SEC_RULE_PERF_TIME = 311,       // "CONFIG_SEC_RULE_PERF_TIME"
+        S_CONFIG_SEC_RULE_PROFILING = 312,       // "CONFIG_SEC_RULE_PROFILING"
+        S_CONFIG_SEC_RULE_VALUE_MAJOR = 313,     // "CONFIG_SEC_RULE_VALUE_MAJOR"
+        S_CONFIG_SEC_RX_PREFILTER = 314,         // "CONFIG_SEC_RX_PREFILTER"
+        S_CONFIG_SEC_RX_RE2 = 315,               // "CONFIG_SEC_RX_RE2"
+        S_CONFIG_DIR_RULE_ENG = 316,             // "CONFIG_DIR_RULE_ENG"
+        S_CONFIG_DIR_SEC_ACTION = 317,           // "CONFIG_DIR_SEC_ACTION"
+        S_CONFIG_DIR_SEC_DEFAULT_ACTION = 318,   // "CONFIG_DIR_SEC_DEFAULT_ACTION"
+        S_CONFIG_DIR_SEC_MARKER = 319,           // "CONFIG_DIR_SEC_MARKER"
+        S_CONFIG_DIR_UNICODE_MAP_FILE = 320,     // "CONFIG_DIR_UNICODE_MAP_FILE"
+        S_CONFIG_DIR_UNICODE_CODE_PAGE = 321,    // "CONFIG_DIR_UNICODE_CODE_PAGE"
+        S_CONFIG_SEC_COLLECTION_GROUP_COMMIT = 322, // "CONFIG_SEC_COLLECTION_GROUP_COMMIT"
+        S_CONFIG_SEC_COLLECTION_REDIS_SERVER = 323, // "CONFIG_SEC_COLLECTION_REDIS_SERVER"
+        S_CONFIG_SEC_COLLECTION_SYNC_MODE = 324, // "CONFIG_SEC_COLLECTION_SYNC_MODE"
+        S_CONFIG_SEC_COLLECTION_TIMEOUT = 325,   // "CONFIG_SEC_COLLECTION_TIMEOUT"
+        S_CONFIG_SEC_TRANSACTION_ID_FORMAT = 326, // "CONFIG_SEC_TRANSACTION_ID_FORMAT"
+        S_CONFIG_SEC_TRANSACTION_MEMORY_LIMIT = 327, // "CONFIG_SEC_TRANSACTION_MEMORY_LIMIT"
+        S_CONFIG_SEC_TRANSACTION_TIME_BUDGET = 328, // "CONFIG_SEC_TRANSACTION_TIME_BUDGET"
+        S_CONFIG_SEC_VERDICT_CACHE = 329,        // "CONFIG_SEC_VERDICT_CACHE"
+        S_CONFIG_SEC_DEBUG_LOG_BUFFER = 330,     // "CONFIG_SEC_DEBUG_LOG_BUFFER"
+        S_CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH = 331, // "CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH"
+        S_CONFIG_SEC_DEBUG_LOG_FILTER = 332,     // "CONFIG_SEC_DEBUG_LOG_FILTER"
+        S_CONFIG_SEC_HTTP_BLKEY = 333,           // "CONFIG_SEC_HTTP_BLKEY"
+        S_CONFIG_SEC_HUGE_PAGES = 334,           // "CONFIG_SEC_HUGE_PAGES"
+        S_CONFIG_SEC_INTERCEPT_ON_ERROR = 335,   // "CONFIG_SEC_INTERCEPT_ON_ERROR"
+        S_CONFIG_SEC_REMOTE_RULES_CACHE_DIR = 336, // "CONFIG_SEC_REMOTE_RULES_CACHE_DIR"
+        S_CONFIG_SEC_REMOTE_RULES_FAIL_ACTION = 337, // "CONFIG_SEC_REMOTE_RULES_FAIL_ACTION"
+        S_CONFIG_SEC_RULE_REMOVE_BY_ID = 338,    // "CONFIG_SEC_RULE_REMOVE_BY_ID"
+        S_CONFIG_SEC_RULE_REMOVE_BY_MSG = 339,   // "CONFIG_SEC_RULE_REMOVE_BY_MSG"
+        S_CONFIG_SEC_RULE_REMOVE_BY_TAG = 340,   // "CONFIG_SEC_RULE_REMOVE_BY_TAG"
+        S_CONFIG_SEC_RULE_UPDATE_TARGET_BY_TAG = 341, // "CONFIG_SEC_RULE_UPDATE_TARGET_BY_TAG"
+        S_CONFIG_SEC_RULE_UPDATE_TARGET_BY_MSG = 342, // "CONFIG_SEC_RULE_UPDATE_TARGET_BY_MSG"
+        S_CONFIG_SEC_RULE_UPDATE_TARGET_BY_ID = 343, // "CONFIG_SEC_RULE_UPDATE_TARGET_BY_ID"
+        S_CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID = 344, // "CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID"
+        S_CONFIG_UPDLOAD_KEEP_FILES = 345,       // "CONFIG_UPDLOAD_KEEP_FILES"
+        S_CONFIG_UPDLOAD_SAVE_TMP_FILES = 346,   // "CONFIG_UPDLOAD_SAVE_TMP_FILES"
+        S_CONFIG_UPLOAD_ANONYMOUS_FILES = 347,   // "CONFIG_UPLOAD_ANONYMOUS_FILES"
+        S_CONFIG_UPLOAD_DIR = 348,               // "CONFIG_UPLOAD_DIR"
+        S_CONFIG_UPLOAD_FILE_LIMIT = 349,        // "CONFIG_UPLOAD_FILE_LIMIT"
+        S_CONFIG_UPLOAD_FILE_MODE = 350,         // "CONFIG_UPLOAD_FILE_MODE"
+        S_CONFIG_UPLOAD_IN_MEMORY_LIMIT = 351,   // "CONFIG_UPLOAD_IN_MEMORY_LIMIT"
+        S_CONFIG_VALUE_ABORT = 352,              // "CONFIG_VALUE_ABORT"
+        S_CONFIG_VALUE_DETC = 353,               // "CONFIG_VALUE_DETC"
+        S_CONFIG_VALUE_HTTPS = 354,              // "CONFIG_VALUE_HTTPS"
+        S_CONFIG_VALUE_OFF = 355,                // "CONFIG_VALUE_OFF"
+        S_CONFIG_VALUE_ON = 356,                 // "CONFIG_VALUE_ON"
+        S_CONFIG_VALUE_PARALLEL = 357,           // "CONFIG_VALUE_PARALLEL"
+        S_CONFIG_VALUE_PROCESS_PARTIAL = 358,    // "CONFIG_VALUE_PROCESS_PARTIAL"
+        S_CONFIG_VALUE_REJECT = 359,             // "CONFIG_VALUE_REJECT"
+        S_CONFIG_VALUE_RELEVANT_ONLY = 360,      // "CONFIG_VALUE_RELEVANT_ONLY"
+        S_CONFIG_VALUE_RING = 361,               // "CONFIG_VALUE_RING"
+        S_CONFIG_VALUE_SERIAL = 362,             // "CONFIG_VALUE_SERIAL"
+        S_CONFIG_VALUE_STREAM = 363,             // "CONFIG_VALUE_STREAM"
+        S_CONFIG_VALUE_WARN = 364,               // "CONFIG_VALUE_WARN"
+        S_CONFIG_XML_EXTERNAL_ENTITY = 365,      // "CONFIG_XML_EXTERNAL_ENTITY"
+        S_CONGIG_DIR_RESPONSE_BODY_MP = 366,     // "CONGIG_DIR_RESPONSE_BODY_MP"
+        S_CONGIG_DIR_SEC_ARG_SEP = 367,          // "CONGIG_DIR_SEC_ARG_SEP"
+        S_CONGIG_DIR_SEC_COOKIE_FORMAT = 368,    // "CONGIG_DIR_SEC_COOKIE_FORMAT"
+        S_CONFIG_SEC_COOKIEV0_SEPARATOR = 369,   // "CONFIG_SEC_COOKIEV0_SEPARATOR"
+        S_CONGIG_DIR_SEC_DATA_DIR = 370,         // "CONGIG_DIR_SEC_DATA_DIR"
+        S_CONGIG_DIR_SEC_STATUS_ENGINE = 371,    // "CONGIG_DIR_SEC_STATUS_ENGINE"
+        S_CONFIG_SEC_STREAM_IN_BODY_INSPECTION = 372, // "CONFIG_SEC_STREAM_IN_BODY_INSPECTION"
+        S_CONFIG_SEC_STREAM_OUT_BODY_INSPECTION = 373, // "CONFIG_SEC_STREAM_OUT_BODY_INSPECTION"
+        S_CONGIG_DIR_SEC_TMP_DIR = 374,          // "CONGIG_DIR_SEC_TMP_DIR"
+        S_DIRECTIVE = 375,                       // "DIRECTIVE"
+        S_DIRECTIVE_SECRULESCRIPT = 376,         // "DIRECTIVE_SECRULESCRIPT"
+        S_FREE_TEXT_QUOTE_MACRO_EXPANSION = 377, // "FREE_TEXT_QUOTE_MACRO_EXPANSION"
+        S_QUOTATION_MARK = 378,                  // "QUOTATION_MARK"
+        S_RUN_TIME_VAR_BLD = 379,                // "RUN_TIME_VAR_BLD"
+        S_RUN_TIME_VAR_DUR = 380,                // "RUN_TIME_VAR_DUR"
+        S_RUN_TIME_VAR_HSV = 381,                // "RUN_TIME_VAR_HSV"
+        S_RUN_TIME_VAR_REMOTE_USER = 382,        // "RUN_TIME_VAR_REMOTE_USER"
+        S_RUN_TIME_VAR_TIME = 383,               // "RUN_TIME_VAR_TIME"
+        S_RUN_TIME_VAR_TIME_DAY = 384,           // "RUN_TIME_VAR_TIME_DAY"
+        S_RUN_TIME_VAR_TIME_EPOCH = 385,         // "RUN_TIME_VAR_TIME_EPOCH"
+        S_RUN_TIME_VAR_TIME_HOUR = 386,          // "RUN_TIME_VAR_TIME_HOUR"
+        S_RUN_TIME_VAR_TIME_MIN = 387,           // "RUN_TIME_VAR_TIME_MIN"
+        S_RUN_TIME_VAR_TIME_MON = 388,           // "RUN_TIME_VAR_TIME_MON"
+        S_RUN_TIME_VAR_TIME_SEC = 389,           // "RUN_TIME_VAR_TIME_SEC"
+        S_RUN_TIME_VAR_TIME_WDAY = 390,          // "RUN_TIME_VAR_TIME_WDAY"
+        S_RUN_TIME_VAR_TIME_YEAR = 391,          // "RUN_TIME_VAR_TIME_YEAR"
+        S_VARIABLE = 392,                        // "VARIABLE"
+        S_DICT_ELEMENT = 393,                    // "Dictionary element"
+        S_DICT_ELEMENT_WITH_EQUALS = 394,        // "Dictionary element, with equals"
+        S_DICT_ELEMENT_REGEXP = 395,             // "Dictionary element, selected by regexp"
+        S_YYACCEPT = 396,                        // $accept
+        S_input = 397,                           // input
+        S_line = 398,                            // line
+        S_audit_log = 399,                       // audit_log
+        S_actions = 400,                         // actions
+        S_actions_may_quoted = 401,              // actions_may_quoted
+        S_op = 402,                              // op
+        S_op_before_init = 403,                  // op_before_init
+        S_expression = 404,                      // expression
+        S_variables = 405,                       // variables
+        S_variables_pre_process = 406,           // variables_pre_process
+        S_variables_may_be_quoted = 407,         // variables_may_be_quoted
+        S_var = 408,                             // var
+        S_act = 409,                             // act
+        S_setvar_action = 410,                   // setvar_action
+        S_run_time_string = 411                  // run_time_string
       };
     };
 
@@ -1760,6 +1894,7 @@ namespace yy {
       case symbol_kind::S_ACTION_CHAIN: // "Chain"
       case symbol_kind::S_ACTION_CTL_AUDIT_ENGINE: // "ACTION_CTL_AUDIT_ENGINE"
       case symbol_kind::S_ACTION_CTL_AUDIT_LOG_PARTS: // "ACTION_CTL_AUDIT_LOG_PARTS"
+      case symbol_kind::S_ACTION_CTL_BDY_GRPC: // "ACTION_CTL_BDY_GRPC"
       case symbol_kind::S_ACTION_CTL_BDY_JSON: // "ACTION_CTL_BDY_JSON"
       case symbol_kind::S_ACTION_CTL_BDY_XML: // "ACTION_CTL_BDY_XML"
       case symbol_kind::S_ACTION_CTL_BDY_URLENCODED: // "ACTION_CTL_BDY_URLENCODED"
@@ -1783,6 +1918,7 @@ namespace yy {
       case symbol_kind::S_ACTION_MULTI_MATCH: // "MultiMatch"
       case symbol_kind::S_ACTION_NO_AUDIT_LOG: // "NoAuditLog"
       case symbol_kind::S_ACTION_NO_LOG: // "NoLog"
+      case symbol_kind::S_ACTION_NO_VERDICT_CACHE: // "NoVerdictCache"
       case symbol_kind::S_ACTION_PASS: // "Pass"
       case symbol_kind::S_ACTION_PAUSE: // "Pause"
       case symbol_kind::S_ACTION_PHASE: // "Phase"
@@ -1847,6 +1983,7 @@ namespace yy {
       case symbol_kind::S_CONFIG_SEC_ARGUMENT_SEPARATOR: // "CONFIG_SEC_ARGUMENT_SEPARATOR"
       case symbol_kind::S_CONFIG_SEC_WEB_APP_ID: // "CONFIG_SEC_WEB_APP_ID"
       case symbol_kind::S_CONFIG_SEC_SERVER_SIG: // "CONFIG_SEC_SERVER_SIG"
+      case symbol_kind::S_CONFIG_DIR_AUDIT_COMPRESSION_LEVEL: // "CONFIG_DIR_AUDIT_COMPRESSION_LEVEL"
       case symbol_kind::S_CONFIG_DIR_AUDIT_DIR: // "CONFIG_DIR_AUDIT_DIR"
       case symbol_kind::S_CONFIG_DIR_AUDIT_DIR_MOD: // "CONFIG_DIR_AUDIT_DIR_MOD"
       case symbol_kind::S_CONFIG_DIR_AUDIT_ENG: // "CONFIG_DIR_AUDIT_ENG"
@@ -1854,7 +1991,9 @@ namespace yy {
       case symbol_kind::S_CONFIG_DIR_AUDIT_LOG: // "CONFIG_DIR_AUDIT_LOG"
       case symbol_kind::S_CONFIG_DIR_AUDIT_LOG2: // "CONFIG_DIR_AUDIT_LOG2"
       case symbol_kind::S_CONFIG_DIR_AUDIT_LOG_P: // "CONFIG_DIR_AUDIT_LOG_P"
+      case symbol_kind::S_CONFIG_DIR_AUDIT_RATE_LIMIT: // "CONFIG_DIR_AUDIT_RATE_LIMIT"
       case symbol_kind::S_CONFIG_DIR_AUDIT_STS: // "CONFIG_DIR_AUDIT_STS"
+      case symbol_kind::S_CONFIG_DIR_AUDIT_TIMINGS: // "CONFIG_DIR_AUDIT_TIMINGS"
       case symbol_kind::S_CONFIG_DIR_AUDIT_TPE: // "CONFIG_DIR_AUDIT_TPE"
       case symbol_kind::S_CONFIG_DIR_DEBUG_LOG: // "CONFIG_DIR_DEBUG_LOG"
       case symbol_kind::S_CONFIG_DIR_DEBUG_LVL: // "CONFIG_DIR_DEBUG_LVL"
@@ -1869,13 +2008,32 @@ namespace yy {
       case symbol_kind::S_CONFIG_DIR_GEO_DB: // "CONFIG_DIR_GEO_DB"
       case symbol_kind::S_CONFIG_DIR_GSB_DB: // "CONFIG_DIR_GSB_DB"
       case symbol_kind::S_CONFIG_SEC_GUARDIAN_LOG: // "CONFIG_SEC_GUARDIAN_LOG"
+      case symbol_kind::S_CONFIG_DIR_DATA_RELOAD_INTERVAL: // "CONFIG_DIR_DATA_RELOAD_INTERVAL"
+      case symbol_kind::S_CONFIG_DIR_LUA_STATE_POOL_LIMIT: // "CONFIG_DIR_LUA_STATE_POOL_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_OVERLOAD_DETECTION_ONLY: // "CONFIG_DIR_OVERLOAD_DETECTION_ONLY"
+      case symbol_kind::S_CONFIG_DIR_OVERLOAD_SHED_TAG: // "CONFIG_DIR_OVERLOAD_SHED_TAG"
+      case symbol_kind::S_CONFIG_DIR_OVERLOAD_TARGET: // "CONFIG_DIR_OVERLOAD_TARGET"
+      case symbol_kind::S_CONFIG_DIR_PCRE_JIT_STACK_SIZE: // "CONFIG_DIR_PCRE_JIT_STACK_SIZE"
       case symbol_kind::S_CONFIG_DIR_PCRE_MATCH_LIMIT: // "CONFIG_DIR_PCRE_MATCH_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_RBL_TIMEOUT: // "CONFIG_DIR_RBL_TIMEOUT"
+      case symbol_kind::S_CONFIG_DIR_RULE_EARLY_DECISION: // "CONFIG_DIR_RULE_EARLY_DECISION"
+      case symbol_kind::S_CONFIG_DIR_RULE_EVALUATION_THREADS: // "CONFIG_DIR_RULE_EVALUATION_THREADS"
+      case symbol_kind::S_CONFIG_DIR_RULE_ENG_SAMPLE_RATE: // "CONFIG_DIR_RULE_ENG_SAMPLE_RATE"
+      case symbol_kind::S_CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE: // "CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE"
+      case symbol_kind::S_CONFIG_DIR_RX_GUARDRAIL: // "CONFIG_DIR_RX_GUARDRAIL"
+      case symbol_kind::S_CONFIG_DIR_REGEX_CACHE_FILE: // "CONFIG_DIR_REGEX_CACHE_FILE"
+      case symbol_kind::S_CONFIG_DIR_RULE_NATIVE_MODULE: // "CONFIG_DIR_RULE_NATIVE_MODULE"
+      case symbol_kind::S_CONFIG_DIR_SHADOW_RULES: // "CONFIG_DIR_SHADOW_RULES"
       case symbol_kind::S_CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION: // "CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION"
       case symbol_kind::S_CONFIG_SEC_CONN_R_STATE_LIMIT: // "CONFIG_SEC_CONN_R_STATE_LIMIT"
       case symbol_kind::S_CONFIG_SEC_CONN_W_STATE_LIMIT: // "CONFIG_SEC_CONN_W_STATE_LIMIT"
       case symbol_kind::S_CONFIG_SEC_SENSOR_ID: // "CONFIG_SEC_SENSOR_ID"
       case symbol_kind::S_CONFIG_DIR_ARGS_LIMIT: // "CONFIG_DIR_ARGS_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_REQ_BODY_DECOMPRESSION: // "CONFIG_DIR_REQ_BODY_DECOMPRESSION"
+      case symbol_kind::S_CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO: // "CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO"
+      case symbol_kind::S_CONFIG_DIR_RES_BODY_DECOMPRESSION: // "CONFIG_DIR_RES_BODY_DECOMPRESSION"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT: // "CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_REQ_BODY_JSON_SIMD: // "CONFIG_DIR_REQ_BODY_JSON_SIMD"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY: // "CONFIG_DIR_REQ_BODY"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT: // "CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY_LIMIT: // "CONFIG_DIR_REQ_BODY_LIMIT"
@@ -1884,17 +2042,34 @@ namespace yy {
       case symbol_kind::S_CONFIG_DIR_RES_BODY: // "CONFIG_DIR_RES_BODY"
       case symbol_kind::S_CONFIG_DIR_RES_BODY_LIMIT: // "CONFIG_DIR_RES_BODY_LIMIT"
       case symbol_kind::S_CONFIG_DIR_RES_BODY_LIMIT_ACTION: // "CONFIG_DIR_RES_BODY_LIMIT_ACTION"
+      case symbol_kind::S_CONFIG_DIR_RES_BODY_STREAM_WINDOW: // "CONFIG_DIR_RES_BODY_STREAM_WINDOW"
       case symbol_kind::S_CONFIG_SEC_RULE_INHERITANCE: // "CONFIG_SEC_RULE_INHERITANCE"
       case symbol_kind::S_CONFIG_SEC_RULE_PERF_TIME: // "CONFIG_SEC_RULE_PERF_TIME"
+      case symbol_kind::S_CONFIG_SEC_RULE_PROFILING: // "CONFIG_SEC_RULE_PROFILING"
+      case symbol_kind::S_CONFIG_SEC_RULE_VALUE_MAJOR: // "CONFIG_SEC_RULE_VALUE_MAJOR"
+      case symbol_kind::S_CONFIG_SEC_RX_PREFILTER: // "CONFIG_SEC_RX_PREFILTER"
+      case symbol_kind::S_CONFIG_SEC_RX_RE2: // "CONFIG_SEC_RX_RE2"
       case symbol_kind::S_CONFIG_DIR_RULE_ENG: // "CONFIG_DIR_RULE_ENG"
       case symbol_kind::S_CONFIG_DIR_SEC_ACTION: // "CONFIG_DIR_SEC_ACTION"
       case symbol_kind::S_CONFIG_DIR_SEC_DEFAULT_ACTION: // "CONFIG_DIR_SEC_DEFAULT_ACTION"
       case symbol_kind::S_CONFIG_DIR_SEC_MARKER: // "CONFIG_DIR_SEC_MARKER"
       case symbol_kind::S_CONFIG_DIR_UNICODE_MAP_FILE: // "CONFIG_DIR_UNICODE_MAP_FILE"
       case symbol_kind::S_CONFIG_DIR_UNICODE_CODE_PAGE: // "CONFIG_DIR_UNICODE_CODE_PAGE"
+      case symbol_kind::S_CONFIG_SEC_COLLECTION_GROUP_COMMIT: // "CONFIG_SEC_COLLECTION_GROUP_COMMIT"
+      case symbol_kind::S_CONFIG_SEC_COLLECTION_REDIS_SERVER: // "CONFIG_SEC_COLLECTION_REDIS_SERVER"
+      case symbol_kind::S_CONFIG_SEC_COLLECTION_SYNC_MODE: // "CONFIG_SEC_COLLECTION_SYNC_MODE"
       case symbol_kind::S_CONFIG_SEC_COLLECTION_TIMEOUT: // "CONFIG_SEC_COLLECTION_TIMEOUT"
+      case symbol_kind::S_CONFIG_SEC_TRANSACTION_ID_FORMAT: // "CONFIG_SEC_TRANSACTION_ID_FORMAT"
+      case symbol_kind::S_CONFIG_SEC_TRANSACTION_MEMORY_LIMIT: // "CONFIG_SEC_TRANSACTION_MEMORY_LIMIT"
+      case symbol_kind::S_CONFIG_SEC_TRANSACTION_TIME_BUDGET: // "CONFIG_SEC_TRANSACTION_TIME_BUDGET"
+      case symbol_kind::S_CONFIG_SEC_VERDICT_CACHE: // "CONFIG_SEC_VERDICT_CACHE"
+      case symbol_kind::S_CONFIG_SEC_DEBUG_LOG_BUFFER: // "CONFIG_SEC_DEBUG_LOG_BUFFER"
+      case symbol_kind::S_CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH: // "CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH"
+      case symbol_kind::S_CONFIG_SEC_DEBUG_LOG_FILTER: // "CONFIG_SEC_DEBUG_LOG_FILTER"
       case symbol_kind::S_CONFIG_SEC_HTTP_BLKEY: // "CONFIG_SEC_HTTP_BLKEY"
+      case symbol_kind::S_CONFIG_SEC_HUGE_PAGES: // "CONFIG_SEC_HUGE_PAGES"
       case symbol_kind::S_CONFIG_SEC_INTERCEPT_ON_ERROR: // "CONFIG_SEC_INTERCEPT_ON_ERROR"
+      case symbol_kind::S_CONFIG_SEC_REMOTE_RULES_CACHE_DIR: // "CONFIG_SEC_REMOTE_RULES_CACHE_DIR"
       case symbol_kind::S_CONFIG_SEC_REMOTE_RULES_FAIL_ACTION: // "CONFIG_SEC_REMOTE_RULES_FAIL_ACTION"
       case symbol_kind::S_CONFIG_SEC_RULE_REMOVE_BY_ID: // "CONFIG_SEC_RULE_REMOVE_BY_ID"
       case symbol_kind::S_CONFIG_SEC_RULE_REMOVE_BY_MSG: // "CONFIG_SEC_RULE_REMOVE_BY_MSG"
@@ -1905,9 +2080,11 @@ namespace yy {
       case symbol_kind::S_CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID: // "CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID"
       case symbol_kind::S_CONFIG_UPDLOAD_KEEP_FILES: // "CONFIG_UPDLOAD_KEEP_FILES"
       case symbol_kind::S_CONFIG_UPDLOAD_SAVE_TMP_FILES: // "CONFIG_UPDLOAD_SAVE_TMP_FILES"
+      case symbol_kind::S_CONFIG_UPLOAD_ANONYMOUS_FILES: // "CONFIG_UPLOAD_ANONYMOUS_FILES"
       case symbol_kind::S_CONFIG_UPLOAD_DIR: // "CONFIG_UPLOAD_DIR"
       case symbol_kind::S_CONFIG_UPLOAD_FILE_LIMIT: // "CONFIG_UPLOAD_FILE_LIMIT"
       case symbol_kind::S_CONFIG_UPLOAD_FILE_MODE: // "CONFIG_UPLOAD_FILE_MODE"
+      case symbol_kind::S_CONFIG_UPLOAD_IN_MEMORY_LIMIT: // "CONFIG_UPLOAD_IN_MEMORY_LIMIT"
       case symbol_kind::S_CONFIG_VALUE_ABORT: // "CONFIG_VALUE_ABORT"
       case symbol_kind::S_CONFIG_VALUE_DETC: // "CONFIG_VALUE_DETC"
       case symbol_kind::S_CONFIG_VALUE_HTTPS: // "CONFIG_VALUE_HTTPS"
@@ -1917,7 +2094,9 @@ namespace yy {
       case symbol_kind::S_CONFIG_VALUE_PROCESS_PARTIAL: // "CONFIG_VALUE_PROCESS_PARTIAL"
       case symbol_kind::S_CONFIG_VALUE_REJECT: // "CONFIG_VALUE_REJECT"
       case symbol_kind::S_CONFIG_VALUE_RELEVANT_ONLY: // "CONFIG_VALUE_RELEVANT_ONLY"
+      case symbol_kind::S_CONFIG_VALUE_RING: // "CONFIG_VALUE_RING"
       case symbol_kind::S_CONFIG_VALUE_SERIAL: // "CONFIG_VALUE_SERIAL"
+      case symbol_kind::S_CONFIG_VALUE_STREAM: // "CONFIG_VALUE_STREAM"
       case symbol_kind::S_CONFIG_VALUE_WARN: // "CONFIG_VALUE_WARN"
       case symbol_kind::S_CONFIG_XML_EXTERNAL_ENTITY: // "CONFIG_XML_EXTERNAL_ENTITY"
       case symbol_kind::S_CONGIG_DIR_RESPONSE_BODY_MP: // "CONGIG_DIR_RESPONSE_BODY_MP"
@@ -2136,6 +2315,7 @@ switch (yykind)
       case symbol_kind::S_ACTION_CHAIN: // "Chain"
       case symbol_kind::S_ACTION_CTL_AUDIT_ENGINE: // "ACTION_CTL_AUDIT_ENGINE"
       case symbol_kind::S_ACTION_CTL_AUDIT_LOG_PARTS: // "ACTION_CTL_AUDIT_LOG_PARTS"
+      case symbol_kind::S_ACTION_CTL_BDY_GRPC: // "ACTION_CTL_BDY_GRPC"
       case symbol_kind::S_ACTION_CTL_BDY_JSON: // "ACTION_CTL_BDY_JSON"
       case symbol_kind::S_ACTION_CTL_BDY_XML: // "ACTION_CTL_BDY_XML"
       case symbol_kind::S_ACTION_CTL_BDY_URLENCODED: // "ACTION_CTL_BDY_URLENCODED"
@@ -2159,6 +2339,7 @@ switch (yykind)
       case symbol_kind::S_ACTION_MULTI_MATCH: // "MultiMatch"
       case symbol_kind::S_ACTION_NO_AUDIT_LOG: // "NoAuditLog"
       case symbol_kind::S_ACTION_NO_LOG: // "NoLog"
+      case symbol_kind::S_ACTION_NO_VERDICT_CACHE: // "NoVerdictCache"
       case symbol_kind::S_ACTION_PASS: // "Pass"
       case symbol_kind::S_ACTION_PAUSE: // "Pause"
       case symbol_kind::S_ACTION_PHASE: // "Phase"
@@ -2223,6 +2404,7 @@ switch (yykind)
       case symbol_kind::S_CONFIG_SEC_ARGUMENT_SEPARATOR: // "CONFIG_SEC_ARGUMENT_SEPARATOR"
       case symbol_kind::S_CONFIG_SEC_WEB_APP_ID: // "CONFIG_SEC_WEB_APP_ID"
       case symbol_kind::S_CONFIG_SEC_SERVER_SIG: // "CONFIG_SEC_SERVER_SIG"
+      case symbol_kind::S_CONFIG_DIR_AUDIT_COMPRESSION_LEVEL: // "CONFIG_DIR_AUDIT_COMPRESSION_LEVEL"
       case symbol_kind::S_CONFIG_DIR_AUDIT_DIR: // "CONFIG_DIR_AUDIT_DIR"
       case symbol_kind::S_CONFIG_DIR_AUDIT_DIR_MOD: // "CONFIG_DIR_AUDIT_DIR_MOD"
       case symbol_kind::S_CONFIG_DIR_AUDIT_ENG: // "CONFIG_DIR_AUDIT_ENG"
@@ -2230,7 +2412,9 @@ switch (yykind)
       case symbol_kind::S_CONFIG_DIR_AUDIT_LOG: // "CONFIG_DIR_AUDIT_LOG"
       case symbol_kind::S_CONFIG_DIR_AUDIT_LOG2: // "CONFIG_DIR_AUDIT_LOG2"
       case symbol_kind::S_CONFIG_DIR_AUDIT_LOG_P: // "CONFIG_DIR_AUDIT_LOG_P"
+      case symbol_kind::S_CONFIG_DIR_AUDIT_RATE_LIMIT: // "CONFIG_DIR_AUDIT_RATE_LIMIT"
       case symbol_kind::S_CONFIG_DIR_AUDIT_STS: // "CONFIG_DIR_AUDIT_STS"
+      case symbol_kind::S_CONFIG_DIR_AUDIT_TIMINGS: // "CONFIG_DIR_AUDIT_TIMINGS"
       case symbol_kind::S_CONFIG_DIR_AUDIT_TPE: // "CONFIG_DIR_AUDIT_TPE"
       case symbol_kind::S_CONFIG_DIR_DEBUG_LOG: // "CONFIG_DIR_DEBUG_LOG"
       case symbol_kind::S_CONFIG_DIR_DEBUG_LVL: // "CONFIG_DIR_DEBUG_LVL"
@@ -2245,13 +2429,32 @@ switch (yykind)
       case symbol_kind::S_CONFIG_DIR_GEO_DB: // "CONFIG_DIR_GEO_DB"
       case symbol_kind::S_CONFIG_DIR_GSB_DB: // "CONFIG_DIR_GSB_DB"
       case symbol_kind::S_CONFIG_SEC_GUARDIAN_LOG: // "CONFIG_SEC_GUARDIAN_LOG"
+      case symbol_kind::S_CONFIG_DIR_DATA_RELOAD_INTERVAL: // "CONFIG_DIR_DATA_RELOAD_INTERVAL"
+      case symbol_kind::S_CONFIG_DIR_LUA_STATE_POOL_LIMIT: // "CONFIG_DIR_LUA_STATE_POOL_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_OVERLOAD_DETECTION_ONLY: // "CONFIG_DIR_OVERLOAD_DETECTION_ONLY"
+      case symbol_kind::S_CONFIG_DIR_OVERLOAD_SHED_TAG: // "CONFIG_DIR_OVERLOAD_SHED_TAG"
+      case symbol_kind::S_CONFIG_DIR_OVERLOAD_TARGET: // "CONFIG_DIR_OVERLOAD_TARGET"
+      case symbol_kind::S_CONFIG_DIR_PCRE_JIT_STACK_SIZE: // "CONFIG_DIR_PCRE_JIT_STACK_SIZE"
       case symbol_kind::S_CONFIG_DIR_PCRE_MATCH_LIMIT: // "CONFIG_DIR_PCRE_MATCH_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_RBL_TIMEOUT: // "CONFIG_DIR_RBL_TIMEOUT"
+      case symbol_kind::S_CONFIG_DIR_RULE_EARLY_DECISION: // "CONFIG_DIR_RULE_EARLY_DECISION"
+      case symbol_kind::S_CONFIG_DIR_RULE_EVALUATION_THREADS: // "CONFIG_DIR_RULE_EVALUATION_THREADS"
+      case symbol_kind::S_CONFIG_DIR_RULE_ENG_SAMPLE_RATE: // "CONFIG_DIR_RULE_ENG_SAMPLE_RATE"
+      case symbol_kind::S_CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE: // "CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE"
+      case symbol_kind::S_CONFIG_DIR_RX_GUARDRAIL: // "CONFIG_DIR_RX_GUARDRAIL"
+      case symbol_kind::S_CONFIG_DIR_REGEX_CACHE_FILE: // "CONFIG_DIR_REGEX_CACHE_FILE"
+      case symbol_kind::S_CONFIG_DIR_RULE_NATIVE_MODULE: // "CONFIG_DIR_RULE_NATIVE_MODULE"
+      case symbol_kind::S_CONFIG_DIR_SHADOW_RULES: // "CONFIG_DIR_SHADOW_RULES"
       case symbol_kind::S_CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION: // "CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION"
       case symbol_kind::S_CONFIG_SEC_CONN_R_STATE_LIMIT: // "CONFIG_SEC_CONN_R_STATE_LIMIT"
       case symbol_kind::S_CONFIG_SEC_CONN_W_STATE_LIMIT: // "CONFIG_SEC_CONN_W_STATE_LIMIT"
       case symbol_kind::S_CONFIG_SEC_SENSOR_ID: // "CONFIG_SEC_SENSOR_ID"
       case symbol_kind::S_CONFIG_DIR_ARGS_LIMIT: // "CONFIG_DIR_ARGS_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_REQ_BODY_DECOMPRESSION: // "CONFIG_DIR_REQ_BODY_DECOMPRESSION"
+      case symbol_kind::S_CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO: // "CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO"
+      case symbol_kind::S_CONFIG_DIR_RES_BODY_DECOMPRESSION: // "CONFIG_DIR_RES_BODY_DECOMPRESSION"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT: // "CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_REQ_BODY_JSON_SIMD: // "CONFIG_DIR_REQ_BODY_JSON_SIMD"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY: // "CONFIG_DIR_REQ_BODY"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT: // "CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY_LIMIT: // "CONFIG_DIR_REQ_BODY_LIMIT"
@@ -2260,17 +2463,34 @@ switch (yykind)
       case symbol_kind::S_CONFIG_DIR_RES_BODY: // "CONFIG_DIR_RES_BODY"
       case symbol_kind::S_CONFIG_DIR_RES_BODY_LIMIT: // "CONFIG_DIR_RES_BODY_LIMIT"
       case symbol_kind::S_CONFIG_DIR_RES_BODY_LIMIT_ACTION: // "CONFIG_DIR_RES_BODY_LIMIT_ACTION"
+      case symbol_kind::S_CONFIG_DIR_RES_BODY_STREAM_WINDOW: // "CONFIG_DIR_RES_BODY_STREAM_WINDOW"
       case symbol_kind::S_CONFIG_SEC_RULE_INHERITANCE: // "CONFIG_SEC_RULE_INHERITANCE"
       case symbol_kind::S_CONFIG_SEC_RULE_PERF_TIME: // "CONFIG_SEC_RULE_PERF_TIME"
+      case symbol_kind::S_CONFIG_SEC_RULE_PROFILING: // "CONFIG_SEC_RULE_PROFILING"
+      case symbol_kind::S_CONFIG_SEC_RULE_VALUE_MAJOR: // "CONFIG_SEC_RULE_VALUE_MAJOR"
+      case symbol_kind::S_CONFIG_SEC_RX_PREFILTER: // "CONFIG_SEC_RX_PREFILTER"
+      case symbol_kind::S_CONFIG_SEC_RX_RE2: // "CONFIG_SEC_RX_RE2"
       case symbol_kind::S_CONFIG_DIR_RULE_ENG: // "CONFIG_DIR_RULE_ENG"
       case symbol_kind::S_CONFIG_DIR_SEC_ACTION: // "CONFIG_DIR_SEC_ACTION"
       case symbol_kind::S_CONFIG_DIR_SEC_DEFAULT_ACTION: // "CONFIG_DIR_SEC_DEFAULT_ACTION"
       case symbol_kind::S_CONFIG_DIR_SEC_MARKER: // "CONFIG_DIR_SEC_MARKER"
       case symbol_kind::S_CONFIG_DIR_UNICODE_MAP_FILE: // "CONFIG_DIR_UNICODE_MAP_FILE"
       case symbol_kind::S_CONFIG_DIR_UNICODE_CODE_PAGE: // "CONFIG_DIR_UNICODE_CODE_PAGE"
+      case symbol_kind::S_CONFIG_SEC_COLLECTION_GROUP_COMMIT: // "CONFIG_SEC_COLLECTION_GROUP_COMMIT"
+      case symbol_kind::S_CONFIG_SEC_COLLECTION_REDIS_SERVER: // "CONFIG_SEC_COLLECTION_REDIS_SERVER"
+      case symbol_kind::S_CONFIG_SEC_COLLECTION_SYNC_MODE: // "CONFIG_SEC_COLLECTION_SYNC_MODE"
       case symbol_kind::S_CONFIG_SEC_COLLECTION_TIMEOUT: // "CONFIG_SEC_COLLECTION_TIMEOUT"
+      case symbol_kind::S_CONFIG_SEC_TRANSACTION_ID_FORMAT: // "CONFIG_SEC_TRANSACTION_ID_FORMAT"
+      case symbol_kind::S_CONFIG_SEC_TRANSACTION_MEMORY_LIMIT: // "CONFIG_SEC_TRANSACTION_MEMORY_LIMIT"
+      case symbol_kind::S_CONFIG_SEC_TRANSACTION_TIME_BUDGET: // "CONFIG_SEC_TRANSACTION_TIME_BUDGET"
+      case symbol_kind::S_CONFIG_SEC_VERDICT_CACHE: // "CONFIG_SEC_VERDICT_CACHE"
+      case symbol_kind::S_CONFIG_SEC_DEBUG_LOG_BUFFER: // "CONFIG_SEC_DEBUG_LOG_BUFFER"
+      case symbol_kind::S_CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH: // "CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH"
+      case symbol_kind::S_CONFIG_SEC_DEBUG_LOG_FILTER: // "CONFIG_SEC_DEBUG_LOG_FILTER"
       case symbol_kind::S_CONFIG_SEC_HTTP_BLKEY: // "CONFIG_SEC_HTTP_BLKEY"
+      case symbol_kind::S_CONFIG_SEC_HUGE_PAGES: // "CONFIG_SEC_HUGE_PAGES"
       case symbol_kind::S_CONFIG_SEC_INTERCEPT_ON_ERROR: // "CONFIG_SEC_INTERCEPT_ON_ERROR"
+      case symbol_kind::S_CONFIG_SEC_REMOTE_RULES_CACHE_DIR: // "CONFIG_SEC_REMOTE_RULES_CACHE_DIR"
       case symbol_kind::S_CONFIG_SEC_REMOTE_RULES_FAIL_ACTION: // "CONFIG_SEC_REMOTE_RULES_FAIL_ACTION"
       case symbol_kind::S_CONFIG_SEC_RULE_REMOVE_BY_ID: // "CONFIG_SEC_RULE_REMOVE_BY_ID"
       case symbol_kind::S_CONFIG_SEC_RULE_REMOVE_BY_MSG: // "CONFIG_SEC_RULE_REMOVE_BY_MSG"
@@ -2281,9 +2501,11 @@ switch (yykind)
       case symbol_kind::S_CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID: // "CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID"
       case symbol_kind::S_CONFIG_UPDLOAD_KEEP_FILES: // "CONFIG_UPDLOAD_KEEP_FILES"
       case symbol_kind::S_CONFIG_UPDLOAD_SAVE_TMP_FILES: // "CONFIG_UPDLOAD_SAVE_TMP_FILES"
+      case symbol_kind::S_CONFIG_UPLOAD_ANONYMOUS_FILES: // "CONFIG_UPLOAD_ANONYMOUS_FILES"
       case symbol_kind::S_CONFIG_UPLOAD_DIR: // "CONFIG_UPLOAD_DIR"
       case symbol_kind::S_CONFIG_UPLOAD_FILE_LIMIT: // "CONFIG_UPLOAD_FILE_LIMIT"
       case symbol_kind::S_CONFIG_UPLOAD_FILE_MODE: // "CONFIG_UPLOAD_FILE_MODE"
+      case symbol_kind::S_CONFIG_UPLOAD_IN_MEMORY_LIMIT: // "CONFIG_UPLOAD_IN_MEMORY_LIMIT"
       case symbol_kind::S_CONFIG_VALUE_ABORT: // "CONFIG_VALUE_ABORT"
       case symbol_kind::S_CONFIG_VALUE_DETC: // "CONFIG_VALUE_DETC"
       case symbol_kind::S_CONFIG_VALUE_HTTPS: // "CONFIG_VALUE_HTTPS"
@@ -2293,7 +2515,9 @@ switch (yykind)
       case symbol_kind::S_CONFIG_VALUE_PROCESS_PARTIAL: // "CONFIG_VALUE_PROCESS_PARTIAL"
       case symbol_kind::S_CONFIG_VALUE_REJECT: // "CONFIG_VALUE_REJECT"
       case symbol_kind::S_CONFIG_VALUE_RELEVANT_ONLY: // "CONFIG_VALUE_RELEVANT_ONLY"
+      case symbol_kind::S_CONFIG_VALUE_RING: // "CONFIG_VALUE_RING"
       case symbol_kind::S_CONFIG_VALUE_SERIAL: // "CONFIG_VALUE_SERIAL"
+      case symbol_kind::S_CONFIG_VALUE_STREAM: // "CONFIG_VALUE_STREAM"
       case symbol_kind::S_CONFIG_VALUE_WARN: // "CONFIG_VALUE_WARN"
       case symbol_kind::S_CONFIG_XML_EXTERNAL_ENTITY: // "CONFIG_XML_EXTERNAL_ENTITY"
       case symbol_kind::S_CONGIG_DIR_RESPONSE_BODY_MP: // "CONGIG_DIR_RESPONSE_BODY_MP"
@@ -2453,12 +2677,7 @@ switch (yykind)
       symbol_type (int tok, const location_type& l)
         : super_type (token_kind_type (tok), l)
 #endif
-      {
-#if !defined _MSC_VER || defined __clang__
-        YY_ASSERT (tok == token::TOK_END
-                   || (token::TOK_YYerror <= tok && tok <= token::TOK_ACTION_CTL_RULE_ENGINE));
-#endif
-      }
+      {}
 #if 201103L <= YY_CPLUSPLUS
       symbol_type (int tok, std::string v, location_type l)
         : super_type (token_kind_type (tok), std::move (v), std::move (l))
@@ -2466,11 +2685,7 @@ switch (yykind)
       symbol_type (int tok, const std::string& v, const location_type& l)
         : super_type (token_kind_type (tok), v, l)
 #endif
-      {
-#if !defined _MSC_VER || defined __clang__
-        YY_ASSERT ((token::TOK_ACTION_ACCURACY <= tok && tok <= token::TOK_DICT_ELEMENT_REGEXP));
-#endif
-      }
+      {}
     };
 
     /// Build a parser object.
@@ -3149,6 +3364,36 @@ switch (yykind)
         return symbol_type (token::TOK_VARIABLE_MSC_PCRE_LIMITS_EXCEEDED, l);
       }
 #endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_VARIABLE_MSC_MEMORY_LIMIT_EXCEEDED (location_type l)
+      {
+        return symbol_type (token::TOK_VARIABLE_MSC_MEMORY_LIMIT_EXCEEDED, std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_VARIABLE_MSC_MEMORY_LIMIT_EXCEEDED (const location_type& l)
+      {
+        return symbol_type (token::TOK_VARIABLE_MSC_MEMORY_LIMIT_EXCEEDED, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_VARIABLE_MSC_TIME_BUDGET_EXCEEDED (location_type l)
+      {
+        return symbol_type (token::TOK_VARIABLE_MSC_TIME_BUDGET_EXCEEDED, std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_VARIABLE_MSC_TIME_BUDGET_EXCEEDED (const location_type& l)
+      {
+        return symbol_type (token::TOK_VARIABLE_MSC_TIME_BUDGET_EXCEEDED, l);
+      }
+#endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
@@ -4724,6 +4969,21 @@ switch (yykind)
         return symbol_type (token::TOK_JSON, l);
       }
 #endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_MSGPACK (location_type l)
+      {
+        return symbol_type (token::TOK_MSGPACK, std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_MSGPACK (const location_type& l)
+      {
+        return symbol_type (token::TOK_MSGPACK, l);
+      }
+#endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
@@ -4889,6 +5149,21 @@ switch (yykind)
         return symbol_type (token::TOK_ACTION_CTL_AUDIT_LOG_PARTS, v, l);
       }
 #endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_ACTION_CTL_BDY_GRPC (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_ACTION_CTL_BDY_GRPC, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_ACTION_CTL_BDY_GRPC (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_ACTION_CTL_BDY_GRPC, v, l);
+      }
+#endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
@@ -5234,6 +5509,21 @@ switch (yykind)
         return symbol_type (token::TOK_ACTION_NO_LOG, v, l);
       }
 #endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_ACTION_NO_VERDICT_CACHE (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_ACTION_NO_VERDICT_CACHE, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_ACTION_NO_VERDICT_CACHE (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_ACTION_NO_VERDICT_CACHE, v, l);
+      }
+#endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
@@ -6194,6 +6484,21 @@ switch (yykind)
         return symbol_type (token::TOK_CONFIG_SEC_SERVER_SIG, v, l);
       }
 #endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_DIR_AUDIT_COMPRESSION_LEVEL (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_AUDIT_COMPRESSION_LEVEL, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_DIR_AUDIT_COMPRESSION_LEVEL (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_AUDIT_COMPRESSION_LEVEL, v, l);
+      }
+#endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
@@ -6299,6 +6604,21 @@ switch (yykind)
         return symbol_type (token::TOK_CONFIG_DIR_AUDIT_LOG_P, v, l);
       }
 #endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_DIR_AUDIT_RATE_LIMIT (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_AUDIT_RATE_LIMIT, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_DIR_AUDIT_RATE_LIMIT (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_AUDIT_RATE_LIMIT, v, l);
+      }
+#endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
@@ -6314,6 +6634,21 @@ switch (yykind)
         return symbol_type (token::TOK_CONFIG_DIR_AUDIT_STS, v, l);
       }
 #endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_DIR_AUDIT_TIMINGS (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_AUDIT_TIMINGS, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_DIR_AUDIT_TIMINGS (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_AUDIT_TIMINGS, v, l);
+      }
+#endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
@@ -6527,427 +6862,967 @@ switch (yykind)
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
-      make_CONFIG_DIR_PCRE_MATCH_LIMIT (std::string v, location_type l)
+      make_CONFIG_DIR_DATA_RELOAD_INTERVAL (std::string v, location_type l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_PCRE_MATCH_LIMIT, std::move (v), std::move (l));
+        return symbol_type (token::TOK_CONFIG_DIR_DATA_RELOAD_INTERVAL, std::move (v), std::move (l));
       }
 #else
       static
       symbol_type
-      make_CONFIG_DIR_PCRE_MATCH_LIMIT (const std::string& v, const location_type& l)
+      make_CONFIG_DIR_DATA_RELOAD_INTERVAL (const std::string& v, const location_type& l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_PCRE_MATCH_LIMIT, v, l);
+        return symbol_type (token::TOK_CONFIG_DIR_DATA_RELOAD_INTERVAL, v, l);
       }
 #endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
-      make_CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION (std::string v, location_type l)
+      make_CONFIG_DIR_LUA_STATE_POOL_LIMIT (std::string v, location_type l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION, std::move (v), std::move (l));
+        return symbol_type (token::TOK_CONFIG_DIR_LUA_STATE_POOL_LIMIT, std::move (v), std::move (l));
       }
 #else
       static
       symbol_type
-      make_CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION (const std::string& v, const location_type& l)
+      make_CONFIG_DIR_LUA_STATE_POOL_LIMIT (const std::string& v, const location_type& l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION, v, l);
+        return symbol_type (token::TOK_CONFIG_DIR_LUA_STATE_POOL_LIMIT, v, l);
       }
 #endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
-      make_CONFIG_SEC_CONN_R_STATE_LIMIT (std::string v, location_type l)
+      make_CONFIG_DIR_OVERLOAD_DETECTION_ONLY (std::string v, location_type l)
       {
-        return symbol_type (token::TOK_CONFIG_SEC_CONN_R_STATE_LIMIT, std::move (v), std::move (l));
+        return symbol_type (token::TOK_CONFIG_DIR_OVERLOAD_DETECTION_ONLY, std::move (v), std::move (l));
       }
 #else
       static
       symbol_type
-      make_CONFIG_SEC_CONN_R_STATE_LIMIT (const std::string& v, const location_type& l)
+      make_CONFIG_DIR_OVERLOAD_DETECTION_ONLY (const std::string& v, const location_type& l)
       {
-        return symbol_type (token::TOK_CONFIG_SEC_CONN_R_STATE_LIMIT, v, l);
+        return symbol_type (token::TOK_CONFIG_DIR_OVERLOAD_DETECTION_ONLY, v, l);
       }
 #endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
-      make_CONFIG_SEC_CONN_W_STATE_LIMIT (std::string v, location_type l)
+      make_CONFIG_DIR_OVERLOAD_SHED_TAG (std::string v, location_type l)
       {
-        return symbol_type (token::TOK_CONFIG_SEC_CONN_W_STATE_LIMIT, std::move (v), std::move (l));
+        return symbol_type (token::TOK_CONFIG_DIR_OVERLOAD_SHED_TAG, std::move (v), std::move (l));
       }
 #else
       static
       symbol_type
-      make_CONFIG_SEC_CONN_W_STATE_LIMIT (const std::string& v, const location_type& l)
+      make_CONFIG_DIR_OVERLOAD_SHED_TAG (const std::string& v, const location_type& l)
       {
-        return symbol_type (token::TOK_CONFIG_SEC_CONN_W_STATE_LIMIT, v, l);
+        return symbol_type (token::TOK_CONFIG_DIR_OVERLOAD_SHED_TAG, v, l);
       }
 #endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
-      make_CONFIG_SEC_SENSOR_ID (std::string v, location_type l)
+      make_CONFIG_DIR_OVERLOAD_TARGET (std::string v, location_type l)
       {
-        return symbol_type (token::TOK_CONFIG_SEC_SENSOR_ID, std::move (v), std::move (l));
+        return symbol_type (token::TOK_CONFIG_DIR_OVERLOAD_TARGET, std::move (v), std::move (l));
       }
 #else
       static
       symbol_type
-      make_CONFIG_SEC_SENSOR_ID (const std::string& v, const location_type& l)
+      make_CONFIG_DIR_OVERLOAD_TARGET (const std::string& v, const location_type& l)
       {
-        return symbol_type (token::TOK_CONFIG_SEC_SENSOR_ID, v, l);
+        return symbol_type (token::TOK_CONFIG_DIR_OVERLOAD_TARGET, v, l);
       }
 #endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
-      make_CONFIG_DIR_ARGS_LIMIT (std::string v, location_type l)
+      make_CONFIG_DIR_PCRE_JIT_STACK_SIZE (std::string v, location_type l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_ARGS_LIMIT, std::move (v), std::move (l));
+        return symbol_type (token::TOK_CONFIG_DIR_PCRE_JIT_STACK_SIZE, std::move (v), std::move (l));
       }
 #else
       static
       symbol_type
-      make_CONFIG_DIR_ARGS_LIMIT (const std::string& v, const location_type& l)
+      make_CONFIG_DIR_PCRE_JIT_STACK_SIZE (const std::string& v, const location_type& l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_ARGS_LIMIT, v, l);
+        return symbol_type (token::TOK_CONFIG_DIR_PCRE_JIT_STACK_SIZE, v, l);
       }
 #endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
-      make_CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT (std::string v, location_type l)
+      make_CONFIG_DIR_PCRE_MATCH_LIMIT (std::string v, location_type l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT, std::move (v), std::move (l));
+        return symbol_type (token::TOK_CONFIG_DIR_PCRE_MATCH_LIMIT, std::move (v), std::move (l));
       }
 #else
       static
       symbol_type
-      make_CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT (const std::string& v, const location_type& l)
+      make_CONFIG_DIR_PCRE_MATCH_LIMIT (const std::string& v, const location_type& l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT, v, l);
+        return symbol_type (token::TOK_CONFIG_DIR_PCRE_MATCH_LIMIT, v, l);
       }
 #endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
-      make_CONFIG_DIR_REQ_BODY (std::string v, location_type l)
+      make_CONFIG_DIR_RBL_TIMEOUT (std::string v, location_type l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_REQ_BODY, std::move (v), std::move (l));
+        return symbol_type (token::TOK_CONFIG_DIR_RBL_TIMEOUT, std::move (v), std::move (l));
       }
 #else
       static
       symbol_type
-      make_CONFIG_DIR_REQ_BODY (const std::string& v, const location_type& l)
+      make_CONFIG_DIR_RBL_TIMEOUT (const std::string& v, const location_type& l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_REQ_BODY, v, l);
+        return symbol_type (token::TOK_CONFIG_DIR_RBL_TIMEOUT, v, l);
       }
 #endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
-      make_CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT (std::string v, location_type l)
+      make_CONFIG_DIR_RULE_EARLY_DECISION (std::string v, location_type l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT, std::move (v), std::move (l));
+        return symbol_type (token::TOK_CONFIG_DIR_RULE_EARLY_DECISION, std::move (v), std::move (l));
       }
 #else
       static
       symbol_type
-      make_CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT (const std::string& v, const location_type& l)
+      make_CONFIG_DIR_RULE_EARLY_DECISION (const std::string& v, const location_type& l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT, v, l);
+        return symbol_type (token::TOK_CONFIG_DIR_RULE_EARLY_DECISION, v, l);
       }
 #endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
-      make_CONFIG_DIR_REQ_BODY_LIMIT (std::string v, location_type l)
+      make_CONFIG_DIR_RULE_EVALUATION_THREADS (std::string v, location_type l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_REQ_BODY_LIMIT, std::move (v), std::move (l));
+        return symbol_type (token::TOK_CONFIG_DIR_RULE_EVALUATION_THREADS, std::move (v), std::move (l));
       }
 #else
       static
       symbol_type
-      make_CONFIG_DIR_REQ_BODY_LIMIT (const std::string& v, const location_type& l)
+      make_CONFIG_DIR_RULE_EVALUATION_THREADS (const std::string& v, const location_type& l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_REQ_BODY_LIMIT, v, l);
+        return symbol_type (token::TOK_CONFIG_DIR_RULE_EVALUATION_THREADS, v, l);
       }
 #endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
-      make_CONFIG_DIR_REQ_BODY_LIMIT_ACTION (std::string v, location_type l)
+      make_CONFIG_DIR_RULE_ENG_SAMPLE_RATE (std::string v, location_type l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_REQ_BODY_LIMIT_ACTION, std::move (v), std::move (l));
+        return symbol_type (token::TOK_CONFIG_DIR_RULE_ENG_SAMPLE_RATE, std::move (v), std::move (l));
       }
 #else
       static
       symbol_type
-      make_CONFIG_DIR_REQ_BODY_LIMIT_ACTION (const std::string& v, const location_type& l)
+      make_CONFIG_DIR_RULE_ENG_SAMPLE_RATE (const std::string& v, const location_type& l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_REQ_BODY_LIMIT_ACTION, v, l);
+        return symbol_type (token::TOK_CONFIG_DIR_RULE_ENG_SAMPLE_RATE, v, l);
       }
 #endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
-      make_CONFIG_DIR_REQ_BODY_NO_FILES_LIMIT (std::string v, location_type l)
+      make_CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE (std::string v, location_type l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_REQ_BODY_NO_FILES_LIMIT, std::move (v), std::move (l));
+        return symbol_type (token::TOK_CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE, std::move (v), std::move (l));
       }
 #else
       static
       symbol_type
-      make_CONFIG_DIR_REQ_BODY_NO_FILES_LIMIT (const std::string& v, const location_type& l)
+      make_CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE (const std::string& v, const location_type& l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_REQ_BODY_NO_FILES_LIMIT, v, l);
+        return symbol_type (token::TOK_CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE, v, l);
       }
 #endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
-      make_CONFIG_DIR_RES_BODY (std::string v, location_type l)
+      make_CONFIG_DIR_RX_GUARDRAIL (std::string v, location_type l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_RES_BODY, std::move (v), std::move (l));
+        return symbol_type (token::TOK_CONFIG_DIR_RX_GUARDRAIL, std::move (v), std::move (l));
       }
 #else
       static
       symbol_type
-      make_CONFIG_DIR_RES_BODY (const std::string& v, const location_type& l)
+      make_CONFIG_DIR_RX_GUARDRAIL (const std::string& v, const location_type& l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_RES_BODY, v, l);
+        return symbol_type (token::TOK_CONFIG_DIR_RX_GUARDRAIL, v, l);
       }
 #endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
-      make_CONFIG_DIR_RES_BODY_LIMIT (std::string v, location_type l)
+      make_CONFIG_DIR_REGEX_CACHE_FILE (std::string v, location_type l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_RES_BODY_LIMIT, std::move (v), std::move (l));
+        return symbol_type (token::TOK_CONFIG_DIR_REGEX_CACHE_FILE, std::move (v), std::move (l));
       }
 #else
       static
       symbol_type
-      make_CONFIG_DIR_RES_BODY_LIMIT (const std::string& v, const location_type& l)
+      make_CONFIG_DIR_REGEX_CACHE_FILE (const std::string& v, const location_type& l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_RES_BODY_LIMIT, v, l);
+        return symbol_type (token::TOK_CONFIG_DIR_REGEX_CACHE_FILE, v, l);
       }
 #endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
-      make_CONFIG_DIR_RES_BODY_LIMIT_ACTION (std::string v, location_type l)
+      make_CONFIG_DIR_RULE_NATIVE_MODULE (std::string v, location_type l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_RES_BODY_LIMIT_ACTION, std::move (v), std::move (l));
+        return symbol_type (token::TOK_CONFIG_DIR_RULE_NATIVE_MODULE, std::move (v), std::move (l));
       }
 #else
       static
       symbol_type
-      make_CONFIG_DIR_RES_BODY_LIMIT_ACTION (const std::string& v, const location_type& l)
+      make_CONFIG_DIR_RULE_NATIVE_MODULE (const std::string& v, const location_type& l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_RES_BODY_LIMIT_ACTION, v, l);
+        return symbol_type (token::TOK_CONFIG_DIR_RULE_NATIVE_MODULE, v, l);
       }
 #endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
-      make_CONFIG_SEC_RULE_INHERITANCE (std::string v, location_type l)
+      make_CONFIG_DIR_SHADOW_RULES (std::string v, location_type l)
       {
-        return symbol_type (token::TOK_CONFIG_SEC_RULE_INHERITANCE, std::move (v), std::move (l));
+        return symbol_type (token::TOK_CONFIG_DIR_SHADOW_RULES, std::move (v), std::move (l));
       }
 #else
       static
       symbol_type
-      make_CONFIG_SEC_RULE_INHERITANCE (const std::string& v, const location_type& l)
+      make_CONFIG_DIR_SHADOW_RULES (const std::string& v, const location_type& l)
       {
-        return symbol_type (token::TOK_CONFIG_SEC_RULE_INHERITANCE, v, l);
+        return symbol_type (token::TOK_CONFIG_DIR_SHADOW_RULES, v, l);
       }
 #endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
-      make_CONFIG_SEC_RULE_PERF_TIME (std::string v, location_type l)
+      make_CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION (std::string v, location_type l)
       {
-        return symbol_type (token::TOK_CONFIG_SEC_RULE_PERF_TIME, std::move (v), std::move (l));
+        return symbol_type (token::TOK_CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION, std::move (v), std::move (l));
       }
 #else
       static
       symbol_type
-      make_CONFIG_SEC_RULE_PERF_TIME (const std::string& v, const location_type& l)
+      make_CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION (const std::string& v, const location_type& l)
       {
-        return symbol_type (token::TOK_CONFIG_SEC_RULE_PERF_TIME, v, l);
+        return symbol_type (token::TOK_CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION, v, l);
       }
 #endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
-      make_CONFIG_DIR_RULE_ENG (std::string v, location_type l)
+      make_CONFIG_SEC_CONN_R_STATE_LIMIT (std::string v, location_type l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_RULE_ENG, std::move (v), std::move (l));
+        return symbol_type (token::TOK_CONFIG_SEC_CONN_R_STATE_LIMIT, std::move (v), std::move (l));
       }
 #else
       static
       symbol_type
-      make_CONFIG_DIR_RULE_ENG (const std::string& v, const location_type& l)
+      make_CONFIG_SEC_CONN_R_STATE_LIMIT (const std::string& v, const location_type& l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_RULE_ENG, v, l);
+        return symbol_type (token::TOK_CONFIG_SEC_CONN_R_STATE_LIMIT, v, l);
       }
 #endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
-      make_CONFIG_DIR_SEC_ACTION (std::string v, location_type l)
+      make_CONFIG_SEC_CONN_W_STATE_LIMIT (std::string v, location_type l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_SEC_ACTION, std::move (v), std::move (l));
+        return symbol_type (token::TOK_CONFIG_SEC_CONN_W_STATE_LIMIT, std::move (v), std::move (l));
       }
 #else
       static
       symbol_type
-      make_CONFIG_DIR_SEC_ACTION (const std::string& v, const location_type& l)
+      make_CONFIG_SEC_CONN_W_STATE_LIMIT (const std::string& v, const location_type& l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_SEC_ACTION, v, l);
+        return symbol_type (token::TOK_CONFIG_SEC_CONN_W_STATE_LIMIT, v, l);
       }
 #endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
-      make_CONFIG_DIR_SEC_DEFAULT_ACTION (std::string v, location_type l)
+      make_CONFIG_SEC_SENSOR_ID (std::string v, location_type l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_SEC_DEFAULT_ACTION, std::move (v), std::move (l));
+        return symbol_type (token::TOK_CONFIG_SEC_SENSOR_ID, std::move (v), std::move (l));
       }
 #else
       static
       symbol_type
-      make_CONFIG_DIR_SEC_DEFAULT_ACTION (const std::string& v, const location_type& l)
+      make_CONFIG_SEC_SENSOR_ID (const std::string& v, const location_type& l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_SEC_DEFAULT_ACTION, v, l);
+        return symbol_type (token::TOK_CONFIG_SEC_SENSOR_ID, v, l);
       }
 #endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
-      make_CONFIG_DIR_SEC_MARKER (std::string v, location_type l)
+      make_CONFIG_DIR_ARGS_LIMIT (std::string v, location_type l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_SEC_MARKER, std::move (v), std::move (l));
+        return symbol_type (token::TOK_CONFIG_DIR_ARGS_LIMIT, std::move (v), std::move (l));
       }
 #else
       static
       symbol_type
-      make_CONFIG_DIR_SEC_MARKER (const std::string& v, const location_type& l)
+      make_CONFIG_DIR_ARGS_LIMIT (const std::string& v, const location_type& l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_SEC_MARKER, v, l);
+        return symbol_type (token::TOK_CONFIG_DIR_ARGS_LIMIT, v, l);
       }
 #endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
-      make_CONFIG_DIR_UNICODE_MAP_FILE (std::string v, location_type l)
+      make_CONFIG_DIR_REQ_BODY_DECOMPRESSION (std::string v, location_type l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_UNICODE_MAP_FILE, std::move (v), std::move (l));
+        return symbol_type (token::TOK_CONFIG_DIR_REQ_BODY_DECOMPRESSION, std::move (v), std::move (l));
       }
 #else
       static
       symbol_type
-      make_CONFIG_DIR_UNICODE_MAP_FILE (const std::string& v, const location_type& l)
+      make_CONFIG_DIR_REQ_BODY_DECOMPRESSION (const std::string& v, const location_type& l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_UNICODE_MAP_FILE, v, l);
+        return symbol_type (token::TOK_CONFIG_DIR_REQ_BODY_DECOMPRESSION, v, l);
       }
 #endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
-      make_CONFIG_DIR_UNICODE_CODE_PAGE (std::string v, location_type l)
+      make_CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO (std::string v, location_type l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_UNICODE_CODE_PAGE, std::move (v), std::move (l));
+        return symbol_type (token::TOK_CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO, std::move (v), std::move (l));
       }
 #else
       static
       symbol_type
-      make_CONFIG_DIR_UNICODE_CODE_PAGE (const std::string& v, const location_type& l)
+      make_CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO (const std::string& v, const location_type& l)
       {
-        return symbol_type (token::TOK_CONFIG_DIR_UNICODE_CODE_PAGE, v, l);
+        return symbol_type (token::TOK_CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO, v, l);
       }
 #endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
-      make_CONFIG_SEC_COLLECTION_TIMEOUT (std::string v, location_type l)
+      make_CONFIG_DIR_RES_BODY_DECOMPRESSION (std::string v, location_type l)
       {
-        return symbol_type (token::TOK_CONFIG_SEC_COLLECTION_TIMEOUT, std::move (v), std::move (l));
+        return symbol_type (token::TOK_CONFIG_DIR_RES_BODY_DECOMPRESSION, std::move (v), std::move (l));
       }
 #else
       static
       symbol_type
-      make_CONFIG_SEC_COLLECTION_TIMEOUT (const std::string& v, const location_type& l)
+      make_CONFIG_DIR_RES_BODY_DECOMPRESSION (const std::string& v, const location_type& l)
       {
-        return symbol_type (token::TOK_CONFIG_SEC_COLLECTION_TIMEOUT, v, l);
+        return symbol_type (token::TOK_CONFIG_DIR_RES_BODY_DECOMPRESSION, v, l);
       }
 #endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
-      make_CONFIG_SEC_HTTP_BLKEY (std::string v, location_type l)
+      make_CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT (std::string v, location_type l)
       {
-        return symbol_type (token::TOK_CONFIG_SEC_HTTP_BLKEY, std::move (v), std::move (l));
+        return symbol_type (token::TOK_CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT, std::move (v), std::move (l));
       }
 #else
       static
       symbol_type
-      make_CONFIG_SEC_HTTP_BLKEY (const std::string& v, const location_type& l)
+      make_CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT (const std::string& v, const location_type& l)
       {
-        return symbol_type (token::TOK_CONFIG_SEC_HTTP_BLKEY, v, l);
+        return symbol_type (token::TOK_CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT, v, l);
       }
 #endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
-      make_CONFIG_SEC_INTERCEPT_ON_ERROR (std::string v, location_type l)
+      make_CONFIG_DIR_REQ_BODY_JSON_SIMD (std::string v, location_type l)
       {
-        return symbol_type (token::TOK_CONFIG_SEC_INTERCEPT_ON_ERROR, std::move (v), std::move (l));
+        return symbol_type (token::TOK_CONFIG_DIR_REQ_BODY_JSON_SIMD, std::move (v), std::move (l));
       }
 #else
       static
       symbol_type
-      make_CONFIG_SEC_INTERCEPT_ON_ERROR (const std::string& v, const location_type& l)
+      make_CONFIG_DIR_REQ_BODY_JSON_SIMD (const std::string& v, const location_type& l)
       {
-        return symbol_type (token::TOK_CONFIG_SEC_INTERCEPT_ON_ERROR, v, l);
+        return symbol_type (token::TOK_CONFIG_DIR_REQ_BODY_JSON_SIMD, v, l);
       }
 #endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
-      make_CONFIG_SEC_REMOTE_RULES_FAIL_ACTION (std::string v, location_type l)
+      make_CONFIG_DIR_REQ_BODY (std::string v, location_type l)
       {
-        return symbol_type (token::TOK_CONFIG_SEC_REMOTE_RULES_FAIL_ACTION, std::move (v), std::move (l));
+        return symbol_type (token::TOK_CONFIG_DIR_REQ_BODY, std::move (v), std::move (l));
       }
 #else
       static
       symbol_type
-      make_CONFIG_SEC_REMOTE_RULES_FAIL_ACTION (const std::string& v, const location_type& l)
+      make_CONFIG_DIR_REQ_BODY (const std::string& v, const location_type& l)
       {
-        return symbol_type (token::TOK_CONFIG_SEC_REMOTE_RULES_FAIL_ACTION, v, l);
+        return symbol_type (token::TOK_CONFIG_DIR_REQ_BODY, v, l);
       }
 #endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
-      make_CONFIG_SEC_RULE_REMOVE_BY_ID (std::string v, location_type l)
+      make_CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT (std::string v, location_type l)
       {
-        return symbol_type (token::TOK_CONFIG_SEC_RULE_REMOVE_BY_ID, std::move (v), std::move (l));
+        return symbol_type (token::TOK_CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT, std::move (v), std::move (l));
       }
 #else
       static
       symbol_type
-      make_CONFIG_SEC_RULE_REMOVE_BY_ID (const std::string& v, const location_type& l)
+      make_CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT (const std::string& v, const location_type& l)
       {
-        return symbol_type (token::TOK_CONFIG_SEC_RULE_REMOVE_BY_ID, v, l);
+        return symbol_type (token::TOK_CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT, v, l);
       }
 #endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
-      make_CONFIG_SEC_RULE_REMOVE_BY_MSG (std::string v, location_type l)
+      make_CONFIG_DIR_REQ_BODY_LIMIT (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_REQ_BODY_LIMIT, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_DIR_REQ_BODY_LIMIT (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_REQ_BODY_LIMIT, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_DIR_REQ_BODY_LIMIT_ACTION (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_REQ_BODY_LIMIT_ACTION, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_DIR_REQ_BODY_LIMIT_ACTION (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_REQ_BODY_LIMIT_ACTION, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_DIR_REQ_BODY_NO_FILES_LIMIT (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_REQ_BODY_NO_FILES_LIMIT, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_DIR_REQ_BODY_NO_FILES_LIMIT (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_REQ_BODY_NO_FILES_LIMIT, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_DIR_RES_BODY (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_RES_BODY, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_DIR_RES_BODY (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_RES_BODY, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_DIR_RES_BODY_LIMIT (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_RES_BODY_LIMIT, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_DIR_RES_BODY_LIMIT (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_RES_BODY_LIMIT, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_DIR_RES_BODY_LIMIT_ACTION (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_RES_BODY_LIMIT_ACTION, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_DIR_RES_BODY_LIMIT_ACTION (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_RES_BODY_LIMIT_ACTION, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_DIR_RES_BODY_STREAM_WINDOW (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_RES_BODY_STREAM_WINDOW, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_DIR_RES_BODY_STREAM_WINDOW (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_RES_BODY_STREAM_WINDOW, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_SEC_RULE_INHERITANCE (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_RULE_INHERITANCE, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_SEC_RULE_INHERITANCE (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_RULE_INHERITANCE, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_SEC_RULE_PERF_TIME (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_RULE_PERF_TIME, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_SEC_RULE_PERF_TIME (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_RULE_PERF_TIME, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_SEC_RULE_PROFILING (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_RULE_PROFILING, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_SEC_RULE_PROFILING (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_RULE_PROFILING, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_SEC_RULE_VALUE_MAJOR (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_RULE_VALUE_MAJOR, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_SEC_RULE_VALUE_MAJOR (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_RULE_VALUE_MAJOR, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_SEC_RX_PREFILTER (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_RX_PREFILTER, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_SEC_RX_PREFILTER (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_RX_PREFILTER, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_SEC_RX_RE2 (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_RX_RE2, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_SEC_RX_RE2 (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_RX_RE2, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_DIR_RULE_ENG (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_RULE_ENG, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_DIR_RULE_ENG (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_RULE_ENG, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_DIR_SEC_ACTION (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_SEC_ACTION, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_DIR_SEC_ACTION (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_SEC_ACTION, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_DIR_SEC_DEFAULT_ACTION (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_SEC_DEFAULT_ACTION, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_DIR_SEC_DEFAULT_ACTION (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_SEC_DEFAULT_ACTION, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_DIR_SEC_MARKER (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_SEC_MARKER, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_DIR_SEC_MARKER (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_SEC_MARKER, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_DIR_UNICODE_MAP_FILE (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_UNICODE_MAP_FILE, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_DIR_UNICODE_MAP_FILE (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_UNICODE_MAP_FILE, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_DIR_UNICODE_CODE_PAGE (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_UNICODE_CODE_PAGE, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_DIR_UNICODE_CODE_PAGE (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_DIR_UNICODE_CODE_PAGE, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_SEC_COLLECTION_GROUP_COMMIT (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_COLLECTION_GROUP_COMMIT, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_SEC_COLLECTION_GROUP_COMMIT (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_COLLECTION_GROUP_COMMIT, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_SEC_COLLECTION_REDIS_SERVER (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_COLLECTION_REDIS_SERVER, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_SEC_COLLECTION_REDIS_SERVER (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_COLLECTION_REDIS_SERVER, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_SEC_COLLECTION_SYNC_MODE (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_COLLECTION_SYNC_MODE, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_SEC_COLLECTION_SYNC_MODE (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_COLLECTION_SYNC_MODE, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_SEC_COLLECTION_TIMEOUT (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_COLLECTION_TIMEOUT, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_SEC_COLLECTION_TIMEOUT (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_COLLECTION_TIMEOUT, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_SEC_TRANSACTION_ID_FORMAT (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_TRANSACTION_ID_FORMAT, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_SEC_TRANSACTION_ID_FORMAT (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_TRANSACTION_ID_FORMAT, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_SEC_TRANSACTION_MEMORY_LIMIT (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_TRANSACTION_MEMORY_LIMIT, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_SEC_TRANSACTION_MEMORY_LIMIT (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_TRANSACTION_MEMORY_LIMIT, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_SEC_TRANSACTION_TIME_BUDGET (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_TRANSACTION_TIME_BUDGET, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_SEC_TRANSACTION_TIME_BUDGET (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_TRANSACTION_TIME_BUDGET, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_SEC_VERDICT_CACHE (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_VERDICT_CACHE, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_SEC_VERDICT_CACHE (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_VERDICT_CACHE, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_SEC_DEBUG_LOG_BUFFER (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_DEBUG_LOG_BUFFER, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_SEC_DEBUG_LOG_BUFFER (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_DEBUG_LOG_BUFFER, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_SEC_DEBUG_LOG_FILTER (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_DEBUG_LOG_FILTER, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_SEC_DEBUG_LOG_FILTER (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_DEBUG_LOG_FILTER, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_SEC_HTTP_BLKEY (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_HTTP_BLKEY, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_SEC_HTTP_BLKEY (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_HTTP_BLKEY, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_SEC_HUGE_PAGES (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_HUGE_PAGES, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_SEC_HUGE_PAGES (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_HUGE_PAGES, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_SEC_INTERCEPT_ON_ERROR (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_INTERCEPT_ON_ERROR, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_SEC_INTERCEPT_ON_ERROR (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_INTERCEPT_ON_ERROR, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_SEC_REMOTE_RULES_CACHE_DIR (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_REMOTE_RULES_CACHE_DIR, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_SEC_REMOTE_RULES_CACHE_DIR (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_REMOTE_RULES_CACHE_DIR, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_SEC_REMOTE_RULES_FAIL_ACTION (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_REMOTE_RULES_FAIL_ACTION, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_SEC_REMOTE_RULES_FAIL_ACTION (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_REMOTE_RULES_FAIL_ACTION, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_SEC_RULE_REMOVE_BY_ID (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_RULE_REMOVE_BY_ID, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_SEC_RULE_REMOVE_BY_ID (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_SEC_RULE_REMOVE_BY_ID, v, l);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_SEC_RULE_REMOVE_BY_MSG (std::string v, location_type l)
       {
         return symbol_type (token::TOK_CONFIG_SEC_RULE_REMOVE_BY_MSG, std::move (v), std::move (l));
       }
@@ -7064,6 +7939,21 @@ switch (yykind)
         return symbol_type (token::TOK_CONFIG_UPDLOAD_SAVE_TMP_FILES, v, l);
       }
 #endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_UPLOAD_ANONYMOUS_FILES (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_UPLOAD_ANONYMOUS_FILES, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_UPLOAD_ANONYMOUS_FILES (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_UPLOAD_ANONYMOUS_FILES, v, l);
+      }
+#endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
@@ -7109,6 +7999,21 @@ switch (yykind)
         return symbol_type (token::TOK_CONFIG_UPLOAD_FILE_MODE, v, l);
       }
 #endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_UPLOAD_IN_MEMORY_LIMIT (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_UPLOAD_IN_MEMORY_LIMIT, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_UPLOAD_IN_MEMORY_LIMIT (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_UPLOAD_IN_MEMORY_LIMIT, v, l);
+      }
+#endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
@@ -7244,6 +8149,21 @@ switch (yykind)
         return symbol_type (token::TOK_CONFIG_VALUE_RELEVANT_ONLY, v, l);
       }
 #endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_VALUE_RING (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_VALUE_RING, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_VALUE_RING (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_VALUE_RING, v, l);
+      }
+#endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
@@ -7259,6 +8179,21 @@ switch (yykind)
         return symbol_type (token::TOK_CONFIG_VALUE_SERIAL, v, l);
       }
 #endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONFIG_VALUE_STREAM (std::string v, location_type l)
+      {
+        return symbol_type (token::TOK_CONFIG_VALUE_STREAM, std::move (v), std::move (l));
+      }
+#else
+      static
+      symbol_type
+      make_CONFIG_VALUE_STREAM (const std::string& v, const location_type& l)
+      {
+        return symbol_type (token::TOK_CONFIG_VALUE_STREAM, v, l);
+      }
+#endif
 #if 201103L <= YY_CPLUSPLUS
       static
       symbol_type
@@ -8069,9 +9004,9 @@ switch (yykind)
     /// Constants.
     enum
     {
-      yylast_ = 3372,     ///< Last index in yytable_.
+      yylast_ = 3783,     ///< Last index in yytable_.
       yynnts_ = 16,  ///< Number of nonterminal symbols.
-      yyfinal_ = 341 ///< Termination state number.
+      yyfinal_ = 407 ///< Termination state number.
     };
 
 
@@ -8150,10 +9085,15 @@ switch (yykind)
      315,   316,   317,   318,   319,   320,   321,   322,   323,   324,
      325,   326,   327,   328,   329,   330,   331,   332,   333,   334,
      335,   336,   337,   338,   339,   340,   341,   342,   343,   344,
-     345,   346,   347
+     345,   346,   347,   348,   349,   350,   351,   352,   353,   354,
+     355,   356,   357,   358,   359,   360,   361,   362,   363,   364,
+     365,   366,   367,   368,   369,   370,   371,   372,   373,   374,
+     375,   376,   377,   378,   379,   380,   381,   382,   383,   384,
+     385,   386,   387,   388,   389,   390,   391,   392,   393,   394,
+     395
     };
     // Last valid token kind.
-    const int code_max = 602;
+    const int code_max = 650;
 
     if (t <= 0)
       return symbol_kind::S_YYEOF;
@@ -8181,6 +9121,7 @@ switch (yykind)
       case symbol_kind::S_ACTION_CHAIN: // "Chain"
       case symbol_kind::S_ACTION_CTL_AUDIT_ENGINE: // "ACTION_CTL_AUDIT_ENGINE"
       case symbol_kind::S_ACTION_CTL_AUDIT_LOG_PARTS: // "ACTION_CTL_AUDIT_LOG_PARTS"
+      case symbol_kind::S_ACTION_CTL_BDY_GRPC: // "ACTION_CTL_BDY_GRPC"
       case symbol_kind::S_ACTION_CTL_BDY_JSON: // "ACTION_CTL_BDY_JSON"
       case symbol_kind::S_ACTION_CTL_BDY_XML: // "ACTION_CTL_BDY_XML"
       case symbol_kind::S_ACTION_CTL_BDY_URLENCODED: // "ACTION_CTL_BDY_URLENCODED"
@@ -8204,6 +9145,7 @@ switch (yykind)
       case symbol_kind::S_ACTION_MULTI_MATCH: // "MultiMatch"
       case symbol_kind::S_ACTION_NO_AUDIT_LOG: // "NoAuditLog"
       case symbol_kind::S_ACTION_NO_LOG: // "NoLog"
+      case symbol_kind::S_ACTION_NO_VERDICT_CACHE: // "NoVerdictCache"
       case symbol_kind::S_ACTION_PASS: // "Pass"
       case symbol_kind::S_ACTION_PAUSE: // "Pause"
       case symbol_kind::S_ACTION_PHASE: // "Phase"
@@ -8268,6 +9210,7 @@ switch (yykind)
       case symbol_kind::S_CONFIG_SEC_ARGUMENT_SEPARATOR: // "CONFIG_SEC_ARGUMENT_SEPARATOR"
       case symbol_kind::S_CONFIG_SEC_WEB_APP_ID: // "CONFIG_SEC_WEB_APP_ID"
       case symbol_kind::S_CONFIG_SEC_SERVER_SIG: // "CONFIG_SEC_SERVER_SIG"
+      case symbol_kind::S_CONFIG_DIR_AUDIT_COMPRESSION_LEVEL: // "CONFIG_DIR_AUDIT_COMPRESSION_LEVEL"
       case symbol_kind::S_CONFIG_DIR_AUDIT_DIR: // "CONFIG_DIR_AUDIT_DIR"
       case symbol_kind::S_CONFIG_DIR_AUDIT_DIR_MOD: // "CONFIG_DIR_AUDIT_DIR_MOD"
       case symbol_kind::S_CONFIG_DIR_AUDIT_ENG: // "CONFIG_DIR_AUDIT_ENG"
@@ -8275,7 +9218,9 @@ switch (yykind)
       case symbol_kind::S_CONFIG_DIR_AUDIT_LOG: // "CONFIG_DIR_AUDIT_LOG"
       case symbol_kind::S_CONFIG_DIR_AUDIT_LOG2: // "CONFIG_DIR_AUDIT_LOG2"
       case symbol_kind::S_CONFIG_DIR_AUDIT_LOG_P: // "CONFIG_DIR_AUDIT_LOG_P"
+      case symbol_kind::S_CONFIG_DIR_AUDIT_RATE_LIMIT: // "CONFIG_DIR_AUDIT_RATE_LIMIT"
       case symbol_kind::S_CONFIG_DIR_AUDIT_STS: // "CONFIG_DIR_AUDIT_STS"
+      case symbol_kind::S_CONFIG_DIR_AUDIT_TIMINGS: // "CONFIG_DIR_AUDIT_TIMINGS"
       case symbol_kind::S_CONFIG_DIR_AUDIT_TPE: // "CONFIG_DIR_AUDIT_TPE"
       case symbol_kind::S_CONFIG_DIR_DEBUG_LOG: // "CONFIG_DIR_DEBUG_LOG"
       case symbol_kind::S_CONFIG_DIR_DEBUG_LVL: // "CONFIG_DIR_DEBUG_LVL"
@@ -8290,13 +9235,32 @@ switch (yykind)
       case symbol_kind::S_CONFIG_DIR_GEO_DB: // "CONFIG_DIR_GEO_DB"
       case symbol_kind::S_CONFIG_DIR_GSB_DB: // "CONFIG_DIR_GSB_DB"
       case symbol_kind::S_CONFIG_SEC_GUARDIAN_LOG: // "CONFIG_SEC_GUARDIAN_LOG"
+      case symbol_kind::S_CONFIG_DIR_DATA_RELOAD_INTERVAL: // "CONFIG_DIR_DATA_RELOAD_INTERVAL"
+      case symbol_kind::S_CONFIG_DIR_LUA_STATE_POOL_LIMIT: // "CONFIG_DIR_LUA_STATE_POOL_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_OVERLOAD_DETECTION_ONLY: // "CONFIG_DIR_OVERLOAD_DETECTION_ONLY"
+      case symbol_kind::S_CONFIG_DIR_OVERLOAD_SHED_TAG: // "CONFIG_DIR_OVERLOAD_SHED_TAG"
+      case symbol_kind::S_CONFIG_DIR_OVERLOAD_TARGET: // "CONFIG_DIR_OVERLOAD_TARGET"
+      case symbol_kind::S_CONFIG_DIR_PCRE_JIT_STACK_SIZE: // "CONFIG_DIR_PCRE_JIT_STACK_SIZE"
       case symbol_kind::S_CONFIG_DIR_PCRE_MATCH_LIMIT: // "CONFIG_DIR_PCRE_MATCH_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_RBL_TIMEOUT: // "CONFIG_DIR_RBL_TIMEOUT"
+      case symbol_kind::S_CONFIG_DIR_RULE_EARLY_DECISION: // "CONFIG_DIR_RULE_EARLY_DECISION"
+      case symbol_kind::S_CONFIG_DIR_RULE_EVALUATION_THREADS: // "CONFIG_DIR_RULE_EVALUATION_THREADS"
+      case symbol_kind::S_CONFIG_DIR_RULE_ENG_SAMPLE_RATE: // "CONFIG_DIR_RULE_ENG_SAMPLE_RATE"
+      case symbol_kind::S_CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE: // "CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE"
+      case symbol_kind::S_CONFIG_DIR_RX_GUARDRAIL: // "CONFIG_DIR_RX_GUARDRAIL"
+      case symbol_kind::S_CONFIG_DIR_REGEX_CACHE_FILE: // "CONFIG_DIR_REGEX_CACHE_FILE"
+      case symbol_kind::S_CONFIG_DIR_RULE_NATIVE_MODULE: // "CONFIG_DIR_RULE_NATIVE_MODULE"
+      case symbol_kind::S_CONFIG_DIR_SHADOW_RULES: // "CONFIG_DIR_SHADOW_RULES"
       case symbol_kind::S_CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION: // "CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION"
       case symbol_kind::S_CONFIG_SEC_CONN_R_STATE_LIMIT: // "CONFIG_SEC_CONN_R_STATE_LIMIT"
       case symbol_kind::S_CONFIG_SEC_CONN_W_STATE_LIMIT: // "CONFIG_SEC_CONN_W_STATE_LIMIT"
       case symbol_kind::S_CONFIG_SEC_SENSOR_ID: // "CONFIG_SEC_SENSOR_ID"
       case symbol_kind::S_CONFIG_DIR_ARGS_LIMIT: // "CONFIG_DIR_ARGS_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_REQ_BODY_DECOMPRESSION: // "CONFIG_DIR_REQ_BODY_DECOMPRESSION"
+      case symbol_kind::S_CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO: // "CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO"
+      case symbol_kind::S_CONFIG_DIR_RES_BODY_DECOMPRESSION: // "CONFIG_DIR_RES_BODY_DECOMPRESSION"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT: // "CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_REQ_BODY_JSON_SIMD: // "CONFIG_DIR_REQ_BODY_JSON_SIMD"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY: // "CONFIG_DIR_REQ_BODY"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT: // "CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY_LIMIT: // "CONFIG_DIR_REQ_BODY_LIMIT"
@@ -8305,17 +9269,34 @@ switch (yykind)
       case symbol_kind::S_CONFIG_DIR_RES_BODY: // "CONFIG_DIR_RES_BODY"
       case symbol_kind::S_CONFIG_DIR_RES_BODY_LIMIT: // "CONFIG_DIR_RES_BODY_LIMIT"
       case symbol_kind::S_CONFIG_DIR_RES_BODY_LIMIT_ACTION: // "CONFIG_DIR_RES_BODY_LIMIT_ACTION"
+      case symbol_kind::S_CONFIG_DIR_RES_BODY_STREAM_WINDOW: // "CONFIG_DIR_RES_BODY_STREAM_WINDOW"
       case symbol_kind::S_CONFIG_SEC_RULE_INHERITANCE: // "CONFIG_SEC_RULE_INHERITANCE"
       case symbol_kind::S_CONFIG_SEC_RULE_PERF_TIME: // "CONFIG_SEC_RULE_PERF_TIME"
+      case symbol_kind::S_CONFIG_SEC_RULE_PROFILING: // "CONFIG_SEC_RULE_PROFILING"
+      case symbol_kind::S_CONFIG_SEC_RULE_VALUE_MAJOR: // "CONFIG_SEC_RULE_VALUE_MAJOR"
+      case symbol_kind::S_CONFIG_SEC_RX_PREFILTER: // "CONFIG_SEC_RX_PREFILTER"
+      case symbol_kind::S_CONFIG_SEC_RX_RE2: // "CONFIG_SEC_RX_RE2"
       case symbol_kind::S_CONFIG_DIR_RULE_ENG: // "CONFIG_DIR_RULE_ENG"
       case symbol_kind::S_CONFIG_DIR_SEC_ACTION: // "CONFIG_DIR_SEC_ACTION"
       case symbol_kind::S_CONFIG_DIR_SEC_DEFAULT_ACTION: // "CONFIG_DIR_SEC_DEFAULT_ACTION"
       case symbol_kind::S_CONFIG_DIR_SEC_MARKER: // "CONFIG_DIR_SEC_MARKER"
       case symbol_kind::S_CONFIG_DIR_UNICODE_MAP_FILE: // "CONFIG_DIR_UNICODE_MAP_FILE"
       case symbol_kind::S_CONFIG_DIR_UNICODE_CODE_PAGE: // "CONFIG_DIR_UNICODE_CODE_PAGE"
+      case symbol_kind::S_CONFIG_SEC_COLLECTION_GROUP_COMMIT: // "CONFIG_SEC_COLLECTION_GROUP_COMMIT"
+      case symbol_kind::S_CONFIG_SEC_COLLECTION_REDIS_SERVER: // "CONFIG_SEC_COLLECTION_REDIS_SERVER"
+      case symbol_kind::S_CONFIG_SEC_COLLECTION_SYNC_MODE: // "CONFIG_SEC_COLLECTION_SYNC_MODE"
       case symbol_kind::S_CONFIG_SEC_COLLECTION_TIMEOUT: // "CONFIG_SEC_COLLECTION_TIMEOUT"
+      case symbol_kind::S_CONFIG_SEC_TRANSACTION_ID_FORMAT: // "CONFIG_SEC_TRANSACTION_ID_FORMAT"
+      case symbol_kind::S_CONFIG_SEC_TRANSACTION_MEMORY_LIMIT: // "CONFIG_SEC_TRANSACTION_MEMORY_LIMIT"
+      case symbol_kind::S_CONFIG_SEC_TRANSACTION_TIME_BUDGET: // "CONFIG_SEC_TRANSACTION_TIME_BUDGET"
+      case symbol_kind::S_CONFIG_SEC_VERDICT_CACHE: // "CONFIG_SEC_VERDICT_CACHE"
+      case symbol_kind::S_CONFIG_SEC_DEBUG_LOG_BUFFER: // "CONFIG_SEC_DEBUG_LOG_BUFFER"
+      case symbol_kind::S_CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH: // "CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH"
+      case symbol_kind::S_CONFIG_SEC_DEBUG_LOG_FILTER: // "CONFIG_SEC_DEBUG_LOG_FILTER"
       case symbol_kind::S_CONFIG_SEC_HTTP_BLKEY: // "CONFIG_SEC_HTTP_BLKEY"
+      case symbol_kind::S_CONFIG_SEC_HUGE_PAGES: // "CONFIG_SEC_HUGE_PAGES"
       case symbol_kind::S_CONFIG_SEC_INTERCEPT_ON_ERROR: // "CONFIG_SEC_INTERCEPT_ON_ERROR"
+      case symbol_kind::S_CONFIG_SEC_REMOTE_RULES_CACHE_DIR: // "CONFIG_SEC_REMOTE_RULES_CACHE_DIR"
       case symbol_kind::S_CONFIG_SEC_REMOTE_RULES_FAIL_ACTION: // "CONFIG_SEC_REMOTE_RULES_FAIL_ACTION"
       case symbol_kind::S_CONFIG_SEC_RULE_REMOVE_BY_ID: // "CONFIG_SEC_RULE_REMOVE_BY_ID"
       case symbol_kind::S_CONFIG_SEC_RULE_REMOVE_BY_MSG: // "CONFIG_SEC_RULE_REMOVE_BY_MSG"
@@ -8326,9 +9307,11 @@ switch (yykind)
       case symbol_kind::S_CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID: // "CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID"
       case symbol_kind::S_CONFIG_UPDLOAD_KEEP_FILES: // "CONFIG_UPDLOAD_KEEP_FILES"
       case symbol_kind::S_CONFIG_UPDLOAD_SAVE_TMP_FILES: // "CONFIG_UPDLOAD_SAVE_TMP_FILES"
+      case symbol_kind::S_CONFIG_UPLOAD_ANONYMOUS_FILES: // "CONFIG_UPLOAD_ANONYMOUS_FILES"
       case symbol_kind::S_CONFIG_UPLOAD_DIR: // "CONFIG_UPLOAD_DIR"
       case symbol_kind::S_CONFIG_UPLOAD_FILE_LIMIT: // "CONFIG_UPLOAD_FILE_LIMIT"
       case symbol_kind::S_CONFIG_UPLOAD_FILE_MODE: // "CONFIG_UPLOAD_FILE_MODE"
+      case symbol_kind::S_CONFIG_UPLOAD_IN_MEMORY_LIMIT: // "CONFIG_UPLOAD_IN_MEMORY_LIMIT"
       case symbol_kind::S_CONFIG_VALUE_ABORT: // "CONFIG_VALUE_ABORT"
       case symbol_kind::S_CONFIG_VALUE_DETC: // "CONFIG_VALUE_DETC"
       case symbol_kind::S_CONFIG_VALUE_HTTPS: // "CONFIG_VALUE_HTTPS"
@@ -8338,7 +9321,9 @@ switch (yykind)
       case symbol_kind::S_CONFIG_VALUE_PROCESS_PARTIAL: // "CONFIG_VALUE_PROCESS_PARTIAL"
       case symbol_kind::S_CONFIG_VALUE_REJECT: // "CONFIG_VALUE_REJECT"
       case symbol_kind::S_CONFIG_VALUE_RELEVANT_ONLY: // "CONFIG_VALUE_RELEVANT_ONLY"
+      case symbol_kind::S_CONFIG_VALUE_RING: // "CONFIG_VALUE_RING"
       case symbol_kind::S_CONFIG_VALUE_SERIAL: // "CONFIG_VALUE_SERIAL"
+      case symbol_kind::S_CONFIG_VALUE_STREAM: // "CONFIG_VALUE_STREAM"
       case symbol_kind::S_CONFIG_VALUE_WARN: // "CONFIG_VALUE_WARN"
       case symbol_kind::S_CONFIG_XML_EXTERNAL_ENTITY: // "CONFIG_XML_EXTERNAL_ENTITY"
       case symbol_kind::S_CONGIG_DIR_RESPONSE_BODY_MP: // "CONGIG_DIR_RESPONSE_BODY_MP"
@@ -8443,6 +9428,7 @@ switch (yykind)
       case symbol_kind::S_ACTION_CHAIN: // "Chain"
       case symbol_kind::S_ACTION_CTL_AUDIT_ENGINE: // "ACTION_CTL_AUDIT_ENGINE"
       case symbol_kind::S_ACTION_CTL_AUDIT_LOG_PARTS: // "ACTION_CTL_AUDIT_LOG_PARTS"
+      case symbol_kind::S_ACTION_CTL_BDY_GRPC: // "ACTION_CTL_BDY_GRPC"
       case symbol_kind::S_ACTION_CTL_BDY_JSON: // "ACTION_CTL_BDY_JSON"
       case symbol_kind::S_ACTION_CTL_BDY_XML: // "ACTION_CTL_BDY_XML"
       case symbol_kind::S_ACTION_CTL_BDY_URLENCODED: // "ACTION_CTL_BDY_URLENCODED"
@@ -8466,6 +9452,7 @@ switch (yykind)
       case symbol_kind::S_ACTION_MULTI_MATCH: // "MultiMatch"
       case symbol_kind::S_ACTION_NO_AUDIT_LOG: // "NoAuditLog"
       case symbol_kind::S_ACTION_NO_LOG: // "NoLog"
+      case symbol_kind::S_ACTION_NO_VERDICT_CACHE: // "NoVerdictCache"
       case symbol_kind::S_ACTION_PASS: // "Pass"
       case symbol_kind::S_ACTION_PAUSE: // "Pause"
       case symbol_kind::S_ACTION_PHASE: // "Phase"
@@ -8530,6 +9517,7 @@ switch (yykind)
       case symbol_kind::S_CONFIG_SEC_ARGUMENT_SEPARATOR: // "CONFIG_SEC_ARGUMENT_SEPARATOR"
       case symbol_kind::S_CONFIG_SEC_WEB_APP_ID: // "CONFIG_SEC_WEB_APP_ID"
       case symbol_kind::S_CONFIG_SEC_SERVER_SIG: // "CONFIG_SEC_SERVER_SIG"
+      case symbol_kind::S_CONFIG_DIR_AUDIT_COMPRESSION_LEVEL: // "CONFIG_DIR_AUDIT_COMPRESSION_LEVEL"
       case symbol_kind::S_CONFIG_DIR_AUDIT_DIR: // "CONFIG_DIR_AUDIT_DIR"
       case symbol_kind::S_CONFIG_DIR_AUDIT_DIR_MOD: // "CONFIG_DIR_AUDIT_DIR_MOD"
       case symbol_kind::S_CONFIG_DIR_AUDIT_ENG: // "CONFIG_DIR_AUDIT_ENG"
@@ -8537,7 +9525,9 @@ switch (yykind)
       case symbol_kind::S_CONFIG_DIR_AUDIT_LOG: // "CONFIG_DIR_AUDIT_LOG"
       case symbol_kind::S_CONFIG_DIR_AUDIT_LOG2: // "CONFIG_DIR_AUDIT_LOG2"
       case symbol_kind::S_CONFIG_DIR_AUDIT_LOG_P: // "CONFIG_DIR_AUDIT_LOG_P"
+      case symbol_kind::S_CONFIG_DIR_AUDIT_RATE_LIMIT: // "CONFIG_DIR_AUDIT_RATE_LIMIT"
       case symbol_kind::S_CONFIG_DIR_AUDIT_STS: // "CONFIG_DIR_AUDIT_STS"
+      case symbol_kind::S_CONFIG_DIR_AUDIT_TIMINGS: // "CONFIG_DIR_AUDIT_TIMINGS"
       case symbol_kind::S_CONFIG_DIR_AUDIT_TPE: // "CONFIG_DIR_AUDIT_TPE"
       case symbol_kind::S_CONFIG_DIR_DEBUG_LOG: // "CONFIG_DIR_DEBUG_LOG"
       case symbol_kind::S_CONFIG_DIR_DEBUG_LVL: // "CONFIG_DIR_DEBUG_LVL"
@@ -8552,13 +9542,32 @@ switch (yykind)
       case symbol_kind::S_CONFIG_DIR_GEO_DB: // "CONFIG_DIR_GEO_DB"
       case symbol_kind::S_CONFIG_DIR_GSB_DB: // "CONFIG_DIR_GSB_DB"
       case symbol_kind::S_CONFIG_SEC_GUARDIAN_LOG: // "CONFIG_SEC_GUARDIAN_LOG"
+      case symbol_kind::S_CONFIG_DIR_DATA_RELOAD_INTERVAL: // "CONFIG_DIR_DATA_RELOAD_INTERVAL"
+      case symbol_kind::S_CONFIG_DIR_LUA_STATE_POOL_LIMIT: // "CONFIG_DIR_LUA_STATE_POOL_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_OVERLOAD_DETECTION_ONLY: // "CONFIG_DIR_OVERLOAD_DETECTION_ONLY"
+      case symbol_kind::S_CONFIG_DIR_OVERLOAD_SHED_TAG: // "CONFIG_DIR_OVERLOAD_SHED_TAG"
+      case symbol_kind::S_CONFIG_DIR_OVERLOAD_TARGET: // "CONFIG_DIR_OVERLOAD_TARGET"
+      case symbol_kind::S_CONFIG_DIR_PCRE_JIT_STACK_SIZE: // "CONFIG_DIR_PCRE_JIT_STACK_SIZE"
       case symbol_kind::S_CONFIG_DIR_PCRE_MATCH_LIMIT: // "CONFIG_DIR_PCRE_MATCH_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_RBL_TIMEOUT: // "CONFIG_DIR_RBL_TIMEOUT"
+      case symbol_kind::S_CONFIG_DIR_RULE_EARLY_DECISION: // "CONFIG_DIR_RULE_EARLY_DECISION"
+      case symbol_kind::S_CONFIG_DIR_RULE_EVALUATION_THREADS: // "CONFIG_DIR_RULE_EVALUATION_THREADS"
+      case symbol_kind::S_CONFIG_DIR_RULE_ENG_SAMPLE_RATE: // "CONFIG_DIR_RULE_ENG_SAMPLE_RATE"
+      case symbol_kind::S_CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE: // "CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE"
+      case symbol_kind::S_CONFIG_DIR_RX_GUARDRAIL: // "CONFIG_DIR_RX_GUARDRAIL"
+      case symbol_kind::S_CONFIG_DIR_REGEX_CACHE_FILE: // "CONFIG_DIR_REGEX_CACHE_FILE"
+      case symbol_kind::S_CONFIG_DIR_RULE_NATIVE_MODULE: // "CONFIG_DIR_RULE_NATIVE_MODULE"
+      case symbol_kind::S_CONFIG_DIR_SHADOW_RULES: // "CONFIG_DIR_SHADOW_RULES"
       case symbol_kind::S_CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION: // "CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION"
       case symbol_kind::S_CONFIG_SEC_CONN_R_STATE_LIMIT: // "CONFIG_SEC_CONN_R_STATE_LIMIT"
       case symbol_kind::S_CONFIG_SEC_CONN_W_STATE_LIMIT: // "CONFIG_SEC_CONN_W_STATE_LIMIT"
       case symbol_kind::S_CONFIG_SEC_SENSOR_ID: // "CONFIG_SEC_SENSOR_ID"
       case symbol_kind::S_CONFIG_DIR_ARGS_LIMIT: // "CONFIG_DIR_ARGS_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_REQ_BODY_DECOMPRESSION: // "CONFIG_DIR_REQ_BODY_DECOMPRESSION"
+      case symbol_kind::S_CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO: // "CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO"
+      case symbol_kind::S_CONFIG_DIR_RES_BODY_DECOMPRESSION: // "CONFIG_DIR_RES_BODY_DECOMPRESSION"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT: // "CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT"
+      case symbol_kind::S_CONFIG_DIR_REQ_BODY_JSON_SIMD: // "CONFIG_DIR_REQ_BODY_JSON_SIMD"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY: // "CONFIG_DIR_REQ_BODY"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT: // "CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT"
       case symbol_kind::S_CONFIG_DIR_REQ_BODY_LIMIT: // "CONFIG_DIR_REQ_BODY_LIMIT"
@@ -8567,17 +9576,34 @@ switch (yykind)
       case symbol_kind::S_CONFIG_DIR_RES_BODY: // "CONFIG_DIR_RES_BODY"
       case symbol_kind::S_CONFIG_DIR_RES_BODY_LIMIT: // "CONFIG_DIR_RES_BODY_LIMIT"
       case symbol_kind::S_CONFIG_DIR_RES_BODY_LIMIT_ACTION: // "CONFIG_DIR_RES_BODY_LIMIT_ACTION"
+      case symbol_kind::S_CONFIG_DIR_RES_BODY_STREAM_WINDOW: // "CONFIG_DIR_RES_BODY_STREAM_WINDOW"
       case symbol_kind::S_CONFIG_SEC_RULE_INHERITANCE: // "CONFIG_SEC_RULE_INHERITANCE"
       case symbol_kind::S_CONFIG_SEC_RULE_PERF_TIME: // "CONFIG_SEC_RULE_PERF_TIME"
+      case symbol_kind::S_CONFIG_SEC_RULE_PROFILING: // "CONFIG_SEC_RULE_PROFILING"
+      case symbol_kind::S_CONFIG_SEC_RULE_VALUE_MAJOR: // "CONFIG_SEC_RULE_VALUE_MAJOR"
+      case symbol_kind::S_CONFIG_SEC_RX_PREFILTER: // "CONFIG_SEC_RX_PREFILTER"
+      case symbol_kind::S_CONFIG_SEC_RX_RE2: // "CONFIG_SEC_RX_RE2"
       case symbol_kind::S_CONFIG_DIR_RULE_ENG: // "CONFIG_DIR_RULE_ENG"
       case symbol_kind::S_CONFIG_DIR_SEC_ACTION: // "CONFIG_DIR_SEC_ACTION"
       case symbol_kind::S_CONFIG_DIR_SEC_DEFAULT_ACTION: // "CONFIG_DIR_SEC_DEFAULT_ACTION"
       case symbol_kind::S_CONFIG_DIR_SEC_MARKER: // "CONFIG_DIR_SEC_MARKER"
       case symbol_kind::S_CONFIG_DIR_UNICODE_MAP_FILE: // "CONFIG_DIR_UNICODE_MAP_FILE"
       case symbol_kind::S_CONFIG_DIR_UNICODE_CODE_PAGE: // "CONFIG_DIR_UNICODE_CODE_PAGE"
+      case symbol_kind::S_CONFIG_SEC_COLLECTION_GROUP_COMMIT: // "CONFIG_SEC_COLLECTION_GROUP_COMMIT"
+      case symbol_kind::S_CONFIG_SEC_COLLECTION_REDIS_SERVER: // "CONFIG_SEC_COLLECTION_REDIS_SERVER"
+      case symbol_kind::S_CONFIG_SEC_COLLECTION_SYNC_MODE: // "CONFIG_SEC_COLLECTION_SYNC_MODE"
       case symbol_kind::S_CONFIG_SEC_COLLECTION_TIMEOUT: // "CONFIG_SEC_COLLECTION_TIMEOUT"
+      case symbol_kind::S_CONFIG_SEC_TRANSACTION_ID_FORMAT: // "CONFIG_SEC_TRANSACTION_ID_FORMAT"
+      case symbol_kind::S_CONFIG_SEC_TRANSACTION_MEMORY_LIMIT: // "CONFIG_SEC_TRANSACTION_MEMORY_LIMIT"
+      case symbol_kind::S_CONFIG_SEC_TRANSACTION_TIME_BUDGET: // "CONFIG_SEC_TRANSACTION_TIME_BUDGET"
+      case symbol_kind::S_CONFIG_SEC_VERDICT_CACHE: // "CONFIG_SEC_VERDICT_CACHE"
+      case symbol_kind::S_CONFIG_SEC_DEBUG_LOG_BUFFER: // "CONFIG_SEC_DEBUG_LOG_BUFFER"
+      case symbol_kind::S_CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH: // "CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH"
+      case symbol_kind::S_CONFIG_SEC_DEBUG_LOG_FILTER: // "CONFIG_SEC_DEBUG_LOG_FILTER"
       case symbol_kind::S_CONFIG_SEC_HTTP_BLKEY: // "CONFIG_SEC_HTTP_BLKEY"
+      case symbol_kind::S_CONFIG_SEC_HUGE_PAGES: // "CONFIG_SEC_HUGE_PAGES"
       case symbol_kind::S_CONFIG_SEC_INTERCEPT_ON_ERROR: // "CONFIG_SEC_INTERCEPT_ON_ERROR"
+      case symbol_kind::S_CONFIG_SEC_REMOTE_RULES_CACHE_DIR: // "CONFIG_SEC_REMOTE_RULES_CACHE_DIR"
       case symbol_kind::S_CONFIG_SEC_REMOTE_RULES_FAIL_ACTION: // "CONFIG_SEC_REMOTE_RULES_FAIL_ACTION"
       case symbol_kind::S_CONFIG_SEC_RULE_REMOVE_BY_ID: // "CONFIG_SEC_RULE_REMOVE_BY_ID"
       case symbol_kind::S_CONFIG_SEC_RULE_REMOVE_BY_MSG: // "CONFIG_SEC_RULE_REMOVE_BY_MSG"
@@ -8588,9 +9614,11 @@ switch (yykind)
       case symbol_kind::S_CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID: // "CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID"
       case symbol_kind::S_CONFIG_UPDLOAD_KEEP_FILES: // "CONFIG_UPDLOAD_KEEP_FILES"
       case symbol_kind::S_CONFIG_UPDLOAD_SAVE_TMP_FILES: // "CONFIG_UPDLOAD_SAVE_TMP_FILES"
+      case symbol_kind::S_CONFIG_UPLOAD_ANONYMOUS_FILES: // "CONFIG_UPLOAD_ANONYMOUS_FILES"
       case symbol_kind::S_CONFIG_UPLOAD_DIR: // "CONFIG_UPLOAD_DIR"
       case symbol_kind::S_CONFIG_UPLOAD_FILE_LIMIT: // "CONFIG_UPLOAD_FILE_LIMIT"
       case symbol_kind::S_CONFIG_UPLOAD_FILE_MODE: // "CONFIG_UPLOAD_FILE_MODE"
+      case symbol_kind::S_CONFIG_UPLOAD_IN_MEMORY_LIMIT: // "CONFIG_UPLOAD_IN_MEMORY_LIMIT"
       case symbol_kind::S_CONFIG_VALUE_ABORT: // "CONFIG_VALUE_ABORT"
       case symbol_kind::S_CONFIG_VALUE_DETC: // "CONFIG_VALUE_DETC"
       case symbol_kind::S_CONFIG_VALUE_HTTPS: // "CONFIG_VALUE_HTTPS"
@@ -8600,7 +9628,9 @@ switch (yykind)
       case symbol_kind::S_CONFIG_VALUE_PROCESS_PARTIAL: // "CONFIG_VALUE_PROCESS_PARTIAL"
       case symbol_kind::S_CONFIG_VALUE_REJECT: // "CONFIG_VALUE_REJECT"
       case symbol_kind::S_CONFIG_VALUE_RELEVANT_ONLY: // "CONFIG_VALUE_RELEVANT_ONLY"
+      case symbol_kind::S_CONFIG_VALUE_RING: // "CONFIG_VALUE_RING"
       case symbol_kind::S_CONFIG_VALUE_SERIAL: // "CONFIG_VALUE_SERIAL"
+      case symbol_kind::S_CONFIG_VALUE_STREAM: // "CONFIG_VALUE_STREAM"
       case symbol_kind::S_CONFIG_VALUE_WARN: // "CONFIG_VALUE_WARN"
       case symbol_kind::S_CONFIG_XML_EXTERNAL_ENTITY: // "CONFIG_XML_EXTERNAL_ENTITY"
       case symbol_kind::S_CONGIG_DIR_RESPONSE_BODY_MP: // "CONGIG_DIR_RESPONSE_BODY_MP"
@@ -8731,7 +9761,7 @@ switch (yykind)
 
 
 } // yy
-#line 8735 "seclang-parser.hh"
+#line 9765 "seclang-parser.hh"
 
 
 
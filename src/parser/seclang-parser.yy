@@ -5,7 +5,6 @@
 %define api.token.constructor
 %define api.value.type variant
 //%define api.namespace {modsecurity::yy}
-%define parse.assert
 %code requires
 {
 #include <string>
@@ -29,6 +28,7 @@ class Driver;
 #include "src/actions/ctl/audit_log_parts.h"
 #include "src/actions/ctl/request_body_access.h"
 #include "src/actions/ctl/rule_engine.h"
+#include "src/actions/ctl/request_body_processor_grpc.h"
 #include "src/actions/ctl/request_body_processor_json.h"
 #include "src/actions/ctl/request_body_processor_xml.h"
 #include "src/actions/ctl/request_body_processor_urlencoded.h"
@@ -49,6 +49,7 @@ class Driver;
 #include "src/actions/maturity.h"
 #include "src/actions/msg.h"
 #include "src/actions/multi_match.h"
+#include "src/actions/no_verdict_cache.h"
 #include "src/actions/no_audit_log.h"
 #include "src/actions/no_log.h"
 #include "src/actions/phase.h"
@@ -154,8 +155,15 @@ class Driver;
 #include "modsecurity/modsecurity.h"
 #include "modsecurity/rules_set_properties.h"
 #include "modsecurity/rule.h"
+#include "src/native_rules.h"
 #include "src/operators/operator.h"
+#include "src/utils/debug_log_buffer.h"
+#include "src/utils/debug_log_filter.h"
+#include "src/utils/download_cache.h"
 #include "src/utils/geo_lookup.h"
+#include "src/utils/gsb.h"
+#include "src/utils/huge_pages.h"
+#include "src/utils/regex_store.h"
 #include "src/utils/string.h"
 #include "src/utils/system.h"
 #include "src/variables/args_combined_size.h"
@@ -186,6 +194,8 @@ class Driver;
 #include "src/variables/modsec_build.h"
 #include "src/variables/msc_pcre_error.h"
 #include "src/variables/msc_pcre_limits_exceeded.h"
+#include "src/variables/msc_memory_limit_exceeded.h"
+#include "src/variables/msc_time_budget_exceeded.h"
 #include "src/variables/multipart_boundary_quoted.h"
 #include "src/variables/multipart_boundary_whitespace.h"
 #include "src/variables/multipart_crlf_lf_lines.h"
@@ -302,6 +312,19 @@ using namespace modsecurity::operators;
         YYERROR; \
     }
 
+/* Operators that can compile off the parser thread are queued on the
+ * driver and initialized together once the parsing is over. */
+#define OPERATOR_INIT(a, b, c) \
+    if (a->threadSafeInit()) { \
+        driver.deferInit(a.get(), b, c); \
+    } else { \
+        std::string error; \
+        if (a->init(b, &error) == false) { \
+            driver.error(c, error); \
+            YYERROR; \
+        } \
+    }
+
 #define OPERATOR_CONTAINER(a, b) \
     std::unique_ptr<Operator> c(b); \
     a = std::move(c);
@@ -372,6 +395,8 @@ using namespace modsecurity::operators;
   VARIABLE_MATCHED_VAR_NAME     "MATCHED_VAR_NAME"
   VARIABLE_MSC_PCRE_ERROR           "MSC_PCRE_ERROR"
   VARIABLE_MSC_PCRE_LIMITS_EXCEEDED "MSC_PCRE_LIMITS_EXCEEDED"
+  VARIABLE_MSC_MEMORY_LIMIT_EXCEEDED "MSC_MEMORY_LIMIT_EXCEEDED"
+  VARIABLE_MSC_TIME_BUDGET_EXCEEDED "MSC_TIME_BUDGET_EXCEEDED"
   VARIABLE_MULTIPART_BOUNDARY_QUOTED
   VARIABLE_MULTIPART_BOUNDARY_WHITESPACE
   VARIABLE_MULTIPART_CRLF_LF_LINES    "MULTIPART_CRLF_LF_LINES"
@@ -482,6 +507,7 @@ using namespace modsecurity::operators;
 
   CONFIG_DIR_AUDIT_LOG_FMT
   JSON
+  MSGPACK
   NATIVE
 
   ACTION_CTL_RULE_ENGINE                       "ACTION_CTL_RULE_ENGINE"
@@ -497,6 +523,7 @@ using namespace modsecurity::operators;
   ACTION_CHAIN                                 "Chain"
   ACTION_CTL_AUDIT_ENGINE                      "ACTION_CTL_AUDIT_ENGINE"
   ACTION_CTL_AUDIT_LOG_PARTS                   "ACTION_CTL_AUDIT_LOG_PARTS"
+  ACTION_CTL_BDY_GRPC                          "ACTION_CTL_BDY_GRPC"
   ACTION_CTL_BDY_JSON                          "ACTION_CTL_BDY_JSON"
   ACTION_CTL_BDY_XML                           "ACTION_CTL_BDY_XML"
   ACTION_CTL_BDY_URLENCODED                    "ACTION_CTL_BDY_URLENCODED"
@@ -520,6 +547,7 @@ using namespace modsecurity::operators;
   ACTION_MULTI_MATCH                           "MultiMatch"
   ACTION_NO_AUDIT_LOG                          "NoAuditLog"
   ACTION_NO_LOG                                "NoLog"
+  ACTION_NO_VERDICT_CACHE                      "NoVerdictCache"
   ACTION_PASS                                  "Pass"
   ACTION_PAUSE                                 "Pause"
   ACTION_PHASE                                 "Phase"
@@ -584,6 +612,7 @@ using namespace modsecurity::operators;
   CONFIG_SEC_ARGUMENT_SEPARATOR                "CONFIG_SEC_ARGUMENT_SEPARATOR"
   CONFIG_SEC_WEB_APP_ID                        "CONFIG_SEC_WEB_APP_ID"
   CONFIG_SEC_SERVER_SIG                        "CONFIG_SEC_SERVER_SIG"
+  CONFIG_DIR_AUDIT_COMPRESSION_LEVEL           "CONFIG_DIR_AUDIT_COMPRESSION_LEVEL"
   CONFIG_DIR_AUDIT_DIR                         "CONFIG_DIR_AUDIT_DIR"
   CONFIG_DIR_AUDIT_DIR_MOD                     "CONFIG_DIR_AUDIT_DIR_MOD"
   CONFIG_DIR_AUDIT_ENG                         "CONFIG_DIR_AUDIT_ENG"
@@ -591,7 +620,9 @@ using namespace modsecurity::operators;
   CONFIG_DIR_AUDIT_LOG                         "CONFIG_DIR_AUDIT_LOG"
   CONFIG_DIR_AUDIT_LOG2                        "CONFIG_DIR_AUDIT_LOG2"
   CONFIG_DIR_AUDIT_LOG_P                       "CONFIG_DIR_AUDIT_LOG_P"
+  CONFIG_DIR_AUDIT_RATE_LIMIT                  "CONFIG_DIR_AUDIT_RATE_LIMIT"
   CONFIG_DIR_AUDIT_STS                         "CONFIG_DIR_AUDIT_STS"
+  CONFIG_DIR_AUDIT_TIMINGS                     "CONFIG_DIR_AUDIT_TIMINGS"
   CONFIG_DIR_AUDIT_TPE                         "CONFIG_DIR_AUDIT_TPE"
   CONFIG_DIR_DEBUG_LOG                         "CONFIG_DIR_DEBUG_LOG"
   CONFIG_DIR_DEBUG_LVL                         "CONFIG_DIR_DEBUG_LVL"
@@ -606,13 +637,32 @@ using namespace modsecurity::operators;
   CONFIG_DIR_GEO_DB                            "CONFIG_DIR_GEO_DB"
   CONFIG_DIR_GSB_DB                            "CONFIG_DIR_GSB_DB"
   CONFIG_SEC_GUARDIAN_LOG                      "CONFIG_SEC_GUARDIAN_LOG"
+  CONFIG_DIR_DATA_RELOAD_INTERVAL              "CONFIG_DIR_DATA_RELOAD_INTERVAL"
+  CONFIG_DIR_LUA_STATE_POOL_LIMIT              "CONFIG_DIR_LUA_STATE_POOL_LIMIT"
+  CONFIG_DIR_OVERLOAD_DETECTION_ONLY           "CONFIG_DIR_OVERLOAD_DETECTION_ONLY"
+  CONFIG_DIR_OVERLOAD_SHED_TAG                 "CONFIG_DIR_OVERLOAD_SHED_TAG"
+  CONFIG_DIR_OVERLOAD_TARGET                   "CONFIG_DIR_OVERLOAD_TARGET"
+  CONFIG_DIR_PCRE_JIT_STACK_SIZE               "CONFIG_DIR_PCRE_JIT_STACK_SIZE"
   CONFIG_DIR_PCRE_MATCH_LIMIT                  "CONFIG_DIR_PCRE_MATCH_LIMIT"
+  CONFIG_DIR_RBL_TIMEOUT                       "CONFIG_DIR_RBL_TIMEOUT"
+  CONFIG_DIR_RULE_EARLY_DECISION               "CONFIG_DIR_RULE_EARLY_DECISION"
+  CONFIG_DIR_RULE_EVALUATION_THREADS           "CONFIG_DIR_RULE_EVALUATION_THREADS"
+  CONFIG_DIR_RULE_ENG_SAMPLE_RATE              "CONFIG_DIR_RULE_ENG_SAMPLE_RATE"
+  CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE        "CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE"
+  CONFIG_DIR_RX_GUARDRAIL                      "CONFIG_DIR_RX_GUARDRAIL"
+  CONFIG_DIR_REGEX_CACHE_FILE                  "CONFIG_DIR_REGEX_CACHE_FILE"
+  CONFIG_DIR_RULE_NATIVE_MODULE                "CONFIG_DIR_RULE_NATIVE_MODULE"
+  CONFIG_DIR_SHADOW_RULES                      "CONFIG_DIR_SHADOW_RULES"
   CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION        "CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION"
   CONFIG_SEC_CONN_R_STATE_LIMIT                "CONFIG_SEC_CONN_R_STATE_LIMIT"
   CONFIG_SEC_CONN_W_STATE_LIMIT                "CONFIG_SEC_CONN_W_STATE_LIMIT"
   CONFIG_SEC_SENSOR_ID                         "CONFIG_SEC_SENSOR_ID"
   CONFIG_DIR_ARGS_LIMIT                        "CONFIG_DIR_ARGS_LIMIT"
+  CONFIG_DIR_REQ_BODY_DECOMPRESSION            "CONFIG_DIR_REQ_BODY_DECOMPRESSION"
+  CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO      "CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO"
+  CONFIG_DIR_RES_BODY_DECOMPRESSION            "CONFIG_DIR_RES_BODY_DECOMPRESSION"
   CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT         "CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT"
+  CONFIG_DIR_REQ_BODY_JSON_SIMD                "CONFIG_DIR_REQ_BODY_JSON_SIMD"
   CONFIG_DIR_REQ_BODY                          "CONFIG_DIR_REQ_BODY"
   CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT          "CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT"
   CONFIG_DIR_REQ_BODY_LIMIT                    "CONFIG_DIR_REQ_BODY_LIMIT"
@@ -621,17 +671,34 @@ using namespace modsecurity::operators;
   CONFIG_DIR_RES_BODY                          "CONFIG_DIR_RES_BODY"
   CONFIG_DIR_RES_BODY_LIMIT                    "CONFIG_DIR_RES_BODY_LIMIT"
   CONFIG_DIR_RES_BODY_LIMIT_ACTION             "CONFIG_DIR_RES_BODY_LIMIT_ACTION"
+  CONFIG_DIR_RES_BODY_STREAM_WINDOW            "CONFIG_DIR_RES_BODY_STREAM_WINDOW"
   CONFIG_SEC_RULE_INHERITANCE                  "CONFIG_SEC_RULE_INHERITANCE"
   CONFIG_SEC_RULE_PERF_TIME                    "CONFIG_SEC_RULE_PERF_TIME"
+  CONFIG_SEC_RULE_PROFILING                    "CONFIG_SEC_RULE_PROFILING"
+  CONFIG_SEC_RULE_VALUE_MAJOR                  "CONFIG_SEC_RULE_VALUE_MAJOR"
+  CONFIG_SEC_RX_PREFILTER                      "CONFIG_SEC_RX_PREFILTER"
+  CONFIG_SEC_RX_RE2                            "CONFIG_SEC_RX_RE2"
   CONFIG_DIR_RULE_ENG                          "CONFIG_DIR_RULE_ENG"
   CONFIG_DIR_SEC_ACTION                        "CONFIG_DIR_SEC_ACTION"
   CONFIG_DIR_SEC_DEFAULT_ACTION                "CONFIG_DIR_SEC_DEFAULT_ACTION"
   CONFIG_DIR_SEC_MARKER                        "CONFIG_DIR_SEC_MARKER"
   CONFIG_DIR_UNICODE_MAP_FILE                  "CONFIG_DIR_UNICODE_MAP_FILE"
   CONFIG_DIR_UNICODE_CODE_PAGE                 "CONFIG_DIR_UNICODE_CODE_PAGE"
+  CONFIG_SEC_COLLECTION_GROUP_COMMIT           "CONFIG_SEC_COLLECTION_GROUP_COMMIT"
+  CONFIG_SEC_COLLECTION_REDIS_SERVER           "CONFIG_SEC_COLLECTION_REDIS_SERVER"
+  CONFIG_SEC_COLLECTION_SYNC_MODE              "CONFIG_SEC_COLLECTION_SYNC_MODE"
   CONFIG_SEC_COLLECTION_TIMEOUT                "CONFIG_SEC_COLLECTION_TIMEOUT"
+  CONFIG_SEC_TRANSACTION_ID_FORMAT             "CONFIG_SEC_TRANSACTION_ID_FORMAT"
+  CONFIG_SEC_TRANSACTION_MEMORY_LIMIT          "CONFIG_SEC_TRANSACTION_MEMORY_LIMIT"
+  CONFIG_SEC_TRANSACTION_TIME_BUDGET           "CONFIG_SEC_TRANSACTION_TIME_BUDGET"
+  CONFIG_SEC_VERDICT_CACHE                     "CONFIG_SEC_VERDICT_CACHE"
+  CONFIG_SEC_DEBUG_LOG_BUFFER                  "CONFIG_SEC_DEBUG_LOG_BUFFER"
+  CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH            "CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH"
+  CONFIG_SEC_DEBUG_LOG_FILTER                  "CONFIG_SEC_DEBUG_LOG_FILTER"
   CONFIG_SEC_HTTP_BLKEY                        "CONFIG_SEC_HTTP_BLKEY"
+  CONFIG_SEC_HUGE_PAGES                        "CONFIG_SEC_HUGE_PAGES"
   CONFIG_SEC_INTERCEPT_ON_ERROR                "CONFIG_SEC_INTERCEPT_ON_ERROR"
+  CONFIG_SEC_REMOTE_RULES_CACHE_DIR            "CONFIG_SEC_REMOTE_RULES_CACHE_DIR"
   CONFIG_SEC_REMOTE_RULES_FAIL_ACTION          "CONFIG_SEC_REMOTE_RULES_FAIL_ACTION"
   CONFIG_SEC_RULE_REMOVE_BY_ID                 "CONFIG_SEC_RULE_REMOVE_BY_ID"
   CONFIG_SEC_RULE_REMOVE_BY_MSG                "CONFIG_SEC_RULE_REMOVE_BY_MSG"
@@ -642,9 +709,11 @@ using namespace modsecurity::operators;
   CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID          "CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID"
   CONFIG_UPDLOAD_KEEP_FILES                    "CONFIG_UPDLOAD_KEEP_FILES"
   CONFIG_UPDLOAD_SAVE_TMP_FILES                "CONFIG_UPDLOAD_SAVE_TMP_FILES"
+  CONFIG_UPLOAD_ANONYMOUS_FILES                "CONFIG_UPLOAD_ANONYMOUS_FILES"
   CONFIG_UPLOAD_DIR                            "CONFIG_UPLOAD_DIR"
   CONFIG_UPLOAD_FILE_LIMIT                     "CONFIG_UPLOAD_FILE_LIMIT"
   CONFIG_UPLOAD_FILE_MODE                      "CONFIG_UPLOAD_FILE_MODE"
+  CONFIG_UPLOAD_IN_MEMORY_LIMIT                "CONFIG_UPLOAD_IN_MEMORY_LIMIT"
   CONFIG_VALUE_ABORT                           "CONFIG_VALUE_ABORT"
   CONFIG_VALUE_DETC                            "CONFIG_VALUE_DETC"
   CONFIG_VALUE_HTTPS                           "CONFIG_VALUE_HTTPS"
@@ -654,7 +723,9 @@ using namespace modsecurity::operators;
   CONFIG_VALUE_PROCESS_PARTIAL                 "CONFIG_VALUE_PROCESS_PARTIAL"
   CONFIG_VALUE_REJECT                          "CONFIG_VALUE_REJECT"
   CONFIG_VALUE_RELEVANT_ONLY                   "CONFIG_VALUE_RELEVANT_ONLY"
+  CONFIG_VALUE_RING                            "CONFIG_VALUE_RING"
   CONFIG_VALUE_SERIAL                          "CONFIG_VALUE_SERIAL"
+  CONFIG_VALUE_STREAM                          "CONFIG_VALUE_STREAM"
   CONFIG_VALUE_WARN                            "CONFIG_VALUE_WARN"
   CONFIG_XML_EXTERNAL_ENTITY                   "CONFIG_XML_EXTERNAL_ENTITY"
   CONGIG_DIR_RESPONSE_BODY_MP                  "CONGIG_DIR_RESPONSE_BODY_MP"
@@ -755,6 +826,28 @@ audit_log:
         driver.m_auditLog->setStatus(modsecurity::audit_log::AuditLog::OnAuditLogStatus);
       }
 
+    /* SecAuditLogCompressionLevel */
+    | CONFIG_DIR_AUDIT_COMPRESSION_LEVEL
+      {
+        int level = atoi($1.c_str());
+        if (driver.m_auditLog->setCompressionLevel(level) == false) {
+            driver.error(@0, "SecAuditLogCompressionLevel expects a level from 0 (no compression) to 9.");
+            YYERROR;
+        }
+#ifndef WITH_ZLIB
+        if (level > 0) {
+            driver.error(@0, "This version of ModSecurity was not compiled with zlib support.");
+            YYERROR;
+        }
+#endif
+      }
+
+    /* SecAuditLogRateLimit */
+    | CONFIG_DIR_AUDIT_RATE_LIMIT
+      {
+        driver.m_auditLog->setRateLimit(atoi($1.c_str()));
+      }
+
     /* SecAuditLogFileMode */
     | CONFIG_DIR_AUDIT_FLE_MOD
       {
@@ -784,11 +877,26 @@ audit_log:
         driver.m_auditLog->setFormat(modsecurity::audit_log::AuditLog::JSONAuditLogFormat);
       }
 
+    | CONFIG_DIR_AUDIT_LOG_FMT MSGPACK
+      {
+        driver.m_auditLog->setFormat(modsecurity::audit_log::AuditLog::MsgPackAuditLogFormat);
+      }
+
     | CONFIG_DIR_AUDIT_LOG_FMT NATIVE
       {
         driver.m_auditLog->setFormat(modsecurity::audit_log::AuditLog::NativeAuditLogFormat);
       }
 
+    /* SecAuditLogTimings */
+    | CONFIG_DIR_AUDIT_TIMINGS CONFIG_VALUE_OFF
+      {
+        driver.m_auditLog->setTimings(false);
+      }
+    | CONFIG_DIR_AUDIT_TIMINGS CONFIG_VALUE_ON
+      {
+        driver.m_auditLog->setTimings(true);
+      }
+
     /* SecAuditLogRelevantStatus */
     | CONFIG_DIR_AUDIT_STS
       {
@@ -809,6 +917,14 @@ audit_log:
       {
         driver.m_auditLog->setType(modsecurity::audit_log::AuditLog::HttpsAuditLogType);
       }
+    | CONFIG_DIR_AUDIT_TPE CONFIG_VALUE_RING
+      {
+        driver.m_auditLog->setType(modsecurity::audit_log::AuditLog::RingAuditLogType);
+      }
+    | CONFIG_DIR_AUDIT_TPE CONFIG_VALUE_STREAM
+      {
+        driver.m_auditLog->setType(modsecurity::audit_log::AuditLog::StreamAuditLogType);
+      }
 
     /* Upload */
     | CONFIG_UPDLOAD_KEEP_FILES CONFIG_VALUE_ON
@@ -834,6 +950,11 @@ audit_log:
         driver.m_uploadFileMode.m_set = true;
         driver.m_uploadFileMode.m_value = strtol($1.c_str(), NULL, 8);
       }
+    | CONFIG_UPLOAD_IN_MEMORY_LIMIT
+      {
+        driver.m_uploadInMemoryLimit.m_set = true;
+        driver.m_uploadInMemoryLimit.m_value = strtol($1.c_str(), NULL, 10);
+      }
     | CONFIG_UPLOAD_DIR
       {
         driver.m_uploadDirectory.m_set = true;
@@ -847,6 +968,14 @@ audit_log:
       {
         driver.m_tmpSaveUploadedFiles = modsecurity::RulesSetProperties::FalseConfigBoolean;
       }
+    | CONFIG_UPLOAD_ANONYMOUS_FILES CONFIG_VALUE_ON
+      {
+        driver.m_uploadAnonymousFiles = modsecurity::RulesSetProperties::TrueConfigBoolean;
+      }
+    | CONFIG_UPLOAD_ANONYMOUS_FILES CONFIG_VALUE_OFF
+      {
+        driver.m_uploadAnonymousFiles = modsecurity::RulesSetProperties::FalseConfigBoolean;
+      }
     ;
 
 actions:
@@ -880,40 +1009,26 @@ op:
     op_before_init
       {
         $$ = std::move($1);
-        std::string error;
-        if ($$->init(*@1.end.filename, &error) == false) {
-            driver.error(@0, error);
-            YYERROR;
-        }
+        OPERATOR_INIT($$, *@1.end.filename, @0)
       }
     | NOT op_before_init
       {
         $$ = std::move($2);
         $$->m_negation = true;
-        std::string error;
-        if ($$->init(*@1.end.filename, &error) == false) {
-            driver.error(@0, error);
-            YYERROR;
-        }
+        OPERATOR_INIT($$, *@1.end.filename, @0)
       }
     | run_time_string
       {
-        OPERATOR_CONTAINER($$, new operators::Rx(std::move($1)));
-        std::string error;
-        if ($$->init(*@1.end.filename, &error) == false) {
-            driver.error(@0, error);
-            YYERROR;
-        }
+        OPERATOR_CONTAINER($$, new operators::Rx(std::move($1),
+            driver.m_regexStore.get()));
+        OPERATOR_INIT($$, *@1.end.filename, @0)
       }
     | NOT run_time_string
       {
-        OPERATOR_CONTAINER($$, new operators::Rx(std::move($2)));
+        OPERATOR_CONTAINER($$, new operators::Rx(std::move($2),
+            driver.m_regexStore.get()));
         $$->m_negation = true;
-        std::string error;
-        if ($$->init(*@1.end.filename, &error) == false) {
-            driver.error(@0, error);
-            YYERROR;
-        }
+        OPERATOR_INIT($$, *@1.end.filename, @0)
       }
     ;
 
@@ -941,6 +1056,8 @@ op_before_init:
     | OPERATOR_INSPECT_FILE run_time_string
       {
         OPERATOR_CONTAINER($$, new operators::InspectFile(std::move($2)));
+        driver.m_variablesInUse.addAll();
+        driver.m_xmlDomRequired = modsecurity::RulesSetProperties::TrueConfigBoolean;
       }
     | OPERATOR_FUZZY_HASH run_time_string
       {
@@ -953,6 +1070,7 @@ op_before_init:
     | OPERATOR_VALIDATE_DTD run_time_string
       {
         OPERATOR_CONTAINER($$, new operators::ValidateDTD(std::move($2)));
+        driver.m_xmlDomRequired = modsecurity::RulesSetProperties::TrueConfigBoolean;
       }
     | OPERATOR_VALIDATE_HASH run_time_string
       {
@@ -962,6 +1080,7 @@ op_before_init:
     | OPERATOR_VALIDATE_SCHEMA run_time_string
       {
         OPERATOR_CONTAINER($$, new operators::ValidateSchema(std::move($2)));
+        driver.m_xmlDomRequired = modsecurity::RulesSetProperties::TrueConfigBoolean;
       }
     | OPERATOR_VERIFY_CC run_time_string
       {
@@ -981,8 +1100,7 @@ op_before_init:
       }
     | OPERATOR_GSB_LOOKUP run_time_string
       {
-        /* $$ = new operators::GsbLookup($1); */
-        OPERATOR_NOT_SUPPORTED("GsbLookup", @0);
+        OPERATOR_CONTAINER($$, new operators::GsbLookup(std::move($2)));
       }
     | OPERATOR_RSUB run_time_string
       {
@@ -1047,11 +1165,13 @@ op_before_init:
       }
     | OPERATOR_RX run_time_string
       {
-        OPERATOR_CONTAINER($$, new operators::Rx(std::move($2)));
+        OPERATOR_CONTAINER($$, new operators::Rx(std::move($2),
+            driver.m_regexStore.get()));
       }
     | OPERATOR_RX_GLOBAL run_time_string
       {
-        OPERATOR_CONTAINER($$, new operators::RxGlobal(std::move($2)));
+        OPERATOR_CONTAINER($$, new operators::RxGlobal(std::move($2),
+            driver.m_regexStore.get()));
       }
     | OPERATOR_STR_EQ run_time_string
       {
@@ -1175,6 +1295,9 @@ expression:
         if (driver.addSecRuleScript(std::move(r)) == false) {
             YYERROR;
         }
+        /* scripts reach the variables, XML included, by name */
+        driver.m_variablesInUse.addAll();
+        driver.m_xmlDomRequired = modsecurity::RulesSetProperties::TrueConfigBoolean;
       }
     | CONFIG_DIR_SEC_DEFAULT_ACTION actions
       {
@@ -1301,8 +1424,11 @@ expression:
       }
     | CONFIG_SEC_CACHE_TRANSFORMATIONS
       {
-        driver.error(@0, "SecCacheTransformations is not supported.");
-        YYERROR;
+        std::string error;
+        if (driver.m_transformationsCache.load($1, &error) == false) {
+            driver.error(@0, error);
+            YYERROR;
+        }
       }
     | CONFIG_SEC_DISABLE_BACKEND_COMPRESS CONFIG_VALUE_ON
       {
@@ -1355,8 +1481,29 @@ expression:
       }
     | CONFIG_DIR_GSB_DB
       {
-        driver.error(@0, "SecGsbLookupDb is not supported.");
-        YYERROR;
+        std::vector<std::string> param;
+        for (const std::string &a : utils::string::ssplit($1, ' ')) {
+            if (a.empty() == false) {
+                param.push_back(a);
+            }
+        }
+        std::string file(param.empty() ? "" : param[0]);
+        std::string error;
+        if (file.size() > 1 && file.front() == '"' && file.back() == '"') {
+            file = file.substr(1, file.size() - 2);
+        }
+        if (file.empty() == false && file[0] != '/') {
+            std::string err;
+            std::string resolved = modsecurity::utils::find_resource(file, *@0.end.filename, &err);
+            if (resolved.empty() == false) {
+                file = resolved;
+            }
+        }
+        if (param.size() > 2 || file.empty()
+            || Utils::Gsb::getInstance().configure(file, param.size() > 1 ? param[1] : "", &error) == false) {
+            driver.error(@0, "SecGsbLookupDb: " + (error.empty() ? "expects a file and optionally an API key" : error));
+            YYERROR;
+        }
       }
     | CONFIG_SEC_GUARDIAN_LOG
       {
@@ -1592,11 +1739,60 @@ expression:
         driver.m_argumentsLimit.m_set = true;
         driver.m_argumentsLimit.m_value = atoi($1.c_str());
       }
+    | CONFIG_DIR_REQ_BODY_DECOMPRESSION CONFIG_VALUE_OFF
+      {
+        driver.m_requestBodyDecompression = modsecurity::RulesSetProperties::FalseConfigBoolean;
+      }
+    | CONFIG_DIR_REQ_BODY_DECOMPRESSION CONFIG_VALUE_ON
+      {
+#ifdef WITH_ZLIB
+        driver.m_requestBodyDecompression = modsecurity::RulesSetProperties::TrueConfigBoolean;
+#else
+        driver.error(@0, "SecRequestBodyDecompression: ModSecurity was not compiled with zlib support.");
+        YYERROR;
+#endif
+      }
+    | CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO
+      {
+        int ratio = atoi($1.c_str());
+        if (ratio < 1) {
+            driver.error(@0, "SecRequestBodyDecompressionRatio expects a ratio of at least 1.");
+            YYERROR;
+        }
+        driver.m_requestBodyDecompressionRatio.m_set = true;
+        driver.m_requestBodyDecompressionRatio.m_value = ratio;
+      }
+    | CONFIG_DIR_RES_BODY_DECOMPRESSION CONFIG_VALUE_OFF
+      {
+        driver.m_responseBodyDecompression = modsecurity::RulesSetProperties::FalseConfigBoolean;
+      }
+    | CONFIG_DIR_RES_BODY_DECOMPRESSION CONFIG_VALUE_ON
+      {
+#ifdef WITH_ZLIB
+        driver.m_responseBodyDecompression = modsecurity::RulesSetProperties::TrueConfigBoolean;
+#else
+        driver.error(@0, "SecResponseBodyDecompression: ModSecurity was not compiled with zlib support.");
+        YYERROR;
+#endif
+      }
     | CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT
       {
         driver.m_requestBodyJsonDepthLimit.m_set = true;
         driver.m_requestBodyJsonDepthLimit.m_value = atoi($1.c_str());
       }
+    | CONFIG_DIR_REQ_BODY_JSON_SIMD CONFIG_VALUE_OFF
+      {
+        driver.m_requestBodyJsonSimd = modsecurity::RulesSetProperties::FalseConfigBoolean;
+      }
+    | CONFIG_DIR_REQ_BODY_JSON_SIMD CONFIG_VALUE_ON
+      {
+#ifdef WITH_SIMDJSON
+        driver.m_requestBodyJsonSimd = modsecurity::RulesSetProperties::TrueConfigBoolean;
+#else
+        driver.error(@0, "SecRequestBodyJsonSimd: ModSecurity was not built with simdjson.");
+        YYERROR;
+#endif
+      }
     /* Body limits */
     | CONFIG_DIR_REQ_BODY_LIMIT
       {
@@ -1610,12 +1806,8 @@ expression:
       }
     | CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT
       {
-        std::stringstream ss;
-        ss << "As of ModSecurity version 3.0, SecRequestBodyInMemoryLimit is no longer ";
-        ss << "supported. Instead, you can use your web server configurations to control ";
-        ss << "those values. ModSecurity will follow the web server decision.";
-        driver.error(@0, ss.str());
-        YYERROR;
+        driver.m_requestBodyInMemoryLimit.m_set = true;
+        driver.m_requestBodyInMemoryLimit.m_value = atoi($1.c_str());
       }
     | CONFIG_DIR_RES_BODY_LIMIT
       {
@@ -1638,6 +1830,20 @@ expression:
       {
         driver.m_responseBodyLimitAction = modsecurity::RulesSet::BodyLimitAction::RejectBodyLimitAction;
       }
+    | CONFIG_DIR_RES_BODY_STREAM_WINDOW
+      {
+        driver.m_responseBodyStreamWindow.m_set = true;
+        driver.m_responseBodyStreamWindow.m_value = atoi($1.c_str());
+      }
+    | CONFIG_SEC_REMOTE_RULES_CACHE_DIR
+      {
+        /* process wide, and set right away: the downloads are done while scanning */
+        std::string error;
+        if (Utils::DownloadCache::getInstance().setDirectory($1, &error) == false) {
+            driver.error(@0, "SecRemoteRulesCacheDir: " + error);
+            YYERROR;
+        }
+      }
     | CONFIG_SEC_REMOTE_RULES_FAIL_ACTION CONFIG_VALUE_ABORT
       {
         driver.m_remoteRulesActionOnFailed = RulesSet::OnFailedRemoteRulesAction::AbortOnFailedRemoteRulesAction;
@@ -1651,11 +1857,197 @@ expression:
         driver.error(@0, "SecPcreMatchLimitRecursion is not currently supported. Default PCRE values are being used for now");
         YYERROR;
 */
+    | CONFIG_DIR_DATA_RELOAD_INTERVAL
+      {
+        driver.m_dataReloadInterval.m_set = true;
+        driver.m_dataReloadInterval.m_value = atoi($1.c_str());
+      }
+    | CONFIG_DIR_LUA_STATE_POOL_LIMIT
+      {
+        driver.m_luaStatePoolLimit.m_set = true;
+        driver.m_luaStatePoolLimit.m_value = atoi($1.c_str());
+      }
+    | CONFIG_DIR_PCRE_JIT_STACK_SIZE
+      {
+        driver.m_pcreJitStackSize.m_set = true;
+        driver.m_pcreJitStackSize.m_value = atoi($1.c_str());
+      }
     | CONFIG_DIR_PCRE_MATCH_LIMIT
       {
         driver.m_pcreMatchLimit.m_set = true;
         driver.m_pcreMatchLimit.m_value = atoi($1.c_str());
       }
+    | CONFIG_DIR_RBL_TIMEOUT
+      {
+        driver.m_rblTimeout.m_set = true;
+        driver.m_rblTimeout.m_value = atoi($1.c_str());
+      }
+    | CONFIG_DIR_RULE_EARLY_DECISION
+      {
+        std::vector<std::string> args;
+        for (const std::string &a : utils::string::ssplit($1, ' ')) {
+            if (a.empty() == false) {
+                args.push_back(a);
+            }
+        }
+        std::string variable = args.empty() ? ""
+            : utils::string::tolower(args[0]);
+        if (variable.compare(0, 3, "tx:") == 0
+            || variable.compare(0, 3, "tx.") == 0) {
+            variable = variable.substr(3);
+        } else {
+            variable.clear();
+        }
+        char *end = nullptr;
+        long threshold = args.size() > 1
+            ? strtol(args[1].c_str(), &end, 10) : 0;
+        if (args.size() != 3 || variable.empty() || end == args[1].c_str()
+            || *end != '\0') {
+            driver.error(@0, "SecRuleEarlyDecision expects a TX variable, a threshold and a marker, got: " + $1);
+            YYERROR;
+        }
+        driver.m_earlyDecisionVariable.m_set = true;
+        driver.m_earlyDecisionVariable.m_value = variable;
+        driver.m_earlyDecisionThreshold.m_set = true;
+        driver.m_earlyDecisionThreshold.m_value = threshold;
+        std::string marker = args[2];
+        if (marker.size() > 2 && marker.front() == '"'
+            && marker.back() == '"') {
+            marker = marker.substr(1, marker.size() - 2);
+        }
+        driver.m_earlyDecisionMarker.m_set = true;
+        driver.m_earlyDecisionMarker.m_value = marker;
+      }
+    | CONFIG_DIR_OVERLOAD_TARGET
+      {
+        std::vector<std::string> args;
+        for (const std::string &a : utils::string::ssplit($1, ' ')) {
+            if (a.empty() == false) {
+                args.push_back(a);
+            }
+        }
+        long values[2] = { 0, 1000 };
+        bool valid = args.size() == 1 || args.size() == 2;
+        for (size_t i = 0; valid && i < args.size(); i++) {
+            char *end = nullptr;
+            values[i] = strtol(args[i].c_str(), &end, 10);
+            valid = end != args[i].c_str() && *end == '\0' && values[i] > 0;
+        }
+        if (valid == false) {
+            driver.error(@0, "SecOverloadTarget expects a p99 in microseconds and optionally a number of transactions, got: " + $1);
+            YYERROR;
+        }
+        driver.m_overloadTarget.m_set = true;
+        driver.m_overloadTarget.m_value = values[0];
+        driver.m_overloadWindow.m_set = true;
+        driver.m_overloadWindow.m_value = values[1];
+      }
+    | CONFIG_DIR_OVERLOAD_SHED_TAG
+      {
+        std::string tag = $1;
+        if (tag.size() > 2 && tag.front() == '"' && tag.back() == '"') {
+            tag = tag.substr(1, tag.size() - 2);
+        }
+        driver.m_overloadShedTags.m_set = true;
+        driver.m_overloadShedTags.m_value.insert(tag);
+      }
+    | CONFIG_DIR_OVERLOAD_DETECTION_ONLY
+      {
+        driver.m_overloadDetectionOnly.m_set = true;
+        for (const std::string &a : utils::string::ssplit($1, ' ')) {
+            if (a.empty() == false) {
+                driver.m_overloadDetectionOnly.m_value.insert(
+                    utils::string::toupper(a));
+            }
+        }
+      }
+    | CONFIG_DIR_RULE_EVALUATION_THREADS
+      {
+        driver.m_ruleEvaluationThreads.m_set = true;
+        driver.m_ruleEvaluationThreads.m_value = atoi($1.c_str());
+      }
+    | CONFIG_DIR_RULE_ENG_SAMPLE_RATE
+      {
+        /* <percent>[%] [transaction|client], kept in hundredths of a percent */
+        std::stringstream ss($1);
+        std::string rate;
+        std::string key;
+        ss >> rate >> key;
+        if (rate.empty() == false && rate.back() == '%') {
+            rate.pop_back();
+        }
+        double percent = atof(rate.c_str());
+        if (percent < 0 || percent > 100) {
+            driver.error(@0, "SecRuleEngineSampleRate expects a percentage from 0 to 100.");
+            YYERROR;
+        }
+        key = utils::string::tolower(key);
+        if (key.empty() == false && key != "transaction" && key != "client") {
+            driver.error(@0, "SecRuleEngineSampleRate samples by transaction or by client, not by " + key + ".");
+            YYERROR;
+        }
+        driver.m_ruleEngineSampleRate.m_set = true;
+        driver.m_ruleEngineSampleRate.m_value =
+            static_cast<int>(percent * 100 + 0.5);
+        driver.m_ruleEngineSampleKey.m_set = true;
+        driver.m_ruleEngineSampleKey.m_value = key == "client" ? 1 : 0;
+      }
+    | CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE
+      {
+        driver.m_ruleProfilingSampleRate.m_set = true;
+        driver.m_ruleProfilingSampleRate.m_value = atoi($1.c_str());
+      }
+    | CONFIG_DIR_RX_GUARDRAIL
+      {
+        int factor = atoi($1.c_str());
+        if (factor < 2) {
+            driver.error(@0, "SecRxGuardrail expects a factor of at " \
+                "least 2, not: " + $1);
+            YYERROR;
+        }
+        driver.m_rxGuardrail.m_set = true;
+        driver.m_rxGuardrail.m_value = factor;
+      }
+    | CONFIG_DIR_REGEX_CACHE_FILE
+      {
+        std::string err;
+        driver.m_regexStore.reset(new Utils::RegexStore());
+        if (driver.m_regexStore->open($1, &err) == false) {
+            driver.error(@0, err);
+            YYERROR;
+        }
+      }
+    | CONFIG_DIR_RULE_NATIVE_MODULE
+      {
+        std::string err;
+        std::string file = modsecurity::utils::find_resource($1,
+            *@1.end.filename, &err);
+        if (file.empty()) {
+            driver.error(@0, "Failed to locate the native module " + $1
+                + ". " + err);
+            YYERROR;
+        }
+        driver.m_nativeModule = NativeRules::load(file, &err);
+        if (driver.m_nativeModule == nullptr) {
+            driver.error(@0, err);
+            YYERROR;
+        }
+        driver.m_ruleNativeModule.m_set = true;
+        driver.m_ruleNativeModule.m_value = file;
+      }
+    | CONFIG_DIR_SHADOW_RULES
+      {
+        std::string err;
+        std::string file = modsecurity::utils::find_resource($1,
+            *@1.end.filename, &err);
+        if (file.empty()) {
+            driver.error(@0, "Failed to locate the shadow rules " + $1
+                + ". " + err);
+            YYERROR;
+        }
+        driver.m_shadowRules.m_set = true;
+        driver.m_shadowRules.m_value = file;
+      }
     | CONGIG_DIR_RESPONSE_BODY_MP
       {
         std::istringstream buf($1);
@@ -1674,6 +2066,43 @@ expression:
         driver.m_responseBodyTypeToBeInspected.m_clear = true;
         driver.m_responseBodyTypeToBeInspected.m_value.clear();
       }
+    | CONFIG_SEC_RULE_PROFILING CONFIG_VALUE_OFF
+      {
+        driver.m_secRuleProfiling = modsecurity::RulesSetProperties::FalseConfigBoolean;
+      }
+    | CONFIG_SEC_RULE_PROFILING CONFIG_VALUE_ON
+      {
+        driver.m_secRuleProfiling = modsecurity::RulesSetProperties::TrueConfigBoolean;
+      }
+    | CONFIG_SEC_RULE_VALUE_MAJOR CONFIG_VALUE_OFF
+      {
+        driver.m_secRuleValueMajor = modsecurity::RulesSetProperties::FalseConfigBoolean;
+      }
+    | CONFIG_SEC_RULE_VALUE_MAJOR CONFIG_VALUE_ON
+      {
+        driver.m_secRuleValueMajor = modsecurity::RulesSetProperties::TrueConfigBoolean;
+      }
+    | CONFIG_SEC_RX_PREFILTER CONFIG_VALUE_OFF
+      {
+        driver.m_secRxPrefilter = modsecurity::RulesSetProperties::FalseConfigBoolean;
+      }
+    | CONFIG_SEC_RX_PREFILTER CONFIG_VALUE_ON
+      {
+        driver.m_secRxPrefilter = modsecurity::RulesSetProperties::TrueConfigBoolean;
+      }
+    | CONFIG_SEC_RX_RE2 CONFIG_VALUE_OFF
+      {
+        driver.m_secRxRe2 = modsecurity::RulesSetProperties::FalseConfigBoolean;
+      }
+    | CONFIG_SEC_RX_RE2 CONFIG_VALUE_ON
+      {
+#ifdef WITH_RE2
+        driver.m_secRxRe2 = modsecurity::RulesSetProperties::TrueConfigBoolean;
+#else
+        driver.error(@0, "SecRxRe2: ModSecurity was not compiled with RE2 support.");
+        YYERROR;
+#endif
+      }
     | CONFIG_XML_EXTERNAL_ENTITY CONFIG_VALUE_OFF
       {
         driver.m_secXMLExternalEntity = modsecurity::RulesSetProperties::FalseConfigBoolean;
@@ -1684,14 +2113,8 @@ expression:
       }
     | CONGIG_DIR_SEC_TMP_DIR
       {
-/* Parser error disabled to avoid breaking default installations with modsecurity.conf-recommended
-        std::stringstream ss;
-        ss << "As of ModSecurity version 3.0, SecTmpDir is no longer supported.";
-        ss << " Instead, you can use your web server configurations to control when";
-        ss << "and where to swap. ModSecurity will follow the web server decision.";
-        driver.error(@0, ss.str());
-        YYERROR;
-*/
+        driver.m_tmpDirectory.m_set = true;
+        driver.m_tmpDirectory.m_value = $1;
       }
     | CONGIG_DIR_SEC_DATA_DIR
 /* Parser error disabled to avoid breaking default installations with modsecurity.conf-recommended
@@ -1774,18 +2197,151 @@ expression:
         }
 
       }
+    | CONFIG_SEC_COLLECTION_REDIS_SERVER
+      {
+        std::vector<std::string> args;
+        for (const std::string &a : utils::string::ssplit($1, ' ')) {
+            if (a.empty() == false) {
+                args.push_back(a);
+            }
+        }
+        size_t colon = args.empty() ? std::string::npos : args[0].rfind(':');
+        std::string host;
+        int port = 0;
+        int timeout = args.size() > 1 ? atoi(args[1].c_str()) : 50;
+        if (colon != std::string::npos) {
+            host = args[0].substr(0, colon);
+            port = atoi(args[0].c_str() + colon + 1);
+        }
+        if (host.size() > 2 && host.front() == '[' && host.back() == ']') {
+            host = host.substr(1, host.size() - 2);
+        }
+        if (args.size() > 2 || host.empty() || port <= 0 || port > 65535
+            || timeout <= 0) {
+            driver.error(@0, "SecCollectionRedisServer expects host:port and optionally a timeout in milliseconds, got: " + $1);
+            YYERROR;
+        }
+        driver.m_collectionRedisHost.m_set = true;
+        driver.m_collectionRedisHost.m_value = host;
+        driver.m_collectionRedisPort.m_set = true;
+        driver.m_collectionRedisPort.m_value = port;
+        driver.m_collectionRedisTimeout.m_set = true;
+        driver.m_collectionRedisTimeout.m_value = timeout;
+      }
+    | CONFIG_SEC_COLLECTION_SYNC_MODE
+      {
+        std::string mode = utils::string::tolower($1);
+        if (mode == "full") {
+            driver.m_collectionSyncMode.m_value = RulesSetProperties::CollectionSyncFull;
+        } else if (mode == "nometasync") {
+            driver.m_collectionSyncMode.m_value = RulesSetProperties::CollectionSyncNoMetaSync;
+        } else if (mode == "nosync") {
+            driver.m_collectionSyncMode.m_value = RulesSetProperties::CollectionSyncNoSync;
+        } else {
+            driver.error(@0, "SecCollectionSyncMode expects Full, NoMetaSync or NoSync, got: " + $1);
+            YYERROR;
+        }
+        driver.m_collectionSyncMode.m_set = true;
+      }
+    | CONFIG_SEC_TRANSACTION_ID_FORMAT
+      {
+        std::string format = utils::string::tolower($1);
+        if (format == "sequential") {
+            driver.m_transactionIdFormat.m_value = RulesSetProperties::TransactionIdSequential;
+        } else if (format == "random") {
+            driver.m_transactionIdFormat.m_value = RulesSetProperties::TransactionIdRandom;
+        } else {
+            driver.error(@0, "SecTransactionIdFormat expects Sequential or Random, got: " + $1);
+            YYERROR;
+        }
+        driver.m_transactionIdFormat.m_set = true;
+      }
+    | CONFIG_SEC_TRANSACTION_MEMORY_LIMIT
+      {
+        driver.m_transactionMemoryLimit.m_set = true;
+        driver.m_transactionMemoryLimit.m_value = atoi($1.c_str());
+      }
+    | CONFIG_SEC_TRANSACTION_TIME_BUDGET
+      {
+        driver.m_transactionTimeBudget.m_set = true;
+        driver.m_transactionTimeBudget.m_value = atoi($1.c_str());
+      }
+    | CONFIG_SEC_VERDICT_CACHE
+      {
+        driver.m_verdictCacheEntries.m_set = true;
+        driver.m_verdictCacheEntries.m_value = atoi($1.c_str());
+      }
+    | CONFIG_SEC_COLLECTION_GROUP_COMMIT
+      {
+        driver.m_collectionGroupCommit.m_set = true;
+        driver.m_collectionGroupCommit.m_value = atoi($1.c_str());
+      }
     | CONFIG_SEC_COLLECTION_TIMEOUT
       {
-/* Parser error disabled to avoid breaking default CRS installations with crs-setup.conf-recommended
-        driver.error(@0, "SecCollectionTimeout is not yet supported.");
-        YYERROR;
-*/
+        driver.m_collectionTimeout.m_set = true;
+        driver.m_collectionTimeout.m_value = atoi($1.c_str());
       }
     | CONFIG_SEC_HTTP_BLKEY
       {
         driver.m_httpblKey.m_set = true;
         driver.m_httpblKey.m_value = $1;
       }
+    | CONFIG_SEC_DEBUG_LOG_BUFFER
+      {
+        std::vector<std::string> args;
+        for (const std::string &a : utils::string::ssplit($1, ' ')) {
+            if (a.empty() == false) {
+                args.push_back(a);
+            }
+        }
+        int level = args.empty() ? -1 : atoi(args[0].c_str());
+        int size = args.size() > 1 ? atoi(args[1].c_str()) : 65536;
+        if (args.size() > 2 || level < 1 || level > 9 || size <= 0) {
+            driver.error(@0, "SecDebugLogBuffer expects a debug level and optionally a size in bytes, got: " + $1);
+            YYERROR;
+        }
+        driver.m_debugLogBufferLevel.m_set = true;
+        driver.m_debugLogBufferLevel.m_value = level;
+        driver.m_debugLogBufferSize.m_set = true;
+        driver.m_debugLogBufferSize.m_value = size;
+      }
+    | CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH
+      {
+        std::string error;
+        Utils::DebugLogBufferFlush flush;
+        if (flush.parse($1, &error) == false) {
+            driver.error(@0, "SecDebugLogBufferFlush: " + error);
+            YYERROR;
+        }
+        driver.m_debugLogBufferFlush.m_set = true;
+        driver.m_debugLogBufferFlush.m_value = $1;
+      }
+    | CONFIG_SEC_DEBUG_LOG_FILTER
+      {
+        std::string error;
+        Utils::DebugLogFilter filter;
+        if (filter.parse($1, &error) == false) {
+            driver.error(@0, "SecDebugLogFilter: " + error);
+            YYERROR;
+        }
+        driver.m_debugLogFilter.m_set = true;
+        driver.m_debugLogFilter.m_value = $1;
+      }
+    | CONFIG_SEC_HUGE_PAGES
+      {
+        /* process wide, and for what the lines that follow compile */
+        std::string mode = utils::string::tolower($1);
+        if (mode == "off") {
+            Utils::HugePages::setMode(Utils::HugePages::Off);
+        } else if (mode == "on") {
+            Utils::HugePages::setMode(Utils::HugePages::Transparent);
+        } else if (mode == "explicit") {
+            Utils::HugePages::setMode(Utils::HugePages::Explicit);
+        } else {
+            driver.error(@0, "SecHugePages expects On, Off or Explicit, got: " + $1);
+            YYERROR;
+        }
+      }
     ;
 
 variables:
@@ -1892,26 +2448,32 @@ var:
     | VARIABLE_ARGS_POST DICT_ELEMENT
       {
         VARIABLE_CONTAINER($$, new variables::ArgsPost_DictElement($2));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ArgsPost);
       }
     | VARIABLE_ARGS_POST DICT_ELEMENT_REGEXP
       {
         VARIABLE_CONTAINER($$, new variables::ArgsPost_DictElementRegexp($2));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ArgsPost);
       }
     | VARIABLE_ARGS_POST
       {
         VARIABLE_CONTAINER($$, new variables::ArgsPost_NoDictElement());
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ArgsPost);
       }
     | VARIABLE_ARGS_GET DICT_ELEMENT
       {
         VARIABLE_CONTAINER($$, new variables::ArgsGet_DictElement($2));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ArgsGet);
       }
     | VARIABLE_ARGS_GET DICT_ELEMENT_REGEXP
       {
         VARIABLE_CONTAINER($$, new variables::ArgsGet_DictElementRegexp($2));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ArgsGet);
       }
     | VARIABLE_ARGS_GET
       {
         VARIABLE_CONTAINER($$, new variables::ArgsGet_NoDictElement());
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ArgsGet);
       }
     | VARIABLE_FILES_SIZES DICT_ELEMENT
       {
@@ -1940,14 +2502,17 @@ var:
     | VARIABLE_FILES_TMP_CONTENT DICT_ELEMENT
       {
         VARIABLE_CONTAINER($$, new variables::FilesTmpContent_DictElement($2));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::FilesTmpContent);
       }
     | VARIABLE_FILES_TMP_CONTENT DICT_ELEMENT_REGEXP
       {
         VARIABLE_CONTAINER($$, new variables::FilesTmpContent_DictElementRegexp($2));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::FilesTmpContent);
       }
     | VARIABLE_FILES_TMP_CONTENT
       {
         VARIABLE_CONTAINER($$, new variables::FilesTmpContent_NoDictElement());
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::FilesTmpContent);
       }
     | VARIABLE_MULTIPART_FILENAME DICT_ELEMENT
       {
@@ -2012,14 +2577,17 @@ var:
     | VARIABLE_REQUEST_COOKIES DICT_ELEMENT
       {
         VARIABLE_CONTAINER($$, new variables::RequestCookies_DictElement($2));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::RequestCookies);
       }
     | VARIABLE_REQUEST_COOKIES DICT_ELEMENT_REGEXP
       {
         VARIABLE_CONTAINER($$, new variables::RequestCookies_DictElementRegexp($2));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::RequestCookies);
       }
     | VARIABLE_REQUEST_COOKIES
       {
         VARIABLE_CONTAINER($$, new variables::RequestCookies_NoDictElement());
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::RequestCookies);
       }
     | VARIABLE_REQUEST_HEADERS DICT_ELEMENT
       {
@@ -2060,14 +2628,17 @@ var:
     | VARIABLE_REQUEST_COOKIES_NAMES DICT_ELEMENT
       {
         VARIABLE_CONTAINER($$, new variables::RequestCookiesNames_DictElement($2));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::RequestCookies);
       }
     | VARIABLE_REQUEST_COOKIES_NAMES DICT_ELEMENT_REGEXP
       {
         VARIABLE_CONTAINER($$, new variables::RequestCookiesNames_DictElementRegexp($2));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::RequestCookies);
       }
     | VARIABLE_REQUEST_COOKIES_NAMES
       {
         VARIABLE_CONTAINER($$, new variables::RequestCookiesNames_NoDictElement());
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::RequestCookies);
       }
     | VARIABLE_MULTIPART_PART_HEADERS DICT_ELEMENT
       {
@@ -2108,14 +2679,17 @@ var:
     | RUN_TIME_VAR_XML DICT_ELEMENT
       {
         VARIABLE_CONTAINER($$, new variables::XML("XML:" + $2));
+        driver.m_xmlDomRequired = modsecurity::RulesSetProperties::TrueConfigBoolean;
       }
     | RUN_TIME_VAR_XML DICT_ELEMENT_REGEXP
       {
         VARIABLE_CONTAINER($$, new variables::XML("XML:" + $2));
+        driver.m_xmlDomRequired = modsecurity::RulesSetProperties::TrueConfigBoolean;
       }
     | RUN_TIME_VAR_XML
       {
         VARIABLE_CONTAINER($$, new variables::XML_NoDictElement());
+        driver.m_xmlDomRequired = modsecurity::RulesSetProperties::TrueConfigBoolean;
       }
     | VARIABLE_FILES_TMP_NAMES DICT_ELEMENT
       {
@@ -2240,40 +2814,49 @@ var:
     | VARIABLE_ARGS_GET_NAMES DICT_ELEMENT
       {
         VARIABLE_CONTAINER($$, new variables::ArgsGetNames_DictElement($2));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ArgsGet);
       }
     | VARIABLE_ARGS_GET_NAMES DICT_ELEMENT_REGEXP
       {
         VARIABLE_CONTAINER($$, new variables::ArgsGetNames_DictElementRegexp($2));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ArgsGet);
       }
     | VARIABLE_ARGS_GET_NAMES
       {
         VARIABLE_CONTAINER($$, new variables::ArgsGetNames_NoDictElement());
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ArgsGet);
       }
 
     | VARIABLE_ARGS_POST_NAMES DICT_ELEMENT
       {
         VARIABLE_CONTAINER($$, new variables::ArgsPostNames_DictElement($2));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ArgsPost);
       }
     | VARIABLE_ARGS_POST_NAMES DICT_ELEMENT_REGEXP
       {
         VARIABLE_CONTAINER($$, new variables::ArgsPostNames_DictElementRegexp($2));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ArgsPost);
       }
     | VARIABLE_ARGS_POST_NAMES
       {
         VARIABLE_CONTAINER($$, new variables::ArgsPostNames_NoDictElement());
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ArgsPost);
       }
 
     | VARIABLE_REQUEST_HEADERS_NAMES DICT_ELEMENT
       {
         VARIABLE_CONTAINER($$, new variables::RequestHeadersNames_DictElement($2));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::RequestHeadersNames);
       }
     | VARIABLE_REQUEST_HEADERS_NAMES DICT_ELEMENT_REGEXP
       {
         VARIABLE_CONTAINER($$, new variables::RequestHeadersNames_DictElementRegexp($2));
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::RequestHeadersNames);
       }
     | VARIABLE_REQUEST_HEADERS_NAMES
       {
         VARIABLE_CONTAINER($$, new variables::RequestHeadersNames_NoDictElement());
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::RequestHeadersNames);
       }
 
     | VARIABLE_RESPONSE_CONTENT_TYPE
@@ -2300,6 +2883,7 @@ var:
    | VARIABLE_AUTH_TYPE
       {
         VARIABLE_CONTAINER($$, new variables::AuthType());
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::AuthType);
       }
     | VARIABLE_FILES_COMBINED_SIZE
       {
@@ -2333,6 +2917,14 @@ var:
       {
         VARIABLE_CONTAINER($$, new variables::MscPcreLimitsExceeded());
       }
+    | VARIABLE_MSC_MEMORY_LIMIT_EXCEEDED
+      {
+        VARIABLE_CONTAINER($$, new variables::MscMemoryLimitExceeded());
+      }
+    | VARIABLE_MSC_TIME_BUDGET_EXCEEDED
+      {
+        VARIABLE_CONTAINER($$, new variables::MscTimeBudgetExceeded());
+      }
     | VARIABLE_MULTIPART_BOUNDARY_QUOTED
       {
         VARIABLE_CONTAINER($$, new variables::MultipartBoundaryQuoted());
@@ -2396,6 +2988,7 @@ var:
     | VARIABLE_OUTBOUND_DATA_ERROR
       {
         VARIABLE_CONTAINER($$, new variables::OutboundDataError());
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ResponseBody);
       }
     | VARIABLE_PATH_INFO
       {
@@ -2476,10 +3069,12 @@ var:
     | VARIABLE_RESPONSE_BODY
       {
         VARIABLE_CONTAINER($$, new variables::ResponseBody());
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ResponseBody);
       }
     | VARIABLE_RESPONSE_CONTENT_LENGTH
       {
         VARIABLE_CONTAINER($$, new variables::ResponseContentLength());
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ResponseBody);
       }
     | VARIABLE_RESPONSE_PROTOCOL
       {
@@ -2669,6 +3264,12 @@ act:
     | ACTION_CTL_AUDIT_LOG_PARTS
       {
         ACTION_CONTAINER($$, new actions::ctl::AuditLogParts($1));
+        /* may ask for the part E */
+        driver.m_variablesInUse.add(modsecurity::ConfigVariablesInUse::ResponseBody);
+      }
+    | ACTION_CTL_BDY_GRPC
+      {
+        ACTION_CONTAINER($$, new actions::ctl::RequestBodyProcessorGRPC($1));
       }
     | ACTION_CTL_BDY_JSON
       {
@@ -2743,6 +3344,8 @@ act:
     | ACTION_EXEC
       {
         ACTION_CONTAINER($$, new actions::Exec($1));
+        driver.m_variablesInUse.addAll();
+        driver.m_xmlDomRequired = modsecurity::RulesSetProperties::TrueConfigBoolean;
       }
     | ACTION_EXPIRE_VAR
       {
@@ -2785,6 +3388,10 @@ act:
       {
         ACTION_CONTAINER($$, new actions::NoLog($1));
       }
+    | ACTION_NO_VERDICT_CACHE
+      {
+        ACTION_CONTAINER($$, new actions::NoVerdictCache($1));
+      }
     | ACTION_PASS
       {
         ACTION_CONTAINER($$, new actions::disruptive::Pass($1));
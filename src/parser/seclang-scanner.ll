@@ -73,7 +73,12 @@ static std::stack<int> YY_PREVIOUS_STATE;
 
 // The location of the current token.
 %}
-%option noyywrap nounput batch debug noinput
+/*
+ * Full tables (-Cfe): one lookup per input character instead of walking
+ * the default compressed tables. With the equivalence classes in place,
+ * that is about 700 KiB of tables for our ~4000 states.
+ */
+%option noyywrap nounput batch debug noinput full ecs
 
 
 
@@ -86,6 +91,7 @@ ACTION_CAPTURE                                  (?i:capture)
 ACTION_CHAIN                                    (?i:chain)
 ACTION_CTL_AUDIT_ENGINE                         (?i:ctl:auditEngine)
 ACTION_CTL_AUDIT_LOG_PARTS                      (?i:ctl:auditLogParts)
+ACTION_CTL_BDY_GRPC                             (?i:ctl:requestBodyProcessor=GRPC)
 ACTION_CTL_BDY_JSON                             (?i:ctl:requestBodyProcessor=JSON)
 ACTION_CTL_BDY_XML                              (?i:ctl:requestBodyProcessor=XML)
 ACTION_CTL_BDY_URLENCODED                       (?i:ctl:requestBodyProcessor=URLENCODED)
@@ -110,6 +116,7 @@ ACTION_MSG                                      (?i:msg)
 ACTION_MULTI_MATCH                              (?i:multiMatch)
 ACTION_NO_AUDIT_LOG                             (?i:noauditlog)
 ACTION_NO_LOG                                   (?i:nolog)
+ACTION_NO_VERDICT_CACHE                         (?i:noVerdictCache)
 ACTION_PASS                                     (?i:pass)
 ACTION_PAUSE                                    (?i:pause)
 ACTION_PHASE                                    ((?i:phase:(?i:REQUEST|RESPONSE|LOGGING|[0-9]+))|(?i:phase:'(?i:REQUEST|RESPONSE|LOGGING|[0-9]+)'))
@@ -188,6 +195,8 @@ VARIABLE_MATCHED_VAR                      (?i:MATCHED_VAR)
 VARIABLE_MATCHED_VAR_NAME                 (?i:MATCHED_VAR_NAME)
 VARIABLE_MSC_PCRE_ERROR                   (?i:MSC_PCRE_ERROR)
 VARIABLE_MSC_PCRE_LIMITS_EXCEEDED         (?i:MSC_PCRE_LIMITS_EXCEEDED)
+VARIABLE_MSC_MEMORY_LIMIT_EXCEEDED        (?i:MSC_MEMORY_LIMIT_EXCEEDED)
+VARIABLE_MSC_TIME_BUDGET_EXCEEDED         (?i:MSC_TIME_BUDGET_EXCEEDED)
 VARIABLE_MULTIPART_BOUNDARY_QUOTED        (?i:MULTIPART_BOUNDARY_QUOTED)
 VARIABLE_MULTIPART_BOUNDARY_WHITESPACE    (?i:MULTIPART_BOUNDARY_WHITESPACE)
 VARIABLE_MULTIPART_CRLF_LF_LINES          (?i:MULTIPART_CRLF_LF_LINES)
@@ -338,6 +347,7 @@ CONFIG_SEC_HASH_METHOD_RX               (?i:SecHashMethodRx)
 CONFIG_SEC_HASH_METHOD_PM               (?i:SecHashMethodPm)
 CONFIG_CONTENT_INJECTION                (?i:SecContentInjection)
 CONFIG_SEC_ARGUMENT_SEPARATOR           (?i:SecArgumentSeparator)
+CONFIG_DIR_AUDIT_COMPRESSION_LEVEL      (?i:SecAuditLogCompressionLevel)
 CONFIG_DIR_AUDIT_DIR                    (?i:SecAuditLogStorageDir)
 CONFIG_DIR_AUDIT_DIR_MOD                (?i:SecAuditLogDirMode)
 CONFIG_DIR_AUDIT_ENG                    (?i:SecAuditEngine)
@@ -346,7 +356,9 @@ CONFIG_DIR_AUDIT_LOG2                   (?i:SecAuditLog2)
 CONFIG_DIR_AUDIT_LOG                    (?i:SecAuditLog)
 CONFIG_DIR_AUDIT_LOG_FMT                (?i:SecAuditLogFormat)
 CONFIG_DIR_AUDIT_LOG_P                  (?i:SecAuditLogParts)
+CONFIG_DIR_AUDIT_RATE_LIMIT             (?i:SecAuditLogRateLimit)
 CONFIG_DIR_AUDIT_STS                    (?i:SecAuditLogRelevantStatus)
+CONFIG_DIR_AUDIT_TIMINGS                (?i:SecAuditLogTimings)
 CONFIG_DIR_AUDIT_TPE                    (?i:SecAuditLogType)
 CONFIG_DIR_DEBUG_LOG                    (?i:SecDebugLog)
 CONFIG_DIR_DEBUG_LVL                    (?i:SecDebugLogLevel)
@@ -359,12 +371,34 @@ CONFIG_SEC_CONN_W_STATE_LIMIT           (?i:SecConnWriteStateLimit)
 CONFIG_SEC_SENSOR_ID                    (?i:SecSensorId)
 CONFIG_SEC_RULE_INHERITANCE             (?i:SecRuleInheritance)
 CONFIG_SEC_RULE_PERF_TIME               (?i:SecRulePerfTime)
+CONFIG_SEC_RULE_PROFILING               (?i:SecRuleProfiling)
+CONFIG_SEC_RULE_VALUE_MAJOR             (?i:SecRuleValueMajor)
+CONFIG_SEC_RX_PREFILTER                 (?i:SecRxPrefilter)
+CONFIG_SEC_RX_RE2                       (?i:SecRxRe2)
 CONFIG_SEC_STREAM_IN_BODY_INSPECTION    (?i:SecStreamInBodyInspection)
 CONFIG_SEC_STREAM_OUT_BODY_INSPECTION   (?i:SecStreamOutBodyInspection)
+CONFIG_DIR_DATA_RELOAD_INTERVAL         (?i:SecDataReloadInterval)
+CONFIG_DIR_LUA_STATE_POOL_LIMIT         (?i:SecLuaStatePoolLimit)
+CONFIG_DIR_OVERLOAD_DETECTION_ONLY      (?i:SecOverloadDetectionOnly)
+CONFIG_DIR_OVERLOAD_SHED_TAG            (?i:SecOverloadShedTag)
+CONFIG_DIR_OVERLOAD_TARGET              (?i:SecOverloadTarget)
+CONFIG_DIR_PCRE_JIT_STACK_SIZE          (?i:SecPcreJitStackSize)
 CONFIG_DIR_PCRE_MATCH_LIMIT             (?i:SecPcreMatchLimit)
+CONFIG_DIR_RBL_TIMEOUT                  (?i:SecRblTimeout)
+CONFIG_DIR_RULE_EARLY_DECISION          (?i:SecRuleEarlyDecision)
+CONFIG_DIR_RULE_EVALUATION_THREADS      (?i:SecRuleEvaluationThreads)
+CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE   (?i:SecRuleProfilingSampleRate)
+CONFIG_DIR_RX_GUARDRAIL                 (?i:SecRxGuardrail)
+CONFIG_DIR_REGEX_CACHE_FILE             (?i:SecRegexCacheFile)
+CONFIG_DIR_RULE_NATIVE_MODULE           (?i:SecRuleNativeModule)
+CONFIG_DIR_SHADOW_RULES                 (?i:SecShadowRules)
 CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION   (?i:SecPcreMatchLimitRecursion)
 CONFIG_DIR_ARGS_LIMIT                   (?i:SecArgumentsLimit)
+CONFIG_DIR_REQ_BODY_DECOMPRESSION       (?i:SecRequestBodyDecompression)
+CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO (?i:SecRequestBodyDecompressionRatio)
+CONFIG_DIR_RES_BODY_DECOMPRESSION       (?i:SecResponseBodyDecompression)
 CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT    (?i:SecRequestBodyJsonDepthLimit)
+CONFIG_DIR_REQ_BODY_JSON_SIMD           (?i:SecRequestBodyJsonSimd)
 CONFIG_DIR_REQ_BODY                     (?i:SecRequestBodyAccess)
 CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT     (?i:SecRequestBodyInMemoryLimit)
 CONFIG_DIR_REQ_BODY_LIMIT               (?i:SecRequestBodyLimit)
@@ -373,16 +407,30 @@ CONFIG_DIR_REQ_BODY_NO_FILES_LIMIT      (?i:SecRequestBodyNoFilesLimit)
 CONFIG_DIR_RES_BODY                     (?i:SecResponseBodyAccess)
 CONFIG_DIR_RES_BODY_LIMIT               (?i:SecResponseBodyLimit)
 CONFIG_DIR_RES_BODY_LIMIT_ACTION        (?i:SecResponseBodyLimitAction)
+CONFIG_DIR_RES_BODY_STREAM_WINDOW       (?i:SecResponseBodyStreamWindow)
 CONFIG_DIR_RULE_ENG                     (?i:SecRuleEngine)
+CONFIG_DIR_RULE_ENG_SAMPLE_RATE         (?i:SecRuleEngineSampleRate)
 CONFIG_DIR_SEC_ACTION                   (?i:SecAction)
 CONFIG_DIR_SEC_DEFAULT_ACTION           (?i:SecDefaultAction)
 CONFIG_SEC_DISABLE_BACKEND_COMPRESS     (?i:SecDisableBackendCompression)
 CONFIG_DIR_SEC_MARKER                   (?i:SecMarker)
 CONFIG_DIR_UNICODE_MAP_FILE             (?i:SecUnicodeMapFile)
 CONFIG_INCLUDE                          (?i:Include)
+CONFIG_SEC_COLLECTION_GROUP_COMMIT      (?i:SecCollectionGroupCommit)
+CONFIG_SEC_COLLECTION_REDIS_SERVER      (?i:SecCollectionRedisServer)
+CONFIG_SEC_COLLECTION_SYNC_MODE         (?i:SecCollectionSyncMode)
 CONFIG_SEC_COLLECTION_TIMEOUT           (?i:SecCollectionTimeout)
+CONFIG_SEC_TRANSACTION_ID_FORMAT        (?i:SecTransactionIdFormat)
+CONFIG_SEC_TRANSACTION_MEMORY_LIMIT     (?i:SecTransactionMemoryLimit)
+CONFIG_SEC_TRANSACTION_TIME_BUDGET      (?i:SecTransactionTimeBudget)
+CONFIG_SEC_VERDICT_CACHE                (?i:SecVerdictCache)
+CONFIG_SEC_DEBUG_LOG_BUFFER             (?i:SecDebugLogBuffer)
+CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH       (?i:SecDebugLogBufferFlush)
+CONFIG_SEC_DEBUG_LOG_FILTER             (?i:SecDebugLogFilter)
 CONFIG_SEC_HTTP_BLKEY                   (?i:SecHttpBlKey)
+CONFIG_SEC_HUGE_PAGES                   (?i:SecHugePages)
 CONFIG_SEC_REMOTE_RULES                 (?i:SecRemoteRules)
+CONFIG_SEC_REMOTE_RULES_CACHE_DIR       (?i:SecRemoteRulesCacheDir)
 CONFIG_SEC_REMOTE_RULES_FAIL_ACTION     (?i:SecRemoteRulesFailAction)
 CONFIG_SEC_REMOVE_RULES_BY_ID           (?i:SecRuleRemoveById)
 CONFIG_SEC_REMOVE_RULES_BY_MSG          (?i:SecRuleRemoveByMsg)
@@ -393,9 +441,11 @@ CONFIG_SEC_UPDATE_TARGET_BY_ID          (?i:SecRuleUpdateTargetById)
 CONFIG_SEC_UPDATE_ACTION_BY_ID          (?i:SecRuleUpdateActionById)
 CONFIG_UPDLOAD_KEEP_FILES               (?i:SecUploadKeepFiles)
 CONFIG_UPDLOAD_SAVE_TMP_FILES           (?i:SecTmpSaveUploadedFiles)
+CONFIG_UPLOAD_ANONYMOUS_FILES           (?i:SecUploadAnonymousFiles)
 CONFIG_UPLOAD_DIR                       (?i:SecUploadDir)
 CONFIG_UPLOAD_FILE_LIMIT                (?i:SecUploadFileLimit)
 CONFIG_UPLOAD_FILE_MODE                 (?i:SecUploadFileMode)
+CONFIG_UPLOAD_IN_MEMORY_LIMIT           (?i:SecUploadInMemoryLimit)
 CONFIG_VALUE_ABORT                      (?i:Abort)
 CONFIG_VALUE_DETC                       (?i:DetectionOnly)
 CONFIG_VALUE_HTTPS                      (?i:https)
@@ -407,7 +457,9 @@ CONFIG_VALUE_PATH                       [0-9A-Za-z_\/\.\-\*\:]+
 CONFIG_VALUE_PROCESS_PARTIAL            (?i:ProcessPartial)
 CONFIG_VALUE_REJECT                     (?i:Reject)
 CONFIG_VALUE_RELEVANT_ONLY              (?i:RelevantOnly)
+CONFIG_VALUE_RING                       (?i:Ring)
 CONFIG_VALUE_SERIAL                     (?i:Serial)
+CONFIG_VALUE_STREAM                     (?i:Stream)
 CONFIG_VALUE_WARN                       (?i:Warn)
 CONFIG_XML_EXTERNAL_ENTITY              (?i:SecXmlExternalEntity)
 CONGIG_DIR_RESPONSE_BODY_MP             (?i:SecResponseBodyMimeType)
@@ -455,6 +507,7 @@ VAR_FREE_TEXT_SPACE                     [^ \t\"]+
 VAR_FREE_TEXT_SPACE_COMMA               [^, \t\"]+
 
 JSON                                    (?i:JSON)
+MSGPACK                                 (?i:MSGPACK)
 NATIVE                                  (?i:NATIVE)
 
 NEW_LINE                                [\n\r]+
@@ -515,6 +568,7 @@ EQUALS_MINUS                            (?i:=\-)
 {ACTION_MULTI_MATCH}                                                    { return p::make_ACTION_MULTI_MATCH(yytext, *driver.loc.back()); }
 {ACTION_NO_AUDIT_LOG}                                                   { return p::make_ACTION_NO_AUDIT_LOG(yytext, *driver.loc.back()); }
 {ACTION_NO_LOG}                                                         { return p::make_ACTION_NO_LOG(yytext, *driver.loc.back()); }
+{ACTION_NO_VERDICT_CACHE}                                               { return p::make_ACTION_NO_VERDICT_CACHE(yytext, *driver.loc.back()); }
 {ACTION_PASS}                                                           { return p::make_ACTION_PASS(yytext, *driver.loc.back()); }
 {ACTION_PAUSE}                                                          { return p::make_ACTION_PAUSE(yytext, *driver.loc.back()); }
 {ACTION_PREPEND}                                                        { return p::make_ACTION_PREPEND(yytext, *driver.loc.back()); }
@@ -533,6 +587,7 @@ EQUALS_MINUS                            (?i:=\-)
 {ACTION_AUDIT_LOG}                                                      { return p::make_ACTION_AUDIT_LOG(yytext, *driver.loc.back()); }
 {ACTION_CTL_AUDIT_ENGINE}=                                              { return p::make_ACTION_CTL_AUDIT_ENGINE(yytext, *driver.loc.back()); }
 {ACTION_CTL_AUDIT_LOG_PARTS}=[+|-]{AUDIT_PARTS}                         { return p::make_ACTION_CTL_AUDIT_LOG_PARTS(yytext, *driver.loc.back()); }
+{ACTION_CTL_BDY_GRPC}                                                   { return p::make_ACTION_CTL_BDY_GRPC(yytext, *driver.loc.back()); }
 {ACTION_CTL_BDY_JSON}                                                   { return p::make_ACTION_CTL_BDY_JSON(yytext, *driver.loc.back()); }
 {ACTION_CTL_BDY_XML}                                                    { return p::make_ACTION_CTL_BDY_XML(yytext, *driver.loc.back()); }
 {ACTION_CTL_BDY_URLENCODED}                                             { return p::make_ACTION_CTL_BDY_URLENCODED(yytext, *driver.loc.back()); }
@@ -615,6 +670,7 @@ EQUALS_MINUS                            (?i:=\-)
 {CONFIG_VALUE_OFF}                                                      { return p::make_CONFIG_VALUE_OFF(yytext, *driver.loc.back()); }
 {CONFIG_VALUE_ON}                                                       { return p::make_CONFIG_VALUE_ON(yytext, *driver.loc.back()); }
 {CONFIG_VALUE_RELEVANT_ONLY}                                            { return p::make_CONFIG_VALUE_RELEVANT_ONLY(yytext, *driver.loc.back()); }
+{CONFIG_VALUE_RING}                                                     { return p::make_CONFIG_VALUE_RING(yytext, *driver.loc.back()); }
 [ \t]*\\\n[ \t]*                                                        { driver.loc.back()->lines(1); driver.loc.back()->step(); }
 [ \t]*\\\r\n[ \t]*                                                      { driver.loc.back()->lines(1); driver.loc.back()->step(); }
 }
@@ -751,6 +807,7 @@ EQUALS_MINUS                            (?i:=\-)
 {CONFIG_SEC_ARGUMENT_SEPARATOR}[ \t]+["]{NEW_LINE_FREE_TEXT}["]         { return p::make_CONFIG_SEC_ARGUMENT_SEPARATOR(parserSanitizer(strchr(yytext, ' ') + 1), *driver.loc.back()); }
 {CONFIG_SEC_ARGUMENT_SEPARATOR}[ \t]+{NEW_LINE_FREE_TEXT}               { return p::make_CONFIG_SEC_ARGUMENT_SEPARATOR(parserSanitizer(strchr(yytext, ' ') + 1), *driver.loc.back()); }
 {CONFIG_DIR_AUDIT_ENG}                                                  { return p::make_CONFIG_DIR_AUDIT_ENG(yytext, *driver.loc.back()); }
+{CONFIG_DIR_AUDIT_COMPRESSION_LEVEL}[ \t]+{CONFIG_VALUE_NUMBER}         { return p::make_CONFIG_DIR_AUDIT_COMPRESSION_LEVEL(strchr(yytext, ' ') + 1, *driver.loc.back()); }
 {CONFIG_DIR_AUDIT_FLE_MOD}[ \t]+{CONFIG_VALUE_NUMBER}                   { return p::make_CONFIG_DIR_AUDIT_FLE_MOD(strchr(yytext, ' ') + 1, *driver.loc.back()); }
 {CONFIG_DIR_AUDIT_LOG2}[ \t]+{CONFIG_VALUE_PATH}                        { return p::make_CONFIG_DIR_AUDIT_LOG2(strchr(yytext, ' ') + 1, *driver.loc.back()); }
 {CONFIG_DIR_AUDIT_LOG_P}[ \t]+{AUDIT_PARTS}                             { return p::make_CONFIG_DIR_AUDIT_LOG_P(parserSanitizer(strchr(yytext, ' ') + 1), *driver.loc.back()); }
@@ -758,8 +815,10 @@ EQUALS_MINUS                            (?i:=\-)
 {CONFIG_DIR_AUDIT_LOG}[ \t]+{CONFIG_VALUE_PATH}                         { return p::make_CONFIG_DIR_AUDIT_LOG(strchr(yytext, ' ') + 1, *driver.loc.back()); }
 {CONFIG_DIR_AUDIT_LOG_FMT}                                              { return p::make_CONFIG_DIR_AUDIT_LOG_FMT(*driver.loc.back()); }
 {JSON}                                                                  { return p::make_JSON(*driver.loc.back()); }
+{MSGPACK}                                                               { return p::make_MSGPACK(*driver.loc.back()); }
 {NATIVE}                                                                { return p::make_NATIVE(*driver.loc.back()); }
 {CONFIG_DIR_AUDIT_LOG}[ \t]+["]{CONFIG_VALUE_PATH}["]                   { return p::make_CONFIG_DIR_AUDIT_LOG(parserSanitizer(strchr(yytext, ' ') + 1), *driver.loc.back()); }
+{CONFIG_DIR_AUDIT_RATE_LIMIT}[ \t]+{CONFIG_VALUE_NUMBER}                { return p::make_CONFIG_DIR_AUDIT_RATE_LIMIT(strchr(yytext, ' ') + 1, *driver.loc.back()); }
 {CONFIG_DIR_AUDIT_STS}[ \t]+{FREE_TEXT_NEW_LINE}                        { return p::make_CONFIG_DIR_AUDIT_STS(parserSanitizer(strchr(yytext, ' ') + 1), *driver.loc.back()); }
 {CONFIG_DIR_AUDIT_STS}[ \t]+["]{NEW_LINE_FREE_TEXT}["]                  { return p::make_CONFIG_DIR_AUDIT_STS(parserSanitizer(strchr(yytext, ' ') + 1), *driver.loc.back()); }
 {CONFIG_DIR_AUDIT_TPE}                                                  { return p::make_CONFIG_DIR_AUDIT_TPE(yytext, *driver.loc.back()); }
@@ -770,8 +829,23 @@ EQUALS_MINUS                            (?i:=\-)
 {CONFIG_DIR_DEBUG_LVL}[ \t]+{CONFIG_VALUE_NUMBER}                       { return p::make_CONFIG_DIR_DEBUG_LVL(strchr(yytext, ' ') + 1, *driver.loc.back()); }
 {CONFIG_DIR_GEO_DB}[ \t]+{FREE_TEXT_NEW_LINE}                           { return p::make_CONFIG_DIR_GEO_DB(strchr(yytext, ' ') + 1, *driver.loc.back()); }
 {CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION}[ \t]+{CONFIG_VALUE_NUMBER}      { return p::make_CONFIG_DIR_PCRE_MATCH_LIMIT_RECURSION(strchr(yytext, ' ') + 1, *driver.loc.back()); }
+{CONFIG_DIR_DATA_RELOAD_INTERVAL}[ \t]+{CONFIG_VALUE_NUMBER}            { return p::make_CONFIG_DIR_DATA_RELOAD_INTERVAL(strchr(yytext, ' ') + 1, *driver.loc.back()); }
+{CONFIG_DIR_LUA_STATE_POOL_LIMIT}[ \t]+{CONFIG_VALUE_NUMBER}            { return p::make_CONFIG_DIR_LUA_STATE_POOL_LIMIT(strchr(yytext, ' ') + 1, *driver.loc.back()); }
+{CONFIG_DIR_PCRE_JIT_STACK_SIZE}[ \t]+{CONFIG_VALUE_NUMBER}             { return p::make_CONFIG_DIR_PCRE_JIT_STACK_SIZE(strchr(yytext, ' ') + 1, *driver.loc.back()); }
 {CONFIG_DIR_PCRE_MATCH_LIMIT}[ \t]+{CONFIG_VALUE_NUMBER}                { return p::make_CONFIG_DIR_PCRE_MATCH_LIMIT(strchr(yytext, ' ') + 1, *driver.loc.back()); }
+{CONFIG_DIR_RBL_TIMEOUT}[ \t]+{CONFIG_VALUE_NUMBER}                     { return p::make_CONFIG_DIR_RBL_TIMEOUT(strchr(yytext, ' ') + 1, *driver.loc.back()); }
+{CONFIG_DIR_RULE_EVALUATION_THREADS}[ \t]+{CONFIG_VALUE_NUMBER}         { return p::make_CONFIG_DIR_RULE_EVALUATION_THREADS(strchr(yytext, ' ') + 1, *driver.loc.back()); }
+{CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE}[ \t]+{CONFIG_VALUE_NUMBER}      { return p::make_CONFIG_DIR_RULE_PROFILING_SAMPLE_RATE(strchr(yytext, ' ') + 1, *driver.loc.back()); }
+{CONFIG_DIR_RX_GUARDRAIL}[ \t]+{CONFIG_VALUE_NUMBER}                    { return p::make_CONFIG_DIR_RX_GUARDRAIL(strchr(yytext, ' ') + 1, *driver.loc.back()); }
+{CONFIG_DIR_RULE_ENG_SAMPLE_RATE}[ \t]+[0-9]+([.][0-9]+)?[%]?([ \t]+[a-zA-Z]+)? { return p::make_CONFIG_DIR_RULE_ENG_SAMPLE_RATE(strchr(yytext, ' ') + 1, *driver.loc.back()); }
+{CONFIG_DIR_REGEX_CACHE_FILE}[ \t]+{CONFIG_VALUE_PATH}                  { return p::make_CONFIG_DIR_REGEX_CACHE_FILE(strchr(yytext, ' ') + 1, *driver.loc.back()); }
+{CONFIG_DIR_REGEX_CACHE_FILE}[ \t]+["]{CONFIG_VALUE_PATH}["]            { return p::make_CONFIG_DIR_REGEX_CACHE_FILE(parserSanitizer(strchr(yytext, ' ') + 1), *driver.loc.back()); }
+{CONFIG_DIR_RULE_NATIVE_MODULE}[ \t]+{CONFIG_VALUE_PATH}                { return p::make_CONFIG_DIR_RULE_NATIVE_MODULE(strchr(yytext, ' ') + 1, *driver.loc.back()); }
+{CONFIG_DIR_RULE_NATIVE_MODULE}[ \t]+["]{CONFIG_VALUE_PATH}["]          { return p::make_CONFIG_DIR_RULE_NATIVE_MODULE(parserSanitizer(strchr(yytext, ' ') + 1), *driver.loc.back()); }
+{CONFIG_DIR_SHADOW_RULES}[ \t]+{CONFIG_VALUE_PATH}                      { return p::make_CONFIG_DIR_SHADOW_RULES(strchr(yytext, ' ') + 1, *driver.loc.back()); }
+{CONFIG_DIR_SHADOW_RULES}[ \t]+["]{CONFIG_VALUE_PATH}["]                { return p::make_CONFIG_DIR_SHADOW_RULES(parserSanitizer(strchr(yytext, ' ') + 1), *driver.loc.back()); }
 {CONFIG_DIR_ARGS_LIMIT}[ \t]+{CONFIG_VALUE_NUMBER}                      { return p::make_CONFIG_DIR_ARGS_LIMIT(strchr(yytext, ' ') + 1, *driver.loc.back()); }
+{CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO}[ \t]+{CONFIG_VALUE_NUMBER}    { return p::make_CONFIG_DIR_REQ_BODY_DECOMPRESSION_RATIO(strchr(yytext, ' ') + 1, *driver.loc.back()); }
 {CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT}[ \t]+{CONFIG_VALUE_NUMBER}       { return p::make_CONFIG_DIR_REQ_BODY_JSON_DEPTH_LIMIT(strchr(yytext, ' ') + 1, *driver.loc.back()); }
 {CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT}[ \t]+{CONFIG_VALUE_NUMBER}        { return p::make_CONFIG_DIR_REQ_BODY_IN_MEMORY_LIMIT(strchr(yytext, ' ') + 1, *driver.loc.back()); }
 
@@ -781,6 +855,7 @@ EQUALS_MINUS                            (?i:=\-)
 {CONFIG_DIR_REQ_BODY}                                                   { return p::make_CONFIG_DIR_REQ_BODY(yytext, *driver.loc.back()); }
 {CONFIG_DIR_RES_BODY_LIMIT_ACTION}                                      { return p::make_CONFIG_DIR_RES_BODY_LIMIT_ACTION(yytext, *driver.loc.back()); }
 {CONFIG_DIR_RES_BODY_LIMIT}[ \t]+{CONFIG_VALUE_NUMBER}                  { return p::make_CONFIG_DIR_RES_BODY_LIMIT(strchr(yytext, ' ') + 1, *driver.loc.back()); }
+{CONFIG_DIR_RES_BODY_STREAM_WINDOW}[ \t]+{CONFIG_VALUE_NUMBER}          { return p::make_CONFIG_DIR_RES_BODY_STREAM_WINDOW(strchr(yytext, ' ') + 1, *driver.loc.back()); }
 {CONFIG_DIR_RES_BODY}                                                   { return p::make_CONFIG_DIR_RES_BODY(yytext, *driver.loc.back()); }
 {CONFIG_DIR_RULE_ENG}                                                   { return p::make_CONFIG_DIR_RULE_ENG(yytext, *driver.loc.back()); }
 {CONFIG_DIR_SEC_MARKER}[ \t]+["]{NEW_LINE_FREE_TEXT}["]                 { return p::make_CONFIG_DIR_SEC_MARKER(strchr(yytext, ' ') + 1, *driver.loc.back()); }
@@ -801,10 +876,12 @@ EQUALS_MINUS                            (?i:=\-)
 {CONFIG_SEC_UPDATE_ACTION_BY_ID}[ \t]+{FREE_TEXT_SPACE_COMMA_QUOTE}     { BEGIN(TRANSACTION_FROM_OPERATOR_TO_ACTIONS); return p::make_CONFIG_SEC_RULE_UPDATE_ACTION_BY_ID(parserSanitizer(strchr(yytext, ' ') + 1), *driver.loc.back()); }
 {CONFIG_UPDLOAD_KEEP_FILES}                                             { return p::make_CONFIG_UPDLOAD_KEEP_FILES(yytext, *driver.loc.back()); }
 {CONFIG_UPDLOAD_SAVE_TMP_FILES}                                         { return p::make_CONFIG_UPDLOAD_SAVE_TMP_FILES(yytext, *driver.loc.back()); }
+{CONFIG_UPLOAD_ANONYMOUS_FILES}                                         { return p::make_CONFIG_UPLOAD_ANONYMOUS_FILES(yytext, *driver.loc.back()); }
 {CONFIG_UPLOAD_DIR}[ \t]+{CONFIG_VALUE_PATH}                            { return p::make_CONFIG_UPLOAD_DIR(parserSanitizer(strchr(yytext, ' ') + 1), *driver.loc.back()); }
 {CONFIG_UPLOAD_DIR}[ \t]+["]{CONFIG_VALUE_PATH}["]                      { return p::make_CONFIG_UPLOAD_DIR(parserSanitizer(strchr(yytext, ' ') + 1), *driver.loc.back()); }
 {CONFIG_UPLOAD_FILE_LIMIT}[ \t]+{CONFIG_VALUE_NUMBER}                   { return p::make_CONFIG_UPLOAD_FILE_LIMIT(strchr(yytext, ' ') + 1, *driver.loc.back()); }
 {CONFIG_UPLOAD_FILE_MODE}[ \t]+{CONFIG_VALUE_NUMBER}                    { return p::make_CONFIG_UPLOAD_FILE_MODE(strchr(yytext, ' ') + 1, *driver.loc.back()); }
+{CONFIG_UPLOAD_IN_MEMORY_LIMIT}[ \t]+{CONFIG_VALUE_NUMBER}              { return p::make_CONFIG_UPLOAD_IN_MEMORY_LIMIT(strchr(yytext, ' ') + 1, *driver.loc.back()); }
 {CONFIG_VALUE_ABORT}                                                    { return p::make_CONFIG_VALUE_ABORT(yytext, *driver.loc.back()); }
 {CONFIG_VALUE_DETC}                                                     { return p::make_CONFIG_VALUE_DETC(yytext, *driver.loc.back()); }
 {CONFIG_VALUE_HTTPS}                                                    { return p::make_CONFIG_VALUE_HTTPS(yytext, *driver.loc.back()); }
@@ -815,8 +892,17 @@ EQUALS_MINUS                            (?i:=\-)
 {CONFIG_VALUE_REJECT}                                                   { return p::make_CONFIG_VALUE_REJECT(yytext, *driver.loc.back()); }
 {CONFIG_VALUE_RELEVANT_ONLY}                                            { return p::make_CONFIG_VALUE_RELEVANT_ONLY(yytext, *driver.loc.back()); }
 {CONFIG_VALUE_SERIAL}                                                   { return p::make_CONFIG_VALUE_SERIAL(yytext, *driver.loc.back()); }
+{CONFIG_VALUE_STREAM}                                                   { return p::make_CONFIG_VALUE_STREAM(yytext, *driver.loc.back()); }
 {CONFIG_VALUE_WARN}                                                     { return p::make_CONFIG_VALUE_WARN(yytext, *driver.loc.back()); }
 {CONFIG_XML_EXTERNAL_ENTITY}                                            { return p::make_CONFIG_XML_EXTERNAL_ENTITY(yytext, *driver.loc.back()); }
+{CONFIG_SEC_RX_PREFILTER}                                               { return p::make_CONFIG_SEC_RX_PREFILTER(yytext, *driver.loc.back()); }
+{CONFIG_SEC_RX_RE2}                                                     { return p::make_CONFIG_SEC_RX_RE2(yytext, *driver.loc.back()); }
+{CONFIG_DIR_REQ_BODY_DECOMPRESSION}                                      { return p::make_CONFIG_DIR_REQ_BODY_DECOMPRESSION(yytext, *driver.loc.back()); }
+{CONFIG_DIR_RES_BODY_DECOMPRESSION}                                      { return p::make_CONFIG_DIR_RES_BODY_DECOMPRESSION(yytext, *driver.loc.back()); }
+{CONFIG_DIR_AUDIT_TIMINGS}                                              { return p::make_CONFIG_DIR_AUDIT_TIMINGS(yytext, *driver.loc.back()); }
+{CONFIG_DIR_REQ_BODY_JSON_SIMD}                                         { return p::make_CONFIG_DIR_REQ_BODY_JSON_SIMD(yytext, *driver.loc.back()); }
+{CONFIG_SEC_RULE_PROFILING}                                             { return p::make_CONFIG_SEC_RULE_PROFILING(yytext, *driver.loc.back()); }
+{CONFIG_SEC_RULE_VALUE_MAJOR}                                           { return p::make_CONFIG_SEC_RULE_VALUE_MAJOR(yytext, *driver.loc.back()); }
 {CONGIG_DIR_RESPONSE_BODY_MP}[ \t]+{FREE_TEXT_NEW_LINE}                 { return p::make_CONGIG_DIR_RESPONSE_BODY_MP(strchr(yytext, ' ') + 1, *driver.loc.back()); }
 {CONGIG_DIR_RESPONSE_BODY_MP_CLEAR}                                     { return p::make_CONGIG_DIR_RESPONSE_BODY_MP_CLEAR(*driver.loc.back()); }
 {CONGIG_DIR_SEC_ARG_SEP}[ \t]+{FREE_TEXT_NEW_LINE}                      { return p::make_CONGIG_DIR_SEC_ARG_SEP(yytext, *driver.loc.back()); }
@@ -841,6 +927,7 @@ EQUALS_MINUS                            (?i:=\-)
 {CONFIG_SEC_HASH_METHOD_PM}                                             { return p::make_CONFIG_SEC_HASH_METHOD_PM(yytext, *driver.loc.back()); }
 {CONFIG_DIR_GSB_DB}[ \t]+{CONFIG_VALUE_PATH}                            { return p::make_CONFIG_DIR_GSB_DB(parserSanitizer(strchr(yytext, ' ') + 1), *driver.loc.back()); }
 {CONFIG_DIR_GSB_DB}[ \t]+["]{CONFIG_VALUE_PATH}["]                      { return p::make_CONFIG_DIR_GSB_DB(parserSanitizer(strchr(yytext, ' ') + 1), *driver.loc.back()); }
+{CONFIG_DIR_GSB_DB}[ \t]+{CONFIG_VALUE_PATH}[ \t]+{CONFIG_VALUE_PATH}     { return p::make_CONFIG_DIR_GSB_DB(parserSanitizer(strchr(yytext, ' ') + 1), *driver.loc.back()); }
 {CONFIG_SEC_GUARDIAN_LOG}                                               { return p::make_CONFIG_SEC_GUARDIAN_LOG(yytext, *driver.loc.back()); }
 {CONFIG_SEC_INTERCEPT_ON_ERROR}                                         { return p::make_CONFIG_SEC_INTERCEPT_ON_ERROR(yytext, *driver.loc.back()); }
 {CONFIG_SEC_CONN_R_STATE_LIMIT}{FREE_TEXT_NEW_LINE}                     { return p::make_CONFIG_SEC_CONN_R_STATE_LIMIT(yytext, *driver.loc.back()); }
@@ -856,9 +943,27 @@ EQUALS_MINUS                            (?i:=\-)
 {CONFIG_DIR_SEC_DEFAULT_ACTION}                                         { BEGIN(TRANSACTION_FROM_DIRECTIVE_TO_ACTIONS); return p::make_CONFIG_DIR_SEC_DEFAULT_ACTION(yytext, *driver.loc.back()); }
 {CONFIG_DIR_SEC_ACTION}                                                 { BEGIN(TRANSACTION_FROM_DIRECTIVE_TO_ACTIONS); return p::make_CONFIG_DIR_SEC_ACTION(yytext, *driver.loc.back()); }
 
+{CONFIG_SEC_REMOTE_RULES_CACHE_DIR}[ \t]+{FREE_TEXT_NEW_LINE}          { return p::make_CONFIG_SEC_REMOTE_RULES_CACHE_DIR(parserSanitizer(strchr(yytext, ' ') + 1), *driver.loc.back()); }
 {CONFIG_SEC_REMOTE_RULES_FAIL_ACTION}                                   { return p::make_CONFIG_SEC_REMOTE_RULES_FAIL_ACTION(yytext, *driver.loc.back()); }
+{CONFIG_SEC_COLLECTION_GROUP_COMMIT}[ \t]+{CONFIG_VALUE_NUMBER}         { return p::make_CONFIG_SEC_COLLECTION_GROUP_COMMIT(strchr(yytext, ' ') + 1, *driver.loc.back()); }
+{CONFIG_SEC_COLLECTION_REDIS_SERVER}[ \t]+{FREE_TEXT_NEW_LINE}         { return p::make_CONFIG_SEC_COLLECTION_REDIS_SERVER(parserSanitizer(strchr(yytext, ' ') + 1), *driver.loc.back()); }
+{CONFIG_DIR_RULE_EARLY_DECISION}[ \t]+{FREE_TEXT_NEW_LINE}             { return p::make_CONFIG_DIR_RULE_EARLY_DECISION(parserSanitizer(strchr(yytext, ' ') + 1), *driver.loc.back()); }
+{CONFIG_DIR_OVERLOAD_DETECTION_ONLY}[ \t]+{FREE_TEXT_NEW_LINE}         { return p::make_CONFIG_DIR_OVERLOAD_DETECTION_ONLY(parserSanitizer(strchr(yytext, ' ') + 1), *driver.loc.back()); }
+{CONFIG_DIR_OVERLOAD_SHED_TAG}[ \t]+{FREE_TEXT_NEW_LINE}               { return p::make_CONFIG_DIR_OVERLOAD_SHED_TAG(parserSanitizer(strchr(yytext, ' ') + 1), *driver.loc.back()); }
+{CONFIG_DIR_OVERLOAD_TARGET}[ \t]+{FREE_TEXT_NEW_LINE}                 { return p::make_CONFIG_DIR_OVERLOAD_TARGET(parserSanitizer(strchr(yytext, ' ') + 1), *driver.loc.back()); }
+{CONFIG_SEC_COLLECTION_SYNC_MODE}[ \t]+{FREE_TEXT_NEW_LINE}            { return p::make_CONFIG_SEC_COLLECTION_SYNC_MODE(parserSanitizer(strchr(yytext, ' ') + 1), *driver.loc.back()); }
 {CONFIG_SEC_COLLECTION_TIMEOUT}[ \t]+{CONFIG_VALUE_NUMBER}              { return p::make_CONFIG_SEC_COLLECTION_TIMEOUT(strchr(yytext, ' ') + 1, *driver.loc.back()); }
+{CONFIG_SEC_TRANSACTION_MEMORY_LIMIT}[ \t]+{CONFIG_VALUE_NUMBER}        { return p::make_CONFIG_SEC_TRANSACTION_MEMORY_LIMIT(strchr(yytext, ' ') + 1, *driver.loc.back()); }
+{CONFIG_SEC_TRANSACTION_TIME_BUDGET}[ \t]+{CONFIG_VALUE_NUMBER}         { return p::make_CONFIG_SEC_TRANSACTION_TIME_BUDGET(strchr(yytext, ' ') + 1, *driver.loc.back()); }
+{CONFIG_SEC_VERDICT_CACHE}[ \t]+{CONFIG_VALUE_NUMBER}                   { return p::make_CONFIG_SEC_VERDICT_CACHE(strchr(yytext, ' ') + 1, *driver.loc.back()); }
+{CONFIG_SEC_TRANSACTION_ID_FORMAT}[ \t]+{FREE_TEXT_NEW_LINE}           { return p::make_CONFIG_SEC_TRANSACTION_ID_FORMAT(parserSanitizer(strchr(yytext, ' ') + 1), *driver.loc.back()); }
 {CONFIG_SEC_HTTP_BLKEY}[ \t]+{FREE_TEXT_NEW_LINE}                       { return p::make_CONFIG_SEC_HTTP_BLKEY(strchr(yytext, ' ') + 1, *driver.loc.back()); }
+{CONFIG_SEC_DEBUG_LOG_BUFFER}[ \t]+{FREE_TEXT_NEW_LINE}                 { return p::make_CONFIG_SEC_DEBUG_LOG_BUFFER(parserSanitizer(strchr(yytext, ' ') + 1), *driver.loc.back()); }
+{CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH}[ \t]+["]{FREE_TEXT}["]             { return p::make_CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH(parserSanitizer(strchr(yytext, ' ') + 1), *driver.loc.back()); }
+{CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH}[ \t]+{FREE_TEXT_NEW_LINE}           { return p::make_CONFIG_SEC_DEBUG_LOG_BUFFER_FLUSH(parserSanitizer(strchr(yytext, ' ') + 1), *driver.loc.back()); }
+{CONFIG_SEC_DEBUG_LOG_FILTER}[ \t]+["]{FREE_TEXT}["]                   { return p::make_CONFIG_SEC_DEBUG_LOG_FILTER(parserSanitizer(strchr(yytext, ' ') + 1), *driver.loc.back()); }
+{CONFIG_SEC_DEBUG_LOG_FILTER}[ \t]+{FREE_TEXT_NEW_LINE}                 { return p::make_CONFIG_SEC_DEBUG_LOG_FILTER(parserSanitizer(strchr(yytext, ' ') + 1), *driver.loc.back()); }
+{CONFIG_SEC_HUGE_PAGES}[ \t]+{FREE_TEXT_NEW_LINE}                       { return p::make_CONFIG_SEC_HUGE_PAGES(parserSanitizer(strchr(yytext, ' ') + 1), *driver.loc.back()); }
 [ \t]*[\n]                                                              { driver.loc.back()->lines(1); driver.loc.back()->step(); }
 #[ \t]*SecRule[^\\].*\\[ \t]*[\r\n]*                                    { driver.loc.back()->lines(1); driver.loc.back()->step(); BEGIN(COMMENT); }
 #[ \t]*SecAction[^\\].*\\[ \t]*[^\\n]                                   { driver.loc.back()->lines(1); driver.loc.back()->step(); BEGIN(COMMENT);  }
@@ -914,6 +1019,8 @@ EQUALS_MINUS                            (?i:=\-)
 {VARIABLE_MATCHED_VAR}                      { return p::make_VARIABLE_MATCHED_VAR(*driver.loc.back()); }
 {VARIABLE_MSC_PCRE_ERROR}                   { return p::make_VARIABLE_MSC_PCRE_ERROR(*driver.loc.back()); }
 {VARIABLE_MSC_PCRE_LIMITS_EXCEEDED}         { return p::make_VARIABLE_MSC_PCRE_LIMITS_EXCEEDED(*driver.loc.back()); }
+{VARIABLE_MSC_MEMORY_LIMIT_EXCEEDED}        { return p::make_VARIABLE_MSC_MEMORY_LIMIT_EXCEEDED(*driver.loc.back()); }
+{VARIABLE_MSC_TIME_BUDGET_EXCEEDED}         { return p::make_VARIABLE_MSC_TIME_BUDGET_EXCEEDED(*driver.loc.back()); }
 {VARIABLE_MULTIPART_BOUNDARY_QUOTED}        { return p::make_VARIABLE_MULTIPART_BOUNDARY_QUOTED(*driver.loc.back()); }
 {VARIABLE_MULTIPART_BOUNDARY_WHITESPACE}    { return p::make_VARIABLE_MULTIPART_BOUNDARY_WHITESPACE(*driver.loc.back()); }
 {VARIABLE_MULTIPART_CRLF_LF_LINES}          { return p::make_VARIABLE_MULTIPART_CRLF_LF_LINES(*driver.loc.back()); }
@@ -1347,7 +1454,13 @@ bool Driver::scan_begin () {
     yy_flex_debug = trace_scanning;
 
     if (buffer.empty() == false) {
-        yy_scan_string(buffer.c_str());
+        /*
+         * Scanned in place. flex wants two NULs at the end, and the rules
+         * end at the first NUL, as they did with yy_scan_string().
+         */
+        buffer.resize(strlen(buffer.c_str()));
+        buffer.append(2, '\0');
+        yy_scan_buffer(&buffer[0], buffer.size());
         return true;
     }
     return false;
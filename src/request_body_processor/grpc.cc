@@ -0,0 +1,385 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/request_body_processor/grpc.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "src/utils/inflate.h"
+
+
+namespace modsecurity {
+namespace RequestBodyProcessor {
+
+/* the recursion limit of the protobuf library itself */
+static const int grpc_depth_limit = 100;
+
+enum WireType {
+    VarintWireType = 0,
+    Fixed64WireType = 1,
+    LengthDelimitedWireType = 2,
+    StartGroupWireType = 3,
+    EndGroupWireType = 4,
+    Fixed32WireType = 5,
+};
+
+
+static bool readVarint(const unsigned char *buf, size_t size, size_t *pos,
+    uint64_t *value) {
+    uint64_t v = 0;
+    for (int shift = 0; shift < 64 && *pos < size; shift += 7) {
+        unsigned char b = buf[(*pos)++];
+        v |= static_cast<uint64_t>(b & 0x7f) << shift;
+        if ((b & 0x80) == 0) {
+            *value = v;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+static uint64_t readFixed(const unsigned char *buf, size_t bytes) {
+    uint64_t v = 0;
+    for (size_t i = 0; i < bytes; i++) {
+        v |= static_cast<uint64_t>(buf[i]) << (8 * i);
+    }
+    return v;
+}
+
+
+/*
+ * Whether a length delimited value reads as text, which is then what it
+ * is taken for, even if it would also decode as a message.
+ */
+static bool isText(const unsigned char *buf, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        if (buf[i] < 0x20 && buf[i] != '\t' && buf[i] != '\r'
+            && buf[i] != '\n') {
+            return false;
+        }
+        if (buf[i] == 0x7f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+GRPC::GRPC(Transaction *transaction) : m_transaction(transaction),
+    m_prefixSize(0),
+    m_messageSize(0),
+    m_messages(0),
+    m_stopped(false),
+    m_streaming(false),
+    m_streamFailed(false) { }
+
+
+bool GRPC::init() {
+    return true;
+}
+
+
+bool GRPC::processChunk(const char *buf, size_t size, std::string *err) {
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(buf);
+
+    while (size > 0 && m_stopped == false) {
+        if (m_prefixSize < sizeof(m_prefix)) {
+            size_t n = std::min(size, sizeof(m_prefix) - m_prefixSize);
+            memcpy(m_prefix + m_prefixSize, p, n);
+            m_prefixSize = m_prefixSize + n;
+            p = p + n;
+            size = size - n;
+            if (m_prefixSize < sizeof(m_prefix)) {
+                break;
+            }
+            if (m_prefix[0] > 1) {
+                err->assign("invalid compressed flag in the prefix of " \
+                    "message " + std::to_string(m_messages + 1));
+                return false;
+            }
+            /* the length of the message, big endian */
+            m_messageSize = static_cast<size_t>(m_prefix[1]) << 24
+                | static_cast<size_t>(m_prefix[2]) << 16
+                | static_cast<size_t>(m_prefix[3]) << 8
+                | static_cast<size_t>(m_prefix[4]);
+            m_message.clear();
+        }
+
+        size_t n = std::min(size, m_messageSize - m_message.size());
+        m_message.append(reinterpret_cast<const char *>(p), n);
+        p = p + n;
+        size = size - n;
+        if (m_message.size() < m_messageSize) {
+            break;
+        }
+
+        if (processMessage(err) == false) {
+            return false;
+        }
+        m_prefixSize = 0;
+        m_message.clear();
+    }
+
+    return true;
+}
+
+
+/**
+ * Feeds a piece of the request body as soon as it arrives, decoding
+ * every message that it completes.
+ *
+ * Errors are not reported here: once a chunk fails to decode the rest is
+ * ignored and complete() reports the error, as it would if the whole body
+ * had been processed at once.
+ *
+ */
+void GRPC::stream(const char *buf, size_t size) {
+    m_streaming = true;
+    if (m_streamFailed) {
+        return;
+    }
+
+    if (processChunk(buf, size, &m_streamError) == false) {
+        m_streamFailed = true;
+    }
+}
+
+
+/**
+ * Hands the arguments found while streaming to the transaction, in the
+ * very same way that they would have been added without streaming.
+ */
+void GRPC::commitArguments() {
+    for (const auto &a : m_arguments) {
+        if (!m_transaction->addArgument("GRPC", a.first, a.second, 0)) {
+            break;
+        }
+    }
+    m_arguments.clear();
+}
+
+
+bool GRPC::complete(std::string *err) {
+    if (m_streamFailed) {
+        err->assign(m_streamError);
+        return false;
+    }
+    if (m_stopped == false && m_prefixSize > 0) {
+        err->assign("message " + std::to_string(m_messages + 1) \
+            + " is truncated");
+        return false;
+    }
+
+    return true;
+}
+
+
+bool GRPC::processMessage(std::string *err) {
+    std::string inflated;
+    const std::string *message = &m_message;
+    size_t consumed = 0;
+    Status status;
+
+    m_messages++;
+
+    if (m_prefix[0] == 1) {
+        /* no message may inflate past what the whole body may be */
+        double limit = m_transaction->m_rules->m_requestBodyLimit.m_set ?
+            m_transaction->m_rules->m_requestBodyLimit.m_value : 0;
+        Utils::Inflate inflate;
+        std::string error;
+
+        inflate.append(
+            reinterpret_cast<const unsigned char *>(m_message.data()),
+            m_message.size(),
+            [&inflated, limit] (const unsigned char *data, size_t len) {
+                inflated.append(reinterpret_cast<const char *>(data), len);
+                return limit == 0 || inflated.size() <= limit;
+            });
+        if (limit != 0 && inflated.size() > limit) {
+            err->assign("message " + std::to_string(m_messages) \
+                + " inflates past SecRequestBodyLimit");
+            return false;
+        }
+        if (inflate.finish(&error) == false) {
+            err->assign("failed to inflate message " \
+                + std::to_string(m_messages) + ": " + error);
+            return false;
+        }
+        message = &inflated;
+    }
+
+    size_t before = m_arguments.size();
+    m_path.assign("grpc");
+    status = decode(reinterpret_cast<const unsigned char *>(message->data()),
+        message->size(), 1, 0, &consumed);
+
+    if (status == Malformed) {
+        m_arguments.resize(before);
+        err->assign("message " + std::to_string(m_messages) \
+            + " is not a valid protobuf message");
+        return false;
+    }
+    if (status == Stopped) {
+        m_stopped = true;
+    }
+
+    if (m_streaming == false) {
+        commitArguments();
+    }
+
+    return true;
+}
+
+
+/*
+ * Decodes the fields of a message, or of the group numbered group when it
+ * is not 0, stopping at the end of that group. depth is that of the
+ * message, the outermost one being at 1.
+ */
+GRPC::Status GRPC::decode(const unsigned char *buf, size_t size, int depth,
+    uint32_t group, size_t *consumed) {
+    size_t pos = 0;
+    size_t pathSize = m_path.size();
+
+    while (pos < size) {
+        uint64_t tag;
+        uint64_t value;
+        Status status = Decoded;
+
+        if (readVarint(buf, size, &pos, &tag) == false) {
+            return Malformed;
+        }
+        uint64_t field = tag >> 3;
+        if (field == 0 || field > 0x1fffffff) {
+            return Malformed;
+        }
+
+        m_path.resize(pathSize);
+        m_path.append(".");
+        m_path.append(std::to_string(field));
+
+        switch (tag & 0x07) {
+        case VarintWireType:
+            if (readVarint(buf, size, &pos, &value) == false) {
+                return Malformed;
+            }
+            status = addArgument(std::to_string(value));
+            break;
+        case Fixed64WireType:
+            if (size - pos < 8) {
+                return Malformed;
+            }
+            status = addArgument(std::to_string(readFixed(buf + pos, 8)));
+            pos = pos + 8;
+            break;
+        case Fixed32WireType:
+            if (size - pos < 4) {
+                return Malformed;
+            }
+            status = addArgument(std::to_string(readFixed(buf + pos, 4)));
+            pos = pos + 4;
+            break;
+        case LengthDelimitedWireType: {
+            if (readVarint(buf, size, &pos, &value) == false
+                || value > size - pos) {
+                return Malformed;
+            }
+            const unsigned char *v = buf + pos;
+            size_t before = m_arguments.size();
+            size_t c = 0;
+            pos = pos + value;
+
+            status = Malformed;
+            if (depth < grpc_depth_limit && value > 0
+                && isText(v, value) == false) {
+                status = decode(v, value, depth + 1, 0, &c);
+            }
+            if (status == Malformed) {
+                /* a string, or bytes, after all */
+                m_arguments.resize(before);
+                m_path.resize(pathSize);
+                m_path.append(".");
+                m_path.append(std::to_string(field));
+                status = addArgument(std::string(
+                    reinterpret_cast<const char *>(v), value));
+            }
+            break;
+        }
+        case StartGroupWireType: {
+            size_t c = 0;
+            /* unlike a message, a group can not be skipped over */
+            if (depth >= grpc_depth_limit) {
+                return Malformed;
+            }
+            status = decode(buf + pos, size - pos, depth + 1,
+                static_cast<uint32_t>(field), &c);
+            if (status == Malformed) {
+                return Malformed;
+            }
+            pos = pos + c;
+            break;
+        }
+        case EndGroupWireType:
+            if (field != group) {
+                return Malformed;
+            }
+            m_path.resize(pathSize);
+            *consumed = pos;
+            return Decoded;
+        default:
+            return Malformed;
+        }
+
+        if (status == Stopped) {
+            m_path.resize(pathSize);
+            return Stopped;
+        }
+    }
+
+    m_path.resize(pathSize);
+    if (group != 0) {
+        return Malformed;
+    }
+    *consumed = pos;
+    return Decoded;
+}
+
+
+GRPC::Status GRPC::addArgument(const std::string &value) {
+    /*
+     * Same outcome as Transaction::addArgument, which will refuse this
+     * very argument when they get committed.
+     */
+    if (overArgumentsLimit()) {
+        return Stopped;
+    }
+    m_arguments.push_back(std::make_pair(m_path, value));
+    return Decoded;
+}
+
+
+bool GRPC::overArgumentsLimit() const {
+    return m_transaction->m_rules->m_argumentsLimit.m_set
+        && m_transaction->m_variableArgs.size() + m_arguments.size()
+        >= m_transaction->m_rules->m_argumentsLimit.m_value;
+}
+
+
+}  // namespace RequestBodyProcessor
+}  // namespace modsecurity
@@ -0,0 +1,101 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#ifndef SRC_REQUEST_BODY_PROCESSOR_GRPC_H_
+#define SRC_REQUEST_BODY_PROCESSOR_GRPC_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "modsecurity/transaction.h"
+#include "modsecurity/rules_set.h"
+
+
+namespace modsecurity {
+namespace RequestBodyProcessor {
+
+
+/*
+ * Decodes a gRPC request body: a sequence of length prefixed messages,
+ * each of them in the protobuf wire format.
+ *
+ * There is no schema, so the arguments are named after the field numbers,
+ * "grpc.1.2" being the field 2 of the message held by the field 1. A
+ * length delimited field is taken as a nested message when it decodes as
+ * one, and as a string otherwise. The fields of every message of a
+ * streamed body share these names, as repeated fields do.
+ *
+ * The body may be fed as it arrives; each message is decoded as soon as
+ * its last byte is in.
+ */
+class GRPC {
+ public:
+    explicit GRPC(Transaction *transaction);
+
+    bool init();
+    bool processChunk(const char *buf, size_t size, std::string *err);
+    bool complete(std::string *err);
+
+    void stream(const char *buf, size_t size);
+    bool isStreaming() const { return m_streaming; }
+    void commitArguments();
+
+ private:
+    enum Status {
+        Decoded,
+        Malformed,
+        /* SecArgumentsLimit reached, nothing else is worth decoding */
+        Stopped,
+    };
+
+    bool processMessage(std::string *err);
+    Status decode(const unsigned char *buf, size_t size, int depth,
+        uint32_t group, size_t *consumed);
+    Status addArgument(const std::string &value);
+    bool overArgumentsLimit() const;
+
+    Transaction *m_transaction;
+
+    /* the frame being received: its 5 bytes prefix, then the message */
+    unsigned char m_prefix[5];
+    size_t m_prefixSize;
+    size_t m_messageSize;
+    std::string m_message;
+    size_t m_messages;
+    bool m_stopped;
+
+    /* the field numbers leading to the field being decoded */
+    std::string m_path;
+
+    /*
+     * The arguments of the message being decoded. They are only handed
+     * to the transaction once their message is decoded and, while streaming,
+     * once the whole body is in (see commitArguments), as the body may
+     * still turn out to be over SecRequestBodyNoFilesLimit.
+     */
+    bool m_streaming;
+    bool m_streamFailed;
+    std::string m_streamError;
+    std::vector<std::pair<std::string, std::string>> m_arguments;
+};
+
+
+}  // namespace RequestBodyProcessor
+}  // namespace modsecurity
+
+#endif  // SRC_REQUEST_BODY_PROCESSOR_GRPC_H_
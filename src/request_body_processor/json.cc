@@ -22,6 +22,8 @@
 #include <iostream>
 #include <string>
 
+#include "src/utils/allocator.h"
+
 
 namespace modsecurity {
 namespace RequestBodyProcessor {
@@ -34,7 +36,9 @@ JSON::JSON(Transaction *transaction) : m_transaction(transaction),
     m_current_key(""),
     m_max_depth(json_depth_limit_default),
     m_current_depth(0),
-    m_depth_limit_exceeded(false) {
+    m_depth_limit_exceeded(false),
+    m_streaming(false),
+    m_streamFailed(false) {
     /**
      * yajl callback functions
      * For more information on the function signatures and order, check
@@ -67,18 +71,13 @@ JSON::JSON(Transaction *transaction) : m_transaction(transaction),
      *
      * TODO: make UTF8 validation optional, as it depends on Content-Encoding
      */
-    m_handle = yajl_alloc(&callbacks, NULL, this);
+    m_handle = yajl_alloc(&callbacks, Utils::Allocator::yajl(), this);
 
     yajl_config(m_handle, yajl_allow_partial_values, 0);
 }
 
 
 JSON::~JSON() {
-    while (m_containers.size() > 0) {
-        JSONContainer *a = m_containers.back();
-        m_containers.pop_back();
-        delete a;
-    }
     yajl_free(m_handle);
 }
 
@@ -108,6 +107,43 @@ bool JSON::processChunk(const char *buf, unsigned int size, std::string *err) {
 }
 
 
+/**
+ * Feeds a piece of the request body as soon as it arrives, so parsing
+ * overlaps with the reception of the remaining body.
+ *
+ * Errors are not reported here: once a chunk fails to parse the rest is
+ * ignored and complete() reports the error, as it would if the whole body
+ * had been processed at once.
+ *
+ */
+void JSON::stream(const char *buf, unsigned int size) {
+    std::string err;
+
+    m_streaming = true;
+    if (m_streamFailed) {
+        return;
+    }
+
+    if (processChunk(buf, size, &err) == false) {
+        m_streamFailed = true;
+    }
+}
+
+
+/**
+ * Hands the arguments found while streaming to the transaction, in the
+ * very same way that they would have been added without streaming.
+ */
+void JSON::commitArguments() {
+    for (const auto &a : m_pendingArguments) {
+        if (!m_transaction->addArgument("JSON", a.first, a.second, 0)) {
+            break;
+        }
+    }
+    m_pendingArguments.clear();
+}
+
+
 bool JSON::complete(std::string *err) {
     /* Wrap up the parsing process */
     m_status = yajl_complete_parse(m_handle);
@@ -126,35 +162,73 @@ bool JSON::complete(std::string *err) {
 }
 
 
-int JSON::addArgument(const std::string& value) {
-    std::string data("");
-    std::string path;
-
-    for (size_t i =  0; i < m_containers.size(); i++) {
-        JSONContainerArray *a = dynamic_cast<JSONContainerArray *>(
-            m_containers[i]);
-        path = path + m_containers[i]->m_name;
-        if (a != NULL) {
-            path = path + ".array_" + std::to_string(a->m_elementCounter);
-        } else {
-            path = path + ".";
-        }
+/*
+ * Opens a map or an array, named after the current key, adding its part
+ * to the path that the arguments below it are named after.
+ */
+void JSON::pushContainer(bool array) {
+    JSONContainer c;
+    std::string name(getCurrentKey());
+
+    c.m_array = array;
+    c.m_pathStart = m_path.size();
+    c.m_elementCounter = 0;
+    m_path.append(name);
+    m_path.append(array ? ".array_" : ".");
+    c.m_counterStart = m_path.size();
+    if (array) {
+        m_path.append("0");
     }
+    m_containers.push_back(c);
+}
 
-    if (m_containers.size() > 0) {
-        JSONContainerArray *a = dynamic_cast<JSONContainerArray *>(
-            m_containers.back());
-        if (a) {
-            a->m_elementCounter++;
-        } else {
-            data = getCurrentKey();
-        }
-    } else {
-        data = getCurrentKey();
+
+/*
+ * Closes the innermost container, which was an element of the one that
+ * is now innermost.
+ */
+void JSON::popContainer() {
+    m_path.resize(m_containers.back().m_pathStart);
+    m_containers.pop_back();
+    nextElement();
+}
+
+
+/* In an array, moves on to the next element. */
+void JSON::nextElement() {
+    if (isPreviousArray() == false) {
+        return;
     }
+    JSONContainer &a = m_containers.back();
+    a.m_elementCounter++;
+    m_path.resize(a.m_counterStart);
+    m_path.append(std::to_string(a.m_elementCounter));
+}
 
 
-    if (!m_transaction->addArgument("JSON", path + data, value, 0)) {
+int JSON::addArgument(const std::string& value) {
+    m_argument.assign(m_path);
+    if (isPreviousArray() == false) {
+        m_argument.append(getCurrentKey());
+    }
+    nextElement();
+
+    if (m_streaming) {
+        m_pendingArguments.push_back(std::make_pair(m_argument, value));
+        /*
+         * Same outcome as Transaction::addArgument, which will refuse this
+         * very argument when they get committed.
+         */
+        if (m_transaction->m_rules->m_argumentsLimit.m_set
+            && m_transaction->m_variableArgs.size()
+            + m_pendingArguments.size()
+            > m_transaction->m_rules->m_argumentsLimit.m_value) {
+            return 0;
+        }
+        return 1;
+    }
+
+    if (!m_transaction->addArgument("JSON", m_argument, value, 0)) {
         // cancel parsing by returning false
         return 0;
     }
@@ -169,17 +243,13 @@ int JSON::addArgument(const std::string& value) {
  */
 int JSON::yajl_map_key(void *ctx, const unsigned char *key, size_t length) {
     JSON *tthis = reinterpret_cast<JSON *>(ctx);
-    std::string safe_key;
 
     /**
      * yajl does not provide us with null-terminated strings, but
      * rather expects us to copy the data from the key up to the
-     * length informed; we create a standalone null-termined copy
-     * in safe_key
+     * length informed
      */
-    safe_key.assign((const char *)key, length);
-
-    tthis->m_current_key = safe_key;
+    tthis->m_current_key.assign((const char *)key, length);
 
     return 1;
 }
@@ -235,9 +305,7 @@ int JSON::yajl_number(void *ctx, const char *value, size_t length) {
  */
 int JSON::yajl_start_array(void *ctx) {
     JSON *tthis = reinterpret_cast<JSON *>(ctx);
-    std::string name = tthis->getCurrentKey();
-    tthis->m_containers.push_back(
-        reinterpret_cast<JSONContainer *>(new JSONContainerArray(name)));
+    tthis->pushContainer(true);
     tthis->m_current_depth++;
     if (tthis->m_current_depth > tthis->m_max_depth) {
         tthis->m_depth_limit_exceeded = true;
@@ -254,16 +322,7 @@ int JSON::yajl_end_array(void *ctx) {
         return 1;
     }
 
-    JSONContainer *a = tthis->m_containers.back();
-    tthis->m_containers.pop_back();
-    delete a;
-    if (tthis->m_containers.size() > 0) {
-        JSONContainerArray *ja = dynamic_cast<JSONContainerArray *>(
-            tthis->m_containers.back());
-        if (ja) {
-            ja->m_elementCounter++;
-        }
-    }
+    tthis->popContainer();
     tthis->m_current_depth--;
 
     return 1;
@@ -272,9 +331,7 @@ int JSON::yajl_end_array(void *ctx) {
 
 int JSON::yajl_start_map(void *ctx) {
     JSON *tthis = reinterpret_cast<JSON *>(ctx);
-    std::string name(tthis->getCurrentKey());
-    tthis->m_containers.push_back(
-        reinterpret_cast<JSONContainer *>(new JSONContainerMap(name)));
+    tthis->pushContainer(false);
     tthis->m_current_depth++;
     if (tthis->m_current_depth > tthis->m_max_depth) {
         tthis->m_depth_limit_exceeded = true;
@@ -295,18 +352,7 @@ int JSON::yajl_end_map(void *ctx) {
         return 1;
     }
 
-    JSONContainer *a = tthis->m_containers.back();
-    tthis->m_containers.pop_back();
-    delete a;
-
-    if (tthis->m_containers.size() > 0) {
-        JSONContainerArray *ja = dynamic_cast<JSONContainerArray *>(
-            tthis->m_containers.back());
-        if (ja) {
-            ja->m_elementCounter++;
-        }
-    }
-
+    tthis->popContainer();
     tthis->m_current_depth--;
     return 1;
 }
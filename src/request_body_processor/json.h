@@ -23,7 +23,8 @@
 
 #include <string>
 #include <iostream>
-#include <deque>
+#include <utility>
+#include <vector>
 
 #include "modsecurity/transaction.h"
 #include "modsecurity/rules_set.h"
@@ -33,28 +34,20 @@ namespace modsecurity {
 namespace RequestBodyProcessor {
 
 
-class JSONContainer {
- public:
-    explicit JSONContainer(const std::string &name) : m_name(name) { }
-    virtual ~JSONContainer() { }
-    std::string m_name;
-};
-
-
-class JSONContainerArray : public JSONContainer {
- public:
-    explicit JSONContainerArray(const std::string &name) : JSONContainer(name),
-        m_elementCounter(0) { }
+/*
+ * A map or an array being parsed. Its part of the argument names is
+ * kept in JSON::m_path, from m_pathStart on: its name, then a dot or,
+ * for arrays, ".array_" and the index of the current element, which
+ * starts at m_counterStart.
+ */
+struct JSONContainer {
+    bool m_array;
+    size_t m_pathStart;
+    size_t m_counterStart;
     size_t m_elementCounter;
 };
 
 
-class JSONContainerMap : public JSONContainer {
- public:
-     explicit JSONContainerMap(const std::string &name) : JSONContainer(name) { }
-};
-
-
 class JSON {
  public:
     explicit JSON(Transaction *transaction);
@@ -64,6 +57,10 @@ class JSON {
     bool processChunk(const char *buf, unsigned int size, std::string *err);
     bool complete(std::string *err);
 
+    void stream(const char *buf, unsigned int size);
+    bool isStreaming() const { return m_streaming; }
+    void commitArguments();
+
     int addArgument(const std::string& value);
 
     static int yajl_number(void *ctx, const char *value, size_t length);
@@ -79,13 +76,7 @@ class JSON {
     static int yajl_end_array(void *ctx);
 
     bool isPreviousArray() const {
-        JSONContainerArray *prev = NULL;
-        if (m_containers.size() < 1) {
-            return false;
-        }
-        prev = dynamic_cast<JSONContainerArray *>(
-            m_containers[m_containers.size() - 1]);
-        return prev != NULL;
+        return m_containers.empty() == false && m_containers.back().m_array;
     }
 
     std::string getCurrentKey(bool emptyIsNull = false) {
@@ -108,7 +99,14 @@ class JSON {
     }
 
  private:
-    std::deque<JSONContainer *> m_containers;
+    void pushContainer(bool array);
+    void popContainer();
+    void nextElement();
+
+    std::vector<JSONContainer> m_containers;
+    /* the names of the containers, see JSONContainer */
+    std::string m_path;
+    std::string m_argument;
     Transaction *m_transaction;
     yajl_handle m_handle;
     yajl_status m_status;
@@ -116,6 +114,15 @@ class JSON {
     double m_max_depth;
     int64_t m_current_depth;
     bool m_depth_limit_exceeded;
+
+    /*
+     * While streaming, the arguments are only handed to the transaction
+     * once the whole body is in (see commitArguments), as the body may
+     * still turn out to be over SecRequestBodyNoFilesLimit.
+     */
+    bool m_streaming;
+    bool m_streamFailed;
+    std::vector<std::pair<std::string, std::string>> m_pendingArguments;
 };
 
 
@@ -0,0 +1,303 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#ifdef WITH_SIMDJSON
+
+#include "src/request_body_processor/json_simd.h"
+
+#include <simdjson.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
+
+
+namespace modsecurity {
+namespace RequestBodyProcessor {
+
+
+namespace {
+
+const double kDefaultMaxDepth = 10000.0;
+
+/*
+ * simdjson has a nesting limit of its own, which is set just above
+ * ours so that ours is the one that trips. Past this one the document
+ * is refused with simdjson's DEPTH_ERROR instead.
+ */
+const double kParserMaxDepth = 100000.0;
+
+
+/*
+ * On-Demand does not look at a number until it is asked to convert it,
+ * and the arguments want the text as it is: check it against the JSON
+ * grammar, as yajl would have.
+ */
+bool isNumber(const char *s, size_t n) {
+    size_t i = 0;
+
+    if (i < n && s[i] == '-') {
+        i++;
+    }
+    if (i == n) {
+        return false;
+    }
+    if (s[i] == '0') {
+        i++;
+    } else if (s[i] >= '1' && s[i] <= '9') {
+        while (i < n && s[i] >= '0' && s[i] <= '9') {
+            i++;
+        }
+    } else {
+        return false;
+    }
+
+    if (i < n && s[i] == '.') {
+        size_t start = ++i;
+        while (i < n && s[i] >= '0' && s[i] <= '9') {
+            i++;
+        }
+        if (i == start) {
+            return false;
+        }
+    }
+
+    if (i < n && (s[i] == 'e' || s[i] == 'E')) {
+        i++;
+        if (i < n && (s[i] == '+' || s[i] == '-')) {
+            i++;
+        }
+        size_t start = i;
+        while (i < n && s[i] >= '0' && s[i] <= '9') {
+            i++;
+        }
+        if (i == start) {
+            return false;
+        }
+    }
+
+    return i == n;
+}
+
+}  // namespace
+
+
+JSONSimd::JSONSimd(Transaction *transaction)
+    : m_transaction(transaction),
+    m_max_depth(kDefaultMaxDepth) { }
+
+
+/**
+ * Parses the whole body. The parser is kept by the thread from one body
+ * to the next, with the room for the largest body it has seen.
+ */
+bool JSONSimd::process(const BodyBuffer &body, std::string *err) {
+    static thread_local simdjson::ondemand::parser parser;
+    simdjson::error_code e;
+
+    /* simdjson reads past the end of the document, it wants the padding */
+    simdjson::padded_string json(body.size());
+    size_t offset = 0;
+    for (size_t i = 0; i < body.chunkCount(); i++) {
+        size_t len;
+        const char *c = body.chunk(i, &len);
+        memcpy(json.data() + offset, c, len);
+        offset = offset + len;
+    }
+
+    size_t depth = static_cast<size_t>(std::min(m_max_depth,
+        kParserMaxDepth)) + 1;
+    if (parser.capacity() < json.size() || parser.max_depth() != depth) {
+        e = parser.allocate(json.size(), depth);
+        if (e) {
+            err->assign(simdjson::error_message(e));
+            return false;
+        }
+    }
+
+    simdjson::ondemand::document doc;
+    e = parser.iterate(json).get(doc);
+    if (e) {
+        err->assign(simdjson::error_message(e));
+        return false;
+    }
+
+    m_path.assign("json");
+    if (walk(&doc, 0, err) == false) {
+        return false;
+    }
+    if (doc.at_end() == false) {
+        err->assign("Trailing content after the JSON document");
+        return false;
+    }
+
+    return true;
+}
+
+
+/*
+ * Adds the value, or what is below it, as arguments. m_path holds the
+ * name of the value: "json", then a dot and the key for the members
+ * of an object (empty-key when empty) and .array_ and the index for
+ * the elements of an array.
+ */
+template <typename T>
+bool JSONSimd::walk(T *value, int64_t depth, std::string *err) {
+    simdjson::ondemand::json_type type;
+    simdjson::error_code e = value->type().get(type);
+    size_t base = m_path.size();
+
+    if (e == simdjson::SUCCESS) {
+        switch (type) {
+        case simdjson::ondemand::json_type::object: {
+            if (depth + 1 > m_max_depth) {
+                err->assign("Parsing depth limit exceeded");
+                return false;
+            }
+            simdjson::ondemand::object object;
+            if ((e = value->get_object().get(object))) {
+                break;
+            }
+            for (auto result : object) {
+                simdjson::ondemand::field field;
+                if ((e = std::move(result).get(field))) {
+                    break;
+                }
+                auto key = field.unescaped_key();
+                if ((e = key.error())) {
+                    break;
+                }
+                m_path.resize(base);
+                m_path.push_back('.');
+                if (key.value_unsafe().empty()) {
+                    m_path.append("empty-key");
+                } else {
+                    m_path.append(key.value_unsafe().data(),
+                        key.value_unsafe().size());
+                }
+                if (walk(&field.value(), depth + 1, err) == false) {
+                    m_path.resize(base);
+                    return false;
+                }
+            }
+            m_path.resize(base);
+            break;
+        }
+        case simdjson::ondemand::json_type::array: {
+            if (depth + 1 > m_max_depth) {
+                err->assign("Parsing depth limit exceeded");
+                return false;
+            }
+            simdjson::ondemand::array array;
+            if ((e = value->get_array().get(array))) {
+                break;
+            }
+            m_path.append(".array_");
+            size_t counter = m_path.size();
+            size_t i = 0;
+            for (auto result : array) {
+                simdjson::ondemand::value child;
+                if ((e = std::move(result).get(child))) {
+                    break;
+                }
+                m_path.resize(counter);
+                m_path.append(std::to_string(i++));
+                if (walk(&child, depth + 1, err) == false) {
+                    m_path.resize(base);
+                    return false;
+                }
+            }
+            m_path.resize(base);
+            break;
+        }
+        case simdjson::ondemand::json_type::string: {
+            auto s = value->get_string();
+            if ((e = s.error())) {
+                break;
+            }
+            return addArgument(s.value_unsafe().data(),
+                s.value_unsafe().size(), err);
+        }
+        case simdjson::ondemand::json_type::number: {
+            /* a document hands it as a simdjson_result, a value does not */
+            simdjson::simdjson_result<std::string_view> raw(
+                value->raw_json_token());
+            std::string_view token;
+            if ((e = std::move(raw).get(token))) {
+                break;
+            }
+            size_t length = token.size();
+            while (length > 0 && (token[length - 1] == ' '
+                || token[length - 1] == '\t' || token[length - 1] == '\n'
+                || token[length - 1] == '\r')) {
+                length--;
+            }
+            if (isNumber(token.data(), length) == false) {
+                e = simdjson::NUMBER_ERROR;
+                break;
+            }
+            return addArgument(token.data(), length, err);
+        }
+        case simdjson::ondemand::json_type::boolean: {
+            bool b;
+            if ((e = value->get_bool().get(b))) {
+                break;
+            }
+            return b ? addArgument("true", 4, err)
+                : addArgument("false", 5, err);
+        }
+        case simdjson::ondemand::json_type::null: {
+            bool null;
+            if ((e = value->is_null().get(null))) {
+                break;
+            }
+            if (null == false) {
+                e = simdjson::N_ATOM_ERROR;
+                break;
+            }
+            return addArgument("", 0, err);
+        }
+        default:
+            e = simdjson::TAPE_ERROR;
+            break;
+        }
+    }
+
+    if (e) {
+        err->assign(simdjson::error_message(e));
+        return false;
+    }
+
+    return true;
+}
+
+
+bool JSONSimd::addArgument(const char *value, size_t length,
+    std::string *err) {
+    m_value.assign(value, length);
+    if (m_transaction->addArgument("JSON", m_path, m_value, 0) == false) {
+        err->assign("Too many arguments");
+        return false;
+    }
+    return true;
+}
+
+
+}  // namespace RequestBodyProcessor
+}  // namespace modsecurity
+
+
+#endif  // WITH_SIMDJSON
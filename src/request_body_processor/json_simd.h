@@ -0,0 +1,68 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#ifndef SRC_REQUEST_BODY_PROCESSOR_JSON_SIMD_H_
+#define SRC_REQUEST_BODY_PROCESSOR_JSON_SIMD_H_
+
+
+#ifdef WITH_SIMDJSON
+
+#include <cstdint>
+#include <string>
+
+#include "modsecurity/body_buffer.h"
+#include "modsecurity/transaction.h"
+
+
+namespace modsecurity {
+namespace RequestBodyProcessor {
+
+
+/**
+ * The JSON body processor on top of the simdjson On-Demand API, used in
+ * place of JSON (yajl) unless SecRequestBodyJsonSimd is Off. It walks
+ * the whole document once the body is in and adds the very same ARGS,
+ * within the same depth and arguments limits. Error messages are
+ * simdjson's, not yajl's.
+ */
+class JSONSimd {
+ public:
+    explicit JSONSimd(Transaction *transaction);
+
+    bool process(const BodyBuffer &body, std::string *err);
+
+    void setMaxDepth(double max_depth) {
+        m_max_depth = max_depth;
+    }
+
+ private:
+    template <typename T>
+    bool walk(T *value, int64_t depth, std::string *err);
+    bool addArgument(const char *value, size_t length, std::string *err);
+
+    Transaction *m_transaction;
+    double m_max_depth;
+    /* the name of the value being walked */
+    std::string m_path;
+    std::string m_value;
+};
+
+
+}  // namespace RequestBodyProcessor
+}  // namespace modsecurity
+
+#endif  // WITH_SIMDJSON
+
+#endif  // SRC_REQUEST_BODY_PROCESSOR_JSON_SIMD_H_
@@ -19,9 +19,12 @@
 #include <stdio.h>
 #include <string.h>
 #include <sys/types.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <algorithm>
 #include <list>
 #include <iostream>
 #include <string>
@@ -29,6 +32,8 @@
 
 #include "modsecurity/rules_set.h"
 #include "modsecurity/collection/collections.h"
+#include "src/utils/async_runner.h"
+#include "src/utils/log_strings.h"
 #include "src/utils/string.h"
 
 
@@ -39,12 +44,17 @@ static const char* mime_charset_special = "!#$%&+-^_`{}~";
 static const char* attr_char_special = "!#$&+-.^_`~";
 
 MultipartPartTmpFile::~MultipartPartTmpFile() {
-    if (!m_tmp_file_name.empty() && m_delete) {
-        /* make sure it is closed first */
-        if (m_tmp_file_fd > 0) {
-            Close();
-        }
+    if (m_anonymous_fd >= 0 || m_tmp_file_fd > 0) {
+        Close();
+    }
+    if (m_anonymous_fd >= 0) {
+        /* nothing to unlink, it goes away with its last descriptor */
+        close(m_anonymous_fd);
+        m_anonymous_fd = -1;
+        return;
+    }
 
+    if (!m_tmp_file_name.empty() && m_delete) {
         const int unlink_rc = unlink(m_tmp_file_name.c_str());
         if (unlink_rc < 0) {
             ms_dbg_a(m_transaction, 1, "Multipart: Failed to delete file (part) \"" \
@@ -59,25 +69,28 @@ MultipartPartTmpFile::~MultipartPartTmpFile() {
     }
 }
 
-void MultipartPartTmpFile::Open() {
-    struct tm timeinfo;
-    char tstr[300];
-    time_t tt = time(NULL);
-
-    localtime_r(&tt, &timeinfo);
-
-    memset(tstr, '\0', 300);
-    strftime(tstr, 299, "/%Y%m%d-%H%M%S", &timeinfo);
-
+void MultipartPartTmpFile::Open(size_t expected) {
+    const std::string &tstr = Utils::LogStrings::second(time(NULL));
     std::string path = m_transaction->m_rules->m_uploadDirectory.m_value;
-    path = path + tstr + "-" + *m_transaction->m_id.get();
-    path += "-file-XXXXXX";
 
-    char* tmp = strdup(path.c_str());
-    m_tmp_file_fd = mkstemp(tmp);
-    m_tmp_file_name.assign(tmp);
-    free(tmp);
-    ms_dbg_a(m_transaction, 4, "MultipartPartTmpFile: Create filename= " + m_tmp_file_name);
+    /* only when the file is not going to be kept around */
+    if (m_transaction->m_rules->m_uploadAnonymousFiles
+            == RulesSetProperties::TrueConfigBoolean
+        && m_transaction->m_rules->m_uploadKeepFiles
+            != RulesSetProperties::TrueConfigBoolean
+        && openAnonymous(path)) {
+        ms_dbg_a(m_transaction, 4, "MultipartPartTmpFile: Create " \
+            "anonymous file " + m_tmp_file_name);
+    } else {
+        path = path + tstr + "-" + *m_transaction->m_id.get();
+        path += "-file-XXXXXX";
+
+        char* tmp = strdup(path.c_str());
+        m_tmp_file_fd = mkstemp(tmp);
+        m_tmp_file_name.assign(tmp);
+        free(tmp);
+        ms_dbg_a(m_transaction, 4, "MultipartPartTmpFile: Create filename= " + m_tmp_file_name);
+    }
 
     int mode = m_transaction->m_rules->m_uploadFileMode.m_value;
     if ((m_tmp_file_fd != -1) && (mode != 0)) {
@@ -85,11 +98,147 @@ void MultipartPartTmpFile::Open() {
             m_tmp_file_fd = -1;
         }
     }
+
+#ifdef FALLOC_FL_KEEP_SIZE
+    /*
+     * Saves the filesystem from growing a big file a piece at a time.
+     * Whatever is not used is given back by Close().
+     */
+    if (m_tmp_file_fd != -1 && expected >= MULTIPART_PREALLOCATE_MIN) {
+        m_preallocated = fallocate(m_tmp_file_fd, FALLOC_FL_KEEP_SIZE, 0,
+            expected) == 0;
+    }
+#endif
 }
 
-void MultipartPartTmpFile::Close() {
-    close(m_tmp_file_fd);
+bool MultipartPartTmpFile::openAnonymous(const std::string &dir) {
+#ifdef O_TMPFILE
+    int fd = open(dir.c_str(), O_TMPFILE | O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        /* not supported by this filesystem, a regular one then */
+        return false;
+    }
+    m_tmp_file_fd = fd;
+    m_anonymous_fd = fd;
+    m_tmp_file_name = "/proc/self/fd/" + std::to_string(fd);
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool MultipartPartTmpFile::write(const char *reserve, size_t reserve_len,
+    const char *data, size_t len) {
+    if (m_pending.size() + reserve_len + len <= MULTIPART_WRITE_BUF_SIZE) {
+        if (m_pending.capacity() == 0) {
+            m_pending.reserve(MULTIPART_WRITE_BUF_SIZE);
+        }
+        m_pending.append(reserve, reserve_len);
+        m_pending.append(data, len);
+        return true;
+    }
+
+    return flush(reserve, reserve_len, data, len);
+}
+
+bool MultipartPartTmpFile::flush(const char *reserve, size_t reserve_len,
+    const char *data, size_t len) {
+    struct iovec iov[3];
+    int n = 0;
+
+    if (m_pending.empty() == false) {
+        iov[n].iov_base = const_cast<char *>(m_pending.data());
+        iov[n++].iov_len = m_pending.size();
+    }
+    if (reserve_len > 0) {
+        iov[n].iov_base = const_cast<char *>(reserve);
+        iov[n++].iov_len = reserve_len;
+    }
+    if (len > 0) {
+        iov[n].iov_base = const_cast<char *>(data);
+        iov[n++].iov_len = len;
+    }
+
+    struct iovec *v = iov;
+    while (n > 0) {
+        ssize_t written = writev(m_tmp_file_fd, v, n);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            m_pending.clear();
+            return false;
+        }
+        m_size += written;
+        /* a short write, skip what made it */
+        while (n > 0 && static_cast<size_t>(written) >= v->iov_len) {
+            written -= v->iov_len;
+            v++;
+            n--;
+        }
+        if (n > 0) {
+            v->iov_base = static_cast<char *>(v->iov_base) + written;
+            v->iov_len -= written;
+        }
+    }
+
+    m_pending.clear();
+    return true;
+}
+
+bool MultipartPartTmpFile::read(size_t limit, std::string *content) const {
+    size_t len = m_size;
+    int fd = m_anonymous_fd;
+
+    if (limit != 0 && len > limit) {
+        len = limit;
+    }
+    content->clear();
+    if (len == 0) {
+        return true;
+    }
+
+    if (fd < 0) {
+        fd = open(m_tmp_file_name.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+    }
+    void *map = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (fd != m_anonymous_fd) {
+        close(fd);
+    }
+    if (map == MAP_FAILED) {
+        return false;
+    }
+
+    madvise(map, len, MADV_SEQUENTIAL);
+    content->assign(static_cast<const char *>(map), len);
+    munmap(map, len);
+    return true;
+}
+
+bool MultipartPartTmpFile::Close() {
+    bool ret = true;
+
+    if (m_tmp_file_fd > 0) {
+        ret = flush();
+        if (m_preallocated) {
+            /* gives back the blocks reserved past the end */
+            if (ftruncate(m_tmp_file_fd, m_size) != 0) {
+                ret = false;
+            }
+            m_preallocated = false;
+        }
+        if (m_tmp_file_fd != m_anonymous_fd) {
+            close(m_tmp_file_fd);
+        }
+    }
     m_tmp_file_fd = -1;
+    /* the write buffer is not needed past the last write */
+    std::string().swap(m_pending);
+
+    return ret;
 }
 
 
@@ -102,6 +251,7 @@ Multipart::Multipart(const std::string &header, Transaction *transaction)
     m_bufptr(NULL),
     m_bufleft(0),
     m_buf_offset(0),
+    m_received(0),
     m_crlf_state(0),
     m_crlf_state_buf_end(0),
     m_mpp(NULL),
@@ -125,10 +275,17 @@ Multipart::Multipart(const std::string &header, Transaction *transaction)
     m_flag_invalid_header_folding(0),
     m_flag_file_limit_exceeded(0),
     m_header(header),
-    m_transaction(transaction) { }
+    m_transaction(transaction),
+    m_offloaded(0) {
+    pthread_mutex_init(&m_offloadedLock, NULL);
+    pthread_cond_init(&m_offloadedDone, NULL);
+}
 
 
 Multipart::~Multipart() {
+    /* the runner may still have parts of an unfinished body */
+    join();
+
     ms_dbg_a(m_transaction, 4,
         "Multipart: Cleanup started (keep files set to " \
         + RulesSetProperties::configBooleanString(
@@ -159,6 +316,9 @@ Multipart::~Multipart() {
         delete m_mpp;
         m_mpp = NULL;
     }
+
+    pthread_cond_destroy(&m_offloadedDone);
+    pthread_mutex_destroy(&m_offloadedLock);
 }
 
 
@@ -562,35 +722,72 @@ int Multipart::process_part_data(std::string *error, size_t offset) {
          * to keep them or if we need to have them approved later
          */
         if (extract) {
-            /* first create a temporary file if we don't have it already */
-            if (!m_mpp->m_tmp_file || !m_mpp->m_tmp_file->isValid()) {
-                m_mpp->m_tmp_file = std::make_shared<RequestBodyProcessor::MultipartPartTmpFile>(m_transaction);
-                m_transaction->m_multipartPartTmpFiles.push_back(m_mpp->m_tmp_file);
-                m_mpp->m_tmp_file->Open();
-
-                /* do we have an opened file? */
-                if (!m_mpp->m_tmp_file || m_mpp->m_tmp_file->getFd() < 0) {
-                    ms_dbg_a(m_transaction, 1,
-                        "Multipart: Failed to create file: " \
-                        + m_mpp->m_tmp_file->getFilename());
-                    error->assign("Multipart: Failed to create file: " \
-                        + m_mpp->m_tmp_file->getFilename());
-                    return -1;
+            size_t incoming = m_reserve[0] + (MULTIPART_BUF_SIZE - m_bufleft);
+
+            /* small files do not need to go through the disk */
+            if (!m_mpp->m_tmp_file
+                && m_transaction->m_rules->m_uploadInMemoryLimit.m_set
+                && m_transaction->m_rules->m_uploadKeepFiles
+                    != RulesSetProperties::TrueConfigBoolean
+                && m_mpp->m_memory.size() + incoming
+                    <= static_cast<size_t>(
+                        m_transaction->m_rules->m_uploadInMemoryLimit.m_value)) {
+                if (m_mpp->m_in_memory == false) {
+                    m_mpp->m_in_memory = true;
+                    m_nfiles++;
+                    ms_dbg_a(m_transaction, 4,
+                        "Multipart: Keeping file " + std::to_string(m_nfiles) \
+                        + " in memory");
                 }
-                /* keep track of the files count */
+                m_mpp->m_memory.append(&m_reserve[1], m_reserve[0]);
+                m_mpp->m_memory.append(m_buf, MULTIPART_BUF_SIZE - m_bufleft);
+            } else {
+                /* first create a temporary file if we don't have it already */
+                if (!m_mpp->m_tmp_file || !m_mpp->m_tmp_file->isValid()) {
+                    m_mpp->m_tmp_file = std::make_shared<RequestBodyProcessor::MultipartPartTmpFile>(m_transaction);
+                    m_transaction->m_multipartPartTmpFiles.push_back(m_mpp->m_tmp_file);
+                    /* the part can not be bigger than what is left */
+                    m_mpp->m_tmp_file->Open(m_received > m_buf_offset
+                        ? m_received - m_buf_offset : 0);
+
+                    /* do we have an opened file? */
+                    if (!m_mpp->m_tmp_file || m_mpp->m_tmp_file->getFd() < 0) {
+                        ms_dbg_a(m_transaction, 1,
+                            "Multipart: Failed to create file: " \
+                            + m_mpp->m_tmp_file->getFilename());
+                        error->assign("Multipart: Failed to create file: " \
+                            + m_mpp->m_tmp_file->getFilename());
+                        return -1;
+                    }
+                    /* keep track of the files count */
+                    if (m_mpp->m_in_memory == false) {
+                        m_nfiles++;
+                    }
 
-                m_nfiles++;
+                    ms_dbg_a(m_transaction, 4,
+                        "Multipart: Created temporary file " \
+                        + std::to_string(m_nfiles) + " (mode o" + std::to_string(m_transaction->m_rules->m_uploadFileMode.m_value) + "): " \
+                        + m_mpp->m_tmp_file->getFilename());
 
-                ms_dbg_a(m_transaction, 4,
-                    "Multipart: Created temporary file " \
-                    + std::to_string(m_nfiles) + " (mode o" + std::to_string(m_transaction->m_rules->m_uploadFileMode.m_value) + "): " \
-                    + m_mpp->m_tmp_file->getFilename());
-            }
+                    /* it outgrew SecUploadInMemoryLimit */
+                    if (m_mpp->m_in_memory
+                        && m_mpp->m_tmp_file->write(NULL, 0,
+                            m_mpp->m_memory.data(),
+                            m_mpp->m_memory.size()) == false) {
+                        ms_dbg_a(m_transaction, 1,
+                            "Multipart: writing to \"" \
+                            + m_mpp->m_tmp_file->getFilename() + "\" failed");
+                        error->assign("Multipart: writing to \"" \
+                            + m_mpp->m_tmp_file->getFilename() + "\" failed");
+                        return -1;
+                    }
+                    m_mpp->m_in_memory = false;
+                    std::string().swap(m_mpp->m_memory);
+                }
 
-            /* write the reserve first */
-            if (m_reserve[0] != 0) {
-                if (write(m_mpp->m_tmp_file->getFd(), &m_reserve[1], m_reserve[0])
-                    != m_reserve[0]) {
+                /* the reserve first, then the data */
+                if (m_mpp->m_tmp_file->write(&m_reserve[1], m_reserve[0], m_buf,
+                    MULTIPART_BUF_SIZE - m_bufleft) == false) {
                     ms_dbg_a(m_transaction, 1,
                         "Multipart: writing to \"" \
                         + m_mpp->m_tmp_file->getFilename() + "\" failed");
@@ -598,7 +795,9 @@ int Multipart::process_part_data(std::string *error, size_t offset) {
                         + m_mpp->m_tmp_file->getFilename() + "\" failed");
                     return -1;
                 }
+            }
 
+            if (m_reserve[0] != 0) {
                 m_mpp->m_tmp_file_size.first += m_reserve[0];
                 if (m_mpp->m_tmp_file_size.second == 0) {
                     m_mpp->m_tmp_file_size.second = offset \
@@ -607,21 +806,6 @@ int Multipart::process_part_data(std::string *error, size_t offset) {
                 m_mpp->m_length += m_reserve[0];
             }
 
-            /* write data to the file */
-
-            if (write(m_mpp->m_tmp_file->getFd(), m_buf,
-                MULTIPART_BUF_SIZE - m_bufleft)
-                != (MULTIPART_BUF_SIZE - m_bufleft)) {
-                ms_dbg_a(m_transaction, 1,
-                    "Multipart: writing to \"" \
-                    + m_mpp->m_tmp_file->getFilename() + "\" failed");
-                error->assign("Multipart: writing to \"" \
-                    + m_mpp->m_tmp_file->getFilename() + "\" failed");
-                return -1;
-            }
-
-            m_mpp->m_value.append(std::string(m_buf,
-                    MULTIPART_BUF_SIZE - m_bufleft));
             m_mpp->m_valueOffset = offset - (MULTIPART_BUF_SIZE - m_bufleft);
 
             m_mpp->m_tmp_file_size.first += (MULTIPART_BUF_SIZE - m_bufleft);
@@ -946,7 +1130,7 @@ int Multipart::process_part_header(std::string *error, int offset) {
 }
 
 
-int Multipart::process_boundary(int last_part) {
+int Multipart::process_boundary(int last_part, std::string *error) {
     /* if there was a part being built finish it */
     if (m_mpp != NULL) {
         /* record all the part header lines from the part into the transaction collection */
@@ -956,10 +1140,20 @@ int Multipart::process_boundary(int last_part) {
             ms_dbg_a(m_transaction, 9, "Multipart: Added part header line:" + header_line.second );
         }
 
-        /* close the temp file */
+        /*
+         * close the temp file, or have the upload runner do it; a part
+         * without a name is dropped right below, so not that one
+         */
         if ((m_mpp->m_type == MULTIPART_FILE) && (m_mpp->m_tmp_file)
-            && (m_mpp->m_tmp_file->isValid())) {
-            m_mpp->m_tmp_file->Close();
+            && (m_mpp->m_tmp_file->isValid())
+            && (m_mpp->m_name.empty() || offload(m_mpp) == false)
+            && (m_mpp->m_tmp_file->Close() == false)) {
+            ms_dbg_a(m_transaction, 1,
+                "Multipart: writing to \"" \
+                + m_mpp->m_tmp_file->getFilename() + "\" failed");
+            error->assign("Multipart: writing to \"" \
+                + m_mpp->m_tmp_file->getFilename() + "\" failed");
+            return -1;
         }
 
         if (m_mpp->m_type != MULTIPART_FILE) {
@@ -1020,10 +1214,108 @@ int Multipart::process_boundary(int last_part) {
 }
 
 
+size_t Multipart::filesTmpContentLimit() const {
+    if (m_transaction->m_rules->m_requestBodyInMemoryLimit.m_set) {
+        return static_cast<size_t>(
+            m_transaction->m_rules->m_requestBodyInMemoryLimit.m_value);
+    }
+    return 0;
+}
+
+
 /**
  * Finalize multipart processing. This method is invoked at the end, when it
  * is clear that there is no more data to be processed.
  */
+/*
+ * FILES_TMP_CONTENT of a file part: the data kept in memory, or what its
+ * temporary file has, read once (by the upload runner, when it had the
+ * part), up to SecRequestBodyInMemoryLimit when that is set. The variable
+ * takes the value over; the rules looking at it all borrow that one copy.
+ */
+void Multipart::filesTmpContent(MultipartPart *m) {
+    size_t limit = filesTmpContentLimit();
+    std::string content;
+
+    if (m->m_in_memory || m->m_content_ready) {
+        content.swap(m->m_memory);
+    } else if (m->m_tmp_file && !m->m_tmp_file->getFilename().empty()
+        && m->m_tmp_file->read(limit, &content) == false) {
+        ms_dbg_a(m_transaction, 4, "Multipart: failed to read back \"" \
+            + m->m_tmp_file->getFilename() + "\" (" + strerror(errno) \
+            + ")");
+    }
+    if (limit != 0 && content.size() > limit) {
+        content.resize(limit);
+    }
+
+    m_transaction->m_variableFilesTmpContent.setCopy(m->m_name,
+        std::move(content), m->m_valueOffset);
+}
+
+
+/*
+ * Leaves what is left to do on a file part whose data is all in to the
+ * upload runner (see ModSecurity::setUploadThreads): the last write and
+ * the closing of its temporary file, and reading it back when the rules
+ * look at FILES_TMP_CONTENT. The parts after it are parsed meanwhile;
+ * join() waits for them all. False, and the part left alone, without a
+ * runner or with too many parts waiting for it.
+ *
+ * The task does not log: the transaction is in use on the request thread.
+ * What went wrong is in the part, for multipart_complete().
+ */
+bool Multipart::offload(MultipartPart *m) {
+    Utils::AsyncRunner *runner = m_transaction->m_ms != NULL
+        ? m_transaction->m_ms->uploadRunner() : NULL;
+    if (runner == NULL) {
+        return false;
+    }
+
+    std::shared_ptr<MultipartPartTmpFile> file = m->m_tmp_file;
+    bool content = m_transaction->m_rules->m_variablesInUse.uses(
+        ConfigVariablesInUse::FilesTmpContent);
+    size_t limit = filesTmpContentLimit();
+
+    pthread_mutex_lock(&m_offloadedLock);
+    m_offloaded++;
+    pthread_mutex_unlock(&m_offloadedLock);
+
+    bool offered = runner->offer([this, m, file, content, limit]() {
+        m->m_close_failed = file->Close() == false;
+        if (content && m->m_close_failed == false) {
+            m->m_content_ready = file->read(limit, &m->m_memory);
+        }
+
+        pthread_mutex_lock(&m_offloadedLock);
+        if (--m_offloaded == 0) {
+            pthread_cond_broadcast(&m_offloadedDone);
+        }
+        pthread_mutex_unlock(&m_offloadedLock);
+    });
+
+    if (offered == false) {
+        pthread_mutex_lock(&m_offloadedLock);
+        m_offloaded--;
+        pthread_mutex_unlock(&m_offloadedLock);
+        return false;
+    }
+
+    ms_dbg_a(m_transaction, 9, "Multipart: Left closing \"" \
+        + file->getFilename() + "\" to the upload threads");
+    return true;
+}
+
+
+void Multipart::join() {
+    pthread_mutex_lock(&m_offloadedLock);
+    while (m_offloaded > 0) {
+        pthread_cond_wait(&m_offloadedDone, &m_offloadedLock);
+    }
+    pthread_mutex_unlock(&m_offloadedLock);
+}
+
+
 int Multipart::multipart_complete(std::string *error) {
     m_transaction->m_variableMultipartUnmatchedBoundary.set(
         std::to_string(m_flag_unmatched_boundary),
@@ -1164,7 +1456,7 @@ int Multipart::multipart_complete(std::string *error) {
                     }
 
                     /* Looks like the final boundary - process it. */
-                    if (process_boundary(1 /* final */) < 0) {
+                    if (process_boundary(1 /* final */, error) < 0) {
                         m_flag_error = 1;
                         return -1;
                     }
@@ -1188,6 +1480,20 @@ int Multipart::multipart_complete(std::string *error) {
         }
     }
 
+    /* the parts left to the upload runner, before the variables */
+    join();
+    for (MultipartPart *m : m_parts) {
+        if (m->m_close_failed) {
+            ms_dbg_a(m_transaction, 1,
+                "Multipart: writing to \"" \
+                + m->m_tmp_file->getFilename() + "\" failed");
+            error->assign("Multipart: writing to \"" \
+                + m->m_tmp_file->getFilename() + "\" failed");
+            m_flag_error = 1;
+            return -1;
+        }
+    }
+
     int file_combined_size = 0;
     for (MultipartPart *m : m_parts) {
         // FIXME: duplicate code, see transaction.
@@ -1214,8 +1520,10 @@ int Multipart::multipart_complete(std::string *error) {
                 m->m_tmp_file_size.second,
                 m->m_tmp_file_size.first);
 
-            m_transaction->m_variableFilesTmpContent.set(m->m_name,
-               m->m_value, m->m_valueOffset);
+            if (m_transaction->m_rules->m_variablesInUse.uses(
+                ConfigVariablesInUse::FilesTmpContent)) {
+                filesTmpContent(m);
+            }
 
             file_combined_size = file_combined_size + m->m_tmp_file_size.first;
 
@@ -1228,8 +1536,11 @@ int Multipart::multipart_complete(std::string *error) {
                 m->m_name + "\", value \"" + m->m_value + "\"");
             m_transaction->m_variableArgs.set(m->m_name, m->m_value,
                 offset + m->m_valueOffset);
-            m_transaction->m_variableArgsPost.set(m->m_name, m->m_value,
-               offset + m->m_valueOffset);
+            if (m_transaction->m_rules->m_variablesInUse.uses(
+                ConfigVariablesInUse::ArgsPost)) {
+                m_transaction->m_variableArgsPost.set(m->m_name, m->m_value,
+                   offset + m->m_valueOffset);
+            }
         }
 #if 0
         if (m_transaction->m_namesArgs->empty()) {
@@ -1490,21 +1801,22 @@ bool Multipart::init(std::string *error) {
  * Assuming that all data is on data. We are not processing chunks.
  *
  */
-bool Multipart::process(const std::string& data, std::string *error,
+bool Multipart::process(const char *data, size_t size, std::string *error,
     int offset) {
-    const char *inptr = data.c_str();
-    unsigned int inleft = data.size();
+    const char *inptr = data;
+    unsigned int inleft = size;
     size_t z = 0;
 
-    if (data.size() == 0) return true;
+    if (size == 0) return true;
     m_seen_data = true;
+    m_received += size;
 
     if (m_is_complete) {
         m_flag_data_before = true;
 
         ms_dbg_a(m_transaction, 4,
             "Multipart: Ignoring data after last boundary (received " \
-            + std::to_string(data.size()) + " bytes)");
+            + std::to_string(size) + " bytes)");
 
         return true;
     }
@@ -1517,8 +1829,33 @@ bool Multipart::process(const std::string& data, std::string *error,
         return false;
     }
 
-    /* here we loop through the available data, one byte at a time */
+    /* here we loop through the available data */
     while (inleft > 0) {
+        /*
+         * Bytes that can not end the line, nor fill the buffer, are taken
+         * in one go: up to the next new line, keeping the last byte of the
+         * buffer for the byte at a time path below. In a file part that is
+         * most of the data. It goes exactly as it would have byte by byte.
+         */
+        if (m_bufleft > 1) {
+            size_t n = std::min(static_cast<size_t>(inleft),
+                static_cast<size_t>(m_bufleft - 1));
+            const char *nl = static_cast<const char *>(memchr(inptr, '\n',
+                n));
+            size_t run = nl != NULL ? nl - inptr : n;
+
+            if (run > 0) {
+                memcpy(m_bufptr, inptr, run);
+                m_bufptr += run;
+                m_bufleft -= run;
+                inptr += run;
+                inleft -= run;
+                z += run;
+                m_crlf_state = (*(inptr - 1) == '\r') ? 1 : 0;
+                continue;
+            }
+        }
+
         char c = *inptr;
         int process_buffer = 0;
 
@@ -1545,8 +1882,8 @@ bool Multipart::process(const std::string& data, std::string *error,
             *(m_bufptr) = 0;
 
             /* Do we have something that looks like a boundary? */
-            if (m_buf_contains_line && (strlen(m_buf) > 3) && (*(m_buf) == '-')
-                && (*(m_buf + 1) == '-')) {
+            if (m_buf_contains_line && (*(m_buf) == '-')
+                && (*(m_buf + 1) == '-') && (strlen(m_buf) > 3)) {
                 /* Does it match our boundary? */
                 if ((strlen(m_buf) >= m_boundary.size() + 2)
                     && (strncmp(m_buf + 2, m_boundary.c_str(),
@@ -1604,11 +1941,21 @@ bool Multipart::process(const std::string& data, std::string *error,
                                 m_flag_crlf_line = 1;
                             }
 
-                            if (process_boundary((is_final ? 1 : 0)) < 0) {
+                            if (process_boundary((is_final ? 1 : 0), error) < 0) {
                                 m_flag_error = true;
                                 return false;
                             }
 
+                            /* a part at a time, see SecTransactionTimeBudget */
+                            if (!is_final && m_transaction->timeBudgetExceeded()) {
+                                m_flag_error = true;
+                                ms_dbg_a(m_transaction, 4, "Multipart: " \
+                                    "transaction time budget exceeded.");
+                                error->assign("Multipart: transaction time " \
+                                    "budget exceeded.");
+                                return false;
+                            }
+
                             if (is_final) {
                                 m_is_complete = 1;
                             }
@@ -1669,18 +2016,18 @@ bool Multipart::process(const std::string& data, std::string *error,
                  * there that resembles a boundary.
                  */
                 if (m_buf_contains_line) {
-                    int i, len = (MULTIPART_BUF_SIZE - m_bufleft);
-                    char *p = m_buf;
-
-                    for (i = 0; i < len; i++) {
-                        if ((p[i] == '-') && (i + 1 < len)
-                            && (p[i + 1] == '-')) {
-                            if (strncmp(p + i + 2, m_boundary.c_str(),
-                                m_boundary.size()) == 0) {
-                                m_flag_unmatched_boundary = 1;
-                                break;
-                            }
+                    const char *p = m_buf;
+                    const char *end = m_buf + (MULTIPART_BUF_SIZE - m_bufleft);
+
+                    while ((p = static_cast<const char *>(memchr(p, '-',
+                        end - p))) != NULL) {
+                        if ((p + 1 < end) && (p[1] == '-')
+                            && (strncmp(p + 2, m_boundary.c_str(),
+                                m_boundary.size()) == 0)) {
+                            m_flag_unmatched_boundary = 1;
+                            break;
                         }
+                        p++;
                     }
                 }
             }
@@ -13,6 +13,8 @@
  *
  */
 
+#include <pthread.h>
+
 #include <string>
 #include <iostream>
 #include <list>
@@ -28,30 +30,23 @@ namespace modsecurity {
 namespace RequestBodyProcessor {
 
 #define MULTIPART_BUF_SIZE 4096
-#define MULTIPART_FORMDATA 1
-#define MULTIPART_FILE 2
 
+/*
+ * Data of the file parts is gathered up to this size before it hits the
+ * temporary file.
+ */
+#ifndef MULTIPART_WRITE_BUF_SIZE
+#define MULTIPART_WRITE_BUF_SIZE 262144
+#endif
 
-struct MyHash {
-    size_t operator()(const std::string& Keyval) const {
-        size_t h = 0;
-        std::for_each(Keyval.begin(), Keyval.end(), [&](char c) {
-            h += tolower(c);
-        });
-        return h;
-    }
-};
+/* files expected to be at least that big get their space reserved */
+#define MULTIPART_PREALLOCATE_MIN 1048576
+#define MULTIPART_FORMDATA 1
+#define MULTIPART_FILE 2
 
 
-struct MyEqual {
-    bool operator()(const std::string& Left, const std::string& Right) const {
-        return Left.size() == Right.size()
-             && std::equal(Left.begin(), Left.end(), Right.begin(),
-            [](char a, char b) {
-                return tolower(a) == tolower(b);
-            });
-    }
-};
+typedef modsecurity::MyHash MyHash;
+typedef modsecurity::MyEqual MyEqual;
 
 
 class MultipartPartTmpFile {
@@ -59,6 +54,9 @@ class MultipartPartTmpFile {
      explicit MultipartPartTmpFile(Transaction *transaction)
         : m_transaction(transaction),
         m_tmp_file_fd(0),
+        m_anonymous_fd(-1),
+        m_preallocated(false),
+        m_size(0),
         m_delete(false)
     { }
 
@@ -75,13 +73,44 @@ class MultipartPartTmpFile {
 
     bool isValid() const {return ((m_tmp_file_fd != 0) && (!m_tmp_file_name.empty()));}
 
-    void Open();
-    void Close();
+    /*
+     * expected is an upper bound of the size of the file, as far as it is
+     * known; 0 if it is not.
+     */
+    void Open(size_t expected = 0);
+    /* false if the data still buffered could not be written */
+    bool Close();
+
+    /*
+     * Appends the reserve and then the data. Both are only buffered
+     * until there is MULTIPART_WRITE_BUF_SIZE worth of them, then go
+     * down in a single writev().
+     */
+    bool write(const char *reserve, size_t reserve_len,
+        const char *data, size_t len);
+
+    /*
+     * The first limit bytes of what was written (all of it with 0), read
+     * through a read only mapping of the file. Once Close()d.
+     */
+    bool read(size_t limit, std::string *content) const;
 
  private:
+    bool flush(const char *reserve = NULL, size_t reserve_len = 0,
+        const char *data = NULL, size_t len = 0);
+    bool openAnonymous(const std::string &dir);
+
     Transaction *m_transaction;
     int m_tmp_file_fd;
+    /*
+     * SecUploadAnonymousFiles: O_TMPFILE, named after its descriptor in
+     * /proc/self/fd, which stays open until the transaction is done.
+     */
+    int m_anonymous_fd;
     std::string m_tmp_file_name;
+    std::string m_pending;
+    bool m_preallocated;
+    size_t m_size;
     bool m_delete; // whether to delete when transaction is done
 };
 
@@ -96,6 +125,9 @@ class MultipartPart {
      m_valueOffset(0),
      m_value_parts(),
      m_tmp_file_size(),
+     m_in_memory(false),
+     m_close_failed(false),
+     m_content_ready(false),
      m_filename(""),
      m_filenameOffset(0),
      m_last_header_name(""),
@@ -131,6 +163,23 @@ class MultipartPart {
     std::shared_ptr<RequestBodyProcessor::MultipartPartTmpFile> m_tmp_file;
     std::pair<size_t, size_t> m_tmp_file_size;
 
+    /*
+     * files only, the data while it is within SecUploadInMemoryLimit;
+     * such a file gets no temporary file, only FILES_TMP_CONTENT. The
+     * data of the others is only read back, for FILES_TMP_CONTENT, from
+     * their temporary file.
+     */
+    bool m_in_memory;
+    std::string m_memory;
+
+    /*
+     * files only, left by the upload runner (see Multipart::offload()):
+     * the temporary file could not be closed; m_memory holds what it has
+     * for FILES_TMP_CONTENT already.
+     */
+    bool m_close_failed;
+    bool m_content_ready;
+
     /* files only, filename as supplied by the browser */
     std::string m_filename;
     size_t m_filenameOffset;
@@ -160,8 +209,9 @@ class Multipart {
     int multipart_complete(std::string *err);
 
     int parse_content_disposition(const char *c_d_value, int offset);
-    bool process(const std::string& data, std::string *err, int offset);
-    int process_boundary(int last_part);
+    bool process(const char *data, size_t size, std::string *err,
+        int offset);
+    int process_boundary(int last_part, std::string *error);
     int process_part_header(std::string *error, int offset);
     int process_part_data(std::string *error, size_t offset);
 
@@ -189,6 +239,9 @@ class Multipart {
 
     unsigned int m_buf_offset;
 
+    /* request body handed to process() so far */
+    size_t m_received;
+
     /* line ending status seen immediately before current position.
      * 0 = neither LF nor CR; 1 = prev char CR; 2 = prev char LF alone;
      * 3 = prev two chars were CRLF
@@ -245,8 +298,18 @@ class Multipart {
     int m_flag_file_limit_exceeded;
 
  private:
+    size_t filesTmpContentLimit() const;
+    void filesTmpContent(MultipartPart *m);
+    bool offload(MultipartPart *m);
+    void join();
+
     std::string m_header;
     Transaction *m_transaction;
+
+    /* parts handed to the upload runner that it is not done with */
+    size_t m_offloaded;
+    pthread_mutex_t m_offloadedLock;
+    pthread_cond_t m_offloadedDone;
 };
 
 
@@ -25,8 +25,38 @@ namespace RequestBodyProcessor {
 
 #ifdef WITH_LIBXML2
 
+namespace {
+
+/*
+ * Names a recycled context may have in its dictionary; past that it is
+ * freed instead, a stream of bodies with ever new names would grow it
+ * forever otherwise.
+ */
+const size_t kParserDictLimit = 16384;
+
+/*
+ * The parser context last used on this thread, waiting for the next
+ * body. While a transaction uses it, it is that transaction's alone.
+ */
+struct ParserCache {
+    ParserCache() : m_ctxt(NULL) { }
+    ~ParserCache() {
+        if (m_ctxt != NULL) {
+            xmlFreeParserCtxt(m_ctxt);
+        }
+    }
+    xmlParserCtxtPtr m_ctxt;
+};
+
+thread_local ParserCache parserCache;
+
+}  // namespace
+
+
 XML::XML(Transaction *transaction)
-    : m_transaction(transaction) {
+    : m_transaction(transaction),
+    m_xpathContext(NULL) {
+    pthread_mutex_init(&m_xpathLock, NULL);
     m_data.doc = NULL;
     m_data.parsing_ctx = NULL;
     m_data.sax_handler = NULL;
@@ -34,8 +64,16 @@ XML::XML(Transaction *transaction)
 
 
 XML::~XML() {
+    if (m_xpathContext != NULL) {
+        xmlXPathFreeContext(m_xpathContext);
+    }
+    pthread_mutex_destroy(&m_xpathLock);
+    if (m_data.sax_handler != NULL) {
+        delete m_data.sax_handler;
+        m_data.sax_handler = NULL;
+    }
     if (m_data.parsing_ctx != NULL) {
-        xmlFreeParserCtxt(m_data.parsing_ctx);
+        recycleParser(m_data.parsing_ctx);
         m_data.parsing_ctx = NULL;
     }
     if (m_data.doc != NULL) {
@@ -60,6 +98,69 @@ bool XML::init() {
 }
 
 
+/*
+ * A push parser for a new body, starting with buf: the one this thread
+ * kept when there is one, reset, a new one otherwise.
+ *
+ * With XML_PARSE_NODICT the document gets copies of its names rather
+ * than entries of the context's dictionary. It does not hold on to the
+ * dictionary then, and the context can go on with the next body while
+ * the document is still in use. The entity loader is not part of the context: what
+ * init() installed applies to a recycled context as well.
+ */
+xmlParserCtxtPtr XML::acquireParser(xmlSAXHandler *sax, const char *buf,
+    unsigned int size) {
+    xmlParserCtxtPtr ctxt = parserCache.m_ctxt;
+    parserCache.m_ctxt = NULL;
+
+    if (ctxt == NULL) {
+        ctxt = xmlCreatePushParserCtxt(sax, NULL, buf, size, "body.xml");
+        if (ctxt == NULL) {
+            return NULL;
+        }
+    } else {
+        if (xmlCtxtResetPush(ctxt, buf, size, "body.xml", NULL) != 0) {
+            xmlFreeParserCtxt(ctxt);
+            return NULL;
+        }
+        if (sax != NULL) {
+            *ctxt->sax = *sax;
+        } else {
+            xmlSAXVersion(ctxt->sax, 2);
+        }
+    }
+
+    /* what xmlCtxtUseOptions does for it, leaving the rest alone */
+    ctxt->dictNames = 0;
+    ctxt->options |= XML_PARSE_NODICT;
+    return ctxt;
+}
+
+
+/*
+ * Gives the context back to the thread the transaction is on, which
+ * need not be the one it came from. The document, if any, has been
+ * taken out of it already.
+ */
+void XML::recycleParser(xmlParserCtxtPtr ctxt) {
+    if (parserCache.m_ctxt != NULL
+        || (ctxt->dict != NULL && xmlDictSize(ctxt->dict)
+            > static_cast<int>(kParserDictLimit))) {
+        xmlFreeParserCtxt(ctxt);
+        return;
+    }
+    parserCache.m_ctxt = ctxt;
+}
+
+
+void XML::releaseParser() {
+    if (parserCache.m_ctxt != NULL) {
+        xmlFreeParserCtxt(parserCache.m_ctxt);
+        parserCache.m_ctxt = NULL;
+    }
+}
+
+
 xmlParserInputBufferPtr XML::unloadExternalEntity(const char *URI,
     xmlCharEncoding enc) {
     return NULL;
@@ -77,21 +178,33 @@ bool XML::processChunk(const char *buf, unsigned int size,
 
         ms_dbg_a(m_transaction, 4, "XML: Initialising parser.");
 
-        /* NOTE When Sax interface is used libxml will not
-         *      create the document object, but we need it.
-
-        msr->xml->sax_handler = (xmlSAXHandler *)apr_pcalloc(msr->mp,
-            sizeof(xmlSAXHandler));
-        if (msr->xml->sax_handler == NULL) return -1;
-        msr->xml->sax_handler->error = xml_receive_sax_error;
-        msr->xml->sax_handler->warning = xml_receive_sax_error;
-        msr->xml->parsing_ctx = xmlCreatePushParserCtxt(msr->xml->sax_handler,
-            msr, buf, size, "body.xml");
-
-        */
+        /* The tree is only needed by the XML variables and the
+         * @validateDTD/@validateSchema operators. When none of the
+         * loaded rules use them the document is parsed with SAX2
+         * callbacks that drop the elements and the text as they
+         * come, so memory stays bounded whatever the body size. The
+         * internal subset is still kept, entities declared in it must
+         * resolve for the body to be found well formed.
+         */
+        if (m_transaction->m_rules->m_xmlDomRequired
+            != RulesSetProperties::TrueConfigBoolean) {
+            ms_dbg_a(m_transaction, 4, "XML: No rule needs the " \
+                "document tree, parsing without it.");
+            m_data.sax_handler = new xmlSAXHandler();
+            xmlSAXVersion(m_data.sax_handler, 2);
+            m_data.sax_handler->startElementNs = NULL;
+            m_data.sax_handler->endElementNs = NULL;
+            m_data.sax_handler->startElement = NULL;
+            m_data.sax_handler->endElement = NULL;
+            m_data.sax_handler->characters = NULL;
+            m_data.sax_handler->ignorableWhitespace = NULL;
+            m_data.sax_handler->cdataBlock = NULL;
+            m_data.sax_handler->reference = NULL;
+            m_data.sax_handler->comment = NULL;
+            m_data.sax_handler->processingInstruction = NULL;
+        }
 
-        m_data.parsing_ctx = xmlCreatePushParserCtxt(NULL, NULL,
-            buf, size, "body.xml");
+        m_data.parsing_ctx = acquireParser(m_data.sax_handler, buf, size);
 
         if (m_data.parsing_ctx == NULL) {
             ms_dbg_a(m_transaction, 4,
@@ -126,9 +239,15 @@ bool XML::complete(std::string *error) {
         /* Preserve the results for our reference. */
         m_data.well_formed = m_data.parsing_ctx->wellFormed;
         m_data.doc = m_data.parsing_ctx->myDoc;
+        m_data.parsing_ctx->myDoc = NULL;
+        if (m_data.sax_handler != NULL && m_data.doc != NULL) {
+            /* Only the prolog is in there, nothing to look at. */
+            xmlFreeDoc(m_data.doc);
+            m_data.doc = NULL;
+        }
 
         /* Clean up everything else. */
-        xmlFreeParserCtxt(m_data.parsing_ctx);
+        recycleParser(m_data.parsing_ctx);
         m_data.parsing_ctx = NULL;
         ms_dbg_a(m_transaction, 4, "XML: Parsing complete (well_formed " \
             + std::to_string(m_data.well_formed) + ").");
@@ -143,6 +262,92 @@ bool XML::complete(std::string *error) {
     return true;
 }
 
+
+/**
+ * The content of the nodes that expression selects in the document, with
+ * the given namespaces registered, or NULL when there is no document or
+ * the namespaces do not register. compiled may be NULL, the expression
+ * is then parsed here. The results stay valid as long as this XML.
+ */
+const std::vector<std::string> *XML::xpath(const std::string &expression,
+    xmlXPathCompExprPtr compiled, const Namespaces &namespaces) {
+    std::string scope;
+    for (const auto &ns : namespaces) {
+        scope.append(ns.first);
+        scope.push_back('\0');
+        scope.append(ns.second);
+        scope.push_back('\0');
+    }
+    std::string key(scope);
+    key.append(expression);
+
+    pthread_mutex_lock(&m_xpathLock);
+    auto it = m_xpathResults.find(key);
+    if (it != m_xpathResults.end()) {
+        pthread_mutex_unlock(&m_xpathLock);
+        return &it->second;
+    }
+
+    if (m_data.doc == NULL) {
+        pthread_mutex_unlock(&m_xpathLock);
+        return NULL;
+    }
+    if (m_xpathContext == NULL) {
+        m_xpathContext = xmlXPathNewContext(m_data.doc);
+        if (m_xpathContext == NULL) {
+            pthread_mutex_unlock(&m_xpathLock);
+            ms_dbg_a(m_transaction, 1, "XML: Unable to create new XPath " \
+                "context. : ");
+            return NULL;
+        }
+    }
+
+    if (m_xpathNamespaces != scope) {
+        xmlXPathRegisteredNsCleanup(m_xpathContext);
+        m_xpathNamespaces.clear();
+        for (const auto &ns : namespaces) {
+            if (xmlXPathRegisterNs(m_xpathContext,
+                reinterpret_cast<const xmlChar *>(ns.first.c_str()),
+                reinterpret_cast<const xmlChar *>(ns.second.c_str())) != 0) {
+                xmlXPathRegisteredNsCleanup(m_xpathContext);
+                pthread_mutex_unlock(&m_xpathLock);
+                ms_dbg_a(m_transaction, 1, "Failed to register XML " \
+                    "namespace href \"" + ns.second + "\" prefix \"" \
+                    + ns.first + "\".");
+                return NULL;
+            }
+            ms_dbg_a(m_transaction, 4, "Registered XML namespace href \"" \
+                + ns.second + "\" prefix \"" + ns.first + "\"");
+        }
+        m_xpathNamespaces = scope;
+    }
+
+    std::vector<std::string> &contents = m_xpathResults[key];
+    xmlXPathObjectPtr obj = compiled != NULL
+        ? xmlXPathCompiledEval(compiled, m_xpathContext)
+        : xmlXPathEvalExpression(
+            reinterpret_cast<const xmlChar *>(expression.c_str()),
+            m_xpathContext);
+    if (obj == NULL) {
+        ms_dbg_a(m_transaction, 1, "XML: Unable to evaluate xpath " \
+            "expression.");
+    } else {
+        xmlNodeSetPtr nodes = obj->nodesetval;
+        for (int i = 0; nodes != NULL && i < nodes->nodeNr; i++) {
+            char *content = reinterpret_cast<char *>(
+                xmlNodeGetContent(nodes->nodeTab[i]));
+            if (content != NULL) {
+                contents.emplace_back(content);
+                xmlFree(content);
+            }
+        }
+        xmlXPathFreeObject(obj);
+    }
+
+    pthread_mutex_unlock(&m_xpathLock);
+    return &contents;
+}
+
 #endif
 
 }  // namespace RequestBodyProcessor
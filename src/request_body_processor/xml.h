@@ -16,10 +16,16 @@
 #ifdef WITH_LIBXML2
 #include <libxml/xmlschemas.h>
 #include <libxml/xpath.h>
+#include <libxml/xpathInternals.h>
 #endif
 
+#include <pthread.h>
+
 #include <string>
 #include <iostream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "modsecurity/transaction.h"
 #include "modsecurity/rules_set.h"
@@ -56,12 +62,34 @@ class XML {
     static void null_error(void *ctx, const char *msg, ...) {
     }
 
+    /* Frees the parser context this thread keeps, see processChunk. */
+    static void releaseParser();
+
+    typedef std::vector<std::pair<std::string, std::string>> Namespaces;
+    const std::vector<std::string> *xpath(const std::string &expression,
+        xmlXPathCompExprPtr compiled, const Namespaces &namespaces);
 
     xml_data m_data;
 
  private:
+    static xmlParserCtxtPtr acquireParser(xmlSAXHandler *sax,
+        const char *buf, unsigned int size);
+    static void recycleParser(xmlParserCtxtPtr ctxt);
+
     Transaction *m_transaction;
     std::string m_header;
+
+    /*
+     * The XML: variables of a transaction ask for the same expressions
+     * over and over, from rules that may run in parallel: one XPath
+     * context is kept for the whole document, along with the content of
+     * the nodes each expression selected (keyed by the expression and
+     * the namespaces it was evaluated under).
+     */
+    pthread_mutex_t m_xpathLock;
+    xmlXPathContextPtr m_xpathContext;
+    std::string m_xpathNamespaces;
+    std::unordered_map<std::string, std::vector<std::string>> m_xpathResults;
 };
 
 #endif
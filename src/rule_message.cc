@@ -15,6 +15,9 @@
 
 #include "modsecurity/rule_message.h"
 
+#include <algorithm>
+#include <string>
+
 #include "modsecurity/rules_set.h"
 #include "modsecurity/modsecurity.h"
 #include "modsecurity/transaction.h"
@@ -25,28 +28,65 @@ namespace modsecurity {
 
 std::string RuleMessage::_details(const RuleMessage *rm) {
     std::string msg;
+    const RuleWithActions::LogDetails *d = nullptr;
 
-    msg.append(" [file \"" + std::string(*rm->m_ruleFile.get()) + "\"]");
-    msg.append(" [line \"" + std::to_string(rm->m_ruleLine) + "\"]");
-    msg.append(" [id \"" + std::to_string(rm->m_ruleId) + "\"]");
-    msg.append(" [rev \"" + utils::string::toHexIfNeeded(rm->m_rev, true) + "\"]");
-    msg.append(" [msg \"" + rm->m_message + "\"]");
-    msg.append(" [data \"" + utils::string::toHexIfNeeded(utils::string::limitTo(200, rm->m_data), true) + "\"]");
-    msg.append(" [severity \"" +
-        std::to_string(rm->m_severity) + "\"]");
-    msg.append(" [ver \"" + utils::string::toHexIfNeeded(rm->m_ver, true) + "\"]");
-    msg.append(" [maturity \"" + std::to_string(rm->m_maturity) + "\"]");
-    msg.append(" [accuracy \"" + std::to_string(rm->m_accuracy) + "\"]");
-
-    for (auto &a : rm->m_tags) {
-        msg.append(" [tag \"" + utils::string::toHexIfNeeded(a, true) + "\"]");
+    if (rm->m_details.empty() == false) {
+        return rm->m_details;
+    }
+    if (rm->m_rule != nullptr) {
+        d = &rm->m_rule->logDetails();
     }
+    msg.reserve(512);
 
-    msg.append(" [hostname \"" + *rm->m_serverIpAddress.get() \
-        + "\"]");
-    msg.append(" [uri \"" + utils::string::limitTo(200, *rm->m_uriNoQueryStringDecoded.get()) + "\"]");
-    msg.append(" [unique_id \"" + *rm->m_id + "\"]");
-    msg.append(" [ref \"" + utils::string::limitTo(200, rm->m_reference) + "\"]");
+    if (d && d->m_fileName != nullptr && d->m_fileName == rm->m_ruleFile.get()
+        && d->m_lineNumber == rm->m_ruleLine && d->m_ruleId == rm->m_ruleId
+        && d->m_rev == rm->m_rev) {
+        msg.append(d->m_head);
+    } else {
+        msg.append(" [file \"").append(*rm->m_ruleFile);
+        msg.append("\"] [line \"").append(std::to_string(rm->m_ruleLine));
+        msg.append("\"] [id \"").append(std::to_string(rm->m_ruleId));
+        msg.append("\"] [rev \"");
+        msg.append(utils::string::toHexIfNeeded(rm->m_rev, true));
+        msg.append("\"]");
+    }
+    msg.append(" [msg \"").append(rm->m_message);
+    msg.append("\"] [data \"");
+    msg.append(utils::string::toHexIfNeeded(
+        utils::string::limitTo(200, rm->m_data), true));
+    msg.append("\"] [severity \"").append(std::to_string(rm->m_severity));
+    msg.append("\"]");
+
+    if (d && d->m_ver == rm->m_ver && d->m_maturity == rm->m_maturity
+        && d->m_accuracy == rm->m_accuracy) {
+        msg.append(d->m_middle);
+    } else {
+        msg.append(" [ver \"");
+        msg.append(utils::string::toHexIfNeeded(rm->m_ver, true));
+        msg.append("\"] [maturity \"").append(std::to_string(rm->m_maturity));
+        msg.append("\"] [accuracy \"").append(std::to_string(rm->m_accuracy));
+        msg.append("\"]");
+    }
+
+    if (d && d->m_tagNames.size() == rm->m_tags.size()
+        && std::equal(rm->m_tags.begin(), rm->m_tags.end(),
+            d->m_tagNames.begin())) {
+        msg.append(d->m_tags);
+    } else {
+        for (auto &a : rm->m_tags) {
+            msg.append(" [tag \"");
+            msg.append(utils::string::toHexIfNeeded(a, true));
+            msg.append("\"]");
+        }
+    }
+
+    msg.append(" [hostname \"").append(*rm->m_serverIpAddress.get());
+    msg.append("\"] [uri \"");
+    msg.append(utils::string::limitTo(200,
+        *rm->m_uriNoQueryStringDecoded.get()));
+    msg.append("\"] [unique_id \"").append(*rm->m_id);
+    msg.append("\"] [ref \"");
+    msg.append(utils::string::limitTo(200, rm->m_reference)).append("\"]");
 
     return msg;
 }
@@ -79,7 +119,7 @@ std::string RuleMessage::log(const RuleMessage *rm, int props, int code) {
             msg.append(std::to_string(code));
         }
         msg.append(" (phase ");
-        msg.append(std::to_string(rm->m_rule->getPhase() - 1) + "). ");
+        msg.append(std::to_string(rm->m_phase) + "). ");
     } else {
         msg.append("ModSecurity: Warning. ");
     }
@@ -0,0 +1,96 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifndef SRC_RULE_PREFETCH_H_
+#define SRC_RULE_PREFETCH_H_
+
+
+namespace modsecurity {
+class RuleWithOperator;
+
+
+/**
+ * What matching a rule found, worked out ahead of time and in parallel
+ * with the other rules of its group (see SecRuleEvaluationThreads). The
+ * rule still evaluates in its turn but takes these results instead of
+ * matching again, so the actions run in rule order and the outcome is
+ * the one of a serial evaluation.
+ *
+ * Only the values that matched, or to which the operator added a
+ * reference without matching (a negated operator), are kept.
+ */
+class RulePrefetch {
+ public:
+    class Value {
+     public:
+        std::string m_key;
+        std::string m_value;
+        std::string m_transformed;
+        /* What the operator appended to the message reference. */
+        std::string m_operatorReference;
+        /* Variable origins and transformation path. */
+        std::string m_reference;
+        bool m_matched;
+    };
+
+    RulePrefetch()
+        : m_evaluated(0),
+        m_transformationNs(0),
+        m_operatorNs(0) { }
+
+    std::vector<Value> m_values;
+    size_t m_evaluated;
+    uint64_t m_transformationNs;
+    uint64_t m_operatorNs;
+};
+
+
+/**
+ * The prefetched rules of the phase being evaluated. Entries are added
+ * before a group is handed to the pool, so that the workers only look
+ * them up. With m_valueMajor the groups are matched on the transaction
+ * thread instead, value by value (SecRuleValueMajor).
+ */
+class RulePrefetches {
+ public:
+    RulePrefetches()
+        : m_valueMajor(false) { }
+
+    RulePrefetch *add(const RuleWithOperator *rule) {
+        return &m_rules[rule];
+    }
+
+    RulePrefetch *find(const RuleWithOperator *rule) {
+        auto it = m_rules.find(rule);
+        return it == m_rules.end() ? nullptr : &it->second;
+    }
+
+    bool m_valueMajor;
+
+ private:
+    std::unordered_map<const RuleWithOperator *, RulePrefetch> m_rules;
+};
+
+
+}  // namespace modsecurity
+
+#endif  // SRC_RULE_PREFETCH_H_
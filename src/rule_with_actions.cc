@@ -18,20 +18,27 @@
 #include <stdio.h>
 
 #include <algorithm>
+#include <functional>
 #include <iostream>
 #include <string>
 #include <cstring>
 #include <list>
 #include <utility>
 #include <memory>
+#include <vector>
 
 #include "modsecurity/rules_set.h"
 #include "src/operators/operator.h"
 #include "modsecurity/actions/action.h"
 #include "modsecurity/modsecurity.h"
 #include "src/actions/transformations/none.h"
+#include "src/actions/transformations/fused.h"
+#include "src/actions/transformations/transformation_cache.h"
 #include "src/actions/tag.h"
 #include "src/utils/string.h"
+#include "src/utils/interned_strings.h"
+#include "src/utils/metrics.h"
+#include "src/utils/verdict_cache.h"
 #include "modsecurity/rule_message.h"
 #include "modsecurity/rule_with_actions.h"
 #include "src/actions/msg.h"
@@ -39,6 +46,7 @@
 #include "src/actions/severity.h"
 #include "src/actions/capture.h"
 #include "src/actions/multi_match.h"
+#include "src/actions/no_verdict_cache.h"
 #include "src/actions/set_var.h"
 #include "src/actions/block.h"
 #include "src/variables/variable.h"
@@ -75,10 +83,16 @@ RuleWithActions::RuleWithActions(
     m_actionsSetVar(),
     m_actionsTag(),
     m_transformations(transformations != NULL ? *transformations : Transformations()),
+    m_tagIds(),
+    m_msgId(-1),
     m_containsCaptureAction(false),
+    m_containsCtlAction(false),
     m_containsMultiMatchAction(false),
+    m_containsNoVerdictCacheAction(false),
     m_containsStaticBlockAction(false),
-    m_isChained(false) {
+    m_isChained(false),
+    m_tagsContainMacro(false),
+    m_containsNoneTransformation(false) {
 
     if (transformations != NULL) {
         delete transformations;
@@ -97,6 +111,9 @@ RuleWithActions::RuleWithActions(
                 } else if (dynamic_cast<actions::MultiMatch *>(a)) {
                     m_containsMultiMatchAction = true;
                     delete a;
+                } else if (dynamic_cast<actions::NoVerdictCache *>(a)) {
+                    m_containsNoVerdictCacheAction = true;
+                    delete a;
                 } else if (dynamic_cast<actions::Severity *>(a)) {
                     m_severity = dynamic_cast<actions::Severity *>(a);
                 } else if (dynamic_cast<actions::LogData *>(a)) {
@@ -118,6 +135,10 @@ RuleWithActions::RuleWithActions(
                     }
                     m_disruptiveAction = a;
                 } else {
+                    if (a->m_name
+                        && utils::string::tolower(*a->m_name) == "ctl") {
+                        m_containsCtlAction = true;
+                    }
                     m_actionsRuntimePos.push_back(a);
                 }
             } else {
@@ -129,6 +150,105 @@ RuleWithActions::RuleWithActions(
         }
         delete actions;
     }
+
+    for (actions::Tag *tag : m_actionsTag) {
+        if (tag == NULL) {
+            continue;
+        }
+        if (tag->containsMacro()) {
+            m_tagsContainMacro = true;
+            continue;
+        }
+        int id = Utils::InternedStrings::id(tag->getName(nullptr));
+        if (id >= static_cast<int>(m_tagIds.size())) {
+            m_tagIds.resize(id + 1, false);
+        }
+        m_tagIds[id] = true;
+    }
+    if (m_msg && msgContainsMacro() == false) {
+        m_msgId = Utils::InternedStrings::id(m_msg->data(nullptr));
+    }
+
+    compileTransformations();
+    compileLogDetails();
+}
+
+
+/**
+ * Only what follows the last t:none is ever executed; that much is known
+ * at load time, as it is the multiMatch action. Without multiMatch the
+ * intermediate values do not matter and the chain can be optimized.
+ *
+ */
+void RuleWithActions::compileTransformations() {
+    size_t first = 0;
+
+    for (size_t i = 0; i < m_transformations.size(); i++) {
+        if (m_transformations[i]->m_isNone) {
+            m_containsNoneTransformation = true;
+            first = i + 1;
+        }
+    }
+
+    Transformations tail(m_transformations.begin() + first,
+        m_transformations.end());
+    if (m_containsMultiMatchAction) {
+        m_transformationsChain = tail;
+        return;
+    }
+    actions::transformations::Fused::optimize(tail, &m_transformationsChain,
+        &m_fusedTransformations);
+}
+
+
+/**
+ * Besides msg, data and severity, the details of a match are made of what
+ * the configuration actions left on the rule, so they are escaped here
+ * rather than on every match (see RuleMessage::_details).
+ *
+ */
+void RuleWithActions::compileLogDetails() {
+    LogDetails &d = m_logDetails;
+
+    d.m_fileName = getFileName().get();
+    d.m_lineNumber = getLineNumber();
+    d.m_ruleId = m_ruleId;
+    d.m_rev = m_rev;
+    d.m_head.clear();
+    if (d.m_fileName != nullptr) {
+        d.m_head.append(" [file \"").append(*d.m_fileName).append("\"]");
+    }
+    d.m_head.append(" [line \"").append(std::to_string(d.m_lineNumber));
+    d.m_head.append("\"] [id \"").append(std::to_string(d.m_ruleId));
+    d.m_head.append("\"] [rev \"");
+    d.m_head.append(utils::string::toHexIfNeeded(d.m_rev, true));
+    d.m_head.append("\"]");
+
+    d.m_ver = m_ver;
+    d.m_accuracy = m_accuracy;
+    d.m_maturity = m_maturity;
+    d.m_middle.assign(" [ver \"");
+    d.m_middle.append(utils::string::toHexIfNeeded(d.m_ver, true));
+    d.m_middle.append("\"] [maturity \"");
+    d.m_middle.append(std::to_string(d.m_maturity));
+    d.m_middle.append("\"] [accuracy \"");
+    d.m_middle.append(std::to_string(d.m_accuracy)).append("\"]");
+
+    d.m_tagNames.clear();
+    d.m_tags.clear();
+    if (m_tagsContainMacro) {
+        return;
+    }
+    for (actions::Tag *tag : m_actionsTag) {
+        if (tag == NULL) {
+            continue;
+        }
+        d.m_tagNames.push_back(tag->getName(nullptr));
+        d.m_tags.append(" [tag \"");
+        d.m_tags.append(utils::string::toHexIfNeeded(d.m_tagNames.back(),
+            true));
+        d.m_tags.append("\"]");
+    }
 }
 
 RuleWithActions::~RuleWithActions() {
@@ -172,9 +292,15 @@ RuleWithActions::~RuleWithActions() {
 
 
 bool RuleWithActions::evaluate(Transaction *transaction) {
-    RuleMessage rm(this, transaction);
-    std::shared_ptr<RuleMessage> rm2 = std::make_shared<RuleMessage>(&rm);
-    return evaluate(transaction, rm2);
+    std::shared_ptr<RuleMessage> &rm = transaction->m_ruleMessage;
+
+    if (rm != nullptr && rm.use_count() == 1) {
+        rm->reset(this, transaction);
+    } else {
+        rm = std::make_shared<RuleMessage>(this, transaction);
+    }
+
+    return evaluate(transaction, rm);
 }
 
 
@@ -307,9 +433,13 @@ void RuleWithActions::executeAction(Transaction *trans,
     }
 
     if (trans->getRuleEngineState() == RulesSet::EnabledRuleEngine) {
+        bool disrupted = trans->m_it.disruptive;
         ms_dbg_a(trans, 4, "Running (disruptive)     action: " + *a->m_name.get() + \
             ".");
         a->evaluate(this, trans, ruleMessage);
+        if (disrupted == false && trans->m_it.disruptive) {
+            Utils::Metrics::getInstance().intervention(ruleMessage->m_ruleId);
+        }
         return;
     }
 
@@ -318,91 +448,100 @@ void RuleWithActions::executeAction(Transaction *trans,
 }
 
 
+namespace {
+
+/*
+ * What the original value of a multiMatch rule is reported with; the
+ * intermediate ones have the name of the transformation, which the rule
+ * holds already, so neither is allocated per value.
+ */
+const std::shared_ptr<std::string> &noPath() {
+    static const std::shared_ptr<std::string> path =
+        std::make_shared<std::string>();
+    return path;
+}
+
+
+/*
+ * Whether value is none of the ones of ret, whose hashes are in seen; if
+ * so, its hash is added. Two steps of a chain often give the same string
+ * (t:lowercase over lower case input after t:urlDecode did something,
+ * t:trim and t:compressWhitespace...), no need to test it again.
+ */
+bool isNewValue(const TransformationResults &ret, std::vector<size_t> *seen,
+    const std::string &value) {
+    size_t hash = std::hash<std::string>()(value);
+    size_t i = 0;
+
+    for (const TransformationResult &r : ret) {
+        if ((*seen)[i++] == hash && *r.first == value) {
+            return false;
+        }
+    }
+    seen->push_back(hash);
+    return true;
+}
+
+}  // namespace
+
+
 inline void RuleWithActions::executeTransformation(
     actions::transformations::Transformation *a,
-    std::shared_ptr<std::string> *value,
+    std::string *value,
     Transaction *trans,
     TransformationResults *ret,
     std::string *path,
-    int *nth) const {
-
-    std::string *oldValue = (*value).get();
-    std::string newValue = a->evaluate(*oldValue, trans);
+    int *nth,
+    std::vector<size_t> *seen) const {
 
-    if (newValue != *oldValue) {
-        std::shared_ptr<std::string> u(new std::string(newValue));
-        if (m_containsMultiMatchAction) {
-            ret->push_back(std::make_pair(u, a->m_name));
-            (*nth)++;
-        }
-        *value = u;
+    if (a->transform(*value, trans) && m_containsMultiMatchAction
+        && isNewValue(*ret, seen, *value)) {
+        ret->push_back(std::make_pair(
+            std::make_shared<std::string>(*value), a->m_name));
+        (*nth)++;
     }
 
-    if (path->empty()) {
-        path->append(*a->m_name.get());
-    } else {
-        path->append("," + *a->m_name.get());
+    if (!path->empty()) {
+        path->push_back(',');
     }
+    path->append(*a->m_name.get());
 
     ms_dbg_a(trans, 9, " T (" + \
         std::to_string(*nth) + ") " + \
         *a->m_name.get() + ": \"" + \
-        utils::string::limitTo(80, newValue) +"\"");
+        utils::string::limitTo(80, *value) +"\"");
 }
 
-void RuleWithActions::executeTransformations(
-    Transaction *trans, const std::string &in, TransformationResults &ret) {
+/*
+ * What executeTransformations() runs, in order: the transformations of the
+ * SecDefaultAction of the phase, the ones of the rule and those added by
+ * SecRuleUpdateActionById.
+ */
+void RuleWithActions::getTransformationsChain(const RulesSet *rules,
+    std::vector<Transformation *> *chain) const {
     int none = 0;
-    int transformations = 0;
-    std::string path("");
-    std::shared_ptr<std::string> value =
-        std::shared_ptr<std::string>(new std::string(in));
-
-    if (m_containsMultiMatchAction == true) {
-        /* keep the original value */
-        ret.push_back(std::make_pair(
-            std::shared_ptr<std::string>(new std::string(*value)),
-            std::shared_ptr<std::string>(new std::string(path))));
-    }
-
-    for (Action *a : m_transformations) {
-        if (a->m_isNone) {
-            none++;
-        }
-    }
 
     // Check for transformations on the SecDefaultAction
     // Notice that first we make sure that won't be a t:none
     // on the target rule.
-    if (none == 0) {
-        for (auto &a : trans->m_rules->m_defaultActions[getPhase()]) {
+    if (m_containsNoneTransformation == false) {
+        for (auto &a : rules->m_defaultActions[getPhase()]) {
             if (a->action_kind \
                 != actions::Action::RunTimeBeforeMatchAttemptKind) {
                 continue;
             }
 
-            // FIXME: here the object needs to be a transformation already.
-            Transformation *t = dynamic_cast<Transformation *>(a.get());
-            executeTransformation(t, &value, trans, &ret, &path,
-                &transformations);
+            // Only transformations are of this kind.
+            chain->push_back(static_cast<Transformation *>(a.get()));
         }
     }
 
-    for (Transformation *a : m_transformations) {
-        if (none == 0) {
-            Transformation *t = dynamic_cast<Transformation *>(a);
-            executeTransformation(t, &value, trans, &ret, &path,
-                &transformations);
-        }
-        if (a->m_isNone) {
-            none--;
-        }
-    }
+    chain->insert(chain->end(), m_transformationsChain.begin(),
+        m_transformationsChain.end());
 
     // FIXME: It can't be something different from transformation. Sort this
     //        on rules compile time.
-    for (auto &b :
-        trans->m_rules->m_exceptions.m_action_pre_update_target_by_id) {
+    for (auto &b : rules->m_exceptions.m_action_pre_update_target_by_id) {
         if (m_ruleId != b.first) {
             continue;
         }
@@ -412,21 +551,81 @@ void RuleWithActions::executeTransformations(
         }
     }
 
-    for (auto &b :
-        trans->m_rules->m_exceptions.m_action_pre_update_target_by_id) {
+    for (auto &b : rules->m_exceptions.m_action_pre_update_target_by_id) {
         if (m_ruleId != b.first) {
             continue;
         }
         Transformation *a = dynamic_cast<Transformation*>(b.second.get());
         if (none == 0) {
-            Transformation *t = dynamic_cast<Transformation *>(a);
-            executeTransformation(t, &value, trans, &ret, &path,
-                &transformations);
+            chain->push_back(a);
         }
         if (a->m_isNone) {
             none--;
         }
     }
+}
+
+
+/*
+ * Whatever the origin of the transformations, the chain is identified by
+ * the names of the ones that are going to be executed, in order. The
+ * multiMatch flag is part of the key as it changes the results.
+ */
+std::string RuleWithActions::getTransformationsKey(
+    const std::vector<Transformation *> &chain) const {
+    std::string key;
+
+    key.push_back(m_containsMultiMatchAction ? 'm' : 's');
+    for (Transformation *a : chain) {
+        key.push_back(',');
+        key.append(*a->m_name.get());
+    }
+    return key;
+}
+
+
+void RuleWithActions::executeTransformations(
+    Transaction *trans, const std::string &in, TransformationResults &ret,
+    bool cached) {
+    int transformations = 0;
+    std::string path("");
+    /*
+     * The transformations are applied in place over a per thread buffer;
+     * its capacity is kept from one call to the next, so a chain that is
+     * able to work in place does not allocate once the buffer is grown.
+     */
+    static thread_local std::string value;
+    static thread_local std::vector<Transformation *> chain;
+    static thread_local std::vector<size_t> seen;
+    std::string chainKey;
+
+    chain.clear();
+    getTransformationsChain(trans->m_rules, &chain);
+
+    if (cached && trans->m_transformationCache) {
+        chainKey = getTransformationsKey(chain);
+        if (trans->m_transformationCache->find(chainKey, in, &ret)) {
+            ms_dbg_a(trans, 9, " T (cached) " + chainKey.substr(1) + \
+                ": \"" + utils::string::limitTo(80, *ret.back().first) + \
+                "\"");
+            return;
+        }
+    }
+
+    value.assign(in);
+
+    if (m_containsMultiMatchAction == true) {
+        /* keep the original value */
+        seen.clear();
+        isNewValue(ret, &seen, value);
+        ret.push_back(std::make_pair(
+            std::make_shared<std::string>(value), noPath()));
+    }
+
+    for (Transformation *a : chain) {
+        executeTransformation(a, &value, trans, &ret, &path,
+            &transformations, &seen);
+    }
 
     if (m_containsMultiMatchAction == true) {
         ms_dbg_a(trans, 9, "multiMatch is enabled. " \
@@ -436,8 +635,12 @@ void RuleWithActions::executeTransformations(
 
     if (!m_containsMultiMatchAction) {
         ret.push_back(std::make_pair(
-            std::shared_ptr<std::string>(new std::string(*value)),
-            std::shared_ptr<std::string>(new std::string(path))));
+            std::make_shared<std::string>(value),
+            std::make_shared<std::string>(path)));
+    }
+
+    if (cached && trans->m_transformationCache) {
+        trans->m_transformationCache->insert(chainKey, in, ret);
     }
 }
 
@@ -457,6 +660,127 @@ bool RuleWithActions::containsMsg(const std::string& name, Transaction *t) {
 }
 
 
+/**
+ * Variants of containsTag and containsMsg for a tag (or msg) that was
+ * interned as id. Unless the rule uses macros in its tags (or msg) nothing
+ * is expanded nor compared, name is only used as a fallback.
+ *
+ */
+bool RuleWithActions::containsTag(int id, const std::string& name,
+    Transaction *t) {
+    if (m_tagsContainMacro) {
+        return containsTag(name, t);
+    }
+    return id >= 0 && id < static_cast<int>(m_tagIds.size()) && m_tagIds[id];
+}
+
+
+bool RuleWithActions::containsMsg(int id, const std::string& name,
+    Transaction *t) {
+    if (m_msg == nullptr) {
+        return false;
+    }
+    if (m_msgId < 0) {
+        return containsMsg(name, t);
+    }
+    return m_msgId == id;
+}
+
+
+bool RuleWithActions::msgContainsMacro() const {
+    return m_msg && m_msg->m_string && m_msg->m_string->containsMacro();
+}
+
+
+bool RuleWithActions::tagsContainMacro() const {
+    for (auto &tag : m_actionsTag) {
+        if (tag != NULL && tag->containsMacro()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/*
+ * Whether the values are transformed before the operator sees them, by
+ * the rule itself or by the SecDefaultAction of its phase. Transformations
+ * added by SecRuleUpdateActionById are not taken into account.
+ */
+bool RuleWithActions::hasTransformations(const RulesSet *rules) const {
+    if (m_transformationsChain.empty() == false) {
+        return true;
+    }
+    if (m_containsNoneTransformation) {
+        return false;
+    }
+    for (auto &a : rules->m_defaultActions[getPhase()]) {
+        if (a->action_kind == actions::Action::RunTimeBeforeMatchAttemptKind) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+bool RuleWithActions::hasVerdictCacheableActions(unsigned int *inputs) const {
+    if (m_containsNoVerdictCacheAction) {
+        return false;
+    }
+    if (!Utils::VerdictCache::cacheable(m_disruptiveAction, inputs)) {
+        return false;
+    }
+    for (const actions::Action *a : m_actionsRuntimePos) {
+        if (!Utils::VerdictCache::cacheable(a, inputs)) {
+            return false;
+        }
+    }
+    for (const actions::SetVar *a : m_actionsSetVar) {
+        if (!Utils::VerdictCache::cacheable(a, inputs)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+size_t RuleWithActions::memoryUsage() const {
+    size_t actions = m_actionsRuntimePos.size() + m_actionsSetVar.size()
+        + m_actionsTag.size() + m_transformations.size()
+        + m_fusedTransformations.size();
+    size_t bytes = sizeof(*this) + m_rev.size() + m_ver.size()
+        + actions * sizeof(actions::Action);
+
+    for (const actions::Action *a : {m_disruptiveAction,
+        static_cast<actions::Action *>(m_logData),
+        static_cast<actions::Action *>(m_msg),
+        static_cast<actions::Action *>(m_severity)}) {
+        if (a != nullptr) {
+            bytes += sizeof(actions::Action);
+        }
+    }
+    if (m_chainedRuleChild != nullptr) {
+        bytes += m_chainedRuleChild->memoryUsage();
+    }
+    return bytes;
+}
+
+
+bool RuleWithActions::hasPersistentCollectionActions() const {
+    for (const actions::Action *a : m_actionsRuntimePos) {
+        if (a->m_name && utils::string::tolower(*a->m_name) == "initcol") {
+            return true;
+        }
+    }
+    for (const actions::SetVar *a : m_actionsSetVar) {
+        if (a->getVariable() != nullptr && a->getVariable()->isPersistent()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
 std::vector<actions::Action *> RuleWithActions::getActionsByName(const std::string& name,
     Transaction *trans) {
     std::vector<actions::Action *> ret;
@@ -503,8 +827,8 @@ void RuleWithActions::performLogging(Transaction *trans,
 
     /**
     *
-    * RuleMessage is stacked allocated for the rule execution,
-    * anything beyond this may lead to invalid pointer access.
+    * RuleMessage is handed to the next rule once this one is done
+    * (see Transaction::m_ruleMessage), nothing may keep pointing to it.
     *
     * In case of a warning, o set of messages is saved to be read
     * at audit log generation. Therefore demands a copy here.
@@ -24,14 +24,24 @@
 #include <list>
 #include <utility>
 #include <memory>
+#include <vector>
 
 #include "modsecurity/rules_set.h"
 #include "src/operators/operator.h"
+#include "src/operators/rx.h"
 #include "modsecurity/actions/action.h"
 #include "modsecurity/modsecurity.h"
 #include "src/actions/transformations/none.h"
 #include "src/actions/tag.h"
 #include "src/utils/string.h"
+#include "src/utils/regex.h"
+#include "src/utils/regex_lint.h"
+#include "src/utils/rule_profiler.h"
+#include "src/utils/system.h"
+#include "src/utils/trace.h"
+#include "src/utils/verdict_cache.h"
+#include "src/native_rules.h"
+#include "src/rule_prefetch.h"
 #include "modsecurity/rule_message.h"
 #include "src/actions/msg.h"
 #include "src/actions/log_data.h"
@@ -41,6 +51,7 @@
 #include "src/actions/set_var.h"
 #include "src/actions/block.h"
 #include "src/variables/variable.h"
+#include "src/variables/request_body.h"
 
 
 namespace modsecurity {
@@ -132,35 +143,40 @@ bool RuleWithOperator::executeOperatorAt(Transaction *trans, const std::string &
 
 void RuleWithOperator::getVariablesExceptions(Transaction *t,
     variables::Variables *exclusion, variables::Variables *addition) {
-    for (auto &a : t->m_rules->m_exceptions.m_variable_update_target_by_tag) {
-        if (containsTag(*a.first.get(), t) == false) {
+    getVariablesExceptions(&t->m_rules->m_exceptions, t, exclusion, addition);
+}
+
+
+/*
+ * t may be nullptr when called ahead of time (see RulesSet::compile), which
+ * is only done if hasStaticFinalVars() holds.
+ */
+void RuleWithOperator::getVariablesExceptions(RulesExceptions *exceptions,
+    Transaction *t, variables::Variables *exclusion,
+    variables::Variables *addition) {
+    for (auto &a : exceptions->m_update_target_by_tag) {
+        if (containsTag(a.m_id, *a.m_name, t) == false) {
             continue;
         }
-        Variable *b = a.second.get();
-        if (dynamic_cast<variables::VariableModificatorExclusion*>(b)) {
-            exclusion->push_back(
-                dynamic_cast<variables::VariableModificatorExclusion*>(
-                    b)->m_base.get());
+        if (a.m_exclusion) {
+            exclusion->push_back(a.m_exclusion);
         } else {
-            addition->push_back(b);
+            addition->push_back(a.m_variable.get());
         }
     }
 
-    for (auto &a : t->m_rules->m_exceptions.m_variable_update_target_by_msg) {
-        if (containsMsg(*a.first.get(), t) == false) {
+    for (auto &a : exceptions->m_update_target_by_msg) {
+        if (containsMsg(a.m_id, *a.m_name, t) == false) {
             continue;
         }
-        Variable *b = a.second.get();
-        if (dynamic_cast<variables::VariableModificatorExclusion*>(b)) {
-            exclusion->push_back(
-                dynamic_cast<variables::VariableModificatorExclusion*>(
-                    b)->m_base.get());
+        if (a.m_exclusion) {
+            exclusion->push_back(a.m_exclusion);
         } else {
-            addition->push_back(b);
+            addition->push_back(a.m_variable.get());
         }
     }
 
-    for (auto &a : t->m_rules->m_exceptions.m_variable_update_target_by_id) {
+    for (auto &a : exceptions->m_variable_update_target_by_id) {
         if (m_ruleId != a.first) {
             continue;
         }
@@ -176,33 +192,303 @@ void RuleWithOperator::getVariablesExceptions(Transaction *t,
 }
 
 
-inline void RuleWithOperator::getFinalVars(variables::Variables *vars,
-    variables::Variables *exclusion, Transaction *trans) {
+namespace {
+
+bool isTargetRemoved(const std::vector<const std::string *> &removedTargets,
+    const std::string &target) {
+    for (const std::string *t : removedTargets) {
+        if (*t == target) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/*
+ * Request and response data: set before the phase that reads them and left
+ * alone by the actions, unlike TX, the persistent collections, MATCHED_VAR
+ * and the like.
+ */
+const char *readOnlyTargets[] = {
+    "ARGS", "ARGS_COMBINED_SIZE", "ARGS_GET", "ARGS_GET_NAMES", "ARGS_NAMES",
+    "ARGS_POST", "ARGS_POST_NAMES", "FILES", "FILES_COMBINED_SIZE",
+    "FILES_NAMES", "FILES_SIZES", "FULL_REQUEST", "FULL_REQUEST_LENGTH",
+    "PATH_INFO", "QUERY_STRING", "REQUEST_BASENAME", "REQUEST_BODY",
+    "REQUEST_BODY_LENGTH", "REQUEST_COOKIES", "REQUEST_COOKIES_NAMES",
+    "REQUEST_FILENAME", "REQUEST_HEADERS", "REQUEST_HEADERS_NAMES",
+    "REQUEST_LINE", "REQUEST_METHOD", "REQUEST_PROTOCOL", "REQUEST_URI",
+    "REQUEST_URI_RAW", "RESPONSE_BODY", "RESPONSE_CONTENT_LENGTH",
+    "RESPONSE_CONTENT_TYPE", "RESPONSE_HEADERS", "RESPONSE_HEADERS_NAMES",
+    "RESPONSE_PROTOCOL", "RESPONSE_STATUS", "XML", NULL
+};
+
+
+bool isReadOnlyTarget(const Variable *var) {
+    std::string name = utils::string::toupper(var->m_collectionName);
+    for (int i = 0; readOnlyTargets[i] != NULL; i++) {
+        if (name == readOnlyTargets[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/*
+ * Operators by what a single evaluation costs them (see getCostClass):
+ * the cheap comparisons, then matchers with a precompiled automaton and
+ * the parsers, then those that go out of the process. Anything else
+ * (@rx included, it depends on its expression) counts as medium.
+ */
+const char *cheapOperators[] = {
+    "beginswith", "contains", "containsword", "endswith", "eq", "ge", "gt",
+    "ipmatch", "ipmatchf", "ipmatchfromfile", "le", "lt", "nomatch",
+    "streq", "strmatch", "unconditionalmatch", "validatebyterange",
+    "validateurlencoding", "validateutf8encoding", "within", NULL
+};
+
+const char *expensiveOperators[] = {
+    "fuzzyhash", "rxglobal", "validatedtd", "validateschema", NULL
+};
+
+const char *externalOperators[] = {
+    "geolookup", "gsblookup", "inspectfile", "rbl", NULL
+};
+
+/* Targets that are a whole body, or a walk over its tree. */
+const char *bodyTargets[] = {
+    "FULL_REQUEST", "REQUEST_BODY", "RESPONSE_BODY", "XML", NULL
+};
+
+/* Transformations that give the same result when applied again. */
+const char *idempotentTransformations[] = {
+    "cmdline", "compresswhitespace", "lowercase", "normalisepath",
+    "normalisepathwin", "normalizepath", "normalizepathwin",
+    "removecomments", "removecommentschar", "removenulls",
+    "removewhitespace", "replacecomments", "replacenulls", "trim",
+    "trimleft", "trimright", "uppercase", NULL
+};
+
+
+bool listed(const char **list, const std::string &name) {
+    for (int i = 0; list[i] != NULL; i++) {
+        if (name == list[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/* t:lowerCase -> lowercase */
+std::string transformationName(const actions::Action *t) {
+    std::string name(*t->m_name);
+    if (name.compare(0, 2, "t:") == 0) {
+        name.erase(0, 2);
+    }
+    return utils::string::tolower(name);
+}
+
+
+/*
+ * The transformations that are given a chance to do their job twice, or
+ * whose work is thrown away by one further down the chain.
+ */
+void transformationHints(const std::vector<std::string> &chain,
+    bool caseless, std::vector<std::string> *hints) {
+    for (size_t i = 0; i < chain.size(); i++) {
+        const std::string &t = chain[i];
+        bool overridden = false;
+
+        for (size_t j = i + 1; j < chain.size() && !overridden; j++) {
+            if (chain[j] == t && listed(idempotentTransformations, t)) {
+                hints->push_back("t:" + t + " is applied again later on");
+                overridden = true;
+            } else if ((t == "lowercase" && chain[j] == "uppercase")
+                || (t == "uppercase" && chain[j] == "lowercase")) {
+                hints->push_back("t:" + t + " is undone by t:" + chain[j]);
+                overridden = true;
+            } else if ((t == "trim" || t == "trimleft" || t == "trimright"
+                || t == "compresswhitespace")
+                && chain[j] == "removewhitespace") {
+                hints->push_back("t:" + t + " is redundant with a later "
+                    "t:removewhitespace");
+                overridden = true;
+            } else if (t == "lowercase" && chain[j] == "cmdline") {
+                hints->push_back("t:lowercase is redundant, t:cmdline "
+                    "lowercases too");
+                overridden = true;
+            }
+        }
+
+        if (!overridden && caseless
+            && (t == "lowercase" || t == "uppercase")) {
+            hints->push_back("t:" + t + " is redundant, the operator "
+                "ignores case");
+        }
+    }
+}
+
+}  // namespace
+
+
+bool RuleWithOperator::isParallelSafe(const RulesSet *rules) const {
+    if (m_operator == nullptr || m_operator->parallelSafe() == false
+        || hasCaptureAction()
+        || (m_operator->m_string && m_operator->m_string->containsMacro())) {
+        return false;
+    }
+
+    const RulesSet::RuleTargets *targets = rules->getRuleTargets(this);
+    if (targets == nullptr) {
+        return false;
+    }
+    for (const Variable *var : *targets->m_variables) {
+        if (var != nullptr && isReadOnlyTarget(var) == false) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+bool RuleWithOperator::isVerdictCacheable(const RulesSet *rules,
+    unsigned int *inputs) const {
+    if (m_operator == nullptr || hasVerdictCacheableActions(inputs) == false
+        || Utils::VerdictCache::cacheable(m_operator->m_string.get(),
+            inputs) == false) {
+        return false;
+    }
+    std::string op = utils::string::tolower(m_operator->m_op);
+    if (op == "gsblookup" || op == "inspectfile" || op == "rbl") {
+        return false;
+    }
+
+    const RulesSet::RuleTargets *targets = rules->getRuleTargets(this);
+    if (targets == nullptr) {
+        return false;
+    }
+    for (const Variable *var : *targets->m_variables) {
+        if (var != nullptr
+            && Utils::VerdictCache::cacheable(var, inputs) == false) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+size_t RuleWithOperator::memoryUsage() const {
+    size_t bytes = RuleWithActions::memoryUsage()
+        - sizeof(RuleWithActions) + sizeof(*this);
+
+    if (m_operator != nullptr) {
+        bytes += m_operator->memoryUsage();
+    }
+    if (m_variables != nullptr) {
+        for (const Variable *var : *m_variables) {
+            if (var != nullptr) {
+                bytes += sizeof(Variable) + var->m_name.size();
+            }
+        }
+    }
+    return bytes;
+}
+
+
+bool RuleWithOperator::mayBlock(const RulesSet *rules, bool redis) const {
+    if (m_operator != nullptr && listed(externalOperators,
+        utils::string::tolower(m_operator->m_op))) {
+        return true;
+    }
+    if (redis == false) {
+        return false;
+    }
+    if (hasPersistentCollectionActions()) {
+        return true;
+    }
+
+    const RulesSet::RuleTargets *targets = rules->getRuleTargets(this);
+    for (const Variable *var : targets ? *targets->m_variables
+        : *m_variables) {
+        if (var != nullptr && var->isPersistent()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+bool RuleWithOperator::hasReadOnlyOperator() const {
+    return m_operator != nullptr && m_operator->parallelSafe();
+}
+
+
+bool RuleWithOperator::hasTarget(const std::string &name) const {
+    for (const variables::Variable *v : *m_variables) {
+        if (v->m_fullName != nullptr
+            && utils::string::toupper(*v->m_fullName) == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+const Utils::Regex *RuleWithOperator::requestBodyRegex(
+    const RulesSet *rules) const {
+    const operators::Rx *rx = dynamic_cast<const operators::Rx *>(
+        m_operator);
+    if (rx == nullptr || rx->regex() == nullptr
+        || rx->regex()->hasError()
+        || rx->regex()->pattern.find("\\G") != std::string::npos
+        || hasTransformations(rules)) {
+        return nullptr;
+    }
+
+    const RulesSet::RuleTargets *targets = rules->getRuleTargets(this);
+    if (targets == nullptr || targets->m_variables->size() != 1
+        || targets->m_exclusion->size() != 0
+        || dynamic_cast<const variables::RequestBody *>(
+            targets->m_variables->at(0)) == nullptr) {
+        return nullptr;
+    }
+
+    return rx->regex();
+}
+
+/*
+ * Targets removed from this very rule by ctl:ruleRemoveTargetById and
+ * ctl:ruleRemoveTargetByTag, gathered once per evaluation instead of for
+ * every variable (and value) the rule inspects.
+ */
+void RuleWithOperator::getTargetsRemovedAtRunTime(Transaction *trans,
+    std::vector<const std::string *> *targets) {
+    auto range = trans->m_ruleRemoveTargetById.equal_range(m_ruleId);
+    for (auto it = range.first; it != range.second; ++it) {
+        targets->push_back(&it->second);
+    }
+
+    for (auto &m : trans->m_ruleRemoveTargetByTag) {
+        if (containsTag(m.first, trans)) {
+            targets->push_back(&m.second);
+        }
+    }
+}
+
+
+void RuleWithOperator::getFinalVars(RulesExceptions *exceptions,
+    variables::Variables *vars, variables::Variables *exclusion,
+    Transaction *trans) {
     variables::Variables addition;
-    getVariablesExceptions(trans, exclusion, &addition);
+    getVariablesExceptions(exceptions, trans, exclusion, &addition);
 
     for (int i = 0; i < m_variables->size(); i++) {
         Variable *variable = m_variables->at(i);
         if (exclusion->contains(variable)) {
             continue;
         }
-        if (std::find_if(trans->m_ruleRemoveTargetById.begin(),
-                trans->m_ruleRemoveTargetById.end(),
-                [&, variable, this](std::pair<int, std::string> &m) -> bool {
-                    return m.first == m_ruleId
-                        && m.second == *variable->m_fullName.get();
-                }) != trans->m_ruleRemoveTargetById.end()) {
-            continue;
-        }
-        if (std::find_if(trans->m_ruleRemoveTargetByTag.begin(),
-                    trans->m_ruleRemoveTargetByTag.end(),
-                    [&, variable, trans, this](
-                        std::pair<std::string, std::string> &m) -> bool {
-                        return containsTag(m.first, trans)
-                            && m.second == *variable->m_fullName.get();
-                    }) != trans->m_ruleRemoveTargetByTag.end()) {
-            continue;
-        }
         vars->push_back(variable);
     }
 
@@ -213,6 +499,363 @@ inline void RuleWithOperator::getFinalVars(variables::Variables *vars,
 }
 
 
+/**
+ * Tells if the exceptions can be applied to this rule without a
+ * transaction: the tags and msg they refer to must not contain macros.
+ *
+ */
+bool RuleWithOperator::hasStaticFinalVars(
+    const RulesExceptions &exceptions) const {
+    if (exceptions.m_update_target_by_tag.empty() == false
+        && tagsContainMacro()) {
+        return false;
+    }
+    if (exceptions.m_update_target_by_msg.empty() == false
+        && msgContainsMacro()) {
+        return false;
+    }
+    return true;
+}
+
+
+/**
+ * Targets of this rule within rules, as resolved by RulesSet::compile;
+ * the excluded ones are prefixed with '!'. Meant for diagnostics, e.g.
+ * modsec-rules-check -t.
+ *
+ */
+std::string RuleWithOperator::getEffectiveTargets(const RulesSet *rules) {
+    const RulesSet::RuleTargets *targets = rules->getRuleTargets(this);
+    if (targets == nullptr) {
+        return std::string("") + m_variables
+            + " (tag or msg exceptions resolved at run time)";
+    }
+
+    std::string ret = std::string("") + targets->m_variables;
+    for (Variable *e : *targets->m_exclusion) {
+        if (ret.empty() == false) {
+            ret.append("|");
+        }
+        ret.append("!" + *e->m_fullName.get());
+    }
+    return ret;
+}
+
+
+/*
+ * Keeps in a RulePrefetch what matching a value found, as evaluate()
+ * takes it afterwards. The operator reference goes to the scratch message
+ * and is moved into the value.
+ */
+class PrefetchValue {
+ public:
+    PrefetchValue(RulePrefetch *out, RuleMessage *scratch)
+        : m_out(out),
+        m_scratch(scratch) { }
+
+    void operator()(const VariableValue *v, const std::string &key,
+        const std::string &value, const std::string &transformed,
+        const std::string &path, bool matched, size_t reference) {
+        if (matched == false
+            && m_scratch->m_reference.size() == reference) {
+            return;
+        }
+        m_out->m_values.emplace_back();
+        RulePrefetch::Value &p = m_out->m_values.back();
+        p.m_operatorReference = m_scratch->m_reference.substr(reference);
+        m_scratch->m_reference.resize(reference);
+        p.m_matched = matched;
+        if (matched == false) {
+            return;
+        }
+        p.m_key = key;
+        p.m_value = value;
+        p.m_transformed = transformed;
+        for (const VariableOrigin &i : v->getOrigin()) {
+            p.m_reference.append(i.toText());
+        }
+        p.m_reference.append(path);
+    }
+
+ private:
+    RulePrefetch *m_out;
+    RuleMessage *m_scratch;
+};
+
+
+/**
+ * Runs every target of the rule, after the transformations, through the
+ * operator and hands each outcome to onValue, in order: the variable
+ * value, its key, the value before and after the transformations, the
+ * transformation path, whether the operator matched and how long the
+ * message reference was before the operator call (operators append the
+ * match offsets to it).
+ *
+ * Only reads the transaction, apart from what the operator itself does,
+ * so it can run off the transaction thread (see prefetch()); cached tells
+ * whether the transformation cache of the transaction may be used.
+ */
+template <typename OnValue>
+void RuleWithOperator::matchValues(Transaction *trans,
+    std::shared_ptr<RuleMessage> ruleMessage, OnValue onValue,
+    uint64_t *transformationNs, uint64_t *operatorNs, size_t *values,
+    bool cached) {
+    variables::Variables vars;
+    variables::Variables exclusion;
+    variables::Variables *finalVars = &vars;
+    variables::Variables *finalExclusion = &exclusion;
+    std::vector<const std::string *> removedTargets;
+    bool tracing = Utils::Trace::enabled(trans);
+
+    getTargetsRemovedAtRunTime(trans, &removedTargets);
+
+    const RulesSet::RuleTargets *targets = trans->m_rules->getRuleTargets(this);
+    if (targets) {
+        finalVars = targets->m_variables;
+        finalExclusion = targets->m_exclusion;
+    } else {
+        vars.reserve(4);
+        getFinalVars(&trans->m_rules->m_exceptions, &vars, &exclusion, trans);
+    }
+
+    for (auto &var : *finalVars) {
+        std::vector<const VariableValue *> e;
+        if (!var) {
+            continue;
+        }
+        if (removedTargets.empty() == false
+            && isTargetRemoved(removedTargets, *var->m_fullName.get())) {
+            continue;
+        }
+        uint64_t started = tracing ? utils::monotonic_ns() : 0;
+        bool borrowed = var->evaluateBorrowed(trans, this, &e);
+        if (borrowed == false) {
+            var->evaluate(trans, this, &e);
+        }
+        if (tracing) {
+            uint64_t spent = utils::monotonic_ns() - started;
+            if (Utils::Trace::slow(trans, spent)) {
+                Utils::Trace::span(trans, "variable", started, spent,
+                    m_ruleId, var->m_fullName.get());
+            }
+        }
+        for (const VariableValue *v : e) {
+            const std::string &key = v->getKeyWithCollection();
+
+            if (finalExclusion->contains(v) == false
+                && (removedTargets.empty()
+                    || isTargetRemoved(removedTargets, key) == false)) {
+                matchValue(trans, ruleMessage, v, onValue, transformationNs,
+                    operatorNs, values, cached);
+            }
+            if (borrowed == false) {
+                delete v;
+            }
+            v = NULL;
+        }
+        e.clear();
+        e.reserve(4);
+    }
+}
+
+
+/*
+ * The part of matchValues() for one value the exclusions left in.
+ */
+template <typename OnValue>
+void RuleWithOperator::matchValue(Transaction *trans,
+    std::shared_ptr<RuleMessage> ruleMessage, const VariableValue *v,
+    OnValue onValue, uint64_t *transformationNs, uint64_t *operatorNs,
+    size_t *values, bool cached) {
+    const std::string &value = v->getValue();
+    const std::string &key = v->getKeyWithCollection();
+    bool profile = trans->m_ruleProfile != nullptr;
+    bool tracing = Utils::Trace::enabled(trans);
+    uint64_t started = 0;
+    TransformationResults results;
+
+    /*
+     * A SecRuleNativeModule does the transformations and the operator in
+     * one call, so the profile has it all as operator time, and the
+     * transformation cache is left alone. The debug log at level 9 wants
+     * every step: it goes the interpreted way.
+     */
+    const NativeMatch *native = trans->m_rules->nativeMatch(this);
+    if (native != nullptr && ms_dbg_a_enabled(trans, 9) == false) {
+        std::string transformed;
+        size_t reference = ruleMessage->m_reference.size();
+
+        (*values)++;
+        if (profile || tracing) {
+            started = Utils::RuleProfiler::now();
+        }
+        bool ret = native->m_match(trans, this, m_operator,
+            native->m_chain.data(), value, &transformed, ruleMessage);
+        if (profile || tracing) {
+            uint64_t spent = Utils::RuleProfiler::now() - started;
+            *operatorNs += spent;
+            if (tracing && Utils::Trace::slow(trans, spent)) {
+                std::string op("@" + getOperatorName());
+                Utils::Trace::span(trans, "operator", started, spent,
+                    m_ruleId, &op);
+            }
+        }
+
+        onValue(v, key, value, native->m_chain.empty() ? value : transformed,
+            native->m_path, ret, reference);
+        return;
+    }
+
+    if (profile) {
+        started = Utils::RuleProfiler::now();
+    }
+    executeTransformations(trans, value, results, cached);
+    if (profile) {
+        *transformationNs += Utils::RuleProfiler::now() - started;
+    }
+
+    for (const auto &valueTemp : results) {
+        bool ret;
+        const std::string &valueAfterTrans = *valueTemp.first;
+        size_t reference = ruleMessage->m_reference.size();
+
+        (*values)++;
+        if (profile || tracing) {
+            started = Utils::RuleProfiler::now();
+        }
+        ret = executeOperatorAt(trans, key, valueAfterTrans, ruleMessage);
+        if (profile || tracing) {
+            uint64_t spent = Utils::RuleProfiler::now() - started;
+            *operatorNs += spent;
+            if (tracing && Utils::Trace::slow(trans, spent)) {
+                std::string op("@" + getOperatorName());
+                Utils::Trace::span(trans, "operator", started, spent,
+                    m_ruleId, &op);
+            }
+        }
+
+        onValue(v, key, value, valueAfterTrans, *valueTemp.second,
+            ret, reference);
+    }
+}
+
+
+/**
+ * Does the matching part of evaluate() ahead of time, on whatever thread
+ * the rule set pool lends, and keeps the outcome in out. Only called for
+ * the rules isParallelSafe() accepts, so the transaction is not written.
+ *
+ */
+void RuleWithOperator::prefetch(Transaction *trans, RulePrefetch *out) {
+    std::shared_ptr<RuleMessage> scratch = std::make_shared<RuleMessage>(
+        this, trans);
+
+    matchValues(trans, scratch, PrefetchValue(out, scratch.get()),
+        &out->m_transformationNs, &out->m_operatorNs, &out->m_evaluated,
+        false);
+}
+
+
+/**
+ * prefetch() for a run of rules with the same targets (see
+ * hasSameTargets), value by value instead of rule by rule: the targets
+ * are resolved once and every value goes through all of the rules, one
+ * after the other, while it is still in the cache. out[i] is for
+ * rules[i]. On the transaction thread, so the transformation cache is
+ * used.
+ *
+ */
+void RuleWithOperator::prefetchValueMajor(
+    const std::vector<RuleWithOperator *> &rules, Transaction *trans,
+    const std::vector<RulePrefetch *> &out) {
+    const RulesSet::RuleTargets *targets =
+        trans->m_rules->getRuleTargets(rules.front());
+    std::vector<std::shared_ptr<RuleMessage>> scratch;
+    std::vector<std::vector<const std::string *>> removedTargets(
+        rules.size());
+
+    for (size_t i = 0; i < rules.size(); i++) {
+        scratch.push_back(std::make_shared<RuleMessage>(rules[i], trans));
+        rules[i]->getTargetsRemovedAtRunTime(trans, &removedTargets[i]);
+    }
+
+    for (auto &var : *targets->m_variables) {
+        std::vector<const VariableValue *> e;
+        if (!var) {
+            continue;
+        }
+        bool borrowed = var->evaluateBorrowed(trans, rules.front(), &e);
+        if (borrowed == false) {
+            var->evaluate(trans, rules.front(), &e);
+        }
+        for (const VariableValue *v : e) {
+            const std::string &key = v->getKeyWithCollection();
+            if (targets->m_exclusion->contains(v) == false) {
+                for (size_t i = 0; i < rules.size(); i++) {
+                    if (removedTargets[i].empty() == false
+                        && (isTargetRemoved(removedTargets[i],
+                            *var->m_fullName)
+                        || isTargetRemoved(removedTargets[i], key))) {
+                        continue;
+                    }
+                    rules[i]->matchValue(trans, scratch[i], v,
+                        PrefetchValue(out[i], scratch[i].get()),
+                        &out[i]->m_transformationNs,
+                        &out[i]->m_operatorNs, &out[i]->m_evaluated, true);
+                }
+            }
+            if (borrowed == false) {
+                delete v;
+            }
+        }
+    }
+}
+
+
+/*
+ * Same targets, once the exceptions of the set are applied, and no
+ * !COLLECTION:key on any of them (those are resolved per variable).
+ */
+bool RuleWithOperator::hasSameTargets(const RuleWithOperator *other,
+    const RulesSet *rules) const {
+    const RulesSet::RuleTargets *a = rules->getRuleTargets(this);
+    const RulesSet::RuleTargets *b = rules->getRuleTargets(other);
+    if (a == nullptr || b == nullptr
+        || a->m_variables->size() != b->m_variables->size()
+        || a->m_exclusion->size() != b->m_exclusion->size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a->m_variables->size(); i++) {
+        Variable *x = a->m_variables->at(i);
+        Variable *y = b->m_variables->at(i);
+        if (x == nullptr || y == nullptr || !(*x == *y)
+            || x->m_keyExclusion.empty() == false
+            || y->m_keyExclusion.empty() == false) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < a->m_exclusion->size(); i++) {
+        if (!(*a->m_exclusion->at(i) == *b->m_exclusion->at(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+void RuleWithOperator::handleMatch(Transaction *trans, const std::string &key,
+    const std::string &value, const std::string &transformed,
+    bool *containsBlock, std::shared_ptr<RuleMessage> ruleMessage) {
+    ruleMessage->m_match = m_operator->resolveMatchMessage(trans,
+        key, value);
+    updateMatchedVars(trans, key, transformed);
+    executeActionsIndependentOfChainedRuleResult(trans,
+        containsBlock, ruleMessage);
+
+    performLogging(trans, ruleMessage, false);
+}
+
+
 bool RuleWithOperator::evaluate(Transaction *trans,
     std::shared_ptr<RuleMessage> ruleMessage) {
     bool globalRet = false;
@@ -220,18 +863,20 @@ bool RuleWithOperator::evaluate(Transaction *trans,
     bool recursiveGlobalRet;
     bool containsBlock = hasBlockAction();
     std::string eparam;
-    variables::Variables vars;
-    vars.reserve(4);
-    variables::Variables exclusion;
+    Utils::RuleProfilerShard *profile = trans->m_ruleProfile;
+    RulePrefetch *prefetched = nullptr;
+    uint64_t transformationNs = 0;
+    uint64_t operatorNs = 0;
+    uint64_t allocations = 0;
+    uint64_t allocatedBytes = 0;
+    size_t values = 0;
 
     RuleWithActions::evaluate(trans, ruleMessage);
 
 
     // FIXME: Make a class runTimeException to handle this cases.
-    for (auto &i : trans->m_ruleRemoveById) {
-        if (m_ruleId != i) {
-            continue;
-        }
+    if (trans->m_ruleRemoveById.empty() == false
+        && trans->m_ruleRemoveById.count(m_ruleId) > 0) {
         ms_dbg_a(trans, 9, "Rule id: " + std::to_string(m_ruleId) +
             " was skipped due to a ruleRemoveById action...");
         return true;
@@ -245,7 +890,11 @@ bool RuleWithOperator::evaluate(Transaction *trans,
         return true;
     }
 
-    if (m_operator->m_string) {
+    /*
+     * The operator expands its own parameter, the one built in here is only
+     * for the debug log: not worth the macro expansion when nobody reads it.
+     */
+    if (ms_dbg_a_enabled(trans, 4) && m_operator->m_string) {
         eparam = m_operator->m_string->evaluate(trans);
 
         if (m_operator->m_string->containsMacro()) {
@@ -267,74 +916,57 @@ bool RuleWithOperator::evaluate(Transaction *trans,
             + variables + ".");
     }
 
+    if (trans->m_rulePrefetches) {
+        prefetched = trans->m_rulePrefetches->find(this);
+    }
 
-    getFinalVars(&vars, &exclusion, trans);
-
-    for (auto &var : vars) {
-        std::vector<const VariableValue *> e;
-        if (!var) {
-            continue;
-        }
-        var->evaluate(trans, this, &e);
-        for (const VariableValue *v : e) {
-            const std::string &value = v->getValue();
-            const std::string &key = v->getKeyWithCollection();
+    if (profile) {
+        Utils::RuleProfiler::allocations(&allocations, &allocatedBytes);
+    }
 
-            if (exclusion.contains(v) ||
-                std::find_if(trans->m_ruleRemoveTargetById.begin(),
-                    trans->m_ruleRemoveTargetById.end(),
-                    [&, v, this](std::pair<int, std::string> &m) -> bool {
-                        return m.first == m_ruleId && m.second == v->getKeyWithCollection();
-                    }) != trans->m_ruleRemoveTargetById.end()
-            ) {
-                delete v;
-                v = NULL;
-                continue;
-            }
-            if (exclusion.contains(v) ||
-                std::find_if(trans->m_ruleRemoveTargetByTag.begin(),
-                    trans->m_ruleRemoveTargetByTag.end(),
-                    [&, v, trans, this](std::pair<std::string, std::string> &m) -> bool {
-                        return containsTag(m.first, trans) && m.second == v->getKeyWithCollection();
-                    }) != trans->m_ruleRemoveTargetByTag.end()
-            ) {
-                delete v;
-                v = NULL;
+    if (prefetched) {
+        /* Matched already, in parallel; only the actions are left. */
+        for (const RulePrefetch::Value &p : prefetched->m_values) {
+            ruleMessage->m_reference.append(p.m_operatorReference);
+            if (p.m_matched == false) {
                 continue;
             }
-
-            TransformationResults values;
-
-            executeTransformations(trans, value, values);
-
-            for (const auto &valueTemp : values) {
-                bool ret;
-                std::string valueAfterTrans = std::move(*valueTemp.first);
-
-                ret = executeOperatorAt(trans, key, valueAfterTrans, ruleMessage);
-
-                if (ret == true) {
-                    ruleMessage->m_match = m_operator->resolveMatchMessage(trans,
-                        key, value);
-                    for (auto &i : v->getOrigin()) {
-                        ruleMessage->m_reference.append(i->toText());
-                    }
-
-                    ruleMessage->m_reference.append(*valueTemp.second);
-                    updateMatchedVars(trans, key, valueAfterTrans);
-                    executeActionsIndependentOfChainedRuleResult(trans,
-                        &containsBlock, ruleMessage);
-
-                    performLogging(trans, ruleMessage, false);
-
-                    globalRet = true;
+            ruleMessage->m_reference.append(p.m_reference);
+            handleMatch(trans, p.m_key, p.m_value, p.m_transformed,
+                &containsBlock, ruleMessage);
+            globalRet = true;
+        }
+        values = prefetched->m_evaluated;
+        transformationNs = prefetched->m_transformationNs;
+        operatorNs = prefetched->m_operatorNs;
+    } else {
+        matchValues(trans, ruleMessage,
+            [&](const VariableValue *v, const std::string &key,
+                const std::string &value, const std::string &transformed,
+                const std::string &path, bool matched, size_t reference) {
+                if (matched == false) {
+                    return;
                 }
-            }
-            delete v;
-            v = NULL;
+                for (const VariableOrigin &i : v->getOrigin()) {
+                    ruleMessage->m_reference.append(i.toText());
+                }
+                ruleMessage->m_reference.append(path);
+                handleMatch(trans, key, value, transformed, &containsBlock,
+                    ruleMessage);
+                globalRet = true;
+            }, &transformationNs, &operatorNs, &values, true);
+    }
+
+    if (profile) {
+        uint64_t a = 0;
+        uint64_t b = 0;
+        if (Utils::RuleProfiler::allocations(&a, &b)) {
+            allocations = a - allocations;
+            allocatedBytes = b - allocatedBytes;
         }
-        e.clear();
-        e.reserve(4);
+        trans->m_ruleProfiler->record(profile, this, values,
+            globalRet, transformationNs, operatorNs, allocations,
+            allocatedBytes);
     }
 
     if (globalRet == false) {
@@ -377,4 +1009,112 @@ end_exec:
 std::string RuleWithOperator::getOperatorName() const { return m_operator->m_op; }
 
 
+std::string RuleWithOperator::getOperatorBackend() const {
+    return m_operator->backend();
+}
+
+
+std::vector<std::string> RuleWithOperator::getPerformanceHints() const {
+    std::vector<std::string> hints;
+    std::string op = utils::string::tolower(m_operator->m_op);
+    bool macro = m_operator->m_string && m_operator->m_string->containsMacro();
+    bool caseless = op == "pm" || op == "pmf" || op == "pmfromfile";
+
+    if (op == "rx" || op == "rxglobal") {
+        const Utils::Regex *re = m_operator->regex();
+        if (macro) {
+            hints.push_back("the expression has macros, it is compiled "
+                "for every value");
+        } else if (re != nullptr && re->hasError() == false) {
+            std::string group;
+            std::string suggestion;
+            std::string param;
+            bool ignoresCase;
+
+            if (re->jit() == false) {
+                hints.push_back("the expression is not JIT compiled");
+            }
+#ifdef WITH_RE2
+            if (re->linear() == false) {
+                hints.push_back("RE2 can not run the expression ("
+                    + re->linearError() + "), SecRxRe2 leaves it to PCRE");
+            }
+#endif
+            if (Utils::RegexLint::nestedQuantifier(re->pattern, &group)) {
+                hints.push_back("nested quantifiers in " + group
+                    + " may backtrack catastrophically");
+            }
+            if (op == "rx" && Utils::RegexLint::literalOperator(re->pattern,
+                &suggestion, &param, &ignoresCase)) {
+                hints.push_back("could be " + suggestion + " " + param
+                    + ((suggestion.compare(0, 3, "@pm") == 0 && !ignoresCase)
+                        ? " (which ignores case)" : ""));
+            }
+            caseless = re->pattern.compare(0, 4, "(?i)") == 0;
+        }
+    } else if (macro && (op == "pm" || op == "within" || op == "ipmatch")) {
+        hints.push_back("the parameter has macros, it is parsed again "
+            "for every value");
+    }
+
+    /* Only what follows the last t:none ever runs. */
+    std::vector<std::string> chain;
+    for (const actions::Action *t : getTransformations()) {
+        if (t->m_isNone) {
+            chain.clear();
+        } else {
+            chain.push_back(transformationName(t));
+        }
+    }
+    transformationHints(chain, caseless, &hints);
+
+    return hints;
+}
+
+
+std::string RuleWithOperator::getCostClass(const RulesSet *rules) const {
+    static const char *classes[] = { "low", "medium", "high", "very high" };
+    std::string op = utils::string::tolower(m_operator->m_op);
+    bool macro = m_operator->m_string && m_operator->m_string->containsMacro();
+    int cost = 1;
+
+    if (listed(cheapOperators, op)) {
+        cost = 0;
+    } else if (listed(externalOperators, op)) {
+        cost = 3;
+    } else if (listed(expensiveOperators, op)) {
+        cost = 2;
+    } else if (op == "rx") {
+        const Utils::Regex *re = m_operator->regex();
+        if (macro) {
+            cost = 3;
+        } else if (re != nullptr && re->jit() == false
+            && re->backend().compare(0, 9, "hyperscan") != 0) {
+            cost = 2;
+        }
+    }
+
+    const RulesSet::RuleTargets *targets = rules->getRuleTargets(this);
+    const variables::Variables *vars = targets != nullptr
+        ? targets->m_variables : m_variables;
+    for (const Variable *var : *vars) {
+        if (var != nullptr && listed(bodyTargets,
+            utils::string::toupper(var->m_collectionName))) {
+            cost++;
+            break;
+        }
+    }
+
+    size_t transformations = 0;
+    for (const actions::Action *t : getTransformations()) {
+        transformations = t->m_isNone ? 0 : transformations + 1;
+    }
+    if (transformations > 3) {
+        cost++;
+    }
+
+    return classes[std::min(cost, 3)];
+}
+
+
 }  // namespace modsecurity
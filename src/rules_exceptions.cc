@@ -15,14 +15,32 @@
 
 #include "modsecurity/rules_exceptions.h"
 
+#include <memory>
 #include <string>
+#include <utility>
 
+#include "src/utils/interned_strings.h"
 #include "src/utils/string.h"
 #include "src/variables/variable.h"
 
 namespace modsecurity {
 
 
+RulesExceptions::UpdateTarget::UpdateTarget(int id,
+    std::shared_ptr<std::string> name,
+    std::shared_ptr<variables::Variable> variable)
+    : m_id(id),
+    m_name(std::move(name)),
+    m_variable(std::move(variable)),
+    m_exclusion(nullptr) {
+    auto *e = dynamic_cast<variables::VariableModificatorExclusion *>(
+        m_variable.get());
+    if (e) {
+        m_exclusion = e->m_base.get();
+    }
+}
+
+
 RulesExceptions::RulesExceptions() {
 }
 
@@ -76,12 +94,15 @@ bool RulesExceptions::loadRemoveRuleByTag(const std::string &msg,
 bool RulesExceptions::loadUpdateTargetByMsg(const std::string &msg,
     std::unique_ptr<std::vector<std::unique_ptr<variables::Variable> > > var,
     std::string *error) {
+    std::shared_ptr<std::string> name = std::make_shared<std::string>(msg);
+    int id = Utils::InternedStrings::id(msg);
+
     for (auto &i : *var) {
+        std::shared_ptr<variables::Variable> v(std::move(i));
         m_variable_update_target_by_msg.emplace(
             std::pair<std::shared_ptr<std::string>,
-            std::unique_ptr<variables::Variable>>(
-                std::make_shared<std::string>(msg),
-                std::move(i)));
+            std::shared_ptr<variables::Variable>>(name, v));
+        m_update_target_by_msg.emplace_back(id, name, v);
     }
 
     return true;
@@ -91,13 +112,15 @@ bool RulesExceptions::loadUpdateTargetByMsg(const std::string &msg,
 bool RulesExceptions::loadUpdateTargetByTag(const std::string &tag,
     std::unique_ptr<std::vector<std::unique_ptr<variables::Variable> > > var,
     std::string *error) {
+    std::shared_ptr<std::string> name = std::make_shared<std::string>(tag);
+    int id = Utils::InternedStrings::id(tag);
 
     for (auto &i : *var) {
+        std::shared_ptr<variables::Variable> v(std::move(i));
         m_variable_update_target_by_tag.emplace(
             std::pair<std::shared_ptr<std::string>,
-                std::unique_ptr<variables::Variable>>(
-                    std::make_shared<std::string>(tag),
-                    std::move(i)));
+                std::shared_ptr<variables::Variable>>(name, v));
+        m_update_target_by_tag.emplace_back(id, name, v);
     }
 
     return true;
@@ -205,6 +228,21 @@ bool RulesExceptions::contains(int a) {
 }
 
 
+bool RulesExceptions::removesRules() const {
+    return m_numbers.empty() == false
+        || m_ranges.empty() == false
+        || m_remove_rule_by_msg.empty() == false
+        || m_remove_rule_by_tag.empty() == false;
+}
+
+
+bool RulesExceptions::updatesTargets() const {
+    return m_variable_update_target_by_id.empty() == false
+        || m_update_target_by_tag.empty() == false
+        || m_update_target_by_msg.empty() == false;
+}
+
+
 bool RulesExceptions::merge(RulesExceptions *from) {
     for (int a : from->m_numbers) {
         bool ret = addNumber(a);
@@ -233,6 +271,13 @@ bool RulesExceptions::merge(RulesExceptions *from) {
                 p.second));
     }
 
+    m_update_target_by_tag.insert(m_update_target_by_tag.end(),
+        from->m_update_target_by_tag.begin(),
+        from->m_update_target_by_tag.end());
+    m_update_target_by_msg.insert(m_update_target_by_msg.end(),
+        from->m_update_target_by_msg.begin(),
+        from->m_update_target_by_msg.end());
+
     for (auto &p : from->m_variable_update_target_by_id) {
         m_variable_update_target_by_id.emplace(
             std::pair<double,
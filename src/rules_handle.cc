@@ -0,0 +1,234 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "modsecurity/rules_handle.h"
+
+#include <pthread.h>
+#include <string.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/transaction.h"
+
+
+namespace modsecurity {
+
+
+RulesHandle::RulesHandle(RulesSet *rules)
+    : m_current(rules),
+    m_version(1),
+    m_reloading(false),
+    m_finished(false),
+    m_result(0) {
+    pthread_mutex_init(&m_lock, NULL);
+}
+
+
+RulesHandle::~RulesHandle() {
+    wait(NULL);
+    pthread_mutex_destroy(&m_lock);
+}
+
+
+void RulesHandle::swap(RulesSet *rules) {
+    std::shared_ptr<RulesSet> fresh(rules);
+    std::atomic_store(&m_current, fresh);
+    m_version++;
+}
+
+
+bool RulesHandle::reloadFromUris(const std::vector<std::string> &uris) {
+    pthread_mutex_lock(&m_lock);
+    if (m_reloading) {
+        if (m_finished.load(std::memory_order_acquire) == false) {
+            pthread_mutex_unlock(&m_lock);
+            return false;
+        }
+        pthread_join(m_thread, NULL);
+        m_reloading = false;
+    }
+    m_finished.store(false, std::memory_order_relaxed);
+    m_uris = uris;
+    m_error.clear();
+    m_result = 0;
+    m_reloading = pthread_create(&m_thread, NULL, &RulesHandle::run,
+        this) == 0;
+    bool started = m_reloading;
+    pthread_mutex_unlock(&m_lock);
+
+    return started;
+}
+
+
+int RulesHandle::wait(std::string *error) {
+    pthread_mutex_lock(&m_lock);
+    if (m_reloading) {
+        pthread_join(m_thread, NULL);
+        m_reloading = false;
+    }
+    int result = m_result;
+    if (error != NULL) {
+        *error = m_error;
+    }
+    pthread_mutex_unlock(&m_lock);
+
+    return result;
+}
+
+
+/*
+ * Runs without the lock, which wait() may hold while joining it; m_uris
+ * is not changed while the thread runs, m_result and m_error are only
+ * read once it was joined, or once m_finished is seen set.
+ */
+void *RulesHandle::run(void *data) {
+    RulesHandle *handle = static_cast<RulesHandle *>(data);
+    std::shared_ptr<RulesSet> previous(handle->current());
+    RulesSet *rules = new RulesSet();
+
+    for (const std::string &uri : handle->m_uris) {
+        if (rules->loadFromUri(uri.c_str(), previous.get()) < 0) {
+            handle->m_error = rules->getParserError();
+            handle->m_result = -1;
+            delete rules;
+            handle->m_finished.store(true, std::memory_order_release);
+            return NULL;
+        }
+    }
+
+    handle->swap(rules);
+    handle->m_result = 1;
+    handle->m_finished.store(true, std::memory_order_release);
+    return NULL;
+}
+
+
+Transaction *RulesHandle::newTransaction(ModSecurity *ms, void *logCbData) {
+    std::shared_ptr<RulesSet> rules(current());
+    Transaction *transaction = new Transaction(ms, rules.get(), logCbData);
+    transaction->m_rulesVersion = std::move(rules);
+    return transaction;
+}
+
+
+Transaction *RulesHandle::newTransaction(ModSecurity *ms, char *id,
+    void *logCbData) {
+    std::shared_ptr<RulesSet> rules(current());
+    Transaction *transaction = new Transaction(ms, rules.get(), id,
+        logCbData);
+    transaction->m_rulesVersion = std::move(rules);
+    return transaction;
+}
+
+
+/**
+ * @name    msc_create_rules_handle
+ * @brief   Creates a handle to replace the rules while they are in use.
+ *
+ * The handle takes the ownership of rules and is freed along with msc.
+ *
+ */
+extern "C" RulesHandle *msc_create_rules_handle(ModSecurity *msc,
+    RulesSet *rules) {
+    return msc->createRulesHandle(rules);
+}
+
+
+/**
+ * @name    msc_rules_handle_swap
+ * @brief   Installs rules, already loaded, as the new version.
+ *
+ * The transactions in flight keep the version they started with.
+ *
+ * @return The new version number.
+ *
+ */
+extern "C" unsigned long msc_rules_handle_swap(RulesHandle *handle,
+    RulesSet *rules) {
+    handle->swap(rules);
+    return handle->version();
+}
+
+
+/**
+ * @name    msc_rules_handle_reload_file
+ * @brief   Loads file into a new version, on a thread of its own.
+ *
+ * @return 0 if the reload was started, -1 if one is still running.
+ *
+ */
+extern "C" int msc_rules_handle_reload_file(RulesHandle *handle,
+    const char *file) {
+    return handle->reloadFromUri(file) ? 0 : -1;
+}
+
+
+/**
+ * @name    msc_rules_handle_reload_files
+ * @brief   msc_rules_handle_reload_file() for the files loaded one after
+ *          the other, as msc_rules_add_file() would.
+ *
+ */
+extern "C" int msc_rules_handle_reload_files(RulesHandle *handle,
+    const char **files, size_t count) {
+    return handle->reloadFromUris(std::vector<std::string>(files,
+        files + count)) ? 0 : -1;
+}
+
+
+/**
+ * @name    msc_rules_handle_wait
+ * @brief   Waits for the last reload to be done.
+ *
+ * @return 1 if the new version was installed, 0 if there was no reload,
+ *         -1 if it failed to load.
+ *
+ * @note On failure error, unless it is NULL, is set and has to be freed
+ *       by the caller.
+ *
+ */
+extern "C" int msc_rules_handle_wait(RulesHandle *handle,
+    const char **error) {
+    std::string e;
+    int ret = handle->wait(&e);
+    if (ret < 0 && error != NULL) {
+        *error = strdup(e.c_str());
+    }
+    return ret;
+}
+
+
+extern "C" unsigned long msc_rules_handle_version(RulesHandle *handle) {
+    return handle->version();
+}
+
+
+/**
+ * @name    msc_new_transaction_from_handle
+ * @brief   Creates a transaction on the current version of the rules.
+ *
+ */
+extern "C" Transaction *msc_new_transaction_from_handle(ModSecurity *ms,
+    RulesHandle *handle, void *logCbData) {
+    return handle->newTransaction(ms, logCbData);
+}
+
+
+}  // namespace modsecurity
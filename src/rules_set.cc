@@ -13,17 +13,55 @@
  *
  */
 
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <algorithm>
 #include <ctime>
+#include <functional>
 #include <iostream>
 #include <fstream>
+#include <initializer_list>
+#include <map>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "modsecurity/rules_set.h"
 #include "modsecurity/modsecurity.h"
 #include "modsecurity/transaction.h"
+#include "modsecurity/rule_marker.h"
+#include "modsecurity/rule_with_operator.h"
+#include "modsecurity/audit_log.h"
+#include "src/collection/backend/expiry.h"
+#include "src/collection/backend/in_memory-per_transaction.h"
+#include "src/collection/backend/lmdb.h"
+#include "src/collection/backend/redis.h"
+#include "src/header_rules.h"
+#include "src/native_rules.h"
+#include "src/operators/pm.h"
+#include "src/operators/pm_from_file.h"
+#include "src/operators/pm_group.h"
+#include "src/operators/rx_group.h"
 #include "src/parser/driver.h"
+#include "src/rule_prefetch.h"
+#include "src/rule_script.h"
+#include "src/uri_rules.h"
+#include "src/utils/debug_log_buffer.h"
+#include "src/utils/debug_log_filter.h"
 #include "src/utils/https_client.h"
+#include "src/utils/metrics.h"
+#include "src/utils/numa.h"
+#include "src/utils/overload_guard.h"
+#include "src/utils/regex.h"
+#include "src/utils/regex_cache.h"
+#include "src/utils/rule_profiler.h"
+#include "src/utils/string.h"
+#include "src/utils/system.h"
+#include "src/utils/thread_pool.h"
+#include "src/utils/verdict_cache.h"
+#include "src/variables/variable.h"
 #include "modsecurity/rules.h"
 
 using modsecurity::Parser::Driver;
@@ -32,6 +70,92 @@ using modsecurity::Utils::HttpsClient;
 namespace modsecurity {
 
 
+/* m_hasActions and m_prefetchable were checked by compileRules */
+inline RuleWithActions *RulesSet::CompiledRule::ruleWithActions() const {
+    return m_hasActions ? static_cast<RuleWithActions *>(m_rule) : nullptr;
+}
+
+
+inline RuleWithOperator *RulesSet::CompiledRule::prefetchable() const {
+    return m_prefetchable ? static_cast<RuleWithOperator *>(m_rule)
+        : nullptr;
+}
+
+
+RulesSet::RulesSet()
+    : RulesSetProperties(new DebugLog()),
+    m_regexCache(new Utils::RegexCache()),
+    m_ruleProfiler(nullptr),
+    m_overloadGuard(nullptr),
+    m_verdictCache(nullptr),
+    m_debugBufferFlush(nullptr),
+    m_debugFilter(nullptr),
+    m_base(nullptr),
+    m_removesRules(false),
+    m_updatesTargets(false),
+    m_threadPool(nullptr),
+    m_parallelPhases(),
+    m_verdictCacheBody(false),
+    m_verdictCacheInputs(0),
+    m_blockingPhases()
+#ifndef NO_LOGS
+    ,m_secmarker_skipped(0)
+#endif
+    { }
+
+
+RulesSet::RulesSet(DebugLog *customLog)
+    : RulesSetProperties(customLog),
+    m_regexCache(new Utils::RegexCache()),
+    m_ruleProfiler(nullptr),
+    m_overloadGuard(nullptr),
+    m_verdictCache(nullptr),
+    m_debugBufferFlush(nullptr),
+    m_debugFilter(nullptr),
+    m_base(nullptr),
+    m_removesRules(false),
+    m_updatesTargets(false),
+    m_threadPool(nullptr),
+    m_parallelPhases(),
+    m_verdictCacheBody(false),
+    m_verdictCacheInputs(0),
+    m_blockingPhases()
+#ifndef NO_LOGS
+    ,m_secmarker_skipped(0)
+#endif
+    { }
+
+
+RulesSet::~RulesSet() {
+    delete m_regexCache;
+    delete m_overloadGuard;
+    delete m_verdictCache;
+    delete m_debugBufferFlush;
+    delete m_debugFilter;
+    delete m_threadPool;
+    for (operators::PmGroup *group : m_pmGroups) {
+        delete group;
+    }
+    for (operators::RxGroup *group : m_rxGroups) {
+        delete group;
+    }
+    for (auto &native : m_nativeMatches) {
+        delete native.second;
+    }
+}
+
+
+RulesSet::RuleTargets::RuleTargets()
+    : m_variables(new variables::Variables()),
+    m_exclusion(new variables::Variables()) { }
+
+
+RulesSet::RuleTargets::~RuleTargets() {
+    delete m_variables;
+    delete m_exclusion;
+}
+
+
 /**
  * @name    loadFromUri
  * @brief   load rules from a give uri
@@ -48,6 +172,122 @@ namespace modsecurity {
  *
  */
 int RulesSet::loadFromUri(const char *uri) {
+    return loadFromUri(uri, nullptr);
+}
+
+
+/*
+ * The files a parse read, with their size and modification time once
+ * it was done. A file changed in the second the parse started, or later,
+ * may have been read before the change: the parse is not reused then,
+ * nor when something came from elsewhere than a file (SecRemoteRules,
+ * data from an URL).
+ */
+class RulesSet::LoadedUri {
+ public:
+    LoadedUri(const std::string &uri, Driver *driver, time_t started)
+        : m_uri(uri),
+        m_driver(driver),
+        m_reusable(true) {
+        for (const std::string &f : driver->m_filenames) {
+            stamp(f, started);
+        }
+        for (int i = 0; i < modsecurity::Phases::NUMBER_OF_PHASES; i++) {
+            Rules *rules = driver->m_rulesSetPhases[i];
+            for (size_t j = 0; j < rules->size(); j++) {
+                stampDataFiles(rules->at(j).get(), started);
+            }
+        }
+    }
+
+    bool unchanged() const {
+        if (m_reusable == false) {
+            return false;
+        }
+        for (const Stamp &f : m_files) {
+            struct stat st;
+            if (stat(f.m_path.c_str(), &st) != 0
+                || st.st_mtime != f.m_mtime || st.st_size != f.m_size) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const std::string m_uri;
+    std::unique_ptr<Driver> m_driver;
+
+ private:
+    struct Stamp {
+        std::string m_path;
+        time_t m_mtime;
+        off_t m_size;
+    };
+
+    void stamp(const std::string &path, time_t started) {
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0 || st.st_mtime >= started) {
+            m_reusable = false;
+            return;
+        }
+        m_files.push_back({path, st.st_mtime, st.st_size});
+    }
+
+    void stampDataFiles(Rule *rule, time_t started) {
+        static const char *const withFiles[] = { "pmfromfile", "pmf",
+            "ipmatchfromfile", "ipmatchf", "validatedtd", "validateschema",
+            "fuzzyhash", NULL };
+
+        RuleScript *script = dynamic_cast<RuleScript *>(rule);
+        if (script != nullptr) {
+            stamp(script->m_name, started);
+            return;
+        }
+
+        for (RuleWithOperator *r = dynamic_cast<RuleWithOperator *>(rule);
+            r != nullptr;
+            r = dynamic_cast<RuleWithOperator *>(r->m_chainedRuleChild.get())) {
+            operators::Operator *op = r->getOperator();
+            if (op == nullptr) {
+                continue;
+            }
+            std::string name = utils::string::tolower(op->m_op);
+            for (int i = 0; withFiles[i] != NULL; i++) {
+                if (name != withFiles[i]) {
+                    continue;
+                }
+                /* fuzzyHash takes the threshold after the file */
+                std::string file(op->m_param.substr(0,
+                    op->m_param.find(' ')));
+                std::string err;
+                std::string found = utils::find_resource(file,
+                    r->getFileName() ? *r->getFileName() : "", &err);
+                stamp(found.empty() ? file : found, started);
+            }
+        }
+    }
+
+    std::vector<Stamp> m_files;
+    bool m_reusable;
+};
+
+
+int RulesSet::loadFromUri(const char *uri, const RulesSet *previous) {
+    if (previous != nullptr) {
+        for (const std::shared_ptr<const LoadedUri> &loaded
+            : previous->m_loadedUris) {
+            if (loaded->m_uri == uri && loaded->unchanged()) {
+                int rules = this->merge(loaded->m_driver.get());
+                if (rules >= 0) {
+                    m_loadedUris.push_back(loaded);
+                    m_sources.emplace_back(true, uri, "");
+                }
+                return rules;
+            }
+        }
+    }
+
+    time_t started = time(NULL);
     Driver *driver = new Driver();
 
     if (driver->parseFile(uri) == 0) {
@@ -57,7 +297,13 @@ int RulesSet::loadFromUri(const char *uri) {
     }
 
     int rules = this->merge(driver);
-    delete driver;
+    if (rules < 0) {
+        delete driver;
+        return rules;
+    }
+    m_loadedUris.push_back(std::make_shared<const LoadedUri>(uri, driver,
+        started));
+    m_sources.emplace_back(true, uri, "");
 
     return rules;
 }
@@ -78,6 +324,7 @@ int RulesSet::load(const char *file, const std::string &ref) {
         return -1;
     }
     delete driver;
+    m_sources.emplace_back(false, file, ref);
 
     return rules;
 }
@@ -106,15 +353,49 @@ std::string RulesSet::getParserError() {
 }
 
 
+std::string RulesSet::profileDump() const {
+    std::shared_ptr<Utils::RuleProfiler> profiler =
+        std::atomic_load(&m_ruleProfiler);
+    if (profiler == nullptr) {
+        return "";
+    }
+    return profiler->dump();
+}
+
+
+std::string RulesSet::nativeSource() const {
+    return NativeRules::source(this);
+}
+
+
+bool RulesSet::needsResponseBody() const {
+    if (m_secResponseBodyAccess != TrueConfigBoolean) {
+        return false;
+    }
+
+    return m_variablesInUse.uses(ConfigVariablesInUse::ResponseBody)
+        || m_responseBodyLimitAction == RejectBodyLimitAction
+        || (m_auditLog != NULL
+            && (m_auditLog->getParts() & audit_log::AuditLog::EAuditLogPart));
+}
+
+
 int RulesSet::evaluate(int phase, Transaction *t) {
     if (phase >= modsecurity::Phases::NUMBER_OF_PHASES) {
        return 0;
     }
 
-    Rules *rules = m_rulesSetPhases[phase];
+    const CompiledPhase *base = nullptr;
+    const CompiledPhase &rules = m_compiledPhases[phase];
+
+    if (m_base != nullptr) {
+        base = (m_removesRules || m_updatesTargets) ? &m_basePhases[phase]
+            : &m_base->m_compiledPhases[phase];
+    }
 
     ms_dbg_a(t, 9, "This phase consists of " \
-        + std::to_string(rules->size()) + " rule(s).");
+        + std::to_string(rules.size() + (base ? base->size() : 0)) \
+        + " rule(s).");
 
     if (t->m_allowType == actions::disruptive::FromNowOnAllowType
         && phase != modsecurity::Phases::LoggingPhase) {
@@ -132,15 +413,293 @@ int RulesSet::evaluate(int phase, Transaction *t) {
     t->m_allowType = actions::disruptive::NoneAllowType;
     //}
 
-    for (int i = 0; i < rules->size(); i++) {
-        // FIXME: This is not meant to be here. At the end of this refactoring,
-        //        the shared pointer won't be used.
-        auto rule = rules->at(i);
-        if (t->isInsideAMarker() && !rule->isMarker()) {
+    if (m_verdictCache != nullptr && cachedVerdict(phase, t)) {
+        return 1;
+    }
+    size_t messages = t->m_rulesMessages.size();
+    collection::backend::Expiry::Scope expiry(collectionTimeout());
+
+    RulePrefetches prefetches;
+    if (runsInParallel(phase, t)) {
+        t->m_rulePrefetches = &prefetches;
+    } else if (runsValueMajor(phase, t)) {
+        prefetches.m_valueMajor = true;
+        t->m_rulePrefetches = &prefetches;
+    }
+
+    /* the rules of the base may skip to the marker of the overlay */
+    bool decisionAhead = base != nullptr && m_earlyDecision != nullptr
+        && rules.m_markers.count(*m_earlyDecision) > 0;
+
+    if (base == nullptr || evaluateRules(*base, t, decisionAhead)) {
+        evaluateRules(rules, t, false);
+    }
+    if (m_debugFilter != nullptr && m_debugFilter->hasRuleIds()) {
+        t->setDebugScope(nullptr);
+    }
+
+    t->m_rulePrefetches = nullptr;
+
+    if (m_verdictCache != nullptr) {
+        cacheVerdict(phase, t, messages);
+    }
+
+    return 1;
+}
+
+
+/**
+ * Puts back what the phase came to for the same request, if the cache has
+ * it, in place of evaluating the rules. The request body phase is only
+ * answered for a request without a body, after the headers phase was.
+ *
+ */
+bool RulesSet::cachedVerdict(int phase, Transaction *t) {
+    Utils::VerdictCache::Slot slot;
+
+    if (phase == modsecurity::Phases::RequestHeadersPhase) {
+        if (!Utils::VerdictCache::key(t, m_verdictCacheInputs,
+            &t->m_verdictKey)) {
+            t->m_verdictKey.clear();
+            return false;
+        }
+        slot = Utils::VerdictCache::RequestHeadersSlot;
+    } else if (phase == modsecurity::Phases::RequestBodyPhase
+        && m_verdictCacheBody && t->m_verdictHit
+        && t->m_requestBody.size() == 0) {
+        slot = Utils::VerdictCache::RequestBodySlot;
+    } else {
+        return false;
+    }
+
+    std::shared_ptr<const Utils::VerdictCache::Verdict> verdict =
+        m_verdictCache->find(t->m_verdictKey, slot);
+    if (verdict == nullptr) {
+        Utils::Metrics::getInstance().increment(
+            Utils::Metrics::VerdictCacheMissesCounter);
+        t->m_verdictHit = false;
+        return false;
+    }
+
+    /* key() only gives one for this kind of TX */
+    collection::backend::InMemoryPerTransaction *tx =
+        static_cast<collection::backend::InMemoryPerTransaction *>(
+            t->m_collections.m_tx_collection);
+    tx->clear();
+    for (const auto &v : verdict->m_tx) {
+        tx->store(v.first, v.second);
+    }
+    t->m_highestSeverityAction = verdict->m_highestSeverity;
+    t->m_verdictHit = true;
+
+    Utils::Metrics::getInstance().increment(
+        Utils::Metrics::VerdictCacheHitsCounter);
+    ms_dbg_a(t, 4, "Verdict of the phase taken from SecVerdictCache, " \
+        "its rules are not evaluated.");
+    return true;
+}
+
+
+/**
+ * Stores what the phase came to, as long as it is the same any identical
+ * request would come to: no intervention, nothing logged by a rule, no
+ * rule left out because of the time budget or the overload protection,
+ * no allow.
+ *
+ */
+void RulesSet::cacheVerdict(int phase, Transaction *t, size_t messages) {
+    Utils::VerdictCache::Slot slot;
+
+    if (phase == modsecurity::Phases::RequestHeadersPhase) {
+        slot = Utils::VerdictCache::RequestHeadersSlot;
+    } else if (phase == modsecurity::Phases::RequestBodyPhase
+        && m_verdictCacheBody && t->m_requestBody.size() == 0) {
+        slot = Utils::VerdictCache::RequestBodySlot;
+    } else {
+        return;
+    }
+    if (t->m_verdictKey.empty()) {
+        return;
+    }
+
+    if (t->m_it.disruptive || t->m_rulesMessages.size() != messages
+        || t->m_timeBudgetExceeded || t->m_overloadLevel > 0
+        || t->m_allowType != actions::disruptive::NoneAllowType) {
+        t->m_verdictKey.clear();
+        return;
+    }
+
+    std::shared_ptr<Utils::VerdictCache::Verdict> verdict =
+        std::make_shared<Utils::VerdictCache::Verdict>();
+    static_cast<collection::backend::InMemoryPerTransaction *>(
+        t->m_collections.m_tx_collection)->dump(&verdict->m_tx);
+    verdict->m_highestSeverity = t->m_highestSeverityAction;
+    m_verdictCache->insert(t->m_verdictKey, slot, verdict);
+}
+
+
+bool RulesSet::runsInParallel(int phase, Transaction *t) const {
+    if (m_threadPool == nullptr || m_parallelPhases[phase] == false) {
+        return false;
+    }
+    /* The debug log is written as the rules go, in their order. */
+    if (ms_dbg_a_enabled(t, 1)) {
+        return false;
+    }
+    if (phase == modsecurity::Phases::RequestBodyPhase) {
+        return t->m_requestBody.size() >= kParallelMinBodySize;
+    }
+    if (phase == modsecurity::Phases::ResponseBodyPhase) {
+        return t->m_responseBody.size() >= kParallelMinBodySize;
+    }
+    return false;
+}
+
+
+/*
+ * Only when nothing reads the debug log, which the matching writes to as
+ * it goes, in rule order.
+ */
+bool RulesSet::runsValueMajor(int phase, Transaction *t) const {
+    return m_secRuleValueMajor == TrueConfigBoolean
+        && m_parallelPhases[phase] && !ms_dbg_a_enabled(t, 1);
+}
+
+
+/**
+ * Matches, on the thread pool, the rule at first and the prefetchable
+ * ones that follow it: up to the first rule that is not, a marker or a
+ * barrier, which is matched too. The rules then evaluate one after the
+ * other as usual, taking the results instead of matching themselves.
+ *
+ * Rules that end up skipped in the meantime (skip, skipAfter, an
+ * interception) are matched for nothing, which is all it costs.
+ *
+ */
+void RulesSet::prefetch(const std::vector<CompiledRule> &rules,
+    size_t first, Transaction *t) {
+    std::vector<std::function<void()>> tasks;
+
+    for (size_t i = first; i < rules.size(); i++) {
+        const CompiledRule &c = rules[i];
+        if (c.m_isMarker) {
+            break;
+        }
+        if (c.m_removedBy != CompiledRule::NotRemoved) {
+            continue;
+        }
+        RuleWithOperator *rule = c.prefetchable();
+        if (rule == nullptr) {
+            break;
+        }
+        RulePrefetch *out = t->m_rulePrefetches->add(rule);
+        tasks.emplace_back([rule, t, out]() {
+            rule->prefetch(t, out);
+        });
+        if (c.m_barrier) {
+            break;
+        }
+    }
+
+    m_threadPool->run(tasks);
+}
+
+
+/**
+ * Matches the rule at first along with the ones that follow it with the
+ * same targets (m_sameTargets), up to the first barrier, value by value:
+ * each value goes through all of them before the next one is fetched.
+ * The rules then evaluate in their order and take the results, as for
+ * prefetch(), so the actions, setvar included, run as they would have.
+ *
+ */
+void RulesSet::prefetchValueMajor(const std::vector<CompiledRule> &rules,
+    size_t first, Transaction *t) {
+    std::vector<RuleWithOperator *> group;
+    std::vector<RulePrefetch *> out;
+
+    for (size_t i = first; i < rules.size(); i++) {
+        const CompiledRule &c = rules[i];
+        if (i > first && c.m_sameTargets == false) {
+            break;
+        }
+        group.push_back(c.prefetchable());
+        out.push_back(t->m_rulePrefetches->add(group.back()));
+        if (c.m_barrier) {
+            break;
+        }
+    }
+
+    RuleWithOperator::prefetchValueMajor(group, t, out);
+}
+
+
+/**
+ * Whether the SecRuleEarlyDecision variable reached its threshold, after
+ * a rule that matched: from then on the outcome of the phase is decided
+ * and only the rules from the marker on (the blocking evaluation) are
+ * worth running.
+ */
+bool RulesSet::decidedEarly(Transaction *t) const {
+    std::unique_ptr<std::string> value =
+        t->m_collections.m_tx_collection->resolveFirst(
+            m_earlyDecisionVariable.m_value);
+    if (value == nullptr) {
+        return false;
+    }
+
+    char *end = nullptr;
+    long score = strtol(value->c_str(), &end, 10);
+    return end != value->c_str() && score >= m_earlyDecisionThreshold.m_value;
+}
+
+
+/**
+ * Evaluates one plan of the phase; the rules of an overlay are evaluated
+ * after the ones of its base, as if they were a single list, so markers
+ * and skips can cross from one to the other.
+ *
+ * skipAfter goes straight to its marker and skip over the rules it
+ * skips (see CompiledPhase); both carry on into the next plan, or phase,
+ * when they are not done with this one, as they always did.
+ *
+ * An early decision is a skipAfter to the SecRuleEarlyDecision marker,
+ * only taken while the marker is still ahead in the phase: in this plan
+ * or, decisionAhead, in the next one.
+ *
+ * Returns false if the transaction was intercepted.
+ *
+ */
+bool RulesSet::evaluateRules(const CompiledPhase &plan, Transaction *t,
+    bool decisionAhead) {
+    const std::vector<CompiledRule> &rules = plan.m_rules;
+    /* the debug log tells about every rule skipped, so they are walked */
+    bool jump = !ms_dbg_a_enabled(t, 9);
+    /* SecDebugLogFilter by rule id: the level changes with every rule */
+    bool scoped = m_debugFilter != nullptr && m_debugFilter->hasRuleIds();
+    HeaderRules::Values headerValues(plan.m_headerRules.get());
+    UriRules::Open uriOpen(plan.m_uriRules.get());
+
+    for (size_t i = 0; i < rules.size(); i++) {
+        if (jump && t->isInsideAMarker()) {
+            i = plan.findMarker(*t->getCurrentMarker(), i);
+        } else if (jump && t->m_skip_next > 0) {
+            i = plan.skipRules(i, &t->m_skip_next);
+        }
+        if (i == rules.size()) {
+            break;
+        }
+
+        const CompiledRule &compiled = rules[i];
+        Rule *rule = compiled.m_rule;
+        if (scoped) {
+            t->setDebugScope(compiled.ruleWithActions());
+        }
+        if (t->isInsideAMarker() && !compiled.m_isMarker) {
             ms_dbg_a(t, 9, "Skipped rule id '" + rule->getReference() \
                 + "' due to a SecMarker: " + *t->getCurrentMarker());
 
-        } else if (rule->isMarker()) {
+        } else if (compiled.m_isMarker) {
             rule->evaluate(t);
         } else if (t->m_skip_next > 0) {
             t->m_skip_next--;
@@ -152,16 +711,49 @@ int RulesSet::evaluate(int phase, Transaction *t) {
             ms_dbg_a(t, 9, "Skipped rule id '" + rule->getReference() \
                 + "' as request trough the utilization of an `allow' action.");
         } else {
-            Rule *base = rule.get();
-            RuleWithActions *ruleWithActions = dynamic_cast<RuleWithActions *>(base);
-            // FIXME: Those should be treated inside the rule itself
-            if (ruleWithActions && m_exceptions.contains(ruleWithActions->m_ruleId)) {
+            RuleWithActions *ruleWithActions = compiled.ruleWithActions();
+
+            if (compiled.m_shed != 0
+                && compiled.m_shed <= t->m_overloadLevel) {
+                ms_dbg_a(t, 9, "Skipped rule id '" + rule->getReference() \
+                    + "'. Shed under overload, level " \
+                    + std::to_string(t->m_overloadLevel) + ".");
+                Utils::Metrics::getInstance().increment(
+                    Utils::Metrics::OverloadRulesShedCounter);
+                continue;
+            }
+            if (compiled.m_readsTimeBudget == false
+                && t->timeBudgetExceeded()) {
+                ms_dbg_a(t, 9, "Skipped rule id '" + rule->getReference() \
+                    + "'. Transaction time budget exceeded.");
+                continue;
+            }
+            if (compiled.m_removedBy == CompiledRule::RemovedById) {
                 ms_dbg_a(t, 9, "Skipped rule id '" + rule->getReference() \
                     + "'. Removed by an SecRuleRemove directive.");
                 continue;
             }
+            if (compiled.m_removedBy == CompiledRule::RemovedByMsg) {
+                ms_dbg_a(t, 9, "Skipped rule id '" \
+                    + ruleWithActions->getReference() \
+                    + "'. Removed by a SecRuleRemoveByMsg directive.");
+                continue;
+            }
+            if (compiled.m_removedBy == CompiledRule::RemovedByTag) {
+                ms_dbg_a(t, 9, "Skipped rule id '" \
+                    + ruleWithActions->getReference() \
+                    + "'. Removed by a SecRuleRemoveByTag directive.");
+                continue;
+            }
+            if (compiled.m_uriRule != CompiledRule::kNoUriRule
+                && UriRules::usable(t)
+                && plan.m_uriRules->open(compiled.m_uriRule, t,
+                    &uriOpen) == false) {
+                continue;
+            }
+
             bool remove_rule = false;
-            if (ruleWithActions && m_exceptions.m_remove_rule_by_msg.empty() == false) {
+            if (compiled.m_checkMsgAtRunTime) {
                 for (auto &z : m_exceptions.m_remove_rule_by_msg) {
                     if (ruleWithActions->containsMsg(z, t) == true) {
                         ms_dbg_a(t, 9, "Skipped rule id '" \
@@ -176,7 +768,7 @@ int RulesSet::evaluate(int phase, Transaction *t) {
                 }
             }
 
-            if (ruleWithActions && m_exceptions.m_remove_rule_by_tag.empty() == false) {
+            if (compiled.m_checkTagAtRunTime) {
                 for (auto &z : m_exceptions.m_remove_rule_by_tag) {
                     if (ruleWithActions->containsTag(z, t) == true) {
                         ms_dbg_a(t, 9, "Skipped rule id '" \
@@ -191,10 +783,9 @@ int RulesSet::evaluate(int phase, Transaction *t) {
                 }
             }
 
-
-            if (ruleWithActions) {
+            if (ruleWithActions && t->m_ruleRemoveByTag.empty() == false) {
                 for (auto &z : t->m_ruleRemoveByTag) {
-                    if (ruleWithActions->containsTag(z, t) == true) {
+                    if (ruleWithActions->containsTag(z.first, z.second, t)) {
                         ms_dbg_a(t, 9, "Skipped rule id '" \
                             + ruleWithActions->getReference() \
                             + "'. Skipped due to a ruleRemoveByTag action.");
@@ -207,71 +798,1219 @@ int RulesSet::evaluate(int phase, Transaction *t) {
                 }
             }
 
-            rule->evaluate(t);
+            if (compiled.m_prefetchable && t->m_rulePrefetches
+                && t->m_rulePrefetches->find(compiled.prefetchable())
+                    == nullptr) {
+                if (t->m_rulePrefetches->m_valueMajor == false) {
+                    prefetch(rules, i, t);
+                } else if (compiled.m_barrier == false
+                    && i + 1 < rules.size() && rules[i + 1].m_sameTargets) {
+                    prefetchValueMajor(rules, i, t);
+                }
+            }
+
+            if (t->m_streamingResponseBody
+                && t->m_responseBodyMatches.count(rule) > 0) {
+                ms_dbg_a(t, 9, "Skipped rule id '" + rule->getReference() \
+                    + "'. It matched an earlier part of the response body.");
+                continue;
+            }
+
+            if (compiled.m_headerRule != CompiledRule::kNoHeaderRule
+                && HeaderRules::usable(t)
+                && plan.m_headerRules->matches(compiled.m_headerRule, t,
+                    &headerValues) == false) {
+                continue;
+            }
+
+            bool matched = rule->evaluate(t);
+            if (matched && t->m_streamingResponseBody) {
+                t->m_responseBodyMatches.insert(rule);
+            }
             if (t->m_it.disruptive > 0) {
 
                 ms_dbg_a(t, 8, "Skipping this phase as this " \
                     "request was already intercepted.");
-                break;
+                return false;
+            }
+
+            if (matched && m_earlyDecision != nullptr
+                && t->isInsideAMarker() == false
+                && (decisionAhead
+                    || plan.findMarker(*m_earlyDecision, i + 1) < rules.size())
+                && decidedEarly(t)) {
+                ms_dbg_a(t, 4, "TX:" + m_earlyDecisionVariable.m_value \
+                    + " reached " \
+                    + std::to_string(m_earlyDecisionThreshold.m_value) \
+                    + ", skipping to the marker " + *m_earlyDecision);
+                t->addMarker(m_earlyDecision);
             }
         }
     }
-    return 1;
-}
-
-
-int RulesSet::merge(Driver *from) {
-    int amount_of_rules = 0;
-
-    amount_of_rules = m_rulesSetPhases.append(&from->m_rulesSetPhases,
-        &m_parserError);
-    mergeProperties(
-        dynamic_cast<RulesSetProperties *>(from),
-        dynamic_cast<RulesSetProperties *>(this),
-        &m_parserError);
-
-    return amount_of_rules;
+    return true;
 }
 
 
-int RulesSet::merge(RulesSet *from) {
-    int amount_of_rules = 0;
+/**
+ * @name    compile
+ * @brief   build the per phase evaluation plan
+ *
+ * Resolves the rule kind and the static exclusions for every rule in every
+ * phase. It has to be called whenever m_rulesSetPhases or m_exceptions
+ * change, which is the case on every merge.
+ *
+ * On an overlay the rules of the base are only compiled again when the
+ * exceptions of the overlay change them.
+ *
+ */
+void RulesSet::compile() {
+    m_ruleTargets.clear();
 
-    amount_of_rules = m_rulesSetPhases.append(&from->m_rulesSetPhases,
-        &m_parserError);
-    mergeProperties(
-        dynamic_cast<RulesSetProperties *>(from),
-        dynamic_cast<RulesSetProperties *>(this),
-        &m_parserError);
+    for (int phase = 0; phase < modsecurity::Phases::NUMBER_OF_PHASES;
+        phase++) {
+        m_basePhases[phase].clear();
+        if (m_base != nullptr && (m_removesRules || m_updatesTargets)) {
+            compileRules(*m_base->m_rulesSetPhases.at(phase),
+                &m_basePhases[phase], m_updatesTargets);
+        }
+        compileRules(*m_rulesSetPhases.at(phase), &m_compiledPhases[phase],
+            true);
+        if (phase == modsecurity::Phases::RequestHeadersPhase) {
+            if (m_basePhases[phase].size() > 0) {
+                compileHeaderRules(&m_basePhases[phase]);
+            }
+            compileHeaderRules(&m_compiledPhases[phase]);
+        }
+        if (m_basePhases[phase].size() > 0) {
+            compileUriRules(&m_basePhases[phase]);
+        }
+        compileUriRules(&m_compiledPhases[phase]);
+    }
 
-    return amount_of_rules;
-}
+    m_earlyDecision = nullptr;
+    if (m_earlyDecisionMarker.m_set) {
+        m_earlyDecision = std::make_shared<std::string>(
+            m_earlyDecisionMarker.m_value);
+    }
 
+    compileOverloadGuard();
+    compileProfiler();
+    compileNative();
+    compileRequestBodyRegexes();
+    compilePmGroups();
+    compileRxGroups();
+    compileThreadPool();
+    compileVerdictCache();
+    compileDebugLogBuffer();
+    compileDebugLogFilter();
+    compileBlockingPhases();
 
-void RulesSet::debug(int level, const std::string &id,
-    const std::string &uri, const std::string &msg) {
-    if (m_debugLog != NULL) {
-        m_debugLog->write(level, id, uri, msg);
+    /* process wide, the JIT stacks belong to the threads */
+    if (m_pcreJitStackSize.m_set) {
+        Utils::Regex::setJitStackSize(m_pcreJitStackSize.m_value);
     }
 }
 
 
-void RulesSet::dump() const {
-    m_rulesSetPhases.dump();
-}
-
+namespace {
 
-extern "C" RulesSet *msc_create_rules_set(void) {
-    return new RulesSet();
+bool isCtl(const actions::Action *a) {
+    return a->m_name && utils::string::tolower(*a->m_name) == "ctl";
 }
 
+}  // namespace
 
-extern "C" void msc_rules_dump(RulesSet *rules) {
-    rules->dump();
-}
 
+void RulesSet::compileThreadPool() {
+    size_t threads = m_ruleEvaluationThreads.m_set
+        && m_ruleEvaluationThreads.m_value > 1
+        ? m_ruleEvaluationThreads.m_value : 0;
 
-extern "C" int msc_rules_merge(RulesSet *rules_dst,
+    if (m_threadPool != nullptr && m_threadPool->threads() != threads) {
+        delete m_threadPool;
+        m_threadPool = nullptr;
+    }
+    if (threads > 0 && m_threadPool == nullptr) {
+        m_threadPool = new Utils::ThreadPool(threads);
+    }
+
+    bool updatesCtl = false;
+    for (auto &b : m_exceptions.m_action_pos_update_target_by_id) {
+        updatesCtl = updatesCtl || isCtl(b.second.get());
+    }
+    for (int phase = 0; phase < modsecurity::Phases::NUMBER_OF_PHASES;
+        phase++) {
+        m_parallelPhases[phase] = !updatesCtl;
+        for (auto &a : m_defaultActions[phase]) {
+            if (isCtl(a.get())) {
+                m_parallelPhases[phase] = false;
+            }
+        }
+    }
+}
+
+
+/**
+ * The cache is only there when the rules of the request headers phase can
+ * be left out at all; the request body phase is answered too when its
+ * rules can as well.
+ *
+ */
+void RulesSet::compileVerdictCache() {
+    delete m_verdictCache;
+    m_verdictCache = nullptr;
+    m_verdictCacheBody = false;
+    m_verdictCacheInputs = 0;
+
+    if (m_verdictCacheEntries.m_set == false
+        || m_verdictCacheEntries.m_value <= 0) {
+        return;
+    }
+
+    unsigned int inputs = 0;
+    for (auto &b : m_exceptions.m_action_pos_update_target_by_id) {
+        if (!Utils::VerdictCache::cacheable(b.second.get(), &inputs)) {
+            return;
+        }
+    }
+    if (!verdictCacheable(modsecurity::Phases::RequestHeadersPhase,
+        &inputs)) {
+        return;
+    }
+    unsigned int body = inputs;
+    if (verdictCacheable(modsecurity::Phases::RequestBodyPhase, &body)) {
+        m_verdictCacheBody = true;
+        inputs = body;
+    }
+
+    m_verdictCacheInputs = inputs;
+    m_verdictCache = new Utils::VerdictCache(m_verdictCacheEntries.m_value);
+}
+
+
+bool RulesSet::verdictCacheable(int phase, unsigned int *inputs) const {
+    const CompiledPhase *base = nullptr;
+
+    for (auto &a : m_defaultActions[phase]) {
+        if (!Utils::VerdictCache::cacheable(a.get(), inputs)) {
+            return false;
+        }
+    }
+    if (m_base != nullptr) {
+        base = (m_removesRules || m_updatesTargets) ? &m_basePhases[phase]
+            : &m_base->m_compiledPhases[phase];
+    }
+
+    for (const CompiledPhase *plan : {base,
+        (const CompiledPhase *)&m_compiledPhases[phase]}) {
+        if (plan == nullptr) {
+            continue;
+        }
+        for (const CompiledRule &entry : plan->m_rules) {
+            if (entry.m_removedBy != CompiledRule::NotRemoved) {
+                continue;
+            }
+            for (const RuleWithActions *link = entry.ruleWithActions();
+                link != nullptr; link = link->m_chainedRuleChild.get()) {
+                const RuleWithOperator *op =
+                    dynamic_cast<const RuleWithOperator *>(link);
+                if (dynamic_cast<const RuleScript *>(link) != nullptr
+                    || (op != nullptr
+                        && !op->isVerdictCacheable(this, inputs))
+                    || (op == nullptr
+                        && !link->hasVerdictCacheableActions(inputs))) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+
+size_t RulesSet::memoryUsage() const {
+    size_t bytes = sizeof(*this);
+
+    for (int phase = 0; phase < modsecurity::Phases::NUMBER_OF_PHASES;
+        phase++) {
+        const Rules *rules = m_rulesSetPhases.at(phase);
+        for (size_t i = 0; i < rules->size(); i++) {
+            const RuleWithActions *rule = dynamic_cast<RuleWithActions *>(
+                rules->m_rules[i].get());
+            bytes += rule != nullptr ? rule->memoryUsage() : sizeof(Rule);
+        }
+        bytes += m_compiledPhases[phase].m_rules.size()
+            * sizeof(CompiledRule);
+    }
+    if (m_regexCache != nullptr) {
+        bytes += m_regexCache->memoryUsage();
+    }
+    return bytes;
+}
+
+
+void RulesSet::compileBlockingPhases() {
+    bool redis = m_collectionRedisHost.m_set;
+
+    for (int phase = 0; phase < modsecurity::Phases::NUMBER_OF_PHASES;
+        phase++) {
+        const CompiledPhase *base = nullptr;
+        m_blockingPhases[phase] = false;
+        if (m_base != nullptr) {
+            base = (m_removesRules || m_updatesTargets) ? &m_basePhases[phase]
+                : &m_base->m_compiledPhases[phase];
+        }
+
+        for (const CompiledPhase *plan : {base,
+            (const CompiledPhase *)&m_compiledPhases[phase]}) {
+            if (plan == nullptr) {
+                continue;
+            }
+            for (const CompiledRule &entry : plan->m_rules) {
+                if (entry.m_removedBy != CompiledRule::NotRemoved) {
+                    continue;
+                }
+                for (const RuleWithActions *link = entry.ruleWithActions();
+                    link != nullptr; link = link->m_chainedRuleChild.get()) {
+                    const RuleWithOperator *op =
+                        dynamic_cast<const RuleWithOperator *>(link);
+                    if (dynamic_cast<const RuleScript *>(link) != nullptr
+                        || (op != nullptr && op->mayBlock(this, redis))
+                        || (op == nullptr && redis
+                            && link->hasPersistentCollectionActions())) {
+                        m_blockingPhases[phase] = true;
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+void RulesSet::compileRequestBodyRegexes() {
+    const CompiledPhase *base = nullptr;
+    int phase = modsecurity::Phases::RequestBodyPhase;
+
+    m_requestBodyRegexes.clear();
+    if (m_base != nullptr) {
+        base = (m_removesRules || m_updatesTargets) ? &m_basePhases[phase]
+            : &m_base->m_compiledPhases[phase];
+    }
+
+    for (const CompiledPhase *plan : {base,
+        (const CompiledPhase *)&m_compiledPhases[phase]}) {
+        if (plan == nullptr) {
+            continue;
+        }
+        for (const CompiledRule &entry : plan->m_rules) {
+            RuleWithOperator *rule = dynamic_cast<RuleWithOperator *>(
+                entry.ruleWithActions());
+            if (entry.m_removedBy != CompiledRule::NotRemoved
+                || rule == nullptr) {
+                continue;
+            }
+            const Utils::Regex *regex = rule->requestBodyRegex(this);
+            if (regex != nullptr && std::find(m_requestBodyRegexes.begin(),
+                m_requestBodyRegexes.end(), regex)
+                    == m_requestBodyRegexes.end()) {
+                regex->compilePartial();
+                m_requestBodyRegexes.push_back(regex);
+            }
+        }
+    }
+}
+
+
+void RulesSet::compileOverloadGuard() {
+    delete m_overloadGuard;
+    m_overloadGuard = nullptr;
+
+    if (m_overloadTarget.m_set) {
+        m_overloadGuard = new Utils::OverloadGuard(
+            static_cast<uint64_t>(m_overloadTarget.m_value) * 1000,
+            m_overloadWindow.m_set ? m_overloadWindow.m_value : 1000);
+    }
+}
+
+
+void RulesSet::compileDebugLogBuffer() {
+    delete m_debugBufferFlush;
+    m_debugBufferFlush = nullptr;
+
+    if (m_debugLogBufferLevel.m_set == false) {
+        return;
+    }
+
+    std::string error;
+    m_debugBufferFlush = new Utils::DebugLogBufferFlush();
+    if (m_debugLogBufferFlush.m_set) {
+        /* already checked by the parser */
+        m_debugBufferFlush->parse(m_debugLogBufferFlush.m_value, &error);
+    }
+}
+
+
+void RulesSet::compileDebugLogFilter() {
+    delete m_debugFilter;
+    m_debugFilter = nullptr;
+
+    if (m_debugLogFilter.m_set == false) {
+        return;
+    }
+
+    std::string error;
+    m_debugFilter = new Utils::DebugLogFilter();
+    /* already checked by the parser */
+    m_debugFilter->parse(m_debugLogFilter.m_value, &error);
+}
+
+
+void RulesSet::compileProfiler() {
+    std::shared_ptr<Utils::RuleProfiler> profiler;
+
+    if (m_secRuleProfiling != TrueConfigBoolean) {
+        std::atomic_store(&m_ruleProfiler, profiler);
+        return;
+    }
+
+    profiler = std::make_shared<Utils::RuleProfiler>(
+        m_ruleProfilingSampleRate.m_set ?
+            m_ruleProfilingSampleRate.m_value : 1);
+
+    for (const RulesSetPhases *phases : {m_base ? &m_base->m_rulesSetPhases
+        : nullptr, (const RulesSetPhases *)&m_rulesSetPhases}) {
+        if (phases == nullptr) {
+            continue;
+        }
+        for (int phase = 0; phase < modsecurity::Phases::NUMBER_OF_PHASES;
+            phase++) {
+            for (auto &r : phases->at(phase)->m_rules) {
+                if (r->isMarker()) {
+                    continue;
+                }
+                RuleWithActions *chain = dynamic_cast<RuleWithActions *>(
+                    r.get());
+                for (RuleWithActions *link = chain; link != nullptr;
+                    link = link->m_chainedRuleChild.get()) {
+                    RuleWithOperator *op = dynamic_cast<RuleWithOperator *>(
+                        link);
+                    if (op) {
+                        profiler->add(op, chain->m_ruleId);
+                    }
+                }
+            }
+        }
+    }
+
+    /*
+     * The transactions already sampled keep the previous profiler, and
+     * the shard they write, alive until they are done.
+     */
+    std::atomic_store(&m_ruleProfiler, profiler);
+}
+
+
+/*
+ * Binds the rules to the functions of the SecRuleNativeModule, as the
+ * parser loaded it; it is only loaded again here if the directive came
+ * from elsewhere. The rules it has no entry for, or one written for
+ * other classes (the rule changed since the module was written), stay
+ * interpreted.
+ */
+void RulesSet::compileNative() {
+    for (auto &native : m_nativeMatches) {
+        delete native.second;
+    }
+    m_nativeMatches.clear();
+
+    if (m_ruleNativeModule.m_set == false) {
+        m_nativeModule = nullptr;
+        return;
+    }
+
+    if (m_nativeModule == nullptr
+        || m_nativeModule->m_path != m_ruleNativeModule.m_value) {
+        std::string error;
+        m_nativeModule = NativeRules::load(m_ruleNativeModule.m_value,
+            &error);
+        if (m_nativeModule == nullptr) {
+            return;
+        }
+    }
+
+    const NativeRule *module = m_nativeModule->m_rules;
+    std::map<std::pair<int64_t, int>, const NativeRule *> entries;
+    for (size_t i = 0; i < m_nativeModule->m_count; i++) {
+        entries[std::make_pair(module[i].m_ruleId, module[i].m_link)] =
+            &module[i];
+    }
+
+    NativeRules::forEachLink(this, [&](RuleWithOperator *rule, int64_t id,
+        int link) {
+        auto entry = entries.find(std::make_pair(id, link));
+        if (entry == entries.end() || m_nativeMatches.count(rule) != 0) {
+            return;
+        }
+        NativeMatch *native = NativeRules::bind(*entry->second, this, rule);
+        if (native != nullptr) {
+            m_nativeMatches[rule] = native;
+        }
+    });
+}
+
+
+/*
+ * CRS has many @pm and @pmFromFile over the same variables in a phase,
+ * each with an automaton of its own, so the same value is scanned again
+ * and again. The ones that see the very same values, with the same
+ * targets and transformations, are merged here into a PmGroup.
+ *
+ * Left out: the ones that go through hyperscan, and @pmFromFile when
+ * SecDataReloadInterval may replace the phrases.
+ */
+void RulesSet::compilePmGroups() {
+    std::vector<actions::transformations::Transformation *> chain;
+
+    for (operators::PmGroup *group : m_pmGroups) {
+        delete group;
+    }
+    m_pmGroups.clear();
+    m_pmGroupOf.clear();
+
+    for (int phase = 0; phase < modsecurity::Phases::NUMBER_OF_PHASES;
+        phase++) {
+        const CompiledPhase *base = nullptr;
+        std::map<std::string, std::vector<operators::Pm *>> candidates;
+
+        if (m_base != nullptr) {
+            base = (m_removesRules || m_updatesTargets) ? &m_basePhases[phase]
+                : &m_base->m_compiledPhases[phase];
+        }
+
+        for (const CompiledPhase *plan : {base,
+            (const CompiledPhase *)&m_compiledPhases[phase]}) {
+            if (plan == nullptr) {
+                continue;
+            }
+            for (const CompiledRule &entry : plan->m_rules) {
+                if (entry.m_removedBy != CompiledRule::NotRemoved) {
+                    continue;
+                }
+                for (RuleWithActions *link = entry.ruleWithActions();
+                    link != nullptr; link = link->m_chainedRuleChild.get()) {
+                    RuleWithOperator *op = dynamic_cast<RuleWithOperator *>(
+                        link);
+                    operators::Pm *pm = op == nullptr ? nullptr
+                        : dynamic_cast<operators::Pm *>(op->getOperator());
+                    if (pm == nullptr || pm->patterns().empty()
+                        || pm->backend() != "acmp"
+                        || getRuleTargets(op) == nullptr
+                        || (m_dataReloadInterval.m_set
+                            && dynamic_cast<operators::PmFromFile *>(pm))) {
+                        continue;
+                    }
+                    chain.clear();
+                    op->getTransformationsChain(this, &chain);
+                    candidates[op->getEffectiveTargets(this) + " "
+                        + op->getTransformationsKey(chain)].push_back(pm);
+                }
+            }
+        }
+
+        for (auto &c : candidates) {
+            if (c.second.size() < 2) {
+                continue;
+            }
+            operators::PmGroup *group = new operators::PmGroup();
+            for (operators::Pm *pm : c.second) {
+                m_pmGroupOf[pm] = std::make_pair(group, group->add(
+                    pm->patterns()));
+            }
+            group->prepare();
+            m_pmGroups.push_back(group);
+        }
+    }
+}
+
+
+const operators::PmGroup *RulesSet::pmGroup(const operators::Operator *op,
+    size_t *slot) const {
+    auto it = m_pmGroupOf.find(op);
+    if (it == m_pmGroupOf.end()) {
+        return nullptr;
+    }
+    *slot = it->second.second;
+    return it->second.first;
+}
+
+/*
+ * With SecRxRe2 On, the @rx (and @rxGlobal) that see the very same values
+ * are merged into an RxGroup, as compilePmGroups does for @pm. Left out:
+ * the expressions with macros and the ones RE2 can not run.
+ */
+void RulesSet::compileRxGroups() {
+    std::vector<actions::transformations::Transformation *> chain;
+
+    for (operators::RxGroup *group : m_rxGroups) {
+        delete group;
+    }
+    m_rxGroups.clear();
+    m_rxGroupOf.clear();
+
+    if (m_secRxRe2 != TrueConfigBoolean) {
+        return;
+    }
+
+    for (int phase = 0; phase < modsecurity::Phases::NUMBER_OF_PHASES;
+        phase++) {
+        const CompiledPhase *base = nullptr;
+        std::map<std::string, std::vector<const operators::Operator *>>
+            candidates;
+
+        if (m_base != nullptr) {
+            base = (m_removesRules || m_updatesTargets) ? &m_basePhases[phase]
+                : &m_base->m_compiledPhases[phase];
+        }
+
+        for (const CompiledPhase *plan : {base,
+            (const CompiledPhase *)&m_compiledPhases[phase]}) {
+            if (plan == nullptr) {
+                continue;
+            }
+            for (const CompiledRule &entry : plan->m_rules) {
+                if (entry.m_removedBy != CompiledRule::NotRemoved) {
+                    continue;
+                }
+                for (RuleWithActions *link = entry.ruleWithActions();
+                    link != nullptr; link = link->m_chainedRuleChild.get()) {
+                    RuleWithOperator *op = dynamic_cast<RuleWithOperator *>(
+                        link);
+                    const operators::Operator *rx = op == nullptr ? nullptr
+                        : op->getOperator();
+                    if (rx == nullptr || rx->regex() == nullptr
+                        || rx->regex()->linear() == false
+                        || getRuleTargets(op) == nullptr) {
+                        continue;
+                    }
+                    chain.clear();
+                    op->getTransformationsChain(this, &chain);
+                    candidates[op->getEffectiveTargets(this) + " "
+                        + op->getTransformationsKey(chain)].push_back(rx);
+                }
+            }
+        }
+
+        for (auto &c : candidates) {
+            if (c.second.size() < 2) {
+                continue;
+            }
+            operators::RxGroup *group = new operators::RxGroup();
+            std::vector<std::pair<const operators::Operator *, size_t>> slots;
+            for (const operators::Operator *rx : c.second) {
+                size_t slot;
+                if (group->add(rx->regex(), &slot)) {
+                    slots.push_back(std::make_pair(rx, slot));
+                }
+            }
+            if (slots.size() < 2 || group->prepare() == false) {
+                delete group;
+                continue;
+            }
+            for (auto &s : slots) {
+                m_rxGroupOf[s.first] = std::make_pair(group, s.second);
+            }
+            m_rxGroups.push_back(group);
+        }
+    }
+}
+
+
+const operators::RxGroup *RulesSet::rxGroup(const operators::Operator *op,
+    size_t *slot) const {
+    auto it = m_rxGroupOf.find(op);
+    if (it == m_rxGroupOf.end()) {
+        return nullptr;
+    }
+    *slot = it->second.second;
+    return it->second.first;
+}
+
+void RulesSet::CompiledPhase::clear() {
+    m_rules.clear();
+    m_markers.clear();
+    m_rulesBefore.clear();
+    m_headerRules.reset();
+    m_uriRules.reset();
+}
+
+
+size_t RulesSet::CompiledPhase::findMarker(const std::string &name,
+    size_t from) const {
+    auto markers = m_markers.find(name);
+    if (markers == m_markers.end()) {
+        return m_rules.size();
+    }
+
+    auto at = std::lower_bound(markers->second.begin(),
+        markers->second.end(), from);
+    if (at == markers->second.end()) {
+        return m_rules.size();
+    }
+
+    return *at;
+}
+
+
+size_t RulesSet::CompiledPhase::skipRules(size_t from, int *count) const {
+    size_t left = m_rulesBefore.back() - m_rulesBefore[from];
+    if (static_cast<size_t>(*count) >= left) {
+        *count -= left;
+        return m_rules.size();
+    }
+
+    size_t target = m_rulesBefore[from] + *count;
+    *count = 0;
+
+    return std::lower_bound(m_rulesBefore.begin() + from,
+        m_rulesBefore.end(), target) - m_rulesBefore.begin();
+}
+
+
+/*
+ * The overload level from which on a rule is skipped, 0 for never. A
+ * SecOverloadShedTag tag sheds the rules that carry it from level 1 on.
+ * paranoia-level/N is progressive instead: the rules tagged with the
+ * paranoia levels from N (2 at least, PL1 is never shed) up to 4 go the
+ * highest first, PL4 from level 1, PL3 from 2 and PL2 from 3.
+ */
+unsigned char RulesSet::shedLevel(RuleWithActions *rule) const {
+    static const std::string paranoia("paranoia-level/");
+    int level = 0;
+
+    for (const std::string &tag : m_overloadShedTags.m_value) {
+        if (tag.compare(0, paranoia.size(), paranoia) != 0) {
+            if (rule->containsTag(tag, nullptr)) {
+                return 1;
+            }
+            continue;
+        }
+        int from = std::max(atoi(tag.c_str() + paranoia.size()), 2);
+        for (int pl = from; pl <= 4; pl++) {
+            if (rule->containsTag(paranoia + std::to_string(pl), nullptr)
+                && (level == 0 || 5 - pl < level)) {
+                level = 5 - pl;
+            }
+        }
+    }
+
+    return level;
+}
+
+
+void RulesSet::compileRules(const Rules &rules, CompiledPhase *plan,
+    bool targets) {
+    std::vector<CompiledRule> &compiled = plan->m_rules;
+    static_assert(sizeof(CompiledRule) <= 2 * sizeof(void *),
+        "evaluation plan entries are kept at a pointer and its flags");
+
+    plan->clear();
+    compiled.reserve(rules.size());
+
+    for (auto &r : rules.m_rules) {
+        Rule *rule = r.get();
+        RuleWithActions *ruleWithActions = nullptr;
+        if (rule->isMarker() == false) {
+            ruleWithActions = dynamic_cast<RuleWithActions *>(rule);
+        }
+        CompiledRule c(rule);
+        c.m_isMarker = rule->isMarker();
+        c.m_hasActions = ruleWithActions != nullptr;
+
+        for (RuleWithActions *link = targets ? ruleWithActions : nullptr;
+            link != nullptr; link = link->m_chainedRuleChild.get()) {
+            RuleWithOperator *op = dynamic_cast<RuleWithOperator *>(link);
+            if (op) {
+                compileTargets(op);
+            }
+        }
+
+        if (ruleWithActions == nullptr) {
+            compiled.push_back(c);
+            continue;
+        }
+
+        if (m_exceptions.contains(ruleWithActions->m_ruleId)) {
+            c.m_removedBy = CompiledRule::RemovedById;
+            compiled.push_back(c);
+            continue;
+        }
+
+        if (m_exceptions.m_remove_rule_by_msg.empty() == false) {
+            if (ruleWithActions->msgContainsMacro()) {
+                c.m_checkMsgAtRunTime = true;
+            } else {
+                for (auto &z : m_exceptions.m_remove_rule_by_msg) {
+                    if (ruleWithActions->containsMsg(z, nullptr)) {
+                        c.m_removedBy = CompiledRule::RemovedByMsg;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (c.m_removedBy == CompiledRule::NotRemoved
+            && m_exceptions.m_remove_rule_by_tag.empty() == false) {
+            if (ruleWithActions->tagsContainMacro()) {
+                c.m_checkTagAtRunTime = true;
+            } else {
+                for (auto &z : m_exceptions.m_remove_rule_by_tag) {
+                    if (ruleWithActions->containsTag(z, nullptr)) {
+                        c.m_removedBy = CompiledRule::RemovedByTag;
+                        break;
+                    }
+                }
+            }
+        }
+
+        for (RuleWithActions *link = m_transactionTimeBudget.m_set
+            ? ruleWithActions : nullptr; link != nullptr;
+            link = link->m_chainedRuleChild.get()) {
+            RuleWithOperator *op = dynamic_cast<RuleWithOperator *>(link);
+            c.m_readsTimeBudget = c.m_readsTimeBudget || (op != nullptr
+                && (op->hasTarget("MSC_TIME_BUDGET_EXCEEDED")
+                    || op->hasTarget("TX:MSC_TIME_BUDGET_EXCEEDED")));
+        }
+
+        if (c.m_removedBy == CompiledRule::NotRemoved
+            && m_overloadShedTags.m_value.empty() == false
+            && ruleWithActions->tagsContainMacro() == false) {
+            c.m_shed = shedLevel(ruleWithActions);
+        }
+
+        RuleWithOperator *op = dynamic_cast<RuleWithOperator *>(
+            ruleWithActions);
+        if (op && op->isParallelSafe(this)) {
+            c.m_prefetchable = true;
+            for (RuleWithActions *link = op; link != nullptr;
+                link = link->m_chainedRuleChild.get()) {
+                c.m_barrier = c.m_barrier || link->hasCtlAction();
+            }
+        }
+        if (c.m_prefetchable && c.m_removedBy == CompiledRule::NotRemoved
+            && compiled.empty() == false) {
+            const CompiledRule &previous = compiled.back();
+            c.m_sameTargets = previous.m_prefetchable
+                && previous.m_removedBy == CompiledRule::NotRemoved
+                && op->hasSameTargets(previous.prefetchable(), this);
+        }
+
+        compiled.push_back(c);
+    }
+
+    size_t rulesBefore = 0;
+    plan->m_rulesBefore.reserve(compiled.size() + 1);
+    for (size_t i = 0; i < compiled.size(); i++) {
+        plan->m_rulesBefore.push_back(rulesBefore);
+        if (compiled[i].m_isMarker == false) {
+            rulesBefore++;
+            continue;
+        }
+        RuleMarker *marker = dynamic_cast<RuleMarker *>(compiled[i].m_rule);
+        if (marker) {
+            plan->m_markers[*marker->getName()].push_back(i);
+        }
+    }
+    plan->m_rulesBefore.push_back(rulesBefore);
+}
+
+
+/*
+ * Only once the targets are compiled, into this set or into m_base: the
+ * program takes the ones getRuleTargets() hands, as evaluate() would.
+ */
+void RulesSet::compileHeaderRules(CompiledPhase *plan) {
+    std::shared_ptr<HeaderRules> program = std::make_shared<HeaderRules>();
+
+    for (CompiledRule &c : plan->m_rules) {
+        if (program->size() == CompiledRule::kNoHeaderRule) {
+            break;
+        }
+        if (c.m_isMarker || c.m_removedBy != CompiledRule::NotRemoved) {
+            continue;
+        }
+        RuleWithOperator *rule = dynamic_cast<RuleWithOperator *>(
+            c.ruleWithActions());
+        if (rule && program->add(rule, getRuleTargets(rule))) {
+            c.m_headerRule = program->size() - 1;
+        }
+    }
+
+    if (program->size() > 0) {
+        plan->m_headerRules = program;
+    }
+}
+
+
+void RulesSet::compileUriRules(CompiledPhase *plan) {
+    std::shared_ptr<UriRules> program = std::make_shared<UriRules>();
+
+    for (CompiledRule &c : plan->m_rules) {
+        if (program->size() == CompiledRule::kNoUriRule) {
+            break;
+        }
+        if (c.m_isMarker || c.m_removedBy != CompiledRule::NotRemoved) {
+            continue;
+        }
+        RuleWithOperator *rule = dynamic_cast<RuleWithOperator *>(
+            c.ruleWithActions());
+        if (rule && program->add(this, rule)) {
+            c.m_uriRule = program->size() - 1;
+        }
+    }
+
+    if (program->size() > 0) {
+        plan->m_uriRules = program;
+    }
+}
+
+
+/**
+ * Applies the SecRuleUpdateTarget* exceptions of this set to rule, unless
+ * they depend on the expansion of the rule tags or msg.
+ *
+ */
+void RulesSet::compileTargets(RuleWithOperator *rule) {
+    if (rule->hasStaticFinalVars(m_exceptions) == false
+        || m_ruleTargets.count(rule) > 0) {
+        return;
+    }
+
+    std::unique_ptr<RuleTargets> targets(new RuleTargets());
+    rule->getFinalVars(&m_exceptions, targets->m_variables,
+        targets->m_exclusion, nullptr);
+    m_ruleTargets.emplace(rule, std::move(targets));
+}
+
+
+void RulesSet::applyCollectionSyncMode() {
+#ifdef WITH_LMDB
+    unsigned int flags = 0;
+
+    if (m_collectionSyncMode.m_set == false) {
+        return;
+    }
+
+    if (m_collectionSyncMode.m_value == CollectionSyncNoMetaSync) {
+        flags = MDB_NOMETASYNC;
+    } else if (m_collectionSyncMode.m_value == CollectionSyncNoSync) {
+        flags = MDB_NOSYNC;
+    }
+    collection::backend::MDBEnvProvider::setSyncMode(flags);
+#endif
+}
+
+
+/*
+ * Only with the Redis backend in use (see ModSecurity::ModSecurity), the
+ * name is not resolved for nothing.
+ */
+bool RulesSet::applyCollectionRedisServer() {
+    std::string error;
+
+    if (m_collectionRedisHost.m_set == false) {
+        return true;
+    }
+
+#if !defined(WITH_REDIS_COLLECTIONS) || defined(WITH_SHARED_COLLECTIONS)
+    m_parserError << "SecCollectionRedisServer: ModSecurity was not " \
+        "compiled with the Redis collections " \
+        "(--enable-redis-collections)." << std::endl;
+    return false;
+#else
+    if (collection::backend::Redis::setServer(m_collectionRedisHost.m_value,
+        m_collectionRedisPort.m_value, m_collectionRedisTimeout.m_value,
+        &error) == false) {
+        m_parserError << error << std::endl;
+        return false;
+    }
+    return true;
+#endif
+}
+
+
+void RulesSet::applyCollectionGroupCommit() {
+#ifdef WITH_LMDB
+    if (m_collectionGroupCommit.m_set == false) {
+        return;
+    }
+
+    collection::backend::MDBEnvProvider::setGroupCommit(
+        m_collectionGroupCommit.m_value > 0
+        ? m_collectionGroupCommit.m_value : 0);
+#endif
+}
+
+
+/*
+ * The timeout itself is the one of the transactions of this set (see
+ * evaluate()); the sweeper is only told how often it has to go by.
+ */
+void RulesSet::applyCollectionTimeout() {
+    collection::backend::Expiry::getInstance().addTimeout(
+        collectionTimeout());
+}
+
+
+unsigned int RulesSet::collectionTimeout() const {
+    return m_collectionTimeout.m_set && m_collectionTimeout.m_value > 0
+        ? m_collectionTimeout.m_value : 0;
+}
+
+
+/*
+ * The shadow rules are a set of their own, loaded along with this one;
+ * transactions of theirs are never shadowed, so they can not have
+ * SecShadowRules themselves.
+ */
+bool RulesSet::compileShadow() {
+    if (m_shadowRules.m_set == false
+        || (m_shadow != nullptr && m_shadowFile == m_shadowRules.m_value)) {
+        return true;
+    }
+
+    std::shared_ptr<RulesSet> shadow = std::make_shared<RulesSet>();
+    if (shadow->loadFromUri(m_shadowRules.m_value.c_str()) < 0) {
+        m_parserError << "Failed to load the SecShadowRules " \
+            << m_shadowRules.m_value << ": " << shadow->getParserError();
+        return false;
+    }
+    if (shadow->m_shadowRules.m_set) {
+        m_parserError << "SecShadowRules can not be used in the shadow " \
+            "rules (" << m_shadowRules.m_value << ")." << std::endl;
+        return false;
+    }
+
+    m_shadow = shadow;
+    m_shadowFile = m_shadowRules.m_value;
+    return true;
+}
+
+
+int RulesSet::merge(Driver *from) {
+    int amount_of_rules = 0;
+
+    amount_of_rules = m_rulesSetPhases.append(&from->m_rulesSetPhases,
+        &m_parserError, m_base ? &m_base->m_rulesSetPhases : nullptr);
+    if (m_base != nullptr) {
+        m_removesRules |= from->m_exceptions.removesRules();
+        m_updatesTargets |= from->m_exceptions.updatesTargets();
+    }
+    mergeProperties(
+        dynamic_cast<RulesSetProperties *>(from),
+        dynamic_cast<RulesSetProperties *>(this),
+        &m_parserError);
+    if (from->m_nativeModule != nullptr) {
+        m_nativeModule = from->m_nativeModule;
+    }
+    applyCollectionSyncMode();
+    applyCollectionGroupCommit();
+    applyCollectionTimeout();
+    if (applyCollectionRedisServer() == false || compileShadow() == false) {
+        return -1;
+    }
+    compile();
+
+    return amount_of_rules;
+}
+
+
+int RulesSet::merge(RulesSet *from) {
+    int amount_of_rules = 0;
+
+    if (from->m_base != nullptr) {
+        m_parserError << "Can not merge an overlay, its base has to be " \
+            "merged first." << std::endl;
+        return -1;
+    }
+
+    amount_of_rules = m_rulesSetPhases.append(&from->m_rulesSetPhases,
+        &m_parserError, m_base ? &m_base->m_rulesSetPhases : nullptr);
+    if (m_base != nullptr) {
+        m_removesRules |= from->m_exceptions.removesRules();
+        m_updatesTargets |= from->m_exceptions.updatesTargets();
+    }
+    mergeProperties(
+        dynamic_cast<RulesSetProperties *>(from),
+        dynamic_cast<RulesSetProperties *>(this),
+        &m_parserError);
+    m_loadedUris.insert(m_loadedUris.end(), from->m_loadedUris.begin(),
+        from->m_loadedUris.end());
+    m_sources.insert(m_sources.end(), from->m_sources.begin(),
+        from->m_sources.end());
+    if (from->m_nativeModule != nullptr) {
+        m_nativeModule = from->m_nativeModule;
+    }
+    applyCollectionSyncMode();
+    applyCollectionGroupCommit();
+    applyCollectionTimeout();
+    if (applyCollectionRedisServer() == false || compileShadow() == false) {
+        return -1;
+    }
+    compile();
+
+    return amount_of_rules;
+}
+
+
+int RulesSet::setBase(std::shared_ptr<RulesSet> base) {
+    if (base->m_base != nullptr) {
+        m_parserError << "The base of an overlay can not be an overlay " \
+            "itself." << std::endl;
+        return -1;
+    }
+    if (m_base != nullptr || m_rulesSetPhases.empty() == false) {
+        m_parserError << "An overlay base has to be set before any rule " \
+            "is added to it." << std::endl;
+        return -1;
+    }
+
+    m_base = base;
+    mergeProperties(
+        dynamic_cast<RulesSetProperties *>(base.get()),
+        dynamic_cast<RulesSetProperties *>(this),
+        &m_parserError);
+    m_shadow = base->m_shadow;
+    m_shadowFile = base->m_shadowFile;
+    compile();
+
+    return 0;
+}
+
+
+std::shared_ptr<RulesSet> RulesSet::shared() {
+    if (m_self == nullptr) {
+        m_self.reset(this);
+    }
+    return m_self;
+}
+
+
+void RulesSet::release(RulesSet *rules) {
+    if (rules->m_self == nullptr) {
+        delete rules;
+        return;
+    }
+    /* the set is deleted here unless an overlay still refers to it */
+    std::shared_ptr<RulesSet> self;
+    self.swap(rules->m_self);
+}
+
+
+int RulesSet::replicatePerNumaNode() {
+    if (m_base != nullptr) {
+        m_parserError << "An overlay can not be replicated." << std::endl;
+        return -1;
+    }
+    if (m_replicas.empty() == false) {
+        return m_replicas.size();
+    }
+
+    std::vector<std::vector<int>> nodes = Utils::Numa::nodes();
+    int here = Utils::Numa::currentCpu();
+    std::vector<RulesSet *> replicaOfCpu;
+
+    for (const std::vector<int> &cpus : nodes) {
+        bool local = false;
+        for (int cpu : cpus) {
+            local |= cpu == here;
+        }
+        if (cpus.empty() || local) {
+            for (int cpu : cpus) {
+                if (replicaOfCpu.size() <= static_cast<size_t>(cpu)) {
+                    replicaOfCpu.resize(cpu + 1, this);
+                }
+            }
+            continue;
+        }
+
+        std::unique_ptr<RulesSet> replica(new RulesSet());
+        bool loaded = true;
+        bool bound = Utils::Numa::runOn(cpus, [&]() {
+            for (const Source &source : m_sources) {
+                int rules = source.m_uri
+                    ? replica->loadFromUri(source.m_rules.c_str())
+                    : replica->load(source.m_rules.c_str(), source.m_ref);
+                if (rules < 0) {
+                    loaded = false;
+                    break;
+                }
+            }
+        });
+        if (bound == false) {
+            m_parserError << "Failed to run on the CPUs of a NUMA node."
+                << std::endl;
+            return -1;
+        }
+        if (loaded == false) {
+            m_parserError << replica->getParserError();
+            return -1;
+        }
+
+        for (int cpu : cpus) {
+            if (replicaOfCpu.size() <= static_cast<size_t>(cpu)) {
+                replicaOfCpu.resize(cpu + 1, this);
+            }
+            replicaOfCpu[cpu] = replica.get();
+        }
+        m_replicas.push_back(std::move(replica));
+    }
+
+    if (m_replicas.empty() == false) {
+        m_replicaOfCpu = replicaOfCpu;
+    }
+    return m_replicas.size();
+}
+
+
+RulesSet *RulesSet::replica() {
+    if (m_replicaOfCpu.empty()) {
+        return this;
+    }
+    int cpu = Utils::Numa::currentCpu();
+    if (cpu < 0 || static_cast<size_t>(cpu) >= m_replicaOfCpu.size()) {
+        return this;
+    }
+    return m_replicaOfCpu[cpu];
+}
+
+
+void RulesSet::debug(int level, const std::string &id,
+    const std::string &uri, const std::string &msg) {
+    if (m_debugLog != NULL) {
+        m_debugLog->write(level, id, uri, msg);
+    }
+}
+
+
+void RulesSet::dump() const {
+    if (m_base != nullptr) {
+        m_base->dump();
+    }
+    m_rulesSetPhases.dump();
+}
+
+
+extern "C" RulesSet *msc_create_rules_set(void) {
+    return new RulesSet();
+}
+
+
+extern "C" void msc_rules_dump(RulesSet *rules) {
+    rules->dump();
+}
+
+
+extern "C" int msc_rules_merge(RulesSet *rules_dst,
     RulesSet *rules_from, const char **error) {
     int ret = rules_dst->merge(rules_from);
     if (ret < 0) {
@@ -281,6 +2020,39 @@ extern "C" int msc_rules_merge(RulesSet *rules_dst,
 }
 
 
+extern "C" int msc_rules_replicate_per_numa_node(RulesSet *rules,
+    const char **error) {
+    int ret = rules->replicatePerNumaNode();
+    if (ret < 0) {
+        *error = strdup(rules->getParserError().c_str());
+    }
+    return ret;
+}
+
+
+extern "C" char *msc_rules_profile_dump(RulesSet *rules) {
+    return strdup(rules->profileDump().c_str());
+}
+
+
+/**
+ * @name    msc_rules_set_base
+ * @brief   Makes rules, still empty, an overlay of base.
+ *
+ * rules keeps a reference to base: msc_rules_cleanup() may be called on
+ * base at any time, it is only deleted once its overlays are gone too.
+ *
+ */
+extern "C" int msc_rules_set_base(RulesSet *rules, RulesSet *base,
+    const char **error) {
+    int ret = rules->setBase(base->shared());
+    if (ret < 0) {
+        *error = strdup(rules->getParserError().c_str());
+    }
+    return ret;
+}
+
+
 extern "C" int msc_rules_add_remote(RulesSet *rules,
     const char *key, const char *uri, const char **error) {
     int ret = rules->loadRemote(key, uri);
@@ -311,8 +2083,18 @@ extern "C" int msc_rules_add(RulesSet *rules, const char *plain_rules,
 }
 
 
+extern "C" int msc_rules_needs_response_body(RulesSet *rules) {
+    return rules->needsResponseBody();
+}
+
+
+extern "C" size_t msc_rules_memory_usage(RulesSet *rules) {
+    return rules->memoryUsage();
+}
+
+
 extern "C" int msc_rules_cleanup(RulesSet *rules) {
-    delete rules;
+    RulesSet::release(rules);
     return true;
 }
 
@@ -18,6 +18,7 @@
 #include <fstream>
 #include <string>
 #include <vector>
+#include <initializer_list>
 
 #include "modsecurity/rules_set_phases.h"
 #include "modsecurity/rule.h"
@@ -39,18 +40,25 @@ bool RulesSetPhases::insert(std::shared_ptr<Rule> rule) {
 }
 
 
-int RulesSetPhases::append(RulesSetPhases *from, std::ostringstream *err) {
+int RulesSetPhases::append(RulesSetPhases *from, std::ostringstream *err,
+    const RulesSetPhases *base) {
     int amount_of_rules = 0;
     std::vector<int64_t> v;
 
-    for (int i = 0; i < modsecurity::Phases::NUMBER_OF_PHASES; i++) {
-        v.reserve(m_rulesAtPhase[i].size());
-        for (size_t z = 0; z < m_rulesAtPhase[i].size(); z++) {
-            RuleWithOperator *rule_ckc = dynamic_cast<RuleWithOperator *>(m_rulesAtPhase[i].at(z).get());
-            if (!rule_ckc) {
-                continue;
+    for (const RulesSetPhases *set : {base, (const RulesSetPhases *)this}) {
+        if (set == nullptr) {
+            continue;
+        }
+        for (int i = 0; i < modsecurity::Phases::NUMBER_OF_PHASES; i++) {
+            const Rules &rules = set->m_rulesAtPhase[i];
+            v.reserve(v.size() + rules.size());
+            for (size_t z = 0; z < rules.size(); z++) {
+                RuleWithOperator *rule_ckc = dynamic_cast<RuleWithOperator *>(rules.at(z).get());
+                if (!rule_ckc) {
+                    continue;
+                }
+                v.push_back(rule_ckc->m_ruleId);
             }
-            v.push_back(rule_ckc->m_ruleId);
         }
     }
     std::sort (v.begin(), v.end());
@@ -66,6 +74,16 @@ int RulesSetPhases::append(RulesSetPhases *from, std::ostringstream *err) {
     return amount_of_rules;
 }
 
+bool RulesSetPhases::empty() const {
+    for (int i = 0; i < modsecurity::Phases::NUMBER_OF_PHASES; i++) {
+        if (m_rulesAtPhase[i].size() > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
 void RulesSetPhases::dump() const {
     for (int i = 0; i <= modsecurity::Phases::NUMBER_OF_PHASES; i++) {
         std::cout << "Phase: " << std::to_string(i);
@@ -13,7 +13,15 @@
  *
  */
 
+#include <pthread.h>
+#include <sys/stat.h>
+
+#include <map>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "modsecurity/rules_set_properties.h"
 #include "src/utils/string.h"
@@ -22,6 +30,33 @@
 namespace modsecurity {
 
 
+namespace {
+
+
+/*
+ * The maps already loaded, by file, code page and the size and mtime of
+ * the file, so that a reload picks up an edited file. Only weak references
+ * are kept: a map goes away with the last rule set using it.
+ */
+pthread_mutex_t unicodeMapsLock = PTHREAD_MUTEX_INITIALIZER;
+std::map<std::string, std::weak_ptr<UnicodeMapHolder>> unicodeMaps;
+
+
+std::string unicodeMapKey(const std::string &f, double codePage) {
+    struct stat st;
+
+    if (stat(f.c_str(), &st) != 0) {
+        return "";
+    }
+    return f + "\n" + std::to_string(codePage) + "\n"
+        + std::to_string(st.st_size) + "\n"
+        + std::to_string(st.st_mtime);
+}
+
+
+}  // namespace
+
+
 void ConfigUnicodeMap::loadConfig(std::string f, double configCodePage,
     RulesSetProperties *driver, std::string *errg) {
     char *buf = NULL;
@@ -35,20 +70,34 @@ void ConfigUnicodeMap::loadConfig(std::string f, double configCodePage,
     int Map = 0;
     int processing = 0;
 
-    driver->m_unicodeMapTable.m_set = true;
-    driver->m_unicodeMapTable.m_unicodeCodePage = configCodePage;
+    std::string key = unicodeMapKey(f, configCodePage);
+    if (!key.empty()) {
+        pthread_mutex_lock(&unicodeMapsLock);
+        std::shared_ptr<UnicodeMapHolder> cached = unicodeMaps[key].lock();
+        pthread_mutex_unlock(&unicodeMapsLock);
+        if (cached != nullptr) {
+            driver->m_unicodeMapTable.m_set = true;
+            driver->m_unicodeMapTable.m_unicodeCodePage = configCodePage;
+            driver->m_unicodeMapTable.m_unicodeMapTable = cached;
+            return;
+        }
+    }
 
-    driver->m_unicodeMapTable.m_unicodeMapTable.reset(new modsecurity::UnicodeMapHolder());
+    std::shared_ptr<UnicodeMapHolder> map(new UnicodeMapHolder());
 
     /* Setting some unicode values - http://tools.ietf.org/html/rfc3490#section-3.1 */
     /* Set 0x3002 -> 0x2e */
-    driver->m_unicodeMapTable.m_unicodeMapTable->change(0x3002, 0x2e);
+    map->change(0x3002, 0x2e);
     /* Set 0xFF61 -> 0x2e */
-    driver->m_unicodeMapTable.m_unicodeMapTable->change(0xff61, 0x2e);
+    map->change(0xff61, 0x2e);
     /* Set 0xFF0E -> 0x2e */
-    driver->m_unicodeMapTable.m_unicodeMapTable->change(0xff0e, 0x2e);
+    map->change(0xff0e, 0x2e);
     /* Set 0x002E -> 0x2e */
-    driver->m_unicodeMapTable.m_unicodeMapTable->change(0x002e, 0x2e);
+    map->change(0x002e, 0x2e);
+
+    driver->m_unicodeMapTable.m_set = true;
+    driver->m_unicodeMapTable.m_unicodeCodePage = configCodePage;
+    driver->m_unicodeMapTable.m_unicodeMapTable = map;
 
 
     std::ifstream file_stream(f, std::ios::in | std::ios::binary);
@@ -101,7 +150,7 @@ void ConfigUnicodeMap::loadConfig(std::string f, double configCodePage,
                 sscanf(ucode, "%x", &code);
                 sscanf(hmap, "%x", &Map);
                 if (code >= 0 && code <= 65535)    {
-                    driver->m_unicodeMapTable.m_unicodeMapTable->change(code, Map);
+                    map->change(code, Map);
                 }
 
                 free(mapping);
@@ -121,6 +170,89 @@ void ConfigUnicodeMap::loadConfig(std::string f, double configCodePage,
     }
 
     delete[] buf;
+
+    if (!key.empty()) {
+        pthread_mutex_lock(&unicodeMapsLock);
+        for (auto it = unicodeMaps.begin(); it != unicodeMaps.end();) {
+            if (it->second.expired()) {
+                it = unicodeMaps.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        unicodeMaps[key] = map;
+        pthread_mutex_unlock(&unicodeMapsLock);
+    }
+}
+
+
+bool ConfigTransformationsCache::load(const std::string &directive,
+    std::string *error) {
+    std::vector<std::string> param;
+
+    for (const std::string &p : utils::string::ssplit(directive, ' ')) {
+        if (!p.empty()) {
+            param.push_back(p);
+        }
+    }
+
+    if (param.size() < 2 || param.size() > 3) {
+        error->assign("SecCacheTransformations expects On or Off, " \
+            "optionally followed by a list of options.");
+        return false;
+    }
+
+    std::string state = utils::string::tolower(param[1]);
+    if (state == "on") {
+        m_enabled = true;
+    } else if (state == "off") {
+        m_enabled = false;
+    } else {
+        error->assign("SecCacheTransformations: invalid state: " + param[1]);
+        return false;
+    }
+
+    if (param.size() == 3) {
+        for (const std::string &option : utils::string::ssplit(param[2], ',')) {
+            std::pair<std::string, std::string> kv = \
+                utils::string::ssplit_pair(option, ':');
+            std::string name = utils::string::tolower(kv.first);
+            size_t value = 0;
+
+            if (kv.second.empty() || kv.second.find_first_not_of(
+                "0123456789") != std::string::npos) {
+                error->assign("SecCacheTransformations: invalid value " \
+                    "for option: " + option);
+                return false;
+            }
+            try {
+                value = std::stoul(kv.second);
+            } catch (const std::out_of_range &) {
+                error->assign("SecCacheTransformations: value out of " \
+                    "range for option: " + option);
+                return false;
+            } catch (const std::invalid_argument &) {
+                error->assign("SecCacheTransformations: invalid value " \
+                    "for option: " + option);
+                return false;
+            }
+
+            if (name == "minlen") {
+                m_minLength = value;
+            } else if (name == "maxlen") {
+                m_maxLength = value;
+            } else if (name == "maxsize") {
+                m_maxSize = value;
+            } else {
+                error->assign("SecCacheTransformations: unknown option: " \
+                    + kv.first);
+                return false;
+            }
+        }
+    }
+
+    m_set = true;
+    return true;
 }
 
 
@@ -0,0 +1,297 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "modsecurity/rules_set_router.h"
+
+#include <string.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_handle.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/transaction.h"
+
+
+namespace modsecurity {
+
+
+RulesSetRouter::RulesSetRouter(ModSecurity *ms)
+    : m_ms(ms),
+    m_wildcards(0),
+    m_default(nullptr) { }
+
+
+RulesSetRouter::~RulesSetRouter() { }
+
+
+void RulesSetRouter::setBase(RulesSet *base) {
+    m_base.reset(base);
+}
+
+
+RulesSet *RulesSetRouter::newOverlay(std::string *error) {
+    if (m_base == nullptr) {
+        error->assign("The router has no base to make an overlay of.");
+        return nullptr;
+    }
+
+    RulesSet *rules = new RulesSet();
+    if (rules->setBase(m_base) < 0) {
+        error->assign(rules->getParserError());
+        delete rules;
+        return nullptr;
+    }
+    return rules;
+}
+
+
+/*
+ * Lower case, without the port nor a trailing dot. An IPv6 literal keeps
+ * its brackets, for the port to be told apart from the address.
+ */
+bool RulesSetRouter::normalise(const char *host, size_t length,
+    std::string *name) {
+    size_t end = length;
+    if (length > 0 && host[0] == '[') {
+        const void *close = memchr(host, ']', length);
+        if (close == NULL) {
+            return false;
+        }
+        end = static_cast<const char *>(close) - host + 1;
+    } else {
+        const void *colon = memchr(host, ':', length);
+        if (colon != NULL) {
+            end = static_cast<const char *>(colon) - host;
+        }
+    }
+    if (end > 0 && host[end - 1] == '.') {
+        end--;
+    }
+    if (end == 0) {
+        return false;
+    }
+
+    name->resize(end);
+    for (size_t i = 0; i < end; i++) {
+        char c = host[i];
+        (*name)[i] = (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+    }
+    return true;
+}
+
+
+bool RulesSetRouter::addRoute(const std::string &host, RulesHandle *handle,
+    std::string *error) {
+    if (host == "*") {
+        if (m_default != nullptr) {
+            error->assign("The default route is already set.");
+            return false;
+        }
+        m_default = handle;
+        return true;
+    }
+
+    bool wildcard = host.compare(0, 2, "*.") == 0;
+    std::string given(host, wildcard ? 2 : 0);
+    std::string name;
+    if (given.find_first_of("*:[]") != std::string::npos
+        || given.find("..") != std::string::npos
+        || given.compare(0, 1, ".") == 0
+        || !normalise(given.c_str(), given.size(), &name)) {
+        error->assign("Invalid host name for a route: " + host);
+        return false;
+    }
+
+    if (!wildcard) {
+        if (m_exact.emplace(name, handle).second == false) {
+            error->assign("Host already routed: " + host);
+            return false;
+        }
+        return true;
+    }
+
+    Node *node = &m_root;
+    size_t end = name.size();
+    while (true) {
+        size_t dot = name.rfind('.', end - 1);
+        size_t begin = dot == std::string::npos ? 0 : dot + 1;
+        std::unique_ptr<Node> &child = node->m_children[
+            name.substr(begin, end - begin)];
+        if (child == nullptr) {
+            child.reset(new Node());
+        }
+        node = child.get();
+        if (dot == std::string::npos) {
+            break;
+        }
+        end = dot;
+    }
+    if (node->m_handle != nullptr) {
+        error->assign("Host already routed: " + host);
+        return false;
+    }
+    node->m_handle = handle;
+    m_wildcards++;
+    return true;
+}
+
+
+bool RulesSetRouter::addRoute(const std::string &host, RulesSet *rules,
+    std::string *error) {
+    return addRoute(host, m_ms->createRulesHandle(rules), error);
+}
+
+
+/*
+ * One hash lookup for an exact name; otherwise a walk from the last
+ * label, keeping the deepest wildcard that still leaves a label of host
+ * on its left. The per thread buffers keep the lookup off the allocator.
+ */
+RulesHandle *RulesSetRouter::route(const char *host, size_t length) const {
+    thread_local std::string name;
+    thread_local std::string label;
+
+    if (!normalise(host, length, &name)) {
+        return m_default;
+    }
+
+    if (!m_exact.empty()) {
+        auto it = m_exact.find(name);
+        if (it != m_exact.end()) {
+            return it->second;
+        }
+    }
+
+    RulesHandle *found = m_default;
+    const Node *node = &m_root;
+    size_t end = name.size();
+    while (m_wildcards > 0 && end > 0) {
+        size_t dot = name.rfind('.', end - 1);
+        size_t begin = dot == std::string::npos ? 0 : dot + 1;
+        label.assign(name, begin, end - begin);
+        auto it = node->m_children.find(label);
+        if (it == node->m_children.end()) {
+            break;
+        }
+        node = it->second.get();
+        if (dot == std::string::npos) {
+            break;
+        }
+        if (node->m_handle != nullptr) {
+            found = node->m_handle;
+        }
+        end = dot;
+    }
+    return found;
+}
+
+
+Transaction *RulesSetRouter::newTransaction(const std::string &host,
+    void *logCbData) {
+    RulesHandle *handle = route(host);
+    if (handle == nullptr) {
+        return nullptr;
+    }
+    return handle->newTransaction(m_ms, logCbData);
+}
+
+
+/**
+ * @name    msc_create_rules_set_router
+ * @brief   Creates a router picking the rules by the Host header.
+ *
+ * The router is freed along with msc.
+ *
+ */
+extern "C" RulesSetRouter *msc_create_rules_set_router(ModSecurity *msc) {
+    return msc->createRulesSetRouter();
+}
+
+
+/**
+ * @name    msc_rules_set_router_set_base
+ * @brief   Sets the rules the overlays are made of; takes ownership.
+ *
+ */
+extern "C" void msc_rules_set_router_set_base(RulesSetRouter *router,
+    RulesSet *base) {
+    router->setBase(base);
+}
+
+
+/**
+ * @name    msc_rules_set_router_new_overlay
+ * @brief   Creates an empty set on top of the base of the router.
+ *
+ * @return The new set, to be loaded with the rules of a tenant, or NULL.
+ *
+ * @note On failure error is set and has to be freed by the caller.
+ *
+ */
+extern "C" RulesSet *msc_rules_set_router_new_overlay(RulesSetRouter *router,
+    const char **error) {
+    std::string e;
+    RulesSet *rules = router->newOverlay(&e);
+    if (rules == nullptr) {
+        *error = strdup(e.c_str());
+    }
+    return rules;
+}
+
+
+/**
+ * @name    msc_rules_set_router_add
+ * @brief   Routes host, "*.suffix" or "*" (the default route) to handle.
+ *
+ * @return 0 on success, -1 if host is invalid or already routed.
+ *
+ * @note On failure error is set and has to be freed by the caller.
+ *
+ */
+extern "C" int msc_rules_set_router_add(RulesSetRouter *router,
+    const char *host, RulesHandle *handle, const char **error) {
+    std::string e;
+    if (!router->addRoute(std::string(host), handle, &e)) {
+        *error = strdup(e.c_str());
+        return -1;
+    }
+    return 0;
+}
+
+
+extern "C" RulesHandle *msc_rules_set_router_route(RulesSetRouter *router,
+    const char *host) {
+    return router->route(host, strlen(host));
+}
+
+
+/**
+ * @name    msc_new_transaction_from_router
+ * @brief   Creates a transaction on the rules routed for host.
+ *
+ * @return NULL when no route matches host.
+ *
+ */
+extern "C" Transaction *msc_new_transaction_from_router(
+    RulesSetRouter *router, const char *host, void *logCbData) {
+    return router->newTransaction(std::string(host), logCbData);
+}
+
+
+}  // namespace modsecurity
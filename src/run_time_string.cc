@@ -31,17 +31,23 @@ namespace modsecurity {
 
 
 void RunTimeString::appendText(const std::string &text) {
-    std::unique_ptr<RunTimeElementHolder> r(new RunTimeElementHolder);
-    r->m_string = text;
-    m_elements.push_back(std::move(r));
+    if (text.empty()) {
+        return;
+    }
+    m_literalSize += text.size();
+    if (!m_elements.empty() && m_elements.back().m_var == nullptr) {
+        m_elements.back().m_string.append(text);
+        return;
+    }
+    m_elements.emplace_back();
+    m_elements.back().m_string = text;
 }
 
 
 void RunTimeString::appendVar(
     std::unique_ptr<modsecurity::variables::Variable> var) {
-    std::unique_ptr<RunTimeElementHolder> r(new RunTimeElementHolder);
-    r->m_var = std::move(var);
-    m_elements.push_back(std::move(r));
+    m_elements.emplace_back();
+    m_elements.back().m_var = std::move(var);
     m_containsMacro = true;
 }
 
@@ -53,23 +59,28 @@ std::string RunTimeString::evaluate(Transaction *t) {
 
 std::string RunTimeString::evaluate(Transaction *t, Rule *r) {
     std::string s;
+    evaluate(t, r, &s);
+    return s;
+}
+
+
+void RunTimeString::evaluate(Transaction *t, Rule *r, std::string *out) {
+    RuleWithOperator *rr = nullptr;
+    bool resolved = false;
+
+    out->reserve(out->size() + m_literalSize);
     for (auto &z : m_elements) {
-        if (z->m_string.size() > 0) {
-            s.append(z->m_string);
-        } else if (z->m_var != NULL && t != NULL) {
-            std::vector<const VariableValue *> l;
-            // FIXME: This cast should be removed.
-            RuleWithOperator *rr = dynamic_cast<RuleWithOperator *>(r);
-            z->m_var->evaluate(t, rr, &l);
-            if (l.size() > 0) {
-                s.append(l[0]->getValue());
-            }
-            for (auto &i : l) {
-                delete i;
+        if (z.m_var == nullptr) {
+            out->append(z.m_string);
+        } else if (t != NULL) {
+            if (!resolved) {
+                // FIXME: This cast should be removed.
+                rr = dynamic_cast<RuleWithOperator *>(r);
+                resolved = true;
             }
+            z.m_var->evaluateFirst(t, rr, out);
         }
     }
-    return s;
 }
 
 }  // namespace modsecurity
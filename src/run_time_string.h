@@ -42,22 +42,37 @@ class RunTimeElementHolder {
     std::string m_string;
 };
 
+/**
+ * A string with macros in it, kept as it was parsed: literal spans, with
+ * the adjacent ones merged, and the variables in between. Evaluating it
+ * appends the spans and the first value of each variable, in order.
+ */
 class RunTimeString {
  public:
     RunTimeString() :
-        m_containsMacro(false) { }
+        m_containsMacro(false),
+        m_literalSize(0) { }
     void appendText(const std::string &text);
     void appendVar(std::unique_ptr<modsecurity::variables::Variable> var);
     std::string evaluate(Transaction *t);
     std::string evaluate(Transaction *t, Rule *r);
+    /**
+     * Appends the expansion to out, so that a caller evaluating over and
+     * over can keep reusing the same buffer.
+     */
+    void evaluate(Transaction *t, Rule *r, std::string *out);
     std::string evaluate() {
         return evaluate(NULL);
     }
     inline bool containsMacro() const { return m_containsMacro; }
+    const std::vector<RunTimeElementHolder> &elements() const {
+        return m_elements;
+    }
     bool m_containsMacro;
 
  protected:
-    std::list<std::unique_ptr<RunTimeElementHolder>> m_elements;
+    std::vector<RunTimeElementHolder> m_elements;
+    size_t m_literalSize;
 };
 
 
@@ -0,0 +1,178 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/shadow_transaction.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rule_message.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/transaction.h"
+#include "src/utils/metrics.h"
+
+
+namespace modsecurity {
+
+
+const size_t ShadowTransaction::kDefaultThreads;
+const size_t ShadowTransaction::kDefaultQueueLimit;
+
+
+namespace {
+
+
+void headersOf(AnchoredSetVariable *headers,
+    std::vector<std::pair<std::string, std::string>> *out) {
+    std::vector<const VariableValue *> l;
+    headers->resolve(&l);
+    out->reserve(l.size());
+    for (const VariableValue *h : l) {
+        out->emplace_back(h->getKey(), h->getValue());
+        delete h;
+    }
+}
+
+
+}  // namespace
+
+
+ShadowTransaction::ShadowTransaction(Transaction *transaction,
+    std::shared_ptr<RulesSet> rules)
+    : m_rules(std::move(rules)),
+    m_id(transaction->m_id),
+    m_clientIpAddress(transaction->m_clientIpAddress),
+    m_serverIpAddress(transaction->m_serverIpAddress),
+    m_clientPort(transaction->m_clientPort),
+    m_serverPort(transaction->m_serverPort),
+    m_uri(transaction->m_uri),
+    m_method(transaction->m_variableRequestMethod.m_value),
+    m_httpVersion(transaction->m_httpVersion),
+    m_responseStatus(-1),
+    m_outcome(outcomeOf(transaction)) {
+    headersOf(&transaction->m_variableRequestHeaders, &m_requestHeaders);
+    m_requestBody.swap(transaction->m_requestBody);
+
+    if (transaction->m_variableResponseStatus.m_value.empty() == false) {
+        m_responseStatus = transaction->m_httpCodeReturned;
+        m_responseProtocol = transaction->m_variableResponseProtocol.m_value;
+        headersOf(&transaction->m_variableResponseHeaders,
+            &m_responseHeaders);
+        m_responseBody.swap(transaction->m_responseBody);
+    }
+}
+
+
+ShadowTransaction::Outcome ShadowTransaction::outcomeOf(
+    const Transaction *transaction) {
+    Outcome outcome;
+
+    outcome.m_disruptive = transaction->m_intervened
+        || transaction->m_it.disruptive;
+    outcome.m_status = transaction->m_it.status;
+    for (const RuleMessage &rm : transaction->m_rulesMessages) {
+        outcome.m_ruleIds.push_back(rm.m_ruleId);
+    }
+    std::sort(outcome.m_ruleIds.begin(), outcome.m_ruleIds.end());
+    outcome.m_ruleIds.erase(std::unique(outcome.m_ruleIds.begin(),
+        outcome.m_ruleIds.end()), outcome.m_ruleIds.end());
+
+    return outcome;
+}
+
+
+std::string ShadowTransaction::Outcome::toString() const {
+    std::string s(m_disruptive ? "intervention " + std::to_string(m_status)
+        : "no intervention");
+
+    s.append(", rules:");
+    for (int id : m_ruleIds) {
+        s.append(" " + std::to_string(id));
+    }
+    if (m_ruleIds.empty()) {
+        s.append(" none");
+    }
+    return s;
+}
+
+
+/**
+ * Goes through the phases the way the connector did, up to where it
+ * stopped, and as a connector would stop when the shadow rules intervene.
+ *
+ */
+void ShadowTransaction::run(ModSecurity *ms) {
+    std::vector<char> id(m_id->begin(), m_id->end());
+    id.push_back('\0');
+    Transaction transaction(ms, m_rules.get(), id.data(), nullptr);
+    Transaction *t = &transaction;
+    t->m_shadow = true;
+    t->m_secRuleEngine = RulesSetProperties::EnabledRuleEngine;
+
+    t->processConnection(m_clientIpAddress->c_str(), m_clientPort,
+        m_serverIpAddress->c_str(), m_serverPort);
+    t->processURI(m_uri.c_str(), m_method.c_str(), m_httpVersion.c_str());
+    for (const auto &h : m_requestHeaders) {
+        t->addRequestHeader(h.first, h.second);
+    }
+    t->processRequestHeaders();
+
+    for (size_t i = 0; i < m_requestBody.chunkCount()
+        && t->m_it.disruptive == false; i++) {
+        size_t len;
+        const char *c = m_requestBody.chunk(i, &len);
+        t->appendRequestBody(reinterpret_cast<const unsigned char *>(c), len);
+    }
+    if (t->m_it.disruptive == false) {
+        t->processRequestBody();
+    }
+
+    if (m_responseStatus >= 0 && t->m_it.disruptive == false) {
+        for (const auto &h : m_responseHeaders) {
+            t->addResponseHeader(h.first, h.second);
+        }
+        t->processResponseHeaders(m_responseStatus, m_responseProtocol);
+        for (size_t i = 0; i < m_responseBody.chunkCount()
+            && t->m_it.disruptive == false; i++) {
+            size_t len;
+            const char *c = m_responseBody.chunk(i, &len);
+            t->appendResponseBody(reinterpret_cast<const unsigned char *>(c),
+                len);
+        }
+        if (t->m_it.disruptive == false) {
+            t->processResponseBody();
+        }
+    }
+
+    Utils::Metrics::getInstance().increment(
+        Utils::Metrics::ShadowTransactionsCounter);
+
+    Outcome shadow = outcomeOf(t);
+    if (shadow == m_outcome) {
+        ms_dbg_a(t, 9, "Shadow rules: same outcome.");
+        return;
+    }
+    Utils::Metrics::getInstance().increment(
+        Utils::Metrics::ShadowDifferencesCounter);
+    ms_dbg_a(t, 3, "Shadow rules: different outcome. Transaction: " \
+        + m_outcome.toString() + ". Shadow: " + shadow.toString() + ".");
+}
+
+
+}  // namespace modsecurity
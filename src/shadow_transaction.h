@@ -0,0 +1,105 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "modsecurity/body_buffer.h"
+
+#ifndef SRC_SHADOW_TRANSACTION_H_
+#define SRC_SHADOW_TRANSACTION_H_
+
+
+namespace modsecurity {
+class ModSecurity;
+class RulesSet;
+class Transaction;
+
+
+/**
+ * What a finished transaction was given and what came out of it, to run
+ * it again against SecShadowRules on the shadow runner of its ModSecurity
+ * (see ModSecurity::setShadowThreads), off the path of the request.
+ *
+ * The transaction is done with by the time it is taken: the addresses and
+ * the id are shared with it, the bodies are moved out of it, only the
+ * headers are copied. The replay runs with the engine On, so that the
+ * interventions of both can be told apart, and nothing of it ever gets to
+ * the connector; only the differences are told, in the debug log of the
+ * shadow rules. Persistent collections are the ones of the instance, a
+ * setvar of the shadow rules on them is seen by the live transactions.
+ *
+ */
+class ShadowTransaction {
+ public:
+    static const size_t kDefaultThreads = 2;
+    static const size_t kDefaultQueueLimit = 256;
+
+    ShadowTransaction(Transaction *transaction,
+        std::shared_ptr<RulesSet> rules);
+
+    ShadowTransaction(const ShadowTransaction &) = delete;
+    ShadowTransaction &operator=(const ShadowTransaction &) = delete;
+
+    void run(ModSecurity *ms);
+
+ private:
+    /* whether a disruptive intervention came out, with what status */
+    class Outcome {
+     public:
+        Outcome() : m_disruptive(false), m_status(200) { }
+
+        bool operator==(const Outcome &o) const {
+            return m_disruptive == o.m_disruptive
+                && (m_disruptive == false || m_status == o.m_status)
+                && m_ruleIds == o.m_ruleIds;
+        }
+
+        std::string toString() const;
+
+        bool m_disruptive;
+        int m_status;
+        /* of the rules that matched, sorted */
+        std::vector<int> m_ruleIds;
+    };
+
+    static Outcome outcomeOf(const Transaction *transaction);
+
+    std::shared_ptr<RulesSet> m_rules;
+    std::shared_ptr<std::string> m_id;
+    std::shared_ptr<std::string> m_clientIpAddress;
+    std::shared_ptr<std::string> m_serverIpAddress;
+    int m_clientPort;
+    int m_serverPort;
+    std::string m_uri;
+    std::string m_method;
+    std::string m_httpVersion;
+    std::vector<std::pair<std::string, std::string>> m_requestHeaders;
+    BodyBuffer m_requestBody;
+    /* -1 when the transaction did not get as far as the response */
+    int m_responseStatus;
+    std::string m_responseProtocol;
+    std::vector<std::pair<std::string, std::string>> m_responseHeaders;
+    BodyBuffer m_responseBody;
+    Outcome m_outcome;
+};
+
+
+}  // namespace modsecurity
+
+#endif  // SRC_SHADOW_TRANSACTION_H_
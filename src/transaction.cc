@@ -20,35 +20,67 @@
 #include <yajl/yajl_gen.h>
 #endif
 
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
 #include <stdio.h>
 #include <string.h>
+#include <strings.h>
+#include <unistd.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <ctime>
 #include <fstream>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <set>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "modsecurity/actions/action.h"
 #include "src/actions/disruptive/deny.h"
 #include "modsecurity/intervention.h"
 #include "modsecurity/modsecurity.h"
+#include "src/request_body_processor/grpc.h"
 #include "src/request_body_processor/multipart.h"
 #include "src/request_body_processor/xml.h"
 #ifdef WITH_YAJL
 #include "src/request_body_processor/json.h"
 #endif
+#ifdef WITH_SIMDJSON
+#include "src/request_body_processor/json_simd.h"
+#endif
+#include "src/actions/transformations/transformation_cache.h"
+#include "src/collection/backend/expiry.h"
+#include "src/operators/injection_cache.h"
+#include "src/operators/pm_group.h"
+#include "src/operators/rx_group.h"
 #include "modsecurity/audit_log.h"
-#include "src/unique_id.h"
+#include "src/shadow_transaction.h"
+#include "src/utils/allocator.h"
+#include "src/utils/async_runner.h"
 #include "src/utils/string.h"
 #include "src/utils/system.h"
+#include "src/utils/debug_log_buffer.h"
+#include "src/utils/debug_log_filter.h"
 #include "src/utils/decode.h"
+#include "src/utils/inflate.h"
+#include "src/utils/log_strings.h"
 #include "src/utils/random.h"
+#include "src/utils/regex_stream.h"
+#include "src/utils/metrics.h"
+#include "src/utils/msgpack.h"
+#include "src/utils/overload_guard.h"
+#include "src/utils/pair_index.h"
+#include "src/utils/rule_profiler.h"
+#include "src/utils/trace.h"
+#include "modsecurity/connection.h"
 #include "modsecurity/rule.h"
 #include "modsecurity/rule_message.h"
+#include "modsecurity/rule_with_actions.h"
 #include "modsecurity/rules_set_properties.h"
 #include "src/actions/disruptive/allow.h"
 #include "src/variables/remote_user.h"
@@ -61,6 +93,98 @@ using modsecurity::RequestBodyProcessor::XML;
 
 namespace modsecurity {
 
+
+/*
+ * Adds the time spent in the enclosing process*() call to the given
+ * timing of the transaction, whatever path it returns by. With
+ * SecTransactionTimeBudget it also sets the deadline of the call from
+ * what the previous ones left of the budget.
+ */
+class TimingScope {
+ public:
+    TimingScope(Transaction *transaction, uint64_t *timing)
+        : m_transaction(transaction),
+        m_timing(timing),
+        m_start(utils::monotonic_ns()),
+        m_released(false) {
+        const RulesSet *rules = transaction->m_rules;
+        if (rules->m_transactionTimeBudget.m_set) {
+            uint64_t budget = static_cast<uint64_t>(
+                rules->m_transactionTimeBudget.m_value) * 1000000;
+            uint64_t spent = transaction->m_timings.total;
+            transaction->m_timeBudgetDeadline = m_start
+                + (spent < budget ? budget - spent : 0);
+        }
+    }
+
+    ~TimingScope() {
+        if (m_released == false) {
+            account();
+        }
+    }
+
+    /*
+     * Stops here, for a call whose phase goes on on another thread (see
+     * Transaction::suspend), which then times it in a scope of its own.
+     */
+    uint64_t *release() {
+        account();
+        m_released = true;
+        return m_timing;
+    }
+
+ private:
+    void account() {
+        uint64_t elapsed = utils::monotonic_ns() - m_start;
+        *m_timing += elapsed;
+        m_transaction->m_timings.total += elapsed;
+        m_transaction->m_timeBudgetDeadline = 0;
+        if (Utils::Trace::enabled(m_transaction)) {
+            Utils::Trace::span(m_transaction, name(), m_start, elapsed);
+        }
+    }
+
+    const char *name() const {
+        const ModSecurityTimings &t = m_transaction->m_timings;
+        if (m_timing == &t.request_headers) {
+            return "request_headers";
+        }
+        if (m_timing == &t.request_body) {
+            return "request_body";
+        }
+        if (m_timing == &t.response_headers) {
+            return "response_headers";
+        }
+        if (m_timing == &t.response_body) {
+            return "response_body";
+        }
+        return "logging";
+    }
+
+    Transaction *m_transaction;
+    uint64_t *m_timing;
+    uint64_t m_start;
+    bool m_released;
+};
+
+
+/*
+ * The id of a transaction the connector gave no id to, in the format
+ * picked by SecTransactionIdFormat.
+ */
+static std::string *newTransactionId(const RulesSet *rules,
+    time_t timeStamp) {
+    if (rules->m_transactionIdFormat.m_set
+        && rules->m_transactionIdFormat.m_value
+            == RulesSetProperties::TransactionIdRandom) {
+        return new std::string(std::to_string(timeStamp)
+            + std::to_string(utils::generate_transaction_unique_id()));
+    }
+    return new std::string(
+        utils::generate_sequential_transaction_id(timeStamp));
+}
+
+
 /**
  * @name    Transaction
  * @brief   Represents the inspection on an entire request.
@@ -100,8 +224,10 @@ namespace modsecurity {
  *
  */
 Transaction::Transaction(ModSecurity *ms, RulesSet *rules, void *logCbData)
-    : m_creationTimeStamp(utils::cpu_seconds()),
+    : m_creationTimeStamp(utils::monotonic_ns()),
      m_clientIpAddress(std::make_shared<std::string>("")),
+    m_clientIpFamily(0),
+    m_connection(NULL),
     m_httpVersion(""),
     m_serverIpAddress(std::make_shared<std::string>("")),
     m_uri(""),
@@ -114,7 +240,7 @@ Transaction::Transaction(ModSecurity *ms, RulesSet *rules, void *logCbData)
     m_ms(ms),
     m_requestBodyType(UnknownFormat),
     m_requestBodyProcessor(UnknownFormat),
-    m_rules(rules),
+    m_rules(rules->replica()),
     m_ruleRemoveById(),
     m_ruleRemoveByIdRange(),
     m_ruleRemoveByTag(),
@@ -126,6 +252,9 @@ Transaction::Transaction(ModSecurity *ms, RulesSet *rules, void *logCbData)
     m_rulesMessages(),
     m_requestBody(),
     m_responseBody(),
+    m_responseBodyStreamed(0),
+    m_streamingResponseBody(false),
+    m_responseBodyMatches(),
     /* m_id(), */
     m_skip_next(0),
     m_allowType(modsecurity::actions::disruptive::NoneAllowType),
@@ -137,16 +266,37 @@ Transaction::Transaction(ModSecurity *ms, RulesSet *rules, void *logCbData)
         ms->m_session_collection, ms->m_user_collection,
         ms->m_resource_collection),
     m_matched(),
-#ifdef WITH_LIBXML2
-    m_xml(new RequestBodyProcessor::XML(this)),
-#else
     m_xml(NULL),
-#endif
-#ifdef WITH_YAJL
-    m_json(new RequestBodyProcessor::JSON(this)),
-#else
     m_json(NULL),
-#endif
+    m_grpc(NULL),
+    m_requestCookiesIndex(NULL),
+    m_requestHeadersNamesIndex(NULL),
+    m_transformationCache(NULL),
+    m_injectionCache(new operators::InjectionCache()),
+    m_pmGroupCache(new operators::PmGroupCache()),
+    m_rxGroupCache(new operators::RxGroupCache()),
+    m_requestBodyStreams(NULL),
+    m_requestBodyInflate(NULL),
+    m_responseBodyInflate(NULL),
+    m_ruleProfile(NULL),
+    m_rulePrefetches(NULL),
+    m_overloadLevel(0),
+    m_timeBudgetDeadline(0),
+    m_timeBudgetChecks(0),
+    m_timeBudgetExceeded(false),
+    m_memoryUsed(0),
+    m_memoryLimitExceeded(false),
+    m_debugBufferLevel(-1),
+    m_debugBuffer(NULL),
+    m_intervened(false),
+    m_shadow(false),
+    m_debugLevel(-1),
+    m_debugScopeLevel(-1),
+    m_debugAddressLevel(-1),
+    m_verdictKey(),
+    m_verdictHit(false),
+    m_timings(),
+    m_traceParent(nullptr),
     m_secRuleEngine(RulesSetProperties::PropertyNotSetRuleEngine),
     m_variableDuration(""),
     m_variableEnvs(),
@@ -160,15 +310,44 @@ Transaction::Transaction(ModSecurity *ms, RulesSet *rules, void *logCbData)
     m_variableTimeSec(""),
     m_variableTimeWDay(""),
     m_variableTimeYear(""),
+    m_nonBlocking(false),
+    m_asyncFds{-1, -1},
+    m_suspended(false),
     m_logCbData(logCbData),
     TransactionAnchoredVariables(this) {
-    m_id = std::unique_ptr<std::string>( new std::string(
-        std::to_string(m_timeStamp)
-        + std::to_string(modsecurity::utils::generate_transaction_unique_id())));
+    m_id = std::unique_ptr<std::string>(
+        newTransactionId(m_rules, m_timeStamp));
+
+    if (m_rules->m_debugBufferFlush != NULL && m_rules->m_debugLog != NULL
+        && m_rules->m_debugLogBufferLevel.m_value
+            > m_rules->m_debugLog->m_debugLevel) {
+        m_debugBufferLevel = m_rules->m_debugLogBufferLevel.m_value;
+        m_debugBuffer = new Utils::DebugLogBuffer(
+            m_rules->m_debugLogBufferSize.m_value);
+    }
+    setDebugAddress();
 
     m_variableUrlEncodedError.set("0", 0);
     m_variableMscPcreError.set("0", 0);
     m_variableMscPcreLimitsExceeded.set("0", 0);
+    m_variableMscTimeBudgetExceeded.set("0", 0);
+    m_variableMscMemoryLimitExceeded.set("0", 0);
+
+    if (m_rules->m_transformationsCache.m_enabled) {
+        m_transformationCache = new actions::transformations::TransformationCache(
+            m_rules->m_transformationsCache);
+    }
+
+    m_ruleProfiler = std::atomic_load(&m_rules->m_ruleProfiler);
+    if (m_ruleProfiler != NULL) {
+        m_ruleProfile = m_ruleProfiler->sample();
+        if (m_ruleProfile == NULL) {
+            m_ruleProfiler = nullptr;
+        }
+    }
+
+    Utils::Metrics::getInstance().increment(
+        Utils::Metrics::TransactionsCounter);
 
     ms_dbg(4, "Initializing transaction");
 
@@ -176,8 +355,10 @@ Transaction::Transaction(ModSecurity *ms, RulesSet *rules, void *logCbData)
 }
 
 Transaction::Transaction(ModSecurity *ms, RulesSet *rules, char *id, void *logCbData)
-    : m_creationTimeStamp(utils::cpu_seconds()),
+    : m_creationTimeStamp(utils::monotonic_ns()),
     m_clientIpAddress(std::make_shared<std::string>("")),
+    m_clientIpFamily(0),
+    m_connection(NULL),
     m_httpVersion(""),
     m_serverIpAddress(std::make_shared<std::string>("")),
     m_uri(""),
@@ -190,7 +371,7 @@ Transaction::Transaction(ModSecurity *ms, RulesSet *rules, char *id, void *logCb
     m_ms(ms),
     m_requestBodyType(UnknownFormat),
     m_requestBodyProcessor(UnknownFormat),
-    m_rules(rules),
+    m_rules(rules->replica()),
     m_ruleRemoveById(),
     m_ruleRemoveByIdRange(),
     m_ruleRemoveByTag(),
@@ -202,6 +383,9 @@ Transaction::Transaction(ModSecurity *ms, RulesSet *rules, char *id, void *logCb
     m_rulesMessages(),
     m_requestBody(),
     m_responseBody(),
+    m_responseBodyStreamed(0),
+    m_streamingResponseBody(false),
+    m_responseBodyMatches(),
     m_id(std::unique_ptr<std::string>(new std::string(id))),
     m_skip_next(0),
     m_allowType(modsecurity::actions::disruptive::NoneAllowType),
@@ -213,16 +397,37 @@ Transaction::Transaction(ModSecurity *ms, RulesSet *rules, char *id, void *logCb
         ms->m_session_collection, ms->m_user_collection,
         ms->m_resource_collection),
     m_matched(),
-#ifdef WITH_LIBXML2
-    m_xml(new RequestBodyProcessor::XML(this)),
-#else
     m_xml(NULL),
-#endif
-#ifdef WITH_YAJL
-    m_json(new RequestBodyProcessor::JSON(this)),
-#else
     m_json(NULL),
-#endif
+    m_grpc(NULL),
+    m_requestCookiesIndex(NULL),
+    m_requestHeadersNamesIndex(NULL),
+    m_transformationCache(NULL),
+    m_injectionCache(new operators::InjectionCache()),
+    m_pmGroupCache(new operators::PmGroupCache()),
+    m_rxGroupCache(new operators::RxGroupCache()),
+    m_requestBodyStreams(NULL),
+    m_requestBodyInflate(NULL),
+    m_responseBodyInflate(NULL),
+    m_ruleProfile(NULL),
+    m_rulePrefetches(NULL),
+    m_overloadLevel(0),
+    m_timeBudgetDeadline(0),
+    m_timeBudgetChecks(0),
+    m_timeBudgetExceeded(false),
+    m_memoryUsed(0),
+    m_memoryLimitExceeded(false),
+    m_debugBufferLevel(-1),
+    m_debugBuffer(NULL),
+    m_intervened(false),
+    m_shadow(false),
+    m_debugLevel(-1),
+    m_debugScopeLevel(-1),
+    m_debugAddressLevel(-1),
+    m_verdictKey(),
+    m_verdictHit(false),
+    m_timings(),
+    m_traceParent(nullptr),
     m_secRuleEngine(RulesSetProperties::PropertyNotSetRuleEngine),
     m_variableDuration(""),
     m_variableEnvs(),
@@ -236,12 +441,42 @@ Transaction::Transaction(ModSecurity *ms, RulesSet *rules, char *id, void *logCb
     m_variableTimeSec(""),
     m_variableTimeWDay(""),
     m_variableTimeYear(""),
+    m_nonBlocking(false),
+    m_asyncFds{-1, -1},
+    m_suspended(false),
     m_logCbData(logCbData),
     TransactionAnchoredVariables(this) {
 
+    if (m_rules->m_debugBufferFlush != NULL && m_rules->m_debugLog != NULL
+        && m_rules->m_debugLogBufferLevel.m_value
+            > m_rules->m_debugLog->m_debugLevel) {
+        m_debugBufferLevel = m_rules->m_debugLogBufferLevel.m_value;
+        m_debugBuffer = new Utils::DebugLogBuffer(
+            m_rules->m_debugLogBufferSize.m_value);
+    }
+    setDebugAddress();
+
     m_variableUrlEncodedError.set("0", 0);
     m_variableMscPcreError.set("0", 0);
     m_variableMscPcreLimitsExceeded.set("0", 0);
+    m_variableMscTimeBudgetExceeded.set("0", 0);
+    m_variableMscMemoryLimitExceeded.set("0", 0);
+
+    if (m_rules->m_transformationsCache.m_enabled) {
+        m_transformationCache = new actions::transformations::TransformationCache(
+            m_rules->m_transformationsCache);
+    }
+
+    m_ruleProfiler = std::atomic_load(&m_rules->m_ruleProfiler);
+    if (m_ruleProfiler != NULL) {
+        m_ruleProfile = m_ruleProfiler->sample();
+        if (m_ruleProfile == NULL) {
+            m_ruleProfiler = nullptr;
+        }
+    }
+
+    Utils::Metrics::getInstance().increment(
+        Utils::Metrics::TransactionsCounter);
 
     ms_dbg(4, "Initializing transaction");
 
@@ -250,10 +485,17 @@ Transaction::Transaction(ModSecurity *ms, RulesSet *rules, char *id, void *logCb
 
 
 Transaction::~Transaction() {
-    m_responseBody.str(std::string());
-    m_responseBody.clear();
+    wait();
+    shadow();
+    flushDebugBuffer();
+    flushCollections();
+    delete m_debugBuffer;
+    if (m_asyncFds[0] >= 0) {
+        close(m_asyncFds[0]);
+        close(m_asyncFds[1]);
+    }
 
-    m_requestBody.str(std::string());
+    m_responseBody.clear();
     m_requestBody.clear();
 
     m_rulesMessages.clear();
@@ -267,6 +509,267 @@ Transaction::~Transaction() {
 #ifdef WITH_LIBXML2
     delete m_xml;
 #endif
+    delete m_grpc;
+    delete m_requestCookiesIndex;
+    delete m_requestHeadersNamesIndex;
+    delete m_transformationCache;
+    delete m_injectionCache;
+    delete m_pmGroupCache;
+    delete m_rxGroupCache;
+    delete m_requestBodyStreams;
+    delete m_requestBodyInflate;
+    delete m_responseBodyInflate;
+
+    if (m_rules->m_overloadGuard != NULL && m_timings.total > 0) {
+        m_rules->m_overloadGuard->observe(m_timings.total);
+    }
+}
+
+
+/**
+ * @name    reset
+ * @brief   Recycles the transaction so it can be used on a new request.
+ *
+ * Everything that is request scoped goes back to the state it had right
+ * after the construction, the rules, the ModSecurity core and the log
+ * callback data are kept. Containers are cleared instead of destroyed, so
+ * a connector that keeps a Transaction around (e.g. per connection or per
+ * worker) saves most of the allocations that a new Transaction costs.
+ *
+ * @note processLogging must be called before the reset, as it is before
+ *       the destruction.
+ *
+ */
+void Transaction::reset() {
+    resetTransaction();
+
+    m_id = std::unique_ptr<std::string>(
+        newTransactionId(m_rules, m_timeStamp));
+
+    ms_dbg(4, "Recycling transaction");
+}
+
+
+/**
+ * @name    reset
+ * @brief   Same as reset(), but using the given unique id.
+ *
+ * @param id Unique id for the transaction that follows.
+ *
+ */
+void Transaction::reset(char *id) {
+    resetTransaction();
+
+    m_id = std::unique_ptr<std::string>(new std::string(id));
+
+    ms_dbg(4, "Recycling transaction");
+}
+
+
+void Transaction::resetTransaction() {
+    wait();
+    shadow();
+    flushDebugBuffer();
+    m_intervened = false;
+    if (m_rules->m_overloadGuard != NULL && m_timings.total > 0) {
+        m_rules->m_overloadGuard->observe(m_timings.total);
+    }
+    m_creationTimeStamp = utils::monotonic_ns();
+    m_timings = ModSecurityTimings();
+    m_traceParent = nullptr;
+    Utils::Metrics::getInstance().increment(
+        Utils::Metrics::TransactionsCounter);
+    m_clientIpAddress = std::make_shared<std::string>("");
+    m_clientIpFamily = 0;
+    m_connection = NULL;
+    m_httpVersion.clear();
+    m_serverIpAddress = std::make_shared<std::string>("");
+    m_uri.clear();
+    m_uri_no_query_string_decoded = std::make_shared<std::string>("");
+    m_ARGScombinedSizeDouble = 0;
+    m_clientPort = 0;
+    m_highestSeverityAction = 255;
+    m_httpCodeReturned = 200;
+    m_serverPort = 0;
+    m_requestBodyType = UnknownFormat;
+    m_requestBodyProcessor = UnknownFormat;
+    m_ruleRemoveById.clear();
+    m_ruleRemoveByIdRange.clear();
+    m_ruleRemoveByTag.clear();
+    m_ruleRemoveTargetByTag.clear();
+    m_ruleRemoveTargetById.clear();
+    m_requestBodyAccess = RulesSet::PropertyNotSetConfigBoolean;
+    m_auditLogModifier.clear();
+    m_ctlAuditEngine = AuditLog::AuditLogStatus::NotSetLogStatus;
+    m_rulesMessages.clear();
+    m_requestBody.clear();
+    m_responseBody.clear();
+    m_responseBodyStreamed = 0;
+    m_streamingResponseBody = false;
+    m_responseBodyMatches.clear();
+    m_skip_next = 0;
+    m_allowType = modsecurity::actions::disruptive::NoneAllowType;
+    m_uri_decoded.clear();
+    m_actions.clear();
+    m_timeStamp = std::time(NULL);
+    flushCollections();
+    m_collections.reset();
+    m_matched.clear();
+    m_secRuleEngine = RulesSetProperties::PropertyNotSetRuleEngine;
+    m_overloadLevel = 0;
+    m_timeBudgetDeadline = 0;
+    m_timeBudgetChecks = 0;
+    m_timeBudgetExceeded = false;
+    m_memoryUsed = 0;
+    m_memoryLimitExceeded = false;
+    m_verdictKey.clear();
+    m_verdictHit = false;
+    m_variableDuration.clear();
+    m_variableEnvs.clear();
+    m_variableHighestSeverityAction.clear();
+    m_variableRemoteUser.clear();
+    m_variableTime.clear();
+    m_variableTimeDay.clear();
+    m_variableTimeEpoch.clear();
+    m_variableTimeHour.clear();
+    m_variableTimeMin.clear();
+    m_variableTimeSec.clear();
+    m_variableTimeWDay.clear();
+    m_variableTimeYear.clear();
+    m_multipartPartTmpFiles.clear();
+    removeMarker();
+
+    /*
+     * The body processors keep parser state around, which is not worth
+     * rewinding by hand. They are created again if the next request
+     * needs them.
+     */
+#ifdef WITH_LIBXML2
+    delete m_xml;
+    m_xml = NULL;
+#endif
+#ifdef WITH_YAJL
+    delete m_json;
+    m_json = NULL;
+#endif
+    delete m_grpc;
+    m_grpc = NULL;
+
+    if (m_requestCookiesIndex != NULL) {
+        m_requestCookiesIndex->clear();
+    }
+    if (m_requestHeadersNamesIndex != NULL) {
+        m_requestHeadersNamesIndex->clear();
+    }
+
+    if (m_transformationCache != NULL) {
+        m_transformationCache->clear();
+    }
+    m_injectionCache->clear();
+    m_pmGroupCache->clear();
+    m_rxGroupCache->clear();
+    delete m_requestBodyStreams;
+    m_requestBodyStreams = NULL;
+    delete m_requestBodyInflate;
+    m_requestBodyInflate = NULL;
+    delete m_responseBodyInflate;
+    m_responseBodyInflate = NULL;
+
+    resetAnchoredVariables();
+    m_variableUrlEncodedError.set("0", 0);
+    m_variableMscPcreError.set("0", 0);
+    m_variableMscPcreLimitsExceeded.set("0", 0);
+    m_variableMscTimeBudgetExceeded.set("0", 0);
+    m_variableMscMemoryLimitExceeded.set("0", 0);
+
+    intervention::free(&m_it);
+    intervention::clean(&m_it);
+}
+
+
+void TransactionAnchoredVariables::resetAnchoredVariables() {
+    m_variableRequestHeadersNames.unset();
+    m_variableResponseContentType.reset();
+    m_variableResponseHeadersNames.unset();
+    m_variableARGScombinedSize.reset();
+    m_variableAuthType.reset();
+    m_variableFilesCombinedSize.reset();
+    m_variableFullRequest.reset();
+    m_variableFullRequestLength.reset();
+    m_variableInboundDataError.reset();
+    m_variableMatchedVar.reset();
+    m_variableMatchedVarName.reset();
+    m_variableMscPcreError.reset();
+    m_variableMscPcreLimitsExceeded.reset();
+    m_variableMscTimeBudgetExceeded.reset();
+    m_variableMscMemoryLimitExceeded.reset();
+    m_variableMultipartBoundaryQuoted.reset();
+    m_variableMultipartBoundaryWhiteSpace.reset();
+    m_variableMultipartCrlfLFLines.reset();
+    m_variableMultipartDataAfter.reset();
+    m_variableMultipartDataBefore.reset();
+    m_variableMultipartFileLimitExceeded.reset();
+    m_variableMultipartHeaderFolding.reset();
+    m_variableMultipartInvalidHeaderFolding.reset();
+    m_variableMultipartInvalidPart.reset();
+    m_variableMultipartInvalidQuoting.reset();
+    m_variableMultipartLFLine.reset();
+    m_variableMultipartMissingSemicolon.reset();
+    m_variableMultipartStrictError.reset();
+    m_variableMultipartUnmatchedBoundary.reset();
+    m_variableOutboundDataError.reset();
+    m_variablePathInfo.reset();
+    m_variableQueryString.reset();
+    m_variableRemoteAddr.reset();
+    m_variableRemoteHost.reset();
+    m_variableRemotePort.reset();
+    m_variableReqbodyError.reset();
+    m_variableReqbodyErrorMsg.reset();
+    m_variableReqbodyProcessorError.reset();
+    m_variableReqbodyProcessorErrorMsg.reset();
+    m_variableReqbodyProcessor.reset();
+    m_variableRequestBasename.reset();
+    m_variableRequestBody.reset();
+    m_variableRequestBodyLength.reset();
+    m_variableRequestFilename.reset();
+    m_variableRequestLine.reset();
+    m_variableRequestMethod.reset();
+    m_variableRequestProtocol.reset();
+    m_variableRequestURI.reset();
+    m_variableRequestURIRaw.reset();
+    m_variableResource.reset();
+    m_variableResponseBody.reset();
+    m_variableResponseContentLength.reset();
+    m_variableResponseProtocol.reset();
+    m_variableResponseStatus.reset();
+    m_variableServerAddr.reset();
+    m_variableServerName.reset();
+    m_variableServerPort.reset();
+    m_variableSessionID.reset();
+    m_variableUniqueID.reset();
+    m_variableUrlEncodedError.reset();
+    m_variableUserID.reset();
+
+    m_variableArgs.unset();
+    m_variableArgsGet.unset();
+    m_variableArgsPost.unset();
+    m_variableFilesSizes.unset();
+    m_variableFilesNames.unset();
+    m_variableFilesTmpContent.unset();
+    m_variableMultipartFileName.unset();
+    m_variableMultipartName.unset();
+    m_variableMatchedVarsNames.unset();
+    m_variableMatchedVars.unset();
+    m_variableFiles.unset();
+    m_variableRequestCookies.unset();
+    m_variableRequestHeaders.unset();
+    m_variableResponseHeaders.unset();
+    m_variableGeo.unset();
+    m_variableRequestCookiesNames.unset();
+    m_variableFilesTmpNames.unset();
+    m_variableMultipartPartHeaders.unset();
+
+    m_variableOffset = 0;
 }
 
 
@@ -287,10 +790,84 @@ void Transaction::debug(int level, const std::string& message) const {
         return;
     }
 
+    if (level > m_debugScopeLevel) {
+        if (m_debugBuffer != NULL && level <= m_debugBufferLevel) {
+            m_debugBuffer->add(level, message);
+        }
+        return;
+    }
     m_rules->debug(level, *m_id.get(), m_uri, message);
 }
 #endif
 
+
+/*
+ * SecDebugLogFilter by client address: worked out once the address is
+ * known, at processConnection; nothing is written before that.
+ */
+void Transaction::setDebugAddress() {
+    const Utils::DebugLogFilter *filter = m_rules->m_debugFilter;
+
+    m_debugAddressLevel = -1;
+    if (m_rules->m_debugLog != NULL && (filter == NULL
+        || filter->addressInScope(*m_clientIpAddress))) {
+        m_debugAddressLevel = m_rules->m_debugLog->m_debugLevel;
+    }
+    setDebugScope(nullptr);
+}
+
+
+/**
+ * @name    setDebugScope
+ * @brief   Tells which rule runs, for SecDebugLogFilter by rule id.
+ *
+ * Called before every rule, and with nullptr once they are over, only
+ * when SecDebugLogFilter has rule ids; the level checked by the ms_dbg
+ * macros is only worked out here.
+ *
+ * @param rule The rule about to run, nullptr for none (or a marker).
+ *
+ */
+void Transaction::setDebugScope(const RuleWithActions *rule) {
+    const Utils::DebugLogFilter *filter = m_rules->m_debugFilter;
+
+    m_debugScopeLevel = m_debugAddressLevel;
+    if (filter != NULL && filter->hasRuleIds()
+        && (rule == NULL || filter->ruleInScope(rule->m_ruleId) == false)) {
+        m_debugScopeLevel = -1;
+    }
+    m_debugLevel = std::max(m_debugScopeLevel, m_debugBufferLevel);
+}
+
+
+/*
+ * Writes the SecDebugLogBuffer of the transaction out, at level 0 with
+ * the level each message had in front of it, if SecDebugLogBufferFlush
+ * asks for it; drops it otherwise.
+ */
+void Transaction::flushDebugBuffer() {
+    if (m_debugBuffer == NULL || m_debugBuffer->messages() == 0) {
+        return;
+    }
+
+    const char *reason = m_rules->m_debugBufferFlush->reason(
+        m_intervened || m_it.disruptive, *m_clientIpAddress,
+        m_rulesMessages);
+    if (reason == NULL) {
+        m_debugBuffer->flush([](int level, const std::string &message) { });
+        return;
+    }
+
+    m_rules->debug(0, *m_id.get(), m_uri, "Debug log buffer (" \
+        + std::string(reason) + "): " \
+        + std::to_string(m_debugBuffer->messages()) + " message(s), " \
+        + std::to_string(m_debugBuffer->dropped()) + " dropped.");
+    m_debugBuffer->flush([this](int level, const std::string &message) {
+        m_rules->debug(0, *m_id.get(), m_uri,
+            "[" + std::to_string(level) + "] " + message);
+    });
+}
+
 /**
  * @name    processConnection
  * @brief   Perform the analysis on the connection.
@@ -315,12 +892,78 @@ void Transaction::debug(int level, const std::string& message) const {
 int Transaction::processConnection(const char *client, int cPort,
     const char *server, int sPort) {
     m_clientIpAddress = std::unique_ptr<std::string>(new std::string(client));
+    m_clientIpFamily = 0;
     m_serverIpAddress = std::unique_ptr<std::string>(new std::string(server));
     this->m_clientPort = cPort;
     this->m_serverPort = sPort;
+
+    return evaluateConnection();
+}
+
+
+/**
+ * @name    processConnection
+ * @brief   processConnection() for a transaction of connection.
+ *
+ * The addresses are the ones of connection, already parsed, and what the
+ * rules work out about the client is shared with the other transactions
+ * of connection (see Connection). The transaction stays attached to it
+ * until it is reset.
+ *
+ * @param connection The connection the request came in, owned by the
+ *                   caller, which has to outlive the transaction.
+ *
+ * @returns If the operation was successful or not.
+ * @retval true Operation was successful.
+ * @retval false Operation failed.
+ *
+ */
+int Transaction::processConnection(Connection *connection) {
+    m_connection = connection;
+    m_clientIpAddress = connection->m_clientIpAddress;
+    m_clientIpFamily = connection->m_clientIpFamily;
+    memcpy(m_clientIpBinary, connection->m_clientIpBinary,
+        sizeof(m_clientIpBinary));
+    m_serverIpAddress = connection->m_serverIpAddress;
+    this->m_clientPort = connection->m_clientPort;
+    this->m_serverPort = connection->m_serverPort;
+
+    return evaluateConnection();
+}
+
+
+/*
+ * Whether a DetectionOnly transaction is left out by SecRuleEngineSampleRate.
+ * key is hashed with FNV-1a, rather than std::hash, for every process of a
+ * deployment to pick the same clients.
+ */
+static bool sampledOut(const RulesSet *rules, const std::string &key) {
+    uint64_t h = 14695981039346656037ULL;
+    for (unsigned char c : key) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    return h % 10000 >= static_cast<uint64_t>(
+        rules->m_ruleEngineSampleRate.m_value);
+}
+
+
+int Transaction::evaluateConnection() {
+    if (m_rules->m_debugFilter != NULL) {
+        setDebugAddress();
+    }
     ms_dbg(4, "Transaction context created.");
     ms_dbg(4, "Starting phase CONNECTION. (SecRules 0)");
 
+    if (m_rules->m_ruleEngineSampleRate.m_set
+        && getRuleEngineState() == RulesSet::DetectionOnlyRuleEngine
+        && sampledOut(m_rules, m_rules->m_ruleEngineSampleKey.m_value == 1
+            ? *m_clientIpAddress : *m_id)) {
+        ms_dbg(4, "DetectionOnly transaction not in the sample of " \
+            "SecRuleEngineSampleRate, the rules are not evaluated.");
+        m_secRuleEngine = RulesSetProperties::DisabledRuleEngine;
+    }
+
 
     m_variableRemoteHost.set(*m_clientIpAddress.get(), m_variableOffset);
     m_variableUniqueID.set(*m_id.get(), m_variableOffset);
@@ -336,52 +979,72 @@ int Transaction::processConnection(const char *client, int cPort,
 }
 
 
+/*
+ * Copies the url-encoded [data, data + len) into out, decoded, reusing
+ * out's storage. Returns true if it has invalid encodings.
+ */
+static bool urlDecodeInto(const char *data, size_t len, std::string *out) {
+    int invalid = 0;
+    int changed = 0;
+
+    out->assign(data, len);
+    if (len == 0) {
+        return false;
+    }
+    int size = utils::urldecode_nonstrict_inplace(
+        reinterpret_cast<unsigned char *>(&(*out)[0]), len,
+        &invalid, &changed);
+    out->resize(size);
+
+    return invalid != 0;
+}
+
+
+/*
+ * Splits buf into its key=value pairs and adds them as arguments, in a
+ * single pass: the key and the value are decoded into buffers that are
+ * reused from one pair to the next. Pairs are split the way they always
+ * were, an empty pair in the middle counts as an (empty) argument, a
+ * trailing separator does not.
+ */
 bool Transaction::extractArguments(const std::string &orig,
     const std::string& buf, size_t offset) {
     char sep1 = '&';
     if (m_rules->m_secArgumentSeparator.m_set) {
         sep1 = m_rules->m_secArgumentSeparator.m_value.at(0);
     }
-    std::vector<std::string> key_value_sets = utils::string::ssplit(buf, sep1);
-
-    for (std::string t : key_value_sets) {
-        char sep2 = '=';
-        size_t key_s = 0;
-        size_t value_s = 0;
-        int invalid = 0;
-        int changed = 0;
-
-        std::string key;
-        std::string value;
-        std::pair<std::string, std::string> key_value_pair = utils::string::ssplit_pair(t, sep2);
-        key = key_value_pair.first;
-        value = key_value_pair.second;
-
-        key_s = (key.length() + 1);
-        value_s = (value.length() + 1);
-        unsigned char *key_c = reinterpret_cast<unsigned char *>(
-            calloc(sizeof(char), key_s));
-        unsigned char *value_c = reinterpret_cast<unsigned char *>(
-            calloc(sizeof(char), value_s));
-
-        memcpy(key_c, key.c_str(), key_s);
-        memcpy(value_c, value.c_str(), value_s);
-
-        key_s = utils::urldecode_nonstrict_inplace(key_c, key_s,
-            &invalid, &changed);
-        value_s = utils::urldecode_nonstrict_inplace(value_c, value_s,
-            &invalid, &changed);
+    const char sep2 = '=';
+    const char *data = buf.data();
+    const size_t size = buf.size();
+    std::string key;
+    std::string value;
+
+    size_t pos = 0;
+    while (pos < size) {
+        const char *pair = data + pos;
+        const char *end = static_cast<const char *>(
+            memchr(pair, sep1, size - pos));
+        size_t pairLen = end ? end - pair : size - pos;
+
+        const char *eq = static_cast<const char *>(
+            memchr(pair, sep2, pairLen));
+        size_t keyLen = eq ? eq - pair : pairLen;
+
+        bool invalid = urlDecodeInto(pair, keyLen, &key);
+        if (eq) {
+            invalid = urlDecodeInto(eq + 1, pairLen - keyLen - 1, &value)
+                || invalid;
+        } else {
+            value.clear();
+        }
 
         if (invalid) {
             m_variableUrlEncodedError.set("1", m_variableOffset);
         }
 
-        addArgument(orig, std::string(reinterpret_cast<char *>(key_c), key_s-1),
-            std::string(reinterpret_cast<char *>(value_c), value_s-1), offset);
-        offset = offset + t.size() + 1;
-
-        free(key_c);
-        free(value_c);
+        addArgument(orig, key, value, offset);
+        offset = offset + pairLen + 1;
+        pos = pos + pairLen + 1;
     }
 
     return true;
@@ -399,21 +1062,32 @@ bool Transaction::addArgument(const std::string& orig, const std::string& key,
         return false;
     }
 
+    if (!accountMemory(sizeof(VariableValue) + 2 * key.size()
+            + value.size())) {
+        ms_dbg(4, "Skipping request argument, over the memory limit.");
+        return false;
+    }
+
     offset = offset + key.size() + 1;
     m_variableArgs.set(key, value, offset);
 
     if (orig == "GET") {
-        m_variableArgsGet.set(key, value, offset);
+        if (m_rules->m_variablesInUse.uses(ConfigVariablesInUse::ArgsGet)) {
+            m_variableArgsGet.set(key, value, offset);
+        }
     } else if (orig == "POST") {
-        m_variableArgsPost.set(key, value, offset);
+        if (m_rules->m_variablesInUse.uses(ConfigVariablesInUse::ArgsPost)) {
+            m_variableArgsPost.set(key, value, offset);
+        }
     }
 
     m_ARGScombinedSizeDouble = m_ARGScombinedSizeDouble + \
         key.length() + value.length();
 
-    m_variableARGScombinedSize.set(std::to_string(m_ARGScombinedSizeDouble),
+    std::string combinedSize(std::to_string(m_ARGScombinedSizeDouble));
+    m_variableARGScombinedSize.set(combinedSize,
         offset - key.size() - 1, key.size());
-    m_variableARGScombinedSize.set(std::to_string(m_ARGScombinedSizeDouble),
+    m_variableARGScombinedSize.set(combinedSize,
         offset, value.length());
 
     return true;
@@ -469,6 +1143,27 @@ int Transaction::processURI(const char *uri, const char *method,
 
     m_variableRequestMethod.set(method, 0);
 
+    if (m_rules->m_overloadGuard != NULL) {
+        m_overloadLevel = m_rules->m_overloadGuard->level();
+    }
+    if (m_overloadLevel > 0) {
+        ms_dbg(4, "Overload protection at level " \
+            + std::to_string(m_overloadLevel) + ", rolling p99 of " \
+            + std::to_string(m_rules->m_overloadGuard->p99() / 1000) \
+            + " us.");
+        Utils::Metrics::getInstance().increment(
+            Utils::Metrics::OverloadTransactionsCounter);
+    }
+    if (m_overloadLevel >= 2
+        && getRuleEngineState() == RulesSet::EnabledRuleEngine
+        && m_rules->m_overloadDetectionOnly.m_value.count(method) > 0) {
+        ms_dbg(4, "Overload protection: switching the " + std::string(method) \
+            + " request to DetectionOnly.");
+        m_secRuleEngine = RulesSetProperties::DetectionOnlyRuleEngine;
+        Utils::Metrics::getInstance().increment(
+            Utils::Metrics::OverloadDetectionOnlyCounter);
+    }
+
 
     std::string requestLine(std::string(method) + " " + std::string(uri));
     m_variableRequestLine.set(requestLine \
@@ -574,6 +1269,8 @@ int Transaction::processURI(const char *uri, const char *method,
  *
  */
 int Transaction::processRequestHeaders() {
+    TimingScope timing(this, &m_timings.request_headers);
+
     ms_dbg(4, "Starting phase REQUEST_HEADERS.  (SecRules 1)");
 
     if (getRuleEngineState() == RulesSet::DisabledRuleEngine) {
@@ -581,12 +1278,98 @@ int Transaction::processRequestHeaders() {
         return true;
     }
 
+    if (suspend(modsecurity::RequestHeadersPhase, &timing, [this]() {
+            m_rules->evaluate(modsecurity::RequestHeadersPhase, this);
+        })) {
+        return MSC_AGAIN;
+    }
     this->m_rules->evaluate(modsecurity::RequestHeadersPhase, this);
 
     return true;
 }
 
 
+namespace {
+
+/*
+ * The request headers that mean something to the engine itself. Their
+ * names all have different lengths, which makes the length a perfect
+ * hash: a single case insensitive comparison tells them apart from the
+ * rest, without lowercasing the name first.
+ */
+enum RequestHeaderKind {
+    OtherHeader,
+    AuthorizationHeader,
+    ContentEncodingHeader,
+    ContentTypeHeader,
+    CookieHeader,
+    HostHeader,
+};
+
+
+struct WellKnownHeader {
+    const char *name;
+    RequestHeaderKind kind;
+};
+
+
+const WellKnownHeader wellKnownHeaders[] = {
+    { nullptr, OtherHeader },                    /* 0 */
+    { nullptr, OtherHeader },
+    { nullptr, OtherHeader },
+    { nullptr, OtherHeader },
+    { "host", HostHeader },                      /* 4 */
+    { nullptr, OtherHeader },
+    { "cookie", CookieHeader },                  /* 6 */
+    { nullptr, OtherHeader },
+    { nullptr, OtherHeader },
+    { nullptr, OtherHeader },
+    { nullptr, OtherHeader },
+    { nullptr, OtherHeader },
+    { "content-type", ContentTypeHeader },       /* 12 */
+    { "authorization", AuthorizationHeader },    /* 13 */
+    { nullptr, OtherHeader },
+    { nullptr, OtherHeader },
+    { "content-encoding", ContentEncodingHeader },  /* 16 */
+};
+
+
+RequestHeaderKind requestHeaderKind(const std::string &key) {
+    size_t size = sizeof(wellKnownHeaders) / sizeof(wellKnownHeaders[0]);
+    if (key.size() >= size) {
+        return OtherHeader;
+    }
+    const WellKnownHeader &h = wellKnownHeaders[key.size()];
+    if (h.name == nullptr || strncasecmp(key.c_str(), h.name,
+        key.size()) != 0) {
+        return OtherHeader;
+    }
+    return h.kind;
+}
+
+
+bool startsWithNoCase(const std::string &value, const char *prefix) {
+    size_t len = strlen(prefix);
+    return value.size() >= len && strncasecmp(value.c_str(), prefix,
+        len) == 0;
+}
+
+
+#ifdef WITH_YAJL
+/* Whether the JSON bodies go to simdjson rather than to yajl. */
+bool jsonSimd(const RulesSet *rules) {
+#ifdef WITH_SIMDJSON
+    return rules->m_requestBodyJsonSimd
+        != RulesSetProperties::FalseConfigBoolean;
+#else
+    return false;
+#endif
+}
+#endif
+
+}  // namespace
+
+
 /**
  * @name    addRequestHeader
  * @brief   Adds a request header
@@ -606,106 +1389,75 @@ int Transaction::processRequestHeaders() {
  */
 int Transaction::addRequestHeader(const std::string& key,
     const std::string& value) {
-    m_variableRequestHeadersNames.set(key, key, m_variableOffset);
-
-    m_variableOffset = m_variableOffset + key.size() + 2;
-    m_variableRequestHeaders.set(key, value, m_variableOffset);
+    accountMemory(sizeof(VariableValue) + 2 * key.size() + value.size());
 
-
-    std::string keyl = utils::string::tolower(key);
-    if (keyl == "authorization") {
-        std::vector<std::string> type = utils::string::split(value, ' ');
-        m_variableAuthType.set(type[0], m_variableOffset);
+    if (m_rules->m_variablesInUse.uses(
+        ConfigVariablesInUse::RequestHeadersNames)) {
+        if (m_requestHeadersNamesIndex == NULL) {
+            m_requestHeadersNamesIndex = new Utils::PairIndex();
+        }
+        m_requestHeadersNamesIndex->add(key, m_variableOffset,
+            std::string(), 0);
+        m_variableRequestHeadersNames.setSource(
+            m_requestHeadersNamesIndex->names());
     }
 
-    if (keyl == "cookie") {
-        size_t localOffset = m_variableOffset;
-        size_t pos;
+    m_variableOffset = m_variableOffset + key.size() + 2;
+    m_variableRequestHeaders.set(key, value, m_variableOffset);
 
-        std::vector<std::string> cookies = utils::string::ssplit(value, ';');
 
-        if (!cookies.empty()) {
-            // Get rid of any optional whitespace after the cookie-string
-            // (i.e. after the end of the final cookie-pair)
-            std::string& final_cookie_pair = cookies.back();
-            while (!final_cookie_pair.empty() && isspace(final_cookie_pair.back())) {
-                final_cookie_pair.pop_back();
-            }
+    switch (requestHeaderKind(key)) {
+    case AuthorizationHeader:
+        if (m_rules->m_variablesInUse.uses(ConfigVariablesInUse::AuthType)) {
+            m_variableAuthType.set(value.substr(0, value.find(' ')),
+                m_variableOffset);
         }
-
-        for (const std::string &c : cookies) {
-            // skip empty substring, eg "Cookie: ;;foo=bar"
-            if (c.empty() == true) {
-                localOffset++; // add length of ';'
-                continue;
-            }
-
-            // find the first '='
-            pos = c.find_first_of("=", 0);
-            std::string ckey = "";
-            std::string cval = "";
-
-            // if the cookie doesn't contains '=', its just a key
-            if (pos == std::string::npos) {
-                ckey = c;
-            }
-            // else split to two substrings by first =
-            else {
-                ckey = c.substr(0, pos);
-                // value will contains the next '=' chars if exists
-                // eg. foo=bar=baz -> key: foo, value: bar=baz
-                cval = c.substr(pos+1);
-            }
-
-            // ltrim the key - following the modsec v2 way
-            while (ckey.empty() == false && isspace(ckey.at(0))) {
-                ckey.erase(0, 1);
-                localOffset++;
-            }
-
-            // if the key is empty (eg: "Cookie:   =bar;") skip it
-            if (ckey.empty() == true) {
-                localOffset = localOffset + c.length() + 1;
-                continue;
-            }
-            else {
-                // handle cookie only if the key is not empty
-                // set cookie name
-                m_variableRequestCookiesNames.set(ckey,
-                        ckey, localOffset);
-                localOffset = localOffset + ckey.size() + 1;
-                // set cookie value
-                m_variableRequestCookies.set(ckey, cval,
-                        localOffset);
-                localOffset = localOffset + cval.size() + 1;
+        break;
+    case ContentEncodingHeader:
+        if (m_rules->m_requestBodyDecompression
+            == RulesSetProperties::TrueConfigBoolean
+            && m_requestBodyInflate == NULL
+            && Utils::Inflate::supports(value)) {
+            ms_dbg(5, "Request body is encoded as " + value \
+                + ", inflating it.");
+            m_requestBodyInflate = new Utils::Inflate();
+        }
+        break;
+    case CookieHeader:
+        if (m_rules->m_variablesInUse.uses(
+            ConfigVariablesInUse::RequestCookies)) {
+            if (m_requestCookiesIndex == NULL) {
+                m_requestCookiesIndex = new Utils::PairIndex();
             }
+            m_requestCookiesIndex->addCookies(value, m_variableOffset);
+            m_variableRequestCookies.setSource(
+                m_requestCookiesIndex->values());
+            m_variableRequestCookiesNames.setSource(
+                m_requestCookiesIndex->names());
         }
-    }
+        break;
     /**
      * Simple check to decide the request body content. This is not the right
      * place, the "body processor" should be able to tell what he is capable
      * to deal with.
      *
      */
-
-    if (keyl == "content-type") {
-        std::string multipart("multipart/form-data");
-        std::string urlencoded("application/x-www-form-urlencoded");
-        std::string l = utils::string::tolower(value);
-        if (l.compare(0, multipart.length(), multipart) == 0) {
+    case ContentTypeHeader:
+        if (startsWithNoCase(value, "multipart/form-data")) {
             this->m_requestBodyType = MultiPartRequestBody;
             m_variableReqbodyProcessor.set("MULTIPART", m_variableOffset);
         }
-
-        if (l.compare(0, urlencoded.length(), urlencoded) == 0) {
+        if (startsWithNoCase(value, "application/x-www-form-urlencoded")) {
             this->m_requestBodyType = WWWFormUrlEncoded;
             m_variableReqbodyProcessor.set("URLENCODED", m_variableOffset);
         }
-    }
-
-    if (keyl == "host") {
-        std::vector<std::string> host = utils::string::split(value, ':');
-        m_variableServerName.set(host[0], m_variableOffset);
+        break;
+    case HostHeader:
+        m_variableServerName.set(value.substr(0, value.find(':')),
+            m_variableOffset);
+        break;
+    case OtherHeader:
+        break;
     }
     m_variableOffset = m_variableOffset + value.size() + 1;
 
@@ -787,6 +1539,8 @@ int Transaction::addRequestHeader(const unsigned char *key, size_t key_n,
  *
  */
 int Transaction::processRequestBody() {
+    TimingScope timing(this, &m_timings.request_body);
+
     ms_dbg(4, "Starting phase REQUEST_BODY. (SecRules 2)");
 
     if (getRuleEngineState() == RulesSetProperties::DisabledRuleEngine) {
@@ -794,6 +1548,11 @@ int Transaction::processRequestBody() {
         return true;
     }
 
+    if (m_requestBodyStreams != NULL) {
+        m_requestBodyStreams->finish(m_rules->m_pcreMatchLimit.m_set ?
+            m_rules->m_pcreMatchLimit.m_value : 0);
+    }
+
     if (m_variableInboundDataError.m_value.empty() == true) {
         m_variableInboundDataError.set("0", 0);
     }
@@ -801,7 +1560,7 @@ int Transaction::processRequestBody() {
     /*
      * Process the request body even if there is nothing to be done.
      * 
-     * if (m_requestBody.tellp() <= 0) {
+     * if (m_requestBody.empty()) {
      *     return true;
      * }
      * 
@@ -812,9 +1571,10 @@ int Transaction::processRequestBody() {
     bool requestBodyNoFilesLimitExceeded = false;
     if ((m_requestBodyType == WWWFormUrlEncoded) ||
         (m_requestBodyProcessor == JSONRequestBody) ||
-        (m_requestBodyProcessor == XMLRequestBody)) {
+        (m_requestBodyProcessor == XMLRequestBody) ||
+        (m_requestBodyProcessor == GRPCRequestBody)) {
         if ((m_rules->m_requestBodyNoFilesLimit.m_set)
-            && (m_requestBody.str().size() > m_rules->m_requestBodyNoFilesLimit.m_value)) {
+            && (m_requestBody.size() > m_rules->m_requestBodyNoFilesLimit.m_value)) {
             m_variableReqbodyError.set("1", 0);
             m_variableReqbodyErrorMsg.set("Request body excluding files is bigger than the maximum expected.", 0);
             m_variableInboundDataError.set("1", m_variableOffset);
@@ -829,10 +1589,16 @@ int Transaction::processRequestBody() {
         // large size might cause issues in the parsing itself; omit if exceeded
         if (!requestBodyNoFilesLimitExceeded) {
             std::string error;
+            if (m_xml == NULL) {
+                m_xml = new RequestBodyProcessor::XML(this);
+            }
             if (m_xml->init() == true) {
-                m_xml->processChunk(m_requestBody.str().c_str(),
-                    m_requestBody.str().size(),
-                    &error);
+                for (size_t i = 0; i < m_requestBody.chunkCount()
+                    && error.empty(); i++) {
+                    size_t len;
+                    const char *c = m_requestBody.chunk(i, &len);
+                    m_xml->processChunk(c, len, &error);
+                }
                 m_xml->complete(&error);
             }
             if (error.empty() == false) {
@@ -842,6 +1608,8 @@ int Transaction::processRequestBody() {
                 m_variableReqbodyProcessorErrorMsg.set("XML parsing error: " \
                     + error, m_variableOffset);
                 m_variableReqbodyProcessorError.set("1", m_variableOffset);
+                Utils::Metrics::getInstance().increment(
+                    Utils::Metrics::XmlBodyErrorsCounter);
             } else {
                 m_variableReqbodyError.set("0", m_variableOffset);
                 m_variableReqbodyProcessorError.set("0", m_variableOffset);
@@ -857,22 +1625,46 @@ int Transaction::processRequestBody() {
         // large size might cause issues in the parsing itself; omit if exceeded
         if (!requestBodyNoFilesLimitExceeded) {
             std::string error;
-            if (m_rules->m_requestBodyJsonDepthLimit.m_set) {
-                m_json->setMaxDepth(m_rules->m_requestBodyJsonDepthLimit.m_value);
-            }
-            if (m_json->init() == true) {
-                m_json->processChunk(m_requestBody.str().c_str(),
-                    m_requestBody.str().size(),
-                    &error);
-                m_json->complete(&error);
+            if (jsonSimd(m_rules)) {
+#ifdef WITH_SIMDJSON
+                RequestBodyProcessor::JSONSimd json(this);
+                if (m_rules->m_requestBodyJsonDepthLimit.m_set) {
+                    json.setMaxDepth(m_rules->m_requestBodyJsonDepthLimit.m_value);
+                }
+                json.process(m_requestBody, &error);
+#endif
+            } else {
+                if (m_json == NULL) {
+                    m_json = new RequestBodyProcessor::JSON(this);
+                }
+                if (m_json->isStreaming()) {
+                    /* body already fed, as it arrived */
+                    m_json->complete(&error);
+                    m_json->commitArguments();
+                } else {
+                    if (m_rules->m_requestBodyJsonDepthLimit.m_set) {
+                        m_json->setMaxDepth(m_rules->m_requestBodyJsonDepthLimit.m_value);
+                    }
+                    if (m_json->init() == true) {
+                        for (size_t i = 0; i < m_requestBody.chunkCount()
+                            && error.empty(); i++) {
+                            size_t len;
+                            const char *c = m_requestBody.chunk(i, &len);
+                            m_json->processChunk(c, len, &error);
+                        }
+                        m_json->complete(&error);
+                    }
+                }
             }
-            if (error.empty() == false && m_requestBody.str().size() > 0) {
+            if (error.empty() == false && m_requestBody.empty() == false) {
                 m_variableReqbodyError.set("1", m_variableOffset);
                 m_variableReqbodyProcessorError.set("1", m_variableOffset);
                 m_variableReqbodyErrorMsg.set("JSON parsing error: " + error,
                     m_variableOffset);
                 m_variableReqbodyProcessorErrorMsg.set("JSON parsing error: " \
                     + error, m_variableOffset);
+                Utils::Metrics::getInstance().increment(
+                    Utils::Metrics::JsonBodyErrorsCounter);
             } else {
                 m_variableReqbodyError.set("0", m_variableOffset);
                 m_variableReqbodyProcessorError.set("0", m_variableOffset);
@@ -880,16 +1672,53 @@ int Transaction::processRequestBody() {
         }
 #endif
 #if defined(WITH_LIBXML2) or defined(WITH_YAJL)
-    } else if (m_requestBodyType == MultiPartRequestBody) {
+    } else if (m_requestBodyProcessor == GRPCRequestBody) {
 #else
-    if (m_requestBodyType == MultiPartRequestBody) {
+    if (m_requestBodyProcessor == GRPCRequestBody) {
 #endif
-        std::string error;
+        // large size might cause issues in the parsing itself; omit if exceeded
+        if (!requestBodyNoFilesLimitExceeded) {
+            std::string error;
+            if (m_grpc == NULL) {
+                m_grpc = new RequestBodyProcessor::GRPC(this);
+            }
+            if (m_grpc->isStreaming()) {
+                /* body already fed, as it arrived */
+                m_grpc->complete(&error);
+                m_grpc->commitArguments();
+            } else if (m_grpc->init() == true) {
+                for (size_t i = 0; i < m_requestBody.chunkCount()
+                    && error.empty(); i++) {
+                    size_t len;
+                    const char *c = m_requestBody.chunk(i, &len);
+                    m_grpc->processChunk(c, len, &error);
+                }
+                if (error.empty()) {
+                    m_grpc->complete(&error);
+                }
+            }
+            if (error.empty() == false) {
+                m_variableReqbodyError.set("1", m_variableOffset);
+                m_variableReqbodyProcessorError.set("1", m_variableOffset);
+                m_variableReqbodyErrorMsg.set("gRPC parsing error: " + error,
+                    m_variableOffset);
+                m_variableReqbodyProcessorErrorMsg.set("gRPC parsing " \
+                    "error: " + error, m_variableOffset);
+                Utils::Metrics::getInstance().increment(
+                    Utils::Metrics::GrpcBodyErrorsCounter);
+            } else {
+                m_variableReqbodyError.set("0", m_variableOffset);
+                m_variableReqbodyProcessorError.set("0", m_variableOffset);
+            }
+        }
+    } else if (m_requestBodyType == MultiPartRequestBody) {
+        std::string error;
         int reqbodyNoFilesLength = 0;
         if (a != NULL) {
             Multipart m(*a, this);
             if (m.init(&error) == true) {
-                m.process(m_requestBody.str(), &error, m_variableOffset);
+                m.process(m_requestBody.data(), m_requestBody.size(), &error,
+                    m_variableOffset);
             }
             reqbodyNoFilesLength = m.m_reqbody_no_files_length;
             m.multipart_complete(&error);
@@ -901,6 +1730,8 @@ int Transaction::processRequestBody() {
                 m_variableOffset);
             m_variableReqbodyProcessorErrorMsg.set("Multipart parsing " \
                 "error: " + error, m_variableOffset);
+            Utils::Metrics::getInstance().increment(
+                Utils::Metrics::MultipartBodyErrorsCounter);
         } else if (((m_rules->m_requestBodyNoFilesLimit.m_set)
                    && (reqbodyNoFilesLength > m_rules->m_requestBodyNoFilesLimit.m_value))) {
             m_variableReqbodyError.set("1", 0);
@@ -934,11 +1765,22 @@ int Transaction::processRequestBody() {
             + error, m_variableOffset);
         m_variableReqbodyProcessorErrorMsg.set("Unknown request body " \
             "processor: " + error, m_variableOffset);
+        Utils::Metrics::getInstance().increment(
+            Utils::Metrics::UnknownBodyErrorsCounter);
     } else {
         m_variableReqbodyError.set("0", m_variableOffset);
         m_variableReqbodyProcessorError.set("0", m_variableOffset);
     }
 
+    std::string inflateError;
+    if (m_requestBodyInflate != NULL
+        && m_requestBodyInflate->finish(&inflateError) == false) {
+        m_variableReqbodyError.set("1", m_variableOffset);
+        m_variableReqbodyErrorMsg.set("Request body decompression " \
+            "failed: " + inflateError, m_variableOffset);
+        ms_dbg(4, "Request body decompression failed: " + inflateError);
+    }
+
     if (m_rules->m_secRequestBodyAccess == RulesSetProperties::FalseConfigBoolean) {
         if (m_requestBodyAccess != RulesSetProperties::TrueConfigBoolean) {
             ms_dbg(4, "Request body processing is disabled");
@@ -969,19 +1811,38 @@ int Transaction::processRequestBody() {
         delete h;
     }
 
+    /*
+     * A spooled body is only there in full for the body processors, the
+     * variables get as much of it as would have been kept in memory.
+     */
+    std::string spooledBody;
+    if (m_requestBody.spooled()) {
+        spooledBody.assign(m_requestBody.data(),
+            m_rules->m_requestBodyInMemoryLimit.m_value);
+        ms_dbg(5, "Request body is spooled, REQUEST_BODY holds its first " \
+            + std::to_string(spooledBody.size()) + " bytes.");
+    }
+    const std::string &body = m_requestBody.spooled() ? spooledBody
+        : m_requestBody.str();
+
     fullRequest = fullRequest + "\n\n";
-    fullRequest = fullRequest + m_requestBody.str();
+    fullRequest = fullRequest + body;
     m_variableFullRequest.set(fullRequest, m_variableOffset);
     m_variableFullRequestLength.set(std::to_string(fullRequest.size()),
         m_variableOffset);
 
-    if (m_requestBody.tellp() > 0) {
-        m_variableRequestBody.set(m_requestBody.str(), m_variableOffset);
+    if (m_requestBody.empty() == false) {
+        m_variableRequestBody.set(body, m_variableOffset);
         m_variableRequestBodyLength.set(std::to_string(
-            m_requestBody.str().size()),
-            m_variableOffset, m_requestBody.str().size());
+            m_requestBody.size()),
+            m_variableOffset, m_requestBody.size());
     }
 
+    if (suspend(modsecurity::RequestBodyPhase, &timing, [this]() {
+            m_rules->evaluate(modsecurity::RequestBodyPhase, this);
+        })) {
+        return MSC_AGAIN;
+    }
     this->m_rules->evaluate(modsecurity::RequestBodyPhase, this);
     return true;
 }
@@ -1042,7 +1903,21 @@ int Transaction::requestBodyFromFile(const char *path) {
 }
 
 int Transaction::appendRequestBody(const unsigned char *buf, size_t len) {
-    int current_size = this->m_requestBody.tellp();
+    if (m_requestBodyInflate != NULL) {
+        return inflateRequestBody(buf, len);
+    }
+    return appendPlainRequestBody(buf, len);
+}
+
+
+int Transaction::appendPlainRequestBody(const unsigned char *buf,
+    size_t len) {
+    size_t current_size = this->m_requestBody.size();
+
+    if (current_size == 0 && m_rules->m_requestBodyInMemoryLimit.m_set) {
+        m_requestBody.spoolAbove(m_rules->m_requestBodyInMemoryLimit.m_value,
+            m_rules->m_tmpDirectory.m_value);
+    }
 
     ms_dbg(9, "Appending request body: " + std::to_string(len) + " bytes. " \
         "Limit set to: "
@@ -1057,8 +1932,9 @@ int Transaction::appendRequestBody(const unsigned char *buf, size_t len) {
             RulesSet::BodyLimitAction::ProcessPartialBodyLimitAction) {
             size_t spaceLeft = this->m_rules->m_requestBodyLimit.m_value
                 - current_size;
-            this->m_requestBody.write(reinterpret_cast<const char*>(buf),
+            this->m_requestBody.append(reinterpret_cast<const char*>(buf),
                 spaceLeft);
+            streamRequestBody(buf, spaceLeft, current_size);
             ms_dbg(5, "Request body limit is marked to process partial");
             return false;
         } else {
@@ -1081,12 +1957,198 @@ int Transaction::appendRequestBody(const unsigned char *buf, size_t len) {
         }
     }
 
-    this->m_requestBody.write(reinterpret_cast<const char*>(buf), len);
+    this->m_requestBody.append(reinterpret_cast<const char*>(buf), len);
+    streamRequestBody(buf, len, current_size);
+
+    return true;
+}
+
+
+/**
+ * Inflates a piece of a compressed request body into the body, where the
+ * usual limits apply to what comes out. The inflation stops, and what is
+ * left of the body is dropped unread, once the limit is reached, once
+ * there is an intervention or once the body grows past
+ * SecRequestBodyDecompressionRatio times what was received, which only
+ * counts after the first kRatioFloor inflated bytes.
+ *
+ */
+int Transaction::inflateRequestBody(const unsigned char *buf, size_t len) {
+    static const size_t kRatioFloor = 65536;
+    size_t ratio = m_rules->m_requestBodyDecompressionRatio.m_set ?
+        m_rules->m_requestBodyDecompressionRatio.m_value :
+        MSC_REQUEST_BODY_DECOMPRESSION_RATIO;
+    bool ratioExceeded = false;
+    int ret = true;
+
+    Utils::Inflate::Result result = m_requestBodyInflate->append(buf, len,
+        [&](const unsigned char *out, size_t size) {
+        size_t inflated = m_requestBodyInflate->inflated();
+        if (inflated > kRatioFloor
+            && inflated > ratio * m_requestBodyInflate->compressed()) {
+            ratioExceeded = true;
+            return false;
+        }
+        size_t before = m_requestBody.size();
+        ret = appendPlainRequestBody(out, size);
+        /* past the limit nothing is appended, whatever the action */
+        return ret == true && m_it.disruptive == false
+            && m_requestBody.size() == before + size;
+    });
+
+    if (result == Utils::Inflate::Failed) {
+        ms_dbg(4, "Failed to inflate the request body.");
+        return ret;
+    }
+    if (ratioExceeded == false) {
+        return ret;
+    }
+
+    m_variableInboundDataError.set("1", m_variableOffset);
+    ms_dbg(5, "Request body inflates to more than " \
+        + std::to_string(ratio) + " times its compressed size.");
+    if (m_rules->m_requestBodyLimitAction ==
+        RulesSet::BodyLimitAction::ProcessPartialBodyLimitAction) {
+        return false;
+    }
+    if (m_rules->m_requestBodyLimitAction ==
+        RulesSet::BodyLimitAction::RejectBodyLimitAction) {
+        if (getRuleEngineState() == RulesSet::EnabledRuleEngine) {
+            intervention::free(&m_it);
+            m_it.log = strdup("Request body decompression ratio is " \
+                "exceeded, rejecting the request");
+            m_it.status = 403;
+            m_it.disruptive = true;
+        } else {
+            ms_dbg(5, "Not rejecting the request as the engine is " \
+                "not Enabled");
+        }
+    }
+    return true;
+}
+
+
+/**
+ * @name    appendRequestBody
+ * @brief   Adds the pieces of a request body, in order
+ *
+ * Same as appending each of the pieces, with the room for all of them
+ * made at once: the body ends up in one more chunk of the buffer rather
+ * than in one per piece.
+ *
+ * @param iov the pieces.
+ * @param n   how many there are.
+ *
+ * @returns If the operation was successful or not.
+ * @retval true Operation was successful.
+ * @retval false The body went past the limit, see appendRequestBody.
+ *
+ */
+int Transaction::appendRequestBody(const msc_iovec *iov, size_t n) {
+    size_t total = 0;
+    for (size_t i = 0; i < n; i++) {
+        total = total + iov[i].len;
+    }
+    size_t limit = m_rules->m_requestBodyLimit.m_value;
+    if (limit > 0) {
+        total = std::min(total, limit > m_requestBody.size()
+            ? limit - m_requestBody.size() : 0);
+    }
+    /* spooling has to be on before reserve() sizes the next chunk */
+    if (m_requestBody.empty() && m_rules->m_requestBodyInMemoryLimit.m_set) {
+        m_requestBody.spoolAbove(m_rules->m_requestBodyInMemoryLimit.m_value,
+            m_rules->m_tmpDirectory.m_value);
+    }
+    m_requestBody.reserve(total);
+
+    for (size_t i = 0; i < n; i++) {
+        if (appendRequestBody(iov[i].base, iov[i].len) == false) {
+            return false;
+        }
+        if (m_it.disruptive) {
+            break;
+        }
+    }
 
     return true;
 }
 
 
+/**
+ * Hands the request body to what can look at it while it is still being
+ * received: the regular expressions of the @rx rules over REQUEST_BODY
+ * and, when the JSON or the gRPC processor was selected before the first
+ * byte arrived, that processor. Anything else waits for
+ * processRequestBody.
+ *
+ */
+void Transaction::streamRequestBody(const unsigned char *buf, size_t len,
+    size_t offset) {
+    if (getRuleEngineState() == RulesSetProperties::DisabledRuleEngine) {
+        return;
+    }
+
+    if (offset == 0 && m_requestBodyStreams == NULL
+        && m_rules->requestBodyRegexes().empty() == false) {
+        m_requestBodyStreams = new Utils::RegexStreams(
+            m_rules->requestBodyRegexes(), &m_requestBody);
+    }
+    if (m_requestBodyStreams != NULL) {
+        m_requestBodyStreams->feed(reinterpret_cast<const char *>(buf), len,
+            m_rules->m_pcreMatchLimit.m_set ?
+                m_rules->m_pcreMatchLimit.m_value : 0);
+    }
+
+    if (m_requestBodyProcessor == GRPCRequestBody) {
+        if (offset == 0) {
+            if (m_grpc == NULL) {
+                m_grpc = new RequestBodyProcessor::GRPC(this);
+            }
+            if (m_grpc->init() == false) {
+                return;
+            }
+        } else if (m_grpc == NULL || m_grpc->isStreaming() == false) {
+            return;
+        }
+        /* not going to be decoded anyway, see processRequestBody */
+        if (m_rules->m_requestBodyNoFilesLimit.m_set
+            && offset + len > m_rules->m_requestBodyNoFilesLimit.m_value) {
+            return;
+        }
+        m_grpc->stream(reinterpret_cast<const char *>(buf), len);
+        return;
+    }
+
+#ifdef WITH_YAJL
+    /* simdjson wants the whole document */
+    if (m_requestBodyProcessor != JSONRequestBody || jsonSimd(m_rules)) {
+        return;
+    }
+    if (offset == 0) {
+        if (m_json == NULL) {
+            m_json = new RequestBodyProcessor::JSON(this);
+        }
+        if (m_rules->m_requestBodyJsonDepthLimit.m_set) {
+            m_json->setMaxDepth(m_rules->m_requestBodyJsonDepthLimit.m_value);
+        }
+        if (m_json->init() == false) {
+            return;
+        }
+    } else if (m_json == NULL || m_json->isStreaming() == false) {
+        return;
+    }
+
+    /* not going to be parsed anyway, see processRequestBody */
+    if (m_rules->m_requestBodyNoFilesLimit.m_set
+        && offset + len > m_rules->m_requestBodyNoFilesLimit.m_value) {
+        return;
+    }
+
+    m_json->stream(reinterpret_cast<const char *>(buf), len);
+#endif
+}
+
+
 /**
  * @name    processResponseHeaders
  * @brief   Perform the analysis on the response readers.
@@ -1105,6 +2167,8 @@ int Transaction::appendRequestBody(const unsigned char *buf, size_t len) {
  *
  */
 int Transaction::processResponseHeaders(int code, const std::string& proto) {
+    TimingScope timing(this, &m_timings.response_headers);
+
     ms_dbg(4, "Starting phase RESPONSE_HEADERS. (SecRules 3)");
 
     this->m_httpCodeReturned = code;
@@ -1116,6 +2180,11 @@ int Transaction::processResponseHeaders(int code, const std::string& proto) {
         return true;
     }
 
+    if (suspend(modsecurity::ResponseHeadersPhase, &timing, [this]() {
+            m_rules->evaluate(modsecurity::ResponseHeadersPhase, this);
+        })) {
+        return MSC_AGAIN;
+    }
     this->m_rules->evaluate(modsecurity::ResponseHeadersPhase, this);
     return true;
 }
@@ -1141,16 +2210,27 @@ int Transaction::processResponseHeaders(int code, const std::string& proto) {
  */
 int Transaction::addResponseHeader(const std::string& key,
     const std::string& value) {
+    accountMemory(sizeof(VariableValue) + 2 * key.size() + value.size());
+
     m_variableResponseHeadersNames.set(key, key, m_variableOffset);
     m_variableResponseHeaders.set(key, value, m_variableOffset);
 
-    if (utils::string::tolower(key) == "content-type") {
+    std::string name = utils::string::tolower(key);
+    if (name == "content-type") {
         // Removes the charset=...
         // Content-Type: text/html; charset=UTF-8
         std::vector<std::string> val = utils::string::split(value, ';');
         if (val.size() > 0) {
             m_variableResponseContentType.set(val[0], 0);
         }
+    } else if (name == "content-encoding"
+        && m_rules->m_responseBodyDecompression
+            == RulesSetProperties::TrueConfigBoolean
+        && m_responseBodyInflate == NULL
+        && Utils::Inflate::supports(value)) {
+        ms_dbg(5, "Response body is encoded as " + value \
+            + ", inflating it.");
+        m_responseBodyInflate = new Utils::Inflate();
     }
     return 1;
 }
@@ -1230,6 +2310,8 @@ int Transaction::addResponseHeader(const unsigned char *key, size_t key_n,
  *
  */
 int Transaction::processResponseBody() {
+    TimingScope timing(this, &m_timings.response_body);
+
     ms_dbg(4, "Starting phase RESPONSE_BODY. (SecRules 4)");
 
     if (getRuleEngineState() == RulesSet::DisabledRuleEngine) {
@@ -1259,16 +2341,65 @@ int Transaction::processResponseBody() {
             + validContetTypes);
         return true;
     }
+
+    std::string inflateError;
+    if (m_responseBodyInflate != NULL
+        && m_responseBodyInflate->finish(&inflateError) == false) {
+        ms_dbg(4, "Response body decompression failed: " + inflateError);
+    }
+
+    if (m_responseBodyStreamed > 0) {
+        ms_dbg(4, "Response body was inspected as it was appended.");
+        return true;
+    }
+
+    if (suspend(modsecurity::ResponseBodyPhase, &timing,
+        [this]() { evaluateResponseBody(); })) {
+        return MSC_AGAIN;
+    }
+    evaluateResponseBody();
+    return true;
+}
+
+
+void Transaction::evaluateResponseBody() {
     if (m_variableOutboundDataError.m_value.empty() == true) {
         m_variableOutboundDataError.set("0", m_variableOffset);
     }
 
     m_variableResponseBody.set(m_responseBody.str(), m_variableOffset);
     m_variableResponseContentLength.set(std::to_string(
-        m_responseBody.str().size()), m_variableOffset);
+        m_responseBodyStreamed > 0 ? m_responseBodyStreamed
+            : m_responseBody.size()), m_variableOffset);
 
     m_rules->evaluate(modsecurity::ResponseBodyPhase, this);
-    return true;
+}
+
+
+/*
+ * With SecResponseBodyStreamWindow, phase 4 runs over every chunk as it is
+ * appended, along with the last bytes of the previous ones so that what
+ * straddles two chunks is seen. The connector may send each chunk on once
+ * appendResponseBody() returns without an intervention.
+ */
+void Transaction::streamResponseBody(size_t len) {
+    if (m_rules->m_responseBodyStreamWindow.m_set == false || len == 0) {
+        return;
+    }
+    m_responseBodyStreamed = m_responseBodyStreamed + len;
+
+    if (m_it.disruptive == false
+        && getRuleEngineState() != RulesSet::DisabledRuleEngine) {
+        TimingScope timing(this, &m_timings.response_body);
+
+        ms_dbg(4, "Starting phase RESPONSE_BODY over " \
+            + std::to_string(len) + " more bytes. (SecRules 4)");
+        m_streamingResponseBody = true;
+        evaluateResponseBody();
+        m_streamingResponseBody = false;
+    }
+
+    m_responseBody.keepLast(m_rules->m_responseBodyStreamWindow.m_value);
 }
 
 
@@ -1291,7 +2422,11 @@ int Transaction::processResponseBody() {
  *
  */
 int Transaction::appendResponseBody(const unsigned char *buf, size_t len) {
-    int current_size = this->m_responseBody.tellp();
+    if (m_rules->needsResponseBody() == false) {
+        ms_dbg(9, "Not appending response body, nothing is going to " \
+            "look at it.");
+        return true;
+    }
 
     std::set<std::string> &bi = \
         this->m_rules->m_responseBodyTypeToBeInspected.m_value;
@@ -1304,6 +2439,18 @@ int Transaction::appendResponseBody(const unsigned char *buf, size_t len) {
         return true;
     }
 
+    if (m_responseBodyInflate != NULL) {
+        return inflateResponseBody(buf, len);
+    }
+    return appendPlainResponseBody(buf, len);
+}
+
+
+int Transaction::appendPlainResponseBody(const unsigned char *buf,
+    size_t len) {
+    size_t current_size = m_rules->m_responseBodyStreamWindow.m_set
+        ? m_responseBodyStreamed : this->m_responseBody.size();
+
     ms_dbg(9, "Appending response body: " + std::to_string(len + current_size)
         + " bytes. Limit set to: " +
         std::to_string(this->m_rules->m_responseBodyLimit.m_value));
@@ -1316,8 +2463,9 @@ int Transaction::appendResponseBody(const unsigned char *buf, size_t len) {
             RulesSet::BodyLimitAction::ProcessPartialBodyLimitAction) {
             size_t spaceLeft = this->m_rules->m_responseBodyLimit.m_value \
                 - current_size;
-            this->m_responseBody.write(reinterpret_cast<const char*>(buf),
+            this->m_responseBody.append(reinterpret_cast<const char*>(buf),
                 spaceLeft);
+            streamResponseBody(spaceLeft);
             ms_dbg(5, "Response body limit is marked to process partial");
             return false;
         } else {
@@ -1340,7 +2488,82 @@ int Transaction::appendResponseBody(const unsigned char *buf, size_t len) {
         }
     }
 
-    this->m_responseBody.write(reinterpret_cast<const char*>(buf), len);
+    this->m_responseBody.append(reinterpret_cast<const char*>(buf), len);
+    streamResponseBody(len);
+
+    return true;
+}
+
+
+/*
+ * The inflated pieces are appended one by one, SecResponseBodyLimit
+ * counting the inflated bytes: with SecResponseBodyStreamWindow phase 4
+ * runs over each of them, stopping the inflation at the first intervention.
+ */
+int Transaction::inflateResponseBody(const unsigned char *buf, size_t len) {
+    int ret = true;
+
+    Utils::Inflate::Result result = m_responseBodyInflate->append(buf, len,
+        [&](const unsigned char *out, size_t size) {
+        size_t before = m_rules->m_responseBodyStreamWindow.m_set
+            ? m_responseBodyStreamed : m_responseBody.size();
+        ret = appendPlainResponseBody(out, size);
+        size_t after = m_rules->m_responseBodyStreamWindow.m_set
+            ? m_responseBodyStreamed : m_responseBody.size();
+        /* past the limit nothing is appended, whatever the action */
+        return ret == true && m_it.disruptive == false
+            && after == before + size;
+    });
+
+    if (result == Utils::Inflate::Failed) {
+        ms_dbg(4, "Failed to inflate the response body.");
+    }
+    return ret;
+}
+
+
+/**
+ * @name    appendResponseBody
+ * @brief   Adds the pieces of a response body, in order
+ *
+ * The response side of appendRequestBody(iov, n). The room is only made
+ * once the first piece was taken, as the response body may well not be
+ * kept at all.
+ *
+ * @param iov the pieces.
+ * @param n   how many there are.
+ *
+ * @returns If the operation was successful or not.
+ * @retval true Operation was successful.
+ * @retval false The body went past the limit, see appendResponseBody.
+ *
+ */
+int Transaction::appendResponseBody(const msc_iovec *iov, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        size_t before = m_responseBody.size();
+        if (appendResponseBody(iov[i].base, iov[i].len) == false) {
+            return false;
+        }
+        if (m_it.disruptive) {
+            break;
+        }
+        if (i > 0 || before == m_responseBody.size()
+            || m_rules->m_responseBodyStreamWindow.m_set
+            || m_responseBodyInflate != NULL) {
+            continue;
+        }
+
+        size_t total = 0;
+        for (size_t j = 1; j < n; j++) {
+            total = total + iov[j].len;
+        }
+        size_t limit = m_rules->m_responseBodyLimit.m_value;
+        if (limit > 0) {
+            total = std::min(total, limit > m_responseBody.size()
+                ? limit - m_responseBody.size() : 0);
+        }
+        m_responseBody.reserve(total);
+    }
 
     return true;
 }
@@ -1356,6 +2579,9 @@ int Transaction::appendResponseBody(const unsigned char *buf, size_t len) {
  *
  * WARN: This is a skeleton that it is not in use yet.
  *
+ * @note When RulesSet::needsResponseBody() is false the body handed to
+ *       appendResponseBody() is not kept and this buffer stays empty.
+ *
  * @return It returns a buffer (const char *)
  *
  */
@@ -1375,11 +2601,7 @@ const char *Transaction::getResponseBody() const {
  *
  */
 size_t Transaction::getResponseBodyLength() {
-    size_t size = 0;
-    m_responseBody.seekp(0, std::ios::end);
-    size = m_responseBody.tellp();
-
-    return size;
+    return m_responseBody.size();
 }
 
 /**
@@ -1395,12 +2617,7 @@ size_t Transaction::getResponseBodyLength() {
  *
  */
 size_t Transaction::getRequestBodyLength() {
-    size_t size = 0;
-
-    m_requestBody.seekp(0, std::ios::end);
-    size = m_requestBody.tellp();
-
-    return size;
+    return m_requestBody.size();
 }
 
 
@@ -1417,14 +2634,49 @@ size_t Transaction::getRequestBodyLength() {
  *
  */
 int Transaction::processLogging() {
+    TimingScope timing(this, &m_timings.logging);
+
     ms_dbg(4, "Starting phase LOGGING. (SecRules 5)");
 
+    if (m_transformationCache) {
+        ms_dbg(4, "Transformation cache: " \
+            + std::to_string(m_transformationCache->m_hits) + " hit(s), " \
+            + std::to_string(m_transformationCache->m_misses) + " miss(es), " \
+            + std::to_string(m_transformationCache->m_size) + " bytes.");
+    }
+
     if (getRuleEngineState() == RulesSet::DisabledRuleEngine) {
         ms_dbg(4, "Rule engine disabled, returning...");
         return true;
     }
 
+    if (suspend(modsecurity::LoggingPhase, &timing,
+        [this]() { evaluateLogging(); })) {
+        return MSC_AGAIN;
+    }
+    evaluateLogging();
+
+    return true;
+}
+
+
+/*
+ * The copies of the records taken by initcol and friends go back to the
+ * backends, with the SecCollectionTimeout of the rules that wrote them.
+ */
+void Transaction::flushCollections() {
+    collection::backend::Expiry::Scope expiry(
+        m_rules != NULL ? m_rules->collectionTimeout() : 0);
+    m_collections.flush();
+}
+
+
+void Transaction::evaluateLogging() {
     this->m_rules->evaluate(modsecurity::LoggingPhase, this);
+    flushDebugBuffer();
+
+    /* The last of the rules have run: the copies of the records go back. */
+    flushCollections();
 
     /* If relevant, save this transaction information at the audit_logs */
     if (m_rules != NULL && m_rules->m_auditLog != NULL) {
@@ -1457,11 +2709,107 @@ int Transaction::processLogging() {
                 std::to_string(parts));
         }
     }
+}
+
+
+/**
+ * Hands step, what is left of the process*() call of phase, over to the
+ * async threads when the transaction is non blocking and the rules of
+ * the phase may block. The step is timed on its thread as the rest of the
+ * call would have been, time budget included; the byte written to the
+ * pipe once it is done is what makes asyncFd() readable, and the only
+ * thing that tells the phase is over: the async thread does not touch
+ * the transaction once it is written, as the connector may resume and
+ * delete it at once.
+ *
+ */
+bool Transaction::suspend(int phase, TimingScope *scope,
+    std::function<void()> step) {
+    if (m_nonBlocking == false || m_rules->mayBlock(phase) == false) {
+        return false;
+    }
+    if (m_asyncFds[0] < 0) {
+        if (pipe(m_asyncFds) != 0) {
+            m_asyncFds[0] = m_asyncFds[1] = -1;
+            return false;
+        }
+        for (int fd : m_asyncFds) {
+            fcntl(fd, F_SETFD, FD_CLOEXEC);
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        }
+    }
+
+    ms_dbg(4, "Phase handed over to an async thread, its rules may block.");
+    m_suspended = true;
+    uint64_t *timing = scope->release();
+    int fd = m_asyncFds[1];
+    m_ms->asyncRunner()->post([this, timing, step, fd]() {
+        {
+            TimingScope scope(this, timing);
+            step();
+        }
+        char c = 0;
+        /* this may be deleted as soon as the byte was written */
+        while (write(fd, &c, 1) < 0 && errno == EINTR) { }
+    });
+    return true;
+}
+
+
+/**
+ * @name    resume
+ * @brief   The result of the suspended process*() call, once it is done.
+ *
+ * @retval MSC_AGAIN The phase still goes on, asyncFd() is to be polled.
+ * @retval 1 The phase is done (or there was nothing suspended); the
+ *           intervention, if any, is to be checked as after any other
+ *           process*() call.
+ *
+ */
+int Transaction::resume() {
+    char c;
+    ssize_t n;
 
+    if (m_suspended == false) {
+        return true;
+    }
+    /* the pipe is non blocking: no byte yet, the phase still goes on */
+    while ((n = read(m_asyncFds[0], &c, 1)) < 0 && errno == EINTR) { }
+    if (n != 1) {
+        return MSC_AGAIN;
+    }
+    m_suspended = false;
     return true;
 }
 
 
+int Transaction::wait() {
+    int ret;
+
+    while ((ret = resume()) == MSC_AGAIN) {
+        struct pollfd p;
+        p.fd = m_asyncFds[0];
+        p.events = POLLIN;
+        p.revents = 0;
+        poll(&p, 1, -1);
+    }
+    return ret;
+}
+
+
+/**
+ * @name    timings
+ * @brief   Time spent so far in each of the processing phases.
+ *
+ * @param timings Filled with the time spent, in nanoseconds, in each of the
+ *                process* calls made so far.
+ *
+ */
+void Transaction::timings(ModSecurityTimings *timings) const {
+    *timings = m_timings;
+}
+
+
 /**
  * @name    intervention
  * @brief   Check if ModSecurity has anything to ask to the server.
@@ -1475,6 +2823,7 @@ int Transaction::processLogging() {
  */
 bool Transaction::intervention(ModSecurityIntervention *it) {
     if (m_it.disruptive) {
+        m_intervened = true;
         if (m_it.url) {
             it->url = strdup(m_it.url);
         }
@@ -1495,21 +2844,56 @@ bool Transaction::intervention(ModSecurityIntervention *it) {
 }
 
 
+/**
+ * @name    getTransformationCacheHits
+ * @brief   Number of transformation chains served from the cache.
+ *
+ * Along with getTransformationCacheMisses, it helps to tune the options
+ * given to SecCacheTransformations. Both are 0 if the cache is disabled.
+ *
+ */
+size_t Transaction::getTransformationCacheHits() const {
+    if (m_transformationCache == NULL) {
+        return 0;
+    }
+    return m_transformationCache->m_hits;
+}
+
+
+/**
+ * @name    getTransformationCacheMisses
+ * @brief   Number of transformation chains that had to be computed.
+ *
+ */
+size_t Transaction::getTransformationCacheMisses() const {
+    if (m_transformationCache == NULL) {
+        return 0;
+    }
+    return m_transformationCache->m_misses;
+}
+
+
 std::string Transaction::toOldAuditLogFormatIndex(const std::string &filename,
     double size, const std::string &md5) {
-    std::stringstream ss;
-    struct tm timeinfo;
-    char tstr[300];
+    std::string line;
+    toOldAuditLogFormatIndex(filename, size, md5, &line);
+    return line;
+}
 
-    memset(tstr, '\0', 300);
-    localtime_r(&this->m_timeStamp, &timeinfo);
 
-    strftime(tstr, 299, "[%d/%b/%Y:%H:%M:%S %z]", &timeinfo);
+/**
+ * Appends the index line of a record of the parallel audit log to out.
+ *
+ */
+void Transaction::toOldAuditLogFormatIndex(const std::string &filename,
+    double size, const std::string &md5, std::string *out) {
+    std::unique_ptr<std::string> host =
+        m_variableRequestHeaders.resolveFirst("Host");
+    std::unique_ptr<std::string> referer =
+        m_variableRequestHeaders.resolveFirst("REFERER");
+    std::unique_ptr<std::string> userAgent =
+        m_variableRequestHeaders.resolveFirst("User-Agent");
 
-    ss << utils::string::dash_if_empty(
-       m_variableRequestHeaders.resolveFirst("Host").get())
-        << " ";
-    ss << utils::string::dash_if_empty(this->m_clientIpAddress->c_str()) << " ";
     /** TODO: Check variable */
     variables::RemoteUser *r = new variables::RemoteUser("REMOTE_USER");
     std::vector<const VariableValue *> l;
@@ -1519,167 +2903,279 @@ std::string Transaction::toOldAuditLogFormatIndex(const std::string &filename,
     }
     delete r;
 
-    ss << utils::string::dash_if_empty(
-        m_variableRemoteUser.c_str());
-    ss << " ";
+    out->reserve(out->size() + 256 + m_uri.size() + filename.size()
+        + (userAgent ? userAgent->size() : 0)
+        + 2 * (referer ? referer->size() : 0));
+
+    out->append(utils::string::dash_if_empty(host.get()));
+    out->push_back(' ');
+    out->append(utils::string::dash_if_empty(
+        this->m_clientIpAddress->c_str()));
+    out->push_back(' ');
+    out->append(utils::string::dash_if_empty(m_variableRemoteUser.c_str()));
+    out->push_back(' ');
     /** TODO: Check variable */
-    //ss << utils::string::dash_if_empty(
-    //    this->m_collections.resolveFirst("LOCAL_USER").get());
-    //ss << " ";
-    ss << tstr << " ";
-
-    ss << "\"";
-    ss << utils::string::dash_if_empty(m_variableRequestMethod.evaluate());
-    ss << " ";
-    ss << this->m_uri.c_str() << " ";
-    ss << "HTTP/" << m_httpVersion.c_str();
-    ss << "\" ";
-
-    ss << this->m_httpCodeReturned << " ";
-    ss << this->m_responseBody.tellp() << " ";
+    //out->append(utils::string::dash_if_empty(
+    //    this->m_collections.resolveFirst("LOCAL_USER").get()));
+    //out->push_back(' ');
+    out->append(Utils::LogStrings::commonTime(m_timeStamp));
+    out->append(" \"");
+    out->append(utils::string::dash_if_empty(
+        m_variableRequestMethod.evaluate()));
+    out->push_back(' ');
+    out->append(this->m_uri.c_str());
+    out->append(" HTTP/");
+    out->append(m_httpVersion.c_str());
+    out->append("\" ");
+
+    out->append(std::to_string(this->m_httpCodeReturned));
+    out->push_back(' ');
+    out->append(std::to_string(this->m_responseBody.size()));
+    out->push_back(' ');
     /** TODO: Check variable */
-    ss << utils::string::dash_if_empty(
-        m_variableRequestHeaders.resolveFirst("REFERER").get()) << " ";
-    ss << "\"";
-    ss << utils::string::dash_if_empty(
-        m_variableRequestHeaders.resolveFirst("User-Agent").get());
-    ss << "\" ";
-    ss << *m_id.get() << " ";
+    out->append(utils::string::dash_if_empty(referer.get()));
+    out->append(" \"");
+    out->append(utils::string::dash_if_empty(userAgent.get()));
+    out->append("\" ");
+    out->append(*m_id.get());
+    out->push_back(' ');
     /** TODO: Check variable */
-    ss << utils::string::dash_if_empty(
-        m_variableRequestHeaders.resolveFirst("REFERER").get()) << " ";
-
-    ss << filename << " ";
-    ss << "0" << " ";
-    ss << std::to_string(size) << " ";
-    ss << "md5:" << md5 << std::endl;
-
-    return ss.str();
+    out->append(utils::string::dash_if_empty(referer.get()));
+    out->push_back(' ');
+
+    out->append(filename);
+    out->append(" 0 ");
+    out->append(std::to_string(size));
+    out->append(" md5:");
+    out->append(md5);
+    out->push_back('\n');
 }
 
 
 std::string Transaction::toOldAuditLogFormat(int parts,
     const std::string &trailer) {
-    std::stringstream audit_log;
-    struct tm timeinfo;
-    char tstr[300];
-
-    memset(tstr, '\0', 300);
-    localtime_r(&this->m_timeStamp, &timeinfo);
-
-    audit_log << "--" << trailer << "-" << "A--" << std::endl;
-    strftime(tstr, 299, "[%d/%b/%Y:%H:%M:%S %z]", &timeinfo);
-    audit_log << tstr;
-    audit_log << " " << m_id->c_str();
-    audit_log << " " << this->m_clientIpAddress->c_str();
-    audit_log << " " << this->m_clientPort;
-    audit_log << " " << m_serverIpAddress->c_str();
-    audit_log << " " << this->m_serverPort;
-    audit_log << std::endl;
+    std::string log;
+    toOldAuditLogFormat(parts, trailer, &log);
+    return log;
+}
 
-    if (parts & audit_log::AuditLog::BAuditLogPart) {
-        std::vector<const VariableValue *> l;
-        audit_log << "--" << trailer << "-" << "B--" << std::endl;
-        audit_log << utils::string::dash_if_empty(
-            m_variableRequestMethod.evaluate());
-        audit_log << " " << this->m_uri.c_str() << " " << "HTTP/";
-        audit_log << this->m_httpVersion.c_str() << std::endl;
 
-        m_variableRequestHeaders.resolve(&l);
-        for (auto &h : l) {
-            size_t pos = strlen("REQUEST_HEADERS:");
-            audit_log << h->getKeyWithCollection().c_str() + pos << ": ";
-            audit_log << h->getValue().c_str() << std::endl;
-            delete h;
-        }
-        audit_log << std::endl;
-    }
-    if (parts & audit_log::AuditLog::CAuditLogPart
-        &&  m_requestBody.tellp() > 0) {
-        std::string body =  m_requestBody.str();
-        audit_log << "--" << trailer << "-" << "C--" << std::endl;
+/**
+ * Appends the native (multipart) audit log record of the transaction to
+ * out, which the writers keep from one record to the next.
+ *
+ * The separator of the parts is the same but for its letter: it is laid
+ * out once, and the room for the whole record is made up front from the
+ * sizes of the headers and of the bodies.
+ *
+ */
+void Transaction::toOldAuditLogFormat(int parts,
+    const std::string &trailer, std::string *out) {
+    /* "--<trailer>-X--\n", X being the part */
+    std::string separator("--" + trailer + "-X--\n");
+    const size_t letter = separator.size() - 4;
+    auto section = [&](char part) {
+        separator[letter] = part;
+        out->append(separator);
+    };
+
+    std::vector<const VariableValue *> requestHeaders;
+    std::vector<const VariableValue *> responseHeaders;
+    std::string responseBody;
+    size_t size = 512 + 12 * separator.size() + m_uri.size();
+    if (parts & audit_log::AuditLog::BAuditLogPart) {
+        m_variableRequestHeaders.resolve(&requestHeaders);
+        for (const VariableValue *h : requestHeaders) {
+            size = size + h->getKey().size() + h->getValue().size() + 3;
+        }
+    }
+    if (parts & audit_log::AuditLog::CAuditLogPart) {
+        size = size + m_requestBody.size() + 2;
+    }
+    if (parts & audit_log::AuditLog::EAuditLogPart
+        && m_responseBody.empty() == false) {
+        responseBody = utils::string::toHexIfNeeded(m_responseBody.str());
+        size = size + responseBody.size() + 2;
+    }
+    if (parts & audit_log::AuditLog::FAuditLogPart) {
+        m_variableResponseHeaders.resolve(&responseHeaders);
+        for (const VariableValue *h : responseHeaders) {
+            size = size + h->getKey().size() + h->getValue().size() + 3;
+        }
+    }
+    out->reserve(out->size() + size);
+
+    section('A');
+    out->append(Utils::LogStrings::commonTime(m_timeStamp));
+    out->push_back(' ');
+    out->append(m_id->c_str());
+    out->push_back(' ');
+    out->append(this->m_clientIpAddress->c_str());
+    out->push_back(' ');
+    out->append(std::to_string(this->m_clientPort));
+    out->push_back(' ');
+    out->append(m_serverIpAddress->c_str());
+    out->push_back(' ');
+    out->append(std::to_string(this->m_serverPort));
+    out->push_back('\n');
+
+    if (parts & audit_log::AuditLog::BAuditLogPart) {
+        section('B');
+        out->append(utils::string::dash_if_empty(
+            m_variableRequestMethod.evaluate()));
+        out->push_back(' ');
+        out->append(this->m_uri.c_str());
+        out->append(" HTTP/");
+        out->append(this->m_httpVersion.c_str());
+        out->push_back('\n');
+
+        for (const VariableValue *h : requestHeaders) {
+            size_t pos = strlen("REQUEST_HEADERS:");
+            out->append(h->getKeyWithCollection().c_str() + pos);
+            out->append(": ");
+            out->append(h->getValue().c_str());
+            out->push_back('\n');
+            delete h;
+        }
+        out->push_back('\n');
+    }
+    if (parts & audit_log::AuditLog::CAuditLogPart
+        &&  m_requestBody.empty() == false) {
+        const std::string &body = m_requestBody.str();
+        section('C');
         if (body.size() > 0) {
-            audit_log << body << std::endl;
+            out->append(body);
+            out->push_back('\n');
         }
-        audit_log << std::endl;
+        out->push_back('\n');
     }
     if (parts & audit_log::AuditLog::DAuditLogPart) {
-        audit_log << "--" << trailer << "-" << "D--" << std::endl;
-        audit_log << std::endl;
+        section('D');
+        out->push_back('\n');
         /** TODO: write audit_log D part. */
     }
     if (parts & audit_log::AuditLog::EAuditLogPart
-        && m_responseBody.tellp() > 0) {
-        std::string body = utils::string::toHexIfNeeded(m_responseBody.str());
-        audit_log << "--" << trailer << "-" << "E--" << std::endl;
-        if (body.size() > 0) {
-            audit_log << body << std::endl;
+        && m_responseBody.empty() == false) {
+        section('E');
+        if (responseBody.size() > 0) {
+            out->append(responseBody);
+            out->push_back('\n');
         }
-        audit_log << std::endl;
+        out->push_back('\n');
     }
     if (parts & audit_log::AuditLog::FAuditLogPart) {
-        std::vector<const VariableValue *> l;
-
-        audit_log << "--" << trailer << "-" << "F--" << std::endl;
-        audit_log << "HTTP/" << m_httpVersion.c_str()  << " ";
-        audit_log << this->m_httpCodeReturned << std::endl;
-        m_variableResponseHeaders.resolve(&l);
-        for (auto &h : l) {
-            audit_log << h->getKey().c_str() << ": ";
-            audit_log << h->getValue().c_str() << std::endl;
+        section('F');
+        out->append("HTTP/");
+        out->append(m_httpVersion.c_str());
+        out->push_back(' ');
+        out->append(std::to_string(this->m_httpCodeReturned));
+        out->push_back('\n');
+        for (const VariableValue *h : responseHeaders) {
+            out->append(h->getKey().c_str());
+            out->append(": ");
+            out->append(h->getValue().c_str());
+            out->push_back('\n');
             delete h;
         }
     }
-    audit_log << std::endl;
+    out->push_back('\n');
 
     if (parts & audit_log::AuditLog::GAuditLogPart) {
-        audit_log << "--" << trailer << "-" << "G--" << std::endl;
-        audit_log << std::endl;
+        section('G');
+        out->push_back('\n');
         /** TODO: write audit_log G part. */
     }
     if (parts & audit_log::AuditLog::HAuditLogPart) {
-        audit_log << "--" << trailer << "-" << "H--" << std::endl;
-        for (auto a : m_rulesMessages) {
-            audit_log << a.log(0, m_httpCodeReturned) << std::endl;
+        section('H');
+        for (auto &a : m_rulesMessages) {
+            out->append(a.log(0, m_httpCodeReturned));
+            out->push_back('\n');
         }
-        audit_log << std::endl;
+        out->push_back('\n');
         /** TODO: write audit_log H part. */
     }
     if (parts & audit_log::AuditLog::IAuditLogPart) {
-        audit_log << "--" << trailer << "-" << "I--" << std::endl;
-        audit_log << std::endl;
+        section('I');
+        out->push_back('\n');
         /** TODO: write audit_log I part. */
     }
     if (parts & audit_log::AuditLog::JAuditLogPart) {
-        audit_log << "--" << trailer << "-" << "J--" << std::endl;
-        audit_log << std::endl;
+        section('J');
+        out->push_back('\n');
         /** TODO: write audit_log J part. */
     }
     if (parts & audit_log::AuditLog::KAuditLogPart) {
-        audit_log << "--" << trailer << "-" << "K--" << std::endl;
-        audit_log << std::endl;
+        section('K');
+        out->push_back('\n');
         /** TODO: write audit_log K part. */
     }
-    audit_log << "--" << trailer << "-" << "Z--" << std::endl << std::endl;
-
-    return audit_log.str();
+    section('Z');
+    out->push_back('\n');
 }
 
 
+#ifdef WITH_YAJL
+namespace {
+
+/*
+ * The JSON generator of the thread, kept from one audit log record to the
+ * next so that its buffer is not allocated again for each of them.
+ */
+class JSONGenerator {
+ public:
+    JSONGenerator() : m_g(yajl_gen_alloc(Utils::Allocator::yajl())) {
+        if (m_g != NULL) {
+            yajl_gen_config(m_g, yajl_gen_beautify, 0);
+        }
+    }
+
+    ~JSONGenerator() {
+        if (m_g != NULL) {
+            yajl_gen_free(m_g);
+        }
+    }
+
+    yajl_gen get() {
+        if (m_g != NULL) {
+            yajl_gen_clear(m_g);
+            yajl_gen_reset(m_g, NULL);
+        }
+        return m_g;
+    }
+
+ private:
+    yajl_gen m_g;
+};
+
+}  // namespace
+#endif
+
+
 std::string Transaction::toJSON(int parts) {
+    std::string log;
+    toJSON(parts, &log);
+    return log;
+}
+
+
+/**
+ * Appends the JSON audit log record of the transaction to out, which the
+ * writers keep from one record to the next.
+ *
+ */
+void Transaction::toJSON(int parts, std::string *out) {
 #ifdef WITH_YAJL
+    static thread_local JSONGenerator generator;
     const unsigned char *buf;
     size_t len;
     yajl_gen g;
-    std::string log;
-    std::string ts = utils::string::ascTime(&m_timeStamp).c_str();
-    std::string uniqueId = UniqueId::uniqueId();
+    const std::string &ts = Utils::LogStrings::ascTime(m_timeStamp);
+    const std::string &uniqueId = Utils::LogStrings::serverId();
 
-    g = yajl_gen_alloc(NULL);
+    g = generator.get();
     if (g == NULL) {
-      return "";
+      return;
     }
-    yajl_gen_config(g, yajl_gen_beautify, 0);
 
     /* main */
     yajl_gen_map_open(g);
@@ -1837,6 +3333,23 @@ std::string Transaction::toJSON(int parts) {
         }
         yajl_gen_array_close(g);
         /* end: messages */
+
+        /* timings, in microseconds; logging is still running by now */
+        if (m_rules->m_auditLog != NULL
+            && m_rules->m_auditLog->getTimings()) {
+            yajl_gen_string(g,
+                reinterpret_cast<const unsigned char*>("timings"),
+                strlen("timings"));
+            yajl_gen_map_open(g);
+            LOGFY_ADD_NUM("request_headers",
+                m_timings.request_headers / 1000);
+            LOGFY_ADD_NUM("request_body", m_timings.request_body / 1000);
+            LOGFY_ADD_NUM("response_headers",
+                m_timings.response_headers / 1000);
+            LOGFY_ADD_NUM("response_body", m_timings.response_body / 1000);
+            LOGFY_ADD_NUM("total", m_timings.total / 1000);
+            yajl_gen_map_close(g);
+        }
     }
 
     /* end: transaction */
@@ -1847,21 +3360,267 @@ std::string Transaction::toJSON(int parts) {
 
     yajl_gen_get_buf(g, &buf, &len);
 
-    log.assign(reinterpret_cast<const char*>(buf), len);
-    log.append("\n");
-
-    yajl_gen_free(g);
-
-    return log;
+    out->append(reinterpret_cast<const char*>(buf), len);
+    out->append("\n");
 #else
-    return std::string("{\"error\":\"ModSecurity was " \
+    out->append("{\"error\":\"ModSecurity was " \
         "not compiled with JSON support.\"}");
 #endif
 }
 
 
+/**
+ * Appends the audit log record of the transaction to out, in MessagePack:
+ * the same document as toJSON, with the same keys and string values
+ * (http_version included, which JSON has as a number), preceded by its
+ * size as a 4 bytes big endian integer. Bodies go in whole, as they are.
+ *
+ */
+void Transaction::toMsgPack(int parts, std::string *out) {
+    size_t start = out->size();
+    Utils::MsgPack m(out);
+
+    out->append(4, '\0');
+
+    /* main */
+    m.mapOpen();
+
+    /* trasaction */
+    m.string("transaction");
+    m.mapOpen();
+    /* Part: A (header mandatory) */
+    m.add("client_ip", *m_clientIpAddress);
+    m.add("time_stamp", Utils::LogStrings::ascTime(m_timeStamp));
+    m.add("server_id", Utils::LogStrings::serverId());
+    m.add("client_port", static_cast<int64_t>(m_clientPort));
+    m.add("host_ip", *m_serverIpAddress);
+    m.add("host_port", static_cast<int64_t>(m_serverPort));
+    m.add("unique_id", *m_id);
+
+    /* request */
+    m.string("request");
+    m.mapOpen();
+    m.add("method", utils::string::dash_if_empty(
+        m_variableRequestMethod.evaluate()));
+    m.add("http_version", m_httpVersion);
+    m.add("uri", m_uri);
+    if (parts & audit_log::AuditLog::CAuditLogPart) {
+        m.add("body", m_requestBody.str());
+    }
+    if (parts & audit_log::AuditLog::BAuditLogPart) {
+        std::vector<const VariableValue *> l;
+        m.string("headers");
+        m.mapOpen();
+        m_variableRequestHeaders.resolve(&l);
+        for (auto &h : l) {
+            m.add(h->getKey().c_str(), h->getValue());
+            delete h;
+        }
+        m.mapClose();
+    }
+    /* end: request */
+    m.mapClose();
+
+    /* response */
+    m.string("response");
+    m.mapOpen();
+    if (parts & audit_log::AuditLog::EAuditLogPart) {
+        m.add("body", m_responseBody.str());
+    }
+    m.add("http_code", static_cast<int64_t>(m_httpCodeReturned));
+    if (parts & audit_log::AuditLog::FAuditLogPart) {
+        std::vector<const VariableValue *> l;
+        m.string("headers");
+        m.mapOpen();
+        m_variableResponseHeaders.resolve(&l);
+        for (auto &h : l) {
+            m.add(h->getKey().c_str(), h->getValue());
+            delete h;
+        }
+        m.mapClose();
+    }
+    /* end: response */
+    m.mapClose();
+
+    /* producer */
+    if (parts & audit_log::AuditLog::HAuditLogPart) {
+        m.string("producer");
+        m.mapOpen();
+        m.add("modsecurity", m_ms->whoAmI());
+        m.add("connector", m_ms->getConnectorInformation());
+        m.add("secrules_engine", RulesSet::ruleEngineStateString(
+            (RulesSetProperties::RuleEngine) getRuleEngineState()));
+        m.string("components");
+        m.arrayOpen();
+        for (auto &a : m_rules->m_components) {
+            m.string(a);
+        }
+        m.arrayClose();
+        /* end: producer */
+        m.mapClose();
+
+        /* messages */
+        m.string("messages");
+        m.arrayOpen();
+        for (auto &a : m_rulesMessages) {
+            m.mapOpen();
+            m.add("message", a.m_message);
+            m.string("details");
+            m.mapOpen();
+            m.add("match", a.m_match);
+            m.add("reference", a.m_reference);
+            m.add("ruleId", std::to_string(a.m_ruleId));
+            m.add("file", *a.m_ruleFile);
+            m.add("lineNumber", std::to_string(a.m_ruleLine));
+            m.add("data", a.m_data);
+            m.add("severity", std::to_string(a.m_severity));
+            m.add("ver", a.m_ver);
+            m.add("rev", a.m_rev);
+            m.string("tags");
+            m.arrayOpen();
+            for (auto &b : a.m_tags) {
+                m.string(b);
+            }
+            m.arrayClose();
+            m.add("maturity", std::to_string(a.m_maturity));
+            m.add("accuracy", std::to_string(a.m_accuracy));
+            m.mapClose();
+            m.mapClose();
+        }
+        m.arrayClose();
+        /* end: messages */
+
+        /* timings, in microseconds; logging is still running by now */
+        if (m_rules->m_auditLog != NULL
+            && m_rules->m_auditLog->getTimings()) {
+            m.string("timings");
+            m.mapOpen();
+            m.add("request_headers",
+                static_cast<int64_t>(m_timings.request_headers / 1000));
+            m.add("request_body",
+                static_cast<int64_t>(m_timings.request_body / 1000));
+            m.add("response_headers",
+                static_cast<int64_t>(m_timings.response_headers / 1000));
+            m.add("response_body",
+                static_cast<int64_t>(m_timings.response_body / 1000));
+            m.add("total", static_cast<int64_t>(m_timings.total / 1000));
+            m.mapClose();
+        }
+    }
+
+    /* end: transaction */
+    m.mapClose();
+
+    /* end: main */
+    m.mapClose();
+
+    uint32_t size = out->size() - start - 4;
+    for (int i = 0; i < 4; i++) {
+        (*out)[start + i] = static_cast<char>((size >> ((3 - i) * 8)) & 0xff);
+    }
+}
+
+
 void Transaction::serverLog(std::shared_ptr<RuleMessage> rm) {
-    m_ms->serverLog(m_logCbData, rm);
+    if (m_shadow) {
+        return;
+    }
+    m_ms->serverLog(m_logCbData, rm, m_rulesVersion);
+}
+
+
+/*
+ * Hands the transaction, that is done with, over to the shadow runner
+ * when SecShadowRules is set; the bodies go with it. Left out, and
+ * counted, when the runner is behind.
+ */
+void Transaction::shadow() {
+    if (m_rules->m_shadow == nullptr || m_uri.empty()) {
+        return;
+    }
+
+    std::shared_ptr<ShadowTransaction> replay =
+        std::make_shared<ShadowTransaction>(this, m_rules->m_shadow);
+    ModSecurity *ms = m_ms;
+    if (ms->shadowRunner()->offer([replay, ms]() { replay->run(ms); })) {
+        return;
+    }
+    Utils::Metrics::getInstance().increment(
+        Utils::Metrics::ShadowShedCounter);
+    ms_dbg(4, "Shadow rules are behind, the transaction is not shadowed.");
+}
+
+
+/**
+ * @name    needsRequestBody
+ * @brief   Whether the request body is still to be looked at.
+ *
+ * False once the rule engine is off, request body access is off (also by
+ * ctl:requestBodyAccess) or an allow action ended the inspection of the
+ * request. The connector can then send the body on as it arrives, without
+ * appending it: REQUEST_BODY and the arguments in it stay empty for the
+ * rules of the later phases, and for the audit log.
+ *
+ */
+bool Transaction::needsRequestBody() const {
+    if (getRuleEngineState() == RulesSet::DisabledRuleEngine) {
+        return false;
+    }
+    if (m_allowType == actions::disruptive::RequestAllowType
+        || m_allowType == actions::disruptive::FromNowOnAllowType) {
+        return false;
+    }
+    if (m_requestBodyAccess
+        != RulesSetProperties::PropertyNotSetConfigBoolean) {
+        return m_requestBodyAccess == RulesSetProperties::TrueConfigBoolean;
+    }
+    return m_rules->m_secRequestBodyAccess
+        != RulesSetProperties::FalseConfigBoolean;
+}
+
+
+/**
+ * @name    needsResponseHeaders
+ * @brief   Whether the response headers are still to be looked at.
+ *
+ * False once the rule engine is off or an allow action (without a phase or
+ * request argument) ended the inspection of the whole transaction.
+ *
+ */
+bool Transaction::needsResponseHeaders() const {
+    if (getRuleEngineState() == RulesSet::DisabledRuleEngine) {
+        return false;
+    }
+    return m_allowType != actions::disruptive::FromNowOnAllowType;
+}
+
+
+/**
+ * @name    needsResponseBody
+ * @brief   Whether the response body is still to be looked at.
+ *
+ * False as needsResponseHeaders() is, without SecResponseBodyAccess and,
+ * once the response headers gave one, for a Content-Type that is not in
+ * SecResponseBodyMimeType: processResponseBody() would not look at it.
+ *
+ */
+bool Transaction::needsResponseBody() const {
+    if (needsResponseHeaders() == false) {
+        return false;
+    }
+    if (m_rules->m_secResponseBodyAccess
+        != RulesSetProperties::TrueConfigBoolean) {
+        return false;
+    }
+
+    const std::string &type = m_variableResponseContentType.m_value;
+    if (type.empty() || m_rules->m_responseBodyTypeToBeInspected.m_set
+        == false) {
+        return true;
+    }
+    const std::set<std::string> &bi =
+        m_rules->m_responseBodyTypeToBeInspected.m_value;
+    return bi.find(type) != bi.end();
 }
 
 
@@ -1874,6 +3633,98 @@ int Transaction::getRuleEngineState() const {
 }
 
 
+/**
+ * @name    timeBudgetExceeded
+ * @brief   Whether the transaction went over SecTransactionTimeBudget.
+ *
+ * Meant to be called often, between rules and parts of a body: the clock
+ * is only looked at once every 8 calls. The first call that finds the
+ * budget used up sets MSC_TIME_BUDGET_EXCEEDED (and TX of the same name)
+ * to 1; from there on it is always true.
+ *
+ * @retval true  The budget is used up.
+ * @retval false There is no budget, it is not used up, or this call did
+ *               not look.
+ *
+ */
+bool Transaction::timeBudgetExceeded() {
+    if (m_timeBudgetExceeded) {
+        return true;
+    }
+    if (m_timeBudgetDeadline == 0 || (m_timeBudgetChecks++ & 7) != 0
+        || utils::monotonic_ns() < m_timeBudgetDeadline) {
+        return false;
+    }
+
+    m_timeBudgetExceeded = true;
+    m_variableMscTimeBudgetExceeded.set("1", m_variableOffset);
+    m_collections.m_tx_collection->storeOrUpdateFirst(
+        "MSC_TIME_BUDGET_EXCEEDED", "1");
+    ms_dbg(4, "Transaction time budget of " \
+        + std::to_string(m_rules->m_transactionTimeBudget.m_value) \
+        + " ms exceeded, set TX.MSC_TIME_BUDGET_EXCEEDED to 1.");
+    Utils::Metrics::getInstance().increment(
+        Utils::Metrics::TimeBudgetExceededCounter);
+
+    return true;
+}
+
+
+/**
+ * @name    accountMemory
+ * @brief   Counts bytes about to be taken by the collections against
+ *          SecTransactionMemoryLimit.
+ *
+ * The bodies buffered so far count too. The first call that goes over
+ * the limit sets MSC_MEMORY_LIMIT_EXCEEDED (and TX of the same name) to
+ * 1; from there on nothing more is counted and it is always false.
+ * Callers that can do without what they were about to store (the
+ * arguments) leave it out; the headers are stored anyway.
+ *
+ * @param bytes An estimate of what is about to be stored.
+ *
+ * @retval true  There is no limit, or it still holds.
+ * @retval false The limit is gone over.
+ *
+ */
+bool Transaction::accountMemory(size_t bytes) {
+    if (m_memoryLimitExceeded) {
+        return false;
+    }
+    m_memoryUsed = m_memoryUsed + bytes;
+    if (!m_rules->m_transactionMemoryLimit.m_set
+        || memoryUsage() <= static_cast<size_t>(
+            m_rules->m_transactionMemoryLimit.m_value)) {
+        return true;
+    }
+
+    m_memoryLimitExceeded = true;
+    m_variableMscMemoryLimitExceeded.set("1", m_variableOffset);
+    m_collections.m_tx_collection->storeOrUpdateFirst(
+        "MSC_MEMORY_LIMIT_EXCEEDED", "1");
+    ms_dbg(4, "Transaction memory limit of " \
+        + std::to_string(m_rules->m_transactionMemoryLimit.m_value) \
+        + " bytes exceeded, set TX.MSC_MEMORY_LIMIT_EXCEEDED to 1.");
+    Utils::Metrics::getInstance().increment(
+        Utils::Metrics::MemoryLimitExceededCounter);
+
+    return false;
+}
+
+
+/**
+ * @name    memoryUsage
+ * @brief   Estimate of the bytes held by the transaction.
+ *
+ * What accountMemory counted plus the request and response bodies
+ * buffered so far.
+ *
+ */
+size_t Transaction::memoryUsage() const {
+    return m_memoryUsed + m_requestBody.size() + m_responseBody.size();
+}
+
+
 /**
  * @name    updateStatusCode
  * @brief   Updates response status code.
@@ -2058,6 +3909,28 @@ extern "C" int msc_append_request_body(Transaction *transaction,
 }
 
 
+/**
+ * @name    msc_append_request_body_iov
+ * @brief   Adds the pieces of a request body to be inspected.
+ *
+ * Same as calling msc_append_request_body for each of the pieces, in
+ * order, for connectors that hold the body as a chain of buffers.
+ *
+ * @param transaction ModSecurity transaction.
+ * @param iov         the pieces.
+ * @param n           how many there are.
+ *
+ * @returns If the operation was successful or not.
+ * @retval 1 Operation was successful.
+ * @retval 0 Operation failed.
+ *
+ */
+extern "C" int msc_append_request_body_iov(Transaction *transaction,
+    const msc_iovec *iov, size_t n) {
+    return transaction->appendRequestBody(iov, n);
+}
+
+
 extern "C" int msc_request_body_from_file(Transaction *transaction,
     const char *path) {
     return transaction->requestBodyFromFile(path);
@@ -2136,6 +4009,28 @@ extern "C" int msc_append_response_body(Transaction *transaction,
 }
 
 
+/**
+ * @name    msc_append_response_body_iov
+ * @brief   Adds the pieces of a response body to be inspected.
+ *
+ * Same as calling msc_append_response_body for each of the pieces, in
+ * order, for connectors that hold the body as a chain of buffers.
+ *
+ * @param transaction ModSecurity transaction.
+ * @param iov         the pieces.
+ * @param n           how many there are.
+ *
+ * @returns If the operation was successful or not.
+ * @retval 1 Operation was successful.
+ * @retval 0 Operation failed.
+ *
+ */
+extern "C" int msc_append_response_body_iov(Transaction *transaction,
+    const msc_iovec *iov, size_t n) {
+    return transaction->appendResponseBody(iov, n);
+}
+
+
 /**
  * @name    msc_add_request_header
  * @brief   Adds a request header
@@ -2186,6 +4081,149 @@ extern "C" int msc_add_n_request_header(Transaction *transaction,
 }
 
 
+namespace {
+
+/*
+ * Feeds a list of headers through a key and a value string that last
+ * for the whole list, so that only the first few of them allocate.
+ */
+int addHeaders(Transaction *transaction, const msc_header *headers,
+    size_t n, bool response) {
+    std::string key;
+    std::string value;
+    int ret = 1;
+
+    for (size_t i = 0; i < n; i++) {
+        key.assign(reinterpret_cast<const char *>(headers[i].key),
+            headers[i].key_len);
+        value.assign(reinterpret_cast<const char *>(headers[i].value),
+            headers[i].value_len);
+        int added = response ? transaction->addResponseHeader(key, value)
+            : transaction->addRequestHeader(key, value);
+        if (added == 0) {
+            ret = 0;
+        }
+    }
+
+    return ret;
+}
+
+}  // namespace
+
+
+/**
+ * @name    msc_add_request_headers
+ * @brief   Adds all the request headers at once
+ *
+ * Same as calling msc_add_n_request_header for each of the headers, in
+ * order, for connectors that hold the whole list already.
+ *
+ * @param transaction ModSecurity transaction.
+ * @param headers     the headers.
+ * @param n           how many there are.
+ *
+ * @returns If the operation was successful or not.
+ * @retval 1 Operation was successful.
+ * @retval 0 Operation failed.
+ *
+ */
+extern "C" int msc_add_request_headers(Transaction *transaction,
+    const msc_header *headers, size_t n) {
+    return addHeaders(transaction, headers, n, false);
+}
+
+
+/**
+ * @name    msc_process_request
+ * @brief   Feeds a whole request and runs the phases 1 and 2 on it
+ *
+ * Does what msc_process_connection, msc_process_uri,
+ * msc_add_request_headers, msc_process_request_headers,
+ * msc_append_request_body and msc_process_request_body would, in that
+ * order, for connectors that have the whole request at hand. It stops
+ * before the request body when the headers raised a disruptive
+ * intervention.
+ *
+ * @note The strings of req, other than the headers and the body, are
+ *       expected to be NULL terminated.
+ * @note Remember to check for a possible intervention.
+ * @note A non blocking transaction waits for its suspended phases here.
+ *
+ * @param transaction ModSecurity transaction.
+ * @param req         the request.
+ *
+ * @returns If the operation was successful or not.
+ * @retval 1 Operation was successful.
+ * @retval 0 Operation failed.
+ *
+ */
+extern "C" int msc_process_request(Transaction *transaction,
+    const msc_request *req) {
+    transaction->processConnection(req->client_ip, req->client_port,
+        req->server_ip, req->server_port);
+    transaction->processURI(req->uri, req->method, req->http_version);
+    int ret = addHeaders(transaction, req->headers, req->headers_n, false);
+    if (transaction->processRequestHeaders() == MSC_AGAIN) {
+        transaction->wait();
+    }
+    if (transaction->m_it.disruptive) {
+        return ret;
+    }
+
+    transaction->appendRequestBody(req->body, req->body_n);
+    if (transaction->m_it.disruptive) {
+        return ret;
+    }
+    if (transaction->processRequestBody() == MSC_AGAIN) {
+        transaction->wait();
+    }
+
+    return ret;
+}
+
+
+/**
+ * @name    msc_process_response
+ * @brief   Feeds a whole response and runs the phases 3 and 4 on it
+ *
+ * The response side of msc_process_request: the headers are added, the
+ * response headers processed and, unless that raised a disruptive
+ * intervention, the body appended and processed.
+ *
+ * @note Remember to check for a possible intervention.
+ * @note A non blocking transaction waits for its suspended phases here.
+ *
+ * @param transaction ModSecurity transaction.
+ * @param res         the response.
+ *
+ * @returns If the operation was successful or not.
+ * @retval 1 Operation was successful.
+ * @retval 0 Operation failed.
+ *
+ */
+extern "C" int msc_process_response(Transaction *transaction,
+    const msc_response *res) {
+    int ret = addHeaders(transaction, res->headers, res->headers_n, true);
+    if (transaction->processResponseHeaders(res->code, res->protocol)
+        == MSC_AGAIN) {
+        transaction->wait();
+    }
+    if (transaction->m_it.disruptive) {
+        return ret;
+    }
+
+    transaction->appendResponseBody(res->body, res->body_n);
+    if (transaction->m_it.disruptive) {
+        return ret;
+    }
+    if (transaction->processResponseBody() == MSC_AGAIN) {
+        transaction->wait();
+    }
+
+    return ret;
+}
+
+
 /**
  * @name    msc_add_response_header
  * @brief   Adds a response header
@@ -2252,6 +4290,36 @@ extern "C" void msc_transaction_cleanup(Transaction *transaction) {
 }
 
 
+/**
+ * @name    msc_transaction_reset
+ * @brief   Recycles a Transaction to be used on a new request.
+ *
+ * Alternative to msc_transaction_cleanup followed by msc_new_transaction,
+ * without paying again for most of the allocations. The rules and the
+ * ModSecurity core used on the creation are kept.
+ *
+ * @param transaction ModSecurity transaction.
+ *
+ */
+extern "C" void msc_transaction_reset(Transaction *transaction) {
+    transaction->reset();
+}
+
+
+/**
+ * @name    msc_transaction_reset_with_id
+ * @brief   Same as msc_transaction_reset, using the given unique id.
+ *
+ * @param transaction ModSecurity transaction.
+ * @param id Unique id for the request that follows.
+ *
+ */
+extern "C" void msc_transaction_reset_with_id(Transaction *transaction,
+    char *id) {
+    transaction->reset(id);
+}
+
+
 /**
  * @name    msc_intervention
  * @brief   Check if ModSecurity has anything to ask to the server.
@@ -2279,6 +4347,11 @@ extern "C" int msc_intervention(Transaction *transaction,
  * contents of the response body, otherwise there is no need to call this
  * function.
  *
+ * @note When msc_rules_needs_response_body() is false for the rules in use
+ *       the body passed to msc_append_response_body() is not kept and the
+ *       returned buffer is empty. Connectors must keep forwarding their own
+ *       copy of the response in that case.
+ *
  * @param transaction ModSecurity transaction.
  *
  * @return It returns a buffer (const char *)
@@ -2321,6 +4394,68 @@ extern "C" size_t msc_get_request_body_length(Transaction *transaction) {
     return transaction->getRequestBodyLength();
 }
 
+/**
+ * @name    msc_transaction_memory_usage
+ * @brief   Estimate of the bytes held by the transaction.
+ *
+ * The collected arguments and headers plus the bodies buffered so far;
+ * what SecTransactionMemoryLimit is checked against.
+ *
+ * @param transaction ModSecurity transaction.
+ *
+ * @return Bytes, an estimate.
+ *
+ */
+extern "C" size_t msc_transaction_memory_usage(Transaction *transaction) {
+    return transaction->memoryUsage();
+}
+
+/**
+ * @name    msc_needs_request_body
+ * @brief   Whether the request body still has to be appended.
+ *
+ * Asked after msc_process_request_headers(): 0 when the rules (or the
+ * configuration) left nothing to do with the request body, which the
+ * connector can then stream on without buffering it.
+ *
+ * @param transaction ModSecurity transaction.
+ *
+ * @return 1 if the body is to be appended, 0 if it is not.
+ *
+ */
+extern "C" int msc_needs_request_body(Transaction *transaction) {
+    return transaction->needsRequestBody() ? 1 : 0;
+}
+
+/**
+ * @name    msc_needs_response_headers
+ * @brief   Whether the response headers still have to be processed.
+ *
+ * @param transaction ModSecurity transaction.
+ *
+ * @return 1 if the headers are to be added and processed, 0 if not.
+ *
+ */
+extern "C" int msc_needs_response_headers(Transaction *transaction) {
+    return transaction->needsResponseHeaders() ? 1 : 0;
+}
+
+/**
+ * @name    msc_needs_response_body
+ * @brief   Whether the response body still has to be appended.
+ *
+ * Best asked after msc_process_response_headers(), when the Content-Type
+ * of the response is known.
+ *
+ * @param transaction ModSecurity transaction.
+ *
+ * @return 1 if the body is to be appended, 0 if it is not.
+ *
+ */
+extern "C" int msc_needs_response_body(Transaction *transaction) {
+    return transaction->needsResponseBody() ? 1 : 0;
+}
+
 /**
  * @name    msc_process_logging
  * @brief   Logging all information relative to this transaction.
@@ -2340,6 +4475,107 @@ extern "C" int msc_process_logging(Transaction *transaction) {
 }
 
 
+/**
+ * @name    msc_transaction_set_non_blocking
+ * @brief   Lets the process calls hand the phases that may block over.
+ *
+ * With nonBlocking set, msc_process_request_headers,
+ * msc_process_request_body, msc_process_response_headers,
+ * msc_process_response_body and msc_process_logging return MSC_AGAIN
+ * when the rules of their phase may block on I/O (@rbl, @inspectFile,
+ * @geoLookup, Lua scripts, persistent collections on Redis): the phase
+ * then goes on on a thread of the ModSecurity instance (see
+ * msc_set_async_threads). The connector polls msc_transaction_fd for
+ * reading and calls msc_transaction_resume once it is readable. Nothing
+ * else of the transaction may be called in the meantime.
+ *
+ * @param transaction ModSecurity transaction.
+ * @param nonBlocking 1 for the non blocking mode, 0 (the default) for
+ *                    the phases to always run within the call.
+ *
+ */
+extern "C" void msc_transaction_set_non_blocking(Transaction *transaction,
+    int nonBlocking) {
+    transaction->setNonBlocking(nonBlocking != 0);
+}
+
+
+/**
+ * @name    msc_transaction_fd
+ * @brief   The file descriptor to poll for a suspended phase.
+ *
+ * It turns readable once the phase is done. It belongs to the
+ * transaction, which closes it, and stays the same for its whole life.
+ *
+ * @param transaction ModSecurity transaction.
+ *
+ * @returns The file descriptor, -1 if no phase was ever suspended.
+ *
+ */
+extern "C" int msc_transaction_fd(Transaction *transaction) {
+    return transaction->asyncFd();
+}
+
+
+/**
+ * @name    msc_transaction_resume
+ * @brief   Completes the process call that returned MSC_AGAIN.
+ *
+ * @note Remember to check for a possible intervention once it is done.
+ *
+ * @param transaction ModSecurity transaction.
+ *
+ * @returns What the process call would have returned, once it is done.
+ * @retval MSC_AGAIN The phase still goes on.
+ * @retval 1 Operation was successful.
+ *
+ */
+extern "C" int msc_transaction_resume(Transaction *transaction) {
+    return transaction->resume();
+}
+
+
+/**
+ * @name    msc_get_timings
+ * @brief   Time spent so far in each of the processing phases.
+ *
+ * Meant for connectors exporting the latency added by the inspection. The
+ * logging time of a transaction is only complete once msc_process_logging
+ * returned.
+ *
+ * @param transaction ModSecurity transaction.
+ * @param timings Filled with the time spent, in nanoseconds, in each phase.
+ *
+ * @returns If the operation was successful or not.
+ * @retval 1 Operation was successful.
+ * @retval 0 Operation failed.
+ *
+ */
+extern "C" int msc_get_timings(Transaction *transaction,
+    ModSecurityTimings *timings) {
+    if (timings == NULL) {
+        return 0;
+    }
+    transaction->timings(timings);
+    return 1;
+}
+
+
+/**
+ * @name    msc_set_trace_parent
+ * @brief   Traces the transaction, see msc_set_trace_cb.
+ *
+ * @param transaction ModSecurity transaction.
+ * @param parent Given back with each span of the transaction; NULL stops
+ *               the tracing. Reset along with the transaction.
+ *
+ */
+extern "C" void msc_set_trace_parent(Transaction *transaction,
+    void *parent) {
+    transaction->setTraceParent(parent);
+}
+
+
 /**
  * @name    msc_update_status_code
  * @brief   Updates response status code.
@@ -37,7 +37,7 @@ class UniqueId {
         return instance;
     }
 
-    static std::string uniqueId() {
+    static const std::string &uniqueId() {
         std::call_once(UniqueId::onceFlag,[]() {
             UniqueId::getInstance().fillUniqueId();
         });
@@ -0,0 +1,163 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/uri_rules.h"
+
+#include <algorithm>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "modsecurity/rule_with_operator.h"
+#include "modsecurity/transaction.h"
+#include "src/actions/transformations/transformation.h"
+#include "src/operators/begins_with.h"
+#include "src/operators/str_eq.h"
+#include "src/run_time_string.h"
+#include "src/variables/request_file_name.h"
+#include "src/variables/request_uri.h"
+#include "src/variables/variable.h"
+
+
+namespace modsecurity {
+
+
+UriRules::UriRules()
+    : m_size(0) {
+    for (int target = 0; target < NumberOfTargets; target++) {
+        m_nodes[target].resize(1);
+    }
+}
+
+
+/*
+ * Only the chain starter is looked at; a chain does not go on unless it
+ * matches. No transformation, t:none aside, as the trie is walked along
+ * the value as it is, and no macro in the parameter.
+ */
+bool UriRules::add(const RulesSet *set, RuleWithOperator *rule) {
+    const RulesSet::RuleTargets *targets = set->getRuleTargets(rule);
+    const operators::Operator *op = rule->getOperator();
+    std::vector<actions::transformations::Transformation *> chain;
+    Target target;
+
+    if (targets == nullptr || targets->m_variables->size() != 1
+        || targets->m_exclusion->empty() == false
+        || op == nullptr || op->m_negation
+        || (typeid(*op) != typeid(operators::BeginsWith)
+            && typeid(*op) != typeid(operators::StrEq))
+        || op->m_string == nullptr || op->m_string->m_containsMacro
+        || op->m_param.empty()) {
+        return false;
+    }
+
+    const variables::Variable *var = targets->m_variables->at(0);
+    if (var != nullptr
+        && typeid(*var) == typeid(variables::RequestFilename)) {
+        target = RequestFilename;
+    } else if (var != nullptr
+        && typeid(*var) == typeid(variables::RequestURI)) {
+        target = RequestUri;
+    } else {
+        return false;
+    }
+
+    rule->getTransformationsChain(set, &chain);
+    for (const actions::transformations::Transformation *t : chain) {
+        if (t->m_isNone == false) {
+            return false;
+        }
+    }
+
+    Node &n = m_nodes[target][node(target, op->m_param)];
+    if (typeid(*op) == typeid(operators::BeginsWith)) {
+        n.m_prefix.push_back(m_size);
+    } else {
+        n.m_exact.push_back(m_size);
+    }
+    m_size++;
+    return true;
+}
+
+
+bool UriRules::usable(const Transaction *t) {
+    return ms_dbg_a_enabled(t, 4) == false
+        && t->m_ruleProfile == nullptr;
+}
+
+
+bool UriRules::open(size_t index, const Transaction *t, Open *open) const {
+    if (open->m_walked == false) {
+        open->m_open.assign(m_size, false);
+        walk(RequestFilename, t->m_variableRequestFilename.m_value, open);
+        walk(RequestUri, t->m_variableRequestURI.m_value, open);
+        open->m_walked = true;
+    }
+    return open->m_open[index];
+}
+
+
+/* The node for path, created along with the ones on the way to it. */
+uint32_t UriRules::node(Target target, const std::string &path) {
+    std::vector<Node> &nodes = m_nodes[target];
+    uint32_t n = 0;
+
+    for (unsigned char c : path) {
+        auto &next = nodes[n].m_next;
+        auto it = std::lower_bound(next.begin(), next.end(),
+            std::make_pair(c, static_cast<uint32_t>(0)));
+        if (it != next.end() && it->first == c) {
+            n = it->second;
+            continue;
+        }
+        uint32_t child = nodes.size();
+        next.insert(it, std::make_pair(c, child));
+        nodes.emplace_back();
+        n = child;
+    }
+    return n;
+}
+
+
+void UriRules::walk(Target target, const std::string &value,
+    Open *open) const {
+    const std::vector<Node> &nodes = m_nodes[target];
+    uint32_t n = 0;
+    size_t i = 0;
+
+    for (;;) {
+        for (uint32_t r : nodes[n].m_prefix) {
+            open->m_open[r] = true;
+        }
+        if (i == value.size()) {
+            for (uint32_t r : nodes[n].m_exact) {
+                open->m_open[r] = true;
+            }
+            return;
+        }
+        const auto &next = nodes[n].m_next;
+        unsigned char c = value[i++];
+        auto it = std::lower_bound(next.begin(), next.end(),
+            std::make_pair(c, static_cast<uint32_t>(0)));
+        if (it == next.end() || it->first != c) {
+            return;
+        }
+        n = it->second;
+    }
+}
+
+
+}  // namespace modsecurity
@@ -0,0 +1,115 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "modsecurity/rules_set.h"
+
+#ifndef SRC_URI_RULES_H_
+#define SRC_URI_RULES_H_
+
+
+namespace modsecurity {
+class RuleWithOperator;
+class Transaction;
+
+
+/**
+ * Index of the rules of a plan that start with a @beginsWith or a @streq
+ * over REQUEST_FILENAME or REQUEST_URI alone, untransformed: the URI
+ * gated rules of the exclusion packages and the application specific
+ * ones, most of which have nothing to do with a given request.
+ *
+ * The prefixes (and the exact values) go into a byte trie per target,
+ * walked once per plan and transaction along the value of the target;
+ * the rules that are not on the way can not match and are skipped. The
+ * others, and all of them when usable() says so, are evaluated as usual,
+ * in their place, so the order of the rules is kept.
+ *
+ */
+class UriRules {
+ public:
+    /**
+     * What the walk of a transaction opened, index by index; done the
+     * first time a rule of the plan asks.
+     */
+    class Open {
+     public:
+        explicit Open(const UriRules *program)
+            : m_program(program),
+            m_walked(false) { }
+
+        Open(const Open &) = delete;
+        Open &operator=(const Open &) = delete;
+
+     private:
+        friend class UriRules;
+
+        const UriRules *m_program;
+        bool m_walked;
+        std::vector<bool> m_open;
+    };
+
+    UriRules();
+
+    /**
+     * Adds rule, with its targets and transformations as resolved by set,
+     * if it is URI gated; its index is then size() - 1.
+     */
+    bool add(const RulesSet *set, RuleWithOperator *rule);
+
+    /*
+     * Whether the rules may be skipped at all: not with a debug log that
+     * tells about every rule or while rules are profiled.
+     */
+    static bool usable(const Transaction *t);
+
+    /* Whether the rule at index may match t. */
+    bool open(size_t index, const Transaction *t, Open *open) const;
+
+    size_t size() const { return m_size; }
+
+ private:
+    enum Target {
+        RequestFilename,
+        RequestUri,
+        NumberOfTargets
+    };
+
+    class Node {
+     public:
+        /* by byte, sorted */
+        std::vector<std::pair<unsigned char, uint32_t>> m_next;
+        /* rules whose prefix ends here, and whose exact value does */
+        std::vector<uint32_t> m_prefix;
+        std::vector<uint32_t> m_exact;
+    };
+
+    uint32_t node(Target target, const std::string &path);
+    void walk(Target target, const std::string &value, Open *open) const;
+
+    std::vector<Node> m_nodes[NumberOfTargets];
+    size_t m_size;
+};
+
+
+}  // namespace modsecurity
+
+#endif  // SRC_URI_RULES_H_
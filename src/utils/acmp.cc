@@ -22,11 +22,19 @@
 #include <cstddef>
 #include <stdio.h>
 #include <ctype.h>
+#include <stdint.h>
 
+#include <algorithm>
 #include <iostream>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "src/utils/huge_pages.h"
+
+using modsecurity::Utils::HugePages;
+
 
 /**
  * TODO: This code comes from ModSecurity 2.9.0 there are two memory leaks here
@@ -246,26 +254,6 @@ static void acmp_clone_node_no_state(acmp_node_t *from, acmp_node_t *to) {
     to->hit_count = 0;
 }
 
-static inline acmp_node_t *acmp_btree_find(acmp_node_t *node, long letter) {
-    acmp_btree_node_t *bnode = node->btree;
-    for (;;) {
-        if (bnode == NULL) return NULL;
-        if (bnode->letter == letter) return bnode->node;
-        if (bnode->letter > letter) {
-            bnode = bnode->left;
-        } else {
-            bnode = bnode->right;
-        }
-    }
-}
-
-/**
- *
- */
-static inline acmp_node_t *acmp_goto(acmp_node_t *node, long letter) {
-    return acmp_btree_find(node, letter);
-}
-
 /**
  * Connects each node with its first fail node that is end of a phrase.
  */
@@ -289,97 +277,173 @@ static void acmp_connect_other_matches(ACMP *parser, acmp_node_t *node) {
 }
 
 /**
- * Adds leaves to binary tree, working from sorted array of keyword tree nodes
+ * Returns the state reached from state s on byte class c, following the
+ * fail states until one has an edge for it. Only used while the flat
+ * table is built: the dense rows of the states before s are ready.
  */
-static void acmp_add_btree_leaves(acmp_btree_node_t *node, acmp_node_t *nodes[],
-        int pos, int lb, int rb) {
-
-    int left = 0, right = 0;
-    if ((pos - lb) > 1) {
-        left = lb + (pos - lb) / 2;
-        node->left = reinterpret_cast<acmp_btree_node_t *>(calloc(1, sizeof(acmp_btree_node_t)));
-        node->left->node = NULL;
-        node->left->right = NULL;
-        node->left->left = NULL;
-        node->left->letter = 0;
-        /* ENH: Check alloc succeded */
-        node->left->node = nodes[left];
-        node->left->letter = nodes[left]->letter;
-#ifdef DEBUG_ACMP
-        fprintf(stderr, "%lc ->left %lc\n", (wint_t)node->node->letter, (wint_t)node->left->node->letter);
-#endif
-    }
-    if ((rb - pos) > 1) {
-        right = pos + (rb - pos) / 2;
-        node->right = reinterpret_cast<acmp_btree_node_t *>(calloc(1, sizeof(acmp_btree_node_t)));
-        node->right->node = NULL;
-        node->right->right = NULL;
-        node->right->left = NULL;
-        node->right->letter = 0;
-        /* ENH: Check alloc succeded */
-        node->right->node = nodes[right];
-        node->right->letter = nodes[right]->letter;
-#ifdef DEBUG_ACMP
-        fprintf(stderr, "%lc ->right %lc\n", (wint_t)node->node->letter, (wint_t)node->right->node->letter);
-#endif
-    }
-    if (node->right != NULL) {
-        acmp_add_btree_leaves(node->right, nodes, right, pos, rb);
-    }
-    if (node->left != NULL) {
-        acmp_add_btree_leaves(node->left, nodes, left, lb, pos);
+static unsigned int acmp_flat_next(ACMP *parser, unsigned int s,
+        unsigned int c) {
+    for (;;) {
+        if (s < parser->dense_count) {
+            return parser->dense[s * parser->class_count + c];
+        }
+        unsigned int first = parser->edge_start[s - parser->dense_count];
+        unsigned int last = parser->edge_start[s - parser->dense_count + 1];
+        for (unsigned int e = first; e < last; e++) {
+            if (parser->edge_class[e] == c) return parser->edge_next[e];
+            if (parser->edge_class[e] > c) break;
+        }
+        s = parser->fail[s];
     }
 }
 
 /**
- * Builds balanced binary tree from children nodes of given node.
+ * Releases the flattened automaton
  */
-static void acmp_build_binary_tree(ACMP *parser, acmp_node_t *node) {
-    size_t count, i, j;
-    acmp_node_t *child = node->child;
-    acmp_node_t **nodes;
-    size_t pos;
-
-    /* Build an array big enough */
-    for (count = 0; child != NULL; child = child->sibling) count++;
-    nodes = (acmp_node_t **)calloc(1, count * sizeof(acmp_node_t *));
-    /* ENH: Check alloc succeded */
+static void acmp_free_table(ACMP *parser) {
+    HugePages::free(parser->dense);
+    HugePages::free(parser->fail);
+    HugePages::free(parser->edge_start);
+    HugePages::free(parser->edge_class);
+    HugePages::free(parser->edge_next);
+    HugePages::free(parser->match);
+    HugePages::free(parser->data);
+    HugePages::free(parser->output);
+    parser->dense = NULL;
+    parser->fail = NULL;
+    parser->edge_start = NULL;
+    parser->edge_class = NULL;
+    parser->edge_next = NULL;
+    parser->match = NULL;
+    parser->data = NULL;
+    parser->output = NULL;
+    parser->state_count = 0;
+    parser->dense_count = 0;
+    parser->class_count = 0;
+}
 
-    /* ENH: Combine this in the loop below - we do not need two loops */
-    child = node->child;
-    for (i = 0; i < count; i++) {
-        nodes[i] = child;
-        child = child->sibling;
-    };
+/**
+ * Compiles the keyword trie, with its fail paths already connected, into
+ * contiguous arrays.
+ *
+ * Bytes that are folded to the same letter, or that do not show up in any
+ * pattern, share a class, which keeps the rows short. States get a dense
+ * row, with the fail transitions already resolved, as long as the rows fit
+ * in ACMP_DENSE_ENTRIES; the remaining ones keep their sorted edges.
+ */
+#define ACMP_DENSE_ENTRIES 65536
+
+static void acmp_flatten(ACMP *parser) {
+    std::vector<acmp_node_t *> nodes;
+    std::unordered_map<const acmp_node_t *, unsigned int> index;
+    int letter_class[256];
+    unsigned int i, c, s, e;
+
+    acmp_free_table(parser);
+
+    /* breadth first numbering, the root is state 0 */
+    nodes.push_back(parser->root_node);
+    index[parser->root_node] = 0;
+    for (i = 0; i < nodes.size(); i++) {
+        for (acmp_node_t *child = nodes[i]->child; child != NULL;
+            child = child->sibling) {
+            index[child] = nodes.size();
+            nodes.push_back(child);
+        }
+    }
 
-    /* We have array with all children of the node and number of those children
+    /*
+     * Class 0 stands for the bytes that no pattern uses. Letters out of
+     * the byte range are never produced by the input (see
+     * acmp_strtoucs), those edges are dropped. With every byte in use
+     * there are 257 classes, more than an unsigned char holds.
      */
-    for (i = 0; i < count - 1; i++)
-        for (j = i + 1; j < count; j++) {
-            acmp_node_t *tmp;
+    memset(letter_class, 0, sizeof(letter_class));
+    parser->class_count = 1;
+    for (i = 1; i < nodes.size(); i++) {
+        long letter = nodes[i]->letter;
+        if (letter < 0 || letter > 255 || letter_class[letter] != 0) continue;
+        letter_class[letter] = parser->class_count++;
+    }
+    for (i = 0; i < 256; i++) {
+        int letter = parser->is_case_sensitive == 0 ? tolower(i) : i;
+        parser->byte_class[i] = letter_class[letter];
+    }
+
+    parser->state_count = nodes.size();
+    parser->dense_count = ACMP_DENSE_ENTRIES / parser->class_count;
+    if (parser->dense_count == 0) parser->dense_count = 1;
+    if (parser->dense_count > parser->state_count) {
+        parser->dense_count = parser->state_count;
+    }
 
-            if (nodes[i]->letter < nodes[j]->letter) continue;
+    parser->fail = (unsigned int *)HugePages::calloc(parser->state_count,
+        sizeof(unsigned int));
+    parser->match = (const char **)HugePages::calloc(parser->state_count,
+        sizeof(const char *));
+    parser->data = (void **)HugePages::calloc(parser->state_count,
+        sizeof(void *));
+    parser->output = (unsigned int *)HugePages::calloc(parser->state_count,
+        sizeof(unsigned int));
+    parser->dense = (unsigned int *)HugePages::calloc(
+        parser->dense_count * parser->class_count, sizeof(unsigned int));
+    parser->edge_start = (unsigned int *)HugePages::calloc(
+        parser->state_count - parser->dense_count + 1,
+        sizeof(unsigned int));
+    /* ENH: Check alloc succeded */
 
-            tmp = nodes[i];
-            nodes[i] = nodes[j];
-            nodes[j] = tmp;
+    for (s = 0; s < parser->state_count; s++) {
+        acmp_node_t *node = nodes[s];
+        parser->fail[s] = node->fail != NULL ? index[node->fail] : 0;
+        if (s > 0 && (node->is_last || node->o_match != NULL)) {
+            parser->match[s] = node->text;
         }
-        if (node->btree != NULL) {
-            free(node->btree);
-            node->btree = NULL;
+        if (node->is_last) {
+            parser->data[s] = node->callback_data;
         }
-    node->btree = reinterpret_cast<acmp_btree_node_t *>(calloc(1, sizeof(acmp_btree_node_t)));
+        parser->output[s] = node->o_match != NULL ? index[node->o_match] : 0;
+    }
 
+    /* edges of the sparse states, sorted by class */
+    std::vector<std::pair<unsigned int, unsigned int>> edges;
+    std::vector<std::pair<unsigned int, unsigned int>> own;
+    for (s = parser->dense_count; s < parser->state_count; s++) {
+        own.clear();
+        for (acmp_node_t *child = nodes[s]->child; child != NULL;
+            child = child->sibling) {
+            if (child->letter < 0 || child->letter > 255) continue;
+            own.push_back(std::make_pair(letter_class[child->letter],
+                index[child]));
+        }
+        std::sort(own.begin(), own.end());
+        edges.insert(edges.end(), own.begin(), own.end());
+        parser->edge_start[s - parser->dense_count + 1] = edges.size();
+    }
+    parser->edge_class = (unsigned short *)HugePages::calloc(
+        edges.size() + 1, sizeof(unsigned short));
+    parser->edge_next = (unsigned int *)HugePages::calloc(edges.size() + 1,
+        sizeof(unsigned int));
     /* ENH: Check alloc succeded */
-    pos = count / 2;
-    node->btree->node = nodes[pos];
-    node->btree->letter = nodes[pos]->letter;
-    acmp_add_btree_leaves(node->btree, nodes, pos, -1, count);
-    for (i = 0; i < count; i++) {
-        if (nodes[i]->child != NULL) acmp_build_binary_tree(parser, nodes[i]);
+    for (e = 0; e < edges.size(); e++) {
+        parser->edge_class[e] = edges[e].first;
+        parser->edge_next[e] = edges[e].second;
     }
-    if (nodes != NULL) {
-        free(nodes);
+
+    /*
+     * Dense rows, same walk as the trie: the goto edge if there is one,
+     * the row of the fail state otherwise. Fail states are shallower,
+     * hence already done.
+     */
+    for (s = 0; s < parser->dense_count; s++) {
+        unsigned int *row = parser->dense + s * parser->class_count;
+        for (c = 0; c < parser->class_count; c++) {
+            row[c] = s == 0 ? 0 : acmp_flat_next(parser, parser->fail[s], c);
+        }
+        for (acmp_node_t *child = nodes[s]->child; child != NULL;
+            child = child->sibling) {
+            if (child->letter < 0 || child->letter > 255) continue;
+            row[letter_class[child->letter]] = index[child];
+        }
     }
 }
 
@@ -432,12 +496,35 @@ static int acmp_connect_fail_branches(ACMP *parser) {
     }
 
     acmp_connect_other_matches(parser, parser->root_node);
-    if (parser->root_node->child != NULL) acmp_build_binary_tree(parser, parser->root_node);
+    acmp_flatten(parser);
     parser->is_failtree_done = 1;
 
     return 1;
 }
 
+/**
+ * Releases the btree built over the children of a node
+ */
+static void acmp_free_btree(acmp_btree_node_t *node) {
+    if (node == NULL) return;
+    acmp_free_btree(node->right);
+    acmp_free_btree(node->left);
+    free(node);
+}
+
+/**
+ * Releases a node, its siblings and its children
+ */
+static void acmp_free_node(acmp_node_t *node) {
+    if (node == NULL) return;
+    acmp_free_node(node->sibling);
+    acmp_free_node(node->child);
+    acmp_free_btree(node->btree);
+    if (node->text && strlen(node->text) > 0) free(node->text);
+    if (node->pattern && strlen(node->pattern) > 0) free(node->pattern);
+    free(node);
+}
+
 /*
  *******************************************************************************
  *******************************************************************************
@@ -459,6 +546,44 @@ ACMP *acmp_create(int flags) {
     return parser;
 }
 
+/**
+ * Destroys the parser and all the memory held by its tree
+ */
+void acmp_destroy(ACMP *parser) {
+    if (parser == NULL) return;
+    acmp_free_node(parser->root_node);
+    acmp_free_table(parser);
+    free(parser);
+}
+
+static size_t acmp_node_memory_usage(const acmp_node_t *node) {
+    size_t bytes = 0;
+    for (; node != NULL; node = node->sibling) {
+        bytes += sizeof(acmp_node_t) + acmp_node_memory_usage(node->child);
+        if (node->text != NULL) bytes += strlen(node->text) + 2;
+        if (node->pattern != NULL) bytes += strlen(node->pattern) + 2;
+    }
+    return bytes;
+}
+
+size_t acmp_memory_usage(const ACMP *parser) {
+    size_t bytes, sparse, edges = 0;
+
+    if (parser == NULL) return 0;
+    bytes = sizeof(ACMP) + acmp_node_memory_usage(parser->root_node);
+    if (parser->fail == NULL) return bytes;
+
+    sparse = parser->state_count - parser->dense_count;
+    if (parser->edge_start != NULL) edges = parser->edge_start[sparse];
+    bytes += parser->state_count * (2 * sizeof(unsigned int)
+        + sizeof(const char *) + sizeof(void *));
+    bytes += parser->dense_count * parser->class_count
+        * sizeof(unsigned int);
+    bytes += (sparse + 1) * sizeof(unsigned int);
+    bytes += (edges + 1) * (sizeof(unsigned short) + sizeof(unsigned int));
+    return bytes;
+}
+
 /**
  * Creates fail tree and initializes buffer
  */
@@ -540,52 +665,97 @@ if (parser->is_active != 0) return -1;
 
 /**
  * Process the data using ACMPT to keep state, and ACMPT's parser to keep the tree
+ *
+ * The state kept in acmpt->ptr is the index of the current state, plus one
+ * so that NULL still means the root.
  */
 int acmp_process_quick(ACMPT *acmpt, const char **match, const char *data, size_t len) {
     ACMP *parser;
-    acmp_node_t *node, *go_to;
-    const char *end;
+    const unsigned char *p, *end;
+    unsigned int s;
     int offset = 0;
 
-    /*
-    if (acmpt->parser->is_failtree_done == 0) {
-        acmp_prepare(acmpt->parser);
-    };
-    */
-
     parser = acmpt->parser;
-    if (acmpt->ptr == NULL) acmpt->ptr = parser->root_node;
-    node = reinterpret_cast<acmp_node_t *>(acmpt->ptr);
-    end = data + len;
-
-    while (data < end) {
-        long letter = (unsigned char)*data++;
-
-        if (parser->is_case_sensitive == 0) letter = tolower(letter);
-
-        go_to = NULL;
-        while (go_to == NULL) {
-            go_to = acmp_goto(node, letter);
-            if (go_to != NULL) {
-                if (go_to->is_last) {
-                    *match = go_to->text;
-                    return offset;
+    if (parser->match == NULL) return -1;
+
+    s = acmpt->ptr == NULL ? 0
+        : static_cast<unsigned int>(reinterpret_cast<uintptr_t>(acmpt->ptr) - 1);
+    p = reinterpret_cast<const unsigned char *>(data);
+    end = p + len;
+
+    while (p < end) {
+        unsigned int c = parser->byte_class[*p++];
+
+        if (c == 0) {
+            s = 0;
+        } else {
+            while (s >= parser->dense_count) {
+                unsigned int e = parser->edge_start[s - parser->dense_count];
+                unsigned int last = parser->edge_start[s - parser->dense_count + 1];
+                while (e < last && parser->edge_class[e] < c) e++;
+                if (e < last && parser->edge_class[e] == c) {
+                    s = parser->edge_next[e];
+                    goto next;
                 }
+                s = parser->fail[s];
             }
-            if (node == parser->root_node) break;
-            if (go_to == NULL) node = node->fail;
+            s = parser->dense[s * parser->class_count + c];
         }
-        if (go_to != NULL) node = go_to;
-
-        /* If node has o_match, then we found a pattern */
-        if (node->o_match != NULL) {
-            *match = node->text;
+next:
+        if (parser->match[s] != NULL) {
+            *match = parser->match[s];
             return offset;
         }
         offset++;
     }
-    acmpt->ptr = node;
+    acmpt->ptr = reinterpret_cast<void *>(static_cast<uintptr_t>(s) + 1);
     return -1;
 }
 
+/**
+ * Same walk as acmp_process_quick, from the root and to the end of data.
+ * A state where no pattern ends itself may still have some down its fail
+ * path (output).
+ */
+void acmp_process_all(ACMP *parser, const char *data, size_t len,
+    acmp_match_t callback, void *ctx) {
+    const unsigned char *p, *end;
+    unsigned int s = 0;
+    int offset = 0;
+
+    if (parser->match == NULL) return;
+
+    p = reinterpret_cast<const unsigned char *>(data);
+    end = p + len;
+
+    while (p < end) {
+        unsigned int c = parser->byte_class[*p++];
+
+        if (c == 0) {
+            s = 0;
+        } else {
+            while (s >= parser->dense_count) {
+                unsigned int e = parser->edge_start[s - parser->dense_count];
+                unsigned int last = parser->edge_start[s - parser->dense_count + 1];
+                while (e < last && parser->edge_class[e] < c) e++;
+                if (e < last && parser->edge_class[e] == c) {
+                    s = parser->edge_next[e];
+                    goto next;
+                }
+                s = parser->fail[s];
+            }
+            s = parser->dense[s * parser->class_count + c];
+        }
+next:
+        if (parser->match[s] != NULL) {
+            unsigned int o = parser->data[s] != NULL ? s : parser->output[s];
+            while (o != 0) {
+                if (callback(ctx, parser->data[o], offset) != 0) return;
+                o = parser->output[o];
+            }
+        }
+        offset++;
+    }
+}
+
 }
@@ -54,6 +54,15 @@ typedef struct {
  */
 typedef void (*acmp_callback_t)(ACMP *, void *, size_t, size_t);
 
+/**
+ * Called by acmp_process_all for every pattern found. Arguments are:
+ * void * - the context given to acmp_process_all
+ * void * - custom data you supplied when adding the pattern
+ * int - offset of the last byte of the match
+ * Returns non zero to stop the search.
+ */
+typedef int (*acmp_match_t)(void *, void *, int);
+
 
 /**
  * One node in trie
@@ -116,6 +125,31 @@ struct ACMP {
     int  is_active;
     size_t  byte_pos;
     size_t  char_pos;
+
+    /*
+     * Flattened automaton, built by acmp_prepare and used by
+     * acmp_process_quick. States are numbered in breadth first order, so
+     * that the shallow ones, where most of the input is consumed, come
+     * first and get a dense transition row; the deeper ones only keep
+     * their own edges, plus the fail state to fall back to.
+     */
+    unsigned short byte_class[256];
+    unsigned int class_count;
+    unsigned int state_count;
+    unsigned int dense_count;
+    unsigned int *dense;
+    unsigned int *fail;
+    unsigned int *edge_start;
+    unsigned short *edge_class;
+    unsigned int *edge_next;
+    const char **match;
+    /*
+     * Per state: the data given along with the pattern that ends there,
+     * if any, and the next state, down the fail path, where a pattern
+     * ends (0 for none). Only used by acmp_process_all.
+     */
+    void **data;
+    unsigned int *output;
 };
 
 
@@ -184,11 +218,24 @@ ACMPT *acmp_duplicate_quick(ACMP *parser);
  */
 int acmp_process_quick(ACMPT *acmpt, const char **match, const char *data, size_t len);
 
+/**
+ * Reports every pattern found in data, along with where it ends, instead
+ * of stopping at the first one. The longest of the patterns ending at a
+ * given offset comes first. Patterns have to be added with non NULL data.
+ */
+void acmp_process_all(ACMP *parser, const char *data, size_t len,
+    acmp_match_t callback, void *ctx);
+
 /**
  * Prepares parser for searching
  */
 int acmp_prepare(ACMP *parser);
 
+/**
+ * Bytes held by the parser: its tree and, once prepared, its tables
+ */
+size_t acmp_memory_usage(const ACMP *parser);
+
 char *parse_pm_content(const char *op_parm, unsigned short int op_len, const char **error_msg);
 
 }
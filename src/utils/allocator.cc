@@ -0,0 +1,222 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+#include "src/utils/allocator.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef WITH_LIBXML2
+#include <libxml/xmlmemory.h>
+#endif
+
+#include <atomic>
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+namespace {
+
+ModSecAllocator allocator = {NULL, NULL, NULL, NULL};
+std::atomic<bool> sealed(false);
+/* something went through Allocator already: it has to be freed by it */
+std::atomic<bool> allocated(false);
+#ifdef WITH_LIBXML2
+bool xmlHooked = false;
+#endif
+
+
+inline void markAllocated() {
+    if (allocated.load(std::memory_order_relaxed) == false) {
+        allocated.store(true, std::memory_order_relaxed);
+    }
+}
+
+#ifdef WITH_YAJL
+void *yajlMalloc(void *ctx, size_t size) {
+    return Allocator::malloc(size);
+}
+
+void *yajlRealloc(void *ctx, void *ptr, size_t size) {
+    return Allocator::realloc(ptr, size);
+}
+
+void yajlFree(void *ctx, void *ptr) {
+    Allocator::free(ptr);
+}
+
+yajl_alloc_funcs yajlFuncs = {yajlMalloc, yajlRealloc, yajlFree, NULL};
+#endif
+
+#if WITH_PCRE2
+void *pcre2Malloc(PCRE2_SIZE size, void *data) {
+    return Allocator::malloc(size);
+}
+
+void pcre2Free(void *ptr, void *data) {
+    Allocator::free(ptr);
+}
+
+pcre2_general_context *generalContext = NULL;
+pcre2_compile_context *compileContext = NULL;
+#endif
+
+#ifdef WITH_LIBXML2
+void xmlFreeHook(void *ptr) {
+    Allocator::free(ptr);
+}
+
+void *xmlMallocHook(size_t size) {
+    return Allocator::malloc(size);
+}
+
+void *xmlReallocHook(void *ptr, size_t size) {
+    return Allocator::realloc(ptr, size);
+}
+
+char *xmlStrdupHook(const char *str) {
+    size_t size = strlen(str) + 1;
+    char *copy = static_cast<char *>(Allocator::malloc(size));
+    if (copy != NULL) {
+        memcpy(copy, str, size);
+    }
+    return copy;
+}
+#endif
+
+}  // namespace
+
+
+bool Allocator::set(const ModSecAllocator *a) {
+    if (sealed.load() || allocated.load()) {
+        return false;
+    }
+    if (a != NULL && (a->allocate == NULL || a->reallocate == NULL
+        || a->release == NULL)) {
+        return false;
+    }
+#ifdef WITH_LIBXML2
+    xmlFreeFunc freeFunc;
+    xmlMallocFunc mallocFunc;
+    xmlReallocFunc reallocFunc;
+    xmlStrdupFunc strdupFunc;
+    /* libxml2 set up by someone else: what it has given out is theirs */
+    if (a != NULL && xmlHooked == false && (xmlMemGet(&freeFunc,
+        &mallocFunc, &reallocFunc, &strdupFunc) != 0
+        || freeFunc != ::free)) {
+        return false;
+    }
+#endif
+
+    if (a != NULL) {
+        allocator = *a;
+    } else {
+        allocator = {NULL, NULL, NULL, NULL};
+    }
+
+#if WITH_PCRE2
+    /* allocated from here on: this is the last call that succeeds */
+    if (a != NULL) {
+        generalContext = pcre2_general_context_create(pcre2Malloc, pcre2Free,
+            NULL);
+        compileContext = pcre2_compile_context_create(generalContext);
+    }
+#endif
+#ifdef WITH_LIBXML2
+    /*
+     * Once and for good: the hooks go through Allocator whatever it is,
+     * so that libxml2 never frees with another allocator than the one
+     * it got the memory from.
+     */
+    if (a != NULL && xmlHooked == false) {
+        xmlMemSetup(xmlFreeHook, xmlMallocHook, xmlReallocHook,
+            xmlStrdupHook);
+        xmlHooked = true;
+    }
+#endif
+    return true;
+}
+
+
+void Allocator::seal() {
+    sealed.store(true);
+}
+
+
+void *Allocator::malloc(size_t size) {
+    markAllocated();
+    if (allocator.allocate == NULL) {
+        return ::malloc(size);
+    }
+    return allocator.allocate(allocator.data, size);
+}
+
+
+void *Allocator::calloc(size_t count, size_t size) {
+    markAllocated();
+    if (allocator.allocate == NULL) {
+        return ::calloc(count, size);
+    }
+    if (size != 0 && count > static_cast<size_t>(-1) / size) {
+        return NULL;
+    }
+    void *ptr = allocator.allocate(allocator.data, count * size);
+    if (ptr != NULL) {
+        memset(ptr, 0, count * size);
+    }
+    return ptr;
+}
+
+
+void *Allocator::realloc(void *ptr, size_t size) {
+    markAllocated();
+    if (allocator.reallocate == NULL) {
+        return ::realloc(ptr, size);
+    }
+    return allocator.reallocate(allocator.data, ptr, size);
+}
+
+
+void Allocator::free(void *ptr) {
+    if (allocator.release == NULL) {
+        ::free(ptr);
+        return;
+    }
+    allocator.release(allocator.data, ptr);
+}
+
+
+#ifdef WITH_YAJL
+yajl_alloc_funcs *Allocator::yajl() {
+    return allocator.allocate != NULL ? &yajlFuncs : NULL;
+}
+#endif
+
+
+#if WITH_PCRE2
+pcre2_general_context *Allocator::pcre2() {
+    return generalContext;
+}
+
+
+pcre2_compile_context *Allocator::pcre2Compile() {
+    return compileContext;
+}
+#endif
+
+
+}  // namespace Utils
+}  // namespace modsecurity
@@ -0,0 +1,77 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+#ifdef WITH_YAJL
+#include <yajl/yajl_common.h>
+#endif
+#if WITH_PCRE2
+#define PCRE2_CODE_UNIT_WIDTH 8
+#include <pcre2.h>
+#endif
+
+#include <cstddef>
+
+#include "modsecurity/modsecurity.h"
+
+#ifndef SRC_UTILS_ALLOCATOR_H_
+#define SRC_UTILS_ALLOCATOR_H_
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+/**
+ * What the library allocates on its own goes through here: the C
+ * parts of it, yajl, libxml2 and PCRE2, with the allocator the connector
+ * handed to msc_set_allocator(), or the C library one when there is none.
+ *
+ * The allocator only changes before the first ModSecurity instance is
+ * built (see seal()) and before anything was allocated through here, so
+ * that nothing is ever freed by another allocator than the one it came
+ * from; libxml2 is hooked once, for good. What is handed back to the connector to be
+ * freed by it (msc_metrics_render(), interventions) stays with the C
+ * library, as documented.
+ */
+class Allocator {
+ public:
+    /*
+     * false once sealed or once something was allocated, when allocator
+     * lacks one of its functions, or when libxml2 has another allocator
+     * than the C library one already.
+     */
+    static bool set(const ModSecAllocator *allocator);
+    static void seal();
+
+    static void *malloc(size_t size);
+    static void *calloc(size_t count, size_t size);
+    static void *realloc(void *ptr, size_t size);
+    static void free(void *ptr);
+
+#ifdef WITH_YAJL
+    /* For yajl_alloc() and yajl_gen_alloc(); NULL is yajl's own. */
+    static yajl_alloc_funcs *yajl();
+#endif
+#if WITH_PCRE2
+    /* For the PCRE2 contexts and match data; NULL is PCRE2's own. */
+    static pcre2_general_context *pcre2();
+    static pcre2_compile_context *pcre2Compile();
+#endif
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_ALLOCATOR_H_
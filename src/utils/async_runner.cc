@@ -0,0 +1,137 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/async_runner.h"
+
+#include <unistd.h>
+
+#include <functional>
+#include <utility>
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+AsyncRunner::AsyncRunner(size_t threads, size_t queueLimit)
+    : m_threads(threads > 0 ? threads : 1),
+    m_queueLimit(queueLimit),
+    m_pid(0),
+    m_stopping(false) {
+    pthread_mutex_init(&m_lock, NULL);
+    pthread_cond_init(&m_wake, NULL);
+}
+
+
+AsyncRunner::~AsyncRunner() {
+    stop();
+    pthread_cond_destroy(&m_wake);
+    pthread_mutex_destroy(&m_lock);
+}
+
+
+void AsyncRunner::start() {
+    if (m_pid == getpid()) {
+        return;
+    }
+    /* Threads do not survive a fork(); only the bookkeeping does. */
+    m_workers.clear();
+    m_stopping = false;
+    for (size_t i = 0; i < m_threads; i++) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, work, this) == 0) {
+            m_workers.push_back(thread);
+        }
+    }
+    m_pid = getpid();
+}
+
+
+void AsyncRunner::stop() {
+    pthread_mutex_lock(&m_lock);
+    if (m_pid != getpid()) {
+        pthread_mutex_unlock(&m_lock);
+        return;
+    }
+    m_stopping = true;
+    pthread_cond_broadcast(&m_wake);
+    pthread_mutex_unlock(&m_lock);
+
+    for (pthread_t &thread : m_workers) {
+        pthread_join(thread, NULL);
+    }
+    m_workers.clear();
+    m_pid = 0;
+}
+
+
+void *AsyncRunner::work(void *data) {
+    AsyncRunner *runner = reinterpret_cast<AsyncRunner *>(data);
+
+    pthread_mutex_lock(&runner->m_lock);
+    while (true) {
+        while (runner->m_tasks.empty() && runner->m_stopping == false) {
+            pthread_cond_wait(&runner->m_wake, &runner->m_lock);
+        }
+        if (runner->m_tasks.empty()) {
+            break;
+        }
+        std::function<void()> task = std::move(runner->m_tasks.front());
+        runner->m_tasks.pop_front();
+        pthread_mutex_unlock(&runner->m_lock);
+        task();
+        pthread_mutex_lock(&runner->m_lock);
+    }
+    pthread_mutex_unlock(&runner->m_lock);
+    return NULL;
+}
+
+
+/**
+ * Runs the task on the calling thread when no worker could be started,
+ * which is slower for the caller but still gets the work done.
+ *
+ */
+void AsyncRunner::post(std::function<void()> task) {
+    pthread_mutex_lock(&m_lock);
+    start();
+    if (m_workers.empty()) {
+        pthread_mutex_unlock(&m_lock);
+        task();
+        return;
+    }
+    m_tasks.push_back(std::move(task));
+    pthread_cond_signal(&m_wake);
+    pthread_mutex_unlock(&m_lock);
+}
+
+
+bool AsyncRunner::offer(std::function<void()> task) {
+    pthread_mutex_lock(&m_lock);
+    start();
+    if (m_workers.empty()
+        || (m_queueLimit > 0 && m_tasks.size() >= m_queueLimit)) {
+        pthread_mutex_unlock(&m_lock);
+        return false;
+    }
+    m_tasks.push_back(std::move(task));
+    pthread_cond_signal(&m_wake);
+    pthread_mutex_unlock(&m_lock);
+    return true;
+}
+
+
+}  // namespace Utils
+}  // namespace modsecurity
@@ -0,0 +1,85 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <pthread.h>
+#include <sys/types.h>
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <vector>
+
+#ifndef SRC_UTILS_ASYNC_RUNNER_H_
+#define SRC_UTILS_ASYNC_RUNNER_H_
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+/**
+ * Worker threads the non blocking transactions hand the phases that may
+ * block on I/O over to (see Transaction::setNonBlocking). Unlike
+ * ThreadPool the caller does not wait for the task: the task lets its
+ * transaction know by itself once it is done.
+ *
+ * The workers are started by the first post() of each process, so a
+ * runner built before the server forks its children works in every one
+ * of them. Stopping waits for the tasks already posted.
+ *
+ * A queueLimit bounds the tasks waiting for a worker, for offer(); post()
+ * does not look at it.
+ */
+class AsyncRunner {
+ public:
+    static const size_t kDefaultThreads = 4;
+
+    explicit AsyncRunner(size_t threads, size_t queueLimit = 0);
+    ~AsyncRunner();
+
+    AsyncRunner(const AsyncRunner &) = delete;
+    AsyncRunner &operator=(const AsyncRunner &) = delete;
+
+    /* The task must not throw. */
+    void post(std::function<void()> task);
+    /*
+     * Same as post(), for the tasks that may as well not run: false, and
+     * the task dropped, when queueLimit tasks are waiting already or no
+     * worker could be started.
+     */
+    bool offer(std::function<void()> task);
+
+    size_t threads() const { return m_threads; }
+
+ private:
+    static void *work(void *data);
+    void start();
+    void stop();
+
+    const size_t m_threads;
+    const size_t m_queueLimit;
+    std::vector<pthread_t> m_workers;
+    std::deque<std::function<void()>> m_tasks;
+    pthread_mutex_t m_lock;
+    pthread_cond_t m_wake;
+    pid_t m_pid;
+    bool m_stopping;
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_ASYNC_RUNNER_H_
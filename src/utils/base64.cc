@@ -15,204 +15,272 @@
 
 #include "src/utils/base64.h"
 
+#include <stdint.h>
 #include <string.h>
 
 #include <string>
-#include <fstream>
-#include <iostream>
 
-#include "mbedtls/base64.h"
+#include "src/utils/byte_scan.h"
 
 namespace modsecurity {
 namespace Utils {
 
 
-std::string Base64::encode(const std::string& data) {
-    size_t encoded_len = 0;
-    unsigned char *d;
-    std::string ret;
+namespace {
 
-    mbedtls_base64_encode(NULL, 0, &encoded_len,
-        reinterpret_cast<const unsigned char*>(data.c_str()), data.size());
 
-    d = reinterpret_cast<unsigned char*>(malloc(sizeof(char) * encoded_len));
-    if (d == NULL) {
-        return data;
-    }
+const char kAlphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
-    memset(d, '\0', encoded_len);
 
-    mbedtls_base64_encode(d, encoded_len, &encoded_len,
-        (unsigned char*) data.c_str(), data.size());
+/*
+ * Lookup tables for the bulk of the work, the runs of alphabet bytes
+ * found by utils::scan::findNotBase64(). Decoding ORs one entry per
+ * character, each already shifted into its place in the 24 bits of the
+ * quad; encoding turns 12 bits at a time into two characters.
+ */
+struct Tables {
+    Tables() {
+        memset(m_sextet, -1, sizeof(m_sextet));
+        for (int i = 0; i < 64; i++) {
+            unsigned char c = kAlphabet[i];
+            m_sextet[c] = i;
+            for (int k = 0; k < 4; k++) {
+                m_decode[k][c] = static_cast<uint32_t>(i) << (18 - 6 * k);
+            }
+        }
+        for (int i = 0; i < 4096; i++) {
+            m_encode[i][0] = kAlphabet[i >> 6];
+            m_encode[i][1] = kAlphabet[i & 0x3f];
+        }
+    }
 
-    ret.assign(reinterpret_cast<const char*>(d), encoded_len);
-    free(d);
+    /* -1 for the bytes that are not in the alphabet */
+    signed char m_sextet[256];
+    uint32_t m_decode[4][256];
+    char m_encode[4096][2];
+};
 
 
-    return ret;
+const Tables &tables() {
+    static const Tables t;
+    return t;
 }
 
 
-std::string Base64::decode(const std::string& data, bool forgiven) {
-    if (forgiven) {
-        return decode_forgiven(data);
+/* n is a multiple of 4 and every byte is in the alphabet. */
+unsigned char *decodeRun(const Tables &t, const unsigned char *in, size_t n,
+    unsigned char *out) {
+    for (const unsigned char *end = in + n; in < end; in += 4) {
+        uint32_t x = t.m_decode[0][in[0]] | t.m_decode[1][in[1]]
+            | t.m_decode[2][in[2]] | t.m_decode[3][in[3]];
+        out[0] = static_cast<unsigned char>(x >> 16);
+        out[1] = static_cast<unsigned char>(x >> 8);
+        out[2] = static_cast<unsigned char>(x);
+        out += 3;
     }
-
-    return decode(data);
+    return out;
 }
 
 
-std::string Base64::decode(const std::string& data) {
-    size_t decoded_len = 0;
-    unsigned char *d;
-    std::string ret;
-    size_t len = strlen(data.c_str());
-
-    mbedtls_base64_decode(NULL, 0, &decoded_len,
-        reinterpret_cast<const unsigned char*>(data.c_str()), len);
+/* The alphabet bytes from p on, rounded down to whole quads. */
+size_t quadRun(const unsigned char *p, size_t len) {
+    return utils::scan::findNotBase64(reinterpret_cast<const char *>(p),
+        len) & ~static_cast<size_t>(3);
+}
 
-    d = reinterpret_cast<unsigned char*>(malloc(sizeof(char) * decoded_len));
-    if (d == NULL) {
-        return data;
-    }
 
-    memset(d, '\0', decoded_len);
+}  // namespace
 
-    mbedtls_base64_decode(d, decoded_len, &decoded_len,
-       reinterpret_cast<const unsigned char*>(data.c_str()), len);
 
-    ret.assign(reinterpret_cast<const char*>(d), decoded_len);
-    free(d);
+std::string Base64::encode(const std::string& data) {
+    const Tables &t = tables();
+    const unsigned char *in = reinterpret_cast<const unsigned char *>(
+        data.data());
+    size_t len = data.size();
+    std::string ret((len + 2) / 3 * 4, '\0');
+    char *out = &ret[0];
+
+    size_t i = 0;
+    for (; i + 3 <= len; i += 3) {
+        uint32_t x = (in[i] << 16) | (in[i + 1] << 8) | in[i + 2];
+        memcpy(out, t.m_encode[x >> 12], 2);
+        memcpy(out + 2, t.m_encode[x & 0xfff], 2);
+        out += 4;
+    }
+    if (i < len) {
+        uint32_t x = in[i] << 16;
+        if (i + 1 < len) {
+            x |= in[i + 1] << 8;
+        }
+        out[0] = kAlphabet[x >> 18];
+        out[1] = kAlphabet[(x >> 12) & 0x3f];
+        out[2] = i + 1 < len ? kAlphabet[(x >> 6) & 0x3f] : '=';
+        out[3] = '=';
+    }
 
     return ret;
 }
 
 
-std::string Base64::decode_forgiven(const std::string& data) {
-    size_t decoded_len = 0;
-    unsigned char *d;
-    std::string ret;
+std::string Base64::decode(const std::string& data, bool forgiven) {
+    if (forgiven) {
+        return decode_forgiven(data);
+    }
 
-    decode_forgiven_engine(NULL, 0, &decoded_len,
-        reinterpret_cast<const unsigned char*>(data.c_str()), data.size());
+    return decode(data);
+}
 
-    d = reinterpret_cast<unsigned char*>(malloc(sizeof(char) * decoded_len));
-    if (d == NULL) {
-        return data;
-    }
 
-    memset(d, '\0', decoded_len);
+/*
+ * RFC 4648 decoding, with the leniency of the mbedtls decoder used before:
+ * line breaks are skipped, and so are spaces, as long as they end a line
+ * or the input. Anything else out of the alphabet, or data after the
+ * padding, makes the whole input invalid and the result empty. A trailing
+ * partial quad is dropped. The input ends at the first NUL.
+ */
+std::string Base64::decode(const std::string& data) {
+    const Tables &t = tables();
+    const unsigned char *in = reinterpret_cast<const unsigned char *>(
+        data.data());
+    const void *nul = memchr(in, '\0', data.size());
+    size_t len = nul ? static_cast<const unsigned char *>(nul) - in
+        : data.size();
+    std::string ret(len / 4 * 3 + 3, '\0');
+    unsigned char *begin = reinterpret_cast<unsigned char *>(&ret[0]);
+    unsigned char *out = begin;
+    uint32_t x = 0;
+    int n = 0;
+    int pad = 0;
+
+    size_t i = 0;
+    while (i < len) {
+        if (n == 0 && pad == 0) {
+            size_t run = quadRun(in + i, len - i);
+            out = decodeRun(t, in + i, run, out);
+            i += run;
+            if (i == len) {
+                break;
+            }
+        }
 
-    decode_forgiven_engine(d, decoded_len, &decoded_len,
-       reinterpret_cast<const unsigned char*>(data.c_str()), data.size());
+        unsigned char c = in[i];
+        if (c == ' ') {
+            while (i < len && in[i] == ' ') {
+                i++;
+            }
+            if (i == len) {
+                break;
+            }
+            if (in[i] != '\n' && (in[i] != '\r' || i + 1 == len
+                || in[i + 1] != '\n')) {
+                return std::string();
+            }
+            continue;
+        }
+        i++;
+        if (c == '\n') {
+            continue;
+        }
+        if (c == '\r') {
+            if (i == len || in[i] != '\n') {
+                return std::string();
+            }
+            continue;
+        }
 
-    ret.assign(reinterpret_cast<const char*>(d), decoded_len);
-    free(d);
+        int s = 0;
+        if (c == '=') {
+            if (++pad > 2) {
+                return std::string();
+            }
+        } else {
+            s = t.m_sextet[c];
+            if (s < 0 || pad != 0) {
+                return std::string();
+            }
+        }
+        x = (x << 6) | s;
+        if (++n < 4) {
+            continue;
+        }
+        out[0] = static_cast<unsigned char>(x >> 16);
+        out[1] = static_cast<unsigned char>(x >> 8);
+        out[2] = static_cast<unsigned char>(x);
+        out += 3 - pad;
+        x = 0;
+        n = 0;
+    }
 
+    ret.resize(out - begin);
     return ret;
 }
 
 
-void Base64::decode_forgiven_engine(unsigned char *plain_text,
-        size_t plain_text_size, size_t *aiming_size,
-        const unsigned char *encoded, size_t input_len) {
-    int i = 0, j = 0, k = 0;
-    int ch = 0;
-    static const char b64_pad = '=';
-    static const int b64_reverse_t[256] = {
-        -2, -2, -2, -2, -2, -2, -2, -2, -2, -1, -1, -2, -2, -1, -2, -2,
-        -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2,
-        -1, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, 62, -2, -2, -2, 63,
-        52, 53, 54, 55, 56, 57, 58, 59, 60, 61, -2, -2, -2, -2, -2, -2,
-        -2, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
-        15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -2, -2, -2, -2, -2,
-        -2, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
-        41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -2, -2, -2, -2, -2,
-        -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2,
-        -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2,
-        -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2,
-        -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2,
-        -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2,
-        -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2,
-        -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2,
-        -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2
-    };
-
-
-    while (/*ch = *encoded++ != '\0' && */input_len-- > 0) {
-        ch = *encoded++;
-        if (ch == b64_pad) {
-            if (*encoded != '=' && (i % 4) == 1) {
-                *aiming_size = 0;
-                return;
+/*
+ * Decodes whatever is in the alphabet and skips everything else, padding
+ * included. A '=' right after the first character of a quad, where no
+ * byte can be complete yet, makes the result empty; so does a trailing
+ * '9' in that spot, as the engine this replaces took its sextet, 61, for
+ * the padding character.
+ */
+std::string Base64::decode_forgiven(const std::string& data) {
+    const Tables &t = tables();
+    const unsigned char *in = reinterpret_cast<const unsigned char *>(
+        data.data());
+    size_t len = data.size();
+    std::string ret(len / 4 * 3 + 2, '\0');
+    unsigned char *begin = reinterpret_cast<unsigned char *>(&ret[0]);
+    unsigned char *out = begin;
+    uint32_t x = 0;
+    int n = 0;
+
+    size_t i = 0;
+    while (i < len) {
+        if (n == 0) {
+            size_t run = quadRun(in + i, len - i);
+            out = decodeRun(t, in + i, run, out);
+            i += run;
+            if (i == len) {
+                break;
             }
-            continue;
         }
 
-        ch = b64_reverse_t[ch];
-        if (ch < 0) {
+        unsigned char c = in[i++];
+        if (c == '=') {
+            if (n == 1) {
+                return std::string();
+            }
             continue;
-        /*} else if (ch == -2) {
-            *aiming_size = 0;
-            return;*/
         }
-        switch (i % 4) {
-            case 0:
-                if (plain_text_size != 0) {
-                    plain_text[j] = ch << 2;
-                }
-                break;
-            case 1:
-                if (plain_text_size == 0) {
-                    j++;
-                } else {
-                    plain_text[j++] |= ch >> 4;
-                    plain_text[j] = (ch & 0x0f) << 4;
-                }
-                break;
-            case 2:
-                if (plain_text_size == 0) {
-                    j++;
-                } else {
-                    plain_text[j++] |= ch >>2;
-                    plain_text[j] = (ch & 0x03) << 6;
-                }
-                break;
-            case 3:
-                if (plain_text_size == 0) {
-                    j++;
-                } else {
-                    plain_text[j++] |= ch;
-                }
-                break;
+        int s = t.m_sextet[c];
+        if (s < 0) {
+            continue;
         }
-        i++;
-    }
-    k = j;
-
-    if (ch == b64_pad) {
-        switch (i % 4) {
-            case 1:
-                *aiming_size = 0;
-                return;
-            case 2:
-                k++;
-            case 3:
-                if (plain_text_size != 0) {
-                    plain_text[k] = 0;
-                }
+        x = (x << 6) | s;
+        if (++n < 4) {
+            continue;
         }
+        out[0] = static_cast<unsigned char>(x >> 16);
+        out[1] = static_cast<unsigned char>(x >> 8);
+        out[2] = static_cast<unsigned char>(x);
+        out += 3;
+        x = 0;
+        n = 0;
     }
 
-    if (plain_text_size != 0) {
-        plain_text[j] = '\0';
+    if (n == 1 && in[len - 1] == '9') {
+        return std::string();
     }
-
-    if (plain_text_size == 0) {
-        *aiming_size = k + 1;
-    } else {
-        *aiming_size = j;
+    if (n == 2) {
+        *out++ = static_cast<unsigned char>(x >> 4);
+    } else if (n == 3) {
+        *out++ = static_cast<unsigned char>(x >> 10);
+        *out++ = static_cast<unsigned char>(x >> 2);
     }
+
+    ret.resize(out - begin);
+    return ret;
 }
 
 
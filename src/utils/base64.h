@@ -31,11 +31,6 @@ class Base64 {
     static std::string decode(const std::string& data, bool forgiven);
     static std::string decode(const std::string& data);
     static std::string decode_forgiven(const std::string& data);
-
-    static void decode_forgiven_engine(unsigned char *plain_text,
-        size_t plain_text_size, size_t *aiming_size,
-        const unsigned char *encoded,
-        size_t input_len);
 };
 
 
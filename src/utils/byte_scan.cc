@@ -0,0 +1,462 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/byte_scan.h"
+
+#include <string.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define MSC_SCAN_SSE2 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define MSC_SCAN_NEON 1
+#endif
+
+
+namespace modsecurity {
+namespace utils {
+namespace scan {
+
+namespace {
+
+inline bool inRange(unsigned char c, unsigned char lo, unsigned char n) {
+    return static_cast<unsigned char>(c - lo) < n;
+}
+
+
+#if defined(MSC_SCAN_SSE2) || defined(MSC_SCAN_NEON)
+#define MSC_SCAN_BLOCKS 1
+
+const size_t kWidth = 16;
+
+#if defined(MSC_SCAN_SSE2)
+typedef __m128i Block;
+
+inline Block load(const char *p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+
+inline void store(char *p, Block v) {
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v);
+}
+
+/* SSE2 has no unsigned byte compare: shift the range to the signed bottom */
+inline Block inRange(Block v, unsigned char lo, unsigned char n) {
+    Block s = _mm_add_epi8(v, _mm_set1_epi8(static_cast<char>(0x80 - lo)));
+    return _mm_cmplt_epi8(s, _mm_set1_epi8(static_cast<char>(0x80 + n)));
+}
+
+inline Block equal(Block v, unsigned char c) {
+    return _mm_cmpeq_epi8(v, _mm_set1_epi8(static_cast<char>(c)));
+}
+
+inline Block either(Block a, Block b) {
+    return _mm_or_si128(a, b);
+}
+
+inline Block orMasked(Block v, Block mask, unsigned char c) {
+    return _mm_or_si128(v, _mm_and_si128(mask,
+        _mm_set1_epi8(static_cast<char>(c))));
+}
+
+inline Block both(Block a, Block b) {
+    return _mm_and_si128(a, b);
+}
+
+inline Block invert(Block v) {
+    return _mm_xor_si128(v, _mm_set1_epi8(static_cast<char>(0xff)));
+}
+
+/* a bit per byte of mask, kBitsPerByte apart */
+const int kBitsPerByte = 1;
+inline uint64_t bits(Block mask) {
+    return static_cast<unsigned int>(_mm_movemask_epi8(mask));
+}
+
+/* offset of the first set byte of mask, -1 if none */
+inline int first(Block mask) {
+    int m = _mm_movemask_epi8(mask);
+    if (m == 0) {
+        return -1;
+    }
+    return __builtin_ctz(m);
+}
+#else
+typedef uint8x16_t Block;
+
+inline Block load(const char *p) {
+    return vld1q_u8(reinterpret_cast<const uint8_t *>(p));
+}
+
+inline void store(char *p, Block v) {
+    vst1q_u8(reinterpret_cast<uint8_t *>(p), v);
+}
+
+inline Block inRange(Block v, unsigned char lo, unsigned char n) {
+    return vcltq_u8(vsubq_u8(v, vdupq_n_u8(lo)), vdupq_n_u8(n));
+}
+
+inline Block equal(Block v, unsigned char c) {
+    return vceqq_u8(v, vdupq_n_u8(c));
+}
+
+inline Block either(Block a, Block b) {
+    return vorrq_u8(a, b);
+}
+
+inline Block orMasked(Block v, Block mask, unsigned char c) {
+    return vorrq_u8(v, vandq_u8(mask, vdupq_n_u8(c)));
+}
+
+inline Block both(Block a, Block b) {
+    return vandq_u8(a, b);
+}
+
+inline Block invert(Block v) {
+    return vmvnq_u8(v);
+}
+
+/* NEON has no movemask, narrow every byte of the mask to a nibble */
+const int kBitsPerByte = 4;
+inline uint64_t bits(Block mask) {
+    return vget_lane_u64(vreinterpret_u64_u8(
+        vshrn_n_u16(vreinterpretq_u16_u8(mask), 4)), 0);
+}
+
+inline int first(Block mask) {
+    uint64_t m = bits(mask);
+    if (m == 0) {
+        return -1;
+    }
+    return __builtin_ctzll(m) >> 2;
+}
+#endif
+#endif
+
+
+struct Upper {
+    bool byte(unsigned char c) const { return inRange(c, 'A', 26); }
+#ifdef MSC_SCAN_BLOCKS
+    Block block(Block v) const { return inRange(v, 'A', 26); }
+#endif
+};
+
+
+struct Space {
+    bool byte(unsigned char c) const {
+        return c == ' ' || inRange(c, '\t', 5);
+    }
+#ifdef MSC_SCAN_BLOCKS
+    Block block(Block v) const {
+        return either(equal(v, ' '), inRange(v, '\t', 5));
+    }
+#endif
+};
+
+
+struct SpaceOrNbsp {
+    bool byte(unsigned char c) const {
+        return Space().byte(c) || c == 0xa0 || c == 0xc2;
+    }
+#ifdef MSC_SCAN_BLOCKS
+    Block block(Block v) const {
+        return either(Space().block(v),
+            either(equal(v, 0xa0), equal(v, 0xc2)));
+    }
+#endif
+};
+
+
+struct Either {
+    Either(unsigned char a, unsigned char b) : m_a(a), m_b(b) { }
+    bool byte(unsigned char c) const { return c == m_a || c == m_b; }
+#ifdef MSC_SCAN_BLOCKS
+    Block block(Block v) const {
+        return either(equal(v, m_a), equal(v, m_b));
+    }
+#endif
+    unsigned char m_a;
+    unsigned char m_b;
+};
+
+
+/* What ends a text run or an unquoted value in the HTML5 tokenizer */
+struct Markup {
+    bool byte(unsigned char c) const {
+        return c == '<' || c == '>' || c == '"' || c == '\'' || c == '`'
+            || c == '/' || c == '\0' || Space().byte(c);
+    }
+#ifdef MSC_SCAN_BLOCKS
+    Block block(Block v) const {
+        return either(either(either(equal(v, '<'), equal(v, '>')),
+            either(equal(v, '"'), equal(v, '\''))),
+            either(either(equal(v, '`'), equal(v, '/')),
+            either(equal(v, '\0'), Space().block(v))));
+    }
+#endif
+};
+
+
+struct NotLetter {
+    bool byte(unsigned char c) const {
+        return !(inRange(c, 'A', 26) || inRange(c, 'a', 26) || c == '_');
+    }
+#ifdef MSC_SCAN_BLOCKS
+    Block block(Block v) const {
+        return invert(either(either(inRange(v, 'A', 26),
+            inRange(v, 'a', 26)), equal(v, '_')));
+    }
+#endif
+};
+
+
+struct NotBase64 {
+    bool byte(unsigned char c) const {
+        return !(inRange(c, 'A', 26) || inRange(c, 'a', 26)
+            || inRange(c, '0', 10) || c == '+' || c == '/');
+    }
+#ifdef MSC_SCAN_BLOCKS
+    Block block(Block v) const {
+        return invert(either(either(either(inRange(v, 'A', 26),
+            inRange(v, 'a', 26)), inRange(v, '0', 10)),
+            either(equal(v, '+'), equal(v, '/'))));
+    }
+#endif
+};
+
+
+struct Digit {
+    bool byte(unsigned char c) const { return inRange(c, '0', 10); }
+#ifdef MSC_SCAN_BLOCKS
+    Block block(Block v) const { return inRange(v, '0', 10); }
+#endif
+};
+
+
+struct NotDigit {
+    bool byte(unsigned char c) const { return !inRange(c, '0', 10); }
+#ifdef MSC_SCAN_BLOCKS
+    Block block(Block v) const { return invert(inRange(v, '0', 10)); }
+#endif
+};
+
+
+struct NonAscii {
+    bool byte(unsigned char c) const { return c >= 0x80; }
+#ifdef MSC_SCAN_BLOCKS
+    Block block(Block v) const { return inRange(v, 0x80, 0x80); }
+#endif
+};
+
+
+struct Outside {
+    explicit Outside(const ByteRanges &r) : m_r(r) { }
+    bool byte(unsigned char c) const {
+        for (size_t k = 0; k < m_r.m_count; k++) {
+            if (inRange(c, m_r.m_lo[k], m_r.m_n[k])) {
+                return false;
+            }
+        }
+        return true;
+    }
+#ifdef MSC_SCAN_BLOCKS
+    Block block(Block v) const {
+        Block in = inRange(v, m_r.m_lo[0], m_r.m_n[0]);
+        for (size_t k = 1; k < m_r.m_count; k++) {
+            in = either(in, inRange(v, m_r.m_lo[k], m_r.m_n[k]));
+        }
+        return invert(in);
+    }
+#endif
+    const ByteRanges &m_r;
+};
+
+
+template<typename Kernel>
+size_t find(const char *p, size_t len, const Kernel &k) {
+    size_t i = 0;
+
+#ifdef MSC_SCAN_BLOCKS
+    for (; i + kWidth <= len; i += kWidth) {
+        int f = first(k.block(load(p + i)));
+        if (f >= 0) {
+            return i + f;
+        }
+    }
+#endif
+
+    for (; i < len; i++) {
+        if (k.byte(static_cast<unsigned char>(p[i]))) {
+            return i;
+        }
+    }
+    return len;
+}
+
+}  // namespace
+
+
+size_t findUpper(const char *p, size_t len) {
+    return find(p, len, Upper());
+}
+
+
+size_t findSpace(const char *p, size_t len) {
+    return find(p, len, Space());
+}
+
+
+size_t findSpaceOrNbsp(const char *p, size_t len) {
+    return find(p, len, SpaceOrNbsp());
+}
+
+
+size_t findEither(const char *p, size_t len, char a, char b) {
+    return find(p, len, Either(static_cast<unsigned char>(a),
+        static_cast<unsigned char>(b)));
+}
+
+
+size_t findMarkup(const char *p, size_t len) {
+    return find(p, len, Markup());
+}
+
+
+size_t findNotLetter(const char *p, size_t len) {
+    return find(p, len, NotLetter());
+}
+
+
+size_t findNotBase64(const char *p, size_t len) {
+    return find(p, len, NotBase64());
+}
+
+
+size_t findDigit(const char *p, size_t len) {
+    return find(p, len, Digit());
+}
+
+
+size_t findNonAscii(const char *p, size_t len) {
+    return find(p, len, NonAscii());
+}
+
+
+size_t findNotDigit(const char *p, size_t len) {
+    return find(p, len, NotDigit());
+}
+
+
+size_t findString(const char *p, size_t len, const char *s, size_t n) {
+    if (n == 0) {
+        return 0;
+    }
+    if (n > len) {
+        return len;
+    }
+
+    size_t i = 0;
+#ifdef MSC_SCAN_BLOCKS
+    unsigned char f = static_cast<unsigned char>(s[0]);
+    unsigned char l = static_cast<unsigned char>(s[n - 1]);
+    for (; i + n - 1 + kWidth <= len; i += kWidth) {
+        uint64_t candidates = bits(both(equal(load(p + i), f),
+            equal(load(p + i + n - 1), l)));
+        while (candidates != 0) {
+            int bit = __builtin_ctzll(candidates);
+            size_t at = i + bit / kBitsPerByte;
+            if (n <= 2 || memcmp(p + at + 1, s + 1, n - 2) == 0) {
+                return at;
+            }
+            candidates &= ~(((uint64_t{1} << kBitsPerByte) - 1)
+                << (bit - bit % kBitsPerByte));
+        }
+    }
+#endif
+
+    while (i + n <= len) {
+        const char *c = static_cast<const char *>(
+            memchr(p + i, s[0], len - n + 1 - i));
+        if (c == NULL) {
+            break;
+        }
+        size_t at = c - p;
+        if (p[at + n - 1] == s[n - 1]
+            && (n <= 2 || memcmp(p + at + 1, s + 1, n - 2) == 0)) {
+            return at;
+        }
+        i = at + 1;
+    }
+
+    return len;
+}
+
+
+bool ByteRanges::add(unsigned char lo, unsigned char hi) {
+    if (m_count == kMax) {
+        return false;
+    }
+    m_lo[m_count] = lo;
+    m_n[m_count] = static_cast<unsigned char>(hi - lo + 1);
+    m_count++;
+    return true;
+}
+
+
+size_t findOutside(const char *p, size_t len, const ByteRanges &r) {
+    if (r.m_count == 0) {
+        return 0;
+    }
+    for (size_t k = 0; k < r.m_count; k++) {
+        if (r.m_n[k] == 0) {
+            return len;
+        }
+    }
+    return find(p, len, Outside(r));
+}
+
+
+bool asciiToLower(char *p, size_t len) {
+    size_t i = findUpper(p, len);
+    if (i == len) {
+        return false;
+    }
+
+#ifdef MSC_SCAN_BLOCKS
+    for (; i + kWidth <= len; i += kWidth) {
+        Block v = load(p + i);
+        Block upper = Upper().block(v);
+        if (first(upper) >= 0) {
+            store(p + i, orMasked(v, upper, 0x20));
+        }
+    }
+#endif
+
+    for (; i < len; i++) {
+        if (Upper().byte(static_cast<unsigned char>(p[i]))) {
+            p[i] = static_cast<char>(p[i] | 0x20);
+        }
+    }
+    return true;
+}
+
+
+}  // namespace scan
+}  // namespace utils
+}  // namespace modsecurity
@@ -0,0 +1,96 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <cstddef>
+
+#ifndef SRC_UTILS_BYTE_SCAN_H_
+#define SRC_UTILS_BYTE_SCAN_H_
+
+
+namespace modsecurity {
+namespace utils {
+namespace scan {
+
+
+/**
+ * Vectorized scans used by the transformations to skip over the bytes they
+ * have nothing to do with; most of the inputs are plain text with nothing
+ * to decode, strip or lowercase.
+ *
+ * SSE2 (x86_64) and NEON (aarch64) are part of the base instruction sets,
+ * so no run time dispatch is needed. Elsewhere the scalar loops are used.
+ *
+ * The find functions return the offset of the first matching byte, or len
+ * if there is none. Whitespace is what isspace() takes as such in the C
+ * locale: ' ', '\t', '\n', '\v', '\f' and '\r'.
+ *
+ */
+size_t findUpper(const char *p, size_t len);
+size_t findSpace(const char *p, size_t len);
+size_t findSpaceOrNbsp(const char *p, size_t len);
+size_t findEither(const char *p, size_t len, char a, char b);
+size_t findDigit(const char *p, size_t len);
+/* The first byte with the high bit set, where UTF-8 needs decoding. */
+size_t findNonAscii(const char *p, size_t len);
+
+/*
+ * Used by the libinjection operators to tell the inputs they cannot
+ * flag. Markup is '<', '>', the quotes (including '`'), '/', NUL and
+ * whitespace. Letters are A-Z, a-z and '_'.
+ */
+size_t findMarkup(const char *p, size_t len);
+size_t findNotLetter(const char *p, size_t len);
+size_t findNotDigit(const char *p, size_t len);
+/* The first byte out of the base64 alphabet: A-Z, a-z, 0-9, '+' and '/'. */
+size_t findNotBase64(const char *p, size_t len);
+
+/*
+ * Offset of the first occurrence of the n bytes of s, or len. Blocks
+ * are filtered on the first and the last byte of s at once, so only the
+ * offsets where both are in place are compared in full.
+ */
+size_t findString(const char *p, size_t len, const char *s, size_t n);
+
+/*
+ * A set of bytes given as up to kMax intervals, lo to lo + n - 1, for
+ * findOutside(). A block is checked against every interval at once, which
+ * beats a table lookup per byte as long as there are only a few of them.
+ */
+struct ByteRanges {
+    static const size_t kMax = 8;
+
+    ByteRanges() : m_count(0) { }
+
+    /* Fails, adding nothing, once there are kMax intervals already. */
+    bool add(unsigned char lo, unsigned char hi);
+
+    size_t m_count;
+    unsigned char m_lo[kMax];
+    /* 0 stands for 256, the whole 0-255 range */
+    unsigned char m_n[kMax];
+};
+
+/* Offset of the first byte that is in none of the intervals, or len. */
+size_t findOutside(const char *p, size_t len, const ByteRanges &r);
+
+/* Lowercases, in place, the A-Z bytes. Returns true if any was found. */
+bool asciiToLower(char *p, size_t len);
+
+
+}  // namespace scan
+}  // namespace utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_BYTE_SCAN_H_
@@ -0,0 +1,138 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/debug_log_buffer.h"
+
+#include <stdlib.h>
+
+#include <functional>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "modsecurity/rule_message.h"
+#include "src/utils/ip_tree.h"
+#include "src/utils/random.h"
+#include "src/utils/string.h"
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+void DebugLogBuffer::add(int level, const std::string &message) {
+    m_messages.push_back({level, message});
+    m_bytes = m_bytes + message.size();
+
+    while (m_bytes > m_size && m_messages.empty() == false) {
+        m_bytes = m_bytes - m_messages.front().m_text.size();
+        m_messages.pop_front();
+        m_dropped++;
+    }
+}
+
+
+void DebugLogBuffer::flush(
+    const std::function<void(int, const std::string &)> &write) {
+    for (const Message &message : m_messages) {
+        write(message.m_level, message.m_text);
+    }
+    m_messages.clear();
+    m_bytes = 0;
+    m_dropped = 0;
+}
+
+
+DebugLogBufferFlush::DebugLogBufferFlush()
+    : m_intervention(true),
+    m_sample(0) { }
+
+
+DebugLogBufferFlush::~DebugLogBufferFlush() { }
+
+
+bool DebugLogBufferFlush::parse(const std::string &conditions,
+    std::string *error) {
+    m_intervention = false;
+
+    for (const std::string &condition : utils::string::ssplit(conditions,
+        ' ')) {
+        if (condition.empty()) {
+            continue;
+        }
+        size_t colon = condition.find(':');
+        std::string name = utils::string::tolower(condition.substr(0, colon));
+        std::string value = colon == std::string::npos ? ""
+            : condition.substr(colon + 1);
+
+        if (name == "intervention" && colon == std::string::npos) {
+            m_intervention = true;
+        } else if (name == "ruleid" && value.empty() == false) {
+            for (const std::string &id : utils::string::ssplit(value, ',')) {
+                char *end = NULL;
+                long n = strtol(id.c_str(), &end, 10);
+                if (id.empty() || *end != '\0' || n <= 0) {
+                    error->assign("Not a rule id: " + id);
+                    return false;
+                }
+                m_ruleIds.insert(static_cast<int>(n));
+            }
+        } else if (name == "clientip" && value.empty() == false) {
+            m_clientIps.reset(new IpTree());
+            if (m_clientIps->addFromBuffer(value, error) == false) {
+                return false;
+            }
+        } else if (name == "sample" && value.empty() == false) {
+            char *end = NULL;
+            m_sample = strtod(value.c_str(), &end);
+            if (*end != '\0' || m_sample < 0 || m_sample > 100) {
+                error->assign("Sample expects a percentage, got: " + value);
+                return false;
+            }
+        } else {
+            error->assign("Expected Intervention, RuleId:, ClientIp: or " \
+                "Sample:, got: " + condition);
+            return false;
+        }
+    }
+    return true;
+}
+
+
+const char *DebugLogBufferFlush::reason(bool intervention,
+    const std::string &clientIp,
+    const std::list<RuleMessage> &messages) const {
+    if (m_intervention && intervention) {
+        return "intervention";
+    }
+    if (m_ruleIds.empty() == false) {
+        for (const RuleMessage &message : messages) {
+            if (m_ruleIds.count(message.m_ruleId) > 0) {
+                return "rule id";
+            }
+        }
+    }
+    if (m_clientIps != nullptr && m_clientIps->contains(clientIp)) {
+        return "client address";
+    }
+    if (m_sample > 0 && utils::random_number(0, 100) < m_sample) {
+        return "sample";
+    }
+    return nullptr;
+}
+
+
+}  // namespace Utils
+}  // namespace modsecurity
@@ -0,0 +1,102 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_set>
+
+#ifndef SRC_UTILS_DEBUG_LOG_BUFFER_H_
+#define SRC_UTILS_DEBUG_LOG_BUFFER_H_
+
+
+namespace modsecurity {
+class RuleMessage;
+namespace Utils {
+class IpTree;
+
+
+/**
+ * SecDebugLogBuffer: the debug log messages of a transaction that are
+ * above SecDebugLogLevel, kept in memory, the oldest dropped once they
+ * take more than size bytes, until the transaction is over and it is
+ * known whether they are wanted (see DebugLogBufferFlush). Only the
+ * transaction it belongs to touches it.
+ */
+class DebugLogBuffer {
+ public:
+    explicit DebugLogBuffer(size_t size)
+        : m_size(size),
+        m_bytes(0),
+        m_dropped(0) { }
+
+    void add(int level, const std::string &message);
+
+    /* Hands the messages to write, oldest first, and empties the buffer. */
+    void flush(const std::function<void(int, const std::string &)> &write);
+
+    size_t messages() const { return m_messages.size(); }
+    size_t dropped() const { return m_dropped; }
+
+ private:
+    struct Message {
+        int m_level;
+        std::string m_text;
+    };
+
+    std::deque<Message> m_messages;
+    const size_t m_size;
+    size_t m_bytes;
+    size_t m_dropped;
+};
+
+
+/**
+ * SecDebugLogBufferFlush: when a DebugLogBuffer is written out. A list
+ * of, space separated:
+ *
+ *   Intervention                 the transaction was disrupted
+ *   RuleId:<id>[,<id>...]        one of the rules logged a match
+ *   ClientIp:<network>[,...]     the client address is in one of them
+ *   Sample:<percent>             that share of the transactions, at random
+ *
+ * Without the directive, only Intervention.
+ */
+class DebugLogBufferFlush {
+ public:
+    DebugLogBufferFlush();
+    ~DebugLogBufferFlush();
+
+    bool parse(const std::string &conditions, std::string *error);
+
+    /* Why the buffer of the transaction is to be written, or nullptr. */
+    const char *reason(bool intervention, const std::string &clientIp,
+        const std::list<RuleMessage> &messages) const;
+
+ private:
+    bool m_intervention;
+    std::unordered_set<int> m_ruleIds;
+    std::unique_ptr<IpTree> m_clientIps;
+    double m_sample;
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_DEBUG_LOG_BUFFER_H_
@@ -0,0 +1,114 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/debug_log_filter.h"
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "src/utils/ip_tree.h"
+#include "src/utils/string.h"
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+DebugLogFilter::DebugLogFilter() { }
+
+
+DebugLogFilter::~DebugLogFilter() { }
+
+
+static bool parseRuleId(const std::string &id, int64_t *n) {
+    char *end = NULL;
+    *n = strtoll(id.c_str(), &end, 10);
+    return id.empty() == false && *end == '\0' && *n > 0;
+}
+
+
+bool DebugLogFilter::parse(const std::string &filter, std::string *error) {
+    std::vector<std::pair<int64_t, int64_t>> ranges;
+
+    for (const std::string &condition : utils::string::ssplit(filter, ' ')) {
+        if (condition.empty()) {
+            continue;
+        }
+        size_t equals = condition.find('=');
+        std::string name = utils::string::tolower(condition.substr(0, equals));
+        std::string value = equals == std::string::npos ? ""
+            : condition.substr(equals + 1);
+
+        if (name == "ruleid" && value.empty() == false) {
+            for (const std::string &range : utils::string::ssplit(value,
+                ',')) {
+                size_t dash = range.find('-');
+                int64_t first = 0;
+                int64_t last = 0;
+                if (parseRuleId(range.substr(0, dash), &first) == false
+                    || (dash != std::string::npos
+                        && parseRuleId(range.substr(dash + 1), &last) == false)
+                    || (dash != std::string::npos && last < first)) {
+                    error->assign("Not a rule id or range of them: " + range);
+                    return false;
+                }
+                ranges.push_back({first, dash == std::string::npos ? first
+                    : last});
+            }
+        } else if (name == "remoteaddr" && value.empty() == false) {
+            m_remoteAddrs.reset(new IpTree());
+            if (m_remoteAddrs->addFromBuffer(value, error) == false) {
+                return false;
+            }
+        } else {
+            error->assign("Expected ruleId= or remoteAddr=, got: " \
+                + condition);
+            return false;
+        }
+    }
+
+    std::sort(ranges.begin(), ranges.end());
+    m_ruleIds.clear();
+    for (const auto &range : ranges) {
+        if (m_ruleIds.empty() == false
+            && range.first <= m_ruleIds.back().second + 1) {
+            m_ruleIds.back().second = std::max(m_ruleIds.back().second,
+                range.second);
+        } else {
+            m_ruleIds.push_back(range);
+        }
+    }
+    return true;
+}
+
+
+bool DebugLogFilter::ruleInScope(int64_t id) const {
+    auto it = std::upper_bound(m_ruleIds.begin(), m_ruleIds.end(),
+        std::make_pair(id, INT64_MAX));
+    return it != m_ruleIds.begin() && id <= (it - 1)->second;
+}
+
+
+bool DebugLogFilter::addressInScope(const std::string &address) const {
+    return m_remoteAddrs == nullptr || m_remoteAddrs->contains(address);
+}
+
+
+}  // namespace Utils
+}  // namespace modsecurity
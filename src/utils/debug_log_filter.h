@@ -0,0 +1,63 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifndef SRC_UTILS_DEBUG_LOG_FILTER_H_
+#define SRC_UTILS_DEBUG_LOG_FILTER_H_
+
+
+namespace modsecurity {
+namespace Utils {
+class IpTree;
+
+
+/**
+ * SecDebugLogFilter: what SecDebugLogLevel applies to. A list of, space
+ * separated:
+ *
+ *   ruleId=<id>[-<id>][,...]     while one of these rules runs
+ *   remoteAddr=<network>[,...]   to the clients in these networks
+ *
+ * Both have to hold when both are given. Outside of them nothing is
+ * written to the debug log, but it does not keep a SecDebugLogBuffer
+ * from buffering.
+ */
+class DebugLogFilter {
+ public:
+    DebugLogFilter();
+    ~DebugLogFilter();
+
+    bool parse(const std::string &filter, std::string *error);
+
+    bool hasRuleIds() const { return m_ruleIds.empty() == false; }
+    bool ruleInScope(int64_t id) const;
+    bool addressInScope(const std::string &address) const;
+
+ private:
+    /* sorted, not overlapping, first and last of each range */
+    std::vector<std::pair<int64_t, int64_t>> m_ruleIds;
+    std::unique_ptr<IpTree> m_remoteAddrs;
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_DEBUG_LOG_FILTER_H_
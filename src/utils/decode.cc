@@ -14,7 +14,11 @@
  */
 
 #include "src/utils/decode.h"
+
+#include <cstring>
+
 #include "modsecurity/modsecurity.h"
+#include "src/utils/byte_scan.h"
 #include "src/utils/string.h"
 
 
@@ -35,6 +39,19 @@ int urldecode_nonstrict_inplace(unsigned char *input,
 
     i = count = 0;
     while (i < input_len) {
+        /* Everything up to the next '%' or '+' is kept as is. */
+        uint64_t n = scan::findEither(reinterpret_cast<char *>(input + i),
+            input_len - i, '%', '+');
+        if (n > 0) {
+            if (d != input + i) {
+                memmove(d, input + i, n);
+            }
+            d += n;
+            count += n;
+            i += n;
+            continue;
+        }
+
         if (input[i] == '%') {
             /* Character is a percent sign. */
 
@@ -0,0 +1,302 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/dns.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "src/utils/random.h"
+
+
+namespace modsecurity {
+namespace Utils {
+
+namespace {
+
+/* used when the answer does not say better; e.g. getaddrinfo */
+const unsigned int kDefaultTtl = 300;
+
+const uint16_t kTypeA = 1;
+const uint16_t kTypeSOA = 6;
+const uint16_t kClassIN = 1;
+
+const size_t kMaxPacket = 512;
+
+
+bool nameserver(struct sockaddr_in *ns) {
+    static struct sockaddr_in cached;
+    static bool found = [] {
+        std::ifstream conf("/etc/resolv.conf");
+        std::string line;
+
+        memset(&cached, 0, sizeof(cached));
+        cached.sin_family = AF_INET;
+        cached.sin_port = htons(53);
+
+        while (std::getline(conf, line)) {
+            std::istringstream fields(line);
+            std::string keyword, address;
+            fields >> keyword >> address;
+            if (keyword == "nameserver"
+                && inet_pton(AF_INET, address.c_str(), &cached.sin_addr) == 1) {
+                return true;
+            }
+        }
+        return false;
+    }();
+
+    *ns = cached;
+    return found;
+}
+
+
+void put16(std::vector<unsigned char> *p, uint16_t v) {
+    p->push_back(static_cast<unsigned char>(v >> 8));
+    p->push_back(static_cast<unsigned char>(v & 0xff));
+}
+
+
+uint16_t get16(const unsigned char *p) {
+    return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+
+uint32_t get32(const unsigned char *p) {
+    return (static_cast<uint32_t>(p[0]) << 24)
+        | (static_cast<uint32_t>(p[1]) << 16)
+        | (static_cast<uint32_t>(p[2]) << 8)
+        | static_cast<uint32_t>(p[3]);
+}
+
+
+bool buildQuery(const std::string &name, uint16_t id,
+    std::vector<unsigned char> *q) {
+    put16(q, id);
+    put16(q, 0x0100); /* recursion desired */
+    put16(q, 1);
+    put16(q, 0);
+    put16(q, 0);
+    put16(q, 0);
+
+    size_t start = 0;
+    while (start < name.size()) {
+        size_t dot = name.find('.', start);
+        if (dot == std::string::npos) {
+            dot = name.size();
+        }
+        size_t len = dot - start;
+        if (len == 0 || len > 63) {
+            return false;
+        }
+        q->push_back(static_cast<unsigned char>(len));
+        q->insert(q->end(), name.begin() + start, name.begin() + dot);
+        start = dot + 1;
+    }
+    q->push_back(0);
+
+    put16(q, kTypeA);
+    put16(q, kClassIN);
+
+    return q->size() <= kMaxPacket;
+}
+
+
+/* skips a, possibly compressed, name; returns false if it runs off */
+bool skipName(const unsigned char *msg, size_t len, size_t *pos) {
+    while (*pos < len) {
+        unsigned char l = msg[*pos];
+        if ((l & 0xc0) == 0xc0) {
+            *pos = *pos + 2;
+            return *pos <= len;
+        }
+        *pos = *pos + 1;
+        if (l == 0) {
+            return true;
+        }
+        *pos = *pos + l;
+    }
+    return false;
+}
+
+
+DnsResult parseResponse(const unsigned char *msg, size_t len, uint16_t id,
+    struct in_addr *addr, unsigned int *ttl) {
+    if (len < 12 || get16(msg) != id || (msg[2] & 0x80) == 0) {
+        return DnsResult::Failed;
+    }
+
+    int rcode = msg[3] & 0x0f;
+    uint16_t qdcount = get16(msg + 4);
+    uint16_t ancount = get16(msg + 6);
+    uint16_t nscount = get16(msg + 8);
+    size_t pos = 12;
+
+    if (rcode != 0 && rcode != 3) {
+        return DnsResult::Failed;
+    }
+
+    for (uint16_t i = 0; i < qdcount; i++) {
+        if (skipName(msg, len, &pos) == false || pos + 4 > len) {
+            return DnsResult::Failed;
+        }
+        pos = pos + 4;
+    }
+
+    /*
+     * Answers first, then the authority section, where the SOA tells for
+     * how long the negative answer holds (RFC 2308).
+     */
+    *ttl = kDefaultTtl;
+    for (unsigned int i = 0; i < static_cast<unsigned int>(ancount) + nscount;
+        i++) {
+        if (skipName(msg, len, &pos) == false || pos + 10 > len) {
+            return DnsResult::Failed;
+        }
+        uint16_t type = get16(msg + pos);
+        uint16_t cls = get16(msg + pos + 2);
+        uint32_t rrTtl = get32(msg + pos + 4);
+        uint16_t rdlength = get16(msg + pos + 8);
+        pos = pos + 10;
+        if (pos + rdlength > len) {
+            return DnsResult::Failed;
+        }
+
+        if (i < ancount && rcode == 0 && type == kTypeA && cls == kClassIN
+            && rdlength == 4) {
+            memcpy(&addr->s_addr, msg + pos, 4);
+            *ttl = rrTtl;
+            return DnsResult::Found;
+        }
+        if (i >= ancount && type == kTypeSOA && rdlength >= 20) {
+            uint32_t minimum = get32(msg + pos + rdlength - 4);
+            *ttl = rrTtl < minimum ? rrTtl : minimum;
+        }
+        pos = pos + rdlength;
+    }
+
+    return DnsResult::NotFound;
+}
+
+
+DnsResult resolveBlocking(const std::string &name, struct in_addr *addr,
+    unsigned int *ttl) {
+    struct addrinfo hints;
+    struct addrinfo *info = NULL;
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+
+    int rc = getaddrinfo(name.c_str(), NULL, &hints, &info);
+    *ttl = kDefaultTtl;
+    if (rc != 0) {
+        if (info != NULL) {
+            freeaddrinfo(info);
+        }
+        return rc == EAI_NONAME ? DnsResult::NotFound : DnsResult::Failed;
+    }
+
+    *addr = reinterpret_cast<struct sockaddr_in *>(info->ai_addr)->sin_addr;
+    freeaddrinfo(info);
+
+    return DnsResult::Found;
+}
+
+
+}  // namespace
+
+
+DnsResult dnsResolveA(const std::string &name, long timeout,
+    struct in_addr *addr, unsigned int *ttl) {
+    struct sockaddr_in ns;
+    std::vector<unsigned char> query;
+    unsigned char response[kMaxPacket];
+    DnsResult result = DnsResult::Failed;
+
+    if (nameserver(&ns) == false) {
+        return resolveBlocking(name, addr, ttl);
+    }
+
+    uint16_t id = static_cast<uint16_t>(utils::random_number(0, 0xffff));
+    if (buildQuery(name, id, &query) == false) {
+        return DnsResult::Failed;
+    }
+
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        return DnsResult::Failed;
+    }
+
+    if (connect(fd, reinterpret_cast<struct sockaddr *>(&ns),
+        sizeof(ns)) != 0
+        || send(fd, query.data(), query.size(), 0) < 0) {
+        close(fd);
+        return DnsResult::Failed;
+    }
+
+    struct timeval start, now;
+    gettimeofday(&start, NULL);
+    long left = timeout;
+    while (left > 0) {
+        struct pollfd pfd;
+        pfd.fd = fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+
+        int rc = poll(&pfd, 1, static_cast<int>(left));
+        if (rc < 0 && errno != EINTR) {
+            break;
+        }
+        if (rc > 0) {
+            ssize_t r = recv(fd, response, sizeof(response), 0);
+            if (r < 0 && errno != EINTR) {
+                break;
+            }
+            if (r > 0) {
+                result = parseResponse(response, r, id, addr, ttl);
+                /* ignore what looks like a stray (or spoofed) datagram */
+                if (result != DnsResult::Failed || (r >= 2
+                    && get16(response) == id)) {
+                    break;
+                }
+            }
+        }
+
+        gettimeofday(&now, NULL);
+        left = timeout - ((now.tv_sec - start.tv_sec) * 1000
+            + (now.tv_usec - start.tv_usec) / 1000);
+    }
+
+    close(fd);
+    return result;
+}
+
+
+}  // namespace Utils
+}  // namespace modsecurity
@@ -0,0 +1,57 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <netinet/in.h>
+
+#include <string>
+
+#ifndef SRC_UTILS_DNS_H_
+#define SRC_UTILS_DNS_H_
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+enum class DnsResult {
+    /* the name has an A record */
+    Found,
+    /* NXDOMAIN, or no A record for the name */
+    NotFound,
+    /* timeout, server failure, bad response... */
+    Failed,
+};
+
+
+/**
+ * Looks for an A record of name, waiting at most timeout milliseconds for
+ * the answer.
+ *
+ * The query goes, over UDP, to the first IPv4 nameserver listed in
+ * /etc/resolv.conf. If there is none, the lookup falls back to the
+ * (blocking, without timeout or TTL) getaddrinfo.
+ *
+ * On Found, addr holds the address; ttl is filled on Found and NotFound
+ * with the time, in seconds, the answer may be cached for.
+ *
+ */
+DnsResult dnsResolveA(const std::string &name, long timeout,
+    struct in_addr *addr, unsigned int *ttl);
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_DNS_H_
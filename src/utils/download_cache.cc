@@ -0,0 +1,307 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/download_cache.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "src/utils/https_client.h"
+#include "src/utils/sha1.h"
+#include "src/utils/string.h"
+#include "src/utils/thread_pool.h"
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+namespace {
+
+/* Copies younger than this are used without asking the server. */
+const int64_t kFreshSeconds = 60;
+
+/* Downloads that prefetch() has going at the same time, at most. */
+const size_t kParallelDownloads = 8;
+
+
+std::vector<std::string> wordsOf(const std::string &line) {
+    std::vector<std::string> words;
+    size_t i = 0;
+
+    while (i < line.size()) {
+        size_t end = line.find_first_of(" \t\r", i);
+        if (end == std::string::npos) {
+            end = line.size();
+        }
+        if (end > i) {
+            words.push_back(line.substr(i, end - i));
+        }
+        i = end + 1;
+    }
+
+    return words;
+}
+
+
+/* Written aside and renamed, so that readers see all of it or nothing. */
+bool writeFile(const std::string &path, const std::string &data) {
+    std::string tmp(path + ".tmp");
+    int fd = open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    size_t done = 0;
+
+    if (fd < 0) {
+        return false;
+    }
+    while (done < data.size()) {
+        ssize_t n = write(fd, data.data() + done, data.size() - done);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            close(fd);
+            unlink(tmp.c_str());
+            return false;
+        }
+        done += n;
+    }
+    close(fd);
+
+    if (rename(tmp.c_str(), path.c_str()) != 0) {
+        unlink(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+
+bool readFile(const std::string &path, std::string *data) {
+    std::ifstream in(path, std::ios::binary);
+
+    if (in.is_open() == false) {
+        return false;
+    }
+    std::stringstream ss;
+    ss << in.rdbuf();
+    *data = ss.str();
+    return true;
+}
+
+}  // namespace
+
+
+DownloadCache::DownloadCache() {
+    pthread_mutex_init(&m_lock, NULL);
+}
+
+
+bool DownloadCache::setDirectory(const std::string &directory,
+    std::string *error) {
+    struct stat st;
+
+    if (directory.empty() == false && (stat(directory.c_str(), &st) != 0
+        || S_ISDIR(st.st_mode) == false
+        || access(directory.c_str(), W_OK | X_OK) != 0)) {
+        error->assign("Not a writable directory: " + directory);
+        return false;
+    }
+
+    pthread_mutex_lock(&m_lock);
+    m_directory = directory;
+    pthread_mutex_unlock(&m_lock);
+    return true;
+}
+
+
+bool DownloadCache::enabled() {
+    pthread_mutex_lock(&m_lock);
+    bool enabled = m_directory.empty() == false;
+    pthread_mutex_unlock(&m_lock);
+    return enabled;
+}
+
+
+/* The key is a secret of the rule server: it only goes in the hash. */
+std::string DownloadCache::pathOf(const std::string &uri,
+    const std::string &key) {
+    pthread_mutex_lock(&m_lock);
+    std::string directory(m_directory);
+    pthread_mutex_unlock(&m_lock);
+
+    if (directory.empty()) {
+        return "";
+    }
+    return directory + "/" + Sha1::hexdigest(key + "\n" + uri);
+}
+
+
+int DownloadCache::lock(const std::string &uri, const std::string &key) {
+    std::string path(pathOf(uri, key));
+
+    if (path.empty()) {
+        return -1;
+    }
+    int fd = open((path + ".lock").c_str(), O_RDWR | O_CREAT, 0600);
+    if (fd < 0) {
+        return -1;
+    }
+    while (flock(fd, LOCK_EX) != 0) {
+        if (errno != EINTR) {
+            close(fd);
+            return -1;
+        }
+    }
+    return fd;
+}
+
+
+void DownloadCache::unlock(int fd) {
+    if (fd < 0) {
+        return;
+    }
+    flock(fd, LOCK_UN);
+    close(fd);
+}
+
+
+/*
+ * The content goes in <hash>, what it takes to revalidate it in
+ * <hash>.meta: the time it was fetched, the ETag and the Last-Modified,
+ * a line each.
+ */
+bool DownloadCache::load(const std::string &uri, const std::string &key,
+    Entry *entry) {
+    std::string path(pathOf(uri, key));
+    std::string meta;
+
+    if (path.empty() || readFile(path + ".meta", &meta) == false) {
+        return false;
+    }
+
+    std::istringstream lines(meta);
+    std::string fetched;
+    if (!std::getline(lines, fetched) || !std::getline(lines, entry->m_etag)
+        || !std::getline(lines, entry->m_lastModified)) {
+        return false;
+    }
+    entry->m_fetched = strtoll(fetched.c_str(), NULL, 10);
+
+    return readFile(path, &entry->m_content);
+}
+
+
+void DownloadCache::store(const std::string &uri, const std::string &key,
+    const Entry &entry) {
+    std::string path(pathOf(uri, key));
+
+    if (path.empty() || writeFile(path, entry.m_content) == false) {
+        return;
+    }
+    writeFile(path + ".meta", std::to_string(entry.m_fetched) + "\n"
+        + entry.m_etag + "\n" + entry.m_lastModified + "\n");
+}
+
+
+bool DownloadCache::fresh(const Entry &entry) {
+    int64_t age = time(NULL) - entry.m_fetched;
+    return age >= 0 && age < kFreshSeconds;
+}
+
+
+void DownloadCache::prefetch(const std::string &rules) {
+    std::vector<std::pair<std::string, std::string>> sources;
+    std::istringstream lines(rules);
+    std::string line;
+
+    while (std::getline(lines, line)) {
+        std::vector<std::string> words(wordsOf(line));
+        if (words.empty() || (words[0][0] != 'S' && words[0][0] != 's')) {
+            continue;
+        }
+        std::string directive(utils::string::tolower(words[0]));
+        if (directive == "secremoterulescachedir" && words.size() == 2) {
+            /* a bad one is reported by the parser, when it gets to it */
+            std::string error;
+            setDirectory(words[1], &error);
+        } else if (directive == "secremoterules" && words.size() == 3) {
+            sources.emplace_back(words[2], words[1]);
+        }
+    }
+
+    /* a single one is downloaded by the parser just the same */
+    if (sources.size() < 2) {
+        return;
+    }
+
+    std::vector<std::function<void()>> tasks;
+    for (const auto &source : sources) {
+        tasks.push_back([this, &source] {
+            HttpsClient client;
+            client.setKey(source.second);
+            if (client.download(source.first) == false) {
+                return;
+            }
+            pthread_mutex_lock(&m_lock);
+            m_prefetched[client.key() + "\n" + source.first] =
+                std::move(client.content);
+            pthread_mutex_unlock(&m_lock);
+        });
+    }
+
+    ThreadPool pool(std::min(sources.size(), kParallelDownloads));
+    pool.run(tasks);
+}
+
+
+bool DownloadCache::takePrefetched(const std::string &uri,
+    const std::string &key, std::string *content) {
+    bool found = false;
+
+    pthread_mutex_lock(&m_lock);
+    auto it = m_prefetched.find(key + "\n" + uri);
+    if (it != m_prefetched.end()) {
+        *content = std::move(it->second);
+        m_prefetched.erase(it);
+        found = true;
+    }
+    pthread_mutex_unlock(&m_lock);
+
+    return found;
+}
+
+
+void DownloadCache::clearPrefetched() {
+    pthread_mutex_lock(&m_lock);
+    m_prefetched.clear();
+    pthread_mutex_unlock(&m_lock);
+}
+
+
+}  // namespace Utils
+}  // namespace modsecurity
@@ -0,0 +1,104 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <pthread.h>
+#include <stdint.h>
+
+#include <string>
+#include <unordered_map>
+
+#ifndef SRC_UTILS_DOWNLOAD_CACHE_H_
+#define SRC_UTILS_DOWNLOAD_CACHE_H_
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+/**
+ * What HttpsClient downloaded before, kept on disk (SecRemoteRulesCacheDir)
+ * for every process of the host.
+ *
+ * An entry is named after the URL and the key it was downloaded with. A
+ * copy younger than a minute is taken as it is: the workers of a server
+ * that start together download once. An older one is revalidated with
+ * If-None-Match / If-Modified-Since, and still used if the server can not
+ * be reached. The process that downloads holds a lock on the entry,
+ * others wait for it and take what it got.
+ *
+ * Apart from it, prefetch() downloads all of the SecRemoteRules of a
+ * configuration at the same time, before the parser gets to them one
+ * after the other.
+ *
+ */
+class DownloadCache {
+ public:
+    struct Entry {
+        Entry() : m_fetched(0) { }
+        std::string m_etag;
+        std::string m_lastModified;
+        std::string m_content;
+        /* seconds since the epoch of the last download or revalidation */
+        int64_t m_fetched;
+    };
+
+    static DownloadCache &getInstance() {
+        static DownloadCache *instance = new DownloadCache();
+        return *instance;
+    }
+
+    /* An empty directory turns the cache off. */
+    bool setDirectory(const std::string &directory, std::string *error);
+    bool enabled();
+
+    /**
+     * Locks the entry of uri and key against the other processes and
+     * threads, until unlock(). -1 if there is no cache or no lock to take.
+     */
+    int lock(const std::string &uri, const std::string &key);
+    void unlock(int fd);
+
+    bool load(const std::string &uri, const std::string &key,
+        Entry *entry);
+    void store(const std::string &uri, const std::string &key,
+        const Entry &entry);
+    static bool fresh(const Entry &entry);
+
+    /**
+     * Downloads, in parallel, what the SecRemoteRules lines of rules point
+     * to. If rules has a SecRemoteRulesCacheDir, it is set first, so that
+     * the downloads go through the cache already.
+     */
+    void prefetch(const std::string &rules);
+    /* What prefetch() got for uri and key, once. */
+    bool takePrefetched(const std::string &uri, const std::string &key,
+        std::string *content);
+    void clearPrefetched();
+
+ private:
+    DownloadCache();
+
+    std::string pathOf(const std::string &uri, const std::string &key);
+
+    pthread_mutex_t m_lock;
+    std::string m_directory;
+    std::unordered_map<std::string, std::string> m_prefetched;
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_DOWNLOAD_CACHE_H_
@@ -0,0 +1,362 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/file_scanner.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+const size_t FileScanner::kPoolSize;
+const long FileScanner::kDefaultTimeout;
+
+
+FileScanner::FileScanner(Protocol protocol, const std::string &socket,
+    long timeout)
+    : m_protocol(protocol),
+    m_socket(socket),
+    m_timeout(timeout > 0 ? timeout : kDefaultTimeout),
+    m_pid(getpid()) {
+    pthread_mutex_init(&m_lock, NULL);
+}
+
+
+FileScanner::~FileScanner() {
+    for (int fd : m_pool) {
+        close(fd);
+    }
+    pthread_mutex_destroy(&m_lock);
+}
+
+
+FileScanner *FileScanner::fromParameter(const std::string &param,
+    std::string *error) {
+    Protocol protocol;
+    size_t start;
+
+    if (param.compare(0, 5, "unix:") == 0) {
+        protocol = LineProtocol;
+        start = 5;
+    } else if (param.compare(0, 6, "clamd:") == 0) {
+        protocol = ClamdProtocol;
+        start = 6;
+    } else {
+        return NULL;
+    }
+
+    std::stringstream ss(param.substr(start));
+    std::string socket;
+    std::string option;
+    long timeout = kDefaultTimeout;
+
+    struct sockaddr_un addr;
+
+    ss >> socket;
+    if (socket.empty() || socket.size() >= sizeof(addr.sun_path)) {
+        error->assign("Invalid socket for @inspectFile: " + param);
+        return NULL;
+    }
+
+    while (ss >> option) {
+        if (option.compare(0, 8, "timeout=") != 0) {
+            error->assign("Unknown @inspectFile option: " + option);
+            return NULL;
+        }
+        char *end = NULL;
+        timeout = strtol(option.c_str() + 8, &end, 10);
+        if (end == option.c_str() + 8 || *end != '\0' || timeout <= 0) {
+            error->assign("Invalid @inspectFile timeout: " + option);
+            return NULL;
+        }
+    }
+
+    return new FileScanner(protocol, socket, timeout);
+}
+
+
+bool FileScanner::scan(const std::string &file, bool *found,
+    std::string *reply, std::string *error) {
+    std::ifstream content;
+    bool pooled;
+
+    reply->clear();
+    if (m_protocol == ClamdProtocol) {
+        /* before a connection is spent on it */
+        content.open(file, std::ios::in | std::ios::binary);
+        if (content.is_open() == false) {
+            error->assign("Failed to open file: " + file);
+            return false;
+        }
+    }
+
+    int fd = acquire(&pooled, error);
+    if (fd < 0) {
+        return false;
+    }
+
+    if (request(fd, file, &content, reply, error) == false) {
+        close(fd);
+        if (pooled == false) {
+            return false;
+        }
+        /* the scanner closed it while it was idle; once more */
+        error->clear();
+        fd = connectSocket(error);
+        if (fd < 0) {
+            return false;
+        }
+        content.clear();
+        content.seekg(0);
+        if (request(fd, file, &content, reply, error) == false) {
+            close(fd);
+            return false;
+        }
+    }
+
+    release(fd);
+
+    if (m_protocol == ClamdProtocol) {
+        /* "<id>: stream: <virus> FOUND", "... OK" or "... ERROR" */
+        size_t pos = reply->find(": ");
+        if (pos != std::string::npos) {
+            reply->erase(0, pos + 2);
+        }
+        if (reply->compare(0, 8, "stream: ") == 0) {
+            reply->erase(0, 8);
+        }
+        if (reply->size() >= 6
+            && reply->compare(reply->size() - 6, 6, " ERROR") == 0) {
+            error->assign("clamd: " + *reply);
+            return false;
+        }
+        *found = reply->size() >= 6
+            && reply->compare(reply->size() - 6, 6, " FOUND") == 0;
+    } else {
+        *found = reply->size() > 0 && reply->at(0) != '1';
+    }
+
+    return true;
+}
+
+
+int FileScanner::acquire(bool *pooled, std::string *error) {
+    int fd = -1;
+
+    pthread_mutex_lock(&m_lock);
+    if (m_pid != getpid()) {
+        /* those are the parent's connections, not ours to use */
+        for (int inherited : m_pool) {
+            close(inherited);
+        }
+        m_pool.clear();
+        m_pid = getpid();
+    }
+    if (m_pool.empty() == false) {
+        fd = m_pool.back();
+        m_pool.pop_back();
+    }
+    pthread_mutex_unlock(&m_lock);
+
+    *pooled = fd >= 0;
+    if (fd < 0) {
+        fd = connectSocket(error);
+    }
+
+    return fd;
+}
+
+
+void FileScanner::release(int fd) {
+    pthread_mutex_lock(&m_lock);
+    if (m_pid == getpid() && m_pool.size() < kPoolSize) {
+        m_pool.push_back(fd);
+        fd = -1;
+    }
+    pthread_mutex_unlock(&m_lock);
+
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+
+int FileScanner::connectSocket(std::string *error) {
+    struct sockaddr_un addr;
+    struct timeval tv;
+    int fd;
+
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        error->assign("Failed to create a socket: " +
+            std::string(strerror(errno)));
+        return -1;
+    }
+
+    tv.tv_sec = m_timeout / 1000;
+    tv.tv_usec = (m_timeout % 1000) * 1000;
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    memcpy(addr.sun_path, m_socket.c_str(), m_socket.size());
+
+    if (connect(fd, reinterpret_cast<struct sockaddr *>(&addr),
+        sizeof(addr)) != 0) {
+        error->assign("Failed to connect to " + m_socket + ": " +
+            std::string(strerror(errno)));
+        close(fd);
+        return -1;
+    }
+
+    if (m_protocol == ClamdProtocol
+        && sendAll(fd, "zIDSESSION", sizeof("zIDSESSION")) == false) {
+        error->assign("Failed to start a session with " + m_socket);
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+
+bool FileScanner::request(int fd, const std::string &file,
+    std::ifstream *content, std::string *reply, std::string *error) {
+    reply->clear();
+
+    if (m_protocol == ClamdProtocol) {
+        if (streamFile(fd, content, error) == false) {
+            return false;
+        }
+        if (readReply(fd, '\0', reply) == false) {
+            error->assign("No answer from " + m_socket);
+            return false;
+        }
+        return true;
+    }
+
+    if (file.find('\n') != std::string::npos) {
+        error->assign("File name not supported by the line protocol: " +
+            file);
+        return false;
+    }
+
+    std::string line(file + "\n");
+    if (sendAll(fd, line.c_str(), line.size()) == false
+        || readReply(fd, '\n', reply) == false) {
+        error->assign("No answer from " + m_socket);
+        return false;
+    }
+
+    return true;
+}
+
+
+bool FileScanner::streamFile(int fd, std::ifstream *f,
+    std::string *error) {
+    char buffer[65536];
+
+    if (sendAll(fd, "zINSTREAM", sizeof("zINSTREAM")) == false) {
+        error->assign("Failed to send to " + m_socket);
+        return false;
+    }
+
+    while (*f) {
+        f->read(buffer, sizeof(buffer));
+        uint32_t len = static_cast<uint32_t>(f->gcount());
+        if (len == 0) {
+            break;
+        }
+        uint32_t prefix = htonl(len);
+        if (sendAll(fd, reinterpret_cast<const char *>(&prefix),
+            sizeof(prefix)) == false || sendAll(fd, buffer, len) == false) {
+            error->assign("Failed to send to " + m_socket);
+            return false;
+        }
+    }
+
+    /* a zero length chunk ends the stream */
+    uint32_t end = 0;
+    if (sendAll(fd, reinterpret_cast<const char *>(&end),
+        sizeof(end)) == false) {
+        error->assign("Failed to send to " + m_socket);
+        return false;
+    }
+
+    return true;
+}
+
+
+bool FileScanner::sendAll(int fd, const char *data, size_t len) {
+    while (len > 0) {
+        ssize_t n = send(fd, data, len, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        len -= n;
+    }
+    return true;
+}
+
+
+bool FileScanner::readReply(int fd, char terminator, std::string *reply) {
+    char buffer[512];
+
+    /* one request at a time per connection, nothing follows the answer */
+    while (reply->size() < 4096) {
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        const char *t = static_cast<const char *>(memchr(buffer, terminator,
+            n));
+        if (t != NULL) {
+            reply->append(buffer, t - buffer);
+            return true;
+        }
+        reply->append(buffer, n);
+    }
+
+    return false;
+}
+
+
+}  // namespace Utils
+}  // namespace modsecurity
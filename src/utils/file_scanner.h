@@ -0,0 +1,105 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <pthread.h>
+#include <sys/types.h>
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifndef SRC_UTILS_FILE_SCANNER_H_
+#define SRC_UTILS_FILE_SCANNER_H_
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+/**
+ * Client of a long running file scanner listening on a UNIX socket; the
+ * persistent alternative to the script that @inspectFile would otherwise
+ * spawn for every file.
+ *
+ * Two protocols are spoken:
+ *
+ *  - unix:<socket>: the name of the file is sent followed by a new line,
+ *    the scanner answers with a single line. As the output of a script,
+ *    an answer starting with "1" means the file is clean.
+ *
+ *  - clamd:<socket>: ClamAV clamd, the content of the file is sent with
+ *    INSTREAM inside an IDSESSION; any answer ending in FOUND is a match.
+ *    clamd does not need to be able to read the temporary files.
+ *
+ * Connections are kept in a pool of up to kPoolSize idle ones and handed
+ * out one per scan, so concurrent scans do not wait on each other. A
+ * pooled connection the scanner closed in the meantime is replaced once.
+ * Every connect, send and receive is bounded by the timeout.
+ *
+ */
+class FileScanner {
+ public:
+    enum Protocol {
+        LineProtocol,
+        ClamdProtocol
+    };
+
+    static const size_t kPoolSize = 8;
+    static const long kDefaultTimeout = 5000;
+
+    FileScanner(Protocol protocol, const std::string &socket, long timeout);
+    ~FileScanner();
+
+    FileScanner(const FileScanner&) = delete;
+    FileScanner& operator=(const FileScanner&) = delete;
+
+    /*
+     * Parses an @inspectFile parameter: "unix:<socket>" or
+     * "clamd:<socket>", optionally followed by " timeout=<ms>". Returns
+     * NULL, with error left empty, when it is a plain script instead.
+     */
+    static FileScanner *fromParameter(const std::string &param,
+        std::string *error);
+
+    /* false on a failure to talk to the scanner */
+    bool scan(const std::string &file, bool *found, std::string *reply,
+        std::string *error);
+
+ private:
+    int acquire(bool *pooled, std::string *error);
+    void release(int fd);
+    int connectSocket(std::string *error);
+    bool request(int fd, const std::string &file, std::ifstream *content,
+        std::string *reply, std::string *error);
+    bool streamFile(int fd, std::ifstream *content, std::string *error);
+    static bool sendAll(int fd, const char *data, size_t len);
+    static bool readReply(int fd, char terminator, std::string *reply);
+
+    Protocol m_protocol;
+    std::string m_socket;
+    long m_timeout;
+
+    std::vector<int> m_pool;
+    /* a pool inherited through fork() is shared with the parent */
+    pid_t m_pid;
+    pthread_mutex_t m_lock;
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_FILE_SCANNER_H_
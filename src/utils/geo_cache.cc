@@ -0,0 +1,146 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/geo_cache.h"
+
+#include <pthread.h>
+#include <sys/socket.h>
+#include <time.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+const size_t GeoCache::kShards;
+const size_t GeoCache::kDefaultCapacity;
+const long GeoCache::kDefaultTtl;
+
+
+GeoCache::GeoCache(size_t capacity, long ttl)
+    : m_capacity(capacity / kShards > 0 ? capacity / kShards : 1),
+    m_ttl(ttl) {
+    for (size_t i = 0; i < kShards; i++) {
+        m_shards[i].hits = 0;
+        m_shards[i].misses = 0;
+        m_shards[i].index.reserve(m_capacity);
+        pthread_mutex_init(&m_shards[i].lock, NULL);
+    }
+}
+
+
+GeoCache::~GeoCache() {
+    for (size_t i = 0; i < kShards; i++) {
+        pthread_mutex_destroy(&m_shards[i].lock);
+    }
+}
+
+
+std::string GeoCache::key(int family, const unsigned char *addr) {
+    std::string k(1, family == AF_INET6 ? '6' : '4');
+    k.append(reinterpret_cast<const char *>(addr), family == AF_INET6 ? 16 : 4);
+    return k;
+}
+
+
+GeoCache::Shard &GeoCache::shard(const std::string &key) {
+    return m_shards[std::hash<std::string>()(key) % kShards];
+}
+
+
+std::shared_ptr<const GeoRecord> GeoCache::get(int family,
+    const unsigned char *addr) {
+    std::string k = key(family, addr);
+    Shard &s = shard(k);
+    std::shared_ptr<const GeoRecord> record;
+
+    pthread_mutex_lock(&s.lock);
+    auto it = s.index.find(k);
+    if (it == s.index.end()) {
+        s.misses++;
+    } else if (it->second->expires <= time(NULL)) {
+        s.entries.erase(it->second);
+        s.index.erase(it);
+        s.misses++;
+    } else {
+        s.entries.splice(s.entries.begin(), s.entries, it->second);
+        record = it->second->record;
+        s.hits++;
+    }
+    pthread_mutex_unlock(&s.lock);
+
+    return record;
+}
+
+
+void GeoCache::put(int family, const unsigned char *addr,
+    std::shared_ptr<const GeoRecord> record) {
+    std::string k = key(family, addr);
+    Shard &s = shard(k);
+
+    pthread_mutex_lock(&s.lock);
+    auto it = s.index.find(k);
+    if (it != s.index.end()) {
+        /* someone else looked it up in the meantime */
+        s.entries.erase(it->second);
+        s.index.erase(it);
+    } else if (s.entries.size() >= m_capacity) {
+        s.index.erase(s.entries.back().key);
+        s.entries.pop_back();
+    }
+    s.entries.push_front(Entry{k, time(NULL) + m_ttl, record});
+    s.index[k] = s.entries.begin();
+    pthread_mutex_unlock(&s.lock);
+}
+
+
+void GeoCache::clear() {
+    for (size_t i = 0; i < kShards; i++) {
+        pthread_mutex_lock(&m_shards[i].lock);
+        m_shards[i].index.clear();
+        m_shards[i].entries.clear();
+        pthread_mutex_unlock(&m_shards[i].lock);
+    }
+}
+
+
+size_t GeoCache::hits() {
+    size_t h = 0;
+    for (size_t i = 0; i < kShards; i++) {
+        pthread_mutex_lock(&m_shards[i].lock);
+        h += m_shards[i].hits;
+        pthread_mutex_unlock(&m_shards[i].lock);
+    }
+    return h;
+}
+
+
+size_t GeoCache::misses() {
+    size_t m = 0;
+    for (size_t i = 0; i < kShards; i++) {
+        pthread_mutex_lock(&m_shards[i].lock);
+        m += m_shards[i].misses;
+        pthread_mutex_unlock(&m_shards[i].lock);
+    }
+    return m;
+}
+
+
+}  // namespace Utils
+}  // namespace modsecurity
@@ -0,0 +1,132 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <pthread.h>
+#include <time.h>
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#ifndef SRC_UTILS_GEO_CACHE_H_
+#define SRC_UTILS_GEO_CACHE_H_
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+/* the GEO collection, in the order the MaxMind database is walked */
+enum GeoField {
+    GEO_COUNTRY_CODE,
+    GEO_COUNTRY_CODE3,
+    GEO_COUNTRY_NAME,
+    GEO_COUNTRY_CONTINENT,
+    GEO_REGION,
+    GEO_CITY,
+    GEO_POSTAL_CODE,
+    GEO_LATITUDE,
+    GEO_LONGITUDE,
+    GEO_DMA_CODE,
+    GEO_AREA_CODE,
+    GEO_FIELDS
+};
+
+
+/* what the database had to say about one address */
+struct GeoRecord {
+    GeoRecord() : found(false), looked(0), present(0) { }
+
+    void set(GeoField field, const std::string &value) {
+        values[field] = value;
+        present |= 1u << field;
+    }
+
+    bool found;
+    /* GeoField bits read from the database, and the ones it had */
+    unsigned int looked;
+    unsigned int present;
+    std::string values[GEO_FIELDS];
+};
+
+
+/**
+ * Bounded LRU of database lookups, keyed by the binary address.
+ *
+ * The same clients come back over and over, walking the database and
+ * copying out every field for each of their requests is wasted work.
+ * Addresses that are not in the database are cached as well, as a record
+ * that was not found. Entries expire after ttl seconds, and the whole
+ * cache is dropped when the database is replaced.
+ *
+ * The entries are spread over kShards independent lists, each with its
+ * own lock, so the threads of a busy server do not all queue on one.
+ *
+ */
+class GeoCache {
+ public:
+    static const size_t kShards = 16;
+    static const size_t kDefaultCapacity = 4096;
+    static const long kDefaultTtl = 600;
+
+    explicit GeoCache(size_t capacity = kDefaultCapacity,
+        long ttl = kDefaultTtl);
+    ~GeoCache();
+
+    GeoCache(const GeoCache&) = delete;
+    GeoCache& operator=(const GeoCache&) = delete;
+
+    /* family is AF_INET or AF_INET6, NULL on a miss */
+    std::shared_ptr<const GeoRecord> get(int family,
+        const unsigned char *addr);
+    void put(int family, const unsigned char *addr,
+        std::shared_ptr<const GeoRecord> record);
+    void clear();
+
+    size_t hits();
+    size_t misses();
+
+ private:
+    struct Entry {
+        std::string key;
+        time_t expires;
+        std::shared_ptr<const GeoRecord> record;
+    };
+
+    struct Shard {
+        /* most recently used first */
+        std::list<Entry> entries;
+        std::unordered_map<std::string, std::list<Entry>::iterator> index;
+        size_t hits;
+        size_t misses;
+        pthread_mutex_t lock;
+    };
+
+    static std::string key(int family, const unsigned char *addr);
+    Shard &shard(const std::string &key);
+
+    size_t m_capacity;
+    long m_ttl;
+    Shard m_shards[kShards];
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_GEO_CACHE_H_
@@ -17,12 +17,16 @@
 #include <sys/types.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
+#include <string.h>
+#include <strings.h>
 #include <string>
 
 #include <fstream>
 #include <iostream>
 
+#include "modsecurity/connection.h"
 #include "src/utils/geo_lookup.h"
+#include "src/utils/ip_tree.h"
 #if WITH_MAXMIND
 #include <maxminddb.h>
 #elif WITH_GEOIP
@@ -51,6 +55,7 @@ void GeoLookup::cleanUp() {
     }
 #endif
     m_version = NOT_LOADED;
+    m_cache.clear();
 }
 
 
@@ -63,6 +68,8 @@ bool GeoLookup::setDataBase(const std::string& filePath,
     std::string intGeo;
 #endif
 
+    m_cache.clear();
+
 #ifdef WITH_MAXMIND
     int status = MMDB_open(filePath.c_str(), MMDB_MODE_MMAP, &mmdb);
     if (status != MMDB_SUCCESS) {
@@ -112,8 +119,41 @@ bool GeoLookup::setDataBase(const std::string& filePath,
 }
 
 
+namespace {
+
+/* GeoField order */
+const char *fieldNames[GEO_FIELDS] = {
+    "COUNTRY_CODE",
+    "COUNTRY_CODE3",
+    "COUNTRY_NAME",
+    "COUNTRY_CONTINENT",
+    "REGION",
+    "CITY",
+    "POSTAL_CODE",
+    "LATITUDE",
+    "LONGITUDE",
+    "DMA_CODE",
+    "AREA_CODE"
+};
+
+}  // namespace
+
+
+void GeoLookup::want(const std::string &field) {
+    for (int i = 0; i < GEO_FIELDS; i++) {
+        if (strcasecmp(field.c_str(), fieldNames[i]) == 0) {
+            m_wanted.fetch_or(1u << i);
+            return;
+        }
+    }
+}
+
+
 bool GeoLookup::lookup(const std::string& target, Transaction *trans,
     std::function<bool(int, const std::string &)> debug) const {
+    unsigned char buffer[16];
+    const unsigned char *addr = buffer;
+    int family;
 
     if (m_version == NOT_LOADED) {
         if (debug) {
@@ -123,19 +163,111 @@ bool GeoLookup::lookup(const std::string& target, Transaction *trans,
         return false;
     }
 
+    if (trans && target == *trans->m_clientIpAddress) {
+        /* REMOTE_ADDR, maybe already parsed by @ipMatch */
+        if (trans->m_clientIpFamily == 0) {
+            trans->m_clientIpFamily = IpTree::parse(target,
+                trans->m_clientIpBinary);
+        }
+        family = trans->m_clientIpFamily;
+        addr = trans->m_clientIpBinary;
+    } else {
+        family = IpTree::parse(target, buffer);
+    }
+
+    unsigned int fields = m_wanted.load();
+    std::shared_ptr<const GeoRecord> record;
+    /* the client of an attached connection, looked up by an earlier request */
+    Connection *connection = trans && addr == trans->m_clientIpBinary
+        ? trans->m_connection : NULL;
+    if (connection != NULL) {
+        record = connection->geoRecord();
+        if (record && (record->looked & fields) != fields) {
+            record.reset();
+        }
+    }
+    if (record == nullptr && family != -1) {
+        record = m_cache.get(family, addr);
+        if (record && (record->looked & fields) != fields) {
+            /* rules asking for more were loaded since */
+            record.reset();
+        }
+        if (record && connection != NULL) {
+            connection->setGeoRecord(record);
+        }
+    }
+
+    if (record == nullptr) {
+        std::shared_ptr<GeoRecord> fresh = std::make_shared<GeoRecord>();
+        if (find(target, family, addr, fields, fresh.get(), debug) == false) {
+            return false;
+        }
+        if (family != -1) {
+            m_cache.put(family, addr, fresh);
+        }
+        if (family != -1 && connection != NULL) {
+            connection->setGeoRecord(fresh);
+        }
+        record = fresh;
+    }
+
+    if (record->found == false) {
+        return false;
+    }
+
+    if (trans) {
+        unsigned int present = record->present & fields;
+        for (int i = 0; present != 0; i++, present >>= 1) {
+            if (present & 1) {
+                trans->m_variableGeo.set(fieldNames[i], record->values[i], 0);
+            }
+        }
+    }
+
+    return true;
+}
+
+
+/**
+ * Reads what the database has on target into record, only the fields
+ * masked in fields when it is a MaxMind one. Returns false on errors,
+ * which are not cached; an address that is not in the database is not an
+ * error, the record is just not found.
+ *
+ */
+bool GeoLookup::find(const std::string &target, int family,
+    const unsigned char *addr, unsigned int fields, GeoRecord *record,
+    std::function<bool(int, const std::string &)> debug) const {
 #ifdef WITH_MAXMIND
     if (m_version == VERSION_MAXMIND) {
-        int gai_error, mmdb_error;
+        int mmdb_error;
         MMDB_lookup_result_s r;
 
-        r = MMDB_lookup_string(&mmdb, target.c_str(), &gai_error, &mmdb_error);
-
-        if (gai_error) {
-            if (debug) {
-                debug(4, "MaxMind: Error from getaddrinfo for: " +
-                    target + ". " + gai_strerror(gai_error));
+        if (family == AF_INET) {
+            struct sockaddr_in sa;
+            memset(&sa, 0, sizeof(sa));
+            sa.sin_family = AF_INET;
+            memcpy(&sa.sin_addr, addr, 4);
+            r = MMDB_lookup_sockaddr(&mmdb,
+                reinterpret_cast<struct sockaddr *>(&sa), &mmdb_error);
+        } else if (family == AF_INET6) {
+            struct sockaddr_in6 sa;
+            memset(&sa, 0, sizeof(sa));
+            sa.sin6_family = AF_INET6;
+            memcpy(&sa.sin6_addr, addr, 16);
+            r = MMDB_lookup_sockaddr(&mmdb,
+                reinterpret_cast<struct sockaddr *>(&sa), &mmdb_error);
+        } else {
+            int gai_error;
+            r = MMDB_lookup_string(&mmdb, target.c_str(), &gai_error,
+                &mmdb_error);
+            if (gai_error) {
+                if (debug) {
+                    debug(4, "MaxMind: Error from getaddrinfo for: " +
+                        target + ". " + gai_strerror(gai_error));
+                }
+                return false;
             }
-            return false;
         }
 
         if (mmdb_error != MMDB_SUCCESS) {
@@ -146,151 +278,138 @@ bool GeoLookup::lookup(const std::string& target, Transaction *trans,
             return false;
         }
 
+        record->looked = fields;
         if (!r.found_entry) {
-            return false;
-        } else {
-            MMDB_entry_data_s entry_data;
+            return true;
+        }
+        record->found = true;
+
+        MMDB_entry_data_s entry_data;
+        int status;
 
-            int status = MMDB_get_value(&r.entry, &entry_data,
+        if (fields & (1u << GEO_COUNTRY_CODE)) {
+            status = MMDB_get_value(&r.entry, &entry_data,
                 "country", "iso_code", NULL);
             if (status == MMDB_SUCCESS && entry_data.has_data) {
-                trans->m_variableGeo.set("COUNTRY_CODE",
+                record->set(GEO_COUNTRY_CODE,
                     std::string(entry_data.utf8_string,
-                        entry_data.data_size), 0);
+                        entry_data.data_size));
             }
+        }
 
+        if (fields & (1u << GEO_COUNTRY_NAME)) {
             status = MMDB_get_value(&r.entry, &entry_data,
                 "country", "names", "en", NULL);
             if (status == MMDB_SUCCESS && entry_data.has_data) {
-                trans->m_variableGeo.set("COUNTRY_NAME",
+                record->set(GEO_COUNTRY_NAME,
                     std::string(entry_data.utf8_string,
-                        entry_data.data_size), 0);
+                        entry_data.data_size));
             }
+        }
 
+        if (fields & (1u << GEO_COUNTRY_CONTINENT)) {
             status = MMDB_get_value(&r.entry, &entry_data,
                 "continent", "names", "en", NULL);
             if (status == MMDB_SUCCESS && entry_data.has_data) {
-                trans->m_variableGeo.set("COUNTRY_CONTINENT",
+                record->set(GEO_COUNTRY_CONTINENT,
                     std::string(entry_data.utf8_string,
-                        entry_data.data_size), 0);
+                        entry_data.data_size));
             }
+        }
 
+        if (fields & (1u << GEO_CITY)) {
             status = MMDB_get_value(&r.entry, &entry_data,
                 "city", "names", "en", NULL);
             if (status == MMDB_SUCCESS && entry_data.has_data) {
-                trans->m_variableGeo.set("CITY",
+                record->set(GEO_CITY,
                     std::string(entry_data.utf8_string,
-                        entry_data.data_size), 0);
+                        entry_data.data_size));
             }
+        }
 
+        if (fields & (1u << GEO_POSTAL_CODE)) {
             status = MMDB_get_value(&r.entry, &entry_data,
                 "postal", "code", NULL);
             if (status == MMDB_SUCCESS && entry_data.has_data) {
-                trans->m_variableGeo.set("POSTAL_CODE",
+                record->set(GEO_POSTAL_CODE,
                     std::string(entry_data.utf8_string,
-                        entry_data.data_size), 0);
+                        entry_data.data_size));
             }
+        }
 
+        if (fields & (1u << GEO_LATITUDE)) {
             status = MMDB_get_value(&r.entry, &entry_data,
                 "location", "latitude", NULL);
             if (status == MMDB_SUCCESS && entry_data.has_data) {
-                trans->m_variableGeo.set("LATITUDE",
-                    std::to_string(entry_data.double_value), 0);
+                record->set(GEO_LATITUDE,
+                    std::to_string(entry_data.double_value));
             }
+        }
 
+        if (fields & (1u << GEO_LONGITUDE)) {
             status = MMDB_get_value(&r.entry, &entry_data,
                 "location", "longitude", NULL);
             if (status == MMDB_SUCCESS && entry_data.has_data) {
-                trans->m_variableGeo.set("LONGITUDE",
-                    std::to_string(entry_data.double_value), 0);
-            }
-
-            /*
-            status = MMDB_get_value(&r.entry, &entry_data,
-                NULL);
-            if (status == MMDB_SUCCESS && entry_data.has_data) {
-                trans->m_variableGeo.set("COUNTRY_CODE3",
-                    std::string(entry_data.utf8_string), 0);
-            }
-
-            status = MMDB_get_value(&r.entry, &entry_data,
-                NULL);
-            if (status == MMDB_SUCCESS && entry_data.has_data) {
-                trans->m_variableGeo.set("REGION",
-                    std::string(entry_data.utf8_string), 0);
-            }
-
-            status = MMDB_get_value(&r.entry, &entry_data,
-                NULL);
-            if (status == MMDB_SUCCESS && entry_data.has_data) {
-                trans->m_variableGeo.set("DMA_CODE",
-                    std::string(entry_data.utf8_string), 0);
+                record->set(GEO_LONGITUDE,
+                    std::to_string(entry_data.double_value));
             }
-
-            status = MMDB_get_value(&r.entry, &entry_data,
-                NULL);
-            if (status == MMDB_SUCCESS && entry_data.has_data) {
-                trans->m_variableGeo.set("AREA_CODE",
-                    std::string(entry_data.utf8_string), 0);
-            }
-            */
         }
+
+        /*
+         * COUNTRY_CODE3, REGION, DMA_CODE and AREA_CODE have no
+         * counterpart in the MaxMind databases.
+         */
     }
 #endif
 
 #ifdef WITH_GEOIP
     if (m_version == VERSION_GEOIP) {
         GeoIPRecord *gir;
+
+        /* the whole record comes at once, no point in masking */
+        record->looked = (1u << GEO_FIELDS) - 1;
+
         gir = GeoIP_record_by_name(m_gi, target.c_str());
         if (gir == NULL) {
-            return false;
+            return true;
         }
+        record->found = true;
 
-        if (trans) {
-            if (gir->country_code) {
-                trans->m_variableGeo.set("COUNTRY_CODE",
-                    std::string(gir->country_code), 0);
-            }
-            if (gir->country_code3) {
-                trans->m_variableGeo.set("COUNTRY_CODE3",
-                    std::string(gir->country_code3), 0);
-            }
-            if (gir->country_name) {
-                trans->m_variableGeo.set("COUNTRY_NAME",
-                    std::string(gir->country_name), 0);
-            }
-            if (gir->continent_code) {
-                trans->m_variableGeo.set("COUNTRY_CONTINENT",
-                    std::string(gir->continent_code), 0);
-            }
-            if (gir->country_code && gir->region) {
-                trans->m_variableGeo.set("REGION",
-                    std::string(GeoIP_region_name_by_code(gir->country_code,
-                        gir->region)), 0);
-            }
-            if (gir->city) {
-                trans->m_variableGeo.set("CITY", std::string(gir->city), 0);
-            }
-            if (gir->postal_code) {
-                trans->m_variableGeo.set("POSTAL_CODE",
-                    std::string(gir->postal_code), 0);
-            }
-            if (gir->latitude) {
-                trans->m_variableGeo.set("LATITUDE",
-                    std::to_string(gir->latitude), 0);
-            }
-            if (gir->longitude) {
-                trans->m_variableGeo.set("LONGITUDE",
-                    std::to_string(gir->longitude), 0);
-            }
-            if (gir->metro_code) {
-                trans->m_variableGeo.set("DMA_CODE",
-                    std::to_string(gir->metro_code), 0);
-            }
-            if (gir->area_code) {
-                trans->m_variableGeo.set("AREA_CODE",
-                    std::to_string(gir->area_code), 0);
-            }
+        if (gir->country_code) {
+            record->set(GEO_COUNTRY_CODE, std::string(gir->country_code));
+        }
+        if (gir->country_code3) {
+            record->set(GEO_COUNTRY_CODE3, std::string(gir->country_code3));
+        }
+        if (gir->country_name) {
+            record->set(GEO_COUNTRY_NAME, std::string(gir->country_name));
+        }
+        if (gir->continent_code) {
+            record->set(GEO_COUNTRY_CONTINENT,
+                std::string(gir->continent_code));
+        }
+        if (gir->country_code && gir->region) {
+            record->set(GEO_REGION,
+                std::string(GeoIP_region_name_by_code(gir->country_code,
+                    gir->region)));
+        }
+        if (gir->city) {
+            record->set(GEO_CITY, std::string(gir->city));
+        }
+        if (gir->postal_code) {
+            record->set(GEO_POSTAL_CODE, std::string(gir->postal_code));
+        }
+        if (gir->latitude) {
+            record->set(GEO_LATITUDE, std::to_string(gir->latitude));
+        }
+        if (gir->longitude) {
+            record->set(GEO_LONGITUDE, std::to_string(gir->longitude));
+        }
+        if (gir->metro_code) {
+            record->set(GEO_DMA_CODE, std::to_string(gir->metro_code));
+        }
+        if (gir->area_code) {
+            record->set(GEO_AREA_CODE, std::to_string(gir->area_code));
         }
 
         GeoIPRecord_delete(gir);
@@ -301,7 +420,6 @@ bool GeoLookup::lookup(const std::string& target, Transaction *trans,
 }
 
 
-
 }  // namespace Utils
 }  // namespace modsecurity
 
@@ -13,10 +13,12 @@
  *
  */
 
+#include <atomic>
 #include <iostream>
 #include <fstream>
 #include <string>
 #include <functional>
+#include <memory>
 
 #if WITH_MAXMIND
 #include <maxminddb.h>
@@ -29,6 +31,7 @@
 #define SRC_UTILS_GEO_LOOKUP_H_
 
 #include "modsecurity/transaction.h"
+#include "src/utils/geo_cache.h"
 
 namespace modsecurity {
 namespace Utils {
@@ -39,6 +42,15 @@ enum GeoLookupVersion {
     VERSION_GEOIP,
 };
 
+/**
+ * Resolves the GEO collection of @geoLookup.
+ *
+ * What the database returns for an address is kept in a GeoCache. Only
+ * the fields the rules ask for (see want()) are read from the database
+ * and set into the transaction; a rule set that only looks at
+ * GEO:COUNTRY_CODE does not pay for the city names.
+ *
+ */
 class GeoLookup {
  public:
     static GeoLookup& getInstance() {
@@ -52,9 +64,19 @@ class GeoLookup {
     bool lookup(const std::string& target, Transaction *transaction,
         std::function<bool(int, const std::string &)> debug) const;
 
+    /*
+     * Called when a GEO variable is built: field is the element it
+     * refers to, wantAll() is for GEO as a whole or a regular expression
+     * on it. Fields are never forgotten, once asked for they are filled
+     * for every rule set of the process.
+     */
+    void want(const std::string &field);
+    void wantAll() { m_wanted.store((1u << GEO_FIELDS) - 1); }
+
  private:
     GeoLookup() :
-        m_version(NOT_LOADED)
+        m_version(NOT_LOADED),
+        m_wanted(0)
 #if WITH_GEOIP
         ,m_gi(NULL)
 #endif
@@ -63,7 +85,13 @@ class GeoLookup {
     GeoLookup(GeoLookup const&);
     void operator=(GeoLookup const&);
 
+    bool find(const std::string &target, int family,
+        const unsigned char *addr, unsigned int fields, GeoRecord *record,
+        std::function<bool(int, const std::string &)> debug) const;
+
     GeoLookupVersion m_version;
+    std::atomic<unsigned int> m_wanted;
+    mutable GeoCache m_cache;
 #if WITH_MAXMIND
     MMDB_s mmdb;
 #endif
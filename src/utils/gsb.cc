@@ -0,0 +1,918 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/gsb.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <stdlib.h>
+#include <sys/file.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef WITH_YAJL
+#include <yajl/yajl_tree.h>
+#endif
+
+#include "modsecurity/modsecurity.h"
+#include "src/utils/base64.h"
+#include "src/utils/https_client.h"
+#include "src/utils/sha256.h"
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+namespace {
+
+const char kMagic[] = "MSCGSB 1";
+const char kUpdateUrl[] =
+    "https://safebrowsing.googleapis.com/v4/threatListUpdates:fetch?key=";
+const char kFindUrl[] =
+    "https://safebrowsing.googleapis.com/v4/fullHashes:find?key=";
+
+const char *const kThreatTypes[] = {
+    "MALWARE",
+    "SOCIAL_ENGINEERING",
+    "UNWANTED_SOFTWARE",
+    NULL
+};
+
+/* when the server does not say, and after a failed update */
+const unsigned int kDefaultWaitSeconds = 1800;
+const unsigned int kRetrySeconds = 900;
+
+/* prefixes with a full hash answer kept, before starting over */
+const size_t kMaxCachedPrefixes = 65536;
+
+
+uint32_t headOf(const std::string &prefix) {
+    const unsigned char *p =
+        reinterpret_cast<const unsigned char *>(prefix.data());
+    return (static_cast<uint32_t>(p[0]) << 24)
+        | (static_cast<uint32_t>(p[1]) << 16)
+        | (static_cast<uint32_t>(p[2]) << 8)
+        | static_cast<uint32_t>(p[3]);
+}
+
+
+int fromHex(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+
+std::string unescape(const std::string &s) {
+    std::string out;
+
+    out.reserve(s.size());
+    for (size_t i = 0; i < s.size(); i++) {
+        int hi, lo;
+        if (s[i] == '%' && i + 2 < s.size()
+            && (hi = fromHex(s[i + 1])) >= 0
+            && (lo = fromHex(s[i + 2])) >= 0) {
+            out.push_back(static_cast<char>(hi * 16 + lo));
+            i += 2;
+            continue;
+        }
+        out.push_back(s[i]);
+    }
+
+    return out;
+}
+
+
+std::string escape(const std::string &s) {
+    static const char *const lut = "0123456789ABCDEF";
+    std::string out;
+
+    for (char ch : s) {
+        unsigned char c = static_cast<unsigned char>(ch);
+        if (c <= 0x20 || c >= 0x7f || c == '#' || c == '%') {
+            out.push_back('%');
+            out.push_back(lut[c >> 4]);
+            out.push_back(lut[c & 15]);
+        } else {
+            out.push_back(ch);
+        }
+    }
+
+    return out;
+}
+
+
+/* /a/./b/../c//d -> /a/c/d */
+std::string resolvePath(const std::string &path) {
+    std::vector<std::string> segments;
+    bool directory = path.empty() || path.back() == '/';
+    size_t i = 0;
+
+    while (i < path.size()) {
+        size_t end = path.find('/', i);
+        if (end == std::string::npos) {
+            end = path.size();
+        }
+        std::string segment(path, i, end - i);
+        i = end + 1;
+        if (segment.empty()) {
+            continue;
+        }
+        if (segment == "." || segment == "..") {
+            if (segment == ".." && segments.empty() == false) {
+                segments.pop_back();
+            }
+            directory = directory || end == path.size();
+            continue;
+        }
+        segments.push_back(segment);
+    }
+
+    std::string out("/");
+    for (size_t j = 0; j < segments.size(); j++) {
+        out.append(segments[j]);
+        if (j + 1 < segments.size() || directory) {
+            out.push_back('/');
+        }
+    }
+
+    return out;
+}
+
+
+std::string resolveHost(std::string host) {
+    std::string out;
+    struct in_addr addr;
+
+    std::transform(host.begin(), host.end(), host.begin(), ::tolower);
+    for (char c : host) {
+        if (c == '.' && (out.empty() || out.back() == '.')) {
+            continue;
+        }
+        out.push_back(c);
+    }
+    while (out.empty() == false && out.back() == '.') {
+        out.pop_back();
+    }
+
+    /* 3279880203, 0x12.0x43.0x44.0x01, 012.034.01.055... */
+    if (out.empty() == false
+        && out.find_first_not_of("0123456789abcdefx.") == std::string::npos
+        && inet_aton(out.c_str(), &addr) != 0) {
+        char buf[INET_ADDRSTRLEN];
+        if (inet_ntop(AF_INET, &addr, buf, sizeof(buf)) != NULL) {
+            out = buf;
+        }
+    }
+
+    return out;
+}
+
+
+bool isAddress(const std::string &host) {
+    struct in_addr addr;
+    return inet_pton(AF_INET, host.c_str(), &addr) == 1;
+}
+
+
+#ifdef WITH_YAJL
+yajl_val member(yajl_val v, const char *name, const char *name2,
+    yajl_type type) {
+    const char *path[] = { name, name2, NULL };
+    return yajl_tree_get(v, path, type);
+}
+
+
+std::string stringOf(yajl_val v) {
+    const char *s = YAJL_GET_STRING(v);
+    return s != NULL ? s : "";
+}
+
+
+/* "593.440s" */
+unsigned int secondsOf(const std::string &duration, unsigned int otherwise) {
+    if (duration.empty()) {
+        return otherwise;
+    }
+    double seconds = strtod(duration.c_str(), NULL);
+    if (seconds <= 0) {
+        return otherwise;
+    }
+    return static_cast<unsigned int>(std::ceil(seconds));
+}
+
+
+std::string clientOf() {
+    return "\"client\":{\"clientId\":\"modsecurity\",\"clientVersion\":\""
+        MODSECURITY_VERSION "\"}";
+}
+
+
+std::string threatTypesOf() {
+    std::string out;
+    for (int i = 0; kThreatTypes[i] != NULL; i++) {
+        out.append(std::string(i ? "," : "") + "\"" + kThreatTypes[i] + "\"");
+    }
+    return out;
+}
+#endif
+
+}  // namespace
+
+
+Gsb::Gsb()
+    : m_configured(false),
+    m_running(false) {
+    pthread_mutex_init(&m_lock, NULL);
+    pthread_atfork(NULL, NULL, childFork);
+}
+
+
+bool Gsb::configure(const std::string &file, const std::string &apiKey,
+    std::string *error) {
+    std::vector<List> lists;
+    int64_t next = 0;
+
+#ifndef WITH_YAJL
+    if (apiKey.empty() == false) {
+        error->assign("Updating the lists needs ModSecurity built with " \
+            "YAJL, only SecGsbLookupDb file is supported");
+        return false;
+    }
+#endif
+
+    pthread_mutex_lock(&m_lock);
+    m_file = file;
+    m_apiKey = apiKey;
+    bool loaded = load(&lists, &next);
+    pthread_mutex_unlock(&m_lock);
+
+    if (loaded == false && apiKey.empty()) {
+        error->assign("Failed to load the Safe Browsing lists from: " + file);
+        return false;
+    }
+    if (apiKey.empty() == false) {
+        size_t slash = file.rfind('/');
+        std::string directory(slash == std::string::npos ? "."
+            : file.substr(0, slash + 1));
+        if (access(directory.c_str(), W_OK) != 0) {
+            error->assign("Not able to write the Safe Browsing lists to: "
+                + file);
+            return false;
+        }
+    }
+
+    pthread_mutex_lock(&m_lock);
+    if (loaded) {
+        publish(lists);
+    }
+    m_fullHashes.clear();
+    pthread_mutex_unlock(&m_lock);
+
+    m_configured = true;
+    start();
+
+    return true;
+}
+
+
+bool Gsb::lookup(const std::string &url, std::string *threat) {
+    if (m_running.load(std::memory_order_relaxed) == false) {
+        start();
+    }
+
+    std::shared_ptr<const Heads> heads = m_heads.get();
+    if (heads == nullptr || heads->m_heads.empty()) {
+        return false;
+    }
+
+    for (const std::string &e : expressionsOf(canonicalize(url))) {
+        std::string hash(Sha256::digest(e));
+        if (contains(heads->m_heads, headOf(hash)) == false) {
+            continue;
+        }
+        if (m_apiKey.empty()) {
+            threat->clear();
+            return true;
+        }
+        if (confirm(hash, threat)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+std::string Gsb::canonicalize(const std::string &url) {
+    std::string s;
+
+    for (char c : url) {
+        if (c != '\t' && c != '\r' && c != '\n') {
+            s.push_back(c);
+        }
+    }
+    size_t begin = 0;
+    while (begin < s.size() && static_cast<unsigned char>(s[begin]) <= 0x20) {
+        begin++;
+    }
+    size_t end = s.size();
+    while (end > begin && static_cast<unsigned char>(s[end - 1]) <= 0x20) {
+        end--;
+    }
+    s = s.substr(begin, end - begin);
+    s = s.substr(0, s.find('#'));
+
+    /* until there is nothing left to unescape, a bound for the loops */
+    for (int i = 0; i < 64; i++) {
+        std::string u(unescape(s));
+        if (u == s) {
+            break;
+        }
+        s.swap(u);
+    }
+
+    size_t scheme = s.find("://");
+    if (scheme != std::string::npos && scheme > 0
+        && s.find_first_of("/?", 0) > scheme) {
+        s = s.substr(scheme + 3);
+    }
+
+    size_t hostEnd = s.find_first_of("/?");
+    std::string host(s, 0, hostEnd);
+    std::string rest(hostEnd == std::string::npos ? "/" : s.substr(hostEnd));
+    if (rest[0] == '?') {
+        rest.insert(0, "/");
+    }
+
+    size_t at = host.rfind('@');
+    if (at != std::string::npos) {
+        host = host.substr(at + 1);
+    }
+    size_t colon = host.rfind(':');
+    if (colon != std::string::npos) {
+        host = host.substr(0, colon);
+    }
+
+    size_t query = rest.find('?');
+    std::string path(rest, 0, query);
+    std::string q(query == std::string::npos ? "" : rest.substr(query));
+
+    return escape(resolveHost(host) + resolvePath(path) + q);
+}
+
+
+/*
+ * a.b.c/1/2.html?param=1: a.b.c/1/2.html?param=1, a.b.c/1/2.html,
+ * a.b.c/, a.b.c/1/ and the same for b.c.
+ */
+std::vector<std::string> Gsb::expressionsOf(const std::string &canonical) {
+    std::vector<std::string> hosts;
+    std::vector<std::string> paths;
+    std::vector<std::string> expressions;
+    size_t slash = canonical.find('/');
+    std::string host(canonical, 0, slash);
+    std::string rest(slash == std::string::npos ? "/"
+        : canonical.substr(slash));
+
+    hosts.push_back(host);
+    if (isAddress(host) == false) {
+        std::vector<size_t> dots;
+        for (size_t i = 0; i < host.size(); i++) {
+            if (host[i] == '.') {
+                dots.push_back(i);
+            }
+        }
+        /* the last 5 components at most, and 2 at least */
+        size_t n = dots.size() + 1;
+        for (size_t i = n > 5 ? n - 5 : 1; i + 1 < n; i++) {
+            hosts.push_back(host.substr(dots[i - 1] + 1));
+        }
+    }
+
+    size_t query = rest.find('?');
+    std::string path(rest, 0, query);
+    if (query != std::string::npos) {
+        paths.push_back(rest);
+    }
+    paths.push_back(path);
+    for (size_t i = 0, n = 0; i < path.size() && n < 4; i++) {
+        if (path[i] != '/') {
+            continue;
+        }
+        n++;
+        std::string prefix(path, 0, i + 1);
+        if (prefix != path) {
+            paths.push_back(prefix);
+        }
+    }
+
+    for (const std::string &h : hosts) {
+        for (const std::string &p : paths) {
+            std::string e(h + p);
+            if (std::find(expressions.begin(), expressions.end(), e)
+                == expressions.end()) {
+                expressions.push_back(e);
+            }
+        }
+    }
+
+    return expressions;
+}
+
+
+/*
+ * Interpolation search: the hashes being evenly spread, it gets there in
+ * a couple of probes; if they happen not to be, binary search takes over.
+ */
+bool Gsb::contains(const std::vector<uint32_t> &heads, uint32_t head) {
+    size_t lo = 0;
+    size_t hi = heads.size();
+
+    for (int probes = 0; lo < hi && probes < 8; probes++) {
+        uint32_t first = heads[lo];
+        uint32_t last = heads[hi - 1];
+        if (head < first || head > last) {
+            return false;
+        }
+        size_t mid = lo;
+        if (last != first) {
+            mid = lo + static_cast<size_t>(
+                static_cast<uint64_t>(head - first) * (hi - 1 - lo)
+                / (last - first));
+        }
+        if (heads[mid] == head) {
+            return true;
+        }
+        if (heads[mid] < head) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return std::binary_search(heads.begin() + lo, heads.begin() + hi, head);
+}
+
+
+std::string Gsb::checksumOf(const std::vector<std::string> &prefixes) {
+    std::string all;
+
+    for (const std::string &p : prefixes) {
+        all.append(p);
+    }
+    return Sha256::digest(all);
+}
+
+
+void Gsb::apply(List *list, bool full, const std::vector<size_t> &removals,
+    const std::vector<std::string> &additions, const std::string &state,
+    const std::string &checksum) {
+    std::vector<std::string> prefixes;
+
+    if (full == false) {
+        std::vector<bool> removed(list->m_prefixes.size(), false);
+        for (size_t i : removals) {
+            if (i < removed.size()) {
+                removed[i] = true;
+            }
+        }
+        for (size_t i = 0; i < list->m_prefixes.size(); i++) {
+            if (removed[i] == false) {
+                prefixes.push_back(std::move(list->m_prefixes[i]));
+            }
+        }
+    }
+    prefixes.insert(prefixes.end(), additions.begin(), additions.end());
+    std::sort(prefixes.begin(), prefixes.end());
+
+    if (checksum.empty() == false && checksumOf(prefixes) != checksum) {
+        /* out of sync, the next update is a full one */
+        list->m_prefixes.clear();
+        list->m_state.clear();
+        return;
+    }
+
+    list->m_prefixes = std::move(prefixes);
+    list->m_state = state;
+}
+
+
+/*
+ * "MSCGSB 1", the time of the next update and the number of lists, then
+ * for each its threat type, client state and number of prefixes, a line,
+ * and the prefixes, each a byte of length and the bytes.
+ */
+bool Gsb::load(std::vector<List> *lists, int64_t *next) {
+    std::ifstream in(m_file, std::ios::binary);
+    std::string line;
+    size_t n = 0;
+
+    if (in.is_open() == false || !std::getline(in, line) || line != kMagic
+        || !std::getline(in, line)) {
+        return false;
+    }
+    *next = strtoll(line.c_str(), NULL, 10);
+    if (!std::getline(in, line)) {
+        return false;
+    }
+    n = strtoul(line.c_str(), NULL, 10);
+
+    for (size_t i = 0; i < n; i++) {
+        List list;
+        size_t count = 0;
+        if (!std::getline(in, line)) {
+            return false;
+        }
+        std::istringstream fields(line);
+        if (!(fields >> list.m_threatType >> list.m_state >> count)) {
+            return false;
+        }
+        if (list.m_state == "-") {
+            list.m_state.clear();
+        }
+        list.m_prefixes.reserve(count);
+        for (size_t j = 0; j < count; j++) {
+            int size = in.get();
+            if (size <= 0) {
+                return false;
+            }
+            std::string prefix(size, '\0');
+            if (!in.read(&prefix[0], size)) {
+                return false;
+            }
+            list.m_prefixes.push_back(std::move(prefix));
+        }
+        lists->push_back(std::move(list));
+    }
+
+    return true;
+}
+
+
+bool Gsb::save(const std::vector<List> &lists, int64_t next) {
+    std::string tmp(m_file + ".tmp");
+    std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+
+    if (out.is_open() == false) {
+        return false;
+    }
+    out << kMagic << "\n" << next << "\n" << lists.size() << "\n";
+    for (const List &list : lists) {
+        out << list.m_threatType << " "
+            << (list.m_state.empty() ? "-" : list.m_state) << " "
+            << list.m_prefixes.size() << "\n";
+        for (const std::string &p : list.m_prefixes) {
+            out.put(static_cast<char>(p.size()));
+            out.write(p.data(), p.size());
+        }
+    }
+    out.close();
+    if (!out || rename(tmp.c_str(), m_file.c_str()) != 0) {
+        unlink(tmp.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+
+/* Called with m_lock held. */
+void Gsb::publish(const std::vector<List> &lists) {
+    std::unique_ptr<Heads> heads(new Heads());
+
+    m_states.clear();
+    for (const List &list : lists) {
+        m_states.push_back(list.m_state);
+        for (const std::string &p : list.m_prefixes) {
+            if (p.size() >= 4) {
+                heads->m_heads.push_back(headOf(p));
+            }
+        }
+    }
+    std::sort(heads->m_heads.begin(), heads->m_heads.end());
+    heads->m_heads.erase(std::unique(heads->m_heads.begin(),
+        heads->m_heads.end()), heads->m_heads.end());
+
+    m_heads.publish(heads.release());
+}
+
+
+#ifdef WITH_YAJL
+bool Gsb::fetchUpdate(std::vector<List> *lists, unsigned int *wait) {
+    HttpsClient client;
+    std::string body("{" + clientOf() + ",\"listUpdateRequests\":[");
+    char error[256];
+
+    for (size_t i = 0; i < lists->size(); i++) {
+        body.append(std::string(i ? "," : "") + "{\"threatType\":\""
+            + (*lists)[i].m_threatType + "\",\"platformType\":" \
+            "\"ANY_PLATFORM\",\"threatEntryType\":\"URL\",\"state\":\""
+            + (*lists)[i].m_state + "\",\"constraints\":" \
+            "{\"supportedCompressions\":[\"RAW\"]}}");
+    }
+    body.append("]}");
+
+    client.setRequestType("application/json");
+    client.setRequestBody(body);
+    if (client.download(kUpdateUrl + m_apiKey) == false) {
+        return false;
+    }
+
+    yajl_val root = yajl_tree_parse(client.content.c_str(), error,
+        sizeof(error));
+    if (root == NULL) {
+        return false;
+    }
+
+    yajl_val responses = member(root, "listUpdateResponses", NULL,
+        yajl_t_array);
+    for (size_t i = 0; responses && i < responses->u.array.len; i++) {
+        yajl_val r = responses->u.array.values[i];
+        std::string type(stringOf(member(r, "threatType", NULL,
+            yajl_t_string)));
+        auto list = std::find_if(lists->begin(), lists->end(),
+            [&type](const List &l) { return l.m_threatType == type; });
+        if (list == lists->end()) {
+            continue;
+        }
+
+        std::vector<size_t> removals;
+        yajl_val removed = member(r, "removals", NULL, yajl_t_array);
+        for (size_t j = 0; removed && j < removed->u.array.len; j++) {
+            yajl_val indices = member(removed->u.array.values[j],
+                "rawIndices", "indices", yajl_t_array);
+            for (size_t k = 0; indices && k < indices->u.array.len; k++) {
+                yajl_val index = indices->u.array.values[k];
+                if (YAJL_IS_INTEGER(index) && YAJL_GET_INTEGER(index) >= 0) {
+                    removals.push_back(YAJL_GET_INTEGER(index));
+                }
+            }
+        }
+
+        std::vector<std::string> additions;
+        yajl_val added = member(r, "additions", NULL, yajl_t_array);
+        for (size_t j = 0; added && j < added->u.array.len; j++) {
+            yajl_val a = added->u.array.values[j];
+            yajl_val size = member(a, "rawHashes", "prefixSize",
+                yajl_t_number);
+            std::string raw(Base64::decode(stringOf(member(a, "rawHashes",
+                "rawHashes", yajl_t_string))));
+            if (YAJL_IS_INTEGER(size) == false) {
+                continue;
+            }
+            size_t n = YAJL_GET_INTEGER(size);
+            if (n < 4 || n > 32) {
+                continue;
+            }
+            for (size_t k = 0; k + n <= raw.size(); k += n) {
+                additions.push_back(raw.substr(k, n));
+            }
+        }
+
+        apply(&*list, stringOf(member(r, "responseType", NULL,
+            yajl_t_string)) == "FULL_UPDATE", removals, additions,
+            stringOf(member(r, "newClientState", NULL, yajl_t_string)),
+            Base64::decode(stringOf(member(r, "checksum", "sha256",
+            yajl_t_string))));
+    }
+
+    *wait = secondsOf(stringOf(member(root, "minimumWaitDuration", NULL,
+        yajl_t_string)), kDefaultWaitSeconds);
+    yajl_tree_free(root);
+
+    return true;
+}
+
+
+bool Gsb::fetchFullHashes(const std::string &prefix, FullHashes *found) {
+    HttpsClient client;
+    std::string states;
+    char error[256];
+    int64_t now = time(NULL);
+
+    pthread_mutex_lock(&m_lock);
+    for (size_t i = 0; i < m_states.size(); i++) {
+        states.append(std::string(i ? "," : "") + "\"" + m_states[i] + "\"");
+    }
+    pthread_mutex_unlock(&m_lock);
+
+    client.setRequestType("application/json");
+    client.setRequestBody("{" + clientOf() + ",\"clientStates\":[" + states
+        + "],\"threatInfo\":{\"threatTypes\":[" + threatTypesOf()
+        + "],\"platformTypes\":[\"ANY_PLATFORM\"],\"threatEntryTypes\":" \
+        "[\"URL\"],\"threatEntries\":[{\"hash\":\"" + Base64::encode(prefix)
+        + "\"}]}}");
+    if (client.download(kFindUrl + m_apiKey) == false) {
+        return false;
+    }
+
+    yajl_val root = yajl_tree_parse(client.content.c_str(), error,
+        sizeof(error));
+    if (root == NULL) {
+        return false;
+    }
+
+    yajl_val matches = member(root, "matches", NULL, yajl_t_array);
+    for (size_t i = 0; matches && i < matches->u.array.len; i++) {
+        yajl_val m = matches->u.array.values[i];
+        Match match;
+        match.m_hash = Base64::decode(stringOf(member(m, "threat", "hash",
+            yajl_t_string)));
+        match.m_threatType = stringOf(member(m, "threatType", NULL,
+            yajl_t_string));
+        match.m_expires = now + secondsOf(stringOf(member(m,
+            "cacheDuration", NULL, yajl_t_string)), 300);
+        found->m_matches.push_back(std::move(match));
+    }
+    found->m_negativeUntil = now + secondsOf(stringOf(member(root,
+        "negativeCacheDuration", NULL, yajl_t_string)), 300);
+    yajl_tree_free(root);
+
+    return true;
+}
+#else
+bool Gsb::fetchUpdate(std::vector<List> *lists, unsigned int *wait) {
+    return false;
+}
+
+
+bool Gsb::fetchFullHashes(const std::string &prefix, FullHashes *found) {
+    return false;
+}
+#endif
+
+
+/*
+ * The full hash is the say of the server. When it can not be asked the
+ * URL is not taken as listed: a network failure does not block traffic.
+ */
+bool Gsb::confirm(const std::string &hash, std::string *threat) {
+    std::string prefix(hash, 0, 4);
+    int64_t now = time(NULL);
+    FullHashes found;
+    bool cached = false;
+
+    pthread_mutex_lock(&m_lock);
+    auto it = m_fullHashes.find(prefix);
+    if (it != m_fullHashes.end()) {
+        found = it->second;
+        cached = true;
+    }
+    pthread_mutex_unlock(&m_lock);
+
+    for (const Match &m : found.m_matches) {
+        if (m.m_hash == hash && m.m_expires > now) {
+            *threat = m.m_threatType;
+            return true;
+        }
+    }
+    if (cached && found.m_negativeUntil > now) {
+        return false;
+    }
+
+    found = FullHashes();
+    if (fetchFullHashes(prefix, &found) == false) {
+        return false;
+    }
+    pthread_mutex_lock(&m_lock);
+    if (m_fullHashes.size() >= kMaxCachedPrefixes) {
+        m_fullHashes.clear();
+    }
+    m_fullHashes[prefix] = found;
+    pthread_mutex_unlock(&m_lock);
+
+    for (const Match &m : found.m_matches) {
+        if (m.m_hash == hash) {
+            *threat = m.m_threatType;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+void Gsb::start() {
+    pthread_mutex_lock(&m_lock);
+    if (m_running == false && m_configured) {
+        pthread_t thread;
+        if (m_apiKey.empty()) {
+            m_running = true;
+        } else if (pthread_create(&thread, NULL, run, this) == 0) {
+            pthread_detach(thread);
+            m_running = true;
+        }
+    }
+    pthread_mutex_unlock(&m_lock);
+}
+
+
+/*
+ * The lock on the file has the processes of the host wait for the one
+ * updating; whoever comes after finds the update done, until it is due
+ * again.
+ */
+unsigned int Gsb::update() {
+    std::vector<List> lists;
+    int64_t next = 0;
+    int64_t now = time(NULL);
+
+    pthread_mutex_lock(&m_lock);
+    std::string file(m_file);
+    pthread_mutex_unlock(&m_lock);
+
+    int fd = open((file + ".lock").c_str(), O_RDWR | O_CREAT, 0600);
+    while (fd >= 0 && flock(fd, LOCK_EX) != 0 && errno == EINTR) { }
+
+    pthread_mutex_lock(&m_lock);
+    if (load(&lists, &next) == false) {
+        lists.clear();
+        next = 0;
+    }
+    pthread_mutex_unlock(&m_lock);
+    for (int i = 0; kThreatTypes[i] != NULL; i++) {
+        if (std::find_if(lists.begin(), lists.end(), [i](const List &l) {
+            return l.m_threatType == kThreatTypes[i]; }) == lists.end()) {
+            List list;
+            list.m_threatType = kThreatTypes[i];
+            lists.push_back(std::move(list));
+        }
+    }
+
+    if (next <= now) {
+        unsigned int wait = kRetrySeconds;
+        if (fetchUpdate(&lists, &wait) == false) {
+            wait = kRetrySeconds;
+        }
+        next = now + wait;
+        pthread_mutex_lock(&m_lock);
+        save(lists, next);
+        pthread_mutex_unlock(&m_lock);
+    }
+
+    if (fd >= 0) {
+        flock(fd, LOCK_UN);
+        close(fd);
+    }
+
+    pthread_mutex_lock(&m_lock);
+    publish(lists);
+    pthread_mutex_unlock(&m_lock);
+
+    return next - now > 0 ? next - now : 1;
+}
+
+
+void *Gsb::run(void *data) {
+    Gsb *gsb = static_cast<Gsb *>(data);
+
+    for (;;) {
+        sleep(gsb->update());
+    }
+
+    return NULL;
+}
+
+
+/* The updater of the parent does not make it to the child. */
+void Gsb::childFork() {
+    Gsb &gsb = getInstance();
+
+    pthread_mutex_init(&gsb.m_lock, NULL);
+    gsb.m_running = false;
+}
+
+
+}  // namespace Utils
+}  // namespace modsecurity
@@ -0,0 +1,140 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <pthread.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include <atomic>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "src/utils/reloader.h"
+
+#ifndef SRC_UTILS_GSB_H_
+#define SRC_UTILS_GSB_H_
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+/**
+ * Local copy of the Google Safe Browsing lists (Update API v4), for
+ * @gsbLookup: SecGsbLookupDb file [api_key].
+ *
+ * What the lists hold are the first bytes (4 mostly, 32 at most) of the
+ * SHA-256 of URL expressions. Lookups only see the first 4 bytes of each,
+ * kept in a sorted array and searched by interpolation, the hashes being
+ * evenly spread. No lock, no network: most URLs are not in there.
+ *
+ * With an API key the lists are kept up to date by a thread of their own,
+ * at the pace the server asks for, and written to file, together with
+ * the time of the next update. The processes of the host take turns on
+ * the file: the one that finds it due fetches the update, the others
+ * read what it wrote. A hit is then confirmed with the full hash from
+ * the server (fullHashes:find), and the answer kept for as long as the
+ * server says it may be. Without a key the file is taken as it is, kept
+ * up to date by someone else, and a prefix hit is a match.
+ *
+ */
+class Gsb {
+ public:
+    static Gsb &getInstance() {
+        static Gsb *instance = new Gsb();
+        return *instance;
+    }
+
+    bool configure(const std::string &file, const std::string &apiKey,
+        std::string *error);
+    bool configured() const { return m_configured.load(); }
+
+    /**
+     * Whether url is in one of the lists; threat is the name of the list
+     * (empty if there is no API key to tell).
+     */
+    bool lookup(const std::string &url, std::string *threat);
+
+    /* As the Safe Browsing documentation has it, without the scheme. */
+    static std::string canonicalize(const std::string &url);
+    /* The host suffix / path prefix combinations that get hashed. */
+    static std::vector<std::string> expressionsOf(
+        const std::string &canonical);
+
+ private:
+    struct List {
+        std::string m_threatType;
+        std::string m_state;
+        /* sorted, as the indices of the removals refer to them */
+        std::vector<std::string> m_prefixes;
+    };
+
+    struct Heads {
+        std::vector<uint32_t> m_heads;
+    };
+
+    struct Match {
+        std::string m_hash;
+        std::string m_threatType;
+        int64_t m_expires;
+    };
+
+    struct FullHashes {
+        FullHashes() : m_negativeUntil(0) { }
+        std::vector<Match> m_matches;
+        int64_t m_negativeUntil;
+    };
+
+    Gsb();
+
+    static bool contains(const std::vector<uint32_t> &heads, uint32_t head);
+    static std::string checksumOf(const std::vector<std::string> &prefixes);
+    static void apply(List *list, bool full,
+        const std::vector<size_t> &removals,
+        const std::vector<std::string> &additions,
+        const std::string &state, const std::string &checksum);
+
+    bool load(std::vector<List> *lists, int64_t *next);
+    bool save(const std::vector<List> &lists, int64_t next);
+    void publish(const std::vector<List> &lists);
+
+    bool fetchUpdate(std::vector<List> *lists, unsigned int *wait);
+    bool fetchFullHashes(const std::string &prefix, FullHashes *found);
+    bool confirm(const std::string &hash, std::string *threat);
+
+    void start();
+    unsigned int update();
+    static void *run(void *data);
+    static void childFork();
+
+    std::string m_file;
+    std::string m_apiKey;
+    std::atomic<bool> m_configured;
+    std::atomic<bool> m_running;
+    pthread_mutex_t m_lock;
+    Versioned<Heads> m_heads;
+    /* of the lists, that fullHashes:find wants to know */
+    std::vector<std::string> m_states;
+    /* by the 4 byte prefix of what was asked for */
+    std::unordered_map<std::string, FullHashes> m_fullHashes;
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_GSB_H_
@@ -20,22 +20,103 @@
 #include <curl/curl.h>
 #endif
 
+#include <pthread.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
+#include <time.h>
 #include <string>
+#include <utility>
 
 #include <fstream>
 #include <iostream>
 
 #include "modsecurity/modsecurity.h"
 #include "src/unique_id.h"
+#include "src/utils/string.h"
 
 namespace modsecurity {
 namespace Utils {
 
 
+#ifdef MSC_WITH_CURL
+namespace {
+
+/*
+ * What the downloads of the process have in common: the DNS cache, the
+ * TLS sessions and, with libcurl 7.57 or later, the connections. A client
+ * gets a connection that an earlier download (of any thread) left open,
+ * instead of going through the TCP and TLS handshakes again.
+ *
+ * A child of fork() must not use the connections of its parent: it gets
+ * a share of its own, the one of the parent is left alone.
+ */
+class Share {
+ public:
+    static Share &getInstance() {
+        static Share *instance = new Share();
+        return *instance;
+    }
+
+    CURLSH *handle() const { return m_handle; }
+
+ private:
+    Share() : m_handle(NULL) {
+        start();
+        pthread_atfork(NULL, NULL, childFork);
+    }
+
+    void start() {
+        for (pthread_mutex_t &lock : m_locks) {
+            pthread_mutex_init(&lock, NULL);
+        }
+        m_handle = curl_share_init();
+        if (m_handle == NULL) {
+            return;
+        }
+        curl_share_setopt(m_handle, CURLSHOPT_LOCKFUNC, &Share::lock);
+        curl_share_setopt(m_handle, CURLSHOPT_UNLOCKFUNC, &Share::unlock);
+        curl_share_setopt(m_handle, CURLSHOPT_USERDATA, this);
+        curl_share_setopt(m_handle, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(m_handle, CURLSHOPT_SHARE,
+            CURL_LOCK_DATA_SSL_SESSION);
+#if LIBCURL_VERSION_NUM >= 0x073900
+        curl_share_setopt(m_handle, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+#endif
+    }
+
+    static void childFork() {
+        getInstance().start();
+    }
+
+    static void lock(CURL *curl, curl_lock_data data,
+        curl_lock_access access, void *p) {
+        pthread_mutex_lock(&static_cast<Share *>(p)->m_locks[data]);
+    }
+
+    static void unlock(CURL *curl, curl_lock_data data, void *p) {
+        pthread_mutex_unlock(&static_cast<Share *>(p)->m_locks[data]);
+    }
+
+    CURLSH *m_handle;
+    pthread_mutex_t m_locks[CURL_LOCK_DATA_LAST];
+};
+
+}  // namespace
+#endif
+
+
+HttpsClient::~HttpsClient() {
+#ifdef MSC_WITH_CURL
+    if (m_handle != NULL) {
+        curl_easy_cleanup(static_cast<CURL *>(m_handle));
+        m_handle = NULL;
+    }
+#endif
+}
+
+
 size_t HttpsClient::handle(char * data, size_t size, size_t nmemb, void * p) {
     return static_cast<HttpsClient*>(p)->handle_impl(data, size, nmemb);
 }
@@ -46,6 +127,38 @@ size_t HttpsClient::handle_impl(char* data, size_t size, size_t nmemb) {
     return size * nmemb;
 }
 
+
+size_t HttpsClient::handleHeader(char *data, size_t size, size_t nmemb,
+    void *p) {
+    return static_cast<HttpsClient*>(p)->handleHeaderImpl(data, size, nmemb);
+}
+
+
+/* Keeps the validators, for DownloadCache to revalidate with. */
+size_t HttpsClient::handleHeaderImpl(char *data, size_t size, size_t nmemb) {
+    std::string line(data, size * nmemb);
+    size_t colon = line.find(':');
+
+    if (colon == std::string::npos) {
+        return size * nmemb;
+    }
+    std::string name(utils::string::tolower(line.substr(0, colon)));
+    size_t begin = line.find_first_not_of(" \t", colon + 1);
+    size_t end = line.find_last_not_of(" \t\r\n");
+    std::string value;
+    if (begin != std::string::npos && end >= begin) {
+        value = line.substr(begin, end - begin + 1);
+    }
+
+    if (name == "etag") {
+        m_etag = value;
+    } else if (name == "last-modified") {
+        m_lastModified = value;
+    }
+
+    return size * nmemb;
+}
+
 void HttpsClient::setKey(const std::string& key) {
     m_key = "ModSec-key: " + key;
 }
@@ -58,15 +171,80 @@ void HttpsClient::setRequestType(const std::string& requestType) {
     m_requestType = requestType;
 }
 
+/*
+ * When set, the CURL handle survives the download, and so does its
+ * connection cache: subsequent downloads to the same host skip the TCP and
+ * TLS handshakes even where libcurl is too old to share the connections
+ * among the handles of the process (see Share).
+ */
+void HttpsClient::setKeepAlive(bool keepAlive) {
+    m_keepAlive = keepAlive;
+}
+
 
-#ifdef MSC_WITH_CURL
+/*
+ * Downloads without a body to send go through DownloadCache: what
+ * prefetch() got, a fresh copy from the disk, or a revalidated one. When
+ * the server can not be reached the copy there is, however old, is used.
+ */
 bool HttpsClient::download(const std::string &uri) {
+    DownloadCache &cache = DownloadCache::getInstance();
+    DownloadCache::Entry entry;
+
+    if (m_requestBody.empty() == false) {
+        return fetch(uri, nullptr);
+    }
+    if (cache.takePrefetched(uri, m_key, &content)) {
+        return true;
+    }
+    if (cache.enabled() == false) {
+        return fetch(uri, nullptr);
+    }
+
+    int lock = cache.lock(uri, m_key);
+    bool cached = cache.load(uri, m_key, &entry);
+    if (cached && DownloadCache::fresh(entry)) {
+        cache.unlock(lock);
+        content = std::move(entry.m_content);
+        return true;
+    }
+
+    bool ret = fetch(uri, cached ? &entry : nullptr);
+    if (ret && m_status == 304 && cached) {
+        content = entry.m_content;
+    } else if (ret) {
+        entry.m_content = content;
+        entry.m_etag = m_etag;
+        entry.m_lastModified = m_lastModified;
+    } else if (cached) {
+        content = std::move(entry.m_content);
+        cache.unlock(lock);
+        return true;
+    }
+    if (ret) {
+        entry.m_fetched = time(NULL);
+        cache.store(uri, m_key, entry);
+    }
+    cache.unlock(lock);
+
+    return ret;
+}
+
+
+#ifdef MSC_WITH_CURL
+bool HttpsClient::fetch(const std::string &uri,
+    const DownloadCache::Entry *cached) {
     CURL *curl;
     CURLcode res;
     std::string uniqueId = "ModSec-unique-id: " + UniqueId::uniqueId();
     std::string status = "ModSec-status: " + std::to_string(MODSECURITY_VERSION_NUM);
 
-    curl = curl_easy_init();
+    if (m_handle != NULL) {
+        curl = static_cast<CURL *>(m_handle);
+        curl_easy_reset(curl);
+    } else {
+        curl = curl_easy_init();
+    }
     if (!curl) {
         error = "Not able to initialize libcurl";
         return false;
@@ -74,6 +252,9 @@ bool HttpsClient::download(const std::string &uri) {
 
     struct curl_slist *headers_chunk = NULL;
     curl_easy_setopt(curl, CURLOPT_URL, uri.c_str());
+    if (Share::getInstance().handle() != NULL) {
+        curl_easy_setopt(curl, CURLOPT_SHARE, Share::getInstance().handle());
+    }
 
     headers_chunk = curl_slist_append(headers_chunk, uniqueId.c_str());
     headers_chunk = curl_slist_append(headers_chunk, status.c_str());
@@ -87,6 +268,15 @@ bool HttpsClient::download(const std::string &uri) {
         headers_chunk = curl_slist_append(headers_chunk, m_key.c_str());
     }
 
+    if (cached != nullptr && cached->m_etag.empty() == false) {
+        std::string hdr = "If-None-Match: " + cached->m_etag;
+        headers_chunk = curl_slist_append(headers_chunk, hdr.c_str());
+    }
+    if (cached != nullptr && cached->m_lastModified.empty() == false) {
+        std::string hdr = "If-Modified-Since: " + cached->m_lastModified;
+        headers_chunk = curl_slist_append(headers_chunk, hdr.c_str());
+    }
+
     /* Make it TLS 1.x only. */
     curl_easy_setopt(curl, CURLOPT_SSLVERSION, CURL_SSLVERSION_TLSv1);
 
@@ -100,7 +290,14 @@ bool HttpsClient::download(const std::string &uri) {
     /* we pass our 'chunk' struct to the callback function */
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, this);
 
+    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, &HttpsClient::handleHeader);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, this);
+
     curl_easy_setopt(curl, CURLOPT_USERAGENT, "ModSecurity3");
+#if LIBCURL_VERSION_NUM >= 0x072f00
+    /* h2 where the server (and libcurl) can, HTTP/1.1 otherwise */
+    curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+#endif
     curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers_chunk);
 
     /* We want Curl to return error in case there is an HTTP error code */
@@ -110,20 +307,31 @@ bool HttpsClient::download(const std::string &uri) {
         curl_easy_setopt(curl, CURLOPT_POSTFIELDS, m_requestBody.c_str());
     }
 
+    m_status = 0;
+    m_etag.clear();
+    m_lastModified.clear();
     res = curl_easy_perform(curl);
 
     curl_slist_free_all(headers_chunk);
 
     if (res != CURLE_OK) {
         error = curl_easy_strerror(res);
+    } else {
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &m_status);
     }
 
-    curl_easy_cleanup(curl);
+    if (m_keepAlive) {
+        m_handle = curl;
+    } else {
+        curl_easy_cleanup(curl);
+        m_handle = NULL;
+    }
 
     return res == CURLE_OK;
 }
 #else
-bool HttpsClient::download(const std::string &uri) {
+bool HttpsClient::fetch(const std::string &uri,
+    const DownloadCache::Entry *cached) {
     error = "Not compiled with libcurl support";
     return false;
 }
@@ -26,6 +26,7 @@
 #define SRC_UTILS_HTTPS_CLIENT_H_
 
 #include "modsecurity/transaction.h"
+#include "src/utils/download_cache.h"
 
 namespace modsecurity {
 namespace Utils {
@@ -38,22 +39,44 @@ class HttpsClient {
         error(""),
         m_key(""),
         m_requestBody(""),
-        m_requestType("") { }
+        m_requestType(""),
+        m_keepAlive(false),
+        m_handle(NULL),
+        m_status(0) { }
+    ~HttpsClient();
+
+    HttpsClient(const HttpsClient &c) = delete;
+    HttpsClient &operator=(const HttpsClient &c) = delete;
 
     bool download(const std::string &uri);
     std::string content;
 
     static size_t handle(char * data, size_t size, size_t nmemb, void * p);
     size_t handle_impl(char * data, size_t size, size_t nmemb);
+    static size_t handleHeader(char *data, size_t size, size_t nmemb,
+        void *p);
+    size_t handleHeaderImpl(char *data, size_t size, size_t nmemb);
     void setKey(const std::string& key);
     void setRequestType(const std::string& requestType);
     void setRequestBody(const std::string& requestBody);
+    void setKeepAlive(bool keepAlive);
+    const std::string &key() const { return m_key; }
 
     std::string error;
  private:
+    /* See download(), cached is the copy to revalidate, if any. */
+    bool fetch(const std::string &uri, const DownloadCache::Entry *cached);
+
     std::string m_key;
     std::string m_requestBody;
     std::string m_requestType;
+    bool m_keepAlive;
+    /* CURL handle kept among downloads, see setKeepAlive */
+    void *m_handle;
+    /* of the last fetch(): the HTTP status and the validators */
+    long m_status;
+    std::string m_etag;
+    std::string m_lastModified;
 };
 
 
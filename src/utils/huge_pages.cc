@@ -0,0 +1,260 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/huge_pages.h"
+
+#include <pthread.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <map>
+
+#include "src/utils/allocator.h"
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+namespace {
+
+/*
+ * In front of every block: the size class it came from, or kLarge for
+ * the ones with a region of their own, along with the size of that
+ * region. Keeps the blocks 16 bytes aligned.
+ */
+struct Header {
+    size_t m_class;
+    size_t m_size;
+};
+
+const size_t kLarge = static_cast<size_t>(-1);
+const size_t kMinBlock = 16;
+const size_t kClasses = 18;
+const size_t kMaxBlock = kMinBlock << (kClasses - 1);
+
+pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+std::atomic<int> currentMode(HugePages::Off);
+std::atomic<size_t> mappedBytes(0);
+/* base to size of every region mapped */
+std::map<uintptr_t, size_t> regions;
+void *freeLists[kClasses];
+char *bump = NULL;
+size_t bumpLeft = 0;
+
+#if WITH_PCRE2
+void *pcre2Malloc(PCRE2_SIZE size, void *data) {
+    return HugePages::malloc(size);
+}
+
+void pcre2Free(void *ptr, void *data) {
+    HugePages::free(ptr);
+}
+
+pcre2_general_context *generalContext = NULL;
+pcre2_compile_context *compileContext = NULL;
+pthread_once_t contextOnce = PTHREAD_ONCE_INIT;
+
+/* outside of the lock, creating them allocates through HugePages */
+void createContexts() {
+    generalContext = pcre2_general_context_create(pcre2Malloc, pcre2Free,
+        NULL);
+    compileContext = pcre2_compile_context_create(generalContext);
+}
+#endif
+
+
+/* size is a multiple of kRegionSize; the region is aligned to it */
+char *mapRegion(size_t size) {
+    void *map = MAP_FAILED;
+
+#ifdef MAP_HUGETLB
+    if (currentMode.load() == HugePages::Explicit) {
+        map = mmap(NULL, size, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    }
+#endif
+    if (map == MAP_FAILED) {
+        size_t span = size + HugePages::kRegionSize;
+        map = mmap(NULL, span, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (map == MAP_FAILED) {
+            return NULL;
+        }
+        uintptr_t raw = reinterpret_cast<uintptr_t>(map);
+        uintptr_t aligned = (raw + HugePages::kRegionSize - 1)
+            & ~(static_cast<uintptr_t>(HugePages::kRegionSize) - 1);
+        if (aligned > raw) {
+            munmap(map, aligned - raw);
+        }
+        if (raw + span > aligned + size) {
+            munmap(reinterpret_cast<void *>(aligned + size),
+                raw + span - aligned - size);
+        }
+        map = reinterpret_cast<void *>(aligned);
+#ifdef MADV_HUGEPAGE
+        madvise(map, size, MADV_HUGEPAGE);
+#endif
+    }
+
+    regions[reinterpret_cast<uintptr_t>(map)] = size;
+    mappedBytes += size;
+    return static_cast<char *>(map);
+}
+
+
+/* with the lock held */
+bool owned(void *ptr) {
+    uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+    auto it = regions.upper_bound(address);
+    if (it == regions.begin()) {
+        return false;
+    }
+    --it;
+    return address < it->first + it->second;
+}
+
+
+size_t classOf(size_t size) {
+    size_t c = 0;
+    while ((kMinBlock << c) < size) {
+        c++;
+    }
+    return c;
+}
+
+}  // namespace
+
+
+void HugePages::setMode(Mode mode) {
+    currentMode.store(mode);
+}
+
+
+HugePages::Mode HugePages::mode() {
+    return static_cast<Mode>(currentMode.load());
+}
+
+
+void *HugePages::malloc(size_t size) {
+    if (currentMode.load() == Off) {
+        return Allocator::malloc(size);
+    }
+    if (size > static_cast<size_t>(-1) - kRegionSize) {
+        return NULL;
+    }
+
+    size_t total = size + sizeof(Header);
+    Header *header = NULL;
+
+    pthread_mutex_lock(&lock);
+    if (total > kMaxBlock) {
+        size_t bytes = (total + kRegionSize - 1) & ~(kRegionSize - 1);
+        header = reinterpret_cast<Header *>(mapRegion(bytes));
+        if (header != NULL) {
+            header->m_class = kLarge;
+            header->m_size = bytes;
+        }
+    } else {
+        size_t c = classOf(total);
+        size_t block = kMinBlock << c;
+        if (freeLists[c] != NULL) {
+            header = static_cast<Header *>(freeLists[c]);
+            memcpy(&freeLists[c], header + 1, sizeof(void *));
+        } else {
+            if (bumpLeft < block) {
+                bump = mapRegion(kRegionSize);
+                bumpLeft = bump != NULL ? kRegionSize : 0;
+            }
+            if (bump != NULL) {
+                header = reinterpret_cast<Header *>(bump);
+                bump = bump + block;
+                bumpLeft = bumpLeft - block;
+            }
+        }
+        if (header != NULL) {
+            header->m_class = c;
+            header->m_size = block;
+        }
+    }
+    pthread_mutex_unlock(&lock);
+
+    if (header == NULL) {
+        return Allocator::malloc(size);
+    }
+    return header + 1;
+}
+
+
+void *HugePages::calloc(size_t count, size_t size) {
+    if (size != 0 && count > static_cast<size_t>(-1) / size) {
+        return NULL;
+    }
+    void *ptr = malloc(count * size);
+    if (ptr != NULL) {
+        memset(ptr, 0, count * size);
+    }
+    return ptr;
+}
+
+
+void HugePages::free(void *ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+    if (mappedBytes.load() == 0) {
+        Allocator::free(ptr);
+        return;
+    }
+
+    pthread_mutex_lock(&lock);
+    if (owned(ptr) == false) {
+        pthread_mutex_unlock(&lock);
+        Allocator::free(ptr);
+        return;
+    }
+    Header *header = static_cast<Header *>(ptr) - 1;
+    if (header->m_class == kLarge) {
+        regions.erase(reinterpret_cast<uintptr_t>(header));
+        mappedBytes -= header->m_size;
+        munmap(header, header->m_size);
+    } else {
+        memcpy(ptr, &freeLists[header->m_class], sizeof(void *));
+        freeLists[header->m_class] = header;
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+
+size_t HugePages::mapped() {
+    return mappedBytes.load();
+}
+
+
+#if WITH_PCRE2
+pcre2_compile_context *HugePages::pcre2Compile() {
+    if (currentMode.load() == Off) {
+        return Allocator::pcre2Compile();
+    }
+    pthread_once(&contextOnce, createContexts);
+    return compileContext;
+}
+#endif
+
+
+}  // namespace Utils
+}  // namespace modsecurity
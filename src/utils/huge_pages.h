@@ -0,0 +1,79 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#if WITH_PCRE2
+#define PCRE2_CODE_UNIT_WIDTH 8
+#include <pcre2.h>
+#endif
+
+#include <cstddef>
+
+#ifndef SRC_UTILS_HUGE_PAGES_H_
+#define SRC_UTILS_HUGE_PAGES_H_
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+/**
+ * Where the structures the matchers walk on every evaluation are placed
+ * (the flattened @pm automata, the @ipMatch trees and the compiled PCRE2
+ * patterns) once SecHugePages is on: regions of kRegionSize bytes, aligned
+ * to it, that are either asked to be backed by transparent huge pages or
+ * taken from the reserved huge pages, so that a few TLB entries cover
+ * all of them instead of one per page of a scattered heap.
+ *
+ * The regions are carved into power of two blocks, which go back to a
+ * free list of their size when freed; only the blocks too large for a
+ * shared region are handed back to the system. What was not allocated
+ * here is freed through Allocator, whatever the mode is by then, so the
+ * mode can change at any time.
+ *
+ * The JIT code of PCRE2 is mapped by PCRE2 itself and can not be placed.
+ */
+class HugePages {
+ public:
+    enum Mode {
+        Off,
+        /* madvise(MADV_HUGEPAGE) */
+        Transparent,
+        /* MAP_HUGETLB, Transparent when there are no pages reserved */
+        Explicit
+    };
+
+    static const size_t kRegionSize = 2 * 1024 * 1024;
+
+    static void setMode(Mode mode);
+    static Mode mode();
+
+    static void *malloc(size_t size);
+    static void *calloc(size_t count, size_t size);
+    static void free(void *ptr);
+
+    /* Bytes of the regions mapped so far. */
+    static size_t mapped();
+
+#if WITH_PCRE2
+    /* For the patterns compiled with the rules. */
+    static pcre2_compile_context *pcre2Compile();
+#endif
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_HUGE_PAGES_H_
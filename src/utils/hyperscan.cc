@@ -0,0 +1,55 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/hyperscan.h"
+
+#ifdef WITH_HYPERSCAN
+
+namespace modsecurity {
+namespace Utils {
+
+namespace {
+
+class ThreadScratch {
+ public:
+    ThreadScratch() : m_scratch(NULL) { }
+    ~ThreadScratch() {
+        if (m_scratch != NULL) {
+            hs_free_scratch(m_scratch);
+            m_scratch = NULL;
+        }
+    }
+
+    hs_scratch_t *m_scratch;
+};
+
+}  // namespace
+
+
+hs_scratch_t *hyperscanScratch(const hs_database_t *db) {
+    static thread_local ThreadScratch scratch;
+
+    /* no-op if the scratch is already large enough for db */
+    if (hs_alloc_scratch(db, &scratch.m_scratch) != HS_SUCCESS) {
+        return NULL;
+    }
+    return scratch.m_scratch;
+}
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif
@@ -0,0 +1,47 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+
+#ifdef WITH_HYPERSCAN
+#include <hs.h>
+#endif
+
+#ifndef SRC_UTILS_HYPERSCAN_H_
+#define SRC_UTILS_HYPERSCAN_H_
+
+#ifdef WITH_HYPERSCAN
+
+namespace modsecurity {
+namespace Utils {
+
+
+/**
+ * Returns the scratch space of the calling thread, grown (if needed) to be
+ * usable with db. Hyperscan scratch can not be shared among threads that
+ * scan at the same time, so each thread owns one, big enough for every
+ * database it has seen. It is released when the thread exits.
+ *
+ * Returns NULL if the scratch could not be allocated.
+ *
+ */
+hs_scratch_t *hyperscanScratch(const hs_database_t *db);
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif
+
+#endif  // SRC_UTILS_HYPERSCAN_H_
@@ -0,0 +1,141 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/inflate.h"
+
+#ifdef WITH_ZLIB
+#include <zlib.h>
+#endif
+
+#include <functional>
+#include <string>
+
+#include "src/utils/string.h"
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+Inflate::Inflate()
+    : m_stream(NULL),
+    m_ended(false),
+    m_stopped(false),
+    m_compressed(0),
+    m_inflated(0) {
+#ifdef WITH_ZLIB
+    z_stream *z = new z_stream();
+    /* 32: the zlib or the gzip header, whichever it is */
+    if (inflateInit2(z, 15 + 32) != Z_OK) {
+        m_error.assign("failed to initialize zlib");
+        delete z;
+        return;
+    }
+    m_stream = z;
+#else
+    m_error.assign("ModSecurity was not compiled with zlib support");
+#endif
+}
+
+
+Inflate::~Inflate() {
+#ifdef WITH_ZLIB
+    z_stream *z = static_cast<z_stream *>(m_stream);
+    if (z != NULL) {
+        inflateEnd(z);
+        delete z;
+    }
+#endif
+}
+
+
+bool Inflate::supports(const std::string &value) {
+    size_t begin = value.find_first_not_of(" \t");
+    size_t end = value.find_last_not_of(" \t");
+    if (begin == std::string::npos) {
+        return false;
+    }
+    std::string coding = utils::string::tolower(
+        value.substr(begin, end - begin + 1));
+    return coding == "gzip" || coding == "x-gzip" || coding == "deflate";
+}
+
+
+Inflate::Result Inflate::append(const unsigned char *data, size_t len,
+    const std::function<bool(const unsigned char *, size_t)> &out) {
+    if (m_stopped || m_ended) {
+        return Stopped;
+    }
+    if (m_error.empty() == false) {
+        return Failed;
+    }
+#ifdef WITH_ZLIB
+    z_stream *z = static_cast<z_stream *>(m_stream);
+    unsigned char chunk[kChunk];
+
+    m_compressed = m_compressed + len;
+    z->next_in = const_cast<unsigned char *>(data);
+    z->avail_in = len;
+
+    while (z->avail_in > 0) {
+        z->next_out = chunk;
+        z->avail_out = sizeof(chunk);
+
+        int ret = ::inflate(z, Z_NO_FLUSH);
+        if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) {
+            m_error.assign(z->msg != NULL ? z->msg : "corrupted stream");
+            return Failed;
+        }
+
+        size_t size = sizeof(chunk) - z->avail_out;
+        m_inflated = m_inflated + size;
+        if (size > 0 && out(chunk, size) == false) {
+            m_stopped = true;
+            return Stopped;
+        }
+
+        if (ret == Z_STREAM_END) {
+            if (z->avail_in == 0) {
+                m_ended = true;
+                break;
+            }
+            /* the next member of a concatenated gzip */
+            inflateReset(z);
+        } else if (ret == Z_BUF_ERROR && size == 0) {
+            break;
+        }
+    }
+    return Continue;
+#else
+    return Failed;
+#endif
+}
+
+
+bool Inflate::finish(std::string *error) const {
+    if (m_error.empty() == false) {
+        error->assign(m_error);
+        return false;
+    }
+    if (m_ended == false && m_stopped == false && m_compressed > 0) {
+        error->assign("the stream ended before it was complete");
+        return false;
+    }
+    return true;
+}
+
+
+}  // namespace Utils
+}  // namespace modsecurity
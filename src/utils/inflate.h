@@ -0,0 +1,88 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+#ifndef SRC_UTILS_INFLATE_H_
+#define SRC_UTILS_INFLATE_H_
+
+
+/*
+ * SecRequestBodyDecompressionRatio when it is not set: how many times
+ * the compressed size the inflated body may take.
+ */
+#define MSC_REQUEST_BODY_DECOMPRESSION_RATIO 100
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+/**
+ * A gzip or zlib (Content-Encoding: deflate) stream, inflated as its
+ * pieces arrive, in as many pieces of kChunk bytes as it takes.
+ *
+ * The output goes to a callback that may stop the inflation, after which
+ * the rest of the input is dropped: what does not fit in the body limit
+ * is not even inflated. Only there when built with zlib; append() fails
+ * otherwise.
+ */
+class Inflate {
+ public:
+    static const size_t kChunk = 16384;
+
+    enum Result {
+        Continue,
+        Stopped,
+        Failed,
+    };
+
+    Inflate();
+    ~Inflate();
+
+    Inflate(const Inflate &) = delete;
+    Inflate &operator=(const Inflate &) = delete;
+
+    /* Whether value, a Content-Encoding, is one that can be inflated. */
+    static bool supports(const std::string &value);
+
+    Result append(const unsigned char *data, size_t len,
+        const std::function<bool(const unsigned char *, size_t)> &out);
+
+    /*
+     * False, with error set, if the stream was broken or ended before
+     * it was complete; stopping it is not an error.
+     */
+    bool finish(std::string *error) const;
+
+    size_t compressed() const { return m_compressed; }
+    size_t inflated() const { return m_inflated; }
+
+ private:
+    void *m_stream;
+    bool m_ended;
+    bool m_stopped;
+    std::string m_error;
+    size_t m_compressed;
+    size_t m_inflated;
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_INFLATE_H_
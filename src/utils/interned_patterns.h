@@ -0,0 +1,145 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <pthread.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#ifndef SRC_UTILS_INTERNED_PATTERNS_H_
+#define SRC_UTILS_INTERNED_PATTERNS_H_
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+/**
+ * Process wide registry of compiled patterns (T is e.g. a Regex).
+ *
+ * The same expression or data file shows up in many rules and, once every
+ * virtual host loads its own configuration, in many rule sets. Operators
+ * get their compiled form from here, so that it is compiled and kept once
+ * per distinct pattern instead of once per rule.
+ *
+ * Only weak references are kept: an entry goes away with the last
+ * operator holding it, and the expired ones are swept as the table grows.
+ * Compiling happens outside of the lock, so operators can still be
+ * initialized in parallel; if two threads compile the same pattern at
+ * once, the first one to be done is kept.
+ *
+ */
+template <typename T>
+class InternedPatterns {
+ public:
+    /*
+     * The entry under key that same() accepts, or the outcome of make(),
+     * which is added. key may be a digest of the pattern, same() is there
+     * to tell the patterns apart in that case.
+     */
+    template <typename Same, typename Make>
+    static std::shared_ptr<T> get(const std::string &key, Same same,
+        Make make) {
+        std::shared_ptr<T> ret = find(key, same);
+        if (ret != nullptr) {
+            return ret;
+        }
+
+        std::shared_ptr<T> made(make());
+
+        pthread_mutex_lock(&state().m_lock);
+        ret = findLocked(key, same);
+        if (ret == nullptr) {
+            ret = made;
+            sweepLocked();
+            state().m_entries.emplace(key, std::weak_ptr<T>(made));
+        }
+        pthread_mutex_unlock(&state().m_lock);
+
+        return ret;
+    }
+
+    static size_t size() {
+        pthread_mutex_lock(&state().m_lock);
+        size_t ret = state().m_entries.size();
+        pthread_mutex_unlock(&state().m_lock);
+        return ret;
+    }
+
+ private:
+    struct State {
+        State()
+            : m_sweepAt(kMinSweep) {
+            pthread_mutex_init(&m_lock, NULL);
+        }
+
+        pthread_mutex_t m_lock;
+        std::unordered_multimap<std::string, std::weak_ptr<T>> m_entries;
+        size_t m_sweepAt;
+    };
+
+    static const size_t kMinSweep = 64;
+
+    static State &state() {
+        /* never destroyed, rules may outlive the static destructors */
+        static State *s = new State();
+        return *s;
+    }
+
+    template <typename Same>
+    static std::shared_ptr<T> find(const std::string &key, Same same) {
+        pthread_mutex_lock(&state().m_lock);
+        std::shared_ptr<T> ret = findLocked(key, same);
+        pthread_mutex_unlock(&state().m_lock);
+        return ret;
+    }
+
+    template <typename Same>
+    static std::shared_ptr<T> findLocked(const std::string &key, Same same) {
+        auto range = state().m_entries.equal_range(key);
+        for (auto it = range.first; it != range.second; ++it) {
+            std::shared_ptr<T> p = it->second.lock();
+            if (p != nullptr && same(*p)) {
+                return p;
+            }
+        }
+        return nullptr;
+    }
+
+    static void sweepLocked() {
+        State &s = state();
+        if (s.m_entries.size() < s.m_sweepAt) {
+            return;
+        }
+        for (auto it = s.m_entries.begin(); it != s.m_entries.end(); ) {
+            if (it->second.expired()) {
+                it = s.m_entries.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        size_t live = s.m_entries.size();
+        s.m_sweepAt = live * 2 > kMinSweep ? live * 2
+            : static_cast<size_t>(kMinSweep);
+    }
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_INTERNED_PATTERNS_H_
@@ -0,0 +1,68 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/interned_strings.h"
+
+#include <pthread.h>
+
+#include <string>
+#include <unordered_map>
+
+
+namespace modsecurity {
+namespace Utils {
+
+namespace {
+
+pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+std::unordered_map<std::string, int> &table() {
+    /* never destroyed, rules may outlive the static destructors */
+    static std::unordered_map<std::string, int> *t =
+        new std::unordered_map<std::string, int>();
+    return *t;
+}
+
+}  // namespace
+
+
+int InternedStrings::id(const std::string &s) {
+    pthread_mutex_lock(&lock);
+    std::unordered_map<std::string, int> &t = table();
+    auto it = t.find(s);
+    if (it == t.end()) {
+        it = t.emplace(s, static_cast<int>(t.size())).first;
+    }
+    int ret = it->second;
+    pthread_mutex_unlock(&lock);
+    return ret;
+}
+
+
+const std::string *InternedStrings::find(const std::string &s) {
+    pthread_mutex_lock(&lock);
+    std::unordered_map<std::string, int> &t = table();
+    auto it = t.find(s);
+    if (it == t.end()) {
+        it = t.emplace(s, static_cast<int>(t.size())).first;
+    }
+    const std::string *ret = &it->first;
+    pthread_mutex_unlock(&lock);
+    return ret;
+}
+
+
+}  // namespace Utils
+}  // namespace modsecurity
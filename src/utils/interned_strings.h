@@ -0,0 +1,51 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <string>
+
+#ifndef SRC_UTILS_INTERNED_STRINGS_H_
+#define SRC_UTILS_INTERNED_STRINGS_H_
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+/**
+ * Process wide table of interned strings.
+ *
+ * Rule tags and messages, as well as the tags and messages named by the
+ * exclusions, are interned once when the configuration is loaded. At run
+ * time telling whether a rule carries a given tag (or message) becomes
+ * an integer comparison instead of a string one.
+ *
+ * Ids are small, dense and never recycled, so they can be used to index a
+ * bitmap. Interning is thread safe but takes a lock; it is not meant to be
+ * called while inspecting a transaction.
+ *
+ */
+class InternedStrings {
+ public:
+    static int id(const std::string &s);
+
+    /* The interned copy of s, valid for as long as the process runs. */
+    static const std::string *find(const std::string &s);
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_INTERNED_STRINGS_H_
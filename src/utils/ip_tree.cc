@@ -19,10 +19,16 @@
 #include <sys/types.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
 #include <string>
+#include <vector>
 
 #include <fstream>
 #include <iostream>
+#include <sstream>
 
 #include "src/utils/geo_lookup.h"
 #include "src/utils/https_client.h"
@@ -30,78 +36,204 @@
 namespace modsecurity {
 namespace Utils {
 
-void IpTree::postOrderTraversal(TreeNode *node) {
-    if (node == NULL) {
-        return;
+namespace {
+
+/* below that the index costs more than the few search steps it saves */
+const size_t kIpv4IndexThreshold = 256;
+
+uint64_t load64(const unsigned char *p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++) {
+        v = (v << 8) | p[i];
     }
+    return v;
+}
+
+}  // namespace
+
+
+bool IpTree::lessThan(const Address6 &a, const Address6 &b) {
+    return a.m_high < b.m_high || (a.m_high == b.m_high && a.m_low < b.m_low);
+}
 
-    postOrderTraversal(node->left);
-    postOrderTraversal(node->right);
 
-    if (node->netmasks) {
-        free(node->netmasks);
-        node->netmasks = NULL;
+IpTree::IpTree() { }
+
+
+IpTree::~IpTree() { }
+
+
+/*
+ * Same grammar as the former radix tree: the address, optionally followed
+ * by a /netmask. A zero netmask is refused.
+ */
+bool IpTree::addNetwork4(const std::string &network) {
+    /* longer entries used to be truncated to the size of this buffer */
+    std::string ip(network, 0, 31);
+    unsigned int netmask = 32;
+    struct in_addr addr;
+
+    size_t slash = ip.find('/');
+    if (slash != std::string::npos) {
+        std::string mask(ip, slash + 1);
+        if (mask.find('.') != std::string::npos) {
+            return false;
+        }
+        int cidr = atoi(mask.c_str());
+        if (cidr <= 0 || cidr > 32) {
+            return false;
+        }
+        netmask = cidr;
+        ip.erase(slash);
+    }
+
+    if (inet_pton(AF_INET, ip.c_str(), &addr) <= 0) {
+        return false;
     }
-    if (node->prefix) {
-        if (node->prefix->buffer) {
-            free(node->prefix->buffer);
-            node->prefix->buffer = NULL;
+
+    uint32_t first = ntohl(addr.s_addr);
+    uint32_t hostmask = netmask == 32 ? 0 : 0xffffffffu >> netmask;
+    Range4 r;
+    r.m_first = first & ~hostmask;
+    r.m_last = first | hostmask;
+    m_ipv4.push_back(r);
+    return true;
+}
+
+
+bool IpTree::addNetwork6(const std::string &network) {
+    std::string ip(network, 0, 127);
+    unsigned int netmask = 128;
+    struct in6_addr addr;
+
+    size_t slash = ip.find('/');
+    if (slash != std::string::npos) {
+        std::string mask(ip, slash + 1);
+        if (mask.find(':') != std::string::npos) {
+            return false;
         }
-        if (node->prefix->prefix_data) {
-            free(node->prefix->prefix_data);
-            node->prefix->prefix_data = NULL;
+        int cidr = atoi(mask.c_str());
+        if (cidr <= 0 || cidr > 128) {
+            return false;
         }
-        free(node->prefix);
-        node->prefix = NULL;
+        netmask = cidr;
+        ip.erase(slash);
+    }
+
+    if (inet_pton(AF_INET6, ip.c_str(), &addr) <= 0) {
+        return false;
     }
-    free(node);
+
+    uint64_t high = load64(addr.s6_addr);
+    uint64_t low = load64(addr.s6_addr + 8);
+    uint64_t highmask = netmask >= 64 ? 0 : ~0ULL >> netmask;
+    uint64_t lowmask = netmask >= 128 ? 0
+        : (netmask <= 64 ? ~0ULL : ~0ULL >> (netmask - 64));
+    Range6 r;
+    r.m_first.m_high = high & ~highmask;
+    r.m_first.m_low = low & ~lowmask;
+    r.m_last.m_high = high | highmask;
+    r.m_last.m_low = low | lowmask;
+    m_ipv6.push_back(r);
+    return true;
 }
 
 
-IpTree::IpTree() {
-    // FIXME: deal with possible error.
-    char *error;
-    create_radix_tree(&m_tree, &error);
+bool IpTree::addNetwork(const std::string &network) {
+    if (network.find(':') == std::string::npos) {
+        return addNetwork4(network);
+    }
+    return addNetwork6(network);
 }
 
 
-IpTree::~IpTree() {
-    if (m_tree != NULL) {
-        if (m_tree->ipv4_tree != NULL) {
-            // Tree_traversal: Post-order to delete all the items.
-            postOrderTraversal(m_tree->ipv4_tree->head);
-            free(m_tree->ipv4_tree);
-            m_tree->ipv4_tree = NULL;
+/*
+ * Sorts and merges the ranges, then builds the IPv4 index. Called after
+ * every load, the lookups only ever see the compiled form.
+ */
+void IpTree::compile() {
+    std::sort(m_ipv4.begin(), m_ipv4.end(),
+        [](const Range4 &a, const Range4 &b) {
+            return a.m_first < b.m_first;
+        });
+
+    size_t n = 0;
+    for (size_t i = 0; i < m_ipv4.size(); i++) {
+        if (n > 0 && static_cast<uint64_t>(m_ipv4[i].m_first)
+            <= static_cast<uint64_t>(m_ipv4[n - 1].m_last) + 1) {
+            m_ipv4[n - 1].m_last = std::max(m_ipv4[n - 1].m_last,
+                m_ipv4[i].m_last);
+        } else {
+            m_ipv4[n++] = m_ipv4[i];
         }
-        if (m_tree->ipv6_tree != NULL) {
-            // Tree_traversal: Post-order to delete all the items.
-            postOrderTraversal(m_tree->ipv6_tree->head);
-            free(m_tree->ipv6_tree);
-            m_tree->ipv6_tree = NULL;
+    }
+    m_ipv4.resize(n);
+    m_ipv4.shrink_to_fit();
+
+    std::sort(m_ipv6.begin(), m_ipv6.end(),
+        [](const Range6 &a, const Range6 &b) {
+            return lessThan(a.m_first, b.m_first);
+        });
+
+    n = 0;
+    for (size_t i = 0; i < m_ipv6.size(); i++) {
+        if (n > 0 && !lessThan(m_ipv6[n - 1].m_last, m_ipv6[i].m_first)) {
+            if (lessThan(m_ipv6[n - 1].m_last, m_ipv6[i].m_last)) {
+                m_ipv6[n - 1].m_last = m_ipv6[i].m_last;
+            }
+        } else {
+            m_ipv6[n++] = m_ipv6[i];
         }
+    }
+    m_ipv6.resize(n);
+    m_ipv6.shrink_to_fit();
 
-        free(m_tree);
-        m_tree = NULL;
+    m_ipv4Index.clear();
+    if (m_ipv4.size() < kIpv4IndexThreshold) {
+        m_ipv4Index.shrink_to_fit();
+        return;
     }
+
+    m_ipv4Index.resize((1 << 16) + 1);
+    size_t r = 0;
+    for (uint32_t i = 0; i < (1 << 16); i++) {
+        while (r < m_ipv4.size() && m_ipv4[r].m_last < (i << 16)) {
+            r++;
+        }
+        m_ipv4Index[i] = r;
+    }
+    m_ipv4Index[1 << 16] = m_ipv4.size();
 }
 
+
 bool IpTree::addFromBuffer(std::istream *ss, std::string *error) {
-    char *error_msg = NULL;
+    bool ret = true;
+
     for (std::string line; std::getline(*ss, line); ) {
         size_t comment_start = line.find('#');
         if (comment_start != std::string::npos) {
             line = line.substr(0, comment_start);
         }
-        int res = add_ip_from_param(line.c_str(), &m_tree, &error_msg);
-        if (res != 0) {
-            if (error_msg != NULL) {
-                error->assign(error_msg);
+
+        std::stringstream entries(line);
+        for (std::string network; std::getline(entries, network, ','); ) {
+            if (network.empty()) {
+                continue;
+            }
+            if (addNetwork(network) == false) {
+                error->assign("Could not add entry \"" + network
+                    + "\" from: " + line);
+                ret = false;
+                break;
             }
-            return false;
+        }
+        if (ret == false) {
+            break;
         }
     }
 
-    return true;
+    compile();
+    return ret;
 }
 
 
@@ -138,23 +270,67 @@ bool IpTree::addFromUrl(const std::string& url, std::string *error) {
 }
 
 
-bool IpTree::contains(const std::string& ip) {
-    int res = 0;
-    char *error_msg = NULL;
+int IpTree::parse(const std::string &ip, unsigned char *addr) {
+    if (strchr(ip.c_str(), ':') == NULL) {
+        if (inet_pton(AF_INET, ip.c_str(), addr) <= 0) {
+            return -1;
+        }
+        return AF_INET;
+    }
 
-    res = tree_contains_ip(m_tree, ip.c_str(), &error_msg);
+    if (inet_pton(AF_INET6, ip.c_str(), addr) <= 0) {
+        return -1;
+    }
+    return AF_INET6;
+}
 
-    if (res < 0) {
-        return false;
+
+bool IpTree::contains(int family, const unsigned char *addr) const {
+    if (family == AF_INET) {
+        uint32_t ip = (static_cast<uint32_t>(addr[0]) << 24)
+            | (static_cast<uint32_t>(addr[1]) << 16)
+            | (static_cast<uint32_t>(addr[2]) << 8)
+            | static_cast<uint32_t>(addr[3]);
+        auto begin = m_ipv4.begin();
+        auto end = m_ipv4.end();
+
+        if (m_ipv4Index.empty() == false) {
+            uint32_t i = ip >> 16;
+            begin = m_ipv4.begin() + m_ipv4Index[i];
+            end = m_ipv4.begin() + std::min(m_ipv4.size(),
+                static_cast<size_t>(m_ipv4Index[i + 1]) + 1);
+        }
+
+        /* the first range ending at, or after, the address */
+        auto r = std::lower_bound(begin, end, ip,
+            [](const Range4 &a, uint32_t v) {
+                return a.m_last < v;
+            });
+        return r != end && r->m_first <= ip;
     }
 
-    if (res > 0) {
-        return true;
+    if (family == AF_INET6) {
+        Address6 ip;
+        ip.m_high = load64(addr);
+        ip.m_low = load64(addr + 8);
+
+        auto r = std::lower_bound(m_ipv6.begin(), m_ipv6.end(), ip,
+            [](const Range6 &a, const Address6 &v) {
+                return lessThan(a.m_last, v);
+            });
+        return r != m_ipv6.end() && !lessThan(ip, r->m_first);
     }
 
     return false;
 }
 
 
+bool IpTree::contains(const std::string& ip) const {
+    unsigned char addr[sizeof(struct in6_addr)];
+
+    return contains(parse(ip, addr), addr);
+}
+
+
 }  // namespace Utils
 }  // namespace modsecurity
@@ -13,34 +13,82 @@
  *
  */
 
+#include <stdint.h>
+
 #include <iostream>
 #include <fstream>
 #include <string>
 #include <functional>
+#include <vector>
 
 #ifndef SRC_UTILS_IP_TREE_H_
 #define SRC_UTILS_IP_TREE_H_
 
 #include "modsecurity/transaction.h"
-#include "src/utils/msc_tree.h"
 
 namespace modsecurity {
 namespace Utils {
 
 
+/**
+ * Set of IPv4 and IPv6 networks, as used by @ipMatch and friends.
+ *
+ * The networks are kept as sorted, disjoint address ranges; overlapping
+ * and adjacent ones are merged when the set is loaded. A lookup is a
+ * binary search over a flat array. Large IPv4 sets also get a direct
+ * index on the first 16 bits of the address (DIR-16), that narrows the
+ * search down to the ranges of that /16.
+ *
+ */
 class IpTree {
  public:
     IpTree();
     ~IpTree();
 
-    bool contains(const std::string &ip);
-    void postOrderTraversal(TreeNode *node);
+    bool contains(const std::string &ip) const;
+    bool contains(int family, const unsigned char *addr) const;
     bool addFromBuffer(std::istream *ss, std::string *error);
     bool addFromBuffer(const std::string& buffer, std::string *error);
     bool addFromFile(const std::string& file, std::string *error);
     bool addFromUrl(const std::string& url, std::string *error);
+
+    /*
+     * Converts a textual address into its binary form (network byte
+     * order, 4 or 16 bytes). Returns AF_INET, AF_INET6 or -1.
+     */
+    static int parse(const std::string &ip, unsigned char *addr);
+
  private:
-    TreeRoot *m_tree;
+    struct Range4 {
+        uint32_t m_first;
+        uint32_t m_last;
+    };
+
+    struct Address6 {
+        uint64_t m_high;
+        uint64_t m_low;
+    };
+
+    struct Range6 {
+        Address6 m_first;
+        Address6 m_last;
+    };
+
+    static bool lessThan(const Address6 &a, const Address6 &b);
+
+    bool addNetwork(const std::string &network);
+    bool addNetwork4(const std::string &network);
+    bool addNetwork6(const std::string &network);
+    void compile();
+
+    std::vector<Range4> m_ipv4;
+    std::vector<Range6> m_ipv6;
+
+    /*
+     * m_ipv4Index[n] is the first range of m_ipv4 which ends at, or
+     * after, the address n << 16. Left empty for small sets.
+     */
+    std::vector<uint32_t> m_ipv4Index;
 };
 
 
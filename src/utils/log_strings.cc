@@ -0,0 +1,141 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/log_strings.h"
+
+#include <string.h>
+#include <time.h>
+
+#include <string>
+
+#include "src/unique_id.h"
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+namespace {
+
+enum Format {
+    AscFormat,
+    CommonFormat,
+    DayFormat,
+    MinuteFormat,
+    SecondFormat,
+    NumberOfFormats
+};
+
+
+/* strftime() formats, but for AscFormat which is asctime_r()'s */
+const char *const formats[NumberOfFormats] = {
+    nullptr,
+    "[%d/%b/%Y:%H:%M:%S %z]",
+    "/%Y%m%d",
+    "/%Y%m%d-%H%M",
+    "/%Y%m%d-%H%M%S",
+};
+
+
+class ThreadTimes {
+ public:
+    ThreadTimes() : m_time(-1) {
+        for (size_t i = 0; i < NumberOfFormats; i++) {
+            m_formatted[i] = -1;
+        }
+    }
+
+    const std::string &format(time_t t, Format f) {
+        if (m_time != t) {
+            localtime_r(&t, &m_tm);
+            m_time = t;
+        }
+        if (m_formatted[f] == t) {
+            return m_strings[f];
+        }
+
+        char buf[64];
+        size_t len = 0;
+        if (f == AscFormat) {
+            if (asctime_r(&m_tm, buf) != NULL) {
+                len = strlen(buf);
+                /* no newline, unlike ctime() */
+                if (len > 0 && buf[len - 1] == '\n') {
+                    len--;
+                }
+            }
+        } else {
+            len = strftime(buf, sizeof(buf), formats[f], &m_tm);
+        }
+        m_strings[f].assign(buf, len);
+        m_formatted[f] = t;
+
+        return m_strings[f];
+    }
+
+ private:
+    /* what m_tm is the broken down form of */
+    time_t m_time;
+    struct tm m_tm;
+    time_t m_formatted[NumberOfFormats];
+    std::string m_strings[NumberOfFormats];
+};
+
+
+const std::string &format(time_t t, Format f) {
+    static thread_local ThreadTimes times;
+    return times.format(t, f);
+}
+
+}  // namespace
+
+
+const std::string &LogStrings::serverId() {
+    /* spares the records the std::call_once of UniqueId::uniqueId() */
+    static thread_local const std::string *id = nullptr;
+    if (id == nullptr) {
+        id = &UniqueId::uniqueId();
+    }
+    return *id;
+}
+
+
+const std::string &LogStrings::ascTime(time_t t) {
+    return format(t, AscFormat);
+}
+
+
+const std::string &LogStrings::commonTime(time_t t) {
+    return format(t, CommonFormat);
+}
+
+
+const std::string &LogStrings::day(time_t t) {
+    return format(t, DayFormat);
+}
+
+
+const std::string &LogStrings::minute(time_t t) {
+    return format(t, MinuteFormat);
+}
+
+
+const std::string &LogStrings::second(time_t t) {
+    return format(t, SecondFormat);
+}
+
+
+}  // namespace Utils
+}  // namespace modsecurity
@@ -0,0 +1,59 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <ctime>
+#include <string>
+
+#ifndef SRC_UTILS_LOG_STRINGS_H_
+#define SRC_UTILS_LOG_STRINGS_H_
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+/**
+ * The strings every log record repeats: the server identity and the
+ * time of the transaction in the formats the writers put it in.
+ *
+ * The times are kept per thread and only formatted again when the second
+ * changes, which the records written in a row seldom see: one localtime_r
+ * (and the time zone lock behind it) per second instead of one or more
+ * per record. What is returned is valid until the next call for another
+ * time, on the same thread.
+ *
+ */
+class LogStrings {
+ public:
+    /* The server identity, the "server_id" of the records. */
+    static const std::string &serverId();
+
+    /* "Thu Oct 15 00:39:16 2026", as ctime() has it, minus the newline. */
+    static const std::string &ascTime(time_t t);
+
+    /* "[15/Oct/2026:00:39:16 +0000]", the native records and index lines. */
+    static const std::string &commonTime(time_t t);
+
+    /* "/20261015", "/20261015-0039" and "/20261015-003916", the paths. */
+    static const std::string &day(time_t t);
+    static const std::string &minute(time_t t);
+    static const std::string &second(time_t t);
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_LOG_STRINGS_H_
@@ -1,21 +1,49 @@
 
 
 #include "src/utils/md5.h"
+
+#ifdef WITH_OPENSSL
+#include <openssl/evp.h>
+#include <memory>
+#else
 #include "others/mbedtls/md5.h"
+#endif
 
 namespace modsecurity {
 namespace Utils {
 
+namespace {
+
+
+/* As in sha1.cc, a context per thread when OpenSSL is used. */
+void md5(const std::string &input, unsigned char *output) {
+#ifdef WITH_OPENSSL
+    static thread_local std::unique_ptr<EVP_MD_CTX,
+        void (*)(EVP_MD_CTX *)> ctx(EVP_MD_CTX_new(), EVP_MD_CTX_free);
+
+    EVP_DigestInit_ex(ctx.get(), EVP_md5(), nullptr);
+    EVP_DigestUpdate(ctx.get(), input.data(), input.size());
+    EVP_DigestFinal_ex(ctx.get(), output, nullptr);
+#else
+    mbedtls_md5(reinterpret_cast<const unsigned char *>(input.c_str()),
+        input.size(), output);
+#endif
+}
+
+
+}  // namespace
+
 
 std::string Md5::hexdigest(const std::string& input) {
     unsigned char digest[16];
+    static const char* const lut = "0123456789abcdef";
 
-    mbedtls_md5(reinterpret_cast<const unsigned char *>(input.c_str()),
-        input.size(), digest);
+    md5(input, digest);
 
-    char buf[33];
+    char buf[32];
     for (int i = 0; i < 16; i++) {
-        sprintf(buf+i*2, "%02x", digest[i]);
+        buf[i * 2] = lut[digest[i] >> 4];
+        buf[i * 2 + 1] = lut[digest[i] & 15];
     }
 
     return std::string(buf, 32);
@@ -26,8 +54,7 @@ std::string Md5::digest(const std::string& input) {
     unsigned char output[16];
     std::string ret;
 
-    mbedtls_md5(reinterpret_cast<const unsigned char *>(input.c_str()),
-        input.size(), output);
+    md5(input, output);
 
     ret.assign(reinterpret_cast<const char *>(output), 16);
 
@@ -37,4 +64,3 @@ std::string Md5::digest(const std::string& input) {
 
 }  // namespace Utils
 }  // namespace modsecurity
-
@@ -0,0 +1,402 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/metrics.h"
+
+#include <map>
+#include <sstream>
+#include <string>
+
+namespace modsecurity {
+namespace Utils {
+
+
+static const uint64_t bucketBounds[Metrics::kBuckets] = {
+    1000, 10000, 100000, 1000000, 10000000, 100000000
+};
+static const char *bucketLabels[Metrics::kBuckets + 1] = {
+    "0.000001", "0.00001", "0.0001", "0.001", "0.01", "0.1", "+Inf"
+};
+
+
+static void add(std::atomic<uint64_t> *c, uint64_t v) {
+    c->store(c->load(std::memory_order_relaxed) + v,
+        std::memory_order_relaxed);
+}
+
+
+Metrics::Shard::Shard() {
+    for (auto &c : m_counters) {
+        c.store(0, std::memory_order_relaxed);
+    }
+    for (auto &h : m_buckets) {
+        for (auto &b : h) {
+            b.store(0, std::memory_order_relaxed);
+        }
+    }
+    for (auto &s : m_sums) {
+        s.store(0, std::memory_order_relaxed);
+    }
+    for (size_t i = 0; i < NumberOfLocks; i++) {
+        m_lockWaits[i].store(0, std::memory_order_relaxed);
+        m_lockWaitNs[i].store(0, std::memory_order_relaxed);
+    }
+    pthread_mutex_init(&m_lock, NULL);
+}
+
+
+Metrics::Shard::~Shard() {
+    pthread_mutex_destroy(&m_lock);
+}
+
+
+Metrics::Metrics() {
+    for (auto &g : m_gauges) {
+        g.store(0, std::memory_order_relaxed);
+    }
+    pthread_mutex_init(&m_lock, NULL);
+}
+
+
+Metrics::~Metrics() {
+    pthread_mutex_destroy(&m_lock);
+}
+
+
+/*
+ * The shard of a thread goes away with it; what it counted is kept in
+ * m_retired. Destroyed before the registry itself, a static, is.
+ */
+class Metrics::ShardOwner {
+ public:
+    ShardOwner() : m_shard(NULL) { }
+    ~ShardOwner() {
+        if (m_shard != NULL) {
+            Metrics::getInstance().retire(m_shard);
+        }
+    }
+
+    Shard *m_shard;
+};
+
+
+Metrics::Shard *Metrics::shard() {
+    static thread_local ShardOwner current;
+
+    if (current.m_shard == NULL) {
+        current.m_shard = new Shard();
+        pthread_mutex_lock(&m_lock);
+        m_shards.emplace_back(current.m_shard);
+        pthread_mutex_unlock(&m_lock);
+    }
+
+    return current.m_shard;
+}
+
+
+void Metrics::retire(Shard *s) {
+    pthread_mutex_lock(&m_lock);
+    fold(*s, &m_retired);
+    for (auto it = m_shards.begin(); it != m_shards.end(); ++it) {
+        if (it->get() == s) {
+            m_shards.erase(it);
+            break;
+        }
+    }
+    pthread_mutex_unlock(&m_lock);
+}
+
+
+/* adds from to to, which is only ever seen by the caller */
+void Metrics::fold(Shard &from, Shard *to) {
+    for (size_t i = 0; i < NumberOfCounters; i++) {
+        add(&to->m_counters[i],
+            from.m_counters[i].load(std::memory_order_relaxed));
+    }
+    for (size_t h = 0; h < NumberOfHistograms; h++) {
+        for (size_t b = 0; b <= kBuckets; b++) {
+            add(&to->m_buckets[h][b],
+                from.m_buckets[h][b].load(std::memory_order_relaxed));
+        }
+        add(&to->m_sums[h], from.m_sums[h].load(std::memory_order_relaxed));
+    }
+    for (size_t l = 0; l < NumberOfLocks; l++) {
+        add(&to->m_lockWaits[l],
+            from.m_lockWaits[l].load(std::memory_order_relaxed));
+        add(&to->m_lockWaitNs[l],
+            from.m_lockWaitNs[l].load(std::memory_order_relaxed));
+    }
+    pthread_mutex_lock(&from.m_lock);
+    for (auto &i : from.m_interventions) {
+        to->m_interventions[i.first] += i.second;
+    }
+    pthread_mutex_unlock(&from.m_lock);
+}
+
+
+void Metrics::increment(Counter counter, uint64_t value) {
+    add(&shard()->m_counters[counter], value);
+}
+
+
+void Metrics::intervention(int64_t ruleId) {
+    Shard *s = shard();
+
+    pthread_mutex_lock(&s->m_lock);
+    s->m_interventions[ruleId]++;
+    pthread_mutex_unlock(&s->m_lock);
+}
+
+
+void Metrics::observe(Histogram histogram, uint64_t ns) {
+    Shard *s = shard();
+    size_t bucket = 0;
+
+    while (bucket < kBuckets && ns > bucketBounds[bucket]) {
+        bucket++;
+    }
+    add(&s->m_buckets[histogram][bucket], 1);
+    add(&s->m_sums[histogram], ns);
+}
+
+
+void Metrics::waited(Lock lock, uint64_t ns) {
+    Shard *s = shard();
+
+    add(&s->m_lockWaits[lock], 1);
+    add(&s->m_lockWaitNs[lock], ns);
+}
+
+
+void Metrics::lock(pthread_mutex_t *mutex, Lock which) {
+    if (pthread_mutex_trylock(mutex) == 0) {
+        return;
+    }
+    uint64_t start = utils::monotonic_ns();
+    pthread_mutex_lock(mutex);
+    getInstance().waited(which, utils::monotonic_ns() - start);
+}
+
+
+void Metrics::readLock(pthread_rwlock_t *rwlock, Lock which) {
+    if (pthread_rwlock_tryrdlock(rwlock) == 0) {
+        return;
+    }
+    uint64_t start = utils::monotonic_ns();
+    pthread_rwlock_rdlock(rwlock);
+    getInstance().waited(which, utils::monotonic_ns() - start);
+}
+
+
+void Metrics::writeLock(pthread_rwlock_t *rwlock, Lock which) {
+    if (pthread_rwlock_trywrlock(rwlock) == 0) {
+        return;
+    }
+    uint64_t start = utils::monotonic_ns();
+    pthread_rwlock_wrlock(rwlock);
+    getInstance().waited(which, utils::monotonic_ns() - start);
+}
+
+
+void Metrics::set(Gauge gauge, int64_t value) {
+    m_gauges[gauge].store(value, std::memory_order_relaxed);
+}
+
+
+std::string Metrics::render() {
+    static const struct {
+        const char *name;
+        const char *help;
+        const char *label;
+    } counters[NumberOfCounters] = {
+        {"modsecurity_transactions_total",
+            "Transactions created.", NULL},
+        {"modsecurity_pcre_limits_exceeded_total",
+            "Regular expression matches stopped by the PCRE limits.", NULL},
+        {"modsecurity_rx_guardrail_total",
+            "Regular expression matches cut short by SecRxGuardrail.", NULL},
+        {"modsecurity_audit_log_failures_total",
+            "Audit log records that could not be written or sent.", NULL},
+        {"modsecurity_audit_log_suppressed_total",
+            "Audit log records left to a digest by SecAuditLogRateLimit.",
+            NULL},
+        {"modsecurity_server_log_dropped_total",
+            "Rule messages dropped as the server log queue was full.", NULL},
+        {"modsecurity_request_body_errors_total",
+            "Request bodies the body processor failed to parse.",
+            "processor=\"xml\""},
+        {"modsecurity_request_body_errors_total", NULL,
+            "processor=\"json\""},
+        {"modsecurity_request_body_errors_total", NULL,
+            "processor=\"grpc\""},
+        {"modsecurity_request_body_errors_total", NULL,
+            "processor=\"multipart\""},
+        {"modsecurity_request_body_errors_total", NULL,
+            "processor=\"unknown\""},
+        {"modsecurity_collection_entries_expired_total",
+            "Persistent collection entries dropped by SecCollectionTimeout.",
+            "backend=\"lmdb\""},
+        {"modsecurity_collection_entries_expired_total", NULL,
+            "backend=\"in_memory\""},
+        {"modsecurity_collection_redis_errors_total",
+            "Round trips to the Redis server that failed or timed out.",
+            NULL},
+        {"modsecurity_collection_redis_dropped_writes_total",
+            "Collection writes the Redis server never got.", NULL},
+        {"modsecurity_collection_shared_memory_dropped_writes_total",
+            "Collection writes with a key or a value too long for a " \
+            "shared memory slot.", NULL},
+        {"modsecurity_overload_transactions_total",
+            "Transactions that started while the overload protection " \
+            "was shedding.", NULL},
+        {"modsecurity_overload_rules_shed_total",
+            "Rule evaluations skipped by the overload protection.", NULL},
+        {"modsecurity_overload_detection_only_total",
+            "Transactions switched to DetectionOnly by the overload " \
+            "protection.", NULL},
+        {"modsecurity_time_budget_exceeded_total",
+            "Transactions that went over SecTransactionTimeBudget.", NULL},
+        {"modsecurity_memory_limit_exceeded_total",
+            "Transactions that went over SecTransactionMemoryLimit.", NULL},
+        {"modsecurity_verdict_cache_hits_total",
+            "Request phases answered by SecVerdictCache.", NULL},
+        {"modsecurity_verdict_cache_misses_total",
+            "Request phases SecVerdictCache had no verdict for.", NULL},
+        {"modsecurity_shadow_transactions_total",
+            "Transactions run again against SecShadowRules.", NULL},
+        {"modsecurity_shadow_differences_total",
+            "Shadowed transactions SecShadowRules had another outcome for.",
+            NULL},
+        {"modsecurity_shadow_shed_total",
+            "Transactions not shadowed as the shadow queue was full.", NULL},
+    };
+    static const char *backends[NumberOfHistograms] = {
+        "lmdb", "shared_memory", "redis"
+    };
+    static const char *locks[NumberOfLocks] = {
+        "collection_shard", "collection_per_process", "shared_files_mutex",
+        "shared_files_fcntl", "lmdb_writer"
+    };
+    Shard total;
+    std::ostringstream out;
+
+    pthread_mutex_lock(&m_lock);
+    fold(m_retired, &total);
+    for (auto &s : m_shards) {
+        fold(*s, &total);
+    }
+    pthread_mutex_unlock(&m_lock);
+
+    uint64_t totals[NumberOfCounters];
+    uint64_t buckets[NumberOfHistograms][kBuckets + 1];
+    uint64_t sums[NumberOfHistograms];
+    uint64_t lockWaits[NumberOfLocks];
+    uint64_t lockWaitNs[NumberOfLocks];
+    std::map<int64_t, uint64_t> interventions(total.m_interventions.begin(),
+        total.m_interventions.end());
+    for (size_t i = 0; i < NumberOfCounters; i++) {
+        totals[i] = total.m_counters[i].load(std::memory_order_relaxed);
+    }
+    for (size_t h = 0; h < NumberOfHistograms; h++) {
+        for (size_t b = 0; b <= kBuckets; b++) {
+            buckets[h][b] = total.m_buckets[h][b].load(
+                std::memory_order_relaxed);
+        }
+        sums[h] = total.m_sums[h].load(std::memory_order_relaxed);
+    }
+    for (size_t l = 0; l < NumberOfLocks; l++) {
+        lockWaits[l] = total.m_lockWaits[l].load(std::memory_order_relaxed);
+        lockWaitNs[l] = total.m_lockWaitNs[l].load(std::memory_order_relaxed);
+    }
+
+    for (size_t i = 0; i < NumberOfCounters; i++) {
+        if (counters[i].help != NULL) {
+            out << "# HELP " << counters[i].name << " " << counters[i].help
+                << "\n# TYPE " << counters[i].name << " counter\n";
+        }
+        out << counters[i].name;
+        if (counters[i].label) {
+            out << "{" << counters[i].label << "}";
+        }
+        out << " " << totals[i] << "\n";
+    }
+
+    out << "# HELP modsecurity_interventions_total Interventions, by the " \
+        "id of the rule that triggered them.\n" \
+        "# TYPE modsecurity_interventions_total counter\n";
+    for (auto &i : interventions) {
+        out << "modsecurity_interventions_total{rule_id=\"" << i.first
+            << "\"} " << i.second << "\n";
+    }
+
+    out << "# HELP modsecurity_audit_log_queue_depth Audit log records " \
+        "waiting to be sent.\n" \
+        "# TYPE modsecurity_audit_log_queue_depth gauge\n" \
+        "modsecurity_audit_log_queue_depth "
+        << m_gauges[AuditLogQueueGauge].load(std::memory_order_relaxed)
+        << "\n";
+
+    out << "# HELP modsecurity_collection_lmdb_size_bytes Space used in the " \
+        "LMDB collections file, as of the last expiry sweep.\n" \
+        "# TYPE modsecurity_collection_lmdb_size_bytes gauge\n" \
+        "modsecurity_collection_lmdb_size_bytes "
+        << m_gauges[LmdbSizeGauge].load(std::memory_order_relaxed)
+        << "\n";
+
+    out << "# HELP modsecurity_overload_level How many steps the rolling " \
+        "p99 is over SecOverloadTarget, 0 when it is not.\n" \
+        "# TYPE modsecurity_overload_level gauge\n" \
+        "modsecurity_overload_level "
+        << m_gauges[OverloadLevelGauge].load(std::memory_order_relaxed)
+        << "\n";
+
+    out << "# HELP modsecurity_collection_operation_seconds Time spent in " \
+        "the persistent collection backends.\n" \
+        "# TYPE modsecurity_collection_operation_seconds histogram\n";
+    for (size_t h = 0; h < NumberOfHistograms; h++) {
+        uint64_t count = 0;
+        for (size_t b = 0; b <= kBuckets; b++) {
+            count += buckets[h][b];
+            out << "modsecurity_collection_operation_seconds_bucket{" \
+                "backend=\"" << backends[h] << "\",le=\"" << bucketLabels[b]
+                << "\"} " << count << "\n";
+        }
+        out << "modsecurity_collection_operation_seconds_sum{backend=\""
+            << backends[h] << "\"} " << sums[h] / 1e9 << "\n";
+        out << "modsecurity_collection_operation_seconds_count{backend=\""
+            << backends[h] << "\"} " << count << "\n";
+    }
+
+    out << "# HELP modsecurity_lock_waits_total Times a shared lock was " \
+        "found taken.\n" \
+        "# TYPE modsecurity_lock_waits_total counter\n";
+    for (size_t l = 0; l < NumberOfLocks; l++) {
+        out << "modsecurity_lock_waits_total{lock=\"" << locks[l] << "\"} "
+            << lockWaits[l] << "\n";
+    }
+    out << "# HELP modsecurity_lock_wait_seconds_total Time spent waiting " \
+        "for the shared locks.\n" \
+        "# TYPE modsecurity_lock_wait_seconds_total counter\n";
+    for (size_t l = 0; l < NumberOfLocks; l++) {
+        out << "modsecurity_lock_wait_seconds_total{lock=\"" << locks[l]
+            << "\"} " << lockWaitNs[l] / 1e9 << "\n";
+    }
+
+    return out.str();
+}
+
+
+}  // namespace Utils
+}  // namespace modsecurity
@@ -0,0 +1,189 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <pthread.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "src/utils/system.h"
+
+#ifndef SRC_UTILS_METRICS_H_
+#define SRC_UTILS_METRICS_H_
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+/**
+ * Process wide engine counters, rendered in the Prometheus text
+ * exposition format (version 0.0.4) by render() (ModSecurity::metrics(),
+ * msc_metrics_render()).
+ *
+ * A process wide registry, rather than one per ModSecurity instance,
+ * since most of what is counted (collection backends, audit log writers,
+ * operators) has no way back to the instance it runs for; connectors
+ * only ever create one anyway.
+ *
+ * Counters and histograms are kept per thread, written by their own
+ * thread only (load and store, no read-modify-write) and summed up by
+ * render(); a thread that exits hands its counts over to the registry
+ * and its shard is freed. Gauges are plain process wide atomics. Interventions are
+ * counted by rule id, in a per thread map whose lock is only ever
+ * contended by render().
+ *
+ */
+class Metrics {
+ public:
+    enum Counter {
+        TransactionsCounter,
+        PcreLimitsExceededCounter,
+        RxGuardrailCounter,
+        AuditLogFailuresCounter,
+        AuditLogSuppressedCounter,
+        ServerLogDroppedCounter,
+        XmlBodyErrorsCounter,
+        JsonBodyErrorsCounter,
+        GrpcBodyErrorsCounter,
+        MultipartBodyErrorsCounter,
+        UnknownBodyErrorsCounter,
+        LmdbEntriesExpiredCounter,
+        InMemoryEntriesExpiredCounter,
+        RedisErrorsCounter,
+        RedisDroppedWritesCounter,
+        SharedMemoryDroppedWritesCounter,
+        OverloadTransactionsCounter,
+        OverloadRulesShedCounter,
+        OverloadDetectionOnlyCounter,
+        TimeBudgetExceededCounter,
+        MemoryLimitExceededCounter,
+        VerdictCacheHitsCounter,
+        VerdictCacheMissesCounter,
+        ShadowTransactionsCounter,
+        ShadowDifferencesCounter,
+        ShadowShedCounter,
+        NumberOfCounters
+    };
+
+    enum Histogram {
+        LmdbOperationsHistogram,
+        SharedMemoryOperationsHistogram,
+        RedisOperationsHistogram,
+        NumberOfHistograms
+    };
+
+    enum Gauge {
+        AuditLogQueueGauge,
+        LmdbSizeGauge,
+        OverloadLevelGauge,
+        NumberOfGauges
+    };
+
+    /* the shared locks whose contention is accounted, see lock() */
+    enum Lock {
+        CollectionShardLock,
+        CollectionPerProcessLock,
+        SharedFilesMutexLock,
+        SharedFilesFileLock,
+        LmdbWriterLock,
+        NumberOfLocks
+    };
+
+    /* upper bounds, in nanoseconds, of the histogram buckets; +Inf last */
+    static const size_t kBuckets = 6;
+
+    /**
+     * Observes the time spent in the enclosing scope.
+     */
+    class Timer {
+     public:
+        explicit Timer(Histogram h)
+            : m_histogram(h),
+            m_start(utils::monotonic_ns()) { }
+        ~Timer() {
+            getInstance().observe(m_histogram,
+                utils::monotonic_ns() - m_start);
+        }
+
+     private:
+        Histogram m_histogram;
+        uint64_t m_start;
+    };
+
+    static Metrics& getInstance() {
+        static Metrics instance;
+        return instance;
+    }
+
+    void increment(Counter counter, uint64_t value = 1);
+    void intervention(int64_t ruleId);
+    void observe(Histogram histogram, uint64_t ns);
+    void set(Gauge gauge, int64_t value);
+    void waited(Lock lock, uint64_t ns);
+
+    /*
+     * Take a shared lock, trying it first: only when it is taken already
+     * is the wait timed and accounted to the lock, so the uncontended
+     * path costs no clock reads.
+     */
+    static void lock(pthread_mutex_t *mutex, Lock which);
+    static void readLock(pthread_rwlock_t *rwlock, Lock which);
+    static void writeLock(pthread_rwlock_t *rwlock, Lock which);
+
+    std::string render();
+
+ private:
+    struct Shard {
+        Shard();
+        ~Shard();
+
+        std::atomic<uint64_t> m_counters[NumberOfCounters];
+        std::atomic<uint64_t> m_buckets[NumberOfHistograms][kBuckets + 1];
+        std::atomic<uint64_t> m_sums[NumberOfHistograms];
+        std::atomic<uint64_t> m_lockWaits[NumberOfLocks];
+        std::atomic<uint64_t> m_lockWaitNs[NumberOfLocks];
+        std::unordered_map<int64_t, uint64_t> m_interventions;
+        pthread_mutex_t m_lock;
+    };
+
+    Metrics();
+    ~Metrics();
+    Metrics(const Metrics&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+
+    class ShardOwner;
+
+    Shard *shard();
+    void retire(Shard *s);
+    static void fold(Shard &from, Shard *to);
+
+    std::vector<std::unique_ptr<Shard>> m_shards;
+    /* what the threads gone counted, under m_lock */
+    Shard m_retired;
+    std::atomic<int64_t> m_gauges[NumberOfGauges];
+    pthread_mutex_t m_lock;
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_METRICS_H_
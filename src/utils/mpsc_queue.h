@@ -0,0 +1,108 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <stdint.h>
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+#ifndef SRC_UTILS_MPSC_QUEUE_H_
+#define SRC_UTILS_MPSC_QUEUE_H_
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+/**
+ * Bounded queue of many producers and a single consumer, without locks.
+ *
+ * A ring of Size cells (a power of two), each with a sequence number
+ * telling whose turn it is: producers claim the next position with a
+ * compare and swap and publish the value by moving the sequence on, the
+ * consumer takes it and hands the cell to the producers of the next lap.
+ * A push to a full queue fails right away instead of waiting.
+ */
+template <typename T, size_t Size>
+class MpscQueue {
+ public:
+    MpscQueue() : m_tail(0), m_head(0) {
+        static_assert((Size & (Size - 1)) == 0, "Size is a power of two");
+        for (size_t i = 0; i < Size; i++) {
+            m_cells[i].m_sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+
+    bool push(T &&value) {
+        Cell *cell;
+        size_t pos = m_tail.load(std::memory_order_relaxed);
+
+        while (true) {
+            cell = &m_cells[pos & (Size - 1)];
+            size_t sequence = cell->m_sequence.load(
+                std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence)
+                - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (m_tail.compare_exchange_weak(pos, pos + 1,
+                    std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->m_value = std::move(value);
+        cell->m_sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /* consumer only */
+    bool pop(T *value) {
+        Cell *cell = &m_cells[m_head & (Size - 1)];
+        if (cell->m_sequence.load(std::memory_order_acquire) != m_head + 1) {
+            return false;
+        }
+
+        *value = std::move(cell->m_value);
+        cell->m_value = T();
+        cell->m_sequence.store(m_head + Size, std::memory_order_release);
+        m_head++;
+        return true;
+    }
+
+ private:
+    struct Cell {
+        std::atomic<size_t> m_sequence;
+        T m_value;
+    };
+
+    Cell m_cells[Size];
+    std::atomic<size_t> m_tail;
+    size_t m_head;
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_MPSC_QUEUE_H_
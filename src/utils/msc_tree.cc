@@ -20,13 +20,16 @@
 #include <arpa/inet.h>
 
 #include "src/utils/msc_tree.h"
+#include "src/utils/huge_pages.h"
+
+using modsecurity::Utils::HugePages;
 
 extern "C" {
 
 CPTTree *CPTCreateRadixTree()   {
     CPTTree *tree;
 
-    tree = reinterpret_cast<CPTTree *>(malloc(sizeof(CPTTree)));
+    tree = reinterpret_cast<CPTTree *>(HugePages::malloc(sizeof(CPTTree)));
 
     if(tree == NULL)
         return NULL;
@@ -62,7 +65,7 @@ void ConvertIPNetmask(unsigned char *buffer, unsigned char netmask, unsigned int
 TreeNode *CPTCreateNode()   {
     TreeNode *node;
 
-    node = reinterpret_cast<TreeNode *>(malloc(sizeof(TreeNode)));
+    node = reinterpret_cast<TreeNode *>(HugePages::malloc(sizeof(TreeNode)));
 
     if(node == NULL)
         return NULL;
@@ -73,7 +76,7 @@ TreeNode *CPTCreateNode()   {
 
 CPTData *CPTCreateCPTData(unsigned char netmask) {
 
-    CPTData *prefix_data = reinterpret_cast<CPTData *>(malloc(sizeof(CPTData)));
+    CPTData *prefix_data = reinterpret_cast<CPTData *>(HugePages::malloc(sizeof(CPTData)));
 
     if (prefix_data == NULL) {
         return NULL;
@@ -113,16 +116,16 @@ TreePrefix *CPTCreatePrefix(unsigned char *ipdata, unsigned int ip_bitmask,
         return NULL;
     }
 
-    prefix = reinterpret_cast<TreePrefix *>(malloc(sizeof(TreePrefix)));
+    prefix = reinterpret_cast<TreePrefix *>(HugePages::malloc(sizeof(TreePrefix)));
     if (prefix == NULL)
         return NULL;
 
     memset(prefix, 0, sizeof(TreePrefix));
 
-    prefix->buffer = reinterpret_cast<unsigned char *>(malloc(bytes));
+    prefix->buffer = reinterpret_cast<unsigned char *>(HugePages::malloc(bytes));
 
     if (prefix->buffer == NULL) {
-        free(prefix);
+        HugePages::free(prefix);
         return NULL;
     }
 
@@ -218,7 +221,7 @@ TreeNode *CPTCreateHead(TreePrefix *prefix, TreeNode *node, CPTTree *tree, unsig
             return node;
 
         node->count++;
-        node->netmasks = reinterpret_cast<unsigned char *>(malloc(node->count *  sizeof(unsigned char)));
+        node->netmasks = reinterpret_cast<unsigned char *>(HugePages::malloc(node->count *  sizeof(unsigned char)));
 
         if(node->netmasks)
             node->netmasks[0] = netmask;
@@ -259,7 +262,7 @@ int InsertNetmask(TreeNode *node, TreeNode *parent, TreeNode *new_node,
 
             node->count++;
 
-            node->netmasks = reinterpret_cast<unsigned char *>(malloc(node->count * sizeof(unsigned char)));
+            node->netmasks = reinterpret_cast<unsigned char *>(HugePages::malloc(node->count * sizeof(unsigned char)));
             if(node->netmasks == NULL) {
                 return 0;
             }
@@ -412,7 +415,7 @@ TreeNode *CPTAddElement(unsigned char *ipdata, unsigned int ip_bitmask, CPTTree
 
                 node->count++;
                 new_node = node;
-                node->netmasks = reinterpret_cast<unsigned char *>(malloc(node->count *  sizeof(unsigned char)));
+                node->netmasks = reinterpret_cast<unsigned char *>(HugePages::malloc(node->count *  sizeof(unsigned char)));
                 memset(node->netmasks, 0, (node->count *  sizeof(unsigned char)));
 
                 if ((node->count -1) == 0) {
@@ -466,8 +469,8 @@ TreeNode *CPTAddElement(unsigned char *ipdata, unsigned int ip_bitmask, CPTTree
         i_node = CPTCreateNode();
 
         if (i_node == NULL) {
-            free(new_node->prefix);
-            free(new_node);
+            HugePages::free(new_node->prefix);
+            HugePages::free(new_node);
             return NULL;
         }
 
@@ -484,13 +487,13 @@ TreeNode *CPTAddElement(unsigned char *ipdata, unsigned int ip_bitmask, CPTTree
                 i++;
             }
 
-            i_node->netmasks = reinterpret_cast<unsigned char *>(malloc((node->count - i) * sizeof(unsigned char)));
+            i_node->netmasks = reinterpret_cast<unsigned char *>(HugePages::malloc((node->count - i) * sizeof(unsigned char)));
             memset(i_node->netmasks, 0, ((node->count - i) * sizeof(unsigned char)));
 
             if(i_node->netmasks == NULL) {
-                free(new_node->prefix);
-                free(new_node);
-                free(i_node);
+                HugePages::free(new_node->prefix);
+                HugePages::free(new_node);
+                HugePages::free(i_node);
                 return NULL;
             }
 
@@ -1114,7 +1117,7 @@ unsigned char is_netmask_v6(char *ip_strv6) {
 
 int create_radix_tree(TreeRoot **rtree, char **error_msg)
 {
-    *rtree = reinterpret_cast<TreeRoot *>(malloc(sizeof(TreeRoot)));
+    *rtree = reinterpret_cast<TreeRoot *>(HugePages::malloc(sizeof(TreeRoot)));
     if (*rtree == NULL)
     {
         //*error_msg = apr_psprintf(mp, "Failed allocating " \
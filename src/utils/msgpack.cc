@@ -0,0 +1,101 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/msgpack.h"
+
+#include <string.h>
+
+#include <string>
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+void MsgPack::element() {
+    if (!m_open.empty()) {
+        m_open.back().second++;
+    }
+}
+
+
+void MsgPack::put(unsigned char type, uint64_t value, int bytes) {
+    m_out->push_back(static_cast<char>(type));
+    for (int i = bytes - 1; i >= 0; i--) {
+        m_out->push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+    }
+}
+
+
+void MsgPack::open(unsigned char type) {
+    element();
+    m_open.push_back(std::make_pair(m_out->size(), 0));
+    put(type, 0, 4);
+}
+
+
+void MsgPack::close(bool map) {
+    if (m_open.empty()) {
+        return;
+    }
+    size_t at = m_open.back().first + 1;
+    uint32_t count = m_open.back().second;
+    m_open.pop_back();
+
+    if (map) {
+        count = count / 2;
+    }
+    for (int i = 0; i < 4; i++) {
+        (*m_out)[at + i] = static_cast<char>((count >> ((3 - i) * 8)) & 0xff);
+    }
+}
+
+
+void MsgPack::string(const char *s, size_t len) {
+    element();
+    if (len < 32) {
+        m_out->push_back(static_cast<char>(0xa0 | len));
+    } else if (len <= 0xff) {
+        put(0xd9, len, 1);
+    } else if (len <= 0xffff) {
+        put(0xda, len, 2);
+    } else {
+        put(0xdb, len, 4);
+    }
+    m_out->append(s, len);
+}
+
+
+void MsgPack::string(const char *s) {
+    string(s, strlen(s));
+}
+
+
+void MsgPack::integer(int64_t value) {
+    element();
+    if (value >= 0 && value < 128) {
+        m_out->push_back(static_cast<char>(value));
+    } else if (value < 0 && value >= -32) {
+        m_out->push_back(static_cast<char>(value & 0xff));
+    } else if (value >= 0) {
+        put(0xcf, static_cast<uint64_t>(value), 8);
+    } else {
+        put(0xd3, static_cast<uint64_t>(value), 8);
+    }
+}
+
+
+}  // namespace Utils
+}  // namespace modsecurity
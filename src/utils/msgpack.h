@@ -0,0 +1,82 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifndef SRC_UTILS_MSGPACK_H_
+#define SRC_UTILS_MSGPACK_H_
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+/**
+ * Writes MessagePack to the end of a string, as it goes.
+ *
+ * Maps and arrays are opened and closed like with a JSON generator; the
+ * number of elements, which MessagePack wants up front, is filled in on
+ * close. They are always given the 32 bits header for that reason, which
+ * is valid, if not the most compact, MessagePack.
+ */
+class MsgPack {
+ public:
+    explicit MsgPack(std::string *out) : m_out(out) { }
+
+    void mapOpen() { open(0xdf); }
+    void mapClose() { close(true); }
+    void arrayOpen() { open(0xdd); }
+    void arrayClose() { close(false); }
+
+    void string(const char *s, size_t len);
+    void string(const std::string &s) { string(s.data(), s.size()); }
+    void string(const char *s);
+    void integer(int64_t value);
+
+    /* key and value of a map entry */
+    void add(const char *key, const std::string &value) {
+        string(key);
+        string(value);
+    }
+    void add(const char *key, const char *value) {
+        string(key);
+        string(value == NULL ? "" : value);
+    }
+    void add(const char *key, int64_t value) {
+        string(key);
+        integer(value);
+    }
+
+ private:
+    void open(unsigned char type);
+    void close(bool map);
+    void element();
+    void put(unsigned char type, uint64_t value, int bytes);
+
+    std::string *m_out;
+    /* where the header of each container still open is, and its count */
+    std::vector<std::pair<size_t, uint32_t>> m_open;
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_MSGPACK_H_
@@ -0,0 +1,153 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/numa.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include <stdlib.h>
+
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+namespace {
+
+/* A sysfs cpu or node list, e.g. "0-3,8-11". */
+std::vector<int> parseList(const std::string &list) {
+    std::vector<int> items;
+    size_t pos = 0;
+
+    while (pos < list.size()) {
+        size_t end = list.find(',', pos);
+        if (end == std::string::npos) {
+            end = list.size();
+        }
+        std::string range(list, pos, end - pos);
+        size_t dash = range.find('-');
+        int first = atoi(range.c_str());
+        int last = dash == std::string::npos ? first
+            : atoi(range.c_str() + dash + 1);
+        for (int i = first; i <= last; i++) {
+            items.push_back(i);
+        }
+        pos = end + 1;
+    }
+    return items;
+}
+
+
+bool readList(const std::string &path, std::vector<int> *items) {
+    std::ifstream file(path);
+    std::string list;
+
+    if (!std::getline(file, list)) {
+        return false;
+    }
+    *items = parseList(list);
+    return true;
+}
+
+#ifdef __linux__
+struct Bound {
+    const std::vector<int> *m_cpus;
+    const std::function<void()> *m_task;
+    bool m_bound;
+};
+
+
+void *runBound(void *data) {
+    Bound *bound = static_cast<Bound *>(data);
+    cpu_set_t set;
+
+    CPU_ZERO(&set);
+    for (int cpu : *bound->m_cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        return NULL;
+    }
+    bound->m_bound = true;
+    (*bound->m_task)();
+    return NULL;
+}
+#endif
+
+}  // namespace
+
+
+std::vector<std::vector<int>> Numa::nodes() {
+    std::vector<std::vector<int>> nodes;
+#ifdef __linux__
+    std::vector<int> online;
+
+    if (!readList("/sys/devices/system/node/online", &online)
+        || online.size() < 2) {
+        return nodes;
+    }
+    for (int node : online) {
+        std::vector<int> cpus;
+        if (!readList("/sys/devices/system/node/node"
+            + std::to_string(node) + "/cpulist", &cpus)) {
+            return std::vector<std::vector<int>>();
+        }
+        if (nodes.size() <= static_cast<size_t>(node)) {
+            nodes.resize(node + 1);
+        }
+        nodes[node] = cpus;
+    }
+#endif
+    return nodes;
+}
+
+
+int Numa::currentCpu() {
+#ifdef __linux__
+    return sched_getcpu();
+#else
+    return -1;
+#endif
+}
+
+
+bool Numa::runOn(const std::vector<int> &cpus,
+    const std::function<void()> &task) {
+#ifdef __linux__
+    Bound bound = { &cpus, &task, false };
+    pthread_t thread;
+
+    if (pthread_create(&thread, NULL, &runBound, &bound) != 0) {
+        return false;
+    }
+    pthread_join(thread, NULL);
+    return bound.m_bound;
+#else
+    return false;
+#endif
+}
+
+
+}  // namespace Utils
+}  // namespace modsecurity
@@ -0,0 +1,56 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <functional>
+#include <vector>
+
+#ifndef SRC_UTILS_NUMA_H_
+#define SRC_UTILS_NUMA_H_
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+/**
+ * What little of the NUMA layout of the host the rules set replicas need
+ * (see RulesSet::replicatePerNumaNode), read from sysfs; there is no
+ * libnuma dependency. Off Linux the host is taken to be a single node.
+ */
+class Numa {
+ public:
+    /*
+     * The CPUs of each online node, by node number; empty when there is
+     * a single node or the layout can not be read.
+     */
+    static std::vector<std::vector<int>> nodes();
+
+    /* The CPU the calling thread runs on, or -1. */
+    static int currentCpu();
+
+    /*
+     * Runs task, to completion, on a thread bound to cpus, so that what
+     * it allocates is first touched, and so placed, on their node.
+     * False if the thread could not be started or bound.
+     */
+    static bool runOn(const std::vector<int> &cpus,
+        const std::function<void()> &task);
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_NUMA_H_
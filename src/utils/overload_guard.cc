@@ -0,0 +1,96 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/overload_guard.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "src/utils/metrics.h"
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+OverloadGuard::OverloadGuard(uint64_t targetNs, size_t window)
+    : m_targetNs(targetNs),
+    m_window(window > 0 ? window : 1),
+    m_every(std::max<size_t>(m_window / 8, 1)),
+    m_samples(new std::atomic<uint64_t>[m_window]),
+    m_observed(0),
+    m_p99(0),
+    m_level(0) {
+    for (size_t i = 0; i < m_window; i++) {
+        m_samples[i].store(0, std::memory_order_relaxed);
+    }
+    pthread_mutex_init(&m_lock, NULL);
+}
+
+
+OverloadGuard::~OverloadGuard() {
+    pthread_mutex_destroy(&m_lock);
+}
+
+
+void OverloadGuard::observe(uint64_t ns) {
+    uint64_t n = m_observed.fetch_add(1, std::memory_order_relaxed);
+    m_samples[n % m_window].store(ns, std::memory_order_relaxed);
+
+    /* no decision on less than a full window */
+    if (n + 1 >= m_window && (n + 1) % m_every == 0) {
+        update();
+    }
+}
+
+
+void OverloadGuard::update() {
+    /* one update at a time is enough, the others skip theirs */
+    if (pthread_mutex_trylock(&m_lock) != 0) {
+        return;
+    }
+
+    std::vector<uint64_t> samples(m_window);
+    for (size_t i = 0; i < m_window; i++) {
+        samples[i] = m_samples[i].load(std::memory_order_relaxed);
+    }
+    size_t at = (m_window * 99) / 100;
+    std::nth_element(samples.begin(), samples.begin() + at, samples.end());
+    uint64_t p99 = samples[at];
+
+    int wanted = 0;
+    for (uint64_t bound = m_targetNs; wanted < kMaxLevel && p99 > bound;
+        bound *= 2) {
+        wanted++;
+    }
+
+    int level = m_level.load(std::memory_order_relaxed);
+    if (wanted > level) {
+        level = wanted;
+    } else if (wanted < level
+        && p99 < ((m_targetNs << (level - 1)) / 10) * 8) {
+        level--;
+    }
+
+    m_p99.store(p99, std::memory_order_relaxed);
+    m_level.store(level, std::memory_order_relaxed);
+    Metrics::getInstance().set(Metrics::OverloadLevelGauge, level);
+
+    pthread_mutex_unlock(&m_lock);
+}
+
+
+}  // namespace Utils
+}  // namespace modsecurity
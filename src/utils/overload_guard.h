@@ -0,0 +1,82 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <pthread.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+#ifndef SRC_UTILS_OVERLOAD_GUARD_H_
+#define SRC_UTILS_OVERLOAD_GUARD_H_
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+/**
+ * Overload protection of a rule set (SecOverloadTarget): the rolling p99
+ * of the time the last transactions spent in the engine (their total
+ * timing), and from it how much of the rules to shed.
+ *
+ * The level goes up one step each time the p99 doubles past the target:
+ * 1 above it, 2 above twice it, 3 above four times. It comes down one
+ * step at a time, only once the p99 is back under 80% of what got it
+ * there, so that shedding, which brings the p99 down, does not make it
+ * go back and forth at every sample. Transactions take the level as
+ * they start (see Transaction::processURI).
+ *
+ * The samples go in a ring written by any thread; every window / 8 of
+ * them, the thread that wrote the last one works out the p99 again.
+ */
+class OverloadGuard {
+ public:
+    static const int kMaxLevel = 3;
+
+    OverloadGuard(uint64_t targetNs, size_t window);
+    ~OverloadGuard();
+
+    OverloadGuard(const OverloadGuard &) = delete;
+    OverloadGuard &operator=(const OverloadGuard &) = delete;
+
+    void observe(uint64_t ns);
+
+    int level() const {
+        return m_level.load(std::memory_order_relaxed);
+    }
+    uint64_t p99() const {
+        return m_p99.load(std::memory_order_relaxed);
+    }
+
+ private:
+    void update();
+
+    uint64_t m_targetNs;
+    size_t m_window;
+    size_t m_every;
+    std::unique_ptr<std::atomic<uint64_t>[]> m_samples;
+    std::atomic<uint64_t> m_observed;
+    std::atomic<uint64_t> m_p99;
+    std::atomic<int> m_level;
+    pthread_mutex_t m_lock;
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_OVERLOAD_GUARD_H_
@@ -0,0 +1,176 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/pair_index.h"
+
+#include <ctype.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "modsecurity/variable_value.h"
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+void PairIndex::clear() {
+    m_text.clear();
+    m_pairs.clear();
+    m_values.m_filled = 0;
+    m_names.m_filled = 0;
+}
+
+
+void PairIndex::add(const std::string &key, size_t keyOffset,
+    const std::string &value, size_t valueOffset) {
+    add(key.data(), key.size(), keyOffset, value.data(), value.size(),
+        valueOffset);
+}
+
+
+void PairIndex::add(const char *key, size_t keyLength, size_t keyOffset,
+    const char *value, size_t valueLength, size_t valueOffset) {
+    Pair p;
+
+    p.m_key = m_text.size();
+    p.m_keyLength = keyLength;
+    m_text.append(key, keyLength);
+    p.m_value = m_text.size();
+    p.m_valueLength = valueLength;
+    m_text.append(value, valueLength);
+    p.m_keyOffset = keyOffset;
+    p.m_valueOffset = valueOffset;
+
+    m_pairs.push_back(p);
+}
+
+
+void PairIndex::addCookies(const std::string &header, size_t offset) {
+    const char *data = header.data();
+    const size_t size = header.size();
+    size_t localOffset = offset;
+
+    size_t pos = 0;
+    while (pos < size) {
+        const char *c = data + pos;
+        const char *end = static_cast<const char *>(
+            memchr(c, ';', size - pos));
+        size_t len = end ? end - c : size - pos;
+        pos = pos + len + 1;
+
+        // Get rid of any optional whitespace after the cookie-string
+        // (i.e. after the end of the final cookie-pair)
+        if (pos >= size) {
+            while (len > 0 && isspace(c[len - 1])) {
+                len--;
+            }
+        }
+
+        // skip empty substring, eg "Cookie: ;;foo=bar"
+        if (len == 0) {
+            localOffset++;  // add length of ';'
+            continue;
+        }
+
+        // split to two substrings by first =, if the cookie doesn't
+        // contains '=', its just a key; the value will contain the next
+        // '=' chars if exists, eg. foo=bar=baz -> key: foo, value: bar=baz
+        const char *eq = static_cast<const char *>(memchr(c, '=', len));
+        size_t keyLen = eq ? eq - c : len;
+        size_t keyStart = 0;
+
+        // ltrim the key - following the modsec v2 way
+        while (keyStart < keyLen && isspace(c[keyStart])) {
+            keyStart++;
+            localOffset++;
+        }
+
+        // if the key is empty (eg: "Cookie:   =bar;") skip it
+        if (keyStart == keyLen) {
+            localOffset = localOffset + len + 1;
+            continue;
+        }
+
+        size_t ckeyLen = keyLen - keyStart;
+        size_t cvalLen = eq ? len - keyLen - 1 : 0;
+        size_t keyOffset = localOffset;
+        size_t valueOffset = keyOffset + ckeyLen + 1;
+
+        add(c + keyStart, ckeyLen, keyOffset, eq ? eq + 1 : c, cvalLen,
+            valueOffset);
+        localOffset = valueOffset + cvalLen + 1;
+    }
+}
+
+
+void PairIndex::Source::fill(AnchoredSetVariable *set) {
+    const std::string &text = m_index->m_text;
+    std::string key;
+
+    for (; m_filled < m_index->m_pairs.size(); m_filled++) {
+        const Pair &p = m_index->m_pairs[m_filled];
+        key.assign(text, p.m_key, p.m_keyLength);
+        if (m_names) {
+            set->set(key, key, p.m_keyOffset);
+        } else {
+            set->set(key, text.substr(p.m_value, p.m_valueLength),
+                p.m_valueOffset);
+        }
+    }
+}
+
+
+/*
+ * The set hands the elements under a key newest first, as they sit in
+ * its buckets; so does this.
+ */
+void PairIndex::Source::find(const AnchoredSetVariable *set,
+    const std::string &key, std::vector<const VariableValue *> *l) const {
+    const std::string &text = m_index->m_text;
+    MyEqual equal;
+
+    for (size_t i = m_index->m_pairs.size(); i > 0; i--) {
+        const Pair &p = m_index->m_pairs[i - 1];
+        if (p.m_keyLength != key.size()) {
+            continue;
+        }
+        std::string k(text, p.m_key, p.m_keyLength);
+        if (equal(k, key) == false) {
+            continue;
+        }
+
+        VariableOrigin origin;
+        VariableValue *v;
+        if (m_names) {
+            v = new VariableValue(&set->m_name, &k, &k);
+            origin.m_offset = p.m_keyOffset;
+            origin.m_length = p.m_keyLength;
+        } else {
+            std::string value(text, p.m_value, p.m_valueLength);
+            v = new VariableValue(&set->m_name, &k, &value);
+            origin.m_offset = p.m_valueOffset;
+            origin.m_length = p.m_valueLength;
+        }
+        v->addOrigin(origin);
+        l->push_back(v);
+    }
+}
+
+
+}  // namespace Utils
+}  // namespace modsecurity
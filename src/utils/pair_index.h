@@ -0,0 +1,110 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "modsecurity/anchored_set_variable.h"
+
+#ifndef SRC_UTILS_PAIR_INDEX_H_
+#define SRC_UTILS_PAIR_INDEX_H_
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+/**
+ * Key and value pairs of the request, held as offsets into a copy of the
+ * text they were found in until a rule asks for them.
+ *
+ * REQUEST_COOKIES, REQUEST_COOKIES_NAMES and REQUEST_HEADERS_NAMES are
+ * filled from one of these on first use (see AnchoredSetVariable::Source)
+ * instead of as the headers come in. A request whose rules only look at
+ * a couple of cookies by name, or at none, does not pay for an element,
+ * with copies of its key and value, per cookie and per header.
+ *
+ * values() fills a set with the values under their keys, at the offsets
+ * of the values; names() fills one with the keys, as values too, at the
+ * offsets of the keys.
+ */
+class PairIndex {
+ public:
+    PairIndex()
+        : m_values(this, false),
+        m_names(this, true) { }
+
+    PairIndex(const PairIndex &) = delete;
+    PairIndex &operator=(const PairIndex &) = delete;
+
+    void clear();
+
+    void add(const std::string &key, size_t keyOffset,
+        const std::string &value, size_t valueOffset);
+
+    /*
+     * The cookie-pairs of a Cookie header whose value is at offset, split
+     * and trimmed, and their offsets advanced, the same way the v2 engine
+     * did.
+     */
+    void addCookies(const std::string &header, size_t offset);
+
+    AnchoredSetVariable::Source *values() { return &m_values; }
+    AnchoredSetVariable::Source *names() { return &m_names; }
+
+ private:
+    struct Pair {
+        /* where the key and the value are in m_text */
+        size_t m_key;
+        size_t m_keyLength;
+        size_t m_value;
+        size_t m_valueLength;
+        /* and where they are in the request */
+        size_t m_keyOffset;
+        size_t m_valueOffset;
+    };
+
+    class Source : public AnchoredSetVariable::Source {
+     public:
+        Source(const PairIndex *index, bool names)
+            : m_index(index),
+            m_names(names),
+            m_filled(0) { }
+
+        void fill(AnchoredSetVariable *set) override;
+        void find(const AnchoredSetVariable *set, const std::string &key,
+            std::vector<const VariableValue *> *l) const override;
+
+        const PairIndex *m_index;
+        bool m_names;
+        /* the pairs already in the set */
+        size_t m_filled;
+    };
+
+    void add(const char *key, size_t keyLength, size_t keyOffset,
+        const char *value, size_t valueLength, size_t valueOffset);
+
+    std::string m_text;
+    std::vector<Pair> m_pairs;
+    Source m_values;
+    Source m_names;
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_PAIR_INDEX_H_
@@ -14,7 +14,12 @@
  */
 
 
+#include <pthread.h>
+#include <unistd.h>
+
 #include <algorithm>
+#include <atomic>
+#include <cstdio>
 #include <random>
 #include <memory>
 #include <functional>
@@ -26,12 +31,13 @@ namespace modsecurity {
 namespace utils {
 
 
+/*
+ * Seeded once per thread: std::random_device costs a read of the kernel
+ * entropy pool, too much to pay for every transaction.
+ */
 double random_number(const double from, const double to) {
-    std::random_device rd;
-    std::mt19937 mt(rd());
-    return std::bind(
-        std::uniform_real_distribution<>{from, to},
-        std::default_random_engine{ mt() })();
+    static thread_local std::mt19937 mt(std::random_device{}());
+    return std::uniform_real_distribution<>{from, to}(mt);
 }
 
 
@@ -40,6 +46,48 @@ double generate_transaction_unique_id() {
 }
 
 
+namespace {
+
+
+/* Kept up to date over fork(), getpid() is a system call. */
+std::atomic<unsigned long> processId(0);
+
+void refreshProcessId() {
+    processId = static_cast<unsigned long>(getpid()) % 10000000;
+}
+
+
+}  // namespace
+
+
+/*
+ * <timeStamp>.<pid, 7 digits><thread, 4 digits or more><counter, 9 digits>
+ *
+ * The thread number is handed out once per thread, from a counter that
+ * does not wrap: once past 9999 it just takes more digits, the pid and the
+ * counter around it keep their width. The counter is bumped for every id,
+ * so two ids of the same process only collide if a thread goes through a
+ * billion transactions within the same second. It is digits and a dot, as
+ * the ids made of a random number.
+ */
+std::string generate_sequential_transaction_id(time_t timeStamp) {
+    static std::atomic<unsigned long long> threads(0);
+    static thread_local unsigned long long thread = threads++;
+    static thread_local unsigned long counter = 0;
+    static const bool tracked = [] {
+        refreshProcessId();
+        return pthread_atfork(nullptr, nullptr, refreshProcessId) == 0;
+    }();
+    char buf[64];
+
+    (void) tracked;
+    int len = snprintf(buf, sizeof(buf), "%lld.%07lu%04llu%09lu",
+        static_cast<long long>(timeStamp), processId.load(), thread,
+        counter++ % 1000000000);
+    return std::string(buf, len);
+}
+
+
 }  // namespace utils
 }  // namespace modsecurity
 
@@ -30,6 +30,7 @@ namespace utils {
 
     double random_number(const double from, const double to);
     double generate_transaction_unique_id();
+    std::string generate_sequential_transaction_id(time_t timeStamp);
 
 
 }  // namespace utils
@@ -15,13 +15,31 @@
 
 #include "src/utils/regex.h"
 
+#include <ctype.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
 #include <string>
 #include <list>
+#include <memory>
 
 #include <fstream>
 #include <iostream>
 
+#include "src/utils/allocator.h"
+#include "src/utils/byte_scan.h"
 #include "src/utils/geo_lookup.h"
+#include "src/utils/huge_pages.h"
+#include "src/utils/interned_patterns.h"
+#include "src/utils/regex_store.h"
+
+#ifdef WITH_RE2
+#include <re2/re2.h>
+#include <re2/stringpiece.h>
+#endif
 
 #ifndef WITH_PCRE2
 #if PCRE_HAVE_JIT
@@ -35,30 +53,250 @@
 #endif
 #endif
 
+
+namespace modsecurity {
+namespace Utils {
+
+
+namespace {
+
+/* see Regex::setJitStackSize */
+std::atomic<size_t> jitStackSize(Regex::kDefaultJitStackSize);
+const size_t kJitStackStartSize = 32 * 1024;
+
 #ifdef WITH_PCRE2
-class Pcre2MatchContextPtr {
+/*
+ * What a thread needs to run the expressions, kept from one match to the
+ * next instead of being allocated for each: match data with room for the
+ * most groups an expression had so far, match data for the overall match
+ * alone, and a match context with a JIT stack of its own and the match
+ * limit that was last asked for.
+ */
+class MatchResources {
  public:
-    Pcre2MatchContextPtr()
-        : m_match_context(pcre2_match_context_create(NULL)) {}
+    MatchResources()
+        : m_data(NULL),
+        m_pairs(0),
+        m_overall(NULL),
+        m_context(NULL),
+        m_stack(NULL),
+        m_stackSize(0),
+        m_defaultMatchLimit(0),
+        m_matchLimit(0) {
+        pcre2_config(PCRE2_CONFIG_MATCHLIMIT, &m_defaultMatchLimit);
+    }
+
+    ~MatchResources() {
+        pcre2_match_data_free(m_data);
+        pcre2_match_data_free(m_overall);
+        pcre2_match_context_free(m_context);
+        pcre2_jit_stack_free(m_stack);
+    }
 
-		Pcre2MatchContextPtr(const Pcre2MatchContextPtr&) = delete;
-		Pcre2MatchContextPtr& operator=(const Pcre2MatchContextPtr&) = delete;
+    MatchResources(const MatchResources &) = delete;
+    MatchResources &operator=(const MatchResources &) = delete;
+
+    pcre2_match_data *data(uint32_t pairs) {
+        if (m_data == NULL || m_pairs < pairs) {
+            pcre2_match_data_free(m_data);
+            m_data = pcre2_match_data_create(pairs, Allocator::pcre2());
+            m_pairs = pairs;
+        }
+        return m_data;
+    }
 
-    ~Pcre2MatchContextPtr() {
-        pcre2_match_context_free(m_match_context);
+    /* what is left out of it makes the match return 0 */
+    pcre2_match_data *overall() {
+        if (m_overall == NULL) {
+            m_overall = pcre2_match_data_create(1, Allocator::pcre2());
+        }
+        return m_overall;
     }
 
-    operator pcre2_match_context*() const {
-        return m_match_context;
+    pcre2_match_context *context(unsigned long match_limit) {
+        size_t stackSize = jitStackSize.load(std::memory_order_relaxed);
+        uint32_t limit = match_limit > 0 ? match_limit : m_defaultMatchLimit;
+
+        if (m_context == NULL) {
+            m_context = pcre2_match_context_create(Allocator::pcre2());
+            m_matchLimit = m_defaultMatchLimit;
+        }
+        if (m_stack == NULL || m_stackSize != stackSize) {
+            pcre2_jit_stack_free(m_stack);
+            m_stack = pcre2_jit_stack_create(
+                std::min(kJitStackStartSize, stackSize), stackSize,
+                Allocator::pcre2());
+            m_stackSize = stackSize;
+            /* the machine stack is used when there is none */
+            pcre2_jit_stack_assign(m_context, NULL, m_stack);
+        }
+        if (m_matchLimit != limit) {
+            pcre2_set_match_limit(m_context, limit);
+            m_matchLimit = limit;
+        }
+        return m_context;
     }
 
  private:
-    pcre2_match_context *m_match_context;
+    pcre2_match_data *m_data;
+    uint32_t m_pairs;
+    pcre2_match_data *m_overall;
+    pcre2_match_context *m_context;
+    pcre2_jit_stack *m_stack;
+    size_t m_stackSize;
+    uint32_t m_defaultMatchLimit;
+    uint32_t m_matchLimit;
 };
+
+
+MatchResources &matchResources() {
+    static thread_local MatchResources resources;
+    return resources;
+}
+#elif PCRE_HAVE_JIT
+class JitStack {
+ public:
+    JitStack() : m_stack(NULL), m_size(0) { }
+    ~JitStack() {
+        if (m_stack != NULL) {
+            pcre_jit_stack_free(m_stack);
+        }
+    }
+
+    JitStack(const JitStack &) = delete;
+    JitStack &operator=(const JitStack &) = delete;
+
+    pcre_jit_stack *get() {
+        size_t size = jitStackSize.load(std::memory_order_relaxed);
+        if (m_stack == NULL || m_size != size) {
+            if (m_stack != NULL) {
+                pcre_jit_stack_free(m_stack);
+            }
+            m_stack = pcre_jit_stack_alloc(
+                std::min(kJitStackStartSize, size), size);
+            m_size = size;
+        }
+        return m_stack;
+    }
+
+ private:
+    pcre_jit_stack *m_stack;
+    size_t m_size;
+};
+
+
+/* the machine stack is used when NULL is returned */
+pcre_jit_stack *threadJitStack(void *data) {
+    static thread_local JitStack stack;
+    return stack.get();
+}
 #endif
 
-namespace modsecurity {
-namespace Utils {
+#ifndef WITH_PCRE2
+/*
+ * The offsets vector of a thread, grown to the most groups an expression
+ * had so far: pcre_exec() wants three ints per pair (the third is its
+ * own workspace).
+ */
+int *threadOvector(uint32_t pairs) {
+    static thread_local std::vector<int> ovector;
+    if (ovector.size() < pairs * 3) {
+        ovector.resize(pairs * 3);
+    }
+    return ovector.data();
+}
+#endif
+
+#ifdef WITH_RE2
+/*
+ * The expression in the syntax of RE2, with the same meaning as with
+ * the options PCRE compiles it with, or false (and why, on error) when
+ * that can not be told apart from the syntax alone. What both read the
+ * same way is left as is, for RE2 to reject what it does not support:
+ *
+ *  - \s also matches the vertical tab for PCRE, not for RE2.
+ *  - \h, \v and \R are (horizontal, vertical) white space and line
+ *    breaks for PCRE; RE2 takes \v as the vertical tab alone.
+ *  - \1 to \9 may be back references as well as octal escapes.
+ *  - PCRE2_MULTILINE is (?m), PCRE2_DOTALL is the dot_nl option.
+ */
+bool linearSyntax(const std::string &pattern, std::string *out,
+    std::string *error) {
+    static const std::string space("\\t\\n\\x0b\\f\\r ");
+    bool inClass = false;
+    size_t classStart = 0;
+
+    out->assign("(?m)");
+    for (size_t i = 0; i < pattern.size(); i++) {
+        char c = pattern[i];
+
+        if (c == '\\' && i + 1 < pattern.size()) {
+            char n = pattern[++i];
+            if (n == 'Q') {
+                size_t end = pattern.find("\\E", i + 1);
+                end = end == std::string::npos ? pattern.size() : end + 2;
+                out->append(pattern, i - 1, end - i + 1);
+                i = end - 1;
+            } else if (n == 's') {
+                out->append(inClass ? space : "[" + space + "]");
+            } else if (n == 'S' && inClass == false) {
+                out->append("[^" + space + "]");
+            } else if (n == 'S' || strchr("hHvVR", n) != NULL
+                || (n >= '1' && n <= '9')) {
+                error->assign(std::string("\\") + n + " has no RE2 "
+                    "equivalent" + (inClass ? " in a character class" : ""));
+                return false;
+            } else {
+                out->push_back(c);
+                out->push_back(n);
+            }
+            continue;
+        }
+
+        out->push_back(c);
+        if (inClass) {
+            /* a ] right after [ or [^ is a literal one */
+            if (c == ']' && i > classStart) {
+                inClass = false;
+            } else if (c == '[' && i + 1 < pattern.size()
+                && pattern[i + 1] == ':') {
+                size_t end = pattern.find(":]", i + 2);
+                if (end != std::string::npos) {
+                    out->append(pattern, i + 1, end + 1 - i);
+                    i = end + 1;
+                }
+            }
+        } else if (c == '[') {
+            inClass = true;
+            classStart = i + 1;
+            if (classStart < pattern.size() && pattern[classStart] == '^') {
+                out->push_back('^');
+                i = classStart++;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+std::vector<re2::StringPiece> &linearGroups(size_t count) {
+    static thread_local std::vector<re2::StringPiece> groups;
+    if (groups.size() < count) {
+        groups.resize(count);
+    }
+    return groups;
+}
+#endif
+
+}  // namespace
+
+
+void Regex::setJitStackSize(size_t size) {
+    jitStackSize.store(size > 0 ? size : kDefaultJitStackSize,
+        std::memory_order_relaxed);
+}
+
 
 // Helper function to tell us if the current config indicates CRLF is a valid newline sequence
 bool crlfIsNewline() {
@@ -87,19 +325,99 @@ bool crlfIsNewline() {
     return crlf_is_newline;
 }
 
-Regex::Regex(const std::string& pattern_, bool ignoreCase)
-    : pattern(pattern_.empty() ? ".*" : pattern_) {
+std::shared_ptr<Regex> Regex::interned(const std::string &pattern,
+    bool ignoreCase, RegexStore *store) {
+    std::shared_ptr<Regex> re = InternedPatterns<Regex>::get(
+        std::string(ignoreCase ? "i/" : "-/") + pattern,
+        [](const Regex &) { return true; },
+        [&pattern, ignoreCase, store]() {
+            Regex *re = new Regex(pattern, ignoreCase, store);
+            re->compileLinear(ignoreCase);
+            return re;
+        });
+
+    /* compiled earlier for other rules, it still belongs in their file */
+    if (re != nullptr && store != NULL && store->isOpen()) {
+        re->keepIn(store, ignoreCase);
+    }
+
+    return re;
+}
+
+
+std::string Regex::storeKey(const std::string &pattern, bool ignoreCase) {
+    return (ignoreCase ? "i:" : "-:") + pattern;
+}
+
+
+void Regex::keepIn(RegexStore *store, bool ignoreCase) const {
 #if WITH_PCRE2
-    PCRE2_SPTR pcre2_pattern = reinterpret_cast<PCRE2_SPTR>(pattern.c_str());
-    uint32_t pcre2_options = (PCRE2_DOTALL|PCRE2_MULTILINE);
-    if (ignoreCase) {
-        pcre2_options |= PCRE2_CASELESS;
+    std::string key(storeKey(pattern, ignoreCase));
+
+    if (store->use(key)) {
+        return;
+    }
+    store->add(key, m_pc);
+#ifdef WITH_HYPERSCAN
+    store->add(key, m_hs);
+#endif
+#endif
+}
+
+
+Regex::Regex(const std::string& pattern_, bool ignoreCase,
+    RegexStore *store)
+    : pattern(pattern_.empty() ? ".*" : pattern_),
+    m_minLength(0),
+    m_anchored(false),
+    m_fewFirstBytes(false),
+    m_firstByteA(0),
+    m_firstByteB(0)
+#ifdef WITH_HYPERSCAN
+    , m_hs(NULL)
+#endif
+#ifdef WITH_RE2
+    , m_re2(NULL)
+#endif
+    {
+    m_captureCount = 0;
+#if WITH_PCRE2
+    std::string key;
+#ifdef WITH_HYPERSCAN
+    bool stored = false;
+#endif
+
+    if (store != NULL && store->isOpen()) {
+        key.assign(storeKey(pattern, ignoreCase));
+        m_pc = store->findPcre(key);
+#ifdef WITH_HYPERSCAN
+        stored = m_pc != NULL;
+#endif
+    } else {
+        store = NULL;
+        m_pc = NULL;
+    }
+
+    if (m_pc == NULL) {
+        PCRE2_SPTR pcre2_pattern = reinterpret_cast<PCRE2_SPTR>(
+            pattern.c_str());
+        uint32_t pcre2_options = (PCRE2_DOTALL|PCRE2_MULTILINE);
+        if (ignoreCase) {
+            pcre2_options |= PCRE2_CASELESS;
+        }
+        int errornumber = 0;
+        PCRE2_SIZE erroroffset = 0;
+        m_pc = pcre2_compile(pcre2_pattern, PCRE2_ZERO_TERMINATED,
+            pcre2_options, &errornumber, &erroroffset,
+            HugePages::pcre2Compile());
+        if (store != NULL) {
+            store->add(key, m_pc);
+        }
     }
-    int errornumber = 0;
-    PCRE2_SIZE erroroffset = 0;
-    m_pc = pcre2_compile(pcre2_pattern, PCRE2_ZERO_TERMINATED,
-        pcre2_options, &errornumber, &erroroffset, NULL);
     m_pcje = pcre2_jit_compile(m_pc, PCRE2_JIT_COMPLETE);
+    if (m_pc != NULL) {
+        pcre2_pattern_info(m_pc, PCRE2_INFO_CAPTURECOUNT, &m_captureCount);
+    }
 #else
     const char *errptr = NULL;
     int erroffset;
@@ -112,14 +430,234 @@ Regex::Regex(const std::string& pattern_, bool ignoreCase)
         &errptr, &erroffset, NULL);
 
     m_pce = pcre_study(m_pc, pcre_study_opt, &errptr);
+#if PCRE_HAVE_JIT
+    if (m_pce != NULL) {
+        pcre_assign_jit_stack(m_pce, threadJitStack, NULL);
+    }
+#endif
+    int captureCount = 0;
+    if (m_pc != NULL && pcre_fullinfo(m_pc, m_pce, PCRE_INFO_CAPTURECOUNT,
+        &captureCount) == 0) {
+        m_captureCount = captureCount;
+    }
 #endif
+
+    computeStartInfo();
+
+#ifdef WITH_HYPERSCAN
+    /*
+     * In prefilter mode Hyperscan accepts most of the PCRE syntax (back
+     * references and the like are approximated). Whatever it refuses is
+     * left to PCRE alone.
+     */
+    unsigned int hs_flags = HS_FLAG_PREFILTER | HS_FLAG_DOTALL
+        | HS_FLAG_MULTILINE | HS_FLAG_SINGLEMATCH | HS_FLAG_ALLOWEMPTY;
+    hs_compile_error_t *hs_error = NULL;
+
+    if (ignoreCase) {
+        hs_flags |= HS_FLAG_CASELESS;
+    }
+#if WITH_PCRE2
+    bool decoded = false;
+    if (stored) {
+        m_hs = store->findHyperscan(key);
+        decoded = m_hs != NULL;
+    }
+#endif
+    if (m_hs == NULL && m_pc != NULL && hs_compile(pattern.c_str(), hs_flags,
+        HS_MODE_BLOCK, NULL, &m_hs, &hs_error) != HS_SUCCESS) {
+        hs_free_compile_error(hs_error);
+        m_hs = NULL;
+    }
+#if WITH_PCRE2
+    if (store != NULL && decoded == false && m_hs != NULL) {
+        store->add(key, m_hs);
+    }
+#endif
+#endif
+}
+
+
+void Regex::addFirstByte(unsigned int c, bool bothCases) {
+    m_firstBytes.set(c);
+    if (bothCases) {
+        m_firstBytes.set(tolower(c));
+        m_firstBytes.set(toupper(c));
+    }
+}
+
+
+/*
+ * Collects the start of match information that PCRE computed for its own
+ * start optimizations, see mayStartMatch().
+ */
+void Regex::computeStartInfo() {
+    if (m_pc == NULL) {
+        return;
+    }
+
+#if WITH_PCRE2
+    uint32_t minLength = 0;
+    uint32_t options = 0;
+    uint32_t firstType = 0;
+
+    if (pcre2_pattern_info(m_pc, PCRE2_INFO_MINLENGTH, &minLength) == 0) {
+        m_minLength = minLength;
+    }
+    if (pcre2_pattern_info(m_pc, PCRE2_INFO_ALLOPTIONS, &options) == 0) {
+        m_anchored = (options & PCRE2_ANCHORED) != 0;
+    }
+    if (m_minLength == 0
+        || pcre2_pattern_info(m_pc, PCRE2_INFO_FIRSTCODETYPE,
+            &firstType) != 0) {
+        return;
+    }
+
+    if (firstType == 1) {
+        uint32_t unit = 0;
+        pcre2_pattern_info(m_pc, PCRE2_INFO_FIRSTCODEUNIT, &unit);
+        /* the unit may be flagged as caseless, which is not reported */
+        if (unit < 128) {
+            addFirstByte(unit, true);
+        }
+    } else if (firstType == 0) {
+        const uint8_t *bitmap = NULL;
+        if (pcre2_pattern_info(m_pc, PCRE2_INFO_FIRSTBITMAP, &bitmap) == 0
+            && bitmap != NULL) {
+            for (unsigned int i = 0; i < 256; i++) {
+                if (bitmap[i / 8] & (1 << (i % 8))) {
+                    addFirstByte(i, false);
+                }
+            }
+        }
+    }
+#else
+    int minLength = -1;
+    unsigned long int options = 0;
+    int firstByte = -2;
+    const unsigned char *table = NULL;
+
+    if (pcre_fullinfo(m_pc, m_pce, PCRE_INFO_MINLENGTH, &minLength) == 0
+        && minLength > 0) {
+        m_minLength = minLength;
+    }
+    if (pcre_fullinfo(m_pc, m_pce, PCRE_INFO_OPTIONS, &options) == 0) {
+        m_anchored = (options & PCRE_ANCHORED) != 0;
+    }
+    if (m_minLength == 0) {
+        return;
+    }
+
+    if (pcre_fullinfo(m_pc, m_pce, PCRE_INFO_FIRSTBYTE, &firstByte) == 0
+        && firstByte >= 0) {
+        /* the byte may be flagged as caseless, which is not reported */
+        if (firstByte < 128) {
+            addFirstByte(firstByte, true);
+        }
+    } else if (pcre_fullinfo(m_pc, m_pce, PCRE_INFO_FIRSTTABLE,
+        &table) == 0 && table != NULL) {
+        for (unsigned int i = 0; i < 256; i++) {
+            if (table[i / 8] & (1 << (i % 8))) {
+                addFirstByte(i, false);
+            }
+        }
+    }
+#endif
+
+    /* one or two bytes, e.g. a caseless letter, are searched with SIMD */
+    std::string few;
+    for (unsigned int i = 0; i < 256 && few.size() <= 2; i++) {
+        if (m_firstBytes[i]) {
+            few.push_back(static_cast<char>(i));
+        }
+    }
+    if (few.size() == 1 || few.size() == 2) {
+        m_fewFirstBytes = true;
+        m_firstByteA = few.front();
+        m_firstByteB = few.back();
+    }
+}
+
+
+/*
+ * Left out of the constructor: only the expressions of the rules (see
+ * interned()) are worth a second compilation.
+ */
+void Regex::compileLinear(bool ignoreCase) {
+#ifdef WITH_RE2
+    std::string syntax;
+
+    if (m_pc == NULL || m_re2 != NULL
+        || linearSyntax(pattern, &syntax, &m_linearError) == false) {
+        return;
+    }
+
+    re2::RE2::Options options;
+    /* bytes, as PCRE sees them without the UTF option */
+    options.set_encoding(re2::RE2::Options::EncodingLatin1);
+    options.set_dot_nl(true);
+    options.set_case_sensitive(ignoreCase == false);
+    options.set_log_errors(false);
+
+    m_re2 = new re2::RE2(syntax, options);
+    if (m_re2->ok() == false) {
+        m_linearError = m_re2->error();
+        delete m_re2;
+        m_re2 = NULL;
+    }
+#endif
+}
+
+
+bool Regex::linear() const {
+#ifdef WITH_RE2
+    return m_re2 != NULL;
+#else
+    return false;
+#endif
+}
+
+
+std::string Regex::linearError() const {
+#ifdef WITH_RE2
+    return m_linearError;
+#else
+    return "ModSecurity was not compiled with RE2";
+#endif
+}
+
+
+std::string Regex::linearPattern() const {
+#ifdef WITH_RE2
+    if (m_re2 != NULL) {
+        return m_re2->pattern();
+    }
+#endif
+    return "";
 }
 
 
 Regex::~Regex() {
+#ifdef WITH_RE2
+    delete m_re2;
+    m_re2 = NULL;
+#endif
+#ifdef WITH_HYPERSCAN
+    if (m_hs != NULL) {
+        hs_free_database(m_hs);
+        m_hs = NULL;
+    }
+#endif
 #if WITH_PCRE2
+    pcre2_code_free(m_partial);
     pcre2_code_free(m_pc);
 #else
+#if PCRE_HAVE_JIT
+    if (m_pcePartial != NULL) {
+        pcre_free_study(m_pcePartial);
+        m_pcePartial = NULL;
+    }
+#endif
     if (m_pc != NULL) {
         pcre_free(m_pc);
         m_pc = NULL;
@@ -136,81 +674,204 @@ Regex::~Regex() {
 }
 
 
+#ifdef WITH_HYPERSCAN
+static int hyperscanOnMatch(unsigned int id, unsigned long long from,
+    unsigned long long to, unsigned int flags, void *ctx) {
+    *reinterpret_cast<bool *>(ctx) = true;
+    /* the first match is all we need to know */
+    return 1;
+}
+#endif
+
+
+/**
+ * Tells if the subject may be matched by the expression. A false answer is
+ * definitive, a true one has to be confirmed by the PCRE matcher.
+ *
+ */
+bool Regex::mayMatch(const std::string &s) const {
+    return mayMatch(s.c_str(), s.length());
+}
+
+
+bool Regex::mayMatch(const char *s, size_t len) const {
+#ifdef WITH_HYPERSCAN
+    if (m_hs == NULL) {
+        return true;
+    }
+
+    hs_scratch_t *scratch = hyperscanScratch(m_hs);
+    if (scratch == NULL) {
+        return true;
+    }
+
+    bool matched = false;
+    hs_error_t rc = hs_scan(m_hs, s, len, 0, scratch,
+        hyperscanOnMatch, &matched);
+    if (rc != HS_SUCCESS && rc != HS_SCAN_TERMINATED) {
+        return true;
+    }
+    return matched;
+#else
+    return true;
+#endif
+}
+
+
+std::string Regex::backend() const {
+#ifdef WITH_PCRE2
+    std::string pcre("pcre2");
+#else
+    std::string pcre("pcre");
+#endif
+#ifdef WITH_HYPERSCAN
+    if (m_hs != NULL) {
+        pcre = "hyperscan+" + pcre;
+    }
+#endif
+#ifdef WITH_RE2
+    if (m_re2 != NULL) {
+        pcre = "re2+" + pcre;
+    }
+#endif
+    return pcre;
+}
+
+
+bool Regex::jit() const {
+#if WITH_PCRE2
+    return m_pc != NULL && m_pcje == 0;
+#elif PCRE_HAVE_JIT
+    int jit = 0;
+    return m_pce != NULL
+        && pcre_fullinfo(m_pc, m_pce, PCRE_INFO_JIT, &jit) == 0 && jit != 0;
+#else
+    return false;
+#endif
+}
+
+
+size_t Regex::memoryUsage() const {
+    size_t bytes = sizeof(*this) + pattern.size();
+    size_t size = 0;
+
+    if (m_pc == NULL) {
+        return bytes;
+    }
+#if WITH_PCRE2
+    if (pcre2_pattern_info(m_pc, PCRE2_INFO_SIZE, &size) == 0) {
+        bytes += size;
+    }
+    if (m_pcje == 0 && pcre2_pattern_info(m_pc, PCRE2_INFO_JITSIZE,
+        &size) == 0) {
+        bytes += size;
+    }
+#else
+    if (pcre_fullinfo(m_pc, m_pce, PCRE_INFO_SIZE, &size) == 0) {
+        bytes += size;
+    }
+#if PCRE_HAVE_JIT
+    if (m_pce != NULL && pcre_fullinfo(m_pc, m_pce, PCRE_INFO_JITSIZE,
+        &size) == 0) {
+        bytes += size;
+    }
+#endif
+#endif
+#ifdef WITH_HYPERSCAN
+    if (m_hs != NULL && hs_database_size(m_hs, &size) == HS_SUCCESS) {
+        bytes += size;
+    }
+#endif
+    return bytes;
+}
+
+
 std::list<SMatch> Regex::searchAll(const std::string& s) const {
     std::list<SMatch> retList;
+    std::vector<SMatchCapture> captures;
+
+    searchAll(s.c_str(), s.length(), &captures);
+    for (const SMatchCapture &capture : captures) {
+        retList.push_front(SMatch(std::string(s, capture.m_offset,
+            capture.m_length), capture.m_offset));
+    }
+
+    return retList;
+}
+
+
+/**
+ * The groups of the successive matches over the len bytes at s, in the
+ * order they are found: the same as the std::string version, only as
+ * offsets and lengths, for the callers that do not need a copy of each.
+ * Like the std::string version, a search starts again at the end of the
+ * last group of the previous match. It stops at the first unset group
+ * and after the first empty one.
+ *
+ */
+void Regex::searchAll(const char *s, size_t len,
+    std::vector<SMatchCapture> *captures) const {
     int rc = 0;
+
+    if (mayMatch(s, len) == false) {
+        return;
+    }
 #ifdef WITH_PCRE2
-    PCRE2_SPTR pcre2_s = reinterpret_cast<PCRE2_SPTR>(s.c_str());
     PCRE2_SIZE offset = 0;
 
-    pcre2_match_data *match_data = pcre2_match_data_create_from_pattern(m_pc, NULL);
+    MatchResources &resources = matchResources();
+    pcre2_match_data *match_data = resources.data(m_captureCount + 1);
+    pcre2_match_context *match_context = resources.context(0);
     do {
-        if (m_pcje == 0) {
-            rc = pcre2_jit_match(m_pc, pcre2_s, s.length(),
-                            offset, 0, match_data, NULL);
-        } 
-        
-        if (m_pcje != 0 || rc == PCRE2_ERROR_JIT_STACKLIMIT) {
-            rc = pcre2_match(m_pc, pcre2_s, s.length(),
-                            offset, PCRE2_NO_JIT, match_data, NULL);
-        }
+        rc = execute(s, len, offset, 0, match_data, match_context);
         PCRE2_SIZE *ovector = pcre2_get_ovector_pointer(match_data);
 #else
-    const char *subject = s.c_str();
-    int ovector[OVECCOUNT];
+    int ovecsize = (m_captureCount + 1) * 3;
+    int *ovector = threadOvector(m_captureCount + 1);
     int offset = 0;
 
     do {
-        rc = pcre_exec(m_pc, m_pce, subject,
-            s.size(), offset, 0, ovector, OVECCOUNT);
+        rc = pcre_exec(m_pc, m_pce, s, len, offset, 0, ovector, ovecsize);
 #endif
         for (int i = 0; i < rc; i++) {
             size_t start = ovector[2*i];
             size_t end = ovector[2*i+1];
-            size_t len = end - start;
-            if (end > s.size()) {
+            size_t length = end - start;
+            if (end > len) {
                 rc = -1;
                 break;
             }
-            std::string match = std::string(s, start, len);
-            offset = start + len;
-            retList.push_front(SMatch(match, start));
+            offset = start + length;
+            captures->push_back(SMatchCapture(i, start, length));
 
-            if (len == 0) {
+            if (length == 0) {
                 rc = 0;
                 break;
             }
         }
     } while (rc > 0);
-
-#ifdef WITH_PCRE2
-    pcre2_match_data_free(match_data);
-#endif
-    return retList;
 }
 
-RegexResult Regex::searchOneMatch(const std::string& s, std::vector<SMatchCapture>& captures, unsigned long match_limit) const {
-#ifdef WITH_PCRE2
-    Pcre2MatchContextPtr match_context;
-    if (match_limit > 0) {
-        // TODO: What if setting the match limit fails?
-        pcre2_set_match_limit(match_context, match_limit);
+RegexResult Regex::searchOneMatch(const std::string& s, std::vector<SMatchCapture>& captures, unsigned long match_limit, bool linear, bool groups) const {
+    if (mayMatch(s) == false) {
+        return RegexResult::Ok;
     }
-
-    PCRE2_SPTR pcre2_s = reinterpret_cast<PCRE2_SPTR>(s.c_str());
-    pcre2_match_data *match_data = pcre2_match_data_create_from_pattern(m_pc, NULL);
-    int rc = 0;
-    if (m_pcje == 0) {
-        rc = pcre2_jit_match(m_pc, pcre2_s, s.length(), 0, 0, match_data, match_context);
-    } 
-    
-    if (m_pcje != 0 || rc == PCRE2_ERROR_JIT_STACKLIMIT) {
-        rc = pcre2_match(m_pc, pcre2_s, s.length(), 0, PCRE2_NO_JIT, match_data, match_context);
+#ifdef WITH_RE2
+    if (linear && m_re2 != NULL) {
+        return searchOneMatchLinear(s, &captures, groups);
     }
+#endif
+    uint32_t pairs = groups ? m_captureCount + 1 : 1;
+#ifdef WITH_PCRE2
+    MatchResources &resources = matchResources();
+    pcre2_match_data *match_data = groups
+        ? resources.data(pairs) : resources.overall();
+    int rc = execute(s.c_str(), s.length(), 0, 0, match_data,
+        resources.context(match_limit));
     PCRE2_SIZE *ovector = pcre2_get_ovector_pointer(match_data);
 #else
     const char *subject = s.c_str();
-    int ovector[OVECCOUNT];
+    int *ovector = threadOvector(pairs);
     pcre_extra local_pce;
     pcre_extra *pce = m_pce;
 
@@ -221,8 +882,13 @@ RegexResult Regex::searchOneMatch(const std::string& s, std::vector<SMatchCaptur
         pce = &local_pce;
     }
 
-    int rc = pcre_exec(m_pc, pce, subject, s.size(), 0, 0, ovector, OVECCOUNT);
+    int rc = pcre_exec(m_pc, pce, subject, s.size(), 0, 0, ovector,
+        pairs * 3);
 #endif
+    /* a match, with no room left for the groups */
+    if (rc == 0 && groups == false) {
+        rc = 1;
+    }
 
     for (int i = 0; i < rc; i++) {
         size_t start = ovector[2*i];
@@ -235,32 +901,32 @@ RegexResult Regex::searchOneMatch(const std::string& s, std::vector<SMatchCaptur
         captures.push_back(capture);
     }
 
-#ifdef WITH_PCRE2
-    pcre2_match_data_free(match_data);
-#endif
     return to_regex_result(rc);
 }
 
-RegexResult Regex::searchGlobal(const std::string& s, std::vector<SMatchCapture>& captures, unsigned long match_limit) const {
+RegexResult Regex::searchGlobal(const std::string& s, std::vector<SMatchCapture>& captures, unsigned long match_limit, bool linear) const {
     bool prev_match_zero_length = false;
-#ifdef WITH_PCRE2
-    Pcre2MatchContextPtr match_context;
-    if (match_limit > 0) {
-        // TODO: What if setting the match limit fails?
-        pcre2_set_match_limit(match_context, match_limit);
+    if (mayMatch(s) == false) {
+        return RegexResult::Ok;
     }
-
-    PCRE2_SPTR pcre2_s = reinterpret_cast<PCRE2_SPTR>(s.c_str());
+#ifdef WITH_RE2
+    if (linear && m_re2 != NULL) {
+        return searchGlobalLinear(s, &captures);
+    }
+#endif
+#ifdef WITH_PCRE2
     PCRE2_SIZE startOffset = 0;
 
-    pcre2_match_data *match_data = pcre2_match_data_create_from_pattern(m_pc, NULL);
+    MatchResources &resources = matchResources();
+    pcre2_match_data *match_data = resources.data(m_captureCount + 1);
+    pcre2_match_context *match_context = resources.context(match_limit);
     while (startOffset <= s.length()) {
         uint32_t pcre2_options = 0;
         if (prev_match_zero_length) {
             pcre2_options = PCRE2_NOTEMPTY_ATSTART | PCRE2_ANCHORED;
         }
-        int rc = pcre2_match(m_pc, pcre2_s, s.length(),
-                            startOffset, pcre2_options, match_data, match_context);
+        int rc = execute(s.c_str(), s.length(), startOffset, pcre2_options,
+            match_data, match_context);
         PCRE2_SIZE *ovector = pcre2_get_ovector_pointer(match_data);
 
 #else
@@ -277,13 +943,15 @@ RegexResult Regex::searchGlobal(const std::string& s, std::vector<SMatchCapture>
 
     int startOffset = 0;
 
+    int ovecsize = (m_captureCount + 1) * 3;
+    int *ovector = threadOvector(m_captureCount + 1);
+
     while (startOffset <= s.length()) {
-        int ovector[OVECCOUNT];
         int pcre_options = 0;
         if (prev_match_zero_length) {
             pcre_options = PCRE_NOTEMPTY_ATSTART | PCRE_ANCHORED;
         }
-        int rc = pcre_exec(m_pc, pce, subject, s.length(), startOffset, pcre_options, ovector, OVECCOUNT);
+        int rc = pcre_exec(m_pc, pce, subject, s.length(), startOffset, pcre_options, ovector, ovecsize);
 
         RegexResult regex_result = to_regex_result(rc);
         if (regex_result != RegexResult::Ok) {
@@ -337,32 +1005,123 @@ RegexResult Regex::searchGlobal(const std::string& s, std::vector<SMatchCapture>
         }
     }
 
-#ifdef WITH_PCRE2
-    pcre2_match_data_free(match_data);
-#endif
     return RegexResult::Ok;
 }
 
+#ifdef WITH_RE2
+/*
+ * As searchOneMatch and searchGlobal, with RE2. The groups that did not
+ * take part in the match are left out, as PCRE reports them unset.
+ */
+RegexResult Regex::searchOneMatchLinear(const std::string &s,
+    std::vector<SMatchCapture> *captures, bool groups) const {
+    size_t count = groups ? m_re2->NumberOfCapturingGroups() + 1 : 1;
+    std::vector<re2::StringPiece> &submatches = linearGroups(count);
+
+    if (m_re2->Match(s, 0, s.length(), re2::RE2::UNANCHORED,
+        submatches.data(), count) == false) {
+        return RegexResult::Ok;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (submatches[i].data() != NULL) {
+            captures->push_back(SMatchCapture(i,
+                submatches[i].data() - s.data(), submatches[i].size()));
+        }
+    }
+
+    return RegexResult::Ok;
+}
+
+
+/*
+ * RE2 can not be told to skip an empty match where one was just found,
+ * so the search goes on from the next byte (or the next two, past a
+ * CRLF newline) instead.
+ */
+RegexResult Regex::searchGlobalLinear(const std::string &s,
+    std::vector<SMatchCapture> *captures) const {
+    size_t count = m_re2->NumberOfCapturingGroups() + 1;
+    std::vector<re2::StringPiece> &groups = linearGroups(count);
+    size_t startOffset = 0;
+
+    while (startOffset <= s.length()
+        && m_re2->Match(s, startOffset, s.length(), re2::RE2::UNANCHORED,
+            groups.data(), count)) {
+        size_t firstGroupForThisFullMatch = captures->size();
+        for (size_t i = 0; i < count; i++) {
+            if (groups[i].data() != NULL) {
+                captures->push_back(SMatchCapture(
+                    firstGroupForThisFullMatch + i,
+                    groups[i].data() - s.data(), groups[i].size()));
+            }
+        }
+
+        size_t end = groups[0].data() - s.data() + groups[0].size();
+        if (groups[0].size() > 0) {
+            startOffset = end;
+            continue;
+        }
+        startOffset = end + 1;
+        if (crlfIsNewline() && startOffset < s.length()
+            && s[startOffset - 1] == '\r' && s[startOffset] == '\n') {
+            startOffset++;
+        }
+    }
+
+    return RegexResult::Ok;
+}
+#endif
+
+
+/**
+ * Tells, without running any matcher, if the subject is long enough and
+ * has a byte where a match may start. A false answer is definitive; this
+ * is what PCRE checks first on its own, minus the setup of the match.
+ *
+ */
+bool Regex::mayStartMatch(const std::string &s) const {
+    if (s.length() < m_minLength) {
+        return false;
+    }
+    if (m_firstBytes.none()) {
+        return true;
+    }
+
+    if (m_anchored) {
+        return m_firstBytes[static_cast<unsigned char>(s[0])];
+    }
+
+    /* a match can not start closer than m_minLength to the end */
+    size_t len = s.length() - m_minLength + 1;
+    if (m_fewFirstBytes) {
+        return utils::scan::findEither(s.data(), len, m_firstByteA,
+            m_firstByteB) < len;
+    }
+    for (size_t i = 0; i < len; i++) {
+        if (m_firstBytes[static_cast<unsigned char>(s[i])]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
 int Regex::search(const std::string& s, SMatch *match) const {
-#ifdef WITH_PCRE2
-    PCRE2_SPTR pcre2_s = reinterpret_cast<PCRE2_SPTR>(s.c_str());
-    pcre2_match_data *match_data = pcre2_match_data_create_from_pattern(m_pc, NULL);
-    int ret = 0;
-    if (m_pcje == 0) {
-        ret = pcre2_match(m_pc, pcre2_s, s.length(),
-            0, 0, match_data, NULL) > 0;
-    } 
-    
-    if (m_pcje != 0 || ret == PCRE2_ERROR_JIT_STACKLIMIT) {
-        ret = pcre2_match(m_pc, pcre2_s, s.length(),
-            0, PCRE2_NO_JIT, match_data, NULL) > 0;
+    if (mayMatch(s) == false) {
+        return 0;
     }
+    /* only the overall match is asked for: 0 when there are groups */
+#ifdef WITH_PCRE2
+    MatchResources &resources = matchResources();
+    pcre2_match_data *match_data = resources.overall();
+    int ret = execute(s.c_str(), s.length(), 0, 0, match_data,
+        resources.context(0)) >= 0;
     if (ret > 0) { // match
         PCRE2_SIZE *ovector = pcre2_get_ovector_pointer(match_data);
 #else
-    int ovector[OVECCOUNT];
+    int ovector[3];
     int ret = pcre_exec(m_pc, m_pce, s.c_str(),
-        s.size(), 0, 0, ovector, OVECCOUNT) > 0;
+        s.size(), 0, 0, ovector, 3) >= 0;
 
     if (ret > 0) {
 #endif
@@ -371,37 +1130,142 @@ int Regex::search(const std::string& s, SMatch *match) const {
             0);
     }
 
-#ifdef WITH_PCRE2
-    pcre2_match_data_free(match_data);
-#endif
     return ret;
 }
 
 int Regex::search(const std::string& s) const {
-#ifdef WITH_PCRE2
-    PCRE2_SPTR pcre2_s = reinterpret_cast<PCRE2_SPTR>(s.c_str());
-    pcre2_match_data *match_data = pcre2_match_data_create_from_pattern(m_pc, NULL);
-    int rc = 0;
-    if (m_pcje == 0) {
-        rc = pcre2_jit_match(m_pc, pcre2_s, s.length(), 0, 0, match_data, NULL);
-    }
-
-    if (m_pcje != 0 || rc == PCRE2_ERROR_JIT_STACKLIMIT) {
-        rc = pcre2_match(m_pc, pcre2_s, s.length(), 0, PCRE2_NO_JIT, match_data, NULL);
+    if (mayMatch(s) == false) {
+        return 0;
     }
-    pcre2_match_data_free(match_data);
-    if (rc > 0) {
+    /* only the overall match is asked for: 0 when there are groups */
+#ifdef WITH_PCRE2
+    MatchResources &resources = matchResources();
+    int rc = execute(s.c_str(), s.length(), 0, 0,
+        resources.overall(), resources.context(0));
+    if (rc >= 0) {
         return 1; // match
     } else {
         return 0; // no match
     }
 #else
-    int ovector[OVECCOUNT];
+    int ovector[3];
     return pcre_exec(m_pc, m_pce, s.c_str(),
-        s.size(), 0, 0, ovector, OVECCOUNT) > 0;
+        s.size(), 0, 0, ovector, 3) >= 0;
+#endif
+}
+
+#ifdef WITH_PCRE2
+/*
+ * Runs the JIT code straight away when there is one, the interpreter
+ * otherwise. The interpreter also takes over when the JIT stack is too
+ * small, or for an option the JIT code was not compiled for (anchoring).
+ */
+int Regex::execute(const char *s, size_t len, size_t offset,
+    uint32_t options, pcre2_match_data *match_data,
+    pcre2_match_context *match_context) const {
+    PCRE2_SPTR subject = reinterpret_cast<PCRE2_SPTR>(s);
+    int rc = PCRE2_ERROR_JIT_BADOPTION;
+
+    if (m_pcje == 0 && (options & PCRE2_ANCHORED) == 0) {
+        rc = pcre2_jit_match(m_pc, subject, len, offset, options,
+            match_data, match_context);
+    }
+    if (rc == PCRE2_ERROR_JIT_BADOPTION || rc == PCRE2_ERROR_JIT_STACKLIMIT) {
+        rc = pcre2_match(m_pc, subject, len, offset,
+            options | PCRE2_NO_JIT, match_data, match_context);
+    }
+
+    return rc;
+}
+#endif
+
+
+void Regex::compilePartial() const {
+    std::call_once(m_partialOnce, [this]() {
+        if (m_pc == NULL) {
+            return;
+        }
+#if WITH_PCRE2
+        m_partial = pcre2_code_copy(m_pc);
+        if (m_partial != NULL) {
+            m_partialJit = pcre2_jit_compile(m_partial,
+                PCRE2_JIT_COMPLETE | PCRE2_JIT_PARTIAL_HARD);
+        }
+#elif PCRE_HAVE_JIT
+        const char *errptr = NULL;
+        m_pcePartial = pcre_study(m_pc, PCRE_STUDY_JIT_COMPILE
+            | PCRE_STUDY_JIT_PARTIAL_HARD_COMPILE | PCRE_STUDY_EXTRA_NEEDED,
+            &errptr);
+        if (m_pcePartial != NULL) {
+            pcre_assign_jit_stack(m_pcePartial, threadJitStack, NULL);
+        }
 #endif
+    });
 }
 
+
+int Regex::matchPart(const char *s, size_t len, size_t offset,
+    bool notBol, bool partial, unsigned long match_limit,
+    std::vector<size_t> *ovector) const {
+    compilePartial();
+
+#if WITH_PCRE2
+    const pcre2_code *code = m_partial != NULL ? m_partial : m_pc;
+    PCRE2_SPTR subject = reinterpret_cast<PCRE2_SPTR>(s);
+    MatchResources &resources = matchResources();
+    pcre2_match_data *match_data = resources.data(m_captureCount + 1);
+    pcre2_match_context *match_context = resources.context(match_limit);
+    uint32_t options = (notBol ? PCRE2_NOTBOL : 0)
+        | (partial ? PCRE2_PARTIAL_HARD : 0);
+    int rc = PCRE2_ERROR_JIT_BADOPTION;
+
+    if (m_partial != NULL && m_partialJit == 0) {
+        rc = pcre2_jit_match(code, subject, len, offset, options,
+            match_data, match_context);
+    }
+    if (rc == PCRE2_ERROR_JIT_BADOPTION || rc == PCRE2_ERROR_JIT_STACKLIMIT) {
+        rc = pcre2_match(code, subject, len, offset, options | PCRE2_NO_JIT,
+            match_data, match_context);
+    }
+
+    PCRE2_SIZE *pairs = pcre2_get_ovector_pointer(match_data);
+    int count = rc > 0 ? rc : (rc == PCRE2_ERROR_PARTIAL ? 1 : 0);
+    ovector->clear();
+    for (int i = 0; i < count; i++) {
+        ovector->push_back(pairs[2 * i] == PCRE2_UNSET ? SIZE_MAX
+            : pairs[2 * i]);
+        ovector->push_back(pairs[2 * i] == PCRE2_UNSET ? SIZE_MAX
+            : pairs[2 * i + 1]);
+    }
+#else
+    pcre_extra local_pce;
+    pcre_extra *pce = m_pcePartial != NULL ? m_pcePartial : m_pce;
+    int *pairs = threadOvector(m_captureCount + 1);
+    int options = (notBol ? PCRE_NOTBOL : 0)
+        | (partial ? PCRE_PARTIAL_HARD : 0);
+
+    if (pce != NULL && match_limit > 0) {
+        local_pce = *pce;
+        local_pce.match_limit = match_limit;
+        local_pce.flags |= PCRE_EXTRA_MATCH_LIMIT;
+        pce = &local_pce;
+    }
+
+    int rc = pcre_exec(m_pc, pce, s, len, offset, options, pairs,
+        (m_captureCount + 1) * 3);
+
+    int count = rc > 0 ? rc : (rc == PCRE_ERROR_PARTIAL ? 1 : 0);
+    ovector->clear();
+    for (int i = 0; i < count; i++) {
+        ovector->push_back(pairs[2 * i] < 0 ? SIZE_MAX : pairs[2 * i]);
+        ovector->push_back(pairs[2 * i] < 0 ? SIZE_MAX : pairs[2 * i + 1]);
+    }
+#endif
+
+    return rc;
+}
+
+
 RegexResult Regex::to_regex_result(int pcre_exec_result) const {
     if (
         pcre_exec_result > 0 ||
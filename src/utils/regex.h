@@ -19,20 +19,30 @@
 #include <pcre.h>
 #endif
 
+#include <bitset>
 #include <iostream>
 #include <fstream>
 #include <string>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <vector>
 
+#include "src/utils/hyperscan.h"
+
 #ifndef SRC_UTILS_REGEX_H_
 #define SRC_UTILS_REGEX_H_
 
+#ifdef WITH_RE2
+namespace re2 {
+class RE2;
+}  // namespace re2
+#endif
 
 namespace modsecurity {
 namespace Utils {
 
-#define OVECCOUNT 900
+class RegexStore;
 
 enum class RegexResult {
     Ok,
@@ -71,25 +81,134 @@ struct SMatchCapture {
 
 class Regex {
  public:
-    explicit Regex(const std::string& pattern_, bool ignoreCase = false);
+    explicit Regex(const std::string& pattern_, bool ignoreCase = false,
+        RegexStore *store = NULL);
     ~Regex();
 
     // m_pc and m_pce can't be easily copied
     Regex(const Regex&) = delete;
     Regex& operator=(const Regex&) = delete;
 
+    /*
+     * The compiled form of pattern shared by everything that asked for
+     * the same one (see InternedPatterns). These are the ones compiled
+     * for RE2 as well, see linear().
+     */
+    static std::shared_ptr<Regex> interned(const std::string &pattern,
+        bool ignoreCase = false, RegexStore *store = NULL);
+
     bool hasError() const {
         return (m_pc == NULL);
     }
     std::list<SMatch> searchAll(const std::string& s) const;
-    RegexResult searchOneMatch(const std::string& s, std::vector<SMatchCapture>& captures, unsigned long match_limit = 0) const;
-    RegexResult searchGlobal(const std::string& s, std::vector<SMatchCapture>& captures, unsigned long match_limit = 0) const;
+    void searchAll(const char *s, size_t len,
+        std::vector<SMatchCapture> *captures) const;
+    /*
+     * linear asks for RE2 (see SecRxRe2), which the expression runs with
+     * if linear() says it can; match_limit is for PCRE only. Without
+     * groups, only the overall match is asked for (and reported), which
+     * spares the matcher the bookkeeping of the groups.
+     */
+    RegexResult searchOneMatch(const std::string& s, std::vector<SMatchCapture>& captures, unsigned long match_limit = 0, bool linear = false, bool groups = true) const;
+    RegexResult searchGlobal(const std::string& s, std::vector<SMatchCapture>& captures, unsigned long match_limit = 0, bool linear = false) const;
     int search(const std::string &s, SMatch *match) const;
     int search(const std::string &s) const;
 
+    /*
+     * Largest JIT stack a thread runs the (JIT compiled) expressions
+     * with, see SecPcreJitStackSize. 0 goes back to the default.
+     */
+    static void setJitStackSize(size_t size);
+    static const size_t kDefaultJitStackSize = 1024 * 1024;
+
+    bool mayMatch(const std::string &s) const;
+    bool mayMatch(const char *s, size_t len) const;
+    bool mayStartMatch(const std::string &s) const;
+    std::string backend() const;
+    /* Whether PCRE runs the expression as JIT compiled code. */
+    bool jit() const;
+    /* Bytes of the compiled expression, JIT code and prefilter included. */
+    size_t memoryUsage() const;
+
+    /*
+     * Whether RE2, whose matching time is linear in the length of the
+     * subject, can run the expression. When it can not (back references,
+     * look-arounds, ...) linearError() tells why, and PCRE is used.
+     */
+    bool linear() const;
+    std::string linearError() const;
+    /* The expression as RE2 has it, empty unless linear(). */
+    std::string linearPattern() const;
+
+    /*
+     * Readies what RegexStream matches with: the expression JIT compiled
+     * for partial matching too, as a code of its own, as the JIT code of
+     * the other one may be in use by other threads. Done once, whatever
+     * the thread; the rules sets ask for it when they are loaded.
+     */
+    void compilePartial() const;
+
     const std::string pattern;
  private:
+    friend class RegexStream;
+
     RegexResult to_regex_result(int pcre_exec_result) const;
+    /*
+     * One attempt of RegexStream from offset, with PARTIAL_HARD when
+     * partial. ovector gets the start and end of each group, SIZE_MAX
+     * for those left unset; for a partial match, where it starts and
+     * where the subject ends. Returns what PCRE did.
+     */
+    int matchPart(const char *s, size_t len, size_t offset, bool notBol,
+        bool partial, unsigned long match_limit,
+        std::vector<size_t> *ovector) const;
+#if WITH_PCRE2
+    int execute(const char *s, size_t len, size_t offset, uint32_t options,
+        pcre2_match_data *match_data,
+        pcre2_match_context *match_context) const;
+#endif
+    void computeStartInfo();
+    void addFirstByte(unsigned int c, bool bothCases);
+    void compileLinear(bool ignoreCase);
+    static std::string storeKey(const std::string &pattern, bool ignoreCase);
+    void keepIn(RegexStore *store, bool ignoreCase) const;
+#ifdef WITH_RE2
+    RegexResult searchOneMatchLinear(const std::string &s,
+        std::vector<SMatchCapture> *captures, bool groups) const;
+    RegexResult searchGlobalLinear(const std::string &s,
+        std::vector<SMatchCapture> *captures) const;
+#endif
+
+    /*
+     * What PCRE knows about the start of any match: its minimum length,
+     * whether it is anchored to the start of the subject and the set of
+     * bytes it can begin with (empty when unknown). When there are one or
+     * two of them they are also kept apart, for a faster search.
+     */
+    size_t m_minLength;
+    bool m_anchored;
+    std::bitset<256> m_firstBytes;
+    bool m_fewFirstBytes;
+    char m_firstByteA;
+    char m_firstByteB;
+
+#ifdef WITH_HYPERSCAN
+    /*
+     * Prefilter database: matches (at least) everything that the PCRE
+     * expression matches, it is used to skip the real matcher when the
+     * subject has no chance to match.
+     */
+    hs_database_t *m_hs;
+#endif
+
+#ifdef WITH_RE2
+    /* NULL until compileLinear() and when RE2 refused the expression. */
+    re2::RE2 *m_re2;
+    std::string m_linearError;
+#endif
+
+    /* as the pattern has them, sizes the offsets vectors */
+    uint32_t m_captureCount;
 
 #if WITH_PCRE2
     pcre2_code *m_pc;
@@ -98,6 +217,15 @@ class Regex {
     pcre *m_pc = NULL;
     pcre_extra *m_pce = NULL;
 #endif
+
+    /* see compilePartial() */
+    mutable std::once_flag m_partialOnce;
+#if WITH_PCRE2
+    mutable pcre2_code *m_partial = NULL;
+    mutable int m_partialJit = PCRE2_ERROR_JIT_BADOPTION;
+#else
+    mutable pcre_extra *m_pcePartial = NULL;
+#endif
 };
 
 
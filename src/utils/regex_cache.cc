@@ -0,0 +1,139 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/regex_cache.h"
+
+#include <pthread.h>
+
+#include <memory>
+#include <string>
+
+#include "src/utils/regex.h"
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+RegexCache::RegexCache(size_t capacity)
+    : m_capacity(capacity > 0 ? capacity : 1),
+    m_hits(0),
+    m_misses(0),
+    m_evictions(0) {
+    m_index.reserve(m_capacity);
+    pthread_mutex_init(&m_lock, NULL);
+}
+
+
+RegexCache::~RegexCache() {
+    m_index.clear();
+    m_entries.clear();
+    pthread_mutex_destroy(&m_lock);
+}
+
+
+/**
+ * Returns the compiled form of pattern, compiling it on a miss. Patterns
+ * that fail to compile are cached as well, the caller is expected to check
+ * hasError() as it would on a fresh Regex.
+ *
+ */
+std::shared_ptr<Regex> RegexCache::get(const std::string &pattern) {
+    pthread_mutex_lock(&m_lock);
+    auto it = m_index.find(pattern);
+    if (it != m_index.end()) {
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        std::shared_ptr<Regex> re = it->second->second;
+        m_hits++;
+        pthread_mutex_unlock(&m_lock);
+        return re;
+    }
+    m_misses++;
+    pthread_mutex_unlock(&m_lock);
+
+    /*
+     * Compilation (and JIT) is what we are trying to save; it is done
+     * without holding the lock so a miss does not stall every other thread.
+     */
+    std::shared_ptr<Regex> re = std::make_shared<Regex>(pattern);
+
+    pthread_mutex_lock(&m_lock);
+    it = m_index.find(pattern);
+    if (it != m_index.end()) {
+        /* someone else compiled it in the meantime */
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        re = it->second->second;
+        pthread_mutex_unlock(&m_lock);
+        return re;
+    }
+
+    if (m_entries.size() >= m_capacity) {
+        m_index.erase(m_entries.back().first);
+        m_entries.pop_back();
+        m_evictions++;
+    }
+    m_entries.emplace_front(pattern, re);
+    m_index[pattern] = m_entries.begin();
+    pthread_mutex_unlock(&m_lock);
+
+    return re;
+}
+
+
+size_t RegexCache::size() {
+    pthread_mutex_lock(&m_lock);
+    size_t s = m_entries.size();
+    pthread_mutex_unlock(&m_lock);
+    return s;
+}
+
+
+size_t RegexCache::memoryUsage() {
+    size_t bytes = 0;
+    pthread_mutex_lock(&m_lock);
+    for (const Entry &e : m_entries) {
+        bytes += 2 * e.first.size() + e.second->memoryUsage();
+    }
+    pthread_mutex_unlock(&m_lock);
+    return bytes;
+}
+
+
+size_t RegexCache::hits() {
+    pthread_mutex_lock(&m_lock);
+    size_t s = m_hits;
+    pthread_mutex_unlock(&m_lock);
+    return s;
+}
+
+
+size_t RegexCache::misses() {
+    pthread_mutex_lock(&m_lock);
+    size_t s = m_misses;
+    pthread_mutex_unlock(&m_lock);
+    return s;
+}
+
+
+size_t RegexCache::evictions() {
+    pthread_mutex_lock(&m_lock);
+    size_t s = m_evictions;
+    pthread_mutex_unlock(&m_lock);
+    return s;
+}
+
+
+}  // namespace Utils
+}  // namespace modsecurity
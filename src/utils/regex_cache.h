@@ -0,0 +1,86 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <pthread.h>
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "src/utils/regex.h"
+
+#ifndef SRC_UTILS_REGEX_CACHE_H_
+#define SRC_UTILS_REGEX_CACHE_H_
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+/**
+ * Bounded LRU of compiled regular expressions, keyed by the pattern.
+ *
+ * Used by @rx and @rxGlobal when the parameter contains macros: the
+ * expanded pattern tends to be the same over and over (e.g.
+ * %{tx.allowed_methods}), so there is no point in compiling it on every
+ * evaluation. A RulesSet owns one, shared by all its transactions and
+ * therefore by all the threads inspecting them.
+ *
+ * Entries are handed out as shared pointers, so an eviction never pulls a
+ * Regex from under a caller that is still using it.
+ *
+ */
+class RegexCache {
+ public:
+    static const size_t kDefaultCapacity = 256;
+
+    explicit RegexCache(size_t capacity = kDefaultCapacity);
+    ~RegexCache();
+
+    RegexCache(const RegexCache&) = delete;
+    RegexCache& operator=(const RegexCache&) = delete;
+
+    std::shared_ptr<Regex> get(const std::string &pattern);
+
+    size_t capacity() const { return m_capacity; }
+    size_t size();
+    size_t hits();
+    size_t misses();
+    size_t evictions();
+    /* Bytes held by the cached expressions (see Regex::memoryUsage). */
+    size_t memoryUsage();
+
+ private:
+    typedef std::pair<std::string, std::shared_ptr<Regex>> Entry;
+
+    size_t m_capacity;
+    size_t m_hits;
+    size_t m_misses;
+    size_t m_evictions;
+
+    /* most recently used first */
+    std::list<Entry> m_entries;
+    std::unordered_map<std::string, std::list<Entry>::iterator> m_index;
+    pthread_mutex_t m_lock;
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_REGEX_CACHE_H_
@@ -0,0 +1,257 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/regex_lint.h"
+
+#include <ctype.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+
+namespace modsecurity {
+namespace Utils {
+
+namespace {
+
+const char *kMetaCharacters = ".^$|?*+()[]{}\\";
+
+
+/*
+ * Length of the quantifier at pos (0 if there is none); unbounded is set
+ * when it has no upper limit and possessive when it ends with a +.
+ */
+size_t quantifier(const std::string &p, size_t pos, bool *unbounded,
+    bool *possessive) {
+    size_t len = 0;
+
+    *unbounded = false;
+    *possessive = false;
+    if (pos >= p.size()) {
+        return 0;
+    }
+    if (p[pos] == '*' || p[pos] == '+') {
+        *unbounded = true;
+        len = 1;
+    } else if (p[pos] == '?') {
+        len = 1;
+    } else if (p[pos] == '{') {
+        size_t end = p.find('}', pos);
+        if (end == std::string::npos) {
+            return 0;
+        }
+        std::string bounds(p, pos + 1, end - pos - 1);
+        if (bounds.empty() || !isdigit(bounds[0])
+            || bounds.find_first_not_of("0123456789,") != std::string::npos) {
+            return 0;
+        }
+        *unbounded = bounds.back() == ',';
+        len = end - pos + 1;
+    } else {
+        return 0;
+    }
+
+    if (pos + len < p.size() && p[pos + len] == '+') {
+        *possessive = true;
+        len++;
+    } else if (pos + len < p.size() && p[pos + len] == '?') {
+        len++;
+    }
+    return len;
+}
+
+
+/* Position right after the character class that starts at pos. */
+size_t skipClass(const std::string &p, size_t pos) {
+    size_t i = pos + 1;
+    if (i < p.size() && p[i] == '^') {
+        i++;
+    }
+    if (i < p.size() && p[i] == ']') {
+        i++;
+    }
+    while (i < p.size() && p[i] != ']') {
+        if (p[i] == '\\') {
+            i++;
+        } else if (p[i] == '[' && i + 1 < p.size() && p[i + 1] == ':') {
+            size_t end = p.find(":]", i + 2);
+            if (end != std::string::npos) {
+                i = end + 1;
+            }
+        }
+        i++;
+    }
+    return i + 1;
+}
+
+
+/*
+ * The text of an alternative when it only has literal characters (escaped
+ * punctuation included), false otherwise.
+ */
+bool literal(const std::string &p, std::string *out) {
+    out->clear();
+    for (size_t i = 0; i < p.size(); i++) {
+        if (p[i] == '\\') {
+            if (i + 1 >= p.size() || isalnum(p[i + 1])) {
+                return false;
+            }
+            out->push_back(p[++i]);
+        } else if (strchr(kMetaCharacters, p[i]) != NULL) {
+            return false;
+        } else {
+            out->push_back(p[i]);
+        }
+    }
+    return !out->empty();
+}
+
+
+}  // namespace
+
+
+bool RegexLint::nestedQuantifier(const std::string &p, std::string *group) {
+    struct Frame {
+        size_t start;
+        bool atomic;
+        bool unbounded;
+    };
+    std::vector<Frame> frames(1, Frame{0, false, false});
+    size_t i = 0;
+
+    while (i < p.size()) {
+        size_t atom = i;
+        bool closed = false;
+        Frame inner{0, false, false};
+
+        if (p[i] == '\\') {
+            if (i + 1 < p.size() && p[i + 1] == 'Q') {
+                size_t end = p.find("\\E", i + 2);
+                i = end == std::string::npos ? p.size() : end + 2;
+                continue;
+            }
+            i += 2;
+        } else if (p[i] == '[') {
+            i = skipClass(p, i);
+        } else if (p[i] == '(') {
+            bool atomic = p.compare(i, 3, "(?>") == 0;
+            frames.push_back(Frame{i, atomic, false});
+            i++;
+            continue;
+        } else if (p[i] == ')') {
+            if (frames.size() == 1) {
+                return false;
+            }
+            inner = frames.back();
+            frames.pop_back();
+            atom = inner.start;
+            closed = true;
+            i++;
+        } else {
+            i++;
+        }
+
+        bool unbounded;
+        bool possessive;
+        size_t len = quantifier(p, i, &unbounded, &possessive);
+        if (closed && unbounded && !possessive && inner.unbounded
+            && !inner.atomic) {
+            group->assign(p, atom, i + len - atom);
+            return true;
+        }
+        if ((unbounded && !possessive) || (closed && inner.unbounded
+            && !inner.atomic)) {
+            frames.back().unbounded = true;
+        }
+        i += len;
+    }
+
+    return false;
+}
+
+
+bool RegexLint::literalOperator(const std::string &pattern,
+    std::string *op, std::string *param, bool *caseless) {
+    std::string p(pattern);
+    bool start = false;
+    bool end = false;
+
+    *caseless = false;
+    if (p.compare(0, 4, "(?i)") == 0) {
+        *caseless = true;
+        p.erase(0, 4);
+    }
+    if (!p.empty() && p[0] == '^') {
+        start = true;
+        p.erase(0, 1);
+    }
+    if (p.size() > 1 && p.back() == '$' && p[p.size() - 2] != '\\') {
+        end = true;
+        p.pop_back();
+    }
+    if (p.compare(0, 3, "(?:") == 0 && p.back() == ')'
+        && p.find_first_of("()", 3) == p.size() - 1) {
+        p = p.substr(3, p.size() - 4);
+    }
+
+    std::vector<std::string> alternatives;
+    size_t from = 0;
+    for (size_t i = 0; i <= p.size(); i++) {
+        if (i < p.size() && p[i] == '\\') {
+            i++;
+        } else if (i == p.size() || p[i] == '|') {
+            std::string text;
+            if (!literal(p.substr(from, i - from), &text)) {
+                return false;
+            }
+            alternatives.push_back(text);
+            from = i + 1;
+        }
+    }
+
+    if (alternatives.size() == 1 && !*caseless) {
+        *param = alternatives[0];
+        if (start && end) {
+            *op = "@streq";
+        } else if (start) {
+            *op = "@beginsWith";
+        } else if (end) {
+            *op = "@endsWith";
+        } else {
+            *op = "@contains";
+        }
+        return true;
+    }
+
+    /* @pm is case insensitive and looks anywhere in the subject. */
+    if (start || end) {
+        return false;
+    }
+    param->clear();
+    *op = "@pm";
+    for (const std::string &a : alternatives) {
+        /* Its parameter is split on spaces, a file has one per line. */
+        if (a.find(' ') != std::string::npos) {
+            *op = "@pmFromFile";
+        }
+        param->append((param->empty() ? "" : " ") + a);
+    }
+    return true;
+}
+
+
+}  // namespace Utils
+}  // namespace modsecurity
@@ -0,0 +1,60 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <string>
+
+#ifndef SRC_UTILS_REGEX_LINT_H_
+#define SRC_UTILS_REGEX_LINT_H_
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+/**
+ * Load time remarks on the cost of a regular expression, for rules-check
+ * -p. Both checks are a best effort over the PCRE syntax: a pattern they
+ * do not understand gets no remark.
+ *
+ */
+class RegexLint {
+ public:
+    /**
+     * Whether an unbounded quantifier applies to a group that has one of
+     * its own, e.g. (a+)+ or (?:\w*\s?)*: a subject that almost matches
+     * then takes exponential time to fail. Atomic groups and possessive
+     * quantifiers are not reported. group is set to the culprit.
+     */
+    static bool nestedQuantifier(const std::string &pattern,
+        std::string *group);
+
+    /**
+     * Whether the pattern is plain text, or alternatives of plain text,
+     * that another operator matches without a regex engine. op is set to
+     * the operator (with its @) and param to what it would be given, the
+     * phrases apart by spaces for @pm and @pmFromFile. Those two ignore
+     * case, caseless tells whether the expression did as well. ^ and $
+     * are taken for the ends of the subject, which they are as long as
+     * it is a single line.
+     */
+    static bool literalOperator(const std::string &pattern,
+        std::string *op, std::string *param, bool *caseless);
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_REGEX_LINT_H_
@@ -0,0 +1,385 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/regex_store.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "src/utils/allocator.h"
+
+
+namespace modsecurity {
+namespace Utils {
+
+namespace {
+
+const char kMagic[8] = {'M', 'S', 'C', 'R', 'X', 'C', '2', '\0'};
+
+
+void putU32(std::string *out, uint32_t v) {
+    out->append(reinterpret_cast<const char *>(&v), sizeof(v));
+}
+
+
+void putU64(std::string *out, uint64_t v) {
+    out->append(reinterpret_cast<const char *>(&v), sizeof(v));
+}
+
+
+bool getU64(const std::string &data, size_t *pos, uint64_t *v) {
+    if (data.size() - *pos < sizeof(*v)) {
+        return false;
+    }
+    memcpy(v, data.data() + *pos, sizeof(*v));
+    *pos += sizeof(*v);
+    return true;
+}
+
+
+bool getU32(const std::string &data, size_t *pos, uint32_t *v) {
+    if (data.size() - *pos < sizeof(*v)) {
+        return false;
+    }
+    memcpy(v, data.data() + *pos, sizeof(*v));
+    *pos += sizeof(*v);
+    return true;
+}
+
+
+bool getBytes(const std::string &data, size_t *pos, uint32_t len,
+    std::string *out) {
+    if (data.size() - *pos < len) {
+        return false;
+    }
+    out->assign(data, *pos, len);
+    *pos += len;
+    return true;
+}
+
+}  // namespace
+
+
+RegexStore::RegexStore()
+    : m_stored(0),
+    m_dirty(false),
+    m_hits(0),
+    m_misses(0) {
+    pthread_mutex_init(&m_lock, NULL);
+}
+
+
+RegexStore::~RegexStore() {
+    pthread_mutex_destroy(&m_lock);
+}
+
+
+std::string RegexStore::tag() {
+    std::string t;
+#if WITH_PCRE2
+    t.append("pcre2 " + std::to_string(PCRE2_MAJOR) + "."
+        + std::to_string(PCRE2_MINOR));
+#endif
+#ifdef WITH_HYPERSCAN
+    t.append(" hyperscan ");
+    t.append(hs_version());
+#endif
+    t.append(" " + std::to_string(sizeof(void *) * 8) + " bits");
+    return t;
+}
+
+
+/* FNV-1a, 64 bits */
+uint64_t RegexStore::checksum(const char *data, size_t len) {
+    uint64_t h = 14695981039346656037ULL;
+    for (size_t i = 0; i < len; i++) {
+        h ^= static_cast<unsigned char>(data[i]);
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+
+bool RegexStore::open(const std::string &path, std::string *error) {
+#if WITH_PCRE2
+    pthread_mutex_lock(&m_lock);
+    if (path == m_path) {
+        pthread_mutex_unlock(&m_lock);
+        return true;
+    }
+
+    m_entries.clear();
+    m_used.clear();
+    m_stored = 0;
+    m_dirty = false;
+    m_path.clear();
+
+    if (access(path.c_str(), F_OK) == 0) {
+        std::ifstream f(path, std::ios::in | std::ios::binary);
+        if (f.is_open() == false) {
+            error->assign("Failed to open the regex cache file: " + path);
+            pthread_mutex_unlock(&m_lock);
+            return false;
+        }
+        std::string data((std::istreambuf_iterator<char>(f)),
+            std::istreambuf_iterator<char>());
+        /* A file we can not use is just not there, save() replaces it. */
+        if (load(data) == false) {
+            m_entries.clear();
+        }
+        m_stored = m_entries.size();
+    }
+
+    m_path = path;
+    pthread_mutex_unlock(&m_lock);
+#endif
+    return true;
+}
+
+
+bool RegexStore::load(const std::string &data) {
+    std::string t;
+    size_t pos = sizeof(kMagic);
+    uint32_t len;
+    uint32_t count;
+
+    if (data.size() < sizeof(kMagic)
+        || memcmp(data.data(), kMagic, sizeof(kMagic)) != 0) {
+        return false;
+    }
+    uint64_t sum;
+
+    if (getU32(data, &pos, &len) == false
+        || getBytes(data, &pos, len, &t) == false || t != tag()) {
+        return false;
+    }
+    if (getU64(data, &pos, &sum) == false
+        || sum != checksum(data.data() + pos, data.size() - pos)) {
+        return false;
+    }
+    if (getU32(data, &pos, &count) == false) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t keyLen, pcreLen, hsLen;
+        std::string key;
+        Entry e;
+
+        if (getU32(data, &pos, &keyLen) == false
+            || getU32(data, &pos, &pcreLen) == false
+            || getU32(data, &pos, &hsLen) == false
+            || getBytes(data, &pos, keyLen, &key) == false
+            || getBytes(data, &pos, pcreLen, &e.pcre) == false
+            || getBytes(data, &pos, hsLen, &e.hyperscan) == false) {
+            return false;
+        }
+        m_entries[key] = std::move(e);
+    }
+
+    return pos == data.size();
+}
+
+
+bool RegexStore::save(std::string *error) {
+    pthread_mutex_lock(&m_lock);
+    if (m_path.empty()
+        || (m_dirty == false && m_used.size() == m_stored)) {
+        pthread_mutex_unlock(&m_lock);
+        return true;
+    }
+
+    std::string entries;
+    putU32(&entries, m_used.size());
+    for (const std::string &key : m_used) {
+        const Entry &e = m_entries[key];
+        putU32(&entries, key.size());
+        putU32(&entries, e.pcre.size());
+        putU32(&entries, e.hyperscan.size());
+        entries.append(key);
+        entries.append(e.pcre);
+        entries.append(e.hyperscan);
+    }
+
+    std::string data(kMagic, sizeof(kMagic));
+    std::string t(tag());
+    putU32(&data, t.size());
+    data.append(t);
+    putU64(&data, checksum(entries.data(), entries.size()));
+    data.append(entries);
+
+    /*
+     * Written aside and renamed over, so that a process reading it at
+     * the same time sees either file, whole.
+     */
+    std::string tmp(m_path + ".tmp." + std::to_string(getpid()));
+    std::ofstream f(tmp, std::ios::out | std::ios::binary | std::ios::trunc);
+    f.write(data.data(), data.size());
+    f.close();
+    if (f.fail() || rename(tmp.c_str(), m_path.c_str()) != 0) {
+        unlink(tmp.c_str());
+        error->assign("Failed to write the regex cache file: " + m_path);
+        pthread_mutex_unlock(&m_lock);
+        return false;
+    }
+
+    m_stored = m_used.size();
+    m_dirty = false;
+    pthread_mutex_unlock(&m_lock);
+    return true;
+}
+
+
+void RegexStore::close() {
+    pthread_mutex_lock(&m_lock);
+    m_entries.clear();
+    m_used.clear();
+    m_stored = 0;
+    m_dirty = false;
+    m_path.clear();
+    pthread_mutex_unlock(&m_lock);
+}
+
+
+bool RegexStore::use(const std::string &key) {
+    bool found = false;
+
+    pthread_mutex_lock(&m_lock);
+    if (m_path.empty() == false && m_entries.count(key) > 0) {
+        m_used.insert(key);
+        found = true;
+    }
+    pthread_mutex_unlock(&m_lock);
+
+    return found;
+}
+
+
+#if WITH_PCRE2
+pcre2_code *RegexStore::findPcre(const std::string &key) {
+    std::string bytes;
+    pcre2_code *codes[1];
+
+    pthread_mutex_lock(&m_lock);
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        bytes = it->second.pcre;
+    }
+    pthread_mutex_unlock(&m_lock);
+
+    if (bytes.empty() || pcre2_serialize_decode(codes, 1,
+        reinterpret_cast<const uint8_t *>(bytes.data()),
+        Allocator::pcre2()) != 1) {
+        pthread_mutex_lock(&m_lock);
+        m_misses++;
+        pthread_mutex_unlock(&m_lock);
+        return NULL;
+    }
+
+    pthread_mutex_lock(&m_lock);
+    m_hits++;
+    m_used.insert(key);
+    pthread_mutex_unlock(&m_lock);
+    return codes[0];
+}
+
+
+void RegexStore::add(const std::string &key, const pcre2_code *pc) {
+    const pcre2_code *codes[1] = {pc};
+    uint8_t *bytes = NULL;
+    PCRE2_SIZE size = 0;
+
+    if (pc == NULL || pcre2_serialize_encode(codes, 1, &bytes, &size,
+        Allocator::pcre2()) < 0) {
+        return;
+    }
+
+    pthread_mutex_lock(&m_lock);
+    m_entries[key].pcre.assign(reinterpret_cast<const char *>(bytes), size);
+    m_used.insert(key);
+    m_dirty = true;
+    pthread_mutex_unlock(&m_lock);
+
+    pcre2_serialize_free(bytes);
+}
+
+
+#ifdef WITH_HYPERSCAN
+hs_database_t *RegexStore::findHyperscan(const std::string &key) {
+    std::string bytes;
+    hs_database_t *db = NULL;
+
+    pthread_mutex_lock(&m_lock);
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        bytes = it->second.hyperscan;
+    }
+    pthread_mutex_unlock(&m_lock);
+
+    if (bytes.empty() || hs_deserialize_database(bytes.data(),
+        bytes.size(), &db) != HS_SUCCESS) {
+        return NULL;
+    }
+
+    return db;
+}
+
+
+void RegexStore::add(const std::string &key, const hs_database_t *db) {
+    char *bytes = NULL;
+    size_t size = 0;
+
+    if (db == NULL
+        || hs_serialize_database(db, &bytes, &size) != HS_SUCCESS) {
+        return;
+    }
+
+    pthread_mutex_lock(&m_lock);
+    m_entries[key].hyperscan.assign(bytes, size);
+    m_used.insert(key);
+    m_dirty = true;
+    pthread_mutex_unlock(&m_lock);
+
+    free(bytes);
+}
+#endif
+#endif
+
+
+size_t RegexStore::hits() {
+    pthread_mutex_lock(&m_lock);
+    size_t n = m_hits;
+    pthread_mutex_unlock(&m_lock);
+    return n;
+}
+
+
+size_t RegexStore::misses() {
+    pthread_mutex_lock(&m_lock);
+    size_t n = m_misses;
+    pthread_mutex_unlock(&m_lock);
+    return n;
+}
+
+
+}  // namespace Utils
+}  // namespace modsecurity
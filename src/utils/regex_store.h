@@ -0,0 +1,125 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <pthread.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#if WITH_PCRE2
+#ifndef PCRE2_CODE_UNIT_WIDTH
+#define PCRE2_CODE_UNIT_WIDTH 8
+#endif
+#include <pcre2.h>
+#endif
+
+#include "src/utils/hyperscan.h"
+
+#ifndef SRC_UTILS_REGEX_STORE_H_
+#define SRC_UTILS_REGEX_STORE_H_
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+/**
+ * On disk cache of the compiled regular expressions (SecRegexCacheFile).
+ *
+ * Compiling the expressions of a large rule set (PCRE and, when in use,
+ * the Hyperscan prefilters) is most of the time it takes to load it. The
+ * compiled code of every expression built while loading the rules is
+ * kept in a file, so that the next start, or the next worker, decodes it
+ * instead. Only the JIT step is done again, it can not be serialized.
+ *
+ * The file is read once, by open(). It starts with a tag naming the
+ * PCRE2 and Hyperscan releases and the word size it was written with,
+ * followed by a checksum of the entries; a file with another tag, or one
+ * whose entries do not add up to the checksum, is ignored and rewritten.
+ * The decoders trust what they are given, so nothing damaged reaches
+ * them. Entries are keyed by the pattern and its flags, so editing the
+ * rules only costs the expressions that changed. save() keeps the entries
+ * used by the rules loaded since open() only, stale ones go away with the
+ * next write.
+ *
+ * Each load of rules that sets SecRegexCacheFile has a store of its own,
+ * owned by the parser, so rules sets using different files, or loaded at
+ * the same time, do not mix their entries.
+ *
+ * Without PCRE2 nothing is cached.
+ *
+ */
+class RegexStore {
+ public:
+    RegexStore();
+    ~RegexStore();
+
+    bool open(const std::string &path, std::string *error);
+    bool save(std::string *error);
+    void close();
+
+    bool isOpen() const { return !m_path.empty(); }
+
+    /*
+     * Keeps the entry of key in the next save(), for an expression that
+     * was compiled before, for other rules. False if there is none.
+     */
+    bool use(const std::string &key);
+
+#if WITH_PCRE2
+    pcre2_code *findPcre(const std::string &key);
+    void add(const std::string &key, const pcre2_code *pc);
+#ifdef WITH_HYPERSCAN
+    hs_database_t *findHyperscan(const std::string &key);
+    void add(const std::string &key, const hs_database_t *db);
+#endif
+#endif
+
+    size_t hits();
+    size_t misses();
+
+ private:
+    struct Entry {
+        std::string pcre;
+        std::string hyperscan;
+    };
+
+    RegexStore(const RegexStore&) = delete;
+    RegexStore& operator=(const RegexStore&) = delete;
+
+    bool load(const std::string &data);
+    static std::string tag();
+    static uint64_t checksum(const char *data, size_t len);
+
+    std::string m_path;
+    std::unordered_map<std::string, Entry> m_entries;
+    /* keys looked up or added since open(), what save() writes */
+    std::unordered_set<std::string> m_used;
+    /* entries in the file as last read or written */
+    size_t m_stored;
+    bool m_dirty;
+    size_t m_hits;
+    size_t m_misses;
+    pthread_mutex_t m_lock;
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_REGEX_STORE_H_
@@ -0,0 +1,293 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/regex_stream.h"
+
+#include <ctype.h>
+#include <string.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "src/utils/regex.h"
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+namespace {
+
+/*
+ * The largest n of the .{n} (and \C{n}) of pattern, dot matching anything
+ * here. An escaped dot or one in a class is taken for one as well, which
+ * only means keeping a few bytes more than needed.
+ */
+size_t longestAnyRepeat(const std::string &pattern) {
+    size_t longest = 0;
+
+    for (size_t i = 1; i + 1 < pattern.size(); i++) {
+        if (pattern[i] != '{'
+            || (pattern[i - 1] != '.' && pattern[i - 1] != 'C')) {
+            continue;
+        }
+        size_t n = 0;
+        for (size_t j = i + 1; j < pattern.size() && isdigit(pattern[j])
+            && n <= RegexStream::kMaxKept; j++) {
+            n = n * 10 + (pattern[j] - '0');
+        }
+        longest = std::max(longest, n);
+    }
+
+    return longest;
+}
+
+}  // namespace
+
+
+
+RegexStream::RegexStream(const Regex *regex)
+    : m_regex(regex),
+    m_state(Searching),
+    m_lookbehind(1),
+    m_retry(0),
+    m_kept(),
+    m_keptOffset(0),
+    m_resume(0),
+    m_ovector(),
+    m_captures() {
+    if (regex->hasError()) {
+        m_state = Failed;
+        return;
+    }
+
+    /*
+     * At least one byte behind the resume point is always kept once the
+     * start of the subject is gone: matching never starts at offset 0 of
+     * the kept bytes again, where \A and ^ would take it for the start.
+     */
+#if WITH_PCRE2
+    uint32_t lookbehind = 0;
+    uint32_t minLength = 0;
+    if (pcre2_pattern_info(regex->m_pc, PCRE2_INFO_MAXLOOKBEHIND,
+        &lookbehind) == 0 && lookbehind > m_lookbehind) {
+        m_lookbehind = lookbehind;
+    }
+    if (pcre2_pattern_info(regex->m_pc, PCRE2_INFO_MINLENGTH,
+        &minLength) == 0 && minLength > 0) {
+        m_retry = minLength - 1;
+    }
+#else
+    int minLength = 0;
+    if (pcre_fullinfo(regex->m_pc, regex->m_pce, PCRE_INFO_MINLENGTH,
+        &minLength) == 0 && minLength > 0) {
+        m_retry = minLength - 1;
+    }
+#ifdef PCRE_INFO_MAXLOOKBEHIND
+    int lookbehind = 0;
+    if (pcre_fullinfo(regex->m_pc, regex->m_pce, PCRE_INFO_MAXLOOKBEHIND,
+        &lookbehind) == 0 && lookbehind > 0
+        && static_cast<size_t>(lookbehind) > m_lookbehind) {
+        m_lookbehind = lookbehind;
+    }
+#else
+    m_lookbehind = 255;
+#endif
+#endif
+    m_retry = std::max(m_retry, longestAnyRepeat(regex->pattern));
+}
+
+
+RegexResult RegexStream::feed(const char *buf, size_t len,
+    unsigned long match_limit) {
+    if (m_state != Searching || len == 0) {
+        return RegexResult::Ok;
+    }
+
+    m_kept.append(buf, len);
+    return search(true, match_limit);
+}
+
+
+RegexResult RegexStream::finish(unsigned long match_limit) {
+    if (m_state != Searching) {
+        return RegexResult::Ok;
+    }
+
+    RegexResult result = search(false, match_limit);
+    if (m_state == Searching) {
+        m_state = NotMatched;
+    }
+    m_kept.clear();
+    m_kept.shrink_to_fit();
+    return result;
+}
+
+
+RegexResult RegexStream::search(bool partial, unsigned long match_limit) {
+    size_t start = 0;
+    int rc = m_regex->matchPart(m_kept.data(), m_kept.size(), m_resume,
+        m_keptOffset > 0, partial, match_limit, &m_ovector);
+
+    for (size_t i = 0; rc > 0 && i < m_ovector.size(); i = i + 2) {
+        if (m_ovector[i] == SIZE_MAX) {
+            continue;
+        }
+        m_captures.push_back(SMatchCapture(i / 2, m_keptOffset + m_ovector[i],
+            m_ovector[i + 1] - m_ovector[i]));
+    }
+    if (m_ovector.empty() == false) {
+        start = m_ovector[0];
+    }
+
+#if WITH_PCRE2
+    bool isPartial = rc == PCRE2_ERROR_PARTIAL;
+    bool noMatch = rc == PCRE2_ERROR_NOMATCH;
+#else
+    bool isPartial = rc == PCRE_ERROR_PARTIAL;
+    bool noMatch = rc == PCRE_ERROR_NOMATCH;
+#endif
+
+    if (rc > 0 && partial && m_kept.size() - start < m_retry) {
+        /* an attempt before this one may match yet, see keepFrom */
+        m_captures.clear();
+        keepFrom(start);
+    } else if (rc > 0) {
+        m_state = Matched;
+        m_kept.clear();
+        m_kept.shrink_to_fit();
+    } else if (isPartial) {
+        keepFrom(start);
+    } else if (noMatch) {
+        keepFrom(m_kept.size());
+    } else {
+        m_state = Failed;
+        return m_regex->to_regex_result(rc);
+    }
+
+    return RegexResult::Ok;
+}
+
+
+void RegexStream::keepFrom(size_t from) {
+    /*
+     * PCRE does not report a partial match when an attempt gives up
+     * before it looks at any byte: for want of the minimum length, or of
+     * the n bytes of a .{n} it checks at once. The attempts that had less
+     * than that left (m_retry) are made again with the next part.
+     */
+    size_t retry = m_kept.size() > m_retry ? m_kept.size() - m_retry : 0;
+    from = std::min(from, std::max(m_resume, retry));
+
+    size_t cut = from > m_lookbehind ? from - m_lookbehind : 0;
+
+    if (cut > 0) {
+        m_kept.erase(0, cut);
+        m_keptOffset = m_keptOffset + cut;
+    }
+    m_resume = from - cut;
+
+    if (m_kept.size() > kMaxKept) {
+        m_state = Abandoned;
+        m_kept.clear();
+        m_kept.shrink_to_fit();
+    }
+}
+
+
+RegexStreams::RegexStreams(const std::vector<const Regex *> &regexes,
+    const BodyBuffer *subject)
+    : m_streams(),
+    m_subject(subject),
+    m_finished(false),
+    m_sameSubject(Unknown) {
+    m_streams.reserve(regexes.size());
+    for (const Regex *regex : regexes) {
+        m_streams.emplace_back(regex);
+    }
+}
+
+
+void RegexStreams::feed(const char *buf, size_t len,
+    unsigned long match_limit) {
+    for (RegexStream &stream : m_streams) {
+        stream.feed(buf, len, match_limit);
+    }
+}
+
+
+void RegexStreams::finish(unsigned long match_limit) {
+    if (m_finished) {
+        return;
+    }
+    for (RegexStream &stream : m_streams) {
+        stream.finish(match_limit);
+    }
+    m_finished = true;
+}
+
+
+const RegexStream *RegexStreams::find(const Regex *regex,
+    const std::string &input) const {
+    const RegexStream *found = nullptr;
+
+    if (m_finished == false) {
+        return nullptr;
+    }
+    for (const RegexStream &stream : m_streams) {
+        if (stream.regex() == regex) {
+            found = &stream;
+            break;
+        }
+    }
+    if (found == nullptr || (found->state() != RegexStream::Matched
+        && found->state() != RegexStream::NotMatched)) {
+        return nullptr;
+    }
+
+    /*
+     * The rules streamed have REQUEST_BODY as their only target, which
+     * all of them get the same copy of for the whole phase: it is told
+     * apart from the body streamed once, not for each rule. It is not the
+     * whole of it when the body was spooled, its size says that much.
+     */
+    if (input.size() != m_subject->size()) {
+        return nullptr;
+    }
+    if (m_sameSubject == Unknown) {
+        m_sameSubject = Same;
+        size_t offset = 0;
+        for (size_t i = 0; i < m_subject->chunkCount(); i++) {
+            size_t len;
+            const char *chunk = m_subject->chunk(i, &len);
+            if (memcmp(input.data() + offset, chunk, len) != 0) {
+                m_sameSubject = Different;
+                break;
+            }
+            offset = offset + len;
+        }
+    }
+    if (m_sameSubject == Different) {
+        return nullptr;
+    }
+
+    return found;
+}
+
+
+}  // namespace Utils
+}  // namespace modsecurity
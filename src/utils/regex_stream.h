@@ -0,0 +1,129 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "modsecurity/body_buffer.h"
+#include "src/utils/regex.h"
+
+#ifndef SRC_UTILS_REGEX_STREAM_H_
+#define SRC_UTILS_REGEX_STREAM_H_
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+/**
+ * Matches a Regex against a subject that is handed over in parts, with
+ * the same outcome as searchOneMatch() over the whole of it.
+ *
+ * Every part is matched with PARTIAL_HARD, with the JIT code of
+ * Regex::compilePartial() when there is one: a match that reaches the end
+ * of what was seen so far is reported as partial, and only the bytes from
+ * where it started on (plus the maximum lookbehind of the pattern) are
+ * kept for the next part. Without a partial match only the lookbehind is
+ * kept. finish() matches what is left as the end of the subject.
+ *
+ * A pattern that keeps a partial match open over more than kMaxKept bytes
+ * would have each part match that much again; the stream is abandoned
+ * then, and the subject has to be matched as a whole.
+ *
+ */
+class RegexStream {
+ public:
+    enum State {
+        Searching,
+        Matched,
+        NotMatched,
+        Abandoned,
+        Failed
+    };
+
+    explicit RegexStream(const Regex *regex);
+
+    RegexResult feed(const char *buf, size_t len,
+        unsigned long match_limit = 0);
+    RegexResult finish(unsigned long match_limit = 0);
+
+    const Regex *regex() const { return m_regex; }
+    State state() const { return m_state; }
+    /* the groups of the match, offsets relative to the whole subject */
+    const std::vector<SMatchCapture> &captures() const { return m_captures; }
+
+    static const size_t kMaxKept = 65536;
+
+ private:
+    RegexResult search(bool partial, unsigned long match_limit);
+    void keepFrom(size_t from);
+
+    const Regex *m_regex;
+    State m_state;
+    size_t m_lookbehind;
+    size_t m_retry;
+    /* the bytes kept, where they are in the subject, where to go on */
+    std::string m_kept;
+    size_t m_keptOffset;
+    size_t m_resume;
+    /* of the last attempt, see Regex::matchPart */
+    std::vector<size_t> m_ovector;
+    std::vector<SMatchCapture> m_captures;
+};
+
+
+/**
+ * The regular expressions of the @rx rules over REQUEST_BODY (see
+ * RuleWithOperator::requestBodyRegex) matched as the request body is
+ * appended, so that phase 2 only has to look at the outcome.
+ *
+ */
+class RegexStreams {
+ public:
+    RegexStreams(const std::vector<const Regex *> &regexes,
+        const BodyBuffer *subject);
+
+    void feed(const char *buf, size_t len, unsigned long match_limit);
+    void finish(unsigned long match_limit);
+
+    /*
+     * The finished stream of regex, provided that input is the subject it
+     * went through, which is only compared once. nullptr otherwise, and
+     * for the streams that were not able to tell, which have to be
+     * matched as usual.
+     */
+    const RegexStream *find(const Regex *regex,
+        const std::string &input) const;
+
+ private:
+    enum SameSubject {
+        Unknown,
+        Same,
+        Different
+    };
+
+    std::vector<RegexStream> m_streams;
+    const BodyBuffer *m_subject;
+    bool m_finished;
+    /* whether the input of find() is the subject, see there */
+    mutable SameSubject m_sameSubject;
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_REGEX_STREAM_H_
@@ -0,0 +1,199 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/reloader.h"
+
+#include <pthread.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <time.h>
+
+#include <atomic>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+
+#include "src/utils/https_client.h"
+
+
+namespace modsecurity {
+namespace Utils {
+
+namespace {
+
+/* bumped in the child of every fork, threads do not survive them */
+std::atomic<unsigned int> forks(1);
+pthread_once_t atforkOnce = PTHREAD_ONCE_INIT;
+
+void onFork() {
+    forks++;
+}
+
+void registerAtfork() {
+    pthread_atfork(NULL, NULL, onFork);
+}
+
+}  // namespace
+
+
+const long Reloader::kMinimumInterval;
+
+
+Reloader::Reloader(const std::string &location, Loader loader)
+    : m_location(location),
+    m_loader(loader),
+    m_mtime(0),
+    m_size(0),
+    m_hash(0),
+    m_interval(0),
+    m_running(false),
+    m_stopping(false),
+    m_generation(0),
+    m_reloads(0),
+    m_failures(0) {
+    struct stat st;
+
+    pthread_once(&atforkOnce, registerAtfork);
+
+    /* what was loaded along with the rules */
+    if (isUrl() == false && stat(m_location.c_str(), &st) == 0) {
+        m_mtime = st.st_mtime;
+        m_size = st.st_size;
+    }
+}
+
+
+Reloader::~Reloader() {
+    stop();
+}
+
+
+unsigned int Reloader::processGeneration() {
+    return forks.load(std::memory_order_relaxed);
+}
+
+
+bool Reloader::isUrl() const {
+    return m_location.compare(0, 8, "https://") == 0;
+}
+
+
+/*
+ * Only the first caller of each process gets to start the thread. When
+ * that fails, it is not retried on every request.
+ */
+void Reloader::start(long interval) {
+    unsigned int generation = processGeneration();
+    unsigned int seen = m_generation.load();
+
+    if (seen == generation
+        || m_generation.compare_exchange_strong(seen, generation) == false) {
+        return;
+    }
+
+    m_interval = interval < kMinimumInterval ? kMinimumInterval : interval;
+    m_stopping = false;
+    m_running = pthread_create(&m_thread, NULL, &Reloader::run, this) == 0;
+}
+
+
+/*
+ * Only a thread started by this very process is waited for; the one of
+ * the parent did not make it through the fork.
+ */
+void Reloader::stop() {
+    if (m_running == false || m_generation.load() != processGeneration()) {
+        return;
+    }
+
+    m_stopping = true;
+    pthread_join(m_thread, NULL);
+    m_running = false;
+}
+
+
+/* returns false if the data changed but could not be loaded */
+bool Reloader::check() {
+    if (isUrl()) {
+        HttpsClient client;
+        if (client.download(m_location) == false) {
+            return false;
+        }
+        size_t hash = std::hash<std::string>()(client.content);
+        if (hash == m_hash) {
+            return true;
+        }
+        m_hash = hash;
+        std::stringstream ss(client.content);
+        return load(&ss);
+    }
+
+    struct stat st;
+    if (stat(m_location.c_str(), &st) != 0) {
+        /* in the middle of being replaced, maybe; try again later */
+        return true;
+    }
+    if (st.st_mtime == m_mtime && st.st_size == m_size) {
+        return true;
+    }
+    m_mtime = st.st_mtime;
+    m_size = st.st_size;
+
+    std::ifstream f(m_location, std::ios::in);
+    if (f.is_open() == false) {
+        return false;
+    }
+    return load(&f);
+}
+
+
+bool Reloader::load(std::istream *data) {
+    std::string error;
+
+    if (m_loader(data, &error) == false) {
+        return false;
+    }
+    m_reloads++;
+    return true;
+}
+
+
+void *Reloader::run(void *data) {
+    Reloader *r = static_cast<Reloader *>(data);
+    /* the stop request is looked at ten times a second */
+    const struct timespec slice = { 0, 100000000 };
+
+    while (r->m_stopping == false) {
+        for (long i = 0; i < r->m_interval * 10
+            && r->m_stopping == false; i++) {
+            nanosleep(&slice, NULL);
+        }
+        if (r->m_stopping) {
+            break;
+        }
+
+        if (r->check() == false) {
+            /* the version in use is kept */
+            r->m_failures++;
+        }
+    }
+
+    return NULL;
+}
+
+
+}  // namespace Utils
+}  // namespace modsecurity
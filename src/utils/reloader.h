@@ -0,0 +1,142 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <pthread.h>
+#include <sys/types.h>
+#include <time.h>
+
+#include <atomic>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#ifndef SRC_UTILS_RELOADER_H_
+#define SRC_UTILS_RELOADER_H_
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+/**
+ * Latest version of a data set that is replaced while in use.
+ *
+ * Readers get a reference to the version current at the time, which
+ * stays valid for as long as they hold it, no matter how many times it
+ * is replaced meanwhile. The version replaced is released by the last
+ * of its readers. Only one thread may publish.
+ *
+ */
+template <typename T>
+class Versioned {
+ public:
+    Versioned() { }
+
+    Versioned(const Versioned &) = delete;
+    Versioned &operator=(const Versioned &) = delete;
+
+    /* NULL until something was published */
+    std::shared_ptr<T> get() const {
+        return std::atomic_load_explicit(&m_current,
+            std::memory_order_acquire);
+    }
+
+    void publish(T *fresh) {
+        std::atomic_store_explicit(&m_current, std::shared_ptr<T>(fresh),
+            std::memory_order_release);
+    }
+
+ private:
+    std::shared_ptr<T> m_current;
+};
+
+
+/**
+ * Refreshes, off the request threads, data loaded from a file or from an
+ * https URL (see SecDataReloadInterval).
+ *
+ * Every interval seconds a file is checked for a new modification time or
+ * size, an URL is downloaded and compared with what was last seen. When
+ * it changed, the content is handed to the loader, which is expected to
+ * build a new version of its data and publish it.
+ *
+ * As the Https audit log writer, the thread is only started by the first
+ * request of each process, so it survives the forks of the server.
+ *
+ */
+class Reloader {
+ public:
+    typedef std::function<bool(std::istream *, std::string *)> Loader;
+
+    static const long kMinimumInterval = 1;
+
+    Reloader(const std::string &location, Loader loader);
+    ~Reloader();
+
+    Reloader(const Reloader &) = delete;
+    Reloader &operator=(const Reloader &) = delete;
+
+    /*
+     * Called on every evaluation; after the first call of the process,
+     * it is a single atomic read.
+     */
+    void watch(long interval) {
+        if (interval > 0 && m_generation.load(std::memory_order_acquire)
+            != processGeneration()) {
+            start(interval);
+        }
+    }
+
+    size_t reloads() const { return m_reloads.load(); }
+    size_t failures() const { return m_failures.load(); }
+
+ private:
+    static unsigned int processGeneration();
+    static void *run(void *data);
+    void start(long interval);
+    void stop();
+    bool check();
+    bool load(std::istream *data);
+    bool isUrl() const;
+
+    const std::string m_location;
+    Loader m_loader;
+
+    /* last state seen of the file, or hash of the URL content */
+    time_t m_mtime;
+    off_t m_size;
+    size_t m_hash;
+
+    /*
+     * No mutex nor condition variable: a copy inherited through fork()
+     * may be held by a thread that only existed in the parent.
+     */
+    pthread_t m_thread;
+    long m_interval;
+    std::atomic<bool> m_running;
+    std::atomic<bool> m_stopping;
+
+    /* process generation the thread was started in, 0 if none */
+    std::atomic<unsigned int> m_generation;
+    std::atomic<size_t> m_reloads;
+    std::atomic<size_t> m_failures;
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_RELOADER_H_
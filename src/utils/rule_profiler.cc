@@ -0,0 +1,239 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/rule_profiler.h"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "modsecurity/rule_with_operator.h"
+#include "src/utils/system.h"
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+static std::atomic<uint64_t> profilers(0);
+static std::atomic<uint64_t> threads(0);
+static std::atomic<RuleProfiler::AllocationCounter> allocationCounter(
+    nullptr);
+
+
+RuleProfiler::RuleProfiler(int sampleRate)
+    : m_sampleRate(sampleRate > 0 ? sampleRate : 1),
+    m_id(++profilers) {
+    pthread_mutex_init(&m_lock, NULL);
+}
+
+
+RuleProfiler::~RuleProfiler() {
+    pthread_mutex_destroy(&m_lock);
+}
+
+
+void RuleProfiler::add(const RuleWithOperator *rule, int64_t id) {
+    if (m_slots.count(rule) > 0) {
+        return;
+    }
+
+    Entry e;
+    e.m_id = id;
+    e.m_file = rule->getFileName() ? *rule->getFileName() : "";
+    e.m_line = rule->getLineNumber();
+    e.m_operator = rule->getOperatorName();
+
+    m_slots.emplace(rule, m_entries.size());
+    m_entries.push_back(std::move(e));
+}
+
+
+RuleProfilerShard *RuleProfiler::sample() {
+    /*
+     * The shard of the profiler last used on this thread. Profilers are
+     * told apart by their id, not their address, which may be reused by
+     * the next one; the shards of any other one are looked up under its
+     * lock. Either way nothing is left behind once a profiler is gone.
+     */
+    static thread_local uint64_t thread = ++threads;
+    static thread_local uint64_t lastId = 0;
+    static thread_local RuleProfilerShard *lastShard = nullptr;
+    RuleProfilerShard *shard;
+
+    if (lastId == m_id) {
+        shard = lastShard;
+    } else {
+        pthread_mutex_lock(&m_lock);
+        std::unique_ptr<RuleProfilerShard> &s = m_shards[thread];
+        if (s == nullptr) {
+            s.reset(new RuleProfilerShard(m_entries.size()));
+        }
+        shard = s.get();
+        pthread_mutex_unlock(&m_lock);
+        lastId = m_id;
+        lastShard = shard;
+    }
+
+    if (shard->m_seen++ % m_sampleRate != 0) {
+        return NULL;
+    }
+    RuleProfilerCounters::add(&shard->m_sampled, 1);
+
+    return shard;
+}
+
+
+void RuleProfiler::record(RuleProfilerShard *shard,
+    const RuleWithOperator *rule, size_t values, bool matched,
+    uint64_t transformationNs, uint64_t operatorNs, uint64_t allocations,
+    uint64_t allocatedBytes) const {
+    auto it = m_slots.find(rule);
+    if (it == m_slots.end()) {
+        return;
+    }
+    RuleProfilerCounters &c = shard->m_counters[it->second];
+    size_t bucket = 0;
+
+    while (bucket + 1 < RuleProfilerCounters::kBuckets
+        && values >= (static_cast<size_t>(1) << bucket)) {
+        bucket++;
+    }
+
+    RuleProfilerCounters::add(&c.m_invocations, 1);
+    RuleProfilerCounters::add(&c.m_values[bucket], 1);
+    RuleProfilerCounters::add(&c.m_transformationNs, transformationNs);
+    RuleProfilerCounters::add(&c.m_operatorNs, operatorNs);
+    RuleProfilerCounters::add(&c.m_allocations, allocations);
+    RuleProfilerCounters::add(&c.m_allocatedBytes, allocatedBytes);
+    if (matched) {
+        RuleProfilerCounters::add(&c.m_matches, 1);
+    }
+}
+
+
+/**
+ * One line per rule that was evaluated, the most expensive first:
+ *
+ *   Rule 942100 (rules.conf:12, @detectSQLi): 100 invocations,
+ *   2 matches, transformations 150us, operator 900us, values
+ *   0:0 1:80 2-3:20 4-7:0 8-15:0 16+:0
+ *
+ * followed by ", allocations 300 (12000 bytes)" when there is an
+ * allocation counter.
+ *
+ */
+std::string RuleProfiler::dump() const {
+    static const char *buckets[RuleProfilerCounters::kBuckets] = {
+        "0", "1", "2-3", "4-7", "8-15", "16+"
+    };
+    struct Total {
+        size_t m_slot;
+        uint64_t m_invocations;
+        uint64_t m_matches;
+        uint64_t m_transformationNs;
+        uint64_t m_operatorNs;
+        uint64_t m_allocations;
+        uint64_t m_allocatedBytes;
+        uint64_t m_values[RuleProfilerCounters::kBuckets];
+    };
+    std::vector<Total> totals(m_entries.size());
+    uint64_t sampled = 0;
+    bool counted = allocationCounter.load() != nullptr;
+    std::ostringstream out;
+
+    pthread_mutex_lock(&m_lock);
+    for (size_t i = 0; i < totals.size(); i++) {
+        Total &t = totals[i];
+        t = Total();
+        t.m_slot = i;
+        for (auto &shard : m_shards) {
+            const RuleProfilerCounters &c = shard.second->m_counters[i];
+            t.m_invocations += c.m_invocations.load(std::memory_order_relaxed);
+            t.m_matches += c.m_matches.load(std::memory_order_relaxed);
+            t.m_transformationNs +=
+                c.m_transformationNs.load(std::memory_order_relaxed);
+            t.m_operatorNs += c.m_operatorNs.load(std::memory_order_relaxed);
+            t.m_allocations += c.m_allocations.load(std::memory_order_relaxed);
+            t.m_allocatedBytes +=
+                c.m_allocatedBytes.load(std::memory_order_relaxed);
+            for (size_t b = 0; b < RuleProfilerCounters::kBuckets; b++) {
+                t.m_values[b] += c.m_values[b].load(std::memory_order_relaxed);
+            }
+        }
+    }
+    for (auto &shard : m_shards) {
+        sampled += shard.second->m_sampled.load(std::memory_order_relaxed);
+    }
+    pthread_mutex_unlock(&m_lock);
+
+    std::sort(totals.begin(), totals.end(),
+        [](const Total &a, const Total &b) {
+            return a.m_transformationNs + a.m_operatorNs
+                > b.m_transformationNs + b.m_operatorNs;
+        });
+
+    out << "Rule profile: " << sampled << " transaction(s) sampled, one out "
+        << "of " << m_sampleRate << "." << std::endl;
+    for (const Total &t : totals) {
+        const Entry &e = m_entries[t.m_slot];
+        if (t.m_invocations == 0) {
+            continue;
+        }
+        out << "Rule " << e.m_id << " (" << e.m_file << ":" << e.m_line
+            << ", @" << e.m_operator << "): " << t.m_invocations
+            << " invocations, " << t.m_matches << " matches, transformations "
+            << t.m_transformationNs / 1000 << "us, operator "
+            << t.m_operatorNs / 1000 << "us, values";
+        for (size_t b = 0; b < RuleProfilerCounters::kBuckets; b++) {
+            out << " " << buckets[b] << ":" << t.m_values[b];
+        }
+        if (counted) {
+            out << ", allocations " << t.m_allocations << " ("
+                << t.m_allocatedBytes << " bytes)";
+        }
+        out << std::endl;
+    }
+
+    return out.str();
+}
+
+
+uint64_t RuleProfiler::now() {
+    return utils::monotonic_ns();
+}
+
+
+void RuleProfiler::setAllocationCounter(AllocationCounter counter) {
+    allocationCounter.store(counter);
+}
+
+
+bool RuleProfiler::allocations(uint64_t *allocations, uint64_t *bytes) {
+    AllocationCounter counter = allocationCounter.load(
+        std::memory_order_relaxed);
+    if (counter == nullptr) {
+        *allocations = 0;
+        *bytes = 0;
+        return false;
+    }
+    counter(allocations, bytes);
+    return true;
+}
+
+
+}  // namespace Utils
+}  // namespace modsecurity
@@ -0,0 +1,153 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <pthread.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifndef SRC_UTILS_RULE_PROFILER_H_
+#define SRC_UTILS_RULE_PROFILER_H_
+
+
+namespace modsecurity {
+class RuleWithOperator;
+namespace Utils {
+
+
+/**
+ * Counters of one rule. They are only written by the thread owning the
+ * shard (a plain load and store, no read-modify-write) and read, at any
+ * time, by RuleProfiler::dump().
+ */
+class RuleProfilerCounters {
+ public:
+    /* values evaluated per invocation: 0, 1, 2-3, 4-7, 8-15, 16+ */
+    static const size_t kBuckets = 6;
+
+    static void add(std::atomic<uint64_t> *c, uint64_t v) {
+        c->store(c->load(std::memory_order_relaxed) + v,
+            std::memory_order_relaxed);
+    }
+
+    std::atomic<uint64_t> m_invocations{0};
+    std::atomic<uint64_t> m_matches{0};
+    std::atomic<uint64_t> m_operatorNs{0};
+    std::atomic<uint64_t> m_transformationNs{0};
+    std::atomic<uint64_t> m_allocations{0};
+    std::atomic<uint64_t> m_allocatedBytes{0};
+    std::atomic<uint64_t> m_values[kBuckets]{};
+};
+
+
+/**
+ * Counters of every rule of a profiler, as filled by one thread.
+ */
+class RuleProfilerShard {
+ public:
+    explicit RuleProfilerShard(size_t rules)
+        : m_counters(new RuleProfilerCounters[rules]),
+        m_seen(0),
+        m_sampled{0} { }
+
+    std::unique_ptr<RuleProfilerCounters[]> m_counters;
+    /* transactions started on this thread, sampled or not */
+    uint64_t m_seen;
+    std::atomic<uint64_t> m_sampled;
+};
+
+
+/**
+ * Per rule execution profile (SecRuleProfiling).
+ *
+ * Built along with the evaluation plan of a rule set, it knows every
+ * rule with an operator, chained ones included. One transaction out of
+ * the sample rate is profiled: for each rule it evaluates, the
+ * invocation, the number of values the operator ran against, whether it
+ * matched and the time spent in the transformations and in the operator
+ * are added to the shard of the current thread, so the hot path takes no
+ * lock and shares no cache line with other threads. dump() sums the
+ * shards up.
+ *
+ * A transaction is expected to run on a single thread; one that moves
+ * keeps writing the shard it started with, which at worst loses a few
+ * increments.
+ *
+ */
+class RuleProfiler {
+ public:
+    explicit RuleProfiler(int sampleRate);
+    ~RuleProfiler();
+
+    RuleProfiler(const RuleProfiler &) = delete;
+    RuleProfiler &operator=(const RuleProfiler &) = delete;
+
+    /*
+     * Called while the plan is built, before any transaction; id is the
+     * one of the chain the rule belongs to.
+     */
+    void add(const RuleWithOperator *rule, int64_t id);
+
+    /* The shard to fill for a new transaction, or NULL if not sampled. */
+    RuleProfilerShard *sample();
+
+    void record(RuleProfilerShard *shard, const RuleWithOperator *rule,
+        size_t values, bool matched, uint64_t transformationNs,
+        uint64_t operatorNs, uint64_t allocations = 0,
+        uint64_t allocatedBytes = 0) const;
+
+    std::string dump() const;
+
+    static uint64_t now();
+
+    /*
+     * What the calling thread allocated so far, as told by a program that
+     * counts it (test/benchmark/allocations, interposing malloc). Without
+     * one, the allocations of the rules are not in the profile.
+     */
+    typedef void (*AllocationCounter)(uint64_t *allocations,
+        uint64_t *bytes);
+    static void setAllocationCounter(AllocationCounter counter);
+    static bool allocations(uint64_t *allocations, uint64_t *bytes);
+
+ private:
+    struct Entry {
+        int64_t m_id;
+        std::string m_file;
+        int m_line;
+        std::string m_operator;
+    };
+
+    std::unordered_map<const RuleWithOperator *, size_t> m_slots;
+    std::vector<Entry> m_entries;
+    /* by thread, numbered in the order they first sampled */
+    std::unordered_map<uint64_t,
+        std::unique_ptr<RuleProfilerShard>> m_shards;
+    int m_sampleRate;
+    /* tells apart the profilers in the per thread shard cache */
+    uint64_t m_id;
+    mutable pthread_mutex_t m_lock;
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_RULE_PROFILER_H_
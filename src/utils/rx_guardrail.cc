@@ -0,0 +1,71 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/rx_guardrail.h"
+
+#include <algorithm>
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+void RxGuardrail::nudge(std::atomic<uint64_t> *estimate, uint64_t sample,
+    bool first) {
+    uint64_t e = estimate->load(std::memory_order_relaxed);
+
+    if (first) {
+        e = sample;
+    } else if (sample > e) {
+        e = std::min(sample, e + std::max<uint64_t>(1, e >> 4));
+    } else if (sample < e) {
+        e = std::max(sample, e - std::max<uint64_t>(1, e >> 4));
+    }
+    estimate->store(e, std::memory_order_relaxed);
+}
+
+
+void RxGuardrail::observe(size_t length, uint64_t ns) {
+    uint64_t samples = m_samples.load(std::memory_order_relaxed);
+
+    nudge(&m_callNs, ns, samples == 0);
+    if (length > 0) {
+        nudge(&m_bytePs, ns * 1000 / length, samples == 0);
+    }
+    m_samples.store(samples + 1, std::memory_order_relaxed);
+}
+
+
+size_t RxGuardrail::budget(size_t length, int factor) const {
+    if (factor < 1
+        || m_samples.load(std::memory_order_relaxed) < kWarmup) {
+        return length;
+    }
+
+    uint64_t bytePs = m_bytePs.load(std::memory_order_relaxed);
+    if (bytePs == 0) {
+        return length;
+    }
+
+    uint64_t allowedPs = m_callNs.load(std::memory_order_relaxed) * 1000
+        * static_cast<uint64_t>(factor);
+    uint64_t bytes = allowedPs / bytePs;
+
+    return bytes < length ? static_cast<size_t>(bytes) : length;
+}
+
+
+}  // namespace Utils
+}  // namespace modsecurity
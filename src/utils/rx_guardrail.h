@@ -0,0 +1,78 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <stdint.h>
+
+#include <atomic>
+#include <cstddef>
+
+#ifndef SRC_UTILS_RX_GUARDRAIL_H_
+#define SRC_UTILS_RX_GUARDRAIL_H_
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+/**
+ * Running cost of the regular expression of one operator (SecRxGuardrail).
+ *
+ * The median time of a search and the median time per byte of subject
+ * are estimated from the searches of the transactions SecRuleProfiling
+ * samples, so that the other transactions leave the rule untouched. Once
+ * enough of them were seen, budget() tells how much of a subject may be
+ * searched without going over a given multiple of the median: an input
+ * predicted to cost more is searched on a prefix only.
+ *
+ * The estimates are frugal streaming medians, nudged towards every new
+ * sample by a sixteenth of their value; concurrent updates may lose a
+ * nudge, which does not matter to an estimate.
+ *
+ */
+class RxGuardrail {
+ public:
+    /* searches to be seen before any input gets cut short */
+    static const uint64_t kWarmup = 64;
+
+    /* PCRE's own match limit, the one in use without SecPcreMatchLimit */
+    static const unsigned long kDefaultMatchLimit = 10000000;
+
+    RxGuardrail() : m_samples(0), m_callNs(0), m_bytePs(0) { }
+
+    /* A search over length bytes, from a profiled transaction, took ns. */
+    void observe(size_t length, uint64_t ns);
+
+    /*
+     * How many bytes of an input of length bytes may be searched within
+     * factor times the median cost of a search; length when it all may.
+     */
+    size_t budget(size_t length, int factor) const;
+
+ private:
+    static void nudge(std::atomic<uint64_t> *estimate, uint64_t sample,
+        bool first);
+
+    std::atomic<uint64_t> m_samples;
+    /* nanoseconds per search */
+    std::atomic<uint64_t> m_callNs;
+    /* picoseconds per byte of subject */
+    std::atomic<uint64_t> m_bytePs;
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_RX_GUARDRAIL_H_
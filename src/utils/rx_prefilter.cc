@@ -0,0 +1,490 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/rx_prefilter.h"
+
+#include <ctype.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/utils/acmp.h"
+#include "src/utils/interned_patterns.h"
+
+
+namespace modsecurity {
+namespace Utils {
+
+namespace {
+
+/*
+ * Shorter literals are too common to discard any meaningful amount of
+ * subjects; not worth the extra pass.
+ */
+const size_t kMinimumLiteralLength = 3;
+
+typedef std::vector<std::string> LiteralSet;
+
+
+size_t shortest(const LiteralSet &set) {
+    size_t s = 0;
+    for (const std::string &l : set) {
+        if (s == 0 || l.size() < s) {
+            s = l.size();
+        }
+    }
+    return s;
+}
+
+
+/*
+ * Tells if a is more selective than b: the longer its shortest literal
+ * is, the better. Fewer alternatives breaks the tie.
+ */
+bool better(const LiteralSet &a, const LiteralSet &b) {
+    if (a.empty()) {
+        return false;
+    }
+    if (b.empty()) {
+        return true;
+    }
+    if (shortest(a) != shortest(b)) {
+        return shortest(a) > shortest(b);
+    }
+    return a.size() < b.size();
+}
+
+
+/*
+ * Conservative recursive descent over the PCRE syntax. Anything that may
+ * change the meaning of the literals (extended mode, \Q..\E, back
+ * references, recursion, etc) makes the whole pattern unsupported.
+ */
+class LiteralExtractor {
+ public:
+    explicit LiteralExtractor(const std::string &pattern)
+        : m_pattern(pattern),
+        m_pos(0),
+        m_unsupported(false) { }
+
+    bool extract(LiteralSet *literals) {
+        alternation(literals);
+        if (m_unsupported || m_pos != m_pattern.size()) {
+            return false;
+        }
+        return !literals->empty()
+            && shortest(*literals) >= kMinimumLiteralLength;
+    }
+
+ private:
+    bool atEnd() const { return m_pos >= m_pattern.size(); }
+    char peek() const { return m_pattern[m_pos]; }
+
+    void alternation(LiteralSet *out) {
+        bool missing = false;
+
+        out->clear();
+        while (!m_unsupported) {
+            LiteralSet branch;
+            sequence(&branch);
+            if (branch.empty()) {
+                missing = true;
+            } else {
+                out->insert(out->end(), branch.begin(), branch.end());
+            }
+            if (atEnd() || peek() != '|') {
+                break;
+            }
+            m_pos++;
+        }
+
+        /* one branch without requirement spoils the whole alternation */
+        if (missing) {
+            out->clear();
+        }
+    }
+
+    void sequence(LiteralSet *best) {
+        std::string run;
+
+        best->clear();
+        while (!atEnd() && !m_unsupported) {
+            char c = peek();
+            int literal = -1;
+            bool isRequirement = false;
+            bool optional = false;
+            LiteralSet group;
+
+            if (c == '|' || c == ')') {
+                break;
+            } else if (c == '\\') {
+                literal = escape();
+            } else if (c == '[') {
+                charClass();
+            } else if (c == '(') {
+                isRequirement = parseGroup(&group);
+            } else if (c == '.' || c == '^' || c == '$') {
+                m_pos++;
+            } else if (c == '*' || c == '+' || c == '?' || c == '{') {
+                m_unsupported = true;
+                break;
+            } else {
+                literal = static_cast<unsigned char>(c);
+                m_pos++;
+            }
+
+            bool quantified = quantifier(&optional);
+
+            if (literal >= 0 && !optional) {
+                run.push_back(static_cast<char>(tolower(literal)));
+            }
+            if (literal < 0 || quantified) {
+                flush(&run, best);
+            }
+            if (isRequirement && !optional && better(group, *best)) {
+                *best = group;
+            }
+        }
+        flush(&run, best);
+    }
+
+    void flush(std::string *run, LiteralSet *best) {
+        if (run->empty()) {
+            return;
+        }
+        LiteralSet candidate(1, *run);
+        if (better(candidate, *best)) {
+            *best = candidate;
+        }
+        run->clear();
+    }
+
+    static int hex(char c) {
+        if (c >= '0' && c <= '9') {
+            return c - '0';
+        }
+        c = static_cast<char>(tolower(c));
+        if (c >= 'a' && c <= 'f') {
+            return c - 'a' + 10;
+        }
+        return -1;
+    }
+
+    /* returns the literal byte of the escape or -1 if it is not one */
+    int escape() {
+        m_pos++;
+        if (atEnd()) {
+            m_unsupported = true;
+            return -1;
+        }
+
+        char n = m_pattern[m_pos++];
+        if (!isalnum(static_cast<unsigned char>(n))) {
+            return static_cast<unsigned char>(n);
+        }
+
+        switch (n) {
+            case 'a':
+                return 0x07;
+            case 'e':
+                return 0x1b;
+            case 'f':
+                return '\f';
+            case 'n':
+                return '\n';
+            case 'r':
+                return '\r';
+            case 't':
+                return '\t';
+            case 'x':
+                if (m_pos + 1 < m_pattern.size()
+                    && hex(m_pattern[m_pos]) >= 0
+                    && hex(m_pattern[m_pos + 1]) >= 0) {
+                    int v = hex(m_pattern[m_pos]) * 16
+                        + hex(m_pattern[m_pos + 1]);
+                    m_pos += 2;
+                    if (v != 0) {
+                        return v;
+                    }
+                }
+                m_unsupported = true;
+                return -1;
+            case 'A': case 'b': case 'B': case 'd': case 'D': case 'G':
+            case 'h': case 'H': case 'K': case 'R': case 's': case 'S':
+            case 'v': case 'V': case 'w': case 'W': case 'X': case 'z':
+            case 'Z':
+                return -1;
+            default:
+                /* back references, \p{..}, \Q..\E, \g, \k, \c, ... */
+                m_unsupported = true;
+                return -1;
+        }
+    }
+
+    void charClass() {
+        m_pos++;
+        if (!atEnd() && peek() == '^') {
+            m_pos++;
+        }
+        if (!atEnd() && peek() == ']') {
+            m_pos++;
+        }
+        while (!atEnd() && peek() != ']') {
+            if (peek() == '\\') {
+                m_pos++;
+            } else if (peek() == '[' && m_pos + 1 < m_pattern.size()
+                && m_pattern[m_pos + 1] == ':') {
+                size_t end = m_pattern.find(":]", m_pos + 2);
+                if (end == std::string::npos) {
+                    m_unsupported = true;
+                    return;
+                }
+                m_pos = end + 1;
+            }
+            m_pos++;
+        }
+        if (atEnd()) {
+            m_unsupported = true;
+            return;
+        }
+        m_pos++;
+    }
+
+    bool skipTo(char c) {
+        size_t end = m_pattern.find(c, m_pos);
+        if (end == std::string::npos) {
+            m_unsupported = true;
+            return false;
+        }
+        m_pos = end + 1;
+        return true;
+    }
+
+    /* returns true if the group content has to be found on a match */
+    bool parseGroup(LiteralSet *set) {
+        bool requirement = true;
+
+        m_pos++;
+        if (!atEnd() && peek() == '*') {
+            m_unsupported = true;
+            return false;
+        }
+
+        if (!atEnd() && peek() == '?') {
+            m_pos++;
+            if (atEnd()) {
+                m_unsupported = true;
+                return false;
+            }
+            char c = peek();
+            if (c == ':' || c == '>' || c == '|') {
+                m_pos++;
+            } else if (c == '=' || c == '!') {
+                requirement = false;
+                m_pos++;
+            } else if (c == '<' && m_pos + 1 < m_pattern.size()
+                && (m_pattern[m_pos + 1] == '='
+                || m_pattern[m_pos + 1] == '!')) {
+                requirement = false;
+                m_pos += 2;
+            } else if (c == '<' || (c == 'P' && m_pos + 1 < m_pattern.size()
+                && m_pattern[m_pos + 1] == '<')) {
+                if (!skipTo('>')) {
+                    return false;
+                }
+            } else if (c == '\'') {
+                m_pos++;
+                if (!skipTo('\'')) {
+                    return false;
+                }
+            } else if (c == '#') {
+                skipTo(')');
+                return false;
+            } else if (isalpha(static_cast<unsigned char>(c)) || c == '-'
+                || c == '^') {
+                while (!atEnd() && (isalpha(static_cast<unsigned char>(peek()))
+                    || peek() == '-' || peek() == '^')) {
+                    if (peek() == 'x') {
+                        m_unsupported = true;
+                        return false;
+                    }
+                    m_pos++;
+                }
+                if (atEnd()) {
+                    m_unsupported = true;
+                    return false;
+                }
+                if (peek() == ')') {
+                    /* option setting only, (?i) and friends */
+                    m_pos++;
+                    set->clear();
+                    return false;
+                }
+                if (peek() != ':') {
+                    m_unsupported = true;
+                    return false;
+                }
+                m_pos++;
+            } else {
+                /* conditionals, recursion and sub routine calls */
+                m_unsupported = true;
+                return false;
+            }
+        }
+
+        alternation(set);
+        if (m_unsupported || atEnd() || peek() != ')') {
+            m_unsupported = true;
+            return false;
+        }
+        m_pos++;
+
+        if (!requirement) {
+            set->clear();
+        }
+        return requirement;
+    }
+
+    /* consumes a quantifier, if any; optional is set on zero minimum */
+    bool quantifier(bool *optional) {
+        *optional = false;
+        if (atEnd()) {
+            return false;
+        }
+
+        char c = peek();
+        if (c == '*' || c == '?') {
+            *optional = true;
+            m_pos++;
+        } else if (c == '+') {
+            m_pos++;
+        } else if (c == '{') {
+            size_t p = m_pos + 1;
+            size_t digits = p;
+            while (p < m_pattern.size() && isdigit(
+                static_cast<unsigned char>(m_pattern[p]))) {
+                p++;
+            }
+            if (p == digits) {
+                /* not a valid {n}, {n,} or {n,m} */
+                m_unsupported = true;
+                return false;
+            }
+            *optional = m_pattern.find_first_not_of('0', digits) >= p;
+            if (p < m_pattern.size() && m_pattern[p] == ',') {
+                p++;
+                while (p < m_pattern.size() && isdigit(
+                    static_cast<unsigned char>(m_pattern[p]))) {
+                    p++;
+                }
+            }
+            if (p >= m_pattern.size() || m_pattern[p] != '}') {
+                m_unsupported = true;
+                return false;
+            }
+            m_pos = p + 1;
+        } else {
+            return false;
+        }
+
+        /* lazy and possessive variants */
+        if (!atEnd() && (peek() == '?' || peek() == '+')) {
+            m_pos++;
+        }
+        return true;
+    }
+
+    const std::string &m_pattern;
+    size_t m_pos;
+    bool m_unsupported;
+};
+
+}  // namespace
+
+
+std::shared_ptr<RxPrefilter> RxPrefilter::interned(
+    const std::string &pattern) {
+    return InternedPatterns<RxPrefilter>::get(pattern,
+        [](const RxPrefilter &) { return true; },
+        [&pattern]() { return new RxPrefilter(pattern); });
+}
+
+
+RxPrefilter::RxPrefilter(const std::string &pattern)
+    : m_acmp(NULL) {
+    if (requiredLiterals(pattern, &m_literals) == false) {
+        m_literals.clear();
+        return;
+    }
+
+    m_acmp = acmp_create(0);
+    for (const std::string &l : m_literals) {
+        acmp_add_pattern(m_acmp, l.c_str(), NULL, NULL, l.length());
+    }
+    while (m_acmp->is_failtree_done == 0) {
+        acmp_prepare(m_acmp);
+    }
+}
+
+
+RxPrefilter::~RxPrefilter() {
+    acmp_destroy(m_acmp);
+    m_acmp = NULL;
+}
+
+
+bool RxPrefilter::mayMatch(const std::string &subject) const {
+    ACMPT pt;
+    const char *match = NULL;
+
+    if (m_acmp == NULL) {
+        return true;
+    }
+
+    pt.parser = m_acmp;
+    pt.ptr = NULL;
+    return acmp_process_quick(&pt, &match, subject.c_str(),
+        subject.length()) >= 0;
+}
+
+
+/**
+ * Fills literals with a set of strings so that any subject matched by
+ * pattern contains, ignoring the case, at least one of them. Returns false
+ * if no such set, selective enough, was found.
+ *
+ */
+bool RxPrefilter::requiredLiterals(const std::string &pattern,
+    std::vector<std::string> *literals) {
+    LiteralExtractor extractor(pattern);
+
+    literals->clear();
+    if (extractor.extract(literals) == false) {
+        literals->clear();
+        return false;
+    }
+
+    std::sort(literals->begin(), literals->end());
+    literals->erase(std::unique(literals->begin(), literals->end()),
+        literals->end());
+
+    return true;
+}
+
+
+}  // namespace Utils
+}  // namespace modsecurity
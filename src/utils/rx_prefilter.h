@@ -0,0 +1,72 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/utils/acmp.h"
+
+#ifndef SRC_UTILS_RX_PREFILTER_H_
+#define SRC_UTILS_RX_PREFILTER_H_
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+/**
+ * Literal prefilter for a regular expression.
+ *
+ * The pattern is analyzed to find a set of literals so that any match of
+ * the expression has to contain at least one of them. Those are loaded
+ * into an Aho-Corasick automaton (case insensitive, which only widens the
+ * set of accepted subjects) that is able to tell, in a single pass, that
+ * the expression can not match a given subject.
+ *
+ * Patterns that are not understood are left without a prefilter, in which
+ * case mayMatch() always returns true.
+ *
+ */
+class RxPrefilter {
+ public:
+    explicit RxPrefilter(const std::string &pattern);
+    ~RxPrefilter();
+
+    RxPrefilter(const RxPrefilter&) = delete;
+    RxPrefilter& operator=(const RxPrefilter&) = delete;
+
+    /* Shared by the operators with the same pattern, as Regex::interned. */
+    static std::shared_ptr<RxPrefilter> interned(const std::string &pattern);
+
+    bool isUsable() const { return m_acmp != NULL; }
+    bool mayMatch(const std::string &subject) const;
+
+    const std::vector<std::string> &literals() const { return m_literals; }
+
+    static bool requiredLiterals(const std::string &pattern,
+        std::vector<std::string> *literals);
+
+ private:
+    ACMP *m_acmp;
+    std::vector<std::string> m_literals;
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_RX_PREFILTER_H_
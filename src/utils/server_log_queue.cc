@@ -0,0 +1,174 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/server_log_queue.h"
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "modsecurity/rule_message.h"
+#include "src/utils/metrics.h"
+
+namespace modsecurity {
+namespace Utils {
+
+
+const size_t ServerLogQueue::kQueueLimit;
+
+
+ServerLogQueue::ServerLogQueue(Deliver deliver)
+    : m_deliver(std::move(deliver)),
+    m_dropped(0),
+    m_queued(0),
+    m_delivered(0),
+    m_waiting(false),
+    m_pid(0),
+    m_stopping(false) {
+    pthread_mutex_init(&m_lock, NULL);
+    pthread_cond_init(&m_cond, NULL);
+    pthread_cond_init(&m_drained, NULL);
+}
+
+
+ServerLogQueue::~ServerLogQueue() {
+    if (m_pid.load(std::memory_order_acquire) == getpid()) {
+        pthread_mutex_lock(&m_lock);
+        m_stopping = true;
+        pthread_cond_signal(&m_cond);
+        pthread_mutex_unlock(&m_lock);
+        pthread_join(m_thread, NULL);
+    }
+    pthread_cond_destroy(&m_drained);
+    pthread_cond_destroy(&m_cond);
+    pthread_mutex_destroy(&m_lock);
+}
+
+
+bool ServerLogQueue::push(void *data, std::shared_ptr<RuleMessage> rm,
+    std::shared_ptr<RulesSet> rules) {
+    if (m_pid.load(std::memory_order_acquire) != getpid()) {
+        pthread_mutex_lock(&m_lock);
+        bool started = m_pid.load(std::memory_order_relaxed) == getpid()
+            || start();
+        pthread_mutex_unlock(&m_lock);
+        if (started == false) {
+            m_deliver(data, rm);
+            return true;
+        }
+    }
+
+    Entry e = { data, std::move(rm), std::move(rules) };
+    if (m_queue.push(std::move(e)) == false) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        Metrics::getInstance().increment(Metrics::ServerLogDroppedCounter);
+        return false;
+    }
+    m_queued.fetch_add(1, std::memory_order_release);
+
+    /* pairs with the fence of run(), one of the two sees the other */
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_waiting.load(std::memory_order_relaxed)) {
+        pthread_mutex_lock(&m_lock);
+        pthread_cond_signal(&m_cond);
+        pthread_mutex_unlock(&m_lock);
+    }
+
+    return true;
+}
+
+
+void ServerLogQueue::drain() {
+    if (m_pid.load(std::memory_order_acquire) != getpid()
+        || pthread_equal(pthread_self(), m_thread)) {
+        return;
+    }
+
+    uint64_t queued = m_queued.load(std::memory_order_acquire);
+    pthread_mutex_lock(&m_lock);
+    while (m_delivered.load(std::memory_order_acquire) < queued) {
+        pthread_cond_wait(&m_drained, &m_lock);
+    }
+    pthread_mutex_unlock(&m_lock);
+}
+
+
+/*
+ * Has to be called with m_lock held. Messages queued in the parent
+ * before the fork are the parent's to deliver, they are dropped here.
+ */
+bool ServerLogQueue::start() {
+    Entry e;
+
+    while (m_queue.pop(&e)) {
+    }
+    m_delivered.store(m_queued.load(std::memory_order_relaxed),
+        std::memory_order_release);
+
+    m_stopping = false;
+    if (pthread_create(&m_thread, NULL, &ServerLogQueue::run, this) != 0) {
+        return false;
+    }
+    m_pid.store(getpid(), std::memory_order_release);
+
+    return true;
+}
+
+
+void *ServerLogQueue::run(void *data) {
+    ServerLogQueue *q = static_cast<ServerLogQueue *>(data);
+    Entry e;
+
+    while (true) {
+        while (q->m_queue.pop(&e)) {
+            q->m_deliver(e.m_data, e.m_message);
+            e.m_message.reset();
+            e.m_rules.reset();
+            q->delivered();
+        }
+
+        pthread_mutex_lock(&q->m_lock);
+        /* whoever waits in drain() checked m_delivered under the lock */
+        pthread_cond_broadcast(&q->m_drained);
+        q->m_waiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (q->m_queue.pop(&e) == false) {
+            if (q->m_stopping) {
+                q->m_waiting.store(false, std::memory_order_relaxed);
+                pthread_mutex_unlock(&q->m_lock);
+                break;
+            }
+            pthread_cond_wait(&q->m_cond, &q->m_lock);
+        }
+        q->m_waiting.store(false, std::memory_order_relaxed);
+        pthread_mutex_unlock(&q->m_lock);
+
+        if (e.m_message != nullptr) {
+            q->m_deliver(e.m_data, e.m_message);
+            e.m_message.reset();
+            e.m_rules.reset();
+            q->delivered();
+        }
+    }
+
+    return NULL;
+}
+
+
+}  // namespace Utils
+}  // namespace modsecurity
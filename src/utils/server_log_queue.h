@@ -0,0 +1,112 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <pthread.h>
+#include <sys/types.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#ifndef SRC_UTILS_SERVER_LOG_QUEUE_H_
+#define SRC_UTILS_SERVER_LOG_QUEUE_H_
+
+#include "src/utils/mpsc_queue.h"
+
+
+namespace modsecurity {
+class RuleMessage;
+class RulesSet;
+namespace Utils {
+
+
+/**
+ * Hands the rule messages to the server log callback from a thread of
+ * its own (AsyncLogProperty), so that neither the callback nor the
+ * formatting of the messages is paid for by the request threads.
+ *
+ * push() only queues the message, as it is, for the delivery thread to
+ * format, if at all, and to hand to the callback; the rules set it comes
+ * from, when it is given, is kept alive until then, as the message
+ * points to its rule. That thread is started
+ * by the first push() of each process, like the HTTPS audit log sender.
+ * When the callback can not keep up and kQueueLimit messages are
+ * waiting, new ones are dropped and counted.
+ *
+ * drain() waits for the messages queued so far to be delivered, for the
+ * connectors to free the data they gave along with them.
+ */
+class ServerLogQueue {
+ public:
+    static const size_t kQueueLimit = 4096;
+
+    typedef std::function<void(void *,
+        const std::shared_ptr<RuleMessage> &)> Deliver;
+
+    explicit ServerLogQueue(Deliver deliver);
+    /* delivers whatever is still queued before returning */
+    ~ServerLogQueue();
+
+    ServerLogQueue(const ServerLogQueue &) = delete;
+    ServerLogQueue &operator=(const ServerLogQueue &) = delete;
+
+    bool push(void *data, std::shared_ptr<RuleMessage> rm,
+        std::shared_ptr<RulesSet> rules);
+    /* not to be called from the callback, returns at once there */
+    void drain();
+
+    size_t dropped() const {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+ private:
+    struct Entry {
+        void *m_data;
+        std::shared_ptr<RuleMessage> m_message;
+        std::shared_ptr<RulesSet> m_rules;
+    };
+
+    static void *run(void *data);
+    void delivered() {
+        m_delivered.store(m_delivered.load(std::memory_order_relaxed) + 1,
+            std::memory_order_release);
+    }
+    bool start();
+
+    MpscQueue<Entry, kQueueLimit> m_queue;
+    Deliver m_deliver;
+    std::atomic<size_t> m_dropped;
+    /* messages queued and delivered, drain() waits for one to reach the
+     * other; m_delivered is only written by the delivery thread */
+    std::atomic<uint64_t> m_queued;
+    std::atomic<uint64_t> m_delivered;
+    /* the delivery thread is about to sleep, producers have to wake it */
+    std::atomic<bool> m_waiting;
+    /* process the delivery thread runs in, 0 before it is started */
+    std::atomic<pid_t> m_pid;
+    bool m_stopping;
+    pthread_t m_thread;
+    pthread_mutex_t m_lock;
+    pthread_cond_t m_cond;
+    pthread_cond_t m_drained;
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_SERVER_LOG_QUEUE_H_
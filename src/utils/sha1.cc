@@ -15,21 +15,51 @@
 
 
 #include "src/utils/sha1.h"
+#ifdef WITH_OPENSSL
+#include <openssl/evp.h>
+#else
 #include "others/mbedtls/sha1.h"
+#endif
 #include <fstream>
 #include <iostream>
 #include <cstring>
+#include <memory>
 
 namespace modsecurity {
 namespace Utils {
 
+namespace {
+
+
+/*
+ * With OpenSSL the digests use the SHA extensions of the CPU when there
+ * are some. The inputs are mostly a few dozen bytes, so the context is
+ * kept per thread: allocating one for each call would cost more than the
+ * hashing.
+ */
+void sha1(const std::string &input, unsigned char *output) {
+#ifdef WITH_OPENSSL
+    static thread_local std::unique_ptr<EVP_MD_CTX,
+        void (*)(EVP_MD_CTX *)> ctx(EVP_MD_CTX_new(), EVP_MD_CTX_free);
+
+    EVP_DigestInit_ex(ctx.get(), EVP_sha1(), nullptr);
+    EVP_DigestUpdate(ctx.get(), input.data(), input.size());
+    EVP_DigestFinal_ex(ctx.get(), output, nullptr);
+#else
+    mbedtls_sha1(reinterpret_cast<const unsigned char *>(input.c_str()),
+        input.size(), output);
+#endif
+}
+
+
+}  // namespace
+
 
 std::string Sha1::hexdigest(const std::string& input) {
     unsigned char digest[20] = { 0 };
     static const char* const lut = "0123456789abcdef";
 
-    mbedtls_sha1(reinterpret_cast<const unsigned char *>(input.c_str()),
-        input.size(), digest);
+    sha1(input, digest);
     std::string a;
 
     for (int i = 0; i < 20; i++) {
@@ -46,8 +76,7 @@ std::string Sha1::digest(const std::string& input) {
     unsigned char output[20];
     std::string ret;
 
-    mbedtls_sha1(reinterpret_cast<const unsigned char *>(input.c_str()),
-        input.size(), output);
+    sha1(input, output);
 
     ret.assign(reinterpret_cast<const char *>(output), 20);
 
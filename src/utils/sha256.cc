@@ -0,0 +1,165 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/sha256.h"
+#ifdef WITH_OPENSSL
+#include <openssl/evp.h>
+#endif
+#include <stdint.h>
+
+#include <cstring>
+#include <memory>
+#include <string>
+
+namespace modsecurity {
+namespace Utils {
+
+namespace {
+
+
+#ifdef WITH_OPENSSL
+void sha256(const std::string &input, unsigned char *output) {
+    static thread_local std::unique_ptr<EVP_MD_CTX,
+        void (*)(EVP_MD_CTX *)> ctx(EVP_MD_CTX_new(), EVP_MD_CTX_free);
+
+    EVP_DigestInit_ex(ctx.get(), EVP_sha256(), nullptr);
+    EVP_DigestUpdate(ctx.get(), input.data(), input.size());
+    EVP_DigestFinal_ex(ctx.get(), output, nullptr);
+}
+#else
+/* FIPS 180-4; the bundled mbed TLS only has MD5 and SHA-1. */
+const uint32_t kRound[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+
+inline uint32_t rotr(uint32_t x, int n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+
+void block(uint32_t *state, const unsigned char *data) {
+    uint32_t w[64];
+
+    for (int i = 0; i < 16; i++) {
+        w[i] = (static_cast<uint32_t>(data[i * 4]) << 24)
+            | (static_cast<uint32_t>(data[i * 4 + 1]) << 16)
+            | (static_cast<uint32_t>(data[i * 4 + 2]) << 8)
+            | static_cast<uint32_t>(data[i * 4 + 3]);
+    }
+    for (int i = 16; i < 64; i++) {
+        uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18)
+            ^ (w[i - 15] >> 3);
+        uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19)
+            ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int i = 0; i < 64; i++) {
+        uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+        uint32_t ch = (e & f) ^ (~e & g);
+        uint32_t t1 = h + s1 + ch + kRound[i] + w[i];
+        uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+        uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+        uint32_t t2 = s0 + maj;
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+
+void sha256(const std::string &input, unsigned char *output) {
+    uint32_t state[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    const unsigned char *data =
+        reinterpret_cast<const unsigned char *>(input.data());
+    size_t size = input.size();
+    size_t done = 0;
+    unsigned char last[128] = { 0 };
+
+    for (; size - done >= 64; done += 64) {
+        block(state, data + done);
+    }
+
+    /* what is left, the 0x80, the zeros and the size in bits */
+    size_t left = size - done;
+    size_t padded = left < 56 ? 64 : 128;
+    uint64_t bits = static_cast<uint64_t>(size) * 8;
+    memcpy(last, data + done, left);
+    last[left] = 0x80;
+    for (int i = 0; i < 8; i++) {
+        last[padded - 1 - i] = static_cast<unsigned char>(bits >> (i * 8));
+    }
+    block(state, last);
+    if (padded == 128) {
+        block(state, last + 64);
+    }
+
+    for (int i = 0; i < 8; i++) {
+        output[i * 4] = static_cast<unsigned char>(state[i] >> 24);
+        output[i * 4 + 1] = static_cast<unsigned char>(state[i] >> 16);
+        output[i * 4 + 2] = static_cast<unsigned char>(state[i] >> 8);
+        output[i * 4 + 3] = static_cast<unsigned char>(state[i]);
+    }
+}
+#endif
+
+
+}  // namespace
+
+
+std::string Sha256::digest(const std::string& input) {
+    unsigned char output[32];
+    std::string ret;
+
+    sha256(input, output);
+
+    ret.assign(reinterpret_cast<const char *>(output), 32);
+
+    return ret;
+}
+
+
+}  // namespace Utils
+}  // namespace modsecurity
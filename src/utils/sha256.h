@@ -0,0 +1,36 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+
+#ifndef SRC_UTILS_SHA256_H_
+#define SRC_UTILS_SHA256_H_
+
+#include <string>
+
+namespace modsecurity {
+namespace Utils {
+
+class Sha256 {
+ public:
+    Sha256() { }
+
+    /* the 32 bytes of the digest */
+    static std::string digest(const std::string& input);
+};
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_SHA256_H_
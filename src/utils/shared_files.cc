@@ -31,6 +31,9 @@
 #include <fstream>
 #include <string>
 
+#include "src/utils/metrics.h"
+#include "src/utils/system.h"
+
 namespace modsecurity {
 namespace utils {
 
@@ -129,7 +132,7 @@ bool SharedFiles::open(const std::string& fileName, std::string *error) {
     bool ret = true;
 
     #if MODSEC_USE_GENERAL_LOCK
-    pthread_mutex_lock(m_generalLock);
+    Utils::Metrics::lock(m_generalLock, Utils::Metrics::SharedFilesMutexLock);
 #endif
 
     a = find_handler(fileName);
@@ -163,7 +166,7 @@ void SharedFiles::close(const std::string& fileName) {
     /* int j = 0; */
 
 #if MODSEC_USE_GENERAL_LOCK
-    pthread_mutex_lock(m_generalLock);
+    Utils::Metrics::lock(m_generalLock, Utils::Metrics::SharedFilesMutexLock);
 #endif
 
     if (fileName.empty()) {
@@ -216,35 +219,66 @@ out:
 }
 
 
+/*
+ * The files are opened in append mode, so every write(2) lands, as a whole,
+ * at the end of the file no matter how many threads (or processes) are
+ * writing to it. Issuing each record as a single write is enough to keep
+ * them from being interleaved; there is no need to serialize the writers on
+ * a file lock, nor to go through (and flush) the stdio buffer.
+ *
+ * The whole file lock is only taken when MODSEC_USE_GENERAL_LOCK asks for
+ * the cross process critical sections.
+ *
+ */
 bool SharedFiles::write(const std::string& fileName,
     const std::string &msg, std::string *error) {
     std::pair<msc_file_handler *, FILE *> a;
-    std::string lmsg = msg;
-    size_t wrote;
-    struct flock lock{};
+    const char *data = msg.c_str();
+    size_t left = msg.size();
     bool ret = true;
+    int fd;
+#if MODSEC_USE_GENERAL_LOCK
+    struct flock lock{};
+#endif
 
     a = find_handler(fileName);
     if (a.first == NULL) {
         error->assign("file is not open: " + fileName);
         return false;
     }
+    fd = fileno(a.second);
 
+#if MODSEC_USE_GENERAL_LOCK
     //Exclusively lock whole file
     lock.l_start = lock.l_len = lock.l_whence = 0;
     lock.l_type = F_WRLCK;
-    fcntl(fileno(a.second), F_SETLKW, &lock);
+    if (fcntl(fd, F_SETLK, &lock) != 0) {
+        uint64_t start = monotonic_ns();
+        fcntl(fd, F_SETLKW, &lock);
+        Utils::Metrics::getInstance().waited(
+            Utils::Metrics::SharedFilesFileLock, monotonic_ns() - start);
+    }
+#endif
 
-    wrote = fwrite(lmsg.c_str(), 1, lmsg.size(), a.second);
-    if (wrote < msg.size()) {
-        error->assign("failed to write: " + fileName);
-        ret = false;
+    while (left > 0) {
+        ssize_t wrote = ::write(fd, data, left);
+        if (wrote < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            error->assign("failed to write: " + fileName);
+            ret = false;
+            break;
+        }
+        data = data + wrote;
+        left = left - wrote;
     }
-    fflush(a.second);
 
+#if MODSEC_USE_GENERAL_LOCK
     //Remove exclusive lock
     lock.l_type = F_UNLCK;
-    fcntl(fileno(a.second), F_SETLKW, &lock);
+    fcntl(fd, F_SETLKW, &lock);
+#endif
 
     return ret;
 }
@@ -44,21 +44,17 @@ namespace modsecurity {
 namespace utils {
 
 
-double cpu_seconds(void) {
-    /*
-     * FIXME: Temporary hack to fix build on MacOS X.  Very issuficient way, but
-     *      works.  Worth reimplementing using mach_absolute_time().
-     */
-#ifndef MACOSX
+/*
+ * The clock for everything that measures time spent: DURATION, the phase
+ * timings, the rule profiler and the metrics. CLOCK_MONOTONIC is read in
+ * the vDSO, without entering the kernel, and is not affected by changes
+ * of the wall clock.
+ */
+uint64_t monotonic_ns(void) {
     struct timespec t;
-    if (!clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &t))
-        return static_cast<double>(t.tv_sec)
-            + static_cast<double>(t.tv_nsec / 1000000000.0);
-    else
-        return static_cast<double>(clock()) /
-            static_cast<double>(CLOCKS_PER_SEC);
-#endif
-        return 0;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return static_cast<uint64_t>(t.tv_sec) * 1000000000ULL
+        + static_cast<uint64_t>(t.tv_nsec);
 }
 
 
@@ -13,6 +13,8 @@
  *
  */
 
+#include <stdint.h>
+
 #include <ctime>
 #include <iostream>
 #include <string>
@@ -28,7 +30,7 @@ namespace modsecurity {
 namespace utils {
 
 
-double cpu_seconds(void);
+uint64_t monotonic_ns(void);
 std::string find_resource(const std::string& file, const std::string& config,
     std::string *err);
 std::string get_path(const std::string& file);
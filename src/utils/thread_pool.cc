@@ -0,0 +1,232 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/thread_pool.h"
+
+#include <unistd.h>
+
+#include <vector>
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+ThreadPool::Batch::Batch()
+    : m_pending(0) {
+    pthread_mutex_init(&m_lock, NULL);
+    pthread_cond_init(&m_done, NULL);
+}
+
+
+ThreadPool::Batch::~Batch() {
+    pthread_cond_destroy(&m_done);
+    pthread_mutex_destroy(&m_lock);
+}
+
+
+/*
+ * The count drops with the lock held: once wait() sees it at zero the
+ * batch goes away, so nothing of it may be touched after the unlock.
+ */
+void ThreadPool::Batch::finish() {
+    pthread_mutex_lock(&m_lock);
+    if (--m_pending == 0) {
+        pthread_cond_broadcast(&m_done);
+    }
+    pthread_mutex_unlock(&m_lock);
+}
+
+
+void ThreadPool::Batch::wait() {
+    pthread_mutex_lock(&m_lock);
+    while (m_pending > 0) {
+        pthread_cond_wait(&m_done, &m_lock);
+    }
+    pthread_mutex_unlock(&m_lock);
+}
+
+
+ThreadPool::ThreadPool(size_t threads)
+    : m_threads(threads > 0 ? threads : 1),
+    m_queued(0),
+    m_next(0),
+    m_pid(0),
+    m_stopping(false) {
+    pthread_mutex_init(&m_lock, NULL);
+    pthread_cond_init(&m_wake, NULL);
+    /* The last queue is where the callers of run() take from first. */
+    for (size_t i = 0; i < m_threads; i++) {
+        m_queues.push_back(new Queue());
+    }
+}
+
+
+ThreadPool::~ThreadPool() {
+    stop();
+    for (Queue *q : m_queues) {
+        delete q;
+    }
+    pthread_cond_destroy(&m_wake);
+    pthread_mutex_destroy(&m_lock);
+}
+
+
+void ThreadPool::start() {
+    pthread_mutex_lock(&m_lock);
+    if (m_pid != getpid()) {
+        /* Threads do not survive a fork(); only the bookkeeping does. */
+        m_workers.clear();
+        m_workers.reserve(m_threads - 1);
+        m_stopping = false;
+        for (size_t i = 0; i + 1 < m_threads; i++) {
+            m_workers.push_back(Worker());
+            Worker &w = m_workers.back();
+            w.m_pool = this;
+            w.m_queue = i;
+            if (pthread_create(&w.m_thread, NULL, work, &w) != 0) {
+                /* Whatever is queued for it is stolen by the others. */
+                m_workers.pop_back();
+            }
+        }
+        m_pid.store(getpid(), std::memory_order_release);
+    }
+    pthread_mutex_unlock(&m_lock);
+}
+
+
+void ThreadPool::stop() {
+    pthread_mutex_lock(&m_lock);
+    if (m_pid != getpid()) {
+        pthread_mutex_unlock(&m_lock);
+        return;
+    }
+    m_stopping = true;
+    pthread_cond_broadcast(&m_wake);
+    pthread_mutex_unlock(&m_lock);
+
+    for (Worker &w : m_workers) {
+        pthread_join(w.m_thread, NULL);
+    }
+    m_workers.clear();
+    m_pid.store(0, std::memory_order_release);
+}
+
+
+/**
+ * Takes the newest task of the given queue or, if it is empty, the oldest
+ * one of any other.
+ */
+bool ThreadPool::take(size_t queue, Task *task) {
+    if (m_queued == 0) {
+        return false;
+    }
+    for (size_t i = 0; i < m_queues.size(); i++) {
+        Queue *q = m_queues[(queue + i) % m_queues.size()];
+        pthread_mutex_lock(&q->m_lock);
+        if (q->m_tasks.empty() == false) {
+            if (i == 0) {
+                *task = q->m_tasks.back();
+                q->m_tasks.pop_back();
+            } else {
+                *task = q->m_tasks.front();
+                q->m_tasks.pop_front();
+            }
+            m_queued--;
+            pthread_mutex_unlock(&q->m_lock);
+            return true;
+        }
+        pthread_mutex_unlock(&q->m_lock);
+    }
+    return false;
+}
+
+
+void ThreadPool::execute(const Task &task) {
+    (*task.m_function)();
+    task.m_batch->finish();
+}
+
+
+void *ThreadPool::work(void *data) {
+    Worker *w = reinterpret_cast<Worker *>(data);
+    ThreadPool *pool = w->m_pool;
+    Task task;
+
+    while (true) {
+        if (pool->take(w->m_queue, &task)) {
+            pool->execute(task);
+            continue;
+        }
+        pthread_mutex_lock(&pool->m_lock);
+        while (pool->m_queued == 0 && pool->m_stopping == false) {
+            pthread_cond_wait(&pool->m_wake, &pool->m_lock);
+        }
+        bool stopping = pool->m_stopping;
+        pthread_mutex_unlock(&pool->m_lock);
+        if (stopping) {
+            return NULL;
+        }
+    }
+}
+
+
+void ThreadPool::run(const std::vector<std::function<void()>> &tasks) {
+    if (tasks.empty()) {
+        return;
+    }
+    if (m_threads == 1 || tasks.size() == 1) {
+        for (const auto &f : tasks) {
+            f();
+        }
+        return;
+    }
+    if (m_pid.load(std::memory_order_acquire) != getpid()) {
+        start();
+    }
+
+    Batch batch;
+    batch.m_pending = tasks.size();
+
+    /*
+     * Spread from a different queue every time, so that batches of a
+     * single task or two do not always land on the same worker.
+     */
+    size_t first = m_next++;
+    for (size_t i = 0; i < tasks.size(); i++) {
+        Queue *q = m_queues[(first + i) % m_queues.size()];
+        Task task;
+        task.m_function = &tasks[i];
+        task.m_batch = &batch;
+        pthread_mutex_lock(&q->m_lock);
+        q->m_tasks.push_back(task);
+        m_queued++;
+        pthread_mutex_unlock(&q->m_lock);
+    }
+    pthread_mutex_lock(&m_lock);
+    pthread_cond_broadcast(&m_wake);
+    pthread_mutex_unlock(&m_lock);
+
+    /* Help out until nothing is left, then wait for the running ones. */
+    Task task;
+    while (batch.m_pending > 0 && take(m_queues.size() - 1, &task)) {
+        execute(task);
+    }
+    batch.wait();
+}
+
+
+}  // namespace Utils
+}  // namespace modsecurity
@@ -0,0 +1,121 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <pthread.h>
+#include <sys/types.h>
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <vector>
+
+#ifndef SRC_UTILS_THREAD_POOL_H_
+#define SRC_UTILS_THREAD_POOL_H_
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+/**
+ * Fixed set of worker threads running batches of short tasks.
+ *
+ * Every worker has its own queue; a batch is spread over all of them and
+ * a worker that runs out of tasks takes the oldest ones of the others, so
+ * an uneven batch still keeps them all busy. The thread calling run()
+ * takes part as well, which is why a pool of n threads only starts n - 1
+ * workers. Batches of different callers may run at the same time.
+ *
+ * The workers are started by the first run() of each process, so a pool
+ * built before the server forks its children works in every one of them.
+ */
+class ThreadPool {
+ public:
+    explicit ThreadPool(size_t threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * Runs every task, in no given order, and returns once all of them
+     * are done. The tasks must not throw.
+     */
+    void run(const std::vector<std::function<void()>> &tasks);
+
+    size_t threads() const { return m_threads; }
+
+ private:
+    class Batch {
+     public:
+        Batch();
+        ~Batch();
+        void finish();
+        void wait();
+
+        std::atomic<size_t> m_pending;
+        pthread_mutex_t m_lock;
+        pthread_cond_t m_done;
+    };
+
+    class Task {
+     public:
+        const std::function<void()> *m_function;
+        Batch *m_batch;
+    };
+
+    class Worker {
+     public:
+        ThreadPool *m_pool;
+        size_t m_queue;
+        pthread_t m_thread;
+    };
+
+    class Queue {
+     public:
+        Queue() { pthread_mutex_init(&m_lock, NULL); }
+        ~Queue() { pthread_mutex_destroy(&m_lock); }
+
+        pthread_mutex_t m_lock;
+        std::deque<Task> m_tasks;
+    };
+
+    static void *work(void *data);
+    bool take(size_t queue, Task *task);
+    void execute(const Task &task);
+    void start();
+    void stop();
+
+    const size_t m_threads;
+    std::vector<Queue *> m_queues;
+    std::vector<Worker> m_workers;
+    std::atomic<size_t> m_queued;
+    std::atomic<size_t> m_next;
+    pthread_mutex_t m_lock;
+    pthread_cond_t m_wake;
+    /*
+     * The process the workers were started in. Written under m_lock; run()
+     * reads it without, to skip start() once the workers are there.
+     */
+    std::atomic<pid_t> m_pid;
+    bool m_stopping;
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_THREAD_POOL_H_
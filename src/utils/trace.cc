@@ -0,0 +1,59 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/trace.h"
+
+#include <time.h>
+
+#include <string>
+
+#include "src/utils/system.h"
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+static uint64_t realtimeNs() {
+    struct timespec t;
+    clock_gettime(CLOCK_REALTIME, &t);
+    return static_cast<uint64_t>(t.tv_sec) * 1000000000ULL
+        + static_cast<uint64_t>(t.tv_nsec);
+}
+
+
+void Trace::span(Transaction *t, const char *name, uint64_t start,
+    uint64_t duration, int64_t ruleId, const std::string *detail) {
+    ModSecuritySpan s;
+    uint64_t ago = utils::monotonic_ns() - start;
+
+    s.name = name;
+    s.detail = detail ? detail->c_str() : NULL;
+    s.rule_id = ruleId;
+    s.start = realtimeNs() - ago;
+    s.duration = duration;
+
+    t->m_ms->traceCb()(t->m_traceParent, &s);
+}
+
+
+void Trace::event(Transaction *t, const char *name, int64_t ruleId,
+    const std::string *detail) {
+    span(t, name, utils::monotonic_ns(), 0, ruleId, detail);
+}
+
+
+}  // namespace Utils
+}  // namespace modsecurity
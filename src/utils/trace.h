@@ -0,0 +1,64 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <stdint.h>
+
+#include <string>
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/trace.h"
+#include "modsecurity/transaction.h"
+
+#ifndef SRC_UTILS_TRACE_H_
+#define SRC_UTILS_TRACE_H_
+
+
+namespace modsecurity {
+namespace Utils {
+
+
+/**
+ * Spans for the connector's tracer (see ModSecurity::setTraceCb). Times
+ * are of the monotonic clock; the callback gets them on the epoch.
+ *
+ * enabled() is all an untraced transaction pays for: check it before
+ * reading the clock.
+ *
+ */
+class Trace {
+ public:
+    static bool enabled(const Transaction *t) {
+        return t != nullptr && t->m_traceParent != nullptr
+            && t->m_ms->traceCb() != nullptr;
+    }
+
+    /* Whether a span of an operator or a variable is worth reporting. */
+    static bool slow(const Transaction *t, uint64_t duration) {
+        return duration >= t->m_ms->traceThreshold();
+    }
+
+    static void span(Transaction *t, const char *name, uint64_t start,
+        uint64_t duration, int64_t ruleId = 0,
+        const std::string *detail = nullptr);
+
+    static void event(Transaction *t, const char *name, int64_t ruleId,
+        const std::string *detail);
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_TRACE_H_
@@ -0,0 +1,302 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "src/utils/verdict_cache.h"
+
+#include <pthread.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "modsecurity/actions/action.h"
+#include "modsecurity/transaction.h"
+#include "src/actions/set_var.h"
+#include "src/collection/backend/in_memory-per_transaction.h"
+#include "src/run_time_string.h"
+#include "src/utils/string.h"
+#include "src/variables/tx.h"
+#include "src/variables/variable.h"
+
+
+namespace modsecurity {
+namespace Utils {
+
+namespace {
+
+/*
+ * What differs from a request to the next one that is otherwise the same:
+ * the clock, the ids, the persistent collections (and ENV, as setenv is
+ * process wide) and how far the transaction went.
+ */
+const char *notCacheable[] = {
+    "DURATION", "ENV", "GLOBAL", "IP", "MSC_TIME_BUDGET_EXCEEDED",
+    "RESOURCE", "SESSION", "TIME", "TIME_DAY", "TIME_EPOCH", "TIME_HOUR",
+    "TIME_MIN", "TIME_MON", "TIME_SEC", "TIME_WDAY", "TIME_YEAR",
+    "UNIQUE_ID", "USER", "WEBSERVER_ERROR_LOG", NULL
+};
+
+
+/* Actions with effects outside the transaction, or past its request. */
+const char *notCacheableActions[] = {
+    "ctl", "deprecatevar", "exec", "expirevar", "initcol", "pause",
+    "proxy", "sanitisearg", "sanitisematched", "sanitisematchedbytes",
+    "sanitiserequestheader", "sanitiseresponseheader", "setenv", "setrsc",
+    "setsid", "setuid", NULL
+};
+
+
+void append(std::string *key, const std::string &s) {
+    key->append(std::to_string(s.size()));
+    key->push_back(':');
+    key->append(s);
+}
+
+}  // namespace
+
+
+VerdictCache::VerdictCache(size_t capacity)
+    : m_capacity(capacity > 0 ? capacity : 1),
+    m_hits(0),
+    m_misses(0),
+    m_evictions(0) {
+    m_index.reserve(m_capacity);
+    pthread_mutex_init(&m_lock, NULL);
+}
+
+
+VerdictCache::~VerdictCache() {
+    m_index.clear();
+    m_entries.clear();
+    pthread_mutex_destroy(&m_lock);
+}
+
+
+/**
+ * Every part is prefixed with its length, so that no two requests end up
+ * with the same key by moving bytes from one part to the next. The
+ * headers are sorted by name, as their order in the map is not the order
+ * they came in.
+ *
+ */
+bool VerdictCache::key(Transaction *t, unsigned int inputs,
+    std::string *key) {
+    collection::backend::InMemoryPerTransaction *tx =
+        dynamic_cast<collection::backend::InMemoryPerTransaction *>(
+            t->m_collections.m_tx_collection);
+    if (tx == nullptr) {
+        return false;
+    }
+
+    std::vector<const VariableValue *> headers;
+    for (const auto &h : t->m_variableRequestHeaders) {
+        headers.push_back(h.second);
+    }
+    std::stable_sort(headers.begin(), headers.end(),
+        [](const VariableValue *a, const VariableValue *b) {
+            return a->getKey() < b->getKey();
+        });
+
+    key->clear();
+    append(key, t->m_variableRequestLine.m_value);
+    key->append(std::to_string(headers.size()));
+    key->push_back(':');
+    for (const VariableValue *h : headers) {
+        append(key, h->getKey());
+        append(key, h->getValue());
+        if (key->size() > kMaxKeySize) {
+            return false;
+        }
+    }
+
+    if (inputs & ClientAddressInput) {
+        append(key, t->m_clientIpAddress ? *t->m_clientIpAddress : "");
+    }
+    if (inputs & ClientPortInput) {
+        append(key, std::to_string(t->m_clientPort));
+    }
+    if (inputs & ServerInput) {
+        append(key, t->m_serverIpAddress ? *t->m_serverIpAddress : "");
+        append(key, std::to_string(t->m_serverPort));
+    }
+    append(key, std::to_string(t->m_highestSeverityAction));
+
+    std::vector<std::pair<std::string, std::string>> values;
+    tx->dump(&values);
+    for (const auto &v : values) {
+        append(key, v.first);
+        append(key, v.second);
+    }
+
+    return key->size() <= kMaxKeySize;
+}
+
+
+bool VerdictCache::cacheable(const variables::Variable *v,
+    unsigned int *inputs) {
+    std::string name = utils::string::toupper(v->m_collectionName);
+
+    for (int i = 0; notCacheable[i] != NULL; i++) {
+        if (name == notCacheable[i]) {
+            return false;
+        }
+    }
+    if (name == "REMOTE_ADDR" || name == "REMOTE_HOST") {
+        *inputs |= ClientAddressInput;
+    } else if (name == "REMOTE_PORT") {
+        *inputs |= ClientPortInput;
+    } else if (name == "SERVER_ADDR" || name == "SERVER_PORT") {
+        *inputs |= ServerInput;
+    }
+
+    const variables::Tx_DynamicElement *dynamic =
+        dynamic_cast<const variables::Tx_DynamicElement *>(v);
+    if (dynamic != nullptr) {
+        return cacheable(dynamic->m_string.get(), inputs);
+    }
+    return true;
+}
+
+
+bool VerdictCache::cacheable(const RunTimeString *s, unsigned int *inputs) {
+    if (s == nullptr) {
+        return true;
+    }
+    for (const RunTimeElementHolder &e : s->elements()) {
+        if (e.m_var && cacheable(e.m_var.get(), inputs) == false) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/**
+ * setvar has to write to TX, whatever else it writes to lives on after
+ * the transaction; what it reads is checked as any other macro.
+ *
+ */
+bool VerdictCache::cacheable(const actions::Action *a, unsigned int *inputs) {
+    if (a == nullptr) {
+        return true;
+    }
+
+    const actions::SetVar *setVar = dynamic_cast<const actions::SetVar *>(a);
+    if (setVar != nullptr) {
+        const variables::Variable *v = setVar->getVariable();
+        return v != nullptr
+            && utils::string::toupper(v->m_collectionName) == "TX"
+            && cacheable(v, inputs)
+            && cacheable(setVar->getValue(), inputs);
+    }
+
+    if (a->m_name == nullptr) {
+        return true;
+    }
+    std::string name = utils::string::tolower(*a->m_name);
+    for (int i = 0; notCacheableActions[i] != NULL; i++) {
+        if (name == notCacheableActions[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+std::shared_ptr<const VerdictCache::Verdict> VerdictCache::find(
+    const std::string &key, Slot slot) {
+    std::shared_ptr<const Verdict> verdict;
+
+    pthread_mutex_lock(&m_lock);
+    auto it = m_index.find(key);
+    if (it != m_index.end()) {
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        verdict = it->second->m_verdicts[slot];
+    }
+    if (verdict != nullptr) {
+        m_hits++;
+    } else {
+        m_misses++;
+    }
+    pthread_mutex_unlock(&m_lock);
+
+    return verdict;
+}
+
+
+void VerdictCache::insert(const std::string &key, Slot slot,
+    std::shared_ptr<const Verdict> verdict) {
+    pthread_mutex_lock(&m_lock);
+    auto it = m_index.find(key);
+    if (it != m_index.end()) {
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        it->second->m_verdicts[slot] = std::move(verdict);
+        pthread_mutex_unlock(&m_lock);
+        return;
+    }
+    if (slot != RequestHeadersSlot) {
+        pthread_mutex_unlock(&m_lock);
+        return;
+    }
+
+    if (m_entries.size() >= m_capacity) {
+        m_index.erase(m_entries.back().m_key);
+        m_entries.pop_back();
+        m_evictions++;
+    }
+    m_entries.emplace_front();
+    m_entries.front().m_key = key;
+    m_entries.front().m_verdicts[slot] = std::move(verdict);
+    m_index[key] = m_entries.begin();
+    pthread_mutex_unlock(&m_lock);
+}
+
+
+size_t VerdictCache::size() {
+    pthread_mutex_lock(&m_lock);
+    size_t s = m_entries.size();
+    pthread_mutex_unlock(&m_lock);
+    return s;
+}
+
+
+size_t VerdictCache::hits() {
+    pthread_mutex_lock(&m_lock);
+    size_t s = m_hits;
+    pthread_mutex_unlock(&m_lock);
+    return s;
+}
+
+
+size_t VerdictCache::misses() {
+    pthread_mutex_lock(&m_lock);
+    size_t s = m_misses;
+    pthread_mutex_unlock(&m_lock);
+    return s;
+}
+
+
+size_t VerdictCache::evictions() {
+    pthread_mutex_lock(&m_lock);
+    size_t s = m_evictions;
+    pthread_mutex_unlock(&m_lock);
+    return s;
+}
+
+
+}  // namespace Utils
+}  // namespace modsecurity
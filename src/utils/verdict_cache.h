@@ -0,0 +1,149 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <pthread.h>
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifndef SRC_UTILS_VERDICT_CACHE_H_
+#define SRC_UTILS_VERDICT_CACHE_H_
+
+
+namespace modsecurity {
+class RunTimeString;
+class Transaction;
+namespace actions {
+class Action;
+}
+namespace variables {
+class Variable;
+}
+
+namespace Utils {
+
+
+/**
+ * Bounded LRU of what the request phases came to for a given request
+ * (SecVerdictCache), so that the next request that is the very same (a
+ * health check, the same asset fetched over and over) does not go through
+ * the rules again.
+ *
+ * The key is everything the rules of the two phases can look at: the
+ * request line, the headers and, when some rule reads them, the client
+ * and server addresses, along with the TX collection and the highest
+ * severity as the phase found them. Only a phase that ended without an
+ * intervention, without a rule message and without being cut short (time
+ * budget, overload) is stored; the verdict is then what it left in TX and
+ * the highest severity, which is put back on a hit in place of running
+ * the rules. The request body phase is only answered for a request with
+ * no body whose headers phase was answered too.
+ *
+ * What a hit does not restore is what the rules say only when they run:
+ * the debug log and the MATCHED_VAR* variables of the skipped rules.
+ *
+ * A RulesSet owns one, rebuilt on every merge, so a verdict never outlives
+ * the rules it came from.
+ *
+ */
+class VerdictCache {
+ public:
+    enum Slot {
+        RequestHeadersSlot,
+        RequestBodySlot,
+        NumberOfSlots
+    };
+
+    /* The inputs a rule reads beyond the request line and the headers. */
+    enum Input {
+        ClientAddressInput = 1 << 0,
+        ClientPortInput = 1 << 1,
+        ServerInput = 1 << 2,
+    };
+
+    /* Requests whose key would be longer than this are not cached. */
+    static const size_t kMaxKeySize = 8192;
+
+    class Verdict {
+     public:
+        Verdict() : m_highestSeverity(255) { }
+
+        std::vector<std::pair<std::string, std::string>> m_tx;
+        int m_highestSeverity;
+    };
+
+    explicit VerdictCache(size_t capacity);
+    ~VerdictCache();
+
+    VerdictCache(const VerdictCache&) = delete;
+    VerdictCache& operator=(const VerdictCache&) = delete;
+
+    /*
+     * The key of the request of t, false if it is too long to be worth
+     * caching; inputs are the Input the rules read.
+     */
+    static bool key(Transaction *t, unsigned int inputs, std::string *key);
+
+    /*
+     * Whether a rule reading v (a target, a macro, what a setvar writes)
+     * can be cached, adding to *inputs what of the Input it reads.
+     */
+    static bool cacheable(const variables::Variable *v,
+        unsigned int *inputs);
+    static bool cacheable(const RunTimeString *s, unsigned int *inputs);
+    /* Whether a leaves nothing behind but TX. */
+    static bool cacheable(const actions::Action *a, unsigned int *inputs);
+
+    std::shared_ptr<const Verdict> find(const std::string &key, Slot slot);
+    /*
+     * The request body slot is only stored for a key whose headers slot
+     * still is.
+     */
+    void insert(const std::string &key, Slot slot,
+        std::shared_ptr<const Verdict> verdict);
+
+    size_t capacity() const { return m_capacity; }
+    size_t size();
+    size_t hits();
+    size_t misses();
+    size_t evictions();
+
+ private:
+    struct Entry {
+        std::string m_key;
+        std::shared_ptr<const Verdict> m_verdicts[NumberOfSlots];
+    };
+
+    size_t m_capacity;
+    size_t m_hits;
+    size_t m_misses;
+    size_t m_evictions;
+
+    /* most recently used first */
+    std::list<Entry> m_entries;
+    std::unordered_map<std::string, std::list<Entry>::iterator> m_index;
+    pthread_mutex_t m_lock;
+};
+
+
+}  // namespace Utils
+}  // namespace modsecurity
+
+#endif  // SRC_UTILS_VERDICT_CACHE_H_
@@ -0,0 +1,81 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "modsecurity/variable_value.h"
+
+#include <string>
+
+#include "src/utils/interned_strings.h"
+
+
+namespace modsecurity {
+
+namespace {
+
+/*
+ * The names a thread looked up last. A rule set has a few dozen
+ * collections and the values come a collection at a time, so the lock
+ * behind InternedStrings is seldom taken once the thread is warm.
+ */
+const size_t kCollectionCache = 16;
+
+struct CollectionCache {
+    const std::string *m_names[kCollectionCache];
+    size_t m_next;
+};
+
+thread_local CollectionCache collectionCache = { { nullptr }, 0 };
+
+}  // namespace
+
+
+const std::string *VariableValue::internCollection(const std::string &name) {
+    static const std::string empty;
+    if (name.empty()) {
+        return &empty;
+    }
+
+    CollectionCache &cache = collectionCache;
+    for (size_t i = 0; i < kCollectionCache; i++) {
+        const std::string *n = cache.m_names[i];
+        if (n == nullptr) {
+            break;
+        }
+        if (*n == name) {
+            return n;
+        }
+    }
+
+    const std::string *n = Utils::InternedStrings::find(name);
+    cache.m_names[cache.m_next] = n;
+    cache.m_next = (cache.m_next + 1) % kCollectionCache;
+    return n;
+}
+
+
+const std::string *VariableValue::buildKeyWithCollection() const {
+    const std::string *k = new std::string(*m_collection + ":" + m_key);
+    const std::string *expected = nullptr;
+    if (m_keyWithCollection.compare_exchange_strong(expected, k,
+        std::memory_order_acq_rel, std::memory_order_acquire) == false) {
+        /* another thread got there first */
+        delete k;
+        return expected;
+    }
+    return k;
+}
+
+
+}  // namespace modsecurity
@@ -30,7 +30,9 @@ namespace variables {
 void Duration::evaluate(Transaction *transaction,
     RuleWithActions *rule,
     std::vector<const VariableValue *> *l) {
-    double e = utils::cpu_seconds() - transaction->m_creationTimeStamp;
+    /* Milliseconds of wall clock time, as in ModSecurity 2. */
+    uint64_t e = (utils::monotonic_ns() - transaction->m_creationTimeStamp)
+        / 1000000;
 
     transaction->m_variableDuration.assign(std::to_string(e));
 
@@ -23,6 +23,7 @@
 #define SRC_VARIABLES_GEO_H_
 
 #include "src/variables/variable.h"
+#include "src/utils/geo_lookup.h"
 
 namespace modsecurity {
 
@@ -30,7 +31,73 @@ class Transaction;
 namespace variables {
 
 
-DEFINE_VARIABLE_DICT(Geo, GEO, m_variableGeo)
+/*
+ * As DEFINE_VARIABLE_DICT, but telling @geoLookup which fields the rules
+ * are going to look at.
+ */
+class Geo_DictElement : public VariableDictElement {
+ public:
+    explicit Geo_DictElement(const std::string &dictElement)
+        : VariableDictElement("GEO", dictElement) {
+        Utils::GeoLookup::getInstance().want(dictElement);
+    }
+
+    void evaluate(Transaction *transaction,
+        RuleWithActions *rule,
+        std::vector<const VariableValue *> *l) override {
+        transaction->m_variableGeo.resolve(m_dictElement, l);
+    }
+
+    bool evaluateBorrowed(Transaction *transaction,
+        RuleWithActions *rule,
+        std::vector<const VariableValue *> *l) override {
+        return transaction->m_variableGeo.resolveBorrowed(m_dictElement, l);
+    }
+};
+
+
+class Geo_NoDictElement : public Variable {
+ public:
+    Geo_NoDictElement()
+        : Variable("GEO") {
+        Utils::GeoLookup::getInstance().wantAll();
+    }
+
+    void evaluate(Transaction *transaction,
+        RuleWithActions *rule,
+        std::vector<const VariableValue *> *l) override {
+        transaction->m_variableGeo.resolve(l, m_keyExclusion);
+    }
+
+    bool evaluateBorrowed(Transaction *transaction,
+        RuleWithActions *rule,
+        std::vector<const VariableValue *> *l) override {
+        return transaction->m_variableGeo.resolveBorrowed(l, m_keyExclusion);
+    }
+};
+
+
+class Geo_DictElementRegexp : public VariableRegex {
+ public:
+    explicit Geo_DictElementRegexp(const std::string &regex)
+        : VariableRegex("GEO", regex) {
+        Utils::GeoLookup::getInstance().wantAll();
+    }
+
+    void evaluate(Transaction *transaction,
+        RuleWithActions *rule,
+        std::vector<const VariableValue *> *l) override {
+        transaction->m_variableGeo.resolveRegularExpression(&m_r, l,
+            m_keyExclusion);
+    }
+
+    bool evaluateBorrowed(Transaction *transaction,
+        RuleWithActions *rule,
+        std::vector<const VariableValue *> *l) override {
+        return transaction->m_variableGeo.resolveRegularExpressionBorrowed(
+            &m_r, l, m_keyExclusion);
+    }
+};
 
 
 }  // namespace variables
@@ -112,6 +112,13 @@ class Resource_DynamicElement : public Variable {
             t->m_rules->m_secWebAppId.m_value, value);
     }
 
+    static bool atomicAdd(Transaction *t, const std::string &var, int delta,
+        int *result) {
+        return t->m_collections.m_resource_collection->atomicAdd(
+            var, t->m_collections.m_resource_collection_key,
+            t->m_rules->m_secWebAppId.m_value, delta, result);
+    }
+
     std::unique_ptr<RunTimeString> m_string;
 };
 
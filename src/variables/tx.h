@@ -45,6 +45,16 @@ class Tx_DictElement : public Variable {
             m_name, l, m_keyExclusion);
     }
 
+    /* setvar keeps a single entry per TX key, the first is the one. */
+    void evaluateFirst(Transaction *t, RuleWithActions *rule,
+        std::string *out) override {
+        std::unique_ptr<std::string> v =
+            t->m_collections.m_tx_collection->resolveFirst(m_name);
+        if (v != nullptr) {
+            out->append(*v);
+        }
+    }
+
     std::string m_dictElement;
 };
 
@@ -103,6 +113,12 @@ class Tx_DynamicElement : public Variable {
         t->m_collections.m_tx_collection->storeOrUpdateFirst(var, value);
     }
 
+    static bool atomicAdd(Transaction *t, const std::string &var, int delta,
+        int *result) {
+        return t->m_collections.m_tx_collection->atomicAdd(var, delta,
+            result);
+    }
+
     std::unique_ptr<RunTimeString> m_string;
 };
 
@@ -113,6 +113,13 @@ class User_DynamicElement : public Variable {
             value);
     }
 
+    static bool atomicAdd(Transaction *t, const std::string &var, int delta,
+        int *result) {
+        return t->m_collections.m_user_collection->atomicAdd(
+            var, t->m_collections.m_user_collection_key,
+            t->m_rules->m_secWebAppId.m_value, delta, result);
+    }
+
     std::unique_ptr<RunTimeString> m_string;
 };
 
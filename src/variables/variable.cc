@@ -54,8 +54,28 @@ Variable::Variable(Variable *var) :
     m_fullName(var->m_fullName) { }
 
 
+void Variable::evaluateFirst(Transaction *t, RuleWithActions *rule,
+    std::string *out) {
+    std::vector<const VariableValue *> l;
+
+    if (evaluateBorrowed(t, rule, &l)) {
+        if (l.size() > 0) {
+            out->append(l[0]->getValue());
+        }
+        return;
+    }
+
+    evaluate(t, rule, &l);
+    if (l.size() > 0) {
+        out->append(l[0]->getValue());
+    }
+    for (auto &i : l) {
+        delete i;
+    }
+}
+
+
 void Variable::addsKeyExclusion(Variable *v) {
-    std::unique_ptr<KeyExclusion> r;
     VariableModificatorExclusion *ve = \
         dynamic_cast<VariableModificatorExclusion *>(v);
     VariableRegex *vr;
@@ -67,12 +87,86 @@ void Variable::addsKeyExclusion(Variable *v) {
     vr = dynamic_cast<VariableRegex *>(ve->m_base.get());
 
     if (vr == NULL) {
-        r.reset(new KeyExclusionString(v->m_name));
+        m_keyExclusion.addKey(v->m_name);
     } else {
-        r.reset(new KeyExclusionRegex(vr->m_regex));
+        m_keyExclusion.addRegex(vr->m_regex);
     }
+}
+
+
+bool Variable::isPersistent() const {
+    std::string name = utils::string::toupper(m_collectionName);
+    return name == "IP" || name == "GLOBAL" || name == "SESSION"
+        || name == "USER" || name == "RESOURCE";
+}
 
-    m_keyExclusion.push_back(std::move(r));
+
+namespace {
+
+
+/*
+ * Back references and recursions by number, whose groups get renumbered
+ * in an alternation, and the (*VERB)s that only work at the start of a
+ * pattern. Patterns that may have any of those are not joined.
+ */
+bool joinable(const std::string &re) {
+    for (size_t i = 0; i + 1 < re.size(); i++) {
+        char c = re[i];
+        char n = re[i + 1];
+        if (c == '\\') {
+            if ((n >= '1' && n <= '9') || n == 'g') {
+                return false;
+            }
+            i++;
+        } else if (c == '(' && n == '*') {
+            return false;
+        } else if (c == '(' && n == '?' && i + 2 < re.size()) {
+            char m = re[i + 2];
+            if (m == 'R' || m == '+' || (m >= '0' && m <= '9')
+                || (m == '-' && i + 3 < re.size()
+                && re[i + 3] >= '0' && re[i + 3] <= '9')) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+
+}  // namespace
+
+
+/*
+ * Rebuilt from scratch on every addition, at rules load: a variable has
+ * only a few of these, and evaluation can then happen from any
+ * thread with no further setup.
+ */
+void KeyExclusions::addRegex(const std::string &re) {
+    m_patterns.push_back(re);
+    m_regexes.clear();
+
+    bool join = m_patterns.size() > 1;
+    for (const std::string &p : m_patterns) {
+        join = join && joinable(p);
+    }
+    if (join) {
+        std::string alternation;
+        for (const std::string &p : m_patterns) {
+            alternation.append(alternation.empty() ? "(?:" : "|(?:");
+            alternation.append(p.empty() ? ".*" : p);
+            alternation.append(")");
+        }
+        std::unique_ptr<Utils::Regex> r(new Utils::Regex(alternation,
+            true));
+        if (!r->hasError()) {
+            m_regexes.push_back(std::move(r));
+            return;
+        }
+    }
+
+    for (const std::string &p : m_patterns) {
+        m_regexes.emplace_back(new Utils::Regex(p, true));
+    }
 }
 
 
@@ -17,9 +17,9 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
-#include <deque>
 
 #include "modsecurity/rules_set.h"
 #include "modsecurity/transaction.h"
@@ -54,6 +54,13 @@ class n ## _DictElementRegexp : public VariableRegex { \
         transaction-> e .resolveRegularExpression(&m_r, l, \
             m_keyExclusion); \
     } \
+\
+    bool evaluateBorrowed(Transaction *transaction, \
+        RuleWithActions *rule, \
+        std::vector<const VariableValue *> *l) override { \
+        return transaction-> e .resolveRegularExpressionBorrowed(&m_r, l, \
+            m_keyExclusion); \
+    } \
 };
 
 
@@ -68,6 +75,12 @@ class n ## _DictElement : public VariableDictElement { \
         std::vector<const VariableValue *> *l) override { \
         transaction-> e .resolve(m_dictElement, l); \
     } \
+\
+    bool evaluateBorrowed(Transaction *transaction, \
+        RuleWithActions *rule, \
+        std::vector<const VariableValue *> *l) override { \
+        return transaction-> e .resolveBorrowed(m_dictElement, l); \
+    } \
 };
 
 
@@ -82,6 +95,12 @@ class n ## _NoDictElement : public Variable { \
         std::vector<const VariableValue *> *l) override { \
         transaction-> e .resolve(l, m_keyExclusion); \
     } \
+\
+    bool evaluateBorrowed(Transaction *transaction, \
+        RuleWithActions *rule, \
+        std::vector<const VariableValue *> *l) override { \
+        return transaction-> e .resolveBorrowed(l, m_keyExclusion); \
+    } \
 };
 
 
@@ -96,6 +115,11 @@ class n : public Variable { \
         std::vector<const VariableValue *> *l) override { \
         transaction-> e .evaluate(l); \
     } \
+\
+    void evaluateFirst(Transaction *transaction, \
+        RuleWithActions *rule, std::string *out) override { \
+        out->append(*transaction-> e .evaluate()); \
+    } \
 };
 
 
@@ -104,64 +128,45 @@ namespace modsecurity {
 class Transaction;
 namespace variables {
 
-class KeyExclusion {
- public:
-    KeyExclusion() { }
-    virtual bool match(const std::string &a) = 0;
-    virtual ~KeyExclusion() { }
-};
-
-
-// FIXME: use pre built regex.
-class KeyExclusionRegex : public KeyExclusion {
- public:
-    explicit KeyExclusionRegex(const Utils::Regex &re)
-        : m_re(re.pattern, true) { }
-    explicit KeyExclusionRegex(const std::string &re)
-        : m_re(re, true) { }
-
-    ~KeyExclusionRegex() override { }
-
-    bool match(const std::string &a) override {
-        return m_re.searchAll(a).size() > 0;
-    }
-
-    Utils::Regex m_re;
-};
-
-
-class KeyExclusionString : public KeyExclusion {
+/*
+ * The keys that the !COLLECTION:key and !COLLECTION:/regex/ exclusions of
+ * a rule take out of one of its variables. The literal keys go in a case
+ * insensitive set and the regular expressions are joined into a single
+ * alternation, so that a key is looked up once and searched once.
+ */
+class KeyExclusions {
  public:
-    explicit KeyExclusionString(std::string &a)
-        : m_key(utils::string::toupper(a)) { }
-
-    ~KeyExclusionString() override { }
+    KeyExclusions() { }
 
-    bool match(const std::string &a) override {
-        return a.size() == m_key.size() && std::equal(a.begin(), a.end(),
-            m_key.begin(),
-            [](char aa, char bb) {
-                return static_cast<char>(toupper(aa)) == static_cast<char>(bb);
-            });
+    void addKey(const std::string &key) {
+        m_keys.insert(key);
     }
+    void addRegex(const std::string &re);
 
-    std::string m_key;
-};
-
-
-class KeyExclusions : public std::deque<std::unique_ptr<KeyExclusion>> {
- public:
-    KeyExclusions() {
+    bool empty() const {
+        return m_keys.empty() && m_patterns.empty();
     }
 
-    bool toOmit(std::string a) {
-        for (auto &z : *this) {
-            if (z->match(a)) {
+    bool toOmit(const std::string &a) const {
+        if (!m_keys.empty() && m_keys.find(a) != m_keys.end()) {
+            return true;
+        }
+        for (auto &re : m_regexes) {
+            if (re->search(a) > 0) {
                 return true;
             }
         }
         return false;
     }
+
+ private:
+    std::unordered_set<std::string, MyHash, MyEqual> m_keys;
+    std::vector<std::string> m_patterns;
+    /*
+     * The alternation of m_patterns or, when they cannot be joined, one
+     * regular expression each.
+     */
+    std::vector<std::unique_ptr<Utils::Regex>> m_regexes;
 };
 
 
@@ -292,6 +297,10 @@ class VariableMonkeyResolution {
             t->m_variableMscPcreError.evaluate(l);
         } else if (comp(variable, "MSC_PCRE_LIMITS_EXCEEDED")) {
             t->m_variableMscPcreLimitsExceeded.evaluate(l);
+        } else if (comp(variable, "MSC_MEMORY_LIMIT_EXCEEDED")) {
+            t->m_variableMscMemoryLimitExceeded.evaluate(l);
+        } else if (comp(variable, "MSC_TIME_BUDGET_EXCEEDED")) {
+            t->m_variableMscTimeBudgetExceeded.evaluate(l);
         } else if (comp(variable, "MULTIPART_CRLF_LF_LINES")) {
             t->m_variableMultipartCrlfLFLines.evaluate(l);
         } else if (comp(variable, "MULTIPART_DATA_AFTER")) {
@@ -407,6 +416,10 @@ class VariableMonkeyResolution {
                 vv = t->m_variableMscPcreError.resolveFirst();
             } else if (comp(variable, "MSC_PCRE_LIMITS_EXCEEDED")) {
                 vv = t->m_variableMscPcreLimitsExceeded.resolveFirst();
+            } else if (comp(variable, "MSC_MEMORY_LIMIT_EXCEEDED")) {
+                vv = t->m_variableMscMemoryLimitExceeded.resolveFirst();
+            } else if (comp(variable, "MSC_TIME_BUDGET_EXCEEDED")) {
+                vv = t->m_variableMscTimeBudgetExceeded.resolveFirst();
             } else if (comp(variable, "MULTIPART_CRLF_LF_LINES")) {
                 vv = t->m_variableMultipartCrlfLFLines.resolveFirst();
             } else if (comp(variable, "MULTIPART_DATA_AFTER")) {
@@ -598,6 +611,28 @@ class Variable : public VariableMonkeyResolution {
         std::vector<const VariableValue *> *l) = 0;
 
 
+    /**
+     * Resolves to the values owned by the transaction, instead of copies,
+     * when the variable supports it (returns false otherwise and leaves l
+     * untouched). Those must not be deleted, nor kept around.
+     */
+    virtual bool evaluateBorrowed(Transaction *t,
+        RuleWithActions *rule,
+        std::vector<const VariableValue *> *l) {
+        return false;
+    }
+
+
+    /**
+     * Appends the first value of the variable to out, if it has any, as a
+     * macro expansion wants it. The default goes through evaluateBorrowed
+     * or evaluate; variables that can get to that value directly override
+     * it to spare the copies.
+     */
+    virtual void evaluateFirst(Transaction *t, RuleWithActions *rule,
+        std::string *out);
+
+
     bool inline belongsToCollection(Variable *var) {
         return m_collectionName.size() == var->m_collectionName.size()
              && std::equal(m_collectionName.begin(), m_collectionName.end(),
@@ -611,6 +646,13 @@ class Variable : public VariableMonkeyResolution {
     void addsKeyExclusion(Variable *v);
 
 
+    /**
+     * Whether the variable is of a collection kept across transactions:
+     * IP, GLOBAL, SESSION, USER or RESOURCE.
+     */
+    bool isPersistent() const;
+
+
     bool operator==(const Variable& b) const {
         return m_collectionName == b.m_collectionName &&
             m_name == b.m_name &&
@@ -659,7 +701,7 @@ class Variables : public std::vector<Variable *> {
             [v](Variable *m) -> bool {
                 VariableRegex *r = dynamic_cast<VariableRegex *>(m);
                 if (r) {
-                    return r->m_r.searchAll(v->getKey()).size() > 0;
+                    return r->m_r.search(v->getKey()) > 0;
                 }
                 return v->getKeyWithCollection() == *m->m_fullName.get();
             }) != end();
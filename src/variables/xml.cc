@@ -47,95 +47,62 @@ namespace modsecurity {
 namespace variables {
 
 #ifndef WITH_LIBXML2
+XML::XML(const std::string &_name)
+    : Variable(_name) { }
+
+
+XML::~XML() { }
+
+
 void XML::evaluate(Transaction *t,
     RuleWithActions *rule,
     std::vector<const VariableValue *> *l) { }
 #else
 
+XML::XML(const std::string &_name)
+    : Variable(_name),
+    m_compiled(xmlXPathCompile(
+        reinterpret_cast<const xmlChar *>(m_name.c_str()))) { }
+
+
+XML::~XML() {
+    if (m_compiled != NULL) {
+        xmlXPathFreeCompExpr(m_compiled);
+    }
+}
+
+
 void XML::evaluate(Transaction *t,
     RuleWithActions *rule,
     std::vector<const VariableValue *> *l) {
-    xmlXPathContextPtr xpathCtx;
-    xmlXPathObjectPtr xpathObj;
-    xmlNodeSetPtr nodes;
-    std::string param;
-    const xmlChar* xpathExpr = NULL;
-    int i;
-    //size_t pos;
-
-    param = m_name;
-    /*
-    pos = m_name.find_first_of(":");
-    if (pos == std::string::npos) {
-        param = "";
-    } else {
-        param = std::string(m_name, pos+1, m_name.length() - (pos + 1));
-    }
-    */
     /* Is there an XML document tree at all? */
-    if (t->m_xml->m_data.doc == NULL) {
+    if (t->m_xml == NULL || t->m_xml->m_data.doc == NULL) {
         /* Sorry, we've got nothing to give! */
         return;
     }
 
-    /* Process the XPath expression. */
-    xpathExpr = (const xmlChar*)param.c_str();
-    xpathCtx = xmlXPathNewContext(t->m_xml->m_data.doc);
-    if (xpathCtx == NULL) {
-        ms_dbg_a(t, 1, "XML: Unable to create new XPath context. : ");
-        return;
-    }
-
+    RequestBodyProcessor::XML::Namespaces namespaces;
     if (rule == NULL) {
         ms_dbg_a(t, 2, "XML: Can't look for xmlns, internal error.");
     } else {
         std::vector<actions::Action *> acts = rule->getActionsByName("xmlns", t);
         for (auto &x : acts) {
             actions::XmlNS *z = (actions::XmlNS *)x;
-            if (xmlXPathRegisterNs(xpathCtx, (const xmlChar*)z->m_scope.c_str(),
-                    (const xmlChar*)z->m_href.c_str()) != 0) {
-                ms_dbg_a(t, 1, "Failed to register XML namespace href \"" + \
-                    z->m_href + "\" prefix \"" + z->m_scope + "\".");
-                return;
-            }
-
-            ms_dbg_a(t, 4, "Registered XML namespace href \"" + z->m_href + \
-                "\" prefix \"" + z->m_scope + "\"");
+            namespaces.emplace_back(z->m_scope, z->m_href);
         }
     }
 
-    /* Initialise XPath expression. */
-    xpathObj = xmlXPathEvalExpression(xpathExpr, xpathCtx);
-    if (xpathObj == NULL) {
-        ms_dbg_a(t, 1, "XML: Unable to evaluate xpath expression.");
-        xmlXPathFreeContext(xpathCtx);
-        return;
-    }
-    /* Evaluate XPath expression. */
-    nodes = xpathObj->nodesetval;
-    if (nodes == NULL) {
-        xmlXPathFreeObject(xpathObj);
-        xmlXPathFreeContext(xpathCtx);
+    /* An expression that did not compile is left for xpath() to report. */
+    const std::vector<std::string> *contents = t->m_xml->xpath(m_name,
+        m_compiled, namespaces);
+    if (contents == NULL || m_keyExclusion.toOmit(*m_fullName)) {
         return;
     }
+
     /* Create one variable for each node in the result. */
-    for (i = 0; i < nodes->nodeNr; i++) {
-        char *content;
-        content = reinterpret_cast<char *>(
-            xmlNodeGetContent(nodes->nodeTab[i]));
-        if (content != NULL) {
-            std::string *a = new std::string(content);
-            VariableValue *var = new VariableValue(m_fullName.get(),
-                a);
-            if (!m_keyExclusion.toOmit(*m_fullName)) {
-                l->push_back(var);
-            }
-            delete a;
-            xmlFree(content);
-         }
+    for (const std::string &content : *contents) {
+        l->push_back(new VariableValue(m_fullName.get(), &content));
     }
-    xmlXPathFreeObject(xpathObj);
-    xmlXPathFreeContext(xpathCtx);
 }
 
 #endif
@@ -19,6 +19,10 @@
 #include <list>
 #include <utility>
 
+#ifdef WITH_LIBXML2
+#include <libxml/xpath.h>
+#endif
+
 #ifndef SRC_VARIABLES_XML_H_
 #define SRC_VARIABLES_XML_H_
 
@@ -55,12 +59,20 @@ class XML_NoDictElement : public Variable {
 
 class XML : public Variable {
  public:
-    explicit XML(const std::string &_name)
-        : Variable(_name) { }
+    explicit XML(const std::string &_name);
+    ~XML() override;
+    XML(const XML &x) = delete;
+    XML &operator=(const XML &x) = delete;
 
     void evaluate(Transaction *transaction,
         RuleWithActions *rule,
         std::vector<const VariableValue *> *l) override;
+
+#ifdef WITH_LIBXML2
+ private:
+    /* Compiled once, at rule load; NULL if libxml2 did not take it. */
+    xmlXPathCompExprPtr m_compiled;
+#endif
 };
 
 
@@ -0,0 +1,402 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cerrno>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "modsecurity/rules_set.h"
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/transaction.h"
+#include "src/utils/rule_profiler.h"
+#include "tools/replay/corpus.h"
+
+using modsecurity::Transaction;
+
+
+/*
+ * What the calling thread allocated so far. With glibc, malloc() itself
+ * is interposed, so that the C libraries (PCRE, yajl, libxml2) are
+ * counted along with operator new; elsewhere only operator new is.
+ * Memory taken with posix_memalign() or mmap() is not seen.
+ */
+static __thread uint64_t allocations = 0;
+static __thread uint64_t allocatedBytes = 0;
+
+#ifdef __GLIBC__
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t n, size_t size);
+void *__libc_realloc(void *p, size_t size);
+
+void *malloc(size_t size) {
+    allocations++;
+    allocatedBytes += size;
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t n, size_t size) {
+    allocations++;
+    allocatedBytes += n * size;
+    return __libc_calloc(n, size);
+}
+
+void *realloc(void *p, size_t size) {
+    allocations++;
+    allocatedBytes += size;
+    return __libc_realloc(p, size);
+}
+}
+#else
+void *operator new(size_t size) {
+    allocations++;
+    allocatedBytes += size;
+    void *p = malloc(size == 0 ? 1 : size);
+    if (p == NULL) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void *operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
+
+void operator delete[](void *p) noexcept {
+    free(p);
+}
+#endif
+
+
+static void counter(uint64_t *a, uint64_t *b) {
+    *a = allocations;
+    *b = allocatedBytes;
+}
+
+
+char rules_file[] = "basic_rules.conf";
+
+const char* const help_message = "" \
+    "Usage: allocations [options]\n" \
+    "\n" \
+    "  -n <num>       transactions to run (default: 1000)\n" \
+    "  -r <file>      rules to load (default: basic_rules.conf)\n" \
+    "  -c <file>      requests to replay, in any form benchmark -c takes;\n" \
+    "                 a single GET otherwise\n" \
+    "  -w <file>      write the allocations per phase there, as a baseline\n" \
+    "  -b <file>      compare with that baseline, exit with 1 when a phase\n" \
+    "                 allocates more than it plus the threshold\n" \
+    "  -x <percent>   the threshold (default: 5)\n" \
+    "  -q             without the allocations of each rule\n" \
+    "  -h, -?, --help this text\n" \
+    "\n" \
+    "The allocations of each rule are those made while its operator ran\n" \
+    "against its variables, transformations and matching actions\n" \
+    "included, as SecRuleProfiling reports them.";
+
+
+enum Phase {
+    RequestHeaders,
+    RequestBody,
+    ResponseHeaders,
+    ResponseBody,
+    Logging,
+    Total,
+    Phases
+};
+
+static const char *phaseNames[Phases] = {
+    "request_headers",
+    "request_body",
+    "response_headers",
+    "response_body",
+    "logging",
+    "total"
+};
+
+
+struct Count {
+    uint64_t allocations;
+    uint64_t bytes;
+};
+
+
+static bool intervened(Transaction *t) {
+    modsecurity::ModSecurityIntervention it;
+    modsecurity::intervention::reset(&it);
+    if (t->intervention(&it) == 0) {
+        return false;
+    }
+    modsecurity::intervention::free(&it);
+    return true;
+}
+
+
+/*
+ * As replay() does, phase by phase; the connection and the URI go with
+ * the request headers.
+ */
+static void run(Transaction *t, const Request &r, Count *counts) {
+    Count start = { allocations, allocatedBytes };
+    int phase = RequestHeaders;
+    bool stop = false;
+
+    auto next = [&]() {
+        counts[phase].allocations += allocations - start.allocations;
+        counts[phase].bytes += allocatedBytes - start.bytes;
+        start.allocations = allocations;
+        start.bytes = allocatedBytes;
+        phase++;
+        stop = stop || intervened(t);
+    };
+
+    t->processConnection(r.clientIp.c_str(), r.clientPort,
+        r.serverIp.c_str(), r.serverPort);
+    t->processURI(r.uri.c_str(), r.method.c_str(), r.httpVersion.c_str());
+    for (const auto &h : r.headers) {
+        t->addRequestHeader(h.first, h.second);
+    }
+    t->processRequestHeaders();
+    next();
+
+    if (!stop) {
+        t->appendRequestBody(
+            reinterpret_cast<const unsigned char *>(r.body.c_str()),
+            r.body.size());
+        t->processRequestBody();
+    }
+    next();
+
+    if (!stop) {
+        for (const auto &h : r.responseHeaders) {
+            t->addResponseHeader(h.first, h.second);
+        }
+        t->processResponseHeaders(r.status, r.protocol);
+    }
+    next();
+
+    if (!stop) {
+        t->appendResponseBody(
+            reinterpret_cast<const unsigned char *>(r.responseBody.c_str()),
+            r.responseBody.size());
+        t->processResponseBody();
+    }
+    next();
+
+    t->processLogging();
+    next();
+}
+
+
+static bool number(const char *arg, unsigned long long *value) {
+    char *end = NULL;
+    errno = 0;
+    unsigned long long v = strtoull(arg, &end, 10);
+    if (errno || end == arg || *end != '\0') {
+        return false;
+    }
+    *value = v;
+    return true;
+}
+
+
+/* One line per phase: name, allocations and bytes per transaction. */
+static bool readBaseline(const std::string &file, double baseline[][2]) {
+    std::ifstream in(file);
+    std::string name;
+    double a;
+    double b;
+
+    if (!in.is_open()) {
+        return false;
+    }
+    while (in >> name >> a >> b) {
+        for (int p = 0; p < Phases; p++) {
+            if (name == phaseNames[p]) {
+                baseline[p][0] = a;
+                baseline[p][1] = b;
+            }
+        }
+    }
+    return true;
+}
+
+
+int main(int argc, char *argv[]) {
+    unsigned long long transactions(1000);
+    unsigned long long threshold(5);
+    std::string rules_path(rules_file);
+    std::string corpus_path;
+    std::string write_path;
+    std::string baseline_path;
+    bool quiet = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg(argv[i]);
+        if (arg == "-h" || arg == "-?" || arg == "--help") {
+            std::cout << help_message << std::endl;
+            return 0;
+        }
+        if (arg == "-q") {
+            quiet = true;
+            continue;
+        }
+        if (arg.size() != 2 || arg[0] != '-' || i + 1 >= argc) {
+            std::cerr << "Invalid option " << arg << std::endl
+                      << help_message << std::endl;
+            return -1;
+        }
+        const char *value = argv[++i];
+        bool ok = true;
+        switch (arg[1]) {
+            case 'n': ok = number(value, &transactions); break;
+            case 'x': ok = number(value, &threshold); break;
+            case 'r': rules_path = value; break;
+            case 'c': corpus_path = value; break;
+            case 'w': write_path = value; break;
+            case 'b': baseline_path = value; break;
+            default: ok = false;
+        }
+        if (!ok || transactions == 0) {
+            std::cerr << "Invalid value for " << arg << ": '" << value
+                      << "'" << std::endl << help_message << std::endl;
+            return -1;
+        }
+    }
+
+    std::vector<Request> corpus;
+    if (corpus_path.empty()) {
+        Request r;
+        r.clientIp = "200.249.12.31";
+        r.clientPort = 12345;
+        r.serverIp = "127.0.0.1";
+        r.serverPort = 80;
+        r.method = "GET";
+        r.uri = "/test.pl?param1=test&para2=test2";
+        r.httpVersion = "1.1";
+        r.headers = {
+            {"Host", "net.tutsplus.com"},
+            {"User-Agent", "Mozilla/5.0 (X11; Linux x86_64; rv:120.0) " \
+                "Gecko/20100101 Firefox/120.0"},
+            {"Accept", "text/html,application/xhtml+xml"},
+            {"Cookie", "PHPSESSID=r2t5uvjq435r4q7ib3vtdjq120"}
+        };
+        r.status = 200;
+        r.protocol = "HTTP 1.1";
+        r.responseHeaders = {
+            {"Content-Type", "text/html; charset=utf-8"}
+        };
+        r.responseBody = "<html><body>Hello</body></html>";
+        corpus.push_back(r);
+    } else {
+        std::string error;
+        if (!loadCorpus(corpus_path, &corpus, &error) || corpus.empty()) {
+            std::cerr << "Problems loading the corpus: " << error
+                      << std::endl;
+            return -1;
+        }
+    }
+
+    modsecurity::Utils::RuleProfiler::setAllocationCounter(counter);
+
+    modsecurity::ModSecurity *modsec = new modsecurity::ModSecurity();
+    modsecurity::RulesSet *rules = new modsecurity::RulesSet();
+    if (rules->load("SecRuleProfiling On") < 0
+        || rules->loadFromUri(rules_path.c_str()) < 0) {
+        std::cerr << "Problems loading the rules..." << std::endl
+                  << rules->getParserError() << std::endl;
+        return -1;
+    }
+
+    /*
+     * The first transaction fills the caches: it is not in the counts of
+     * the phases, only in the profile of the rules.
+     */
+    Count counts[Phases] = {};
+    Transaction *t = new Transaction(modsec, rules, NULL);
+    run(t, corpus[0], counts);
+    t->reset();
+    memset(counts, 0, sizeof(counts));
+
+    for (unsigned long long i = 0; i < transactions; i++) {
+        run(t, corpus[i % corpus.size()], counts);
+        t->reset();
+    }
+    delete t;
+
+    for (int p = 0; p < Total; p++) {
+        counts[Total].allocations += counts[p].allocations;
+        counts[Total].bytes += counts[p].bytes;
+    }
+
+    double baseline[Phases][2] = {};
+    bool compare = !baseline_path.empty();
+    if (compare && !readBaseline(baseline_path, baseline)) {
+        std::cerr << "Failed to read " << baseline_path << std::endl;
+        return -1;
+    }
+
+    std::ofstream out;
+    if (!write_path.empty()) {
+        out.open(write_path);
+    }
+
+    int status = 0;
+    std::cout << std::fixed << std::setprecision(2) << transactions
+              << " transaction(s) over " << corpus.size()
+              << " request(s)\n\n" << std::left << std::setw(18)
+              << "Per transaction" << std::right << std::setw(14)
+              << "allocations" << std::setw(14) << "bytes" << "\n";
+    for (int p = 0; p < Phases; p++) {
+        double a = static_cast<double>(counts[p].allocations) / transactions;
+        double b = static_cast<double>(counts[p].bytes) / transactions;
+        std::cout << std::left << std::setw(18) << phaseNames[p]
+                  << std::right << std::setw(14) << a << std::setw(14) << b;
+        if (compare) {
+            double limit = 1 + threshold / 100.0;
+            if (a > baseline[p][0] * limit || b > baseline[p][1] * limit) {
+                std::cout << "  over the baseline (" << baseline[p][0]
+                          << ", " << baseline[p][1] << ")";
+                status = 1;
+            }
+        }
+        std::cout << "\n";
+        if (out.is_open()) {
+            out << std::fixed << std::setprecision(2) << phaseNames[p]
+                << " " << a << " " << b << "\n";
+        }
+    }
+
+    if (!quiet) {
+        std::cout << "\n" << rules->profileDump();
+    }
+
+    delete rules;
+    delete modsec;
+    return status;
+}
@@ -13,20 +13,87 @@
  *
  */
 
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
-#include <ctime>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <new>
+#include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "modsecurity/rules_set.h"
 #include "modsecurity/modsecurity.h"
+#include "modsecurity/timings.h"
+#include "modsecurity/transaction.h"
+#include "tools/replay/corpus.h"
 
+using modsecurity::ModSecurityTimings;
 using modsecurity::Transaction;
 
+
+/*
+ * Every operator new of the process, the library included, goes through
+ * here; the counter is per thread so the workers do not share a cache
+ * line. Allocations made with malloc() by the C libraries (PCRE, yajl,
+ * libxml2) are not seen.
+ */
+static thread_local uint64_t allocations = 0;
+
+void *operator new(size_t size) {
+    allocations++;
+    void *p = malloc(size == 0 ? 1 : size);
+    if (p == NULL) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void *operator new[](size_t size) {
+    return operator new(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+    allocations++;
+    return malloc(size == 0 ? 1 : size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &tag) noexcept {
+    return operator new(size, tag);
+}
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
+
+void operator delete[](void *p) noexcept {
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    free(p);
+}
+
+void operator delete[](void *p, size_t) noexcept {
+    free(p);
+}
+
+
 char request_uri[] = "/test.pl?param1=test&para2=test2";
 
-unsigned char response_body[] = "" \
+char response_body[] = "" \
     "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n\r" \
     "<soap:Envelope xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\" " \
     "xmlns:xsd=\"http://www.w3.org/2001/XMLSchema\" " \
@@ -42,133 +109,372 @@ char ip[] = "200.249.12.31";
 
 char rules_file[] = "basic_rules.conf";
 
-const char* const help_message = "Usage: benchmark [num_iterations|-h|-?|--help]";
+const char* const help_message = "" \
+    "Usage: benchmark [options] [num_iterations [num_args]]\n" \
+    "\n" \
+    "  -n <num>       transactions to run, in total (default: 1000000)\n" \
+    "  -t <num>       worker threads sharing the rules (default: 1)\n" \
+    "  -r <file>      rules to load (default: basic_rules.conf)\n" \
+    "  -p <level>     CRS paranoia level, sets tx.paranoia_level before\n" \
+    "                 loading the rules (see download-owasp-v3-rules.sh)\n" \
+    "  -c <file>      requests to replay, a HAR capture, a JSON audit log\n" \
+    "                 or one JSON object per line (JSONL); replayed in a\n" \
+    "                 loop\n" \
+    "  -a <num>       extra arguments added to the built-in request\n" \
+    "  -j             print the results as JSON\n" \
+    "  -h, -?, --help this text\n" \
+    "\n" \
+    "A JSONL line looks like:\n" \
+    "  {\"method\": \"POST\", \"uri\": \"/login\",\n" \
+    "   \"http_version\": \"1.1\",\n" \
+    "   \"headers\": {\"Host\": \"example.com\"}, \"body\": \"user=a\",\n" \
+    "   \"response\": {\"status\": 200, \"headers\": {}, \"body\": \"\"}}\n" \
+    "headers may also be a list of {\"name\": ..., \"value\": ...}, as in HAR.";
+
+
+/*
+ * The request the benchmark always did, for runs without a corpus: a GET
+ * with the headers of a browser and a small XML response.
+ */
+static Request builtinRequest(unsigned long long num_args) {
+    Request r;
+    r.clientIp = ip;
+    r.clientPort = 12345;
+    r.serverIp = "127.0.0.1";
+    r.serverPort = 80;
+    r.method = "GET";
+    r.uri = request_uri;
+    for (unsigned long long i = 0; i < num_args; i++) {
+        r.uri.append("&item[" + std::to_string(i) + "][id]="
+            + std::to_string(i));
+    }
+    r.httpVersion = "1.1";
+    r.headers = {
+        {"Host", "net.tutsplus.com"},
+        {"User-Agent", "Mozilla/5.0 (Windows; U; Windows NT 6.1; en-US; " \
+            "rv:1.9.1.5) Gecko/20091102 Firefox/3.5.5 (.NET CLR 3.5.30729)"},
+        {"Accept", "text/html,application/xhtml+xml,application/xml;" \
+            "q=0.9,*/*;q=0.8"},
+        {"Accept-Language", "en-us,en;q=0.5"},
+        {"Accept-Encoding", "gzip,deflate"},
+        {"Accept-Charset", "ISO-8859-1,utf-8;q=0.7,*;q=0.7"},
+        {"Keep-Alive", "300"},
+        {"Connection", "keep-alive"},
+        {"Cookie", "PHPSESSID=r2t5uvjq435r4q7ib3vtdjq120"},
+        {"Pragma", "no-cache"},
+        {"Cache-Control", "no-cache"}
+    };
+    r.status = 200;
+    r.protocol = "HTTP 1.1";
+    r.responseHeaders = {
+        {"Content-Type", "text/xml; charset=utf-8"},
+        {"Content-Length", std::to_string(strlen(response_body))}
+    };
+    r.responseBody = response_body;
+    return r;
+}
+
+
+enum Phase {
+    RequestHeaders,
+    RequestBody,
+    ResponseHeaders,
+    ResponseBody,
+    Logging,
+    Total,
+    Phases
+};
+
+static const char *phaseNames[Phases] = {
+    "request_headers",
+    "request_body",
+    "response_headers",
+    "response_body",
+    "logging",
+    "total"
+};
+
+
+struct Worker {
+    modsecurity::ModSecurity *modsec;
+    modsecurity::RulesSet *rules;
+    const std::vector<Request> *corpus;
+    std::atomic<unsigned long long> *next;
+    unsigned long long total;
+    pthread_t thread;
+
+    unsigned long long transactions;
+    unsigned long long interventions;
+    uint64_t allocations;
+    std::vector<uint64_t> latency[Phases];
+};
+
+
+/*
+ * Each worker recycles its own transaction, as a connector would do per
+ * connection, and takes the next request of the corpus from the shared
+ * counter until the total is reached.
+ */
+static void *work(void *data) {
+    Worker *w = reinterpret_cast<Worker *>(data);
+    Transaction *t = new Transaction(w->modsec, w->rules, NULL);
+    ModSecurityTimings timings;
+    uint64_t started = allocations;
+
+    while (true) {
+        unsigned long long i = (*w->next)++;
+        if (i >= w->total) {
+            break;
+        }
+        if (replay(t, (*w->corpus)[i % w->corpus->size()])) {
+            w->interventions++;
+        }
+        t->processLogging();
+
+        t->timings(&timings);
+        w->latency[RequestHeaders].push_back(timings.request_headers);
+        w->latency[RequestBody].push_back(timings.request_body);
+        w->latency[ResponseHeaders].push_back(timings.response_headers);
+        w->latency[ResponseBody].push_back(timings.response_body);
+        w->latency[Logging].push_back(timings.logging);
+        w->latency[Total].push_back(timings.total);
+        w->transactions++;
+
+        t->reset();
+    }
+
+    w->allocations = allocations - started;
+    delete t;
+    return NULL;
+}
+
+
+static bool number(const char *arg, unsigned long long *value) {
+    char *end = NULL;
+    errno = 0;
+    unsigned long long v = strtoull(arg, &end, 10);
+    if (errno || end == arg || *end != '\0') {
+        return false;
+    }
+    *value = v;
+    return true;
+}
+
+
+static double percentile(const std::vector<uint64_t> &sorted, double p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t i = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[i] / 1000.0;
+}
 
-int main(int argc, char *argv[]) {
 
+int main(int argc, char *argv[]) {
     unsigned long long NUM_REQUESTS(1000000);
+    unsigned long long num_threads = 1;
+    unsigned long long num_args = 0;
+    unsigned long long paranoia = 0;
+    std::string rules_path(rules_file);
+    std::string corpus_path;
+    bool json = false;
+    int positional = 0;
 
-    if (argc > 1) {
-        if (0 == strcmp(argv[1], "-h") ||
-            0 == strcmp(argv[1], "-?") ||
-            0 == strcmp(argv[1], "--help")) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg(argv[i]);
+        if (arg == "-h" || arg == "-?" || arg == "--help") {
             std::cout << help_message << std::endl;
             return 0;
         }
-        errno = 0;
-        unsigned long long upper = strtoull(argv[1], 0, 10);
-        if (!errno && upper) {
-            NUM_REQUESTS = upper;
-        } else {
-            if (errno) {
-                perror("Invalid number of iterations");
-            } else {
-                std::cerr << "Failed to convert '" << argv[1] << "' to integer value" << std::endl
+        if (arg == "-j") {
+            json = true;
+            continue;
+        }
+        if (arg.size() == 2 && arg[0] == '-') {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << std::endl
                           << help_message << std::endl;
                 return -1;
             }
+            const char *value = argv[++i];
+            bool ok = true;
+            switch (arg[1]) {
+                case 'n': ok = number(value, &NUM_REQUESTS); break;
+                case 't': ok = number(value, &num_threads); break;
+                case 'a': ok = number(value, &num_args); break;
+                case 'p': ok = number(value, &paranoia); break;
+                case 'r': rules_path = value; break;
+                case 'c': corpus_path = value; break;
+                default: ok = false;
+            }
+            if (!ok) {
+                std::cerr << "Invalid value for " << arg << ": '" << value
+                          << "'" << std::endl << help_message << std::endl;
+                return -1;
+            }
+            continue;
         }
-    }
-    std::cout << "Doing " << NUM_REQUESTS << " transactions...\n";
-    modsecurity::ModSecurity *modsec;
-    modsecurity::RulesSet *rules;
-    modsecurity::ModSecurityIntervention it;
-    modsecurity::intervention::reset(&it);
-    modsec = new modsecurity::ModSecurity();
-    modsec->setConnectorInformation("ModSecurity-benchmark v0.0.1-alpha" \
-            " (ModSecurity benchmark utility)");
 
-    rules = new modsecurity::RulesSet();
-    if (rules->loadFromUri(rules_file) < 0) {
-        std::cout << "Problems loading the rules..." << std::endl;
-        std::cout << rules->m_parserError.str() << std::endl;
+        /* The old positional form: num_iterations [num_args]. */
+        bool ok = false;
+        if (positional == 0) {
+            ok = number(argv[i], &NUM_REQUESTS);
+        } else if (positional == 1) {
+            ok = number(argv[i], &num_args);
+        }
+        if (!ok) {
+            std::cerr << "Failed to convert '" << argv[i]
+                      << "' to integer value" << std::endl
+                      << help_message << std::endl;
+            return -1;
+        }
+        positional++;
+    }
+    if (NUM_REQUESTS == 0 || num_threads == 0) {
+        std::cerr << "The transactions and threads can not be 0"
+                  << std::endl;
         return -1;
     }
 
-    for (unsigned long long i = 0; i < NUM_REQUESTS; i++) {
-        //std::cout << "Proceeding with request " << i << std::endl;
-
-        Transaction *modsecTransaction = new Transaction(modsec, rules, NULL);
-        modsecTransaction->processConnection(ip, 12345, "127.0.0.1", 80);
-
-        if (modsecTransaction->intervention(&it)) {
-            std::cout << "There is an intervention" << std::endl;
-            goto next_request;
+    std::vector<Request> corpus;
+    if (corpus_path.empty()) {
+        corpus.push_back(builtinRequest(num_args));
+    } else {
+        std::string error;
+        if (!loadCorpus(corpus_path, &corpus, &error)) {
+            std::cerr << "Problems loading the corpus: " << error
+                      << std::endl;
+            return -1;
         }
-        modsecTransaction->processURI(request_uri, "GET", "1.1");
-        if (modsecTransaction->intervention(&it)) {
-            std::cout << "There is an intervention" << std::endl;
-            goto next_request;
+        if (corpus.empty()) {
+            std::cerr << "No requests in " << corpus_path << std::endl;
+            return -1;
         }
+    }
 
-        modsecTransaction->addRequestHeader("Host",
-            "net.tutsplus.com");
-        modsecTransaction->addRequestHeader("User-Agent",
-            "Mozilla/5.0 (Windows; U; Windows NT 6.1; en-US; rv:1.9.1.5) " \
-            "Gecko/20091102 Firefox/3.5.5 (.NET CLR 3.5.30729)");
-        modsecTransaction->addRequestHeader("Accept",
-            "text/html,application/xhtml+xml,application/xml;" \
-            "q=0.9,*/*;q=0.8");
-        modsecTransaction->addRequestHeader("Accept-Language",
-            "en-us,en;q=0.5");
-        modsecTransaction->addRequestHeader("Accept-Encoding",
-            "gzip,deflate");
-        modsecTransaction->addRequestHeader("Accept-Charset",
-            "ISO-8859-1,utf-8;q=0.7,*;q=0.7");
-        modsecTransaction->addRequestHeader("Keep-Alive",
-            "300");
-        modsecTransaction->addRequestHeader("Connection",
-            "keep-alive");
-        modsecTransaction->addRequestHeader("Cookie",
-            "PHPSESSID=r2t5uvjq435r4q7ib3vtdjq120");
-        modsecTransaction->addRequestHeader("Pragma",
-            "no-cache");
-        modsecTransaction->addRequestHeader("Cache-Control",
-            "no-cache");
-        modsecTransaction->processRequestHeaders();
-
-        if (modsecTransaction->intervention(&it)) {
-            std::cout << "There is an intervention" << std::endl;
-            goto next_request;
-        }
+    modsecurity::ModSecurity *modsec = new modsecurity::ModSecurity();
+    modsec->setConnectorInformation("ModSecurity-benchmark v0.0.2" \
+            " (ModSecurity benchmark utility)");
 
+    /*
+     * CRS v3 only initializes tx.paranoia_level when it is not set yet,
+     * so setting it ahead of the rules picks the level.
+     */
+    modsecurity::RulesSet *rules = new modsecurity::RulesSet();
+    if (paranoia > 0) {
+        std::string setup("SecAction \"id:900000,phase:1,nolog,pass," \
+            "t:none,setvar:tx.paranoia_level=" + std::to_string(paranoia)
+            + "\"");
+        if (rules->load(setup.c_str()) < 0) {
+            std::cerr << "Problems setting the paranoia level..."
+                      << std::endl << rules->m_parserError.str()
+                      << std::endl;
+            return -1;
+        }
+    }
+    if (rules->loadFromUri(rules_path.c_str()) < 0) {
+        std::cerr << "Problems loading the rules..." << std::endl;
+        std::cerr << rules->m_parserError.str() << std::endl;
+        return -1;
+    }
 
-        modsecTransaction->processRequestBody();
+    if (!json) {
+        std::cout << "Doing " << NUM_REQUESTS << " transactions with "
+                  << num_threads << " thread(s) over " << corpus.size()
+                  << " request(s)...\n";
+    }
 
-        if (modsecTransaction->intervention(&it)) {
-            std::cout << "There is an intervention" << std::endl;
-            goto next_request;
+    std::atomic<unsigned long long> next(0);
+    std::vector<Worker> workers(num_threads);
+    auto begin = std::chrono::steady_clock::now();
+    for (auto &w : workers) {
+        w.modsec = modsec;
+        w.rules = rules;
+        w.corpus = &corpus;
+        w.next = &next;
+        w.total = NUM_REQUESTS;
+        w.transactions = 0;
+        w.interventions = 0;
+        w.allocations = 0;
+        for (auto &l : w.latency) {
+            l.reserve(NUM_REQUESTS / num_threads + 1);
         }
+        pthread_create(&w.thread, NULL, work, &w);
+    }
 
-        modsecTransaction->addResponseHeader("HTTP/1.1",
-            "200 OK");
-        modsecTransaction->addResponseHeader("Content-Type",
-            "text/xml; charset=utf-8");
-        modsecTransaction->addResponseHeader("Content-Length",
-            "200");
-
-        modsecTransaction->processResponseHeaders(200, "HTTP 1.2");
+    unsigned long long transactions = 0;
+    unsigned long long interventions = 0;
+    uint64_t allocated = 0;
+    std::vector<uint64_t> latency[Phases];
+    for (auto &w : workers) {
+        pthread_join(w.thread, NULL);
+    }
+    double elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - begin).count();
 
-        if (modsecTransaction->intervention(&it)) {
-            std::cout << "There is an intervention" << std::endl;
-            goto next_request;
+    for (auto &w : workers) {
+        transactions += w.transactions;
+        interventions += w.interventions;
+        allocated += w.allocations;
+        for (int p = 0; p < Phases; p++) {
+            latency[p].insert(latency[p].end(), w.latency[p].begin(),
+                w.latency[p].end());
+            std::vector<uint64_t>().swap(w.latency[p]);
         }
+    }
+    for (auto &l : latency) {
+        std::sort(l.begin(), l.end());
+    }
 
+    static const double quantiles[] = { 0.5, 0.9, 0.99, 0.999 };
+    static const char *quantileNames[] = { "p50", "p90", "p99", "p999" };
+    double tps = transactions / elapsed;
+    double perTransaction = static_cast<double>(allocated) / transactions;
 
-        modsecTransaction->appendResponseBody(response_body,
-            strlen((const char*)response_body));
-        modsecTransaction->processResponseBody();
-
-        if (modsecTransaction->intervention(&it)) {
-            std::cout << "There is an intervention" << std::endl;
-            goto next_request;
+    if (json) {
+        std::cout << std::fixed << std::setprecision(3) << "{"
+                  << "\"rules\": \"" << rules_path << "\", "
+                  << "\"paranoia_level\": " << paranoia << ", "
+                  << "\"corpus\": \"" << corpus_path << "\", "
+                  << "\"corpus_requests\": " << corpus.size() << ", "
+                  << "\"threads\": " << num_threads << ", "
+                  << "\"transactions\": " << transactions << ", "
+                  << "\"interventions\": " << interventions << ", "
+                  << "\"elapsed_seconds\": " << elapsed << ", "
+                  << "\"transactions_per_second\": " << tps << ", "
+                  << "\"allocations_per_transaction\": " << perTransaction
+                  << ", \"latency_us\": {";
+        for (int p = 0; p < Phases; p++) {
+            std::cout << (p ? ", " : "") << "\"" << phaseNames[p] << "\": {";
+            for (int q = 0; q < 4; q++) {
+                std::cout << "\"" << quantileNames[q] << "\": "
+                          << percentile(latency[p], quantiles[q]) << ", ";
+            }
+            std::cout << "\"max\": " << percentile(latency[p], 1) << "}";
+        }
+        std::cout << "}}" << std::endl;
+    } else {
+        std::cout << std::fixed << std::setprecision(2)
+                  << "Elapsed: " << elapsed << " s, " << tps
+                  << " transactions/s, " << interventions
+                  << " intervention(s)\n"
+                  << "Allocations per transaction: " << perTransaction
+                  << "\n\n" << std::left << std::setw(18) << "Latency (us)";
+        for (int q = 0; q < 4; q++) {
+            std::cout << std::right << std::setw(10) << quantileNames[q];
+        }
+        std::cout << std::setw(10) << "max" << "\n";
+        for (int p = 0; p < Phases; p++) {
+            std::cout << std::left << std::setw(18) << phaseNames[p];
+            for (int q = 0; q < 4; q++) {
+                std::cout << std::right << std::setw(10)
+                          << percentile(latency[p], quantiles[q]);
+            }
+            std::cout << std::setw(10) << percentile(latency[p], 1) << "\n";
         }
-
-next_request:
-        modsecTransaction->processLogging();
-        delete modsecTransaction;
     }
 
     delete rules;
     delete modsec;
+    return 0;
 }
@@ -9,5 +9,5 @@ cd -
 echo 'Include "owasp-v3/crs-setup.conf.example"' >> basic_rules.conf
 echo 'Include "owasp-v3/rules/*.conf"' >> basic_rules.conf
 
-echo "Done."
+echo "Done. Use ./benchmark -p <level> to run at a given paranoia level."
 
@@ -0,0 +1,171 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/transaction.h"
+
+using modsecurity::Transaction;
+
+const char* const help_message = "Usage: fork_rss [workers " \
+    "[transactions [rules_file]]]";
+
+
+/*
+ * Bytes of the process that are private and dirty, the ones a forked
+ * worker no longer shares with the master. Linux only; -1 elsewhere.
+ */
+static long long privateDirty() {
+    std::ifstream smaps("/proc/self/smaps_rollup");
+    if (smaps.is_open() == false) {
+        smaps.open("/proc/self/smaps");
+    }
+    if (smaps.is_open() == false) {
+        return -1;
+    }
+
+    long long kb = 0;
+    std::string line;
+    while (std::getline(smaps, line)) {
+        if (line.compare(0, 14, "Private_Dirty:") == 0) {
+            kb += atoll(line.c_str() + 14);
+        }
+    }
+    return kb * 1024;
+}
+
+
+static void inspect(modsecurity::ModSecurity *modsec,
+    modsecurity::RulesSet *rules, int i) {
+    Transaction *t = new Transaction(modsec, rules, NULL);
+    std::string uri("/index.php?id=" + std::to_string(i)
+        + "&q=1%27%20union%20select%20pass%20from%20users--"
+        + "&name=john&city=lisbon");
+
+    t->processConnection("127.0.0.1", 12345, "127.0.0.1", 80);
+    t->processURI(uri.c_str(), "GET", "1.1");
+    t->addRequestHeader("Host", "localhost");
+    t->addRequestHeader("User-Agent", "Mozilla/5.0 (X11; Linux x86_64)");
+    t->addRequestHeader("Accept", "*/*");
+    t->processRequestHeaders();
+    t->processRequestBody();
+    t->addResponseHeader("Content-Type", "text/html");
+    t->processResponseHeaders(200, "HTTP 1.1");
+    t->processResponseBody();
+    t->processLogging();
+    delete t;
+}
+
+
+/*
+ * The way a pre-fork server runs: the master loads the rules, the
+ * workers inherit them copy on write and inspect requests. Each worker
+ * reports how much of the memory it shared with the master it had to
+ * copy: after the first transaction, which allocates what any worker
+ * needs anyway, and after all of them. The second figure growing with
+ * the number of transactions means the rules are written to while
+ * requests are inspected.
+ */
+int main(int argc, char *argv[]) {
+    unsigned long long workers(4);
+    unsigned long long transactions(1000);
+    std::string file("basic_rules.conf");
+
+    if (argc > 1 && (0 == strcmp(argv[1], "-h") ||
+        0 == strcmp(argv[1], "-?") ||
+        0 == strcmp(argv[1], "--help"))) {
+        std::cout << help_message << std::endl;
+        return 0;
+    }
+    for (int i = 1; i < argc && i < 3; i++) {
+        unsigned long long n = strtoull(argv[i], 0, 10);
+        if (n == 0) {
+            std::cerr << "Failed to convert '" << argv[i] << "' to integer value"
+                << std::endl << help_message << std::endl;
+            return -1;
+        }
+        (i == 1 ? workers : transactions) = n;
+    }
+    if (argc > 3) {
+        file = argv[3];
+    }
+
+    modsecurity::ModSecurity *modsec = new modsecurity::ModSecurity();
+    modsecurity::RulesSet *rules = new modsecurity::RulesSet();
+    if (rules->loadFromUri(file.c_str()) < 0) {
+        std::cerr << "Problems loading the rules: " << std::endl
+            << rules->getParserError() << std::endl;
+        delete rules;
+        delete modsec;
+        return -1;
+    }
+
+    std::cout << workers << " worker(s), " << transactions
+        << " transaction(s) each, over " << file << "...\n";
+    for (unsigned long long w = 0; w < workers; w++) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            perror("fork");
+            return -1;
+        }
+        if (pid > 0) {
+            continue;
+        }
+
+        long long forked = privateDirty();
+        inspect(modsec, rules, 0);
+        long long warm = privateDirty();
+        for (unsigned long long i = 1; i < transactions; i++) {
+            inspect(modsec, rules, i);
+        }
+        long long done = privateDirty();
+
+        std::ostringstream out;
+        out << "  worker " << w << ": " << (warm - forked) / 1024
+            << " KiB after the first transaction, "
+            << (done - warm) / 1024 << " KiB more after the others\n";
+        std::cout << out.str() << std::flush;
+        _exit(forked < 0 ? 1 : 0);
+    }
+
+    int failed = 0;
+    for (unsigned long long w = 0; w < workers; w++) {
+        int status;
+        if (wait(&status) < 0 || !WIFEXITED(status)
+            || WEXITSTATUS(status) != 0) {
+            failed++;
+        }
+    }
+    if (failed) {
+        std::cerr << failed << " worker(s) could not tell their memory use"
+            << std::endl;
+    }
+
+    delete rules;
+    delete modsec;
+
+    return failed ? -1 : 0;
+}
@@ -0,0 +1,244 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/transaction.h"
+#include "src/operators/operator.h"
+
+using modsecurity::Transaction;
+using modsecurity::operators::Operator;
+
+/*
+ * huge_pages is a SecHugePages mode; to see what it does to the TLB, run
+ * it under perf stat -e dTLB-load-misses,iTLB-load-misses with Off and
+ * with On.
+ */
+const char* const help_message = "Usage: operators [num_iterations " \
+    "[name|all [huge_pages]]]";
+
+/* The words the pm operators look for, one per line in the file form. */
+const char *keywords[] = {
+    "union select",
+    "<script",
+    "javascript:",
+    "onerror=",
+    "/etc/passwd",
+    "cmd.exe",
+    "sleep(",
+    "benchmark(",
+    NULL
+};
+
+
+/*
+ * fixed is for the operators that look at a single short value (an
+ * address, a number), where the size classes do not apply.
+ */
+struct Case {
+    const char *name;
+    const char *param;
+    bool fixed;
+    const char *clean;
+    const char *dirty;
+};
+
+Case cases[] = {
+    { "rx", "(?i)(?:union\\s+select|<script[^>]*>|\\bsleep\\s*\\()",
+        false, NULL, NULL },
+    { "pm", NULL, false, NULL, NULL },
+    { "pmFromFile", NULL, false, NULL, NULL },
+    { "contains", "<script", false, NULL, NULL },
+    { "detectSQLi", "", false, NULL, NULL },
+    { "detectXSS", "", false, NULL, NULL },
+    { "validateUrlEncoding", "", false, NULL, NULL },
+    { "validateUtf8Encoding", "", false, NULL, NULL },
+    { "validateByteRange", "9,10,13,32-126", false, NULL, NULL },
+    /* More intervals than utils::scan::ByteRanges takes: the table loop. */
+    { "validateByteRange", "1,3,5,7,9,11,13,15,32-126", false, NULL, NULL },
+    { "verifyCC", "(?:\\d[\\s-]*?){13,16}", false, NULL, NULL },
+    { "ipMatch", "10.0.0.0/8,172.16.0.0/12,192.168.0.0/16,2001:db8::/32",
+        true, "203.0.113.7", "192.168.10.20" },
+    { "within", "GET POST HEAD OPTIONS", true, "DELETE", "POST" },
+    { "streq", "application/x-www-form-urlencoded", true,
+        "multipart/form-data", "application/x-www-form-urlencoded" },
+    { "eq", "0", true, "1", "0" },
+    { NULL, NULL, false, NULL, NULL }
+};
+
+
+/* Bytes per input: a header value, a typical argument, a request body. */
+const size_t sizes[] = { 64, 1024, 16384, 0 };
+
+
+/*
+ * What most of the inputs look like: plain text, already decoded, that
+ * none of the operators above matches.
+ */
+std::string cleanInput(size_t size) {
+    std::string s;
+    while (s.size() < size) {
+        s.append("Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 "
+            "Chrome/120.0.0.0 Safari/537.36 name=john&city=lisbon ");
+    }
+    s.resize(size);
+    return s;
+}
+
+
+/*
+ * An attack every few bytes, along with broken encodings and a card
+ * number, for the operators to find early and often.
+ */
+std::string dirtyInput(size_t size) {
+    std::string s;
+    while (s.size() < size) {
+        s.append("1' UNION SELECT pass FROM users-- <script>alert(1)"
+            "</script> %zz%c0%af \xc0\xaf 4111 1111 1111 1111 ");
+    }
+    s.resize(size);
+    return s;
+}
+
+
+void run(Operator *op, const std::string &name,
+    const std::string &kind, const std::string &input,
+    unsigned long long iterations, Transaction *transaction) {
+    unsigned long long matches = 0;
+
+    auto begin = std::chrono::steady_clock::now();
+    for (unsigned long long i = 0; i < iterations; i++) {
+        matches += op->evaluate(transaction, NULL, input, nullptr);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(end - begin).count();
+    std::cout << "  @" << name << " (" << kind << ", " << input.size()
+        << " bytes): " << ns / iterations << " ns/op"
+        << (matches ? ", matches" : "") << std::endl;
+}
+
+
+int main(int argc, char *argv[]) {
+    unsigned long long iterations(100000);
+
+    if (argc > 1) {
+        if (0 == strcmp(argv[1], "-h") ||
+            0 == strcmp(argv[1], "-?") ||
+            0 == strcmp(argv[1], "--help")) {
+            std::cout << help_message << std::endl;
+            return 0;
+        }
+        unsigned long long n = strtoull(argv[1], 0, 10);
+        if (n == 0) {
+            std::cerr << "Failed to convert '" << argv[1] << "' to integer value"
+                << std::endl << help_message << std::endl;
+            return -1;
+        }
+        iterations = n;
+    }
+    std::string filter;
+    if (argc > 2 && strcmp(argv[2], "all") != 0) {
+        filter = argv[2];
+    }
+
+    std::string words;
+    char file[] = "/tmp/modsec-operators-XXXXXX";
+    int fd = mkstemp(file);
+    if (fd < 0) {
+        perror("Failed to create the @pmFromFile list");
+        return -1;
+    }
+    close(fd);
+    std::ofstream list(file);
+    for (int i = 0; keywords[i] != NULL; i++) {
+        words.append(std::string(i ? " " : "") + keywords[i]);
+        list << keywords[i] << std::endl;
+    }
+    list.close();
+
+    modsecurity::ModSecurity *modsec = new modsecurity::ModSecurity();
+    modsecurity::RulesSet *rules = new modsecurity::RulesSet();
+    if (argc > 3
+        && rules->load((std::string("SecHugePages ") + argv[3]).c_str()) < 0) {
+        std::cerr << rules->getParserError() << std::endl;
+        return -1;
+    }
+    Transaction *transaction = new Transaction(modsec, rules, NULL);
+
+    /*
+     * num_iterations is for the 1 KiB inputs; the others are scaled to
+     * go through the same amount of bytes.
+     */
+    std::cout << "Doing " << iterations << " iterations per 1 KiB case...\n";
+    for (int i = 0; cases[i].name != NULL; i++) {
+        const Case &c = cases[i];
+        std::string name(c.name);
+        if (!filter.empty() && name != filter) {
+            continue;
+        }
+
+        std::string param;
+        if (name == "pm") {
+            param = words;
+        } else if (name == "pmFromFile") {
+            param = file;
+        } else {
+            param = c.param;
+        }
+
+        std::string error;
+        std::unique_ptr<Operator> op(Operator::instantiate(name, param));
+        if (op == nullptr || !op->init(file, &error)) {
+            std::cerr << "Failed to set up @" << name << ": " << error
+                << std::endl;
+            continue;
+        }
+
+        if (c.fixed) {
+            run(op.get(), name, "clean", c.clean, iterations, transaction);
+            run(op.get(), name, "dirty", c.dirty, iterations, transaction);
+            continue;
+        }
+        for (int j = 0; sizes[j] != 0; j++) {
+            unsigned long long n = iterations * 1024 / sizes[j];
+            if (n == 0) {
+                n = 1;
+            }
+            run(op.get(), name, "clean", cleanInput(sizes[j]), n,
+                transaction);
+            run(op.get(), name, "dirty", dirtyInput(sizes[j]), n,
+                transaction);
+        }
+    }
+
+    unlink(file);
+
+    delete transaction;
+    delete rules;
+    delete modsec;
+
+    return 0;
+}
@@ -0,0 +1,154 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/transaction.h"
+
+using modsecurity::Transaction;
+
+const char* const help_message = "Usage: request_body_stream " \
+    "[num_iterations [body_kib [chunk_bytes]]]";
+
+const char *patterns[] = {
+    "(?i)union[\\s/*]+select",
+    "(?i)<script[^>]*>",
+    "(?i)\\bsleep\\s*\\(",
+    "(?i)/etc/(?:passwd|shadow)",
+    "(?i)\\bjavascript:",
+    "(?i)on(?:error|load)\\s*=",
+    "\\.\\./\\.\\./",
+    "(?i)cmd\\.exe",
+    NULL
+};
+
+
+/*
+ * The @rx rules over REQUEST_BODY, streamed as the body is appended or,
+ * with an exclusion that changes nothing else, matched over the whole
+ * body in phase 2.
+ */
+static std::string rules(bool streamed) {
+    std::string conf("SecRuleEngine DetectionOnly\n" \
+        "SecRequestBodyAccess On\n" \
+        "SecRequestBodyLimit 134217728\n" \
+        "SecRequestBodyNoFilesLimit 134217728\n");
+
+    for (int i = 0; patterns[i] != NULL; i++) {
+        conf.append("SecRule REQUEST_BODY");
+        if (streamed == false) {
+            conf.append("|!REQUEST_HEADERS:x");
+        }
+        conf.append(" \"@rx " + std::string(patterns[i]) + "\" \"id:"
+            + std::to_string(i + 1) + ",phase:2,pass,nolog\"\n");
+    }
+
+    return conf;
+}
+
+
+static double run(modsecurity::ModSecurity *modsec,
+    modsecurity::RulesSet *rules, const std::string &body, size_t chunk,
+    unsigned long long iterations) {
+    std::chrono::nanoseconds total(0);
+
+    for (unsigned long long i = 0; i < iterations; i++) {
+        Transaction *t = new Transaction(modsec, rules, NULL);
+        t->processConnection("127.0.0.1", 12345, "127.0.0.1", 80);
+        t->processURI("/upload", "POST", "1.1");
+        t->addRequestHeader("Host", "localhost");
+        t->addRequestHeader("Content-Type", "text/plain");
+        t->processRequestHeaders();
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t offset = 0; offset < body.size(); offset += chunk) {
+            t->appendRequestBody(
+                reinterpret_cast<const unsigned char *>(body.data())
+                    + offset, std::min(chunk, body.size() - offset));
+        }
+        t->processRequestBody();
+        total += std::chrono::steady_clock::now() - start;
+
+        t->processLogging();
+        delete t;
+    }
+
+    return std::chrono::duration<double, std::micro>(total).count()
+        / iterations;
+}
+
+
+/*
+ * Time from the first byte of the request body appended to the end of
+ * phase 2, with the @rx rules streamed and with the same rules matched
+ * over the whole body.
+ */
+int main(int argc, char *argv[]) {
+    unsigned long long iterations(200);
+    unsigned long long kib(256);
+    unsigned long long chunk(8192);
+
+    if (argc > 1 && (0 == strcmp(argv[1], "-h") ||
+        0 == strcmp(argv[1], "-?") ||
+        0 == strcmp(argv[1], "--help"))) {
+        std::cout << help_message << std::endl;
+        return 0;
+    }
+    for (int i = 1; i < argc && i < 4; i++) {
+        unsigned long long n = strtoull(argv[i], 0, 10);
+        if (n == 0) {
+            std::cerr << "Failed to convert '" << argv[i] << "' to integer value"
+                << std::endl << help_message << std::endl;
+            return -1;
+        }
+        (i == 1 ? iterations : i == 2 ? kib : chunk) = n;
+    }
+
+    std::string body;
+    while (body.size() < kib * 1024) {
+        body.append("name=john&city=lisbon&comment=nothing to see here, "
+            "move along. ");
+    }
+    body.resize(kib * 1024);
+
+    modsecurity::ModSecurity *modsec = new modsecurity::ModSecurity();
+    std::cout << kib << " KiB bodies in " << chunk << " byte chunks, "
+        << iterations << " iteration(s)" << std::endl;
+    for (bool streamed : {true, false}) {
+        modsecurity::RulesSet *set = new modsecurity::RulesSet();
+        if (set->load(rules(streamed).c_str()) < 0) {
+            std::cerr << "Problems loading the rules: " << std::endl
+                << set->getParserError() << std::endl;
+            delete set;
+            delete modsec;
+            return -1;
+        }
+        std::cout << "  " << (streamed ? "streamed" : "whole body") << ": "
+            << run(modsec, set, body, chunk, iterations)
+            << " us per request" << std::endl;
+        delete set;
+    }
+    delete modsec;
+
+    return 0;
+}
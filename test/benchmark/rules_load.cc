@@ -0,0 +1,95 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+
+const char* const help_message = "Usage: rules_load [num_iterations " \
+    "[rules_file]]";
+
+
+/*
+ * Loads the rules file (basic_rules.conf, CRS included once downloaded,
+ * by default) into a new RulesSet num_iterations times and reports how
+ * long each load takes, the way a server start or a reload does it for
+ * every virtual host.
+ */
+int main(int argc, char *argv[]) {
+    unsigned long long iterations(10);
+    std::string file("basic_rules.conf");
+
+    if (argc > 1) {
+        if (0 == strcmp(argv[1], "-h") ||
+            0 == strcmp(argv[1], "-?") ||
+            0 == strcmp(argv[1], "--help")) {
+            std::cout << help_message << std::endl;
+            return 0;
+        }
+        unsigned long long n = strtoull(argv[1], 0, 10);
+        if (n == 0) {
+            std::cerr << "Failed to convert '" << argv[1] << "' to integer value"
+                << std::endl << help_message << std::endl;
+            return -1;
+        }
+        iterations = n;
+    }
+    if (argc > 2) {
+        file = argv[2];
+    }
+
+    modsecurity::ModSecurity *modsec = new modsecurity::ModSecurity();
+    double total = 0;
+    double best = 0;
+    int rules = 0;
+
+    std::cout << "Loading " << file << " " << iterations << " times...\n";
+    for (unsigned long long i = 0; i < iterations; i++) {
+        modsecurity::RulesSet *rulesSet = new modsecurity::RulesSet();
+
+        auto begin = std::chrono::steady_clock::now();
+        rules = rulesSet->loadFromUri(file.c_str());
+        auto end = std::chrono::steady_clock::now();
+
+        if (rules < 0) {
+            std::cerr << "Problems loading the rules: " << std::endl
+                << rulesSet->getParserError() << std::endl;
+            delete rulesSet;
+            delete modsec;
+            return -1;
+        }
+        delete rulesSet;
+
+        double ms = std::chrono::duration<double, std::milli>(
+            end - begin).count();
+        total += ms;
+        if (i == 0 || ms < best) {
+            best = ms;
+        }
+    }
+
+    std::cout << "  " << rules << " rules: " << total / iterations
+        << " ms/load, best " << best << " ms" << std::endl;
+
+    delete modsec;
+
+    return 0;
+}
@@ -0,0 +1,510 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rule.h"
+#include "modsecurity/rules_handle.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/transaction.h"
+#include "tools/replay/corpus.h"
+
+using modsecurity::Transaction;
+
+
+const char* const help_message = "" \
+    "Usage: scalability [options]\n" \
+    "\n" \
+    "  -n <num>       transactions per thread count (default: 100000)\n" \
+    "  -m <num>       most threads to go up to, doubling from 1\n" \
+    "                 (default: 64)\n" \
+    "  -r <file>      rules to load (default: basic_rules.conf)\n" \
+    "  -c <file>      requests to replay, as benchmark -c takes them\n" \
+    "  -i <num>       distinct client addresses, spread over the IP\n" \
+    "                 collection records (default: 256)\n" \
+    "  -x             no rule updating the shared IP collection\n" \
+    "  -l <file>      serial audit log of every transaction, to file\n" \
+    "  -H             take the rules from a RulesHandle, with a new\n" \
+    "                 transaction per request, as reloading connectors do\n" \
+    "  -j             print the results as JSON\n" \
+    "  -h, -?, --help this text\n" \
+    "\n" \
+    "For every thread count, all the threads share one rules set and the\n" \
+    "persistent collections. The throughput is compared with the one of\n" \
+    "a single thread, the waits for the shared locks are read from the\n" \
+    "engine metrics, and the cost of copying the shared pointers that all\n" \
+    "the threads copy (the rules, the handle) is measured apart.";
+
+
+/* the shared locks, as named by modsecurity_lock_waits_total */
+static const char *lockNames[] = {
+    "collection_shard",
+    "collection_per_process",
+    "shared_files_mutex",
+    "shared_files_fcntl",
+    "lmdb_writer"
+};
+static const size_t kLocks = sizeof(lockNames) / sizeof(lockNames[0]);
+
+
+struct LockWaits {
+    double waits[kLocks];
+    double seconds[kLocks];
+};
+
+
+/*
+ * The lock wait counters, as rendered by ModSecurity::metrics(): they
+ * are process wide, so a thread count gets the difference of two reads.
+ */
+static LockWaits lockWaits(const modsecurity::ModSecurity *modsec) {
+    static const std::string waits("modsecurity_lock_waits_total{lock=\"");
+    static const std::string seconds(
+        "modsecurity_lock_wait_seconds_total{lock=\"");
+    LockWaits w = {};
+    std::istringstream metrics(modsec->metrics());
+    std::string line;
+
+    while (std::getline(metrics, line)) {
+        double *into = NULL;
+        size_t start = 0;
+        if (line.compare(0, waits.size(), waits) == 0) {
+            into = w.waits;
+            start = waits.size();
+        } else if (line.compare(0, seconds.size(), seconds) == 0) {
+            into = w.seconds;
+            start = seconds.size();
+        } else {
+            continue;
+        }
+        size_t end = line.find('"', start);
+        if (end == std::string::npos) {
+            continue;
+        }
+        std::string name(line, start, end - start);
+        for (size_t l = 0; l < kLocks; l++) {
+            if (name == lockNames[l]) {
+                into[l] = strtod(line.c_str() + line.rfind(' ') + 1, NULL);
+            }
+        }
+    }
+    return w;
+}
+
+
+struct Worker {
+    modsecurity::ModSecurity *modsec;
+    modsecurity::RulesSet *rules;
+    modsecurity::RulesHandle *handle;
+    std::vector<Request> corpus;
+    std::atomic<unsigned long long> *next;
+    unsigned long long total;
+    unsigned long long clients;
+    pthread_t thread;
+
+    unsigned long long transactions;
+};
+
+
+/*
+ * Without a handle, each worker recycles its own transaction, as a
+ * connector would do per connection; with one, it asks the handle for a
+ * new transaction per request. The client address of the request picks
+ * the record of the IP collection.
+ */
+static void *work(void *data) {
+    Worker *w = reinterpret_cast<Worker *>(data);
+    Transaction *t = NULL;
+
+    if (w->handle == NULL) {
+        t = new Transaction(w->modsec, w->rules, NULL);
+    }
+    while (true) {
+        unsigned long long i = (*w->next)++;
+        if (i >= w->total) {
+            break;
+        }
+        Request &r = w->corpus[i % w->corpus.size()];
+        unsigned long long client = i % w->clients;
+        r.clientIp = "10." + std::to_string((client >> 16) & 0xff) + "."
+            + std::to_string((client >> 8) & 0xff) + "."
+            + std::to_string(client & 0xff);
+
+        if (w->handle != NULL) {
+            t = w->handle->newTransaction(w->modsec, NULL);
+        }
+        replay(t, r);
+        t->processLogging();
+        w->transactions++;
+        if (w->handle != NULL) {
+            delete t;
+        } else {
+            t->reset();
+        }
+    }
+
+    if (w->handle == NULL) {
+        delete t;
+    }
+    return NULL;
+}
+
+
+/*
+ * Copies, and drops, the shared pointers that every transaction of every
+ * thread goes through: one of the rules and, with a handle, the current
+ * rules set. Their reference counts are shared by all the threads, so
+ * the cost of a copy grows with the threads that bounce their cache
+ * line around.
+ */
+struct Prober {
+    std::shared_ptr<modsecurity::Rule> rule;
+    modsecurity::RulesHandle *handle;
+    unsigned long long copies;
+    pthread_t thread;
+
+    double ns;
+};
+
+
+static void *probe(void *data) {
+    Prober *p = reinterpret_cast<Prober *>(data);
+    auto begin = std::chrono::steady_clock::now();
+
+    for (unsigned long long i = 0; i < p->copies; i++) {
+        std::shared_ptr<modsecurity::Rule> rule(p->rule);
+        if (p->handle != NULL) {
+            std::shared_ptr<modsecurity::RulesSet> rules(
+                p->handle->current());
+        }
+    }
+
+    p->ns = std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - begin).count() / p->copies;
+    return NULL;
+}
+
+
+static std::shared_ptr<modsecurity::Rule> someRule(
+    modsecurity::RulesSet *rules) {
+    for (int phase = 0; phase < modsecurity::Phases::NUMBER_OF_PHASES;
+        phase++) {
+        modsecurity::Rules *r = rules->m_rulesSetPhases.at(phase);
+        if (r->size() > 0) {
+            return r->at(0);
+        }
+    }
+    return std::shared_ptr<modsecurity::Rule>();
+}
+
+
+static bool number(const char *arg, unsigned long long *value) {
+    char *end = NULL;
+    errno = 0;
+    unsigned long long v = strtoull(arg, &end, 10);
+    if (errno || end == arg || *end != '\0') {
+        return false;
+    }
+    *value = v;
+    return true;
+}
+
+
+struct Step {
+    unsigned long long threads;
+    unsigned long long transactions;
+    double elapsed;
+    double tps;
+    double refcountNs;
+    LockWaits locks;
+};
+
+
+int main(int argc, char *argv[]) {
+    unsigned long long transactions = 100000;
+    unsigned long long max_threads = 64;
+    unsigned long long clients = 256;
+    std::string rules_path("basic_rules.conf");
+    std::string corpus_path;
+    std::string audit_log;
+    bool collection = true;
+    bool use_handle = false;
+    bool json = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg(argv[i]);
+        if (arg == "-h" || arg == "-?" || arg == "--help") {
+            std::cout << help_message << std::endl;
+            return 0;
+        }
+        if (arg == "-j") {
+            json = true;
+            continue;
+        }
+        if (arg == "-x") {
+            collection = false;
+            continue;
+        }
+        if (arg == "-H") {
+            use_handle = true;
+            continue;
+        }
+        if (arg.size() != 2 || arg[0] != '-' || i + 1 >= argc) {
+            std::cerr << "Invalid option " << arg << std::endl
+                      << help_message << std::endl;
+            return -1;
+        }
+        const char *value = argv[++i];
+        bool ok = true;
+        switch (arg[1]) {
+            case 'n': ok = number(value, &transactions); break;
+            case 'm': ok = number(value, &max_threads); break;
+            case 'i': ok = number(value, &clients); break;
+            case 'r': rules_path = value; break;
+            case 'c': corpus_path = value; break;
+            case 'l': audit_log = value; break;
+            default: ok = false;
+        }
+        if (!ok) {
+            std::cerr << "Invalid value for " << arg << ": '" << value
+                      << "'" << std::endl << help_message << std::endl;
+            return -1;
+        }
+    }
+    if (transactions == 0 || max_threads == 0 || clients == 0) {
+        std::cerr << "The transactions, threads and clients can not be 0"
+                  << std::endl;
+        return -1;
+    }
+
+    std::vector<Request> corpus;
+    if (corpus_path.empty()) {
+        Request r;
+        r.clientIp = "10.0.0.1";
+        r.clientPort = 12345;
+        r.serverIp = "127.0.0.1";
+        r.serverPort = 80;
+        r.method = "GET";
+        r.uri = "/test.pl?param1=test&para2=test2";
+        r.httpVersion = "1.1";
+        r.headers = {
+            {"Host", "net.tutsplus.com"},
+            {"User-Agent", "Mozilla/5.0 (X11; Linux x86_64)"},
+            {"Accept", "text/html,application/xhtml+xml,*/*;q=0.8"},
+            {"Cookie", "PHPSESSID=r2t5uvjq435r4q7ib3vtdjq120"}
+        };
+        r.status = 200;
+        r.protocol = "HTTP 1.1";
+        r.responseHeaders = {{"Content-Type", "text/html"}};
+        r.responseBody = "<html><body>hello</body></html>";
+        corpus.push_back(r);
+    } else {
+        std::string error;
+        if (!loadCorpus(corpus_path, &corpus, &error)) {
+            std::cerr << "Problems loading the corpus: " << error
+                      << std::endl;
+            return -1;
+        }
+        if (corpus.empty()) {
+            std::cerr << "No requests in " << corpus_path << std::endl;
+            return -1;
+        }
+    }
+
+    modsecurity::ModSecurity *modsec = new modsecurity::ModSecurity();
+    modsec->setConnectorInformation("ModSecurity-scalability v0.0.1" \
+            " (ModSecurity scalability benchmark)");
+
+    modsecurity::RulesSet *rules = new modsecurity::RulesSet();
+    if (rules->loadFromUri(rules_path.c_str()) < 0) {
+        std::cerr << "Problems loading the rules..." << std::endl
+                  << rules->m_parserError.str() << std::endl;
+        return -1;
+    }
+    std::string extra;
+    if (collection) {
+        extra.append("SecAction \"id:900990,phase:1,nolog,pass,t:none," \
+            "initcol:ip=%{REMOTE_ADDR},setvar:ip.requests=+1\"\n");
+    }
+    if (audit_log.empty() == false) {
+        extra.append("SecAuditEngine On\nSecAuditLogType Serial\n" \
+            "SecAuditLogParts ABFHZ\nSecAuditLog " + audit_log + "\n");
+    }
+    if (extra.empty() == false && rules->load(extra.c_str()) < 0) {
+        std::cerr << "Problems loading the rules..." << std::endl
+                  << rules->m_parserError.str() << std::endl;
+        return -1;
+    }
+
+    std::shared_ptr<modsecurity::Rule> rule = someRule(rules);
+    modsecurity::RulesHandle *handle = NULL;
+    if (use_handle) {
+        handle = new modsecurity::RulesHandle(rules);
+    }
+
+    std::vector<unsigned long long> counts;
+    for (unsigned long long n = 1; n < max_threads; n = n * 2) {
+        counts.push_back(n);
+    }
+    counts.push_back(max_threads);
+
+    if (!json) {
+        std::cout << transactions << " transactions per thread count, up "
+                  << "to " << max_threads << " threads, over "
+                  << corpus.size() << " request(s)...\n";
+    }
+
+    std::vector<Step> steps;
+    for (unsigned long long n : counts) {
+        Step step;
+        std::atomic<unsigned long long> next(0);
+        std::vector<Worker> workers(n);
+        LockWaits before = lockWaits(modsec);
+
+        auto begin = std::chrono::steady_clock::now();
+        for (auto &w : workers) {
+            w.modsec = modsec;
+            w.rules = rules;
+            w.handle = handle;
+            w.corpus = corpus;
+            w.next = &next;
+            w.total = transactions;
+            w.clients = clients;
+            w.transactions = 0;
+            pthread_create(&w.thread, NULL, work, &w);
+        }
+        step.transactions = 0;
+        for (auto &w : workers) {
+            pthread_join(w.thread, NULL);
+            step.transactions += w.transactions;
+        }
+        step.elapsed = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - begin).count();
+
+        LockWaits after = lockWaits(modsec);
+        for (size_t l = 0; l < kLocks; l++) {
+            step.locks.waits[l] = after.waits[l] - before.waits[l];
+            step.locks.seconds[l] = after.seconds[l] - before.seconds[l];
+        }
+        step.threads = n;
+        step.tps = step.transactions / step.elapsed;
+
+        step.refcountNs = 0;
+        if (rule) {
+            std::vector<Prober> probers(n);
+            for (auto &p : probers) {
+                p.rule = rule;
+                p.handle = handle;
+                p.copies = 1000000;
+                pthread_create(&p.thread, NULL, probe, &p);
+            }
+            for (auto &p : probers) {
+                pthread_join(p.thread, NULL);
+                step.refcountNs += p.ns / n;
+            }
+        }
+
+        steps.push_back(step);
+    }
+
+    double single = steps.front().tps;
+    if (json) {
+        std::cout << std::fixed << std::setprecision(3) << "{"
+                  << "\"rules\": \"" << rules_path << "\", "
+                  << "\"corpus\": \"" << corpus_path << "\", "
+                  << "\"clients\": " << clients << ", "
+                  << "\"collection\": " << (collection ? "true" : "false")
+                  << ", \"audit_log\": \"" << audit_log << "\", "
+                  << "\"rules_handle\": " << (use_handle ? "true" : "false")
+                  << ", \"steps\": [";
+        for (size_t s = 0; s < steps.size(); s++) {
+            const Step &step = steps[s];
+            std::cout << (s ? ", " : "") << "{"
+                      << "\"threads\": " << step.threads << ", "
+                      << "\"transactions\": " << step.transactions << ", "
+                      << "\"elapsed_seconds\": " << step.elapsed << ", "
+                      << "\"transactions_per_second\": " << step.tps << ", "
+                      << "\"speedup\": " << step.tps / single << ", "
+                      << "\"efficiency\": "
+                      << step.tps / (single * step.threads) << ", "
+                      << "\"refcount_ns_per_copy\": " << step.refcountNs
+                      << ", \"locks\": {";
+            for (size_t l = 0; l < kLocks; l++) {
+                std::cout << (l ? ", " : "") << "\"" << lockNames[l]
+                          << "\": {\"waits\": " << step.locks.waits[l]
+                          << ", \"wait_seconds\": " << step.locks.seconds[l]
+                          << "}";
+            }
+            std::cout << "}}";
+        }
+        std::cout << "]}" << std::endl;
+    } else {
+        std::cout << std::fixed << std::setprecision(2) << "\n"
+                  << std::setw(8) << "threads" << std::setw(16)
+                  << "transactions/s" << std::setw(10) << "speedup"
+                  << std::setw(12) << "efficiency" << std::setw(16)
+                  << "refcount ns/copy" << "\n";
+        for (const Step &step : steps) {
+            std::cout << std::setw(8) << step.threads << std::setw(16)
+                      << step.tps << std::setw(10) << step.tps / single
+                      << std::setw(11)
+                      << 100 * step.tps / (single * step.threads) << "%"
+                      << std::setw(16) << step.refcountNs << "\n";
+        }
+
+        std::cout << "\nLock waits: times found taken, and microseconds "
+                  << "waited, per 1000 transactions\n" << std::setw(8)
+                  << "threads";
+        for (size_t l = 0; l < kLocks; l++) {
+            std::cout << std::setw(26) << lockNames[l];
+        }
+        std::cout << "\n";
+        for (const Step &step : steps) {
+            std::cout << std::setw(8) << step.threads;
+            for (size_t l = 0; l < kLocks; l++) {
+                std::ostringstream cell;
+                cell << std::fixed << std::setprecision(2)
+                     << 1000 * step.locks.waits[l] / step.transactions
+                     << " / "
+                     << 1e9 * step.locks.seconds[l] / step.transactions;
+                std::cout << std::setw(26) << cell.str();
+            }
+            std::cout << "\n";
+        }
+    }
+
+    rule.reset();
+    if (handle != NULL) {
+        delete handle;
+    } else {
+        delete rules;
+    }
+    delete modsec;
+    return 0;
+}
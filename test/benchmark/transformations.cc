@@ -0,0 +1,180 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <string.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/transaction.h"
+#include "src/actions/transformations/transformation.h"
+
+using modsecurity::Transaction;
+using modsecurity::actions::transformations::Transformation;
+
+const char* const help_message = "Usage: transformations " \
+    "[num_iterations [name]]";
+
+const char *transformations[] = {
+    "base64Decode",
+    "base64DecodeExt",
+    "base64Encode",
+    "cmd_line",
+    "compressWhitespace",
+    "cssDecode",
+    "escapeSeqDecode",
+    "hexDecode",
+    "hexEncode",
+    "htmlEntityDecode",
+    "jsDecode",
+    "length",
+    "lowercase",
+    "md5",
+    "normalisePath",
+    "normalisePathWin",
+    "parityEven7bit",
+    "parityOdd7bit",
+    "parityZero7bit",
+    "removeComments",
+    "removeCommentsChar",
+    "removeNulls",
+    "removeWhitespace",
+    "replaceComments",
+    "replaceNulls",
+    "sha1",
+    "sqlHexDecode",
+    "trim",
+    "trimLeft",
+    "trimRight",
+    "uppercase",
+    "urlDecode",
+    "urlDecodeUni",
+    "urlEncode",
+    "utf8toUnicode",
+    NULL
+};
+
+
+/* Bytes per input: a header value, a typical argument, a request body. */
+const size_t sizes[] = { 64, 1024, 16384, 0 };
+
+
+/*
+ * What most of the inputs look like: nothing to decode, nothing to strip,
+ * few upper case letters, if any.
+ */
+std::string cleanInput(size_t size) {
+    std::string s;
+    while (s.size() < size) {
+        s.append("mozilla/5.0_(x11;_linux_x86_64)_applewebkit/537.36_"
+            "chrome/120.0.0.0_safari/537.36;");
+    }
+    s.resize(size);
+    return s;
+}
+
+
+/* Something to do every few bytes. */
+std::string dirtyInput(size_t size) {
+    std::string s;
+    while (s.size() < size) {
+        s.append("Select%20*+FROM\tusers%00&lt;script&gt;  ");
+        s.push_back('\0');
+    }
+    s.resize(size);
+    return s;
+}
+
+
+void run(Transformation *t, const std::string &name,
+    const std::string &kind, const std::string &input,
+    unsigned long long iterations, Transaction *transaction) {
+    std::string value;
+
+    auto begin = std::chrono::steady_clock::now();
+    for (unsigned long long i = 0; i < iterations; i++) {
+        value.assign(input);
+        t->transform(value, transaction);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(end - begin).count();
+    std::cout << "  t:" << name << " (" << kind << ", " << input.size()
+        << " bytes): " << ns / iterations << " ns/op" << std::endl;
+}
+
+
+int main(int argc, char *argv[]) {
+    unsigned long long iterations(100000);
+
+    if (argc > 1) {
+        if (0 == strcmp(argv[1], "-h") ||
+            0 == strcmp(argv[1], "-?") ||
+            0 == strcmp(argv[1], "--help")) {
+            std::cout << help_message << std::endl;
+            return 0;
+        }
+        unsigned long long n = strtoull(argv[1], 0, 10);
+        if (n == 0) {
+            std::cerr << "Failed to convert '" << argv[1] << "' to integer value"
+                << std::endl << help_message << std::endl;
+            return -1;
+        }
+        iterations = n;
+    }
+    std::string filter;
+    if (argc > 2) {
+        filter = argv[2];
+    }
+
+    /* t:urlDecodeUni may look at the rules (SecUnicodeMapFile) */
+    modsecurity::ModSecurity *modsec = new modsecurity::ModSecurity();
+    modsecurity::RulesSet *rules = new modsecurity::RulesSet();
+    Transaction *transaction = new Transaction(modsec, rules, NULL);
+
+    /*
+     * num_iterations is for the 1 KiB inputs; the others are scaled to
+     * go through the same amount of bytes.
+     */
+    std::cout << "Doing " << iterations << " iterations per 1 KiB case...\n";
+    for (int i = 0; transformations[i] != NULL; i++) {
+        std::string name(transformations[i]);
+        if (!filter.empty() && name != filter) {
+            continue;
+        }
+        std::unique_ptr<Transformation> t(
+            Transformation::instantiate("t:" + name));
+        for (int j = 0; sizes[j] != 0; j++) {
+            unsigned long long n = iterations * 1024 / sizes[j];
+            if (n == 0) {
+                n = 1;
+            }
+            run(t.get(), name, "clean", cleanInput(sizes[j]), n,
+                transaction);
+            run(t.get(), name, "dirty", dirtyInput(sizes[j]), n,
+                transaction);
+        }
+    }
+
+    delete transaction;
+    delete rules;
+    delete modsec;
+
+    return 0;
+}
@@ -0,0 +1,133 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <dirent.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "test/fuzzer/cost_targets.h"
+
+/*
+ * Runs the worst case inputs found by test/fuzzer/cost_fuzzer, one file
+ * per target, named after it (see CostTargets). With max_ns_per_byte, the
+ * exit status is 1 when one of them takes longer than that: a regression
+ * back to a super-linear worst case.
+ */
+const char* const help_message = "Usage: worst_case [num_iterations " \
+    "[dir [rules_file|- [max_ns_per_byte]]]]";
+
+
+int main(int argc, char *argv[]) {
+    unsigned long long iterations(100);
+    std::string dir("worst_case");
+    std::string rulesFile;
+    double limit = 0;
+
+    if (argc > 1) {
+        if (0 == strcmp(argv[1], "-h") ||
+            0 == strcmp(argv[1], "-?") ||
+            0 == strcmp(argv[1], "--help")) {
+            std::cout << help_message << std::endl;
+            return 0;
+        }
+        unsigned long long n = strtoull(argv[1], 0, 10);
+        if (n == 0) {
+            std::cerr << "Failed to convert '" << argv[1] << "' to integer value"
+                << std::endl << help_message << std::endl;
+            return -1;
+        }
+        iterations = n;
+    }
+    if (argc > 2) {
+        dir = argv[2];
+    }
+    if (argc > 3 && strcmp(argv[3], "-") != 0) {
+        rulesFile = argv[3];
+    }
+    if (argc > 4) {
+        limit = strtod(argv[4], NULL);
+    }
+
+    CostTargets targets(rulesFile);
+    if (targets.error().empty() == false) {
+        std::cerr << targets.error() << std::endl;
+        return -1;
+    }
+
+    DIR *d = opendir(dir.c_str());
+    if (d == NULL) {
+        std::cerr << "Failed to open " << dir << std::endl;
+        return -1;
+    }
+    std::vector<std::string> files;
+    while (struct dirent *e = readdir(d)) {
+        if (e->d_name[0] != '.') {
+            files.push_back(e->d_name);
+        }
+    }
+    closedir(d);
+    std::sort(files.begin(), files.end());
+
+    CostCounter counter;
+    int status = 0;
+
+    std::cout << "Doing " << iterations << " iterations per input, cost in "
+        << counter.unit() << "...\n";
+    for (const std::string &name : files) {
+        const std::vector<std::string> &names = targets.names();
+        if (std::find(names.begin(), names.end(), name) == names.end()) {
+            std::cerr << "  " << name << ": no such target, skipped"
+                << std::endl;
+            continue;
+        }
+
+        std::ifstream in(dir + "/" + name, std::ios::binary);
+        std::stringstream ss;
+        ss << in.rdbuf();
+        std::string input(ss.str());
+        const uint8_t *data = reinterpret_cast<const uint8_t *>(input.data());
+
+        uint64_t cost = 0;
+        auto begin = std::chrono::steady_clock::now();
+        for (unsigned long long i = 0; i < iterations; i++) {
+            counter.start();
+            targets.run(name, data, input.size());
+            cost += counter.stop();
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        double ns = std::chrono::duration<double, std::nano>(end - begin)
+            .count() / iterations;
+        double perByte = input.size() ? ns / input.size() : ns;
+        std::cout << "  " << name << " (" << input.size() << " bytes): "
+            << cost / iterations << " " << counter.unit() << "/run, "
+            << perByte << " ns/byte";
+        if (limit > 0 && perByte > limit) {
+            std::cout << ", over the limit";
+            status = 1;
+        }
+        std::cout << std::endl;
+    }
+
+    return status;
+}
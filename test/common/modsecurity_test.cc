@@ -21,6 +21,7 @@
 #include <dirent.h>
 #include <string.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 #include <fstream>
 #include <cstdlib>
@@ -145,6 +146,16 @@ void ModSecurityTest<T>::cmd_options(int argc, char **argv) {
         i++;
         m_count_all = true;
     }
+    if (argc > i && strncmp(argv[i], "-j", 2) == 0) {
+        m_jobs = std::atoi(argv[i] + 2);
+        if (m_jobs <= 0) {
+            m_jobs = sysconf(_SC_NPROCESSORS_ONLN);
+        }
+        if (m_jobs <= 0) {
+            m_jobs = 1;
+        }
+        i++;
+    }
     if (std::getenv("AUTOMAKE_TESTS")) {
         m_automake_output = true;
     }
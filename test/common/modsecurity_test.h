@@ -34,7 +34,8 @@ template <class T> class ModSecurityTest :
     ModSecurityTest()
         : m_test_number(0),
         m_automake_output(false),
-        m_count_all(false) { }
+        m_count_all(false),
+        m_jobs(0) { }
 
     std::string header();
     void cmd_options(int, char **);
@@ -48,6 +49,8 @@ template <class T> class ModSecurityTest :
     int m_test_number;
     bool m_automake_output;
     bool m_count_all;
+    /* -jN: how many workers run the tests, 0 when they run in-process. */
+    int m_jobs;
 };
 
 }  // namespace modsecurity_test
@@ -0,0 +1,119 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+/**
+ * A libFuzzer target that looks for the inputs that cost the most, rather
+ * than for crashes: besides the code coverage, libFuzzer is given the
+ * cost of each run (see CostCounter), one counter per target and per
+ * quarter of a power of two, so that an input that costs more than all
+ * of the ones before it is a new feature and is kept in the corpus.
+ *
+ * The first byte of the input picks the target (see CostTargets), the
+ * rest is what the target is given. Build with --enable-afl-fuzz and
+ * CXX=clang++, then:
+ *
+ *   make -C test/fuzzer cost_fuzzer
+ *   MODSEC_FUZZ_RULES=crs.conf MODSEC_FUZZ_WORST=worst/ \
+ *       ./test/fuzzer/cost_fuzzer -use_value_profile=1 -max_len=65536 \
+ *       corpus/
+ *
+ * MODSEC_FUZZ_RULES adds the "rules" target. With MODSEC_FUZZ_WORST set,
+ * the costliest input seen so far for each target is kept there in a
+ * file named after the target, without the first byte: what
+ * test/benchmark/worst_case runs.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "test/fuzzer/cost_targets.h"
+
+
+/* libFuzzer counts what is set here as coverage. */
+#define MSC_COST_TARGETS 64
+#define MSC_COST_BUCKETS 128
+
+__attribute__((section("__libfuzzer_extra_counters")))
+static uint8_t costCounters[MSC_COST_TARGETS * MSC_COST_BUCKETS];
+
+
+static CostTargets *targets = nullptr;
+static CostCounter *counter = nullptr;
+static std::vector<uint64_t> worst;
+static std::string worstDir;
+
+
+/* 4 * log2(cost), plus the two bits after the leading one. */
+static size_t bucket(uint64_t cost) {
+    if (cost < 4) {
+        return cost;
+    }
+    size_t n = 63 - __builtin_clzll(cost);
+    size_t b = 4 * n + ((cost >> (n - 2)) & 3);
+    return b < MSC_COST_BUCKETS ? b : MSC_COST_BUCKETS - 1;
+}
+
+
+extern "C" int LLVMFuzzerInitialize(int *argc, char ***argv) {
+    const char *rules = getenv("MODSEC_FUZZ_RULES");
+    const char *dir = getenv("MODSEC_FUZZ_WORST");
+
+    targets = new CostTargets(rules ? rules : "");
+    if (targets->error().empty() == false) {
+        fprintf(stderr, "cost_fuzzer: %s\n", targets->error().c_str());
+        exit(1);
+    }
+    counter = new CostCounter();
+    worst.assign(targets->names().size(), 0);
+    if (dir != NULL) {
+        worstDir = std::string(dir) + "/";
+    }
+
+    fprintf(stderr, "cost_fuzzer: %zu targets, cost in %s\n",
+        targets->names().size(), counter->unit());
+    return 0;
+}
+
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    if (size == 0) {
+        return 0;
+    }
+    size_t t = data[0] % targets->names().size();
+    const std::string &name = targets->names()[t];
+
+    counter->start();
+    targets->run(name, data + 1, size - 1);
+    uint64_t cost = counter->stop();
+
+    if (t < MSC_COST_TARGETS) {
+        costCounters[t * MSC_COST_BUCKETS + bucket(cost)] = 1;
+    }
+
+    if (cost > worst[t]) {
+        worst[t] = cost;
+        if (worstDir.empty() == false) {
+            std::ofstream out(worstDir + name, std::ios::binary);
+            out.write(reinterpret_cast<const char *>(data + 1), size - 1);
+        }
+    }
+
+    return 0;
+}
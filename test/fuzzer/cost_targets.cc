@@ -0,0 +1,258 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "test/fuzzer/cost_targets.h"
+
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#endif
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/transaction.h"
+#include "src/actions/transformations/transformation.h"
+
+using modsecurity::ModSecurity;
+using modsecurity::RulesSet;
+using modsecurity::Transaction;
+using modsecurity::actions::transformations::Transformation;
+
+
+namespace {
+
+const char *transformations[] = {
+    "base64Decode",
+    "base64DecodeExt",
+    "base64Encode",
+    "cmd_line",
+    "compressWhitespace",
+    "cssDecode",
+    "escapeSeqDecode",
+    "hexDecode",
+    "hexEncode",
+    "htmlEntityDecode",
+    "jsDecode",
+    "length",
+    "lowercase",
+    "md5",
+    "normalisePath",
+    "normalisePathWin",
+    "parityEven7bit",
+    "parityOdd7bit",
+    "parityZero7bit",
+    "removeComments",
+    "removeCommentsChar",
+    "removeNulls",
+    "removeWhitespace",
+    "replaceComments",
+    "replaceNulls",
+    "sha1",
+    "sqlHexDecode",
+    "trim",
+    "trimLeft",
+    "trimRight",
+    "uppercase",
+    "urlDecode",
+    "urlDecodeUni",
+    "urlEncode",
+    "utf8toUnicode",
+    NULL
+};
+
+
+/* The body processors, by the Content-Type that picks them. */
+const char *bodies[][2] = {
+    { "body-urlencoded", "application/x-www-form-urlencoded" },
+    { "body-json", "application/json" },
+    { "body-xml", "text/xml" },
+    { "body-multipart", "multipart/form-data; boundary=----fuzz" },
+    { NULL, NULL }
+};
+
+
+/*
+ * JSON and XML are not parsed unless asked for. A rule that looks at all
+ * of the arguments makes them resolved, as most rule sets do.
+ */
+const char *bodyRules =
+    "SecRuleEngine On\n"
+    "SecRequestBodyAccess On\n"
+    "SecRequestBodyLimit 1048576\n"
+    "SecRequestBodyNoFilesLimit 1048576\n"
+    "SecRule REQUEST_HEADERS:Content-Type \"@beginsWith application/json\" "
+        "\"id:1,phase:1,pass,nolog,ctl:requestBodyProcessor=JSON\"\n"
+    "SecRule REQUEST_HEADERS:Content-Type \"@beginsWith text/xml\" "
+        "\"id:2,phase:1,pass,nolog,ctl:requestBodyProcessor=XML\"\n"
+    "SecRule ARGS|ARGS_NAMES|XML:/* \"@rx ^$\" \"id:3,phase:2,pass,nolog\"\n";
+
+
+/* The instances, kept from one run to the next: they cost to build. */
+std::map<std::string, std::unique_ptr<Transformation>> &instances() {
+    static std::map<std::string, std::unique_ptr<Transformation>> t;
+    return t;
+}
+
+}  // namespace
+
+
+CostTargets::CostTargets(const std::string &rulesFile)
+    : m_modsec(new ModSecurity()),
+    m_bodyRules(new RulesSet()),
+    m_rules(nullptr) {
+    for (int i = 0; transformations[i] != NULL; i++) {
+        std::string name(transformations[i]);
+        instances()[name].reset(Transformation::instantiate("t:" + name));
+        m_names.push_back("t-" + name);
+    }
+
+    if (m_bodyRules->load(bodyRules) < 0) {
+        m_error = m_bodyRules->getParserError();
+    } else {
+        for (int i = 0; bodies[i][0] != NULL; i++) {
+            m_names.push_back(bodies[i][0]);
+        }
+    }
+
+    if (rulesFile.empty() == false) {
+        m_rules = new RulesSet();
+        if (m_rules->loadFromUri(rulesFile.c_str()) < 0) {
+            m_error = m_rules->getParserError();
+            delete m_rules;
+            m_rules = nullptr;
+        } else {
+            m_names.push_back("rules");
+        }
+    }
+}
+
+
+CostTargets::~CostTargets() {
+    instances().clear();
+    delete m_rules;
+    delete m_bodyRules;
+    delete m_modsec;
+}
+
+
+bool CostTargets::run(const std::string &name, const uint8_t *data,
+    size_t size) {
+    if (name.compare(0, 2, "t-") == 0) {
+        auto it = instances().find(name.substr(2));
+        if (it == instances().end()) {
+            return false;
+        }
+        std::string value(reinterpret_cast<const char *>(data), size);
+        Transaction transaction(m_modsec, m_bodyRules, NULL);
+        it->second->transform(value, &transaction);
+        return true;
+    }
+
+    for (int i = 0; bodies[i][0] != NULL; i++) {
+        if (name == bodies[i][0]) {
+            return request(m_bodyRules, bodies[i][1], data, size, false);
+        }
+    }
+
+    if (name == "rules" && m_rules != nullptr) {
+        return request(m_rules, bodies[0][1], data, size, true);
+    }
+
+    return false;
+}
+
+
+bool CostTargets::request(RulesSet *rules, const std::string &type,
+    const uint8_t *data, size_t size, bool query) {
+    std::string value(reinterpret_cast<const char *>(data), size);
+    Transaction transaction(m_modsec, rules, NULL);
+
+    transaction.processConnection("127.0.0.1", 33172, "127.0.0.1", 80);
+    transaction.processURI(query ? ("/index.php?" + value).c_str()
+        : "/index.php", "POST", "1.1");
+    transaction.addRequestHeader("Host", "localhost");
+    transaction.addRequestHeader("User-Agent", query ? value : "fuzz");
+    transaction.addRequestHeader("Content-Type", type);
+    transaction.addRequestHeader("Content-Length", std::to_string(size));
+    transaction.processRequestHeaders();
+    transaction.appendRequestBody(data, size);
+    transaction.processRequestBody();
+
+    return true;
+}
+
+
+CostCounter::CostCounter()
+    : m_fd(-1),
+    m_start(0) {
+#ifdef __linux__
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    m_fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+}
+
+
+CostCounter::~CostCounter() {
+    if (m_fd >= 0) {
+        close(m_fd);
+    }
+}
+
+
+static uint64_t threadTime() {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+
+void CostCounter::start() {
+    if (m_fd < 0 || read(m_fd, &m_start, sizeof(m_start))
+        != sizeof(m_start)) {
+        m_start = threadTime();
+    }
+}
+
+
+uint64_t CostCounter::stop() {
+    uint64_t now = 0;
+
+    if (m_fd < 0 || read(m_fd, &now, sizeof(now)) != sizeof(now)) {
+        now = threadTime();
+    }
+    return now > m_start ? now - m_start : 0;
+}
+
+
+const char *CostCounter::unit() const {
+    return m_fd >= 0 ? "instructions" : "ns";
+}
@@ -0,0 +1,95 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#ifndef TEST_FUZZER_COST_TARGETS_H_
+#define TEST_FUZZER_COST_TARGETS_H_
+
+namespace modsecurity {
+class ModSecurity;
+class RulesSet;
+}
+
+
+/**
+ * What the cost fuzzer (cost_fuzzer.cc) and the worst case benchmark
+ * (test/benchmark/worst_case.cc) run an input through, by name:
+ *
+ *  - t-<name>: the transformation, e.g. t-htmlEntityDecode.
+ *  - body-urlencoded, body-json, body-xml, body-multipart: a request with
+ *    the input as its body, parsed by that body processor, ARGS resolved
+ *    once by a rule.
+ *  - rules: a request with the input as its query string, body and
+ *    User-Agent, through the rules file given (CRS, typically). Only
+ *    there when a rules file was.
+ *
+ */
+class CostTargets {
+ public:
+    explicit CostTargets(const std::string &rulesFile = "");
+    ~CostTargets();
+
+    CostTargets(const CostTargets &) = delete;
+    CostTargets &operator=(const CostTargets &) = delete;
+
+    /* Empty when the body processor or rules file failed to load. */
+    const std::string &error() const { return m_error; }
+
+    const std::vector<std::string> &names() const { return m_names; }
+    /* false when there is no such target */
+    bool run(const std::string &name, const uint8_t *data, size_t size);
+
+ private:
+    bool request(modsecurity::RulesSet *rules, const std::string &type,
+        const uint8_t *data, size_t size, bool query);
+
+    std::vector<std::string> m_names;
+    std::string m_error;
+    modsecurity::ModSecurity *m_modsec;
+    modsecurity::RulesSet *m_bodyRules;
+    modsecurity::RulesSet *m_rules;
+};
+
+
+/**
+ * Cost of what runs on the calling thread between start() and stop():
+ * retired instructions when the kernel counts them for us (see
+ * perf_event_open(2)), thread CPU time in nanoseconds otherwise.
+ *
+ */
+class CostCounter {
+ public:
+    CostCounter();
+    ~CostCounter();
+
+    CostCounter(const CostCounter &) = delete;
+    CostCounter &operator=(const CostCounter &) = delete;
+
+    void start();
+    uint64_t stop();
+    /* "instructions" or "ns" */
+    const char *unit() const;
+
+ private:
+    int m_fd;
+    uint64_t m_start;
+};
+
+#endif  // TEST_FUZZER_COST_TARGETS_H_
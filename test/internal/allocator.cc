@@ -0,0 +1,164 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <stdlib.h>
+
+#include <mutex>
+#include <unordered_set>
+
+#include "modsecurity/intervention.h"
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/transaction.h"
+#include "test/internal/internal_test.h"
+
+
+namespace {
+
+/*
+ * The allocator of the connector: it knows what it gave out, and counts
+ * what it is asked to free without having given it.
+ */
+struct Counting {
+    std::mutex m_lock;
+    std::unordered_set<void *> m_live;
+    size_t m_allocations;
+    size_t m_foreign;
+};
+
+Counting counting;
+
+
+void *countingAllocate(void *data, size_t size) {
+    Counting *c = static_cast<Counting *>(data);
+    void *ptr = malloc(size);
+    std::lock_guard<std::mutex> guard(c->m_lock);
+    c->m_allocations++;
+    c->m_live.insert(ptr);
+    return ptr;
+}
+
+
+void countingRelease(void *data, void *ptr) {
+    Counting *c = static_cast<Counting *>(data);
+    if (ptr == NULL) {
+        return;
+    }
+    std::lock_guard<std::mutex> guard(c->m_lock);
+    if (c->m_live.erase(ptr) == 0) {
+        c->m_foreign++;
+        return;
+    }
+    free(ptr);
+}
+
+
+void *countingReallocate(void *data, void *ptr, size_t size) {
+    Counting *c = static_cast<Counting *>(data);
+    if (ptr == NULL) {
+        return countingAllocate(data, size);
+    }
+    std::lock_guard<std::mutex> guard(c->m_lock);
+    if (c->m_live.erase(ptr) == 0) {
+        c->m_foreign++;
+        return NULL;
+    }
+    void *fresh = realloc(ptr, size);
+    c->m_allocations++;
+    c->m_live.insert(fresh != NULL ? fresh : ptr);
+    return fresh;
+}
+
+
+size_t live() {
+    std::lock_guard<std::mutex> guard(counting.m_lock);
+    return counting.m_live.size();
+}
+
+
+int verdict(modsecurity::ModSecurity *msc, modsecurity::RulesSet *rules) {
+    modsecurity::ModSecurityIntervention it;
+    int status = 0;
+
+    modsecurity::Transaction *t = modsecurity::msc_new_transaction(msc,
+        rules, NULL);
+    modsecurity::msc_process_connection(t, "127.0.0.1", 12345,
+        "127.0.0.1", 80);
+    modsecurity::msc_process_uri(t, "/?a=%61tt%61ck&b=x", "GET", "1.1");
+    modsecurity::msc_process_request_headers(t);
+    modsecurity::intervention::reset(&it);
+    if (modsecurity::msc_intervention(t, &it) != 0) {
+        status = it.status;
+    }
+    modsecurity::intervention::free(&it);
+    modsecurity::msc_process_logging(t);
+    modsecurity::msc_transaction_cleanup(t);
+    return status;
+}
+
+}  // namespace
+
+
+/*
+ * The first test of the file: nothing of the library allocated anything
+ * yet in this process.
+ */
+INTERNAL_TEST(allocator_gets_what_the_library_allocates) {
+    ModSecAllocator incomplete = {countingAllocate, NULL, countingRelease,
+        &counting};
+    ModSecAllocator a = {countingAllocate, countingReallocate,
+        countingRelease, &counting};
+
+    counting.m_allocations = 0;
+    counting.m_foreign = 0;
+    CHECK_EQ(modsecurity::msc_set_allocator(&incomplete), -1);
+    CHECK_EQ(modsecurity::msc_set_allocator(&a), 0);
+
+    {
+        modsecurity::ModSecurity msc;
+        modsecurity::RulesSet rules;
+
+        /* the instance seals it */
+        CHECK_EQ(modsecurity::msc_set_allocator(NULL), -1);
+
+        CHECK(rules.load("SecRuleEngine On\n" \
+            "SecRule ARGS \"@streq attack\" " \
+            "\"id:1,phase:1,t:cssDecode,t:urlEncode,deny,status:403\"\n")
+            >= 0);
+
+        CHECK_EQ(verdict(&msc, &rules), 403);
+        size_t after = live();
+        CHECK(counting.m_allocations > 0);
+
+        /* what a transaction allocated goes back with it */
+        for (int i = 0; i < 10; i++) {
+            CHECK_EQ(verdict(&msc, &rules), 403);
+        }
+        CHECK_EQ(live(), after);
+    }
+
+    /* nothing it did not allocate itself was handed to it */
+    CHECK_EQ(counting.m_foreign, 0);
+}
+
+
+/* Whatever went through the allocator has to be freed by it. */
+INTERNAL_TEST(allocator_stays_once_something_was_allocated) {
+    ModSecAllocator a = {countingAllocate, countingReallocate,
+        countingRelease, &counting};
+
+    CHECK_EQ(modsecurity::msc_set_allocator(&a), -1);
+    CHECK_EQ(modsecurity::msc_set_allocator(NULL), -1);
+}
@@ -0,0 +1,261 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "modsecurity/intervention.h"
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/transaction.h"
+#include "test/internal/internal_test.h"
+
+
+using modsecurity::msc_header;
+using modsecurity::msc_iovec;
+using modsecurity::msc_request;
+using modsecurity::msc_response;
+using modsecurity_test::internal::statusOf;
+
+
+namespace {
+
+const char kRules[] =
+    "SecRuleEngine On\n" \
+    "SecRequestBodyAccess On\n" \
+    "SecResponseBodyAccess On\n" \
+    "SecResponseBodyMimeType text/html\n" \
+    "SecRule REQUEST_HEADERS:X-Block \"@streq yes\" " \
+        "\"id:1,phase:1,deny,status:401\"\n" \
+    "SecRule ARGS_POST:b \"@streq attack\" " \
+        "\"id:2,phase:2,deny,status:402\"\n" \
+    "SecRule RESPONSE_HEADERS:X-Leak \"@streq yes\" " \
+        "\"id:3,phase:3,deny,status:403\"\n" \
+    "SecRule RESPONSE_BODY \"@contains secretword\" " \
+        "\"id:4,phase:4,deny,status:404\"\n";
+
+
+const unsigned char *bytes(const char *s) {
+    return reinterpret_cast<const unsigned char *>(s);
+}
+
+
+/*
+ * Names and values are taken by their length: they point into buffers
+ * with more after them, as a connector's would.
+ */
+msc_header header(const char *key, size_t key_len, const char *value,
+    size_t value_len) {
+    msc_header h;
+    h.key = bytes(key);
+    h.key_len = key_len;
+    h.value = bytes(value);
+    h.value_len = value_len;
+    return h;
+}
+
+
+msc_iovec piece(const char *s) {
+    msc_iovec v;
+    v.base = bytes(s);
+    v.len = strlen(s);
+    return v;
+}
+
+
+struct Exchange {
+    bool block;
+    std::vector<const char *> requestBody;
+    bool leak;
+    std::vector<const char *> responseBody;
+};
+
+
+/* The status the transaction ends with, through the batch calls. */
+int batch(modsecurity::RulesSet *rules, const Exchange &e) {
+    modsecurity::ModSecurity msc;
+    std::vector<msc_header> requestHeaders;
+    std::vector<msc_header> responseHeaders;
+    std::vector<msc_iovec> requestBody;
+    std::vector<msc_iovec> responseBody;
+    int status;
+
+    requestHeaders.push_back(header("Host: localhost", 4,
+        "localhost\r\n", 9));
+    requestHeaders.push_back(header("Content-Type", 12,
+        "application/x-www-form-urlencoded; more", 33));
+    if (e.block) {
+        requestHeaders.push_back(header("X-Block-ignored", 7, "yes-ignored",
+            3));
+    }
+    for (const char *p : e.requestBody) {
+        requestBody.push_back(piece(p));
+    }
+
+    msc_request req;
+    req.client_ip = "127.0.0.1";
+    req.client_port = 12345;
+    req.server_ip = "127.0.0.1";
+    req.server_port = 80;
+    req.uri = "/form";
+    req.method = "POST";
+    req.http_version = "1.1";
+    req.headers = requestHeaders.data();
+    req.headers_n = requestHeaders.size();
+    req.body = requestBody.data();
+    req.body_n = requestBody.size();
+
+    responseHeaders.push_back(header("Content-Type", 12, "text/html", 9));
+    if (e.leak) {
+        responseHeaders.push_back(header("X-Leak", 6, "yes", 3));
+    }
+    for (const char *p : e.responseBody) {
+        responseBody.push_back(piece(p));
+    }
+
+    msc_response res;
+    res.code = 200;
+    res.protocol = "HTTP 1.1";
+    res.headers = responseHeaders.data();
+    res.headers_n = responseHeaders.size();
+    res.body = responseBody.data();
+    res.body_n = responseBody.size();
+
+    modsecurity::Transaction *t = modsecurity::msc_new_transaction(&msc,
+        rules, NULL);
+    CHECK_EQ(modsecurity::msc_process_request(t, &req), 1);
+    status = statusOf(t);
+    if (status == 0) {
+        CHECK_EQ(modsecurity::msc_process_response(t, &res), 1);
+        status = statusOf(t);
+    }
+    modsecurity::msc_process_logging(t);
+    modsecurity::msc_transaction_cleanup(t);
+    return status;
+}
+
+
+/* The same, a call per step. */
+int stepwise(modsecurity::RulesSet *rules, const Exchange &e) {
+    modsecurity::ModSecurity msc;
+    int status = 0;
+
+    modsecurity::Transaction *t = modsecurity::msc_new_transaction(&msc,
+        rules, NULL);
+    modsecurity::msc_process_connection(t, "127.0.0.1", 12345,
+        "127.0.0.1", 80);
+    modsecurity::msc_process_uri(t, "/form", "POST", "1.1");
+    modsecurity::msc_add_request_header(t, bytes("Host"),
+        bytes("localhost"));
+    modsecurity::msc_add_request_header(t, bytes("Content-Type"),
+        bytes("application/x-www-form-urlencoded"));
+    if (e.block) {
+        modsecurity::msc_add_request_header(t, bytes("X-Block"),
+            bytes("yes"));
+    }
+    modsecurity::msc_process_request_headers(t);
+    status = statusOf(t);
+    if (status == 0) {
+        for (const char *p : e.requestBody) {
+            modsecurity::msc_append_request_body(t, bytes(p), strlen(p));
+        }
+        modsecurity::msc_process_request_body(t);
+        status = statusOf(t);
+    }
+    if (status == 0) {
+        modsecurity::msc_add_response_header(t, bytes("Content-Type"),
+            bytes("text/html"));
+        if (e.leak) {
+            modsecurity::msc_add_response_header(t, bytes("X-Leak"),
+                bytes("yes"));
+        }
+        modsecurity::msc_process_response_headers(t, 200, "HTTP 1.1");
+        status = statusOf(t);
+    }
+    if (status == 0) {
+        for (const char *p : e.responseBody) {
+            modsecurity::msc_append_response_body(t, bytes(p), strlen(p));
+        }
+        modsecurity::msc_process_response_body(t);
+        status = statusOf(t);
+    }
+    modsecurity::msc_process_logging(t);
+    modsecurity::msc_transaction_cleanup(t);
+    return status;
+}
+
+
+void check(const Exchange &e, int expected) {
+    modsecurity::RulesSet rules;
+
+    CHECK(rules.load(kRules) >= 0);
+    CHECK_EQ(stepwise(&rules, e), expected);
+    CHECK_EQ(batch(&rules, e), expected);
+}
+
+}  // namespace
+
+
+INTERNAL_TEST(clean_exchange_passes) {
+    Exchange e;
+    e.block = false;
+    e.requestBody = {"a=1&", "b=harmless"};
+    e.leak = false;
+    e.responseBody = {"<html>", "nothing to see", "</html>"};
+    check(e, 0);
+}
+
+
+INTERNAL_TEST(request_headers_are_taken_by_length) {
+    Exchange e;
+    e.block = true;
+    e.requestBody = {"b=attack"};
+    e.leak = true;
+    e.responseBody = {"secretword"};
+    /* phase 1 stops it before the body is even appended */
+    check(e, 401);
+}
+
+
+INTERNAL_TEST(request_body_pieces_are_joined) {
+    Exchange e;
+    e.block = false;
+    e.requestBody = {"a=1&b=at", "ta", "ck"};
+    e.leak = false;
+    e.responseBody = {"secretword"};
+    check(e, 402);
+}
+
+
+INTERNAL_TEST(response_headers_run_phase_three) {
+    Exchange e;
+    e.block = false;
+    e.requestBody = {"a=1"};
+    e.leak = true;
+    e.responseBody = {"secretword"};
+    check(e, 403);
+}
+
+
+INTERNAL_TEST(response_body_pieces_are_joined) {
+    Exchange e;
+    e.block = false;
+    e.requestBody = {};
+    e.leak = false;
+    e.responseBody = {"<html>secr", "et", "word</html>"};
+    check(e, 404);
+}
@@ -0,0 +1,154 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <ctime>
+#include <limits>
+#include <memory>
+#include <string>
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/transaction.h"
+#include "src/collection/backend/expiry.h"
+#include "src/collection/backend/in_memory-sharded.h"
+#include "test/internal/internal_test.h"
+
+
+using modsecurity::collection::backend::Expiry;
+using modsecurity::collection::backend::InMemorySharded;
+
+
+namespace {
+
+const uint64_t kNoBudget = std::numeric_limits<uint64_t>::max();
+
+
+/*
+ * A collection the test sweeps by itself: the thread of Expiry is kept
+ * away from it, the cursor of a sweeper is only used by one thread.
+ */
+class Swept : public InMemorySharded {
+ public:
+    explicit Swept(const std::string &name) : InMemorySharded(name) {
+        Expiry::getInstance().remove(this);
+    }
+};
+
+
+void run(modsecurity::ModSecurity *msc, modsecurity::RulesSet *rules) {
+    modsecurity::Transaction *t = modsecurity::msc_new_transaction(msc,
+        rules, NULL);
+    modsecurity::msc_process_connection(t, "127.0.0.1", 12345,
+        "127.0.0.1", 80);
+    modsecurity::msc_process_uri(t, "/", "GET", "1.1");
+    modsecurity::msc_process_request_headers(t);
+    modsecurity::msc_process_logging(t);
+    modsecurity::msc_transaction_cleanup(t);
+}
+
+}  // namespace
+
+
+INTERNAL_TEST(scope_sets_the_timeout_of_the_thread) {
+    Expiry &expiry = Expiry::getInstance();
+
+    CHECK_EQ(expiry.timeout(), 0u);
+    CHECK_EQ(expiry.expiresAt(), 0);
+    {
+        Expiry::Scope outer(30);
+        CHECK_EQ(expiry.timeout(), 30u);
+        {
+            Expiry::Scope inner(0);
+            CHECK_EQ(expiry.timeout(), 0u);
+            CHECK_EQ(expiry.expiresAt(), 0);
+        }
+        CHECK_EQ(expiry.timeout(), 30u);
+        int64_t at = expiry.expiresAt();
+        int64_t now = static_cast<int64_t>(time(NULL));
+        CHECK(at >= now + 29 && at <= now + 30);
+    }
+    CHECK_EQ(expiry.timeout(), 0u);
+}
+
+
+INTERNAL_TEST(sweep_goes_on_where_it_stopped) {
+    Swept c("IP");
+    const int keys = 20000;
+
+    {
+        Expiry::Scope scope(1);
+        for (int i = 0; i < keys; i++) {
+            std::string n(std::to_string(i));
+            c.store("flat" + n, "1");
+            c.store("key", "record" + n, "app", "1");
+        }
+    }
+    c.store("kept", "1");
+
+    /* already out of time: a chunk of a shard per call */
+    int64_t later = static_cast<int64_t>(time(NULL)) + 5;
+    CHECK(c.sweep(later, 0) == false);
+
+    int calls = 1;
+    while (c.sweep(later, 0) == false) {
+        calls++;
+        CHECK(calls < keys);
+    }
+    CHECK(calls > static_cast<int>(InMemorySharded::kShards));
+
+    for (int i = 0; i < keys; i += 97) {
+        std::string n(std::to_string(i));
+        CHECK(c.resolveFirst("flat" + n) == nullptr);
+        CHECK(c.resolveFirst("key", "record" + n, "app") == nullptr);
+    }
+    CHECK(c.resolveFirst("kept") != nullptr);
+
+    /* a whole pass with the time to do it */
+    CHECK(c.sweep(later, kNoBudget));
+}
+
+
+INTERNAL_TEST(timeout_is_the_one_of_the_rules_set) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet expiring;
+    modsecurity::RulesSet kept;
+
+    delete msc.m_ip_collection;
+    Swept *ip = new Swept("IP");
+    msc.m_ip_collection = ip;
+
+    CHECK(expiring.load("SecRuleEngine On\n" \
+        "SecCollectionTimeout 10\n" \
+        "SecAction \"id:1,phase:1,pass,nolog,initcol:ip=expiring," \
+        "setvar:ip.hits=1\"\n") >= 0);
+    CHECK(kept.load("SecRuleEngine On\n" \
+        "SecAction \"id:1,phase:1,pass,nolog,initcol:ip=kept," \
+        "setvar:ip.hits=1\"\n") >= 0);
+    CHECK_EQ(expiring.collectionTimeout(), 10u);
+    CHECK_EQ(kept.collectionTimeout(), 0u);
+
+    /* the last one loaded does not change the first one */
+    run(&msc, &expiring);
+    run(&msc, &kept);
+
+    const std::string &app = expiring.m_secWebAppId.m_value;
+    CHECK(ip->resolveFirst("hits", "expiring", app) != nullptr);
+    CHECK(ip->resolveFirst("hits", "kept", app) != nullptr);
+
+    int64_t later = static_cast<int64_t>(time(NULL)) + 20;
+    CHECK(ip->sweep(later, kNoBudget));
+    CHECK(ip->resolveFirst("hits", "expiring", app) == nullptr);
+    CHECK(ip->resolveFirst("hits", "kept", app) != nullptr);
+}
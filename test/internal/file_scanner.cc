@@ -0,0 +1,324 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <arpa/inet.h>
+#include <poll.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/transaction.h"
+#include "modsecurity/intervention.h"
+#include "src/utils/file_scanner.h"
+#include "test/internal/internal_test.h"
+
+
+using modsecurity::Utils::FileScanner;
+using modsecurity_test::internal::tempFile;
+
+
+namespace {
+
+/*
+ * Scanner listening on a UNIX socket, in a thread of its own. With the
+ * line protocol, names containing "eicar" are infected; with clamd, any
+ * content containing it.
+ */
+class FakeScanner {
+ public:
+    explicit FakeScanner(bool clamd)
+        : m_clamd(clamd),
+        m_closeIdle(false),
+        m_accepted(0),
+        m_stop(false) {
+        char dir[] = "/tmp/modsec-scanner-XXXXXX";
+        m_dir = mkdtemp(dir);
+        m_path = m_dir + "/scanner.sock";
+
+        struct sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        memcpy(addr.sun_path, m_path.c_str(), m_path.size());
+        m_listen = socket(AF_UNIX, SOCK_STREAM, 0);
+        bind(m_listen, reinterpret_cast<struct sockaddr *>(&addr),
+            sizeof(addr));
+        listen(m_listen, 16);
+
+        m_thread = std::thread(&FakeScanner::serve, this);
+    }
+
+    ~FakeScanner() {
+        m_stop = true;
+        m_thread.join();
+        for (auto &c : m_connections) {
+            close(c.first);
+        }
+        close(m_listen);
+        unlink(m_path.c_str());
+        rmdir(m_dir.c_str());
+    }
+
+    const std::string &path() const { return m_path; }
+    int accepted() const { return m_accepted.load(); }
+    /* hang up on every connection once it is answered */
+    void closeIdle() { m_closeIdle = true; }
+
+ private:
+    void serve() {
+        while (m_stop == false) {
+            std::vector<struct pollfd> fds;
+            fds.push_back({m_listen, POLLIN, 0});
+            for (auto &c : m_connections) {
+                fds.push_back({c.first, POLLIN, 0});
+            }
+            if (poll(fds.data(), fds.size(), 20) <= 0) {
+                continue;
+            }
+            if (fds[0].revents & POLLIN) {
+                int fd = accept(m_listen, NULL, NULL);
+                if (fd >= 0) {
+                    m_accepted++;
+                    m_connections[fd] = std::string();
+                }
+            }
+            for (size_t i = 1; i < fds.size(); i++) {
+                if (fds[i].revents == 0) {
+                    continue;
+                }
+                char buffer[4096];
+                ssize_t n = recv(fds[i].fd, buffer, sizeof(buffer), 0);
+                if (n <= 0 || handle(fds[i].fd, buffer, n) == false) {
+                    close(fds[i].fd);
+                    m_connections.erase(fds[i].fd);
+                }
+            }
+        }
+    }
+
+    /* false to close the connection */
+    bool handle(int fd, const char *data, size_t len) {
+        std::string &in = m_connections[fd];
+        in.append(data, len);
+
+        if (m_clamd == false) {
+            size_t eol = in.find('\n');
+            if (eol == std::string::npos) {
+                return true;
+            }
+            std::string name = in.substr(0, eol);
+            in.erase(0, eol + 1);
+            answer(fd, name.find("eicar") == std::string::npos ?
+                "1 clean\n" : "0 infected\n");
+            return m_closeIdle == false;
+        }
+
+        if (in.compare(0, 11, std::string("zIDSESSION\0", 11)) == 0) {
+            in.erase(0, 11);
+        }
+        if (in.compare(0, 10, std::string("zINSTREAM\0", 10)) != 0) {
+            return in.size() < 10;
+        }
+        std::string content;
+        size_t pos = 10;
+        for (;;) {
+            if (in.size() < pos + 4) {
+                return true;
+            }
+            uint32_t chunk;
+            memcpy(&chunk, in.data() + pos, 4);
+            chunk = ntohl(chunk);
+            pos += 4;
+            if (chunk == 0) {
+                break;
+            }
+            if (in.size() < pos + chunk) {
+                return true;
+            }
+            content.append(in, pos, chunk);
+            pos += chunk;
+        }
+        in.erase(0, pos);
+        m_requests++;
+        std::string reply = std::to_string(m_requests) + ": stream: ";
+        reply.append(content.find("eicar") == std::string::npos ?
+            "OK" : "Eicar-Test-Signature FOUND");
+        reply.push_back('\0');
+        answer(fd, reply);
+        return m_closeIdle == false;
+    }
+
+    static void answer(int fd, const std::string &reply) {
+        send(fd, reply.data(), reply.size(), MSG_NOSIGNAL);
+    }
+
+    bool m_clamd;
+    std::atomic<bool> m_closeIdle;
+    std::atomic<int> m_accepted;
+    std::atomic<bool> m_stop;
+    int m_requests = 0;
+    int m_listen;
+    std::string m_dir;
+    std::string m_path;
+    std::map<int, std::string> m_connections;
+    std::thread m_thread;
+};
+
+}  // namespace
+
+
+INTERNAL_TEST(parameters) {
+    std::string error;
+    std::unique_ptr<FileScanner> s;
+
+    s.reset(FileScanner::fromParameter("/usr/bin/scan.sh", &error));
+    CHECK(s == nullptr);
+    CHECK(error.empty());
+
+    s.reset(FileScanner::fromParameter("unix:/run/s.sock timeout=20",
+        &error));
+    CHECK(s != nullptr);
+    CHECK(error.empty());
+
+    s.reset(FileScanner::fromParameter("clamd:/run/s.sock timeout=x",
+        &error));
+    CHECK(s == nullptr);
+    CHECK(error.empty() == false);
+
+    error.clear();
+    s.reset(FileScanner::fromParameter("unix:/run/s.sock retries=2",
+        &error));
+    CHECK(s == nullptr);
+    CHECK(error.empty() == false);
+}
+
+
+INTERNAL_TEST(line_protocol_reuses_the_connection) {
+    FakeScanner server(false);
+    std::string error;
+    std::unique_ptr<FileScanner> s(FileScanner::fromParameter(
+        "unix:" + server.path() + " timeout=2000", &error));
+    CHECK(s != nullptr);
+
+    for (int i = 0; i < 4; i++) {
+        bool found = true;
+        std::string reply;
+        CHECK(s->scan("/tmp/clean-file", &found, &reply, &error));
+        CHECK(found == false);
+        CHECK_EQ(reply, std::string("1 clean"));
+
+        CHECK(s->scan("/tmp/eicar-file", &found, &reply, &error));
+        CHECK(found);
+        CHECK_EQ(reply, std::string("0 infected"));
+    }
+
+    CHECK_EQ(server.accepted(), 1);
+}
+
+
+INTERNAL_TEST(line_protocol_retries_a_closed_connection) {
+    FakeScanner server(false);
+    std::string error;
+    std::unique_ptr<FileScanner> s(FileScanner::fromParameter(
+        "unix:" + server.path() + " timeout=2000", &error));
+    bool found = true;
+    std::string reply;
+
+    server.closeIdle();
+    CHECK(s->scan("/tmp/clean-file", &found, &reply, &error));
+    usleep(100000);
+    /* the pooled connection was closed by the scanner meanwhile */
+    CHECK(s->scan("/tmp/eicar-file", &found, &reply, &error));
+    CHECK(found);
+    CHECK_EQ(server.accepted(), 2);
+}
+
+
+INTERNAL_TEST(clamd_streams_the_content) {
+    FakeScanner server(true);
+    std::string error;
+    std::unique_ptr<FileScanner> s(FileScanner::fromParameter(
+        "clamd:" + server.path() + " timeout=2000", &error));
+    std::string clean = tempFile("nothing to see here");
+    std::string infected = tempFile(std::string(100000, 'x') + "eicar");
+    bool found = true;
+    std::string reply;
+
+    CHECK(s->scan(clean, &found, &reply, &error));
+    CHECK(found == false);
+    CHECK_EQ(reply, std::string("OK"));
+
+    /* more than one chunk */
+    CHECK(s->scan(infected, &found, &reply, &error));
+    CHECK(found);
+    CHECK_EQ(reply, std::string("Eicar-Test-Signature FOUND"));
+    CHECK_EQ(server.accepted(), 1);
+
+    CHECK(s->scan("/nonexistent/file", &found, &reply, &error) == false);
+    unlink(clean.c_str());
+    unlink(infected.c_str());
+}
+
+
+INTERNAL_TEST(unreachable_scanner) {
+    std::string error;
+    std::unique_ptr<FileScanner> s(FileScanner::fromParameter(
+        "unix:/nonexistent/scanner.sock timeout=200", &error));
+    bool found = true;
+    std::string reply;
+
+    CHECK(s->scan("/tmp/eicar-file", &found, &reply, &error) == false);
+    CHECK(error.empty() == false);
+}
+
+
+INTERNAL_TEST(inspect_file_operator) {
+    FakeScanner server(false);
+    std::string rules("SecRuleEngine On\n" \
+        "SecRule ARGS:file \"@inspectFile unix:");
+    rules.append(server.path());
+    rules.append(" timeout=2000\" \"id:1,phase:1,deny,status:403\"\n");
+
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules_set;
+    CHECK(rules_set.load(rules.c_str()) > 0);
+
+    const char *uris[] = { "/?file=clean", "/?file=eicar", "/?file=ok" };
+    int expected[] = { 200, 403, 200 };
+    for (int i = 0; i < 3; i++) {
+        modsecurity::Transaction t(&msc, &rules_set, NULL);
+        modsecurity::ModSecurityIntervention it;
+        modsecurity::intervention::reset(&it);
+        t.processConnection("127.0.0.1", 12345, "127.0.0.1", 80);
+        t.processURI(uris[i], "GET", "1.1");
+        t.processRequestHeaders();
+        t.intervention(&it);
+        modsecurity::intervention::free(&it);
+        CHECK_EQ(it.status, expected[i]);
+    }
+
+    CHECK_EQ(server.accepted(), 1);
+}
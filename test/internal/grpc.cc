@@ -0,0 +1,423 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/transaction.h"
+#include "modsecurity/variable_value.h"
+#include "src/request_body_processor/grpc.h"
+#include "test/internal/internal_test.h"
+
+
+namespace {
+
+enum WireType {
+    Varint = 0,
+    Fixed64 = 1,
+    LengthDelimited = 2,
+    StartGroup = 3,
+    EndGroup = 4,
+    Fixed32 = 5,
+};
+
+
+std::string varint(uint64_t v) {
+    std::string s;
+    while (v >= 0x80) {
+        s.push_back(static_cast<char>((v & 0x7f) | 0x80));
+        v = v >> 7;
+    }
+    s.push_back(static_cast<char>(v));
+    return s;
+}
+
+
+std::string little(uint64_t v, size_t bytes) {
+    std::string s;
+    for (size_t i = 0; i < bytes; i++) {
+        s.push_back(static_cast<char>((v >> (8 * i)) & 0xff));
+    }
+    return s;
+}
+
+
+std::string big(uint64_t v, size_t bytes) {
+    std::string s = little(v, bytes);
+    std::reverse(s.begin(), s.end());
+    return s;
+}
+
+
+std::string tag(uint64_t field, WireType type) {
+    return varint(field << 3 | type);
+}
+
+
+std::string number(uint64_t field, uint64_t v) {
+    return tag(field, Varint) + varint(v);
+}
+
+
+std::string fixed32(uint64_t field, uint32_t v) {
+    return tag(field, Fixed32) + little(v, 4);
+}
+
+
+std::string fixed64(uint64_t field, uint64_t v) {
+    return tag(field, Fixed64) + little(v, 8);
+}
+
+
+std::string delimited(uint64_t field, const std::string &v) {
+    return tag(field, LengthDelimited) + varint(v.size()) + v;
+}
+
+
+std::string group(uint64_t field, const std::string &fields) {
+    return tag(field, StartGroup) + fields + tag(field, EndGroup);
+}
+
+
+/* The fields nested in as many messages, all of them the field 1. */
+std::string nested(const std::string &fields, int levels) {
+    std::string m = fields;
+    for (int i = 0; i < levels; i++) {
+        m = delimited(1, m);
+    }
+    return m;
+}
+
+
+std::string frame(const std::string &message, bool compressed = false) {
+    return std::string(1, compressed ? 1 : 0) + big(message.size(), 4)
+        + message;
+}
+
+
+/*
+ * A zlib stream of a single stored block: compressed as far as the
+ * inflater is concerned, without having to link zlib here.
+ */
+std::string deflated(const std::string &data) {
+    uint32_t a = 1;
+    uint32_t b = 0;
+    for (unsigned char c : data) {
+        a = (a + c) % 65521;
+        b = (b + a) % 65521;
+    }
+    return std::string("\x78\x01\x01", 3) + little(data.size(), 2)
+        + little(~data.size() & 0xffff, 2) + data + big(b << 16 | a, 4);
+}
+
+
+/*
+ * Decodes body, handed over in pieces of size bytes; the error, empty
+ * if there was none.
+ */
+std::string decode(modsecurity::Transaction *t, const std::string &body,
+    size_t size) {
+    modsecurity::RequestBodyProcessor::GRPC grpc(t);
+    std::string error;
+
+    CHECK(grpc.init());
+    for (size_t i = 0; i < body.size() && error.empty(); i = i + size) {
+        grpc.processChunk(body.data() + i, std::min(size, body.size() - i),
+            &error);
+    }
+    if (error.empty()) {
+        grpc.complete(&error);
+    }
+    return error;
+}
+
+
+std::string decode(modsecurity::Transaction *t, const std::string &body) {
+    return decode(t, body, body.size() > 0 ? body.size() : 1);
+}
+
+
+std::vector<std::string> values(modsecurity::Transaction *t,
+    const std::string &name) {
+    std::vector<const modsecurity::VariableValue *> l;
+    std::vector<std::string> v;
+
+    t->m_variableArgs.resolve(name, &l);
+    for (const modsecurity::VariableValue *a : l) {
+        v.push_back(a->getValue());
+        delete a;
+    }
+    std::sort(v.begin(), v.end());
+    return v;
+}
+
+
+std::string value(modsecurity::Transaction *t, const std::string &name) {
+    std::vector<std::string> v = values(t, name);
+    CHECK_EQ(v.size(), 1);
+    return v.front();
+}
+
+}  // namespace
+
+
+INTERNAL_TEST(grpc_names_the_fields_of_nested_messages) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules;
+    CHECK(rules.load("SecRuleEngine On\n") >= 0);
+    modsecurity::Transaction t(&msc, &rules, NULL);
+
+    std::string inner = delimited(2, "abc") + number(3, 150);
+    std::string message = delimited(1, inner) + fixed32(4, 7)
+        + fixed64(5, 0x100000000ULL) + delimited(6, "\x01\xff")
+        + delimited(7, "(a");
+
+    CHECK_EQ(decode(&t, frame(message)), "");
+    CHECK_EQ(t.m_variableArgs.size(), 6);
+    CHECK_EQ(value(&t, "grpc.1.2"), "abc");
+    CHECK_EQ(value(&t, "grpc.1.3"), "150");
+    CHECK_EQ(value(&t, "grpc.4"), "7");
+    CHECK_EQ(value(&t, "grpc.5"), "4294967296");
+    /* not a message, not text either: the bytes as they are */
+    CHECK_EQ(value(&t, "grpc.6"), "\x01\xff");
+    /* text, even though it would also decode as the field 5 */
+    CHECK_EQ(value(&t, "grpc.7"), "(a");
+}
+
+
+/* The body gives the same arguments, whatever the pieces it comes in. */
+INTERNAL_TEST(grpc_messages_share_the_names_of_their_fields) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules;
+    CHECK(rules.load("SecRuleEngine On\n") >= 0);
+
+    std::string body = frame(delimited(1, number(2, 1)))
+        + frame(delimited(1, number(2, 2))) + frame("");
+
+    for (size_t size = 1; size <= body.size(); size++) {
+        modsecurity::Transaction t(&msc, &rules, NULL);
+        CHECK_EQ(decode(&t, body, size), "");
+        CHECK_EQ(t.m_variableArgs.size(), 2);
+        CHECK(values(&t, "grpc.1.2") == std::vector<std::string>({"1", "2"}));
+    }
+}
+
+
+INTERNAL_TEST(grpc_groups_are_decoded_as_messages) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules;
+    CHECK(rules.load("SecRuleEngine On\n") >= 0);
+
+    {
+        modsecurity::Transaction t(&msc, &rules, NULL);
+        std::string message = group(1, number(2, 7)
+            + group(3, delimited(4, "x"))) + number(5, 1);
+
+        CHECK_EQ(decode(&t, frame(message)), "");
+        CHECK_EQ(t.m_variableArgs.size(), 3);
+        CHECK_EQ(value(&t, "grpc.1.2"), "7");
+        CHECK_EQ(value(&t, "grpc.1.3.4"), "x");
+        CHECK_EQ(value(&t, "grpc.5"), "1");
+    }
+
+    const std::string malformed[] = {
+        /* ended by another group */
+        tag(1, StartGroup) + number(2, 7) + tag(3, EndGroup),
+        /* never ended */
+        tag(1, StartGroup) + number(2, 7),
+        /* ended without having been started */
+        number(2, 7) + tag(1, EndGroup),
+    };
+    for (const std::string &m : malformed) {
+        modsecurity::Transaction t(&msc, &rules, NULL);
+        CHECK_EQ(decode(&t, frame(m)),
+            "message 1 is not a valid protobuf message");
+        CHECK_EQ(t.m_variableArgs.size(), 0);
+    }
+}
+
+
+INTERNAL_TEST(grpc_truncated_input_is_an_error) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules;
+    CHECK(rules.load("SecRuleEngine On\n") >= 0);
+
+    const std::string malformed[] = {
+        /* a varint of which the last byte is missing */
+        tag(1, Varint) + "\x96",
+        std::string("\x88"),
+        /* a length past the end of the message */
+        tag(1, LengthDelimited) + varint(5) + "ab",
+        tag(1, LengthDelimited) + "\x85",
+        tag(1, Fixed32) + "\x01\x02",
+        tag(1, Fixed64) + "\x01\x02\x03\x04",
+        /* field 0, and a wire type that does not exist */
+        number(0, 1),
+        varint(1 << 3 | 6) + "\x01",
+    };
+    for (const std::string &m : malformed) {
+        modsecurity::Transaction t(&msc, &rules, NULL);
+        CHECK_EQ(decode(&t, frame(number(1, 1)) + frame(m)),
+            "message 2 is not a valid protobuf message");
+        /* what the message before it had is kept, none of its own */
+        CHECK_EQ(t.m_variableArgs.size(), 1);
+    }
+
+    {
+        modsecurity::Transaction t(&msc, &rules, NULL);
+        std::string body = frame(number(1, 1));
+        CHECK_EQ(decode(&t, body.substr(0, body.size() - 1)),
+            "message 1 is truncated");
+        CHECK_EQ(decode(&t, body.substr(0, 3)), "message 1 is truncated");
+    }
+
+    {
+        modsecurity::Transaction t(&msc, &rules, NULL);
+        CHECK_EQ(decode(&t, std::string("\x02", 1) + big(2, 4)
+            + number(1, 1)), "invalid compressed flag in the prefix of " \
+            "message 1");
+    }
+}
+
+
+INTERNAL_TEST(grpc_compressed_messages_are_inflated) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules;
+    CHECK(rules.load("SecRuleEngine On\n" \
+        "SecRequestBodyLimit 64\n") >= 0);
+
+    std::string message = delimited(1, number(2, 42)) + delimited(3, "abc");
+
+#ifdef WITH_ZLIB
+    {
+        modsecurity::Transaction t(&msc, &rules, NULL);
+        CHECK_EQ(decode(&t, frame(deflated(message), true)
+            + frame(number(4, 1))), "");
+        CHECK_EQ(t.m_variableArgs.size(), 3);
+        CHECK_EQ(value(&t, "grpc.1.2"), "42");
+        CHECK_EQ(value(&t, "grpc.3"), "abc");
+        CHECK_EQ(value(&t, "grpc.4"), "1");
+    }
+
+    {
+        /* no message may inflate past the body limit */
+        modsecurity::Transaction t(&msc, &rules, NULL);
+        CHECK_EQ(decode(&t, frame(deflated(delimited(1,
+            std::string(100, 'a'))), true)),
+            "message 1 inflates past SecRequestBodyLimit");
+        CHECK_EQ(t.m_variableArgs.size(), 0);
+    }
+
+    {
+        modsecurity::Transaction t(&msc, &rules, NULL);
+        std::string broken = deflated(message);
+        broken.resize(broken.size() - 4);
+        CHECK(decode(&t, frame(broken, true)).find(
+            "failed to inflate message 1") == 0);
+        CHECK_EQ(t.m_variableArgs.size(), 0);
+    }
+#else
+    {
+        modsecurity::Transaction t(&msc, &rules, NULL);
+        CHECK(decode(&t, frame(deflated(message), true)).find(
+            "failed to inflate message 1") == 0);
+        CHECK_EQ(t.m_variableArgs.size(), 0);
+    }
+#endif
+}
+
+
+/*
+ * Once SecArgumentsLimit is reached nothing else is decoded, not even
+ * what would be malformed.
+ */
+INTERNAL_TEST(grpc_stops_at_the_arguments_limit) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules;
+    CHECK(rules.load("SecRuleEngine On\n" \
+        "SecArgumentsLimit 3\n") >= 0);
+
+    std::string body = frame(number(1, 1) + delimited(2, number(3, 2)))
+        + frame(number(1, 3) + number(1, 4)) + frame("\xff");
+
+    for (size_t size = 1; size <= body.size(); size++) {
+        modsecurity::Transaction t(&msc, &rules, NULL);
+        CHECK_EQ(decode(&t, body, size), "");
+        CHECK_EQ(t.m_variableArgs.size(), 3);
+        CHECK(values(&t, "grpc.1") == std::vector<std::string>({"1", "3"}));
+        CHECK_EQ(value(&t, "grpc.2.3"), "2");
+    }
+
+    {
+        /* the arguments already there count as well */
+        modsecurity::Transaction t(&msc, &rules, NULL);
+        CHECK(t.addArgument("GET", "a", "1", 0));
+        CHECK(t.addArgument("GET", "b", "2", 0));
+        CHECK_EQ(decode(&t, body), "");
+        CHECK_EQ(t.m_variableArgs.size(), 3);
+        CHECK_EQ(value(&t, "grpc.1"), "1");
+    }
+}
+
+
+/*
+ * Past the recursion limit of the protobuf library a length delimited
+ * field is kept as it is, and a group is an error.
+ */
+INTERNAL_TEST(grpc_depth_is_limited) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules;
+    CHECK(rules.load("SecRuleEngine On\n") >= 0);
+
+    std::string path = "grpc";
+    for (int i = 0; i < 100; i++) {
+        path = path + ".1";
+    }
+
+    {
+        /* the innermost message at the limit */
+        modsecurity::Transaction t(&msc, &rules, NULL);
+        CHECK_EQ(decode(&t, frame(nested(number(1, 5), 99))), "");
+        CHECK_EQ(t.m_variableArgs.size(), 1);
+        CHECK_EQ(value(&t, path), "5");
+    }
+
+    {
+        modsecurity::Transaction t(&msc, &rules, NULL);
+        CHECK_EQ(decode(&t, frame(nested(number(1, 5), 100))), "");
+        CHECK_EQ(t.m_variableArgs.size(), 1);
+        CHECK_EQ(value(&t, path), number(1, 5));
+    }
+
+    {
+        std::string g = number(2, 5);
+        for (int i = 0; i < 99; i++) {
+            g = group(1, g);
+        }
+        modsecurity::Transaction t(&msc, &rules, NULL);
+        CHECK_EQ(decode(&t, frame(g)), "");
+        CHECK_EQ(value(&t, path.substr(0, path.size() - 2) + ".2"), "5");
+
+        modsecurity::Transaction deeper(&msc, &rules, NULL);
+        CHECK_EQ(decode(&deeper, frame(group(1, g))),
+            "message 1 is not a valid protobuf message");
+        CHECK_EQ(deeper.m_variableArgs.size(), 0);
+    }
+}
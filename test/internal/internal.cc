@@ -0,0 +1,101 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "test/internal/internal_test.h"
+
+
+namespace modsecurity_test {
+namespace internal {
+
+
+std::vector<TestCase> &testCases() {
+    static std::vector<TestCase> cases;
+    return cases;
+}
+
+
+}  // namespace internal
+}  // namespace modsecurity_test
+
+
+static std::string baseName(const std::string &path) {
+    size_t pos = path.find_last_of('/');
+    if (pos == std::string::npos) {
+        return path;
+    }
+    return path.substr(pos + 1);
+}
+
+
+void print_help() {
+    std::cout << "Use ./internal_tests /path/to/test/internal/file.cc";
+    std::cout << " [test name]" << std::endl;
+}
+
+
+int main(int argc, char **argv) {
+    using modsecurity_test::internal::TestCase;
+    using modsecurity_test::internal::testCases;
+    bool automake = std::getenv("AUTOMAKE_TESTS") != NULL;
+    int failed = 0;
+    int ran = 0;
+
+    if (argc < 2) {
+        print_help();
+        return 1;
+    }
+
+    std::string file = baseName(argv[1]);
+    for (const TestCase &c : testCases()) {
+        if (baseName(c.file) != file) {
+            continue;
+        }
+        if (argc > 2 && std::string(argv[2]) != c.name) {
+            continue;
+        }
+
+        ran++;
+        std::string error;
+        try {
+            c.fn();
+        } catch (const std::exception &e) {
+            error = e.what();
+        }
+
+        if (automake) {
+            std::cout << ":test-result: ";
+        }
+        if (error.empty()) {
+            std::cout << "PASS " << file << ":" << c.name << std::endl;
+        } else {
+            std::cout << "FAIL " << file << ":" << c.name << " - " << error
+                << std::endl;
+            failed++;
+        }
+    }
+
+    if (ran == 0) {
+        std::cout << "No tests for " << argv[1] << std::endl;
+        return 1;
+    }
+
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,140 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "modsecurity/intervention.h"
+#include "modsecurity/transaction.h"
+
+#ifndef TEST_INTERNAL_INTERNAL_TEST_H_
+#define TEST_INTERNAL_INTERNAL_TEST_H_
+
+/*
+ * Tests of the library internals, or of what the JSON driven regression
+ * tests cannot express (several chunks, threads, reloads...). Each file
+ * registers its tests with INTERNAL_TEST; the internal_tests program runs
+ * the ones of the file it is given.
+ */
+namespace modsecurity_test {
+namespace internal {
+
+
+class TestFailure : public std::runtime_error {
+ public:
+    explicit TestFailure(const std::string &what)
+        : std::runtime_error(what) { }
+};
+
+
+struct TestCase {
+    const char *file;
+    const char *name;
+    void (*fn)();
+};
+
+
+std::vector<TestCase> &testCases();
+
+
+class TestRegistration {
+ public:
+    TestRegistration(const char *file, const char *name, void (*fn)()) {
+        testCases().push_back({file, name, fn});
+    }
+};
+
+
+inline void fail(const char *file, int line, const std::string &what) {
+    std::stringstream ss;
+    ss << file << ":" << line << ": " << what;
+    throw TestFailure(ss.str());
+}
+
+
+}  // namespace internal
+}  // namespace modsecurity_test
+
+
+#define INTERNAL_TEST(name) \
+    static void name(); \
+    static modsecurity_test::internal::TestRegistration \
+        name ## _registration(__FILE__, #name, name); \
+    static void name()
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            modsecurity_test::internal::fail(__FILE__, __LINE__, #cond); \
+        } \
+    } while (0)
+
+#define CHECK_EQ(a, b) \
+    do { \
+        if (!((a) == (b))) { \
+            std::stringstream _ss; \
+            _ss << #a << " == " << #b << " (" << (a) << " != " << (b) \
+                << ")"; \
+            modsecurity_test::internal::fail(__FILE__, __LINE__, _ss.str()); \
+        } \
+    } while (0)
+
+
+namespace modsecurity_test {
+namespace internal {
+
+
+/* The status of the intervention the transaction has, 0 if there is none. */
+inline int statusOf(modsecurity::Transaction *t) {
+    modsecurity::ModSecurityIntervention it;
+    int status = 0;
+
+    modsecurity::intervention::reset(&it);
+    if (modsecurity::msc_intervention(t, &it) != 0) {
+        status = it.status;
+    }
+    modsecurity::intervention::free(&it);
+    return status;
+}
+
+
+inline void writeFile(const std::string &path, const std::string &content) {
+    std::ofstream f(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    f.write(content.data(), content.size());
+}
+
+
+/* A new file under /tmp holding content; the caller removes it. */
+inline std::string tempFile(const std::string &content) {
+    char path[] = "/tmp/modsec-test-XXXXXX";
+    int fd = mkstemp(path);
+    CHECK(fd >= 0);
+    close(fd);
+    writeFile(path, content);
+    return path;
+}
+
+
+}  // namespace internal
+}  // namespace modsecurity_test
+
+
+#endif  // TEST_INTERNAL_INTERNAL_TEST_H_
@@ -0,0 +1,129 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <stdlib.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/transaction.h"
+#include "src/utils/metrics.h"
+#include "test/internal/internal_test.h"
+
+
+namespace {
+
+using modsecurity::Utils::Metrics;
+
+
+/* the value of the sample named series, e.g. name{label="x"}; 0 if none */
+double value(const std::string &text, const std::string &series) {
+    std::istringstream in(text);
+    std::string line;
+
+    while (std::getline(in, line)) {
+        if (line.compare(0, series.size() + 1, series + " ") == 0) {
+            return strtod(line.c_str() + series.size() + 1, NULL);
+        }
+    }
+    return 0;
+}
+
+
+std::string render() {
+    modsecurity::ModSecurity msc;
+    char *c = modsecurity::msc_metrics_render(&msc);
+    std::string text(c);
+    free(c);
+    return text;
+}
+
+}  // namespace
+
+
+INTERNAL_TEST(prometheus_text_format) {
+    Metrics::getInstance().increment(Metrics::TransactionsCounter);
+    std::string text = render();
+    std::istringstream in(text);
+    std::string line;
+
+    CHECK(text.empty() == false);
+    CHECK_EQ(text[text.size() - 1], '\n');
+    while (std::getline(in, line)) {
+        if (line[0] == '#') {
+            /* no OpenMetrics only line, such as # EOF */
+            CHECK(line.compare(0, 7, "# HELP ") == 0
+                || line.compare(0, 7, "# TYPE ") == 0);
+            continue;
+        }
+        size_t space = line.rfind(' ');
+        CHECK(space != std::string::npos);
+        CHECK(line.compare(0, 12, "modsecurity_") == 0);
+        char *end = NULL;
+        strtod(line.c_str() + space + 1, &end);
+        CHECK_EQ(*end, '\0');
+    }
+}
+
+
+INTERNAL_TEST(counts_transactions) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules;
+    CHECK(rules.load("SecRuleEngine On\n") >= 0);
+
+    double before = value(render(), "modsecurity_transactions_total");
+    for (int i = 0; i < 3; i++) {
+        modsecurity::Transaction t(&msc, &rules, NULL);
+    }
+    CHECK_EQ(value(render(), "modsecurity_transactions_total") - before, 3);
+}
+
+
+INTERNAL_TEST(counts_outlive_their_thread) {
+    const int threads = 8;
+    std::string series = "modsecurity_interventions_total{rule_id=\"987654\"}";
+
+    double shed = value(render(), "modsecurity_shadow_shed_total");
+    double interventions = value(render(), series);
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; i++) {
+        workers.emplace_back([]() {
+            for (int j = 0; j < 10; j++) {
+                Metrics::getInstance().increment(Metrics::ShadowShedCounter);
+            }
+            Metrics::getInstance().intervention(987654);
+        });
+    }
+    for (std::thread &t : workers) {
+        t.join();
+    }
+
+    std::string text = render();
+    CHECK_EQ(value(text, "modsecurity_shadow_shed_total") - shed,
+        threads * 10);
+    CHECK_EQ(value(text, series) - interventions, threads);
+
+    /* and keep adding up once retired */
+    std::thread([]() {
+        Metrics::getInstance().increment(Metrics::ShadowShedCounter, 5);
+    }).join();
+    CHECK_EQ(value(render(), "modsecurity_shadow_shed_total") - shed,
+        threads * 10 + 5);
+}
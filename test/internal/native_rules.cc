@@ -0,0 +1,167 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "modsecurity/intervention.h"
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rule_with_operator.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/transaction.h"
+#include "src/native_rules.h"
+#include "test/internal/internal_test.h"
+
+
+using modsecurity_test::internal::writeFile;
+
+
+namespace {
+
+const char kRules[] =
+    "SecRuleEngine On\n" \
+    "SecRule ARGS \"@rx ^a+b$\" " \
+        "\"id:1,phase:1,t:lowercase,deny,status:401\"\n" \
+    "SecRule ARGS \"@contains select\" " \
+        "\"id:2,phase:1,t:urlDecodeUni,t:compressWhitespace,t:lowercase," \
+        "deny,status:402\"\n" \
+    "SecRule ARGS \"@streq admin\" " \
+        "\"id:3,phase:1,t:trim,deny,status:403\"\n" \
+    "SecRule ARGS \"@beginsWith /etc\" " \
+        "\"id:4,phase:1,t:normalisePath,deny,status:404\"\n" \
+    "SecRule ARGS \"@pm evil wicked\" " \
+        "\"id:5,phase:1,t:lowercase,deny,status:405\"\n" \
+    "SecRule ARGS:n \"!@eq 7\" \"id:6,phase:1,t:length,chain,deny," \
+        "status:406\"\n" \
+    "    SecRule ARGS:m \"@gt 10\" \"t:none\"\n";
+
+const char *kQueries[] = {
+    "a=aaB",
+    "a=ab&b=x",
+    "a=SeLeCt",
+    "a=%53elect%20*",
+    "a=+admin+",
+    "a=admins",
+    "a=/tmp/../etc/passwd",
+    "a=/etc",
+    "a=Evil",
+    "a=wickedly",
+    "n=1234567&m=11",
+    "n=1234567&m=9",
+    "n=12&m=11",
+    "a=harmless",
+    "",
+};
+
+
+/* The environment the test suite sets, default otherwise. */
+std::string env(const char *name, const char *def) {
+    const char *v = getenv(name);
+    return v != NULL && *v != '\0' ? v : def;
+}
+
+
+int verdict(modsecurity::ModSecurity *msc, modsecurity::RulesSet *rules,
+    const char *query) {
+    modsecurity::ModSecurityIntervention it;
+    std::string uri = std::string("/?") + query;
+    int status = 0;
+
+    modsecurity::Transaction *t = modsecurity::msc_new_transaction(msc,
+        rules, NULL);
+    modsecurity::msc_process_connection(t, "127.0.0.1", 12345,
+        "127.0.0.1", 80);
+    modsecurity::msc_process_uri(t, uri.c_str(), "GET", "1.1");
+    modsecurity::msc_process_request_headers(t);
+    modsecurity::intervention::reset(&it);
+    if (modsecurity::msc_intervention(t, &it) != 0) {
+        status = it.status;
+    }
+    modsecurity::intervention::free(&it);
+    modsecurity::msc_process_logging(t);
+    modsecurity::msc_transaction_cleanup(t);
+    return status;
+}
+
+}  // namespace
+
+
+/*
+ * rules-check -n writes the module, built here as a connector would,
+ * with the options of the library: the rules give the same verdicts
+ * through it as interpreted.
+ */
+INTERNAL_TEST(native_module_gives_the_interpreted_verdicts) {
+    char dir[] = "/tmp/modsec-native-rules-XXXXXX";
+    CHECK(mkdtemp(dir) != NULL);
+    std::string conf = std::string(dir) + "/rules.conf";
+    std::string source = std::string(dir) + "/rules.cc";
+    std::string module = std::string(dir) + "/rules.so";
+
+    writeFile(conf, kRules);
+    std::string check = env("NATIVE_RULES_CHECK",
+        "../tools/rules-check/modsec-rules-check") + " -n " + source
+        + " " + conf + " > /dev/null";
+    CHECK_EQ(system(check.c_str()), 0);
+    std::string build = env("NATIVE_RULES_CXX",
+        "c++ -std=c++11 -shared -fPIC -I.. -I../headers") + " -O1 "
+        + source + " -o " + module;
+    CHECK_EQ(system(build.c_str()), 0);
+
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet interpreted;
+    modsecurity::RulesSet native;
+
+    CHECK(interpreted.loadFromUri(conf.c_str()) >= 0);
+    CHECK(native.loadFromUri(conf.c_str()) >= 0);
+    CHECK(native.load(("SecRuleNativeModule " + module).c_str()) >= 0);
+
+    /* every link of every chain has a function of the module */
+    int links = 0;
+    int bound = 0;
+    modsecurity::NativeRules::forEachLink(&native,
+        [&](modsecurity::RuleWithOperator *rule, int64_t, int) {
+        links++;
+        if (native.nativeMatch(rule) != nullptr) {
+            bound++;
+        }
+    });
+    CHECK_EQ(links, 7);
+    CHECK_EQ(bound, links);
+
+    for (const char *q : kQueries) {
+        CHECK_EQ(verdict(&msc, &native, q), verdict(&msc, &interpreted, q));
+    }
+    CHECK_EQ(verdict(&msc, &native, "a=aaB"), 401);
+    CHECK_EQ(verdict(&msc, &native, "n=1234567&m=11"), 406);
+    CHECK_EQ(verdict(&msc, &native, "a=harmless"), 0);
+
+    unlink(module.c_str());
+    unlink(source.c_str());
+    unlink(conf.c_str());
+    rmdir(dir);
+}
+
+
+INTERNAL_TEST(what_is_not_a_module_is_refused) {
+    std::string error;
+
+    CHECK(modsecurity::NativeRules::load("/does/not/exist.so", &error)
+        == nullptr);
+    CHECK(error.empty() == false);
+}
@@ -0,0 +1,190 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <poll.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <string>
+
+#include "modsecurity/intervention.h"
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/transaction.h"
+#include "test/internal/internal_test.h"
+
+
+using modsecurity_test::internal::statusOf;
+
+
+namespace {
+
+/*
+ * A script for @inspectFile, the operator that makes a phase one that
+ * may block: it finds something once gate exists.
+ */
+class Script {
+ public:
+    Script() {
+        char dir[] = "/tmp/modsec-non-blocking-XXXXXX";
+        CHECK(mkdtemp(dir) != NULL);
+        m_dir = dir;
+        m_path = m_dir + "/inspect.sh";
+        m_gate = m_dir + "/gate";
+        std::ofstream f(m_path, std::ios::out | std::ios::trunc);
+        f << "#!/bin/sh\n" \
+            "while [ ! -e " << m_gate << " ]; do sleep 0.01; done\n" \
+            "echo 0 found\n";
+        f.close();
+        chmod(m_path.c_str(), 0700);
+    }
+
+    ~Script() {
+        unlink(m_gate.c_str());
+        unlink(m_path.c_str());
+        rmdir(m_dir.c_str());
+    }
+
+    void open() {
+        std::ofstream f(m_gate);
+    }
+
+    std::string rules() const {
+        return "SecRuleEngine On\n" \
+            "SecRule ARGS:a \"@inspectFile " + m_path + "\" " \
+            "\"id:1,phase:1,deny,status:403\"\n";
+    }
+
+ private:
+    std::string m_dir;
+    std::string m_path;
+    std::string m_gate;
+};
+
+
+modsecurity::Transaction *begin(modsecurity::ModSecurity *msc,
+    modsecurity::RulesSet *rules) {
+    modsecurity::Transaction *t = modsecurity::msc_new_transaction(msc,
+        rules, NULL);
+    modsecurity::msc_transaction_set_non_blocking(t, 1);
+    modsecurity::msc_process_connection(t, "127.0.0.1", 12345,
+        "127.0.0.1", 80);
+    modsecurity::msc_process_uri(t, "/?a=x", "GET", "1.1");
+    return t;
+}
+
+
+bool readable(int fd, int timeout) {
+    struct pollfd p;
+    p.fd = fd;
+    p.events = POLLIN;
+    p.revents = 0;
+    return poll(&p, 1, timeout) == 1 && (p.revents & POLLIN);
+}
+
+}  // namespace
+
+
+INTERNAL_TEST(suspended_phase_is_resumed_once_the_fd_is_readable) {
+    Script script;
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules;
+
+    CHECK(rules.load(script.rules().c_str()) >= 0);
+    modsecurity::Transaction *t = begin(&msc, &rules);
+
+    CHECK_EQ(modsecurity::msc_process_request_headers(t), MSC_AGAIN);
+    int fd = modsecurity::msc_transaction_fd(t);
+    CHECK(fd >= 0);
+
+    /* the script waits for the gate: the phase is still going on */
+    CHECK(readable(fd, 50) == false);
+    CHECK_EQ(modsecurity::msc_transaction_resume(t), MSC_AGAIN);
+
+    script.open();
+    CHECK(readable(fd, 10000));
+    CHECK_EQ(modsecurity::msc_transaction_resume(t), 1);
+    CHECK_EQ(statusOf(t), 403);
+
+    /* it is done with: nothing left to read */
+    CHECK(readable(fd, 0) == false);
+    CHECK_EQ(modsecurity::msc_transaction_resume(t), 1);
+
+    modsecurity::msc_transaction_cleanup(t);
+}
+
+
+/*
+ * Once the fd is readable, resume() is done with the transaction: it
+ * may be freed at once, as the async thread no longer touches it.
+ */
+INTERNAL_TEST(resumed_transaction_can_be_freed_at_once) {
+    Script script;
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules;
+
+    CHECK(rules.load(script.rules().c_str()) >= 0);
+    script.open();
+    for (int i = 0; i < 50; i++) {
+        modsecurity::Transaction *t = begin(&msc, &rules);
+        CHECK_EQ(modsecurity::msc_process_request_headers(t), MSC_AGAIN);
+        int ret;
+        while ((ret = modsecurity::msc_transaction_resume(t)) == MSC_AGAIN) {
+            CHECK(readable(modsecurity::msc_transaction_fd(t), 10000));
+        }
+        CHECK_EQ(ret, 1);
+        CHECK_EQ(statusOf(t), 403);
+        modsecurity::msc_transaction_cleanup(t);
+    }
+}
+
+
+INTERNAL_TEST(batch_call_waits_for_the_suspended_phase) {
+    Script script;
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules;
+    modsecurity::msc_header host;
+    modsecurity::msc_request req;
+
+    CHECK(rules.load(script.rules().c_str()) >= 0);
+    script.open();
+
+    host.key = reinterpret_cast<const unsigned char *>("Host");
+    host.key_len = 4;
+    host.value = reinterpret_cast<const unsigned char *>("localhost");
+    host.value_len = 9;
+    req.client_ip = "127.0.0.1";
+    req.client_port = 12345;
+    req.server_ip = "127.0.0.1";
+    req.server_port = 80;
+    req.uri = "/?a=x";
+    req.method = "GET";
+    req.http_version = "1.1";
+    req.headers = &host;
+    req.headers_n = 1;
+    req.body = NULL;
+    req.body_n = 0;
+
+    modsecurity::Transaction *t = modsecurity::msc_new_transaction(&msc,
+        &rules, NULL);
+    modsecurity::msc_transaction_set_non_blocking(t, 1);
+    CHECK_EQ(modsecurity::msc_process_request(t, &req), 1);
+    CHECK_EQ(statusOf(t), 403);
+    CHECK_EQ(modsecurity::msc_transaction_resume(t), 1);
+    modsecurity::msc_transaction_cleanup(t);
+}
+
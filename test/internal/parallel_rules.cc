@@ -0,0 +1,142 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/rule_message.h"
+#include "modsecurity/intervention.h"
+#include "modsecurity/transaction.h"
+#include "modsecurity/collection/collection.h"
+#include "test/internal/internal_test.h"
+
+
+namespace {
+
+/*
+ * Independent rules the pool matches ahead, a chain, a skipAfter over a
+ * rule, setvar on the way and a rule reading what the others set.
+ */
+const char kRules[] =
+    "SecRuleEngine On\n" \
+    "SecRequestBodyAccess On\n" \
+    "SecRequestBodyLimit 1048576\n" \
+    "SecRequestBodyNoFilesLimit 1048576\n" \
+    "SecArgumentsLimit 100000\n" \
+    "SecDefaultAction \"phase:2,log,pass\"\n" \
+    "SecRule ARGS \"@rx (?i)union\\s+select\" " \
+        "\"id:10,setvar:tx.score=+5\"\n" \
+    "SecRule ARGS \"@pm passwd shadow\" \"id:11,setvar:tx.score=+3\"\n" \
+    "SecRule ARGS_NAMES \"@rx ^cmd$\" \"id:12,chain,setvar:tx.score=+2\"\n" \
+    "    SecRule ARGS:cmd \"@contains /bin/sh\" \"\"\n" \
+    "SecRule ARGS \"@rx never-there\" \"id:13,setvar:tx.score=+100\"\n" \
+    "SecRule REQUEST_BODY \"@contains filler\" " \
+        "\"id:14,skipAfter:END_CHECKS\"\n" \
+    "SecRule ARGS \"@rx .\" \"id:15,setvar:tx.score=+1000\"\n" \
+    "SecMarker END_CHECKS\n" \
+    "SecRule ARGS \"@detectXSS\" \"id:16,setvar:tx.score=+7\"\n" \
+    "SecRule TX:score \"@ge 10\" \"id:17,deny,status:403\"\n";
+
+
+struct Verdict {
+    int status;
+    std::string score;
+    std::vector<int64_t> messages;
+};
+
+
+std::string body(const std::string &attack) {
+    std::string b;
+    int i = 0;
+
+    while (b.size() < 96 * 1024) {
+        b += "f" + std::to_string(i++) + "=filler+" + std::string(64, 'x')
+            + "&";
+    }
+    return b + attack;
+}
+
+
+Verdict evaluate(modsecurity::RulesSet *rules, const std::string &b) {
+    modsecurity::ModSecurity msc;
+    modsecurity::ModSecurityIntervention it;
+    modsecurity::intervention::reset(&it);
+    Verdict v;
+
+    modsecurity::Transaction t(&msc, rules, NULL);
+    t.processConnection("127.0.0.1", 12345, "127.0.0.1", 80);
+    t.processURI("/login", "POST", "1.1");
+    t.addRequestHeader("Host", "localhost");
+    t.addRequestHeader("Content-Type",
+        "application/x-www-form-urlencoded");
+    t.addRequestHeader("Content-Length", std::to_string(b.size()));
+    t.processRequestHeaders();
+    t.appendRequestBody(reinterpret_cast<const unsigned char *>(b.c_str()),
+        b.size());
+    CHECK(t.m_requestBody.size()
+        >= modsecurity::RulesSet::kParallelMinBodySize);
+    t.processRequestBody();
+
+    v.status = t.intervention(&it) ? it.status : 200;
+    modsecurity::intervention::free(&it);
+    std::unique_ptr<std::string> score =
+        t.m_collections.m_tx_collection->resolveFirst("score");
+    v.score = score ? *score : "";
+    for (const modsecurity::RuleMessage &m : t.m_rulesMessages) {
+        v.messages.push_back(m.m_ruleId);
+    }
+    return v;
+}
+
+
+void same(const std::string &b, int status) {
+    modsecurity::RulesSet serial;
+    modsecurity::RulesSet parallel;
+    CHECK(serial.load(kRules) > 0);
+    CHECK(parallel.load((std::string(kRules) +
+        "SecRuleEvaluationThreads 4\n").c_str()) > 0);
+
+    Verdict s = evaluate(&serial, b);
+    Verdict p = evaluate(&parallel, b);
+
+    CHECK_EQ(s.status, status);
+    CHECK_EQ(p.status, s.status);
+    CHECK_EQ(p.score, s.score);
+    CHECK(p.messages == s.messages);
+}
+
+}  // namespace
+
+
+INTERNAL_TEST(clean_body) {
+    same(body("name=alice"), 200);
+}
+
+
+INTERNAL_TEST(attack_at_the_end_of_the_body) {
+    /* 5 + 3 + 7 */
+    same(body("q=1+UNION+SELECT+passwd+from+users&" \
+        "r=%3Cscript%3Ealert(1)%3C/script%3E"), 403);
+}
+
+
+INTERNAL_TEST(chain_and_xss_under_the_threshold) {
+    /* 2 + 7 */
+    same(body("cmd=%2Fbin%2Fsh+-c+id&c=%3Cscript%3Ealert(1)%3C/script%3E"),
+        200);
+}
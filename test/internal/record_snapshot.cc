@@ -0,0 +1,204 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "modsecurity/intervention.h"
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/transaction.h"
+#include "modsecurity/variable_value.h"
+#include "src/collection/backend/in_memory-sharded.h"
+#include "src/collection/backend/record_snapshot.h"
+#include "src/variables/variable.h"
+#include "test/internal/internal_test.h"
+
+
+using modsecurity::VariableValue;
+using modsecurity::collection::backend::InMemorySharded;
+using modsecurity::collection::backend::RecordSnapshot;
+
+
+namespace {
+
+typedef std::vector<std::pair<std::string, std::string>> Entries;
+
+
+/*
+ * The in-memory collection, with the read of a whole record LMDB and
+ * Redis have: initcol takes a snapshot of it.
+ */
+class Backend : public InMemorySharded {
+ public:
+    explicit Backend(const std::string &name)
+        : InMemorySharded(name), m_reads(0) { }
+
+    bool resolveRecord(const std::string &compartment,
+        const std::string &compartment2, Entries *entries) override {
+        std::vector<const VariableValue *> l;
+        modsecurity::variables::KeyExclusions ke;
+        size_t prefix = compartment.size() + compartment2.size() + 4;
+
+        m_reads++;
+        resolveMultiMatches("", compartment, compartment2, &l, ke);
+        for (const VariableValue *v : l) {
+            entries->emplace_back(v->getKey().substr(prefix), v->getValue());
+            delete v;
+        }
+        return true;
+    }
+
+    std::string valueOf(const std::string &key,
+        const std::string &compartment, const std::string &compartment2) {
+        std::unique_ptr<std::string> v = resolveFirst(key, compartment,
+            compartment2);
+        return v == nullptr ? "(none)" : *v;
+    }
+
+    std::atomic<int> m_reads;
+};
+
+}  // namespace
+
+
+INTERNAL_TEST(snapshot_serves_the_record_and_defers_the_writes) {
+    Backend b("IP");
+    Entries entries;
+    int result = 0;
+
+    b.store("hits", "rec", "app", "5");
+    b.store("name", "rec", "app", "x");
+    b.store("gone", "rec", "app", "1");
+    CHECK(b.resolveRecord("rec", "app", &entries));
+    RecordSnapshot s(&b, "rec", "app", &entries);
+
+    CHECK(s.atomicAdd("rec::app::hits", 1, &result));
+    CHECK_EQ(result, 6);
+    s.store("rec::app::name", "y");
+    s.del("rec::app::gone");
+    /* set, then incremented: the value is known, it is stored */
+    s.store("rec::app::new", "1");
+    CHECK(s.atomicAdd("rec::app::new", 2, &result));
+    CHECK_EQ(result, 3);
+
+    CHECK_EQ(*s.resolveFirst("rec::app::hits"), "6");
+    CHECK_EQ(*s.resolveFirst("rec::app::name"), "y");
+    CHECK(s.resolveFirst("rec::app::gone") == nullptr);
+
+    /* nothing is written before the flush */
+    CHECK_EQ(b.valueOf("hits", "rec", "app"), "5");
+    CHECK_EQ(b.valueOf("name", "rec", "app"), "x");
+    CHECK_EQ(b.valueOf("gone", "rec", "app"), "1");
+    CHECK_EQ(b.valueOf("new", "rec", "app"), "(none)");
+
+    /* but for the keys of other records, which are not in the copy */
+    s.store("other::app::k", "1");
+    CHECK(b.resolveFirst("other::app::k") != nullptr);
+
+    /* another transaction increments it meanwhile */
+    b.atomicAdd("hits", "rec", "app", 10, nullptr);
+
+    s.flush();
+    CHECK_EQ(b.valueOf("hits", "rec", "app"), "16");
+    CHECK_EQ(b.valueOf("name", "rec", "app"), "y");
+    CHECK_EQ(b.valueOf("gone", "rec", "app"), "(none)");
+    CHECK_EQ(b.valueOf("new", "rec", "app"), "3");
+
+    /* what was flushed is not written again */
+    s.flush();
+    CHECK_EQ(b.valueOf("hits", "rec", "app"), "16");
+    CHECK_EQ(b.m_reads.load(), 1);
+}
+
+
+INTERNAL_TEST(increments_of_concurrent_snapshots_add_up) {
+    const int kThreads = 8;
+    const int kTransactions = 500;
+    Backend b("IP");
+    std::vector<std::thread> threads;
+
+    b.store("hits", "rec", "app", "0");
+    for (int i = 0; i < kThreads; i++) {
+        threads.push_back(std::thread([&b]() {
+            for (int j = 0; j < kTransactions; j++) {
+                Entries entries;
+                b.resolveRecord("rec", "app", &entries);
+                RecordSnapshot s(&b, "rec", "app", &entries);
+                s.atomicAdd("rec::app::hits", 1, nullptr);
+                s.atomicAdd("rec::app::hits", 2, nullptr);
+                s.flush();
+            }
+        }));
+    }
+    for (std::thread &t : threads) {
+        t.join();
+    }
+
+    CHECK_EQ(b.valueOf("hits", "rec", "app"),
+        std::to_string(kThreads * kTransactions * 3));
+}
+
+
+/*
+ * initcol reads the record once; the rules see the copy, the backend the
+ * changes once the logging phase is over.
+ */
+INTERNAL_TEST(initcol_snapshot_is_flushed_at_logging) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules;
+    modsecurity::ModSecurityIntervention it;
+
+    delete msc.m_ip_collection;
+    Backend *ip = new Backend("IP");
+    msc.m_ip_collection = ip;
+
+    CHECK(rules.load("SecRuleEngine On\n" \
+        "SecAction \"id:1,phase:1,pass,nolog,initcol:ip=snap," \
+        "setvar:ip.hits=+1\"\n" \
+        "SecRule IP:hits \"@eq 6\" \"id:2,phase:2,deny,status:406\"\n")
+        >= 0);
+    const std::string &app = rules.m_secWebAppId.m_value;
+    ip->store("hits", "snap", app, "5");
+
+    modsecurity::Transaction *t = modsecurity::msc_new_transaction(&msc,
+        &rules, NULL);
+    modsecurity::msc_process_connection(t, "127.0.0.1", 12345,
+        "127.0.0.1", 80);
+    modsecurity::msc_process_uri(t, "/", "GET", "1.1");
+    modsecurity::msc_process_request_headers(t);
+    CHECK_EQ(ip->m_reads.load(), 1);
+    CHECK_EQ(ip->valueOf("hits", "snap", app), "5");
+
+    /* another host, or transaction, increments it meanwhile */
+    ip->atomicAdd("hits", "snap", app, 10, nullptr);
+
+    modsecurity::msc_process_request_body(t);
+    modsecurity::intervention::reset(&it);
+    CHECK(modsecurity::msc_intervention(t, &it) != 0);
+    CHECK_EQ(it.status, 406);
+    modsecurity::intervention::free(&it);
+    CHECK_EQ(ip->m_reads.load(), 1);
+    CHECK_EQ(ip->valueOf("hits", "snap", app), "15");
+
+    modsecurity::msc_process_logging(t);
+    CHECK_EQ(ip->valueOf("hits", "snap", app), "16");
+    modsecurity::msc_transaction_cleanup(t);
+    CHECK_EQ(ip->valueOf("hits", "snap", app), "16");
+}
@@ -0,0 +1,242 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "src/collection/backend/redis_protocol.h"
+#include "test/internal/internal_test.h"
+
+
+using modsecurity::collection::backend::redis::Command;
+using modsecurity::collection::backend::redis::Fields;
+using modsecurity::collection::backend::redis::Reply;
+using modsecurity::collection::backend::redis::ReplyParser;
+
+
+namespace {
+
+/* The input as a socket would give it, chunk bytes at a time. */
+class Chunks : public ReplyParser {
+ public:
+    Chunks(const std::string &data, size_t chunk)
+        : m_data(data), m_chunk(chunk), m_at(0) { }
+
+ protected:
+    bool fill(std::string *in) override {
+        if (m_at >= m_data.size()) {
+            return false;
+        }
+        size_t n = std::min(m_chunk, m_data.size() - m_at);
+        in->append(m_data, m_at, n);
+        m_at += n;
+        return true;
+    }
+
+ private:
+    std::string m_data;
+    size_t m_chunk;
+    size_t m_at;
+};
+
+
+const char kReplies[] =
+    "+OK\r\n"
+    "-ERR wrong type\r\n"
+    ":-42\r\n"
+    "$-1\r\n"
+    "$7\r\na\r\nb\r\nc\r\n"
+    "*-1\r\n"
+    "*4\r\n$4\r\nhits\r\n$2\r\n10\r\n$5\r\nblock\r\n$0\r\n\r\n"
+    "*2\r\n*1\r\n:1\r\n+x\r\n";
+
+
+void checkReplies(ReplyParser *p) {
+    Reply r;
+
+    CHECK(p->reply(&r));
+    CHECK_EQ(r.m_type, '+');
+    CHECK_EQ(r.m_string, "OK");
+
+    r = Reply();
+    CHECK(p->reply(&r));
+    CHECK_EQ(r.m_type, '-');
+    CHECK_EQ(r.m_string, "ERR wrong type");
+
+    r = Reply();
+    CHECK(p->reply(&r));
+    CHECK_EQ(r.m_type, ':');
+    CHECK_EQ(r.m_integer, -42);
+
+    r = Reply();
+    CHECK(p->reply(&r));
+    CHECK_EQ(r.m_type, 0);
+
+    r = Reply();
+    CHECK(p->reply(&r));
+    CHECK_EQ(r.m_type, '$');
+    CHECK_EQ(r.m_string, "a\r\nb\r\nc");
+
+    r = Reply();
+    CHECK(p->reply(&r));
+    CHECK_EQ(r.m_type, 0);
+
+    r = Reply();
+    CHECK(p->reply(&r));
+    CHECK_EQ(r.m_type, '*');
+    CHECK_EQ(r.m_elements.size(), 4);
+    CHECK_EQ(r.m_elements[0].m_string, "hits");
+    CHECK_EQ(r.m_elements[1].m_string, "10");
+    CHECK_EQ(r.m_elements[2].m_string, "block");
+    CHECK_EQ(r.m_elements[3].m_type, '$');
+    CHECK(r.m_elements[3].m_string.empty());
+
+    r = Reply();
+    CHECK(p->reply(&r));
+    CHECK_EQ(r.m_elements.size(), 2);
+    CHECK_EQ(r.m_elements[0].m_elements.size(), 1);
+    CHECK_EQ(r.m_elements[0].m_elements[0].m_integer, 1);
+    CHECK_EQ(r.m_elements[1].m_string, "x");
+
+    /* the input is over */
+    CHECK(p->reply(&r) == false);
+}
+
+
+bool parses(const std::string &data) {
+    Chunks p(data, data.size());
+    Reply r;
+    return p.reply(&r);
+}
+
+}  // namespace
+
+
+INTERNAL_TEST(parses_replies_in_one_piece) {
+    Chunks p(std::string(kReplies, sizeof(kReplies) - 1),
+        sizeof(kReplies));
+    checkReplies(&p);
+}
+
+
+INTERNAL_TEST(parses_replies_a_byte_at_a_time) {
+    Chunks p(std::string(kReplies, sizeof(kReplies) - 1), 1);
+    checkReplies(&p);
+}
+
+
+INTERNAL_TEST(parses_replies_split_anywhere) {
+    for (size_t chunk = 2; chunk < 16; chunk++) {
+        Chunks p(std::string(kReplies, sizeof(kReplies) - 1), chunk);
+        checkReplies(&p);
+    }
+}
+
+
+INTERNAL_TEST(rejects_what_is_not_resp) {
+    CHECK(parses("") == false);
+    CHECK(parses("\r\n") == false);
+    CHECK(parses("?what\r\n") == false);
+    CHECK(parses(":12x\r\n") == false);
+    CHECK(parses(":\r\n") == false);
+    CHECK(parses("$x\r\n") == false);
+    CHECK(parses("*x\r\n") == false);
+    /* the terminator is not where the length says */
+    CHECK(parses("$3\r\nabcd\r\n") == false);
+}
+
+
+INTERNAL_TEST(rejects_truncated_replies) {
+    CHECK(parses("+OK") == false);
+    CHECK(parses("+OK\r") == false);
+    CHECK(parses("$5\r\nabc") == false);
+    CHECK(parses("$3\r\nabc") == false);
+    CHECK(parses("*2\r\n:1\r\n") == false);
+}
+
+
+INTERNAL_TEST(rejects_replies_past_the_bounds) {
+    CHECK(parses("$16777217\r\n") == false);
+    CHECK(parses("*1048577\r\n") == false);
+    CHECK(parses("*1\r\n*1\r\n:1\r\n"));
+    CHECK(parses("*1\r\n*1\r\n*1\r\n:1\r\n") == false);
+}
+
+
+INTERNAL_TEST(encodes_commands_as_bulk_strings) {
+    std::vector<Command> commands;
+    std::string out;
+
+    commands.push_back({"HSET", "modsec:IP:1.2.3.4", "a b", ""});
+    commands.push_back({"HGETALL", "k"});
+    modsecurity::collection::backend::redis::encode(commands, &out);
+
+    CHECK_EQ(out, "*4\r\n$4\r\nHSET\r\n$17\r\nmodsec:IP:1.2.3.4\r\n" \
+        "$3\r\na b\r\n$0\r\n\r\n*2\r\n$7\r\nHGETALL\r\n$1\r\nk\r\n");
+}
+
+
+/*
+ * A fetch that went out before the writes: what the server has stands
+ * but for the fields written locally since, which stay as they are here.
+ */
+INTERNAL_TEST(fetched_record_keeps_the_pending_writes) {
+    Fields fetched;
+    Fields local;
+    std::unordered_map<std::string, unsigned int> pending;
+
+    fetched["hits"] = "10";
+    fetched["block"] = "1";
+    fetched["score"] = "5";
+    fetched["other"] = "x";
+
+    local["hits"] = "3";
+    local["score"] = "7";
+    local["new"] = "1";
+
+    pending["score"] = 2;
+    pending["new"] = 1;
+    /* deleted locally */
+    pending["block"] = 1;
+
+    modsecurity::collection::backend::redis::merge(&fetched, local,
+        pending);
+
+    CHECK_EQ(fetched.size(), 4);
+    CHECK_EQ(fetched["hits"], "10");
+    CHECK_EQ(fetched["score"], "7");
+    CHECK_EQ(fetched["new"], "1");
+    CHECK_EQ(fetched["other"], "x");
+    CHECK(fetched.count("block") == 0);
+}
+
+
+INTERNAL_TEST(fetched_record_with_nothing_pending_is_taken_whole) {
+    Fields fetched;
+    Fields local;
+    std::unordered_map<std::string, unsigned int> pending;
+
+    fetched["hits"] = "10";
+    local["hits"] = "3";
+    local["gone"] = "1";
+
+    modsecurity::collection::backend::redis::merge(&fetched, local,
+        pending);
+
+    CHECK_EQ(fetched.size(), 1);
+    CHECK_EQ(fetched["hits"], "10");
+}
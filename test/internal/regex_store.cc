@@ -0,0 +1,176 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+#include "src/utils/regex.h"
+#include "src/utils/regex_store.h"
+#include "test/internal/internal_test.h"
+
+
+using modsecurity::Utils::Regex;
+using modsecurity::Utils::RegexStore;
+using modsecurity_test::internal::writeFile;
+
+
+namespace {
+
+class TempDir {
+ public:
+    TempDir() {
+        char dir[] = "/tmp/modsec-regex-store-XXXXXX";
+        m_dir = mkdtemp(dir);
+    }
+    ~TempDir() {
+        unlink((m_dir + "/a.cache").c_str());
+        unlink((m_dir + "/b.cache").c_str());
+        rmdir(m_dir.c_str());
+    }
+    std::string path(const std::string &name) const {
+        return m_dir + "/" + name;
+    }
+
+ private:
+    std::string m_dir;
+};
+
+
+#if WITH_PCRE2
+std::string readFile(const std::string &path) {
+    std::ifstream f(path, std::ios::in | std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(f)),
+        std::istreambuf_iterator<char>());
+}
+
+
+/* compiles the patterns through a store opened on path, then saves it */
+void fill(const std::string &path, const char *patterns[], size_t count,
+    size_t *hits) {
+    RegexStore store;
+    std::string error;
+
+    CHECK(store.open(path, &error));
+    for (size_t i = 0; i < count; i++) {
+        Regex re(patterns[i], false, &store);
+        CHECK(re.hasError() == false);
+    }
+    CHECK(store.save(&error));
+    *hits = store.hits();
+}
+#endif
+
+}  // namespace
+
+
+#if WITH_PCRE2
+INTERNAL_TEST(decoded_on_the_next_open) {
+    TempDir dir;
+    const char *patterns[] = { "^a+b$", "(?:select|union)\\s", "x{2,}" };
+    size_t hits = 0;
+
+    fill(dir.path("a.cache"), patterns, 3, &hits);
+    CHECK_EQ(hits, 0);
+    fill(dir.path("a.cache"), patterns, 3, &hits);
+    CHECK_EQ(hits, 3);
+
+    /* what was decoded matches as what was compiled */
+    RegexStore store;
+    std::string error;
+    CHECK(store.open(dir.path("a.cache"), &error));
+    Regex decoded("^a+b$", false, &store);
+    Regex compiled("^a+b$", false);
+    CHECK_EQ(store.hits(), 1);
+    CHECK_EQ(decoded.searchAll("aaab").size(),
+        compiled.searchAll("aaab").size());
+    CHECK(decoded.searchAll("aaac").empty());
+}
+
+
+INTERNAL_TEST(damaged_file_is_ignored) {
+    TempDir dir;
+    const char *patterns[] = { "^a+b$", "x{2,}" };
+    size_t hits = 0;
+
+    fill(dir.path("a.cache"), patterns, 2, &hits);
+    std::string data = readFile(dir.path("a.cache"));
+    CHECK(data.size() > 64);
+
+    /* a byte of the compiled code */
+    data[data.size() - 8] ^= 0x5a;
+    writeFile(dir.path("a.cache"), data);
+    fill(dir.path("a.cache"), patterns, 2, &hits);
+    CHECK_EQ(hits, 0);
+
+    /* and rewritten whole by the save of that very load */
+    fill(dir.path("a.cache"), patterns, 2, &hits);
+    CHECK_EQ(hits, 2);
+
+    /* cut short */
+    data = readFile(dir.path("a.cache"));
+    writeFile(dir.path("a.cache"), data.substr(0, data.size() / 2));
+    fill(dir.path("a.cache"), patterns, 2, &hits);
+    CHECK_EQ(hits, 0);
+
+    /* another format version */
+    data = readFile(dir.path("a.cache"));
+    data[6] = '1';
+    writeFile(dir.path("a.cache"), data);
+    fill(dir.path("a.cache"), patterns, 2, &hits);
+    CHECK_EQ(hits, 0);
+}
+
+
+INTERNAL_TEST(rules_sets_keep_their_own_files) {
+    TempDir dir;
+    std::string a("SecRegexCacheFile " + dir.path("a.cache") + "\n" \
+        "SecRule ARGS \"@rx ^only-in-a$\" \"id:1,phase:1,pass\"\n" \
+        "SecRule ARGS \"@rx ^in-both$\" \"id:2,phase:1,pass\"\n");
+    std::string b("SecRegexCacheFile " + dir.path("b.cache") + "\n" \
+        "SecRule ARGS \"@rx ^in-both$\" \"id:2,phase:1,pass\"\n");
+
+    modsecurity::RulesSet first;
+    modsecurity::RulesSet second;
+    CHECK(first.load(a.c_str()) > 0);
+    CHECK(second.load(b.c_str()) > 0);
+
+    std::string fileA = readFile(dir.path("a.cache"));
+    std::string fileB = readFile(dir.path("b.cache"));
+    CHECK(fileA.find("only-in-a") != std::string::npos);
+    CHECK(fileA.find("in-both") != std::string::npos);
+    CHECK(fileB.find("only-in-a") == std::string::npos);
+    /* already compiled for the first rules set, kept in the file anyway */
+    CHECK(fileB.find("in-both") != std::string::npos);
+}
+#else
+INTERNAL_TEST(nothing_cached_without_pcre2) {
+    TempDir dir;
+    RegexStore store;
+    std::string error;
+
+    CHECK(store.open(dir.path("a.cache"), &error));
+    CHECK(store.isOpen() == false);
+    Regex re("^a+b$", false, &store);
+    CHECK(store.save(&error));
+    CHECK(access(dir.path("a.cache").c_str(), F_OK) != 0);
+}
+#endif
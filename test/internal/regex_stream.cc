@@ -0,0 +1,197 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "modsecurity/body_buffer.h"
+#include "modsecurity/intervention.h"
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/transaction.h"
+#include "src/utils/regex.h"
+#include "src/utils/regex_stream.h"
+#include "test/internal/internal_test.h"
+
+
+using modsecurity::Utils::Regex;
+using modsecurity::Utils::RegexStream;
+using modsecurity::Utils::RegexStreams;
+
+
+namespace {
+
+RegexStream::State stream(const Regex *regex,
+    const std::vector<std::string> &parts, size_t *offset, size_t *length) {
+    RegexStream s(regex);
+
+    for (const std::string &part : parts) {
+        s.feed(part.data(), part.size());
+    }
+    s.finish();
+    if (s.state() == RegexStream::Matched) {
+        *offset = s.captures().at(0).m_offset;
+        *length = s.captures().at(0).m_length;
+    }
+    return s.state();
+}
+
+
+/*
+ * Appends body to a transaction in parts of the given size and returns
+ * the status of the intervention phase 2 ends with, 0 for none.
+ */
+int request(modsecurity::RulesSet *rules, const std::string &body,
+    size_t part) {
+    modsecurity::ModSecurity msc;
+    modsecurity::ModSecurityIntervention it;
+    int status = 0;
+
+    modsecurity::Transaction *t = modsecurity::msc_new_transaction(&msc,
+        rules, NULL);
+    modsecurity::msc_process_connection(t, "127.0.0.1", 12345,
+        "127.0.0.1", 80);
+    modsecurity::msc_process_uri(t, "/", "POST", "1.1");
+    modsecurity::msc_add_request_header(t,
+        reinterpret_cast<const unsigned char *>("Content-Type"),
+        reinterpret_cast<const unsigned char *>("text/plain"));
+    modsecurity::msc_process_request_headers(t);
+    for (size_t offset = 0; offset < body.size(); offset += part) {
+        modsecurity::msc_append_request_body(t,
+            reinterpret_cast<const unsigned char *>(body.data()) + offset,
+            std::min(part, body.size() - offset));
+    }
+    modsecurity::msc_process_request_body(t);
+
+    modsecurity::intervention::reset(&it);
+    if (modsecurity::msc_intervention(t, &it) != 0) {
+        status = it.status;
+    }
+    modsecurity::intervention::free(&it);
+    modsecurity::msc_process_logging(t);
+    modsecurity::msc_transaction_cleanup(t);
+    return status;
+}
+
+
+void load(modsecurity::RulesSet *rules, const std::string &pattern) {
+    std::string conf("SecRuleEngine On\n" \
+        "SecRequestBodyAccess On\n" \
+        "SecRule REQUEST_BODY \"@rx " + pattern + "\" " \
+        "\"id:1,phase:2,deny,status:403\"\n");
+    CHECK(rules->load(conf.c_str()) >= 0);
+}
+
+}  // namespace
+
+
+INTERNAL_TEST(match_split_over_parts) {
+    Regex regex("foo[0-9]+bar");
+    size_t offset = 0;
+    size_t length = 0;
+
+    CHECK_EQ(stream(&regex, {"xxfo", "o12", "3b", "arzz"}, &offset,
+        &length), RegexStream::Matched);
+    CHECK_EQ(offset, 2);
+    CHECK_EQ(length, 9);
+}
+
+
+INTERNAL_TEST(lookbehind_over_parts) {
+    Regex regex("(?<=ab)cd");
+    size_t offset = 0;
+    size_t length = 0;
+
+    CHECK_EQ(stream(&regex, {"a", "b", "c", "d"}, &offset, &length),
+        RegexStream::Matched);
+    CHECK_EQ(offset, 2);
+    CHECK_EQ(length, 2);
+    CHECK_EQ(stream(&regex, {"x", "b", "c", "d"}, &offset, &length),
+        RegexStream::NotMatched);
+}
+
+
+INTERNAL_TEST(anchored_to_the_start_of_the_subject) {
+    Regex regex("^abc");
+    size_t offset = 0;
+    size_t length = 0;
+
+    /* the start of a later part is not the start of the subject */
+    CHECK_EQ(stream(&regex, {"xyz", "abc"}, &offset, &length),
+        RegexStream::NotMatched);
+    CHECK_EQ(stream(&regex, {"a", "bc"}, &offset, &length),
+        RegexStream::Matched);
+}
+
+
+INTERNAL_TEST(partial_match_kept_too_long_is_abandoned) {
+    Regex regex("a.*z");
+    RegexStream s(&regex);
+    std::string part(4096, 'a');
+
+    for (size_t i = 0; i * part.size() <= RegexStream::kMaxKept; i++) {
+        s.feed(part.data(), part.size());
+    }
+    CHECK_EQ(s.state(), RegexStream::Abandoned);
+
+    /* it has nothing more to say, the body is matched as a whole */
+    s.feed("z", 1);
+    s.finish();
+    CHECK_EQ(s.state(), RegexStream::Abandoned);
+}
+
+
+INTERNAL_TEST(streams_only_answer_for_their_subject) {
+    Regex regex("foo");
+    std::vector<const Regex *> regexes(1, &regex);
+    modsecurity::BodyBuffer body;
+
+    body.append("a foo", 5);
+    RegexStreams streams(regexes, &body);
+    streams.feed("a foo", 5, 0);
+    CHECK(streams.find(&regex, "a foo") == nullptr);
+    streams.finish(0);
+
+    const RegexStream *s = streams.find(&regex, "a foo");
+    CHECK(s != nullptr);
+    CHECK_EQ(s->state(), RegexStream::Matched);
+    CHECK(streams.find(&regex, "a foo and more") == nullptr);
+}
+
+
+INTERNAL_TEST(request_body_appended_in_parts) {
+    modsecurity::RulesSet rules;
+    std::string body(1000, 'x');
+
+    load(&rules, "secret[0-9]{4}word");
+    body.replace(500, 14, "secret1234word");
+
+    for (size_t part : {1, 3, 7, 500, 1000}) {
+        CHECK_EQ(request(&rules, body, part), 403);
+    }
+    CHECK_EQ(request(&rules, std::string(1000, 'x'), 7), 0);
+}
+
+
+INTERNAL_TEST(request_body_abandoned_stream) {
+    modsecurity::RulesSet rules;
+    std::string body(RegexStream::kMaxKept * 2, 'a');
+
+    /* the partial match outgrows kMaxKept, phase 2 matches the body */
+    load(&rules, "a.*z");
+    CHECK_EQ(request(&rules, body + "z", 4096), 403);
+    CHECK_EQ(request(&rules, body, 4096), 0);
+}
@@ -0,0 +1,123 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <memory>
+#include <string>
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/transaction.h"
+#include "modsecurity/intervention.h"
+#include "src/utils/reloader.h"
+#include "test/internal/internal_test.h"
+
+
+using modsecurity_test::internal::tempFile;
+using modsecurity_test::internal::writeFile;
+
+
+namespace {
+
+struct Counted {
+    explicit Counted(int *alive) : m_alive(alive) { (*m_alive)++; }
+    ~Counted() { (*m_alive)--; }
+    int *m_alive;
+};
+
+
+int status(modsecurity::Transaction *t) {
+    modsecurity::ModSecurityIntervention it;
+    modsecurity::intervention::reset(&it);
+    t->intervention(&it);
+    modsecurity::intervention::free(&it);
+    return it.status;
+}
+
+
+void begin(modsecurity::Transaction *t, const char *client) {
+    t->processConnection(client, 12345, "127.0.0.1", 80);
+    t->processURI("/", "GET", "1.1");
+    t->addRequestHeader("Host", "localhost");
+    t->processRequestHeaders();
+}
+
+
+int verdict(modsecurity::ModSecurity *msc, modsecurity::RulesSet *rules,
+    const char *client) {
+    modsecurity::Transaction t(msc, rules, NULL);
+    begin(&t, client);
+    t.processRequestBody();
+    return status(&t);
+}
+
+}  // namespace
+
+
+INTERNAL_TEST(versioned_keeps_what_readers_hold) {
+    int alive = 0;
+    modsecurity::Utils::Versioned<Counted> v;
+
+    CHECK(v.get() == nullptr);
+    v.publish(new Counted(&alive));
+    std::shared_ptr<Counted> held = v.get();
+
+    /* replaced twice while held */
+    v.publish(new Counted(&alive));
+    v.publish(new Counted(&alive));
+    CHECK_EQ(alive, 2);
+    CHECK(held->m_alive == &alive);
+    CHECK(v.get() != held);
+
+    held.reset();
+    CHECK_EQ(alive, 1);
+}
+
+
+INTERNAL_TEST(reload_with_a_transaction_in_flight) {
+    std::string path = tempFile("10.0.0.1\n");
+
+    std::string rules("SecRuleEngine On\n" \
+        "SecDataReloadInterval 1\n" \
+        "SecRule REMOTE_ADDR \"@ipMatchFromFile ");
+    rules.append(path);
+    rules.append("\" \"id:1,phase:2,deny,status:403\"\n");
+
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules_set;
+    CHECK(rules_set.load(rules.c_str()) > 0);
+
+    /* the first evaluation starts the reloader */
+    CHECK_EQ(verdict(&msc, &rules_set, "10.0.0.1"), 403);
+
+    modsecurity::Transaction inFlight(&msc, &rules_set, NULL);
+    begin(&inFlight, "10.0.0.2");
+
+    writeFile(path, "10.0.0.2\n10.0.0.3\n");
+    int seconds = 0;
+    while (verdict(&msc, &rules_set, "10.0.0.3") != 403 && seconds < 10) {
+        sleep(1);
+        seconds++;
+    }
+    unlink(path.c_str());
+    CHECK(seconds < 10);
+    CHECK_EQ(verdict(&msc, &rules_set, "10.0.0.1"), 200);
+
+    /* started before the reload, evaluated after it */
+    inFlight.processRequestBody();
+    CHECK_EQ(status(&inFlight), 403);
+}
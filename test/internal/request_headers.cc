@@ -0,0 +1,171 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/intervention.h"
+#include "modsecurity/transaction.h"
+#include "modsecurity/variable_value.h"
+#include "test/internal/internal_test.h"
+
+
+namespace {
+
+const char kRules[] =
+    "SecRuleEngine On\n" \
+    "SecRule REQUEST_HEADERS:X-Test \"@streq evil\" " \
+        "\"id:1,phase:1,deny,status:403\"\n" \
+    "SecRule REQUEST_HEADERS_NAMES \"@streq X-Other\" " \
+        "\"id:2,phase:1,pass,nolog\"\n";
+
+/*
+ * Keys and values are slices of one buffer, none of them NULL
+ * terminated, the way a connector hands its own header list over.
+ */
+const char kBuffer[] = "HostlocalhostX-TestgoodX-Testevil" \
+    "X-Otheron";
+
+typedef std::vector<std::pair<std::string, std::string>> Headers;
+
+
+std::vector<modsecurity::msc_header> headers() {
+    const unsigned char *b = reinterpret_cast<const unsigned char *>(kBuffer);
+    std::vector<modsecurity::msc_header> h(4);
+
+    h[0] = {b, 4, b + 4, 9};
+    h[1] = {b + 13, 6, b + 19, 4};
+    h[2] = {b + 23, 6, b + 29, 4};
+    h[3] = {b + 33, 7, b + 40, 2};
+    return h;
+}
+
+
+struct Result {
+    Headers headers;
+    Headers names;
+    int status;
+};
+
+
+Result collect(modsecurity::Transaction *t) {
+    modsecurity::ModSecurityIntervention it;
+    modsecurity::intervention::reset(&it);
+    std::vector<const modsecurity::VariableValue *> l;
+    Result r;
+
+    modsecurity::msc_process_request_headers(t);
+    r.status = modsecurity::msc_intervention(t, &it) ? it.status : 200;
+    modsecurity::intervention::free(&it);
+
+    t->m_variableRequestHeaders.resolve(&l);
+    for (const modsecurity::VariableValue *v : l) {
+        r.headers.emplace_back(v->getKey(), v->getValue());
+        delete v;
+    }
+    l.clear();
+    t->m_variableRequestHeadersNames.resolve(&l);
+    for (const modsecurity::VariableValue *v : l) {
+        r.names.emplace_back(v->getKey(), v->getValue());
+        delete v;
+    }
+    /* the collections do not keep the order the headers came in */
+    std::sort(r.headers.begin(), r.headers.end());
+    std::sort(r.names.begin(), r.names.end());
+    return r;
+}
+
+
+modsecurity::Transaction *start(modsecurity::ModSecurity *msc,
+    modsecurity::RulesSet *rules) {
+    modsecurity::Transaction *t = modsecurity::msc_new_transaction(msc,
+        rules, NULL);
+    modsecurity::msc_process_connection(t, "127.0.0.1", 12345,
+        "127.0.0.1", 80);
+    modsecurity::msc_process_uri(t, "/", "GET", "1.1");
+    return t;
+}
+
+}  // namespace
+
+
+INTERNAL_TEST(same_as_one_at_a_time) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules;
+    CHECK(rules.load(kRules) > 0);
+    std::vector<modsecurity::msc_header> h = headers();
+
+    modsecurity::Transaction *one = start(&msc, &rules);
+    for (const modsecurity::msc_header &i : h) {
+        CHECK_EQ(modsecurity::msc_add_n_request_header(one, i.key,
+            i.key_len, i.value, i.value_len), 1);
+    }
+    Result expected = collect(one);
+    modsecurity::msc_transaction_cleanup(one);
+
+    modsecurity::Transaction *all = start(&msc, &rules);
+    CHECK_EQ(modsecurity::msc_add_request_headers(all, h.data(), h.size()),
+        1);
+    Result got = collect(all);
+    modsecurity::msc_transaction_cleanup(all);
+
+    CHECK_EQ(expected.headers.size(), 4);
+    CHECK(got.headers == expected.headers);
+    CHECK(got.names == expected.names);
+    CHECK_EQ(got.status, expected.status);
+}
+
+
+INTERNAL_TEST(keeps_the_duplicates) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules;
+    CHECK(rules.load(kRules) > 0);
+    std::vector<modsecurity::msc_header> h = headers();
+
+    modsecurity::Transaction *t = start(&msc, &rules);
+    CHECK_EQ(modsecurity::msc_add_request_headers(t, h.data(), h.size()),
+        1);
+    Result r = collect(t);
+    modsecurity::msc_transaction_cleanup(t);
+
+    Headers want = {
+        {"Host", "localhost"},
+        {"X-Other", "on"},
+        {"X-Test", "evil"},
+        {"X-Test", "good"},
+    };
+    CHECK(r.headers == want);
+    /* the second X-Test is the one that matches */
+    CHECK_EQ(r.status, 403);
+}
+
+
+INTERNAL_TEST(none) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules;
+    CHECK(rules.load(kRules) > 0);
+
+    modsecurity::Transaction *t = start(&msc, &rules);
+    CHECK_EQ(modsecurity::msc_add_request_headers(t, NULL, 0), 1);
+    Result r = collect(t);
+    modsecurity::msc_transaction_cleanup(t);
+
+    CHECK(r.headers.empty());
+    CHECK_EQ(r.status, 200);
+}
@@ -0,0 +1,136 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <string>
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/intervention.h"
+#include "modsecurity/transaction.h"
+#include "test/internal/internal_test.h"
+
+
+namespace {
+
+const char kBody[] = "<html><body>secret</body></html>";
+
+
+/*
+ * Feeds a small HTML response through a transaction and returns what
+ * msc_get_response_body hands back to the connector.
+ */
+std::string respond(modsecurity::RulesSet *rules, bool *disrupted) {
+    modsecurity::ModSecurity msc;
+    modsecurity::ModSecurityIntervention it;
+    modsecurity::intervention::reset(&it);
+
+    modsecurity::Transaction *t = modsecurity::msc_new_transaction(&msc,
+        rules, NULL);
+    modsecurity::msc_process_connection(t, "127.0.0.1", 12345,
+        "127.0.0.1", 80);
+    modsecurity::msc_process_uri(t, "/", "GET", "1.1");
+    modsecurity::msc_add_request_header(t,
+        reinterpret_cast<const unsigned char *>("Host"),
+        reinterpret_cast<const unsigned char *>("localhost"));
+    modsecurity::msc_process_request_headers(t);
+    modsecurity::msc_process_request_body(t);
+    modsecurity::msc_add_response_header(t,
+        reinterpret_cast<const unsigned char *>("Content-Type"),
+        reinterpret_cast<const unsigned char *>("text/html"));
+    modsecurity::msc_process_response_headers(t, 200, "HTTP 1.1");
+    modsecurity::msc_append_response_body(t,
+        reinterpret_cast<const unsigned char *>(kBody), sizeof(kBody) - 1);
+    modsecurity::msc_process_response_body(t);
+
+    *disrupted = modsecurity::msc_intervention(t, &it) != 0;
+    modsecurity::intervention::free(&it);
+
+    std::string body(modsecurity::msc_get_response_body(t),
+        modsecurity::msc_get_response_body_length(t));
+    modsecurity::msc_process_logging(t);
+    modsecurity::msc_transaction_cleanup(t);
+    return body;
+}
+
+
+void load(modsecurity::RulesSet *rules, const std::string &extra) {
+    std::string conf = "SecRuleEngine On\n" \
+        "SecResponseBodyAccess On\n" \
+        "SecResponseBodyMimeType text/html\n" + extra;
+    CHECK(rules->load(conf.c_str()) >= 0);
+}
+
+}  // namespace
+
+
+INTERNAL_TEST(dropped_when_no_rule_reads_it) {
+    modsecurity::RulesSet rules;
+    load(&rules,
+        "SecRule REQUEST_HEADERS:Host \"@rx ^evil\" \"id:1,phase:1,deny\"\n");
+
+    CHECK(rules.needsResponseBody() == false);
+    CHECK_EQ(modsecurity::msc_rules_needs_response_body(&rules), 0);
+
+    bool disrupted = false;
+    CHECK(respond(&rules, &disrupted).empty());
+    CHECK(disrupted == false);
+}
+
+
+INTERNAL_TEST(kept_when_a_rule_reads_it) {
+    modsecurity::RulesSet rules;
+    load(&rules,
+        "SecRule RESPONSE_BODY \"@contains secret\" \"id:1,phase:4,deny\"\n");
+
+    CHECK(rules.needsResponseBody());
+    CHECK_EQ(modsecurity::msc_rules_needs_response_body(&rules), 1);
+
+    bool disrupted = false;
+    CHECK_EQ(respond(&rules, &disrupted), std::string(kBody));
+    CHECK(disrupted);
+}
+
+
+INTERNAL_TEST(kept_for_the_audit_log) {
+    modsecurity::RulesSet rules;
+    load(&rules,
+        "SecAuditEngine On\n" \
+        "SecAuditLogParts ABEZ\n" \
+        "SecAuditLog /dev/null\n");
+
+    CHECK(rules.needsResponseBody());
+
+    bool disrupted = false;
+    CHECK_EQ(respond(&rules, &disrupted), std::string(kBody));
+}
+
+
+INTERNAL_TEST(kept_when_the_limit_rejects) {
+    modsecurity::RulesSet rules;
+    load(&rules, "SecResponseBodyLimitAction Reject\n");
+
+    CHECK(rules.needsResponseBody());
+}
+
+
+INTERNAL_TEST(never_without_body_access) {
+    modsecurity::RulesSet rules;
+    CHECK(rules.load("SecRuleEngine On\n" \
+        "SecResponseBodyAccess Off\n" \
+        "SecRule RESPONSE_BODY \"@contains secret\" " \
+            "\"id:1,phase:4,deny\"\n") >= 0);
+
+    CHECK(rules.needsResponseBody() == false);
+}
@@ -0,0 +1,132 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <string>
+#include <vector>
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/intervention.h"
+#include "modsecurity/transaction.h"
+#include "test/internal/internal_test.h"
+
+
+namespace {
+
+void load(modsecurity::RulesSet *rules) {
+    CHECK(rules->load("SecRuleEngine On\n" \
+        "SecResponseBodyAccess On\n" \
+        "SecResponseBodyMimeType text/html\n" \
+        "SecResponseBodyStreamWindow 16\n" \
+        "SecRule RESPONSE_BODY \"@contains secretword\" " \
+        "\"id:1,phase:4,deny,status:403\"\n") >= 0);
+}
+
+
+/*
+ * Appends the chunks one by one, as a connector streaming the response
+ * would, and returns the index of the chunk after which an intervention
+ * was given, -1 if none.
+ */
+int stream(modsecurity::RulesSet *rules,
+    const std::vector<std::string> &chunks, int *status) {
+    modsecurity::ModSecurity msc;
+    modsecurity::ModSecurityIntervention it;
+    int at = -1;
+
+    modsecurity::Transaction *t = modsecurity::msc_new_transaction(&msc,
+        rules, NULL);
+    modsecurity::msc_process_connection(t, "127.0.0.1", 12345,
+        "127.0.0.1", 80);
+    modsecurity::msc_process_uri(t, "/", "GET", "1.1");
+    modsecurity::msc_process_request_headers(t);
+    modsecurity::msc_process_request_body(t);
+    modsecurity::msc_add_response_header(t,
+        reinterpret_cast<const unsigned char *>("Content-Type"),
+        reinterpret_cast<const unsigned char *>("text/html"));
+    modsecurity::msc_process_response_headers(t, 200, "HTTP 1.1");
+
+    for (size_t i = 0; i < chunks.size() && at < 0; i++) {
+        modsecurity::msc_append_response_body(t,
+            reinterpret_cast<const unsigned char *>(chunks[i].c_str()),
+            chunks[i].size());
+        modsecurity::intervention::reset(&it);
+        if (modsecurity::msc_intervention(t, &it) != 0) {
+            at = i;
+            *status = it.status;
+        }
+        modsecurity::intervention::free(&it);
+    }
+    if (at < 0) {
+        modsecurity::msc_process_response_body(t);
+        modsecurity::intervention::reset(&it);
+        if (modsecurity::msc_intervention(t, &it) != 0) {
+            at = chunks.size();
+            *status = it.status;
+        }
+        modsecurity::intervention::free(&it);
+    }
+
+    modsecurity::msc_process_logging(t);
+    modsecurity::msc_transaction_cleanup(t);
+    return at;
+}
+
+}  // namespace
+
+
+INTERNAL_TEST(match_straddling_two_chunks) {
+    modsecurity::RulesSet rules;
+    std::vector<std::string> chunks;
+    int status = 0;
+
+    load(&rules);
+    chunks.push_back(std::string(100, 'a') + "secr");
+    chunks.push_back("etword" + std::string(100, 'b'));
+    chunks.push_back(std::string(100, 'c'));
+
+    CHECK_EQ(stream(&rules, chunks, &status), 1);
+    CHECK_EQ(status, 403);
+}
+
+
+INTERNAL_TEST(match_straddling_three_chunks) {
+    modsecurity::RulesSet rules;
+    std::vector<std::string> chunks;
+    int status = 0;
+
+    load(&rules);
+    chunks.push_back(std::string(100, 'a') + "sec");
+    chunks.push_back("ret");
+    chunks.push_back("word" + std::string(100, 'b'));
+
+    CHECK_EQ(stream(&rules, chunks, &status), 2);
+    CHECK_EQ(status, 403);
+}
+
+
+INTERNAL_TEST(no_match_over_the_chunks) {
+    modsecurity::RulesSet rules;
+    std::vector<std::string> chunks;
+    int status = 0;
+
+    load(&rules);
+    /* both halves are there, too far apart to be one match */
+    chunks.push_back("secret" + std::string(100, 'a'));
+    chunks.push_back(std::string(100, 'b') + "word");
+
+    CHECK_EQ(stream(&rules, chunks, &status), -1);
+    CHECK_EQ(status, 0);
+}
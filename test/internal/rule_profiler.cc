@@ -0,0 +1,154 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <stdlib.h>
+
+#include <memory>
+#include <string>
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/intervention.h"
+#include "modsecurity/transaction.h"
+#include "test/internal/internal_test.h"
+
+
+namespace {
+
+const char kRules[] =
+    "SecRuleEngine On\n" \
+    "SecRuleProfiling On\n" \
+    "SecRule ARGS:a \"@streq x\" \"id:1,phase:1,pass,nolog\"\n" \
+    "SecRule ARGS \"@rx never\" \"id:2,phase:1,pass,nolog\"\n";
+
+
+modsecurity::Transaction *start(modsecurity::ModSecurity *msc,
+    modsecurity::RulesSet *rules, const char *uri) {
+    modsecurity::Transaction *t = new modsecurity::Transaction(msc, rules,
+        NULL);
+    t->processConnection("127.0.0.1", 12345, "127.0.0.1", 80);
+    t->processURI(uri, "GET", "1.1");
+    t->addRequestHeader("Host", "localhost");
+    return t;
+}
+
+
+void run(modsecurity::ModSecurity *msc, modsecurity::RulesSet *rules,
+    const char *uri) {
+    std::unique_ptr<modsecurity::Transaction> t(start(msc, rules, uri));
+    t->processRequestHeaders();
+}
+
+
+bool contains(const std::string &s, const std::string &what) {
+    return s.find(what) != std::string::npos;
+}
+
+}  // namespace
+
+
+INTERNAL_TEST(off_by_default) {
+    modsecurity::RulesSet rules;
+    CHECK(rules.load("SecRule ARGS \"@rx x\" \"id:1,phase:1,pass\"\n") > 0);
+
+    CHECK(rules.profileDump().empty());
+    char *dump = modsecurity::msc_rules_profile_dump(&rules);
+    CHECK_EQ(std::string(dump), std::string());
+    free(dump);
+}
+
+
+INTERNAL_TEST(counts_every_rule) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules;
+    CHECK(rules.load(kRules) > 0);
+
+    run(&msc, &rules, "/?a=x");
+    run(&msc, &rules, "/?a=x&b=y&c=z");
+    run(&msc, &rules, "/?a=y");
+
+    std::string dump = rules.profileDump();
+    CHECK(contains(dump, "Rule profile: 3 transaction(s) sampled, one out " \
+        "of 1.\n"));
+    CHECK(contains(dump, "Rule 1 ("));
+    CHECK(contains(dump, ", @streq): 3 invocations, 2 matches"));
+    CHECK(contains(dump, ", @rx): 3 invocations, 0 matches"));
+    /* ARGS had 1, 3 and 1 values */
+    CHECK(contains(dump, "values 0:0 1:2 2-3:1 4-7:0 8-15:0 16+:0"));
+
+    char *c = modsecurity::msc_rules_profile_dump(&rules);
+    CHECK_EQ(std::string(c), dump);
+    free(c);
+}
+
+
+INTERNAL_TEST(one_out_of_the_sample_rate) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules;
+    CHECK(rules.load((std::string(kRules) +
+        "SecRuleProfilingSampleRate 2\n").c_str()) > 0);
+
+    for (int i = 0; i < 4; i++) {
+        run(&msc, &rules, "/?a=x");
+    }
+
+    std::string dump = rules.profileDump();
+    CHECK(contains(dump, "Rule profile: 2 transaction(s) sampled, one out " \
+        "of 2.\n"));
+    CHECK(contains(dump, ", @streq): 2 invocations, 2 matches"));
+}
+
+
+INTERNAL_TEST(merge_while_a_transaction_is_sampled) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules;
+    CHECK(rules.load(kRules) > 0);
+
+    std::unique_ptr<modsecurity::Transaction> t(start(&msc, &rules,
+        "/?a=x"));
+    /* replaces the profiler t was sampled by */
+    CHECK(rules.load("SecRule ARGS \"@rx other\" " \
+        "\"id:3,phase:1,pass,nolog\"\n") > 0);
+    t->processRequestHeaders();
+    t.reset();
+
+    std::string dump = rules.profileDump();
+    CHECK(contains(dump, "Rule profile: 0 transaction(s) sampled"));
+    CHECK(contains(dump, "invocations") == false);
+
+    run(&msc, &rules, "/?a=x");
+    dump = rules.profileDump();
+    CHECK(contains(dump, "Rule profile: 1 transaction(s) sampled"));
+    CHECK(contains(dump, "Rule 3 ("));
+}
+
+
+INTERNAL_TEST(rule_sets_on_the_same_thread) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet first;
+    modsecurity::RulesSet second;
+    CHECK(first.load(kRules) > 0);
+    CHECK(second.load(kRules) > 0);
+
+    for (int i = 0; i < 3; i++) {
+        run(&msc, &first, "/?a=x");
+        run(&msc, &second, "/?a=y");
+    }
+
+    CHECK(contains(first.profileDump(), ", @streq): 3 invocations, " \
+        "3 matches"));
+    CHECK(contains(second.profileDump(), ", @streq): 3 invocations, " \
+        "0 matches"));
+}
@@ -0,0 +1,213 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "modsecurity/intervention.h"
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_handle.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/transaction.h"
+#include "test/internal/internal_test.h"
+
+
+using modsecurity_test::internal::statusOf;
+using modsecurity_test::internal::tempFile;
+
+
+namespace {
+
+const char kDeny401[] = "SecRuleEngine On\n" \
+    "SecRule ARGS \"@contains attack\" " \
+    "\"id:1,phase:1,deny,status:401,log,msg:'attack'\"\n";
+
+const char kDeny402[] = "SecRuleEngine On\n" \
+    "SecRule ARGS \"@contains attack\" " \
+    "\"id:1,phase:1,deny,status:402,log,msg:'attack'\"\n";
+
+
+modsecurity::RulesSet *loaded(const char *rules) {
+    modsecurity::RulesSet *r = new modsecurity::RulesSet();
+    CHECK(r->load(rules) >= 0);
+    return r;
+}
+
+
+modsecurity::Transaction *begin(modsecurity::ModSecurity *msc,
+    modsecurity::RulesHandle *handle, void *data) {
+    modsecurity::Transaction *t =
+        modsecurity::msc_new_transaction_from_handle(msc, handle, data);
+    modsecurity::msc_process_connection(t, "127.0.0.1", 12345,
+        "127.0.0.1", 80);
+    modsecurity::msc_process_uri(t, "/?a=attack", "GET", "1.1");
+    modsecurity::msc_process_request_headers(t);
+    return t;
+}
+
+
+void end(modsecurity::Transaction *t) {
+    modsecurity::msc_process_logging(t);
+    modsecurity::msc_transaction_cleanup(t);
+}
+
+
+int verdict(modsecurity::ModSecurity *msc,
+    modsecurity::RulesHandle *handle) {
+    modsecurity::Transaction *t = begin(msc, handle, NULL);
+    int status = statusOf(t);
+    end(t);
+    return status;
+}
+
+
+/* Held until released, so that the messages stay queued. */
+std::atomic<bool> released(false);
+std::atomic<int> delivered(0);
+
+
+void blockingLogCb(void *, const void *) {
+    while (released.load() == false) {
+        usleep(1000);
+    }
+    delivered++;
+}
+
+}  // namespace
+
+
+INTERNAL_TEST(swap_keeps_transactions_in_flight_on_their_version) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesHandle *handle = modsecurity::msc_create_rules_handle(
+        &msc, loaded(kDeny401));
+    std::weak_ptr<modsecurity::RulesSet> first(handle->current());
+
+    CHECK_EQ(modsecurity::msc_rules_handle_version(handle), 1);
+    modsecurity::Transaction *t = begin(&msc, handle, NULL);
+
+    CHECK_EQ(modsecurity::msc_rules_handle_swap(handle, loaded(kDeny402)),
+        2);
+    CHECK(first.expired() == false);
+    CHECK_EQ(verdict(&msc, handle), 402);
+
+    /* the one that started before the swap still runs the first version */
+    CHECK_EQ(statusOf(t), 401);
+    end(t);
+    CHECK(first.expired());
+}
+
+
+INTERNAL_TEST(reload_installs_a_new_version) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesHandle *handle = modsecurity::msc_create_rules_handle(
+        &msc, loaded(kDeny401));
+    std::string path = tempFile(kDeny402);
+    const char *error = NULL;
+
+    /* no reload yet */
+    CHECK_EQ(modsecurity::msc_rules_handle_wait(handle, &error), 0);
+
+    CHECK_EQ(modsecurity::msc_rules_handle_reload_file(handle,
+        path.c_str()), 0);
+    CHECK_EQ(modsecurity::msc_rules_handle_wait(handle, &error), 1);
+    CHECK(error == NULL);
+    CHECK_EQ(modsecurity::msc_rules_handle_version(handle), 2);
+    CHECK_EQ(verdict(&msc, handle), 402);
+
+    unlink(path.c_str());
+}
+
+
+INTERNAL_TEST(failed_reload_keeps_the_current_version) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesHandle *handle = modsecurity::msc_create_rules_handle(
+        &msc, loaded(kDeny401));
+    std::string path = tempFile("SecRule ARGS \"@nosuchop x\" \"id:1\"\n");
+    const char *error = NULL;
+
+    CHECK_EQ(modsecurity::msc_rules_handle_reload_file(handle,
+        path.c_str()), 0);
+    CHECK_EQ(modsecurity::msc_rules_handle_wait(handle, &error), -1);
+    CHECK(error != NULL && error[0] != '\0');
+    free(const_cast<char *>(error));
+
+    /* the error may be of no interest */
+    CHECK_EQ(modsecurity::msc_rules_handle_reload_file(handle,
+        path.c_str()), 0);
+    CHECK_EQ(modsecurity::msc_rules_handle_wait(handle, NULL), -1);
+
+    CHECK_EQ(modsecurity::msc_rules_handle_version(handle), 1);
+    CHECK_EQ(verdict(&msc, handle), 401);
+
+    unlink(path.c_str());
+}
+
+
+/*
+ * A reload that is over does not have to be waited for before the next
+ * one; only one that still runs is refused.
+ */
+INTERNAL_TEST(reload_after_a_finished_reload_is_accepted) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesHandle *handle = modsecurity::msc_create_rules_handle(
+        &msc, loaded(kDeny401));
+    std::string path = tempFile(kDeny402);
+    int started = -1;
+
+    CHECK_EQ(modsecurity::msc_rules_handle_reload_file(handle,
+        path.c_str()), 0);
+    for (int i = 0; i < 10000 && started != 0; i++) {
+        started = modsecurity::msc_rules_handle_reload_file(handle,
+            path.c_str());
+        if (started != 0) {
+            usleep(1000);
+        }
+    }
+    CHECK_EQ(started, 0);
+    CHECK_EQ(modsecurity::msc_rules_handle_wait(handle, NULL), 1);
+    CHECK_EQ(modsecurity::msc_rules_handle_version(handle), 3);
+
+    unlink(path.c_str());
+}
+
+
+/*
+ * The messages queued for the log callback point to the rules of their
+ * transaction: the version is only freed once they were delivered.
+ */
+INTERNAL_TEST(queued_messages_keep_their_version) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesHandle *handle = modsecurity::msc_create_rules_handle(
+        &msc, loaded(kDeny401));
+    std::weak_ptr<modsecurity::RulesSet> first(handle->current());
+
+    released = false;
+    delivered = 0;
+    msc.setServerLogCb(blockingLogCb, modsecurity::TextLogProperty
+        | modsecurity::AsyncLogProperty);
+
+    end(begin(&msc, handle, NULL));
+    modsecurity::msc_rules_handle_swap(handle, loaded(kDeny402));
+    CHECK(first.expired() == false);
+
+    released = true;
+    modsecurity::msc_drain_server_log(&msc);
+    CHECK(delivered.load() > 0);
+    CHECK(first.expired());
+}
@@ -0,0 +1,132 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <memory>
+#include <string>
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/intervention.h"
+#include "modsecurity/transaction.h"
+#include "test/internal/internal_test.h"
+
+
+namespace {
+
+const char kBase[] =
+    "SecRuleEngine On\n" \
+    "SecRule ARGS:a \"@streq base\" \"id:1,phase:1,deny,status:403\"\n";
+
+
+int status(modsecurity::RulesSet *rules, const std::string &uri) {
+    modsecurity::ModSecurity msc;
+    modsecurity::ModSecurityIntervention it;
+    modsecurity::intervention::reset(&it);
+
+    modsecurity::Transaction t(&msc, rules, NULL);
+    t.processConnection("127.0.0.1", 12345, "127.0.0.1", 80);
+    t.processURI(uri.c_str(), "GET", "1.1");
+    t.addRequestHeader("Host", "localhost");
+    t.processRequestHeaders();
+
+    int ret = 200;
+    if (t.intervention(&it)) {
+        ret = it.status;
+    }
+    modsecurity::intervention::free(&it);
+    return ret;
+}
+
+
+void overlay(modsecurity::RulesSet *rules, modsecurity::RulesSet *base,
+    const std::string &conf) {
+    const char *error = NULL;
+    CHECK_EQ(modsecurity::msc_rules_set_base(rules, base, &error), 0);
+    CHECK(rules->load(conf.c_str()) >= 0);
+}
+
+}  // namespace
+
+
+INTERNAL_TEST(base_rules_apply_to_the_overlay) {
+    std::shared_ptr<modsecurity::RulesSet> base(new modsecurity::RulesSet());
+    CHECK(base->load(kBase) > 0);
+    modsecurity::RulesSet rules;
+    CHECK_EQ(rules.setBase(base), 0);
+    CHECK(rules.load("SecRule ARGS:a \"@streq overlay\" " \
+        "\"id:2,phase:1,deny,status:406\"\n") > 0);
+
+    CHECK_EQ(status(&rules, "/?a=base"), 403);
+    CHECK_EQ(status(&rules, "/?a=overlay"), 406);
+    CHECK_EQ(status(&rules, "/?a=other"), 200);
+    /* the base itself is not changed by its overlay */
+    CHECK_EQ(status(base.get(), "/?a=overlay"), 200);
+}
+
+
+INTERNAL_TEST(base_ids_can_not_be_reused) {
+    std::shared_ptr<modsecurity::RulesSet> base(new modsecurity::RulesSet());
+    CHECK(base->load(kBase) > 0);
+    modsecurity::RulesSet rules;
+    CHECK_EQ(rules.setBase(base), 0);
+
+    CHECK(rules.load("SecRule ARGS:a \"@streq again\" " \
+        "\"id:1,phase:1,deny\"\n") < 0);
+}
+
+
+INTERNAL_TEST(base_ids_can_be_removed) {
+    std::shared_ptr<modsecurity::RulesSet> base(new modsecurity::RulesSet());
+    CHECK(base->load(kBase) > 0);
+    modsecurity::RulesSet rules;
+    CHECK_EQ(rules.setBase(base), 0);
+    CHECK(rules.load("SecRuleRemoveById 1\n") >= 0);
+
+    CHECK_EQ(status(&rules, "/?a=base"), 200);
+    CHECK_EQ(status(base.get(), "/?a=base"), 403);
+}
+
+
+INTERNAL_TEST(overlay_keeps_the_base) {
+    modsecurity::RulesSet *base = modsecurity::msc_create_rules_set();
+    const char *error = NULL;
+    CHECK(modsecurity::msc_rules_add(base, kBase, &error) > 0);
+
+    modsecurity::RulesSet *first = modsecurity::msc_create_rules_set();
+    modsecurity::RulesSet *second = modsecurity::msc_create_rules_set();
+    overlay(first, base, "");
+    overlay(second, base, "SecRuleRemoveById 1\n");
+
+    /* the connector is done with the base, the overlays still use it */
+    modsecurity::msc_rules_cleanup(base);
+    CHECK(first->getBase() != NULL);
+    CHECK_EQ(status(first, "/?a=base"), 403);
+    CHECK_EQ(status(second, "/?a=base"), 200);
+
+    modsecurity::msc_rules_cleanup(first);
+    CHECK_EQ(status(second, "/?a=base"), 200);
+    modsecurity::msc_rules_cleanup(second);
+}
+
+
+INTERNAL_TEST(overlay_of_an_overlay_is_refused) {
+    std::shared_ptr<modsecurity::RulesSet> base(new modsecurity::RulesSet());
+    CHECK(base->load(kBase) > 0);
+    std::shared_ptr<modsecurity::RulesSet> middle(new modsecurity::RulesSet());
+    CHECK_EQ(middle->setBase(base), 0);
+
+    modsecurity::RulesSet rules;
+    CHECK(rules.setBase(middle) < 0);
+}
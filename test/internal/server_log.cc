@@ -0,0 +1,179 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <unistd.h>
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/transaction.h"
+#include "test/internal/internal_test.h"
+
+
+namespace {
+
+/* what the connector would keep per request */
+struct Request {
+    int id;
+    int logged;
+};
+
+std::mutex lock;
+modsecurity::ModSecurity *drainFromCallback = NULL;
+
+
+/*
+ * A slow callback, so that messages are still queued when the request
+ * is done with them.
+ */
+void logCb(void *data, const void *msg) {
+    usleep(1000);
+    if (drainFromCallback) {
+        /* has to return at once instead of waiting for itself */
+        modsecurity::msc_drain_server_log(drainFromCallback);
+    }
+    Request *r = static_cast<Request *>(data);
+    std::string text(static_cast<const char *>(msg));
+    std::lock_guard<std::mutex> guard(lock);
+    if (text.find("attack") != std::string::npos) {
+        r->logged++;
+    }
+}
+
+
+std::vector<std::string> texts;
+
+
+/* As slow, keeps what it is given. */
+void textCb(void *data, const void *msg) {
+    usleep(1000);
+    std::lock_guard<std::mutex> guard(lock);
+    texts.push_back(static_cast<const char *>(msg));
+}
+
+
+void request(modsecurity::ModSecurity *msc, modsecurity::RulesSet *rules,
+    Request *r) {
+    modsecurity::Transaction *t = modsecurity::msc_new_transaction(msc,
+        rules, r);
+    modsecurity::msc_process_connection(t, "127.0.0.1", 12345,
+        "127.0.0.1", 80);
+    modsecurity::msc_process_uri(t, "/?a=attack", "GET", "1.1");
+    modsecurity::msc_process_request_headers(t);
+    modsecurity::msc_process_logging(t);
+    modsecurity::msc_transaction_cleanup(t);
+}
+
+
+void load(modsecurity::RulesSet *rules) {
+    CHECK(rules->load("SecRuleEngine On\n" \
+        "SecRule ARGS \"@contains attack\" " \
+        "\"id:1,phase:1,pass,log,msg:'attack one'\"\n" \
+        "SecRule ARGS \"@contains attack\" " \
+        "\"id:2,phase:1,pass,log,msg:'attack two'\"\n") >= 0);
+}
+
+}  // namespace
+
+
+INTERNAL_TEST(drain_delivers_everything_queued) {
+    const int kRequests = 20;
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules;
+    Request reqs[kRequests];
+
+    load(&rules);
+    msc.setServerLogCb(logCb, modsecurity::TextLogProperty
+        | modsecurity::AsyncLogProperty);
+
+    for (int i = 0; i < kRequests; i++) {
+        reqs[i].id = i;
+        reqs[i].logged = 0;
+        request(&msc, &rules, &reqs[i]);
+    }
+
+    /* the connector may free reqs after this */
+    modsecurity::msc_drain_server_log(&msc);
+
+    std::lock_guard<std::mutex> guard(lock);
+    for (int i = 0; i < kRequests; i++) {
+        CHECK_EQ(reqs[i].logged, 2);
+    }
+}
+
+
+INTERNAL_TEST(drain_from_the_callback_returns) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules;
+    Request r = { 0, 0 };
+
+    load(&rules);
+    msc.setServerLogCb(logCb, modsecurity::TextLogProperty
+        | modsecurity::AsyncLogProperty);
+    drainFromCallback = &msc;
+
+    request(&msc, &rules, &r);
+    modsecurity::msc_drain_server_log(&msc);
+    drainFromCallback = NULL;
+
+    std::lock_guard<std::mutex> guard(lock);
+    CHECK_EQ(r.logged, 2);
+}
+
+
+INTERNAL_TEST(drain_without_the_queue) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules;
+    Request r = { 0, 0 };
+
+    load(&rules);
+    msc.setServerLogCb(logCb, modsecurity::TextLogProperty);
+    request(&msc, &rules, &r);
+
+    /* delivered synchronously already, nothing to wait for */
+    modsecurity::msc_drain_server_log(&msc);
+    std::lock_guard<std::mutex> guard(lock);
+    CHECK_EQ(r.logged, 2);
+}
+
+
+/*
+ * The details of the messages are formatted before they are queued: the
+ * rules they come from may be gone by the time they are delivered.
+ */
+INTERNAL_TEST(queued_messages_outlive_their_rules) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet *rules = new modsecurity::RulesSet();
+    Request r = { 0, 0 };
+
+    texts.clear();
+    load(rules);
+    msc.setServerLogCb(textCb, modsecurity::TextLogProperty
+        | modsecurity::AsyncLogProperty);
+
+    request(&msc, rules, &r);
+    delete rules;
+    modsecurity::msc_drain_server_log(&msc);
+
+    std::lock_guard<std::mutex> guard(lock);
+    CHECK_EQ(texts.size(), 2);
+    CHECK(texts[0].find("[id \"1\"]") != std::string::npos);
+    CHECK(texts[0].find("[msg \"attack one\"]") != std::string::npos);
+    CHECK(texts[1].find("[id \"2\"]") != std::string::npos);
+}
@@ -0,0 +1,146 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <stdlib.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "modsecurity/variable_value.h"
+#include "src/collection/backend/shared_memory.h"
+#include "src/utils/metrics.h"
+#include "test/internal/internal_test.h"
+
+
+using modsecurity::VariableValue;
+using modsecurity::collection::backend::SharedMemory;
+using modsecurity::Utils::Metrics;
+
+
+static const int kThreads = 8;
+static const int kKeys = 4096;
+
+
+static size_t countOf(SharedMemory *c, const std::string &key) {
+    std::vector<const VariableValue *> l;
+    c->resolveSingleMatch(key, &l);
+    size_t n = l.size();
+    for (const VariableValue *v : l) {
+        delete v;
+    }
+    return n;
+}
+
+
+static double droppedWrites() {
+    static const std::string name =
+        "\nmodsecurity_collection_shared_memory_dropped_writes_total ";
+    std::string text = Metrics::getInstance().render();
+    size_t at = text.find(name);
+    CHECK(at != std::string::npos);
+    return strtod(text.c_str() + at + name.size(), NULL);
+}
+
+
+INTERNAL_TEST(concurrent_store_or_update_first_keeps_one_entry) {
+    SharedMemory c("IP");
+    std::vector<std::thread> threads;
+    std::atomic<int> ready(0);
+
+    for (int t = 0; t < kThreads; t++) {
+        threads.emplace_back([&c, &ready, t]() {
+            /* all of them missing the same keys at the same time */
+            ready++;
+            while (ready.load() < kThreads) { }
+            for (int k = 0; k < kKeys; k++) {
+                c.storeOrUpdateFirst("key" + std::to_string(k),
+                    std::to_string(t));
+            }
+        });
+    }
+    for (std::thread &t : threads) {
+        t.join();
+    }
+
+    for (int k = 0; k < kKeys; k++) {
+        CHECK_EQ(countOf(&c, "key" + std::to_string(k)), 1);
+    }
+}
+
+
+INTERNAL_TEST(concurrent_atomic_add_counts_every_addition) {
+    SharedMemory c("IP");
+    std::vector<std::thread> threads;
+    std::atomic<int> ready(0);
+
+    for (int t = 0; t < kThreads; t++) {
+        threads.emplace_back([&c, &ready]() {
+            ready++;
+            while (ready.load() < kThreads) { }
+            for (int k = 0; k < kKeys; k++) {
+                c.atomicAdd("counter" + std::to_string(k), 1, nullptr);
+            }
+        });
+    }
+    for (std::thread &t : threads) {
+        t.join();
+    }
+
+    for (int k = 0; k < kKeys; k++) {
+        std::string key = "counter" + std::to_string(k);
+        CHECK_EQ(countOf(&c, key), 1);
+        std::unique_ptr<std::string> v = c.resolveFirst(key);
+        CHECK(v != nullptr);
+        CHECK_EQ(*v, std::to_string(kThreads));
+    }
+}
+
+
+INTERNAL_TEST(store_or_update_first_after_delete) {
+    SharedMemory c("IP");
+
+    c.storeOrUpdateFirst("key", "1");
+    c.storeOrUpdateFirst("key", "2");
+    CHECK_EQ(countOf(&c, "key"), 1);
+    CHECK_EQ(*c.resolveFirst("key"), std::string("2"));
+
+    c.del("key");
+    CHECK(c.resolveFirst("key") == nullptr);
+    c.storeOrUpdateFirst("key", "3");
+    CHECK_EQ(countOf(&c, "key"), 1);
+    CHECK_EQ(*c.resolveFirst("key"), std::string("3"));
+}
+
+
+INTERNAL_TEST(too_long_writes_are_counted) {
+    SharedMemory c("IP");
+    std::string longKey(SharedMemory::kKeySize + 1, 'k');
+    std::string longValue(SharedMemory::kValueSize + 1, 'v');
+    double before = droppedWrites();
+
+    c.store(longKey, "1");
+    CHECK(c.storeOrUpdateFirst("key", longValue) == false);
+    CHECK(c.atomicAdd(longKey, 1, NULL) == false);
+    CHECK(c.resolveFirst(longKey) == nullptr);
+    CHECK(c.resolveFirst("key") == nullptr);
+    CHECK_EQ(droppedWrites() - before, 3);
+
+    /* right at the limits they fit */
+    CHECK(c.storeOrUpdateFirst(longKey.substr(1), longValue.substr(1)));
+    CHECK_EQ(droppedWrites() - before, 3);
+}
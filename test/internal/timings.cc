@@ -0,0 +1,117 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <string>
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/audit_log.h"
+#include "modsecurity/timings.h"
+#include "modsecurity/transaction.h"
+#include "test/internal/internal_test.h"
+
+
+namespace {
+
+const char kRules[] =
+    "SecRuleEngine On\n" \
+    "SecRequestBodyAccess On\n" \
+    "SecRule ARGS \"@rx attack\" \"id:1,phase:2,pass,nolog\"\n" \
+    "SecRule REQUEST_HEADERS \"@rx attack\" \"id:2,phase:1,pass,nolog\"\n";
+
+
+void request(modsecurity::Transaction *t) {
+    modsecurity::msc_process_connection(t, "127.0.0.1", 12345,
+        "127.0.0.1", 80);
+    modsecurity::msc_process_uri(t, "/?a=b", "POST", "1.1");
+    modsecurity::msc_add_request_header(t,
+        reinterpret_cast<const unsigned char *>("Host"),
+        reinterpret_cast<const unsigned char *>("localhost"));
+    modsecurity::msc_process_request_headers(t);
+    modsecurity::msc_append_request_body(t,
+        reinterpret_cast<const unsigned char *>("c=d"), 3);
+    modsecurity::msc_process_request_body(t);
+}
+
+
+bool timingsInAuditLog(const std::string &conf) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules;
+    CHECK(rules.load((kRules + conf).c_str()) > 0);
+
+    modsecurity::Transaction t(&msc, &rules, NULL);
+    request(&t);
+    std::string out;
+    t.toMsgPack(modsecurity::audit_log::AuditLog::HAuditLogPart, &out);
+    return out.find("timings") != std::string::npos;
+}
+
+}  // namespace
+
+
+INTERNAL_TEST(msc_get_timings) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules;
+    CHECK(rules.load(kRules) > 0);
+    modsecurity::ModSecurityTimings timings;
+
+    modsecurity::Transaction *t = modsecurity::msc_new_transaction(&msc,
+        &rules, NULL);
+    CHECK_EQ(modsecurity::msc_get_timings(t, NULL), 0);
+    CHECK_EQ(modsecurity::msc_get_timings(t, &timings), 1);
+    CHECK_EQ(timings.total, 0);
+
+    request(t);
+    CHECK_EQ(modsecurity::msc_get_timings(t, &timings), 1);
+    CHECK(timings.request_headers > 0);
+    CHECK(timings.request_body > 0);
+    CHECK_EQ(timings.response_headers, 0);
+    CHECK_EQ(timings.response_body, 0);
+    CHECK_EQ(timings.logging, 0);
+    CHECK_EQ(timings.total, timings.request_headers + timings.request_body);
+
+    modsecurity::msc_process_response_headers(t, 200, "HTTP 1.1");
+    modsecurity::msc_process_response_body(t);
+    modsecurity::msc_process_logging(t);
+    CHECK_EQ(modsecurity::msc_get_timings(t, &timings), 1);
+    CHECK(timings.response_headers > 0);
+    CHECK(timings.logging > 0);
+    CHECK_EQ(timings.total, timings.request_headers + timings.request_body
+        + timings.response_headers + timings.response_body
+        + timings.logging);
+
+    modsecurity::msc_transaction_cleanup(t);
+}
+
+
+INTERNAL_TEST(audit_log_timings_are_optional) {
+    CHECK(timingsInAuditLog("SecAuditEngine On\n") == false);
+    CHECK(timingsInAuditLog("SecAuditEngine On\n" \
+        "SecAuditLogTimings Off\n") == false);
+    CHECK(timingsInAuditLog("SecAuditEngine On\n" \
+        "SecAuditLogTimings On\n"));
+}
+
+
+INTERNAL_TEST(audit_log_timings_are_merged) {
+    modsecurity::RulesSet rules;
+    CHECK(rules.load("SecAuditLogTimings On\n") >= 0);
+    CHECK(rules.m_auditLog->getTimings());
+    /* not set again, kept */
+    CHECK(rules.load("SecAuditEngine On\n") >= 0);
+    CHECK(rules.m_auditLog->getTimings());
+    CHECK(rules.load("SecAuditLogTimings Off\n") >= 0);
+    CHECK(rules.m_auditLog->getTimings() == false);
+}
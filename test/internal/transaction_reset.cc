@@ -0,0 +1,113 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <memory>
+#include <string>
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/transaction.h"
+#include "modsecurity/intervention.h"
+#include "test/internal/internal_test.h"
+
+
+static const char *rules = \
+    "SecRuleEngine On\n" \
+    "SecRule ARGS:attack \"@streq 1\" " \
+        "\"id:1,phase:1,pass,nolog,setvar:tx.seen=1\"\n" \
+    "SecRule TX:seen \"@eq 1\" \"id:2,phase:1,deny,status:403\"\n" \
+    "SecRule REQUEST_HEADERS:X-Block \"@streq yes\" " \
+        "\"id:3,phase:1,deny,status:406\"\n";
+
+
+static int request(modsecurity::Transaction *t, const char *uri,
+    const char *blockHeader) {
+    modsecurity::ModSecurityIntervention it;
+    modsecurity::intervention::reset(&it);
+
+    t->processConnection("127.0.0.1", 12345, "127.0.0.1", 80);
+    t->processURI(uri, "GET", "1.1");
+    t->addRequestHeader("Host", "localhost");
+    if (blockHeader != NULL) {
+        t->addRequestHeader("X-Block", blockHeader);
+    }
+    t->processRequestHeaders();
+    t->intervention(&it);
+    modsecurity::intervention::free(&it);
+
+    return it.status;
+}
+
+
+INTERNAL_TEST(reset_drops_request_state) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules_set;
+    CHECK(rules_set.load(rules) > 0);
+
+    modsecurity::Transaction t(&msc, &rules_set, NULL);
+    CHECK_EQ(request(&t, "/?attack=1", "yes"), 403);
+    CHECK(t.m_collections.m_tx_collection->resolveFirst("seen") != nullptr);
+
+    t.reset();
+    CHECK(t.m_collections.m_tx_collection->resolveFirst("seen") == nullptr);
+    CHECK(t.m_uri.empty());
+    CHECK_EQ(t.m_highestSeverityAction, 255);
+
+    /* nothing of the blocked request decides the verdict of this one */
+    CHECK_EQ(request(&t, "/?attack=0", NULL), 200);
+    CHECK_EQ(t.m_uri, std::string("/?attack=0"));
+
+    t.reset();
+    CHECK_EQ(request(&t, "/", "yes"), 406);
+}
+
+
+INTERNAL_TEST(reset_matches_a_new_transaction) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules_set;
+    CHECK(rules_set.load(rules) > 0);
+
+    const char *uris[] = { "/?attack=1", "/?attack=0", "/a?attack=1",
+        "/b" };
+    modsecurity::Transaction recycled(&msc, &rules_set, NULL);
+    for (const char *uri : uris) {
+        modsecurity::Transaction fresh(&msc, &rules_set, NULL);
+        recycled.reset();
+        CHECK_EQ(request(&recycled, uri, NULL), request(&fresh, uri, NULL));
+    }
+}
+
+
+INTERNAL_TEST(reset_with_id) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules_set;
+    CHECK(rules_set.load(rules) > 0);
+
+    char first[] = "first-id";
+    char second[] = "second-id";
+    modsecurity::Transaction *t = msc_new_transaction_with_id(&msc,
+        &rules_set, first, NULL);
+    CHECK_EQ(*t->m_id, std::string("first-id"));
+    CHECK_EQ(request(t, "/?attack=1", NULL), 403);
+
+    msc_transaction_reset_with_id(t, second);
+    CHECK_EQ(*t->m_id, std::string("second-id"));
+    CHECK_EQ(request(t, "/", NULL), 200);
+
+    msc_transaction_reset(t);
+    CHECK(*t->m_id != "second-id");
+    CHECK(t->m_id->empty() == false);
+    msc_transaction_cleanup(t);
+}
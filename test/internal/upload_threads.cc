@@ -0,0 +1,284 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <dirent.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "modsecurity/intervention.h"
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/transaction.h"
+#include "modsecurity/variable_value.h"
+#include "test/internal/internal_test.h"
+
+
+using modsecurity_test::internal::statusOf;
+
+
+namespace {
+
+const char kBoundary[] = "----upload-threads";
+
+
+struct Part {
+    const char *name;
+    const char *filename;
+    std::string content;
+};
+
+
+/* The file parts, with a form field in between. */
+std::vector<Part> parts() {
+    return {
+        {"f1", "one.txt", "first file\n"},
+        {"a", NULL, "1"},
+        /* past the write buffer: written while parsing, then closed */
+        {"f2", "two.txt", std::string(300000, 'b')},
+        {"f3", "three.txt", "secretword"},
+        {"f4", "four.txt", "fourth file\n"},
+    };
+}
+
+
+std::string body(const std::vector<Part> &p) {
+    std::string b;
+    for (const Part &part : p) {
+        b = b + "--" + kBoundary + "\r\n" \
+            "Content-Disposition: form-data; name=\"" + part.name + "\"";
+        if (part.filename != NULL) {
+            b = b + "; filename=\"" + part.filename + "\"\r\n" \
+                "Content-Type: text/plain";
+        }
+        b = b + "\r\n\r\n" + part.content + "\r\n";
+    }
+    return b + "--" + kBoundary + "--\r\n";
+}
+
+
+/* An upload directory, of which the test checks that it is left empty. */
+class UploadDir {
+ public:
+    UploadDir() {
+        char dir[] = "/tmp/modsec-upload-threads-XXXXXX";
+        CHECK(mkdtemp(dir) != NULL);
+        m_dir = dir;
+    }
+
+    ~UploadDir() {
+        rmdir(m_dir.c_str());
+    }
+
+    size_t files() const {
+        DIR *d = opendir(m_dir.c_str());
+        size_t n = 0;
+        CHECK(d != NULL);
+        while (struct dirent *e = readdir(d)) {
+            std::string name(e->d_name);
+            if (name != "." && name != "..") {
+                n++;
+            }
+        }
+        closedir(d);
+        return n;
+    }
+
+    std::string rules() const {
+        return "SecRuleEngine On\n" \
+            "SecRequestBodyAccess On\n" \
+            "SecTmpSaveUploadedFiles On\n" \
+            "SecUploadDir " + m_dir + "/\n" \
+            "SecRule REQBODY_ERROR \"!@eq 0\" " \
+                "\"id:1,phase:2,deny,status:400\"\n" \
+            "SecRule FILES_TMP_CONTENT \"@contains secretword\" " \
+                "\"id:2,phase:2,deny,status:403\"\n";
+    }
+
+ private:
+    std::string m_dir;
+};
+
+
+modsecurity::Transaction *request(modsecurity::ModSecurity *msc,
+    modsecurity::RulesSet *rules, const std::string &b) {
+    std::string type = std::string("multipart/form-data; boundary=")
+        + kBoundary;
+    std::string length = std::to_string(b.size());
+
+    modsecurity::Transaction *t = modsecurity::msc_new_transaction(msc,
+        rules, NULL);
+    modsecurity::msc_process_connection(t, "127.0.0.1", 12345,
+        "127.0.0.1", 80);
+    modsecurity::msc_process_uri(t, "/upload", "POST", "1.1");
+    t->addRequestHeader("Host", "localhost");
+    t->addRequestHeader("Content-Type", type);
+    t->addRequestHeader("Content-Length", length);
+    modsecurity::msc_process_request_headers(t);
+    modsecurity::msc_append_request_body(t,
+        reinterpret_cast<const unsigned char *>(b.data()), b.size());
+    modsecurity::msc_process_request_body(t);
+    return t;
+}
+
+
+std::vector<std::string> values(modsecurity::AnchoredSetVariable *v,
+    const std::string &name) {
+    std::vector<const modsecurity::VariableValue *> l;
+    std::vector<std::string> r;
+
+    v->resolve(name, &l);
+    for (const modsecurity::VariableValue *a : l) {
+        r.push_back(a->getValue());
+        delete a;
+    }
+    return r;
+}
+
+
+void end(modsecurity::Transaction *t) {
+    modsecurity::msc_process_logging(t);
+    modsecurity::msc_transaction_cleanup(t);
+}
+
+
+/*
+ * Files may not grow at all: whatever is left to write when a part is
+ * closed fails then.
+ */
+class NoFileGrows {
+ public:
+    NoFileGrows() {
+        CHECK_EQ(getrlimit(RLIMIT_FSIZE, &m_limit), 0);
+        m_handler = signal(SIGXFSZ, SIG_IGN);
+        struct rlimit none = m_limit;
+        none.rlim_cur = 0;
+        CHECK_EQ(setrlimit(RLIMIT_FSIZE, &none), 0);
+    }
+
+    ~NoFileGrows() {
+        setrlimit(RLIMIT_FSIZE, &m_limit);
+        signal(SIGXFSZ, m_handler);
+    }
+
+ private:
+    struct rlimit m_limit;
+    void (*m_handler)(int);
+};
+
+}  // namespace
+
+
+/*
+ * The parts left to the upload threads are all closed and read back by
+ * the time phase 2 looks at them.
+ */
+INTERNAL_TEST(upload_threads_give_the_same_files) {
+    UploadDir dir;
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules;
+    std::vector<Part> p = parts();
+    std::string b = body(p);
+
+    CHECK(rules.load(dir.rules().c_str()) >= 0);
+    msc.setUploadThreads(2, 16);
+    CHECK(msc.uploadRunner() != NULL);
+
+    for (int i = 0; i < 20; i++) {
+        modsecurity::Transaction *t = request(&msc, &rules, b);
+        CHECK_EQ(statusOf(t), 403);
+        CHECK_EQ(t->m_variableReqbodyError.m_value, "0");
+        for (const Part &part : p) {
+            std::vector<std::string> content = values(
+                &t->m_variableFilesTmpContent, part.name);
+            if (part.filename == NULL) {
+                CHECK(content.empty());
+                continue;
+            }
+            CHECK_EQ(content.size(), 1);
+            CHECK(content.front() == part.content);
+            CHECK_EQ(values(&t->m_variableFilesSizes, part.name).front(),
+                std::to_string(part.content.size()));
+            CHECK_EQ(values(&t->m_variableFilesTmpNames, part.name).size(),
+                1);
+        }
+        end(t);
+    }
+
+    /* no temporary file outlives its transaction */
+    CHECK_EQ(dir.files(), 0);
+}
+
+
+/* Without threads, as it always was. */
+INTERNAL_TEST(no_upload_threads_by_default) {
+    UploadDir dir;
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules;
+    std::vector<Part> p = parts();
+
+    CHECK(rules.load(dir.rules().c_str()) >= 0);
+    CHECK(msc.uploadRunner() == NULL);
+    msc.setUploadThreads(2, 16);
+    msc.setUploadThreads(0, 16);
+    CHECK(msc.uploadRunner() == NULL);
+
+    modsecurity::Transaction *t = request(&msc, &rules, body(p));
+    CHECK_EQ(statusOf(t), 403);
+    CHECK(values(&t->m_variableFilesTmpContent, "f3").front()
+        == p[3].content);
+    end(t);
+    CHECK_EQ(dir.files(), 0);
+}
+
+
+/*
+ * A part that can not be closed fails the body, on the upload threads
+ * as on the request thread.
+ */
+INTERNAL_TEST(upload_threads_report_a_close_failure) {
+    const size_t threads[] = {0, 2};
+
+    for (size_t n : threads) {
+        UploadDir dir;
+        modsecurity::ModSecurity msc;
+        modsecurity::RulesSet rules;
+        std::vector<Part> p = {
+            {"f1", "one.txt", "first file\n"},
+            {"f3", "three.txt", "secretword"},
+        };
+
+        CHECK(rules.load(dir.rules().c_str()) >= 0);
+        msc.setUploadThreads(n, 16);
+
+        modsecurity::Transaction *t;
+        {
+            NoFileGrows limit;
+            t = request(&msc, &rules, body(p));
+        }
+        CHECK_EQ(statusOf(t), 400);
+        CHECK_EQ(t->m_variableReqbodyError.m_value, "1");
+        const std::string &msg = t->m_variableReqbodyErrorMsg.m_value;
+        CHECK(msg.find("Multipart parsing error: Multipart: writing to \"")
+            == 0);
+        CHECK(msg.find("\" failed") != std::string::npos);
+        end(t);
+        CHECK_EQ(dir.files(), 0);
+    }
+}
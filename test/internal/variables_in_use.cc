@@ -0,0 +1,147 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/intervention.h"
+#include "modsecurity/transaction.h"
+#include "modsecurity/variable_value.h"
+#include "test/internal/internal_test.h"
+
+
+namespace {
+
+struct Collected {
+    size_t cookies;
+    size_t cookieNames;
+    bool authType;
+};
+
+
+Collected collect(const std::string &rules) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules_set;
+    Collected c;
+
+    CHECK(rules_set.load(("SecRuleEngine On\n" + rules).c_str()) > 0);
+
+    modsecurity::Transaction t(&msc, &rules_set, NULL);
+    t.processConnection("127.0.0.1", 12345, "127.0.0.1", 80);
+    t.processURI("/?a=b", "GET", "1.1");
+    t.addRequestHeader("Host", "localhost");
+    t.addRequestHeader("Cookie", "session=abc; theme=dark");
+    t.addRequestHeader("Authorization", "Basic dXNlcjpwYXNz");
+    t.processRequestHeaders();
+
+    std::vector<const modsecurity::VariableValue *> l;
+    t.m_variableRequestCookies.resolve(&l);
+    c.cookies = l.size();
+    for (const modsecurity::VariableValue *v : l) {
+        delete v;
+    }
+    l.clear();
+    t.m_variableRequestCookiesNames.resolve(&l);
+    c.cookieNames = l.size();
+    for (const modsecurity::VariableValue *v : l) {
+        delete v;
+    }
+    std::unique_ptr<std::string> authType =
+        t.m_variableAuthType.resolveFirst();
+    c.authType = authType != nullptr && *authType == "Basic";
+
+    return c;
+}
+
+}  // namespace
+
+
+INTERNAL_TEST(skipped_when_unused) {
+    Collected c = collect(
+        "SecRule ARGS \"@rx attack\" \"id:1,phase:1,deny\"\n" \
+        "SecRule REQUEST_HEADERS:Host \"@rx ^evil\" \"id:2,phase:1,deny\"\n");
+
+    CHECK_EQ(c.cookies, 0);
+    CHECK_EQ(c.cookieNames, 0);
+    CHECK(c.authType == false);
+}
+
+
+INTERNAL_TEST(cookies_as_target) {
+    Collected c = collect(
+        "SecRule REQUEST_COOKIES:session \"@rx x\" \"id:1,phase:1,deny\"\n");
+
+    CHECK_EQ(c.cookies, 2);
+    CHECK_EQ(c.cookieNames, 2);
+    CHECK(c.authType == false);
+}
+
+
+INTERNAL_TEST(cookie_names_as_target) {
+    Collected c = collect(
+        "SecRule REQUEST_COOKIES_NAMES \"@rx x\" \"id:1,phase:1,deny\"\n");
+
+    CHECK_EQ(c.cookieNames, 2);
+}
+
+
+INTERNAL_TEST(cookies_in_an_exclusion) {
+    Collected c = collect(
+        "SecRule ARGS|!REQUEST_COOKIES:session \"@rx x\" " \
+            "\"id:1,phase:1,deny\"\n");
+
+    CHECK_EQ(c.cookies, 2);
+}
+
+
+INTERNAL_TEST(auth_type_as_target) {
+    Collected c = collect(
+        "SecRule AUTH_TYPE \"@streq Digest\" \"id:1,phase:1,deny\"\n");
+
+    CHECK(c.authType);
+    CHECK_EQ(c.cookies, 0);
+}
+
+
+INTERNAL_TEST(auth_type_in_a_macro) {
+    Collected c = collect(
+        "SecRule ARGS \"@rx x\" " \
+            "\"id:1,phase:1,pass,log,msg:'auth %{AUTH_TYPE}'\"\n");
+
+    CHECK(c.authType);
+}
+
+
+INTERNAL_TEST(same_verdict_either_way) {
+    modsecurity::ModSecurity msc;
+    modsecurity::RulesSet rules_set;
+    CHECK(rules_set.load("SecRuleEngine On\n" \
+        "SecRule REQUEST_COOKIES:session \"@streq abc\" " \
+            "\"id:1,phase:1,deny,status:403\"\n") > 0);
+
+    modsecurity::Transaction t(&msc, &rules_set, NULL);
+    modsecurity::ModSecurityIntervention it;
+    modsecurity::intervention::reset(&it);
+    t.processConnection("127.0.0.1", 12345, "127.0.0.1", 80);
+    t.processURI("/", "GET", "1.1");
+    t.addRequestHeader("Cookie", "session=abc; theme=dark");
+    t.processRequestHeaders();
+    t.intervention(&it);
+    modsecurity::intervention::free(&it);
+    CHECK_EQ(it.status, 403);
+}
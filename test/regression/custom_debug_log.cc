@@ -47,6 +47,12 @@ std::string const CustomDebugLog::log_messages() const {
 }
 
 
+void CustomDebugLog::reset_log_messages(const std::string &messages) {
+    m_log.str(messages);
+    m_log.seekp(0, std::ios_base::end);
+}
+
+
 int CustomDebugLog::getDebugLogLevel() {
     return 9;
 }
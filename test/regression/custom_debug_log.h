@@ -33,6 +33,7 @@ class CustomDebugLog : public modsecurity::debug_log::DebugLog {
         const std::string &uri, const std::string &msg) override;
     bool const contains(const std::string& pattern) const;
     std::string const log_messages() const;
+    void reset_log_messages(const std::string &messages);
     std::string error_log_messages();
     int getDebugLogLevel() override;
 
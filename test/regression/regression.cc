@@ -15,13 +15,23 @@
 
 #include <string.h>
 
+#include <sys/types.h>
+#include <sys/wait.h>
 #include <unistd.h>
 
+#include <cctype>
+#include <chrono>
+#include <cstdio>
 #include <ctime>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <list>
 #include <algorithm>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "modsecurity/rules_set.h"
 #include "modsecurity/modsecurity.h"
@@ -45,8 +55,23 @@ using modsecurity::Utils::Regex;
 std::string default_test_path = "test-cases/regression";
 std::list<std::string> resources;
 
+/*
+ * With -jN the rules of a test are only parsed once per worker: tests with
+ * the same rules get the RulesSet of the first one, along with what its
+ * debug log had right after the load.
+ */
+bool reuse_rules = false;
+std::unordered_map<std::string,
+    std::pair<modsecurity::RulesSet *, std::string>> rules_cache;
+
+#ifdef WITH_LMDB
+/* Only the worker running the tests that use collections starts afresh. */
+bool unlink_collections = true;
+#endif
+
+
 void print_help() {
-    std::cout << "Use ./regression-tests /path/to/file" << std::endl;
+    std::cout << "Use ./regression-tests [-jN] /path/to/file" << std::endl;
     std::cout << std::endl;
     std::cout << std::endl;
 }
@@ -115,6 +140,30 @@ void logCb(void *data, const void *msgv) {
 }
 
 
+/* Times a test, whichever way it leaves the loop in perform_unit_test. */
+class Stopwatch {
+ public:
+    explicit Stopwatch(RegressionTestResult *res)
+        : m_res(res),
+        m_begin(std::chrono::steady_clock::now()) { }
+
+    ~Stopwatch() {
+        m_res->elapsed = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - m_begin).count();
+    }
+
+ private:
+    RegressionTestResult *m_res;
+    std::chrono::steady_clock::time_point m_begin;
+};
+
+
+bool reusable(const RegressionTest *t) {
+    return reuse_rules && t->parser_error.empty()
+        && t->rules.find("SecRuleProfiling") == std::string::npos;
+}
+
+
 void perform_unit_test(ModSecurityTest<RegressionTest> *test,
     std::vector<RegressionTest *> *tests,
     ModSecurityTestResults<RegressionTestResult> *res, int *count) {
@@ -127,6 +176,8 @@ void perform_unit_test(ModSecurityTest<RegressionTest> *test,
         ModSecurityTestResults<RegressionTest> r;
         std::stringstream serverLog;
         RegressionTestResult *testRes = new RegressionTestResult();
+        Stopwatch stopwatch(testRes);
+        bool cached = false;
 
         testRes->test = t;
         r.status = 200;
@@ -163,8 +214,10 @@ void perform_unit_test(ModSecurityTest<RegressionTest> *test,
 
 #ifdef WITH_LMDB
         // some tests (e.g. issue-1831.json)  don't like it when data persists between runs
-        unlink("./modsec-shared-collections");
-        unlink("./modsec-shared-collections-lock");
+        if (unlink_collections) {
+            unlink("./modsec-shared-collections");
+            unlink("./modsec-shared-collections-lock");
+        }
 #endif
 
         modsec = new modsecurity::ModSecurity();
@@ -201,8 +254,16 @@ void perform_unit_test(ModSecurityTest<RegressionTest> *test,
             continue;
         }
 
-        modsec_rules->load("SecDebugLogLevel 9");
-        if (modsec_rules->load(t->rules.c_str(), filename) < 0) {
+        if (reusable(t) && rules_cache.count(t->rules) > 0) {
+            std::pair<modsecurity::RulesSet *, std::string> &c =
+                rules_cache[t->rules];
+            delete modsec_rules;
+            modsec_rules = c.first;
+            reinterpret_cast<CustomDebugLog *>(modsec_rules->m_debugLog)
+                ->reset_log_messages(c.second);
+            cached = true;
+        } else if (modsec_rules->load("SecDebugLogLevel 9") < 0
+            || modsec_rules->load(t->rules.c_str(), filename) < 0) {
             /* Parser error */
             if (t->parser_error.empty() == true) {
                 /*
@@ -297,6 +358,11 @@ void perform_unit_test(ModSecurityTest<RegressionTest> *test,
 
                 continue;
             }
+            if (reusable(t)) {
+                rules_cache[t->rules] = std::make_pair(modsec_rules,
+                    debug_log->log_messages());
+                cached = true;
+            }
         }
 
         modsec_transaction = new modsecurity::Transaction(modsec, modsec_rules,
@@ -461,7 +527,9 @@ after_debug_log:
         }
 
         delete modsec_transaction;
-        delete modsec_rules;
+        if (!cached) {
+            delete modsec_rules;
+        }
         delete modsec;
         /* delete debug_log; */
 
@@ -470,6 +538,241 @@ after_debug_log:
 }
 
 
+/*
+ * A bunch of test files for one worker of -jN. The tests that share state
+ * outside of the process (the audit logs and, with LMDB, the collections)
+ * all go to the same shard, so they still run one after the other.
+ */
+struct Shard {
+    std::vector<std::string> keys;
+    size_t tests = 0;
+    int offset = 0;
+    bool shared = false;
+    FILE *out = NULL;
+    pid_t pid = -1;
+    int status = 0;
+    bool done = false;
+};
+
+
+bool shares_state(const RegressionTest *t) {
+    if (t->rules.find("SecAuditLog") != std::string::npos) {
+        return true;
+    }
+#ifdef WITH_LMDB
+    std::string rules(t->rules);
+    std::transform(rules.begin(), rules.end(), rules.begin(), ::tolower);
+    for (const char *c : { "initcol", "setsid", "setuid", "setrsc",
+        "global" }) {
+        if (rules.find(c) != std::string::npos) {
+            return true;
+        }
+    }
+#endif
+    return false;
+}
+
+
+std::vector<Shard> make_shards(ModSecurityTest<RegressionTest> *test,
+    const std::list<std::string> &keys) {
+    std::vector<std::pair<std::string, std::vector<std::string>>> files;
+    std::vector<bool> shared;
+    size_t total = 0;
+
+    /* The keys are sorted, thus the tests of a file come in a row. */
+    for (const std::string &key : keys) {
+        const std::vector<RegressionTest *> *tests = (*test)[key];
+        const std::string &filename = tests->front()->filename;
+        if (files.empty() || files.back().first != filename) {
+            files.emplace_back(filename, std::vector<std::string>());
+            shared.push_back(false);
+        }
+        files.back().second.push_back(key);
+        for (const RegressionTest *t : *tests) {
+            if (shares_state(t)) {
+                shared.back() = true;
+            }
+        }
+        total += tests->size();
+    }
+
+    /* A few shards per worker, so that a slow file doesn't hold the rest. */
+    std::vector<Shard> shards(1);
+    shards[0].shared = true;
+    size_t size = total / (test->m_jobs * 4) + 1;
+    for (size_t i = 0; i < files.size(); i++) {
+        Shard *s = &shards[0];
+        if (!shared[i]) {
+            if (shards.size() == 1 || shards.back().tests >= size) {
+                shards.emplace_back();
+            }
+            s = &shards.back();
+        }
+        for (const std::string &key : files[i].second) {
+            s->keys.push_back(key);
+            s->tests += (*test)[key]->size();
+        }
+    }
+    if (shards[0].keys.empty()) {
+        shards.erase(shards.begin());
+    }
+
+    int offset = 0;
+    for (Shard &s : shards) {
+        s.offset = offset;
+        offset += s.tests;
+    }
+
+    return shards;
+}
+
+
+void write_string(std::ostream *o, const std::string &s) {
+    *o << s.size() << std::endl << s;
+}
+
+
+std::string read_string(std::istream *i) {
+    size_t len = 0;
+    if (!(*i >> len) || i->get() != '\n') {
+        return "";
+    }
+    std::string s(len, '\0');
+    i->read(&s[0], len);
+    s.resize(i->gcount());
+    return s;
+}
+
+
+/*
+ * Runs in the child: the output and the results of the shard both go to
+ * the shard's file, for the parent to pick them up in order.
+ */
+void run_shard(ModSecurityTest<RegressionTest> *test, Shard *shard) {
+    ModSecurityTestResults<RegressionTestResult> res;
+    std::stringstream output;
+    int counter = shard->offset;
+
+#ifdef WITH_LMDB
+    unlink_collections = shard->shared;
+#endif
+    std::streambuf *stdout_buf = std::cout.rdbuf(output.rdbuf());
+    for (const std::string &key : shard->keys) {
+        perform_unit_test(test, (*test)[key], &res, &counter);
+    }
+    std::cout.rdbuf(stdout_buf);
+
+    std::stringstream o;
+    write_string(&o, output.str());
+    for (RegressionTestResult *r : res) {
+        o << r->passed << " " << r->skipped << " " << r->disabled << " "
+            << r->elapsed << std::endl;
+        write_string(&o, r->reason.str());
+    }
+
+    std::string s = o.str();
+    fwrite(s.c_str(), 1, s.size(), shard->out);
+    fflush(shard->out);
+}
+
+
+/*
+ * The results of a finished shard, one per test as perform_unit_test
+ * would have them. Whatever a worker that died could not tell about is a
+ * failure.
+ */
+void collect_shard(ModSecurityTest<RegressionTest> *test, Shard *shard,
+    ModSecurityTestResults<RegressionTestResult> *res) {
+    std::stringstream i;
+    char buf[8192];
+    size_t n;
+
+    rewind(shard->out);
+    while ((n = fread(buf, 1, sizeof(buf), shard->out)) > 0) {
+        i.write(buf, n);
+    }
+    fclose(shard->out);
+    shard->out = NULL;
+
+    std::cout << read_string(&i);
+    for (const std::string &key : shard->keys) {
+        for (RegressionTest *t : *(*test)[key]) {
+            RegressionTestResult *r = new RegressionTestResult();
+            r->test = t;
+            if (i >> r->passed >> r->skipped >> r->disabled >> r->elapsed) {
+                r->reason << read_string(&i);
+            } else {
+                r->passed = false;
+                r->reason << KRED << "the worker running it exited with ";
+                if (WIFSIGNALED(shard->status)) {
+                    r->reason << "signal " << WTERMSIG(shard->status);
+                } else {
+                    r->reason << "status " << WEXITSTATUS(shard->status);
+                }
+                r->reason << RESET << std::endl;
+                if (test->m_automake_output) {
+                    std::cout << ":test-result: FAIL "
+                        << t->filename << ":" << t->name << std::endl;
+                }
+            }
+            res->push_back(r);
+        }
+    }
+}
+
+
+void perform_parallel(ModSecurityTest<RegressionTest> *test,
+    const std::list<std::string> &keys,
+    ModSecurityTestResults<RegressionTestResult> *res) {
+    std::vector<Shard> shards = make_shards(test, keys);
+    size_t next = 0;
+    size_t printed = 0;
+    int running = 0;
+
+    while (printed < shards.size()) {
+        while (running < test->m_jobs && next < shards.size()) {
+            Shard *s = &shards[next++];
+            s->out = tmpfile();
+            if (s->out == NULL) {
+                perror("Failed to create the file for a worker");
+                exit(1);
+            }
+            std::cout.flush();
+            fflush(stdout);
+            s->pid = fork();
+            if (s->pid < 0) {
+                perror("Failed to start a worker");
+                exit(1);
+            }
+            if (s->pid == 0) {
+                run_shard(test, s);
+                _exit(0);
+            }
+            running++;
+        }
+
+        int status;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0) {
+            perror("Failed to wait for the workers");
+            exit(1);
+        }
+        for (Shard &s : shards) {
+            if (s.pid == pid && !s.done) {
+                s.status = status;
+                s.done = true;
+                running--;
+            }
+        }
+
+        /* The output goes out in shard order, as soon as it can. */
+        while (printed < shards.size() && shards[printed].done) {
+            collect_shard(test, &shards[printed++], res);
+        }
+    }
+}
+
+
 int main(int argc, char **argv) {
     ModSecurityTest<RegressionTest> test;
 
@@ -502,6 +805,21 @@ int main(int argc, char **argv) {
 #ifdef WITH_LUA
     resources.push_back("lua");
 #endif
+#ifdef WITH_LUA_JIT
+    resources.push_back("luajit");
+#endif
+#ifdef WITH_SIMDJSON
+    resources.push_back("simdjson");
+#endif
+#ifdef WITH_ZLIB
+    resources.push_back("zlib");
+#endif
+#ifdef WITH_RE2
+    resources.push_back("re2");
+#endif
+#if defined(WITH_REDIS_COLLECTIONS) && !defined(WITH_SHARED_COLLECTIONS)
+    resources.push_back("redis");
+#endif
 
 #ifdef NO_LOGS
     std::cout << "Test utility cannot work without logging support." \
@@ -540,14 +858,30 @@ int main(int argc, char **argv) {
     }
 
     ModSecurityTestResults<RegressionTestResult> res;
-    for (std::string &a : keyList) {
-        test_number++;
-        if ((test.m_test_number == 0)
-            || (test_number == test.m_test_number)) {
-            std::vector<RegressionTest *> *tests = test[a];
-            perform_unit_test(&test, tests, &res, &counter);
+    auto begin = std::chrono::steady_clock::now();
+    if (test.m_jobs > 0) {
+        std::list<std::string> selected;
+        for (std::string &a : keyList) {
+            test_number++;
+            if ((test.m_test_number == 0)
+                || (test_number == test.m_test_number)) {
+                selected.push_back(a);
+            }
+        }
+        reuse_rules = true;
+        perform_parallel(&test, selected, &res);
+    } else {
+        for (std::string &a : keyList) {
+            test_number++;
+            if ((test.m_test_number == 0)
+                || (test_number == test.m_test_number)) {
+                std::vector<RegressionTest *> *tests = test[a];
+                perform_unit_test(&test, tests, &res, &counter);
+            }
         }
     }
+    double elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - begin).count();
 
     std::cout << std::endl;
 
@@ -556,6 +890,25 @@ int main(int argc, char **argv) {
     int disabled = 0;
     int skipped = 0;
 
+    /* Where the time goes, so that a test that got slower stands out. */
+    if (!test.m_automake_output && !res.empty()) {
+        std::vector<RegressionTestResult *> slowest(res.begin(), res.end());
+        size_t n = std::min(slowest.size(), static_cast<size_t>(10));
+        std::partial_sort(slowest.begin(), slowest.begin() + n,
+            slowest.end(), [](const RegressionTestResult *a,
+                const RegressionTestResult *b) {
+                return a->elapsed > b->elapsed;
+            });
+        std::cout << KWHT << "Slowest tests:" << RESET << std::endl;
+        for (size_t i = 0; i < n; i++) {
+            std::cout << std::setw(10) << std::right << std::fixed
+                << std::setprecision(2) << slowest[i]->elapsed << " ms  "
+                << slowest[i]->test->filename << ":"
+                << slowest[i]->test->name << std::endl;
+        }
+        std::cout << std::endl;
+    }
+
     for (RegressionTestResult *r : res) {
         if (r->skipped == true) {
             skipped++;
@@ -595,6 +948,17 @@ int main(int argc, char **argv) {
         std::cout << KCYN << std::to_string(skipped) << " ";
 		std::cout << "skipped test(s). " << std::to_string(disabled) << " ";
         std::cout << "disabled test(s)." << RESET << std::endl;
+        std::cout << "Took " << std::fixed << std::setprecision(2)
+            << elapsed << " s";
+        if (test.m_jobs > 0) {
+            std::cout << " with " << test.m_jobs << " workers";
+        }
+        std::cout << "." << std::endl;
+    }
+
+    for (std::pair<const std::string,
+        std::pair<modsecurity::RulesSet *, std::string>> &c : rules_cache) {
+        delete c.second.first;
     }
 
     for (std::pair<std::string, std::vector<RegressionTest *> *> a : test) {
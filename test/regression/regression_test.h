@@ -84,11 +84,14 @@ class RegressionTestResult {
       passed(false),
       skipped(false),
       disabled(false),
+      elapsed(0),
       test(NULL) { }
 
     bool passed;
     bool skipped;
     bool disabled;
+    /* Milliseconds from the rules load to the checks on the logs. */
+    double elapsed;
     RegressionTest *test;
     std::stringstream reason;
 };
@@ -0,0 +1,27 @@
+local ffi = require("ffi")
+ffi.cdef(m.ffi)
+
+function main()
+    local values = ffi.new("const msc_lua_value *[1]")
+    local lowercase = ffi.C.msc_lua_compile_transformations(__msc,
+        "lowercase")
+    local n = ffi.C.msc_lua_getvars(__msc, "ARGS", lowercase, values)
+    m.log(9, "ARGS count read through the FFI = " .. tostring(n))
+
+    if n ~= 2 then
+        return nil
+    end
+    local v = values[0][1]
+    if ffi.string(v.value, v.value_len) ~= "bbb" then
+        return nil
+    end
+
+    local value = ffi.new("const char *[1]")
+    local len = ffi.new("size_t[1]")
+    if ffi.C.msc_lua_getvar(__msc, "ARGS.parm1", nil, value, len) ~= 1
+        or ffi.string(value[0], len[0]) ~= "A" then
+        return nil
+    end
+
+    return "read through the FFI"
+end
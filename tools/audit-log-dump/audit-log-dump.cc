@@ -0,0 +1,243 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+
+/*
+ * Turns an audit log written with SecAuditLogFormat MsgPack back into
+ * JSON, one record per line. The records are a 4 bytes big endian size
+ * followed by a MessagePack document; only the types the engine writes
+ * are understood.
+ */
+
+
+void print_help(const char *name) {
+    std::cout << "Use: " << name << " [<filename>]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Reads a MsgPack audit log (the standard input if no file "
+        "is given) and prints" << std::endl;
+    std::cout << "each of its records as a line of JSON." << std::endl;
+    std::cout << std::endl;
+}
+
+
+class Reader {
+ public:
+    explicit Reader(const std::string &data) : m_data(data), m_pos(0) { }
+
+    bool value(std::string *out);
+    bool done() const { return m_pos == m_data.size(); }
+
+ private:
+    bool number(int bytes, uint64_t *n);
+    bool string(size_t len, std::string *out);
+
+    const std::string &m_data;
+    size_t m_pos;
+};
+
+
+bool Reader::number(int bytes, uint64_t *n) {
+    if (m_data.size() - m_pos < static_cast<size_t>(bytes)) {
+        return false;
+    }
+    *n = 0;
+    for (int i = 0; i < bytes; i++) {
+        *n = (*n << 8) | static_cast<unsigned char>(m_data[m_pos++]);
+    }
+    return true;
+}
+
+
+bool Reader::string(size_t len, std::string *out) {
+    if (m_data.size() - m_pos < len) {
+        return false;
+    }
+    out->push_back('"');
+    for (size_t i = m_pos; i < m_pos + len; i++) {
+        unsigned char c = m_data[i];
+        if (c == '"' || c == '\\') {
+            out->push_back('\\');
+            out->push_back(c);
+        } else if (c == '\n') {
+            out->append("\\n");
+        } else if (c == '\r') {
+            out->append("\\r");
+        } else if (c == '\t') {
+            out->append("\\t");
+        } else if (c < 0x20) {
+            char u[7];
+            snprintf(u, sizeof(u), "\\u%04x", c);
+            out->append(u);
+        } else {
+            out->push_back(c);
+        }
+    }
+    out->push_back('"');
+    m_pos += len;
+    return true;
+}
+
+
+bool Reader::value(std::string *out) {
+    uint64_t n;
+    if (m_pos >= m_data.size()) {
+        return false;
+    }
+    unsigned char type = m_data[m_pos++];
+
+    if (type < 0x80) {
+        out->append(std::to_string(type));
+        return true;
+    }
+    if (type >= 0xe0) {
+        out->append(std::to_string(static_cast<int8_t>(type)));
+        return true;
+    }
+    if ((type & 0xe0) == 0xa0) {
+        return string(type & 0x1f, out);
+    }
+
+    bool map = false;
+    switch (type) {
+    case 0xc0:
+        out->append("null");
+        return true;
+    case 0xc2:
+        out->append("false");
+        return true;
+    case 0xc3:
+        out->append("true");
+        return true;
+    case 0xcc: case 0xcd: case 0xce: case 0xcf:
+        if (!number(1 << (type - 0xcc), &n)) {
+            return false;
+        }
+        out->append(std::to_string(n));
+        return true;
+    case 0xd0: case 0xd1: case 0xd2: case 0xd3: {
+        int bytes = 1 << (type - 0xd0);
+        if (!number(bytes, &n)) {
+            return false;
+        }
+        int64_t s = static_cast<int64_t>(n << (64 - bytes * 8))
+            >> (64 - bytes * 8);
+        out->append(std::to_string(s));
+        return true;
+    }
+    case 0xd9: case 0xda: case 0xdb:
+        return number(1 << (type - 0xd9), &n) && string(n, out);
+    case 0xdf:
+        map = true;
+        /* fall through */
+    case 0xdd:
+        if (!number(4, &n)) {
+            return false;
+        }
+        break;
+    case 0xde:
+        map = true;
+        /* fall through */
+    case 0xdc:
+        if (!number(2, &n)) {
+            return false;
+        }
+        break;
+    default:
+        if ((type & 0xf0) == 0x80 || (type & 0xf0) == 0x90) {
+            map = (type & 0xf0) == 0x80;
+            n = type & 0x0f;
+            break;
+        }
+        return false;
+    }
+
+    out->push_back(map ? '{' : '[');
+    for (uint64_t i = 0; i < n; i++) {
+        if (i > 0) {
+            out->push_back(',');
+        }
+        if (map) {
+            if (!value(out)) {
+                return false;
+            }
+            out->push_back(':');
+        }
+        if (!value(out)) {
+            return false;
+        }
+    }
+    out->push_back(map ? '}' : ']');
+    return true;
+}
+
+
+int main(int argc, char **argv) {
+    std::ifstream file;
+    std::istream *in = &std::cin;
+
+    if (argc > 2 || (argc == 2 && (strcmp(argv[1], "-h") == 0
+        || strcmp(argv[1], "--help") == 0))) {
+        print_help(argv[0]);
+        return argc > 2;
+    }
+    if (argc == 2) {
+        file.open(argv[1], std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open: " << argv[1] << std::endl;
+            return 1;
+        }
+        in = &file;
+    }
+
+    unsigned char size[4];
+    size_t records = 0;
+    std::string record;
+    std::string json;
+    while (in->read(reinterpret_cast<char *>(size), 4)) {
+        uint32_t len = (size[0] << 24) | (size[1] << 16) | (size[2] << 8)
+            | size[3];
+        record.resize(len);
+        if (len > 0 && !in->read(&record[0], len)) {
+            std::cerr << "Record " << records + 1 << " is cut short"
+                << std::endl;
+            return 1;
+        }
+
+        Reader r(record);
+        json.clear();
+        if (!r.value(&json) || !r.done()) {
+            std::cerr << "Record " << records + 1 << " is not valid"
+                << std::endl;
+            return 1;
+        }
+        std::cout << json << std::endl;
+        records++;
+    }
+    if (in->gcount() != 0) {
+        std::cerr << "Record " << records + 1 << " is cut short"
+            << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
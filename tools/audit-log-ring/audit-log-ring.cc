@@ -0,0 +1,136 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <iostream>
+#include <string>
+
+#include "modsecurity/audit_log_ring.h"
+
+
+/*
+ * The consumer of a SecAuditLogType Ring audit log: copies the records,
+ * as they are, to the standard output and frees their space in the ring.
+ * A log shipper would do the same, handing the record over where this
+ * calls fwrite(); see modsecurity/audit_log_ring.h for the layout.
+ */
+
+
+void print_help(const char *name) {
+    std::cout << "Use: " << name << " [-f] <filename>" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Prints the records of an audit log ring, written with " \
+        "SecAuditLogType Ring," << std::endl;
+    std::cout << "emptying it; with -f it keeps waiting for more." \
+        << std::endl;
+    std::cout << std::endl;
+}
+
+
+int main(int argc, char **argv) {
+    bool follow = false;
+    const char *file = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-f") == 0) {
+            follow = true;
+        } else if (argv[i][0] == '-' || file != NULL) {
+            print_help(argv[0]);
+            return 1;
+        } else {
+            file = argv[i];
+        }
+    }
+    if (file == NULL) {
+        print_help(argv[0]);
+        return 1;
+    }
+
+    int fd = open(file, O_RDWR);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        std::cerr << "Failed to open " << file << ": " << strerror(errno) \
+            << std::endl;
+        return 1;
+    }
+    if (static_cast<size_t>(st.st_size) < sizeof(MscAuditLogRingHeader)) {
+        std::cerr << file << " is not an audit log ring" << std::endl;
+        return 1;
+    }
+    void *map = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+        fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        std::cerr << "Failed to map " << file << ": " << strerror(errno) \
+            << std::endl;
+        return 1;
+    }
+
+    MscAuditLogRingHeader *h = static_cast<MscAuditLogRingHeader *>(map);
+    if (__atomic_load_n(&h->magic, __ATOMIC_ACQUIRE)
+        != MSC_AUDIT_LOG_RING_MAGIC
+        || h->version != MSC_AUDIT_LOG_RING_VERSION
+        || h->data_offset + h->capacity
+        > static_cast<uint64_t>(st.st_size)) {
+        std::cerr << file << " is not an audit log ring of version " \
+            << MSC_AUDIT_LOG_RING_VERSION << std::endl;
+        return 1;
+    }
+
+    const char *data = static_cast<const char *>(map) + h->data_offset;
+    uint64_t mask = h->capacity - 1;
+    uint64_t tail = __atomic_load_n(&h->tail, __ATOMIC_ACQUIRE);
+    while (true) {
+        const MscAuditLogRingRecord *record =
+            reinterpret_cast<const MscAuditLogRingRecord *>(
+                data + (tail & mask));
+        if (__atomic_load_n(&record->sequence, __ATOMIC_ACQUIRE)
+            != tail + 1) {
+            /* nothing complete at tail: empty, or still being written */
+            if (follow == false
+                && __atomic_load_n(&h->head, __ATOMIC_ACQUIRE) == tail) {
+                break;
+            }
+            fflush(stdout);
+            usleep(10000);
+            continue;
+        }
+
+        if (record->kind == MSC_AUDIT_LOG_RING_RECORD) {
+            fwrite(record + 1, 1, record->length, stdout);
+        }
+        tail += (sizeof(MscAuditLogRingRecord) + record->length
+            + MSC_AUDIT_LOG_RING_ALIGN - 1)
+            & ~static_cast<uint64_t>(MSC_AUDIT_LOG_RING_ALIGN - 1);
+        __atomic_store_n(&h->tail, tail, __ATOMIC_RELEASE);
+    }
+    fflush(stdout);
+
+    std::cerr << __atomic_load_n(&h->written, __ATOMIC_RELAXED) \
+        << " records written, " \
+        << __atomic_load_n(&h->dropped, __ATOMIC_RELAXED) \
+        << " dropped" << std::endl;
+    munmap(map, st.st_size);
+
+    return 0;
+}
@@ -0,0 +1,373 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include "tools/replay/corpus.h"
+
+#ifdef WITH_YAJL
+#include <yajl/yajl_tree.h>
+#endif
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/transaction.h"
+
+
+namespace {
+
+/* Where the requests come from when the recording does not tell. */
+const char *kClientIp = "200.249.12.31";
+const int kClientPort = 12345;
+const char *kServerIp = "127.0.0.1";
+const int kServerPort = 80;
+
+
+Request newRequest() {
+    Request r;
+    r.clientIp = kClientIp;
+    r.clientPort = kClientPort;
+    r.serverIp = kServerIp;
+    r.serverPort = kServerPort;
+    r.method = "GET";
+    r.uri = "/";
+    r.httpVersion = "1.1";
+    r.status = 200;
+    return r;
+}
+
+
+#ifdef WITH_YAJL
+std::string jsonString(yajl_val node, const char *key,
+    const std::string &def = "") {
+    const char *path[] = { key, NULL };
+    yajl_val v = yajl_tree_get(node, path, yajl_t_string);
+    if (v == NULL) {
+        return def;
+    }
+    return YAJL_GET_STRING(v);
+}
+
+
+int jsonInteger(yajl_val node, const char *key, int def) {
+    const char *path[] = { key, NULL };
+    yajl_val v = yajl_tree_get(node, path, yajl_t_number);
+    if (v == NULL || !YAJL_IS_INTEGER(v)) {
+        return def;
+    }
+    return YAJL_GET_INTEGER(v);
+}
+
+
+/*
+ * The audit log writes the HTTP version as a number (1.1): its text is
+ * what yajl read.
+ */
+std::string jsonVersion(yajl_val node, const char *key,
+    const std::string &def) {
+    const char *path[] = { key, NULL };
+    yajl_val v = yajl_tree_get(node, path, yajl_t_any);
+    if (v != NULL && YAJL_IS_NUMBER(v)) {
+        return v->u.number.r;
+    }
+    return jsonString(node, key, def);
+}
+
+
+/*
+ * Headers are either an object, name to value, or a list of
+ * {"name", "value"} objects, which keeps the repeated ones. HTTP/2
+ * pseudo headers (":authority", ...) from HAR captures are left out.
+ */
+void jsonHeaders(yajl_val node, const char *key, Headers *headers) {
+    const char *path[] = { key, NULL };
+    yajl_val v = yajl_tree_get(node, path, yajl_t_any);
+    if (v == NULL) {
+        return;
+    }
+    if (YAJL_IS_OBJECT(v)) {
+        for (size_t i = 0; i < v->u.object.len; i++) {
+            yajl_val value = v->u.object.values[i];
+            if (YAJL_IS_STRING(value)) {
+                headers->emplace_back(v->u.object.keys[i],
+                    YAJL_GET_STRING(value));
+            }
+        }
+    } else if (YAJL_IS_ARRAY(v)) {
+        for (size_t i = 0; i < v->u.array.len; i++) {
+            std::string name = jsonString(v->u.array.values[i], "name");
+            if (name.empty() || name[0] == ':') {
+                continue;
+            }
+            headers->emplace_back(name,
+                jsonString(v->u.array.values[i], "value"));
+        }
+    }
+}
+
+
+/*
+ * HAR has the absolute URL and the version as "HTTP/1.1"; what goes to
+ * processURI() is the path and "1.1".
+ */
+std::string harUri(const std::string &url) {
+    size_t scheme = url.find("://");
+    if (scheme == std::string::npos) {
+        return url;
+    }
+    size_t path = url.find('/', scheme + 3);
+    if (path == std::string::npos) {
+        return "/";
+    }
+    return url.substr(path);
+}
+
+
+std::string harVersion(const std::string &version) {
+    size_t slash = version.find('/');
+    if (slash == std::string::npos) {
+        return version.empty() ? "1.1" : version;
+    }
+    return version.substr(slash + 1);
+}
+
+
+bool loadHar(yajl_val root, std::vector<Request> *corpus) {
+    const char *path[] = { "log", "entries", NULL };
+    yajl_val entries = yajl_tree_get(root, path, yajl_t_array);
+    if (entries == NULL) {
+        return false;
+    }
+
+    for (size_t i = 0; i < entries->u.array.len; i++) {
+        yajl_val entry = entries->u.array.values[i];
+        const char *req[] = { "request", NULL };
+        const char *res[] = { "response", NULL };
+        const char *post[] = { "request", "postData", NULL };
+        const char *content[] = { "response", "content", NULL };
+        yajl_val request = yajl_tree_get(entry, req, yajl_t_object);
+        yajl_val response = yajl_tree_get(entry, res, yajl_t_object);
+        if (request == NULL) {
+            continue;
+        }
+
+        Request r = newRequest();
+        r.clientIp = jsonString(entry, "serverIPAddress", kClientIp);
+        r.method = jsonString(request, "method", "GET");
+        r.uri = harUri(jsonString(request, "url", "/"));
+        r.httpVersion = harVersion(jsonString(request, "httpVersion"));
+        jsonHeaders(request, "headers", &r.headers);
+        yajl_val postData = yajl_tree_get(entry, post, yajl_t_object);
+        if (postData != NULL) {
+            r.body = jsonString(postData, "text");
+        }
+        r.protocol = "HTTP " + r.httpVersion;
+        if (response != NULL) {
+            r.status = jsonInteger(response, "status", 200);
+            jsonHeaders(response, "headers", &r.responseHeaders);
+            yajl_val body = yajl_tree_get(entry, content, yajl_t_object);
+            /* base64 encoded bodies are left out, not decoded. */
+            if (body != NULL && jsonString(body, "encoding").empty()) {
+                r.responseBody = jsonString(body, "text");
+            }
+        }
+        corpus->push_back(std::move(r));
+    }
+    return true;
+}
+
+
+/*
+ * A record of the JSON audit log: the request and response parts (B, C,
+ * E, F, I) are what is replayed, whichever of them were logged.
+ */
+void loadAuditLogRecord(yajl_val transaction, std::vector<Request> *corpus) {
+    const char *req[] = { "request", NULL };
+    const char *res[] = { "response", NULL };
+    yajl_val request = yajl_tree_get(transaction, req, yajl_t_object);
+    yajl_val response = yajl_tree_get(transaction, res, yajl_t_object);
+
+    Request r = newRequest();
+    r.clientIp = jsonString(transaction, "client_ip", kClientIp);
+    r.clientPort = jsonInteger(transaction, "client_port", kClientPort);
+    r.serverIp = jsonString(transaction, "host_ip", kServerIp);
+    r.serverPort = jsonInteger(transaction, "host_port", kServerPort);
+    if (request != NULL) {
+        r.method = jsonString(request, "method", "GET");
+        r.uri = jsonString(request, "uri", "/");
+        r.httpVersion = jsonVersion(request, "http_version", "1.1");
+        jsonHeaders(request, "headers", &r.headers);
+        r.body = jsonString(request, "body");
+    }
+    r.protocol = "HTTP " + r.httpVersion;
+    if (response != NULL) {
+        r.status = jsonInteger(response, "http_code", 200);
+        jsonHeaders(response, "headers", &r.responseHeaders);
+        r.responseBody = jsonString(response, "body");
+    }
+    corpus->push_back(std::move(r));
+}
+
+
+bool loadJsonl(const std::string &line, std::vector<Request> *corpus,
+    std::string *error) {
+    char errbuf[1024];
+    yajl_val node = yajl_tree_parse(line.c_str(), errbuf, sizeof(errbuf));
+    if (node == NULL || !YAJL_IS_OBJECT(node)) {
+        *error = node == NULL ? errbuf : "not a JSON object";
+        yajl_tree_free(node);
+        return false;
+    }
+
+    const char *tr[] = { "transaction", NULL };
+    yajl_val transaction = yajl_tree_get(node, tr, yajl_t_object);
+    if (transaction != NULL) {
+        loadAuditLogRecord(transaction, corpus);
+        yajl_tree_free(node);
+        return true;
+    }
+
+    const char *res[] = { "response", NULL };
+    yajl_val response = yajl_tree_get(node, res, yajl_t_object);
+
+    Request r = newRequest();
+    r.clientIp = jsonString(node, "client_ip", kClientIp);
+    r.method = jsonString(node, "method", "GET");
+    r.uri = jsonString(node, "uri", "/");
+    r.httpVersion = jsonString(node, "http_version", "1.1");
+    jsonHeaders(node, "headers", &r.headers);
+    r.body = jsonString(node, "body");
+    r.protocol = "HTTP " + r.httpVersion;
+    if (response != NULL) {
+        r.status = jsonInteger(response, "status", 200);
+        jsonHeaders(response, "headers", &r.responseHeaders);
+        r.responseBody = jsonString(response, "body");
+    }
+    corpus->push_back(std::move(r));
+
+    yajl_tree_free(node);
+    return true;
+}
+#endif
+
+
+bool intervened(modsecurity::Transaction *t) {
+    modsecurity::ModSecurityIntervention it;
+    modsecurity::intervention::reset(&it);
+    if (t->intervention(&it) == 0) {
+        return false;
+    }
+    modsecurity::intervention::free(&it);
+    return true;
+}
+
+}  // namespace
+
+
+bool loadCorpus(const std::string &file, std::vector<Request> *corpus,
+    std::string *error) {
+#ifdef WITH_YAJL
+    std::ifstream in(file);
+    if (!in.is_open()) {
+        *error = "can not open " + file;
+        return false;
+    }
+    std::stringstream ss;
+    ss << in.rdbuf();
+    std::string content = ss.str();
+
+    /*
+     * A HAR capture is a single document; everything else is a JSON
+     * object per line (a file with a single audit log record is both).
+     */
+    char errbuf[1024];
+    yajl_val root = yajl_tree_parse(content.c_str(), errbuf, sizeof(errbuf));
+    if (root != NULL) {
+        bool har = loadHar(root, corpus);
+        yajl_tree_free(root);
+        if (har) {
+            return true;
+        }
+    }
+
+    std::istringstream lines(content);
+    std::string line;
+    size_t number = 0;
+    while (std::getline(lines, line)) {
+        number++;
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+        if (!loadJsonl(line, corpus, error)) {
+            *error = file + ":" + std::to_string(number) + ": " + *error;
+            return false;
+        }
+    }
+    return true;
+#else
+    *error = "replaying a corpus needs ModSecurity built with YAJL";
+    return false;
+#endif
+}
+
+
+bool replay(modsecurity::Transaction *t, const Request &r) {
+    t->processConnection(r.clientIp.c_str(), r.clientPort,
+        r.serverIp.c_str(), r.serverPort);
+    if (intervened(t)) {
+        return true;
+    }
+    t->processURI(r.uri.c_str(), r.method.c_str(), r.httpVersion.c_str());
+    if (intervened(t)) {
+        return true;
+    }
+
+    for (const auto &h : r.headers) {
+        t->addRequestHeader(h.first, h.second);
+    }
+    t->processRequestHeaders();
+    if (intervened(t)) {
+        return true;
+    }
+
+    if (!r.body.empty()) {
+        t->appendRequestBody(
+            reinterpret_cast<const unsigned char *>(r.body.c_str()),
+            r.body.size());
+    }
+    t->processRequestBody();
+    if (intervened(t)) {
+        return true;
+    }
+
+    for (const auto &h : r.responseHeaders) {
+        t->addResponseHeader(h.first, h.second);
+    }
+    t->processResponseHeaders(r.status, r.protocol);
+    if (intervened(t)) {
+        return true;
+    }
+
+    if (!r.responseBody.empty()) {
+        t->appendResponseBody(
+            reinterpret_cast<const unsigned char *>(r.responseBody.c_str()),
+            r.responseBody.size());
+    }
+    t->processResponseBody();
+    return intervened(t);
+}
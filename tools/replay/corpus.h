@@ -0,0 +1,63 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "modsecurity/transaction.h"
+
+#ifndef TOOLS_REPLAY_CORPUS_H_
+#define TOOLS_REPLAY_CORPUS_H_
+
+
+typedef std::vector<std::pair<std::string, std::string>> Headers;
+
+/* A recorded exchange, as it is fed again to a transaction. */
+struct Request {
+    std::string clientIp;
+    int clientPort;
+    std::string serverIp;
+    int serverPort;
+    std::string method;
+    std::string uri;
+    std::string httpVersion;
+    Headers headers;
+    std::string body;
+    int status;
+    std::string protocol;
+    Headers responseHeaders;
+    std::string responseBody;
+};
+
+
+/**
+ * Appends the requests recorded in file to corpus. It can be a HAR
+ * capture, a JSON audit log (one record per line, as Transaction::toJSON
+ * writes them) or one request per line in the form of benchmark -c.
+ * Needs YAJL.
+ */
+bool loadCorpus(const std::string &file, std::vector<Request> *corpus,
+    std::string *error);
+
+/**
+ * Runs r through every phase of t but the logging one, the way a
+ * connector would: it stops at the first intervention, which is then
+ * returned (as true).
+ */
+bool replay(modsecurity::Transaction *t, const Request &r);
+
+
+#endif  // TOOLS_REPLAY_CORPUS_H_
@@ -0,0 +1,369 @@
+/*
+ * ModSecurity, http://www.modsecurity.org/
+ * Copyright (c) 2015 - 2021 Trustwave Holdings, Inc. (http://www.trustwave.com/)
+ *
+ * You may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * If any of the files related to licensing are missing or if you have any
+ * other questions related to licensing please contact Trustwave Holdings, Inc.
+ * directly using the email address security@modsecurity.org.
+ *
+ */
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/timings.h"
+#include "modsecurity/transaction.h"
+#include "tools/replay/corpus.h"
+
+using modsecurity::ModSecurityTimings;
+using modsecurity::Transaction;
+
+
+/*
+ * Replays recorded traffic through a rule set, to tell what the rules
+ * cost before they are deployed: the throughput, the latency of every
+ * phase and the rules that take most of the time (SecRuleProfiling on
+ * every transaction).
+ */
+
+
+void print_help(const char *name) {
+    std::cout << "Use: " << name << " [options] <rules> <corpus> [<corpus> "
+        "...]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "  -t <num>  worker threads sharing the rules (default: 1)"
+        << std::endl;
+    std::cout << "  -n <num>  transactions to run, the corpus is replayed in "
+        "a loop (default:" << std::endl;
+    std::cout << "            each request once)" << std::endl;
+    std::cout << "  -p <num>  CRS paranoia level, tx.paranoia_level is set "
+        "ahead of the rules" << std::endl;
+    std::cout << "  -r <num>  most expensive rules to list (default: 10)"
+        << std::endl;
+    std::cout << "  -j        print the results as JSON" << std::endl;
+    std::cout << std::endl;
+    std::cout << "A corpus is a HAR capture, a JSON audit log "
+        "(SecAuditLogFormat JSON, a record" << std::endl;
+    std::cout << "per line) or one request per line as benchmark -c takes "
+        "them." << std::endl;
+    std::cout << std::endl;
+}
+
+
+enum Phase {
+    RequestHeaders,
+    RequestBody,
+    ResponseHeaders,
+    ResponseBody,
+    Logging,
+    Total,
+    Phases
+};
+
+const char *phaseNames[Phases] = {
+    "request_headers",
+    "request_body",
+    "response_headers",
+    "response_body",
+    "logging",
+    "total"
+};
+
+
+struct Worker {
+    modsecurity::ModSecurity *modsec;
+    modsecurity::RulesSet *rules;
+    const std::vector<Request> *corpus;
+    std::atomic<unsigned long long> *next;
+    unsigned long long total;
+    pthread_t thread;
+
+    unsigned long long interventions;
+    std::vector<uint64_t> latency[Phases];
+};
+
+
+/* Transactions are recycled per worker, as a connector does per connection. */
+void *work(void *data) {
+    Worker *w = reinterpret_cast<Worker *>(data);
+    Transaction *t = new Transaction(w->modsec, w->rules, NULL);
+    ModSecurityTimings timings;
+
+    while (true) {
+        unsigned long long i = (*w->next)++;
+        if (i >= w->total) {
+            break;
+        }
+        if (replay(t, (*w->corpus)[i % w->corpus->size()])) {
+            w->interventions++;
+        }
+        t->processLogging();
+
+        t->timings(&timings);
+        w->latency[RequestHeaders].push_back(timings.request_headers);
+        w->latency[RequestBody].push_back(timings.request_body);
+        w->latency[ResponseHeaders].push_back(timings.response_headers);
+        w->latency[ResponseBody].push_back(timings.response_body);
+        w->latency[Logging].push_back(timings.logging);
+        w->latency[Total].push_back(timings.total);
+
+        t->reset();
+    }
+
+    delete t;
+    return NULL;
+}
+
+
+bool number(const char *arg, unsigned long long *value) {
+    char *end = NULL;
+    errno = 0;
+    unsigned long long v = strtoull(arg, &end, 10);
+    if (errno || end == arg || *end != '\0') {
+        return false;
+    }
+    *value = v;
+    return true;
+}
+
+
+double percentile(const std::vector<uint64_t> &sorted, double p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t i = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[i] / 1000.0;
+}
+
+
+std::string jsonEscape(const std::string &s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            out.push_back('\\');
+        }
+        if (static_cast<unsigned char>(c) >= 0x20) {
+            out.push_back(c);
+        }
+    }
+    return out;
+}
+
+
+/* The first lines of the profile: the rules by decreasing time spent. */
+std::vector<std::string> topRules(const modsecurity::RulesSet *rules,
+    unsigned long long n) {
+    std::istringstream profile(rules->profileDump());
+    std::vector<std::string> top;
+    std::string line;
+
+    std::getline(profile, line);
+    while (top.size() < n && std::getline(profile, line)) {
+        top.push_back(line);
+    }
+    return top;
+}
+
+
+int main(int argc, char **argv) {
+    unsigned long long transactions = 0;
+    unsigned long long threads = 1;
+    unsigned long long paranoia = 0;
+    unsigned long long top = 10;
+    bool json = false;
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg(argv[i]);
+        if (arg == "-h" || arg == "-?" || arg == "--help") {
+            print_help(argv[0]);
+            return 0;
+        }
+        if (arg == "-j") {
+            json = true;
+            continue;
+        }
+        if (arg.size() == 2 && arg[0] == '-') {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << std::endl;
+                return -1;
+            }
+            const char *value = argv[++i];
+            bool ok = true;
+            switch (arg[1]) {
+                case 'n': ok = number(value, &transactions); break;
+                case 't': ok = number(value, &threads) && threads > 0; break;
+                case 'p': ok = number(value, &paranoia); break;
+                case 'r': ok = number(value, &top); break;
+                default: ok = false;
+            }
+            if (!ok) {
+                std::cerr << "Invalid value for " << arg << ": '" << value
+                    << "'" << std::endl;
+                return -1;
+            }
+            continue;
+        }
+        files.push_back(arg);
+    }
+    if (files.size() < 2) {
+        print_help(argv[0]);
+        return -1;
+    }
+
+    std::vector<Request> corpus;
+    for (size_t i = 1; i < files.size(); i++) {
+        std::string error;
+        if (!loadCorpus(files[i], &corpus, &error)) {
+            std::cerr << "Problems loading the corpus: " << error
+                << std::endl;
+            return -1;
+        }
+    }
+    if (corpus.empty()) {
+        std::cerr << "No requests to replay." << std::endl;
+        return -1;
+    }
+    if (transactions == 0) {
+        transactions = corpus.size();
+    }
+
+    modsecurity::ModSecurity *modsec = new modsecurity::ModSecurity();
+    modsec->setConnectorInformation("ModSecurity-replay v0.0.1" \
+        " (ModSecurity replay utility)");
+
+    /*
+     * CRS only initializes tx.paranoia_level when it is not set yet, so
+     * setting it ahead of the rules picks the level. Profiling goes last,
+     * for the rules not to turn it off.
+     */
+    modsecurity::RulesSet *rules = new modsecurity::RulesSet();
+    std::string setup;
+    if (paranoia > 0) {
+        setup = "SecAction \"id:900000,phase:1,nolog,pass,t:none," \
+            "setvar:tx.paranoia_level=" + std::to_string(paranoia) + "\"";
+    }
+    if ((!setup.empty() && rules->load(setup.c_str()) < 0)
+        || rules->loadFromUri(files[0].c_str()) < 0
+        || rules->load("SecRuleProfiling On\n" \
+            "SecRuleProfilingSampleRate 1") < 0) {
+        std::cerr << "Problems loading the rules..." << std::endl;
+        std::cerr << rules->m_parserError.str() << std::endl;
+        return -1;
+    }
+
+    std::atomic<unsigned long long> next(0);
+    std::vector<Worker> workers(threads);
+    auto begin = std::chrono::steady_clock::now();
+    for (auto &w : workers) {
+        w.modsec = modsec;
+        w.rules = rules;
+        w.corpus = &corpus;
+        w.next = &next;
+        w.total = transactions;
+        w.interventions = 0;
+        for (auto &l : w.latency) {
+            l.reserve(transactions / threads + 1);
+        }
+        pthread_create(&w.thread, NULL, work, &w);
+    }
+    for (auto &w : workers) {
+        pthread_join(w.thread, NULL);
+    }
+    double elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - begin).count();
+
+    unsigned long long interventions = 0;
+    std::vector<uint64_t> latency[Phases];
+    for (auto &w : workers) {
+        interventions += w.interventions;
+        for (int p = 0; p < Phases; p++) {
+            latency[p].insert(latency[p].end(), w.latency[p].begin(),
+                w.latency[p].end());
+        }
+    }
+    for (auto &l : latency) {
+        std::sort(l.begin(), l.end());
+    }
+
+    static const double quantiles[] = { 0.5, 0.9, 0.99, 0.999 };
+    static const char *quantileNames[] = { "p50", "p90", "p99", "p999" };
+    double tps = transactions / elapsed;
+    std::vector<std::string> expensive = topRules(rules, top);
+
+    if (json) {
+        std::cout << std::fixed << std::setprecision(3) << "{"
+            << "\"rules\": \"" << jsonEscape(files[0]) << "\", "
+            << "\"paranoia_level\": " << paranoia << ", "
+            << "\"corpus_requests\": " << corpus.size() << ", "
+            << "\"threads\": " << threads << ", "
+            << "\"transactions\": " << transactions << ", "
+            << "\"interventions\": " << interventions << ", "
+            << "\"elapsed_seconds\": " << elapsed << ", "
+            << "\"transactions_per_second\": " << tps << ", "
+            << "\"latency_us\": {";
+        for (int p = 0; p < Phases; p++) {
+            std::cout << (p ? ", " : "") << "\"" << phaseNames[p] << "\": {";
+            for (int q = 0; q < 4; q++) {
+                std::cout << "\"" << quantileNames[q] << "\": "
+                    << percentile(latency[p], quantiles[q]) << ", ";
+            }
+            std::cout << "\"max\": " << percentile(latency[p], 1) << "}";
+        }
+        std::cout << "}, \"top_rules\": [";
+        for (size_t i = 0; i < expensive.size(); i++) {
+            std::cout << (i ? ", " : "") << "\"" << jsonEscape(expensive[i])
+                << "\"";
+        }
+        std::cout << "]}" << std::endl;
+    } else {
+        std::cout << std::fixed << std::setprecision(2)
+            << "Replayed " << transactions << " transactions ("
+            << corpus.size() << " recorded) with " << threads
+            << " thread(s)" << std::endl
+            << "Elapsed: " << elapsed << " s, " << tps
+            << " transactions/s, " << interventions << " intervention(s)"
+            << std::endl << std::endl
+            << std::left << std::setw(18) << "Latency (us)";
+        for (int q = 0; q < 4; q++) {
+            std::cout << std::right << std::setw(10) << quantileNames[q];
+        }
+        std::cout << std::setw(10) << "max" << std::endl;
+        for (int p = 0; p < Phases; p++) {
+            std::cout << std::left << std::setw(18) << phaseNames[p];
+            for (int q = 0; q < 4; q++) {
+                std::cout << std::right << std::setw(10)
+                    << percentile(latency[p], quantiles[q]);
+            }
+            std::cout << std::setw(10) << percentile(latency[p], 1)
+                << std::endl;
+        }
+        std::cout << std::endl << "Most expensive rules:" << std::endl;
+        for (const std::string &line : expensive) {
+            std::cout << "  " << line << std::endl;
+        }
+    }
+
+    delete rules;
+    delete modsec;
+    return 0;
+}
@@ -18,24 +18,105 @@
 #include <unistd.h>
 
 #include <ctime>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "modsecurity/rules_set.h"
 #include "modsecurity/modsecurity.h"
+#include "modsecurity/rule_with_operator.h"
 
 
 void print_help(const char *name) {
-    std::cout << "Use: " << name << " [<filename>|SecLangCommand]" << std::endl;
+    std::cout << "Use: " << name << " [-b] [-p] [-t] [-n <file.cc>] [<filename>|SecLangCommand]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "  -b  list the matching engine used by each rule operator"
+        << std::endl;
+    std::cout << "  -p  (or --perf) estimate the cost of each rule and point "
+        "out what makes it slower than it needs to be" << std::endl;
+    std::cout << "  -t  list the effective targets of each rule, once the "
+        "SecRuleUpdateTarget* exceptions are applied" << std::endl;
+    std::cout << "  -n  write C++ for the rules to file.cc, to be built into "
+        "a SecRuleNativeModule" << std::endl;
     std::cout << std::endl;
 }
 
 
+/*
+ * Calls f on every rule with an operator, the links of the chains
+ * included, along with the id of the rule that starts the chain.
+ */
+void for_each_rule(modsecurity::RulesSet *rules,
+    const std::function<void(int64_t, modsecurity::RuleWithOperator *)> &f) {
+    for (int i = 0; i < modsecurity::Phases::NUMBER_OF_PHASES; i++) {
+        modsecurity::Rules *phase = rules->m_rulesSetPhases[i];
+        for (size_t j = 0; j < phase->size(); j++) {
+            std::shared_ptr<modsecurity::RuleWithActions> r =
+                std::dynamic_pointer_cast<modsecurity::RuleWithActions>(
+                    phase->at(j));
+            int64_t id = r ? r->m_ruleId : 0;
+            while (r) {
+                modsecurity::RuleWithOperator *op =
+                    dynamic_cast<modsecurity::RuleWithOperator *>(r.get());
+                if (op) {
+                    f(id, op);
+                }
+                r = r->m_chainedRuleChild;
+            }
+        }
+    }
+}
+
+
+void print_rule(int64_t id, modsecurity::RuleWithOperator *op) {
+    std::cout << "    Rule " << std::to_string(id) << " (@"
+        << op->getOperatorName() << "): ";
+}
+
+
+void print_backends(modsecurity::RulesSet *rules) {
+    for_each_rule(rules, [](int64_t id, modsecurity::RuleWithOperator *op) {
+        if (op->getOperatorBackend().empty() == false) {
+            print_rule(id, op);
+            std::cout << op->getOperatorBackend() << std::endl;
+        }
+    });
+}
+
+
+void print_targets(modsecurity::RulesSet *rules) {
+    for_each_rule(rules,
+        [rules](int64_t id, modsecurity::RuleWithOperator *op) {
+        print_rule(id, op);
+        std::cout << op->getEffectiveTargets(rules) << std::endl;
+    });
+}
+
+
+void print_performance(modsecurity::RulesSet *rules) {
+    for_each_rule(rules,
+        [rules](int64_t id, modsecurity::RuleWithOperator *op) {
+        print_rule(id, op);
+        std::cout << op->getCostClass(rules) << " cost" << std::endl;
+        for (const std::string &hint : op->getPerformanceHints()) {
+            std::cout << "        " << hint << std::endl;
+        }
+    });
+}
+
+
 int main(int argc, char **argv) {
     modsecurity::RulesSet *rules;
     char **args = argv;
     rules = new modsecurity::RulesSet();
     int ret = 0;
+    bool backends = false;
+    bool targets = false;
+    bool performance = false;
+    const char *native = NULL;
 
     args++;
 
@@ -51,6 +132,26 @@ int main(int argc, char **argv) {
         std::string err;
         int r;
 
+        if (strcmp(arg, "-b") == 0) {
+            backends = true;
+            goto next;
+        }
+
+        if (strcmp(arg, "-t") == 0) {
+            targets = true;
+            goto next;
+        }
+
+        if (strcmp(arg, "-p") == 0 || strcmp(arg, "--perf") == 0) {
+            performance = true;
+            goto next;
+        }
+
+        if (strcmp(arg, "-n") == 0 && args[1] != NULL) {
+            native = *++args;
+            goto next;
+        }
+
         if (argFull.empty() == false) {
             if (arg[strlen(arg)-1] == '\"') {
                 argFull.append(arg, strlen(arg)-1);
@@ -95,6 +196,27 @@ next:
         args++;
     }
 
+    if (backends) {
+        print_backends(rules);
+    }
+
+    if (targets) {
+        print_targets(rules);
+    }
+
+    if (performance) {
+        print_performance(rules);
+    }
+
+    if (native != NULL) {
+        std::ofstream out(native);
+        out << rules->nativeSource();
+        if (!out) {
+            std::cerr << "Failed to write " << native << std::endl;
+            ret = -1;
+        }
+    }
+
     delete rules;
 
     if (ret < 0) {